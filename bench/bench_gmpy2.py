@@ -0,0 +1,241 @@
+"""Benchmarks for gmpy2.
+
+The benchmarks sweep operand sizes from one limb up to 10**7 bits. With
+pyperf installed, the pyperf runner is used:
+
+    python bench/bench_gmpy2.py -o before.json
+    python bench/bench_gmpy2.py -o after.json
+    python -m pyperf compare_to before.json after.json
+
+Without pyperf, a simple timer is used that writes its own JSON file and
+can compare two of them:
+
+    python bench/bench_gmpy2.py --simple -o before.json
+    python bench/bench_gmpy2.py --simple --compare before.json after.json
+
+Use --select to run the benchmarks whose names contain a substring and
+--full to include the 10**7 bit operands. Operands are generated from a
+fixed seed so runs are comparable between builds.
+"""
+
+from __future__ import print_function, division
+
+import json
+import platform
+import random
+import sys
+import time
+
+import gmpy2
+from gmpy2 import mpz, mpq, mpfr, mpc, xmpz
+
+SIZES = [64, 256, 4096, 65536, 10**6]
+FULL_SIZES = SIZES + [10**7]
+
+# Operations that are at least quadratic in some part of the work are
+# limited to smaller operands so that a full sweep finishes in minutes.
+PRP_SIZES = [64, 256, 1024, 4096]
+POWMOD_SIZES = [64, 256, 1024, 4096]
+FLOAT_SIZES = [53, 256, 4096, 65536]
+
+
+def operand(bits, seed):
+    rng = random.Random(seed * 1000003 + bits)
+    return mpz(rng.getrandbits(bits) | (1 << (bits - 1)))
+
+
+def odd_operand(bits, seed):
+    return operand(bits, seed) | 1
+
+
+def loop(func, *args):
+    """Return a pyperf time function that calls func(*args) 'loops' times."""
+    def timer(loops):
+        r = range(loops)
+        t0 = time.perf_counter()
+        for _ in r:
+            func(*args)
+        return time.perf_counter() - t0
+    return timer
+
+
+def cache_loop(cache_size):
+    """Create and drop small mpz objects with the given cache size."""
+    def timer(loops):
+        saved = gmpy2.get_cache()
+        gmpy2.set_cache(cache_size, saved[1])
+        try:
+            x = mpz(12345)
+            r = range(loops)
+            t0 = time.perf_counter()
+            for _ in r:
+                x + 1; x * 3; x - 7; x + 2; x * 5
+            return time.perf_counter() - t0
+        finally:
+            gmpy2.set_cache(*saved)
+    return timer
+
+
+def benchmarks(full=False):
+    """Yield (name, time function) pairs."""
+    sizes = FULL_SIZES if full else SIZES
+
+    for bits in sizes:
+        a, b = operand(bits, 1), operand(bits, 2)
+        h = operand(max(bits // 2, 1), 3)
+        yield "mpz_add/%d" % bits, loop(a.__add__, b)
+        yield "mpz_mul/%d" % bits, loop(a.__mul__, b)
+        yield "mpz_floordiv/%d" % bits, loop(a.__floordiv__, h)
+        yield "mpz_mod/%d" % bits, loop(a.__mod__, h)
+        yield "mpz_gcd/%d" % bits, loop(gmpy2.gcd, a, b)
+        yield "mpz_isqrt/%d" % bits, loop(gmpy2.isqrt, a)
+        yield "xmpz_iadd/%d" % bits, loop(xmpz(a).__iadd__, b)
+
+    for bits in POWMOD_SIZES:
+        a, e, m = operand(bits, 1), operand(bits, 2), odd_operand(bits, 3)
+        yield "mpz_powmod/%d" % bits, loop(pow, a, e, m)
+
+    for bits in sizes[:-1]:
+        q = mpq(operand(bits, 1), operand(bits, 2))
+        r = mpq(operand(bits, 3), operand(bits, 4))
+        yield "mpq_add/%d" % bits, loop(q.__add__, r)
+        yield "mpq_mul/%d" % bits, loop(q.__mul__, r)
+
+    for prec in FLOAT_SIZES:
+        with gmpy2.local_context(gmpy2.context(), precision=prec) as ctx:
+            x = mpfr(operand(prec, 1)) / operand(prec, 2)
+            y = mpfr(operand(prec, 3)) / operand(prec, 4)
+            z = mpc(x, y)
+        yield "mpfr_add/%d" % prec, loop(ctx.add, x, y)
+        yield "mpfr_mul/%d" % prec, loop(ctx.mul, x, y)
+        yield "mpfr_div/%d" % prec, loop(ctx.div, x, y)
+        yield "mpfr_sqrt/%d" % prec, loop(ctx.sqrt, x)
+        yield "mpfr_exp/%d" % prec, loop(ctx.exp, x)
+        yield "mpc_mul/%d" % prec, loop(ctx.mul, z, z)
+        yield "mpc_div/%d" % prec, loop(ctx.div, z, x + z)
+
+    for bits in sizes:
+        a = operand(bits, 1)
+        n = int(a)
+        s = a.digits(16)
+        yield "int_to_mpz/%d" % bits, loop(mpz, n)
+        yield "mpz_to_int/%d" % bits, loop(int, a)
+        yield "mpz_hash/%d" % bits, loop(hash, a + 1)
+        yield "hex_to_mpz/%d" % bits, loop(mpz, s, 16)
+        yield "mpz_to_hex/%d" % bits, loop(a.digits, 16)
+        data = gmpy2.to_binary(a)
+        yield "to_binary/%d" % bits, loop(gmpy2.to_binary, a)
+        yield "from_binary/%d" % bits, loop(gmpy2.from_binary, data)
+
+    for bits in sizes[:-1]:
+        a = operand(bits, 1)
+        s = a.digits(10)
+        yield "str_to_mpz/%d" % bits, loop(mpz, s)
+        yield "mpz_to_str/%d" % bits, loop(a.digits, 10)
+
+    for bits in PRP_SIZES:
+        p = gmpy2.next_prime(operand(bits, 1))
+        yield "is_prime/%d" % bits, loop(gmpy2.is_prime, p)
+        yield "is_bpsw_prp/%d" % bits, loop(gmpy2.is_bpsw_prp, p)
+        yield "is_strong_prp/%d" % bits, loop(gmpy2.is_strong_prp, p, 2)
+
+    x, z = mpfr("1.2345678901234567"), mpc("1.5-2.25j")
+    values = [mpz(i) ** 3 for i in range(1000)]
+    yield "format_mpz", loop(format, mpz(123456789), ">12d")
+    yield "format_mpfr", loop(format, x, ".10e")
+    yield "format_mpc", loop(format, z, ".6f")
+    yield "format_many/1000", loop(gmpy2.format_many, values, "d")
+    yield "digits_many/1000", loop(gmpy2.digits_many, values)
+
+    yield "mpz_small_ops/cached", cache_loop(100)
+    yield "mpz_small_ops/uncached", cache_loop(0)
+
+
+def selected(names, select):
+    return not select or any(s in names for s in select)
+
+
+def environment():
+    return {
+        "python": platform.python_version(),
+        "platform": platform.platform(),
+        "gmpy2": gmpy2.version(),
+        "gmp": gmpy2.mp_version(),
+        "mpfr": gmpy2.mpfr_version(),
+        "mpc": gmpy2.mpc_version(),
+    }
+
+
+def simple_time(timer, repeat=5, target=0.05):
+    """Return the best time per loop, calibrating the number of loops."""
+    loops = 1
+    while True:
+        t = timer(loops)
+        if t >= target or loops >= 10**7:
+            break
+        loops *= 10 if t < target / 10 else 2
+    return min([t] + [timer(loops) for _ in range(repeat - 1)]) / loops
+
+
+def simple_compare(old, new):
+    with open(old) as f:
+        before = json.load(f)["benchmarks"]
+    with open(new) as f:
+        after = json.load(f)["benchmarks"]
+    print("%-28s %12s %12s %8s" % ("benchmark", "before", "after", "ratio"))
+    for name in sorted(set(before) & set(after)):
+        b, a = before[name], after[name]
+        mark = "  slower" if a > 1.1 * b else ("  faster" if a < b / 1.1 else "")
+        print("%-28s %12.3g %12.3g %8.2f%s" % (name, b, a, a / b, mark))
+
+
+def simple_main(args):
+    result = {"environment": environment(), "benchmarks": {}}
+    for name, timer in benchmarks(args.full):
+        if selected(name, args.select):
+            result["benchmarks"][name] = t = simple_time(timer)
+            print("%-28s %.3g s" % (name, t))
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump(result, f, indent=1, sort_keys=True)
+
+
+def main():
+    import argparse
+
+    if "--simple" not in sys.argv and "--compare" not in sys.argv:
+        try:
+            import pyperf
+        except ImportError:
+            pyperf = None
+        if pyperf:
+            runner = pyperf.Runner()
+            runner.argparser.add_argument("--select", action="append")
+            runner.argparser.add_argument("--full", action="store_true")
+            args = runner.parse_args()
+            for key, value in environment().items():
+                runner.metadata[key] = value
+            for name, timer in benchmarks(args.full):
+                if selected(name, args.select):
+                    runner.bench_time_func(name, timer)
+            return
+
+    parser = argparse.ArgumentParser(description="gmpy2 benchmarks")
+    parser.add_argument("--simple", action="store_true",
+                        help="do not use pyperf")
+    parser.add_argument("--select", action="append",
+                        help="only run benchmarks whose name contains SELECT")
+    parser.add_argument("--full", action="store_true",
+                        help="include 10**7 bit operands")
+    parser.add_argument("-o", "--output", help="write the results as JSON")
+    parser.add_argument("--compare", nargs=2, metavar=("OLD", "NEW"),
+                        help="compare two JSON files written with --simple")
+    args = parser.parse_args()
+    if args.compare:
+        simple_compare(*args.compare)
+    else:
+        simple_main(args)
+
+
+if __name__ == "__main__":
+    main()
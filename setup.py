@@ -58,6 +58,9 @@ else:
 #  lib_path is set to 'lib64' or 'lib32' as appropriate.
 #
 #  --shared and --static are converted to -DSHARED and -DSTATIC.
+#
+#  --usdt is converted to -DGMPY_USDT. It compiles in the static probes
+#  described in src/gmpy2_probes.h and requires <sys/sdt.h>.
 
 defines = []
 
@@ -74,6 +77,10 @@ for token in sys.argv[:]:
         lib_path = 'lib32'
         sys.argv.remove(token)
 
+    if token.lower() == '--usdt':
+        defines.append( ('GMPY_USDT', 1) )
+        sys.argv.remove(token)
+
     if token.lower() == '--msys2':
         defines.append( ('MSYS2', 1) )
         sys.argv.remove(token)
@@ -225,6 +232,9 @@ setup(name = "gmpy2",
         'Topic :: Scientific/Engineering :: Mathematics',
         'Topic :: Software Development :: Libraries :: Python Modules',
       ],
+      headers = [os.path.join('src', 'gmpy2_capi.h')],
       cmdclass = my_commands,
+      package_dir = {'': 'src'},
+      py_modules = ['gmpy2_tune'],
       ext_modules = [gmpy2_ext]
 )
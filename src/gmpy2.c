@@ -42,7 +42,7 @@
 
 /*
  * originally written for GMP-2.0 (by AMK...?)
- * Rewritten by Niels Mller, May 1996
+ * Rewritten by Niels Möller, May 1996
  *
  * Version for GMP-4, Python 2.X, with support for MSVC++6,
  * addition of mpf's, &c: Alex Martelli (now aleaxit@gmail.com, Nov 2000).
@@ -395,12 +395,16 @@
 #include <float.h>
 #include <stdio.h>
 #include <ctype.h>
+#include <time.h>
 
+#define GMPY2_MODULE
 #include "gmpy2.h"
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
  * Global data declarations begin here.                                    *
- * NOTE: Because of these global declarations, GMPY2 is not thread-safe!   *
+ * NOTE: The object caches are kept per thread (see gmpy2_cache.c). The    *
+ *       remaining global declarations are only modified while holding     *
+ *       the GIL.                                                          *
  * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
 /* The following global strings are used by gmpy_misc.c. */
@@ -418,36 +422,111 @@ LGPL 3 or later.";
  */
 
 static struct gmpy_global {
-    int cache_size;          /* size of cache, for all caches */
+    int cache_size;          /* default size of cache, for all caches */
     int cache_obsize;        /* maximum size of the objects that are cached */
+    int cache_sizes[GMPY_CACHE_TYPES]; /* size of each cache */
+    int cache_generation;    /* incremented when the cache sizes change */
+    size_t nogil_bits;       /* operand size that releases the GIL */
+    int nogil_mpfr;          /* if 1, MPFR functions may release the GIL */
+    size_t str_cache_limit;  /* bytes of mpz strings that may be kept */
+    size_t str_cache_bytes;  /* bytes of mpz strings currently kept */
+    unsigned long bpsw_trial_limit; /* trial division bound for BPSW tests */
+    size_t pmul_crossover;   /* default crossover of parallel_mul() */
+    size_t pool_min_cost;    /* smallest job that uses the thread pool */
+    size_t barrett_bits;     /* smallest modulus using Barrett reduction */
 } global = {
     100,                     /* cache_size */
-    128,                     /* cache_obsize */
+    1024,                    /* cache_obsize */
+    { 100, 100, 100, 100, 100, 100 },  /* cache_sizes */
+    1,                       /* cache_generation */
+#ifdef WITHOUT_THREADS
+    0,                       /* nogil_bits */
+#else
+    NOGIL_DEFAULT_BITS,      /* nogil_bits */
+#endif
+    0,                       /* nogil_mpfr */
+    0,                       /* str_cache_limit */
+    0,                       /* str_cache_bytes */
+    1000,                    /* bpsw_trial_limit */
+    PMUL_DEFAULT_CROSSOVER,  /* pmul_crossover */
+    GMPY_POOL_MIN_COST,      /* pool_min_cost */
+    MODULUS_BARRETT_BITS,    /* barrett_bits */
 };
 
-static mpz_t* zcache;
-static int in_zcache;
+/* Counters maintained by the custom memory allocation routines. They are
+ * only updated while the GIL is held; see gmpy2_threads.c. */
 
-static MPZ_Object **gmpympzcache;
-static int in_gmpympzcache;
+static struct gmpy_alloc_stats {
+    size_t allocs;           /* calls to gmpy_allocate */
+    size_t reallocs;         /* calls to gmpy_reallocate */
+    size_t frees;            /* calls to gmpy_free */
+    size_t total_bytes;      /* bytes requested by allocate and reallocate */
+    size_t bytes;            /* bytes currently allocated */
+    size_t peak_bytes;       /* high-water mark of bytes */
+    size_t limb_hits;        /* allocations served by the limb cache */
+} alloc_stats;
 
-static XMPZ_Object **gmpyxmpzcache;
-static int in_gmpyxmpzcache;
-
-static MPQ_Object **gmpympqcache;
-static int in_gmpympqcache;
+#ifdef WITHOUT_THREADS
+/* Use a module-level cache. */
+static gmpy_cache module_cache;
+#else
+/* Key for the thread state dictionary entry that owns the thread's cache */
+static PyObject *tls_cache_key = NULL;
+/* The cache of the current thread; NULL until first used */
+static GMPY_TLS gmpy_cache *tls_cache = NULL;
+/* Set once the cache of the current thread has been released */
+static GMPY_TLS int tls_cache_closed = 0;
+#endif
 
-static MPFR_Object **gmpympfrcache;
-static int in_gmpympfrcache;
+/* The shared mpz objects for small values, see gmpy2_cache.c */
+static MPZ_Object *mpz_small[MPZ_SMALL_MAX - MPZ_SMALL_MIN + 1];
+
+/* Support for arena allocation. */
+
+/* All chunks that have not been released, in any thread */
+static gmpy_arena_chunk *arena_chunks = NULL;
+/* The chunk used by the innermost arena of the current thread, or NULL */
+static GMPY_TLS gmpy_arena_chunk *tls_arena = NULL;
+/* Settings of the innermost parallel_mul() manager of the current thread;
+ * tls_pmul_threads is 0 if there is none */
+static GMPY_TLS int tls_pmul_threads = 0;
+static GMPY_TLS size_t tls_pmul_bits = 0;
+/* All files mapped by xmpz_mmap(), see gmpy2_mmap.c */
+static gmpy_mmap_region *mmap_regions = NULL;
+
+/* Support for releasing the GIL. */
+
+#ifndef WITHOUT_THREADS
+/* Number of threads running GMP or MPFR code without the GIL */
+static int nogil_count = 0;
+/* Set while the current thread runs without the GIL */
+static GMPY_TLS int tls_nogil = 0;
+/* Allocation counters of the current thread while it runs without the GIL */
+static GMPY_TLS struct gmpy_nogil_stats tls_alloc_stats;
+/* Thread state saved when the current thread released the GIL; NULL in the
+ * threads of the pool */
+static GMPY_TLS PyThreadState *tls_nogil_save = NULL;
+/* Protects the lists of arena chunks and mapped files while nogil_count
+ * is not 0 */
+static PyThread_type_lock arena_lock = NULL;
+#endif
 
-static MPC_Object **gmpympccache;
-static int in_gmpympccache;
+/* Work done since the last cancellation point polled, see gmpy2_cancel.c */
+static GMPY_TLS size_t tls_cancel_work = 0;
 
 /* Support for context manager. */
 
 #ifdef WITHOUT_THREADS
 /* Use a module-level context. */
 static CTXT_Object *module_context = NULL;
+#elif defined(GMPY_CONTEXTVAR)
+/* The context variable that holds the current context */
+static PyObject *current_context_var = NULL;
+/* The value of current_context_var last seen by the current thread, and
+ * the Python context (with its version) that it was read from */
+static GMPY_TLS CTXT_Object *tls_context = NULL;
+static GMPY_TLS PyObject *tls_context_owner = NULL;
+static GMPY_TLS uint64_t tls_context_ver = 0;
 #else
 /* Key for thread state dictionary */
 static PyObject *tls_context_key = NULL;
@@ -455,6 +534,13 @@ static PyObject *tls_context_key = NULL;
 static CTXT_Object *cached_context = NULL;
 #endif
 
+/* Flags raised by the current thread under frozen contexts, and the entry
+ * to reuse when a context is not in the table */
+static GMPY_TLS gmpy_frozen_flags tls_frozen_flags[FROZEN_FLAGS_SIZE];
+static GMPY_TLS int tls_frozen_next = 0;
+/* The last id given to a frozen context */
+static uint64_t frozen_ids = 0;
+
 
 /* Define gmpy2 specific errors for mpfr and mpc data types. No change will
  * be made the exceptions raised by mpz, xmpz, and mpq.
@@ -477,6 +563,27 @@ static PyObject *GMPyExc_Erange = NULL;
 
 #include "gmpy2_cache.c"
 
+/* Opt-in per-function call counters are in gmpy2_profile.c. */
+
+#include "gmpy2_profile.c"
+
+/* The arena allocator for limbs is in gmpy2_arena.c. */
+
+#include "gmpy2_arena.c"
+
+/* Limbs stored in memory-mapped files are managed by gmpy2_mmap.c. */
+
+#include "gmpy2_mmap.c"
+
+/* Support for releasing the GIL. */
+
+#include "gmpy2_threads.c"
+#include "gmpy2_cancel.c"
+#include "gmpy2_pool.c"
+#include "gmpy2_pmul.c"
+#include "gmpy2_futures.c"
+#include "gmpy2_radix.c"
+
 /* Miscellaneous helper functions and simple methods are in gmpy_misc.c. */
 
 #include "gmpy2_misc.c"
@@ -489,6 +596,10 @@ static PyObject *GMPyExc_Erange = NULL;
 
 #include "gmpy2_binary.c"
 
+/* Values kept in files by set_persistent_cache(). */
+
+#include "gmpy2_pcache.c"
+
 /* Support for conversions to/from numeric types. */
 
 #include "gmpy2_convert.c"
@@ -501,6 +612,14 @@ static PyObject *GMPyExc_Erange = NULL;
 
 #include "gmpy2_random.c"
 
+/* Support for Montgomery arithmetic. */
+
+#include "gmpy2_mont.c"
+
+/* Support for 53-bit mpfr arithmetic with hardware doubles. */
+
+#include "gmpy2_mpfr_d53.c"
+
 /* Support for Lucas sequences. */
 
 #include "gmpy_mpz_lucas.c"
@@ -519,6 +638,7 @@ static PyObject *GMPyExc_Erange = NULL;
 #include "gmpy2_mpz_bitops.c"
 #include "gmpy2_mpz_inplace.c"
 #include "gmpy2_xmpz_inplace.c"
+#include "gmpy2_mpq_small.c"
 
 /* Begin includes of refactored code. */
 
@@ -546,8 +666,31 @@ static PyObject *GMPyExc_Erange = NULL;
 #include "gmpy2_mpc_misc.c"
 #include "gmpy2_mpfr_misc.c"
 #include "gmpy2_mpq_misc.c"
+#include "gmpy2_reduce.c"
 #include "gmpy2_mpz_misc.c"
 #include "gmpy2_xmpz_misc.c"
+#include "gmpy2_xmpz_rank.c"
+#include "gmpy2_vector.c"
+#include "gmpy2_sort.c"
+#include "gmpy2_crt.c"
+#include "gmpy2_rns.c"
+#include "gmpy2_decimal_mpz.c"
+#include "gmpy2_modulus.c"
+#include "gmpy2_primes.c"
+#include "gmpy2_factor.c"
+#include "gmpy2_dlog.c"
+#include "gmpy2_randprime.c"
+#include "gmpy2_combcache.c"
+#include "gmpy2_divset.c"
+#include "gmpy2_binsplit.c"
+#include "gmpy2_mpz_vector.c"
+#include "gmpy2_mpfr_array.c"
+#include "gmpy2_mpfr_ball.c"
+#include "gmpy2_lazy.c"
+#include "gmpy2_fft.c"
+#include "gmpy2_matrix.c"
+#include "gmpy2_ndarray.c"
+#include "gmpy2_tuning.c"
 
 /* Include gmpy_context last to avoid adding doc names to .h files. */
 
@@ -558,135 +701,237 @@ static PyObject *GMPyExc_Erange = NULL;
 #include "gmpy2_mpc.c"
 
 #include "gmpy2_context.c"
+#include "gmpy2_capi.c"
 
 static PyMethodDef Pygmpy_methods [] =
 {
+    { "DivisorSet", GMPy_DivisorSet_Factory, METH_O, GMPy_doc_divisorset_factory },
+    { "Modulus", GMPy_Modulus_Factory, METH_O, GMPy_doc_modulus_factory },
+    { "PowmodTable", GMPY_FASTCALL(GMPy_PowmodTable_Factory), GMPY_METH_FASTCALL, GMPy_doc_powmod_table_factory },
     { "_cvsid", GMPy_get_cvsid, METH_NOARGS, GMPy_doc_cvsid },
+#ifdef GMPY_PICKLE_BUFFER
+    { "_from_limbs", GMPy_MPANY_From_Limbs, METH_VARARGS, GMPy_doc_from_limbs },
+#endif
+    { "arena", (PyCFunction)GMPy_Arena_Factory, METH_VARARGS | METH_KEYWORDS, GMPy_doc_arena },
     { "_printf", GMPy_printf, METH_VARARGS, GMPy_doc_function_printf },
-    { "add", GMPy_Context_Add, METH_VARARGS, GMPy_doc_function_add },
-    { "bit_clear", GMPy_MPZ_bit_clear_function, METH_VARARGS, doc_bit_clear_function },
-    { "bit_flip", GMPy_MPZ_bit_flip_function, METH_VARARGS, doc_bit_flip_function },
+    { "add", GMPY_FASTCALL(GMPy_Context_Add), GMPY_METH_FASTCALL, GMPy_doc_function_add },
+    { "batch_gcd", GMPy_MPZ_Function_BatchGCD, METH_O, GMPy_doc_mpz_function_batch_gcd },
+    { "binary_split", (PyCFunction)GMPy_Function_BinarySplit, METH_VARARGS | METH_KEYWORDS, GMPy_doc_function_binary_split },
+    { "bit_and_many", GMPy_MPZ_bit_and_many, METH_O, doc_bit_and_many },
+    { "bit_clear", GMPY_FASTCALL(GMPy_MPZ_bit_clear_function), GMPY_METH_FASTCALL, doc_bit_clear_function },
+    { "bit_flip", GMPY_FASTCALL(GMPy_MPZ_bit_flip_function), GMPY_METH_FASTCALL, doc_bit_flip_function },
     { "bit_length", GMPy_MPZ_bit_length_function, METH_O, doc_bit_length_function },
     { "bit_mask", GMPy_MPZ_bit_mask, METH_O, doc_bit_mask },
-    { "bit_scan0", GMPy_MPZ_bit_scan0_function, METH_VARARGS, doc_bit_scan0_function },
-    { "bit_scan1", GMPy_MPZ_bit_scan1_function, METH_VARARGS, doc_bit_scan1_function },
-    { "bit_set", GMPy_MPZ_bit_set_function, METH_VARARGS, doc_bit_set_function },
-    { "bit_test", GMPy_MPZ_bit_test_function, METH_VARARGS, doc_bit_test_function },
-    { "bincoef", GMPy_MPZ_Function_Bincoef, METH_VARARGS, GMPy_doc_mpz_function_bincoef },
-    { "comb", GMPy_MPZ_Function_Bincoef, METH_VARARGS, GMPy_doc_mpz_function_comb },
-    { "c_div", GMPy_MPZ_c_div, METH_VARARGS, doc_c_div },
-    { "c_div_2exp", GMPy_MPZ_c_div_2exp, METH_VARARGS, doc_c_div_2exp },
-    { "c_divmod", GMPy_MPZ_c_divmod, METH_VARARGS, doc_c_divmod },
-    { "c_divmod_2exp", GMPy_MPZ_c_divmod_2exp, METH_VARARGS, doc_c_divmod_2exp },
-    { "c_mod", GMPy_MPZ_c_mod, METH_VARARGS, doc_c_mod },
-    { "c_mod_2exp", GMPy_MPZ_c_mod_2exp, METH_VARARGS, doc_c_mod_2exp },
+    { "bit_or_many", GMPy_MPZ_bit_or_many, METH_O, doc_bit_or_many },
+    { "bit_scan0", GMPY_FASTCALL(GMPy_MPZ_bit_scan0_function), GMPY_METH_FASTCALL, doc_bit_scan0_function },
+    { "bit_scan1", GMPY_FASTCALL(GMPy_MPZ_bit_scan1_function), GMPY_METH_FASTCALL, doc_bit_scan1_function },
+    { "bit_set", GMPY_FASTCALL(GMPy_MPZ_bit_set_function), GMPY_METH_FASTCALL, doc_bit_set_function },
+    { "bit_test", GMPY_FASTCALL(GMPy_MPZ_bit_test_function), GMPY_METH_FASTCALL, doc_bit_test_function },
+    { "bit_xor_many", GMPy_MPZ_bit_xor_many, METH_O, doc_bit_xor_many },
+    { "bincoef", GMPY_FASTCALL(GMPy_MPZ_Function_Bincoef), GMPY_METH_FASTCALL, GMPy_doc_mpz_function_bincoef },
+    { "comb", GMPY_FASTCALL(GMPy_MPZ_Function_Bincoef), GMPY_METH_FASTCALL, GMPy_doc_mpz_function_comb },
+    { "comb_row", GMPy_MPZ_Function_CombRow, METH_O, GMPy_doc_mpz_function_comb_row },
+    { "cache_stats", GMPy_cache_stats, METH_NOARGS, GMPy_doc_cache_stats },
+    { "c_div", GMPY_FASTCALL(GMPy_MPZ_c_div), GMPY_METH_FASTCALL, doc_c_div },
+    { "c_div_2exp", GMPY_FASTCALL(GMPy_MPZ_c_div_2exp), GMPY_METH_FASTCALL, doc_c_div_2exp },
+    { "c_divmod", GMPY_FASTCALL(GMPy_MPZ_c_divmod), GMPY_METH_FASTCALL, doc_c_divmod },
+    { "c_divmod_2exp", GMPY_FASTCALL(GMPy_MPZ_c_divmod_2exp), GMPY_METH_FASTCALL, doc_c_divmod_2exp },
+    { "c_mod", GMPY_FASTCALL(GMPy_MPZ_c_mod), GMPY_METH_FASTCALL, doc_c_mod },
+    { "c_mod_2exp", GMPY_FASTCALL(GMPy_MPZ_c_mod_2exp), GMPY_METH_FASTCALL, doc_c_mod_2exp },
+    { "crt", GMPY_FASTCALL(GMPy_MPZ_Function_CRT), GMPY_METH_FASTCALL, GMPy_doc_mpz_function_crt },
+    { "crt_basis", GMPy_CRT_Basis_Factory, METH_O, GMPy_doc_crt_basis_factory },
+    { "decimal_mpz", GMPy_DecMPZ_Factory, METH_VARARGS, GMPy_doc_decimal_mpz_factory },
     { "denom", GMPy_MPQ_Function_Denom, METH_O, GMPy_doc_mpq_function_denom },
     { "digits", GMPy_Context_Digits, METH_VARARGS, GMPy_doc_context_digits },
-    { "div", GMPy_Context_TrueDiv, METH_VARARGS, GMPy_doc_truediv },
-    { "divexact", GMPy_MPZ_Function_Divexact, METH_VARARGS, GMPy_doc_mpz_function_divexact },
-    { "divm", GMPy_MPZ_Function_Divm, METH_VARARGS, GMPy_doc_mpz_function_divm },
-    { "div_mod", GMPy_Context_DivMod, METH_VARARGS, GMPy_doc_divmod },
+    { "digits_many", (PyCFunction)GMPy_Function_DigitsMany, METH_VARARGS | METH_KEYWORDS, GMPy_doc_function_digits_many },
+    { "discrete_log", (PyCFunction)GMPy_MPZ_Function_DiscreteLog, METH_VARARGS | METH_KEYWORDS, GMPy_doc_mpz_function_discrete_log },
+    { "div", GMPY_FASTCALL(GMPy_Context_TrueDiv), GMPY_METH_FASTCALL, GMPy_doc_truediv },
+    { "divexact", GMPY_FASTCALL(GMPy_MPZ_Function_Divexact), GMPY_METH_FASTCALL, GMPy_doc_mpz_function_divexact },
+    { "divm", GMPY_FASTCALL(GMPy_MPZ_Function_Divm), GMPY_METH_FASTCALL, GMPy_doc_mpz_function_divm },
+    { "div_mod", GMPY_FASTCALL(GMPy_Context_DivMod), GMPY_METH_FASTCALL, GMPy_doc_divmod },
     { "double_fac", GMPy_MPZ_Function_DoubleFac, METH_O, GMPy_doc_mpz_function_double_fac },
     { "fac", GMPy_MPZ_Function_Fac, METH_O, GMPy_doc_mpz_function_fac },
+    { "fac_range", GMPY_FASTCALL(GMPy_MPZ_Function_FacRange), GMPY_METH_FASTCALL, GMPy_doc_mpz_function_fac_range },
+    { "factor", (PyCFunction)GMPy_MPZ_Function_Factor, METH_VARARGS | METH_KEYWORDS, GMPy_doc_mpz_function_factor },
+    { "factorint", (PyCFunction)GMPy_MPZ_Function_FactorInt, METH_VARARGS | METH_KEYWORDS, GMPy_doc_mpz_function_factorint },
     { "fib", GMPy_MPZ_Function_Fib, METH_O, GMPy_doc_mpz_function_fib },
     { "fib2", GMPy_MPZ_Function_Fib2, METH_O, GMPy_doc_mpz_function_fib2 },
-    { "floor_div", GMPy_Context_FloorDiv, METH_VARARGS, GMPy_doc_floordiv },
+    { "fib2_mod", GMPy_MPZ_Function_Fib2Mod, METH_VARARGS, GMPy_doc_mpz_function_fib2_mod },
+    { "fib_mod", GMPy_MPZ_Function_FibMod, METH_VARARGS, GMPy_doc_mpz_function_fib_mod },
+    { "floor_div", GMPY_FASTCALL(GMPy_Context_FloorDiv), GMPY_METH_FASTCALL, GMPy_doc_floordiv },
+    { "format_many", (PyCFunction)GMPy_Function_FormatMany, METH_VARARGS | METH_KEYWORDS, GMPy_doc_function_format_many },
     { "from_binary", GMPy_MPANY_From_Binary, METH_O, doc_from_binary },
-    { "f_div", GMPy_MPZ_f_div, METH_VARARGS, doc_f_div },
-    { "f_div_2exp", GMPy_MPZ_f_div_2exp, METH_VARARGS, doc_f_div_2exp },
-    { "f_divmod", GMPy_MPZ_f_divmod, METH_VARARGS, doc_f_divmod },
-    { "f_divmod_2exp", GMPy_MPZ_f_divmod_2exp, METH_VARARGS, doc_f_divmod_2exp },
-    { "f_mod", GMPy_MPZ_f_mod, METH_VARARGS, doc_f_mod },
-    { "f_mod_2exp", GMPy_MPZ_f_mod_2exp, METH_VARARGS, doc_f_mod_2exp },
-    { "gcd", GMPy_MPZ_Function_GCD, METH_VARARGS, GMPy_doc_mpz_function_gcd },
-    { "gcdext", GMPy_MPZ_Function_GCDext, METH_VARARGS, GMPy_doc_mpz_function_gcdext },
+    { "from_binary_many", GMPy_MPANY_From_Binary_Many, METH_O, doc_from_binary_many },
+    { "from_ndarray", GMPy_MPANY_From_NDArray, METH_O, GMPy_doc_from_ndarray },
+    { "f_div", GMPY_FASTCALL(GMPy_MPZ_f_div), GMPY_METH_FASTCALL, doc_f_div },
+    { "f_div_2exp", GMPY_FASTCALL(GMPy_MPZ_f_div_2exp), GMPY_METH_FASTCALL, doc_f_div_2exp },
+    { "f_divmod", GMPY_FASTCALL(GMPy_MPZ_f_divmod), GMPY_METH_FASTCALL, doc_f_divmod },
+    { "f_divmod_2exp", GMPY_FASTCALL(GMPy_MPZ_f_divmod_2exp), GMPY_METH_FASTCALL, doc_f_divmod_2exp },
+    { "f_mod", GMPY_FASTCALL(GMPy_MPZ_f_mod), GMPY_METH_FASTCALL, doc_f_mod },
+    { "f_mod_2exp", GMPY_FASTCALL(GMPy_MPZ_f_mod_2exp), GMPY_METH_FASTCALL, doc_f_mod_2exp },
+    { "gcd", GMPY_FASTCALL(GMPy_MPZ_Function_GCD), GMPY_METH_FASTCALL, GMPy_doc_mpz_function_gcd },
+    { "gcdext", GMPY_FASTCALL(GMPy_MPZ_Function_GCDext), GMPY_METH_FASTCALL, GMPy_doc_mpz_function_gcdext },
+    { "get_bpsw_trial_limit", GMPy_get_bpsw_trial_limit, METH_NOARGS, GMPy_doc_get_bpsw_trial_limit },
     { "get_cache", GMPy_get_cache, METH_NOARGS, GMPy_doc_get_cache },
-    { "hamdist", GMPy_MPZ_hamdist, METH_VARARGS, doc_hamdist },
-    { "invert", GMPy_MPZ_Function_Invert, METH_VARARGS, GMPy_doc_mpz_function_invert },
-    { "iroot", GMPy_MPZ_Function_Iroot, METH_VARARGS, GMPy_doc_mpz_function_iroot },
-    { "iroot_rem", GMPy_MPZ_Function_IrootRem, METH_VARARGS, GMPy_doc_mpz_function_iroot_rem },
+    { "get_comb_cache", GMPy_get_comb_cache, METH_NOARGS, GMPy_doc_get_comb_cache },
+    { "get_nogil_threshold", GMPy_get_nogil_threshold, METH_NOARGS, GMPy_doc_get_nogil_threshold },
+    { "get_persistent_cache", GMPy_get_persistent_cache, METH_NOARGS, GMPy_doc_get_persistent_cache },
+    { "get_radix_cache", GMPy_get_radix_cache, METH_NOARGS, GMPy_doc_get_radix_cache },
+    { "get_str_cache", GMPy_get_str_cache, METH_NOARGS, GMPy_doc_get_str_cache },
+    { "get_threads", GMPy_get_threads, METH_NOARGS, GMPy_doc_get_threads },
+    { "get_tuning", GMPy_get_tuning, METH_NOARGS, GMPy_doc_get_tuning },
+    { "hamdist", GMPY_FASTCALL(GMPy_MPZ_hamdist), GMPY_METH_FASTCALL, doc_hamdist },
+    { "hamdist_many", GMPY_FASTCALL(GMPy_MPZ_hamdist_many), GMPY_METH_FASTCALL, doc_hamdist_many },
+    { "invert", GMPY_FASTCALL(GMPy_MPZ_Function_Invert), GMPY_METH_FASTCALL, GMPy_doc_mpz_function_invert },
+    { "invert_many", GMPY_FASTCALL(GMPy_MPZ_Function_InvertMany), GMPY_METH_FASTCALL, GMPy_doc_mpz_function_invert_many },
+    { "iroot", GMPY_FASTCALL(GMPy_MPZ_Function_Iroot), GMPY_METH_FASTCALL, GMPy_doc_mpz_function_iroot },
+    { "iroot_many", GMPY_FASTCALL(GMPy_MPZ_Function_IrootMany), GMPY_METH_FASTCALL, GMPy_doc_mpz_function_iroot_many },
+    { "iroot_rem", GMPY_FASTCALL(GMPy_MPZ_Function_IrootRem), GMPY_METH_FASTCALL, GMPy_doc_mpz_function_iroot_rem },
     { "isqrt", GMPy_MPZ_Function_Isqrt, METH_O, GMPy_doc_mpz_function_isqrt },
+    { "isqrt_many", GMPy_MPZ_Function_IsqrtMany, METH_O, GMPy_doc_mpz_function_isqrt_many },
     { "isqrt_rem", GMPy_MPZ_Function_IsqrtRem, METH_O, GMPy_doc_mpz_function_isqrt_rem },
-    { "is_bpsw_prp", GMPY_mpz_is_bpsw_prp, METH_VARARGS, doc_mpz_is_bpsw_prp },
-    { "is_congruent", GMPy_MPZ_Function_IsCongruent, METH_VARARGS, GMPy_doc_mpz_function_is_congruent },
-    { "is_divisible", GMPy_MPZ_Function_IsDivisible, METH_VARARGS, GMPy_doc_mpz_function_is_divisible },
+    { "is_bpsw_prp", GMPY_FASTCALL(GMPY_mpz_is_bpsw_prp), GMPY_METH_FASTCALL, doc_mpz_is_bpsw_prp },
+    { "is_bpsw_prp_many", GMPy_MPZ_Function_IsBPSWPrpMany, METH_O, GMPy_doc_mpz_function_is_bpsw_prp_many },
+    { "is_congruent", GMPY_FASTCALL(GMPy_MPZ_Function_IsCongruent), GMPY_METH_FASTCALL, GMPy_doc_mpz_function_is_congruent },
+    { "is_divisible", GMPY_FASTCALL(GMPy_MPZ_Function_IsDivisible), GMPY_METH_FASTCALL, GMPy_doc_mpz_function_is_divisible },
     { "is_even", GMPy_MPZ_Function_IsEven, METH_O, GMPy_doc_mpz_function_is_even },
-    { "is_euler_prp", GMPY_mpz_is_euler_prp, METH_VARARGS, doc_mpz_is_euler_prp },
-    { "is_extra_strong_lucas_prp", GMPY_mpz_is_extrastronglucas_prp, METH_VARARGS, doc_mpz_is_extrastronglucas_prp },
-    { "is_fermat_prp", GMPY_mpz_is_fermat_prp, METH_VARARGS, doc_mpz_is_fermat_prp },
-    { "is_fibonacci_prp", GMPY_mpz_is_fibonacci_prp, METH_VARARGS, doc_mpz_is_fibonacci_prp },
-    { "is_lucas_prp", GMPY_mpz_is_lucas_prp, METH_VARARGS, doc_mpz_is_lucas_prp },
+    { "is_euler_prp", GMPY_FASTCALL(GMPY_mpz_is_euler_prp), GMPY_METH_FASTCALL, doc_mpz_is_euler_prp },
+    { "is_extra_strong_lucas_prp", GMPY_FASTCALL(GMPY_mpz_is_extrastronglucas_prp), GMPY_METH_FASTCALL, doc_mpz_is_extrastronglucas_prp },
+    { "is_fermat_prp", GMPY_FASTCALL(GMPY_mpz_is_fermat_prp), GMPY_METH_FASTCALL, doc_mpz_is_fermat_prp },
+    { "is_fibonacci_prp", GMPY_FASTCALL(GMPY_mpz_is_fibonacci_prp), GMPY_METH_FASTCALL, doc_mpz_is_fibonacci_prp },
+    { "is_lucas_prp", GMPY_FASTCALL(GMPY_mpz_is_lucas_prp), GMPY_METH_FASTCALL, doc_mpz_is_lucas_prp },
     { "is_odd", GMPy_MPZ_Function_IsOdd, METH_O, GMPy_doc_mpz_function_is_odd },
     { "is_power", GMPy_MPZ_Function_IsPower, METH_O, GMPy_doc_mpz_function_is_power },
-    { "is_prime", GMPy_MPZ_Function_IsPrime, METH_VARARGS, GMPy_doc_mpz_function_is_prime },
-    { "is_selfridge_prp", GMPY_mpz_is_selfridge_prp, METH_VARARGS, doc_mpz_is_selfridge_prp },
+    { "is_prime", GMPY_FASTCALL(GMPy_MPZ_Function_IsPrime), GMPY_METH_FASTCALL, GMPy_doc_mpz_function_is_prime },
+    { "is_prime_many", GMPY_FASTCALL(GMPy_MPZ_Function_IsPrimeMany), GMPY_METH_FASTCALL, GMPy_doc_mpz_function_is_prime_many },
+    { "is_selfridge_prp", GMPY_FASTCALL(GMPY_mpz_is_selfridge_prp), GMPY_METH_FASTCALL, doc_mpz_is_selfridge_prp },
     { "is_square", GMPy_MPZ_Function_IsSquare, METH_O, GMPy_doc_mpz_function_is_square },
-    { "is_strong_prp", GMPY_mpz_is_strong_prp, METH_VARARGS, doc_mpz_is_strong_prp },
-    { "is_strong_bpsw_prp", GMPY_mpz_is_strongbpsw_prp, METH_VARARGS, doc_mpz_is_strongbpsw_prp },
-    { "is_strong_lucas_prp", GMPY_mpz_is_stronglucas_prp, METH_VARARGS, doc_mpz_is_stronglucas_prp },
-    { "is_strong_selfridge_prp", GMPY_mpz_is_strongselfridge_prp, METH_VARARGS, doc_mpz_is_strongselfridge_prp },
-    { "jacobi", GMPy_MPZ_Function_Jacobi, METH_VARARGS, GMPy_doc_mpz_function_jacobi },
-    { "kronecker", GMPy_MPZ_Function_Kronecker, METH_VARARGS, GMPy_doc_mpz_function_kronecker },
-    { "lcm", GMPy_MPZ_Function_LCM, METH_VARARGS, GMPy_doc_mpz_function_lcm },
-    { "legendre", GMPy_MPZ_Function_Legendre, METH_VARARGS, GMPy_doc_mpz_function_legendre },
+    { "is_strong_prp", GMPY_FASTCALL(GMPY_mpz_is_strong_prp), GMPY_METH_FASTCALL, doc_mpz_is_strong_prp },
+    { "is_strong_bpsw_prp", GMPY_FASTCALL(GMPY_mpz_is_strongbpsw_prp), GMPY_METH_FASTCALL, doc_mpz_is_strongbpsw_prp },
+    { "is_strong_lucas_prp", GMPY_FASTCALL(GMPY_mpz_is_stronglucas_prp), GMPY_METH_FASTCALL, doc_mpz_is_stronglucas_prp },
+    { "is_strong_selfridge_prp", GMPY_FASTCALL(GMPY_mpz_is_strongselfridge_prp), GMPY_METH_FASTCALL, doc_mpz_is_strongselfridge_prp },
+    { "jacobi", GMPY_FASTCALL(GMPy_MPZ_Function_Jacobi), GMPY_METH_FASTCALL, GMPy_doc_mpz_function_jacobi },
+    { "jacobi_many", GMPy_MPZ_Function_JacobiMany, METH_VARARGS, GMPy_doc_mpz_function_jacobi_many },
+    { "kronecker", GMPY_FASTCALL(GMPy_MPZ_Function_Kronecker), GMPY_METH_FASTCALL, GMPy_doc_mpz_function_kronecker },
+    { "lazy", GMPy_Lazy_Factory, METH_O, GMPy_doc_lazy_factory },
+    { "lcm", GMPY_FASTCALL(GMPy_MPZ_Function_LCM), GMPY_METH_FASTCALL, GMPy_doc_mpz_function_lcm },
+    { "legendre", GMPY_FASTCALL(GMPy_MPZ_Function_Legendre), GMPY_METH_FASTCALL, GMPy_doc_mpz_function_legendre },
+    { "legendre_many", GMPy_MPZ_Function_LegendreMany, METH_VARARGS, GMPy_doc_mpz_function_legendre_many },
     { "license", GMPy_get_license, METH_NOARGS, GMPy_doc_license },
     { "lucas", GMPy_MPZ_Function_Lucas, METH_O, GMPy_doc_mpz_function_lucas },
-    { "lucasu", GMPY_mpz_lucasu, METH_VARARGS, doc_mpz_lucasu },
-    { "lucasu_mod", GMPY_mpz_lucasu_mod, METH_VARARGS, doc_mpz_lucasu_mod },
-    { "lucasv", GMPY_mpz_lucasv, METH_VARARGS, doc_mpz_lucasv },
-    { "lucasv_mod", GMPY_mpz_lucasv_mod, METH_VARARGS, doc_mpz_lucasv_mod },
+    { "lucasu", GMPY_FASTCALL(GMPY_mpz_lucasu), GMPY_METH_FASTCALL, doc_mpz_lucasu },
+    { "lucasu_mod", GMPY_FASTCALL(GMPY_mpz_lucasu_mod), GMPY_METH_FASTCALL, doc_mpz_lucasu_mod },
+    { "lucasv", GMPY_FASTCALL(GMPY_mpz_lucasv), GMPY_METH_FASTCALL, doc_mpz_lucasv },
+    { "lucasv_mod", GMPY_FASTCALL(GMPY_mpz_lucasv_mod), GMPY_METH_FASTCALL, doc_mpz_lucasv_mod },
     { "lucas2", GMPy_MPZ_Function_Lucas2, METH_O, GMPy_doc_mpz_function_lucas2 },
-    { "mod", GMPy_Context_Mod, METH_VARARGS, GMPy_doc_mod },
+    { "lucas2_mod", GMPy_MPZ_Function_Lucas2Mod, METH_VARARGS, GMPy_doc_mpz_function_lucas2_mod },
+    { "lucas_mod", GMPy_MPZ_Function_LucasMod, METH_VARARGS, GMPy_doc_mpz_function_lucas_mod },
+    { "lucas_uv_mod", GMPY_FASTCALL(GMPY_mpz_lucas_uv_mod), GMPY_METH_FASTCALL, doc_mpz_lucas_uv_mod },
+    { "mod", GMPY_FASTCALL(GMPy_Context_Mod), GMPY_METH_FASTCALL, GMPy_doc_mod },
     { "mp_version", GMPy_get_mp_version, METH_NOARGS, GMPy_doc_mp_version },
     { "mp_limbsize", GMPy_get_mp_limbsize, METH_NOARGS, GMPy_doc_mp_limbsize },
     { "mpc_version", GMPy_get_mpc_version, METH_NOARGS, GMPy_doc_mpc_version },
     { "mpfr_version", GMPy_get_mpfr_version, METH_NOARGS, GMPy_doc_mpfr_version },
     { "mpq", (PyCFunction)GMPy_MPQ_Factory, METH_VARARGS | METH_KEYWORDS, GMPy_doc_mpq_factory },
     { "mpq_from_old_binary", GMPy_MPQ_From_Old_Binary, METH_O, doc_mpq_from_old_binary },
-    { "mpz", (PyCFunction)GMPy_MPZ_Factory, METH_VARARGS | METH_KEYWORDS, GMPy_doc_mpz_factory },
+    { "mpq_many", GMPy_MPQ_Function_Many, METH_VARARGS, GMPy_doc_function_mpq_many },
+    { "mpz", GMPY_FASTCALL_KEYWORDS(GMPy_MPZ_Factory), GMPY_METH_FASTCALL_KEYWORDS, GMPy_doc_mpz_factory },
+    { "mpz_from_buffer", (PyCFunction)GMPy_MPZ_From_Buffer, METH_VARARGS | METH_KEYWORDS, doc_mpz_from_buffer },
+#ifdef PY3
+    { "mpz_from_bytes", (PyCFunction)GMPy_MPZ_Method_FromBytes, METH_VARARGS | METH_KEYWORDS, GMPy_doc_mpz_method_from_bytes },
+#endif
     { "mpz_from_old_binary", GMPy_MPZ_From_Old_Binary, METH_O, doc_mpz_from_old_binary },
-    { "mpz_random", GMPy_MPZ_random_Function, METH_VARARGS, GMPy_doc_mpz_random_function },
-    { "mpz_rrandomb", GMPy_MPZ_rrandomb_Function, METH_VARARGS, GMPy_doc_mpz_rrandomb_function },
-    { "mpz_urandomb", GMPy_MPZ_urandomb_Function, METH_VARARGS, GMPy_doc_mpz_urandomb_function },
-    { "mul", GMPy_Context_Mul, METH_VARARGS, GMPy_doc_function_mul },
-    { "multi_fac", GMPy_MPZ_Function_MultiFac, METH_VARARGS, GMPy_doc_mpz_function_multi_fac },
+    { "mpz_random", (PyCFunction)GMPy_MPZ_random_Function, METH_VARARGS | METH_KEYWORDS, GMPy_doc_mpz_random_function },
+    { "mpz_rrandomb", (PyCFunction)GMPy_MPZ_rrandomb_Function, METH_VARARGS | METH_KEYWORDS, GMPy_doc_mpz_rrandomb_function },
+    { "mpz_urandomb", (PyCFunction)GMPy_MPZ_urandomb_Function, METH_VARARGS | METH_KEYWORDS, GMPy_doc_mpz_urandomb_function },
+    { "mpz_vector", GMPy_MPZVector_Factory, METH_VARARGS, GMPy_doc_mpz_vector_factory },
+    { "mul", GMPY_FASTCALL(GMPy_Context_Mul), GMPY_METH_FASTCALL, GMPy_doc_function_mul },
+    { "multi_fac", GMPY_FASTCALL(GMPy_MPZ_Function_MultiFac), GMPY_METH_FASTCALL, GMPy_doc_mpz_function_multi_fac },
     { "next_prime", GMPy_MPZ_Function_NextPrime, METH_O, GMPy_doc_mpz_function_next_prime },
     { "numer", GMPy_MPQ_Function_Numer, METH_O, GMPy_doc_mpq_function_numer },
-    { "num_digits", GMPy_MPZ_Function_NumDigits, METH_VARARGS, GMPy_doc_mpz_function_num_digits },
-    { "pack", GMPy_MPZ_pack, METH_VARARGS, doc_pack },
+    { "num_digits", GMPY_FASTCALL(GMPy_MPZ_Function_NumDigits), GMPY_METH_FASTCALL, GMPy_doc_mpz_function_num_digits },
+    { "pack", GMPY_FASTCALL(GMPy_MPZ_pack), GMPY_METH_FASTCALL, doc_pack },
+    { "parallel_mul", (PyCFunction)GMPy_PMUL_Factory, METH_VARARGS | METH_KEYWORDS, GMPy_doc_parallel_mul },
+    { "perfect_power", GMPy_MPZ_Function_PerfectPower, METH_O, GMPy_doc_mpz_function_perfect_power },
+    { "poly_mul", GMPY_FASTCALL(GMPy_MPZ_Function_PolyMul), GMPY_METH_FASTCALL, GMPy_doc_mpz_function_poly_mul },
+    { "poly_mulmod", GMPY_FASTCALL(GMPy_MPZ_Function_PolyMulmod), GMPY_METH_FASTCALL, GMPy_doc_mpz_function_poly_mulmod },
+    { "poly_sqr", GMPy_MPZ_Function_PolySqr, METH_O, GMPy_doc_mpz_function_poly_sqr },
     { "popcount", GMPy_MPZ_popcount, METH_O, doc_popcount },
-    { "powmod", GMPy_Integer_PowMod, METH_VARARGS, GMPy_doc_integer_powmod },
+    { "popcount_many", GMPy_MPZ_popcount_many, METH_O, doc_popcount_many },
+    { "powmod", GMPY_FASTCALL(GMPy_Integer_PowMod), GMPY_METH_FASTCALL, GMPy_doc_integer_powmod },
+    { "powmod_base_many", GMPY_FASTCALL(GMPy_Integer_PowModBaseMany), GMPY_METH_FASTCALL, GMPy_doc_integer_powmod_base_many },
+    { "powmod_many", GMPY_FASTCALL(GMPy_Integer_PowModMany), GMPY_METH_FASTCALL, GMPy_doc_integer_powmod_many },
+    { "powmod_prod", GMPY_FASTCALL(GMPy_Integer_PowModProd), GMPY_METH_FASTCALL, GMPy_doc_integer_powmod_prod },
+    { "prewarm", GMPy_prewarm, METH_VARARGS, GMPy_doc_prewarm },
+    { "primes", GMPY_FASTCALL(GMPy_Primes_Factory), GMPY_METH_FASTCALL, GMPy_doc_primes_factory },
     { "primorial", GMPy_MPZ_Function_Primorial, METH_O, GMPy_doc_mpz_function_primorial },
-    { "qdiv", GMPy_MPQ_Function_Qdiv, METH_VARARGS, GMPy_doc_function_qdiv },
-    { "remove", GMPy_MPZ_Function_Remove, METH_VARARGS, GMPy_doc_mpz_function_remove },
-    { "random_state", GMPy_RandomState_Factory, METH_VARARGS, GMPy_doc_random_state_factory },
-    { "set_cache", GMPy_set_cache, METH_VARARGS, GMPy_doc_set_cache },
+    { "prod", (PyCFunction)GMPy_Context_Prod, METH_VARARGS | METH_KEYWORDS, GMPy_doc_function_prod },
+    { "profile", GMPY_FASTCALL(GMPy_Profile), GMPY_METH_FASTCALL, GMPy_doc_profile },
+    { "profile_stats", GMPY_FASTCALL(GMPy_Profile_Stats), GMPY_METH_FASTCALL, GMPy_doc_profile_stats },
+    { "profile_text", GMPy_Profile_Text, METH_NOARGS, GMPy_doc_profile_text },
+    { "qdiv", GMPY_FASTCALL(GMPy_MPQ_Function_Qdiv), GMPY_METH_FASTCALL, GMPy_doc_function_qdiv },
+    { "qdot", GMPY_FASTCALL(GMPy_MPQ_Function_Qdot), GMPY_METH_FASTCALL, GMPy_doc_function_qdot },
+    { "qsum", GMPy_MPQ_Function_Qsum, METH_O, GMPy_doc_function_qsum },
+    { "remove", GMPY_FASTCALL(GMPy_MPZ_Function_Remove), GMPY_METH_FASTCALL, GMPy_doc_mpz_function_remove },
+    { "random_prime", (PyCFunction)GMPy_MPZ_Function_RandomPrime, METH_VARARGS | METH_KEYWORDS, GMPy_doc_mpz_function_random_prime },
+    { "random_safe_prime", (PyCFunction)GMPy_MPZ_Function_RandomSafePrime, METH_VARARGS | METH_KEYWORDS, GMPy_doc_mpz_function_random_safe_prime },
+    { "random_state", GMPY_FASTCALL(GMPy_RandomState_Factory), GMPY_METH_FASTCALL, GMPy_doc_random_state_factory },
+    { "rns_int", GMPY_FASTCALL(GMPy_RNS_Factory), GMPY_METH_FASTCALL, GMPy_doc_rns_int },
+    { "rns_many", GMPY_FASTCALL(GMPy_RNS_Function_Many), GMPY_METH_FASTCALL, GMPy_doc_rns_many },
+    { "searchsorted", (PyCFunction)GMPy_Function_SearchSorted, METH_VARARGS | METH_KEYWORDS, GMPy_doc_function_searchsorted },
+    { "set_bpsw_trial_limit", GMPy_set_bpsw_trial_limit, METH_O, GMPy_doc_set_bpsw_trial_limit },
+    { "set_cache", (PyCFunction)GMPy_set_cache, METH_VARARGS | METH_KEYWORDS, GMPy_doc_set_cache },
+    { "set_comb_cache", GMPy_set_comb_cache, METH_O, GMPy_doc_set_comb_cache },
+    { "set_nogil_threshold", GMPy_set_nogil_threshold, METH_O, GMPy_doc_set_nogil_threshold },
+    { "set_persistent_cache", GMPy_set_persistent_cache, METH_O, GMPy_doc_set_persistent_cache },
+    { "set_radix_cache", GMPy_set_radix_cache, METH_O, GMPy_doc_set_radix_cache },
+    { "set_str_cache", GMPy_set_str_cache, METH_O, GMPy_doc_set_str_cache },
+    { "set_threads", GMPy_set_threads, METH_O, GMPy_doc_set_threads },
+    { "set_tuning", (PyCFunction)GMPy_set_tuning, METH_VARARGS | METH_KEYWORDS, GMPy_doc_set_tuning },
     { "sign", GMPy_Context_Sign, METH_O, GMPy_doc_function_sign },
+    { "sort", (PyCFunction)GMPy_Function_Sort, METH_VARARGS | METH_KEYWORDS, GMPy_doc_function_sort },
+    { "sqrtmod", GMPY_FASTCALL(GMPy_MPZ_Function_Sqrtmod), GMPY_METH_FASTCALL, GMPy_doc_mpz_function_sqrtmod },
+    { "sqrtmod_prime_power", GMPY_FASTCALL(GMPy_MPZ_Function_SqrtmodPrimePower), GMPY_METH_FASTCALL, GMPy_doc_mpz_function_sqrtmod_prime_power },
     { "square", GMPy_Context_Square, METH_O, GMPy_doc_function_square },
-    { "sub", GMPy_Context_Sub, METH_VARARGS, GMPy_doc_sub },
-    { "to_binary", GMPy_MPANY_To_Binary, METH_O, doc_to_binary },
-    { "t_div", GMPy_MPZ_t_div, METH_VARARGS, doc_t_div },
-    { "t_div_2exp", GMPy_MPZ_t_div_2exp, METH_VARARGS, doc_t_div_2exp },
-    { "t_divmod", GMPy_MPZ_t_divmod, METH_VARARGS, doc_t_divmod },
-    { "t_divmod_2exp", GMPy_MPZ_t_divmod_2exp, METH_VARARGS, doc_t_divmod_2exp },
-    { "t_mod", GMPy_MPZ_t_mod, METH_VARARGS, doc_t_mod },
-    { "t_mod_2exp", GMPy_MPZ_t_mod_2exp, METH_VARARGS, doc_t_mod_2exp },
-    { "unpack", GMPy_MPZ_unpack, METH_VARARGS, doc_unpack },
+    { "sub", GMPY_FASTCALL(GMPy_Context_Sub), GMPY_METH_FASTCALL, GMPy_doc_sub },
+    { "submit", (PyCFunction)GMPy_submit, METH_VARARGS | METH_KEYWORDS, GMPy_doc_submit },
+    { "submit_async", (PyCFunction)GMPy_submit_async, METH_VARARGS | METH_KEYWORDS, GMPy_doc_submit_async },
+    { "sum", (PyCFunction)GMPy_Function_Sum, METH_VARARGS | METH_KEYWORDS, GMPy_doc_function_sum },
+    { "to_binary", (PyCFunction)GMPy_MPANY_To_Binary_Function, METH_VARARGS | METH_KEYWORDS, doc_to_binary },
+    { "to_binary_many", (PyCFunction)GMPy_MPANY_To_Binary_Many, METH_VARARGS | METH_KEYWORDS, doc_to_binary_many },
+    { "to_ndarray", GMPY_FASTCALL(GMPy_MPANY_To_NDArray), GMPY_METH_FASTCALL, GMPy_doc_to_ndarray },
+    { "t_div", GMPY_FASTCALL(GMPy_MPZ_t_div), GMPY_METH_FASTCALL, doc_t_div },
+    { "t_div_2exp", GMPY_FASTCALL(GMPy_MPZ_t_div_2exp), GMPY_METH_FASTCALL, doc_t_div_2exp },
+    { "t_divmod", GMPY_FASTCALL(GMPy_MPZ_t_divmod), GMPY_METH_FASTCALL, doc_t_divmod },
+    { "t_divmod_2exp", GMPY_FASTCALL(GMPy_MPZ_t_divmod_2exp), GMPY_METH_FASTCALL, doc_t_divmod_2exp },
+    { "t_mod", GMPY_FASTCALL(GMPy_MPZ_t_mod), GMPY_METH_FASTCALL, doc_t_mod },
+    { "t_mod_2exp", GMPY_FASTCALL(GMPy_MPZ_t_mod_2exp), GMPY_METH_FASTCALL, doc_t_mod_2exp },
+    { "unpack", GMPY_FASTCALL(GMPy_MPZ_unpack), GMPY_METH_FASTCALL, doc_unpack },
+    { "unpack_buffer", GMPy_MPZ_unpack_buffer, METH_VARARGS, doc_unpack_buffer },
+    { "vadd", GMPy_Context_VAdd, METH_VARARGS, GMPy_doc_context_vadd },
+    { "vdiv", GMPy_Context_VDiv, METH_VARARGS, GMPy_doc_context_vdiv },
     { "version", GMPy_get_version, METH_NOARGS, GMPy_doc_version },
+    { "vmul", GMPy_Context_VMul, METH_VARARGS, GMPy_doc_context_vmul },
+    { "vsub", GMPy_Context_VSub, METH_VARARGS, GMPy_doc_context_vsub },
     { "xbit_mask", GMPy_XMPZ_Function_XbitMask, METH_O, GMPy_doc_xmpz_function_xbit_mask },
     { "xmpz", (PyCFunction)GMPy_XMPZ_Factory, METH_VARARGS | METH_KEYWORDS, GMPy_doc_xmpz_factory },
-    { "_mpmath_normalize", Pympz_mpmath_normalize, METH_VARARGS, doc_mpmath_normalizeg },
-    { "_mpmath_create", Pympz_mpmath_create, METH_VARARGS, doc_mpmath_createg },
+    { "xmpz_mmap", GMPy_XMPZ_Mmap, METH_VARARGS, GMPy_doc_xmpz_mmap },
+    { "_mpmath_normalize", GMPY_FASTCALL(Pympz_mpmath_normalize), GMPY_METH_FASTCALL, doc_mpmath_normalizeg },
+    { "_mpmath_create", GMPY_FASTCALL(Pympz_mpmath_create), GMPY_METH_FASTCALL, doc_mpmath_createg },
+    { "_mpmath_add", GMPY_FASTCALL(Pympz_mpmath_add), GMPY_METH_FASTCALL, doc_mpmath_addg },
+    { "_mpmath_mul", GMPY_FASTCALL(Pympz_mpmath_mul), GMPY_METH_FASTCALL, doc_mpmath_mulg },
+    { "_mpmath_div", GMPY_FASTCALL(Pympz_mpmath_div), GMPY_METH_FASTCALL, doc_mpmath_divg },
+    { "_mpmath_sqrt", GMPY_FASTCALL(Pympz_mpmath_sqrt), GMPY_METH_FASTCALL, doc_mpmath_sqrtg },
 
     { "acos", GMPy_Context_Acos, METH_O, GMPy_doc_function_acos },
     { "acosh", GMPy_Context_Acosh, METH_O, GMPy_doc_function_acosh },
     { "ai", GMPy_Context_Ai, METH_O, GMPy_doc_function_ai },
-    { "agm", GMPy_Context_AGM, METH_VARARGS, GMPy_doc_function_agm },
+    { "agm", GMPY_FASTCALL(GMPy_Context_AGM), GMPY_METH_FASTCALL, GMPy_doc_function_agm },
     { "asin", GMPy_Context_Asin, METH_O, GMPy_doc_function_asin },
     { "asinh", GMPy_Context_Asinh, METH_O, GMPy_doc_function_asinh },
     { "atan", GMPy_Context_Atan, METH_O, GMPy_doc_function_atan },
     { "atanh", GMPy_Context_Atanh, METH_O, GMPy_doc_function_atanh },
-    { "atan2", GMPy_Context_Atan2, METH_VARARGS, GMPy_doc_function_atan2 },
+    { "atan2", GMPY_FASTCALL(GMPy_Context_Atan2), GMPY_METH_FASTCALL, GMPy_doc_function_atan2 },
     { "can_round", GMPy_MPFR_Can_Round, METH_VARARGS, GMPy_doc_mpfr_can_round },
     { "cbrt", GMPy_Context_Cbrt, METH_O, GMPy_doc_function_cbrt },
     { "ceil", GMPy_Context_Ceil, METH_O, GMPy_doc_function_ceil },
@@ -696,7 +941,7 @@ static PyMethodDef Pygmpy_methods [] =
     { "const_log2", (PyCFunction)GMPy_Function_Const_Log2, METH_VARARGS | METH_KEYWORDS, GMPy_doc_function_const_log2 },
     { "const_pi", (PyCFunction)GMPy_Function_Const_Pi, METH_VARARGS | METH_KEYWORDS, GMPy_doc_function_const_pi },
     { "context", (PyCFunction)GMPy_CTXT_Context, METH_VARARGS | METH_KEYWORDS, GMPy_doc_context },
-    { "copy_sign", GMPy_MPFR_copy_sign, METH_VARARGS, GMPy_doc_mpfr_copy_sign },
+    { "copy_sign", GMPY_FASTCALL(GMPy_MPFR_copy_sign), GMPY_METH_FASTCALL, GMPy_doc_mpfr_copy_sign },
     { "cos", GMPy_Context_Cos, METH_O, GMPy_doc_function_cos },
     { "cosh", GMPy_Context_Cosh, METH_O, GMPy_doc_function_cosh },
     { "cot", GMPy_Context_Cot, METH_O, GMPy_doc_function_cot },
@@ -704,8 +949,10 @@ static PyMethodDef Pygmpy_methods [] =
     { "csc", GMPy_Context_Csc, METH_O, GMPy_doc_function_csc },
     { "csch", GMPy_Context_Csch, METH_O, GMPy_doc_function_csch },
     { "degrees", GMPy_Context_Degrees, METH_O, GMPy_doc_function_degrees },
+    { "det", GMPy_Context_Det, METH_O, GMPy_doc_function_det },
     { "digamma", GMPy_Context_Digamma, METH_O, GMPy_doc_function_digamma },
-    { "div_2exp", GMPy_Context_Div_2exp, METH_VARARGS, GMPy_doc_function_div_2exp },
+    { "div_2exp", GMPY_FASTCALL(GMPy_Context_Div_2exp), GMPY_METH_FASTCALL, GMPy_doc_function_div_2exp },
+    { "dot", GMPY_FASTCALL(GMPy_Context_Dot), GMPY_METH_FASTCALL, GMPy_doc_function_dot },
     { "eint", GMPy_Context_Eint, METH_O, GMPy_doc_function_eint },
     { "erf", GMPy_Context_Erf, METH_O, GMPy_doc_function_erf },
     { "erfc", GMPy_Context_Erfc, METH_O, GMPy_doc_function_erfc },
@@ -713,35 +960,37 @@ static PyMethodDef Pygmpy_methods [] =
     { "expm1", GMPy_Context_Expm1, METH_O, GMPy_doc_function_expm1 },
     { "exp10", GMPy_Context_Exp10, METH_O, GMPy_doc_function_exp10 },
     { "exp2", GMPy_Context_Exp2, METH_O, GMPy_doc_function_exp2 },
-    { "f2q", GMPy_Context_F2Q, METH_VARARGS, GMPy_doc_function_f2q },
+    { "f2q", GMPY_FASTCALL(GMPy_Context_F2Q), GMPY_METH_FASTCALL, GMPy_doc_function_f2q },
     { "factorial", GMPy_Context_Factorial, METH_O, GMPy_doc_function_factorial },
+    { "fft", GMPy_Context_FFT, METH_O, GMPy_doc_function_fft },
     { "floor", GMPy_Context_Floor, METH_O, GMPy_doc_function_floor },
-    { "fma", GMPy_Context_FMA, METH_VARARGS, GMPy_doc_function_fma },
-    { "fms", GMPy_Context_FMS, METH_VARARGS, GMPy_doc_function_fms },
-    { "fmod", GMPy_Context_Fmod, METH_VARARGS, GMPy_doc_function_fmod },
+    { "fma", GMPY_FASTCALL(GMPy_Context_FMA), GMPY_METH_FASTCALL, GMPy_doc_function_fma },
+    { "fms", GMPY_FASTCALL(GMPy_Context_FMS), GMPY_METH_FASTCALL, GMPy_doc_function_fms },
+    { "fmod", GMPY_FASTCALL(GMPy_Context_Fmod), GMPY_METH_FASTCALL, GMPy_doc_function_fmod },
     { "frac", GMPy_Context_Frac, METH_O, GMPy_doc_function_frac },
     { "free_cache", GMPy_MPFR_Free_Cache, METH_NOARGS, GMPy_doc_mpfr_free_cache },
     { "frexp", GMPy_Context_Frexp, METH_O, GMPy_doc_function_frexp },
-    { "fsum", GMPy_Context_Fsum, METH_O, GMPy_doc_function_fsum },
+    { "fsum", (PyCFunction)GMPy_Context_Fsum, METH_VARARGS | METH_KEYWORDS, GMPy_doc_function_fsum },
     { "gamma", GMPy_Context_Gamma, METH_O, GMPy_doc_function_gamma },
     { "get_context", GMPy_CTXT_Get, METH_NOARGS, GMPy_doc_get_context },
     { "get_emax_max", GMPy_MPFR_get_emax_max, METH_NOARGS, GMPy_doc_mpfr_get_emax_max },
     { "get_emin_min", GMPy_MPFR_get_emin_min, METH_NOARGS, GMPy_doc_mpfr_get_emin_min },
     { "get_exp", GMPy_MPFR_get_exp, METH_O, GMPy_doc_mpfr_get_exp },
     { "get_max_precision", GMPy_MPFR_get_max_precision, METH_NOARGS, GMPy_doc_mpfr_get_max_precision },
-    { "hypot", GMPy_Context_Hypot, METH_VARARGS, GMPy_doc_function_hypot },
+    { "hypot", GMPY_FASTCALL(GMPy_Context_Hypot), GMPY_METH_FASTCALL, GMPy_doc_function_hypot },
     { "ieee", GMPy_CTXT_ieee, METH_O, GMPy_doc_context_ieee },
-    { "inf", GMPy_MPFR_set_inf, METH_VARARGS, GMPy_doc_mpfr_set_inf },
+    { "ifft", GMPy_Context_IFFT, METH_O, GMPy_doc_function_ifft },
+    { "inf", GMPY_FASTCALL(GMPy_MPFR_set_inf), GMPY_METH_FASTCALL, GMPy_doc_mpfr_set_inf },
     { "is_finite", GMPy_Context_Is_Finite, METH_O, GMPy_doc_function_is_finite },
     { "is_infinite", GMPy_Context_Is_Infinite, METH_O, GMPy_doc_function_is_infinite },
     { "is_integer", GMPy_Context_Is_Integer, METH_O, GMPy_doc_function_is_integer },
-    { "is_lessgreater", GMPy_Context_Is_LessGreater, METH_VARARGS, GMPy_doc_function_is_lessgreater },
+    { "is_lessgreater", GMPY_FASTCALL(GMPy_Context_Is_LessGreater), GMPY_METH_FASTCALL, GMPy_doc_function_is_lessgreater },
     { "is_nan", GMPy_Context_Is_NAN, METH_O, GMPy_doc_function_is_nan },
     { "is_regular", GMPy_Context_Is_Regular, METH_O, GMPy_doc_function_is_regular },
     { "is_signed", GMPy_Context_Is_Signed, METH_O, GMPy_doc_function_is_signed },
-    { "is_unordered", GMPy_Context_Is_Unordered, METH_VARARGS, GMPy_doc_function_is_unordered },
+    { "is_unordered", GMPY_FASTCALL(GMPy_Context_Is_Unordered), GMPY_METH_FASTCALL, GMPy_doc_function_is_unordered },
     { "is_zero", GMPy_Context_Is_Zero, METH_O, GMPy_doc_function_is_zero },
-    { "jn", GMPy_Context_Jn, METH_VARARGS, GMPy_doc_function_jn },
+    { "jn", GMPY_FASTCALL(GMPy_Context_Jn), GMPY_METH_FASTCALL, GMPy_doc_function_jn },
     { "j0", GMPy_Context_J0, METH_O, GMPy_doc_function_j0 },
     { "j1", GMPy_Context_J1, METH_O, GMPy_doc_function_j1 },
     { "lgamma", GMPy_Context_Lgamma, METH_O, GMPy_doc_function_lgamma },
@@ -752,57 +1001,67 @@ static PyMethodDef Pygmpy_methods [] =
     { "log1p", GMPy_Context_Log1p, METH_O, GMPy_doc_function_log1p },
     { "log10", GMPy_Context_Log10, METH_O, GMPy_doc_function_log10 },
     { "log2", GMPy_Context_Log2, METH_O, GMPy_doc_function_log2 },
-    { "maxnum", GMPy_Context_Maxnum, METH_VARARGS, GMPy_doc_function_maxnum },
-    { "minnum", GMPy_Context_Minnum, METH_VARARGS, GMPy_doc_function_minnum },
+    { "matmul", GMPY_FASTCALL(GMPy_Context_MatMul), GMPY_METH_FASTCALL, GMPy_doc_function_matmul },
+    { "maxnum", GMPY_FASTCALL(GMPy_Context_Maxnum), GMPY_METH_FASTCALL, GMPy_doc_function_maxnum },
+    { "minnum", GMPY_FASTCALL(GMPy_Context_Minnum), GMPY_METH_FASTCALL, GMPy_doc_function_minnum },
     { "modf", GMPy_Context_Modf, METH_O, GMPy_doc_function_modf },
-    { "mpfr", (PyCFunction)GMPy_MPFR_Factory, METH_VARARGS | METH_KEYWORDS, GMPy_doc_mpfr_factory },
+    { "mpfr", GMPY_FASTCALL_KEYWORDS(GMPy_MPFR_Factory), GMPY_METH_FASTCALL_KEYWORDS, GMPy_doc_mpfr_factory },
+    { "mpfr_array", (PyCFunction)GMPy_MPFRArray_Factory, METH_VARARGS | METH_KEYWORDS, GMPy_doc_mpfr_array_factory },
+    { "mpfr_ball", (PyCFunction)GMPy_Ball_Factory, METH_VARARGS | METH_KEYWORDS, GMPy_doc_mpfr_ball_factory },
     { "mpfr_from_old_binary", GMPy_MPFR_From_Old_Binary, METH_O, doc_mpfr_from_old_binary },
-    { "mpfr_random", GMPy_MPFR_random_Function, METH_VARARGS, GMPy_doc_mpfr_random_function },
-    { "mpfr_grandom", GMPy_MPFR_grandom_Function, METH_VARARGS, GMPy_doc_mpfr_grandom_function },
-    { "mul_2exp", GMPy_Context_Mul_2exp, METH_VARARGS, GMPy_doc_function_mul_2exp },
+    { "mpfr_random", (PyCFunction)GMPy_MPFR_random_Function, METH_VARARGS | METH_KEYWORDS, GMPy_doc_mpfr_random_function },
+    { "mpfr_grandom", (PyCFunction)GMPy_MPFR_grandom_Function, METH_VARARGS | METH_KEYWORDS, GMPy_doc_mpfr_grandom_function },
+    { "mul_2exp", GMPY_FASTCALL(GMPy_Context_Mul_2exp), GMPY_METH_FASTCALL, GMPy_doc_function_mul_2exp },
     { "nan", GMPy_MPFR_set_nan, METH_NOARGS, GMPy_doc_mpfr_set_nan },
     { "next_above", GMPy_Context_NextAbove, METH_O, GMPy_doc_function_next_above },
     { "next_below", GMPy_Context_NextBelow, METH_O, GMPy_doc_function_next_below },
-    { "next_toward", GMPy_Context_NextToward, METH_VARARGS, GMPy_doc_function_next_toward },
+    { "next_toward", GMPY_FASTCALL(GMPy_Context_NextToward), GMPY_METH_FASTCALL, GMPy_doc_function_next_toward },
+    { "norm2", GMPy_Context_Norm2, METH_O, GMPy_doc_function_norm2 },
     { "radians", GMPy_Context_Radians, METH_O, GMPy_doc_function_radians },
     { "rec_sqrt", GMPy_Context_RecSqrt, METH_O, GMPy_doc_function_rec_sqrt },
-    { "reldiff", GMPy_Context_RelDiff, METH_VARARGS, GMPy_doc_function_reldiff },
-    { "remainder", GMPy_Context_Remainder, METH_VARARGS, GMPy_doc_function_remainder },
-    { "remquo", GMPy_Context_RemQuo, METH_VARARGS, GMPy_doc_function_remquo },
+    { "reldiff", GMPY_FASTCALL(GMPy_Context_RelDiff), GMPY_METH_FASTCALL, GMPy_doc_function_reldiff },
+    { "remainder", GMPY_FASTCALL(GMPy_Context_Remainder), GMPY_METH_FASTCALL, GMPy_doc_function_remainder },
+    { "remquo", GMPY_FASTCALL(GMPy_Context_RemQuo), GMPY_METH_FASTCALL, GMPy_doc_function_remquo },
+    { "rfft", GMPy_Context_RFFT, METH_O, GMPy_doc_function_rfft },
     { "rint", GMPy_Context_Rint, METH_O, GMPy_doc_function_rint },
     { "rint_ceil", GMPy_Context_RintCeil, METH_O, GMPy_doc_function_rint_ceil },
     { "rint_floor", GMPy_Context_RintFloor, METH_O, GMPy_doc_function_rint_floor },
     { "rint_round", GMPy_Context_RintRound, METH_O, GMPy_doc_function_rint_round },
     { "rint_trunc", GMPy_Context_RintTrunc, METH_O, GMPy_doc_function_rint_trunc },
-    { "root", GMPy_Context_Root, METH_VARARGS, GMPy_doc_function_root },
+    { "root", GMPY_FASTCALL(GMPy_Context_Root), GMPY_METH_FASTCALL, GMPy_doc_function_root },
     { "round_away", GMPy_Context_RoundAway, METH_O, GMPy_doc_function_round_away },
-    { "round2", GMPy_Context_Round2, METH_VARARGS, GMPy_doc_function_round2 },
+    { "round2", GMPY_FASTCALL(GMPy_Context_Round2), GMPY_METH_FASTCALL, GMPy_doc_function_round2 },
     { "sec", GMPy_Context_Sec, METH_O, GMPy_doc_function_sec },
     { "sech", GMPy_Context_Sech, METH_O, GMPy_doc_function_sech },
     { "set_context", GMPy_CTXT_Set, METH_O, GMPy_doc_set_context },
-    { "set_exp", GMPy_MPFR_set_exp, METH_VARARGS, GMPy_doc_mpfr_set_exp },
-    { "set_sign", GMPy_MPFR_set_sign, METH_VARARGS, GMPy_doc_mpfr_set_sign },
+    { "set_exp", GMPY_FASTCALL(GMPy_MPFR_set_exp), GMPY_METH_FASTCALL, GMPy_doc_mpfr_set_exp },
+    { "set_sign", GMPY_FASTCALL(GMPy_MPFR_set_sign), GMPY_METH_FASTCALL, GMPy_doc_mpfr_set_sign },
     { "sin", GMPy_Context_Sin, METH_O, GMPy_doc_function_sin },
     { "sin_cos", GMPy_Context_Sin_Cos, METH_O, GMPy_doc_function_sin_cos },
+    { "sin_cos_many", GMPy_Context_Sin_Cos_Many, METH_O, GMPy_doc_function_sin_cos_many },
     { "sinh", GMPy_Context_Sinh, METH_O, GMPy_doc_function_sinh },
     { "sinh_cosh", GMPy_Context_Sinh_Cosh, METH_O, GMPy_doc_function_sinh_cosh },
+    { "sinh_cosh_many", GMPy_Context_Sinh_Cosh_Many, METH_O, GMPy_doc_function_sinh_cosh_many },
+    { "solve", GMPY_FASTCALL(GMPy_Context_Solve), GMPY_METH_FASTCALL, GMPy_doc_function_solve },
     { "sqrt", GMPy_Context_Sqrt, METH_O, GMPy_doc_function_sqrt },
     { "tan", GMPy_Context_Tan, METH_O, GMPy_doc_function_tan },
     { "tanh", GMPy_Context_Tanh, METH_O, GMPy_doc_function_tanh },
     { "trunc", GMPy_Context_Trunc, METH_O, GMPy_doc_function_trunc},
-    { "yn", GMPy_Context_Yn, METH_VARARGS, GMPy_doc_function_yn },
+    { "yn", GMPY_FASTCALL(GMPy_Context_Yn), GMPY_METH_FASTCALL, GMPy_doc_function_yn },
     { "y0", GMPy_Context_Y0, METH_O, GMPy_doc_function_y0 },
     { "y1", GMPy_Context_Y1, METH_O, GMPy_doc_function_y1 },
-    { "zero", GMPy_MPFR_set_zero, METH_VARARGS, GMPy_doc_mpfr_set_zero },
+    { "zero", GMPY_FASTCALL(GMPy_MPFR_set_zero), GMPY_METH_FASTCALL, GMPy_doc_mpfr_set_zero },
     { "zeta", GMPy_Context_Zeta, METH_O, GMPy_doc_function_zeta },
 
     { "mpc", (PyCFunction)GMPy_MPC_Factory, METH_VARARGS | METH_KEYWORDS, GMPy_doc_mpc_factory },
-    { "mpc_random", GMPy_MPC_random_Function, METH_VARARGS, GMPy_doc_mpc_random_function },
+    { "mpc_random", GMPY_FASTCALL(GMPy_MPC_random_Function), GMPY_METH_FASTCALL, GMPy_doc_mpc_random_function },
     { "norm", GMPy_Context_Norm, METH_O, GMPy_doc_function_norm },
     { "polar", GMPy_Context_Polar, METH_O, GMPy_doc_function_polar },
+    { "polyval", GMPY_FASTCALL(GMPy_Context_Polyval), GMPY_METH_FASTCALL, GMPy_doc_function_polyval },
+    { "polyval_many", GMPY_FASTCALL(GMPy_Context_PolyvalMany), GMPY_METH_FASTCALL, GMPy_doc_function_polyval_many },
     { "phase", GMPy_Context_Phase, METH_O, GMPy_doc_function_phase },
     { "proj", GMPy_Context_Proj, METH_O, GMPy_doc_function_proj },
-    { "rect", GMPy_Context_Rect, METH_VARARGS, GMPy_doc_function_rect },
+    { "rect", GMPY_FASTCALL(GMPy_Context_Rect), GMPY_METH_FASTCALL, GMPy_doc_function_rect },
     { NULL, NULL, 1}
 };
 
@@ -810,32 +1069,164 @@ static PyMethodDef Pygmpy_methods [] =
  * libraries. See gmpy.h for defines.
  */
 
+/* While the GIL is released, the counters are kept per thread. */
+
+#ifdef WITHOUT_THREADS
+#  define ALLOC_COUNT(field) alloc_stats.field++
+#else
+#  define ALLOC_COUNT(field) \
+    if (tls_nogil) tls_alloc_stats.field++; else alloc_stats.field++
+#endif
+
+static void
+alloc_stats_grow(size_t size)
+{
+#ifndef WITHOUT_THREADS
+    if (tls_nogil) {
+        tls_alloc_stats.total_bytes += size;
+        tls_alloc_stats.bytes += (Py_ssize_t)size;
+        if (tls_alloc_stats.bytes > tls_alloc_stats.peak_bytes)
+            tls_alloc_stats.peak_bytes = tls_alloc_stats.bytes;
+        return;
+    }
+#endif
+    alloc_stats.total_bytes += size;
+    alloc_stats.bytes += size;
+    if (alloc_stats.bytes > alloc_stats.peak_bytes)
+        alloc_stats.peak_bytes = alloc_stats.bytes;
+}
+
+/* Memory allocated before gmpy2 installed its memory functions may be freed
+ * by gmpy_free, so don't let the count of allocated bytes wrap around. */
+
+static void
+alloc_stats_shrink(size_t size)
+{
+#ifndef WITHOUT_THREADS
+    if (tls_nogil) {
+        tls_alloc_stats.bytes -= (Py_ssize_t)size;
+        return;
+    }
+#endif
+    if (alloc_stats.bytes > size)
+        alloc_stats.bytes -= size;
+    else
+        alloc_stats.bytes = 0;
+}
+
+/* Return the limb cache bucket for blocks of 'size' bytes, or NULL if
+ * blocks of that size are not cached. The limb cache belongs to the object
+ * caches of the current thread, so it is not used without the GIL or before
+ * the thread has created its caches. A block freed with a given size is at
+ * least that large, so it can be reused for any request of the same size.
+ */
+
+static gmpy_limbbucket *
+limb_bucket(size_t size)
+{
+    gmpy_cache *cache;
+
+    if (size == 0 || size % sizeof(mp_limb_t) ||
+        size > LIMB_CACHE_LIMBS * sizeof(mp_limb_t))
+        return NULL;
+#ifdef WITHOUT_THREADS
+    cache = &module_cache;
+#else
+    if (tls_nogil || !(cache = tls_cache))
+        return NULL;
+#endif
+    return &(cache->limbbucket[size / sizeof(mp_limb_t) - 1]);
+}
+
 static void *
 gmpy_allocate(size_t size)
 {
-    void *res;
+    void *res = NULL;
+    gmpy_limbbucket *bucket;
+    int locked;
+
+    alloc_stats_grow(size);
+    ALLOC_COUNT(allocs);
+    if (size >= GMPY_PROBE_LARGE_ALLOC)
+        GMPY_PROBE1(alloc__large, size);
+
+    if (tls_arena) {
+        ARENA_LOCK(locked);
+        res = GMPy_Arena_Allocate(size);
+        ARENA_UNLOCK(locked);
+    }
+    else if ((bucket = limb_bucket(size)) && bucket->in_limbcache) {
+        res = bucket->blocks[--(bucket->in_limbcache)];
+        alloc_stats.limb_hits++;
+    }
 
-    if (!(res = GMPY_MALLOC(size)))
+    if (!res && !(res = GMPY_MALLOC(size)))
         Py_FatalError("Insufficient memory");
 
+    GMPY_TRACK(res, size);
     return res;
 }
 
 static void *
 gmpy_reallocate(void *ptr, size_t old_size, size_t new_size)
 {
-    void *res;
-
-    if (!(res = GMPY_REALLOC(ptr, new_size)))
+    void *res = NULL;
+    gmpy_arena_chunk *chunk;
+    gmpy_mmap_region *region;
+    int locked;
+
+    if (new_size > old_size)
+        alloc_stats_grow(new_size - old_size);
+    else
+        alloc_stats_shrink(old_size - new_size);
+    ALLOC_COUNT(reallocs);
+    if (new_size >= GMPY_PROBE_LARGE_ALLOC && new_size > old_size)
+        GMPY_PROBE1(alloc__large, new_size);
+
+    ARENA_LOCK(locked);
+    if (mmap_regions && (region = GMPy_Mmap_Find(ptr)))
+        res = GMPy_Mmap_Reallocate(region, ptr, old_size, new_size);
+    else if (arena_chunks && (chunk = GMPy_Arena_Find(ptr)))
+        res = GMPy_Arena_Reallocate(chunk, ptr, old_size, new_size);
+    ARENA_UNLOCK(locked);
+
+    if (!res && !(res = GMPY_REALLOC(ptr, new_size)))
         Py_FatalError("Insufficient memory");
 
+    if (res != ptr)
+        GMPY_UNTRACK(ptr);
+    GMPY_TRACK(res, new_size);
     return res;
 }
 
 static void
 gmpy_free( void *ptr, size_t size)
 {
-    GMPY_FREE(ptr);
+    gmpy_arena_chunk *chunk;
+    gmpy_mmap_region *region;
+    gmpy_limbbucket *bucket;
+    int locked;
+
+    alloc_stats_shrink(size);
+    ALLOC_COUNT(frees);
+    GMPY_UNTRACK(ptr);
+
+    ARENA_LOCK(locked);
+    if (mmap_regions && (region = GMPy_Mmap_Find(ptr))) {
+        GMPy_Mmap_Free(region, ptr);
+        ptr = NULL;
+    }
+    else if (arena_chunks && (chunk = GMPy_Arena_Find(ptr))) {
+        GMPy_Arena_Free(chunk, ptr);
+        ptr = NULL;
+    }
+    ARENA_UNLOCK(locked);
+    if (!ptr)
+        return;
+    if ((bucket = limb_bucket(size)) && bucket->in_limbcache < LIMB_CACHE_SIZE)
+        bucket->blocks[(bucket->in_limbcache)++] = ptr;
+    else
+        GMPY_FREE(ptr);
 }
 
 static char _gmpy_docs[] =
@@ -864,224 +1255,291 @@ static char _gmpy_docs[] =
 "MPFR and MPC libraries are available.\n\
 ";
 
-/* Notes on Python 3.x support: Full support for PEP-3121 has not been
- * implemented. No per-module state has been defined.
+/* Initialization is split in two. GMPy_Init_Once() sets up the state that
+ * is shared by the whole process: the type objects, the memory functions,
+ * the exceptions, and the keys of the per-thread caches and contexts. It
+ * runs when gmpy2 is first imported. GMPy_Module_Exec() fills in a module
+ * object and runs once for every interpreter that imports gmpy2.
+ *
+ * On Python 3.5 and later, the module uses multi-phase initialization
+ * (PEP 489) so each sub-interpreter gets its own module object and its own
+ * copyreg registrations. The type objects are static and shared, so the
+ * module can only be loaded by interpreters that share the main GIL. On
+ * free-threaded builds, the module asks for the GIL to be enabled: the
+ * object caches and the contexts are per thread, but the global settings,
+ * the combinatorial and radix caches, and the allocation counters are only
+ * protected by the GIL.
  */
 
-#ifdef PY3
-#define INITERROR return NULL
-static struct PyModuleDef moduledef = {
-        PyModuleDef_HEAD_INIT,
-        "gmpy2",
-        _gmpy_docs,
-        -1, /*sizeof(struct module_state) */
-        Pygmpy_methods,
-        NULL,
-        NULL, /* gmpy_traverse */
-        NULL, /* gmpy_clear */
-        NULL
-};
-#else
-#define INITERROR return
-#endif
+static int gmpy_initialized = 0;
 
-#ifdef PY3
-PyMODINIT_FUNC PyInit_gmpy2(void)
-#else
-PyMODINIT_FUNC initgmpy2(void)
-#endif
+static int
+GMPy_Init_Once(void)
 {
-    PyObject* gmpy_module = NULL;
-    PyObject* copy_reg_module = NULL;
     PyObject *temp = NULL;
 
+    if (gmpy_initialized)
+        return 0;
+
     /* Validate the sizes of the various typedef'ed integer types. */
 
 #if defined _WIN64 && (MPIR || MSYS2)
     if (sizeof(mp_bitcnt_t) != sizeof(PY_LONG_LONG)) {
         SYSTEM_ERROR("Size of PY_LONG_LONG and mp_bitcnt_t not compatible (_WIN64 && MPIR)");
-        INITERROR;
+        return -1;
     }
 #else
     if (sizeof(mp_bitcnt_t) != sizeof(long)) {
         SYSTEM_ERROR("Size of long and mp_bitcnt_t not compatible");
-        INITERROR;
+        return -1;
     }
 #endif
 
     if (sizeof(mp_bitcnt_t) > sizeof(size_t)) {
         SYSTEM_ERROR("Size of size_t and mp_bitcnt_t not compatible");
-        INITERROR;
+        return -1;
     }
 
     if (sizeof(mpfr_prec_t) != sizeof(long)) {
         SYSTEM_ERROR("Size of mpfr_prec_t and long not compatible");
-        INITERROR;
+        return -1;
     }
 
     if (sizeof(mpfr_exp_t) != sizeof(long)) {
         SYSTEM_ERROR("Size of mpfr_exp_t and long not compatible");
-        INITERROR;
+        return -1;
     }
 
     /* Initialize the types. */
     if (PyType_Ready(&MPZ_Type) < 0)
-        INITERROR;
+        return -1;
     if (PyType_Ready(&MPQ_Type) < 0)
-        INITERROR;
+        return -1;
     if (PyType_Ready(&XMPZ_Type) < 0)
-        INITERROR;
+        return -1;
     if (PyType_Ready(&GMPy_Iter_Type) < 0)
-        INITERROR;
+        return -1;
     if (PyType_Ready(&MPFR_Type) < 0)
-        INITERROR;
+        return -1;
     if (PyType_Ready(&CTXT_Type) < 0)
-        INITERROR;
+        return -1;
     if (PyType_Ready(&CTXT_Manager_Type) < 0)
-        INITERROR;
+        return -1;
     if (PyType_Ready(&MPC_Type) < 0)
-        INITERROR;
+        return -1;
+    if (PyType_Ready(&Arena_Type) < 0)
+        return -1;
+    if (PyType_Ready(&PMUL_Type) < 0)
+        return -1;
+    if (PyType_Ready(&CRT_Basis_Type) < 0)
+        return -1;
+    if (PyType_Ready(&RNS_Type) < 0)
+        return -1;
+    if (PyType_Ready(&DecMPZ_Type) < 0)
+        return -1;
+    if (PyType_Ready(&Modulus_Type) < 0)
+        return -1;
+    if (PyType_Ready(&DivisorSet_Type) < 0)
+        return -1;
+    if (PyType_Ready(&MPZVector_Type) < 0)
+        return -1;
+    if (PyType_Ready(&MPFRArray_Type) < 0)
+        return -1;
+    if (PyType_Ready(&Ball_Type) < 0)
+        return -1;
+    if (PyType_Ready(&Lazy_Type) < 0)
+        return -1;
+    if (PyType_Ready(&PowmodTable_Type) < 0)
+        return -1;
+    if (PyType_Ready(&Primes_Type) < 0)
+        return -1;
 
     /* Initialize the custom memory handlers. */
     mp_set_memory_functions(gmpy_allocate, gmpy_reallocate, gmpy_free);
 
-    /* Initialize object caching. */
-    set_zcache();
-    set_gmpympzcache();
-    set_gmpympqcache();
-    set_gmpyxmpzcache();
-    set_gmpympfrcache();
-    set_gmpympccache();
+#ifndef WITHOUT_THREADS
+    /* Support releasing the GIL. */
+    if (!(arena_lock = PyThread_allocate_lock()))
+        return -1;
+    if (GMPy_Pool_Init() < 0)
+        return -1;
+    global.nogil_mpfr = mpfr_buildopt_tls_p();
+#endif
+
+    /* Create the shared objects for small mpz values. */
+    if (GMPy_MPZ_Small_Init() < 0)
+        return -1;
+
+    /* Load the thresholds measured for this machine. */
+    if (GMPy_Tuning_Load() < 0)
+        return -1;
+
+    /* Initialize object caching. The caches themselves are created by
+     * each thread on first use. */
+#ifndef WITHOUT_THREADS
+    tls_cache_key = PyUnicode_FromString("__GMPY2_CACHE__");
+    if (!tls_cache_key)
+        return -1;
+#endif
 
     /* Initialize exceptions. */
     GMPyExc_GmpyError = PyErr_NewException("gmpy2.gmpyError",
                                            PyExc_ArithmeticError, NULL);
     if (!GMPyExc_GmpyError)
-        INITERROR;
+        return -1;
 
     GMPyExc_Erange = PyErr_NewException("gmpy2.RangeError",
                                         GMPyExc_GmpyError, NULL);
     if (!GMPyExc_Erange)
-        INITERROR;
+        return -1;
 
     GMPyExc_Inexact = PyErr_NewException("gmpy2.InexactResultError",
                                          GMPyExc_GmpyError, NULL);
     if (!GMPyExc_Inexact)
-        INITERROR;
+        return -1;
 
     GMPyExc_Overflow = PyErr_NewException("gmpy2.OverflowResultError",
                                           GMPyExc_Inexact, NULL);
     if (!GMPyExc_Overflow)
-        INITERROR;
+        return -1;
 
     GMPyExc_Underflow = PyErr_NewException("gmpy2.UnderflowResultError",
                                            GMPyExc_Inexact, NULL);
     if (!GMPyExc_Underflow)
-        INITERROR;
+        return -1;
 
     temp = PyTuple_Pack(2, GMPyExc_GmpyError, PyExc_ValueError);
     if (!temp)
-        INITERROR;
+        return -1;
     GMPyExc_Invalid = PyErr_NewException("gmpy2.InvalidOperationError",
                                          temp, NULL);
     Py_DECREF(temp);
     if (!GMPyExc_Invalid)
-        INITERROR;
+        return -1;
 
     temp = PyTuple_Pack(2, GMPyExc_GmpyError, PyExc_ZeroDivisionError);
     if (!temp)
-        INITERROR;
+        return -1;
     GMPyExc_DivZero = PyErr_NewException("gmpy2.DivisionByZeroError",
                                          temp, NULL);
     Py_DECREF(temp);
     if (!GMPyExc_DivZero)
-        INITERROR;
+        return -1;
 
-
-#ifdef PY3
-    gmpy_module = PyModule_Create(&moduledef);
+    /* Initialize thread local contexts. */
+#ifdef WITHOUT_THREADS
+    module_context = (CTXT_Object*)GMPy_CTXT_New();
+    if (!module_context)
+        return -1;
+#elif defined(GMPY_CONTEXTVAR)
+    current_context_var = PyContextVar_New("gmpy2_context", NULL);
+    if (!current_context_var)
+        return -1;
 #else
-    gmpy_module = Py_InitModule3("gmpy2", Pygmpy_methods, _gmpy_docs);
+    tls_context_key = PyUnicode_FromString("__GMPY2_CTX__");
+    if (!tls_context_key)
+        return -1;
 #endif
 
-    if (gmpy_module == NULL)
-        INITERROR;
+    gmpy_initialized = 1;
+    return 0;
+}
+
+static int
+GMPy_Module_Exec(PyObject *gmpy_module)
+{
+#ifndef GMPY_PICKLE_BUFFER
+    PyObject* copy_reg_module = NULL;
+#endif
+
+    if (GMPy_Init_Once() < 0)
+        return -1;
 
-    /* Initialize thread local contexts. */
 #ifdef WITHOUT_THREADS
-    module_context = (CTXT_Object*)GMPy_CTXT_New();
-    if (!module_context)
-        INITERROR;
     Py_INCREF(Py_False);
     if (PyModule_AddObject(gmpy_module, "HAVE_THREADS", Py_False) < 0) {
         Py_DECREF(Py_False);
-        INITERROR;
+        return -1;
     }
 #else
-    tls_context_key = PyUnicode_FromString("__GMPY2_CTX__");
     Py_INCREF(Py_True);
     if (PyModule_AddObject(gmpy_module, "HAVE_THREADS", Py_True) < 0) {
         Py_DECREF(Py_True);
-        INITERROR;
+        return -1;
     }
 #endif
 
     /* Add the constants for defining rounding modes. */
     if (PyModule_AddIntConstant(gmpy_module, "RoundToNearest", MPFR_RNDN) < 0)
-        INITERROR;
+        return -1;
     if (PyModule_AddIntConstant(gmpy_module, "RoundToZero", MPFR_RNDZ) < 0)
-        INITERROR;
+        return -1;
     if (PyModule_AddIntConstant(gmpy_module, "RoundUp", MPFR_RNDU) < 0)
-        INITERROR;
+        return -1;
     if (PyModule_AddIntConstant(gmpy_module, "RoundDown", MPFR_RNDD) < 0)
-        INITERROR;
+        return -1;
     if (PyModule_AddIntConstant(gmpy_module, "RoundAwayZero", MPFR_RNDA) < 0)
-        INITERROR;
+        return -1;
     if (PyModule_AddIntConstant(gmpy_module, "Default", GMPY_DEFAULT) < 0)
-        INITERROR;
+        return -1;
+
+    /* Add the tracemalloc domain used for limb allocations. */
+    if (PyModule_AddIntConstant(gmpy_module, "TRACEMALLOC_DOMAIN",
+                                GMPY_TRACEMALLOC_DOMAIN) < 0)
+        return -1;
 
     /* Add the exceptions. */
     Py_INCREF(GMPyExc_DivZero);
     if (PyModule_AddObject(gmpy_module, "DivisionByZeroError", GMPyExc_DivZero) < 0) {
         Py_DECREF(GMPyExc_DivZero);
-        INITERROR;
+        return -1;
     }
     Py_INCREF(GMPyExc_Inexact);
     if (PyModule_AddObject(gmpy_module, "InexactResultError", GMPyExc_Inexact) < 0) {
         Py_DECREF(GMPyExc_Inexact);
-        INITERROR;
+        return -1;
     }
     Py_INCREF(GMPyExc_Invalid);
     if (PyModule_AddObject(gmpy_module, "InvalidOperationError", GMPyExc_Invalid) < 0 ) {
         Py_DECREF(GMPyExc_Invalid);
-        INITERROR;
+        return -1;
     }
     Py_INCREF(GMPyExc_Overflow);
     if (PyModule_AddObject(gmpy_module, "OverflowResultError", GMPyExc_Overflow) < 0) {
         Py_DECREF(GMPyExc_Overflow);
-        INITERROR;
+        return -1;
     }
     Py_INCREF(GMPyExc_Underflow);
     if (PyModule_AddObject(gmpy_module, "UnderflowResultError", GMPyExc_Underflow) < 0) {
         Py_DECREF(GMPyExc_Underflow);
-        INITERROR;
+        return -1;
     }
     Py_INCREF(GMPyExc_Erange);
     if (PyModule_AddObject(gmpy_module, "RangeError", GMPyExc_Erange) < 0) {
         Py_DECREF(GMPyExc_Erange);
-        INITERROR;
+        return -1;
     }
 
-    /* Add support for pickling. */
-#ifdef PY3
+    /* Export the C API for other extensions. */
+    if (GMPy_CAPI_Init(gmpy_module) < 0)
+        return -1;
+
+    /* Add support for pickling. When protocol 5 is available, all types
+     * define __reduce_ex__ and nothing needs to be imported. Otherwise the
+     * types are registered with copyreg.
+     */
+#if defined(GMPY_PICKLE_BUFFER)
+    if (GMPy_Pickle_Init(gmpy_module) < 0)
+        return -1;
+#elif defined(PY3)
     copy_reg_module = PyImport_ImportModule("copyreg");
     if (copy_reg_module) {
         char* enable_pickle =
             "def gmpy2_reducer(x): return (gmpy2.from_binary, (gmpy2.to_binary(x),))\n"
             "copyreg.pickle(type(gmpy2.mpz(0)), gmpy2_reducer)\n"
             "copyreg.pickle(type(gmpy2.xmpz(0)), gmpy2_reducer)\n"
-            "copyreg.pickle(type(gmpy2.mpq(0)), gmpy2_reducer)\n"
             "copyreg.pickle(type(gmpy2.mpfr(0)), gmpy2_reducer)\n"
+            "copyreg.pickle(type(gmpy2.mpq(0)), gmpy2_reducer)\n"
             "copyreg.pickle(type(gmpy2.mpc(0,0)), gmpy2_reducer)\n";
         PyObject* namespace = PyDict_New();
         PyObject* result = NULL;
@@ -1128,7 +1586,64 @@ PyMODINIT_FUNC initgmpy2(void)
     }
 #endif
 
+    return 0;
+}
+
+#if defined(PY3) && PY_VERSION_HEX >= 0x03050000
+static PyModuleDef_Slot gmpy_slots[] = {
+    { Py_mod_exec, (void*)GMPy_Module_Exec },
+#if PY_VERSION_HEX >= 0x030C0000
+    { Py_mod_multiple_interpreters, Py_MOD_MULTIPLE_INTERPRETERS_SUPPORTED },
+#endif
+#if PY_VERSION_HEX >= 0x030D0000
+    { Py_mod_gil, Py_MOD_GIL_USED },
+#endif
+    { 0, NULL }
+};
+#endif
+
 #ifdef PY3
+static struct PyModuleDef moduledef = {
+        PyModuleDef_HEAD_INIT,
+        "gmpy2",
+        _gmpy_docs,
+#if PY_VERSION_HEX >= 0x03050000
+        0,
+        Pygmpy_methods,
+        gmpy_slots,
+#else
+        -1,
+        Pygmpy_methods,
+        NULL,
+#endif
+        NULL, /* gmpy_traverse */
+        NULL, /* gmpy_clear */
+        NULL
+};
+
+PyMODINIT_FUNC PyInit_gmpy2(void)
+{
+#if PY_VERSION_HEX >= 0x03050000
+    return PyModuleDef_Init(&moduledef);
+#else
+    PyObject *gmpy_module;
+
+    if (!(gmpy_module = PyModule_Create(&moduledef)))
+        return NULL;
+    if (GMPy_Module_Exec(gmpy_module) < 0) {
+        Py_DECREF(gmpy_module);
+        return NULL;
+    }
     return gmpy_module;
 #endif
 }
+#else
+PyMODINIT_FUNC initgmpy2(void)
+{
+    PyObject *gmpy_module;
+
+    if (!(gmpy_module = Py_InitModule3("gmpy2", Pygmpy_methods, _gmpy_docs)))
+        return;
+    GMPy_Module_Exec(gmpy_module);
+}
+#endif
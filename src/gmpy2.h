@@ -75,6 +75,7 @@ typedef unsigned long Py_uhash_t;
 #if (PY_MAJOR_VERSION == 3)
 #define PY3
 #define Py2or3String_FromString     PyUnicode_FromString
+#define Py2or3String_FromStringAndSize PyUnicode_FromStringAndSize
 #define Py2or3String_FromFormat     PyUnicode_FromFormat
 #define Py2or3String_Check          PyUnicode_Check
 #define Py2or3String_Format         PyUnicode_Format
@@ -89,6 +90,7 @@ typedef unsigned long Py_uhash_t;
 #else
 #define PY2
 #define Py2or3String_FromString     PyString_FromString
+#define Py2or3String_FromStringAndSize PyString_FromStringAndSize
 #define Py2or3String_FromFormat     PyString_FromFormat
 #define Py2or3String_Check          PyString_Check
 #define Py2or3String_Format         PyString_Format
@@ -102,6 +104,43 @@ typedef unsigned long Py_uhash_t;
 #define PyIntOrLong_AsLong          PyInt_AsLong
 #endif
 
+/* Functions that take a variable number of positional arguments are written
+ * for METH_FASTCALL, which passes the arguments as a C array instead of a
+ * tuple:
+ *
+ *   static PyObject * NAME(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+ *
+ * GMPY_FASTCALL_WRAPPER(NAME) must follow the definition. On versions of
+ * Python without METH_FASTCALL, it creates a METH_VARARGS function that
+ * passes on the items of the argument tuple. Method tables refer to the
+ * function as GMPY_FASTCALL(NAME) with the flag GMPY_METH_FASTCALL.
+ *
+ * A METH_VARARGS | METH_KEYWORDS function NAME can have a METH_FASTCALL |
+ * METH_KEYWORDS front end, NAME_FastCall, that handles the common calls
+ * itself and passes on the others with GMPy_FastCall_Keywords(). Method
+ * tables refer to it as GMPY_FASTCALL_KEYWORDS(NAME) with the flag
+ * GMPY_METH_FASTCALL_KEYWORDS.
+ */
+
+#if PY_VERSION_HEX >= 0x03070000
+#  define GMPY_METH_FASTCALL          METH_FASTCALL
+#  define GMPY_FASTCALL(NAME)         (PyCFunction)(void(*)(void))NAME
+#  define GMPY_METH_FASTCALL_KEYWORDS (METH_FASTCALL | METH_KEYWORDS)
+#  define GMPY_FASTCALL_KEYWORDS(NAME) (PyCFunction)(void(*)(void))NAME##_FastCall
+#  define GMPY_FASTCALL_WRAPPER(NAME)
+#else
+#  define GMPY_METH_FASTCALL          METH_VARARGS
+#  define GMPY_FASTCALL(NAME)         NAME##_VarArgs
+#  define GMPY_METH_FASTCALL_KEYWORDS (METH_VARARGS | METH_KEYWORDS)
+#  define GMPY_FASTCALL_KEYWORDS(NAME) (PyCFunction)NAME
+#  define GMPY_FASTCALL_WRAPPER(NAME) \
+static PyObject * \
+NAME##_VarArgs(PyObject *self, PyObject *args) \
+{ \
+    return NAME(self, &PyTuple_GET_ITEM(args, 0), PyTuple_GET_SIZE(args)); \
+}
+#endif
+
 /* Support MPIR, if requested. */
 
 #ifdef MPIR
@@ -153,12 +192,13 @@ typedef unsigned long Py_uhash_t;
 #define SYSTEM_ERROR(msg) PyErr_SetString(PyExc_SystemError, msg)
 #define OVERFLOW_ERROR(msg) PyErr_SetString(PyExc_OverflowError, msg)
 #define RUNTIME_ERROR(msg) PyErr_SetString(PyExc_RuntimeError, msg)
+#define BUFFER_ERROR(msg) PyErr_SetString(PyExc_BufferError, msg)
 
 #define GMPY_DEFAULT -1
 
 /* To prevent excessive memory usage, we don't want to save very large
  * numbers in the cache. The default value specified in the options
- * structure is 128 words (512 bytes on 32-bit platforms, 1024 bytes on
+ * structure is 1024 words (4096 bytes on 32-bit platforms, 8192 bytes on
  * 64-bit platforms).
  */
 #define MAX_CACHE_LIMBS 16384
@@ -185,6 +225,25 @@ typedef unsigned long Py_uhash_t;
 #  define GMPY_REALLOC(NAME, SIZE) realloc(NAME, SIZE)
 #endif
 
+/* Limb allocations made with malloc() are invisible to tracemalloc, so
+ * gmpy_allocate() and friends report them under their own domain. With
+ * USE_PYMEM they are already traced by Python. PyTraceMalloc_Track() may be
+ * called without the GIL and returns at once when tracemalloc is not
+ * tracing.
+ */
+
+#define GMPY_TRACEMALLOC_DOMAIN 0x676d7079
+
+#if PY_VERSION_HEX >= 0x03070000 && !defined(USE_PYMEM)
+#  define GMPY_TRACK(PTR, SIZE) \
+    (void)PyTraceMalloc_Track(GMPY_TRACEMALLOC_DOMAIN, (uintptr_t)(PTR), SIZE)
+#  define GMPY_UNTRACK(PTR) \
+    (void)PyTraceMalloc_Untrack(GMPY_TRACEMALLOC_DOMAIN, (uintptr_t)(PTR))
+#else
+#  define GMPY_TRACK(PTR, SIZE)
+#  define GMPY_UNTRACK(PTR)
+#endif
+
 #ifdef USE_ALLOCA
 #  define TEMP_ALLOC(B, S) \
     if(S < ALLOC_THRESHOLD) { \
@@ -218,13 +277,36 @@ typedef unsigned long Py_uhash_t;
 #define Py_TYPE(ob)     (((PyObject*)(ob))->ob_type)
 #endif
 
+/* Python.h only includes pythread.h, which declares the lock API, since
+ * Python 3.7. */
+
+#ifndef WITHOUT_THREADS
+#include "pythread.h"
+#endif
+
+/* Storage class for data that is private to each thread. */
+
+#if defined(WITHOUT_THREADS)
+#  define GMPY_TLS
+#elif defined(_MSC_VER)
+#  define GMPY_TLS __declspec(thread)
+#else
+#  define GMPY_TLS __thread
+#endif
+
 /* The gmpy_args.h file includes macros that are used for argument
  * processing.
  */
 #include "mpfr.h"
 #include "mpc.h"
 
+/* The object structures and the C API exported to other extensions. */
+
+#include "gmpy2_capi.h"
+
 #include "gmpy2_macros.h"
+#include "gmpy2_profile.h"
+#include "gmpy2_probes.h"
 
 #include "gmpy2_context.h"
 
@@ -236,6 +318,7 @@ typedef unsigned long Py_uhash_t;
 #include "gmpy2_mpz_bitops.h"
 #include "gmpy2_mpz_inplace.h"
 #include "gmpy2_xmpz_inplace.h"
+#include "gmpy2_mpq_small.h"
 
 #include "gmpy2_mpq.h"
 
@@ -259,6 +342,20 @@ typedef unsigned long Py_uhash_t;
 
 #include "gmpy2_cache.h"
 
+/* Support arena allocation of limbs. */
+
+#include "gmpy2_arena.h"
+#include "gmpy2_mmap.h"
+
+/* Support releasing the GIL around long-running functions. */
+
+#include "gmpy2_threads.h"
+#include "gmpy2_cancel.h"
+#include "gmpy2_pool.h"
+#include "gmpy2_pmul.h"
+#include "gmpy2_futures.h"
+#include "gmpy2_radix.h"
+
 /* Suport for miscellaneous functions (ie. version, license, etc.). */
 
 #include "gmpy2_misc.h"
@@ -266,11 +363,20 @@ typedef unsigned long Py_uhash_t;
 /* Support conversion to/from binary format. */
 
 #include "gmpy2_binary.h"
+#include "gmpy2_pcache.h"
 
 /* Support random number generators. */
 
 #include "gmpy2_random.h"
 
+/* Support Montgomery arithmetic. */
+
+#include "gmpy2_mont.h"
+
+/* Support 53-bit mpfr arithmetic with hardware doubles. */
+
+#include "gmpy2_mpfr_d53.h"
+
 /* Support Lucas sequences. */
 
 #include "gmpy_mpz_lucas.h"
@@ -305,8 +411,31 @@ typedef unsigned long Py_uhash_t;
 #include "gmpy2_mpc_misc.h"
 #include "gmpy2_mpfr_misc.h"
 #include "gmpy2_mpq_misc.h"
+#include "gmpy2_reduce.h"
 #include "gmpy2_mpz_misc.h"
 #include "gmpy2_xmpz_misc.h"
+#include "gmpy2_xmpz_rank.h"
+#include "gmpy2_vector.h"
+#include "gmpy2_sort.h"
+#include "gmpy2_crt.h"
+#include "gmpy2_rns.h"
+#include "gmpy2_decimal_mpz.h"
+#include "gmpy2_modulus.h"
+#include "gmpy2_primes.h"
+#include "gmpy2_factor.h"
+#include "gmpy2_dlog.h"
+#include "gmpy2_randprime.h"
+#include "gmpy2_combcache.h"
+#include "gmpy2_divset.h"
+#include "gmpy2_binsplit.h"
+#include "gmpy2_mpz_vector.h"
+#include "gmpy2_mpfr_array.h"
+#include "gmpy2_mpfr_ball.h"
+#include "gmpy2_lazy.h"
+#include "gmpy2_fft.h"
+#include "gmpy2_matrix.h"
+#include "gmpy2_ndarray.h"
+#include "gmpy2_tuning.h"
 
 #ifdef __cplusplus
 }
@@ -60,6 +60,12 @@ static PyObject *
 GMPy_Integer_Add(PyObject *x, PyObject *y, CTXT_Object *context)
 {
     MPZ_Object *result;
+    long a, b;
+
+    /* Return the shared object if the result is small. */
+    if (GMPy_MPZ_Small_Operand(x, &a) && GMPy_MPZ_Small_Operand(y, &b) &&
+        MPZ_IS_SMALL(a + b))
+        return (PyObject*)GMPy_MPZ_Small(a + b);
 
     if (!(result = GMPy_MPZ_New(context)))
         return NULL;
@@ -79,10 +85,9 @@ GMPy_Integer_Add(PyObject *x, PyObject *y, CTXT_Object *context)
             }
             else {
                 mpz_t tempz;
-                mpz_inoc(tempz);
-                mpz_set_PyIntOrLong(tempz, y);
+                mpz_inoc_pylong(tempz, y);
                 mpz_add(result->z, MPZ(x), tempz);
-                mpz_cloc(tempz);
+                mpz_cloc_pylong(tempz);
             }
             return (PyObject*)result;
         }
@@ -109,10 +114,9 @@ GMPy_Integer_Add(PyObject *x, PyObject *y, CTXT_Object *context)
             }
             else {
                 mpz_t tempz;
-                mpz_inoc(tempz);
-                mpz_set_PyIntOrLong(tempz, x);
+                mpz_inoc_pylong(tempz, x);
                 mpz_add(result->z, MPZ(y), tempz);
-                mpz_cloc(tempz);
+                mpz_cloc_pylong(tempz);
                 return (PyObject*)result;
             }
         }
@@ -146,28 +150,41 @@ GMPy_Integer_Add(PyObject *x, PyObject *y, CTXT_Object *context)
  * function. If no appropriate function can be found, return NotImplemented.
  */
 
+GMPY_PROFILE_WRAP(PyObject *, GMPy_MPZ_Add_Slot, (PyObject *x, PyObject *y),
+                  (x, y), gmpy_profile_bits2(x, y))
+
 static PyObject *
-GMPy_MPZ_Add_Slot(PyObject *x, PyObject *y)
+GMPy_MPZ_Add_Slot_Impl(PyObject *x, PyObject *y)
 {
+    int xtype, ytype;
+
     if (CHECK_MPZANY(x) && CHECK_MPZANY(y)) {
         MPZ_Object *result;
+        long a, b;
 
-        if ((result = GMPy_MPZ_New(NULL))) {
+        if (GMPy_MPZ_Small_Operand(x, &a) && GMPy_MPZ_Small_Operand(y, &b) &&
+            MPZ_IS_SMALL(a + b))
+            return (PyObject*)GMPy_MPZ_Small(a + b);
+
+        if ((result = GMPy_MPZ_Reuse(x, y))) {
             mpz_add(result->z, MPZ(x), MPZ(y));
         }
         return (PyObject*)result;
     }
 
-    if (IS_INTEGER(x) && IS_INTEGER(y))
+    xtype = GMPy_ObjectType(x);
+    ytype = GMPy_ObjectType(y);
+
+    if (IS_TYPE_INTEGER(xtype) && IS_TYPE_INTEGER(ytype))
         return GMPy_Integer_Add(x, y, NULL);
 
-    if (IS_RATIONAL(x) && IS_RATIONAL(y))
+    if (IS_TYPE_RATIONAL(xtype) && IS_TYPE_RATIONAL(ytype))
         return GMPy_Rational_Add(x, y, NULL);
 
-    if (IS_REAL(x) && IS_REAL(y))
+    if (IS_TYPE_REAL(xtype) && IS_TYPE_REAL(ytype))
         return GMPy_Real_Add(x, y, NULL);
 
-    if (IS_COMPLEX(x) && IS_COMPLEX(y))
+    if (IS_TYPE_COMPLEX(xtype) && IS_TYPE_COMPLEX(ytype))
         return GMPy_Complex_Add(x, y, NULL);
 
     Py_RETURN_NOTIMPLEMENTED;
@@ -186,7 +203,8 @@ GMPy_Rational_Add(PyObject *x, PyObject *y, CTXT_Object *context)
         return NULL;
 
     if (MPQ_Check(x) && MPQ_Check(y)) {
-        mpq_add(result->q, MPQ(x), MPQ(y));
+        if (!GMPy_MPQ_Small_Add(result->q, MPQ(x), MPQ(y), 0))
+            mpq_add(result->q, MPQ(x), MPQ(y));
         return (PyObject*)result;
     }
 
@@ -202,7 +220,8 @@ GMPy_Rational_Add(PyObject *x, PyObject *y, CTXT_Object *context)
             return NULL;
         }
 
-        mpq_add(result->q, tempx->q, tempy->q);
+        if (!GMPy_MPQ_Small_Add(result->q, tempx->q, tempy->q, 0))
+            mpq_add(result->q, tempx->q, tempy->q);
         Py_DECREF((PyObject*)tempx);
         Py_DECREF((PyObject*)tempy);
         return (PyObject*)result;
@@ -217,16 +236,24 @@ GMPy_Rational_Add(PyObject *x, PyObject *y, CTXT_Object *context)
  * If the other object isn't a Pympq, call the appropriate function. If
  * no appropriate function can be found, return NotImplemented. */
 
+GMPY_PROFILE_WRAP(PyObject *, GMPy_MPQ_Add_Slot, (PyObject *x, PyObject *y),
+                  (x, y), gmpy_profile_bits2(x, y))
+
 static PyObject *
-GMPy_MPQ_Add_Slot(PyObject *x, PyObject *y)
+GMPy_MPQ_Add_Slot_Impl(PyObject *x, PyObject *y)
 {
-    if (IS_RATIONAL(x) && IS_RATIONAL(y))
+    int xtype, ytype;
+
+    xtype = GMPy_ObjectType(x);
+    ytype = GMPy_ObjectType(y);
+
+    if (IS_TYPE_RATIONAL(xtype) && IS_TYPE_RATIONAL(ytype))
         return GMPy_Rational_Add(x, y, NULL);
 
-    if (IS_REAL(x) && IS_REAL(y))
+    if (IS_TYPE_REAL(xtype) && IS_TYPE_REAL(ytype))
         return GMPy_Real_Add(x, y, NULL);
 
-    if (IS_COMPLEX(x) && IS_COMPLEX(y))
+    if (IS_TYPE_COMPLEX(xtype) && IS_TYPE_COMPLEX(ytype))
         return GMPy_Complex_Add(x, y, NULL);
 
     Py_RETURN_NOTIMPLEMENTED;
@@ -260,6 +287,8 @@ GMPy_Real_Add(PyObject *x, PyObject *y, CTXT_Object *context)
         return NULL;
 
     if (MPFR_Check(x) && MPFR_Check(y)) {
+        if (GMPy_MPFR_D53_Add(result, (MPFR_Object*)x, (MPFR_Object*)y, 0, context))
+            goto done;
         mpfr_clear_flags();
         result->rc = mpfr_add(result->f, MPFR(x), MPFR(y), GET_MPFR_ROUND(context));
         goto done;
@@ -274,11 +303,10 @@ GMPy_Real_Add(PyObject *x, PyObject *y, CTXT_Object *context)
             temp = GMPy_Integer_AsLongAndError(y, &error);
             
             if (error) {
-                mpz_inoc(tempz);
-                mpz_set_PyIntOrLong(tempz, y);
+                mpz_inoc_pylong(tempz, y);
                 mpfr_clear_flags();
                 result->rc = mpfr_add_z(result->f, MPFR(x), tempz, GET_MPFR_ROUND(context));
-                mpz_cloc(tempz);
+                mpz_cloc_pylong(tempz);
                 goto done;
             }
             else {
@@ -322,11 +350,10 @@ GMPy_Real_Add(PyObject *x, PyObject *y, CTXT_Object *context)
 
             temp = GMPy_Integer_AsLongAndError(x, &error);
             if (error) {
-                mpz_inoc(tempz);
-                mpz_set_PyIntOrLong(tempz, x);
+                mpz_inoc_pylong(tempz, x);
                 mpfr_clear_flags();
                 result->rc = mpfr_add_z(result->f, MPFR(y), tempz, GET_MPFR_ROUND(context));
-                mpz_cloc(tempz);
+                mpz_cloc_pylong(tempz);
                 goto done;
             }
             else {
@@ -393,13 +420,21 @@ GMPy_Real_Add(PyObject *x, PyObject *y, CTXT_Object *context)
  * If the other object isn't a Pympfr, call the appropriate function. If
  * no appropriate function can be found, return NotImplemented. */
 
+GMPY_PROFILE_WRAP(PyObject *, GMPy_MPFR_Add_Slot, (PyObject *x, PyObject *y),
+                  (x, y), gmpy_profile_bits2(x, y))
+
 static PyObject *
-GMPy_MPFR_Add_Slot(PyObject *x, PyObject *y)
+GMPy_MPFR_Add_Slot_Impl(PyObject *x, PyObject *y)
 {
-    if (IS_REAL(x) && IS_REAL(y))
+    int xtype, ytype;
+
+    xtype = GMPy_ObjectType(x);
+    ytype = GMPy_ObjectType(y);
+
+    if (IS_TYPE_REAL(xtype) && IS_TYPE_REAL(ytype))
         return GMPy_Real_Add(x, y, NULL);
 
-    if (IS_COMPLEX(x) && IS_COMPLEX(y))
+    if (IS_TYPE_COMPLEX(xtype) && IS_TYPE_COMPLEX(ytype))
         return GMPy_Complex_Add(x, y, NULL);
 
     Py_RETURN_NOTIMPLEMENTED;
@@ -425,6 +460,44 @@ GMPy_Complex_Add(PyObject *x, PyObject *y, CTXT_Object *context)
         goto done;
     }
 
+    /* A real operand is used as an mpfr, so no zero imaginary part is
+     * created or operated on. */
+    if (IS_COMPLEX(x) && IS_REAL(y)) {
+        MPC_Object *tempx;
+        MPFR_Object *tempy;
+
+        tempx = GMPy_MPC_From_Complex(x, 1, 1, context);
+        tempy = GMPy_MPFR_From_Real(y, 1, context);
+        if (!tempx || !tempy) {
+            Py_XDECREF((PyObject*)tempx);
+            Py_XDECREF((PyObject*)tempy);
+            Py_DECREF((PyObject*)result);
+            return NULL;
+        }
+        result->rc = mpc_add_fr(result->c, tempx->c, tempy->f, GET_MPC_ROUND(context));
+        Py_DECREF((PyObject*)tempx);
+        Py_DECREF((PyObject*)tempy);
+        goto done;
+    }
+
+    if (IS_REAL(x) && IS_COMPLEX(y)) {
+        MPFR_Object *tempx;
+        MPC_Object *tempy;
+
+        tempx = GMPy_MPFR_From_Real(x, 1, context);
+        tempy = GMPy_MPC_From_Complex(y, 1, 1, context);
+        if (!tempx || !tempy) {
+            Py_XDECREF((PyObject*)tempx);
+            Py_XDECREF((PyObject*)tempy);
+            Py_DECREF((PyObject*)result);
+            return NULL;
+        }
+        result->rc = mpc_add_fr(result->c, tempy->c, tempx->f, GET_MPC_ROUND(context));
+        Py_DECREF((PyObject*)tempx);
+        Py_DECREF((PyObject*)tempy);
+        goto done;
+    }
+
     if (IS_COMPLEX(x) && IS_COMPLEX(y)) {
         MPC_Object *tempx, *tempy;
 
@@ -455,25 +528,36 @@ GMPy_Complex_Add(PyObject *x, PyObject *y, CTXT_Object *context)
  * step of the numeric ladder, the NotImplemented return value from
  * Pympc_Add_Complex() is correct and is just passed on. */
 
+GMPY_PROFILE_WRAP(PyObject *, GMPy_MPC_Add_Slot, (PyObject *x, PyObject *y),
+                  (x, y), gmpy_profile_bits2(x, y))
+
 static PyObject *
-GMPy_MPC_Add_Slot(PyObject *x, PyObject *y)
+GMPy_MPC_Add_Slot_Impl(PyObject *x, PyObject *y)
 {
     return GMPy_Complex_Add(x, y, NULL);
 }
 
+GMPY_PROFILE_WRAP(PyObject *, GMPy_Number_Add, (PyObject *x, PyObject *y, CTXT_Object *context),
+                  (x, y, context), gmpy_profile_bits2(x, y))
+
 static PyObject *
-GMPy_Number_Add(PyObject *x, PyObject *y, CTXT_Object *context)
+GMPy_Number_Add_Impl(PyObject *x, PyObject *y, CTXT_Object *context)
 {
-    if (IS_INTEGER(x) && IS_INTEGER(y))
+    int xtype, ytype;
+
+    xtype = GMPy_ObjectType(x);
+    ytype = GMPy_ObjectType(y);
+
+    if (IS_TYPE_INTEGER(xtype) && IS_TYPE_INTEGER(ytype))
         return GMPy_Integer_Add(x, y, context);
 
-    if (IS_RATIONAL(x) && IS_RATIONAL(y))
+    if (IS_TYPE_RATIONAL(xtype) && IS_TYPE_RATIONAL(ytype))
         return GMPy_Rational_Add(x, y, context);
 
-    if (IS_REAL(x) && IS_REAL(y))
+    if (IS_TYPE_REAL(xtype) && IS_TYPE_REAL(ytype))
         return GMPy_Real_Add(x, y, context);
 
-    if (IS_COMPLEX(x) && IS_COMPLEX(y))
+    if (IS_TYPE_COMPLEX(xtype) && IS_TYPE_COMPLEX(ytype))
         return GMPy_Complex_Add(x, y, context);
 
     TYPE_ERROR("add() argument type not supported");
@@ -491,11 +575,11 @@ PyDoc_STRVAR(GMPy_doc_context_add,
 "Return x + y.");
 
 static PyObject *
-GMPy_Context_Add(PyObject *self, PyObject *args)
+GMPy_Context_Add(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     CTXT_Object *context = NULL;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (nargs != 2) {
         TYPE_ERROR("add() requires 2 arguments.");
         return NULL;
     }
@@ -507,6 +591,7 @@ GMPy_Context_Add(PyObject *self, PyObject *args)
         CHECK_CONTEXT(context);
     }
 
-    return GMPy_Number_Add(PyTuple_GET_ITEM(args, 0), PyTuple_GET_ITEM(args, 1), context);
+    return GMPy_Number_Add(args[0], args[1], context);
 }
+GMPY_FASTCALL_WRAPPER(GMPy_Context_Add)
 
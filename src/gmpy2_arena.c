@@ -0,0 +1,344 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_arena.c                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* An arena comes into effect when its __enter__ method is called and remains
+ * in effect for the current thread until __exit__ is called. While an arena
+ * is in effect, the memory requested by GMP, MPFR, and MPC is carved out of
+ * chunks of 'size' bytes instead of being requested from malloc.
+ *
+ * Freeing memory only decrements the count of live allocations in a chunk;
+ * the chunk is reused from the beginning once the count drops to zero. When
+ * the arena exits, its chunks are retired. Objects that outlive the arena
+ * keep their chunk alive and it is released when the last one is deleted.
+ *
+ * The functions are called with the GIL held, except for the memory
+ * functions of a thread that has released the GIL (see gmpy2_threads.c).
+ * Such a thread never allocates from its arena, but it may free or resize
+ * memory that lives in a chunk. The chunk list is then protected by
+ * arena_lock; use ARENA_LOCK around any code that reads or changes it.
+ */
+
+#define ARENA_ROUND(n) (((n) + ARENA_ALIGN - 1) & ~((size_t)ARENA_ALIGN - 1))
+
+static gmpy_arena_chunk *
+arena_chunk_new(void *owner, size_t size)
+{
+    gmpy_arena_chunk *chunk;
+    size_t header = ARENA_ROUND(sizeof(gmpy_arena_chunk));
+
+    if (!(chunk = GMPY_MALLOC(header + size)))
+        return NULL;
+    chunk->owner = owner;
+    chunk->data = (char*)chunk + header;
+    chunk->size = size;
+    chunk->used = 0;
+    chunk->last = 0;
+    chunk->live = 0;
+    chunk->retired = 0;
+
+    chunk->prev = NULL;
+    chunk->next = arena_chunks;
+    if (arena_chunks)
+        arena_chunks->prev = chunk;
+    arena_chunks = chunk;
+    return chunk;
+}
+
+static void
+arena_chunk_del(gmpy_arena_chunk *chunk)
+{
+    if (chunk->prev)
+        chunk->prev->next = chunk->next;
+    else
+        arena_chunks = chunk->next;
+    if (chunk->next)
+        chunk->next->prev = chunk->prev;
+    GMPY_FREE(chunk);
+}
+
+/* Stop allocating from a chunk. The chunk is released as soon as it holds
+ * no live allocations. */
+
+static void
+arena_chunk_retire(gmpy_arena_chunk *chunk)
+{
+    chunk->retired = 1;
+    if (!chunk->live)
+        arena_chunk_del(chunk);
+}
+
+/* Return the chunk containing 'ptr' or NULL if 'ptr' was not allocated from
+ * an arena. */
+
+static gmpy_arena_chunk *
+GMPy_Arena_Find(void *ptr)
+{
+    gmpy_arena_chunk *chunk;
+
+    /* The chunk currently in use is the most likely candidate. */
+    chunk = tls_arena;
+    if (chunk && (char*)ptr >= chunk->data && (char*)ptr < chunk->data + chunk->size)
+        return chunk;
+
+    for (chunk = arena_chunks; chunk; chunk = chunk->next) {
+        if ((char*)ptr >= chunk->data && (char*)ptr < chunk->data + chunk->size)
+            return chunk;
+    }
+    return NULL;
+}
+
+/* Allocate 'size' bytes from the arena in effect for the current thread.
+ * Returns NULL if no arena is in effect or if the request is larger than a
+ * chunk; the caller then uses malloc.
+ */
+
+static void *
+GMPy_Arena_Allocate(size_t size)
+{
+    gmpy_arena_chunk *chunk = tls_arena, *temp;
+    char *res;
+
+    if (!chunk || ARENA_NOGIL)
+        return NULL;
+
+    size = ARENA_ROUND(size);
+    if (size > chunk->size)
+        return NULL;
+
+    if (chunk->used + size > chunk->size) {
+        if (!(temp = arena_chunk_new(chunk->owner, chunk->size)))
+            return NULL;
+        arena_chunk_retire(chunk);
+        tls_arena = chunk = temp;
+    }
+
+    res = chunk->data + chunk->used;
+    chunk->last = chunk->used;
+    chunk->used += size;
+    chunk->live++;
+    return res;
+}
+
+static void *
+GMPy_Arena_Reallocate(gmpy_arena_chunk *chunk, void *ptr,
+                      size_t old_size, size_t new_size)
+{
+    void *res;
+
+    /* The most recent allocation can grow in place. */
+    if (chunk == tls_arena && (char*)ptr == chunk->data + chunk->last &&
+        chunk->last + ARENA_ROUND(new_size) <= chunk->size) {
+        chunk->used = chunk->last + ARENA_ROUND(new_size);
+        return ptr;
+    }
+
+    if (new_size <= old_size)
+        return ptr;
+
+    if (!(res = GMPy_Arena_Allocate(new_size)) &&
+        !(res = GMPY_MALLOC(new_size)))
+        Py_FatalError("Insufficient memory");
+
+    memcpy(res, ptr, old_size);
+    GMPy_Arena_Free(chunk, ptr);
+    return res;
+}
+
+static void
+GMPy_Arena_Free(gmpy_arena_chunk *chunk, void *ptr)
+{
+    if (--(chunk->live))
+        return;
+
+    if (chunk->retired) {
+        arena_chunk_del(chunk);
+    }
+    else {
+        chunk->used = 0;
+        chunk->last = 0;
+    }
+}
+
+PyDoc_STRVAR(GMPy_doc_arena,
+"arena(size=1048576) -> arena manager\n\n"
+"Return an arena manager for use with the 'with' statement. While the\n"
+"arena is in effect, the memory for new gmpy2 results is carved out of\n"
+"blocks of 'size' bytes instead of being allocated individually. The\n"
+"blocks are released when the 'with' statement exits. Results that are\n"
+"still referenced keep their memory and remain valid.");
+
+static PyObject *
+GMPy_Arena_Factory(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    ARENA_Object *result;
+    Py_ssize_t size = ARENA_DEFAULT_SIZE;
+    static char *kwlist[] = {"size", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|n", kwlist, &size))
+        return NULL;
+
+    if (size <= 0) {
+        VALUE_ERROR("arena size must be greater than 0");
+        return NULL;
+    }
+
+    if (!(result = PyObject_New(ARENA_Object, &Arena_Type)))
+        return NULL;
+    result->size = ARENA_ROUND((size_t)size);
+    result->prev = NULL;
+    result->active = 0;
+    return (PyObject*)result;
+}
+
+/* Retire the chunk used by 'self' and restore the previous arena. Returns 0
+ * if 'self' is not the innermost arena of the current thread.
+ */
+
+static int
+arena_close(ARENA_Object *self)
+{
+    gmpy_cache *cache;
+    int locked;
+
+    if (!tls_arena || tls_arena->owner != (void*)self)
+        return 0;
+
+    /* Cached limbs would keep the chunks alive. */
+    if ((cache = GMPy_current_cache()))
+        GMPy_Cache_Release_Arena(cache, (void*)self);
+
+    ARENA_LOCK(locked);
+    arena_chunk_retire(tls_arena);
+    ARENA_UNLOCK(locked);
+    tls_arena = self->prev;
+    self->prev = NULL;
+    self->active = 0;
+    return 1;
+}
+
+static void
+GMPy_Arena_Dealloc(ARENA_Object *self)
+{
+    if (self->active)
+        arena_close(self);
+    PyObject_Del(self);
+}
+
+static PyObject *
+GMPy_Arena_Repr_Slot(ARENA_Object *self)
+{
+    return Py2or3String_FromFormat("arena(size=%zu)", self->size);
+}
+
+static PyObject *
+GMPy_Arena_Enter(PyObject *self, PyObject *args)
+{
+    ARENA_Object *arena = (ARENA_Object*)self;
+    gmpy_arena_chunk *chunk;
+    int locked;
+
+    if (arena->active) {
+        RUNTIME_ERROR("arena is already in effect");
+        return NULL;
+    }
+
+    ARENA_LOCK(locked);
+    chunk = arena_chunk_new((void*)arena, arena->size);
+    ARENA_UNLOCK(locked);
+    if (!chunk) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+
+    arena->prev = tls_arena;
+    arena->active = 1;
+    tls_arena = chunk;
+
+    Py_INCREF(self);
+    return self;
+}
+
+static PyObject *
+GMPy_Arena_Exit(PyObject *self, PyObject *args)
+{
+    ARENA_Object *arena = (ARENA_Object*)self;
+
+    if (!arena->active)
+        Py_RETURN_NONE;
+
+    if (!arena_close(arena)) {
+        RUNTIME_ERROR("arena must be exited by the thread that entered it");
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyMethodDef GMPyArena_methods[] =
+{
+    { "__enter__", GMPy_Arena_Enter, METH_NOARGS, NULL },
+    { "__exit__", GMPy_Arena_Exit, METH_VARARGS, NULL },
+    { NULL, NULL, 1 }
+};
+
+static PyTypeObject Arena_Type =
+{
+#ifdef PY3
+    PyVarObject_HEAD_INIT(0, 0)
+#else
+    PyObject_HEAD_INIT(0)
+        0,                                   /* ob_size          */
+#endif
+    "gmpy2 arena",                           /* tp_name          */
+    sizeof(ARENA_Object),                    /* tp_basicsize     */
+        0,                                   /* tp_itemsize      */
+    (destructor) GMPy_Arena_Dealloc,         /* tp_dealloc       */
+        0,                                   /* tp_print         */
+        0,                                   /* tp_getattr       */
+        0,                                   /* tp_setattr       */
+        0,                                   /* tp_reserved      */
+    (reprfunc) GMPy_Arena_Repr_Slot,         /* tp_repr          */
+        0,                                   /* tp_as_number     */
+        0,                                   /* tp_as_sequence   */
+        0,                                   /* tp_as_mapping    */
+        0,                                   /* tp_hash          */
+        0,                                   /* tp_call          */
+        0,                                   /* tp_str           */
+        0,                                   /* tp_getattro      */
+        0,                                   /* tp_setattro      */
+        0,                                   /* tp_as_buffer     */
+    Py_TPFLAGS_DEFAULT,                      /* tp_flags         */
+    "GMPY2 arena manager",                   /* tp_doc           */
+        0,                                   /* tp_traverse      */
+        0,                                   /* tp_clear         */
+        0,                                   /* tp_richcompare   */
+        0,                                   /* tp_weaklistoffset*/
+        0,                                   /* tp_iter          */
+        0,                                   /* tp_iternext      */
+    GMPyArena_methods,                       /* tp_methods       */
+        0,                                   /* tp_members       */
+        0,                                   /* tp_getset        */
+};
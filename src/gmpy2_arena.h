@@ -0,0 +1,93 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_arena.h                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GMPY_ARENA_H
+#define GMPY_ARENA_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Limb storage allocated while an arena is active comes from large chunks
+ * managed by a bump allocator. A chunk is released once the arena scope has
+ * exited and every allocation made from it has been freed.
+ */
+
+typedef struct gmpy_arena_chunk {
+    struct gmpy_arena_chunk *next;  /* list of all live chunks */
+    struct gmpy_arena_chunk *prev;
+    void *owner;                    /* arena that created the chunk */
+    char *data;
+    size_t size;                    /* bytes available in data */
+    size_t used;                    /* bytes handed out */
+    size_t last;                    /* offset of the most recent allocation */
+    size_t live;                    /* allocations not yet freed */
+    int retired;                    /* no further allocations are made */
+} gmpy_arena_chunk;
+
+typedef struct {
+    PyObject_HEAD
+    size_t size;                    /* size of each chunk */
+    gmpy_arena_chunk *prev;         /* chunk active when __enter__ was called */
+    int active;
+} ARENA_Object;
+
+static PyTypeObject Arena_Type;
+
+#define ARENA_ALIGN 16
+#define ARENA_DEFAULT_SIZE 1048576
+
+/* Take arena_lock if a thread may be running without the GIL. */
+#ifdef WITHOUT_THREADS
+#  define ARENA_LOCK(locked) locked = 0
+#  define ARENA_UNLOCK(locked) (void)locked
+#  define ARENA_NOGIL 0
+#else
+#  define ARENA_LOCK(locked) \
+    if ((locked = (tls_nogil || nogil_count))) \
+        PyThread_acquire_lock(arena_lock, WAIT_LOCK)
+#  define ARENA_UNLOCK(locked) \
+    if (locked) PyThread_release_lock(arena_lock)
+#  define ARENA_NOGIL tls_nogil
+#endif
+
+static gmpy_arena_chunk * GMPy_Arena_Find(void *ptr);
+static void *             GMPy_Arena_Allocate(size_t size);
+static void *             GMPy_Arena_Reallocate(gmpy_arena_chunk *chunk, void *ptr,
+                                                size_t old_size, size_t new_size);
+static void               GMPy_Arena_Free(gmpy_arena_chunk *chunk, void *ptr);
+
+static PyObject *         GMPy_Arena_Factory(PyObject *self, PyObject *args, PyObject *kwargs);
+static void               GMPy_Arena_Dealloc(ARENA_Object *self);
+static PyObject *         GMPy_Arena_Repr_Slot(ARENA_Object *self);
+static PyObject *         GMPy_Arena_Enter(PyObject *self, PyObject *args);
+static PyObject *         GMPy_Arena_Exit(PyObject *self, PyObject *args);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -231,69 +231,138 @@ GMPy_MPFR_From_Old_Binary(PyObject *self, PyObject *other)
  *              2 => value is < 0
  *              3 => unassigned
  * byte[2]+: value
+ *
+ * Compact format of an mpz/xmpz whose absolute value is less than 2**63.
+ *
+ * byte[0]:     0x81 => mpz
+ *              0x82 => xmpz
+ * byte[1]+:    the value, zigzag encoded (0, -1, 1, -2, ... become 0, 1,
+ *              2, 3, ...) and written 7 bits per byte, least significant
+ *              group first. The high bit is set in every byte except the
+ *              last.
  */
 
-static PyObject *
-GMPy_MPZ_To_Binary(MPZ_Object *self)
+#define BINARY_COMPACT 0x80
+
+/* Return 1 and set *zigzag if z can use the compact format. */
+
+static int
+GMPy_MPZ_Binary_Zigzag(mpz_t z, uint64_t *zigzag)
 {
-    size_t size = 2;
-    int sgn;
-    char *buffer;
-    PyObject *result;
+    uint64_t mag;
 
-    sgn = mpz_sgn(self->z);
-    if (sgn == 0) {
-        TEMP_ALLOC(buffer, size);
-        buffer[0] = 0x01;
-        buffer[1] = 0x00;
-        goto done;
+    if (mpz_sizeinbase(z, 2) > 63)
+        return 0;
+    mag = mpz_getlimbn(z, 0);
+#if GMP_NUMB_BITS < 64
+    mag |= (uint64_t)mpz_getlimbn(z, 1) << GMP_NUMB_BITS;
+#endif
+    if (mpz_sgn(z) < 0)
+        *zigzag = 2 * mag - 1;
+    else
+        *zigzag = 2 * mag;
+    return 1;
+}
+
+/* Return the size of the binary representation of z. */
+
+static size_t
+GMPy_MPZ_Binary_Size(mpz_t z, int compact)
+{
+    uint64_t zigzag;
+    size_t size = 1;
+
+    if (compact && GMPy_MPZ_Binary_Zigzag(z, &zigzag)) {
+        do {
+            size++;
+            zigzag >>= 7;
+        } while (zigzag);
+        return size;
     }
+    if (mpz_sgn(z) == 0)
+        return 2;
+    return ((mpz_sizeinbase(z, 2) + 7) / 8) + 2;
+}
 
-    size = ((mpz_sizeinbase(self->z, 2) + 7) / 8) + 2;
+/* Write the binary representation of z, using GMPy_MPZ_Binary_Size(z)
+ * bytes, to buffer. code is 0x01 for an mpz or 0x02 for an xmpz.
+ */
 
-    TEMP_ALLOC(buffer, size);
-    buffer[0] = 0x01;
+static void
+GMPy_MPZ_Binary_Write(char *buffer, mpz_t z, char code, int compact)
+{
+    uint64_t zigzag;
+    int sgn = mpz_sgn(z);
+
+    if (compact && GMPy_MPZ_Binary_Zigzag(z, &zigzag)) {
+        *buffer++ = code | BINARY_COMPACT;
+        while (zigzag >= 0x80) {
+            *buffer++ = (char)((zigzag & 0x7f) | 0x80);
+            zigzag >>= 7;
+        }
+        *buffer = (char)zigzag;
+        return;
+    }
+
+    buffer[0] = code;
+    if (sgn == 0) {
+        buffer[1] = 0x00;
+        return;
+    }
     if (sgn > 0)
         buffer[1] = 0x01;
     else
         buffer[1] = 0x02;
-    mpz_export(buffer+2, NULL, -1, sizeof(char), 0, 0, self->z);
+    mpz_export(buffer+2, NULL, -1, sizeof(char), 0, 0, z);
+}
 
-  done:
-    result = PyBytes_FromStringAndSize(buffer, size);
-    TEMP_FREE(buffer, size);
-    return result;
+/* Set z from the compact format in buffer[1:len]. Return -1 if the
+ * encoding is invalid.
+ */
+
+static int
+GMPy_MPZ_Binary_Read_Compact(mpz_t z, unsigned char *buffer, Py_ssize_t len)
+{
+    uint64_t zigzag = 0, mag;
+    Py_ssize_t i;
+    int shift = 0;
+
+    for (i = 1; i < len; i++, shift += 7) {
+        if (shift == 63 && buffer[i] > 1)
+            return -1;
+        zigzag |= (uint64_t)(buffer[i] & 0x7f) << shift;
+        if (!(buffer[i] & 0x80))
+            break;
+    }
+    if (i != len - 1)
+        return -1;
+
+    mag = (zigzag >> 1) + (zigzag & 1);
+    mpz_import(z, 1, -1, sizeof(uint64_t), 0, 0, &mag);
+    if (zigzag & 1)
+        mpz_neg(z, z);
+    return 0;
 }
 
 static PyObject *
-GMPy_XMPZ_To_Binary(XMPZ_Object *self)
+GMPy_MPZ_To_Binary(MPZ_Object *self, int compact)
 {
-    size_t size = 2;
-    int sgn;
-    char *buffer;
     PyObject *result;
 
-    sgn = mpz_sgn(self->z);
-    if (sgn == 0) {
-        TEMP_ALLOC(buffer, size);
-        buffer[0] = 0x02;
-        buffer[1] = 0x00;
-        goto done;
-    }
-
-    size = ((mpz_sizeinbase(self->z, 2) + 7) / 8) + 2;
+    result = PyBytes_FromStringAndSize(NULL, GMPy_MPZ_Binary_Size(self->z, compact));
+    if (result)
+        GMPy_MPZ_Binary_Write(PyBytes_AS_STRING(result), self->z, 0x01, compact);
+    return result;
+}
 
-    TEMP_ALLOC(buffer, size);
-    buffer[0] = 0x02;
-    if (sgn > 0)
-        buffer[1] = 0x01;
-    else
-        buffer[1] = 0x02;
-    mpz_export(buffer+2, NULL, -1, sizeof(char), 0, 0, self->z);
+static PyObject *
+GMPy_XMPZ_To_Binary(XMPZ_Object *self, int compact)
+{
+    PyObject *result;
 
-  done:
-    result = PyBytes_FromStringAndSize(buffer, size);
-    TEMP_FREE(buffer, size);
+    result = PyBytes_FromStringAndSize(NULL, GMPy_MPZ_Binary_Size(self->z, compact));
+    if (result)
+        GMPy_MPZ_Binary_Write(PyBytes_AS_STRING(result), self->z, 0x02, compact);
     return result;
 }
 
@@ -627,8 +696,6 @@ PyDoc_STRVAR(doc_from_binary,
 static PyObject *
 GMPy_MPANY_From_Binary(PyObject *self, PyObject *other)
 {
-    unsigned char *buffer, *cp;
-    Py_ssize_t len;
     CTXT_Object *context = NULL;
 
     CHECK_CONTEXT(context);
@@ -638,15 +705,44 @@ GMPy_MPANY_From_Binary(PyObject *self, PyObject *other)
         return NULL;
     }
 
-    len = PyBytes_Size(other);
+    return GMPy_MPANY_From_Binary_Data((unsigned char*)PyBytes_AS_STRING(other),
+                                       PyBytes_GET_SIZE(other), context);
+}
+
+/* Decode the len bytes at buffer. The data may be part of a larger buffer,
+ * so nothing beyond buffer[len-1] is read.
+ */
+
+static PyObject *
+GMPy_MPANY_From_Binary_Data(unsigned char *buffer, Py_ssize_t len,
+                            CTXT_Object *context)
+{
+    unsigned char *cp;
+
     if (len < 2) {
         VALUE_ERROR("byte sequence too short for from_binary()");
         return NULL;
     }
-    buffer = (unsigned char*)PyBytes_AsString(other);
     cp = buffer;
 
     switch (cp[0]) {
+        case 0x81:
+        case 0x82: {
+            PyObject *result;
+
+            if (cp[0] == 0x81)
+                result = (PyObject*)GMPy_MPZ_New(NULL);
+            else
+                result = (PyObject*)GMPy_XMPZ_New(NULL);
+            if (!result)
+                return NULL;
+            if (GMPy_MPZ_Binary_Read_Compact(MPZ(result), cp, len) < 0) {
+                VALUE_ERROR("byte sequence invalid for from_binary()");
+                Py_DECREF(result);
+                return NULL;
+            }
+            return result;
+        }
         case 0x01: {
             MPZ_Object *result;
 
@@ -1156,20 +1252,22 @@ GMPy_MPANY_From_Binary(PyObject *self, PyObject *other)
 }
 
 PyDoc_STRVAR(doc_to_binary,
-"to_binary(x) -> bytes\n"
+"to_binary(x[, compact=False]) -> bytes\n"
 "Return a Python byte sequence that is a portable binary\n"
 "representation of a gmpy2 object x. The byte sequence can\n"
 "be passed to gmpy2.from_binary() to obtain an exact copy of\n"
 "x's value. Works with mpz, xmpz, mpq, mpfr, and mpc types. \n"
+"If compact is True, an mpz or xmpz with an absolute value less\n"
+"than 2**63 uses a shorter variable-length encoding.\n"
 "Raises TypeError if x is not a gmpy2 object.");
 
 static PyObject *
-GMPy_MPANY_To_Binary(PyObject *self, PyObject *other)
+GMPy_MPANY_To_Binary(PyObject *other, int compact)
 {
     if(MPZ_Check(other))
-        return GMPy_MPZ_To_Binary((MPZ_Object*)other);
+        return GMPy_MPZ_To_Binary((MPZ_Object*)other, compact);
     else if(XMPZ_Check(other))
-        return GMPy_XMPZ_To_Binary((XMPZ_Object*)other);
+        return GMPy_XMPZ_To_Binary((XMPZ_Object*)other, compact);
     else if(MPQ_Check(other))
         return GMPy_MPQ_To_Binary((MPQ_Object*)other);
     else if(MPFR_Check(other))
@@ -1180,3 +1278,449 @@ GMPy_MPANY_To_Binary(PyObject *self, PyObject *other)
     return NULL;
 }
 
+static PyObject *
+GMPy_MPANY_To_Binary_Function(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    PyObject *x;
+    int compact = 0;
+    static char *kwlist[] = {"x", "compact", NULL};
+
+    if (PyTuple_GET_SIZE(args) == 1 && !keywds)
+        return GMPy_MPANY_To_Binary(PyTuple_GET_ITEM(args, 0), 0);
+
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "O|i", kwlist, &x, &compact))
+        return NULL;
+    return GMPy_MPANY_To_Binary(x, compact);
+}
+
+/* Format of the binary representation of a sequence of gmpy2 objects.
+ *
+ * byte[0]:      6 => sequence
+ * byte[1]:      0 (reserved)
+ * byte[2-9]:    n, the number of items, as a 64-bit little-endian value
+ * byte[10+]:    n+1 offsets, each a 64-bit little-endian value
+ * byte[10+8*(n+1)]+: the binary representation of each item, as created
+ *               by to_binary(). Item i starts at offset[i] and ends just
+ *               before offset[i+1]. Offsets are relative to the start of
+ *               the item data.
+ */
+
+#define BINARY_MANY_HEADER 10
+
+static void
+GMPy_Binary_Put64(unsigned char *cp, uint64_t value)
+{
+    int i;
+
+    for (i = 0; i < 8; i++) {
+        cp[i] = (unsigned char)(value & 0xff);
+        value >>= 8;
+    }
+}
+
+static uint64_t
+GMPy_Binary_Get64(const unsigned char *cp)
+{
+    uint64_t value = 0;
+    int i;
+
+    for (i = 7; i >= 0; i--)
+        value = (value << 8) | cp[i];
+    return value;
+}
+
+PyDoc_STRVAR(doc_to_binary_many,
+"to_binary_many(seq[, compact=False]) -> bytes\n"
+"Return a single byte sequence containing the binary representation\n"
+"of each gmpy2 object in seq, preceded by a table of offsets. The\n"
+"byte sequence can be passed to gmpy2.from_binary_many() to obtain a\n"
+"list with an exact copy of each value. compact has the same\n"
+"meaning as for to_binary().");
+
+static PyObject *
+GMPy_MPANY_To_Binary_Many(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    PyObject *other, *seq, **items, **parts = NULL, *result = NULL;
+    Py_ssize_t n, i;
+    size_t header, total = 0, size;
+    unsigned char *cp, *data;
+    int compact = 0;
+    static char *kwlist[] = {"seq", "compact", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "O|i", kwlist, &other, &compact))
+        return NULL;
+
+    if (!(seq = PySequence_Fast(other, "to_binary_many() requires a sequence")))
+        return NULL;
+
+    n = PySequence_Fast_GET_SIZE(seq);
+    items = PySequence_Fast_ITEMS(seq);
+
+    if (!(parts = GMPY_MALLOC((n ? n : 1) * sizeof(PyObject*)))) {
+        PyErr_NoMemory();
+        goto done;
+    }
+
+    /* mpz and xmpz values are written directly into the result. All other
+     * types are converted with to_binary() first.
+     */
+    for (i = 0; i < n; i++) {
+        if (CHECK_MPZANY(items[i])) {
+            parts[i] = NULL;
+            total += GMPy_MPZ_Binary_Size(MPZ(items[i]), compact);
+        }
+        else {
+            if (!(parts[i] = GMPy_MPANY_To_Binary(items[i], compact))) {
+                n = i;
+                goto done;
+            }
+            total += PyBytes_GET_SIZE(parts[i]);
+        }
+    }
+
+    header = BINARY_MANY_HEADER + 8 * ((size_t)n + 1);
+    if (!(result = PyBytes_FromStringAndSize(NULL, header + total)))
+        goto done;
+
+    cp = (unsigned char*)PyBytes_AS_STRING(result);
+    cp[0] = 0x06;
+    cp[1] = 0x00;
+    GMPy_Binary_Put64(cp + 2, (uint64_t)n);
+    data = cp + header;
+    cp += BINARY_MANY_HEADER;
+    total = 0;
+    for (i = 0; i < n; i++) {
+        GMPy_Binary_Put64(cp + 8 * i, (uint64_t)total);
+        if (parts[i]) {
+            size = PyBytes_GET_SIZE(parts[i]);
+            memcpy(data + total, PyBytes_AS_STRING(parts[i]), size);
+        }
+        else {
+            size = GMPy_MPZ_Binary_Size(MPZ(items[i]), compact);
+            GMPy_MPZ_Binary_Write((char*)data + total, MPZ(items[i]),
+                                  XMPZ_Check(items[i]) ? 0x02 : 0x01, compact);
+        }
+        total += size;
+    }
+    GMPy_Binary_Put64(cp + 8 * n, (uint64_t)total);
+
+  done:
+    if (parts) {
+        for (i = 0; i < n; i++)
+            Py_XDECREF(parts[i]);
+        GMPY_FREE(parts);
+    }
+    Py_DECREF(seq);
+    return result;
+}
+
+PyDoc_STRVAR(doc_from_binary_many,
+"from_binary_many(buffer) -> list\n"
+"Return a list of gmpy2 objects from a byte sequence created by\n"
+"gmpy2.to_binary_many(). buffer may be any object that supports the\n"
+"buffer protocol, such as bytes, memoryview, or mmap. The items are\n"
+"decoded in place without copying.");
+
+static PyObject *
+GMPy_MPANY_From_Binary_Many(PyObject *self, PyObject *other)
+{
+    PyObject *result = NULL, *temp;
+    Py_buffer view;
+    unsigned char *cp, *data;
+    uint64_t n, i, start, stop, datalen;
+    CTXT_Object *context = NULL;
+
+    CHECK_CONTEXT(context);
+
+    if (PyObject_GetBuffer(other, &view, PyBUF_SIMPLE) < 0)
+        return NULL;
+
+    cp = (unsigned char*)view.buf;
+    if (view.len < BINARY_MANY_HEADER + 8 || cp[0] != 0x06) {
+        VALUE_ERROR("invalid byte sequence for from_binary_many()");
+        goto done;
+    }
+
+    n = GMPy_Binary_Get64(cp + 2);
+    if (n >= (uint64_t)(view.len - BINARY_MANY_HEADER) / 8 ||
+        n >= PY_SSIZE_T_MAX / 8) {
+        VALUE_ERROR("invalid byte sequence for from_binary_many()");
+        goto done;
+    }
+    data = cp + BINARY_MANY_HEADER + 8 * (n + 1);
+    datalen = (uint64_t)(view.len - BINARY_MANY_HEADER) - 8 * (n + 1);
+    cp += BINARY_MANY_HEADER;
+
+    if (!(result = PyList_New((Py_ssize_t)n)))
+        goto done;
+
+    stop = GMPy_Binary_Get64(cp);
+    for (i = 0; i < n; i++) {
+        start = stop;
+        stop = GMPy_Binary_Get64(cp + 8 * (i + 1));
+        if (start > stop || stop > datalen) {
+            VALUE_ERROR("invalid byte sequence for from_binary_many()");
+            Py_CLEAR(result);
+            goto done;
+        }
+        if (!(temp = GMPy_MPANY_From_Binary_Data(data + start,
+                                                 (Py_ssize_t)(stop - start),
+                                                 context))) {
+            Py_CLEAR(result);
+            goto done;
+        }
+        PyList_SET_ITEM(result, (Py_ssize_t)i, temp);
+    }
+
+  done:
+    PyBuffer_Release(&view);
+    return result;
+}
+
+#ifdef GMPY_PICKLE_BUFFER
+
+/* Pickle protocol 5 lets large values be sent "out-of-band": instead of
+ * copying the value into the pickle, __reduce_ex__ returns a PickleBuffer
+ * over the limbs, which the pickler hands to its buffer_callback. The value
+ * is rebuilt by _from_limbs(), which records the limb size and byte order
+ * so a pickle can still be read on a different platform:
+ *
+ *   _from_limbs(1, limbs, negative, limb_bytes, endian)    mpz
+ *   _from_limbs(2, limbs, negative, limb_bytes, endian)    xmpz
+ *   _from_limbs(4, limbs, negative, limb_bytes, endian, prec, exp)  mpfr
+ *
+ * Smaller values, older protocols, mpfr values that are 0, infinite or
+ * NaN, and all mpq and mpc values are pickled with to_binary() as before.
+ */
+
+#ifdef WORDS_BIGENDIAN
+#  define PICKLE_ENDIAN 1
+#else
+#  define PICKLE_ENDIAN -1
+#endif
+
+/* The low s bits of a limb, for 0 <= s < GMP_NUMB_BITS. */
+#define PICKLE_LOW_MASK(s) (((mp_limb_t)1 << (s)) - 1)
+
+/* Return a new reference to the function 'name' of the gmpy2 module of the
+ * current interpreter. Each interpreter has its own module object, so the
+ * functions named in a pickle are looked up when it is created.
+ */
+
+static PyObject *
+pickle_function(const char *name)
+{
+    PyObject *key, *module, *result;
+
+    if (!(key = PyUnicode_FromString("gmpy2")))
+        return NULL;
+    module = PyImport_GetModule(key);
+    Py_DECREF(key);
+    if (!module) {
+        if (!PyErr_Occurred())
+            RUNTIME_ERROR("gmpy2 module not found");
+        return NULL;
+    }
+    result = PyObject_GetAttrString(module, name);
+    Py_DECREF(module);
+    return result;
+}
+
+/* An mpfr has no buffer interface of its own; a Limbs_Object exports the
+ * significand of the mpfr it refers to.
+ */
+
+static int
+GMPy_Limbs_GetBuffer(Limbs_Object *self, Py_buffer *view, int flags)
+{
+    mpfr_ptr f = MPFR(self->obj);
+
+    return PyBuffer_FillInfo(view, (PyObject*)self, f->_mpfr_d,
+                             (Py_ssize_t)(PICKLE_LIMBS(mpfr_get_prec(f)) * sizeof(mp_limb_t)),
+                             1, flags);
+}
+
+static void
+GMPy_Limbs_Dealloc(Limbs_Object *self)
+{
+    Py_DECREF(self->obj);
+    PyObject_Del(self);
+}
+
+static PyBufferProcs GMPy_Limbs_as_buffer = {
+    (getbufferproc) GMPy_Limbs_GetBuffer,
+    (releasebufferproc) NULL,
+};
+
+static PyTypeObject Limbs_Type =
+{
+    PyVarObject_HEAD_INIT(0, 0)
+    "gmpy2 limbs",                           /* tp_name          */
+    sizeof(Limbs_Object),                    /* tp_basicsize     */
+        0,                                   /* tp_itemsize      */
+    (destructor) GMPy_Limbs_Dealloc,         /* tp_dealloc       */
+        0,                                   /* tp_print         */
+        0,                                   /* tp_getattr       */
+        0,                                   /* tp_setattr       */
+        0,                                   /* tp_reserved      */
+        0,                                   /* tp_repr          */
+        0,                                   /* tp_as_number     */
+        0,                                   /* tp_as_sequence   */
+        0,                                   /* tp_as_mapping    */
+        0,                                   /* tp_hash          */
+        0,                                   /* tp_call          */
+        0,                                   /* tp_str           */
+        0,                                   /* tp_getattro      */
+        0,                                   /* tp_setattro      */
+    &GMPy_Limbs_as_buffer,                   /* tp_as_buffer     */
+    Py_TPFLAGS_DEFAULT,                      /* tp_flags         */
+    "GMPY2 mpfr significand",                /* tp_doc           */
+};
+
+static int
+GMPy_Pickle_Init(PyObject *module)
+{
+    if (PyType_Ready(&Limbs_Type) < 0)
+        return -1;
+    return 0;
+}
+
+PyDoc_STRVAR(GMPy_doc_reduce_ex,
+"x.__reduce_ex__(protocol) -> tuple\n\n"
+"Support for pickling. With protocol 5 or later, large values are\n"
+"pickled as a PickleBuffer over their limbs, which can be transferred\n"
+"out-of-band.");
+
+static PyObject *
+GMPy_MPANY_Reduce_Ex(PyObject *self, PyObject *args)
+{
+    PyObject *buffer, *temp, *result;
+    Limbs_Object *limbs;
+    int protocol;
+
+    if (!PyArg_ParseTuple(args, "i", &protocol))
+        return NULL;
+
+    if (protocol >= 5) {
+        if (CHECK_MPZANY(self) &&
+            mpz_size(MPZ(self)) * sizeof(mp_limb_t) >= PICKLE_BUFFER_MIN) {
+            if (!(buffer = PyPickleBuffer_FromObject(self)))
+                return NULL;
+            return Py_BuildValue("N(iNiii)", pickle_function("_from_limbs"),
+                                 MPZ_Check(self) ? 1 : 2, buffer,
+                                 mpz_sgn(MPZ(self)) < 0, (int)sizeof(mp_limb_t),
+                                 PICKLE_ENDIAN);
+        }
+        if (MPFR_Check(self) && mpfr_regular_p(MPFR(self)) &&
+            PICKLE_LIMBS(mpfr_get_prec(MPFR(self))) * sizeof(mp_limb_t) >= PICKLE_BUFFER_MIN) {
+            if (!(limbs = PyObject_New(Limbs_Object, &Limbs_Type)))
+                return NULL;
+            Py_INCREF(self);
+            limbs->obj = self;
+            buffer = PyPickleBuffer_FromObject((PyObject*)limbs);
+            Py_DECREF((PyObject*)limbs);
+            if (!buffer)
+                return NULL;
+            return Py_BuildValue("N(iNiiill)", pickle_function("_from_limbs"), 4, buffer,
+                                 mpfr_signbit(MPFR(self)) != 0,
+                                 (int)sizeof(mp_limb_t), PICKLE_ENDIAN,
+                                 (long)mpfr_get_prec(MPFR(self)),
+                                 (long)mpfr_get_exp(MPFR(self)));
+        }
+    }
+
+    if (!(temp = GMPy_MPANY_To_Binary(self, 0)))
+        return NULL;
+    result = Py_BuildValue("N(N)", pickle_function("from_binary"), temp);
+    return result;
+}
+
+PyDoc_STRVAR(GMPy_doc_from_limbs,
+"_from_limbs(code, limbs, negative, limb_bytes, endian[, prec, exp])\n\n"
+"Rebuild a value pickled by __reduce_ex__() with protocol 5.");
+
+static PyObject *
+GMPy_MPANY_From_Limbs(PyObject *self, PyObject *args)
+{
+    PyObject *obj, *result = NULL;
+    Py_buffer view;
+    int code, negative, limb_bytes, endian;
+    long prec = 0, exp = 0;
+    size_t count;
+
+    if (!PyArg_ParseTuple(args, "iOiii|ll", &code, &obj, &negative,
+                          &limb_bytes, &endian, &prec, &exp))
+        return NULL;
+
+    if (PyObject_GetBuffer(obj, &view, PyBUF_SIMPLE) < 0)
+        return NULL;
+
+    if ((limb_bytes != 4 && limb_bytes != 8) || (endian != 1 && endian != -1) ||
+        view.len % limb_bytes)
+        goto invalid;
+    count = (size_t)(view.len / limb_bytes);
+
+    if (code == 1 || code == 2) {
+        if (code == 1)
+            result = (PyObject*)GMPy_MPZ_New(NULL);
+        else
+            result = (PyObject*)GMPy_XMPZ_New(NULL);
+        if (!result)
+            goto done;
+        GMPY_BEGIN_NOGIL((size_t)view.len * 8);
+        mpz_import(MPZ(result), count, -1, (size_t)limb_bytes, endian, 0, view.buf);
+        GMPY_END_NOGIL;
+        if (negative)
+            mpz_neg(MPZ(result), MPZ(result));
+    }
+    else if (code == 4) {
+        mpz_t temp;
+        mp_limb_t *d;
+        size_t n;
+
+        /* The significand may be padded to a multiple of 64 bits. */
+        if (prec < MPFR_PREC_MIN || prec > MPFR_PREC_MAX ||
+            count * limb_bytes * 8 < (size_t)prec ||
+            count * limb_bytes * 8 >= (size_t)prec + 64)
+            goto invalid;
+        if (!(result = (PyObject*)GMPy_MPFR_New((mpfr_prec_t)prec, NULL)))
+            goto done;
+
+        d = ((MPFR_Object*)result)->f->_mpfr_d;
+        n = PICKLE_LIMBS(prec);
+
+        /* Copy the limbs directly if they are in the native layout and are
+         * a valid significand. Otherwise let MPFR round them.
+         */
+        if (limb_bytes == sizeof(mp_limb_t) && endian == PICKLE_ENDIAN && count == n &&
+            (((mp_limb_t*)view.buf)[n - 1] >> (GMP_NUMB_BITS - 1)) &&
+            !(((mp_limb_t*)view.buf)[0] & PICKLE_LOW_MASK(n * GMP_NUMB_BITS - prec)) &&
+            exp >= mpfr_get_emin() && exp <= mpfr_get_emax()) {
+            memcpy(d, view.buf, n * sizeof(mp_limb_t));
+            ((MPFR_Object*)result)->f->_mpfr_exp = (mpfr_exp_t)exp;
+            mpfr_setsign(MPFR(result), MPFR(result), negative, MPFR_RNDN);
+        }
+        else {
+            mpz_init(temp);
+            mpz_import(temp, count, -1, (size_t)limb_bytes, endian, 0, view.buf);
+            if (negative)
+                mpz_neg(temp, temp);
+            ((MPFR_Object*)result)->rc =
+                mpfr_set_z_2exp(MPFR(result), temp, (mpfr_exp_t)(exp - (long)count * limb_bytes * 8),
+                                MPFR_RNDN);
+            mpz_clear(temp);
+        }
+    }
+    else {
+        goto invalid;
+    }
+    goto done;
+
+  invalid:
+    VALUE_ERROR("invalid limb data for _from_limbs()");
+  done:
+    PyBuffer_Release(&view);
+    return result;
+}
+
+#endif
@@ -42,14 +42,45 @@ static PyObject * GMPy_MPQ_From_Old_Binary(PyObject *self, PyObject *other);
 static PyObject * GMPy_MPFR_From_Old_Binary(PyObject *self, PyObject *other);
 
 static PyObject * GMPy_MPANY_From_Binary(PyObject *self, PyObject *other);
-static PyObject * GMPy_MPANY_To_Binary(PyObject *self, PyObject *other);
+static PyObject * GMPy_MPANY_From_Binary_Data(unsigned char *buffer, Py_ssize_t len,
+                                              CTXT_Object *context);
+static PyObject * GMPy_MPANY_To_Binary(PyObject *other, int compact);
+static PyObject * GMPy_MPANY_To_Binary_Function(PyObject *self, PyObject *args, PyObject *keywds);
+static PyObject * GMPy_MPANY_To_Binary_Many(PyObject *self, PyObject *args, PyObject *keywds);
+static PyObject * GMPy_MPANY_From_Binary_Many(PyObject *self, PyObject *other);
 
-static PyObject * GMPy_MPZ_To_Binary(MPZ_Object *self);
-static PyObject * GMPy_XMPZ_To_Binary(XMPZ_Object *self);
+static int        GMPy_MPZ_Binary_Zigzag(mpz_t z, uint64_t *zigzag);
+static size_t     GMPy_MPZ_Binary_Size(mpz_t z, int compact);
+static void       GMPy_MPZ_Binary_Write(char *buffer, mpz_t z, char code, int compact);
+static int        GMPy_MPZ_Binary_Read_Compact(mpz_t z, unsigned char *buffer, Py_ssize_t len);
+static PyObject * GMPy_MPZ_To_Binary(MPZ_Object *self, int compact);
+static PyObject * GMPy_XMPZ_To_Binary(XMPZ_Object *self, int compact);
 static PyObject * GMPy_MPQ_To_Binary(MPQ_Object *self);
 static PyObject * GMPy_MPFR_To_Binary(MPFR_Object *self);
 static PyObject * GMPy_MPC_To_Binary(MPC_Object *self);
 
+/* Protocol 5 pickling needs PickleBuffer, added in Python 3.8. */
+#if defined(PY3) && PY_VERSION_HEX >= 0x03080000
+#  define GMPY_PICKLE_BUFFER
+
+/* Values with fewer bytes of limbs are pickled in-band. */
+#define PICKLE_BUFFER_MIN 1024
+
+/* Number of limbs in the significand of an mpfr with precision p. */
+#define PICKLE_LIMBS(p) (((size_t)(p) + GMP_NUMB_BITS - 1) / GMP_NUMB_BITS)
+
+typedef struct {
+    PyObject_HEAD
+    PyObject *obj;                  /* the mpfr whose limbs are exported */
+} Limbs_Object;
+
+static PyTypeObject Limbs_Type;
+
+static int        GMPy_Pickle_Init(PyObject *module);
+static PyObject * GMPy_MPANY_Reduce_Ex(PyObject *self, PyObject *args);
+static PyObject * GMPy_MPANY_From_Limbs(PyObject *self, PyObject *args);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,208 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_binsplit.c                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+static void
+binsplit_eval(mpz_ptr r, const binsplit_poly *poly, unsigned long k)
+{
+    Py_ssize_t i;
+
+    if (!poly->len) {
+        mpz_set_ui(r, 0);
+        return;
+    }
+    mpz_set(r, poly->coef[poly->len - 1]->z);
+    for (i = poly->len - 2; i >= 0; i--) {
+        mpz_mul_ui(r, r, k);
+        mpz_add(r, r, poly->coef[i]->z);
+    }
+}
+
+/* Compute P, Q, B and T for [n1, n2) into s, which must be initialized.
+ * Sets *zero if q(k) or b(k) is 0 for some k in the range. */
+
+static void
+binsplit_range(const binsplit_poly *polys, unsigned long n1, unsigned long n2,
+               binsplit_sum *s, int *zero)
+{
+    binsplit_sum r;
+    unsigned long m;
+
+    if (n2 - n1 == 1) {
+        binsplit_eval(s->P, &polys[0], n1);
+        binsplit_eval(s->Q, &polys[1], n1);
+        binsplit_eval(s->T, &polys[2], n1);
+        binsplit_eval(s->B, &polys[3], n1);
+        mpz_mul(s->T, s->T, s->P);
+        if (!mpz_sgn(s->Q) || !mpz_sgn(s->B)) {
+            *zero = 1;
+        }
+        return;
+    }
+
+    m = n1 + (n2 - n1) / 2;
+    binsplit_range(polys, n1, m, s, zero);
+    mpz_init(r.P);
+    mpz_init(r.Q);
+    mpz_init(r.B);
+    mpz_init(r.T);
+    binsplit_range(polys, m, n2, &r, zero);
+
+    mpz_mul(s->T, s->T, r.B);
+    mpz_mul(s->T, s->T, r.Q);
+    mpz_mul(r.T, r.T, s->B);
+    mpz_mul(r.T, r.T, s->P);
+    mpz_add(s->T, s->T, r.T);
+    mpz_mul(s->P, s->P, r.P);
+    mpz_mul(s->Q, s->Q, r.Q);
+    mpz_mul(s->B, s->B, r.B);
+
+    mpz_clear(r.P);
+    mpz_clear(r.Q);
+    mpz_clear(r.B);
+    mpz_clear(r.T);
+}
+
+/* Read a polynomial given as an integer or as an iterable of integer
+ * coefficients. Returns 0 on success or -1 with an exception set. */
+
+static int
+binsplit_parse(PyObject *obj, binsplit_poly *poly)
+{
+    static const char *msg = "binary_split() requires integers or iterables of integers";
+    PyObject *tuple;
+
+    if (IS_INTEGER(obj)) {
+        if (!(tuple = PyTuple_Pack(1, obj)))
+            return -1;
+        poly->coef = GMPy_MPZ_Array_From_Iterable(tuple, &poly->len, msg, NULL);
+        Py_DECREF(tuple);
+    }
+    else {
+        poly->coef = GMPy_MPZ_Array_From_Iterable(obj, &poly->len, msg, NULL);
+    }
+    return poly->coef ? 0 : -1;
+}
+
+PyDoc_STRVAR(GMPy_doc_function_binary_split,
+"binary_split(p, q, a, b, n, exact=True) -> mpq or mpfr\n\n"
+"Return the sum for k in range(n) of\n\n"
+"    a(k)/b(k) * p(0)*...*p(k) / (q(0)*...*q(k))\n\n"
+"where p, q, a and b are polynomials in k given as lists of integer\n"
+"coefficients, lowest degree first, or as integers for constant\n"
+"polynomials. The sum is evaluated by binary splitting. If exact is\n"
+"False, the result is an mpfr rounded to the precision of the current\n"
+"context instead of an mpq.");
+
+static PyObject *
+GMPy_Function_BinarySplit(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    static char *kwlist[] = {"p", "q", "a", "b", "n", "exact", NULL};
+    PyObject *objs[4], *exact = NULL, *result = NULL;
+    binsplit_poly polys[4];
+    binsplit_sum s;
+    MPQ_Object *sum;
+    Py_ssize_t n;
+    int i, zero = 0;
+    CTXT_Object *context = NULL;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OOOOn|O:binary_split", kwlist,
+                                     &objs[0], &objs[1], &objs[2], &objs[3],
+                                     &n, &exact))
+        return NULL;
+
+    if (n < 0) {
+        VALUE_ERROR("binary_split() requires n >= 0");
+        return NULL;
+    }
+    if ((size_t)n > ULONG_MAX) {
+        OVERFLOW_ERROR("binary_split() requires n to fit in an unsigned long");
+        return NULL;
+    }
+
+    CHECK_CONTEXT(context);
+
+    for (i = 0; i < 4; i++) {
+        if (binsplit_parse(objs[i], &polys[i])) {
+            while (--i >= 0) {
+                GMPy_MPZ_Array_Free(polys[i].coef, polys[i].len);
+            }
+            return NULL;
+        }
+    }
+
+    if (!(sum = GMPy_MPQ_New(context)))
+        goto done;
+
+    if (n) {
+        mpz_init(s.P);
+        mpz_init(s.Q);
+        mpz_init(s.B);
+        mpz_init(s.T);
+        GMPY_BEGIN_NOGIL((size_t)n * GMP_NUMB_BITS);
+        binsplit_range(polys, 0, (unsigned long)n, &s, &zero);
+        mpz_mul(s.B, s.B, s.Q);
+        GMPY_END_NOGIL;
+        mpz_swap(mpq_numref(sum->q), s.T);
+        mpz_swap(mpq_denref(sum->q), s.B);
+        mpz_clear(s.P);
+        mpz_clear(s.Q);
+        mpz_clear(s.B);
+        mpz_clear(s.T);
+
+        if (zero) {
+            ZERO_ERROR("binary_split() requires q(k) and b(k) to be nonzero");
+            Py_DECREF((PyObject*)sum);
+            goto done;
+        }
+        if (mpz_sgn(mpq_denref(sum->q)) < 0) {
+            mpz_neg(mpq_numref(sum->q), mpq_numref(sum->q));
+            mpz_neg(mpq_denref(sum->q), mpq_denref(sum->q));
+        }
+    }
+    else {
+        mpq_set_ui(sum->q, 0, 1);
+    }
+
+    if (exact && !PyObject_IsTrue(exact)) {
+        /* mpfr_set_q() does not need the fraction to be reduced. */
+        result = (PyObject*)GMPy_MPFR_From_MPQ(sum, 0, context);
+    }
+    else {
+        GMPY_BEGIN_NOGIL(mpz_sizeinbase(mpq_denref(sum->q), 2));
+        mpq_canonicalize(sum->q);
+        GMPY_END_NOGIL;
+        Py_INCREF((PyObject*)sum);
+        result = (PyObject*)sum;
+    }
+    Py_DECREF((PyObject*)sum);
+
+  done:
+    for (i = 0; i < 4; i++) {
+        GMPy_MPZ_Array_Free(polys[i].coef, polys[i].len);
+    }
+    return result;
+}
@@ -0,0 +1,65 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_binsplit.h                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+#ifndef GMPY_BINSPLIT_H
+#define GMPY_BINSPLIT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Binary splitting evaluates the sum for k in [0, n) of
+ *
+ *     a(k)/b(k) * p(0)*...*p(k) / (q(0)*...*q(k))
+ *
+ * for polynomials p, q, a and b with integer coefficients. For a range
+ * [n1, n2) it computes the integers P, Q, B and T with
+ *
+ *     P = p(n1)*...*p(n2-1)    Q = q(n1)*...*q(n2-1)    B = b(n1)*...*b(n2-1)
+ *
+ * and T/(B*Q) equal to the sum over the range without the factors of p
+ * and q before n1. The two halves of a range combine as
+ *
+ *     T = Br*Qr*Tl + Bl*Pl*Tr
+ *
+ * so the work is a balanced tree of multiplications.
+ */
+
+typedef struct {
+    MPZ_Object **coef;              /* coefficients, lowest degree first */
+    Py_ssize_t len;
+} binsplit_poly;
+
+typedef struct {
+    mpz_t P, Q, B, T;
+} binsplit_sum;
+
+static PyObject * GMPy_Function_BinarySplit(PyObject *self, PyObject *args, PyObject *kwargs);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -32,33 +32,460 @@
  *
  * "zcache" is used to cache mpz_t objects. The cache is accessed via the
  * functions mpz_inoc/mpz_cloc. The function set_zcache is used to change
- * the size of the array used to store the cached objects.
+ * the size of the arrays used to store the cached objects. The zcache is
+ * split into buckets by allocated size (powers of 2 in limbs).
+ *
+ * The mpz and xmpz caches only save the Python objects; the limbs are
+ * returned to the zcache.
  *
  * The "py???cache" is used to cache Py??? objects. The cache is accessed
  * via Py???_new/Py???_dealloc. The functions set_py???cache and
  * set_py???cache are used to change the size of the array used to the store
  * the cached objects.
+ *
+ * Each thread uses its own set of caches. The set is created on first use
+ * and is owned by a capsule stored in the thread state dictionary, so it is
+ * released when the thread state is cleared at thread exit. Objects that
+ * are deleted after that point bypass the cache.
+ */
+
+#ifndef WITHOUT_THREADS
+
+static void
+GMPy_Cache_Free(gmpy_cache *cache)
+{
+    int i, k;
+
+    for (k = 0; k < ZCACHE_BUCKETS; ++k) {
+        for (i = 0; i < cache->zbucket[k].in_zcache; ++i)
+            mpz_clear(cache->zbucket[k].zcache[i]);
+        GMPY_FREE(cache->zbucket[k].zcache);
+    }
+    for (i = 0; i < cache->in_gmpympzcache; ++i)
+        PyObject_Del(cache->gmpympzcache[i]);
+    for (i = 0; i < cache->in_gmpyxmpzcache; ++i)
+        PyObject_Del(cache->gmpyxmpzcache[i]);
+    for (i = 0; i < cache->in_gmpympqcache; ++i) {
+        mpq_clear(cache->gmpympqcache[i]->q);
+        PyObject_Del(cache->gmpympqcache[i]);
+    }
+    for (k = 0; k < MPFR_CACHE_BUCKETS; ++k) {
+        for (i = 0; i < cache->mpfrbucket[k].in_mpfrcache; ++i) {
+            mpfr_clear(cache->mpfrbucket[k].mpfrcache[i]->f);
+            PyObject_Del(cache->mpfrbucket[k].mpfrcache[i]);
+        }
+        GMPY_FREE(cache->mpfrbucket[k].mpfrcache);
+    }
+    for (i = 0; i < cache->in_gmpympccache; ++i) {
+        mpc_clear(cache->gmpympccache[i]->c);
+        PyObject_Del(cache->gmpympccache[i]);
+    }
+    for (i = 0; i < PYLONG_CACHE_SIZE; ++i) {
+        if (cache->pylong[i].obj) {
+            Py_DECREF(cache->pylong[i].obj);
+            mpz_clear(cache->pylong[i].z);
+        }
+    }
+    /* Clearing the cached values above may have filled the limb cache. */
+    for (k = 0; k < LIMB_CACHE_LIMBS; ++k) {
+        for (i = 0; i < cache->limbbucket[k].in_limbcache; ++i)
+            GMPY_FREE(cache->limbbucket[k].blocks[i]);
+    }
+    GMPY_FREE(cache->gmpympzcache);
+    GMPY_FREE(cache->gmpyxmpzcache);
+    GMPY_FREE(cache->gmpympqcache);
+    GMPY_FREE(cache->gmpympccache);
+    GMPY_FREE(cache);
+}
+
+/* Called when the thread state dictionary that owns the cache is cleared.
+ * This normally happens in the thread that owns the cache, but it may also
+ * happen in the main thread during interpreter shutdown.
+ */
+
+static void
+GMPy_Cache_Destructor(PyObject *capsule)
+{
+    gmpy_cache *cache;
+
+    cache = (gmpy_cache*)PyCapsule_GetPointer(capsule, "gmpy2.cache");
+    if (!cache)
+        return;
+
+    if (cache == tls_cache) {
+        tls_cache = NULL;
+        tls_cache_closed = 1;
+    }
+    GMPy_Cache_Free(cache);
+}
+
+/* Create the caches for the current thread and register them with the
+ * thread state dictionary. Returns NULL, without setting an exception, if
+ * the caches can't be created; the caller then bypasses the cache.
+ */
+
+static gmpy_cache *
+current_cache_new(void)
+{
+    PyObject *dict, *capsule;
+    PyObject *type, *value, *traceback;
+    gmpy_cache *cache;
+
+    if (!(cache = GMPY_MALLOC(sizeof(gmpy_cache))))
+        return NULL;
+    memset(cache, 0, sizeof(gmpy_cache));
+    GMPy_Cache_Resize(cache);
+
+    /* Install the cache before touching the thread state dictionary in case
+     * an object is deleted while the dictionary is being updated. */
+    tls_cache = cache;
+
+    /* mpz_inoc() and friends may be called while an exception is pending
+     * so the current exception state must be preserved. */
+    PyErr_Fetch(&type, &value, &traceback);
+
+    dict = PyThreadState_GetDict();
+    if (!dict || !tls_cache_key ||
+        !(capsule = PyCapsule_New(cache, "gmpy2.cache", GMPy_Cache_Destructor))) {
+        tls_cache = NULL;
+        GMPy_Cache_Free(cache);
+        PyErr_Clear();
+        PyErr_Restore(type, value, traceback);
+        return NULL;
+    }
+
+    if (PyDict_SetItem(dict, tls_cache_key, capsule) < 0) {
+        /* The destructor releases the cache. */
+        Py_DECREF(capsule);
+        tls_cache = NULL;
+        tls_cache_closed = 0;
+        PyErr_Clear();
+        PyErr_Restore(type, value, traceback);
+        return NULL;
+    }
+    Py_DECREF(capsule);
+    PyErr_Restore(type, value, traceback);
+    return cache;
+}
+
+#endif
+
+/* Return the caches used by the current thread or NULL if the object caches
+ * can not be used.
+ */
+
+static gmpy_cache *
+GMPy_current_cache(void)
+{
+    gmpy_cache *cache;
+
+#ifdef WITHOUT_THREADS
+    cache = &module_cache;
+#else
+    /* The caches hold Python objects, so code running without the GIL
+     * falls back to plain mpz_init() and mpz_clear(). */
+    if (tls_nogil)
+        return NULL;
+    cache = tls_cache;
+    if (!cache) {
+        if (tls_cache_closed || !(cache = current_cache_new()))
+            return NULL;
+    }
+#endif
+
+    /* Pick up changes made by set_cache() in another thread. */
+    if (cache->generation != global.cache_generation)
+        GMPy_Cache_Resize(cache);
+    return cache;
+}
+
+static void
+GMPy_Cache_Resize(gmpy_cache *cache)
+{
+    cache->generation = global.cache_generation;
+    set_zcache(cache);
+    set_pylong_cache(cache);
+    set_gmpympzcache(cache);
+    set_gmpympqcache(cache);
+    set_gmpyxmpzcache(cache);
+    set_gmpympfrcache(cache);
+    set_gmpympccache(cache);
+}
+
+/* Return the number of objects held by one of the caches. */
+
+static Py_ssize_t
+GMPy_Cache_Count(gmpy_cache *cache, int type)
+{
+    Py_ssize_t count = 0;
+    int k;
+
+    switch (type) {
+    case GMPY_CACHE_ZCACHE:
+        for (k = 0; k < ZCACHE_BUCKETS; ++k)
+            count += cache->zbucket[k].in_zcache;
+        return count;
+    case GMPY_CACHE_MPZ:
+        return cache->in_gmpympzcache;
+    case GMPY_CACHE_XMPZ:
+        return cache->in_gmpyxmpzcache;
+    case GMPY_CACHE_MPQ:
+        return cache->in_gmpympqcache;
+    case GMPY_CACHE_MPFR:
+        for (k = 0; k < MPFR_CACHE_BUCKETS; ++k)
+            count += cache->mpfrbucket[k].in_mpfrcache;
+        return count;
+    case GMPY_CACHE_MPC:
+        return cache->in_gmpympccache;
+    default:
+        return 0;
+    }
+}
+
+/* Fill one of the caches of the current thread with up to 'count' objects
+ * using 'limbs' limbs each. Returns the number of objects added to the
+ * cache or -1 if an exception was raised. The statistics are not changed.
+ */
+
+static Py_ssize_t
+GMPy_Cache_Prewarm(int type, int count, int limbs)
+{
+    gmpy_cache *cache;
+    gmpy_cache_stats saved[GMPY_CACHE_TYPES];
+    PyObject **objects = NULL;
+    Py_ssize_t before;
+    mp_bitcnt_t bits = (mp_bitcnt_t)limbs * mp_bits_per_limb;
+    mpz_t temp;
+    int i, n = 0;
+
+    if (!(cache = GMPy_current_cache()) || count <= 0)
+        return 0;
+
+    memcpy(saved, cache->stats, sizeof(saved));
+    before = GMPy_Cache_Count(cache, type);
+
+    if (type == GMPY_CACHE_ZCACHE) {
+        for (i = 0; i < count; ++i) {
+            mpz_init2(temp, bits);
+            mpz_cloc(temp);
+        }
+    }
+    else {
+        if (!(objects = GMPY_MALLOC(sizeof(PyObject*) * count))) {
+            PyErr_NoMemory();
+            return -1;
+        }
+
+        for (n = 0; n < count; ++n) {
+            switch (type) {
+            case GMPY_CACHE_MPZ:
+                if ((objects[n] = (PyObject*)GMPy_MPZ_New(NULL)))
+                    mpz_realloc2(MPZ(objects[n]), bits);
+                break;
+            case GMPY_CACHE_XMPZ:
+                if ((objects[n] = (PyObject*)GMPy_XMPZ_New(NULL)))
+                    mpz_realloc2(MPZ(objects[n]), bits);
+                break;
+            case GMPY_CACHE_MPQ:
+                if ((objects[n] = (PyObject*)GMPy_MPQ_New(NULL))) {
+                    mpz_realloc2(mpq_numref(MPQ(objects[n])), bits);
+                    mpz_realloc2(mpq_denref(MPQ(objects[n])), bits);
+                }
+                break;
+            case GMPY_CACHE_MPFR:
+                objects[n] = (PyObject*)GMPy_MPFR_New((mpfr_prec_t)bits, NULL);
+                break;
+            default:
+                objects[n] = (PyObject*)GMPy_MPC_New((mpfr_prec_t)bits, (mpfr_prec_t)bits, NULL);
+                break;
+            }
+            if (!objects[n])
+                break;
+        }
+
+        /* Deleting the objects returns them to the cache. */
+        for (i = 0; i < n; ++i)
+            Py_DECREF(objects[i]);
+        GMPY_FREE(objects);
+    }
+
+    memcpy(cache->stats, saved, sizeof(saved));
+    if (type != GMPY_CACHE_ZCACHE && n < count)
+        return -1;
+    return GMPy_Cache_Count(cache, type) - before;
+}
+
+/* Release the cached objects whose memory was allocated from the chunks of
+ * 'owner' so that the chunks can be freed when the arena exits.
+ */
+
+static int
+arena_owned(void *ptr, void *owner)
+{
+    gmpy_arena_chunk *chunk;
+    int locked, result;
+
+    ARENA_LOCK(locked);
+    chunk = GMPy_Arena_Find(ptr);
+    result = chunk && chunk->owner == owner;
+    ARENA_UNLOCK(locked);
+    return result;
+}
+
+static void
+GMPy_Cache_Release_Arena(gmpy_cache *cache, void *owner)
+{
+    int i, k;
+    gmpy_zbucket *zbucket;
+    gmpy_mpfrbucket *fbucket;
+
+    if (!arena_chunks)
+        return;
+
+    for (k = 0; k < ZCACHE_BUCKETS; ++k) {
+        zbucket = &(cache->zbucket[k]);
+        for (i = zbucket->in_zcache - 1; i >= 0; --i) {
+            if (arena_owned(zbucket->zcache[i]->_mp_d, owner)) {
+                mpz_clear(zbucket->zcache[i]);
+                cache->stats[GMPY_CACHE_ZCACHE].evictions++;
+                zbucket->zcache[i][0] = zbucket->zcache[--(zbucket->in_zcache)][0];
+            }
+        }
+        if (!zbucket->in_zcache)
+            cache->zbucket_used &= ~(1U << k);
+    }
+
+    for (i = 0; i < PYLONG_CACHE_SIZE; ++i) {
+        if (cache->pylong[i].obj &&
+            arena_owned(cache->pylong[i].z->_mp_d, owner)) {
+            Py_CLEAR(cache->pylong[i].obj);
+            mpz_clear(cache->pylong[i].z);
+        }
+    }
+
+    for (i = cache->in_gmpympqcache - 1; i >= 0; --i) {
+        if (arena_owned(mpq_numref(cache->gmpympqcache[i]->q)->_mp_d, owner) ||
+            arena_owned(mpq_denref(cache->gmpympqcache[i]->q)->_mp_d, owner)) {
+            mpq_clear(cache->gmpympqcache[i]->q);
+            PyObject_Del(cache->gmpympqcache[i]);
+            cache->stats[GMPY_CACHE_MPQ].evictions++;
+            cache->gmpympqcache[i] = cache->gmpympqcache[--(cache->in_gmpympqcache)];
+        }
+    }
+
+    for (k = 0; k < MPFR_CACHE_BUCKETS; ++k) {
+        fbucket = &(cache->mpfrbucket[k]);
+        for (i = fbucket->in_mpfrcache - 1; i >= 0; --i) {
+            if (arena_owned(fbucket->mpfrcache[i]->f->_mpfr_d, owner)) {
+                mpfr_clear(fbucket->mpfrcache[i]->f);
+                PyObject_Del(fbucket->mpfrcache[i]);
+                cache->stats[GMPY_CACHE_MPFR].evictions++;
+                fbucket->mpfrcache[i] = fbucket->mpfrcache[--(fbucket->in_mpfrcache)];
+            }
+        }
+    }
+
+    for (i = cache->in_gmpympccache - 1; i >= 0; --i) {
+        if (arena_owned(mpc_realref(cache->gmpympccache[i]->c)->_mpfr_d, owner) ||
+            arena_owned(mpc_imagref(cache->gmpympccache[i]->c)->_mpfr_d, owner)) {
+            mpc_clear(cache->gmpympccache[i]->c);
+            PyObject_Del(cache->gmpympccache[i]);
+            cache->stats[GMPY_CACHE_MPC].evictions++;
+            cache->gmpympccache[i] = cache->gmpympccache[--(cache->in_gmpympccache)];
+        }
+    }
+}
+
+/* Resize the array used by a cache to 'NEWSIZE' entries. If the memory
+ * can't be allocated, the old array is kept.
  */
 
+#define GMPY_CACHE_REALLOC(ARRAY, SIZE, TYPE, NEWSIZE) \
+    { \
+        TYPE *temp; \
+        if ((NEWSIZE) == 0) { \
+            GMPY_FREE(ARRAY); \
+            ARRAY = NULL; \
+            SIZE = 0; \
+        } \
+        else if ((temp = GMPY_REALLOC(ARRAY, sizeof(TYPE) * (NEWSIZE)))) { \
+            ARRAY = temp; \
+            SIZE = (NEWSIZE); \
+        } \
+    }
+
+/* Return the zcache bucket for an mpz_t with 'alloc' limbs. */
+
+static int
+zcache_bucket(int alloc)
+{
+    int k = 0;
+
+    while ((1 << k) < alloc)
+        k++;
+    return k;
+}
+
 static void
-set_zcache(void)
+set_zcache(gmpy_cache *cache)
 {
-    if (in_zcache > global.cache_size) {
-        int i;
-        for(i = global.cache_size; i < in_zcache; ++i)
-            mpz_clear(zcache[i]);
-        in_zcache = global.cache_size;
+    int i, k, size;
+    mpz_t *temp;
+    gmpy_zbucket *bucket;
+
+    for (k = 0; k < ZCACHE_BUCKETS; ++k) {
+        bucket = &(cache->zbucket[k]);
+        size = ZCACHE_BUCKET_LIMBS >> k;
+        if (size > global.cache_sizes[GMPY_CACHE_ZCACHE])
+            size = global.cache_sizes[GMPY_CACHE_ZCACHE];
+
+        if (bucket->in_zcache > size) {
+            for (i = size; i < bucket->in_zcache; ++i)
+                mpz_clear(bucket->zcache[i]);
+            cache->stats[GMPY_CACHE_ZCACHE].evictions += bucket->in_zcache - size;
+            bucket->in_zcache = size;
+        }
+        if (!bucket->in_zcache)
+            cache->zbucket_used &= ~(1U << k);
+
+        /* Arrays that are not in use are allocated the next time they are
+         * needed. */
+        if (size != bucket->zcache_size) {
+            if (size == 0 || !bucket->zcache) {
+                GMPY_FREE(bucket->zcache);
+                bucket->zcache = NULL;
+                bucket->zcache_size = size;
+            }
+            else if ((temp = GMPY_REALLOC(bucket->zcache, sizeof(mpz_t) * size))) {
+                bucket->zcache = temp;
+                bucket->zcache_size = size;
+            }
+        }
     }
-    zcache = GMPY_REALLOC(zcache, sizeof(mpz_t) * global.cache_size);
 }
 
 static void
 mpz_inoc(mpz_t newo)
 {
-    if (in_zcache) {
-        newo[0] = (zcache[--in_zcache])[0];
+    int k = 0;
+    unsigned int used;
+    gmpy_zbucket *bucket;
+    gmpy_cache *cache = GMPy_current_cache();
+
+    if (cache && (used = cache->zbucket_used)) {
+        while (!(used & 1)) {
+            used >>= 1;
+            k++;
+        }
+        bucket = &(cache->zbucket[k]);
+        newo[0] = (bucket->zcache[--(bucket->in_zcache)])[0];
+        if (!bucket->in_zcache)
+            cache->zbucket_used &= ~(1U << k);
+        cache->stats[GMPY_CACHE_ZCACHE].hits++;
     }
     else {
+        if (cache)
+            cache->stats[GMPY_CACHE_ZCACHE].misses++;
         mpz_init(newo);
     }
 }
@@ -66,59 +493,204 @@ mpz_inoc(mpz_t newo)
 static void
 mpz_cloc(mpz_t oldo)
 {
-    if (in_zcache<global.cache_size && oldo->_mp_alloc <= global.cache_obsize) {
-        (zcache[in_zcache++])[0] = oldo[0];
+    int k;
+    gmpy_zbucket *bucket;
+    gmpy_cache *cache = GMPy_current_cache();
+
+    if (!cache || oldo->_mp_alloc == 0) {
+        mpz_clear(oldo);
+        return;
+    }
+
+    if (oldo->_mp_alloc <= global.cache_obsize &&
+        (k = zcache_bucket(oldo->_mp_alloc)) < ZCACHE_BUCKETS) {
+        bucket = &(cache->zbucket[k]);
+        if (bucket->in_zcache < bucket->zcache_size &&
+            (bucket->zcache ||
+             (bucket->zcache = GMPY_MALLOC(sizeof(mpz_t) * bucket->zcache_size)))) {
+            (bucket->zcache[(bucket->in_zcache)++])[0] = oldo[0];
+            cache->zbucket_used |= 1U << k;
+            return;
+        }
+    }
+    cache->stats[GMPY_CACHE_ZCACHE].evictions++;
+    mpz_clear(oldo);
+}
+
+/* Cached conversions of Python ints, see mpz_inoc_pylong() in
+ * gmpy2_convert_gmp.c. Entries that the current settings no longer allow
+ * are discarded. */
+
+static void
+set_pylong_cache(gmpy_cache *cache)
+{
+    int i;
+    gmpy_pylong_entry *entry;
+
+    for (i = 0; i < PYLONG_CACHE_SIZE; ++i) {
+        entry = &(cache->pylong[i]);
+        if (entry->obj &&
+            (global.cache_sizes[GMPY_CACHE_ZCACHE] == 0 ||
+             entry->z->_mp_alloc > global.cache_obsize)) {
+            Py_CLEAR(entry->obj);
+            mpz_clear(entry->z);
+        }
+    }
+}
+
+/* Small mpz values.
+ *
+ * mpz objects are immutable so the values from MPZ_SMALL_MIN to MPZ_SMALL_MAX
+ * are created once and shared. Functions that return a small value return a
+ * new reference to the shared object instead of creating a new one. The
+ * shared objects are never deleted.
+ */
+
+static int
+GMPy_MPZ_Small_Init(void)
+{
+    long i;
+    MPZ_Object *temp;
+
+    for (i = MPZ_SMALL_MIN; i <= MPZ_SMALL_MAX; ++i) {
+        if (!(temp = PyObject_New(MPZ_Object, &MPZ_Type)))
+            return -1;
+        mpz_init_set_si(temp->z, i);
+        temp->hash_cache = -1;
+        temp->str_cache = NULL;
+        mpz_small[i - MPZ_SMALL_MIN] = temp;
+    }
+    return 0;
+}
+
+/* Return a new reference to the shared object for 'value'. 'value' must be
+ * between MPZ_SMALL_MIN and MPZ_SMALL_MAX. */
+
+static MPZ_Object *
+GMPy_MPZ_Small(long value)
+{
+    MPZ_Object *result = mpz_small[value - MPZ_SMALL_MIN];
+
+    Py_INCREF((PyObject*)result);
+    return result;
+}
+
+/* Temporary elision.
+ *
+ * In an expression like a*b + c*d, the products are dead as soon as the sum
+ * is formed. The number slots call GMPy_MPZ_Reuse() to get the object for
+ * their result; it returns a new reference to x or y if either one is a
+ * temporary (see MPZ_IS_TEMPORARY), and a new mpz otherwise. GMP allows the
+ * result to alias an operand so the caller can simply overwrite it. Pass
+ * NULL for y if the operation is unary.
+ */
+
+static MPZ_Object *
+GMPy_MPZ_Reuse(PyObject *x, PyObject *y)
+{
+    MPZ_Object *result;
+
+    if (MPZ_IS_TEMPORARY(x))
+        result = (MPZ_Object*)x;
+    else if (y && MPZ_IS_TEMPORARY(y))
+        result = (MPZ_Object*)y;
+    else
+        return GMPy_MPZ_New(NULL);
+
+    Py_INCREF((PyObject*)result);
+    result->hash_cache = -1;
+    if (result->str_cache) {
+        global.str_cache_bytes -= PyObject_Length(result->str_cache);
+        Py_CLEAR(result->str_cache);
+    }
+    return result;
+}
+
+/* Return 1 and store the value in 'value' if 'obj' is an mpz or a Python
+ * integer whose absolute value is at most MPZ_SMALL_OPERAND. The sum or
+ * difference of two such values can not overflow a C long.
+ */
+
+static int
+GMPy_MPZ_Small_Operand(PyObject *obj, long *value)
+{
+    int error;
+
+    if (MPZ_Check(obj)) {
+        if (!mpz_fits_slong_p(MPZ(obj)))
+            return 0;
+        *value = mpz_get_si(MPZ(obj));
+    }
+    else if (PyIntOrLong_Check(obj)) {
+        *value = GMPy_Integer_AsLongAndError(obj, &error);
+        if (error)
+            return 0;
     }
     else {
-        mpz_clear(oldo);
+        return 0;
     }
+    return *value >= -MPZ_SMALL_OPERAND && *value <= MPZ_SMALL_OPERAND;
 }
 
 /* Caching logic for Pympz. */
 
 static void
-set_gmpympzcache(void)
+set_gmpympzcache(gmpy_cache *cache)
 {
-    if (in_gmpympzcache > global.cache_size) {
-        int i;
-        for (i = global.cache_size; i < in_gmpympzcache; ++i) {
-            mpz_cloc(gmpympzcache[i]->z);
-            PyObject_Del(gmpympzcache[i]);
-        }
-        in_gmpympzcache = global.cache_size;
+    int i, size = global.cache_sizes[GMPY_CACHE_MPZ];
+
+    if (cache->in_gmpympzcache > size) {
+        for (i = size; i < cache->in_gmpympzcache; ++i)
+            PyObject_Del(cache->gmpympzcache[i]);
+        cache->stats[GMPY_CACHE_MPZ].evictions += cache->in_gmpympzcache - size;
+        cache->in_gmpympzcache = size;
     }
-    gmpympzcache = GMPY_REALLOC(gmpympzcache, sizeof(MPZ_Object)*global.cache_size);
+    GMPY_CACHE_REALLOC(cache->gmpympzcache, cache->gmpympzcache_size, MPZ_Object*, size);
 }
 
 static MPZ_Object *
 GMPy_MPZ_New(CTXT_Object *context)
 {
     MPZ_Object *result;
+    gmpy_cache *cache = GMPy_current_cache();
 
-    if (in_gmpympzcache) {
-        result = gmpympzcache[--in_gmpympzcache];
+    if (cache && cache->in_gmpympzcache) {
+        result = cache->gmpympzcache[--(cache->in_gmpympzcache)];
         /* Py_INCREF does not set the debugging pointers, so need to use
          * _Py_NewReference instead. */
         _Py_NewReference((PyObject*)result);
+        cache->stats[GMPY_CACHE_MPZ].hits++;
+        GMPY_PROBE(mpz__cache__hit);
     }
     else {
+        if (cache)
+            cache->stats[GMPY_CACHE_MPZ].misses++;
+        GMPY_PROBE(mpz__cache__miss);
         if (!(result = PyObject_New(MPZ_Object, &MPZ_Type)))
             return NULL;
-        mpz_inoc(result->z);
     }
+    mpz_inoc(result->z);
     result->hash_cache = -1;
+    result->str_cache = NULL;
     return result;
 }
 
 static void
 GMPy_MPZ_Dealloc(MPZ_Object *self)
 {
-    if (in_gmpympzcache < global.cache_size &&
-        self->z->_mp_alloc <= global.cache_obsize) {
-        gmpympzcache[in_gmpympzcache++] = self;
+    gmpy_cache *cache = GMPy_current_cache();
+
+    if (self->str_cache) {
+        global.str_cache_bytes -= PyObject_Length(self->str_cache);
+        Py_CLEAR(self->str_cache);
+    }
+    mpz_cloc(self->z);
+    if (cache && cache->in_gmpympzcache < cache->gmpympzcache_size) {
+        cache->gmpympzcache[(cache->in_gmpympzcache)++] = self;
     }
     else {
-        mpz_cloc(self->z);
+        if (cache)
+            cache->stats[GMPY_CACHE_MPZ].evictions++;
         PyObject_Del(self);
     }
 }
@@ -126,47 +698,60 @@ GMPy_MPZ_Dealloc(MPZ_Object *self)
 /* Caching logic for Pyxmpz. */
 
 static void
-set_gmpyxmpzcache(void)
+set_gmpyxmpzcache(gmpy_cache *cache)
 {
-    if (in_gmpyxmpzcache > global.cache_size) {
-        int i;
-        for (i = global.cache_size; i < in_gmpyxmpzcache; ++i) {
-            mpz_cloc(gmpyxmpzcache[i]->z);
-            PyObject_Del(gmpyxmpzcache[i]);
-        }
-        in_gmpyxmpzcache = global.cache_size;
+    int i, size = global.cache_sizes[GMPY_CACHE_XMPZ];
+
+    if (cache->in_gmpyxmpzcache > size) {
+        for (i = size; i < cache->in_gmpyxmpzcache; ++i)
+            PyObject_Del(cache->gmpyxmpzcache[i]);
+        cache->stats[GMPY_CACHE_XMPZ].evictions += cache->in_gmpyxmpzcache - size;
+        cache->in_gmpyxmpzcache = size;
     }
-    gmpyxmpzcache = GMPY_REALLOC(gmpyxmpzcache, sizeof(XMPZ_Object)*global.cache_size);
+    GMPY_CACHE_REALLOC(cache->gmpyxmpzcache, cache->gmpyxmpzcache_size, XMPZ_Object*, size);
 }
 
 static XMPZ_Object *
 GMPy_XMPZ_New(CTXT_Object *context)
 {
     XMPZ_Object *result;
+    gmpy_cache *cache = GMPy_current_cache();
 
-    if (in_gmpyxmpzcache) {
-        result = gmpyxmpzcache[--in_gmpyxmpzcache];
+    if (cache && cache->in_gmpyxmpzcache) {
+        result = cache->gmpyxmpzcache[--(cache->in_gmpyxmpzcache)];
         /* Py_INCREF does not set the debugging pointers, so need to use
          * _Py_NewReference instead. */
         _Py_NewReference((PyObject*)result);
+        cache->stats[GMPY_CACHE_XMPZ].hits++;
     }
     else {
+        if (cache)
+            cache->stats[GMPY_CACHE_XMPZ].misses++;
         if (!(result = PyObject_New(XMPZ_Object, &XMPZ_Type)))
             return NULL;
-        mpz_inoc(result->z);
     }
+    mpz_inoc(result->z);
+    result->exports = 0;
+    result->mapping = NULL;
+    result->rank = NULL;
     return result;
 }
 
 static void
 GMPy_XMPZ_Dealloc(XMPZ_Object *obj)
 {
-    if (in_gmpyxmpzcache < global.cache_size &&
-        obj->z->_mp_alloc <= global.cache_obsize) {
-        gmpyxmpzcache[in_gmpyxmpzcache++] = obj;
+    gmpy_cache *cache = GMPy_current_cache();
+
+    if (obj->mapping)
+        GMPy_Mmap_Close(obj);
+    GMPy_XMPZ_Drop_Rank(obj);
+    mpz_cloc(obj->z);
+    if (cache && cache->in_gmpyxmpzcache < cache->gmpyxmpzcache_size) {
+        cache->gmpyxmpzcache[(cache->in_gmpyxmpzcache)++] = obj;
     }
     else {
-        mpz_cloc(obj->z);
+        if (cache)
+            cache->stats[GMPY_CACHE_XMPZ].evictions++;
         PyObject_Del((PyObject*)obj);
     }
 }
@@ -174,31 +759,37 @@ GMPy_XMPZ_Dealloc(XMPZ_Object *obj)
 /* Caching logic for Pympq. */
 
 static void
-set_gmpympqcache(void)
+set_gmpympqcache(gmpy_cache *cache)
 {
-    if (in_gmpympqcache > global.cache_size) {
-        int i;
-        for (i = global.cache_size; i < in_gmpympqcache; ++i) {
-            mpq_clear(gmpympqcache[i]->q);
-            PyObject_Del(gmpympqcache[i]);
+    int i, size = global.cache_sizes[GMPY_CACHE_MPQ];
+
+    if (cache->in_gmpympqcache > size) {
+        for (i = size; i < cache->in_gmpympqcache; ++i) {
+            mpq_clear(cache->gmpympqcache[i]->q);
+            PyObject_Del(cache->gmpympqcache[i]);
         }
-        in_gmpympqcache = global.cache_size;
+        cache->stats[GMPY_CACHE_MPQ].evictions += cache->in_gmpympqcache - size;
+        cache->in_gmpympqcache = size;
     }
-    gmpympqcache = GMPY_REALLOC(gmpympqcache, sizeof(MPQ_Object)*global.cache_size);
+    GMPY_CACHE_REALLOC(cache->gmpympqcache, cache->gmpympqcache_size, MPQ_Object*, size);
 }
 
 static MPQ_Object *
 GMPy_MPQ_New(CTXT_Object *context)
 {
     MPQ_Object *result;
+    gmpy_cache *cache = GMPy_current_cache();
 
-    if (in_gmpympqcache) {
-        result = gmpympqcache[--in_gmpympqcache];
+    if (cache && cache->in_gmpympqcache) {
+        result = cache->gmpympqcache[--(cache->in_gmpympqcache)];
         /* Py_INCREF does not set the debugging pointers, so need to use
            _Py_NewReference instead. */
         _Py_NewReference((PyObject*)result);
+        cache->stats[GMPY_CACHE_MPQ].hits++;
     }
     else {
+        if (cache)
+            cache->stats[GMPY_CACHE_MPQ].misses++;
         if (!(result = PyObject_New(MPQ_Object, &MPQ_Type)))
             return NULL;
         mpq_init(result->q);
@@ -210,37 +801,80 @@ GMPy_MPQ_New(CTXT_Object *context)
 static void
 GMPy_MPQ_Dealloc(MPQ_Object *self)
 {
-    if (in_gmpympqcache<global.cache_size &&
+    gmpy_cache *cache = GMPy_current_cache();
+
+    if (cache && cache->in_gmpympqcache < cache->gmpympqcache_size &&
         mpq_numref(self->q)->_mp_alloc <= global.cache_obsize &&
         mpq_denref(self->q)->_mp_alloc <= global.cache_obsize) {
-        gmpympqcache[in_gmpympqcache++] = self;
+        cache->gmpympqcache[(cache->in_gmpympqcache)++] = self;
     }
     else {
+        if (cache)
+            cache->stats[GMPY_CACHE_MPQ].evictions++;
         mpq_clear(self->q);
         PyObject_Del(self);
     }
 }
 
-/* Caching logic for Pympfr. */
+/* Caching logic for Pympfr.
+ *
+ * The mpfr objects are cached by the number of limbs used by the mantissa so
+ * that GMPy_MPFR_New() can usually change the precision of a cached object
+ * without reallocating the mantissa. Bucket k holds objects with between
+ * 2**(k-1)+1 and 2**k limbs; the common precisions of 53, 113, 256, and 1024
+ * bits on 64-bit platforms are always exact matches.
+ */
+
+/* Return the number of limbs needed for a mantissa of 'bits' bits. */
+
+#define MPFR_LIMBS(bits) (((bits) + mp_bits_per_limb - 1) / mp_bits_per_limb)
 
 static void
-set_gmpympfrcache(void)
+set_gmpympfrcache(gmpy_cache *cache)
 {
-    if (in_gmpympfrcache > global.cache_size) {
-        int i;
-        for (i = global.cache_size; i < in_gmpympfrcache; ++i) {
-            mpfr_clear(gmpympfrcache[i]->f);
-            PyObject_Del(gmpympfrcache[i]);
+    int i, k, size;
+    MPFR_Object **temp;
+    gmpy_mpfrbucket *bucket;
+
+    for (k = 0; k < MPFR_CACHE_BUCKETS; ++k) {
+        bucket = &(cache->mpfrbucket[k]);
+        size = ZCACHE_BUCKET_LIMBS >> k;
+        if (size > global.cache_sizes[GMPY_CACHE_MPFR])
+            size = global.cache_sizes[GMPY_CACHE_MPFR];
+
+        if (bucket->in_mpfrcache > size) {
+            for (i = size; i < bucket->in_mpfrcache; ++i) {
+                mpfr_clear(bucket->mpfrcache[i]->f);
+                PyObject_Del(bucket->mpfrcache[i]);
+            }
+            cache->stats[GMPY_CACHE_MPFR].evictions += bucket->in_mpfrcache - size;
+            bucket->in_mpfrcache = size;
+        }
+
+        /* Arrays that are not in use are allocated the next time they are
+         * needed. */
+        if (size != bucket->mpfrcache_size) {
+            if (size == 0 || !bucket->mpfrcache) {
+                GMPY_FREE(bucket->mpfrcache);
+                bucket->mpfrcache = NULL;
+                bucket->mpfrcache_size = size;
+            }
+            else if ((temp = GMPY_REALLOC(bucket->mpfrcache, sizeof(MPFR_Object*) * size))) {
+                bucket->mpfrcache = temp;
+                bucket->mpfrcache_size = size;
+            }
         }
-        in_gmpympfrcache = global.cache_size;
     }
-    gmpympfrcache = GMPY_REALLOC(gmpympfrcache, sizeof(MPFR_Object)*global.cache_size);
 }
 
 static MPFR_Object *
 GMPy_MPFR_New(mpfr_prec_t bits, CTXT_Object *context)
 {
+    int k;
+    size_t msize;
     MPFR_Object *result;
+    gmpy_mpfrbucket *bucket;
+    gmpy_cache *cache;
 
     if (bits == 0 || bits == 1)
         bits = GET_MPFR_PREC(context) + bits * GET_GUARD_BITS(context);
@@ -250,14 +884,29 @@ GMPy_MPFR_New(mpfr_prec_t bits, CTXT_Object *context)
         return NULL;
     }
 
-    if (in_gmpympfrcache) {
-        result = gmpympfrcache[--in_gmpympfrcache];
+    if (GMPY_LIMB_CHECK(bits, context))
+        return NULL;
+
+    msize = MPFR_LIMBS(bits);
+    bucket = NULL;
+    if ((cache = GMPy_current_cache()) && msize <= (size_t)global.cache_obsize &&
+        (k = zcache_bucket((int)msize)) < MPFR_CACHE_BUCKETS)
+        bucket = &(cache->mpfrbucket[k]);
+
+    if (bucket && bucket->in_mpfrcache) {
+        result = bucket->mpfrcache[--(bucket->in_mpfrcache)];
         /* Py_INCREF does not set the debugging pointers, so need to use
            _Py_NewReference instead. */
         _Py_NewReference((PyObject*)result);
+        /* Only reallocates if the cached object has fewer limbs. */
         mpfr_set_prec(result->f, bits);
+        cache->stats[GMPY_CACHE_MPFR].hits++;
+        GMPY_PROBE1(mpfr__cache__hit, (long)bits);
     }
     else {
+        if (cache)
+            cache->stats[GMPY_CACHE_MPFR].misses++;
+        GMPY_PROBE1(mpfr__cache__miss, (long)bits);
         if (!(result = PyObject_New(MPFR_Object, &MPFR_Type)))
             return NULL;
         mpfr_init2(result->f, bits);
@@ -270,32 +919,43 @@ GMPy_MPFR_New(mpfr_prec_t bits, CTXT_Object *context)
 static void
 GMPy_MPFR_Dealloc(MPFR_Object *self)
 {
+    int k;
     size_t msize;
+    gmpy_mpfrbucket *bucket;
+    gmpy_cache *cache = GMPy_current_cache();
 
     /* Calculate the number of limbs in the mantissa. */
-    msize = (self->f->_mpfr_prec + mp_bits_per_limb - 1) / mp_bits_per_limb;
-    if (in_gmpympfrcache < global.cache_size &&
-        msize <= (size_t)global.cache_obsize) {
-        gmpympfrcache[in_gmpympfrcache++] = self;
-    }
-    else {
-        mpfr_clear(self->f);
-        PyObject_Del(self);
+    msize = MPFR_LIMBS(self->f->_mpfr_prec);
+    if (cache && msize <= (size_t)global.cache_obsize &&
+        (k = zcache_bucket((int)msize)) < MPFR_CACHE_BUCKETS) {
+        bucket = &(cache->mpfrbucket[k]);
+        if (bucket->in_mpfrcache < bucket->mpfrcache_size &&
+            (bucket->mpfrcache ||
+             (bucket->mpfrcache = GMPY_MALLOC(sizeof(MPFR_Object*) * bucket->mpfrcache_size)))) {
+            bucket->mpfrcache[(bucket->in_mpfrcache)++] = self;
+            return;
+        }
     }
+    if (cache)
+        cache->stats[GMPY_CACHE_MPFR].evictions++;
+    mpfr_clear(self->f);
+    PyObject_Del(self);
 }
 
 static void
-set_gmpympccache(void)
+set_gmpympccache(gmpy_cache *cache)
 {
-    if (in_gmpympccache > global.cache_size) {
-        int i;
-        for (i = global.cache_size; i < in_gmpympccache; ++i) {
-            mpc_clear(gmpympccache[i]->c);
-            PyObject_Del(gmpympccache[i]);
+    int i, size = global.cache_sizes[GMPY_CACHE_MPC];
+
+    if (cache->in_gmpympccache > size) {
+        for (i = size; i < cache->in_gmpympccache; ++i) {
+            mpc_clear(cache->gmpympccache[i]->c);
+            PyObject_Del(cache->gmpympccache[i]);
         }
-        in_gmpympccache = global.cache_size;
+        cache->stats[GMPY_CACHE_MPC].evictions += cache->in_gmpympccache - size;
+        cache->in_gmpympccache = size;
     }
-    gmpympccache = GMPY_REALLOC(gmpympccache, sizeof(MPC_Object)*global.cache_size);
+    GMPY_CACHE_REALLOC(cache->gmpympccache, cache->gmpympccache_size, MPC_Object*, size);
 }
 
 
@@ -303,6 +963,7 @@ static MPC_Object *
 GMPy_MPC_New(mpfr_prec_t rprec, mpfr_prec_t iprec, CTXT_Object *context)
 {
     MPC_Object *self;
+    gmpy_cache *cache;
 
     CHECK_CONTEXT_SET_EXPONENT(context);
 
@@ -316,11 +977,17 @@ GMPy_MPC_New(mpfr_prec_t rprec, mpfr_prec_t iprec, CTXT_Object *context)
         VALUE_ERROR("invalid value for precision");
         return NULL;
     }
-    if (in_gmpympccache) {
-        self = gmpympccache[--in_gmpympccache];
+
+    if (GMPY_LIMB_CHECK((double)rprec + iprec, context))
+        return NULL;
+
+    cache = GMPy_current_cache();
+    if (cache && cache->in_gmpympccache) {
+        self = cache->gmpympccache[--(cache->in_gmpympccache)];
         /* Py_INCREF does not set the debugging pointers, so need to use
            _Py_NewReference instead. */
         _Py_NewReference((PyObject*)self);
+        cache->stats[GMPY_CACHE_MPC].hits++;
         if (rprec == iprec) {
             mpc_set_prec(self->c, rprec);
         }
@@ -330,6 +997,8 @@ GMPy_MPC_New(mpfr_prec_t rprec, mpfr_prec_t iprec, CTXT_Object *context)
         }
     }
     else {
+        if (cache)
+            cache->stats[GMPY_CACHE_MPC].misses++;
         if (!(self = PyObject_New(MPC_Object, &MPC_Type)))
             return NULL;
         mpc_init3(self->c, rprec, iprec);
@@ -343,17 +1012,19 @@ static void
 GMPy_MPC_Dealloc(MPC_Object *self)
 {
     size_t msize;
+    gmpy_cache *cache = GMPy_current_cache();
 
     /* Calculate the number of limbs in the mantissa. */
     msize = (mpc_realref(self->c)->_mpfr_prec + mp_bits_per_limb - 1) / mp_bits_per_limb;
     msize += (mpc_imagref(self->c)->_mpfr_prec + mp_bits_per_limb - 1) / mp_bits_per_limb;
-    if (in_gmpympccache < global.cache_size &&
+    if (cache && cache->in_gmpympccache < cache->gmpympccache_size &&
         msize <= (size_t)global.cache_obsize) {
-        gmpympccache[in_gmpympccache++] = self;
+        cache->gmpympccache[(cache->in_gmpympccache)++] = self;
     }
     else {
+        if (cache)
+            cache->stats[GMPY_CACHE_MPC].evictions++;
         mpc_clear(self->c);
         PyObject_Del(self);
     }
 }
-
@@ -32,12 +32,23 @@
  *
  * "zcache" is used to cache mpz_t objects. The cache is accessed via the
  * functions mpz_inoc/mpz_cloc. The function set_zcache is used to change
- * the size of the array used to store the cached objects.
+ * the size of the arrays used to store the cached objects. The zcache is
+ * split into buckets by allocated size: bucket k holds mpz_t with more than
+ * 2**(k-1) and at most 2**k limbs. mpz_inoc returns the smallest cached
+ * mpz_t so small results are not given large buffers.
  *
  * The "py???cache" is used to cache Py??? objects. The cache is accessed
  * via Py???_new/Py???_dealloc. The functions set_py???cache and
  * set_py???cache are used to change the size of the array used to the store
  * the cached objects.
+ *
+ * Small limb blocks freed by GMP are kept in the "limbcache" and reused by
+ * gmpy_allocate(), so a small value does not need a call to malloc() even
+ * when the zcache is empty.
+ *
+ * All the caches are private to a thread. A thread's caches are created the
+ * first time it creates or deletes a gmpy2 object and are released when the
+ * thread exits. No locking is required.
  */
 
 #ifndef GMPY_CACHE_H
@@ -47,27 +58,144 @@
 extern "C" {
 #endif
 
-static void          set_zcache(void);
+/* Number of zcache buckets; the largest bucket holds mpz_t with up to
+ * MAX_CACHE_LIMBS limbs. */
+#define ZCACHE_BUCKETS 15
+
+/* Maximum number of limbs held by a single zcache bucket. Buckets for large
+ * sizes hold fewer entries. */
+#define ZCACHE_BUCKET_LIMBS 16384
+
+typedef struct {
+    mpz_t *zcache;                  /* allocated on first use */
+    int in_zcache;
+    int zcache_size;
+} gmpy_zbucket;
+
+/* Number of mpfr cache buckets. Bucket k holds mpfr objects whose mantissa
+ * uses between 2**(k-1)+1 and 2**k limbs. */
+#define MPFR_CACHE_BUCKETS 15
+
+typedef struct {
+    MPFR_Object **mpfrcache;        /* allocated on first use */
+    int in_mpfrcache;
+    int mpfrcache_size;
+} gmpy_mpfrbucket;
+
+/* Indices into the statistics kept by each cache. */
+#define GMPY_CACHE_ZCACHE 0
+#define GMPY_CACHE_MPZ    1
+#define GMPY_CACHE_XMPZ   2
+#define GMPY_CACHE_MPQ    3
+#define GMPY_CACHE_MPFR   4
+#define GMPY_CACHE_MPC    5
+#define GMPY_CACHE_TYPES  6
+
+/* Limb blocks of up to LIMB_CACHE_LIMBS limbs, which hold the values of most
+ * small integers, are kept when they are freed and handed out again by
+ * gmpy_allocate() for a request of the same size. Bucket k holds blocks of
+ * k+1 limbs. */
+#define LIMB_CACHE_LIMBS 2
+#define LIMB_CACHE_SIZE  256
+
+typedef struct {
+    void *blocks[LIMB_CACHE_SIZE];
+    int in_limbcache;
+} gmpy_limbbucket;
+
+/* Number of recently converted Python ints remembered by each thread, see
+ * mpz_inoc_pylong. */
+#define PYLONG_CACHE_SIZE 4
+
+typedef struct {
+    PyObject *obj;                  /* reference to the int, or NULL */
+    mpz_t z;                        /* value of obj, valid if obj is set */
+} gmpy_pylong_entry;
+
+typedef struct {
+    size_t hits;                    /* requests served from the cache */
+    size_t misses;                  /* requests that needed an allocation */
+    size_t evictions;               /* freed objects that were not cached */
+} gmpy_cache_stats;
+
+typedef struct {
+    int generation;                 /* value of global.cache_generation */
+                                    /*   when the arrays were sized     */
+    gmpy_zbucket zbucket[ZCACHE_BUCKETS];
+    unsigned int zbucket_used;      /* bit k is set if bucket k is not empty */
+    MPZ_Object **gmpympzcache;
+    int in_gmpympzcache;
+    int gmpympzcache_size;
+    XMPZ_Object **gmpyxmpzcache;
+    int in_gmpyxmpzcache;
+    int gmpyxmpzcache_size;
+    MPQ_Object **gmpympqcache;
+    int in_gmpympqcache;
+    int gmpympqcache_size;
+    gmpy_mpfrbucket mpfrbucket[MPFR_CACHE_BUCKETS];
+    MPC_Object **gmpympccache;
+    int in_gmpympccache;
+    int gmpympccache_size;
+    gmpy_limbbucket limbbucket[LIMB_CACHE_LIMBS];
+    gmpy_pylong_entry pylong[PYLONG_CACHE_SIZE];
+    int pylong_next;                /* entry replaced by the next miss */
+    gmpy_cache_stats stats[GMPY_CACHE_TYPES];
+} gmpy_cache;
+
+static gmpy_cache *  GMPy_current_cache(void);
+static void          GMPy_Cache_Resize(gmpy_cache *cache);
+static void          GMPy_Cache_Release_Arena(gmpy_cache *cache, void *owner);
+static Py_ssize_t    GMPy_Cache_Count(gmpy_cache *cache, int type);
+static Py_ssize_t    GMPy_Cache_Prewarm(int type, int count, int limbs);
+
+static void          set_zcache(gmpy_cache *cache);
 static void          mpz_inoc(mpz_t newo);
 static void          mpz_cloc(mpz_t oldo);
+static void          set_pylong_cache(gmpy_cache *cache);
+
+/* Range of the preallocated mpz values that are shared by all threads. */
+#define MPZ_SMALL_MIN (-5)
+#define MPZ_SMALL_MAX 256
+#define MPZ_IS_SMALL(v) ((v) >= MPZ_SMALL_MIN && (v) <= MPZ_SMALL_MAX)
+
+/* Largest operand, in absolute value, used by the small value fast paths. */
+#define MPZ_SMALL_OPERAND 0x100000L
+
+static int           GMPy_MPZ_Small_Init(void);
+static MPZ_Object *  GMPy_MPZ_Small(long value);
+static int           GMPy_MPZ_Small_Operand(PyObject *obj, long *value);
+
+/* True if 'obj' is an mpz that is referenced only by the operand stack of
+ * the expression being evaluated, so its storage can be reused for the
+ * result. Only Python 3.14 can tell; before that a reference count of 1
+ * may belong to a C caller that holds a borrowed reference, e.g. to an item
+ * of a list, so the operand is never reused. */
+#if PY_VERSION_HEX >= 0x030E0000 && !defined(Py_GIL_DISABLED)
+#  define MPZ_IS_TEMPORARY(obj) \
+    (MPZ_Check(obj) && PyUnstable_Object_IsUniqueReferencedTemporary(obj))
+#else
+#  define MPZ_IS_TEMPORARY(obj) 0
+#endif
+
+static MPZ_Object *  GMPy_MPZ_Reuse(PyObject *x, PyObject *y);
 
-static void          set_gmpympzcache(void);
+static void          set_gmpympzcache(gmpy_cache *cache);
 static MPZ_Object *  GMPy_MPZ_New(CTXT_Object *context);
 static void          GMPy_MPZ_Dealloc(MPZ_Object *self);
 
-static void          set_gmpyxmpzcache(void);
+static void          set_gmpyxmpzcache(gmpy_cache *cache);
 static XMPZ_Object * GMPy_XMPZ_New(CTXT_Object *context);
 static void          GMPy_XMPZ_Dealloc(XMPZ_Object *self);
 
-static void          set_gmpympqcache(void);
+static void          set_gmpympqcache(gmpy_cache *cache);
 static MPQ_Object *  GMPy_MPQ_New(CTXT_Object *context);
 static void          GMPy_MPQ_Dealloc(MPQ_Object *self);
 
-static void          set_gmpympfrcache(void);
+static void          set_gmpympfrcache(gmpy_cache *cache);
 static MPFR_Object * GMPy_MPFR_New(mpfr_prec_t bits, CTXT_Object *context);
 static void          GMPy_MPFR_Dealloc(MPFR_Object *self);
 
-static void          set_gmpympccache(void);
+static void          set_gmpympccache(gmpy_cache *cache);
 static MPC_Object *  GMPy_MPC_New(mpfr_prec_t rprec, mpfr_prec_t iprec, CTXT_Object *context);
 static void          GMPy_MPC_Dealloc(MPC_Object *self);
 
@@ -0,0 +1,173 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_cancel.c                                                          *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* The deadline of a context is a value of time.monotonic(). The clock is
+ * only read when the work counter of a cancellation point overflows, so
+ * it is taken from the time module rather than from the C library, which
+ * might use a different epoch. */
+
+static PyObject *cancel_monotonic = NULL;
+
+/* The number of bytes of limbs allocated by gmpy2 that are still in use,
+ * as reported by cache_stats(). */
+
+static size_t
+GMPy_Limb_Bytes(void)
+{
+    size_t bytes = alloc_stats.bytes;
+
+#ifndef WITHOUT_THREADS
+    if (tls_nogil && tls_alloc_stats.bytes > 0)
+        bytes += (size_t)tls_alloc_stats.bytes;
+#endif
+    return bytes;
+}
+
+/* Size estimates: log2(x) for x >= 1, and log2(abs(x)) for an mpz, which
+ * is 0 for 0. */
+
+static double
+GMPy_Limb_Log2(double x)
+{
+    return x > 1.0 ? log(x) / log(2.0) : 0.0;
+}
+
+static double
+GMPy_Limb_Log2_MPZ(mpz_srcptr x)
+{
+    double d;
+    long e;
+
+    if (mpz_sgn(x) == 0)
+        return 0.0;
+    d = mpz_get_d_2exp(&e, x);
+    return (double)e + GMPy_Limb_Log2(fabs(d) * 2.0) - 1.0;
+}
+
+static void
+limb_error(void)
+{
+    PyErr_SetString(PyExc_MemoryError,
+                    "result would exceed max_limb_bytes of the context");
+}
+
+static int
+GMPy_Limb_Check(double bits, CTXT_Object *context)
+{
+    CHECK_CONTEXT(context);
+    if (context->ctx.max_limb_bytes &&
+        (double)GMPy_Limb_Bytes() + bits / 8 > (double)context->ctx.max_limb_bytes) {
+        limb_error();
+        return -1;
+    }
+    return 0;
+}
+
+/* Check for signals, the deadline, and the progress callback. The GIL must
+ * be held. Returns 1, with an exception set, to stop the operation. */
+
+static int
+cancel_check(size_t done, size_t total)
+{
+    CTXT_Object *context;
+    PyObject *temp, *module;
+    double now;
+
+    if (PyErr_CheckSignals() < 0)
+        return 1;
+
+    CURRENT_CONTEXT(context);
+    if (!context)
+        return 1;
+
+    if (context->ctx.max_limb_bytes &&
+        GMPy_Limb_Bytes() > context->ctx.max_limb_bytes) {
+        limb_error();
+        return 1;
+    }
+
+    if (context->ctx.deadline > 0.0) {
+        if (!cancel_monotonic) {
+            if (!(module = PyImport_ImportModule("time")))
+                return 1;
+            cancel_monotonic = PyObject_GetAttrString(module, "monotonic");
+            Py_DECREF(module);
+            if (!cancel_monotonic)
+                return 1;
+        }
+        if (!(temp = PyObject_CallObject(cancel_monotonic, NULL)))
+            return 1;
+        now = PyFloat_AsDouble(temp);
+        Py_DECREF(temp);
+        if (now == -1.0 && PyErr_Occurred())
+            return 1;
+        if (now >= context->ctx.deadline) {
+#if PY_VERSION_HEX >= 0x03030000
+            PyErr_SetString(PyExc_TimeoutError, "deadline of the context has passed");
+#else
+            PyErr_SetString(PyExc_RuntimeError, "deadline of the context has passed");
+#endif
+            return 1;
+        }
+    }
+
+    if (context->progress) {
+        /* The callback may replace the context, so keep it alive. */
+        Py_INCREF((PyObject*)context);
+        temp = PyObject_CallFunction(context->progress, "(nn)",
+                                     (Py_ssize_t)done, (Py_ssize_t)total);
+        Py_DECREF((PyObject*)context);
+        if (!temp)
+            return 1;
+        Py_DECREF(temp);
+    }
+    return 0;
+}
+
+static int
+GMPy_Cancel_Poll(size_t done, size_t total)
+{
+    int status;
+
+    tls_cancel_work = 0;
+#ifdef WITHOUT_THREADS
+    status = cancel_check(done, total);
+#else
+    if (!tls_nogil)
+        return cancel_check(done, total);
+    if (!tls_nogil_save)
+        return 0;
+
+    PyEval_RestoreThread(tls_nogil_save);
+    tls_nogil = 0;
+    GMPy_NoGIL_Merge(&tls_alloc_stats);
+    status = cancel_check(done, total);
+    tls_nogil = 1;
+    tls_nogil_save = PyEval_SaveThread();
+#endif
+    return status;
+}
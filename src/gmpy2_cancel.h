@@ -0,0 +1,81 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_cancel.h                                                          *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GMPY_CANCEL_H
+#define GMPY_CANCEL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Cancellation points in the loops that gmpy2 implements itself.
+ *
+ * GMPY_CANCEL_POINT(bits, done, total) adds 'bits', the operand size of the
+ * work done since the last call, to a counter of the current thread. Once
+ * the counter reaches GMPY_CANCEL_WORK it calls GMPy_Cancel_Poll(), which
+ * runs the pending signal handlers, checks the deadline of the current
+ * context, and calls its progress callback with (done, total). The value is
+ * nonzero if the loop must stop; an exception is then set and the caller
+ * must return NULL once it holds the GIL again.
+ *
+ * A cancellation point may be used with or without the GIL held. Without
+ * it, the GIL is taken for the duration of the poll, so the operands must
+ * not be visible to other Python code. In the threads of the pool the
+ * point only resets the counter; the calling thread polls for them.
+ *
+ * GMPY_LIMB_CHECK(bits, context) is true, with MemoryError set, if a result
+ * of about 'bits' bits would take the limbs allocated by gmpy2 beyond the
+ * max_limb_bytes of the context. GMP requires its allocation functions to
+ * succeed, so gmpy_allocate() cannot fail; the functions whose result size
+ * follows from their arguments check it before they start instead. Only
+ * results of at least GMPY_LIMB_CHECK_BITS are checked, so small operations
+ * do not look up the context. Cancellation points also compare the live
+ * limb memory with the limit.
+ */
+
+#define GMPY_CANCEL_WORK ((size_t)1 << 24)
+
+#define GMPY_CANCEL_POINT(bits, done, total) \
+    ((tls_cancel_work += (bits)) >= GMPY_CANCEL_WORK && \
+     GMPy_Cancel_Poll((size_t)(done), (size_t)(total)))
+
+#define GMPY_LIMB_CHECK_BITS ((double)(1 << 20))
+
+#define GMPY_LIMB_CHECK(bits, context) \
+    ((double)(bits) >= GMPY_LIMB_CHECK_BITS && \
+     GMPy_Limb_Check((double)(bits), context) < 0)
+
+static int GMPy_Cancel_Poll(size_t done, size_t total);
+static int GMPy_Limb_Check(double bits, CTXT_Object *context);
+static size_t GMPy_Limb_Bytes(void);
+static double GMPy_Limb_Log2(double x);
+static double GMPy_Limb_Log2_MPZ(mpz_srcptr x);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,83 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_capi.c                                                            *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* The C API exported as the capsule gmpy2._C_API; see gmpy2_capi.h. */
+
+static CTXT_Object *
+GMPy_CAPI_current_context(void)
+{
+    CTXT_Object *context = NULL;
+
+    CHECK_CONTEXT(context);
+    return context;
+}
+
+static GMPy_CAPI GMPy_C_API = {
+    GMPY2_CAPI_VERSION,
+
+    &MPZ_Type,
+    &XMPZ_Type,
+    &MPQ_Type,
+    &MPFR_Type,
+    &MPC_Type,
+    &CTXT_Type,
+
+    GMPy_MPZ_New,
+    GMPy_XMPZ_New,
+    GMPy_MPQ_New,
+    GMPy_MPFR_New,
+    GMPy_MPC_New,
+
+    GMPy_MPZ_Dealloc,
+    GMPy_XMPZ_Dealloc,
+    GMPy_MPQ_Dealloc,
+    GMPy_MPFR_Dealloc,
+    GMPy_MPC_Dealloc,
+
+    GMPy_MPZ_From_Integer,
+    GMPy_MPQ_From_Number,
+    GMPy_MPFR_From_Real,
+    GMPy_MPC_From_Complex,
+    GMPy_PyIntOrLong_From_MPZ,
+
+    GMPy_CAPI_current_context,
+};
+
+static int
+GMPy_CAPI_Init(PyObject *module)
+{
+    PyObject *capsule;
+
+    if (!(capsule = PyCapsule_New(&GMPy_C_API, GMPY2_CAPI_NAME, NULL)))
+        return -1;
+
+    if (PyModule_AddObject(module, "_C_API", capsule) < 0) {
+        Py_DECREF(capsule);
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,227 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_capi.h                                                            *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* gmpy2 C API header file.
+ *
+ * gmpy2 publishes a GMPy_CAPI structure as the capsule gmpy2._C_API. An
+ * extension module that includes this file (after Python.h) must call
+ * import_gmpy2() from its module initialization function; it returns 0 on
+ * success and -1, with an exception set, on failure. After that, these
+ * names can be used as they are inside gmpy2:
+ *
+ *   MPZ_Object, XMPZ_Object, MPQ_Object, MPFR_Object, MPC_Object
+ *   MPZ(obj), XMPZ(obj), MPQ(obj), MPFR(obj), MPC(obj)
+ *   MPZ_Check(obj), XMPZ_Check(obj), MPQ_Check(obj), MPFR_Check(obj),
+ *   MPC_Check(obj), CTXT_Check(obj)
+ *   MPZ_Type, XMPZ_Type, MPQ_Type, MPFR_Type, MPC_Type, CTXT_Type
+ *
+ *   GMPy_MPZ_New(context), GMPy_XMPZ_New(context), GMPy_MPQ_New(context)
+ *   GMPy_MPFR_New(prec, context), GMPy_MPC_New(rprec, iprec, context)
+ *   GMPy_MPZ_Dealloc(obj), ... , GMPy_MPC_Dealloc(obj)
+ *   GMPy_MPZ_From_Integer(obj, context), GMPy_MPQ_From_Number(obj, context)
+ *   GMPy_MPFR_From_Real(obj, prec, context)
+ *   GMPy_MPC_From_Complex(obj, rprec, iprec, context)
+ *   GMPy_PyIntOrLong_From_MPZ(obj, context)
+ *   GMPy_current_context()
+ *
+ * A NULL context means the current context. GMPy_current_context() returns
+ * a borrowed reference. The New functions return objects from the caches
+ * of the calling thread and the Dealloc functions return them there; they
+ * are the tp_dealloc of the types, so Py_DECREF is the usual way to release
+ * an object.
+ *
+ * Fields are only ever appended to GMPy_CAPI. GMPY2_CAPI_VERSION is
+ * incremented when that happens, and import_gmpy2() fails if the installed
+ * gmpy2 is older than the header the extension was compiled with.
+ */
+
+#ifndef GMPY2_CAPI_H
+#define GMPY2_CAPI_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef MPIR
+#  include "mpir.h"
+#else
+#  include "gmp.h"
+#endif
+#include "mpfr.h"
+#include "mpc.h"
+
+#define GMPY2_CAPI_VERSION 1
+#define GMPY2_CAPI_NAME "gmpy2._C_API"
+
+#if PY_VERSION_HEX < 0x030200A4 && !defined(GMPY2_MODULE)
+typedef long Py_hash_t;
+#endif
+
+typedef struct {
+    PyObject_HEAD
+    mpz_t z;
+    Py_hash_t hash_cache;
+    PyObject *str_cache;     /* str(), if kept by set_str_cache() */
+} MPZ_Object;
+
+typedef struct {
+    PyObject_HEAD
+    mpz_t z;
+    Py_ssize_t exports;     /* number of buffers exported */
+    struct gmpy_mmap_region *mapping;  /* file holding the limbs, or NULL */
+    struct gmpy_rank_index *rank;      /* bit counts for rank(), or NULL */
+} XMPZ_Object;
+
+typedef struct {
+    PyObject_HEAD
+    mpq_t q;
+    Py_hash_t  hash_cache;
+} MPQ_Object;
+
+typedef struct {
+    PyObject_HEAD
+    mpfr_t f;
+    Py_hash_t hash_cache;
+    int rc;
+} MPFR_Object;
+
+typedef struct {
+    PyObject_HEAD
+    mpc_t c;
+    Py_hash_t hash_cache;
+    int rc;
+} MPC_Object;
+
+/* The layout of a context is private. */
+struct gmpy_ctxt_object;
+
+typedef struct {
+    int version;
+
+    PyTypeObject *MPZ_Type;
+    PyTypeObject *XMPZ_Type;
+    PyTypeObject *MPQ_Type;
+    PyTypeObject *MPFR_Type;
+    PyTypeObject *MPC_Type;
+    PyTypeObject *CTXT_Type;
+
+    MPZ_Object *  (*MPZ_New)(struct gmpy_ctxt_object *context);
+    XMPZ_Object * (*XMPZ_New)(struct gmpy_ctxt_object *context);
+    MPQ_Object *  (*MPQ_New)(struct gmpy_ctxt_object *context);
+    MPFR_Object * (*MPFR_New)(mpfr_prec_t bits, struct gmpy_ctxt_object *context);
+    MPC_Object *  (*MPC_New)(mpfr_prec_t rprec, mpfr_prec_t iprec,
+                             struct gmpy_ctxt_object *context);
+
+    void (*MPZ_Dealloc)(MPZ_Object *self);
+    void (*XMPZ_Dealloc)(XMPZ_Object *self);
+    void (*MPQ_Dealloc)(MPQ_Object *self);
+    void (*MPFR_Dealloc)(MPFR_Object *self);
+    void (*MPC_Dealloc)(MPC_Object *self);
+
+    MPZ_Object *  (*MPZ_From_Integer)(PyObject *obj, struct gmpy_ctxt_object *context);
+    MPQ_Object *  (*MPQ_From_Number)(PyObject *obj, struct gmpy_ctxt_object *context);
+    MPFR_Object * (*MPFR_From_Real)(PyObject *obj, mpfr_prec_t prec,
+                                    struct gmpy_ctxt_object *context);
+    MPC_Object *  (*MPC_From_Complex)(PyObject *obj, mpfr_prec_t rprec,
+                                      mpfr_prec_t iprec,
+                                      struct gmpy_ctxt_object *context);
+    PyObject *    (*PyIntOrLong_From_MPZ)(MPZ_Object *obj, struct gmpy_ctxt_object *context);
+
+    struct gmpy_ctxt_object * (*current_context)(void);
+} GMPy_CAPI;
+
+#define MPZ(obj) (((MPZ_Object*)(obj))->z)
+#define XMPZ(obj) (((XMPZ_Object*)(obj))->z)
+#define MPQ(obj) (((MPQ_Object *)(obj))->q)
+#define MPFR(obj) (((MPFR_Object *)(obj))->f)
+#define MPC(obj) (((MPC_Object *)(obj))->c)
+
+#define MPZ_Check(v) (((PyObject*)v)->ob_type == &MPZ_Type)
+#define XMPZ_Check(v) (((PyObject*)v)->ob_type == &XMPZ_Type)
+#define MPQ_Check(v) (((PyObject*)v)->ob_type == &MPQ_Type)
+#define MPFR_Check(v) (((PyObject*)v)->ob_type == &MPFR_Type)
+#define MPC_Check(v) (((PyObject*)v)->ob_type == &MPC_Type)
+
+#ifdef GMPY2_MODULE
+
+static int GMPy_CAPI_Init(PyObject *module);
+
+#else
+
+typedef struct gmpy_ctxt_object CTXT_Object;
+
+static GMPy_CAPI *GMPy_C_API = NULL;
+
+#define MPZ_Type (*GMPy_C_API->MPZ_Type)
+#define XMPZ_Type (*GMPy_C_API->XMPZ_Type)
+#define MPQ_Type (*GMPy_C_API->MPQ_Type)
+#define MPFR_Type (*GMPy_C_API->MPFR_Type)
+#define MPC_Type (*GMPy_C_API->MPC_Type)
+#define CTXT_Type (*GMPy_C_API->CTXT_Type)
+#define CTXT_Check(v) (((PyObject*)v)->ob_type == &CTXT_Type)
+
+#define GMPy_MPZ_New (*GMPy_C_API->MPZ_New)
+#define GMPy_XMPZ_New (*GMPy_C_API->XMPZ_New)
+#define GMPy_MPQ_New (*GMPy_C_API->MPQ_New)
+#define GMPy_MPFR_New (*GMPy_C_API->MPFR_New)
+#define GMPy_MPC_New (*GMPy_C_API->MPC_New)
+#define GMPy_MPZ_Dealloc (*GMPy_C_API->MPZ_Dealloc)
+#define GMPy_XMPZ_Dealloc (*GMPy_C_API->XMPZ_Dealloc)
+#define GMPy_MPQ_Dealloc (*GMPy_C_API->MPQ_Dealloc)
+#define GMPy_MPFR_Dealloc (*GMPy_C_API->MPFR_Dealloc)
+#define GMPy_MPC_Dealloc (*GMPy_C_API->MPC_Dealloc)
+#define GMPy_MPZ_From_Integer (*GMPy_C_API->MPZ_From_Integer)
+#define GMPy_MPQ_From_Number (*GMPy_C_API->MPQ_From_Number)
+#define GMPy_MPFR_From_Real (*GMPy_C_API->MPFR_From_Real)
+#define GMPy_MPC_From_Complex (*GMPy_C_API->MPC_From_Complex)
+#define GMPy_PyIntOrLong_From_MPZ (*GMPy_C_API->PyIntOrLong_From_MPZ)
+#define GMPy_current_context (*GMPy_C_API->current_context)
+
+static int
+import_gmpy2(void)
+{
+    GMPy_CAPI *api = (GMPy_CAPI*)PyCapsule_Import(GMPY2_CAPI_NAME, 0);
+
+    if (!api)
+        return -1;
+
+    if (api->version < GMPY2_CAPI_VERSION) {
+        PyErr_Format(PyExc_ImportError,
+                     "gmpy2 C API version %d is older than version %d",
+                     api->version, GMPY2_CAPI_VERSION);
+        return -1;
+    }
+    GMPy_C_API = api;
+    return 0;
+}
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+#endif
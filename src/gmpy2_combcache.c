@@ -0,0 +1,481 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_combcache.c                                                       *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* When set_comb_cache() gives a memory budget, the results of fac(),
+ * primorial() and comb() are kept in a small table and later calls with
+ * nearby arguments start from the closest kept result:
+ *
+ *   fac(n)       = fac(m) * (m+1) * ... * n, or fac(m) / ((n+1) * ... * m)
+ *   primorial(n) = primorial(m) times or divided by the primes between
+ *   comb(n, k)   = comb(m, j) moved one step of n or k at a time
+ *
+ * The product of the factors in between is built by binary splitting, so
+ * the kept value takes part in a single multiplication or exact division.
+ * The least recently used entries are dropped when the budget is exceeded.
+ *
+ * The cache is only used while the GIL is held.
+ */
+
+#define COMB_ENTRIES 32
+
+/* comb(n, k) is only kept for k >= COMB_MIN_K; smaller ones are cheap. */
+#define COMB_MIN_K 16
+
+/* Number of single steps allowed to move from a kept comb(m, j). */
+#define COMB_MAX_STEPS 32
+
+enum { COMB_FAC = 1, COMB_PRIMORIAL, COMB_BIN };
+
+typedef struct {
+    int kind;                /* 0 if the entry is unused */
+    unsigned long n, k;
+    mpz_t value;
+    size_t bytes;
+    size_t stamp;            /* time of last use */
+} gmpy_comb_entry;
+
+static gmpy_comb_entry comb_cache[COMB_ENTRIES];
+static size_t comb_cache_limit = 0;      /* 0 disables the cache */
+static size_t comb_cache_bytes = 0;
+static size_t comb_cache_clock = 0;
+
+static void
+comb_cache_drop(gmpy_comb_entry *e)
+{
+    if (e->kind) {
+        mpz_clear(e->value);
+        comb_cache_bytes -= e->bytes;
+        e->kind = 0;
+    }
+}
+
+/* Return the kept entry of the given kind closest to (n, k), measured by
+ * dist(), or NULL if none is within maxdist. */
+
+static gmpy_comb_entry *
+comb_cache_nearest(int kind, unsigned long n, unsigned long k,
+                   unsigned long maxdist)
+{
+    gmpy_comb_entry *best = NULL;
+    unsigned long d, bestd = maxdist;
+    int i;
+
+    if (!comb_cache_limit)
+        return NULL;
+
+    for (i = 0; i < COMB_ENTRIES; i++) {
+        if (comb_cache[i].kind != kind)
+            continue;
+        d = comb_cache[i].n > n ? comb_cache[i].n - n : n - comb_cache[i].n;
+        d += comb_cache[i].k > k ? comb_cache[i].k - k : k - comb_cache[i].k;
+        if (d <= bestd) {
+            best = &comb_cache[i];
+            bestd = d;
+        }
+    }
+    if (best)
+        best->stamp = ++comb_cache_clock;
+    return best;
+}
+
+/* Keep a copy of value, dropping the least recently used entries to stay
+ * within the memory budget. */
+
+static void
+comb_cache_store(int kind, unsigned long n, unsigned long k, mpz_srcptr value)
+{
+    gmpy_comb_entry *e = NULL;
+    size_t bytes = mpz_size(value) * sizeof(mp_limb_t);
+    int i;
+
+    if (!comb_cache_limit || bytes > comb_cache_limit)
+        return;
+
+    for (i = 0; i < COMB_ENTRIES; i++) {
+        if (comb_cache[i].kind == kind && comb_cache[i].n == n &&
+            comb_cache[i].k == k)
+            return;
+    }
+
+    while (1) {
+        gmpy_comb_entry *oldest = NULL;
+
+        for (i = 0; i < COMB_ENTRIES; i++) {
+            if (!comb_cache[i].kind) {
+                if (!e)
+                    e = &comb_cache[i];
+            }
+            else if (!oldest || comb_cache[i].stamp < oldest->stamp) {
+                oldest = &comb_cache[i];
+            }
+        }
+        if (e && comb_cache_bytes + bytes <= comb_cache_limit)
+            break;
+        comb_cache_drop(oldest);
+        e = NULL;
+    }
+
+    mpz_init_set(e->value, value);
+    e->kind = kind;
+    e->n = n;
+    e->k = k;
+    e->bytes = bytes;
+    e->stamp = ++comb_cache_clock;
+    comb_cache_bytes += bytes;
+}
+
+/* Set r to lo * (lo+1) * ... * (hi-1), with lo < hi. */
+
+static void
+comb_range_product(mpz_t r, unsigned long lo, unsigned long hi)
+{
+    mpz_t t;
+    unsigned long mid, m;
+
+    if (hi - lo <= 16) {
+        mpz_set_ui(r, lo);
+        for (m = lo + 1; m < hi; m++)
+            mpz_mul_ui(r, r, m);
+        return;
+    }
+    mid = lo + (hi - lo) / 2;
+    mpz_init(t);
+    comb_range_product(r, lo, mid);
+    comb_range_product(t, mid, hi);
+    mpz_mul(r, r, t);
+    mpz_clear(t);
+}
+
+/* Set r to the product of the primes p with lo < p <= hi. */
+
+static void
+comb_prime_product(mpz_t r, unsigned long lo, unsigned long hi)
+{
+    unsigned long p[32];
+    mpz_t t;
+    unsigned long m;
+    int np = 0, i;
+
+    mpz_set_ui(r, 1);
+    mpz_init(t);
+    for (m = lo + 1; m <= hi && m >= lo + 1; m++) {
+        if (!prp_word_is_prime(m))
+            continue;
+        p[np++] = m;
+        if (np == 32) {
+            mpz_set_ui(t, p[0]);
+            for (i = 1; i < np; i++)
+                mpz_mul_ui(t, t, p[i]);
+            mpz_mul(r, r, t);
+            np = 0;
+        }
+    }
+    if (np) {
+        mpz_set_ui(t, p[0]);
+        for (i = 1; i < np; i++)
+            mpz_mul_ui(t, t, p[i]);
+        mpz_mul(r, r, t);
+    }
+    mpz_clear(t);
+}
+
+/* Set r to n!. */
+
+static void
+comb_fac(mpz_t r, unsigned long n)
+{
+    gmpy_comb_entry *e;
+    unsigned long m;
+    double bits = (double)n * GMPy_Limb_Log2((double)n);
+    mpz_t t;
+
+    e = comb_cache_nearest(COMB_FAC, n, 0, n / 4);
+    if (e && e->n == n) {
+        mpz_set(r, e->value);
+        return;
+    }
+    if (pcache_load_mpz(r, "fac", n, 0, bits)) {
+        comb_cache_store(COMB_FAC, n, 0, r);
+        return;
+    }
+
+    if (e) {
+        /* e may be dropped by another thread while the GIL is released. */
+        m = e->n;
+        mpz_set(r, e->value);
+        mpz_init(t);
+        GMPY_BEGIN_NOGIL(n);
+        if (m < n) {
+            comb_range_product(t, m + 1, n + 1);
+            mpz_mul(r, r, t);
+        }
+        else {
+            comb_range_product(t, n + 1, m + 1);
+            mpz_divexact(r, r, t);
+        }
+        GMPY_END_NOGIL;
+        mpz_clear(t);
+    }
+    else {
+        GMPY_BEGIN_NOGIL(n);
+        mpz_fac_ui(r, n);
+        GMPY_END_NOGIL;
+    }
+    comb_cache_store(COMB_FAC, n, 0, r);
+    pcache_store_mpz(r, "fac", n, 0, bits);
+}
+
+/* Set r to the product of the primes <= n. */
+
+static void
+comb_primorial(mpz_t r, unsigned long n)
+{
+    gmpy_comb_entry *e;
+    unsigned long m;
+    double bits = 1.4427 * n;
+    mpz_t t;
+
+    e = comb_cache_nearest(COMB_PRIMORIAL, n, 0, n / 4);
+    if (e && e->n == n) {
+        mpz_set(r, e->value);
+        return;
+    }
+    if (pcache_load_mpz(r, "primorial", n, 0, bits)) {
+        comb_cache_store(COMB_PRIMORIAL, n, 0, r);
+        return;
+    }
+
+    if (e) {
+        /* e may be dropped by another thread while the GIL is released. */
+        m = e->n;
+        mpz_set(r, e->value);
+        mpz_init(t);
+        GMPY_BEGIN_NOGIL(n);
+        if (m < n) {
+            comb_prime_product(t, m, n);
+            mpz_mul(r, r, t);
+        }
+        else {
+            comb_prime_product(t, n, m);
+            mpz_divexact(r, r, t);
+        }
+        GMPY_END_NOGIL;
+        mpz_clear(t);
+    }
+    else {
+        GMPY_BEGIN_NOGIL(n);
+        mpz_primorial_ui(r, n);
+        GMPY_END_NOGIL;
+    }
+    comb_cache_store(COMB_PRIMORIAL, n, 0, r);
+    pcache_store_mpz(r, "primorial", n, 0, bits);
+}
+
+/* Set r to comb(n, k). Only 0 <= k <= n that fit an unsigned long with
+ * k >= COMB_MIN_K use the cache. */
+
+static void
+comb_bin(mpz_t r, mpz_srcptr n, unsigned long k)
+{
+    gmpy_comb_entry *e;
+    unsigned long m, j, un;
+
+    if (!comb_cache_limit || k < COMB_MIN_K || !mpz_fits_ulong_p(n) ||
+        (un = mpz_get_ui(n)) < k) {
+        mpz_bin_ui(r, n, k);
+        return;
+    }
+
+    if (!(e = comb_cache_nearest(COMB_BIN, un, k, COMB_MAX_STEPS))) {
+        mpz_bin_ui(r, n, k);
+        comb_cache_store(COMB_BIN, un, k, r);
+        return;
+    }
+
+    /* Raise n first and lower it last, so that j <= m at every step. */
+    mpz_set(r, e->value);
+    m = e->n;
+    j = e->k;
+    for (; m < un; m++) {
+        mpz_mul_ui(r, r, m + 1);
+        mpz_divexact_ui(r, r, m + 1 - j);
+    }
+    for (; j < k; j++) {
+        mpz_mul_ui(r, r, m - j);
+        mpz_divexact_ui(r, r, j + 1);
+    }
+    for (; j > k; j--) {
+        mpz_mul_ui(r, r, j);
+        mpz_divexact_ui(r, r, m - j + 1);
+    }
+    for (; m > un; m--) {
+        mpz_mul_ui(r, r, m - j);
+        mpz_divexact_ui(r, r, m);
+    }
+    comb_cache_store(COMB_BIN, un, k, r);
+}
+
+PyDoc_STRVAR(GMPy_doc_get_comb_cache,
+"get_comb_cache() -> tuple\n\n"
+"Return the memory budget, in bytes, of the cache of factorials,\n"
+"primorials and binomial coefficients, and the number of bytes\n"
+"currently used.");
+
+static PyObject *
+GMPy_get_comb_cache(PyObject *self, PyObject *args)
+{
+    return Py_BuildValue("(nn)", (Py_ssize_t)comb_cache_limit,
+                         (Py_ssize_t)comb_cache_bytes);
+}
+
+PyDoc_STRVAR(GMPy_doc_set_comb_cache,
+"set_comb_cache(bytes)\n\n"
+"Keep up to bytes of recent results of fac(), primorial() and comb()\n"
+"in memory. Calls with nearby arguments then start from a kept result\n"
+"instead of computing from scratch. 0 (the default) disables the\n"
+"cache and frees its memory.");
+
+static PyObject *
+GMPy_set_comb_cache(PyObject *self, PyObject *other)
+{
+    Py_ssize_t bytes;
+    int i;
+
+    bytes = PyIntOrLong_AsSsize_t(other);
+    if (bytes == -1 && PyErr_Occurred()) {
+        TYPE_ERROR("set_comb_cache() requires an integer argument");
+        return NULL;
+    }
+    if (bytes < 0) {
+        VALUE_ERROR("size must be 0 or greater");
+        return NULL;
+    }
+
+    comb_cache_limit = (size_t)bytes;
+    if (comb_cache_bytes > comb_cache_limit) {
+        for (i = 0; i < COMB_ENTRIES; i++)
+            comb_cache_drop(&comb_cache[i]);
+    }
+    Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(GMPy_doc_mpz_function_comb_row,
+"comb_row(n) -> list\n\n"
+"Return the list [comb(n, 0), comb(n, 1), ..., comb(n, n)]. Each\n"
+"entry is computed from the previous one.");
+
+static PyObject *
+GMPy_MPZ_Function_CombRow(PyObject *self, PyObject *other)
+{
+    PyObject *result;
+    MPZ_Object *item;
+    unsigned long n, k;
+
+    n = c_ulong_From_Integer(other);
+    if (n == (unsigned long)(-1) && PyErr_Occurred()) {
+        return NULL;
+    }
+    if (n >= (unsigned long)PY_SSIZE_T_MAX) {
+        return PyErr_NoMemory();
+    }
+
+    if (!(result = PyList_New((Py_ssize_t)n + 1)))
+        return NULL;
+
+    for (k = 0; k <= n; k++) {
+        if (!(item = GMPy_MPZ_New(NULL))) {
+            Py_DECREF(result);
+            return NULL;
+        }
+        if (k == 0) {
+            mpz_set_ui(item->z, 1);
+        }
+        else if (k > n / 2) {
+            /* comb(n, k) == comb(n, n - k) */
+            mpz_set(item->z, MPZ(PyList_GET_ITEM(result, n - k)));
+        }
+        else {
+            mpz_mul_ui(item->z, MPZ(PyList_GET_ITEM(result, k - 1)), n - k + 1);
+            mpz_divexact_ui(item->z, item->z, k);
+        }
+        PyList_SET_ITEM(result, k, (PyObject*)item);
+    }
+    return result;
+}
+
+PyDoc_STRVAR(GMPy_doc_mpz_function_fac_range,
+"fac_range(a, b) -> list\n\n"
+"Return the list [fac(a), fac(a+1), ..., fac(b-1)]. Each entry is\n"
+"computed from the previous one.");
+
+static PyObject *
+GMPy_MPZ_Function_FacRange(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *result;
+    MPZ_Object *item;
+    unsigned long a, b, n;
+
+    if (nargs != 2) {
+        TYPE_ERROR("fac_range() requires 2 integer arguments");
+        return NULL;
+    }
+
+    a = c_ulong_From_Integer(args[0]);
+    if (a == (unsigned long)(-1) && PyErr_Occurred()) {
+        return NULL;
+    }
+
+    b = c_ulong_From_Integer(args[1]);
+    if (b == (unsigned long)(-1) && PyErr_Occurred()) {
+        return NULL;
+    }
+
+    if (b < a)
+        b = a;
+    if (b - a > (unsigned long)PY_SSIZE_T_MAX) {
+        return PyErr_NoMemory();
+    }
+
+    if (!(result = PyList_New((Py_ssize_t)(b - a))))
+        return NULL;
+
+    for (n = a; n < b; n++) {
+        if (!(item = GMPy_MPZ_New(NULL))) {
+            Py_DECREF(result);
+            return NULL;
+        }
+        if (n == a)
+            comb_fac(item->z, n);
+        else
+            mpz_mul_ui(item->z, MPZ(PyList_GET_ITEM(result, n - a - 1)), n);
+        PyList_SET_ITEM(result, n - a, (PyObject*)item);
+    }
+    if (b - a > 1)
+        comb_cache_store(COMB_FAC, b - 1, 0, MPZ(PyList_GET_ITEM(result, b - a - 1)));
+    return result;
+}
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_Function_FacRange)
@@ -86,6 +86,10 @@ GMPy_CTXT_New(void)
         result->ctx.guard_bits = 0;
         result->ctx.convert_exact = 0;
         result->ctx.mpfr_divmod_exact = 0;
+        result->ctx.deadline = 0.0;
+        result->ctx.max_limb_bytes = 0;
+        result->progress = NULL;
+        result->frozen = 0;
 
 #ifndef WITHOUT_THREADS
         result->tstate = NULL;
@@ -98,9 +102,36 @@ GMPy_CTXT_New(void)
 static void
 GMPy_CTXT_Dealloc(CTXT_Object *self)
 {
+    Py_XDECREF(self->progress);
     PyObject_Del(self);
 };
 
+/* Return the flags of a frozen context for the current thread. Safe to
+ * call without the GIL. */
+
+static gmpy_context *
+GMPy_Frozen_Flags(CTXT_Object *context)
+{
+    gmpy_frozen_flags *entry;
+    int i;
+
+    for (i = 0; i < FROZEN_FLAGS_SIZE; i++) {
+        if (tls_frozen_flags[i].id == context->frozen)
+            return &tls_frozen_flags[i].ctx;
+    }
+
+    entry = &tls_frozen_flags[tls_frozen_next];
+    tls_frozen_next = (tls_frozen_next + 1) % FROZEN_FLAGS_SIZE;
+    entry->id = context->frozen;
+    entry->ctx.underflow = 0;
+    entry->ctx.overflow = 0;
+    entry->ctx.inexact = 0;
+    entry->ctx.invalid = 0;
+    entry->ctx.erange = 0;
+    entry->ctx.divzero = 0;
+    return &entry->ctx;
+}
+
 /* Support for global and thread local contexts. */
 
 /* Doc-string, alternate definitions below. */
@@ -118,6 +149,7 @@ GMPy_CTXT_Set(PyObject *self, PyObject *other)
         VALUE_ERROR("set_context() requires a context argument");
         return NULL;
     }
+    GMPY_PROBE1(context__set, other);
 
     Py_DECREF((PyObject*)module_context);
     Py_INCREF((PyObject*)other);
@@ -126,6 +158,88 @@ GMPy_CTXT_Set(PyObject *self, PyObject *other)
     Py_RETURN_NONE;
 }
 
+#elif defined(GMPY_CONTEXTVAR)
+
+/* The current context is the value of current_context_var. Reading a
+ * context variable is a lookup in the mapping of the active Python context,
+ * so the last value read is remembered per thread. It stays valid while
+ * the thread runs the same Python context: the thread state changes
+ * context_ver whenever another context is entered or exited, and only
+ * GMPy_CTXT_Set changes the value of current_context_var.
+ */
+
+static void
+remember_context(CTXT_Object *context)
+{
+    PyThreadState *tstate = PyThreadState_GET();
+
+    tls_context = context;
+    tls_context_owner = tstate->context;
+    tls_context_ver = tstate->context_ver;
+}
+
+static CTXT_Object *
+current_context_from_var(void)
+{
+    PyObject *context;
+
+    if (PyContextVar_Get(current_context_var, NULL, &context) < 0)
+        return NULL;
+
+    if (!context) {
+        /* Set up a new context for this thread or task. */
+        PyObject *token;
+
+        if (!(context = GMPy_CTXT_New()))
+            return NULL;
+        if (!(token = PyContextVar_Set(current_context_var, context))) {
+            Py_DECREF(context);
+            return NULL;
+        }
+        Py_DECREF(token);
+    }
+
+    /* The Python context keeps the value alive. */
+    Py_DECREF(context);
+    remember_context((CTXT_Object*)context);
+    return (CTXT_Object*)context;
+}
+
+/* Return borrowed reference to the current context. */
+static CTXT_Object *
+GMPy_current_context(void)
+{
+    PyThreadState *tstate = PyThreadState_GET();
+
+    if (tls_context && tls_context_owner == tstate->context &&
+        tls_context_ver == tstate->context_ver) {
+        return tls_context;
+    }
+
+    return current_context_from_var();
+}
+
+/* Set the current context of this thread or task. */
+static PyObject *
+GMPy_CTXT_Set(PyObject *self, PyObject *other)
+{
+    PyObject *token;
+
+    if (!CTXT_Check(other)) {
+        VALUE_ERROR("set_context() requires a context argument");
+        return NULL;
+    }
+    GMPY_PROBE1(context__set, other);
+
+    if (!(token = PyContextVar_Set(current_context_var, other))) {
+        return NULL;
+    }
+    Py_DECREF(token);
+
+    remember_context((CTXT_Object*)other);
+    Py_RETURN_NONE;
+}
+
 #else
 
 /* Begin support for thread local contexts. */
@@ -205,6 +319,7 @@ GMPy_CTXT_Set(PyObject *self, PyObject *other)
         VALUE_ERROR("set_context() requires a context argument");
         return NULL;
     }
+    GMPY_PROBE1(context__set, other);
 
     dict = PyThreadState_GetDict();
     if (dict == NULL) {
@@ -290,8 +405,10 @@ GMPy_CTXT_Manager_New(void)
     PyObject *result;
 
     result = (PyObject*)PyObject_New(CTXT_Manager_Object, &CTXT_Manager_Type);
-    ((CTXT_Manager_Object*)(result))->new_context = NULL;
-    ((CTXT_Manager_Object*)(result))->old_context = NULL;
+    if (result) {
+        ((CTXT_Manager_Object*)(result))->new_context = NULL;
+        ((CTXT_Manager_Object*)(result))->old_context = NULL;
+    }
     return result;
 }
 
@@ -323,6 +440,7 @@ GMPy_CTXT_Repr_Slot(CTXT_Object *self)
     PyObject *format;
     PyObject *tuple;
     PyObject *result = NULL;
+    gmpy_context *flags = GMPY_FLAGS(self);
     int i = 0;
 
     tuple = PyTuple_New(26);
@@ -367,17 +485,17 @@ GMPy_CTXT_Repr_Slot(CTXT_Object *self)
     PyTuple_SET_ITEM(tuple, i++, PyIntOrLong_FromLong(self->ctx.emin));
     PyTuple_SET_ITEM(tuple, i++, PyBool_FromLong(self->ctx.subnormalize));
     PyTuple_SET_ITEM(tuple, i++, PyBool_FromLong(self->ctx.traps & TRAP_UNDERFLOW));
-    PyTuple_SET_ITEM(tuple, i++, PyBool_FromLong(self->ctx.underflow));
+    PyTuple_SET_ITEM(tuple, i++, PyBool_FromLong(flags->underflow));
     PyTuple_SET_ITEM(tuple, i++, PyBool_FromLong(self->ctx.traps & TRAP_OVERFLOW));
-    PyTuple_SET_ITEM(tuple, i++, PyBool_FromLong(self->ctx.overflow));
+    PyTuple_SET_ITEM(tuple, i++, PyBool_FromLong(flags->overflow));
     PyTuple_SET_ITEM(tuple, i++, PyBool_FromLong(self->ctx.traps & TRAP_INEXACT));
-    PyTuple_SET_ITEM(tuple, i++, PyBool_FromLong(self->ctx.inexact));
+    PyTuple_SET_ITEM(tuple, i++, PyBool_FromLong(flags->inexact));
     PyTuple_SET_ITEM(tuple, i++, PyBool_FromLong(self->ctx.traps & TRAP_INVALID));
-    PyTuple_SET_ITEM(tuple, i++, PyBool_FromLong(self->ctx.invalid));
+    PyTuple_SET_ITEM(tuple, i++, PyBool_FromLong(flags->invalid));
     PyTuple_SET_ITEM(tuple, i++, PyBool_FromLong(self->ctx.traps & TRAP_ERANGE));
-    PyTuple_SET_ITEM(tuple, i++, PyBool_FromLong(self->ctx.erange));
+    PyTuple_SET_ITEM(tuple, i++, PyBool_FromLong(flags->erange));
     PyTuple_SET_ITEM(tuple, i++, PyBool_FromLong(self->ctx.traps & TRAP_DIVZERO));
-    PyTuple_SET_ITEM(tuple, i++, PyBool_FromLong(self->ctx.divzero));
+    PyTuple_SET_ITEM(tuple, i++, PyBool_FromLong(flags->divzero));
     PyTuple_SET_ITEM(tuple, i++, PyBool_FromLong(self->ctx.allow_complex));
     PyTuple_SET_ITEM(tuple, i++, PyBool_FromLong(self->ctx.rational_division));
     PyTuple_SET_ITEM(tuple, i++, PyIntOrLong_FromLong(self->ctx.guard_bits));
@@ -420,11 +538,55 @@ PyDoc_STRVAR(GMPy_doc_context_copy,
 
 static PyObject *
 GMPy_CTXT_Copy(PyObject *self, PyObject *other)
+{
+    CTXT_Object *result, *context = (CTXT_Object*)self;
+    gmpy_context *flags;
+
+    if ((result = (CTXT_Object*)GMPy_CTXT_New())) {
+        result->ctx = context->ctx;
+        result->progress = context->progress;
+        Py_XINCREF(result->progress);
+        if (context->frozen) {
+            /* The copy is mutable and starts with the flags that the
+             * current thread raised under the frozen context. */
+            flags = GMPy_Frozen_Flags(context);
+            result->ctx.underflow = flags->underflow;
+            result->ctx.overflow = flags->overflow;
+            result->ctx.inexact = flags->inexact;
+            result->ctx.invalid = flags->invalid;
+            result->ctx.erange = flags->erange;
+            result->ctx.divzero = flags->divzero;
+        }
+    }
+    return (PyObject*)result;
+}
+
+PyDoc_STRVAR(GMPy_doc_context_freeze,
+"context.freeze() -> gmpy2 context\n\n"
+"Return a frozen copy of a context. The settings of a frozen context can\n"
+"not be changed, so it can be shared by threads and used with\n"
+"local_context() without being copied. Each thread sees only the\n"
+"exception flags that it raised under a frozen context.");
+
+static PyObject *
+GMPy_CTXT_Freeze(PyObject *self, PyObject *other)
 {
     CTXT_Object *result;
 
-    result = (CTXT_Object*)GMPy_CTXT_New();
-    result->ctx = ((CTXT_Object*)self)->ctx;
+    if (((CTXT_Object*)self)->frozen) {
+        Py_INCREF(self);
+        return self;
+    }
+
+    if ((result = (CTXT_Object*)GMPy_CTXT_Copy(self, NULL))) {
+        result->ctx.underflow = 0;
+        result->ctx.overflow = 0;
+        result->ctx.inexact = 0;
+        result->ctx.invalid = 0;
+        result->ctx.erange = 0;
+        result->ctx.divzero = 0;
+        result->frozen = ++frozen_ids;
+    }
     return (PyObject*)result;
 }
 
@@ -432,10 +594,14 @@ GMPy_CTXT_Copy(PyObject *self, PyObject *other)
  * error occurred; returns 0 is an error occurred.
  */
 
+static int GMPy_CTXT_Set_deadline(CTXT_Object *self, PyObject *value, void *closure);
+static int GMPy_CTXT_Set_progress(CTXT_Object *self, PyObject *value, void *closure);
+static int GMPy_CTXT_Set_max_limb_bytes(CTXT_Object *self, PyObject *value, void *closure);
+
 static int
 _parse_context_args(CTXT_Object *ctxt, PyObject *kwargs)
 {
-    PyObject *args;
+    PyObject *args, *deadline = NULL, *progress = NULL, *max_limb_bytes = NULL;
     int x_trap_underflow = 0, x_trap_overflow = 0, x_trap_inexact = 0;
     int x_trap_invalid = 0, x_trap_erange = 0, x_trap_divzero = 0;
 
@@ -445,7 +611,7 @@ _parse_context_args(CTXT_Object *ctxt, PyObject *kwargs)
         "trap_underflow", "trap_overflow", "trap_inexact",
         "trap_invalid", "trap_erange", "trap_divzero", "allow_complex",
         "rational_division", "guard_bits", "convert_exact",
-        "mpfr_divmod_exact", NULL };
+        "mpfr_divmod_exact", "deadline", "progress", "max_limb_bytes", NULL };
 
     /* Create an empty dummy tuple to use for args. */
 
@@ -463,7 +629,7 @@ _parse_context_args(CTXT_Object *ctxt, PyObject *kwargs)
     x_trap_divzero = ctxt->ctx.traps & TRAP_DIVZERO;
 
     if (!(PyArg_ParseTupleAndKeywords(args, kwargs,
-            "|llliiilliiiiiiiiiiii", kwlist,
+            "|llliiilliiiiiiiiiiiiOOO", kwlist,
             &ctxt->ctx.mpfr_prec,
             &ctxt->ctx.real_prec,
             &ctxt->ctx.imag_prec,
@@ -483,13 +649,22 @@ _parse_context_args(CTXT_Object *ctxt, PyObject *kwargs)
             &ctxt->ctx.rational_division,
             &ctxt->ctx.guard_bits,
             &ctxt->ctx.convert_exact,
-            &ctxt->ctx.mpfr_divmod_exact))) {
+            &ctxt->ctx.mpfr_divmod_exact,
+            &deadline,
+            &progress,
+            &max_limb_bytes))) {
         VALUE_ERROR("invalid keyword arguments in local_context()");
         Py_DECREF(args);
         return 0;
     }
     Py_DECREF(args);
 
+    if ((deadline && GMPy_CTXT_Set_deadline(ctxt, deadline, NULL) < 0) ||
+        (progress && GMPy_CTXT_Set_progress(ctxt, progress, NULL) < 0) ||
+        (max_limb_bytes &&
+         GMPy_CTXT_Set_max_limb_bytes(ctxt, max_limb_bytes, NULL) < 0))
+        return 0;
+
     ctxt->ctx.traps = TRAP_NONE;
     if (x_trap_underflow)
         ctxt->ctx.traps |= TRAP_UNDERFLOW;
@@ -587,7 +762,10 @@ PyDoc_STRVAR(GMPy_doc_local_context,
 "when the 'with ...' block terminates. The temporary context for the\n"
 "'with ...' block is based on the current context if no context is\n"
 "specified. Keyword arguments are supported and will modify the\n"
-"temporary new context.");
+"temporary new context.\n\n"
+"The context manager can be saved and used again. Entering it again\n"
+"only switches to the same temporary context, which is faster than\n"
+"calling local_context() each time.");
 
 static PyObject *
 GMPy_CTXT_Local(PyObject *self, PyObject *args, PyObject *kwargs)
@@ -597,6 +775,8 @@ GMPy_CTXT_Local(PyObject *self, PyObject *args, PyObject *kwargs)
     CTXT_Object *context, *temp;
 
     CURRENT_CONTEXT(context);
+    if (!context)
+        return NULL;
 
     if (PyTuple_GET_SIZE(args) == 1 && CTXT_Check(PyTuple_GET_ITEM(args, 0))) {
         arg_context = 1;
@@ -609,20 +789,26 @@ GMPy_CTXT_Local(PyObject *self, PyObject *args, PyObject *kwargs)
     if (!(result = (CTXT_Manager_Object*)GMPy_CTXT_Manager_New()))
         return NULL;
 
+    /* The context that is entered is a copy so that contexts shared with
+     * other threads or tasks are never modified. A context that is passed
+     * as an argument without keywords is used as is. */
     if (arg_context) {
         temp = (CTXT_Object*)PyTuple_GET_ITEM(args, 0);
-        result->new_context = temp;
-        Py_INCREF((PyObject*)(result->new_context));
     }
     else {
-        result->new_context = context;
-        Py_INCREF((PyObject*)(result->new_context));
+        temp = context;
     }
 
-    result->old_context = (CTXT_Object*)GMPy_CTXT_Copy((PyObject*)context, NULL);
-    if (!(result->old_context)) {
-        Py_DECREF((PyObject*)result);
-        return NULL;
+    if (arg_context && !(kwargs && PyDict_Size(kwargs))) {
+        result->new_context = temp;
+        Py_INCREF((PyObject*)(result->new_context));
+    }
+    else {
+        result->new_context = (CTXT_Object*)GMPy_CTXT_Copy((PyObject*)temp, NULL);
+        if (!(result->new_context)) {
+            Py_DECREF((PyObject*)result);
+            return NULL;
+        }
     }
 
     if (!_parse_context_args(result->new_context, kwargs)) {
@@ -676,7 +862,13 @@ PyDoc_STRVAR(GMPy_doc_context,
 "    convert_exact:     if True, string to mpfr/mpc conversions are done\n"
 "                       exactly by intermediate conversion to mpq\n"
 "    mpfr_divmod_exact: if True, divmod(mpfr,mpfr) calculations are done\n"
-"                       exactly by intermediate conversion to mpq.\n");
+"                       exactly by intermediate conversion to mpq.\n"
+"    deadline:          value of time.monotonic() after which long\n"
+"                       operations raise TimeoutError, or None\n"
+"    progress:          called as progress(done, total) during long\n"
+"                       operations, or None\n"
+"    max_limb_bytes:    MemoryError is raised when an operation would take\n"
+"                       the memory of gmpy2 numbers beyond it, or None\n");
 #if 0
 "\nMethods\n"
 "    abs(x)          return absolute value of x\n"
@@ -805,32 +997,62 @@ GMPy_CTXT_Context(PyObject *self, PyObject *args, PyObject *kwargs)
     }
 }
 
+/* A context manager can be entered again after it has exited. Entering it
+ * only saves the current context and makes new_context current, so a
+ * manager created once by local_context() switches contexts without
+ * allocating any gmpy2 objects.
+ */
+
 static PyObject *
 GMPy_CTXT_Manager_Enter(PyObject *self, PyObject *args)
 {
+    CTXT_Manager_Object *manager = (CTXT_Manager_Object*)self;
+    CTXT_Object *context;
     PyObject *temp;
 
-    temp = GMPy_CTXT_Set(NULL, (PyObject*)((CTXT_Manager_Object*)self)->new_context);
-    if (!temp)
+    if (manager->old_context) {
+        RUNTIME_ERROR("context manager is already in effect");
+        return NULL;
+    }
+
+    CURRENT_CONTEXT(context);
+    if (!context)
+        return NULL;
+
+    /* The current context may only be referenced by the context variable. */
+    Py_INCREF((PyObject*)context);
+    temp = GMPy_CTXT_Set(NULL, (PyObject*)manager->new_context);
+    if (!temp) {
+        Py_DECREF((PyObject*)context);
         return NULL;
+    }
     Py_DECREF(temp);
+    manager->old_context = context;
 
-    Py_INCREF((PyObject*)(((CTXT_Manager_Object*)self)->new_context));
-    return (PyObject*)(((CTXT_Manager_Object*)self)->new_context);
+    Py_INCREF((PyObject*)(manager->new_context));
+    return (PyObject*)(manager->new_context);
 }
 
 static PyObject *
-GMPy_CTXT_Manager_Exit(PyObject *self, PyObject *args)
+GMPy_CTXT_Manager_Exit(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
+    CTXT_Manager_Object *manager = (CTXT_Manager_Object*)self;
+    CTXT_Object *context = manager->old_context;
     PyObject *temp;
 
-    temp = GMPy_CTXT_Set(NULL, (PyObject*)((CTXT_Manager_Object*)self)->old_context);
+    if (!context)
+        Py_RETURN_NONE;
+
+    manager->old_context = NULL;
+    temp = GMPy_CTXT_Set(NULL, (PyObject*)context);
+    Py_DECREF((PyObject*)context);
     if (!temp)
         return NULL;
     Py_DECREF(temp);
 
     Py_RETURN_NONE;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_CTXT_Manager_Exit)
 
 static PyObject *
 GMPy_CTXT_Enter(PyObject *self, PyObject *args)
@@ -838,9 +1060,14 @@ GMPy_CTXT_Enter(PyObject *self, PyObject *args)
     PyObject *temp;
     PyObject *result;
 
-    result = GMPy_CTXT_Copy(self, NULL);
-    if (!result)
+    /* A frozen context is entered as is. */
+    if (((CTXT_Object*)self)->frozen) {
+        Py_INCREF(self);
+        result = self;
+    }
+    else if (!(result = GMPy_CTXT_Copy(self, NULL))) {
         return NULL;
+    }
 
     temp = GMPy_CTXT_Set(NULL, result);
     if (!temp)
@@ -851,7 +1078,7 @@ GMPy_CTXT_Enter(PyObject *self, PyObject *args)
 }
 
 static PyObject *
-GMPy_CTXT_Exit(PyObject *self, PyObject *args)
+GMPy_CTXT_Exit(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     PyObject *temp;
 
@@ -862,6 +1089,7 @@ GMPy_CTXT_Exit(PyObject *self, PyObject *args)
 
     Py_RETURN_NONE;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_CTXT_Exit)
 
 PyDoc_STRVAR(GMPy_doc_context_clear_flags,
 "clear_flags()\n\n"
@@ -870,15 +1098,26 @@ PyDoc_STRVAR(GMPy_doc_context_clear_flags,
 static PyObject *
 GMPy_CTXT_Clear_Flags(PyObject *self, PyObject *args)
 {
-    ((CTXT_Object*)self)->ctx.underflow = 0;
-    ((CTXT_Object*)self)->ctx.overflow = 0;
-    ((CTXT_Object*)self)->ctx.inexact = 0;
-    ((CTXT_Object*)self)->ctx.invalid = 0;
-    ((CTXT_Object*)self)->ctx.erange = 0;
-    ((CTXT_Object*)self)->ctx.divzero = 0;
+    gmpy_context *flags = GMPY_FLAGS((CTXT_Object*)self);
+
+    flags->underflow = 0;
+    flags->overflow = 0;
+    flags->inexact = 0;
+    flags->invalid = 0;
+    flags->erange = 0;
+    flags->divzero = 0;
     Py_RETURN_NONE;
 }
 
+/* The settings of a frozen context can not be changed. */
+
+#define CHECK_NOT_FROZEN(self) \
+    if (self->frozen) { \
+        PyErr_SetString(PyExc_AttributeError, \
+                        "a frozen context can not be changed"); \
+        return -1; \
+    }
+
 /* Define the get/set functions. */
 
 #define GETSET_BOOLEAN(NAME) \
@@ -890,6 +1129,7 @@ GMPy_CTXT_Get_##NAME(CTXT_Object *self, void *closure) \
 static int \
 GMPy_CTXT_Set_##NAME(CTXT_Object *self, PyObject *value, void *closure) \
 { \
+    CHECK_NOT_FROZEN(self); \
     if (!(PyBool_Check(value))) { \
         TYPE_ERROR(#NAME " must be True or False"); \
         return -1; \
@@ -911,6 +1151,7 @@ GMPy_CTXT_Get_##NAME(CTXT_Object *self, void *closure) \
 static int \
 GMPy_CTXT_Set_##NAME(CTXT_Object *self, PyObject *value, void *closure) \
 { \
+    CHECK_NOT_FROZEN(self); \
     if (!(PyBool_Check(value))) { \
         TYPE_ERROR(#NAME " must be True or False"); \
         return -1; \
@@ -922,13 +1163,34 @@ GMPy_CTXT_Set_##NAME(CTXT_Object *self, PyObject *value, void *closure) \
     return 0; \
 }
 
+/* Define the get/set functions for an exception flag. The flags of a
+ * frozen context are those of the current thread.
+ */
+
+#define GETSET_FLAG(NAME) \
+static PyObject * \
+GMPy_CTXT_Get_##NAME(CTXT_Object *self, void *closure) \
+{ \
+    return PyBool_FromLong(GMPY_FLAGS(self)->NAME); \
+}; \
+static int \
+GMPy_CTXT_Set_##NAME(CTXT_Object *self, PyObject *value, void *closure) \
+{ \
+    if (!(PyBool_Check(value))) { \
+        TYPE_ERROR(#NAME " must be True or False"); \
+        return -1; \
+    } \
+    GMPY_FLAGS(self)->NAME = (value == Py_True) ? 1 : 0; \
+    return 0; \
+}
+
 GETSET_BOOLEAN(subnormalize);
-GETSET_BOOLEAN(underflow);
-GETSET_BOOLEAN(overflow);
-GETSET_BOOLEAN(inexact);
-GETSET_BOOLEAN(invalid);
-GETSET_BOOLEAN(erange);
-GETSET_BOOLEAN(divzero);
+GETSET_FLAG(underflow);
+GETSET_FLAG(overflow);
+GETSET_FLAG(inexact);
+GETSET_FLAG(invalid);
+GETSET_FLAG(erange);
+GETSET_FLAG(divzero);
 GETSET_BOOLEAN_BIT(trap_underflow, TRAP_UNDERFLOW);
 GETSET_BOOLEAN_BIT(trap_overflow, TRAP_OVERFLOW);
 GETSET_BOOLEAN_BIT(trap_inexact, TRAP_INEXACT);
@@ -951,6 +1213,8 @@ GMPy_CTXT_Set_precision(CTXT_Object *self, PyObject *value, void *closure)
 {
     Py_ssize_t temp;
 
+    CHECK_NOT_FROZEN(self);
+
     if (!(PyIntOrLong_Check(value))) {
         TYPE_ERROR("precision must be Python integer");
         return -1;
@@ -978,6 +1242,8 @@ GMPy_CTXT_Set_real_prec(CTXT_Object *self, PyObject *value, void *closure)
 {
     Py_ssize_t temp;
 
+    CHECK_NOT_FROZEN(self);
+
     if (!(PyIntOrLong_Check(value))) {
         TYPE_ERROR("real_prec must be Python integer");
         return -1;
@@ -1005,6 +1271,8 @@ GMPy_CTXT_Set_imag_prec(CTXT_Object *self, PyObject *value, void *closure)
 {
     Py_ssize_t temp;
 
+    CHECK_NOT_FROZEN(self);
+
     if (!(PyIntOrLong_Check(value))) {
         TYPE_ERROR("imag_prec must be Python integer");
         return -1;
@@ -1032,6 +1300,8 @@ GMPy_CTXT_Set_guard_bits(CTXT_Object *self, PyObject *value, void *closure)
 {
     Py_ssize_t temp;
 
+    CHECK_NOT_FROZEN(self);
+
     if (!(PyIntOrLong_Check(value))) {
         TYPE_ERROR("guard_bits must be Python integer");
         return -1;
@@ -1059,6 +1329,8 @@ GMPy_CTXT_Set_round(CTXT_Object *self, PyObject *value, void *closure)
 {
     long temp;
 
+    CHECK_NOT_FROZEN(self);
+
     if (!(PyIntOrLong_Check(value))) {
         TYPE_ERROR("round mode must be Python integer");
         return -1;
@@ -1101,6 +1373,8 @@ GMPy_CTXT_Set_real_round(CTXT_Object *self, PyObject *value, void *closure)
 {
     long temp;
 
+    CHECK_NOT_FROZEN(self);
+
     if (!(PyIntOrLong_Check(value))) {
         TYPE_ERROR("round mode must be Python integer");
         return -1;
@@ -1132,6 +1406,8 @@ GMPy_CTXT_Set_imag_round(CTXT_Object *self, PyObject *value, void *closure)
 {
     long temp;
 
+    CHECK_NOT_FROZEN(self);
+
     if (!(PyIntOrLong_Check(value))) {
         TYPE_ERROR("round mode must be Python integer");
         return -1;
@@ -1163,6 +1439,8 @@ GMPy_CTXT_Set_emin(CTXT_Object *self, PyObject *value, void *closure)
 {
     long exp;
 
+    CHECK_NOT_FROZEN(self);
+
     if (!(PyIntOrLong_Check(value))) {
         TYPE_ERROR("emin must be Python integer");
         return -1;
@@ -1191,6 +1469,8 @@ GMPy_CTXT_Set_emax(CTXT_Object *self, PyObject *value, void *closure)
 {
     long exp;
 
+    CHECK_NOT_FROZEN(self);
+
     if (!(PyIntOrLong_Check(value))) {
         TYPE_ERROR("emax must be Python integer");
         return -1;
@@ -1208,6 +1488,108 @@ GMPy_CTXT_Set_emax(CTXT_Object *self, PyObject *value, void *closure)
     return 0;
 }
 
+static PyObject *
+GMPy_CTXT_Get_deadline(CTXT_Object *self, void *closure)
+{
+    if (self->ctx.deadline > 0.0)
+        return PyFloat_FromDouble(self->ctx.deadline);
+    Py_RETURN_NONE;
+}
+
+static int
+GMPy_CTXT_Set_deadline(CTXT_Object *self, PyObject *value, void *closure)
+{
+    double deadline;
+
+    CHECK_NOT_FROZEN(self);
+
+    if (value == NULL || value == Py_None) {
+        self->ctx.deadline = 0.0;
+        return 0;
+    }
+    if (!PyFloat_Check(value) && !PyIntOrLong_Check(value)) {
+        TYPE_ERROR("deadline must be a number or None");
+        return -1;
+    }
+    deadline = PyFloat_AsDouble(value);
+    if (deadline == -1.0 && PyErr_Occurred())
+        return -1;
+    if (!(deadline > 0.0)) {
+        VALUE_ERROR("deadline must be greater than 0");
+        return -1;
+    }
+    self->ctx.deadline = deadline;
+    return 0;
+}
+
+static PyObject *
+GMPy_CTXT_Get_progress(CTXT_Object *self, void *closure)
+{
+    PyObject *result = self->progress ? self->progress : Py_None;
+
+    Py_INCREF(result);
+    return result;
+}
+
+static int
+GMPy_CTXT_Set_progress(CTXT_Object *self, PyObject *value, void *closure)
+{
+    PyObject *old = self->progress;
+
+    CHECK_NOT_FROZEN(self);
+
+    if (value == Py_None)
+        value = NULL;
+    if (value && !PyCallable_Check(value)) {
+        TYPE_ERROR("progress must be callable or None");
+        return -1;
+    }
+    Py_XINCREF(value);
+    self->progress = value;
+    Py_XDECREF(old);
+    return 0;
+}
+
+static PyObject *
+GMPy_CTXT_Get_max_limb_bytes(CTXT_Object *self, void *closure)
+{
+    if (self->ctx.max_limb_bytes)
+        return PyIntOrLong_FromSize_t(self->ctx.max_limb_bytes);
+    Py_RETURN_NONE;
+}
+
+static int
+GMPy_CTXT_Set_max_limb_bytes(CTXT_Object *self, PyObject *value, void *closure)
+{
+    Py_ssize_t bytes;
+
+    CHECK_NOT_FROZEN(self);
+
+    if (value == NULL || value == Py_None) {
+        self->ctx.max_limb_bytes = 0;
+        return 0;
+    }
+    if (!PyIntOrLong_Check(value)) {
+        TYPE_ERROR("max_limb_bytes must be an integer or None");
+        return -1;
+    }
+    bytes = PyIntOrLong_AsSsize_t(value);
+    if (bytes == -1 && PyErr_Occurred())
+        return -1;
+    if (bytes <= 0) {
+        VALUE_ERROR("max_limb_bytes must be greater than 0");
+        return -1;
+    }
+    self->ctx.max_limb_bytes = (size_t)bytes;
+    return 0;
+}
+
+static PyObject *
+GMPy_CTXT_Get_frozen(CTXT_Object *self, void *closure)
+{
+    return PyBool_FromLong(self->frozen != 0);
+}
+
 #define ADD_GETSET(NAME) \
     {#NAME, \
         (getter)GMPy_CTXT_Get_##NAME, \
@@ -1240,6 +1622,10 @@ static PyGetSetDef GMPyContext_getseters[] = {
     ADD_GETSET(guard_bits),
     ADD_GETSET(convert_exact),
     ADD_GETSET(mpfr_divmod_exact),
+    ADD_GETSET(deadline),
+    ADD_GETSET(progress),
+    ADD_GETSET(max_limb_bytes),
+    {"frozen", (getter)GMPy_CTXT_Get_frozen, NULL, NULL, NULL},
     {NULL}
 };
 
@@ -1248,14 +1634,14 @@ static PyMethodDef GMPyContext_methods[] =
     { "abs", GMPy_Context_Abs, METH_O, GMPy_doc_context_abs },
     { "acos", GMPy_Context_Acos, METH_O, GMPy_doc_context_acos },
     { "acosh", GMPy_Context_Acosh, METH_O, GMPy_doc_context_acosh },
-    { "add", GMPy_Context_Add, METH_VARARGS, GMPy_doc_context_add },
-    { "agm", GMPy_Context_AGM, METH_VARARGS, GMPy_doc_context_agm },
+    { "add", GMPY_FASTCALL(GMPy_Context_Add), GMPY_METH_FASTCALL, GMPy_doc_context_add },
+    { "agm", GMPY_FASTCALL(GMPy_Context_AGM), GMPY_METH_FASTCALL, GMPy_doc_context_agm },
     { "ai", GMPy_Context_Ai, METH_O, GMPy_doc_context_ai },
     { "asin", GMPy_Context_Asin, METH_O, GMPy_doc_context_asin },
     { "asinh", GMPy_Context_Asinh, METH_O, GMPy_doc_context_asinh },
     { "atan", GMPy_Context_Atan, METH_O, GMPy_doc_context_atan },
     { "atanh", GMPy_Context_Atanh, METH_O, GMPy_doc_context_atanh },
-    { "atan2", GMPy_Context_Atan2, METH_VARARGS, GMPy_doc_context_atan2 },
+    { "atan2", GMPY_FASTCALL(GMPy_Context_Atan2), GMPY_METH_FASTCALL, GMPy_doc_context_atan2 },
     { "clear_flags", GMPy_CTXT_Clear_Flags, METH_NOARGS, GMPy_doc_context_clear_flags },
     { "cbrt", GMPy_Context_Cbrt, METH_O, GMPy_doc_context_cbrt },
     { "ceil", GMPy_Context_Ceil, METH_O, GMPy_doc_context_ceil },
@@ -1272,10 +1658,12 @@ static PyMethodDef GMPyContext_methods[] =
     { "csc", GMPy_Context_Csc, METH_O, GMPy_doc_context_csc },
     { "csch", GMPy_Context_Csch, METH_O, GMPy_doc_context_csch },
     { "degrees", GMPy_Context_Degrees, METH_O, GMPy_doc_context_degrees },
+    { "det", GMPy_Context_Det, METH_O, GMPy_doc_context_det },
     { "digamma", GMPy_Context_Digamma, METH_O, GMPy_doc_context_digamma },
-    { "div", GMPy_Context_TrueDiv, METH_VARARGS, GMPy_doc_context_truediv },
-    { "div_mod", GMPy_Context_DivMod, METH_VARARGS, GMPy_doc_context_divmod },
-    { "div_2exp", GMPy_Context_Div_2exp, METH_VARARGS, GMPy_doc_context_div_2exp },
+    { "div", GMPY_FASTCALL(GMPy_Context_TrueDiv), GMPY_METH_FASTCALL, GMPy_doc_context_truediv },
+    { "div_mod", GMPY_FASTCALL(GMPy_Context_DivMod), GMPY_METH_FASTCALL, GMPy_doc_context_divmod },
+    { "div_2exp", GMPY_FASTCALL(GMPy_Context_Div_2exp), GMPY_METH_FASTCALL, GMPy_doc_context_div_2exp },
+    { "dot", GMPY_FASTCALL(GMPy_Context_Dot), GMPY_METH_FASTCALL, GMPy_doc_context_dot },
     { "eint", GMPy_Context_Eint, METH_O, GMPy_doc_context_eint },
     { "erf", GMPy_Context_Erf, METH_O, GMPy_doc_context_erf },
     { "erfc", GMPy_Context_Erfc, METH_O, GMPy_doc_context_erfc },
@@ -1283,17 +1671,20 @@ static PyMethodDef GMPyContext_methods[] =
     { "expm1", GMPy_Context_Expm1, METH_O, GMPy_doc_context_expm1 },
     { "exp10", GMPy_Context_Exp10, METH_O, GMPy_doc_context_exp10 },
     { "exp2", GMPy_Context_Exp2, METH_O, GMPy_doc_context_exp2 },
+    { "fft", GMPy_Context_FFT, METH_O, GMPy_doc_context_fft },
     { "floor", GMPy_Context_Floor, METH_O, GMPy_doc_context_floor },
-    { "floor_div", GMPy_Context_FloorDiv, METH_VARARGS, GMPy_doc_context_floordiv },
-    { "fma", GMPy_Context_FMA, METH_VARARGS, GMPy_doc_context_fma },
-    { "fmod", GMPy_Context_Fmod, METH_VARARGS, GMPy_doc_context_fmod },
-    { "fms", GMPy_Context_FMS, METH_VARARGS, GMPy_doc_context_fms },
+    { "floor_div", GMPY_FASTCALL(GMPy_Context_FloorDiv), GMPY_METH_FASTCALL, GMPy_doc_context_floordiv },
+    { "fma", GMPY_FASTCALL(GMPy_Context_FMA), GMPY_METH_FASTCALL, GMPy_doc_context_fma },
+    { "fmod", GMPY_FASTCALL(GMPy_Context_Fmod), GMPY_METH_FASTCALL, GMPy_doc_context_fmod },
+    { "fms", GMPY_FASTCALL(GMPy_Context_FMS), GMPY_METH_FASTCALL, GMPy_doc_context_fms },
     { "factorial", GMPy_Context_Factorial, METH_O, GMPy_doc_context_factorial },
     { "frac", GMPy_Context_Frac, METH_O, GMPy_doc_context_frac },
+    { "freeze", GMPy_CTXT_Freeze, METH_NOARGS, GMPy_doc_context_freeze },
     { "frexp", GMPy_Context_Frexp, METH_O, GMPy_doc_context_frexp },
-    { "fsum", GMPy_Context_Fsum, METH_O, GMPy_doc_context_fsum },
+    { "fsum", (PyCFunction)GMPy_Context_Fsum, METH_VARARGS | METH_KEYWORDS, GMPy_doc_context_fsum },
     { "gamma", GMPy_Context_Gamma, METH_O, GMPy_doc_context_gamma },
-    { "hypot", GMPy_Context_Hypot, METH_VARARGS, GMPy_doc_context_hypot },
+    { "hypot", GMPY_FASTCALL(GMPy_Context_Hypot), GMPY_METH_FASTCALL, GMPy_doc_context_hypot },
+    { "ifft", GMPy_Context_IFFT, METH_O, GMPy_doc_context_ifft },
     { "is_finite", GMPy_Context_Is_Finite, METH_O, GMPy_doc_context_is_finite },
     { "is_infinite", GMPy_Context_Is_Infinite, METH_O, GMPy_doc_context_is_infinite },
     { "is_integere", GMPy_Context_Is_Integer, METH_O, GMPy_doc_context_is_integer },
@@ -1301,7 +1692,7 @@ static PyMethodDef GMPyContext_methods[] =
     { "is_regular", GMPy_Context_Is_Regular, METH_O, GMPy_doc_context_is_regular },
     { "is_signed", GMPy_Context_Is_Signed, METH_O, GMPy_doc_context_is_signed },
     { "is_zero", GMPy_Context_Is_Zero, METH_O, GMPy_doc_context_is_zero },
-    { "jn", GMPy_Context_Jn, METH_VARARGS, GMPy_doc_context_jn },
+    { "jn", GMPY_FASTCALL(GMPy_Context_Jn), GMPY_METH_FASTCALL, GMPy_doc_context_jn },
     { "j0", GMPy_Context_J0, METH_O, GMPy_doc_context_j0 },
     { "j1", GMPy_Context_J1, METH_O, GMPy_doc_context_j1 },
     { "li2", GMPy_Context_Li2, METH_O, GMPy_doc_context_li2 },
@@ -1311,56 +1702,70 @@ static PyMethodDef GMPyContext_methods[] =
     { "log10", GMPy_Context_Log10, METH_O, GMPy_doc_context_log10 },
     { "log1p", GMPy_Context_Log1p, METH_O, GMPy_doc_context_log1p },
     { "log2", GMPy_Context_Log2, METH_O, GMPy_doc_context_log2 },
-    { "maxnum", GMPy_Context_Maxnum, METH_VARARGS, GMPy_doc_context_maxnum },
+    { "map", GMPY_FASTCALL(GMPy_Context_Map), GMPY_METH_FASTCALL, GMPy_doc_context_map },
+    { "matmul", GMPY_FASTCALL(GMPy_Context_MatMul), GMPY_METH_FASTCALL, GMPy_doc_context_matmul },
+    { "maxnum", GMPY_FASTCALL(GMPy_Context_Maxnum), GMPY_METH_FASTCALL, GMPy_doc_context_maxnum },
     { "mpc", (PyCFunction)GMPy_MPC_Factory, METH_VARARGS | METH_KEYWORDS, GMPy_doc_mpc_factory },
-    { "mpfr", (PyCFunction)GMPy_MPFR_Factory, METH_VARARGS | METH_KEYWORDS, GMPy_doc_mpfr_factory },
-    { "minnum", GMPy_Context_Minnum, METH_VARARGS, GMPy_doc_context_minnum },
-    { "minus", GMPy_Context_Minus, METH_VARARGS, GMPy_doc_context_minus },
-    { "mod", GMPy_Context_Mod, METH_VARARGS, GMPy_doc_context_mod },
+    { "mpfr", GMPY_FASTCALL_KEYWORDS(GMPy_MPFR_Factory), GMPY_METH_FASTCALL_KEYWORDS, GMPy_doc_mpfr_factory },
+    { "minnum", GMPY_FASTCALL(GMPy_Context_Minnum), GMPY_METH_FASTCALL, GMPy_doc_context_minnum },
+    { "minus", GMPY_FASTCALL(GMPy_Context_Minus), GMPY_METH_FASTCALL, GMPy_doc_context_minus },
+    { "mod", GMPY_FASTCALL(GMPy_Context_Mod), GMPY_METH_FASTCALL, GMPy_doc_context_mod },
     { "modf", GMPy_Context_Modf, METH_O, GMPy_doc_context_modf },
-    { "mul", GMPy_Context_Mul, METH_VARARGS, GMPy_doc_context_mul },
-    { "mul_2exp", GMPy_Context_Mul_2exp, METH_VARARGS, GMPy_doc_context_mul_2exp },
+    { "mul", GMPY_FASTCALL(GMPy_Context_Mul), GMPY_METH_FASTCALL, GMPy_doc_context_mul },
+    { "mul_2exp", GMPY_FASTCALL(GMPy_Context_Mul_2exp), GMPY_METH_FASTCALL, GMPy_doc_context_mul_2exp },
     { "next_above", GMPy_Context_NextAbove, METH_O, GMPy_doc_context_next_above },
     { "next_below", GMPy_Context_NextBelow, METH_O, GMPy_doc_context_next_below },
-    { "next_toward", GMPy_Context_NextToward, METH_VARARGS, GMPy_doc_context_next_toward },
+    { "next_toward", GMPY_FASTCALL(GMPy_Context_NextToward), GMPY_METH_FASTCALL, GMPy_doc_context_next_toward },
     { "norm", GMPy_Context_Norm, METH_O, GMPy_doc_context_norm },
+    { "norm2", GMPy_Context_Norm2, METH_O, GMPy_doc_context_norm2 },
     { "phase", GMPy_Context_Phase, METH_O, GMPy_doc_context_phase },
-    { "plus", GMPy_Context_Plus, METH_VARARGS, GMPy_doc_context_plus },
+    { "plus", GMPY_FASTCALL(GMPy_Context_Plus), GMPY_METH_FASTCALL, GMPy_doc_context_plus },
     { "polar", GMPy_Context_Polar, METH_O, GMPy_doc_context_polar },
+    { "polyval", GMPY_FASTCALL(GMPy_Context_Polyval), GMPY_METH_FASTCALL, GMPy_doc_context_polyval },
+    { "polyval_many", GMPY_FASTCALL(GMPy_Context_PolyvalMany), GMPY_METH_FASTCALL, GMPy_doc_context_polyval_many },
     { "proj", GMPy_Context_Proj, METH_O, GMPy_doc_context_proj },
-    { "pow", GMPy_Context_Pow, METH_VARARGS, GMPy_doc_context_pow },
+    { "pow", GMPY_FASTCALL(GMPy_Context_Pow), GMPY_METH_FASTCALL, GMPy_doc_context_pow },
+    { "prod", (PyCFunction)GMPy_Context_Prod, METH_VARARGS | METH_KEYWORDS, GMPy_doc_context_prod },
     { "radians", GMPy_Context_Radians, METH_O, GMPy_doc_context_radians },
-    { "rect", GMPy_Context_Rect, METH_VARARGS, GMPy_doc_context_rect },
+    { "rect", GMPY_FASTCALL(GMPy_Context_Rect), GMPY_METH_FASTCALL, GMPy_doc_context_rect },
     { "rec_sqrt", GMPy_Context_RecSqrt, METH_O, GMPy_doc_context_rec_sqrt },
-    { "reldiff", GMPy_Context_RelDiff, METH_VARARGS, GMPy_doc_context_reldiff },
-    { "remainder", GMPy_Context_Remainder, METH_VARARGS, GMPy_doc_context_remainder },
-    { "remquo", GMPy_Context_RemQuo, METH_VARARGS, GMPy_doc_context_remquo },
+    { "reldiff", GMPY_FASTCALL(GMPy_Context_RelDiff), GMPY_METH_FASTCALL, GMPy_doc_context_reldiff },
+    { "remainder", GMPY_FASTCALL(GMPy_Context_Remainder), GMPY_METH_FASTCALL, GMPy_doc_context_remainder },
+    { "remquo", GMPY_FASTCALL(GMPy_Context_RemQuo), GMPY_METH_FASTCALL, GMPy_doc_context_remquo },
+    { "rfft", GMPy_Context_RFFT, METH_O, GMPy_doc_context_rfft },
     { "rint", GMPy_Context_Rint, METH_O, GMPy_doc_context_rint },
     { "rint_ceil", GMPy_Context_RintCeil, METH_O, GMPy_doc_context_rint_ceil },
     { "rint_floor", GMPy_Context_RintFloor, METH_O, GMPy_doc_context_rint_floor },
     { "rint_round", GMPy_Context_RintRound, METH_O, GMPy_doc_context_rint_round },
     { "rint_trunc", GMPy_Context_RintTrunc, METH_O, GMPy_doc_context_rint_trunc },
-    { "root", GMPy_Context_Root, METH_VARARGS, GMPy_doc_context_root },
-    { "round2", GMPy_Context_Round2, METH_VARARGS, GMPy_doc_context_round2 },
+    { "root", GMPY_FASTCALL(GMPy_Context_Root), GMPY_METH_FASTCALL, GMPy_doc_context_root },
+    { "round2", GMPY_FASTCALL(GMPy_Context_Round2), GMPY_METH_FASTCALL, GMPy_doc_context_round2 },
     { "round_away", GMPy_Context_RoundAway, METH_O, GMPy_doc_context_round_away },
     { "sec", GMPy_Context_Sec, METH_O, GMPy_doc_context_sec },
     { "sech", GMPy_Context_Sech, METH_O, GMPy_doc_context_sech },
     { "sin", GMPy_Context_Sin, METH_O, GMPy_doc_context_sin },
     { "sin_cos", GMPy_Context_Sin_Cos, METH_O, GMPy_doc_context_sin_cos },
+    { "sin_cos_many", GMPy_Context_Sin_Cos_Many, METH_O, GMPy_doc_context_sin_cos_many },
     { "sinh", GMPy_Context_Sinh, METH_O, GMPy_doc_context_sinh },
     { "sinh_cosh", GMPy_Context_Sinh_Cosh, METH_O, GMPy_doc_context_sinh_cosh },
+    { "sinh_cosh_many", GMPy_Context_Sinh_Cosh_Many, METH_O, GMPy_doc_context_sinh_cosh_many },
+    { "solve", GMPY_FASTCALL(GMPy_Context_Solve), GMPY_METH_FASTCALL, GMPy_doc_context_solve },
     { "sqrt", GMPy_Context_Sqrt, METH_O, GMPy_doc_context_sqrt },
     { "square", GMPy_Context_Square, METH_O, GMPy_doc_context_square },
-    { "sub", GMPy_Context_Sub, METH_VARARGS, GMPy_doc_context_sub },
+    { "sub", GMPY_FASTCALL(GMPy_Context_Sub), GMPY_METH_FASTCALL, GMPy_doc_context_sub },
     { "tan", GMPy_Context_Tan, METH_O, GMPy_doc_context_tan },
     { "tanh", GMPy_Context_Tanh, METH_O, GMPy_doc_context_tanh },
     { "trunc", GMPy_Context_Trunc, METH_O, GMPy_doc_context_trunc },
-    { "yn", GMPy_Context_Yn, METH_VARARGS, GMPy_doc_context_yn },
+    { "vadd", GMPy_Context_VAdd, METH_VARARGS, GMPy_doc_context_vadd },
+    { "vdiv", GMPy_Context_VDiv, METH_VARARGS, GMPy_doc_context_vdiv },
+    { "vmul", GMPy_Context_VMul, METH_VARARGS, GMPy_doc_context_vmul },
+    { "vsub", GMPy_Context_VSub, METH_VARARGS, GMPy_doc_context_vsub },
+    { "yn", GMPY_FASTCALL(GMPy_Context_Yn), GMPY_METH_FASTCALL, GMPy_doc_context_yn },
     { "y0", GMPy_Context_Y0, METH_O, GMPy_doc_context_y0 },
     { "y1", GMPy_Context_Y1, METH_O, GMPy_doc_context_y1 },
     { "zeta", GMPy_Context_Zeta, METH_O, GMPy_doc_context_zeta },
     { "__enter__", GMPy_CTXT_Enter, METH_NOARGS, NULL },
-    { "__exit__", GMPy_CTXT_Exit, METH_VARARGS, NULL },
+    { "__exit__", GMPY_FASTCALL(GMPy_CTXT_Exit), GMPY_METH_FASTCALL, NULL },
     { NULL, NULL, 1 }
 };
 
@@ -1406,7 +1811,7 @@ static PyTypeObject CTXT_Type =
 static PyMethodDef GMPyContextManager_methods[] =
 {
     { "__enter__", GMPy_CTXT_Manager_Enter, METH_NOARGS, NULL },
-    { "__exit__", GMPy_CTXT_Manager_Exit, METH_VARARGS, NULL },
+    { "__exit__", GMPY_FASTCALL(GMPy_CTXT_Manager_Exit), GMPY_METH_FASTCALL, NULL },
     { NULL, NULL, 1 }
 };
 
@@ -64,22 +64,53 @@ typedef struct {
                              /*   must be less than MAX_GUARD_BITS     */
     int convert_exact;       /* if 1, str -> mpfr via mpq */
     int mpfr_divmod_exact;   /* if 1, divmod(mpfr, mpfr) uses mpq */
+    double deadline;         /* time.monotonic() value, 0 if none */
+    size_t max_limb_bytes;   /* limit for the limbs in use, 0 if none */
 } gmpy_context;
 
-typedef struct {
+/* Python 3.7 and later keep the current context in a contextvars.ContextVar
+ * so each thread, and each asyncio task, has its own current context.
+ * Older versions use the thread state dictionary.
+ */
+#if !defined(WITHOUT_THREADS) && PY_VERSION_HEX >= 0x030700A1
+#  define GMPY_CONTEXTVAR
+#endif
+
+typedef struct gmpy_ctxt_object {
     PyObject_HEAD
     gmpy_context ctx;
+    PyObject *progress;      /* progress callback, or NULL */
+    uint64_t frozen;         /* id of a frozen context, 0 if mutable */
 #ifndef WITHOUT_THREADS
     PyThreadState *tstate;
 #endif
 } CTXT_Object;
 
+/* A frozen context can not be changed, so it can be shared by any number
+ * of threads without copying it. The exception flags are the only state
+ * that arithmetic changes; for a frozen context each thread keeps them in
+ * a small table indexed by the id of the context. GMPY_FLAGS() returns the
+ * flags to update for a context. Only the six flag fields of the result
+ * are used. A thread that raises flags under more than FROZEN_FLAGS_SIZE
+ * frozen contexts forgets the flags of the oldest ones.
+ */
+
+#define FROZEN_FLAGS_SIZE 8
+
+typedef struct {
+    uint64_t id;             /* frozen context, 0 if the entry is unused */
+    gmpy_context ctx;        /* flags raised under that context */
+} gmpy_frozen_flags;
+
+#define GMPY_FLAGS(c) ((c)->frozen ? GMPy_Frozen_Flags(c) : &(c)->ctx)
+
 typedef struct {
     PyObject_HEAD
     CTXT_Object *new_context; /* Context that will be returned when
                                * __enter__ is called. */
     CTXT_Object *old_context; /* Context that will restored when
-                               * __exit__ is called. */
+                               * __exit__ is called; NULL unless the
+                               * manager is in effect. */
 } CTXT_Manager_Object;
 
 
@@ -120,6 +151,9 @@ static PyTypeObject CTXT_Manager_Type;
 #define GET_REAL_PREC(c) ((c->ctx.real_prec==GMPY_DEFAULT)?GET_MPFR_PREC(c):c->ctx.real_prec)
 #define GET_IMAG_PREC(c) ((c->ctx.imag_prec==GMPY_DEFAULT)?GET_REAL_PREC(c):c->ctx.imag_prec)
 #define GET_MPFR_ROUND(c) (c->ctx.mpfr_round)
+/* The rounding mode r' for which round(-x, r') == -round(x, r). */
+#define MPFR_REVERSE_ROUND(r) \
+    ((r) == MPFR_RNDU ? MPFR_RNDD : ((r) == MPFR_RNDD ? MPFR_RNDU : (r)))
 #define GET_REAL_ROUND(c) ((c->ctx.real_round==GMPY_DEFAULT)?GET_MPFR_ROUND(c):c->ctx.real_round)
 #define GET_IMAG_ROUND(c) ((c->ctx.imag_round==GMPY_DEFAULT)?GET_REAL_ROUND(c):c->ctx.imag_round)
 #define GET_MPC_ROUND(c) (MPC_RND(GET_REAL_ROUND(c), GET_IMAG_ROUND(c)))
@@ -135,7 +169,7 @@ static PyObject *    GMPy_CTXT_Manager_New(void);
 static void          GMPy_CTXT_Manager_Dealloc(CTXT_Manager_Object *self);
 static PyObject *    GMPy_CTXT_Manager_Repr_Slot(CTXT_Manager_Object *self);
 static PyObject *    GMPy_CTXT_Manager_Enter(PyObject *self, PyObject *args);
-static PyObject *    GMPy_CTXT_Manager_Exit(PyObject *self, PyObject *args);
+static PyObject *    GMPy_CTXT_Manager_Exit(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 
 static PyObject *    GMPy_CTXT_New(void);
 static void          GMPy_CTXT_Dealloc(CTXT_Object *self);
@@ -146,9 +180,11 @@ static PyObject *    GMPy_CTXT_Context(PyObject *self, PyObject *args, PyObject
 static PyObject *    GMPy_CTXT_Set(PyObject *self, PyObject *other);
 static PyObject *    GMPy_CTXT_Clear_Flags(PyObject *self, PyObject *args);
 static PyObject *    GMPy_CTXT_Copy(PyObject *self, PyObject *other);
+static PyObject *    GMPy_CTXT_Freeze(PyObject *self, PyObject *other);
+static gmpy_context * GMPy_Frozen_Flags(CTXT_Object *context);
 static PyObject *    GMPy_CTXT_ieee(PyObject *self, PyObject *other);
 static PyObject *    GMPy_CTXT_Enter(PyObject *self, PyObject *args);
-static PyObject *    GMPy_CTXT_Exit(PyObject *self, PyObject *args);
+static PyObject *    GMPy_CTXT_Exit(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 
 #ifndef WITHOUT_THREADS
 static CTXT_Object * GMPy_current_context(void);
@@ -47,6 +47,69 @@
  * Miscellaneous helper functions.                                          *
  * ======================================================================== */
 
+static PyTypeObject *gmpy_fraction_type = NULL;
+static PyTypeObject *gmpy_decimal_type = NULL;
+
+#if PY_VERSION_HEX < 0x03030000
+#define GMPY_DECIMAL_NAME "Decimal"
+#else
+#define GMPY_DECIMAL_NAME "decimal.Decimal"
+#endif
+
+/* Classify an object of a type that is not built into Python or gmpy2. A
+ * reference to the Fraction and Decimal types is kept so the cached pointers
+ * can never refer to a different type. */
+
+static int
+GMPy_ObjectType_ByName(PyTypeObject *type)
+{
+    if (!strcmp(type->tp_name, "Fraction")) {
+        if (!gmpy_fraction_type) {
+            Py_INCREF((PyObject*)type);
+            gmpy_fraction_type = type;
+        }
+        return OBJ_TYPE_PyFraction;
+    }
+    if (!strcmp(type->tp_name, GMPY_DECIMAL_NAME)) {
+        if (!gmpy_decimal_type) {
+            Py_INCREF((PyObject*)type);
+            gmpy_decimal_type = type;
+        }
+        return OBJ_TYPE_PyDecimal;
+    }
+    return OBJ_TYPE_UNKNOWN;
+}
+
+/* The tests are ordered by how often the types are seen as arguments. */
+
+static int
+GMPy_ObjectType(PyObject *obj)
+{
+    PyTypeObject *type = Py_TYPE(obj);
+
+    if (type == &MPZ_Type)
+        return OBJ_TYPE_MPZ;
+    if (type == &MPFR_Type)
+        return OBJ_TYPE_MPFR;
+    if (type == &MPC_Type)
+        return OBJ_TYPE_MPC;
+    if (type == &MPQ_Type)
+        return OBJ_TYPE_MPQ;
+    if (type == &XMPZ_Type)
+        return OBJ_TYPE_XMPZ;
+    if (PyIntOrLong_Check(obj))
+        return OBJ_TYPE_PyInteger;
+    if (PyFloat_Check(obj))
+        return OBJ_TYPE_PyFloat;
+    if (PyComplex_Check(obj))
+        return OBJ_TYPE_PyComplex;
+    if (type == gmpy_fraction_type)
+        return OBJ_TYPE_PyFraction;
+    if (type == gmpy_decimal_type)
+        return OBJ_TYPE_PyDecimal;
+    return GMPy_ObjectType_ByName(type);
+}
+
 /* Since macros are used in gmpy2's codebase, these functions are skipped
  * until they are needed for the C API in the future.
  */
@@ -150,7 +213,7 @@ mpz_set_PyStr(mpz_ptr z, PyObject *s, int base)
     }
     
     /* delegate rest to GMP's _set_str function */
-    if (-1 == mpz_set_str(z, cp, base)) {
+    if (-1 == mpz_set_str_radix(z, cp, base)) {
         VALUE_ERROR("invalid digits");
         Py_XDECREF(ascii_str);
         return -1;
@@ -179,45 +242,21 @@ mpz_set_PyStr(mpz_ptr z, PyObject *s, int base)
 static char* _ztag = "mpz(";
 static char* _xztag = "xmpz(";
 
-static PyObject *
-mpz_ascii(mpz_t z, int base, int option, int which)
+/* Write the formatted mpz to p, which must have room for
+ * mpz_sizeinbase(z, base) + 11 characters, and return a pointer to the
+ * trailing NULL byte. The base is not checked.
+ */
+
+static char *
+mpz_ascii_chars(char *p, mpz_t z, int base, int option, int which)
 {
-    PyObject *result;
-    char *buffer, *p;
     int negative = 0;
-    size_t size;
-
-    if (
-        !(
-          (base == 0) ||
-          ((base >= -36) && (base <= -2)) ||
-          ((base >= 2) && (base <= 62))
-         )
-       ) {
-        VALUE_ERROR("base must be in the interval 2 ... 62");
-        return NULL;
-    }
-
-    /* Allocate extra space for:
-     *
-     * minus sign and trailing NULL byte (2)
-     * 'xmpz()' tag                      (6)
-     * '0x' prefix                       (2)
-     *                                  -----
-     *                                   10
-     *
-     * And add one more to be sure...
-     */
-
-    size = mpz_sizeinbase(z, base) + 11;
-    TEMP_ALLOC(buffer, size);
 
     if (mpz_sgn(z) < 0) {
         negative = 1;
         mpz_neg(z, z);
     }
 
-    p = buffer;
     if (option & 1) {
         if (which)
             strcpy(p, _xztag);
@@ -254,17 +293,53 @@ mpz_ascii(mpz_t z, int base, int option, int which)
     }
 
     /* Call GMP. */
-    mpz_get_str(p, base, z);
-    p = buffer + strlen(buffer);
+    mpz_get_str_radix(p, base, z);
+    p += strlen(p);
 
     if (option & 1)
         *(p++) = ')';
-    *(p++) = '\00';
+    *p = '\00';
 
-    result = Py_BuildValue("s", buffer);
     if (negative == 1) {
         mpz_neg(z, z);
     }
+    return p;
+}
+
+static PyObject *
+mpz_ascii(mpz_t z, int base, int option, int which)
+{
+    PyObject *result;
+    char *buffer;
+    size_t size;
+
+    if (
+        !(
+          (base == 0) ||
+          ((base >= -36) && (base <= -2)) ||
+          ((base >= 2) && (base <= 62))
+         )
+       ) {
+        VALUE_ERROR("base must be in the interval 2 ... 62");
+        return NULL;
+    }
+
+    /* Allocate extra space for:
+     *
+     * minus sign and trailing NULL byte (2)
+     * 'xmpz()' tag                      (6)
+     * '0x' prefix                       (2)
+     *                                  -----
+     *                                   10
+     *
+     * And add one more to be sure...
+     */
+
+    size = mpz_sizeinbase(z, base < 0 ? -base : (base ? base : 10)) + 11;
+    TEMP_ALLOC(buffer, size);
+
+    mpz_ascii_chars(buffer, z, base, option, which);
+    result = Py_BuildValue("s", buffer);
     TEMP_FREE(buffer, size);
     return result;
 }
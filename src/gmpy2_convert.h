@@ -32,6 +32,37 @@
 extern "C" {
 #endif
 
+/* GMPy_ObjectType() classifies an object with a single pass over the
+ * supported types. The values are grouped so a range check tells whether an
+ * object is an integer, a rational, a real or a complex number. Dispatchers
+ * that test several categories should classify each operand once and use
+ * the IS_TYPE_XXX() macros.
+ */
+
+#define OBJ_TYPE_UNKNOWN        0
+#define OBJ_TYPE_MPZ            1
+#define OBJ_TYPE_XMPZ           2
+#define OBJ_TYPE_PyInteger      3
+#define OBJ_TYPE_MAX_INTEGER    15
+#define OBJ_TYPE_MPQ            16
+#define OBJ_TYPE_PyFraction     17
+#define OBJ_TYPE_MAX_RATIONAL   31
+#define OBJ_TYPE_MPFR           32
+#define OBJ_TYPE_PyFloat        33
+#define OBJ_TYPE_PyDecimal      34
+#define OBJ_TYPE_MAX_REAL       47
+#define OBJ_TYPE_MPC            48
+#define OBJ_TYPE_PyComplex      49
+#define OBJ_TYPE_MAX_COMPLEX    63
+
+#define IS_TYPE_MPZANY(t)   ((t) == OBJ_TYPE_MPZ || (t) == OBJ_TYPE_XMPZ)
+#define IS_TYPE_INTEGER(t)  ((t) > OBJ_TYPE_UNKNOWN && (t) < OBJ_TYPE_MAX_INTEGER)
+#define IS_TYPE_RATIONAL(t) ((t) > OBJ_TYPE_UNKNOWN && (t) < OBJ_TYPE_MAX_RATIONAL)
+#define IS_TYPE_REAL(t)     ((t) > OBJ_TYPE_UNKNOWN && (t) < OBJ_TYPE_MAX_REAL)
+#define IS_TYPE_COMPLEX(t)  ((t) > OBJ_TYPE_UNKNOWN && (t) < OBJ_TYPE_MAX_COMPLEX)
+
+static int GMPy_ObjectType(PyObject *obj);
+
 /* The following macros classify the numeric types that are supported by
  * gmpy2.
  */
@@ -42,16 +73,16 @@ extern "C" {
 #define IS_INTEGER(x) (MPZ_Check(x) || PyLong_Check(x) || XMPZ_Check(x))
 #endif
 
-#define IS_FRACTION(x) (!strcmp(Py_TYPE(x)->tp_name, "Fraction"))
+/* Fraction and Decimal are recognized by the name of their type. The type is
+ * remembered when the first instance is seen, so the names are only compared
+ * for objects of other types. */
+
+#define IS_FRACTION(x) (GMPy_ObjectType(x) == OBJ_TYPE_PyFraction)
 
 #define IS_RATIONAL_ONLY(x) (MPQ_Check(x) || IS_FRACTION(x))
 #define IS_RATIONAL(x) (IS_INTEGER(x) || IS_RATIONAL_ONLY(x))
 
-#if PY_VERSION_HEX < 0x03030000
-#define IS_DECIMAL(x) (!strcmp(Py_TYPE(x)->tp_name, "Decimal"))
-#else
-#define IS_DECIMAL(x) (!strcmp(Py_TYPE(x)->tp_name, "decimal.Decimal"))
-#endif
+#define IS_DECIMAL(x) (GMPy_ObjectType(x) == OBJ_TYPE_PyDecimal)
 
 #define IS_REAL_ONLY(x) (MPFR_Check(x) || PyFloat_Check(x) || IS_DECIMAL(x))
 #define IS_REAL(x) (IS_RATIONAL(x) || IS_REAL_ONLY(x))
@@ -85,6 +116,7 @@ static int GMPy_isComplex(PyObject *obj);
 
 /* ======== C helper routines ======== */
 static int             mpz_set_PyStr(mpz_ptr z, PyObject *s, int base);
+static char *          mpz_ascii_chars(char *p, mpz_t z, int base, int option, int which);
 static PyObject *      mpz_ascii(mpz_t z, int base, int option, int which);
 
 #ifdef __cplusplus
@@ -40,8 +40,11 @@
  * Conversion between native Python objects and MPZ.                        *
  * ======================================================================== */
 
+GMPY_PROFILE_WRAP(MPZ_Object *, GMPy_MPZ_From_PyIntOrLong, (PyObject *obj, CTXT_Object *context),
+                  (obj, context), gmpy_profile_bits(obj))
+
 static MPZ_Object *
-GMPy_MPZ_From_PyIntOrLong(PyObject *obj, CTXT_Object *context)
+GMPy_MPZ_From_PyIntOrLong_Impl(PyObject *obj, CTXT_Object *context)
 {
     MPZ_Object *result;
 
@@ -54,8 +57,76 @@ GMPy_MPZ_From_PyIntOrLong(PyObject *obj, CTXT_Object *context)
     return result;
 }
 
+/* Conversion of Python ints for mixed arithmetic.
+ *
+ * An operand that is a Python int is converted again every time it is used
+ * with an mpz, which costs as much as a simple operation such as an add.
+ * Each thread remembers the mpz value of the last PYLONG_CACHE_SIZE ints
+ * that were converted. An entry holds a reference to its int so the
+ * identity of the int is a valid key: ints are immutable and a live object
+ * can not share its address with another one. Only exact ints of more than
+ * one digit and at most global.cache_obsize limbs are remembered; the
+ * entries are discarded when the zcache is disabled.
+ *
+ * mpz_inoc_pylong initializes newo with the value of the Python integer obj.
+ * If the value is cached, newo is a read-only view of the cached value (like
+ * mpz_roinit_n, its _mp_alloc is 0) and is only valid until the next call to
+ * mpz_inoc_pylong. newo must not be modified and must be released with
+ * mpz_cloc_pylong.
+ */
+
+static void
+mpz_inoc_pylong(mpz_t newo, PyObject *obj)
+{
+    int i;
+    size_t digits;
+    gmpy_pylong_entry *entry;
+    gmpy_cache *cache;
+
+    if (!PyLong_CheckExact(obj) ||
+        (digits = (size_t)ABS(Py_SIZE(obj))) <= 1 ||
+        digits * PyLong_SHIFT > (size_t)global.cache_obsize * GMP_NUMB_BITS ||
+        global.cache_sizes[GMPY_CACHE_ZCACHE] == 0 ||
+        !(cache = GMPy_current_cache())) {
+        mpz_inoc(newo);
+        mpz_set_PyIntOrLong(newo, obj);
+        return;
+    }
+
+    for (i = 0; i < PYLONG_CACHE_SIZE; ++i) {
+        entry = &(cache->pylong[i]);
+        if (entry->obj == obj)
+            goto found;
+    }
+
+    entry = &(cache->pylong[cache->pylong_next]);
+    cache->pylong_next = (cache->pylong_next + 1) % PYLONG_CACHE_SIZE;
+    if (entry->obj)
+        Py_DECREF(entry->obj);
+    else
+        mpz_init(entry->z);
+    Py_INCREF(obj);
+    entry->obj = obj;
+    mpz_set_PyIntOrLong(entry->z, obj);
+
+  found:
+    newo->_mp_alloc = 0;
+    newo->_mp_size = entry->z->_mp_size;
+    newo->_mp_d = entry->z->_mp_d;
+}
+
+static void
+mpz_cloc_pylong(mpz_t oldo)
+{
+    if (oldo->_mp_alloc != 0)
+        mpz_cloc(oldo);
+}
+
+GMPY_PROFILE_WRAP(MPZ_Object *, GMPy_MPZ_From_PyStr, (PyObject *s, int base, CTXT_Object *context),
+                  (s, base, context), gmpy_profile_bits((PyObject*)result))
+
 static MPZ_Object *
-GMPy_MPZ_From_PyStr(PyObject *s, int base, CTXT_Object *context)
+GMPy_MPZ_From_PyStr_Impl(PyObject *s, int base, CTXT_Object *context)
 {
     MPZ_Object *result;
 
@@ -116,8 +187,11 @@ GMPy_MPZ_Long_Slot(MPZ_Object *self)
  * when a PyLong is specifically needed for Python 2.x.
  */
 
+GMPY_PROFILE_WRAP(PyObject *, GMPy_PyIntOrLong_From_MPZ, (MPZ_Object *obj, CTXT_Object *context),
+                  (obj, context), gmpy_profile_bits((PyObject*)obj))
+
 static PyObject *
-GMPy_PyIntOrLong_From_MPZ(MPZ_Object *obj, CTXT_Object *context)
+GMPy_PyIntOrLong_From_MPZ_Impl(MPZ_Object *obj, CTXT_Object *context)
 {
     assert(CHECK_MPZANY(obj));
 
@@ -161,8 +235,11 @@ GMPy_MPZ_Float_Slot(MPZ_Object *self)
     return GMPy_PyFloat_From_MPZ(self, NULL);
 }
 
+GMPY_PROFILE_WRAP(PyObject *, GMPy_PyStr_From_MPZ, (MPZ_Object *obj, int base, int option, CTXT_Object *context),
+                  (obj, base, option, context), gmpy_profile_bits((PyObject*)obj))
+
 static PyObject *
-GMPy_PyStr_From_MPZ(MPZ_Object *obj, int base, int option, CTXT_Object *context)
+GMPy_PyStr_From_MPZ_Impl(MPZ_Object *obj, int base, int option, CTXT_Object *context)
 {
     assert(CHECK_MPZANY(obj));
 
@@ -218,6 +295,59 @@ GMPy_MPZ_From_Number(PyObject *obj, CTXT_Object *context)
     return result;
 }
 
+/* Convert the items of an iterable to mpz. Returns a new array of
+ * references, and the number of items in *len, or NULL after setting
+ * TypeError with 'msg' if an item is not an integer. The array is released
+ * with GMPy_MPZ_Array_Free.
+ */
+
+static MPZ_Object **
+GMPy_MPZ_Array_From_Iterable(PyObject *obj, Py_ssize_t *len, const char *msg,
+                             CTXT_Object *context)
+{
+    PyObject *seq, **items;
+    MPZ_Object **result;
+    Py_ssize_t i, n;
+
+    if (!(seq = PySequence_Fast(obj, msg)))
+        return NULL;
+
+    n = PySequence_Fast_GET_SIZE(seq);
+    if (!(result = GMPY_MALLOC(sizeof(MPZ_Object*) * (n ? n : 1)))) {
+        Py_DECREF(seq);
+        PyErr_NoMemory();
+        return NULL;
+    }
+
+    items = PySequence_Fast_ITEMS(seq);
+    for (i = 0; i < n; i++) {
+        if (!IS_INTEGER(items[i]) ||
+            !(result[i] = GMPy_MPZ_From_Integer(items[i], context))) {
+            if (!PyErr_Occurred() || PyErr_ExceptionMatches(PyExc_TypeError)) {
+                PyErr_Clear();
+                TYPE_ERROR(msg);
+            }
+            GMPy_MPZ_Array_Free(result, i);
+            Py_DECREF(seq);
+            return NULL;
+        }
+    }
+
+    Py_DECREF(seq);
+    *len = n;
+    return result;
+}
+
+static void
+GMPy_MPZ_Array_Free(MPZ_Object **array, Py_ssize_t len)
+{
+    Py_ssize_t i;
+
+    for (i = 0; i < len; i++)
+        Py_DECREF((PyObject*)array[i]);
+    GMPY_FREE(array);
+}
+
 static MPZ_Object *
 GMPy_MPZ_From_Integer(PyObject *obj, CTXT_Object *context)
 {
@@ -242,13 +372,37 @@ GMPy_MPZ_From_Integer(PyObject *obj, CTXT_Object *context)
 static PyObject *
 GMPy_MPZ_Str_Slot(MPZ_Object *self)
 {
+    PyObject *result;
+    size_t len;
+
+    if (self->str_cache) {
+        Py_INCREF(self->str_cache);
+        return self->str_cache;
+    }
+
     /* base-10, no tag */
-    return GMPy_PyStr_From_MPZ(self, 10, 0, NULL);
+    result = GMPy_PyStr_From_MPZ(self, 10, 0, NULL);
+
+    /* An mpz never changes, so its string can be kept if there is room. */
+    if (result && global.str_cache_limit &&
+        mpz_sizeinbase(self->z, 2) >= STR_CACHE_MIN_BITS) {
+        len = (size_t)PyObject_Length(result);
+        if (global.str_cache_bytes + len <= global.str_cache_limit) {
+            Py_INCREF(result);
+            self->str_cache = result;
+            global.str_cache_bytes += len;
+        }
+    }
+    return result;
 }
 
 static PyObject *
 GMPy_MPZ_Repr_Slot(MPZ_Object *self)
 {
+#ifdef PY3
+    if (self->str_cache)
+        return PyUnicode_FromFormat("mpz(%U)", self->str_cache);
+#endif
     /* base-10, with tag */
     return GMPy_PyStr_From_MPZ(self, 10, 1, NULL);
 }
@@ -462,179 +616,268 @@ GMPy_MPQ_From_PyIntOrLong(PyObject *obj, CTXT_Object *context)
     return result;
 }
 
-static MPQ_Object *
-GMPy_MPQ_From_PyStr(PyObject *s, int base, CTXT_Object *context)
-{
-    MPQ_Object *result;
-    char *cp;
-    char exp_char = 'E';
-    Py_ssize_t len, i;
-    PyObject *ascii_str = NULL;
-    long expt = 0;
-
-    if (!(result = GMPy_MPQ_New(context)))
-        return NULL;
+/* Set z to the integer in cp[0:len]. As with mpz_set_str(), white space is
+ * ignored. If 'point' is not NULL, the first '.' is skipped and the number
+ * of digits that follow it is stored in *point. Returns -1 if the digits
+ * are invalid, or -2 with an exception set if memory is exhausted.
+ *
+ * The string is read in place. Up to a word of digits in bases 2 to 36 is
+ * accumulated in an unsigned long; longer runs are copied without the '.'
+ * and passed to mpz_set_str_radix().
+ */
 
-    if (PyBytes_Check(s)) {
-        len = PyBytes_Size(s);
-        cp = PyBytes_AsString(s);
-    }
-    else if (PyUnicode_Check(s)) {
-        ascii_str = PyUnicode_AsASCIIString(s);
-        if (!ascii_str) {
-            VALUE_ERROR("string contains non-ASCII characters");
-            goto error;
+static int
+mpz_set_chars(mpz_t z, const char *cp, Py_ssize_t len, int base, long *point)
+{
+    const char *p = cp, *end = cp + len;
+    char *buf, *q;
+    unsigned long acc = 0, limit;
+    long frac = -1;
+    int c, d, negative = 0, ndigits = 0, res;
+
+    if (base >= 2 && base <= 36) {
+        limit = (ULONG_MAX - (unsigned long)(base - 1)) / (unsigned long)base;
+        while (p < end && isspace((unsigned char)*p))
+            p++;
+        if (p < end && *p == '-') {
+            negative = 1;
+            p++;
         }
-        len = PyBytes_Size(ascii_str);
-        cp = PyBytes_AsString(ascii_str);
-    }
-    else {
-        TYPE_ERROR("object is not string or Unicode");
-        goto error;
-    }
-
-    /* Don't allow NULL characters */
-    for (i = 0; i < len; i++) {
-        if (cp[i] == '\0') {
-            VALUE_ERROR("string contains NULL characters");
-            goto error;
+        /* Like mpz_set_str(), white space may not follow the sign. */
+        if (p < end && isspace((unsigned char)*p))
+            return -1;
+        for (; p < end; p++) {
+            c = (unsigned char)*p;
+            if (c >= '0' && c <= '9')
+                d = c - '0';
+            else if (c >= 'a' && c <= 'z')
+                d = c - 'a' + 10;
+            else if (c >= 'A' && c <= 'Z')
+                d = c - 'A' + 10;
+            else if (c == '.' && point && frac < 0) {
+                frac = 0;
+                continue;
+            }
+            else if (isspace(c))
+                continue;
+            else
+                return -1;
+            if (d >= base)
+                return -1;
+            if (acc > limit)
+                goto slow;
+            acc = acc * (unsigned long)base + (unsigned long)d;
+            ndigits++;
+            if (frac >= 0)
+                frac++;
         }
+        if (!ndigits)
+            return -1;
+        mpz_set_ui(z, acc);
+        if (negative)
+            mpz_neg(z, z);
+        if (point)
+            *point = frac < 0 ? 0 : frac;
+        return 0;
     }
 
-    {
-        char *whereslash = strchr((char*)cp, '/');
-        char *wheredot = strchr((char*)cp, '.');
-        char *whereexp = strchr((char*)cp, 'E');
-        
-        if (!whereexp) {
-            whereexp = strchr((char*)cp, 'e');
-            exp_char = 'e';
+  slow:
+    if (!(buf = GMPY_MALLOC(len + 1))) {
+        PyErr_NoMemory();
+        return -2;
+    }
+    for (p = cp, q = buf, frac = -1; p < end; p++) {
+        if (*p == '.' && point && frac < 0) {
+            frac = 0;
+            continue;
         }
+        if (frac >= 0 && isdigit((unsigned char)*p))
+            frac++;
+        *q++ = *p;
+    }
+    *q = '\0';
+    res = mpz_set_str_radix(z, buf, base);
+    GMPY_FREE(buf);
+    if (point)
+        *point = frac < 0 ? 0 : frac;
+    return res;
+}
 
-        if (whereslash && wheredot) {
-            VALUE_ERROR("illegal string: both . and / found");
-            goto error;
-        }
+/* Multiply the numerator of q by 10**exp and set the denominator so that q
+ * is canonical, assuming the numerator has been set. For exp < 0 the
+ * factors of 2 and 5 shared by the numerator and 10**-exp are removed
+ * directly instead of computing a gcd.
+ */
 
-        if (wheredot && (base != 10)) {
-            VALUE_ERROR("illegal string: embedded . requires base=10");
-            goto error;
-        }
+static void
+mpq_set_num_pow10(mpq_t q, long exp)
+{
+    unsigned long e, twos, fives;
 
-        /* If base=10, no slash is found, and an exponent symbol is found, then
-         * assume we have decimal number in scientific format.
-         */
-        if (whereexp && !whereslash && (base == 10)) {
-            /* Temporarily shorten the string and continue processing as
-             * normal. We'll deal with the exponent later.
-             */
-            *whereexp = '\0';
-            expt = atol(whereexp+1);
+    if (exp >= 0 || !mpz_sgn(mpq_numref(q))) {
+        if (exp > 0) {
+            mpz_ui_pow_ui(mpq_denref(q), 10, (unsigned long)exp);
+            mpz_mul(mpq_numref(q), mpq_numref(q), mpq_denref(q));
         }
+        mpz_set_ui(mpq_denref(q), 1);
+        return;
+    }
 
-        /* Handle the case where an embedded decimal point exists. An optional
-         * exponent is also allowed. We take advantage of the fact that
-         * mpz_set_str() ignores embedded space characters. We count the
-         * number of digits after the decimal point and then replace the '.'
-         * with a ' '. We've already inserted a NUL byte to terminate the
-         * string in the case when an exponent was entered. The value for
-         * the exponent has already been read.
-         */
-
-        if (wheredot) {
-            char *counter;
-            long digits = 0;
-
-            counter = wheredot;
-            digits = 0;
-            *wheredot = ' ';
-            while (*++counter != '\0') {
-                if (isdigit(*counter))
-                    digits++;
-            }
-            if (-1 == mpz_set_str(mpq_numref(result->q), (char*)cp, base)) {
-                if (wheredot)
-                    *wheredot = '.';
-                /* Restore the exponent! */
-                if (whereexp && !whereslash && (base == 10))
-                    *whereexp = exp_char;
-                VALUE_ERROR("invalid digits");
-                goto error;
-            }
-            /* Process the exponent. */
-            digits = expt - digits;
-            if (digits < 0) {
-                mpz_ui_pow_ui(mpq_denref(result->q), 10, (unsigned long)(-digits));
-            }
-            else {
-                /* Use the denominator instead of a temporary variable. */
-                mpz_ui_pow_ui(mpq_denref(result->q), 10, (unsigned long)(digits));
-                mpz_mul(mpq_numref(result->q), mpq_numref(result->q), mpq_denref(result->q));
-                mpz_set_ui(mpq_denref(result->q), 1);
-            }
-            mpq_canonicalize(result->q);
-
-            /* Restore the decimal point. */
-            *wheredot = '.';
+    e = (unsigned long)(-(exp + 1)) + 1;
+    twos = mpz_scan1(mpq_numref(q), 0);
+    if (twos > e)
+        twos = e;
+    mpz_fdiv_q_2exp(mpq_numref(q), mpq_numref(q), twos);
+    for (fives = 0; fives < e && mpz_divisible_ui_p(mpq_numref(q), 5); fives++)
+        mpz_divexact_ui(mpq_numref(q), mpq_numref(q), 5);
+    mpz_ui_pow_ui(mpq_denref(q), 5, e - fives);
+    mpz_mul_2exp(mpq_denref(q), mpq_denref(q), e - twos);
+}
 
-            /* Restore the exponent! */
-            if (whereexp && (base == 10))
-                *whereexp = exp_char;
+/* Parse a rational in cp[0:len]: "n/d", or for base 10 a decimal number
+ * with an optional fraction and exponent. The string is scanned once to
+ * find the separators and is not modified. Returns -1 with an exception
+ * set on error.
+ */
 
-            goto finish;
+static int
+GMPy_MPQ_Set_Chars(mpq_t q, const char *cp, Py_ssize_t len, int base)
+{
+    const char *p, *end = cp + len, *slash = NULL, *dot = NULL, *expo = NULL;
+    long expt = 0, frac = 0;
+    int res, negative = 0;
+
+    for (p = cp; p < end; p++) {
+        switch (*p) {
+            case '\0':
+                VALUE_ERROR("string contains NULL characters");
+                return -1;
+            case '/':
+                if (!slash)
+                    slash = p;
+                break;
+            case '.':
+                if (!dot)
+                    dot = p;
+                break;
+            case 'E':
+            case 'e':
+                if (!expo)
+                    expo = p;
+                break;
         }
+    }
 
-        if (whereslash)
-            *whereslash = '\0';
+    if (slash && dot) {
+        VALUE_ERROR("illegal string: both . and / found");
+        return -1;
+    }
 
-        /* Read the numerator. */
-        if (-1 == mpz_set_str(mpq_numref(result->q), (char*)cp, base)) {
-            if (whereslash)
-                *whereslash = '/';
-            VALUE_ERROR("invalid digits");
-            goto error;
-        }
+    if (dot && (base != 10)) {
+        VALUE_ERROR("illegal string: embedded . requires base=10");
+        return -1;
+    }
 
-        /* If a slash was present, read the denominator. */
-        if (whereslash) {
-            *whereslash = '/';
-            if (-1 == mpz_set_str(mpq_denref(result->q), whereslash+1, base)) {
+    if (slash) {
+        if ((res = mpz_set_chars(mpq_numref(q), cp, slash - cp, base, NULL)) == 0)
+            res = mpz_set_chars(mpq_denref(q), slash + 1, end - slash - 1, base, NULL);
+        if (res < 0) {
+            if (res == -1)
                 VALUE_ERROR("invalid digits");
-                goto error;
-            }
-            if (0 == mpz_sgn(mpq_denref(result->q))) {
-                ZERO_ERROR("zero denominator in mpq()");
-                goto error;
-            }
-            mpq_canonicalize(result->q);
+            return -1;
         }
-        else {
-            /* Since no slash was present, either the denominator is 1 or a
-             * power of 10.
-             */
+        if (0 == mpz_sgn(mpq_denref(q))) {
+            ZERO_ERROR("zero denominator in mpq()");
+            return -1;
+        }
+        mpq_canonicalize(q);
+        return 0;
+    }
 
-            if (expt <= 0) {
-                mpz_ui_pow_ui(mpq_denref(result->q), 10, (unsigned long)(-expt));
-            }
-            else {
-                mpz_ui_pow_ui(mpq_denref(result->q), 10, (unsigned long)(expt));
-                mpz_mul(mpq_numref(result->q), mpq_numref(result->q), mpq_denref(result->q));
-                mpz_set_ui(mpq_denref(result->q), 1);
+    /* In base 10, an exponent may follow the digits. */
+    if (expo && (base == 10)) {
+        const char *digits;
+
+        p = expo + 1;
+        while (p < end && isspace((unsigned char)*p))
+            p++;
+        if (p < end && (*p == '-' || *p == '+'))
+            negative = (*p++ == '-');
+        for (digits = p; p < end && isdigit((unsigned char)*p); p++) {
+            if (expt > (LONG_MAX - 9) / 10) {
+                VALUE_ERROR("exponent too large");
+                return -1;
             }
-            mpq_canonicalize(result->q);
-            if (whereexp && (base == 10))
-                *whereexp = exp_char;
+            expt = expt * 10 + (*p - '0');
+        }
+        if (p == digits || (dot && dot > expo)) {
+            VALUE_ERROR("invalid digits");
+            return -1;
+        }
+        while (p < end && isspace((unsigned char)*p))
+            p++;
+        if (p != end) {
+            VALUE_ERROR("invalid digits");
+            return -1;
         }
+        if (negative)
+            expt = -expt;
+        end = expo;
     }
 
-  finish:
-    Py_XDECREF(ascii_str);
-    return result;
+    if ((res = mpz_set_chars(mpq_numref(q), cp, end - cp, base, dot ? &frac : NULL)) < 0) {
+        if (res == -1)
+            VALUE_ERROR("invalid digits");
+        return -1;
+    }
+    mpq_set_num_pow10(q, expt - frac);
+    return 0;
+}
 
-  error:
-    Py_DECREF((PyObject*)result);
+static MPQ_Object *
+GMPy_MPQ_From_PyStr(PyObject *s, int base, CTXT_Object *context)
+{
+    MPQ_Object *result;
+    const char *cp;
+    Py_ssize_t len;
+    PyObject *ascii_str = NULL;
+
+    if (PyBytes_Check(s)) {
+        len = PyBytes_GET_SIZE(s);
+        cp = PyBytes_AS_STRING(s);
+    }
+    else if (PyUnicode_Check(s)) {
+#if PY_VERSION_HEX >= 0x03030000
+        /* The UTF-8 form of an ASCII string is its own data. */
+        if (!(cp = PyUnicode_AsUTF8AndSize(s, &len)))
+            return NULL;
+        if (!PyUnicode_IS_ASCII(s)) {
+            VALUE_ERROR("string contains non-ASCII characters");
+            return NULL;
+        }
+#else
+        ascii_str = PyUnicode_AsASCIIString(s);
+        if (!ascii_str) {
+            VALUE_ERROR("string contains non-ASCII characters");
+            return NULL;
+        }
+        len = PyBytes_Size(ascii_str);
+        cp = PyBytes_AsString(ascii_str);
+#endif
+    }
+    else {
+        TYPE_ERROR("object is not string or Unicode");
+        return NULL;
+    }
+
+    if ((result = GMPy_MPQ_New(context))) {
+        if (GMPy_MPQ_Set_Chars(result->q, cp, len, base) < 0) {
+            Py_DECREF((PyObject*)result);
+            result = NULL;
+        }
+    }
     Py_XDECREF(ascii_str);
-    return NULL;
+    return result;
 }
 
 static MPQ_Object *
@@ -957,84 +1200,120 @@ GMPy_MPQ_From_DecimalRaw(PyObject* obj, CTXT_Object *context)
 
 }
 #else
+/* str() of a Decimal is the fastest way to read its value from C: the
+ * result is always [-]digits[.digits][E[+|-]digits], Infinity, or a NaN.
+ * The digits are converted directly and the result is made canonical by
+ * mpq_set_num_pow10().
+ */
+
 static MPQ_Object*
 GMPy_MPQ_From_DecimalRaw(PyObject* obj, CTXT_Object *context)
 {
     MPQ_Object *result;
-    PyObject *temp = NULL, *d_is_inf = NULL, *d_is_nan = NULL;
-    PyObject *d_is_zero = NULL, *d_is_signed = NULL, *s = NULL;
+    PyObject *s;
+    const char *p, *end;
+    char *buf = NULL, *q;
+    Py_ssize_t len, ndigits = 0;
+    long exp = 0, frac = 0;
+    unsigned long small = 0;
+    int sign = 0, point = 0;
 
     if (!(result = GMPy_MPQ_New(context)))
         return NULL;
     mpq_set_si(result->q, 0, 1);
 
-    d_is_inf = PyObject_GetAttrString(obj, "is_infinite");
-    d_is_nan = PyObject_GetAttrString(obj, "is_nan");
-    d_is_zero = PyObject_GetAttrString(obj, "is_zero");
-    d_is_signed = PyObject_GetAttrString(obj, "is_signed");
-    if (!d_is_inf || !d_is_nan || !d_is_zero || !d_is_signed) {
-        SYSTEM_ERROR("Object does not appear to be Decimal");
+    if (!(s = PyObject_Str(obj)))
         goto error;
-    }
-
-    if (!(temp = PyObject_CallFunctionObjArgs(d_is_nan, NULL)))
+    if (!(p = PyUnicode_AsUTF8AndSize(s, &len)))
         goto error;
-    if (PyObject_IsTrue(temp)) {
+    end = p + len;
+
+    if (p < end && *p == '-') {
+        sign = 1;
+        p++;
+    }
+    if (p < end && (*p == 'N' || *p == 's')) {
         mpz_set_si(mpq_denref(result->q), 0);
         goto okay;
     }
-    Py_DECREF(temp);
+    if (p < end && *p == 'I') {
+        mpq_set_si(result->q, sign ? -1 : 1, 0);
+        goto okay;
+    }
 
-    if (!(temp = PyObject_CallFunctionObjArgs(d_is_inf, NULL)))
+    if (!(buf = GMPY_MALLOC(len + 1))) {
+        PyErr_NoMemory();
         goto error;
-    if (PyObject_IsTrue(temp)) {
-        Py_DECREF(temp);
-        if (!(temp = PyObject_CallFunctionObjArgs(d_is_signed, NULL)))
-            goto error;
-        if (PyObject_IsTrue(temp)) {
-            mpq_set_si(result->q, -1, 0);
+    }
+    for (q = buf; p < end && *p != 'E' && *p != 'e'; p++) {
+        if (*p == '.' && !point) {
+            point = 1;
+        }
+        else if (*p >= '0' && *p <= '9') {
+            *q++ = *p;
+            frac += point;
         }
         else {
-            mpq_set_si(result->q, 1, 0);
+            goto error_format;
         }
-        goto okay;
     }
-    Py_DECREF(temp);
-
-    if (!(temp = PyObject_CallFunctionObjArgs(d_is_zero, NULL)))
-        goto error;
-    if (PyObject_IsTrue(temp)) {
-        Py_DECREF(temp);
-        if (!(temp = PyObject_CallFunctionObjArgs(d_is_signed, NULL)))
+    *q = '\0';
+    ndigits = q - buf;
+    if (!ndigits)
+        goto error_format;
+
+    if (p < end) {
+        char *stop;
+
+        errno = 0;
+        exp = strtol(p + 1, &stop, 10);
+        if (stop != end || stop == p + 1)
+            goto error_format;
+        if (errno == ERANGE || exp < LONG_MIN + frac) {
+            SYSTEM_ERROR("Decimal _exp is not valid or overflow occurred");
             goto error;
-        if (PyObject_IsTrue(temp)) {
-            mpz_set_si(mpq_denref(result->q), -1);
         }
-        goto okay;
     }
+    exp -= frac;
 
-    Py_DECREF((PyObject*)result);
+    /* Trailing zeros of the coefficient only enlarge the denominator. */
+    while (exp < 0 && ndigits > 1 && buf[ndigits - 1] == '0') {
+        buf[--ndigits] = '\0';
+        exp++;
+    }
 
-    s = PyObject_Str(obj);
-    if (s) {
-        result = GMPy_MPQ_From_PyStr(s, 10, context);
-        Py_DECREF(s);
+    if (ndigits < (Py_ssize_t)(sizeof(unsigned long) == 8 ? 20 : 10)) {
+        for (q = buf; *q; q++)
+            small = small * 10 + (unsigned long)(*q - '0');
+        mpz_set_ui(mpq_numref(result->q), small);
+    }
+    else {
+        mpz_set_str_radix(mpq_numref(result->q), buf, 10);
+    }
+
+    if (!mpz_sgn(mpq_numref(result->q))) {
+        /* For -0, we need a negative denominator. */
+        if (sign)
+            mpz_set_si(mpq_denref(result->q), -1);
+        goto okay;
     }
 
+    mpq_set_num_pow10(result->q, exp);
+
+    if (sign)
+        mpz_neg(mpq_numref(result->q), mpq_numref(result->q));
+
   okay:
-    Py_DECREF(temp);
-    Py_DECREF(d_is_inf);
-    Py_DECREF(d_is_nan);
-    Py_DECREF(d_is_zero);
-    Py_DECREF(d_is_signed);
+    GMPY_FREE(buf);
+    Py_DECREF(s);
     return result;
 
+  error_format:
+    SYSTEM_ERROR("Cannot convert Decimal to mpq");
   error:
-    Py_XDECREF(temp);
-    Py_XDECREF(d_is_inf);
-    Py_XDECREF(d_is_nan);
-    Py_XDECREF(d_is_zero);
-    Py_XDECREF(d_is_signed);
+    if (buf)
+        GMPY_FREE(buf);
+    Py_XDECREF(s);
     Py_DECREF((PyObject*)result);
     return NULL;
 }
@@ -1072,12 +1351,22 @@ static MPQ_Object*
 GMPy_MPQ_From_Fraction(PyObject* obj, CTXT_Object *context)
 {
     MPQ_Object *result;
-    PyObject *num, *den;
+    PyObject *num = NULL, *den = NULL;
 
     if (!(result = GMPy_MPQ_New(context)))
         return NULL;
     mpq_set_si(result->q, 0, 1);
 
+    /* The numerator and denominator properties of fractions.Fraction are
+     * implemented in Python; read the underlying slots when they exist. */
+    if ((num = PyObject_GetAttrString(obj, "_numerator")) &&
+        (den = PyObject_GetAttrString(obj, "_denominator")) &&
+        PyIntOrLong_Check(num) && PyIntOrLong_Check(den))
+        goto okay;
+    PyErr_Clear();
+    Py_XDECREF(num);
+    Py_XDECREF(den);
+
     num = PyObject_GetAttrString(obj, "numerator");
     den = PyObject_GetAttrString(obj, "denominator");
     if (!num || !PyIntOrLong_Check(num) || !den || !PyIntOrLong_Check(den)) {
@@ -1087,6 +1376,7 @@ GMPy_MPQ_From_Fraction(PyObject* obj, CTXT_Object *context)
         Py_DECREF((PyObject*)result);
         return NULL;
     }
+  okay:
     mpz_set_PyIntOrLong(mpq_numref(result->q), num);
     mpz_set_PyIntOrLong(mpq_denref(result->q), den);
     Py_DECREF(num);
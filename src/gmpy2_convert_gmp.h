@@ -38,11 +38,17 @@ extern "C" {
 
 static MPZ_Object *    GMPy_MPZ_From_PyIntOrLong(PyObject *obj, CTXT_Object *context);
 static MPZ_Object *    GMPy_MPZ_From_PyStr(PyObject *s, int base, CTXT_Object *context);
+static void            mpz_inoc_pylong(mpz_t newo, PyObject *obj);
+static void            mpz_cloc_pylong(mpz_t oldo);
 static MPZ_Object *    GMPy_MPZ_From_PyFloat(PyObject *obj, CTXT_Object *context);
 
 static MPZ_Object *    GMPy_MPZ_From_Number(PyObject *obj, CTXT_Object *context);
 static MPZ_Object *    GMPy_MPZ_From_Integer(PyObject *obj, CTXT_Object *context);
 
+static MPZ_Object **   GMPy_MPZ_Array_From_Iterable(PyObject *obj, Py_ssize_t *len,
+                                                    const char *msg, CTXT_Object *context);
+static void            GMPy_MPZ_Array_Free(MPZ_Object **array, Py_ssize_t len);
+
 static PyObject *      GMPy_MPZ_Str_Slot(MPZ_Object *self);
 static PyObject *      GMPy_MPZ_Repr_Slot(MPZ_Object *self);
 
@@ -86,6 +92,9 @@ static MPZ_Object *    GMPy_MPZ_From_XMPZ(XMPZ_Object *obj, CTXT_Object *context
 
 static MPQ_Object *    GMPy_MPQ_From_PyIntOrLong(PyObject *obj, CTXT_Object *context);
 static MPQ_Object *    GMPy_MPQ_From_PyStr(PyObject *s, int base, CTXT_Object *context);
+static int             GMPy_MPQ_Set_Chars(mpq_t q, const char *cp, Py_ssize_t len, int base);
+static int             mpz_set_chars(mpz_t z, const char *cp, Py_ssize_t len, int base, long *point);
+static void            mpq_set_num_pow10(mpq_t q, long exp);
 static MPQ_Object *    GMPy_MPQ_From_PyFloat(PyObject *obj, CTXT_Object *context);
 static MPQ_Object *    GMPy_MPQ_From_Fraction(PyObject *obj, CTXT_Object *context);
 static MPQ_Object *    GMPy_MPQ_From_MPZ(MPZ_Object *obj, CTXT_Object *context);
@@ -259,23 +259,34 @@ GMPy_MPC_From_Decimal(PyObject *obj, mpfr_prec_t rprec, mpfr_prec_t iprec,
     MPFR_Object *tempf;
     mpfr_prec_t oldmpfr, oldreal;
     int oldmpfr_round, oldreal_round;
+    CTXT_Object real_context;
 
     assert(IS_DECIMAL(obj));
 
     CHECK_CONTEXT(context);
 
-    oldmpfr = GET_MPFR_PREC(context);
-    oldreal = GET_REAL_PREC(context);
-    oldmpfr_round = GET_MPFR_ROUND(context);
-    oldreal_round = GET_REAL_ROUND(context);
+    if (context->frozen) {
+        /* A frozen context may be in use by other threads. The copy keeps
+         * the id, so the flags still go to the current thread. */
+        real_context = *context;
+        real_context.ctx.mpfr_prec = GET_REAL_PREC(context);
+        real_context.ctx.mpfr_round = GET_REAL_ROUND(context);
+        tempf = GMPy_MPFR_From_Decimal(obj, rprec, &real_context);
+    }
+    else {
+        oldmpfr = GET_MPFR_PREC(context);
+        oldreal = GET_REAL_PREC(context);
+        oldmpfr_round = GET_MPFR_ROUND(context);
+        oldreal_round = GET_REAL_ROUND(context);
 
-    context->ctx.mpfr_prec = oldreal;
-    context->ctx.mpfr_round = oldreal_round;
+        context->ctx.mpfr_prec = oldreal;
+        context->ctx.mpfr_round = oldreal_round;
 
-    tempf = GMPy_MPFR_From_Decimal(obj, rprec, context);
+        tempf = GMPy_MPFR_From_Decimal(obj, rprec, context);
 
-    context->ctx.mpfr_prec = oldmpfr;
-    context->ctx.mpfr_round = oldmpfr_round;
+        context->ctx.mpfr_prec = oldmpfr;
+        context->ctx.mpfr_round = oldmpfr_round;
+    }
 
     result = GMPy_MPC_New(0, 0, context);
     if (!tempf || !result) {
@@ -156,7 +156,7 @@ GMPy_MPFR_From_PyIntOrLong(PyObject *obj, mpfr_prec_t prec, CTXT_Object *context
         prec = GET_MPFR_PREC(context);
 
     if (prec == 1) {
-        /* This should be made accurate, but is it worth the overhead? */
+        /* Values that don't fit in a long are given more bits below. */
         prec = 64;
         was_one = 1;
     }
@@ -169,6 +169,8 @@ GMPy_MPFR_From_PyIntOrLong(PyObject *obj, mpfr_prec_t prec, CTXT_Object *context
     if (error) {
         mpz_inoc(tempz);
         mpz_set_PyIntOrLong(tempz, obj);
+        if (was_one && mpz_sizeinbase(tempz, 2) > (size_t)prec)
+            mpfr_set_prec(result->f, mpz_sizeinbase(tempz, 2));
         mpfr_clear_flags();
         result->rc = mpfr_set_z(result->f, tempz, GET_MPFR_ROUND(context));
         mpz_cloc(tempz);
@@ -388,18 +390,19 @@ GMPy_MPFR_From_Decimal(PyObject* obj, mpfr_prec_t prec, CTXT_Object *context)
  *
  * If prec>=2, then the specified precision is used.
  *
- * If context.convert_exact is set, then str->mpfr conversion is done via
- * exact conversion to mpq and then mpq->mpfr conversion.
+ * If context.convert_exact is set, then str->mpfr conversion is done by
+ * parsing the string directly into an mpq_t and rounding that once.
  */
 
 static MPFR_Object *
 GMPy_MPFR_From_PyStrExact(PyObject *s, int base, mpfr_prec_t prec, CTXT_Object *context)
 {
     MPFR_Object *result;
-    MPQ_Object *tempq;
-    char *cp, *endptr;
+    mpq_t tempq;
+    const char *cp, *p;
+    char *endptr;
     Py_ssize_t len;
-    PyObject *ascii_str = NULL;
+    PyObject *ascii_str = NULL, *type, *value, *traceback;
 
     CHECK_CONTEXT(context);
 
@@ -407,10 +410,18 @@ GMPy_MPFR_From_PyStrExact(PyObject *s, int base, mpfr_prec_t prec, CTXT_Object *
         prec = GET_MPFR_PREC(context) + prec * GET_GUARD_BITS(context);
 
     if (PyBytes_Check(s)) {
-        len = PyBytes_Size(s);
-        cp = PyBytes_AsString(s);
+        len = PyBytes_GET_SIZE(s);
+        cp = PyBytes_AS_STRING(s);
     }
     else if (PyUnicode_Check(s)) {
+#if PY_VERSION_HEX >= 0x03030000
+        if (!(cp = PyUnicode_AsUTF8AndSize(s, &len)))
+            return NULL;
+        if (!PyUnicode_IS_ASCII(s)) {
+            VALUE_ERROR("string contains non-ASCII characters");
+            return NULL;
+        }
+#else
         ascii_str = PyUnicode_AsASCIIString(s);
         if (!ascii_str) {
             VALUE_ERROR("string contains non-ASCII characters");
@@ -418,51 +429,59 @@ GMPy_MPFR_From_PyStrExact(PyObject *s, int base, mpfr_prec_t prec, CTXT_Object *
         }
         len = PyBytes_Size(ascii_str);
         cp = PyBytes_AsString(ascii_str);
+#endif
     }
     else {
         TYPE_ERROR("object is not string or Unicode");
         return NULL;
     }
 
-    /* To detect +-0, +-Inf, and NaN, we first convert the string to low precision
-     * mpfr. 47 bits was chosen to be "different" from 53 to make it easy to detect
-     * if the low precision value leaks out. Assuming no error occurred, one of the
-     * special values wasn't detected, then the string is converted to an mpq and
-     * then a valid mpq is converted to an mpfr.
-     */
-     
-    if (!(result = GMPy_MPFR_New(47, context))) {
+    /* A fraction is valid for mpq() but not for mpfr(). */
+    if (memchr(cp, '/', len)) {
+        VALUE_ERROR("invalid digits");
         Py_XDECREF(ascii_str);
         return NULL;
     }
 
-    /* delegate the rest to MPFR */
-    mpfr_clear_flags();
-    result->rc = mpfr_strtofr(result->f, cp, &endptr, base, GET_MPFR_ROUND(context));
-    Py_XDECREF(ascii_str);
-
-    if (len != (Py_ssize_t)(endptr - cp)) {
-        VALUE_ERROR("invalid digits");
-        Py_DECREF((PyObject*)result);
+    if (!(result = GMPy_MPFR_New(prec, context))) {
+        Py_XDECREF(ascii_str);
         return NULL;
     }
 
-    if (!(result->rc) && !mpfr_regular_p(result->f)) {
-        /* Change the precision of the exact result and return it. */
-        mpfr_prec_round(result->f, prec, GET_MPFR_ROUND(context));
-        return result;
-    }
-
-    if (!(tempq = GMPy_MPQ_From_PyStr(s, base, context))) {
+    mpq_init(tempq);
+    if (GMPy_MPQ_Set_Chars(tempq, cp, len, base) < 0) {
+        /* Infinity and NaN are not rationals; let MPFR recognize them. They
+         * are exact at any precision. Otherwise report the parse error.
+         */
+        mpq_clear(tempq);
+        PyErr_Fetch(&type, &value, &traceback);
+        mpfr_clear_flags();
+        result->rc = mpfr_strtofr(result->f, cp, &endptr, base, GET_MPFR_ROUND(context));
+        Py_XDECREF(ascii_str);
+        if (len == (Py_ssize_t)(endptr - cp) && !mpfr_number_p(result->f)) {
+            Py_XDECREF(type);
+            Py_XDECREF(value);
+            Py_XDECREF(traceback);
+            return result;
+        }
+        PyErr_Restore(type, value, traceback);
         Py_DECREF((PyObject*)result);
         return NULL;
     }
 
-    mpfr_set_prec(result->f, prec);
     mpfr_clear_flags();
-    result->rc = mpfr_set_q(result->f, tempq->q, GET_MPFR_ROUND(context));
-    Py_DECREF((PyObject*)tempq);
-    
+    if (mpq_sgn(tempq)) {
+        result->rc = mpfr_set_q(result->f, tempq, GET_MPFR_ROUND(context));
+    }
+    else {
+        /* Keep the sign of a negative zero. */
+        for (p = cp; p < cp + len && isspace((unsigned char)*p); p++);
+        mpfr_set_zero(result->f, (p < cp + len && *p == '-') ? -1 : 1);
+        result->rc = 0;
+    }
+    mpq_clear(tempq);
+    Py_XDECREF(ascii_str);
+
     if (prec != 1) {
         GMPY_MPFR_CHECK_RANGE(result, context);
     }
@@ -471,8 +490,11 @@ GMPy_MPFR_From_PyStrExact(PyObject *s, int base, mpfr_prec_t prec, CTXT_Object *
     return result;
 }
 
+GMPY_PROFILE_WRAP(MPFR_Object *, GMPy_MPFR_From_PyStr, (PyObject *s, int base, mpfr_prec_t prec, CTXT_Object *context),
+                  (s, base, prec, context), gmpy_profile_bits((PyObject*)result))
+
 static MPFR_Object *
-GMPy_MPFR_From_PyStr(PyObject *s, int base, mpfr_prec_t prec, CTXT_Object *context)
+GMPy_MPFR_From_PyStr_Impl(PyObject *s, int base, mpfr_prec_t prec, CTXT_Object *context)
 {
     MPFR_Object *result;
     char *cp, *endptr;
@@ -757,10 +779,32 @@ stern_brocot(MPFR_Object* self, MPFR_Object *err, mpfr_prec_t prec, int mayz, CT
     return result;
 }
 
+/* Set num/den to the exact value of the regular number f in lowest terms.
+ * The significand is read as an integer and a power of two is moved to the
+ * numerator or denominator; no gcd is needed since den is a power of two.
+ */
+
+static void
+mpfr_get_num_den(mpz_t num, mpz_t den, mpfr_srcptr f)
+{
+    mpfr_exp_t temp, twocount;
+
+    temp = mpfr_get_z_2exp(num, f);
+    twocount = (mpfr_exp_t)mpz_scan1(num, 0);
+    if (twocount) {
+        temp += twocount;
+        mpz_div_2exp(num, num, twocount);
+    }
+    mpz_set_ui(den, 1);
+    if (temp > 0)
+        mpz_mul_2exp(num, num, temp);
+    else if (temp < 0)
+        mpz_mul_2exp(den, den, -temp);
+}
+
 static MPQ_Object *
 GMPy_MPQ_From_MPFR(MPFR_Object *self, CTXT_Object *context)
 {
-    mpfr_exp_t temp, twocount;
     MPQ_Object *result;
 
     CHECK_CONTEXT(context);
@@ -784,17 +828,7 @@ GMPy_MPQ_From_MPFR(MPFR_Object *self, CTXT_Object *context)
         mpz_set_ui(mpq_denref(result->q), 1);
     }
     else {
-        temp = mpfr_get_z_2exp(mpq_numref(result->q), self->f);
-        twocount = (mpfr_exp_t)mpz_scan1(mpq_numref(result->q), 0);
-        if (twocount) {
-            temp += twocount;
-            mpz_div_2exp(mpq_numref(result->q), mpq_numref(result->q), twocount);
-        }
-        mpz_set_ui(mpq_denref(result->q), 1);
-        if (temp > 0)
-            mpz_mul_2exp(mpq_numref(result->q), mpq_numref(result->q), temp);
-        else if (temp < 0)
-            mpz_mul_2exp(mpq_denref(result->q), mpq_denref(result->q), -temp);
+        mpfr_get_num_den(mpq_numref(result->q), mpq_denref(result->q), self->f);
     }
     return result;
 }
@@ -0,0 +1,461 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_crt.c                                                             *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* This file implements gmpy2.crt() and the crt_basis type.
+ *
+ * For moduli m[0], ..., m[n-1] with product M, the solution of the
+ * congruences x = r[i] (mod m[i]) is
+ *
+ *     x = sum(r[i] * c[i] * (M // m[i])) mod M,  c[i] = (M // m[i])**-1 mod m[i].
+ *
+ * The moduli are kept in a product tree: tree[0] contains the moduli and
+ * each entry of tree[k+1] is the product of two adjacent entries of tree[k],
+ * or a copy of the last entry if tree[k] has an odd length. M // m[i] mod
+ * m[i] is found for every i at once by reducing M down the tree modulo the
+ * squares of the nodes. The sum is computed bottom-up: the value of a node
+ * is value(left) * right + value(right) * left. Both take O(M(n) log n)
+ * time instead of one inversion per modulus.
+ *
+ * The arithmetic is done without the GIL once all the memory has been
+ * allocated.
+ */
+
+static CRT_Basis_Object *
+GMPy_CRT_Basis_New(MPZ_Object **moduli, Py_ssize_t n)
+{
+    CRT_Basis_Object *result;
+    mpz_t *rem = NULL, *next = NULL, *swap, square;
+    Py_ssize_t i, k;
+    size_t bits = 0;
+    int coprime = 1;
+
+    if (n == 0) {
+        VALUE_ERROR("crt_basis() requires at least one modulus");
+        return NULL;
+    }
+    for (i = 0; i < n; i++) {
+        if (mpz_sgn(moduli[i]->z) <= 0) {
+            VALUE_ERROR("crt_basis() moduli must be positive");
+            return NULL;
+        }
+        bits += mpz_sizeinbase(moduli[i]->z, 2);
+    }
+
+    if (!(result = PyObject_New(CRT_Basis_Object, &CRT_Basis_Type)))
+        return NULL;
+    result->n = n;
+    result->size = NULL;
+    result->tree = NULL;
+    result->coef = NULL;
+    result->words = NULL;
+    for (k = n, result->levels = 1; k > 1; k = (k + 1) / 2)
+        result->levels++;
+
+    if (!(result->size = GMPY_MALLOC(result->levels * sizeof(Py_ssize_t))) ||
+        !(result->tree = GMPY_MALLOC(result->levels * sizeof(mpz_t*))) ||
+        !(result->coef = GMPY_MALLOC(n * sizeof(mpz_t))) ||
+        !(rem = GMPY_MALLOC(n * sizeof(mpz_t))) ||
+        !(next = GMPY_MALLOC(n * sizeof(mpz_t)))) {
+        GMPY_FREE(rem);
+        result->levels = 0;
+        Py_DECREF((PyObject*)result);
+        return (CRT_Basis_Object*)PyErr_NoMemory();
+    }
+    for (k = 0; k < result->levels; k++) {
+        result->size[k] = k ? (result->size[k - 1] + 1) / 2 : n;
+        if (!(result->tree[k] = GMPY_MALLOC(result->size[k] * sizeof(mpz_t)))) {
+            GMPY_FREE(rem);
+            GMPY_FREE(next);
+            result->levels = k;
+            result->n = 0;
+            Py_DECREF((PyObject*)result);
+            return (CRT_Basis_Object*)PyErr_NoMemory();
+        }
+    }
+
+    GMPY_BEGIN_NOGIL(bits);
+    for (i = 0; i < n; i++)
+        mpz_init_set(result->tree[0][i], moduli[i]->z);
+    for (k = 1; k < result->levels; k++) {
+        for (i = 0; i < result->size[k]; i++) {
+            if (2 * i + 1 < result->size[k - 1]) {
+                mpz_init(result->tree[k][i]);
+                mpz_mul(result->tree[k][i], result->tree[k - 1][2 * i],
+                        result->tree[k - 1][2 * i + 1]);
+            }
+            else {
+                mpz_init_set(result->tree[k][i], result->tree[k - 1][2 * i]);
+            }
+        }
+    }
+
+    /* Find M mod m[i]**2 for each modulus. */
+    mpz_init(square);
+    mpz_init_set(rem[0], result->tree[result->levels - 1][0]);
+    for (k = result->levels - 2; k >= 0; k--) {
+        for (i = 0; i < result->size[k]; i++) {
+            mpz_init(next[i]);
+            mpz_mul(square, result->tree[k][i], result->tree[k][i]);
+            mpz_mod(next[i], rem[i / 2], square);
+        }
+        for (i = 0; i < result->size[k + 1]; i++)
+            mpz_clear(rem[i]);
+        swap = rem;
+        rem = next;
+        next = swap;
+    }
+    mpz_clear(square);
+
+    for (i = 0; i < n; i++) {
+        mpz_init(result->coef[i]);
+        mpz_divexact(rem[i], rem[i], result->tree[0][i]);
+        if (mpz_cmp_ui(result->tree[0][i], 1) &&
+            !mpz_invert(result->coef[i], rem[i], result->tree[0][i]))
+            coprime = 0;
+        mpz_clear(rem[i]);
+    }
+    GMPY_END_NOGIL;
+
+    GMPY_FREE(rem);
+    GMPY_FREE(next);
+    if (!coprime) {
+        VALUE_ERROR("crt_basis() moduli must be pairwise coprime");
+        Py_DECREF((PyObject*)result);
+        return NULL;
+    }
+
+    /* Word-size moduli are also kept as words for rns_int. */
+    for (i = 0; i < n && mpz_fits_ulong_p(result->tree[0][i]); i++)
+        ;
+    if (i == n && (result->words = GMPY_MALLOC(n * sizeof(unsigned long)))) {
+        for (i = 0; i < n; i++)
+            result->words[i] = mpz_get_ui(result->tree[0][i]);
+    }
+    return result;
+}
+
+PyDoc_STRVAR(GMPy_doc_crt_basis_factory,
+"crt_basis(moduli) -> crt_basis\n\n"
+"Return an object that solves systems of congruences for the sequence\n"
+"of pairwise coprime moduli. The work that only depends on the moduli\n"
+"is done once, so repeated reconstructions are faster than crt().");
+
+static PyObject *
+GMPy_CRT_Basis_Factory(PyObject *self, PyObject *other)
+{
+    CRT_Basis_Object *result;
+    MPZ_Object **moduli;
+    Py_ssize_t n;
+
+    if (!(moduli = GMPy_MPZ_Array_From_Iterable(other, &n,
+                            "crt_basis() requires a sequence of integers", NULL)))
+        return NULL;
+
+    result = GMPy_CRT_Basis_New(moduli, n);
+    GMPy_MPZ_Array_Free(moduli, n);
+    return (PyObject*)result;
+}
+
+static void
+GMPy_CRT_Basis_Dealloc(CRT_Basis_Object *self)
+{
+    Py_ssize_t i, k;
+
+    /* A partially constructed basis has n == 0 or levels == 0. */
+    if (self->tree) {
+        for (k = 0; k < self->levels; k++) {
+            for (i = 0; i < self->size[k] && self->n; i++)
+                mpz_clear(self->tree[k][i]);
+            GMPY_FREE(self->tree[k]);
+        }
+        GMPY_FREE(self->tree);
+    }
+    if (self->coef && self->levels) {
+        for (i = 0; i < self->n; i++)
+            mpz_clear(self->coef[i]);
+    }
+    GMPY_FREE(self->coef);
+    GMPY_FREE(self->size);
+    GMPY_FREE(self->words);
+    PyObject_Del(self);
+}
+
+static PyObject *
+GMPy_CRT_Basis_Repr_Slot(CRT_Basis_Object *self)
+{
+    return Py2or3String_FromFormat("<crt_basis of %zd moduli>", self->n);
+}
+
+/* Set result to the solution of x = value[i] (mod m[i]) with 0 <= x < M.
+ * value has one initialized entry for each modulus; the entries are used
+ * as temporaries and cleared. Safe to call without the GIL. */
+
+static void
+GMPy_CRT_Basis_Combine_Values(CRT_Basis_Object *self, mpz_t *value, mpz_ptr result)
+{
+    mpz_t temp, *tree;
+    Py_ssize_t i, k, m, n = self->n;
+
+    for (i = 0; i < n; i++) {
+        mpz_mul(value[i], value[i], self->coef[i]);
+        mpz_mod(value[i], value[i], self->tree[0][i]);
+    }
+    mpz_init(temp);
+    for (k = 0, m = n; m > 1; k++, m = (m + 1) / 2) {
+        tree = self->tree[k];
+        for (i = 0; i < m / 2; i++) {
+            mpz_mul(temp, value[2 * i + 1], tree[2 * i]);
+            mpz_mul(value[i], value[2 * i], tree[2 * i + 1]);
+            mpz_add(value[i], value[i], temp);
+        }
+        if (m & 1)
+            mpz_swap(value[m / 2], value[m - 1]);
+    }
+    mpz_mod(result, value[0], self->tree[self->levels - 1][0]);
+    mpz_clear(temp);
+    for (i = 0; i < n; i++)
+        mpz_clear(value[i]);
+}
+
+/* Return the solution of x = residues[i] (mod m[i]) with 0 <= x < M. */
+
+static MPZ_Object *
+GMPy_CRT_Basis_Combine(CRT_Basis_Object *self, PyObject *residues)
+{
+    MPZ_Object *result = NULL, **items;
+    mpz_t *value = NULL;
+    Py_ssize_t i, n;
+
+    if (!(items = GMPy_MPZ_Array_From_Iterable(residues, &n,
+                            "crt() requires a sequence of integer residues", NULL)))
+        return NULL;
+
+    if (n != self->n) {
+        VALUE_ERROR("crt() requires one residue for each modulus");
+        goto done;
+    }
+    if (!(result = GMPy_MPZ_New(NULL)))
+        goto done;
+    if (!(value = GMPY_MALLOC(n * sizeof(mpz_t)))) {
+        Py_CLEAR(result);
+        PyErr_NoMemory();
+        goto done;
+    }
+
+    GMPY_BEGIN_NOGIL(mpz_sizeinbase(self->tree[self->levels - 1][0], 2));
+    for (i = 0; i < n; i++)
+        mpz_init_set(value[i], items[i]->z);
+    GMPy_CRT_Basis_Combine_Values(self, value, result->z);
+    GMPY_END_NOGIL;
+
+  done:
+    GMPY_FREE(value);
+    GMPy_MPZ_Array_Free(items, n);
+    return result;
+}
+
+PyDoc_STRVAR(GMPy_doc_crt_basis_reconstruct,
+"x.reconstruct(residues) -> mpz\n\n"
+"Return the integer y with 0 <= y < x.modulus such that y is congruent\n"
+"to residues[i] modulo x.moduli[i] for every i.");
+
+static PyObject *
+GMPy_CRT_Basis_Reconstruct(PyObject *self, PyObject *other)
+{
+    return (PyObject*)GMPy_CRT_Basis_Combine((CRT_Basis_Object*)self, other);
+}
+
+PyDoc_STRVAR(GMPy_doc_crt_basis_reduce,
+"x.reduce(y) -> list\n\n"
+"Return the list [y % m for m in x.moduli], computed with a remainder\n"
+"tree. This is the inverse of x.reconstruct() for 0 <= y < x.modulus.");
+
+static PyObject *
+GMPy_CRT_Basis_Reduce(PyObject *self, PyObject *other)
+{
+    CRT_Basis_Object *basis = (CRT_Basis_Object*)self;
+    PyObject *result = NULL, *temp;
+    MPZ_Object *tempx;
+    mpz_t *rem = NULL, *next = NULL, *swap;
+    Py_ssize_t i, k, n = basis->n;
+
+    if (!IS_INTEGER(other)) {
+        TYPE_ERROR("reduce() requires an integer argument");
+        return NULL;
+    }
+    if (!(tempx = GMPy_MPZ_From_Integer(other, NULL)))
+        return NULL;
+
+    if (!(rem = GMPY_MALLOC(n * sizeof(mpz_t))) ||
+        !(next = GMPY_MALLOC(n * sizeof(mpz_t)))) {
+        PyErr_NoMemory();
+        goto done;
+    }
+    if (!(result = PyList_New(n)))
+        goto done;
+    for (i = 0; i < n; i++) {
+        if (!(temp = (PyObject*)GMPy_MPZ_New(NULL))) {
+            Py_CLEAR(result);
+            goto done;
+        }
+        PyList_SET_ITEM(result, i, temp);
+    }
+
+    GMPY_BEGIN_NOGIL(mpz_sizeinbase(tempx->z, 2));
+    mpz_init(rem[0]);
+    mpz_mod(rem[0], tempx->z, basis->tree[basis->levels - 1][0]);
+    for (k = basis->levels - 2; k >= 0; k--) {
+        for (i = 0; i < basis->size[k]; i++) {
+            mpz_init(next[i]);
+            mpz_mod(next[i], rem[i / 2], basis->tree[k][i]);
+        }
+        for (i = 0; i < basis->size[k + 1]; i++)
+            mpz_clear(rem[i]);
+        swap = rem;
+        rem = next;
+        next = swap;
+    }
+    for (i = 0; i < n; i++) {
+        mpz_swap(MPZ(PyList_GET_ITEM(result, i)), rem[i]);
+        mpz_clear(rem[i]);
+    }
+    GMPY_END_NOGIL;
+
+  done:
+    GMPY_FREE(rem);
+    GMPY_FREE(next);
+    Py_DECREF((PyObject*)tempx);
+    return result;
+}
+
+static PyObject *
+GMPy_CRT_Basis_GetModulus(CRT_Basis_Object *self, void *closure)
+{
+    MPZ_Object *result;
+
+    if ((result = GMPy_MPZ_New(NULL)))
+        mpz_set(result->z, self->tree[self->levels - 1][0]);
+    return (PyObject*)result;
+}
+
+static PyObject *
+GMPy_CRT_Basis_GetModuli(CRT_Basis_Object *self, void *closure)
+{
+    PyObject *result;
+    MPZ_Object *temp;
+    Py_ssize_t i;
+
+    if (!(result = PyTuple_New(self->n)))
+        return NULL;
+    for (i = 0; i < self->n; i++) {
+        if (!(temp = GMPy_MPZ_New(NULL))) {
+            Py_DECREF(result);
+            return NULL;
+        }
+        mpz_set(temp->z, self->tree[0][i]);
+        PyTuple_SET_ITEM(result, i, (PyObject*)temp);
+    }
+    return result;
+}
+
+PyDoc_STRVAR(GMPy_doc_mpz_function_crt,
+"crt(residues, moduli) -> mpz\n\n"
+"Return the integer x with 0 <= x < prod(moduli) such that x is congruent\n"
+"to residues[i] modulo moduli[i] for every i. The moduli must be positive\n"
+"and pairwise coprime. Use crt_basis() to reuse the same moduli.");
+
+static PyObject *
+GMPy_MPZ_Function_CRT(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    CRT_Basis_Object *basis;
+    MPZ_Object *result;
+
+    if (nargs != 2) {
+        TYPE_ERROR("crt() requires 2 arguments");
+        return NULL;
+    }
+
+    if (!(basis = (CRT_Basis_Object*)GMPy_CRT_Basis_Factory(NULL, args[1])))
+        return NULL;
+    result = GMPy_CRT_Basis_Combine(basis, args[0]);
+    Py_DECREF((PyObject*)basis);
+    return (PyObject*)result;
+}
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_Function_CRT)
+
+static PyGetSetDef GMPy_CRT_Basis_getseters[] =
+{
+    { "modulus", (getter)GMPy_CRT_Basis_GetModulus, NULL, "product of the moduli", NULL },
+    { "moduli", (getter)GMPy_CRT_Basis_GetModuli, NULL, "tuple of the moduli", NULL },
+    {NULL}
+};
+
+static PyMethodDef GMPy_CRT_Basis_methods[] =
+{
+    { "reconstruct", GMPy_CRT_Basis_Reconstruct, METH_O, GMPy_doc_crt_basis_reconstruct },
+    { "reduce", GMPy_CRT_Basis_Reduce, METH_O, GMPy_doc_crt_basis_reduce },
+    { NULL, NULL, 1 }
+};
+
+static PyTypeObject CRT_Basis_Type =
+{
+#ifdef PY3
+    PyVarObject_HEAD_INIT(0, 0)
+#else
+    PyObject_HEAD_INIT(0)
+        0,                                   /* ob_size          */
+#endif
+    "gmpy2 crt_basis",                       /* tp_name          */
+    sizeof(CRT_Basis_Object),                /* tp_basicsize     */
+        0,                                   /* tp_itemsize      */
+    (destructor) GMPy_CRT_Basis_Dealloc,     /* tp_dealloc       */
+        0,                                   /* tp_print         */
+        0,                                   /* tp_getattr       */
+        0,                                   /* tp_setattr       */
+        0,                                   /* tp_reserved      */
+    (reprfunc) GMPy_CRT_Basis_Repr_Slot,     /* tp_repr          */
+        0,                                   /* tp_as_number     */
+        0,                                   /* tp_as_sequence   */
+        0,                                   /* tp_as_mapping    */
+        0,                                   /* tp_hash          */
+        0,                                   /* tp_call          */
+        0,                                   /* tp_str           */
+        0,                                   /* tp_getattro      */
+        0,                                   /* tp_setattro      */
+        0,                                   /* tp_as_buffer     */
+    Py_TPFLAGS_DEFAULT,                      /* tp_flags         */
+    "GMPY2 CRT basis",                       /* tp_doc           */
+        0,                                   /* tp_traverse      */
+        0,                                   /* tp_clear         */
+        0,                                   /* tp_richcompare   */
+        0,                                   /* tp_weaklistoffset*/
+        0,                                   /* tp_iter          */
+        0,                                   /* tp_iternext      */
+    GMPy_CRT_Basis_methods,                  /* tp_methods       */
+        0,                                   /* tp_members       */
+    GMPy_CRT_Basis_getseters,                /* tp_getset        */
+};
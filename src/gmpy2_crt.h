@@ -0,0 +1,71 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_crt.h                                                             *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GMPY_CRT_H
+#define GMPY_CRT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* A crt_basis stores the product tree of a fixed set of pairwise coprime
+ * moduli and the coefficients needed to combine residues with the Chinese
+ * remainder theorem.
+ */
+
+typedef struct {
+    PyObject_HEAD
+    Py_ssize_t n;                   /* number of moduli */
+    Py_ssize_t levels;              /* number of levels in the tree */
+    Py_ssize_t *size;               /* number of entries in each level */
+    mpz_t **tree;                   /* tree[0] contains the moduli */
+    mpz_t *coef;                    /* inverse of (M // m) modulo m */
+    unsigned long *words;           /* the moduli if they all fit in an
+                                     * unsigned long, else NULL */
+} CRT_Basis_Object;
+
+static PyTypeObject CRT_Basis_Type;
+
+#define CRT_Basis_Check(v) (((PyObject*)v)->ob_type == &CRT_Basis_Type)
+
+static CRT_Basis_Object * GMPy_CRT_Basis_New(MPZ_Object **moduli, Py_ssize_t n);
+static PyObject *         GMPy_CRT_Basis_Factory(PyObject *self, PyObject *other);
+static void               GMPy_CRT_Basis_Dealloc(CRT_Basis_Object *self);
+static PyObject *         GMPy_CRT_Basis_Repr_Slot(CRT_Basis_Object *self);
+static MPZ_Object *       GMPy_CRT_Basis_Combine(CRT_Basis_Object *self, PyObject *residues);
+static void               GMPy_CRT_Basis_Combine_Values(CRT_Basis_Object *self, mpz_t *value,
+                                                        mpz_ptr result);
+static PyObject *         GMPy_CRT_Basis_Reconstruct(PyObject *self, PyObject *other);
+static PyObject *         GMPy_CRT_Basis_Reduce(PyObject *self, PyObject *other);
+static PyObject *         GMPy_CRT_Basis_GetModulus(CRT_Basis_Object *self, void *closure);
+static PyObject *         GMPy_CRT_Basis_GetModuli(CRT_Basis_Object *self, void *closure);
+static PyObject *         GMPy_MPZ_Function_CRT(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
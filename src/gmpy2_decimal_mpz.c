@@ -0,0 +1,736 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_decimal_mpz.c                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* This file implements decimal_mpz, see gmpy2_decimal_mpz.h. */
+
+static const uint64_t dec_pow10[DECMPZ_DIGITS + 1] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL,
+    10000000ULL, 100000000ULL, 1000000000ULL, 10000000000ULL,
+    100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+    100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+    100000000000000000ULL, 1000000000000000000ULL, DECMPZ_BASE
+};
+
+/* Return a new decimal_mpz with room for n limbs; size is set to n. */
+
+static DecMPZ_Object *
+dec_new(Py_ssize_t n)
+{
+    DecMPZ_Object *result;
+
+    if ((result = PyObject_NewVar(DecMPZ_Object, &DecMPZ_Type, n ? n : 1))) {
+        result->size = n;
+        result->negative = 0;
+    }
+    return result;
+}
+
+static void
+dec_normalize(DecMPZ_Object *x)
+{
+    while (x->size && !x->d[x->size - 1])
+        x->size--;
+    if (!x->size)
+        x->negative = 0;
+}
+
+/* Parse an optionally signed string of decimal digits surrounded by
+ * optional whitespace. */
+
+static DecMPZ_Object *
+dec_from_chars(const char *cp, Py_ssize_t len)
+{
+    DecMPZ_Object *result;
+    Py_ssize_t start = 0, stop = len, i, k, n;
+    int negative = 0;
+    uint64_t limb;
+
+    while (start < stop && Py_ISSPACE(cp[start]))
+        start++;
+    while (stop > start && Py_ISSPACE(cp[stop - 1]))
+        stop--;
+    if (start < stop && (cp[start] == '+' || cp[start] == '-'))
+        negative = cp[start++] == '-';
+    if (start == stop) {
+        VALUE_ERROR("invalid digits");
+        return NULL;
+    }
+    for (i = start; i < stop; i++) {
+        if (cp[i] < '0' || cp[i] > '9') {
+            VALUE_ERROR("invalid digits");
+            return NULL;
+        }
+    }
+
+    n = (stop - start + DECMPZ_DIGITS - 1) / DECMPZ_DIGITS;
+    if (!(result = dec_new(n)))
+        return NULL;
+    for (k = 0; k < n; k++) {
+        i = stop - (k + 1) * DECMPZ_DIGITS;
+        if (i < start)
+            i = start;
+        for (limb = 0; i < stop - k * DECMPZ_DIGITS; i++)
+            limb = limb * 10 + (uint64_t)(cp[i] - '0');
+        result->d[k] = limb;
+    }
+    result->negative = negative;
+    dec_normalize(result);
+    return result;
+}
+
+static DecMPZ_Object *
+dec_from_str(PyObject *s)
+{
+    DecMPZ_Object *result;
+    PyObject *ascii_str = NULL;
+
+    if (PyUnicode_Check(s)) {
+        if (!(ascii_str = PyUnicode_AsASCIIString(s))) {
+            VALUE_ERROR("string contains non-ASCII characters");
+            return NULL;
+        }
+        s = ascii_str;
+    }
+    result = dec_from_chars(PyBytes_AS_STRING(s), PyBytes_GET_SIZE(s));
+    Py_XDECREF(ascii_str);
+    return result;
+}
+
+static DecMPZ_Object *
+dec_from_mpz(mpz_srcptr z)
+{
+    DecMPZ_Object *result;
+    char *buffer;
+
+    /* Values below 2**64 are split directly. */
+    if (mpz_sizeinbase(z, 2) <= 64) {
+        uint64_t v = 0;
+
+        mpz_export(&v, NULL, -1, sizeof(uint64_t), 0, 0, z);
+        if ((result = dec_new(2))) {
+            result->d[0] = v % DECMPZ_BASE;
+            result->d[1] = v / DECMPZ_BASE;
+            result->negative = mpz_sgn(z) < 0;
+            dec_normalize(result);
+        }
+        return result;
+    }
+
+    if (!(buffer = GMPY_MALLOC(mpz_sizeinbase(z, 10) + 2))) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+    mpz_get_str(buffer, 10, z);
+    result = dec_from_chars(buffer, strlen(buffer));
+    GMPY_FREE(buffer);
+    return result;
+}
+
+/* Write the digits of x, with a leading '-' if it is negative, to buffer,
+ * which must have room for DECMPZ_DIGITS * size + 2 characters. Returns
+ * the number of characters written, not counting the trailing NUL. */
+
+static Py_ssize_t
+dec_to_chars(DecMPZ_Object *x, char *buffer)
+{
+    char *p = buffer;
+    Py_ssize_t i, k;
+    uint64_t limb;
+
+    if (!x->size) {
+        *p++ = '0';
+        *p = '\0';
+        return 1;
+    }
+    if (x->negative)
+        *p++ = '-';
+
+    /* The top limb without leading zeros, then 19 digits per limb. */
+    limb = x->d[x->size - 1];
+    for (k = 1; k < DECMPZ_DIGITS && limb >= dec_pow10[k]; k++)
+        ;
+    for (i = k - 1; i >= 0; i--, limb /= 10)
+        p[i] = (char)('0' + limb % 10);
+    p += k;
+    for (i = x->size - 2; i >= 0; i--) {
+        limb = x->d[i];
+        for (k = DECMPZ_DIGITS - 1; k >= 0; k--, limb /= 10)
+            p[k] = (char)('0' + limb % 10);
+        p += DECMPZ_DIGITS;
+    }
+    *p = '\0';
+    return p - buffer;
+}
+
+/* Set z to the value of x. Returns 0 or -1 with an exception set. */
+
+static int
+dec_to_mpz(DecMPZ_Object *x, mpz_ptr z)
+{
+    char *buffer;
+
+    if (x->size <= 1) {
+        mpz_set_ui(z, 0);
+        if (x->size) {
+#if ULONG_MAX >= 0xffffffffffffffffUL
+            mpz_set_ui(z, (unsigned long)x->d[0]);
+#else
+            mpz_set_ui(z, (unsigned long)(x->d[0] >> 32));
+            mpz_mul_2exp(z, z, 32);
+            mpz_add_ui(z, z, (unsigned long)(x->d[0] & 0xffffffffUL));
+#endif
+        }
+        if (x->negative)
+            mpz_neg(z, z);
+        return 0;
+    }
+
+    if (!(buffer = GMPY_MALLOC(DECMPZ_DIGITS * x->size + 2))) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    dec_to_chars(x, buffer);
+    mpz_set_str(z, buffer, 10);
+    GMPY_FREE(buffer);
+    return 0;
+}
+
+/* Return a new reference to obj as a decimal_mpz, Py_NotImplemented if it
+ * is not a decimal_mpz or an integer, or NULL with an exception set. */
+
+static PyObject *
+dec_operand(PyObject *obj)
+{
+    MPZ_Object *tempz;
+    PyObject *result;
+
+    if (DecMPZ_Check(obj)) {
+        Py_INCREF(obj);
+        return obj;
+    }
+    if (!IS_INTEGER(obj)) {
+        Py_INCREF(Py_NotImplemented);
+        return Py_NotImplemented;
+    }
+    if (!(tempz = GMPy_MPZ_From_Integer(obj, NULL)))
+        return NULL;
+    result = (PyObject*)dec_from_mpz(tempz->z);
+    Py_DECREF((PyObject*)tempz);
+    return result;
+}
+
+static int
+dec_cmp_abs(DecMPZ_Object *a, DecMPZ_Object *b)
+{
+    Py_ssize_t i;
+
+    if (a->size != b->size)
+        return a->size < b->size ? -1 : 1;
+    for (i = a->size - 1; i >= 0; i--) {
+        if (a->d[i] != b->d[i])
+            return a->d[i] < b->d[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+static int
+dec_cmp(DecMPZ_Object *a, DecMPZ_Object *b)
+{
+    int c;
+
+    if (a->negative != b->negative)
+        return a->negative ? -1 : 1;
+    c = dec_cmp_abs(a, b);
+    return a->negative ? -c : c;
+}
+
+/* Return a + b, or a - b if subtract is set. */
+
+static DecMPZ_Object *
+dec_add(DecMPZ_Object *a, DecMPZ_Object *b, int subtract)
+{
+    DecMPZ_Object *result, *swap;
+    int negative_a = a->negative, negative_b = b->negative ^ subtract;
+    uint64_t carry = 0, t;
+    Py_ssize_t i;
+
+    if (b->size == 0)
+        negative_b = 0;
+
+    if (negative_a == negative_b) {
+        if (a->size < b->size) {
+            swap = a; a = b; b = swap;
+        }
+        if (!(result = dec_new(a->size + 1)))
+            return NULL;
+        /* A sum of two limbs can exceed 2**64, so compare with the
+         * complement instead of forming it. */
+        for (i = 0; i < a->size; i++) {
+            t = DECMPZ_BASE - (i < b->size ? b->d[i] : 0);
+            if (a->d[i] + carry >= t) {
+                result->d[i] = a->d[i] + carry - t;
+                carry = 1;
+            }
+            else {
+                result->d[i] = a->d[i] + carry + (DECMPZ_BASE - t);
+                carry = 0;
+            }
+        }
+        result->d[a->size] = carry;
+        result->negative = negative_a;
+    }
+    else {
+        /* Subtract the smaller magnitude from the larger one. */
+        if (dec_cmp_abs(a, b) < 0) {
+            swap = a; a = b; b = swap;
+            negative_a = negative_b;
+        }
+        if (!(result = dec_new(a->size)))
+            return NULL;
+        for (i = 0; i < a->size; i++) {
+            t = (i < b->size ? b->d[i] : 0) + carry;
+            carry = a->d[i] < t;
+            result->d[i] = carry ? a->d[i] + (DECMPZ_BASE - t) : a->d[i] - t;
+        }
+        result->negative = negative_a;
+    }
+    dec_normalize(result);
+    return result;
+}
+
+static PyObject *
+dec_add_slot(PyObject *x, PyObject *y, int subtract)
+{
+    PyObject *a, *b, *result;
+
+    if (!(a = dec_operand(x)))
+        return NULL;
+    if (a == Py_NotImplemented)
+        return a;
+    if (!(b = dec_operand(y))) {
+        Py_DECREF(a);
+        return NULL;
+    }
+    if (b == Py_NotImplemented) {
+        Py_DECREF(a);
+        return b;
+    }
+    result = (PyObject*)dec_add((DecMPZ_Object*)a, (DecMPZ_Object*)b, subtract);
+    Py_DECREF(a);
+    Py_DECREF(b);
+    return result;
+}
+
+static PyObject *
+GMPy_DecMPZ_Add_Slot(PyObject *x, PyObject *y)
+{
+    return dec_add_slot(x, y, 0);
+}
+
+static PyObject *
+GMPy_DecMPZ_Sub_Slot(PyObject *x, PyObject *y)
+{
+    return dec_add_slot(x, y, 1);
+}
+
+static DecMPZ_Object *
+dec_copy(DecMPZ_Object *x, int negative)
+{
+    DecMPZ_Object *result;
+
+    if ((result = dec_new(x->size))) {
+        memcpy(result->d, x->d, x->size * sizeof(uint64_t));
+        result->negative = x->size ? negative : 0;
+    }
+    return result;
+}
+
+static PyObject *
+GMPy_DecMPZ_Neg_Slot(DecMPZ_Object *x)
+{
+    return (PyObject*)dec_copy(x, !x->negative);
+}
+
+static PyObject *
+GMPy_DecMPZ_Pos_Slot(DecMPZ_Object *x)
+{
+    Py_INCREF((PyObject*)x);
+    return (PyObject*)x;
+}
+
+static PyObject *
+GMPy_DecMPZ_Abs_Slot(DecMPZ_Object *x)
+{
+    if (!x->negative)
+        return GMPy_DecMPZ_Pos_Slot(x);
+    return (PyObject*)dec_copy(x, 0);
+}
+
+static int
+GMPy_DecMPZ_NonZero_Slot(DecMPZ_Object *x)
+{
+    return x->size != 0;
+}
+
+PyDoc_STRVAR(GMPy_doc_decimal_mpz_scale,
+"x.scale(k) -> decimal_mpz\n\n"
+"Return x * 10**k if k >= 0 and x // 10**-k if k < 0. Only the decimal\n"
+"limbs are shifted, so the cost is linear in the number of digits.");
+
+static PyObject *
+GMPy_DecMPZ_Method_Scale(PyObject *self, PyObject *other)
+{
+    DecMPZ_Object *x = (DecMPZ_Object*)self, *result, *one, *temp;
+    Py_ssize_t k, q, r, i, n;
+    uint64_t lo, hi, carry;
+    int dropped = 0, error;
+
+    if (!IS_INTEGER(other)) {
+        TYPE_ERROR("scale() requires an integer argument");
+        return NULL;
+    }
+    k = GMPy_Integer_AsLongAndError(other, &error);
+    if (error) {
+        OVERFLOW_ERROR("scale() argument too large");
+        return NULL;
+    }
+    if (!x->size || !k)
+        return GMPy_DecMPZ_Pos_Slot(x);
+
+    if (k > 0) {
+        q = k / DECMPZ_DIGITS;
+        r = k % DECMPZ_DIGITS;
+        if (x->size > PY_SSIZE_T_MAX / (Py_ssize_t)sizeof(uint64_t) - q - 1) {
+            PyErr_NoMemory();
+            return NULL;
+        }
+        if (!(result = dec_new(x->size + q + 1)))
+            return NULL;
+        memset(result->d, 0, q * sizeof(uint64_t));
+        if (r == 0) {
+            memcpy(result->d + q, x->d, x->size * sizeof(uint64_t));
+            result->d[x->size + q] = 0;
+        }
+        else {
+            /* Each limb keeps its low 19 - r digits and passes the high r
+             * digits on to the next limb. */
+            lo = dec_pow10[DECMPZ_DIGITS - r];
+            hi = dec_pow10[r];
+            for (i = 0, carry = 0; i < x->size; i++) {
+                result->d[i + q] = (x->d[i] % lo) * hi + carry;
+                carry = x->d[i] / lo;
+            }
+            result->d[x->size + q] = carry;
+        }
+        result->negative = x->negative;
+        dec_normalize(result);
+        return (PyObject*)result;
+    }
+
+    k = -k;
+    q = k / DECMPZ_DIGITS;
+    r = k % DECMPZ_DIGITS;
+    n = q < x->size ? x->size - q : 0;
+    if (!(result = dec_new(n)))
+        return NULL;
+    for (i = 0; i < q && i < x->size; i++)
+        dropped |= x->d[i] != 0;
+    if (n) {
+        lo = dec_pow10[r];
+        hi = dec_pow10[DECMPZ_DIGITS - r];
+        dropped |= (x->d[q] % lo) != 0;
+        for (i = 0; i < n; i++) {
+            result->d[i] = x->d[i + q] / lo;
+            if (r && i + q + 1 < x->size)
+                result->d[i] += (x->d[i + q + 1] % lo) * hi;
+        }
+    }
+    result->negative = x->negative;
+    dec_normalize(result);
+
+    /* Round toward minus infinity, like //. */
+    if (x->negative && dropped) {
+        if (!(one = dec_new(1))) {
+            Py_DECREF((PyObject*)result);
+            return NULL;
+        }
+        one->d[0] = 1;
+        temp = dec_add(result, one, 1);
+        Py_DECREF((PyObject*)one);
+        Py_DECREF((PyObject*)result);
+        result = temp;
+    }
+    return (PyObject*)result;
+}
+
+PyDoc_STRVAR(GMPy_doc_decimal_mpz_to_mpz,
+"x.to_mpz() -> mpz\n\n"
+"Return the value of x as an mpz. This is a base conversion.");
+
+static PyObject *
+GMPy_DecMPZ_Method_ToMPZ(PyObject *self, PyObject *other)
+{
+    MPZ_Object *result;
+
+    if ((result = GMPy_MPZ_New(NULL))) {
+        if (dec_to_mpz((DecMPZ_Object*)self, result->z) < 0)
+            Py_CLEAR(result);
+    }
+    return (PyObject*)result;
+}
+
+PyDoc_STRVAR(GMPy_doc_decimal_mpz_num_digits,
+"x.num_digits() -> int\n\n"
+"Return the number of decimal digits of x, 1 for zero.");
+
+static PyObject *
+GMPy_DecMPZ_Method_NumDigits(PyObject *self, PyObject *other)
+{
+    DecMPZ_Object *x = (DecMPZ_Object*)self;
+    Py_ssize_t k;
+
+    if (!x->size)
+        return PyIntOrLong_FromSsize_t(1);
+    for (k = 1; k < DECMPZ_DIGITS && x->d[x->size - 1] >= dec_pow10[k]; k++)
+        ;
+    return PyIntOrLong_FromSsize_t(DECMPZ_DIGITS * (x->size - 1) + k);
+}
+
+static PyObject *
+GMPy_DecMPZ_Int_Slot(DecMPZ_Object *x)
+{
+    MPZ_Object *tempz;
+    PyObject *result;
+
+    if (!(tempz = (MPZ_Object*)GMPy_DecMPZ_Method_ToMPZ((PyObject*)x, NULL)))
+        return NULL;
+    result = GMPy_PyIntOrLong_From_MPZ(tempz, NULL);
+    Py_DECREF((PyObject*)tempz);
+    return result;
+}
+
+static Py_hash_t
+GMPy_DecMPZ_Hash_Slot(DecMPZ_Object *self)
+{
+    PyObject *tempz;
+    Py_hash_t result;
+
+    /* Equal to the hash of the same value as an int. */
+    if (!(tempz = GMPy_DecMPZ_Method_ToMPZ((PyObject*)self, NULL)))
+        return -1;
+    result = PyObject_Hash(tempz);
+    Py_DECREF(tempz);
+    return result;
+}
+
+static PyObject *
+GMPy_DecMPZ_RichCompare_Slot(PyObject *a, PyObject *b, int op)
+{
+    PyObject *x, *y;
+    int c;
+
+    if (!(x = dec_operand(a)))
+        return NULL;
+    if (x == Py_NotImplemented)
+        return x;
+    if (!(y = dec_operand(b))) {
+        Py_DECREF(x);
+        return NULL;
+    }
+    if (y == Py_NotImplemented) {
+        Py_DECREF(x);
+        return y;
+    }
+    c = dec_cmp((DecMPZ_Object*)x, (DecMPZ_Object*)y);
+    Py_DECREF(x);
+    Py_DECREF(y);
+    return _cmp_to_object(c, op);
+}
+
+static PyObject *
+GMPy_DecMPZ_Str_Slot(DecMPZ_Object *self)
+{
+    PyObject *result;
+    char *buffer;
+    Py_ssize_t len;
+
+    if (!(buffer = GMPY_MALLOC(DECMPZ_DIGITS * self->size + 2)))
+        return PyErr_NoMemory();
+    len = dec_to_chars(self, buffer);
+    result = Py2or3String_FromStringAndSize(buffer, len);
+    GMPY_FREE(buffer);
+    return result;
+}
+
+static PyObject *
+GMPy_DecMPZ_Repr_Slot(DecMPZ_Object *self)
+{
+    PyObject *digits, *format, *args, *result = NULL;
+
+    if (!(digits = GMPy_DecMPZ_Str_Slot(self)))
+        return NULL;
+    args = Py_BuildValue("(N)", digits);
+    format = Py2or3String_FromString("decimal_mpz('%s')");
+    if (args && format)
+        result = Py2or3String_Format(format, args);
+    Py_XDECREF(args);
+    Py_XDECREF(format);
+    return result;
+}
+
+static void
+GMPy_DecMPZ_Dealloc(DecMPZ_Object *self)
+{
+    PyObject_Del(self);
+}
+
+PyDoc_STRVAR(GMPy_doc_decimal_mpz_factory,
+"decimal_mpz(x=0) -> decimal_mpz\n\n"
+"Return an integer stored in base 10**19. x is a string of decimal digits\n"
+"with an optional sign, an integer or a decimal_mpz. str(), parsing, +, -,\n"
+"comparison and scale() take linear time; to_mpz() and int() convert the\n"
+"value to binary for other arithmetic.");
+
+static PyObject *
+GMPy_DecMPZ_Factory(PyObject *self, PyObject *args)
+{
+    PyObject *x = NULL, *result;
+
+    if (!PyArg_ParseTuple(args, "|O:decimal_mpz", &x))
+        return NULL;
+    if (!x)
+        return (PyObject*)dec_new(0);
+    if (PyStrOrUnicode_Check(x))
+        return (PyObject*)dec_from_str(x);
+
+    if ((result = dec_operand(x)) == Py_NotImplemented) {
+        Py_DECREF(result);
+        TYPE_ERROR("decimal_mpz() requires a string or an integer argument");
+        return NULL;
+    }
+    return result;
+}
+
+#ifdef PY3
+static PyNumberMethods GMPy_DecMPZ_number_methods =
+{
+    (binaryfunc) GMPy_DecMPZ_Add_Slot,       /* nb_add                  */
+    (binaryfunc) GMPy_DecMPZ_Sub_Slot,       /* nb_subtract             */
+        0,                                   /* nb_multiply             */
+        0,                                   /* nb_remainder            */
+        0,                                   /* nb_divmod               */
+        0,                                   /* nb_power                */
+    (unaryfunc) GMPy_DecMPZ_Neg_Slot,        /* nb_negative             */
+    (unaryfunc) GMPy_DecMPZ_Pos_Slot,        /* nb_positive             */
+    (unaryfunc) GMPy_DecMPZ_Abs_Slot,        /* nb_absolute             */
+    (inquiry) GMPy_DecMPZ_NonZero_Slot,      /* nb_bool                 */
+        0,                                   /* nb_invert               */
+        0,                                   /* nb_lshift               */
+        0,                                   /* nb_rshift               */
+        0,                                   /* nb_and                  */
+        0,                                   /* nb_xor                  */
+        0,                                   /* nb_or                   */
+    (unaryfunc) GMPy_DecMPZ_Int_Slot,        /* nb_int                  */
+        0,                                   /* nb_reserved             */
+        0,                                   /* nb_float                */
+};
+#else
+static PyNumberMethods GMPy_DecMPZ_number_methods =
+{
+    (binaryfunc) GMPy_DecMPZ_Add_Slot,       /* nb_add                  */
+    (binaryfunc) GMPy_DecMPZ_Sub_Slot,       /* nb_subtract             */
+        0,                                   /* nb_multiply             */
+        0,                                   /* nb_divide               */
+        0,                                   /* nb_remainder            */
+        0,                                   /* nb_divmod               */
+        0,                                   /* nb_power                */
+    (unaryfunc) GMPy_DecMPZ_Neg_Slot,        /* nb_negative             */
+    (unaryfunc) GMPy_DecMPZ_Pos_Slot,        /* nb_positive             */
+    (unaryfunc) GMPy_DecMPZ_Abs_Slot,        /* nb_absolute             */
+    (inquiry) GMPy_DecMPZ_NonZero_Slot,      /* nb_bool                 */
+        0,                                   /* nb_invert               */
+        0,                                   /* nb_lshift               */
+        0,                                   /* nb_rshift               */
+        0,                                   /* nb_and                  */
+        0,                                   /* nb_xor                  */
+        0,                                   /* nb_or                   */
+        0,                                   /* nb_coerce               */
+    (unaryfunc) GMPy_DecMPZ_Int_Slot,        /* nb_int                  */
+    (unaryfunc) GMPy_DecMPZ_Int_Slot,        /* nb_long                 */
+};
+#endif
+
+static PyMethodDef GMPy_DecMPZ_methods[] =
+{
+    { "num_digits", GMPy_DecMPZ_Method_NumDigits, METH_NOARGS, GMPy_doc_decimal_mpz_num_digits },
+    { "scale", GMPy_DecMPZ_Method_Scale, METH_O, GMPy_doc_decimal_mpz_scale },
+    { "to_mpz", GMPy_DecMPZ_Method_ToMPZ, METH_NOARGS, GMPy_doc_decimal_mpz_to_mpz },
+    { NULL, NULL, 1 }
+};
+
+static PyTypeObject DecMPZ_Type =
+{
+#ifdef PY3
+    PyVarObject_HEAD_INIT(0, 0)
+#else
+    PyObject_HEAD_INIT(0)
+        0,                                   /* ob_size          */
+#endif
+    "gmpy2 decimal_mpz",                     /* tp_name          */
+    offsetof(DecMPZ_Object, d),              /* tp_basicsize     */
+    sizeof(uint64_t),                        /* tp_itemsize      */
+    (destructor) GMPy_DecMPZ_Dealloc,        /* tp_dealloc       */
+        0,                                   /* tp_print         */
+        0,                                   /* tp_getattr       */
+        0,                                   /* tp_setattr       */
+        0,                                   /* tp_reserved      */
+    (reprfunc) GMPy_DecMPZ_Repr_Slot,        /* tp_repr          */
+    &GMPy_DecMPZ_number_methods,             /* tp_as_number     */
+        0,                                   /* tp_as_sequence   */
+        0,                                   /* tp_as_mapping    */
+    (hashfunc) GMPy_DecMPZ_Hash_Slot,        /* tp_hash          */
+        0,                                   /* tp_call          */
+    (reprfunc) GMPy_DecMPZ_Str_Slot,         /* tp_str           */
+        0,                                   /* tp_getattro      */
+        0,                                   /* tp_setattro      */
+        0,                                   /* tp_as_buffer     */
+#ifdef PY3
+    Py_TPFLAGS_DEFAULT,                      /* tp_flags         */
+#else
+    Py_TPFLAGS_HAVE_RICHCOMPARE | Py_TPFLAGS_CHECKTYPES, /* tp_flags */
+#endif
+    "GMPY2 integer in base 10**19",          /* tp_doc           */
+        0,                                   /* tp_traverse      */
+        0,                                   /* tp_clear         */
+    (richcmpfunc)&GMPy_DecMPZ_RichCompare_Slot, /* tp_richcompare */
+        0,                                   /* tp_weaklistoffset*/
+        0,                                   /* tp_iter          */
+        0,                                   /* tp_iternext      */
+    GMPy_DecMPZ_methods,                     /* tp_methods       */
+        0,                                   /* tp_members       */
+        0,                                   /* tp_getset        */
+};
@@ -0,0 +1,76 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_decimal_mpz.h                                                     *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GMPY_DECIMAL_MPZ_H
+#define GMPY_DECIMAL_MPZ_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* A decimal_mpz is an integer stored in sign and magnitude form with limbs
+ * in base 10**19, least significant first. Conversion from and to decimal
+ * strings, addition, subtraction, scaling by powers of ten and comparison
+ * work on the limbs directly and take linear time. Multiplication and
+ * everything else needs to_mpz(), which does one base conversion.
+ */
+
+#define DECMPZ_DIGITS 19
+#define DECMPZ_BASE 10000000000000000000ULL
+
+typedef struct {
+    PyObject_VAR_HEAD               /* ob_size is the number of limbs allocated */
+    Py_ssize_t size;                /* limbs in use, 0 for zero */
+    int negative;
+    uint64_t d[1];
+} DecMPZ_Object;
+
+static PyTypeObject DecMPZ_Type;
+
+#define DecMPZ_Check(v) (((PyObject*)v)->ob_type == &DecMPZ_Type)
+
+static PyObject * GMPy_DecMPZ_Factory(PyObject *self, PyObject *args);
+static void       GMPy_DecMPZ_Dealloc(DecMPZ_Object *self);
+static PyObject * GMPy_DecMPZ_Str_Slot(DecMPZ_Object *self);
+static PyObject * GMPy_DecMPZ_Repr_Slot(DecMPZ_Object *self);
+static Py_hash_t  GMPy_DecMPZ_Hash_Slot(DecMPZ_Object *self);
+static PyObject * GMPy_DecMPZ_RichCompare_Slot(PyObject *a, PyObject *b, int op);
+static PyObject * GMPy_DecMPZ_Add_Slot(PyObject *x, PyObject *y);
+static PyObject * GMPy_DecMPZ_Sub_Slot(PyObject *x, PyObject *y);
+static PyObject * GMPy_DecMPZ_Neg_Slot(DecMPZ_Object *x);
+static PyObject * GMPy_DecMPZ_Pos_Slot(DecMPZ_Object *x);
+static PyObject * GMPy_DecMPZ_Abs_Slot(DecMPZ_Object *x);
+static int        GMPy_DecMPZ_NonZero_Slot(DecMPZ_Object *x);
+static PyObject * GMPy_DecMPZ_Int_Slot(DecMPZ_Object *x);
+static PyObject * GMPy_DecMPZ_Method_Scale(PyObject *self, PyObject *other);
+static PyObject * GMPy_DecMPZ_Method_ToMPZ(PyObject *self, PyObject *other);
+static PyObject * GMPy_DecMPZ_Method_NumDigits(PyObject *self, PyObject *other);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -73,10 +73,9 @@ GMPy_Integer_DivMod(PyObject *x, PyObject *y, CTXT_Object *context)
         if (PyIntOrLong_Check(y)) {
             temp = GMPy_Integer_AsLongAndError(y, &error);
             if (error) {
-                mpz_inoc(tempz);
-                mpz_set_PyIntOrLong(tempz, y);
+                mpz_inoc_pylong(tempz, y);
                 mpz_fdiv_qr(quo->z, rem->z, MPZ(x), tempz);
-                mpz_cloc(tempz);
+                mpz_cloc_pylong(tempz);
             }
             else if (temp > 0) {
                 mpz_fdiv_qr_ui(quo->z, rem->z, MPZ(x), temp);
@@ -120,10 +119,9 @@ GMPy_Integer_DivMod(PyObject *x, PyObject *y, CTXT_Object *context)
             Py_DECREF(result);
             return NULL;
         }
-        mpz_inoc(tempz);
-        mpz_set_PyIntOrLong(tempz, x);
+        mpz_inoc_pylong(tempz, x);
         mpz_fdiv_qr(quo->z, rem->z, tempz, MPZ(y));
-        mpz_cloc(tempz);
+        mpz_cloc_pylong(tempz);
         PyTuple_SET_ITEM(result, 0, (PyObject*)quo);
         PyTuple_SET_ITEM(result, 1, (PyObject*)rem);
         return (PyObject*)result;
@@ -162,19 +160,27 @@ GMPy_Integer_DivMod(PyObject *x, PyObject *y, CTXT_Object *context)
     Py_RETURN_NOTIMPLEMENTED;
 }
 
+GMPY_PROFILE_WRAP(PyObject *, GMPy_MPZ_DivMod_Slot, (PyObject *x, PyObject *y),
+                  (x, y), gmpy_profile_bits2(x, y))
+
 static PyObject *
-GMPy_MPZ_DivMod_Slot(PyObject *x, PyObject *y)
+GMPy_MPZ_DivMod_Slot_Impl(PyObject *x, PyObject *y)
 {
-    if (IS_INTEGER(x) && IS_INTEGER(y))
+    int xtype, ytype;
+
+    xtype = GMPy_ObjectType(x);
+    ytype = GMPy_ObjectType(y);
+
+    if (IS_TYPE_INTEGER(xtype) && IS_TYPE_INTEGER(ytype))
         return GMPy_Integer_DivMod(x, y, NULL);
 
-    if (IS_RATIONAL(x) && IS_RATIONAL(y))
+    if (IS_TYPE_RATIONAL(xtype) && IS_TYPE_RATIONAL(ytype))
         return GMPy_Rational_DivMod(x, y, NULL);
 
-    if (IS_REAL(x) && IS_REAL(y))
+    if (IS_TYPE_REAL(xtype) && IS_TYPE_REAL(ytype))
         return GMPy_Real_DivMod(x, y, NULL);
 
-    if (IS_COMPLEX(x) && IS_COMPLEX(y))
+    if (IS_TYPE_COMPLEX(xtype) && IS_TYPE_COMPLEX(ytype))
         return GMPy_Complex_DivMod(x, y, NULL);
 
     Py_RETURN_NOTIMPLEMENTED;
@@ -236,16 +242,24 @@ GMPy_Rational_DivMod(PyObject *x, PyObject *y, CTXT_Object *context)
     return NULL;
 }
 
+GMPY_PROFILE_WRAP(PyObject *, GMPy_MPQ_DivMod_Slot, (PyObject *x, PyObject *y),
+                  (x, y), gmpy_profile_bits2(x, y))
+
 static PyObject *
-GMPy_MPQ_DivMod_Slot(PyObject *x, PyObject *y)
+GMPy_MPQ_DivMod_Slot_Impl(PyObject *x, PyObject *y)
 {
-    if (IS_RATIONAL(x) && IS_RATIONAL(y))
+    int xtype, ytype;
+
+    xtype = GMPy_ObjectType(x);
+    ytype = GMPy_ObjectType(y);
+
+    if (IS_TYPE_RATIONAL(xtype) && IS_TYPE_RATIONAL(ytype))
         return GMPy_Rational_DivMod(x, y, NULL);
 
-    if (IS_REAL(x) && IS_REAL(y))
+    if (IS_TYPE_REAL(xtype) && IS_TYPE_REAL(ytype))
         return GMPy_Real_DivMod(x, y, NULL);
 
-    if (IS_COMPLEX(x) && IS_COMPLEX(y))
+    if (IS_TYPE_COMPLEX(xtype) && IS_TYPE_COMPLEX(ytype))
         return GMPy_Complex_DivMod(x, y, NULL);
 
     Py_RETURN_NOTIMPLEMENTED;
@@ -295,7 +309,7 @@ GMPy_Real_DivMod_1(PyObject *x, PyObject *y, CTXT_Object *context)
             goto error;
         }
         if (mpfr_zero_p(tempy->f)) {
-            context->ctx.divzero = 1;
+            GMPY_FLAGS(context)->divzero = 1;
             if (context->ctx.traps & TRAP_DIVZERO) {
                 GMPY_DIVZERO("divmod() division by zero");
                 goto error;
@@ -303,7 +317,7 @@ GMPy_Real_DivMod_1(PyObject *x, PyObject *y, CTXT_Object *context)
         }
 
         if (mpfr_nan_p(tempx->f) || mpfr_nan_p(tempy->f) || mpfr_inf_p(tempx->f)) {
-            context->ctx.invalid = 1;
+            GMPY_FLAGS(context)->invalid = 1;
             if (context->ctx.traps & TRAP_INVALID) {
                 GMPY_INVALID("divmod() invalid operation");
                 goto error;
@@ -314,7 +328,7 @@ GMPy_Real_DivMod_1(PyObject *x, PyObject *y, CTXT_Object *context)
             }
         }
         else if (mpfr_inf_p(tempy->f)) {
-            context->ctx.invalid = 1;
+            GMPY_FLAGS(context)->invalid = 1;
             if (context->ctx.traps & TRAP_INVALID) {
                 GMPY_INVALID("divmod() invalid operation");
                 goto error;
@@ -415,7 +429,7 @@ GMPy_Real_DivMod_2(PyObject *x, PyObject *y, CTXT_Object *context)
         }
 
         if (mpfr_zero_p(tempy->f)) {
-            context->ctx.divzero = 1;
+            GMPY_FLAGS(context)->divzero = 1;
             if (context->ctx.traps & TRAP_DIVZERO) {
                 GMPY_DIVZERO("divmod() division by zero");
                 goto error;
@@ -423,7 +437,7 @@ GMPy_Real_DivMod_2(PyObject *x, PyObject *y, CTXT_Object *context)
         }
 
         if (mpfr_nan_p(tempx->f) || mpfr_nan_p(tempy->f) || mpfr_inf_p(tempx->f)) {
-            context->ctx.invalid = 1;
+            GMPY_FLAGS(context)->invalid = 1;
             if (context->ctx.traps & TRAP_INVALID) {
                 GMPY_INVALID("divmod() invalid operation");
                 goto error;
@@ -434,7 +448,7 @@ GMPy_Real_DivMod_2(PyObject *x, PyObject *y, CTXT_Object *context)
             }
         }
         else if (mpfr_inf_p(tempy->f)) {
-            context->ctx.invalid = 1;
+            GMPY_FLAGS(context)->invalid = 1;
             if (context->ctx.traps & TRAP_INVALID) {
                 GMPY_INVALID("divmod() invalid operation");
                 goto error;
@@ -517,13 +531,21 @@ GMPy_Real_DivMod_2(PyObject *x, PyObject *y, CTXT_Object *context)
     return NULL;
 }
 
+GMPY_PROFILE_WRAP(PyObject *, GMPy_MPFR_DivMod_Slot, (PyObject *x, PyObject *y),
+                  (x, y), gmpy_profile_bits2(x, y))
+
 static PyObject *
-GMPy_MPFR_DivMod_Slot(PyObject *x, PyObject *y)
+GMPy_MPFR_DivMod_Slot_Impl(PyObject *x, PyObject *y)
 {
-    if (IS_REAL(x) && IS_REAL(y))
+    int xtype, ytype;
+
+    xtype = GMPy_ObjectType(x);
+    ytype = GMPy_ObjectType(y);
+
+    if (IS_TYPE_REAL(xtype) && IS_TYPE_REAL(ytype))
         return GMPy_Real_DivMod(x, y, NULL);
 
-    if (IS_COMPLEX(x) && IS_COMPLEX(y))
+    if (IS_TYPE_COMPLEX(xtype) && IS_TYPE_COMPLEX(ytype))
         return GMPy_Complex_DivMod(x, y, NULL);
 
     Py_RETURN_NOTIMPLEMENTED;
@@ -536,8 +558,11 @@ GMPy_Complex_DivMod(PyObject *x, PyObject *y, CTXT_Object *context)
     return NULL;
 }
 
+GMPY_PROFILE_WRAP(PyObject *, GMPy_MPC_DivMod_Slot, (PyObject *x, PyObject *y),
+                  (x, y), gmpy_profile_bits2(x, y))
+
 static PyObject *
-GMPy_MPC_DivMod_Slot(PyObject *x, PyObject *y)
+GMPy_MPC_DivMod_Slot_Impl(PyObject *x, PyObject *y)
 {
     return GMPy_Complex_DivMod(x, y, NULL);
 }
@@ -550,19 +575,27 @@ PyDoc_STRVAR(GMPy_doc_divmod,
 "  RoundToNearest. Overflow, underflow, and inexact exceptions are not\n"
 "  supported. Special values are handled as per Python's behavior.");
 
+GMPY_PROFILE_WRAP(PyObject *, GMPy_Number_DivMod, (PyObject *x, PyObject *y, CTXT_Object *context),
+                  (x, y, context), gmpy_profile_bits2(x, y))
+
 static PyObject *
-GMPy_Number_DivMod(PyObject *x, PyObject *y, CTXT_Object *context)
+GMPy_Number_DivMod_Impl(PyObject *x, PyObject *y, CTXT_Object *context)
 {
-    if (IS_INTEGER(x) && IS_INTEGER(y))
+    int xtype, ytype;
+
+    xtype = GMPy_ObjectType(x);
+    ytype = GMPy_ObjectType(y);
+
+    if (IS_TYPE_INTEGER(xtype) && IS_TYPE_INTEGER(ytype))
         return GMPy_Integer_DivMod(x, y, context);
 
-    if (IS_RATIONAL(x) && IS_RATIONAL(y))
+    if (IS_TYPE_RATIONAL(xtype) && IS_TYPE_RATIONAL(ytype))
         return GMPy_Rational_DivMod(x, y, context);
 
-    if (IS_REAL(x) && IS_REAL(y))
+    if (IS_TYPE_REAL(xtype) && IS_TYPE_REAL(ytype))
         return GMPy_Real_DivMod(x, y, context);
 
-    if (IS_COMPLEX(x) && IS_COMPLEX(y))
+    if (IS_TYPE_COMPLEX(xtype) && IS_TYPE_COMPLEX(ytype))
         return GMPy_Complex_DivMod(x, y, context);
 
     TYPE_ERROR("divmod() argument type not supported");
@@ -576,11 +609,11 @@ PyDoc_STRVAR(GMPy_doc_context_divmod,
 "mpfr arguments to context.div_mod().");
 
 static PyObject *
-GMPy_Context_DivMod(PyObject *self, PyObject *args)
+GMPy_Context_DivMod(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     CTXT_Object *context = NULL;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (nargs != 2) {
         TYPE_ERROR("divmod() requires 2 arguments.");
         return NULL;
     }
@@ -592,7 +625,8 @@ GMPy_Context_DivMod(PyObject *self, PyObject *args)
         CHECK_CONTEXT(context);
     }
 
-    return GMPy_Number_DivMod(PyTuple_GET_ITEM(args, 0), PyTuple_GET_ITEM(args, 1),
+    return GMPy_Number_DivMod(args[0], args[1],
                               context);
 }
+GMPY_FASTCALL_WRAPPER(GMPy_Context_DivMod)
 
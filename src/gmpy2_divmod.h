@@ -50,7 +50,7 @@ static PyObject * GMPy_MPQ_DivMod_Slot(PyObject *x, PyObject *y);
 static PyObject * GMPy_MPFR_DivMod_Slot(PyObject *x, PyObject *y);
 static PyObject * GMPy_MPC_DivMod_Slot(PyObject *x, PyObject *y);
 
-static PyObject * GMPy_Context_DivMod(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_DivMod(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 
 #ifdef __cplusplus
 }
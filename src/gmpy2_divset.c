@@ -0,0 +1,281 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_divset.c                                                          *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+PyDoc_STRVAR(GMPy_doc_divisorset_factory,
+"DivisorSet(divs) -> DivisorSet\n\n"
+"Return an object that tests integers for divisibility by each of the\n"
+"positive integers in divs, which must fit in an unsigned long. The\n"
+"divisors are grouped once so that every test makes one pass over the\n"
+"limbs of n for each group of divisors whose product fits in a limb.");
+
+static PyObject *
+GMPy_DivisorSet_Factory(PyObject *self, PyObject *other)
+{
+    DivisorSet_Object *result;
+    PyObject *seq, **items;
+    Py_ssize_t i, n;
+    unsigned long d;
+    mp_limb_t product = 1;
+
+    if (!(seq = PySequence_Fast(other, "DivisorSet() requires a sequence of integers")))
+        return NULL;
+    n = PySequence_Fast_GET_SIZE(seq);
+    items = PySequence_Fast_ITEMS(seq);
+
+    if (!(result = PyObject_New(DivisorSet_Object, &DivisorSet_Type))) {
+        Py_DECREF(seq);
+        return NULL;
+    }
+    result->ndivs = n;
+    result->ngroups = 0;
+    result->divs = GMPY_MALLOC(sizeof(unsigned long) * (n ? n : 1));
+    result->products = GMPY_MALLOC(sizeof(mp_limb_t) * (n ? n : 1));
+    result->ends = GMPY_MALLOC(sizeof(Py_ssize_t) * (n ? n : 1));
+    if (!result->divs || !result->products || !result->ends) {
+        PyErr_NoMemory();
+        goto error;
+    }
+
+    for (i = 0; i < n; i++) {
+        if (!IS_INTEGER(items[i])) {
+            TYPE_ERROR("DivisorSet() requires a sequence of integers");
+            goto error;
+        }
+        d = c_ulong_From_Integer(items[i]);
+        if (d == (unsigned long)(-1) && PyErr_Occurred())
+            goto error;
+        if (d == 0) {
+            VALUE_ERROR("DivisorSet() requires positive divisors");
+            goto error;
+        }
+        result->divs[i] = d;
+
+        /* Start a new group when the product would overflow a limb. */
+        if (i > 0 && product > GMP_NUMB_MAX / d) {
+            result->products[result->ngroups] = product;
+            result->ends[result->ngroups++] = i;
+            product = 1;
+        }
+        product *= d;
+    }
+    if (n > 0) {
+        result->products[result->ngroups] = product;
+        result->ends[result->ngroups++] = n;
+    }
+
+    Py_DECREF(seq);
+    return (PyObject*)result;
+
+  error:
+    Py_DECREF(seq);
+    Py_DECREF((PyObject*)result);
+    return NULL;
+}
+
+static void
+GMPy_DivisorSet_Dealloc(DivisorSet_Object *self)
+{
+    GMPY_FREE(self->divs);
+    GMPY_FREE(self->products);
+    GMPY_FREE(self->ends);
+    PyObject_Del(self);
+}
+
+static PyObject *
+GMPy_DivisorSet_Repr_Slot(DivisorSet_Object *self)
+{
+    return Py2or3String_FromFormat("<DivisorSet of %zd divisors>", self->ndivs);
+}
+
+static PyObject *
+GMPy_DivisorSet_GetDivisors(DivisorSet_Object *self, void *closure)
+{
+    PyObject *result, *item;
+    Py_ssize_t i;
+
+    if (!(result = PyList_New(self->ndivs)))
+        return NULL;
+    for (i = 0; i < self->ndivs; i++) {
+        if (!(item = PyIntOrLong_FromSize_t(self->divs[i]))) {
+            Py_DECREF(result);
+            return NULL;
+        }
+        PyList_SET_ITEM(result, i, item);
+    }
+    return result;
+}
+
+/* Set hit[i] to 1 if divs[i] divides n, else 0. */
+
+static void
+divset_test(DivisorSet_Object *self, mpz_srcptr n, char *hit)
+{
+    mp_size_t size = mpz_size(n);
+    mp_limb_t rem;
+    Py_ssize_t g, i = 0;
+
+    for (g = 0; g < self->ngroups; g++) {
+        rem = size ? mpn_mod_1(n->_mp_d, size, self->products[g]) : 0;
+        for (; i < self->ends[g]; i++)
+            hit[i] = (rem % self->divs[i]) == 0;
+    }
+}
+
+/* Run the test for the integer argument other. Returns a buffer with one
+ * entry per divisor, or NULL on error. */
+
+static char *
+divset_apply(PyObject *self, PyObject *other, const char *name)
+{
+    DivisorSet_Object *set = (DivisorSet_Object *)self;
+    MPZ_Object *tempn;
+    char *hit;
+
+    if (!IS_INTEGER(other) || !(tempn = GMPy_MPZ_From_Integer(other, NULL))) {
+        PyErr_Format(PyExc_TypeError, "%s() requires an integer argument", name);
+        return NULL;
+    }
+    if (!(hit = GMPY_MALLOC(set->ndivs ? set->ndivs : 1))) {
+        Py_DECREF((PyObject*)tempn);
+        PyErr_NoMemory();
+        return NULL;
+    }
+    divset_test(set, tempn->z, hit);
+    Py_DECREF((PyObject*)tempn);
+    return hit;
+}
+
+PyDoc_STRVAR(GMPy_doc_divisorset_divides,
+"D.divides(n) -> list\n\n"
+"Return the list of the divisors of D that divide n, in the order they\n"
+"were given.");
+
+static PyObject *
+GMPy_DivisorSet_Divides(PyObject *self, PyObject *other)
+{
+    DivisorSet_Object *set = (DivisorSet_Object *)self;
+    PyObject *result, *item;
+    Py_ssize_t i;
+    char *hit;
+
+    if (!(hit = divset_apply(self, other, "divides")))
+        return NULL;
+
+    if ((result = PyList_New(0))) {
+        for (i = 0; i < set->ndivs; i++) {
+            if (!hit[i])
+                continue;
+            if (!(item = PyIntOrLong_FromSize_t(set->divs[i])) ||
+                PyList_Append(result, item) < 0) {
+                Py_XDECREF(item);
+                Py_CLEAR(result);
+                break;
+            }
+            Py_DECREF(item);
+        }
+    }
+    GMPY_FREE(hit);
+    return result;
+}
+
+PyDoc_STRVAR(GMPy_doc_divisorset_mask,
+"D.mask(n) -> mpz\n\n"
+"Return an integer with bit i set if the i-th divisor of D divides n.");
+
+static PyObject *
+GMPy_DivisorSet_Mask(PyObject *self, PyObject *other)
+{
+    DivisorSet_Object *set = (DivisorSet_Object *)self;
+    MPZ_Object *result;
+    Py_ssize_t i;
+    char *hit;
+
+    if (!(hit = divset_apply(self, other, "mask")))
+        return NULL;
+
+    if ((result = GMPy_MPZ_New(NULL))) {
+        mpz_set_ui(result->z, 0);
+        for (i = 0; i < set->ndivs; i++) {
+            if (hit[i])
+                mpz_setbit(result->z, (mp_bitcnt_t)i);
+        }
+    }
+    GMPY_FREE(hit);
+    return (PyObject*)result;
+}
+
+static PyGetSetDef GMPy_DivisorSet_getseters[] =
+{
+    { "divisors", (getter)GMPy_DivisorSet_GetDivisors, NULL, "the divisors", NULL },
+    {NULL}
+};
+
+static PyMethodDef GMPy_DivisorSet_methods[] =
+{
+    { "divides", GMPy_DivisorSet_Divides, METH_O, GMPy_doc_divisorset_divides },
+    { "mask", GMPy_DivisorSet_Mask, METH_O, GMPy_doc_divisorset_mask },
+    { NULL, NULL, 1 }
+};
+
+static PyTypeObject DivisorSet_Type =
+{
+#ifdef PY3
+    PyVarObject_HEAD_INIT(0, 0)
+#else
+    PyObject_HEAD_INIT(0)
+        0,                                   /* ob_size          */
+#endif
+    "gmpy2 DivisorSet",                      /* tp_name          */
+    sizeof(DivisorSet_Object),               /* tp_basicsize     */
+        0,                                   /* tp_itemsize      */
+    (destructor) GMPy_DivisorSet_Dealloc,    /* tp_dealloc       */
+        0,                                   /* tp_print         */
+        0,                                   /* tp_getattr       */
+        0,                                   /* tp_setattr       */
+        0,                                   /* tp_reserved      */
+    (reprfunc) GMPy_DivisorSet_Repr_Slot,    /* tp_repr          */
+        0,                                   /* tp_as_number     */
+        0,                                   /* tp_as_sequence   */
+        0,                                   /* tp_as_mapping    */
+        0,                                   /* tp_hash          */
+        0,                                   /* tp_call          */
+        0,                                   /* tp_str           */
+        0,                                   /* tp_getattro      */
+        0,                                   /* tp_setattro      */
+        0,                                   /* tp_as_buffer     */
+    Py_TPFLAGS_DEFAULT,                      /* tp_flags         */
+    "GMPY2 divisor set",                     /* tp_doc           */
+        0,                                   /* tp_traverse      */
+        0,                                   /* tp_clear         */
+        0,                                   /* tp_richcompare   */
+        0,                                   /* tp_weaklistoffset*/
+        0,                                   /* tp_iter          */
+        0,                                   /* tp_iternext      */
+    GMPy_DivisorSet_methods,                 /* tp_methods       */
+        0,                                   /* tp_members       */
+    GMPy_DivisorSet_getseters,               /* tp_getset        */
+};
@@ -0,0 +1,65 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_divset.h                                                          *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GMPY_DIVSET_H
+#define GMPY_DIVSET_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* A DivisorSet tests an integer for divisibility by a fixed list of word
+ * sized divisors. Consecutive divisors are grouped so that the product of
+ * each group fits in a limb; one pass over the limbs of n per group gives
+ * the residue modulo the product, and the residues modulo the divisors of
+ * the group follow from single limb divisions.
+ */
+
+typedef struct {
+    PyObject_HEAD
+    unsigned long *divs;            /* the divisors, in the given order */
+    mp_limb_t *products;            /* product of the divisors of each group */
+    Py_ssize_t *ends;               /* end of each group in divs */
+    Py_ssize_t ndivs;
+    Py_ssize_t ngroups;
+} DivisorSet_Object;
+
+static PyTypeObject DivisorSet_Type;
+
+#define DivisorSet_Check(v) (((PyObject*)v)->ob_type == &DivisorSet_Type)
+
+static PyObject * GMPy_DivisorSet_Factory(PyObject *self, PyObject *other);
+static void       GMPy_DivisorSet_Dealloc(DivisorSet_Object *self);
+static PyObject * GMPy_DivisorSet_Repr_Slot(DivisorSet_Object *self);
+static PyObject * GMPy_DivisorSet_GetDivisors(DivisorSet_Object *self, void *closure);
+static PyObject * GMPy_DivisorSet_Divides(PyObject *self, PyObject *other);
+static PyObject * GMPy_DivisorSet_Mask(PyObject *self, PyObject *other);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
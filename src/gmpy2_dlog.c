@@ -0,0 +1,469 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_dlog.c                                                            *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* This file implements discrete_log(). The order of g is found from the
+ * factorization of the group order and the logarithm is split by
+ * Pohlig-Hellman into one logarithm in a subgroup of prime order q for
+ * each digit in base q. Those are solved by baby step, giant step with a
+ * compact hash table when q has at most DLOG_BSGS_MAX_BITS bits, and by
+ * Pollard's rho otherwise. The results are combined with the Chinese
+ * remainder theorem.
+ */
+
+#define DLOG_BSGS_MAX_BITS 36
+#define DLOG_RHO_RETRIES 32
+#define DLOG_SIGNAL_STEPS 16384
+
+/* ******************************************************************
+ * Baby step, giant step
+ *
+ * The table only stores the low limb of each baby step and its index.
+ * A match is confirmed by an exponentiation, so the rare collisions of
+ * the low limbs cost nothing but time.
+ * ******************************************************************/
+
+typedef struct {
+    mp_limb_t *keys;
+    unsigned long *index;   /* baby step + 1, or 0 for an empty slot */
+    size_t mask;
+} dlog_table;
+
+static size_t
+dlog_hash(mp_limb_t key, size_t mask)
+{
+    return (size_t)((key ^ (key >> 29)) * 0x9E3779B97F4A7C15ULL >> 7) & mask;
+}
+
+/* Set x to the logarithm of h to the base g of prime order q modulo p.
+ * Returns 1 on success, 0 if there is no solution and -1 on error. */
+
+static int
+dlog_bsgs(mpz_t x, mpz_t g, mpz_t h, mpz_t q, mpz_t p)
+{
+    dlog_table T;
+    mpz_t t, c, b;
+    unsigned long m, j, i;
+    size_t slot, size;
+    mp_limb_t key;
+    int found = 0;
+
+    mpz_init(t);
+    mpz_init(c);
+    mpz_init(b);
+    mpz_sqrt(t, q);
+    m = mpz_get_ui(t) + 1;
+    for (size = 2; size < 2 * m; size *= 2)
+        ;
+    T.mask = size - 1;
+    T.keys = GMPY_MALLOC(size * sizeof(mp_limb_t));
+    T.index = GMPY_MALLOC(size * sizeof(unsigned long));
+    if (!T.keys || !T.index) {
+        PyErr_NoMemory();
+        found = -1;
+        goto done;
+    }
+    memset(T.index, 0, size * sizeof(unsigned long));
+
+    /* Baby steps g**j for 0 <= j < m. */
+    mpz_set_ui(t, 1);
+    for (j = 0; j < m; j++) {
+        key = mpz_getlimbn(t, 0);
+        for (slot = dlog_hash(key, T.mask); T.index[slot]; slot = (slot + 1) & T.mask)
+            ;
+        T.keys[slot] = key;
+        T.index[slot] = j + 1;
+        mpz_mul(t, t, g);
+        mpz_tdiv_r(t, t, p);
+    }
+
+    /* Giant steps h * g**(-m*i) for 0 <= i < m. */
+    if (!mpz_invert(c, t, p))
+        goto done;
+    mpz_set(t, h);
+    for (i = 0; i < m && !found; i++) {
+        if (i % DLOG_SIGNAL_STEPS == 0 && PyErr_CheckSignals()) {
+            found = -1;
+            break;
+        }
+        key = mpz_getlimbn(t, 0);
+        for (slot = dlog_hash(key, T.mask); T.index[slot]; slot = (slot + 1) & T.mask) {
+            if (T.keys[slot] != key)
+                continue;
+            mpz_powm_ui(b, g, T.index[slot] - 1, p);
+            if (mpz_cmp(b, t) == 0) {
+                mpz_set_ui(x, i);
+                mpz_mul_ui(x, x, m);
+                mpz_add_ui(x, x, T.index[slot] - 1);
+                found = 1;
+                break;
+            }
+        }
+        if (found)
+            break;
+        mpz_mul(t, t, c);
+        mpz_tdiv_r(t, t, p);
+    }
+    if (found == 1)
+        mpz_mod(x, x, q);
+
+  done:
+    GMPY_FREE(T.keys);
+    GMPY_FREE(T.index);
+    mpz_clear(t);
+    mpz_clear(c);
+    mpz_clear(b);
+    return found;
+}
+
+/* ******************************************************************
+ * Pollard's rho
+ *
+ * The walk x = g**a * h**b multiplies by g, squares, or multiplies by h,
+ * depending on a hash of x. A cycle is found with Brent's method, and
+ * then a + b*log(h) == a' + b'*log(h) mod q.
+ * ******************************************************************/
+
+static void
+dlog_rho_step(mpz_t x, mpz_t a, mpz_t b, mpz_t g, mpz_t h, mpz_t q, mpz_t p)
+{
+    switch (dlog_hash(mpz_getlimbn(x, 0), ~(size_t)0) % 3) {
+    case 0:
+        mpz_mul(x, x, g);
+        mpz_add_ui(a, a, 1);
+        break;
+    case 1:
+        mpz_mul(x, x, x);
+        mpz_mul_2exp(a, a, 1);
+        mpz_mul_2exp(b, b, 1);
+        if (mpz_cmp(b, q) >= 0)
+            mpz_sub(b, b, q);
+        break;
+    default:
+        mpz_mul(x, x, h);
+        mpz_add_ui(b, b, 1);
+        break;
+    }
+    if (mpz_cmp(a, q) >= 0)
+        mpz_sub(a, a, q);
+    if (mpz_cmp(b, q) >= 0)
+        mpz_sub(b, b, q);
+    mpz_tdiv_r(x, x, p);
+}
+
+/* Set x to the logarithm of h to the base g of prime order q modulo p.
+ * Returns 1 on success, 0 if no solution was found and -1 on error. */
+
+static int
+dlog_rho(mpz_t x, mpz_t g, mpz_t h, mpz_t q, mpz_t p)
+{
+    mpz_t y, a, b, ys, as, bs, t;
+    unsigned long seed, power, lam, steps = 0;
+    int found = 0;
+
+    mpz_init(y);
+    mpz_init(a);
+    mpz_init(b);
+    mpz_init(ys);
+    mpz_init(as);
+    mpz_init(bs);
+    mpz_init(t);
+
+    for (seed = 1; seed <= DLOG_RHO_RETRIES && !found; seed++) {
+        /* Start from g**seed * h. */
+        mpz_set_ui(a, seed);
+        mpz_mod(a, a, q);
+        mpz_set_ui(b, 1);
+        mpz_powm(y, g, a, p);
+        mpz_mul(y, y, h);
+        mpz_tdiv_r(y, y, p);
+        mpz_set(ys, y);
+        mpz_set(as, a);
+        mpz_set(bs, b);
+        power = 1;
+        lam = 0;
+        for (;;) {
+            dlog_rho_step(y, a, b, g, h, q, p);
+            if (++steps % DLOG_SIGNAL_STEPS == 0 && PyErr_CheckSignals()) {
+                found = -1;
+                goto done;
+            }
+            if (mpz_cmp(y, ys) == 0)
+                break;
+            if (++lam == power) {
+                mpz_set(ys, y);
+                mpz_set(as, a);
+                mpz_set(bs, b);
+                power *= 2;
+                lam = 0;
+            }
+        }
+
+        mpz_sub(t, b, bs);
+        if (!mpz_invert(t, t, q))
+            continue;
+        mpz_sub(x, as, a);
+        mpz_mul(x, x, t);
+        mpz_mod(x, x, q);
+        mpz_powm(t, g, x, p);
+        found = (mpz_cmp(t, h) == 0);
+    }
+
+  done:
+    mpz_clear(y);
+    mpz_clear(a);
+    mpz_clear(b);
+    mpz_clear(ys);
+    mpz_clear(as);
+    mpz_clear(bs);
+    mpz_clear(t);
+    return found;
+}
+
+/* ******************************************************************
+ * Pohlig-Hellman
+ * ******************************************************************/
+
+/* Replace n, a multiple of the order of g modulo p with the factorization
+ * F, by the order of g, and update F to match. */
+
+static void
+dlog_order(mpz_t n, factor_list *F, mpz_t g, mpz_t p)
+{
+    mpz_t t, r;
+    size_t i, j = 0;
+
+    mpz_init(t);
+    mpz_init(r);
+    for (i = 0; i < F->len; i++) {
+        while (F->items[i].e > 0) {
+            mpz_divexact(t, n, F->items[i].p);
+            mpz_powm(r, g, t, p);
+            if (mpz_cmp_ui(r, 1) != 0)
+                break;
+            mpz_swap(n, t);
+            F->items[i].e--;
+        }
+        if (F->items[i].e > 0)
+            F->items[j++] = F->items[i];
+        else
+            mpz_clear(F->items[i].p);
+    }
+    F->len = j;
+    mpz_clear(t);
+    mpz_clear(r);
+}
+
+/* Set x to the logarithm of h to the base g modulo p, where g has order n
+ * with the factorization F. Returns 1 on success, 0 if there is no
+ * solution and -1 on error. */
+
+static int
+dlog_pohlig_hellman(mpz_t x, mpz_t g, mpz_t h, mpz_t n, factor_list *F, mpz_t p)
+{
+    mpz_t gamma, hk, e, xq, qk, d, t, mod;
+    mpz_ptr q;
+    unsigned long i;
+    size_t f;
+    int r = 1;
+
+    mpz_init(gamma);
+    mpz_init(hk);
+    mpz_init(e);
+    mpz_init(xq);
+    mpz_init(qk);
+    mpz_init(d);
+    mpz_init(t);
+    mpz_init_set_ui(mod, 1);
+    mpz_set_ui(x, 0);
+
+    for (f = 0; f < F->len && r > 0; f++) {
+        q = F->items[f].p;
+
+        /* gamma = g**(n/q) has order q. Find the base q digits of x mod
+         * q**k from (h * g**(-xq))**(n / q**(i+1)) == gamma**digit. */
+        mpz_divexact(e, n, q);
+        mpz_powm(gamma, g, e, p);
+        mpz_set_ui(xq, 0);
+        mpz_set_ui(qk, 1);
+        for (i = 0; i < F->items[f].e; i++) {
+            mpz_powm(t, g, xq, p);
+            if (!mpz_invert(t, t, p)) {
+                r = 0;
+                break;
+            }
+            mpz_mul(hk, h, t);
+            mpz_tdiv_r(hk, hk, p);
+            mpz_mul(t, qk, q);
+            mpz_divexact(e, n, t);
+            mpz_powm(hk, hk, e, p);
+
+            mpz_powm(t, hk, q, p);
+            if (mpz_cmp_ui(t, 1) != 0) {
+                r = 0;
+                break;
+            }
+            if (mpz_cmp_ui(hk, 1) == 0)
+                mpz_set_ui(d, 0);
+            else if (mpz_sizeinbase(q, 2) <= DLOG_BSGS_MAX_BITS)
+                r = dlog_bsgs(d, gamma, hk, q, p);
+            else
+                r = dlog_rho(d, gamma, hk, q, p);
+            if (r <= 0)
+                break;
+            mpz_addmul(xq, d, qk);
+            mpz_mul(qk, qk, q);
+        }
+        if (r <= 0)
+            break;
+
+        /* Combine x mod mod with xq mod qk. */
+        mpz_sub(t, xq, x);
+        mpz_invert(d, mod, qk);
+        mpz_mul(t, t, d);
+        mpz_mod(t, t, qk);
+        mpz_addmul(x, mod, t);
+        mpz_mul(mod, mod, qk);
+    }
+
+    mpz_clear(gamma);
+    mpz_clear(hk);
+    mpz_clear(e);
+    mpz_clear(xq);
+    mpz_clear(qk);
+    mpz_clear(d);
+    mpz_clear(t);
+    mpz_clear(mod);
+    return r;
+}
+
+PyDoc_STRVAR(GMPy_doc_mpz_function_discrete_log,
+"discrete_log(g, h, p, order=None) -> mpz\n\n"
+"Return the smallest x >= 0 such that g**x == h mod p. g must be coprime\n"
+"to p. order must be a multiple of the order of g modulo p; if it is\n"
+"None, the order of the group of units modulo p is used, which requires\n"
+"factoring p. The order is factored with factor() and the logarithm is\n"
+"found with the Pohlig-Hellman method, so the time depends on the\n"
+"largest prime factor of the order of g. Raises ValueError if there is\n"
+"no solution.");
+
+static PyObject *
+GMPy_MPZ_Function_DiscreteLog(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    static char *kwlist[] = {"g", "h", "p", "order", NULL};
+    PyObject *argg, *argh, *argp, *argorder = Py_None;
+    MPZ_Object *tempg = NULL, *temph = NULL, *tempp = NULL, *temporder = NULL;
+    MPZ_Object *result = NULL;
+    factor_list F = {NULL, 0, 0};
+    mpz_t g, h, n, t;
+    size_t i;
+    int r = -1;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OOO|O:discrete_log", kwlist,
+                                     &argg, &argh, &argp, &argorder))
+        return NULL;
+
+    if (!(tempg = GMPy_MPZ_From_Integer(argg, NULL)) ||
+        !(temph = GMPy_MPZ_From_Integer(argh, NULL)) ||
+        !(tempp = GMPy_MPZ_From_Integer(argp, NULL)) ||
+        (argorder != Py_None && !(temporder = GMPy_MPZ_From_Integer(argorder, NULL)))) {
+        TYPE_ERROR("discrete_log() requires integer arguments");
+        goto cleanup;
+    }
+
+    if (mpz_cmp_ui(tempp->z, 1) <= 0) {
+        VALUE_ERROR("discrete_log() requires p > 1");
+        goto cleanup;
+    }
+    if (temporder && mpz_sgn(temporder->z) <= 0) {
+        VALUE_ERROR("discrete_log() requires order > 0");
+        goto cleanup;
+    }
+
+    mpz_init(g);
+    mpz_init(h);
+    mpz_init(n);
+    mpz_init(t);
+    mpz_mod(g, tempg->z, tempp->z);
+    mpz_mod(h, temph->z, tempp->z);
+
+    mpz_gcd(t, g, tempp->z);
+    if (mpz_cmp_ui(t, 1) != 0) {
+        VALUE_ERROR("discrete_log() requires g coprime to p");
+        goto done;
+    }
+
+    if (temporder) {
+        mpz_set(n, temporder->z);
+    }
+    else {
+        /* Euler's phi(p). */
+        if (factor_mpz(&F, tempp->z, 0) < 0)
+            goto done;
+        mpz_set_ui(n, 1);
+        for (i = 0; i < F.len; i++) {
+            mpz_pow_ui(t, F.items[i].p, F.items[i].e - 1);
+            mpz_mul(n, n, t);
+            mpz_sub_ui(t, F.items[i].p, 1);
+            mpz_mul(n, n, t);
+        }
+        factor_list_clear(&F);
+    }
+
+    mpz_powm(t, g, n, tempp->z);
+    if (mpz_cmp_ui(t, 1) != 0) {
+        VALUE_ERROR("discrete_log() order is not a multiple of the order of g");
+        goto done;
+    }
+
+    if (!(result = GMPy_MPZ_New(NULL)))
+        goto done;
+    if (factor_mpz(&F, n, 0) < 0)
+        goto done;
+    dlog_order(n, &F, g, tempp->z);
+
+    if ((r = dlog_pohlig_hellman(result->z, g, h, n, &F, tempp->z)) > 0) {
+        mpz_powm(t, g, result->z, tempp->z);
+        r = (mpz_cmp(t, h) == 0);
+    }
+    if (r == 0)
+        VALUE_ERROR("discrete_log() no solution exists");
+
+  done:
+    if (r <= 0)
+        Py_CLEAR(result);
+    factor_list_clear(&F);
+    mpz_clear(g);
+    mpz_clear(h);
+    mpz_clear(n);
+    mpz_clear(t);
+  cleanup:
+    Py_XDECREF((PyObject*)tempg);
+    Py_XDECREF((PyObject*)temph);
+    Py_XDECREF((PyObject*)tempp);
+    Py_XDECREF((PyObject*)temporder);
+    return (PyObject*)result;
+}
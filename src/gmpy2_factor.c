@@ -0,0 +1,939 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_factor.c                                                          *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* This file implements factor() and factorint(). The powers of 2 and the
+ * odd primes below PRP_TRIAL_MAX are removed by trial division with the
+ * prp_trial table. Each remaining cofactor is certified with the BPSW test
+ * or split in turn by:
+ *
+ *   1) Pollard's rho with Brent's cycle detection; single limb cofactors
+ *      use the word-size Montgomery multiplication from gmpy_mpz_prp.c and
+ *      are always split here.
+ *   2) Pollard's p-1 method, stage 1 only.
+ *   3) The elliptic curve method on Montgomery curves with Suyama's
+ *      parametrization, using increasing bounds. Stage 2 is the standard
+ *      baby step, giant step continuation with D = 2310.
+ *
+ * Steps 1 to 3 only use the loop-local scratch space and GMP, so they run
+ * without the GIL once the amount of work reaches the nogil threshold.
+ * Interrupts are checked between elliptic curves.
+ */
+
+#define FACTOR_RHO_ITERS (1UL << 16)
+#define FACTOR_PM1_B1 100000UL
+#define FACTOR_CHUNK_BITS 1024
+
+/* ******************************************************************
+ * Lists of factors
+ * ******************************************************************/
+
+static void
+factor_list_clear(factor_list *L)
+{
+    size_t i;
+
+    for (i = 0; i < L->len; i++)
+        mpz_clear(L->items[i].p);
+    GMPY_FREE(L->items);
+    L->items = NULL;
+    L->len = L->alloc = 0;
+}
+
+/* Append an entry with exponent e and return its initialized mpz, or NULL
+ * with an exception set. */
+
+static mpz_ptr
+factor_list_add(factor_list *L, unsigned long e)
+{
+    factor_entry *items;
+    size_t alloc;
+
+    if (L->len == L->alloc) {
+        alloc = L->alloc ? 2 * L->alloc : 16;
+        if (!(items = GMPY_REALLOC(L->items, alloc * sizeof(factor_entry)))) {
+            PyErr_NoMemory();
+            return NULL;
+        }
+        L->items = items;
+        L->alloc = alloc;
+    }
+    mpz_init(L->items[L->len].p);
+    L->items[L->len].e = e;
+    return L->items[L->len++].p;
+}
+
+static int
+factor_entry_cmp(const void *a, const void *b)
+{
+    return mpz_cmp(((const factor_entry*)a)->p, ((const factor_entry*)b)->p);
+}
+
+/* Sort the entries and merge the exponents of equal factors. */
+
+static void
+factor_list_normalize(factor_list *L)
+{
+    size_t i, j = 0;
+
+    if (L->len == 0)
+        return;
+    qsort(L->items, L->len, sizeof(factor_entry), factor_entry_cmp);
+    for (i = 1; i < L->len; i++) {
+        if (mpz_cmp(L->items[i].p, L->items[j].p) == 0) {
+            L->items[j].e += L->items[i].e;
+            mpz_clear(L->items[i].p);
+        }
+        else {
+            L->items[++j] = L->items[i];
+        }
+    }
+    L->len = j + 1;
+}
+
+/* ******************************************************************
+ * Helpers
+ * ******************************************************************/
+
+/* Set z to the n limbs at ap. */
+
+static void
+factor_set_limbs(mpz_ptr z, mp_srcptr ap, mp_size_t n)
+{
+    mp_size_t j;
+
+    mpz_realloc2(z, n * GMP_NUMB_BITS);
+    for (j = 0; j < n; j++)
+        z->_mp_d[j] = ap[j];
+    while (n > 0 && z->_mp_d[n - 1] == 0)
+        n--;
+    z->_mp_size = (int)n;
+}
+
+/* Return 1 if 1 < d < n. */
+
+static int
+factor_proper(mpz_srcptr d, mpz_srcptr n)
+{
+    return mpz_cmp_ui(d, 1) > 0 && mpz_cmp(d, n) < 0;
+}
+
+/* A segmented sieve that returns the odd primes in increasing order, up
+ * to PRP_TRIAL_MAX**2. */
+
+#define FACTOR_SEGMENT 8192
+
+typedef struct {
+    unsigned long base;         /* sieve[i] stands for base + 2*i */
+    unsigned long pos;
+    unsigned char sieve[FACTOR_SEGMENT];
+} factor_sieve;
+
+static void
+factor_sieve_fill(factor_sieve *s)
+{
+    unsigned long hi = s->base + 2 * FACTOR_SEGMENT, p, j;
+    unsigned int i;
+
+    memset(s->sieve, 0, FACTOR_SEGMENT);
+    for (i = 0; i < PRP_TRIAL_PRIMES; i++) {
+        p = prp_trial.primes[i];
+        if (p * p >= hi)
+            break;
+        j = p * p;
+        if (j < s->base) {
+            j = (s->base + p - 1) / p * p;
+            if (!(j & 1))
+                j += p;
+        }
+        for (; j < hi; j += 2 * p)
+            s->sieve[(j - s->base) / 2] = 1;
+    }
+    if (s->base == 1)
+        s->sieve[0] = 1;
+    s->pos = 0;
+}
+
+static void
+factor_sieve_init(factor_sieve *s)
+{
+    s->base = 1;
+    factor_sieve_fill(s);
+}
+
+static unsigned long
+factor_sieve_next(factor_sieve *s)
+{
+    for (;;) {
+        for (; s->pos < FACTOR_SEGMENT; s->pos++) {
+            if (!s->sieve[s->pos])
+                return s->base + 2 * s->pos++;
+        }
+        s->base += 2 * FACTOR_SEGMENT;
+        factor_sieve_fill(s);
+    }
+}
+
+/* Multiply k by the largest power of p that does not exceed B1. */
+
+static void
+factor_mul_prime_power(mpz_ptr k, unsigned long p, unsigned long B1)
+{
+    unsigned long q = p;
+
+    while (q <= B1 / p)
+        q *= p;
+    mpz_mul_ui(k, k, q);
+}
+
+/* ******************************************************************
+ * Trial division
+ * ******************************************************************/
+
+/* Remove the prime factors of the odd n that are less than PRP_TRIAL_MAX
+ * and add them to out. If what remains is less than the square of the
+ * next prime, it is added to out as well and n is set to 1. Returns -1 on
+ * error. */
+
+static int
+factor_trial(mpz_ptr n, factor_list *out)
+{
+    mp_limb_t rem, p;
+    unsigned int g, i = 0;
+    unsigned long e;
+    mpz_ptr f;
+
+    for (g = 0; g < prp_trial.ngroups; g++) {
+        p = prp_trial.primes[i];
+        if (mpz_size(n) == 1 && mpz_getlimbn(n, 0) / p < p) {
+            if (mpz_cmp_ui(n, 1) > 0) {
+                if (!(f = factor_list_add(out, 1)))
+                    return -1;
+                mpz_swap(f, n);
+                mpz_set_ui(n, 1);
+            }
+            return 0;
+        }
+        rem = mpn_mod_1(n->_mp_d, mpz_size(n), prp_trial.products[g]);
+        for (; i < prp_trial.ends[g]; i++) {
+            p = prp_trial.primes[i];
+            if (rem % p)
+                continue;
+            e = 0;
+            do {
+                mpz_divexact_ui(n, n, (unsigned long)p);
+                e++;
+            } while (mpz_divisible_ui_p(n, (unsigned long)p));
+            if (!(f = factor_list_add(out, e)))
+                return -1;
+            mpz_set_ui(f, (unsigned long)p);
+        }
+    }
+    return 0;
+}
+
+/* ******************************************************************
+ * Pollard's rho method with Brent's cycle detection
+ * ******************************************************************/
+
+static mp_limb_t
+factor_gcd_word(mp_limb_t a, mp_limb_t n)
+{
+    return a ? mpn_gcd_1(&a, 1, n) : n;
+}
+
+#define FACTOR_RHO_WORD_STEP(y) \
+    do { \
+        (y) = prp_word_mul(&w, (y), (y)) + c; \
+        if ((y) < c || (y) >= w.n) \
+            (y) -= w.n; \
+    } while (0)
+
+/* Return a nontrivial factor of the odd composite n, or 0 if none was found
+ * with the first few polynomials. */
+
+static mp_limb_t
+factor_rho_word(mp_limb_t n)
+{
+    prp_word w;
+    mp_limb_t c, x, y, ys, q, g;
+    unsigned long r, k, i, m = 128;
+
+    prp_word_init(&w, n);
+    for (c = 1; c < 100; c++) {
+        y = 2;
+        q = w.one;
+        g = 1;
+        for (r = 1; g == 1; r *= 2) {
+            x = y;
+            for (i = 0; i < r; i++)
+                FACTOR_RHO_WORD_STEP(y);
+            for (k = 0; k < r && g == 1; k += m) {
+                ys = y;
+                for (i = 0; i < m && i < r - k; i++) {
+                    FACTOR_RHO_WORD_STEP(y);
+                    q = prp_word_mul(&w, q, x > y ? x - y : y - x);
+                }
+                g = factor_gcd_word(q, n);
+            }
+        }
+        if (g == n) {
+            do {
+                FACTOR_RHO_WORD_STEP(ys);
+                g = factor_gcd_word(x > ys ? x - ys : ys - x, n);
+            } while (g == 1);
+        }
+        if (g != n)
+            return g;
+    }
+    return 0;
+}
+
+/* Look for a factor d of the odd composite n with at most iters steps of
+ * Brent's variant for the polynomial x**2 + 1. Returns 1 if one was found. */
+
+static int
+factor_rho(mpz_ptr d, mpz_srcptr n, unsigned long iters)
+{
+    mp_size_t nl = mpz_size(n);
+    mpz_t scratch, t;
+    gmpy_mont M;
+    mp_ptr x, y, ys, q, c, diff;
+    unsigned long r, k, i, m = 128;
+    int found = 0;
+
+    mpz_init(t);
+    mpz_init(scratch);
+    mpz_realloc2(scratch, 8 * nl * GMP_NUMB_BITS);
+    mont_init(&M, n, scratch->_mp_d);
+    x = scratch->_mp_d + 2 * nl;
+    y = x + nl;
+    ys = y + nl;
+    q = ys + nl;
+    c = q + nl;
+    diff = c + nl;
+
+    mpz_set_ui(t, 2);
+    mont_from_mpz(&M, y, t, d);
+    mpz_set_ui(t, 1);
+    mont_from_mpz(&M, c, t, d);
+    mont_copy(&M, q, c);
+    mpz_set_ui(d, 1);
+
+    for (r = 1; r <= iters && mpz_cmp_ui(d, 1) == 0; r *= 2) {
+        mont_copy(&M, x, y);
+        for (i = 0; i < r; i++) {
+            mont_mul(&M, y, y, y);
+            mont_add(&M, y, y, c);
+        }
+        for (k = 0; k < r && mpz_cmp_ui(d, 1) == 0; k += m) {
+            mont_copy(&M, ys, y);
+            for (i = 0; i < m && i < r - k; i++) {
+                mont_mul(&M, y, y, y);
+                mont_add(&M, y, y, c);
+                mont_sub(&M, diff, x, y);
+                mont_mul(&M, q, q, diff);
+            }
+            factor_set_limbs(t, q, nl);
+            mpz_gcd(d, t, n);
+        }
+    }
+    if (mpz_cmp(d, n) == 0) {
+        do {
+            mont_mul(&M, ys, ys, ys);
+            mont_add(&M, ys, ys, c);
+            mont_sub(&M, diff, x, ys);
+            factor_set_limbs(t, diff, nl);
+            mpz_gcd(d, t, n);
+        } while (mpz_cmp_ui(d, 1) == 0);
+    }
+    found = factor_proper(d, n);
+
+    mpz_clear(scratch);
+    mpz_clear(t);
+    return found;
+}
+
+/* ******************************************************************
+ * Pollard's p-1 method
+ * ******************************************************************/
+
+/* Look for a factor d of the odd n such that d - 1 is B1-powersmooth.
+ * Returns 1 if one was found. */
+
+static int
+factor_pm1(mpz_ptr d, mpz_srcptr n, unsigned long B1)
+{
+    factor_sieve sieve;
+    mpz_t a, k;
+    unsigned long p;
+    int found;
+
+    mpz_init_set_ui(a, 2);
+    mpz_init_set_ui(k, 1);
+    factor_mul_prime_power(k, 2, B1);
+    factor_sieve_init(&sieve);
+    for (p = factor_sieve_next(&sieve); p <= B1; p = factor_sieve_next(&sieve)) {
+        factor_mul_prime_power(k, p, B1);
+        if (mpz_sizeinbase(k, 2) >= FACTOR_CHUNK_BITS) {
+            mpz_powm(a, a, k, n);
+            mpz_set_ui(k, 1);
+        }
+    }
+    mpz_powm(a, a, k, n);
+    mpz_sub_ui(a, a, 1);
+    mpz_gcd(d, a, n);
+    found = factor_proper(d, n);
+
+    mpz_clear(a);
+    mpz_clear(k);
+    return found;
+}
+
+/* ******************************************************************
+ * The elliptic curve method
+ *
+ * Points on the curve B*y**2 = x**3 + A*x**2 + x are kept as (X : Z) in
+ * Montgomery form, X in the first n limbs and Z in the next n limbs.
+ * ******************************************************************/
+
+/* Stage 2 uses the baby steps j*Q for 0 < j < ECM_D/2, gcd(j, ECM_D) == 1. */
+#define ECM_D 2310
+#define ECM_BABY 240
+
+typedef struct {
+    gmpy_mont M;
+    mp_ptr a24;             /* (A + 2) / 4 */
+    mp_ptr t;               /* 4n limbs of scratch */
+} ecm_curve;
+
+/* R = 2 * P. R may be P. */
+
+static void
+ecm_dbl(const ecm_curve *C, mp_ptr R, mp_srcptr P)
+{
+    const gmpy_mont *M = &C->M;
+    mp_size_t n = M->n;
+    mp_ptr s = C->t, d = s + n, t = d + n, u = t + n;
+
+    mont_add(M, s, P, P + n);
+    mont_sub(M, d, P, P + n);
+    mont_mul(M, s, s, s);
+    mont_mul(M, d, d, d);
+    mont_sub(M, t, s, d);
+    mont_mul(M, R, s, d);
+    mont_mul(M, u, C->a24, t);
+    mont_add(M, u, u, d);
+    mont_mul(M, R + n, t, u);
+}
+
+/* R = P + Q, where D = P - Q. R may be P or Q but not D. */
+
+static void
+ecm_add(const ecm_curve *C, mp_ptr R, mp_srcptr P, mp_srcptr Q, mp_srcptr D)
+{
+    const gmpy_mont *M = &C->M;
+    mp_size_t n = M->n;
+    mp_ptr a = C->t, b = a + n, c = b + n, e = c + n;
+
+    mont_sub(M, a, P, P + n);
+    mont_add(M, b, Q, Q + n);
+    mont_mul(M, a, a, b);
+    mont_add(M, c, P, P + n);
+    mont_sub(M, e, Q, Q + n);
+    mont_mul(M, c, c, e);
+    mont_add(M, b, a, c);
+    mont_sub(M, e, a, c);
+    mont_mul(M, b, b, b);
+    mont_mul(M, e, e, e);
+    mont_mul(M, R, D + n, b);
+    mont_mul(M, R + n, D, e);
+}
+
+static void
+ecm_copy(const ecm_curve *C, mp_ptr R, mp_srcptr P)
+{
+    mont_copy(&C->M, R, P);
+    mont_copy(&C->M, R + C->M.n, P + C->M.n);
+}
+
+/* Set R0 = k * P and R1 = (k + 1) * P for k > 0. P must not overlap R0 or
+ * R1. */
+
+static void
+ecm_ladder(const ecm_curve *C, mp_ptr R0, mp_ptr R1, mp_srcptr P, mpz_srcptr k)
+{
+    mp_bitcnt_t bit = mpz_sizeinbase(k, 2) - 1;
+
+    ecm_copy(C, R0, P);
+    ecm_dbl(C, R1, P);
+    while (bit-- > 0) {
+        if (mpz_tstbit(k, bit)) {
+            ecm_add(C, R0, R1, R0, P);
+            ecm_dbl(C, R1, R1);
+        }
+        else {
+            ecm_add(C, R1, R1, R0, P);
+            ecm_dbl(C, R0, R0);
+        }
+    }
+}
+
+/* Run one curve with stage 1 bound B1 and stage 2 bound B2 on the odd n.
+ * sigma > 5 selects the curve. Returns 1 if a factor d was found. */
+
+static int
+factor_ecm(mpz_ptr d, mpz_srcptr n, unsigned long B1, unsigned long B2,
+           unsigned long sigma)
+{
+    mp_size_t nl = mpz_size(n);
+    factor_sieve sieve;
+    ecm_curve C;
+    mpz_t scratch, u, v, x, z, t;
+    mp_ptr P, R0, R1, T, Q2, G, baby, acc, cross, tmp;
+    unsigned long p, j, m, nbaby;
+    int found = 0;
+
+    mpz_init(scratch);
+    mpz_init(u);
+    mpz_init(v);
+    mpz_init(x);
+    mpz_init(z);
+    mpz_init(t);
+    mpz_realloc2(scratch, (2 * ECM_BABY + 22) * nl * GMP_NUMB_BITS);
+    mont_init(&C.M, n, scratch->_mp_d);
+    C.t = scratch->_mp_d + 2 * nl;
+    C.a24 = C.t + 4 * nl;
+    P = C.a24 + nl;
+    R0 = P + 2 * nl;
+    R1 = R0 + 2 * nl;
+    T = R1 + 2 * nl;
+    Q2 = T + 2 * nl;
+    G = Q2 + 2 * nl;
+    acc = G + 2 * nl;
+    cross = acc + nl;
+    baby = cross + 2 * nl;
+
+    /* Suyama's parametrization: u = sigma**2 - 5, v = 4*sigma,
+     * x0 = u**3, z0 = v**3 and (A + 2) / 4 = (v - u)**3 * (3*u + v) /
+     * (16 * u**3 * v). */
+    mpz_set_ui(u, sigma);
+    mpz_mul_ui(u, u, sigma);
+    mpz_sub_ui(u, u, 5);
+    mpz_set_ui(v, sigma);
+    mpz_mul_2exp(v, v, 2);
+    mpz_powm_ui(x, u, 3, n);
+    mpz_powm_ui(z, v, 3, n);
+    mpz_mul(t, x, v);
+    mpz_mul_2exp(t, t, 4);
+    if (!mpz_invert(t, t, n)) {
+        mpz_mul(t, x, v);
+        mpz_gcd(d, t, n);
+        found = factor_proper(d, n);
+        goto done;
+    }
+    mpz_sub(d, v, u);
+    mpz_powm_ui(d, d, 3, n);
+    mpz_mul(t, t, d);
+    mpz_mul_ui(d, u, 3);
+    mpz_add(d, d, v);
+    mpz_mul(t, t, d);
+    mont_from_mpz(&C.M, C.a24, t, d);
+    mont_from_mpz(&C.M, P, x, d);
+    mont_from_mpz(&C.M, P + nl, z, d);
+
+    /* Stage 1: multiply P by every prime power up to B1, a chunk of primes
+     * at a time. */
+    mpz_set_ui(t, 1);
+    factor_mul_prime_power(t, 2, B1);
+    factor_sieve_init(&sieve);
+    for (p = factor_sieve_next(&sieve); p <= B1; p = factor_sieve_next(&sieve)) {
+        factor_mul_prime_power(t, p, B1);
+        if (mpz_sizeinbase(t, 2) >= FACTOR_CHUNK_BITS) {
+            ecm_ladder(&C, R0, R1, P, t);
+            ecm_copy(&C, P, R0);
+            mpz_set_ui(t, 1);
+        }
+    }
+    ecm_ladder(&C, R0, R1, P, t);
+    ecm_copy(&C, P, R0);
+
+    factor_set_limbs(t, P + nl, nl);
+    mpz_gcd(d, t, n);
+    if (mpz_cmp_ui(d, 1) != 0) {
+        found = factor_proper(d, n);
+        goto done;
+    }
+    if (B2 <= B1)
+        goto done;
+
+    /* Stage 2: compute the baby steps j*P from (j - 2)*P + 2*P with the
+     * difference (j - 4)*P. */
+    ecm_dbl(&C, Q2, P);
+    ecm_copy(&C, R0, P);
+    ecm_add(&C, R1, Q2, P, P);
+    ecm_copy(&C, baby, P);
+    nbaby = 1;
+    for (j = 3; j < ECM_D / 2; j += 2) {
+        if (j > 3) {
+            ecm_add(&C, T, R1, Q2, R0);
+            tmp = R0;
+            R0 = R1;
+            R1 = T;
+            T = tmp;
+        }
+        if (j % 3 && j % 5 && j % 7 && j % 11)
+            ecm_copy(&C, baby + 2 * nl * nbaby++, R1);
+    }
+
+    /* The giant steps m*G, G = ECM_D*P, for ECM_D*m near a prime q in
+     * (B1, B2]. q = ECM_D*m +- j is caught when X_m*Z_j == X_j*Z_m. */
+    mpz_set_ui(t, ECM_D);
+    ecm_ladder(&C, R0, R1, P, t);
+    ecm_copy(&C, G, R0);
+    m = B1 / ECM_D;
+    if (m == 0)
+        m = 1;
+    mpz_set_ui(t, m);
+    ecm_ladder(&C, R0, R1, G, t);
+    mpz_set_ui(t, 1);
+    mont_from_mpz(&C.M, acc, t, d);
+    for (; m <= B2 / ECM_D + 1; m++) {
+        for (j = 0; j < nbaby; j++) {
+            tmp = baby + 2 * nl * j;
+            mont_mul(&C.M, cross, R0, tmp + nl);
+            mont_mul(&C.M, cross + nl, tmp, R0 + nl);
+            mont_sub(&C.M, cross, cross, cross + nl);
+            mont_mul(&C.M, acc, acc, cross);
+        }
+        ecm_add(&C, T, R1, G, R0);
+        tmp = R0;
+        R0 = R1;
+        R1 = T;
+        T = tmp;
+    }
+    factor_set_limbs(t, acc, nl);
+    mpz_gcd(d, t, n);
+    found = factor_proper(d, n);
+
+  done:
+    mpz_clear(scratch);
+    mpz_clear(u);
+    mpz_clear(v);
+    mpz_clear(x);
+    mpz_clear(z);
+    mpz_clear(t);
+    return found;
+}
+
+/* ******************************************************************
+ * Driver
+ * ******************************************************************/
+
+/* The bounds and number of curves for each level of the elliptic curve
+ * method. Each level is aimed at factors about 5 digits larger than the
+ * level before it. After the last level is done, its curves are repeated.
+ */
+
+static const struct {
+    unsigned long B1;
+    unsigned long curves;
+} ecm_levels[] = {
+    {     2000UL,    25 },
+    {    11000UL,    90 },
+    {    50000UL,   300 },
+    {   250000UL,   700 },
+    {  1000000UL,  1800 },
+    {  3000000UL,  5100 },
+    { 11000000UL, 10600 },
+    { 43000000UL, 19300 },
+};
+
+#define ECM_LEVELS (sizeof(ecm_levels) / sizeof(ecm_levels[0]))
+
+typedef struct {
+    Py_ssize_t effort;      /* maximum number of curves, or 0 */
+    Py_ssize_t curves;      /* number of curves run so far */
+    unsigned long sigma;    /* parameter for the next curve */
+} factor_state;
+
+/* Find a nontrivial factor d of the odd composite n, which has no prime
+ * factors below PRP_TRIAL_MAX and is not a perfect power. Returns 1 if a
+ * factor was found, 0 if the effort is used up and -1 on error. */
+
+static int
+factor_split(mpz_ptr d, mpz_srcptr n, factor_state *state)
+{
+    size_t level = 0;
+    unsigned long curve = 0, B1;
+    mp_limb_t w;
+    int found;
+
+    if (mpz_size(n) == 1 && (w = factor_rho_word(mpz_getlimbn(n, 0)))) {
+        mpz_import(d, 1, -1, sizeof(mp_limb_t), 0, 0, &w);
+        return 1;
+    }
+
+    /* Each of these steps does many thousands of multiplications, so the
+     * GIL is released whenever releasing it is enabled. */
+    GMPY_BEGIN_NOGIL(global.nogil_bits);
+    found = factor_rho(d, n, FACTOR_RHO_ITERS) ||
+            factor_pm1(d, n, FACTOR_PM1_B1);
+    GMPY_END_NOGIL;
+    if (found)
+        return 1;
+
+    for (;;) {
+        if (state->effort && state->curves >= state->effort)
+            return 0;
+        if (PyErr_CheckSignals())
+            return -1;
+        if (curve == ecm_levels[level].curves && level + 1 < ECM_LEVELS) {
+            level++;
+            curve = 0;
+        }
+        curve++;
+        state->curves++;
+        B1 = ecm_levels[level].B1;
+        GMPY_BEGIN_NOGIL(global.nogil_bits);
+        found = factor_ecm(d, n, B1, 50 * B1, state->sigma++);
+        GMPY_END_NOGIL;
+        if (found)
+            return 1;
+    }
+}
+
+/* Set out to the sorted factorization of n != 0. Composite cofactors that
+ * could not be split within the effort are included with their
+ * multiplicity. Returns -1 on error. */
+
+static int
+factor_mpz(factor_list *out, mpz_srcptr n, Py_ssize_t effort)
+{
+    factor_list todo = {NULL, 0, 0};
+    factor_state state;
+    mpz_t c, d;
+    mpz_ptr f;
+    unsigned long m, k, e;
+    int r, status = -1;
+
+    PRP_TRIAL_INIT();
+    state.effort = effort;
+    state.curves = 0;
+    state.sigma = 6;
+
+    mpz_init(c);
+    mpz_init(d);
+    mpz_abs(c, n);
+
+    if (mpz_sgn(n) < 0) {
+        if (!(f = factor_list_add(out, 1)))
+            goto done;
+        mpz_set_si(f, -1);
+    }
+    if ((e = (unsigned long)mpz_scan1(c, 0))) {
+        if (!(f = factor_list_add(out, e)))
+            goto done;
+        mpz_set_ui(f, 2);
+        mpz_tdiv_q_2exp(c, c, e);
+    }
+    if (factor_trial(c, out) < 0)
+        goto done;
+    if (mpz_cmp_ui(c, 1) > 0) {
+        if (!(f = factor_list_add(&todo, 1)))
+            goto done;
+        mpz_swap(f, c);
+    }
+
+    while (todo.len > 0) {
+        todo.len--;
+        mpz_swap(c, todo.items[todo.len].p);
+        mpz_clear(todo.items[todo.len].p);
+        m = todo.items[todo.len].e;
+
+        if ((r = prp_is_prime(c)) < 0)
+            goto done;
+        if (r) {
+            if (!(f = factor_list_add(out, m)))
+                goto done;
+            mpz_swap(f, c);
+            continue;
+        }
+
+        /* Every prime factor is at least PRP_TRIAL_MAX = 2**16, so the
+         * largest exponent that gives an exact root is tried first. */
+        if (mpz_perfect_power_p(c)) {
+            for (k = (unsigned long)mpz_sizeinbase(c, 2) / 16; k > 1; k--) {
+                if (mpz_root(d, c, k))
+                    break;
+            }
+            if (k > 1) {
+                if (!(f = factor_list_add(&todo, m * k)))
+                    goto done;
+                mpz_swap(f, d);
+                continue;
+            }
+        }
+
+        if ((r = factor_split(d, c, &state)) < 0)
+            goto done;
+        if (!(f = factor_list_add(r ? &todo : out, m)))
+            goto done;
+        if (r) {
+            mpz_divexact(c, c, d);
+            mpz_swap(f, d);
+            if (!(f = factor_list_add(&todo, m)))
+                goto done;
+        }
+        mpz_swap(f, c);
+    }
+    factor_list_normalize(out);
+    status = 0;
+
+  done:
+    factor_list_clear(&todo);
+    mpz_clear(c);
+    mpz_clear(d);
+    return status;
+}
+
+/* Parse the arguments of factor() and factorint() and factor n. Returns -1
+ * on error. */
+
+static int
+factor_parse(factor_list *out, PyObject *args, PyObject *kwargs,
+             const char *format)
+{
+    static char *kwlist[] = {"n", "effort", NULL};
+    PyObject *arg;
+    MPZ_Object *n;
+    Py_ssize_t effort = 0;
+    int r;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, format, kwlist, &arg, &effort))
+        return -1;
+    if (!(n = GMPy_MPZ_From_Integer(arg, NULL))) {
+        TYPE_ERROR("factor() requires an integer argument");
+        return -1;
+    }
+    if (mpz_sgn(n->z) == 0) {
+        VALUE_ERROR("factor() of 0 is not defined");
+        Py_DECREF((PyObject*)n);
+        return -1;
+    }
+    if (effort < 0) {
+        VALUE_ERROR("effort must be >= 0");
+        Py_DECREF((PyObject*)n);
+        return -1;
+    }
+    r = factor_mpz(out, n->z, effort);
+    Py_DECREF((PyObject*)n);
+    return r;
+}
+
+PyDoc_STRVAR(GMPy_doc_mpz_function_factor,
+"factor(n, effort=0) -> list\n\n"
+"Return the factorization of the nonzero integer n as a sorted list of\n"
+"(factor, exponent) pairs. If n is negative, the first pair is (-1, 1).\n"
+"Small factors are found by trial division, larger ones with Pollard's\n"
+"rho and p-1 methods and the elliptic curve method. Each factor passes\n"
+"is_bpsw_prp(). If effort is not 0, at most effort elliptic curves are\n"
+"tried and a cofactor that could not be split is returned as one of the\n"
+"pairs; use is_prime() to check for it.");
+
+static PyObject *
+GMPy_MPZ_Function_Factor(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    factor_list out = {NULL, 0, 0};
+    PyObject *result = NULL, *pair;
+    MPZ_Object *p;
+    size_t i;
+
+    if (factor_parse(&out, args, kwargs, "O|n:factor") < 0)
+        goto done;
+    if (!(result = PyList_New((Py_ssize_t)out.len)))
+        goto done;
+    for (i = 0; i < out.len; i++) {
+        if (!(p = GMPy_MPZ_New(NULL))) {
+            Py_CLEAR(result);
+            goto done;
+        }
+        mpz_swap(p->z, out.items[i].p);
+        pair = Py_BuildValue("(Nk)", p, out.items[i].e);
+        if (!pair) {
+            Py_CLEAR(result);
+            goto done;
+        }
+        PyList_SET_ITEM(result, (Py_ssize_t)i, pair);
+    }
+
+  done:
+    factor_list_clear(&out);
+    return result;
+}
+
+PyDoc_STRVAR(GMPy_doc_mpz_function_factorint,
+"factorint(n, effort=0) -> dict\n\n"
+"Return the factorization of the nonzero integer n as a dictionary that\n"
+"maps each factor to its exponent. See factor().");
+
+static PyObject *
+GMPy_MPZ_Function_FactorInt(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    factor_list out = {NULL, 0, 0};
+    PyObject *result = NULL, *e;
+    MPZ_Object *p;
+    size_t i;
+    int r;
+
+    if (factor_parse(&out, args, kwargs, "O|n:factorint") < 0)
+        goto done;
+    if (!(result = PyDict_New()))
+        goto done;
+    for (i = 0; i < out.len; i++) {
+        if (!(p = GMPy_MPZ_New(NULL))) {
+            Py_CLEAR(result);
+            goto done;
+        }
+        mpz_swap(p->z, out.items[i].p);
+        if (!(e = PyIntOrLong_FromSize_t((size_t)out.items[i].e))) {
+            Py_DECREF((PyObject*)p);
+            Py_CLEAR(result);
+            goto done;
+        }
+        r = PyDict_SetItem(result, (PyObject*)p, e);
+        Py_DECREF((PyObject*)p);
+        Py_DECREF(e);
+        if (r < 0) {
+            Py_CLEAR(result);
+            goto done;
+        }
+    }
+
+  done:
+    factor_list_clear(&out);
+    return result;
+}
@@ -0,0 +1,337 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_fft.c                                                             *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* Discrete Fourier transforms over mpc sequences.
+ *
+ * The values are converted once to mpc_t at a working precision with
+ * 2*log2(n) + 16 guard bits, transformed in place, and each output is
+ * rounded once to the context. Lengths that are a power of two use the
+ * iterative radix-2 Cooley-Tukey algorithm; other lengths use the direct
+ * O(n**2) sum with the same cached twiddle factors.
+ *
+ * The error of each output is a few units in the last place of the working
+ * precision relative to the Euclidean norm of the input, so an output much
+ * smaller than the norm is not correctly rounded.
+ */
+
+static gmpy_fft_twiddles fft_cache = {0, 0, NULL};
+
+static void
+GMPy_FFT_Free_Cache(void)
+{
+    Py_ssize_t k;
+
+    if (fft_cache.w) {
+        for (k = 0; k < fft_cache.n; k++)
+            mpc_clear(fft_cache.w[k]);
+        PyMem_Free(fft_cache.w);
+    }
+    fft_cache.n = 0;
+    fft_cache.prec = 0;
+    fft_cache.w = NULL;
+}
+
+/* Return the twiddle factors for a transform of length n at precision
+ * prec. A table computed at a higher precision is reused as it is.
+ */
+static mpc_t *
+fft_twiddles(Py_ssize_t n, mpfr_prec_t prec)
+{
+    Py_ssize_t k;
+    mpfr_t angle;
+
+    if (fft_cache.w && fft_cache.n == n && fft_cache.prec >= prec)
+        return fft_cache.w;
+
+    GMPy_FFT_Free_Cache();
+    if (!(fft_cache.w = PyMem_New(mpc_t, n))) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+
+    mpfr_init2(angle, prec + 8);
+    for (k = 0; k < n; k++) {
+        mpc_init2(fft_cache.w[k], prec);
+        /* The quarter turns are exact, so that values that should be
+         * real or imaginary stay that way. */
+        if ((4 * k) % n == 0) {
+            static const int re[4] = {1, 0, -1, 0}, im[4] = {0, -1, 0, 1};
+            Py_ssize_t q = 4 * k / n;
+
+            mpfr_set_si(mpc_realref(fft_cache.w[k]), re[q], MPFR_RNDN);
+            mpfr_set_si(mpc_imagref(fft_cache.w[k]), im[q], MPFR_RNDN);
+            continue;
+        }
+        /* angle = -2*pi*k/n */
+        mpfr_const_pi(angle, MPFR_RNDN);
+        mpfr_mul_si(angle, angle, -2 * (long)k, MPFR_RNDN);
+        mpfr_div_si(angle, angle, (long)n, MPFR_RNDN);
+        mpfr_sin_cos(mpc_imagref(fft_cache.w[k]), mpc_realref(fft_cache.w[k]),
+                     angle, MPFR_RNDN);
+    }
+    mpfr_clear(angle);
+    fft_cache.n = n;
+    fft_cache.prec = prec;
+    return fft_cache.w;
+}
+
+/* Transform the n values of a in place. The output is in natural order. */
+static int
+fft_kernel(mpc_t *a, Py_ssize_t n, int inverse, mpfr_prec_t prec)
+{
+    Py_ssize_t i, j, k, len, half, step;
+    mpc_t *w, t;
+
+    if (n == 1)
+        return 1;
+    if (!(w = fft_twiddles(n, prec)))
+        return 0;
+
+    mpc_init2(t, prec);
+
+    if ((n & (n - 1)) == 0) {
+        /* Bit-reversal permutation. */
+        for (i = 1, j = 0; i < n; i++) {
+            Py_ssize_t bit = n >> 1;
+
+            for (; j & bit; bit >>= 1)
+                j ^= bit;
+            j ^= bit;
+            if (i < j)
+                mpc_swap(a[i], a[j]);
+        }
+
+        for (len = 2; len <= n; len <<= 1) {
+            half = len >> 1;
+            step = n / len;
+            for (i = 0; i < n; i += len) {
+                for (j = 0; j < half; j++) {
+                    k = j * step;
+                    if (inverse && k)
+                        k = n - k;
+                    mpc_mul(t, a[i + j + half], w[k], MPC_RNDNN);
+                    mpc_sub(a[i + j + half], a[i + j], t, MPC_RNDNN);
+                    mpc_add(a[i + j], a[i + j], t, MPC_RNDNN);
+                }
+            }
+        }
+    }
+    else {
+        mpc_t *b;
+
+        if (!(b = PyMem_New(mpc_t, n))) {
+            mpc_clear(t);
+            PyErr_NoMemory();
+            return 0;
+        }
+        for (k = 0; k < n; k++) {
+            mpc_init2(b[k], prec);
+            mpc_set_ui(b[k], 0, MPC_RNDNN);
+            for (j = 0, i = 0; j < n; j++) {
+                /* i = j*k mod n */
+                mpc_mul(t, a[j], w[inverse && i ? n - i : i], MPC_RNDNN);
+                mpc_add(b[k], b[k], t, MPC_RNDNN);
+                i += k;
+                if (i >= n)
+                    i -= n;
+            }
+        }
+        for (k = 0; k < n; k++) {
+            mpc_swap(a[k], b[k]);
+            mpc_clear(b[k]);
+        }
+        PyMem_Free(b);
+    }
+
+    mpc_clear(t);
+    return 1;
+}
+
+static PyObject *
+fft_common(PyObject *other, int inverse, int real, CTXT_Object *context)
+{
+    PyObject *seq, *result = NULL;
+    PyObject **items;
+    Py_ssize_t i, n, nout, bits;
+    mpfr_prec_t prec;
+    mpc_t *a;
+
+    if (!(seq = PySequence_Fast(other, "argument must be an iterable")))
+        return NULL;
+    n = PySequence_Fast_GET_SIZE(seq);
+    items = PySequence_Fast_ITEMS(seq);
+
+    if (n == 0) {
+        VALUE_ERROR("fft() requires at least one value");
+        Py_DECREF(seq);
+        return NULL;
+    }
+
+    prec = GET_REAL_PREC(context);
+    if (GET_IMAG_PREC(context) > prec)
+        prec = GET_IMAG_PREC(context);
+    for (bits = 0, i = n - 1; i > 0; i >>= 1)
+        bits++;
+    prec += 2 * bits + 16;
+
+    if (!(a = PyMem_New(mpc_t, n))) {
+        Py_DECREF(seq);
+        return PyErr_NoMemory();
+    }
+    for (i = 0; i < n; i++)
+        mpc_init2(a[i], prec);
+
+    for (i = 0; i < n; i++) {
+        if (real ? !IS_REAL(items[i]) : !IS_COMPLEX(items[i])) {
+            if (real)
+                TYPE_ERROR("rfft() argument type not supported");
+            else
+                TYPE_ERROR("fft() argument type not supported");
+            goto done;
+        }
+        if (MPC_Check(items[i])) {
+            mpc_set(a[i], MPC(items[i]), MPC_RNDNN);
+        }
+        else {
+            MPC_Object *temp;
+
+            if (!(temp = GMPy_MPC_From_Complex(items[i], 1, 1, context)))
+                goto done;
+            mpc_set(a[i], temp->c, MPC_RNDNN);
+            Py_DECREF((PyObject*)temp);
+        }
+    }
+
+    if (!fft_kernel(a, n, inverse, prec))
+        goto done;
+
+    nout = real ? n / 2 + 1 : n;
+    if (!(result = PyList_New(nout)))
+        goto done;
+    for (i = 0; i < nout; i++) {
+        MPC_Object *temp;
+
+        if (!(temp = GMPy_MPC_New(0, 0, context))) {
+            Py_CLEAR(result);
+            goto done;
+        }
+        if (inverse)
+            temp->rc = mpc_div_ui(temp->c, a[i], (unsigned long)n, GET_MPC_ROUND(context));
+        else
+            temp->rc = mpc_set(temp->c, a[i], GET_MPC_ROUND(context));
+        GMPY_MPC_CLEANUP(temp, context, "fft()");
+        if (!temp) {
+            Py_CLEAR(result);
+            goto done;
+        }
+        PyList_SET_ITEM(result, i, (PyObject*)temp);
+    }
+
+  done:
+    for (i = 0; i < n; i++)
+        mpc_clear(a[i]);
+    PyMem_Free(a);
+    Py_DECREF(seq);
+    return result;
+}
+
+PyDoc_STRVAR(GMPy_doc_function_fft,
+"fft(iterable) -> list\n\n"
+"Return the discrete Fourier transform, sum(x[j]*exp(-2j*pi*j*k/n)), of\n"
+"the n values in iterable as a list of mpc.");
+
+PyDoc_STRVAR(GMPy_doc_context_fft,
+"context.fft(iterable) -> list\n\n"
+"Return the discrete Fourier transform, sum(x[j]*exp(-2j*pi*j*k/n)), of\n"
+"the n values in iterable as a list of mpc.");
+
+static PyObject *
+GMPy_Context_FFT(PyObject *self, PyObject *other)
+{
+    CTXT_Object *context = NULL;
+
+    if (self && CTXT_Check(self)) {
+        context = (CTXT_Object*)self;
+    }
+    else {
+        CHECK_CONTEXT(context);
+    }
+
+    return fft_common(other, 0, 0, context);
+}
+
+PyDoc_STRVAR(GMPy_doc_function_ifft,
+"ifft(iterable) -> list\n\n"
+"Return the inverse discrete Fourier transform,\n"
+"sum(x[j]*exp(2j*pi*j*k/n))/n, of the n values in iterable as a list of\n"
+"mpc.");
+
+PyDoc_STRVAR(GMPy_doc_context_ifft,
+"context.ifft(iterable) -> list\n\n"
+"Return the inverse discrete Fourier transform,\n"
+"sum(x[j]*exp(2j*pi*j*k/n))/n, of the n values in iterable as a list of\n"
+"mpc.");
+
+static PyObject *
+GMPy_Context_IFFT(PyObject *self, PyObject *other)
+{
+    CTXT_Object *context = NULL;
+
+    if (self && CTXT_Check(self)) {
+        context = (CTXT_Object*)self;
+    }
+    else {
+        CHECK_CONTEXT(context);
+    }
+
+    return fft_common(other, 1, 0, context);
+}
+
+PyDoc_STRVAR(GMPy_doc_function_rfft,
+"rfft(iterable) -> list\n\n"
+"Return the first n//2+1 values of the discrete Fourier transform of the\n"
+"n real values in iterable. The others are their complex conjugates.");
+
+PyDoc_STRVAR(GMPy_doc_context_rfft,
+"context.rfft(iterable) -> list\n\n"
+"Return the first n//2+1 values of the discrete Fourier transform of the\n"
+"n real values in iterable. The others are their complex conjugates.");
+
+static PyObject *
+GMPy_Context_RFFT(PyObject *self, PyObject *other)
+{
+    CTXT_Object *context = NULL;
+
+    if (self && CTXT_Check(self)) {
+        context = (CTXT_Object*)self;
+    }
+    else {
+        CHECK_CONTEXT(context);
+    }
+
+    return fft_common(other, 0, 1, context);
+}
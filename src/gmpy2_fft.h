@@ -0,0 +1,54 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_fft.h                                                             *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GMPY_FFT_H
+#define GMPY_FFT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* The twiddle factors exp(-2*pi*i*k/n), 0 <= k < n, of the last transform
+ * are kept until a transform of another length or at a higher working
+ * precision is requested, or until free_cache() is called.
+ */
+
+typedef struct {
+    Py_ssize_t n;
+    mpfr_prec_t prec;
+    mpc_t *w;
+} gmpy_fft_twiddles;
+
+static PyObject * GMPy_Context_FFT(PyObject *self, PyObject *other);
+static PyObject * GMPy_Context_IFFT(PyObject *self, PyObject *other);
+static PyObject * GMPy_Context_RFFT(PyObject *self, PyObject *other);
+static void       GMPy_FFT_Free_Cache(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
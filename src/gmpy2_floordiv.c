@@ -80,10 +80,9 @@ GMPy_Integer_FloorDiv(PyObject *x, PyObject *y, CTXT_Object *context)
             }
             else {
                 mpz_t tempz;
-                mpz_inoc(tempz);
-                mpz_set_PyIntOrLong(tempz, y);
+                mpz_inoc_pylong(tempz, y);
                 mpz_fdiv_q(result->z, MPZ(x), tempz);
-                mpz_cloc(tempz);
+                mpz_cloc_pylong(tempz);
             }
             return (PyObject*)result;
         }
@@ -108,10 +107,9 @@ GMPy_Integer_FloorDiv(PyObject *x, PyObject *y, CTXT_Object *context)
         
         if (PyIntOrLong_Check(x)) {
             mpz_t tempz;
-            mpz_inoc(tempz);
-            mpz_set_PyIntOrLong(tempz, x);
+            mpz_inoc_pylong(tempz, x);
             mpz_fdiv_q(result->z, tempz, MPZ(y));
-            mpz_cloc(tempz);
+            mpz_cloc_pylong(tempz);
             return (PyObject*)result;
         }
     }
@@ -151,9 +149,14 @@ GMPy_Integer_FloorDiv(PyObject *x, PyObject *y, CTXT_Object *context)
  * function. If no appropriate function can be found, return NotImplemented.
  */
 
+GMPY_PROFILE_WRAP(PyObject *, GMPy_MPZ_FloorDiv_Slot, (PyObject *x, PyObject *y),
+                  (x, y), gmpy_profile_bits2(x, y))
+
 static PyObject *
-GMPy_MPZ_FloorDiv_Slot(PyObject *x, PyObject *y)
+GMPy_MPZ_FloorDiv_Slot_Impl(PyObject *x, PyObject *y)
 {
+    int xtype, ytype;
+
     if (CHECK_MPZANY(x) && CHECK_MPZANY(y)) {
         MPZ_Object *result;
 
@@ -161,22 +164,25 @@ GMPy_MPZ_FloorDiv_Slot(PyObject *x, PyObject *y)
             ZERO_ERROR("division or modulo by zero");
             return NULL;
         }
-        if ((result = GMPy_MPZ_New(NULL))) {
+        if ((result = GMPy_MPZ_Reuse(x, y))) {
             mpz_fdiv_q(result->z, MPZ(x), MPZ(y));
         }
         return (PyObject*)result;
     }
 
-    if (IS_INTEGER(x) && IS_INTEGER(y))
+    xtype = GMPy_ObjectType(x);
+    ytype = GMPy_ObjectType(y);
+
+    if (IS_TYPE_INTEGER(xtype) && IS_TYPE_INTEGER(ytype))
         return GMPy_Integer_FloorDiv(x, y, NULL);
 
-    if (IS_RATIONAL(x) && IS_RATIONAL(y))
+    if (IS_TYPE_RATIONAL(xtype) && IS_TYPE_RATIONAL(ytype))
         return GMPy_Rational_FloorDiv(x, y, NULL);
 
-    if (IS_REAL(x) && IS_REAL(y))
+    if (IS_TYPE_REAL(xtype) && IS_TYPE_REAL(ytype))
         return GMPy_Real_FloorDiv(x, y, NULL);
 
-    if (IS_COMPLEX(x) && IS_COMPLEX(y))
+    if (IS_TYPE_COMPLEX(xtype) && IS_TYPE_COMPLEX(ytype))
         return GMPy_Complex_FloorDiv(x, y, NULL);
 
     Py_RETURN_NOTIMPLEMENTED;
@@ -243,16 +249,24 @@ GMPy_Rational_FloorDiv(PyObject *x, PyObject *y, CTXT_Object *context)
     return NULL;
 }
 
+GMPY_PROFILE_WRAP(PyObject *, GMPy_MPQ_FloorDiv_Slot, (PyObject *x, PyObject *y),
+                  (x, y), gmpy_profile_bits2(x, y))
+
 static PyObject *
-GMPy_MPQ_FloorDiv_Slot(PyObject *x, PyObject *y)
+GMPy_MPQ_FloorDiv_Slot_Impl(PyObject *x, PyObject *y)
 {
-    if (IS_RATIONAL(x) && IS_RATIONAL(y))
+    int xtype, ytype;
+
+    xtype = GMPy_ObjectType(x);
+    ytype = GMPy_ObjectType(y);
+
+    if (IS_TYPE_RATIONAL(xtype) && IS_TYPE_RATIONAL(ytype))
         return GMPy_Rational_FloorDiv(x, y, NULL);
 
-    if (IS_REAL(x) && IS_REAL(y))
+    if (IS_TYPE_REAL(xtype) && IS_TYPE_REAL(ytype))
         return GMPy_Real_FloorDiv(x, y, NULL);
 
-    if (IS_COMPLEX(x) && IS_COMPLEX(y))
+    if (IS_TYPE_COMPLEX(xtype) && IS_TYPE_COMPLEX(ytype))
         return GMPy_Complex_FloorDiv(x, y, NULL);
 
     Py_RETURN_NOTIMPLEMENTED;
@@ -295,11 +309,10 @@ GMPy_Real_FloorDiv(PyObject *x, PyObject *y, CTXT_Object *context)
             }
             else {
                 mpz_t tempz;
-                mpz_inoc(tempz);
-                mpz_set_PyIntOrLong(tempz, y);
+                mpz_inoc_pylong(tempz, y);
                 mpfr_clear_flags();
                 result->rc = mpfr_div_z(result->f, MPFR(x), tempz, GET_MPFR_ROUND(context));
-                mpz_cloc(tempz);
+                mpz_cloc_pylong(tempz);
                 result->rc = mpfr_floor(result->f, result->f);
                 goto done;
             }
@@ -388,13 +401,21 @@ GMPy_Real_FloorDiv(PyObject *x, PyObject *y, CTXT_Object *context)
     return (PyObject*)result;
 }
 
+GMPY_PROFILE_WRAP(PyObject *, GMPy_MPFR_FloorDiv_Slot, (PyObject *x, PyObject *y),
+                  (x, y), gmpy_profile_bits2(x, y))
+
 static PyObject *
-GMPy_MPFR_FloorDiv_Slot(PyObject *x, PyObject *y)
+GMPy_MPFR_FloorDiv_Slot_Impl(PyObject *x, PyObject *y)
 {
-    if (IS_REAL(x) && IS_REAL(y))
+    int xtype, ytype;
+
+    xtype = GMPy_ObjectType(x);
+    ytype = GMPy_ObjectType(y);
+
+    if (IS_TYPE_REAL(xtype) && IS_TYPE_REAL(ytype))
         return GMPy_Real_FloorDiv(x, y, NULL);
 
-    if (IS_COMPLEX(x) && IS_COMPLEX(y))
+    if (IS_TYPE_COMPLEX(xtype) && IS_TYPE_COMPLEX(ytype))
         return GMPy_Complex_FloorDiv(x, y, NULL);
 
     Py_RETURN_NOTIMPLEMENTED;
@@ -407,8 +428,11 @@ GMPy_Complex_FloorDiv(PyObject *x, PyObject *y, CTXT_Object *context)
     return NULL;
 }
 
+GMPY_PROFILE_WRAP(PyObject *, GMPy_MPC_FloorDiv_Slot, (PyObject *x, PyObject *y),
+                  (x, y), gmpy_profile_bits2(x, y))
+
 static PyObject *
-GMPy_MPC_FloorDiv_Slot(PyObject *x, PyObject *y)
+GMPy_MPC_FloorDiv_Slot_Impl(PyObject *x, PyObject *y)
 {
     return GMPy_Complex_FloorDiv(x, y, NULL);
 }
@@ -417,19 +441,27 @@ PyDoc_STRVAR(GMPy_doc_floordiv,
 "floor_div(x, y) -> number\n\n"
 "Return x // y; uses floor division.");
 
+GMPY_PROFILE_WRAP(PyObject *, GMPy_Number_FloorDiv, (PyObject *x, PyObject *y, CTXT_Object *context),
+                  (x, y, context), gmpy_profile_bits2(x, y))
+
 static PyObject *
-GMPy_Number_FloorDiv(PyObject *x, PyObject *y, CTXT_Object *context)
+GMPy_Number_FloorDiv_Impl(PyObject *x, PyObject *y, CTXT_Object *context)
 {
-    if (IS_INTEGER(x) && IS_INTEGER(y))
+    int xtype, ytype;
+
+    xtype = GMPy_ObjectType(x);
+    ytype = GMPy_ObjectType(y);
+
+    if (IS_TYPE_INTEGER(xtype) && IS_TYPE_INTEGER(ytype))
         return GMPy_Integer_FloorDiv(x, y, context);
 
-    if (IS_RATIONAL(x) && IS_RATIONAL(y))
+    if (IS_TYPE_RATIONAL(xtype) && IS_TYPE_RATIONAL(ytype))
         return GMPy_Rational_FloorDiv(x, y, context);
 
-    if (IS_REAL(x) && IS_REAL(y))
+    if (IS_TYPE_REAL(xtype) && IS_TYPE_REAL(ytype))
         return GMPy_Real_FloorDiv(x, y, context);
 
-    if (IS_COMPLEX(x) && IS_COMPLEX(y))
+    if (IS_TYPE_COMPLEX(xtype) && IS_TYPE_COMPLEX(ytype))
         return GMPy_Complex_FloorDiv(x, y, context);
 
     TYPE_ERROR("floor_div() argument type not supported");
@@ -441,11 +473,11 @@ PyDoc_STRVAR(GMPy_doc_context_floordiv,
 "Return x // y; uses floor division.");
 
 static PyObject *
-GMPy_Context_FloorDiv(PyObject *self, PyObject *args)
+GMPy_Context_FloorDiv(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     CTXT_Object *context = NULL;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (nargs != 2) {
         TYPE_ERROR("floor_div() requires 2 arguments");
         return NULL;
     }
@@ -458,7 +490,8 @@ GMPy_Context_FloorDiv(PyObject *self, PyObject *args)
     }
 
 
-    return GMPy_Number_FloorDiv(PyTuple_GET_ITEM(args, 0), PyTuple_GET_ITEM(args, 1),
+    return GMPy_Number_FloorDiv(args[0], args[1],
                                 context);
 }
+GMPY_FASTCALL_WRAPPER(GMPy_Context_FloorDiv)
 
@@ -25,6 +25,64 @@
  * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
  * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
+/* Parsed format specifications are kept in a small direct-mapped cache for
+ * each type, so that formatting many values with the same specification
+ * only parses it once. A specification is reduced to the mpfr_printf()
+ * formats, the mpz base and options, and the field alignment, fill and
+ * width. The result is written into a buffer and padded there; the field
+ * is no longer passed to str.__format__().
+ */
+
+#define GMPY_FORMAT_SPEC_MAX 32
+#define GMPY_FORMAT_CACHE_SIZE 16
+#define GMPY_FORMAT_BUFSIZE 256
+
+enum { FORMAT_MPZ, FORMAT_MPFR, FORMAT_MPC };
+
+typedef struct {
+    int used;
+    char spec[GMPY_FORMAT_SPEC_MAX];  /* cache key */
+    char align, fill;                 /* '<', '>' or '^'; ' ' or '0' */
+    Py_ssize_t width;
+    int base, option;                 /* mpz: as for mpz_ascii() */
+    int mpcstyle;                     /* mpc: (1 2) instead of 1+2j */
+    char rfmt[100], ifmt[100];        /* mpfr_printf() formats */
+} gmpy_format_spec;
+
+static gmpy_format_spec gmpy_format_cache[3][GMPY_FORMAT_CACHE_SIZE];
+
+/* Longer specifications would overflow the mpfr_printf() formats. */
+#define FORMAT_SPEC_CHECK(fmtcode) \
+    if (strlen(fmtcode) > 90) { \
+        VALUE_ERROR("Invalid conversion specification"); \
+        return -1; \
+    }
+
+/* Set the alignment, fill and width from field, which holds an optional
+ * alignment character followed by the width digits. As for str, a width
+ * that starts with '0' is filled with '0'.
+ */
+
+static int
+format_set_field(gmpy_format_spec *spec, const char *field)
+{
+    spec->align = '<';
+    spec->fill = ' ';
+    spec->width = 0;
+    if (*field == '<' || *field == '>' || *field == '^')
+        spec->align = *(field++);
+    if (*field == '0')
+        spec->fill = '0';
+    for (; *field; field++) {
+        if (spec->width > (PY_SSIZE_T_MAX - 9) / 10) {
+            VALUE_ERROR("Too many decimal digits in format string");
+            return -1;
+        }
+        spec->width = spec->width * 10 + (*field - '0');
+    }
+    return 0;
+}
+
 PyDoc_STRVAR(GMPy_doc_mpz_format,
 "x.__format__(fmt) -> string\n\n"
 "Return a Python string by formatting mpz 'x' using the format string\n"
@@ -47,37 +105,31 @@ PyDoc_STRVAR(GMPy_doc_mpz_format,
 "        'x' -> hex format\n"
 "The default format is 'd'.");
 
-/* Formatting occurs in two phases. Pympz_ascii() is used to create a string
- * with the appropriate binary/octal/decimal/hex formatting, including the
- * leading sign character (+ , -, or space) and base encoding (0b, 0o, or 0x).
- * Left/right/centering using the specified width is done by creating a
- * format string and calling the __format__() method of the string object
- * returned by Pympz_ascii().
+/* Formatting occurs in two phases. The digits are written with the
+ * appropriate binary/octal/decimal/hex formatting, including the leading
+ * sign character (+ , -, or space) and base encoding (0b, 0o, or 0x).
+ * Left/right/centering using the specified width is done in the same
+ * buffer by format_finish().
  */
 
-static PyObject *
-GMPy_MPZ_Format(PyObject *self, PyObject *args)
+static int
+format_parse_mpz(const char *fmtcode, gmpy_format_spec *spec)
 {
-    PyObject *result = NULL, *mpzstr = NULL;
-    char *fmtcode = 0, *p1, *p2;
-    char fmt[30];
-    int base = 10, option = 16;
+    const char *p1;
+    char fmt[100], *p2;
     int seensign = 0, seenindicator = 0, seenalign = 0, seendigits = 0;
 
-    if (!CHECK_MPZANY(self)) {
-        TYPE_ERROR("requires mpz type");
-        return NULL;
-    }
+    FORMAT_SPEC_CHECK(fmtcode);
 
-    if (!PyArg_ParseTuple(args, "s", &fmtcode))
-        return NULL;
+    spec->base = 10;
+    spec->option = 16;
 
     p2 = fmt;
     for (p1 = fmtcode; *p1 != '\00'; p1++) {
         if (*p1 == '<' || *p1 == '>' || *p1 == '^') {
             if (seenalign || seensign || seenindicator || seendigits) {
                 VALUE_ERROR("Invalid conversion specification");
-                return NULL;
+                return -1;
             }
             else {
                 *(p2++) = *p1;
@@ -88,10 +140,10 @@ GMPy_MPZ_Format(PyObject *self, PyObject *args)
         if (*p1 == '+') {
             if (seensign || seenindicator || seendigits) {
                 VALUE_ERROR("Invalid conversion specification");
-                return NULL;
+                return -1;
             }
             else {
-                option |= 2;
+                spec->option |= 2;
                 seensign = 1;
                 continue;
             }
@@ -99,7 +151,7 @@ GMPy_MPZ_Format(PyObject *self, PyObject *args)
         if (*p1 == '-') {
             if (seensign || seenindicator || seendigits) {
                 VALUE_ERROR("Invalid conversion specification");
-                return NULL;
+                return -1;
             }
             else {
                 seensign = 1;
@@ -109,10 +161,10 @@ GMPy_MPZ_Format(PyObject *self, PyObject *args)
         if (*p1 == ' ') {
             if (seensign || seenindicator || seendigits) {
                 VALUE_ERROR("Invalid conversion specification");
-                return NULL;
+                return -1;
             }
             else {
-                option |= 4;
+                spec->option |= 4;
                 seensign = 1;
                 continue;
             }
@@ -120,10 +172,10 @@ GMPy_MPZ_Format(PyObject *self, PyObject *args)
         if (*p1 == '#') {
             if (seenindicator || seendigits) {
                 VALUE_ERROR("Invalid conversion specification");
-                return NULL;
+                return -1;
             }
             else {
-                option |= 8;
+                spec->option |= 8;
                 seenindicator = 1;
                 continue;
             }
@@ -138,84 +190,44 @@ GMPy_MPZ_Format(PyObject *self, PyObject *args)
             continue;
         }
         if (*p1 == 'b') {
-            base = 2;
+            spec->base = 2;
             break;
         }
         if (*p1 == 'o') {
-            base = 8;
+            spec->base = 8;
             break;
         }
         if (*p1 == 'x') {
-            base = 16;
+            spec->base = 16;
             break;
         }
         if (*p1 == 'd') {
-            base = 10;
+            spec->base = 10;
             break;
         }
         if (*p1 == 'X') {
-            base = -16;
+            spec->base = -16;
             break;
         }
         VALUE_ERROR("Invalid conversion specification");
-        return NULL;
+        return -1;
     }
     *(p2++) = '\00';
 
-    if (!(mpzstr = mpz_ascii(MPZ(self), base, option, 0)))
-        return NULL;
-
-    result = PyObject_CallMethod(mpzstr, "__format__", "(s)", fmt);
-    Py_DECREF(mpzstr);
-    return result;
+    return format_set_field(spec, fmt);
 }
 
-PyDoc_STRVAR(GMPy_doc_mpfr_format,
-"x.__format__(fmt) -> string\n\n"
-"Return a Python string by formatting 'x' using the format string\n"
-"'fmt'. A valid format string consists of:\n"
-"     optional alignment code:\n"
-"        '<' -> left shifted in field\n"
-"        '>' -> right shifted in field\n"
-"        '^' -> centered in field\n"
-"     optional leading sign code\n"
-"        '+' -> always display leading sign\n"
-"        '-' -> only display minus for negative values\n"
-"        ' ' -> minus for negative values, space for positive values\n"
-"     optional width.precision\n"
-"     optional rounding mode:\n"
-"        'U' -> round toward plus Infinity\n"
-"        'D' -> round toward minus Infinity\n"
-"        'Y' -> round away from zero\n"
-"        'Z' -> round toward zero\n"
-"        'N' -> round to nearest\n"
-"     optional conversion code:\n"
-"        'a','A' -> hex format\n"
-"        'b'     -> binary format\n"
-"        'e','E' -> scientific format\n"
-"        'f','F' -> fixed point format\n"
-"        'g','G' -> fixed or float format\n\n"
-"The default format is '.6f'.");
-
-static PyObject *
-GMPy_MPFR_Format(PyObject *self, PyObject *args)
+static int
+format_parse_mpfr(const char *fmtcode, gmpy_format_spec *spec)
 {
-    PyObject *result = NULL, *mpfrstr = NULL;
-    char *buffer = 0, *newbuf = 0, *fmtcode = 0, *p1, *p2, *p3;
-    char mpfrfmt[100], fmt[30];
-    int buflen;
+    const char *p1;
+    char fmt[100], *p2, *p3;
     int seensign = 0, seenalign = 0, seendecimal = 0, seendigits = 0;
     int seenround = 0, seenconv = 0;
 
-    if (!MPFR_Check(self)) {
-        TYPE_ERROR("requires mpfr type");
-        return NULL;
-    }
-
-    if (!PyArg_ParseTuple(args, "s", &fmtcode))
-        return NULL;
+    FORMAT_SPEC_CHECK(fmtcode);
 
-    p2 = mpfrfmt;
+    p2 = spec->rfmt;
     p3 = fmt;
     *(p2++) = '%';
 
@@ -223,7 +235,7 @@ GMPy_MPFR_Format(PyObject *self, PyObject *args)
         if (*p1 == '<' || *p1 == '>' || *p1 == '^') {
             if (seenalign || seensign || seendecimal || seendigits || seenround) {
                 VALUE_ERROR("Invalid conversion specification");
-                return NULL;
+                return -1;
             }
             else {
                 *(p3++) = *p1;
@@ -234,7 +246,7 @@ GMPy_MPFR_Format(PyObject *self, PyObject *args)
         if (*p1 == '+' || *p1 == ' ') {
             if (seensign || seendecimal || seendigits || seenround) {
                 VALUE_ERROR("Invalid conversion specification");
-                return NULL;
+                return -1;
             }
             else {
                 *(p2++) = *p1;
@@ -245,7 +257,7 @@ GMPy_MPFR_Format(PyObject *self, PyObject *args)
         if (*p1 == '-') {
             if (seensign || seendecimal || seendigits || seenround) {
                 VALUE_ERROR("Invalid conversion specification");
-                return NULL;
+                return -1;
             }
             else {
                 seensign = 1;
@@ -255,7 +267,7 @@ GMPy_MPFR_Format(PyObject *self, PyObject *args)
         if (*p1 == '.') {
             if (seendecimal || seendigits || seenround) {
                 VALUE_ERROR("Invalid conversion specification");
-                return NULL;
+                return -1;
             }
             else {
                 *(p2++) = *p1;
@@ -266,7 +278,7 @@ GMPy_MPFR_Format(PyObject *self, PyObject *args)
         if (isdigit(*p1)) {
             if (seendigits || seenround) {
                 VALUE_ERROR("Invalid conversion specification");
-                return NULL;
+                return -1;
             }
             else if (seendecimal) {
                 *(p2++) = *p1;
@@ -289,7 +301,7 @@ GMPy_MPFR_Format(PyObject *self, PyObject *args)
             *p1 == 'N' ) {
             if (seenround) {
                 VALUE_ERROR("Invalid conversion specification");
-                return NULL;
+                return -1;
             }
             else {
                 *(p2++) = *p1;
@@ -305,7 +317,7 @@ GMPy_MPFR_Format(PyObject *self, PyObject *args)
             break;
         }
         VALUE_ERROR("Invalid conversion specification");
-        return NULL;
+        return -1;
     }
 
     if (!seendigits)
@@ -316,87 +328,22 @@ GMPy_MPFR_Format(PyObject *self, PyObject *args)
     *(p2) = '\00';
     *(p3) = '\00';
 
-    buflen = mpfr_asprintf(&buffer, mpfrfmt, MPFR(self));
-
-    /* If there isn't a decimal point in the output and the output
-     * only consists of digits, then append .0 */
-    if (strlen(buffer) == strspn(buffer, "+- 0123456789")) {
-        newbuf = GMPY_MALLOC(buflen + 3);
-        if (!newbuf) {
-            mpfr_free_str(buffer);
-            return PyErr_NoMemory();
-        }
-        *newbuf = '\0';
-        strcat(newbuf, buffer);
-        strcat(newbuf, ".0");
-        mpfr_free_str(buffer);
-        mpfrstr = Py_BuildValue("s", newbuf);
-        GMPY_FREE(newbuf);
-    }
-    else {
-        mpfrstr = Py_BuildValue("s", buffer);
-        mpfr_free_str(buffer);
-    }
-    if (!mpfrstr) {
-        return NULL;
-    }
-
-    result = PyObject_CallMethod(mpfrstr, "__format__", "(s)", fmt);
-    Py_DECREF(mpfrstr);
-    return result;
+    return format_set_field(spec, fmt);
 }
 
-PyDoc_STRVAR(GMPy_doc_mpc_format,
-"x.__format__(fmt) -> string\n\n"
-"Return a Python string by formatting 'x' using the format string\n"
-"'fmt'. A valid format string consists of:\n"
-"     optional alignment code:\n"
-"        '<' -> left shifted in field\n"
-"        '>' -> right shifted in field\n"
-"        '^' -> centered in field\n"
-"     optional leading sign code\n"
-"        '+' -> always display leading sign\n"
-"        '-' -> only display minus for negative values\n"
-"        ' ' -> minus for negative values, space for positive values\n"
-"     optional width.real_precision.imag_precision\n"
-"     optional rounding mode:\n"
-"        'U' -> round toward plus infinity\n"
-"        'D' -> round toward minus infinity\n"
-"        'Z' -> round toward zero\n"
-"        'N' -> round to nearest\n"
-"     optional output style:\n"
-"        'P' -> Python style, 1+2j, (default)\n"
-"        'M' -> MPC style, (1 2)\n"
-"     optional conversion code:\n"
-"        'a','A' -> hex format\n"
-"        'b'     -> binary format\n"
-"        'e','E' -> scientific format\n"
-"        'f','F' -> fixed point format\n"
-"        'g','G' -> fixed or scientific format\n\n"
-"The default format is 'f'.");
-
-static PyObject *
-GMPy_MPC_Format(PyObject *self, PyObject *args)
+static int
+format_parse_mpc(const char *fmtcode, gmpy_format_spec *spec)
 {
-    PyObject *result = NULL, *tempstr = NULL;
-    char *realbuf = 0, *imagbuf = 0, *tempbuf = 0, *fmtcode = 0;
-    char *p, *rfmtptr, *ifmtptr, *fmtptr;
-    char rfmt[100], ifmt[100], fmt[30];
-    int rbuflen, ibuflen;
+    const char *p;
+    char fmt[100], *rfmtptr, *ifmtptr, *fmtptr;
     int seensign = 0, seenalign = 0, seendecimal = 0, seendigits = 0;
-    int seenround = 0, seenconv = 0, seenstyle = 0, mpcstyle = 0;
-
-    if (!MPC_Check(self)) {
-        TYPE_ERROR("requires 'mpc' object");
-        return NULL;
-    }
+    int seenround = 0, seenconv = 0, seenstyle = 0;
 
-    if (!PyArg_ParseTuple(args, "s", &fmtcode)) {
-        return NULL;
-    }
+    FORMAT_SPEC_CHECK(fmtcode);
 
-    rfmtptr = rfmt;
-    ifmtptr = ifmt;
+    spec->mpcstyle = 0;
+    rfmtptr = spec->rfmt;
+    ifmtptr = spec->ifmt;
     fmtptr = fmt;
     *(rfmtptr++) = '%';
     *(ifmtptr++) = '%';
@@ -406,7 +353,7 @@ GMPy_MPC_Format(PyObject *self, PyObject *args)
             if (seenalign || seensign || seendecimal || seendigits ||
                 seenround || seenstyle) {
                 VALUE_ERROR("Invalid conversion specification");
-                return NULL;
+                return -1;
             }
             else {
                 *(fmtptr++) = *p;
@@ -418,7 +365,7 @@ GMPy_MPC_Format(PyObject *self, PyObject *args)
             if (seensign || seendecimal || seendigits || seenround ||
                 seenstyle) {
                 VALUE_ERROR("Invalid conversion specification");
-                return NULL;
+                return -1;
             }
             else {
                 *(rfmtptr++) = *p;
@@ -435,7 +382,7 @@ GMPy_MPC_Format(PyObject *self, PyObject *args)
         if (*p == '.') {
             if (seendecimal == 2 || seendigits || seenround || seenstyle) {
                 VALUE_ERROR("Invalid conversion specification");
-                return NULL;
+                return -1;
             }
             else {
                 if (!seendecimal) {
@@ -453,7 +400,7 @@ GMPy_MPC_Format(PyObject *self, PyObject *args)
         if (isdigit(*p)) {
             if (seendigits || seenround || seenstyle) {
                 VALUE_ERROR("Invalid conversion specification");
-                return NULL;
+                return -1;
             }
             else if (seendecimal == 1) {
                 *(rfmtptr++) = *p;
@@ -482,7 +429,7 @@ GMPy_MPC_Format(PyObject *self, PyObject *args)
             *p == 'N' ) {
             if (seenround || seenstyle) {
                 VALUE_ERROR("Invalid conversion specification");
-                return NULL;
+                return -1;
             }
             else {
                 *(rfmtptr++) = *p;
@@ -494,11 +441,11 @@ GMPy_MPC_Format(PyObject *self, PyObject *args)
         if (*p == 'P' || *p == 'M') {
             if (seenstyle) {
                 VALUE_ERROR("Invalid conversion specification");
-                return NULL;
+                return -1;
             }
             else {
                 if (*p == 'M')
-                    mpcstyle = 1;
+                    spec->mpcstyle = 1;
                 seenstyle = 1;
                 continue;
             }
@@ -512,7 +459,7 @@ GMPy_MPC_Format(PyObject *self, PyObject *args)
             break;
         }
         VALUE_ERROR("Invalid conversion specification");
-        return NULL;
+        return -1;
     }
 
     if (!seensign) {
@@ -532,96 +479,393 @@ GMPy_MPC_Format(PyObject *self, PyObject *args)
     *(ifmtptr) = '\00';
     *(fmtptr) = '\00';
 
-    /* Format the real part.... */
+    /* If Python style is wanted, convert the '-' or ' ' sign indicator of
+     * the imaginary part to '+'. */
 
-    rbuflen = mpfr_asprintf(&realbuf, rfmt,
-                           mpc_realref(MPC(self)));
-
-    if (rbuflen < 0) {
-        mpfr_free_str(realbuf);
-        SYSTEM_ERROR("Internal error in mpfr_asprintf");
-        return NULL;
-    }
-
-    /* Format the imaginary part. If Python style is wanted, convert the '-'
-     * or ' ' sign indicator to '+'. */
-
-    if (!mpcstyle) {
-        if (ifmt[1] == ' ' || ifmt[1] == '-' || ifmt[1] == '+') {
-            ifmt[1] = '+';
+    if (!spec->mpcstyle) {
+        if (spec->ifmt[1] == ' ' || spec->ifmt[1] == '-' || spec->ifmt[1] == '+') {
+            spec->ifmt[1] = '+';
         }
         else {
-            mpfr_free_str(realbuf);
             VALUE_ERROR("Invalid conversion specification for imag");
-            return NULL;
+            return -1;
         }
     }
 
-    ibuflen = mpfr_asprintf(&imagbuf, ifmt,
-                           mpc_imagref(MPC(self)));
+    return format_set_field(spec, fmt);
+}
+
+/* Return the parsed form of fmtcode for the given kind, from the cache if
+ * possible. A specification too long for the cache is parsed into *temp.
+ * Returns NULL with an exception set if fmtcode is invalid.
+ */
 
-    if (ibuflen < 0) {
-        mpfr_free_str(realbuf);
-        mpfr_free_str(imagbuf);
-        SYSTEM_ERROR("Internal error in mpfr_asprintf");
+static gmpy_format_spec *
+format_spec_lookup(int kind, const char *fmtcode, gmpy_format_spec *temp)
+{
+    gmpy_format_spec *spec = temp;
+    const char *p;
+    size_t len = strlen(fmtcode);
+    unsigned long hash = 5381;
+    int res;
+
+    if (len < GMPY_FORMAT_SPEC_MAX) {
+        for (p = fmtcode; *p; p++)
+            hash = hash * 33 + (unsigned char)*p;
+        spec = &gmpy_format_cache[kind][hash % GMPY_FORMAT_CACHE_SIZE];
+        if (spec->used && !strcmp(spec->spec, fmtcode))
+            return spec;
+        spec->used = 0;
+    }
+
+    if (kind == FORMAT_MPZ)
+        res = format_parse_mpz(fmtcode, spec);
+    else if (kind == FORMAT_MPFR)
+        res = format_parse_mpfr(fmtcode, spec);
+    else
+        res = format_parse_mpc(fmtcode, spec);
+    if (res < 0)
         return NULL;
+
+    if (spec != temp) {
+        strcpy(spec->spec, fmtcode);
+        spec->used = 1;
+    }
+    return spec;
+}
+
+/* Formatted values are appended to a gmpy_strbuf. It starts out in a
+ * caller supplied buffer, usually on the stack, and moves to memory from
+ * GMPY_MALLOC() when it grows. One extra byte is always kept for the
+ * trailing NULL byte written by mpfr_snprintf().
+ */
+
+typedef struct {
+    char *buf;
+    size_t len, size;
+    char *stack;
+} gmpy_strbuf;
+
+static void
+strbuf_init(gmpy_strbuf *b, char *stack, size_t size)
+{
+    b->buf = b->stack = stack;
+    b->len = 0;
+    b->size = size;
+}
+
+static void
+strbuf_free(gmpy_strbuf *b)
+{
+    if (b->buf != b->stack)
+        GMPY_FREE(b->buf);
+}
+
+/* Make room for n more characters. Returns -1 with an exception set if
+ * memory is exhausted.
+ */
+
+static int
+strbuf_reserve(gmpy_strbuf *b, size_t n)
+{
+    size_t size = b->size;
+    char *newbuf;
+
+    if (b->len + n + 1 <= size)
+        return 0;
+    if (n > PY_SSIZE_T_MAX - b->len - 1) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    while (size < b->len + n + 1)
+        size = size < (PY_SSIZE_T_MAX >> 1) ? 2 * size : b->len + n + 1;
+    if (b->buf == b->stack) {
+        if ((newbuf = GMPY_MALLOC(size)))
+            memcpy(newbuf, b->buf, b->len);
     }
+    else
+        newbuf = GMPY_REALLOC(b->buf, size);
+    if (!newbuf) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    b->buf = newbuf;
+    b->size = size;
+    return 0;
+}
+
+static int
+strbuf_append(gmpy_strbuf *b, const char *s, size_t n)
+{
+    if (strbuf_reserve(b, n) < 0)
+        return -1;
+    memcpy(b->buf + b->len, s, n);
+    b->len += n;
+    return 0;
+}
+
+/* Pad the characters appended since 'start' to the field width of spec. */
+
+static int
+format_pad(gmpy_strbuf *b, size_t start, const gmpy_format_spec *spec)
+{
+    size_t len = b->len - start, pad, left;
+    char *p;
+
+    if ((size_t)spec->width <= len)
+        return 0;
+    if (strbuf_reserve(b, (size_t)spec->width - len) < 0)
+        return -1;
+    p = b->buf + start;
+    pad = (size_t)spec->width - len;
+    if (spec->align == '<')
+        left = 0;
+    else if (spec->align == '^')
+        left = pad / 2;
+    else
+        left = pad;
+    memmove(p + left, p, len);
+    memset(p, spec->fill, left);
+    memset(p + left + len, spec->fill, pad - left);
+    b->len += pad;
+    return 0;
+}
+
+/* Append x formatted with the mpfr_printf() format fmt. If the output does
+ * not fit, it is formatted again after the buffer has grown.
+ */
 
-    /* Combine the real and imaginary components into a single buffer.
-     * Include space for '(', ' ', and 'j)' and possibly appending '.0' twice.
-     */
+static int
+format_append_mpfr_chars(gmpy_strbuf *b, const char *fmt, mpfr_srcptr x)
+{
+    int len;
 
-    tempbuf = GMPY_MALLOC(rbuflen + ibuflen + 10);
-    if (!tempbuf) {
-        mpfr_free_str(realbuf);
-        mpfr_free_str(imagbuf);
-        return PyErr_NoMemory();
+    len = mpfr_snprintf(b->buf + b->len, b->size - b->len, fmt, x);
+    if (len < 0) {
+        SYSTEM_ERROR("Internal error in mpfr_snprintf");
+        return -1;
+    }
+    if (b->len + (size_t)len + 1 > b->size) {
+        if (strbuf_reserve(b, (size_t)len) < 0)
+            return -1;
+        mpfr_snprintf(b->buf + b->len, (size_t)len + 1, fmt, x);
     }
-    tempbuf[0] = '\00';
-    if (mpcstyle)
-        strcat(tempbuf, "(");
-    strcat(tempbuf, realbuf);
+    b->len += (size_t)len;
+    return 0;
+}
 
-    /* If there isn't a decimal point in the output and the output
-     * is short and only consists of digits, then append .0 */
-    if (strlen(realbuf) < 50 &&
-        strlen(realbuf) == strspn(realbuf, "+- 0123456789")) {
-        strcat(tempbuf, ".0");
+/* If there isn't a decimal point in the characters appended since 'start'
+ * and they only consist of digits, then append .0 */
+
+static int
+format_append_point(gmpy_strbuf *b, size_t start, size_t maxlen)
+{
+    size_t i, len = b->len - start;
+
+    if (len >= maxlen)
+        return 0;
+    for (i = start; i < b->len; i++) {
+        if (!strchr("+- 0123456789", b->buf[i]))
+            return 0;
     }
+    return strbuf_append(b, ".0", 2);
+}
+
+static int
+format_append_mpz(gmpy_strbuf *b, mpz_t z, const gmpy_format_spec *spec)
+{
+    size_t start = b->len;
+
+    if (strbuf_reserve(b, mpz_sizeinbase(z, spec->base < 0 ? -spec->base : spec->base) + 11) < 0)
+        return -1;
+    b->len = mpz_ascii_chars(b->buf + b->len, z, spec->base, spec->option, 0) - b->buf;
+    return format_pad(b, start, spec);
+}
+
+static int
+format_append_mpfr(gmpy_strbuf *b, mpfr_srcptr x, const gmpy_format_spec *spec)
+{
+    size_t start = b->len;
+
+    if (format_append_mpfr_chars(b, spec->rfmt, x) < 0 ||
+        format_append_point(b, start, PY_SSIZE_T_MAX) < 0)
+        return -1;
+    return format_pad(b, start, spec);
+}
+
+static int
+format_append_mpc(gmpy_strbuf *b, mpc_srcptr c, const gmpy_format_spec *spec)
+{
+    size_t start = b->len, part;
+
+    if (spec->mpcstyle && strbuf_append(b, "(", 1) < 0)
+        return -1;
 
-    if (mpcstyle)
-        strcat(tempbuf, " ");
+    /* If the real or imaginary part is short and there isn't a decimal
+     * point, then append .0 */
+    part = b->len;
+    if (format_append_mpfr_chars(b, spec->rfmt, mpc_realref(c)) < 0 ||
+        format_append_point(b, part, 50) < 0)
+        return -1;
+
+    if (spec->mpcstyle) {
+        if (strbuf_append(b, " ", 1) < 0)
+            return -1;
+    }
     else {
         /* Need to insert + if imag is nan or +inf. */
-        if (mpfr_nan_p(mpc_imagref(MPC(self))) ||
-            (mpfr_inf_p(mpc_imagref(MPC(self))) &&
-             mpfr_sgn(mpc_imagref(MPC(self))) > 0)) {
-            strcat(tempbuf, "+");
+        if (mpfr_nan_p(mpc_imagref(c)) ||
+            (mpfr_inf_p(mpc_imagref(c)) && mpfr_sgn(mpc_imagref(c)) > 0)) {
+            if (strbuf_append(b, "+", 1) < 0)
+                return -1;
         }
     }
-    strcat(tempbuf, imagbuf);
-    if (strlen(imagbuf) < 50 &&
-        strlen(imagbuf) == strspn(imagbuf, "+- 0123456789")) {
-        strcat(tempbuf, ".0");
+
+    part = b->len;
+    if (format_append_mpfr_chars(b, spec->ifmt, mpc_imagref(c)) < 0 ||
+        format_append_point(b, part, 50) < 0)
+        return -1;
+
+    if (strbuf_append(b, spec->mpcstyle ? ")" : "j", 1) < 0)
+        return -1;
+    return format_pad(b, start, spec);
+}
+
+static PyObject *
+GMPy_MPZ_Format(PyObject *self, PyObject *args)
+{
+    PyObject *result = NULL;
+    gmpy_format_spec temp, *spec;
+    gmpy_strbuf b;
+    char stackbuf[GMPY_FORMAT_BUFSIZE];
+    char *fmtcode = 0;
+
+    if (!CHECK_MPZANY(self)) {
+        TYPE_ERROR("requires mpz type");
+        return NULL;
     }
 
-    if (mpcstyle)
-        strcat(tempbuf, ")");
-    else
-        strcat(tempbuf, "j");
+    if (!PyArg_ParseTuple(args, "s", &fmtcode))
+        return NULL;
+
+    if (!(spec = format_spec_lookup(FORMAT_MPZ, fmtcode, &temp)))
+        return NULL;
+
+    strbuf_init(&b, stackbuf, sizeof(stackbuf));
+    if (format_append_mpz(&b, MPZ(self), spec) == 0)
+        result = Py2or3String_FromStringAndSize(b.buf, b.len);
+    strbuf_free(&b);
+    return result;
+}
+
+PyDoc_STRVAR(GMPy_doc_mpfr_format,
+"x.__format__(fmt) -> string\n\n"
+"Return a Python string by formatting 'x' using the format string\n"
+"'fmt'. A valid format string consists of:\n"
+"     optional alignment code:\n"
+"        '<' -> left shifted in field\n"
+"        '>' -> right shifted in field\n"
+"        '^' -> centered in field\n"
+"     optional leading sign code\n"
+"        '+' -> always display leading sign\n"
+"        '-' -> only display minus for negative values\n"
+"        ' ' -> minus for negative values, space for positive values\n"
+"     optional width.precision\n"
+"     optional rounding mode:\n"
+"        'U' -> round toward plus Infinity\n"
+"        'D' -> round toward minus Infinity\n"
+"        'Y' -> round away from zero\n"
+"        'Z' -> round toward zero\n"
+"        'N' -> round to nearest\n"
+"     optional conversion code:\n"
+"        'a','A' -> hex format\n"
+"        'b'     -> binary format\n"
+"        'e','E' -> scientific format\n"
+"        'f','F' -> fixed point format\n"
+"        'g','G' -> fixed or float format\n\n"
+"The default format is '.6f'.");
+
+static PyObject *
+GMPy_MPFR_Format(PyObject *self, PyObject *args)
+{
+    PyObject *result = NULL;
+    gmpy_format_spec temp, *spec;
+    gmpy_strbuf b;
+    char stackbuf[GMPY_FORMAT_BUFSIZE];
+    char *fmtcode = 0;
+
+    if (!MPFR_Check(self)) {
+        TYPE_ERROR("requires mpfr type");
+        return NULL;
+    }
+
+    if (!PyArg_ParseTuple(args, "s", &fmtcode))
+        return NULL;
+
+    if (!(spec = format_spec_lookup(FORMAT_MPFR, fmtcode, &temp)))
+        return NULL;
+
+    strbuf_init(&b, stackbuf, sizeof(stackbuf));
+    if (format_append_mpfr(&b, MPFR(self), spec) == 0)
+        result = Py2or3String_FromStringAndSize(b.buf, b.len);
+    strbuf_free(&b);
+    return result;
+}
+
+PyDoc_STRVAR(GMPy_doc_mpc_format,
+"x.__format__(fmt) -> string\n\n"
+"Return a Python string by formatting 'x' using the format string\n"
+"'fmt'. A valid format string consists of:\n"
+"     optional alignment code:\n"
+"        '<' -> left shifted in field\n"
+"        '>' -> right shifted in field\n"
+"        '^' -> centered in field\n"
+"     optional leading sign code\n"
+"        '+' -> always display leading sign\n"
+"        '-' -> only display minus for negative values\n"
+"        ' ' -> minus for negative values, space for positive values\n"
+"     optional width.real_precision.imag_precision\n"
+"     optional rounding mode:\n"
+"        'U' -> round toward plus infinity\n"
+"        'D' -> round toward minus infinity\n"
+"        'Z' -> round toward zero\n"
+"        'N' -> round to nearest\n"
+"     optional output style:\n"
+"        'P' -> Python style, 1+2j, (default)\n"
+"        'M' -> MPC style, (1 2)\n"
+"     optional conversion code:\n"
+"        'a','A' -> hex format\n"
+"        'b'     -> binary format\n"
+"        'e','E' -> scientific format\n"
+"        'f','F' -> fixed point format\n"
+"        'g','G' -> fixed or scientific format\n\n"
+"The default format is 'f'.");
 
-    mpfr_free_str(realbuf);
-    mpfr_free_str(imagbuf);
+static PyObject *
+GMPy_MPC_Format(PyObject *self, PyObject *args)
+{
+    PyObject *result = NULL;
+    gmpy_format_spec temp, *spec;
+    gmpy_strbuf b;
+    char stackbuf[GMPY_FORMAT_BUFSIZE];
+    char *fmtcode = 0;
+
+    if (!MPC_Check(self)) {
+        TYPE_ERROR("requires 'mpc' object");
+        return NULL;
+    }
 
-    tempstr = Py_BuildValue("s", tempbuf);
-    if (!tempstr) {
-        GMPY_FREE(tempbuf);
+    if (!PyArg_ParseTuple(args, "s", &fmtcode)) {
         return NULL;
     }
 
-    result = PyObject_CallMethod(tempstr, "__format__", "(s)", fmt);
+    if (!(spec = format_spec_lookup(FORMAT_MPC, fmtcode, &temp)))
+        return NULL;
 
-    Py_DECREF(tempstr);
+    strbuf_init(&b, stackbuf, sizeof(stackbuf));
+    if (format_append_mpc(&b, MPC(self), spec) == 0)
+        result = Py2or3String_FromStringAndSize(b.buf, b.len);
+    strbuf_free(&b);
     return result;
 }
 
@@ -776,3 +1020,222 @@ GMPy_Context_Digits(PyObject *self, PyObject *args)
 }
 
 
+
+/* format_many() and digits_many() write every value into one gmpy_strbuf
+ * and create a single str, or bytes if the separator is bytes. Python
+ * integers are read into a temporary mpz_t instead of an mpz object.
+ */
+
+static int
+format_many_sep(PyObject *obj, const char **sep, Py_ssize_t *seplen, int *asbytes)
+{
+    if (PyBytes_Check(obj)) {
+        *sep = PyBytes_AS_STRING(obj);
+        *seplen = PyBytes_GET_SIZE(obj);
+        *asbytes = 1;
+        return 0;
+    }
+#if PY_VERSION_HEX >= 0x03030000
+    if (PyUnicode_Check(obj)) {
+        if (!(*sep = PyUnicode_AsUTF8AndSize(obj, seplen)))
+            return -1;
+        return 0;
+    }
+#endif
+    TYPE_ERROR("sep must be str or bytes");
+    return -1;
+}
+
+static PyObject *
+format_many_result(gmpy_strbuf *b, int asbytes)
+{
+    if (asbytes)
+        return PyBytes_FromStringAndSize(b->buf, b->len);
+    return Py2or3String_FromStringAndSize(b->buf, b->len);
+}
+
+PyDoc_STRVAR(GMPy_doc_function_format_many,
+"format_many(values, fmt='', sep=',') -> string\n\n"
+"Return sep.join(format(x, fmt) for x in values), with every value\n"
+"written into a single buffer. Integers are formatted as mpz; real and\n"
+"complex values that are not mpfr or mpc are converted first. The result\n"
+"is bytes if sep is bytes.");
+
+static PyObject *
+GMPy_Function_FormatMany(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    static char *kwlist[] = {"values", "fmt", "sep", NULL};
+    PyObject *values, *sepobj = NULL, *seq, *result = NULL;
+    PyObject **items;
+    gmpy_format_spec temps[3], *specs[3] = {NULL, NULL, NULL};
+    gmpy_strbuf b;
+    char stackbuf[4 * GMPY_FORMAT_BUFSIZE];
+    const char *fmtcode = "", *sep = ",";
+    Py_ssize_t seplen = 1, i, n;
+    int asbytes = 0, kind, res;
+    mpz_t tempz;
+    CTXT_Object *context = NULL;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|sO:format_many", kwlist,
+                                     &values, &fmtcode, &sepobj))
+        return NULL;
+
+    if (sepobj && format_many_sep(sepobj, &sep, &seplen, &asbytes) < 0)
+        return NULL;
+
+    CHECK_CONTEXT(context);
+
+    if (!(seq = PySequence_Fast(values, "format_many() requires an iterable")))
+        return NULL;
+    n = PySequence_Fast_GET_SIZE(seq);
+    items = PySequence_Fast_ITEMS(seq);
+
+    strbuf_init(&b, stackbuf, sizeof(stackbuf));
+    mpz_init(tempz);
+
+    for (i = 0; i < n; i++) {
+        PyObject *x = items[i], *temp = NULL;
+
+        if (i && strbuf_append(&b, sep, seplen) < 0)
+            goto done;
+
+        if (IS_INTEGER(x))
+            kind = FORMAT_MPZ;
+        else if (IS_REAL(x))
+            kind = FORMAT_MPFR;
+        else if (IS_COMPLEX(x))
+            kind = FORMAT_MPC;
+        else {
+            TYPE_ERROR("format_many() requires integer, real or complex values");
+            goto done;
+        }
+
+        /* Each kind is looked up once; the slot is not reused meanwhile. */
+        if (!specs[kind] &&
+            !(specs[kind] = format_spec_lookup(kind, fmtcode, &temps[kind])))
+            goto done;
+
+        if (kind == FORMAT_MPZ) {
+            if (CHECK_MPZANY(x))
+                res = format_append_mpz(&b, MPZ(x), specs[kind]);
+            else {
+                mpz_set_PyIntOrLong(tempz, x);
+                res = format_append_mpz(&b, tempz, specs[kind]);
+            }
+        }
+        else if (kind == FORMAT_MPFR) {
+            if (!MPFR_Check(x) &&
+                !(x = temp = (PyObject*)GMPy_MPFR_From_Real(x, 1, context)))
+                goto done;
+            res = format_append_mpfr(&b, MPFR(x), specs[kind]);
+        }
+        else {
+            if (!MPC_Check(x) &&
+                !(x = temp = (PyObject*)GMPy_MPC_From_Complex(x, 1, 1, context)))
+                goto done;
+            res = format_append_mpc(&b, MPC(x), specs[kind]);
+        }
+        Py_XDECREF(temp);
+        if (res < 0)
+            goto done;
+    }
+
+    result = format_many_result(&b, asbytes);
+
+  done:
+    mpz_clear(tempz);
+    strbuf_free(&b);
+    Py_DECREF(seq);
+    return result;
+}
+
+PyDoc_STRVAR(GMPy_doc_function_digits_many,
+"digits_many(values, base=10, sep=',') -> string\n\n"
+"Return sep.join(digits(x, base) for x in values), with every value\n"
+"written into a single buffer. The values must be integers or rationals.\n"
+"The result is bytes if sep is bytes.");
+
+static PyObject *
+GMPy_Function_DigitsMany(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    static char *kwlist[] = {"values", "base", "sep", NULL};
+    PyObject *values, *sepobj = NULL, *seq, *result = NULL;
+    PyObject **items;
+    gmpy_strbuf b;
+    char stackbuf[4 * GMPY_FORMAT_BUFSIZE];
+    const char *sep = ",";
+    Py_ssize_t seplen = 1, i, n;
+    int base = 10, asbytes = 0;
+    mpz_t tempz;
+    CTXT_Object *context = NULL;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|iO:digits_many", kwlist,
+                                     &values, &base, &sepobj))
+        return NULL;
+
+    if (base < 2 || base > 62) {
+        VALUE_ERROR("base must be in the interval 2 ... 62");
+        return NULL;
+    }
+
+    if (sepobj && format_many_sep(sepobj, &sep, &seplen, &asbytes) < 0)
+        return NULL;
+
+    CHECK_CONTEXT(context);
+
+    if (!(seq = PySequence_Fast(values, "digits_many() requires an iterable")))
+        return NULL;
+    n = PySequence_Fast_GET_SIZE(seq);
+    items = PySequence_Fast_ITEMS(seq);
+
+    strbuf_init(&b, stackbuf, sizeof(stackbuf));
+    mpz_init(tempz);
+
+    for (i = 0; i < n; i++) {
+        PyObject *x = items[i];
+        MPQ_Object *tempq;
+
+        if (i && strbuf_append(&b, sep, seplen) < 0)
+            goto done;
+
+        /* As for mpz.digits() and mpq.digits(). */
+        if (IS_INTEGER(x)) {
+            mpz_ptr z = tempz;
+
+            if (CHECK_MPZANY(x))
+                z = MPZ(x);
+            else
+                mpz_set_PyIntOrLong(tempz, x);
+            if (strbuf_reserve(&b, mpz_sizeinbase(z, base) + 11) < 0)
+                goto done;
+            b.len = mpz_ascii_chars(b.buf + b.len, z, base, 16, 0) - b.buf;
+        }
+        else if (IS_RATIONAL(x)) {
+            if (!(tempq = GMPy_MPQ_From_Rational(x, context)))
+                goto done;
+            if (strbuf_reserve(&b, mpz_sizeinbase(mpq_numref(tempq->q), base) +
+                                   mpz_sizeinbase(mpq_denref(tempq->q), base) + 22) < 0) {
+                Py_DECREF((PyObject*)tempq);
+                goto done;
+            }
+            b.len = mpz_ascii_chars(b.buf + b.len, mpq_numref(tempq->q), base, 0, 0) - b.buf;
+            if (mpz_cmp_ui(mpq_denref(tempq->q), 1)) {
+                b.buf[b.len++] = '/';
+                b.len = mpz_ascii_chars(b.buf + b.len, mpq_denref(tempq->q), base, 0, 0) - b.buf;
+            }
+            Py_DECREF((PyObject*)tempq);
+        }
+        else {
+            TYPE_ERROR("digits_many() requires integer or rational values");
+            goto done;
+        }
+    }
+
+    result = format_many_result(&b, asbytes);
+
+  done:
+    mpz_clear(tempz);
+    strbuf_free(&b);
+    Py_DECREF(seq);
+    return result;
+}
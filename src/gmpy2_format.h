@@ -42,6 +42,8 @@ static PyObject * GMPy_MPFR_Format(PyObject *self, PyObject *args);
 static PyObject * GMPy_MPC_Digits_Method(PyObject *self, PyObject *args);
 static PyObject * GMPy_MPC_Format(PyObject *self, PyObject *args);
 static PyObject * GMPy_Context_Digits(PyObject *self, PyObject *args);
+static PyObject * GMPy_Function_FormatMany(PyObject *self, PyObject *args, PyObject *kwargs);
+static PyObject * GMPy_Function_DigitsMany(PyObject *self, PyObject *args, PyObject *kwargs);
 
 #ifdef __cplusplus
 }
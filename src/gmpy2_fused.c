@@ -108,8 +108,11 @@ _GMPy_MPFR_FMA(PyObject *x, PyObject *y, PyObject *z, CTXT_Object *context)
         return NULL;
     }
     
-    mpfr_clear_flags();
-    result->rc = mpfr_fma(result->f, MPFR(x), MPFR(y), MPFR(z), GET_MPFR_ROUND(context));
+    if (!GMPy_MPFR_D53_FMA(result, (MPFR_Object*)x, (MPFR_Object*)y,
+                           (MPFR_Object*)z, context)) {
+        mpfr_clear_flags();
+        result->rc = mpfr_fma(result->f, MPFR(x), MPFR(y), MPFR(z), GET_MPFR_ROUND(context));
+    }
     GMPY_MPFR_CLEANUP(result, context, "fma()");
     return (PyObject*)result;
 }
@@ -348,3 +351,428 @@ PyDoc_STRVAR(GMPy_doc_function_fms,
 "Return correctly rounded result of (x * y) - z.");
 
 GMPY_MPFR_MPC_TRIOP_TEMPLATE(FMS, fms);
+
+/* In-place fused operations for xmpz. The product is accumulated directly
+ * into the xmpz with mpz_addmul() or mpz_submul(), so no result object and
+ * no temporary for the product are created. A factor that is a Python int
+ * that fits in a long uses mpz_addmul_ui() or mpz_submul_ui().
+ */
+
+/* Point *z at the value of an integer argument. If obj is not an mpz or an
+ * xmpz, it is converted into *temp, which the caller must release with
+ * Py_XDECREF().
+ */
+
+static int
+fused_integer_arg(PyObject *obj, mpz_ptr *z, MPZ_Object **temp, CTXT_Object *context)
+{
+    if (CHECK_MPZANY(obj)) {
+        *z = MPZ(obj);
+        return 0;
+    }
+    if (!(*temp = GMPy_MPZ_From_Integer(obj, context)))
+        return -1;
+    *z = (*temp)->z;
+    return 0;
+}
+
+/* Set rop to rop + x * y, or rop - x * y if 'sub' is set. */
+
+static int
+GMPy_MPZ_AddMul_InPlace(mpz_t rop, PyObject *x, PyObject *y, int sub, CTXT_Object *context)
+{
+    MPZ_Object *tempx = NULL, *tempy = NULL;
+    mpz_ptr zx, zy;
+    PyObject *small = NULL;
+    long temp;
+    int error;
+
+    if (PyIntOrLong_Check(y))
+        small = y;
+    else if (PyIntOrLong_Check(x)) {
+        small = x;
+        x = y;
+    }
+
+    if (small) {
+        temp = GMPy_Integer_AsLongAndError(small, &error);
+        if (!error) {
+            if (fused_integer_arg(x, &zx, &tempx, context) < 0)
+                return -1;
+            if (temp < 0)
+                sub = !sub;
+            if (sub)
+                mpz_submul_ui(rop, zx, temp < 0 ? -(unsigned long)temp : (unsigned long)temp);
+            else
+                mpz_addmul_ui(rop, zx, temp < 0 ? -(unsigned long)temp : (unsigned long)temp);
+            Py_XDECREF((PyObject*)tempx);
+            return 0;
+        }
+        y = small;
+    }
+
+    if (fused_integer_arg(x, &zx, &tempx, context) < 0 ||
+        fused_integer_arg(y, &zy, &tempy, context) < 0) {
+        Py_XDECREF((PyObject*)tempx);
+        return -1;
+    }
+    if (sub)
+        mpz_submul(rop, zx, zy);
+    else
+        mpz_addmul(rop, zx, zy);
+    Py_XDECREF((PyObject*)tempx);
+    Py_XDECREF((PyObject*)tempy);
+    return 0;
+}
+
+static PyObject *
+xmpz_addmul(PyObject *self, PyObject *args, int sub, const char *msg)
+{
+    CTXT_Object *context = NULL;
+
+    if (PyTuple_GET_SIZE(args) != 2 ||
+        !IS_INTEGER(PyTuple_GET_ITEM(args, 0)) ||
+        !IS_INTEGER(PyTuple_GET_ITEM(args, 1))) {
+        TYPE_ERROR(msg);
+        return NULL;
+    }
+
+    XMPZ_CHECK_EXPORTS(self, NULL);
+    CHECK_CONTEXT(context);
+
+    if (GMPy_MPZ_AddMul_InPlace(MPZ(self), PyTuple_GET_ITEM(args, 0),
+                                PyTuple_GET_ITEM(args, 1), sub, context) < 0)
+        return NULL;
+    Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(GMPy_doc_xmpz_method_addmul,
+"x.addmul(a, b)\n\n"
+"Add a * b to x in place without creating a temporary for the product.");
+
+static PyObject *
+GMPy_XMPZ_Method_AddMul(PyObject *self, PyObject *args)
+{
+    return xmpz_addmul(self, args, 0, "addmul() requires 'int','int' arguments");
+}
+
+PyDoc_STRVAR(GMPy_doc_xmpz_method_submul,
+"x.submul(a, b)\n\n"
+"Subtract a * b from x in place without creating a temporary for the\n"
+"product.");
+
+static PyObject *
+GMPy_XMPZ_Method_SubMul(PyObject *self, PyObject *args)
+{
+    return xmpz_addmul(self, args, 1, "submul() requires 'int','int' arguments");
+}
+
+PyDoc_STRVAR(GMPy_doc_xmpz_method_fma_inplace,
+"x.fma_inplace(a, b)\n\n"
+"Set x to x * a + b in place. One step of Horner's rule for evaluating\n"
+"a polynomial.");
+
+static PyObject *
+GMPy_XMPZ_Method_FMA_InPlace(PyObject *self, PyObject *args)
+{
+    MPZ_Object *tempa = NULL, *tempb = NULL;
+    PyObject *a, *b;
+    mpz_ptr za, zb;
+    long temp;
+    int error;
+    CTXT_Object *context = NULL;
+
+    if (PyTuple_GET_SIZE(args) != 2) {
+        TYPE_ERROR("fma_inplace() requires 'int','int' arguments");
+        return NULL;
+    }
+
+    a = PyTuple_GET_ITEM(args, 0);
+    b = PyTuple_GET_ITEM(args, 1);
+    if (!IS_INTEGER(a) || !IS_INTEGER(b)) {
+        TYPE_ERROR("fma_inplace() requires 'int','int' arguments");
+        return NULL;
+    }
+
+    XMPZ_CHECK_EXPORTS(self, NULL);
+    CHECK_CONTEXT(context);
+
+    if (PyIntOrLong_Check(a)) {
+        temp = GMPy_Integer_AsLongAndError(a, &error);
+        if (!error) {
+            mpz_mul_si(MPZ(self), MPZ(self), temp);
+            goto add;
+        }
+    }
+    if (fused_integer_arg(a, &za, &tempa, context) < 0)
+        return NULL;
+    mpz_mul(MPZ(self), MPZ(self), za);
+    Py_XDECREF((PyObject*)tempa);
+
+  add:
+    if (PyIntOrLong_Check(b)) {
+        temp = GMPy_Integer_AsLongAndError(b, &error);
+        if (!error) {
+            if (temp >= 0)
+                mpz_add_ui(MPZ(self), MPZ(self), (unsigned long)temp);
+            else
+                mpz_sub_ui(MPZ(self), MPZ(self), -(unsigned long)temp);
+            Py_RETURN_NONE;
+        }
+    }
+    if (fused_integer_arg(b, &zb, &tempb, context) < 0)
+        return NULL;
+    mpz_add(MPZ(self), MPZ(self), zb);
+    Py_XDECREF((PyObject*)tempb);
+    Py_RETURN_NONE;
+}
+
+/* Polynomial evaluation by Horner's rule. The coefficients are converted
+ * once and every step is a single fused multiply-add into an accumulator
+ * that carries a few guard bits per doubling of the degree, so only the
+ * final value is rounded to the context.
+ */
+
+PyDoc_STRVAR(GMPy_doc_function_polyval,
+"polyval(coeffs, x) -> mpfr | mpc\n\n"
+"Return the value of the polynomial with coefficients coeffs, highest\n"
+"degree first, at x. The value is computed with fused multiply-add at a\n"
+"slightly higher precision and rounded once. The result is an mpc if x\n"
+"or any coefficient is complex.");
+
+PyDoc_STRVAR(GMPy_doc_context_polyval,
+"context.polyval(coeffs, x) -> mpfr | mpc\n\n"
+"Return the value of the polynomial with coefficients coeffs, highest\n"
+"degree first, at x. The value is computed with fused multiply-add at a\n"
+"slightly higher precision and rounded once. The result is an mpc if x\n"
+"or any coefficient is complex.");
+
+PyDoc_STRVAR(GMPy_doc_function_polyval_many,
+"polyval_many(coeffs, xs) -> list\n\n"
+"Return [polyval(coeffs, x) for x in xs], converting the coefficients\n"
+"only once. All results are mpc if any value in xs or any coefficient is\n"
+"complex.");
+
+PyDoc_STRVAR(GMPy_doc_context_polyval_many,
+"context.polyval_many(coeffs, xs) -> list\n\n"
+"Return [polyval(coeffs, x) for x in xs], converting the coefficients\n"
+"only once. All results are mpc if any value in xs or any coefficient is\n"
+"complex.");
+
+/* Convert the items of seq to mpfr, or to mpc if cplx is set. Returns a new
+ * array of new references, or NULL with an exception set.
+ */
+static PyObject **
+polyval_convert(PyObject *seq, int cplx, CTXT_Object *context)
+{
+    Py_ssize_t i, n = PySequence_Fast_GET_SIZE(seq);
+    PyObject **items = PySequence_Fast_ITEMS(seq);
+    PyObject **out;
+
+    if (!(out = PyMem_New(PyObject*, n ? n : 1))) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+    for (i = 0; i < n; i++) {
+        if (cplx)
+            out[i] = (PyObject*)GMPy_MPC_From_Complex(items[i], 1, 1, context);
+        else
+            out[i] = (PyObject*)GMPy_MPFR_From_Real(items[i], 1, context);
+        if (!out[i]) {
+            while (i-- > 0)
+                Py_DECREF(out[i]);
+            PyMem_Free(out);
+            return NULL;
+        }
+    }
+    return out;
+}
+
+static void
+polyval_release(PyObject **items, Py_ssize_t n)
+{
+    Py_ssize_t i;
+
+    for (i = 0; i < n; i++)
+        Py_DECREF(items[i]);
+    PyMem_Free(items);
+}
+
+/* Check that every item of seq is a real (or complex, when *cplx is set on
+ * return) number.
+ */
+static int
+polyval_scan(PyObject *seq, int *cplx)
+{
+    Py_ssize_t i, n = PySequence_Fast_GET_SIZE(seq);
+    PyObject **items = PySequence_Fast_ITEMS(seq);
+
+    for (i = 0; i < n; i++) {
+        if (IS_REAL(items[i]))
+            continue;
+        if (IS_COMPLEX(items[i])) {
+            *cplx = 1;
+            continue;
+        }
+        TYPE_ERROR("polyval() argument type not supported");
+        return 0;
+    }
+    return 1;
+}
+
+static PyObject *
+polyval_eval(PyObject **cf, Py_ssize_t n, PyObject *x, int cplx,
+             CTXT_Object *context)
+{
+    Py_ssize_t i;
+    mpfr_prec_t wprec, guard = 8;
+
+    for (i = n; i > 0; i >>= 1)
+        guard++;
+
+    if (cplx) {
+        MPC_Object *result;
+        mpc_t acc;
+
+        if (!(result = GMPy_MPC_New(0, 0, context)))
+            return NULL;
+        wprec = GET_REAL_PREC(context);
+        if (GET_IMAG_PREC(context) > wprec)
+            wprec = GET_IMAG_PREC(context);
+        wprec += guard;
+        mpfr_clear_flags();
+        if (n == 0) {
+            result->rc = mpc_set_ui(result->c, 0, GET_MPC_ROUND(context));
+        }
+        else {
+            mpc_init2(acc, wprec);
+            mpc_set(acc, MPC(cf[0]), MPC_RNDNN);
+            for (i = 1; i < n; i++)
+                mpc_fma(acc, acc, MPC(x), MPC(cf[i]), MPC_RNDNN);
+            result->rc = mpc_set(result->c, acc, GET_MPC_ROUND(context));
+            mpc_clear(acc);
+        }
+        GMPY_MPC_CLEANUP(result, context, "polyval()");
+        return (PyObject*)result;
+    }
+    else {
+        MPFR_Object *result;
+        mpfr_t acc;
+
+        if (!(result = GMPy_MPFR_New(0, context)))
+            return NULL;
+        wprec = GET_MPFR_PREC(context) + guard;
+        mpfr_clear_flags();
+        if (n == 0) {
+            result->rc = mpfr_set_ui(result->f, 0, GET_MPFR_ROUND(context));
+        }
+        else {
+            mpfr_init2(acc, wprec);
+            mpfr_set(acc, MPFR(cf[0]), MPFR_RNDN);
+            for (i = 1; i < n; i++)
+                mpfr_fma(acc, acc, MPFR(x), MPFR(cf[i]), MPFR_RNDN);
+            result->rc = mpfr_set(result->f, acc, GET_MPFR_ROUND(context));
+            mpfr_clear(acc);
+        }
+        GMPY_MPFR_CLEANUP(result, context, "polyval()");
+        return (PyObject*)result;
+    }
+}
+
+static PyObject *
+polyval_common(PyObject *coeffs, PyObject *xarg, int many, CTXT_Object *context)
+{
+    PyObject *cseq, *xseq = NULL, *result = NULL;
+    PyObject **cf = NULL, **xv = NULL;
+    Py_ssize_t i, n, m = 0;
+    int cplx = 0;
+
+    if (!(cseq = PySequence_Fast(coeffs, "polyval() coefficients must be a sequence")))
+        return NULL;
+    n = PySequence_Fast_GET_SIZE(cseq);
+
+    if (many) {
+        if (!(xseq = PySequence_Fast(xarg, "polyval_many() requires a sequence of values")))
+            goto done;
+    }
+    else {
+        if (!(xseq = PyTuple_Pack(1, xarg)))
+            goto done;
+    }
+    m = PySequence_Fast_GET_SIZE(xseq);
+
+    if (!polyval_scan(cseq, &cplx) || !polyval_scan(xseq, &cplx))
+        goto done;
+    if (!(cf = polyval_convert(cseq, cplx, context)))
+        goto done;
+    if (!(xv = polyval_convert(xseq, cplx, context)))
+        goto done;
+
+    if (!many) {
+        result = polyval_eval(cf, n, xv[0], cplx, context);
+        goto done;
+    }
+
+    if (!(result = PyList_New(m)))
+        goto done;
+    for (i = 0; i < m; i++) {
+        PyObject *temp = polyval_eval(cf, n, xv[i], cplx, context);
+
+        if (!temp) {
+            Py_CLEAR(result);
+            goto done;
+        }
+        PyList_SET_ITEM(result, i, temp);
+    }
+
+  done:
+    if (xv)
+        polyval_release(xv, m);
+    if (cf)
+        polyval_release(cf, n);
+    Py_XDECREF(xseq);
+    Py_DECREF(cseq);
+    return result;
+}
+
+static PyObject *
+GMPy_Context_Polyval(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    CTXT_Object *context = NULL;
+
+    if (nargs != 2) {
+        TYPE_ERROR("polyval() requires 2 arguments");
+        return NULL;
+    }
+
+    if (self && CTXT_Check(self)) {
+        context = (CTXT_Object*)self;
+    }
+    else {
+        CHECK_CONTEXT(context);
+    }
+
+    return polyval_common(args[0], args[1], 0, context);
+}
+GMPY_FASTCALL_WRAPPER(GMPy_Context_Polyval)
+
+static PyObject *
+GMPy_Context_PolyvalMany(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    CTXT_Object *context = NULL;
+
+    if (nargs != 2) {
+        TYPE_ERROR("polyval_many() requires 2 arguments");
+        return NULL;
+    }
+
+    if (self && CTXT_Check(self)) {
+        context = (CTXT_Object*)self;
+    }
+    else {
+        CHECK_CONTEXT(context);
+    }
+
+    return polyval_common(args[0], args[1], 1, context);
+}
+GMPY_FASTCALL_WRAPPER(GMPy_Context_PolyvalMany)
@@ -37,14 +37,23 @@ static PyObject * GMPy_Rational_FMA(PyObject *x, PyObject *y, PyObject *z, CTXT_
 static PyObject * GMPy_Real_FMA(PyObject *x, PyObject *y, PyObject *z, CTXT_Object *context);
 static PyObject * GMPy_Complex_FMA(PyObject *x, PyObject *y, PyObject *z, CTXT_Object *context);
 static PyObject * GMPy_Number_FMA(PyObject *x, PyObject *y, PyObject *z, CTXT_Object *context);
-static PyObject * GMPy_Context_FMA(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_FMA(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 
 static PyObject * GMPy_Integer_FMS(PyObject *x, PyObject *y, PyObject *z, CTXT_Object *context);
 static PyObject * GMPy_Rational_FMS(PyObject *x, PyObject *y, PyObject *z, CTXT_Object *context);
 static PyObject * GMPy_Real_FMS(PyObject *x, PyObject *y, PyObject *z, CTXT_Object *context);
 static PyObject * GMPy_Complex_FMS(PyObject *x, PyObject *y, PyObject *z, CTXT_Object *context);
 static PyObject * GMPy_Number_FMS(PyObject *x, PyObject *y, PyObject *z, CTXT_Object *context);
-static PyObject * GMPy_Context_FMS(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_FMS(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+
+static int fused_integer_arg(PyObject *obj, mpz_ptr *z, MPZ_Object **temp, CTXT_Object *context);
+static int GMPy_MPZ_AddMul_InPlace(mpz_t rop, PyObject *x, PyObject *y, int sub, CTXT_Object *context);
+static PyObject * GMPy_XMPZ_Method_AddMul(PyObject *self, PyObject *args);
+static PyObject * GMPy_XMPZ_Method_SubMul(PyObject *self, PyObject *args);
+static PyObject * GMPy_XMPZ_Method_FMA_InPlace(PyObject *self, PyObject *args);
+
+static PyObject * GMPy_Context_Polyval(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPy_Context_PolyvalMany(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,225 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_futures.c                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* submit() runs a function on a concurrent.futures.ThreadPoolExecutor. The
+ * executor is created on first use with get_threads() workers and created
+ * again after set_threads() changes that number, or in a child process
+ * after fork(). The workers are Python threads; the operations that are
+ * worth submitting release the GIL while GMP or MPFR does the work, so
+ * several of them run at once and the caller, or an asyncio event loop,
+ * is not blocked.
+ *
+ * Each task is a PyCFunction whose self is the tuple (context, func, args,
+ * kwargs). The context is a copy of the context of the caller, made by
+ * submit(), so later changes to the caller's context do not affect it.
+ */
+
+#ifdef HAVE_FORK
+#  include <unistd.h>
+#endif
+
+static struct {
+    PyObject *executor;
+    long workers;
+#ifdef HAVE_FORK
+    pid_t pid;
+#endif
+} futures = {NULL, 0};
+
+/* Return a borrowed reference to the executor. */
+
+static PyObject *
+futures_executor(void)
+{
+    PyObject *module, *cls, *temp, *args, *kwargs = NULL;
+    long workers;
+
+#ifndef PY3
+    /* concurrent.futures is not part of the Python 2 standard library. */
+    PyErr_SetString(PyExc_NotImplementedError,
+                    "submit() requires Python 3");
+    return NULL;
+#endif
+
+    if (!(temp = GMPy_get_threads(NULL, NULL)))
+        return NULL;
+    workers = PyIntOrLong_AsLong(temp);
+    Py_DECREF(temp);
+
+#ifdef HAVE_FORK
+    if (futures.executor && futures.pid != getpid()) {
+        /* The worker threads did not survive the fork. */
+        Py_CLEAR(futures.executor);
+    }
+#endif
+
+    if (futures.executor && futures.workers == workers)
+        return futures.executor;
+
+    if (futures.executor) {
+        /* Tasks that were already submitted still finish. */
+        temp = PyObject_CallMethod(futures.executor, "shutdown", "(O)", Py_False);
+        Py_CLEAR(futures.executor);
+        if (!temp)
+            return NULL;
+        Py_DECREF(temp);
+    }
+
+    if (!(module = PyImport_ImportModule("concurrent.futures")))
+        return NULL;
+    cls = PyObject_GetAttrString(module, "ThreadPoolExecutor");
+    Py_DECREF(module);
+    if (!cls)
+        return NULL;
+
+    args = Py_BuildValue("(l)", workers);
+#if PY_VERSION_HEX >= 0x03060000
+    /* thread_name_prefix was added in Python 3.6. */
+    if (args && !(kwargs = Py_BuildValue("{s:s}", "thread_name_prefix", "gmpy2")))
+        Py_CLEAR(args);
+#endif
+    if (args)
+        futures.executor = PyObject_Call(cls, args, kwargs);
+    Py_DECREF(cls);
+    Py_XDECREF(args);
+    Py_XDECREF(kwargs);
+    if (!futures.executor)
+        return NULL;
+
+    futures.workers = workers;
+#ifdef HAVE_FORK
+    futures.pid = getpid();
+#endif
+    return futures.executor;
+}
+
+/* Run a submitted task in a worker thread. */
+
+static PyObject *
+futures_run(PyObject *task, PyObject *unused)
+{
+    PyObject *saved, *result, *temp;
+    CTXT_Object *current;
+
+    CURRENT_CONTEXT(current);
+    if (!(saved = (PyObject*)current))
+        return NULL;
+    Py_INCREF(saved);
+
+    if (!(temp = GMPy_CTXT_Set(NULL, PyTuple_GET_ITEM(task, 0)))) {
+        Py_DECREF(saved);
+        return NULL;
+    }
+    Py_DECREF(temp);
+
+    result = PyObject_Call(PyTuple_GET_ITEM(task, 1),
+                           PyTuple_GET_ITEM(task, 2),
+                           PyTuple_GET_ITEM(task, 3) == Py_None ?
+                               NULL : PyTuple_GET_ITEM(task, 3));
+
+    if (!(temp = GMPy_CTXT_Set(NULL, saved)))
+        Py_CLEAR(result);
+    Py_XDECREF(temp);
+    Py_DECREF(saved);
+    return result;
+}
+
+static PyMethodDef futures_run_def = {
+    "gmpy2_task", futures_run, METH_NOARGS, NULL
+};
+
+PyDoc_STRVAR(GMPy_doc_submit,
+"submit(func, *args, **kwargs) -> concurrent.futures.Future\n\n"
+"Call func(*args, **kwargs) in a background thread and return a\n"
+"Future for the result. The call uses a copy of the current context.\n"
+"Operations such as powmod(), fac(), next_prime(), is_bpsw_prp(),\n"
+"factor(), zeta(), and gamma() release the GIL for large arguments, so\n"
+"submitted calls run concurrently. The number of background threads is\n"
+"get_threads().");
+
+static PyObject *
+GMPy_submit(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *executor, *func, *fargs, *task, *run, *result;
+    CTXT_Object *context = NULL, *copy;
+    Py_ssize_t n = PyTuple_GET_SIZE(args);
+
+    if (n < 1 || !PyCallable_Check(PyTuple_GET_ITEM(args, 0))) {
+        TYPE_ERROR("submit() requires a callable argument");
+        return NULL;
+    }
+    func = PyTuple_GET_ITEM(args, 0);
+
+    if (!(executor = futures_executor()))
+        return NULL;
+
+    CHECK_CONTEXT(context);
+    if (!(copy = (CTXT_Object*)GMPy_CTXT_Copy((PyObject*)context, NULL)))
+        return NULL;
+
+    if (!(fargs = PyTuple_GetSlice(args, 1, n))) {
+        Py_DECREF((PyObject*)copy);
+        return NULL;
+    }
+
+    task = Py_BuildValue("(NONO)", copy, func, fargs,
+                         kwargs ? kwargs : Py_None);
+    if (!task)
+        return NULL;
+
+    run = PyCFunction_New(&futures_run_def, task);
+    Py_DECREF(task);
+    if (!run)
+        return NULL;
+
+    result = PyObject_CallMethod(executor, "submit", "(O)", run);
+    Py_DECREF(run);
+    return result;
+}
+
+PyDoc_STRVAR(GMPy_doc_submit_async,
+"submit_async(func, *args, **kwargs) -> asyncio.Future\n\n"
+"Like submit(), but return an asyncio future that can be awaited in the\n"
+"running event loop.");
+
+static PyObject *
+GMPy_submit_async(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *future, *module, *result;
+
+    if (!(future = GMPy_submit(self, args, kwargs)))
+        return NULL;
+
+    if (!(module = PyImport_ImportModule("asyncio"))) {
+        Py_DECREF(future);
+        return NULL;
+    }
+    result = PyObject_CallMethod(module, "wrap_future", "(O)", future);
+    Py_DECREF(module);
+    Py_DECREF(future);
+    return result;
+}
@@ -53,10 +53,89 @@ GMPy_MPZ_Hash_Slot(MPZ_Object *self)
 #endif
 }
 
+#if defined(_PyHASH_MODULUS) && GMP_NUMB_BITS > _PyHASH_BITS
+/* _PyHASH_MODULUS is the Mersenne prime 2**_PyHASH_BITS - 1, so a double
+ * limb product of two residues reduces with shifts and adds. Each partial
+ * sum below is less than 2**(_PyHASH_BITS + 1) and fits in a limb.
+ */
+
+static mp_limb_t
+hash_mulmod(mp_limb_t a, mp_limb_t b)
+{
+    mp_limb_t lo, hi, r;
+
+    hi = mpn_mul_1(&lo, &a, 1, b);
+    r = (lo & _PyHASH_MODULUS) + (lo >> _PyHASH_BITS);
+    if (r >= _PyHASH_MODULUS) {
+        r -= _PyHASH_MODULUS;
+    }
+    r += hi << (GMP_NUMB_BITS - _PyHASH_BITS);
+    if (r >= _PyHASH_MODULUS) {
+        r -= _PyHASH_MODULUS;
+    }
+    return r;
+}
+
+/* Inverse of 0 < a < _PyHASH_MODULUS by the extended Euclidean algorithm.
+ * The cofactors are bounded by the modulus and fit in a signed 64-bit
+ * integer.
+ */
+
+static mp_limb_t
+hash_invert(mp_limb_t a)
+{
+    uint64_t r0 = _PyHASH_MODULUS, r1 = a, q, t;
+    int64_t s0 = 0, s1 = 1, st;
+
+    while (r1) {
+        q = r0 / r1;
+        t = r0 - q * r1;
+        r0 = r1;
+        r1 = t;
+        st = s0 - (int64_t)q * s1;
+        s0 = s1;
+        s1 = st;
+    }
+    if (s0 < 0) {
+        s0 += _PyHASH_MODULUS;
+    }
+    return (mp_limb_t)s0;
+}
+#endif
+
 static Py_hash_t
 GMPy_MPQ_Hash_Slot(MPQ_Object *self)
 {
-#ifdef _PyHASH_MODULUS
+#if defined(_PyHASH_MODULUS) && GMP_NUMB_BITS > _PyHASH_BITS
+    Py_hash_t hash;
+    mp_limb_t num, den;
+
+    if (self->hash_cache != -1) {
+        return self->hash_cache;
+    }
+
+    /* Same definition as Python's Fraction.__hash__, computed on the
+     * residues of the numerator and denominator without temporaries.
+     */
+    num = mpn_mod_1(mpq_numref(self->q)->_mp_d,
+                    mpz_size(mpq_numref(self->q)), _PyHASH_MODULUS);
+    den = mpn_mod_1(mpq_denref(self->q)->_mp_d,
+                    mpz_size(mpq_denref(self->q)), _PyHASH_MODULUS);
+
+    if (den == 0) {
+        hash = _PyHASH_INF;
+    }
+    else {
+        hash = (Py_hash_t)hash_mulmod(num, hash_invert(den));
+    }
+    if (mpz_sgn(mpq_numref(self->q)) < 0) {
+        hash = -hash;
+    }
+    if (hash == -1) {
+        hash = -2;
+    }
+    return (self->hash_cache = hash);
+#elif defined(_PyHASH_MODULUS)
     Py_hash_t hash = 0;
     mpz_t temp, temp1, mask;
 
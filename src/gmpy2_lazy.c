@@ -0,0 +1,832 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_lazy.c                                                            *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+/* Ziv's strategy for correct rounding: evaluate at some working precision
+ * with a rigorous error bound, and try again with more bits when the bound
+ * does not decide the rounding. The error bound here comes from ball
+ * arithmetic. Every node has a midpoint m, computed with round-to-nearest
+ * at the working precision w, and a radius r such that the exact value is
+ * in [m - r, m + r]. The radius accounts for the radii of the operands and
+ * for the rounding of m itself, which is at most one ulp of m. The radius
+ * is kept to LAZY_RPREC bits and every operation on it rounds up.
+ *
+ * The ternary value of the result is known when the rounded result lies
+ * outside the final ball, or when the radius is zero. A result inside the
+ * ball may be exact and gets a ternary value of 0.
+ */
+
+static unsigned long lazy_epoch = 0;
+
+static Lazy_Object *
+lazy_new(int op, PyObject *a, PyObject *b)
+{
+    Lazy_Object *result;
+
+    if (!(result = PyObject_GC_New(Lazy_Object, &Lazy_Type)))
+        return NULL;
+    result->op = op;
+    Py_XINCREF(a);
+    result->a = a;
+    Py_XINCREF(b);
+    result->b = b;
+    result->epoch = 0;
+    mpfr_init2(result->m, MPFR_PREC_MIN);
+    mpfr_init2(result->r, LAZY_RPREC);
+    PyObject_GC_Track(result);
+    return result;
+}
+
+/* Return a new reference to a leaf holding obj, or obj itself if it is
+ * already a lazy object. Return NULL without an exception set if obj is
+ * not a real number. */
+
+static Lazy_Object *
+lazy_from_object(PyObject *obj, CTXT_Object *context)
+{
+    PyObject *value;
+    Lazy_Object *result;
+    int op;
+
+    if (Lazy_Check(obj)) {
+        Py_INCREF(obj);
+        return (Lazy_Object*)obj;
+    }
+
+    if (IS_INTEGER(obj)) {
+        op = LAZY_LEAF_MPZ;
+        value = (PyObject*)GMPy_MPZ_From_Integer(obj, context);
+    }
+    else if (IS_RATIONAL(obj)) {
+        op = LAZY_LEAF_MPQ;
+        value = (PyObject*)GMPy_MPQ_From_Number(obj, context);
+    }
+    else if (IS_REAL(obj)) {
+        op = LAZY_LEAF_MPFR;
+        value = (PyObject*)GMPy_MPFR_From_Real(obj, 1, context);
+    }
+    else {
+        return NULL;
+    }
+
+    if (!value)
+        return NULL;
+    result = lazy_new(op, value, NULL);
+    Py_DECREF(value);
+    return result;
+}
+
+static Lazy_Object *
+lazy_from_string(PyObject *obj)
+{
+    PyObject *ascii;
+    Lazy_Object *result;
+    char *end;
+    MPFR_DECL_INIT(temp, 53);
+
+    if (PyBytes_Check(obj)) {
+        Py_INCREF(obj);
+        ascii = obj;
+    }
+    else if (!(ascii = PyUnicode_AsASCIIString(obj))) {
+        return NULL;
+    }
+
+    mpfr_strtofr(temp, PyBytes_AS_STRING(ascii), &end, 10, MPFR_RNDN);
+    if (end == PyBytes_AS_STRING(ascii) || *end) {
+        VALUE_ERROR("invalid digits");
+        Py_DECREF(ascii);
+        return NULL;
+    }
+
+    result = lazy_new(LAZY_LEAF_STR, ascii, NULL);
+    Py_DECREF(ascii);
+    return result;
+}
+
+/* Add the rounding error of a midpoint with ternary value rc. */
+
+static void
+lazy_add_ulp(Lazy_Object *x, int rc, mpfr_prec_t w)
+{
+    MPFR_DECL_INIT(ulp, LAZY_RPREC);
+
+    if (!rc)
+        return;
+    if (!mpfr_regular_p(x->m)) {
+        mpfr_set_inf(x->r, 1);
+        return;
+    }
+    mpfr_set_ui_2exp(ulp, 1, mpfr_get_exp(x->m) - w, MPFR_RNDU);
+    mpfr_add(x->r, x->r, ulp, MPFR_RNDU);
+}
+
+static int
+lazy_eval_leaf(Lazy_Object *x)
+{
+    char *end;
+
+    switch (x->op) {
+    case LAZY_LEAF_MPZ:
+        return mpfr_set_z(x->m, MPZ(x->a), MPFR_RNDN);
+    case LAZY_LEAF_MPQ:
+        return mpfr_set_q(x->m, MPQ(x->a), MPFR_RNDN);
+    case LAZY_LEAF_MPFR:
+        return mpfr_set(x->m, MPFR(x->a), MPFR_RNDN);
+    case LAZY_LEAF_STR:
+        return mpfr_strtofr(x->m, PyBytes_AS_STRING(x->a), &end, 10, MPFR_RNDN);
+    case LAZY_PI:
+        return mpfr_const_pi(x->m, MPFR_RNDN);
+    case LAZY_LOG2:
+        return mpfr_const_log2(x->m, MPFR_RNDN);
+    case LAZY_EULER:
+        return mpfr_const_euler(x->m, MPFR_RNDN);
+    default:
+        return mpfr_const_catalan(x->m, MPFR_RNDN);
+    }
+}
+
+/* Set the midpoint and radius of x from those of its operands a and, for
+ * a binary operation, b. */
+
+static void
+lazy_eval_node(Lazy_Object *x, Lazy_Object *a, Lazy_Object *b, mpfr_prec_t w)
+{
+    MPFR_DECL_INIT(t1, LAZY_RPREC);
+    MPFR_DECL_INIT(t2, LAZY_RPREC);
+    int rc = 0, exact;
+
+    mpfr_set_prec(x->m, w);
+    mpfr_set_zero(x->r, 1);
+
+    if (!a) {
+        lazy_add_ulp(x, lazy_eval_leaf(x), w);
+        return;
+    }
+
+    exact = mpfr_zero_p(a->r) && (!b || mpfr_zero_p(b->r));
+
+    switch (x->op) {
+    case LAZY_NEG:
+        rc = mpfr_neg(x->m, a->m, MPFR_RNDN);
+        break;
+    case LAZY_ABS:
+        rc = mpfr_abs(x->m, a->m, MPFR_RNDN);
+        break;
+    case LAZY_SQRT:
+    case LAZY_LOG:
+        /* t1 and t2 are lower and upper bounds of the operand. */
+        mpfr_sub(t1, a->m, a->r, MPFR_RNDD);
+        mpfr_add(t2, a->m, a->r, MPFR_RNDU);
+        if (!exact && mpfr_sgn(t2) < 0) {
+            mpfr_set_nan(x->m);
+            return;
+        }
+        if (x->op == LAZY_SQRT)
+            rc = mpfr_sqrt(x->m, a->m, MPFR_RNDN);
+        else
+            rc = mpfr_log(x->m, a->m, MPFR_RNDN);
+        break;
+    case LAZY_EXP:
+        rc = mpfr_exp(x->m, a->m, MPFR_RNDN);
+        break;
+    case LAZY_SIN:
+        rc = mpfr_sin(x->m, a->m, MPFR_RNDN);
+        break;
+    case LAZY_COS:
+        rc = mpfr_cos(x->m, a->m, MPFR_RNDN);
+        break;
+    case LAZY_ATAN:
+        rc = mpfr_atan(x->m, a->m, MPFR_RNDN);
+        break;
+    case LAZY_ADD:
+        rc = mpfr_add(x->m, a->m, b->m, MPFR_RNDN);
+        break;
+    case LAZY_SUB:
+        rc = mpfr_sub(x->m, a->m, b->m, MPFR_RNDN);
+        break;
+    case LAZY_MUL:
+        rc = mpfr_mul(x->m, a->m, b->m, MPFR_RNDN);
+        break;
+    default:
+        rc = mpfr_div(x->m, a->m, b->m, MPFR_RNDN);
+        break;
+    }
+
+    /* Infinities and NaNs are only exact if the operands are. */
+    if (!mpfr_number_p(x->m) || !mpfr_number_p(a->m) || (b && !mpfr_number_p(b->m))) {
+        if (!exact || rc)
+            mpfr_set_inf(x->r, 1);
+        return;
+    }
+
+    if (!exact) {
+        switch (x->op) {
+        case LAZY_SQRT:
+            /* |sqrt(y) - sqrt(m)| <= r / sqrt(m - r), or sqrt(r). */
+            if (mpfr_sgn(t1) < 0) {
+                mpfr_set_inf(x->r, 1);
+            }
+            else if (mpfr_sgn(t1) > 0) {
+                mpfr_sqrt(t1, t1, MPFR_RNDD);
+                mpfr_div(x->r, a->r, t1, MPFR_RNDU);
+            }
+            else {
+                mpfr_sqrt(x->r, a->r, MPFR_RNDU);
+            }
+            break;
+        case LAZY_LOG:
+            /* |log(y) - log(m)| <= r / (m - r). */
+            if (mpfr_sgn(t1) <= 0)
+                mpfr_set_inf(x->r, 1);
+            else
+                mpfr_div(x->r, a->r, t1, MPFR_RNDU);
+            break;
+        case LAZY_EXP:
+            /* |exp(y) - exp(m)| <= exp(m) * (exp(r) - 1). */
+            mpfr_abs(t1, x->m, MPFR_RNDU);
+            mpfr_set_ui_2exp(t2, 1, mpfr_get_exp(x->m) - w, MPFR_RNDU);
+            mpfr_add(t1, t1, t2, MPFR_RNDU);
+            mpfr_expm1(t2, a->r, MPFR_RNDU);
+            mpfr_mul(x->r, t1, t2, MPFR_RNDU);
+            break;
+        case LAZY_ADD:
+        case LAZY_SUB:
+            mpfr_add(x->r, a->r, b->r, MPFR_RNDU);
+            break;
+        case LAZY_MUL:
+            /* |a| rb + |b| ra + ra rb */
+            mpfr_abs(t1, a->m, MPFR_RNDU);
+            mpfr_mul(t1, t1, b->r, MPFR_RNDU);
+            mpfr_abs(t2, b->m, MPFR_RNDU);
+            mpfr_mul(t2, t2, a->r, MPFR_RNDU);
+            mpfr_add(t1, t1, t2, MPFR_RNDU);
+            mpfr_mul(t2, a->r, b->r, MPFR_RNDU);
+            mpfr_add(x->r, t1, t2, MPFR_RNDU);
+            break;
+        case LAZY_DIV:
+            /* (|a| rb + |b| ra) / (|b| (|b| - rb)) */
+            mpfr_abs(t2, b->m, MPFR_RNDD);
+            mpfr_sub(t2, t2, b->r, MPFR_RNDD);
+            if (mpfr_sgn(t2) <= 0) {
+                mpfr_set_inf(x->r, 1);
+                break;
+            }
+            mpfr_abs(t1, b->m, MPFR_RNDD);
+            mpfr_mul(t2, t2, t1, MPFR_RNDD);
+            mpfr_abs(t1, a->m, MPFR_RNDU);
+            mpfr_mul(t1, t1, b->r, MPFR_RNDU);
+            mpfr_abs(x->r, b->m, MPFR_RNDU);
+            mpfr_mul(x->r, x->r, a->r, MPFR_RNDU);
+            mpfr_add(t1, t1, x->r, MPFR_RNDU);
+            mpfr_div(x->r, t1, t2, MPFR_RNDU);
+            break;
+        default:
+            /* neg, abs, sin, cos and atan are 1-Lipschitz. */
+            mpfr_set(x->r, a->r, MPFR_RNDU);
+            break;
+        }
+    }
+    lazy_add_ulp(x, rc, w);
+}
+
+/* Evaluate every node of the DAG below root at working precision w. The
+ * DAG is walked in post-order with an explicit stack so that deep
+ * expressions do not exhaust the C stack, and a node shared by several
+ * parents is only evaluated once. */
+
+static int
+lazy_eval_dag(Lazy_Object *root, mpfr_prec_t w, unsigned long epoch)
+{
+    Lazy_Object **stack, **temp, *x, *a, *b;
+    Py_ssize_t n = 0, alloc = 64;
+
+    if (!(stack = PyMem_New(Lazy_Object*, alloc))) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    stack[n++] = root;
+
+    while (n > 0) {
+        x = stack[n - 1];
+        if (x->epoch == epoch) {
+            n--;
+            continue;
+        }
+
+        a = LAZY_IS_UNARY(x->op) || LAZY_IS_BINARY(x->op) ? (Lazy_Object*)x->a : NULL;
+        b = LAZY_IS_BINARY(x->op) ? (Lazy_Object*)x->b : NULL;
+
+        if ((a && a->epoch != epoch) || (b && b->epoch != epoch)) {
+            if (n + 2 > alloc) {
+                alloc *= 2;
+                if (!(temp = PyMem_Resize(stack, Lazy_Object*, alloc))) {
+                    PyMem_Free(stack);
+                    PyErr_NoMemory();
+                    return -1;
+                }
+                stack = temp;
+            }
+            if (a && a->epoch != epoch)
+                stack[n++] = a;
+            if (b && b->epoch != epoch)
+                stack[n++] = b;
+            continue;
+        }
+
+        lazy_eval_node(x, a, b, w);
+        x->epoch = epoch;
+        n--;
+    }
+
+    PyMem_Free(stack);
+    return 0;
+}
+
+PyDoc_STRVAR(GMPy_doc_lazy_eval,
+"x.eval(precision=0, max_prec=0) -> mpfr\n\n"
+"Return the value of the expression x correctly rounded to the given\n"
+"precision (0 uses the precision of the current context) with the\n"
+"rounding mode of the current context. The expression is evaluated in\n"
+"ball arithmetic with a working precision that is doubled until the\n"
+"rounding is decided. ValueError is raised if it is not decided at\n"
+"max_prec bits; the default is 64 times the precision, and at least\n"
+"4096 bits. The ternary value of the result is 0 if the result may be\n"
+"exact.");
+
+static PyObject *
+GMPy_Lazy_Method_Eval(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    Lazy_Object *x = (Lazy_Object*)self;
+    MPFR_Object *result = NULL;
+    CTXT_Object *context = NULL;
+    mpfr_exp_t _oldemin, _oldemax;
+    mpfr_prec_t p, w, maxp;
+    mpfr_rnd_t rnd;
+    mpfr_t lo, hi, ylo, yhi;
+    long bits = 0, maxbits = 0;
+    int rc = 0, done = 0;
+    static char *kwlist[] = {"precision", "max_prec", NULL};
+
+    CHECK_CONTEXT(context);
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "|ll:eval", kwlist, &bits, &maxbits))
+        return NULL;
+
+    p = bits ? bits : GET_MPFR_PREC(context);
+    if (p < MPFR_PREC_MIN || p > MPFR_PREC_MAX / 64) {
+        VALUE_ERROR("invalid value for precision");
+        return NULL;
+    }
+    maxp = maxbits ? maxbits : (p > 64 ? 64 * p : 4096);
+    if (maxp < p || maxp > MPFR_PREC_MAX) {
+        VALUE_ERROR("invalid value for max_prec");
+        return NULL;
+    }
+    rnd = GET_MPFR_ROUND(context);
+
+    mpfr_init2(lo, MPFR_PREC_MIN);
+    mpfr_init2(hi, MPFR_PREC_MIN);
+    mpfr_init2(ylo, p);
+    mpfr_init2(yhi, p);
+
+    GMPY_MPFR_WIDEN_RANGE(_oldemin, _oldemax);
+    w = p + 32 < maxp ? p + 32 : maxp;
+    while (1) {
+        if (lazy_eval_dag(x, w, ++lazy_epoch) < 0)
+            break;
+
+        if (mpfr_zero_p(x->r) && !mpfr_number_p(x->m)) {
+            mpfr_set(ylo, x->m, rnd);
+            done = 1;
+        }
+        else if (mpfr_number_p(x->r) && mpfr_number_p(x->m)) {
+            mpfr_set_prec(lo, w);
+            mpfr_set_prec(hi, w);
+            mpfr_sub(lo, x->m, x->r, MPFR_RNDD);
+            mpfr_add(hi, x->m, x->r, MPFR_RNDU);
+            rc = mpfr_set(ylo, lo, rnd);
+            mpfr_set(yhi, hi, rnd);
+            if (mpfr_equal_p(ylo, yhi) && mpfr_signbit(ylo) == mpfr_signbit(yhi)) {
+                if (!mpfr_zero_p(x->r))
+                    rc = mpfr_cmp(ylo, hi) > 0 ? 1 : (mpfr_cmp(ylo, lo) < 0 ? -1 : 0);
+                done = 1;
+            }
+        }
+
+        if (done || w >= maxp) {
+            if (!done)
+                VALUE_ERROR("eval() could not round the result within max_prec bits");
+            break;
+        }
+        w = w < maxp / 2 ? 2 * w : maxp;
+    }
+    GMPY_MPFR_RESTORE_RANGE(_oldemin, _oldemax);
+
+    if (done && (result = GMPy_MPFR_New(p, context))) {
+        mpfr_set(result->f, ylo, MPFR_RNDN);
+        result->rc = rc;
+        mpfr_clear_flags();
+        if (rc)
+            mpfr_set_inexflag();
+        if (mpfr_nan_p(result->f))
+            mpfr_set_nanflag();
+        GMPY_MPFR_CLEANUP(result, context, "eval()");
+    }
+
+    mpfr_clear(lo);
+    mpfr_clear(hi);
+    mpfr_clear(ylo);
+    mpfr_clear(yhi);
+    return (PyObject*)result;
+}
+
+static PyObject *
+lazy_unary(PyObject *x, int op)
+{
+    return (PyObject*)lazy_new(op, x, NULL);
+}
+
+static PyObject *
+lazy_binary(PyObject *x, PyObject *y, int op)
+{
+    Lazy_Object *tempx, *tempy, *result = NULL;
+    CTXT_Object *context = NULL;
+
+    CHECK_CONTEXT(context);
+    if (!(tempx = lazy_from_object(x, context))) {
+        if (PyErr_Occurred())
+            return NULL;
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    if (!(tempy = lazy_from_object(y, context))) {
+        Py_DECREF((PyObject*)tempx);
+        if (PyErr_Occurred())
+            return NULL;
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    result = lazy_new(op, (PyObject*)tempx, (PyObject*)tempy);
+    Py_DECREF((PyObject*)tempx);
+    Py_DECREF((PyObject*)tempy);
+    return (PyObject*)result;
+}
+
+static PyObject *
+GMPy_Lazy_Add_Slot(PyObject *x, PyObject *y)
+{
+    return lazy_binary(x, y, LAZY_ADD);
+}
+
+static PyObject *
+GMPy_Lazy_Sub_Slot(PyObject *x, PyObject *y)
+{
+    return lazy_binary(x, y, LAZY_SUB);
+}
+
+static PyObject *
+GMPy_Lazy_Mul_Slot(PyObject *x, PyObject *y)
+{
+    return lazy_binary(x, y, LAZY_MUL);
+}
+
+static PyObject *
+GMPy_Lazy_TrueDiv_Slot(PyObject *x, PyObject *y)
+{
+    return lazy_binary(x, y, LAZY_DIV);
+}
+
+static PyObject *
+GMPy_Lazy_Neg_Slot(PyObject *x)
+{
+    return lazy_unary(x, LAZY_NEG);
+}
+
+static PyObject *
+GMPy_Lazy_Pos_Slot(PyObject *x)
+{
+    Py_INCREF(x);
+    return x;
+}
+
+static PyObject *
+GMPy_Lazy_Abs_Slot(PyObject *x)
+{
+    return lazy_unary(x, LAZY_ABS);
+}
+
+#define LAZY_METHOD(NAME, OP, DOC) \
+PyDoc_STRVAR(GMPy_doc_lazy_##NAME, \
+"x." #NAME "() -> lazy\n\n" \
+"Return a lazy expression for " DOC "."); \
+\
+static PyObject * \
+GMPy_Lazy_Method_##NAME(PyObject *self, PyObject *other) \
+{ \
+    return lazy_unary(self, OP); \
+}
+
+LAZY_METHOD(sqrt, LAZY_SQRT, "the square root of x")
+LAZY_METHOD(exp, LAZY_EXP, "the exponential of x")
+LAZY_METHOD(log, LAZY_LOG, "the natural logarithm of x")
+LAZY_METHOD(sin, LAZY_SIN, "the sine of x")
+LAZY_METHOD(cos, LAZY_COS, "the cosine of x")
+LAZY_METHOD(atan, LAZY_ATAN, "the arc-tangent of x")
+
+PyDoc_STRVAR(GMPy_doc_lazy_factory,
+"lazy(x) -> lazy\n\n"
+"Return a lazy expression for the real number x, which may also be a\n"
+"string of decimal digits that is read again at each working precision.\n"
+"Arithmetic with +, -, *, / and the methods sqrt(), exp(), log(), sin(),\n"
+"cos() and atan() build an expression without computing anything;\n"
+"x.eval() returns its correctly rounded value. x may also be one of the\n"
+"functions const_pi, const_log2, const_euler and const_catalan for that\n"
+"constant.");
+
+static PyObject *
+GMPy_Lazy_Factory(PyObject *self, PyObject *other)
+{
+    Lazy_Object *result;
+    CTXT_Object *context = NULL;
+
+    CHECK_CONTEXT(context);
+    if (PyStrOrUnicode_Check(other))
+        return (PyObject*)lazy_from_string(other);
+    if (PyCFunction_Check(other)) {
+        PyCFunction func = PyCFunction_GET_FUNCTION(other);
+
+        if (func == (PyCFunction)GMPy_Function_Const_Pi)
+            return (PyObject*)lazy_new(LAZY_PI, NULL, NULL);
+        if (func == (PyCFunction)GMPy_Function_Const_Log2)
+            return (PyObject*)lazy_new(LAZY_LOG2, NULL, NULL);
+        if (func == (PyCFunction)GMPy_Function_Const_Euler)
+            return (PyObject*)lazy_new(LAZY_EULER, NULL, NULL);
+        if (func == (PyCFunction)GMPy_Function_Const_Catalan)
+            return (PyObject*)lazy_new(LAZY_CATALAN, NULL, NULL);
+    }
+    if (!(result = lazy_from_object(other, context)) && !PyErr_Occurred())
+        TYPE_ERROR("lazy() requires a real number or a string");
+    return (PyObject*)result;
+}
+
+static void
+GMPy_Lazy_Dealloc(Lazy_Object *self)
+{
+    PyObject_GC_UnTrack(self);
+#if PY_VERSION_HEX >= 0x03080000
+    Py_TRASHCAN_BEGIN(self, GMPy_Lazy_Dealloc)
+#else
+    Py_TRASHCAN_SAFE_BEGIN(self)
+#endif
+    Py_XDECREF(self->a);
+    Py_XDECREF(self->b);
+    mpfr_clear(self->m);
+    mpfr_clear(self->r);
+    PyObject_GC_Del(self);
+#if PY_VERSION_HEX >= 0x03080000
+    Py_TRASHCAN_END
+#else
+    Py_TRASHCAN_SAFE_END(self)
+#endif
+}
+
+static int
+GMPy_Lazy_Traverse(Lazy_Object *self, visitproc visit, void *arg)
+{
+    Py_VISIT(self->a);
+    Py_VISIT(self->b);
+    return 0;
+}
+
+/* Return the text of an expression. A binary operation is put in
+ * parentheses when it is the operand of another binary operation or of a
+ * negation. */
+
+static PyObject *
+lazy_repr(Lazy_Object *x, int nested)
+{
+    static const char *names[] = {
+        NULL, NULL, NULL, NULL,
+        "const_pi", "const_log2", "const_euler", "const_catalan",
+        "-", "abs", "sqrt", "exp", "log", "sin", "cos", "atan",
+        "+", "-", "*", "/"
+    };
+    PyObject *a = NULL, *b = NULL, *format = NULL, *args = NULL, *result = NULL;
+
+    if (x->op == LAZY_LEAF_STR)
+        return Py2or3String_FromFormat("'%s'", PyBytes_AS_STRING(x->a));
+    if (LAZY_IS_LEAF(x->op))
+        return PyObject_Repr(x->a);
+    if (!LAZY_IS_UNARY(x->op) && !LAZY_IS_BINARY(x->op))
+        return Py2or3String_FromString(names[x->op]);
+
+    if (Py_EnterRecursiveCall(" in lazy.__repr__"))
+        return NULL;
+
+    if (!(a = lazy_repr((Lazy_Object*)x->a, x->op == LAZY_NEG || LAZY_IS_BINARY(x->op))))
+        goto done;
+
+    if (LAZY_IS_UNARY(x->op)) {
+        if (x->op == LAZY_NEG)
+            format = Py2or3String_FromString("-%s");
+        else
+            format = Py2or3String_FromFormat("%s(%%s)", names[x->op]);
+        args = Py_BuildValue("(O)", a);
+    }
+    else {
+        if (!(b = lazy_repr((Lazy_Object*)x->b, 1)))
+            goto done;
+        format = Py2or3String_FromFormat(nested ? "(%%s %s %%s)" : "%%s %s %%s", names[x->op]);
+        args = Py_BuildValue("(OO)", a, b);
+    }
+    if (format && args)
+        result = Py2or3String_Format(format, args);
+
+  done:
+    Py_LeaveRecursiveCall();
+    Py_XDECREF(a);
+    Py_XDECREF(b);
+    Py_XDECREF(format);
+    Py_XDECREF(args);
+    return result;
+}
+
+static PyObject *
+GMPy_Lazy_Repr_Slot(Lazy_Object *self)
+{
+    PyObject *expr, *format, *args, *result = NULL;
+
+    if (!(expr = lazy_repr(self, 0)))
+        return NULL;
+    args = Py_BuildValue("(N)", expr);
+    format = Py2or3String_FromString("lazy(%s)");
+    if (args && format)
+        result = Py2or3String_Format(format, args);
+    Py_XDECREF(args);
+    Py_XDECREF(format);
+    return result;
+}
+
+#ifdef PY3
+static PyNumberMethods GMPy_Lazy_number_methods =
+{
+    (binaryfunc) GMPy_Lazy_Add_Slot,           /* nb_add                  */
+    (binaryfunc) GMPy_Lazy_Sub_Slot,           /* nb_subtract             */
+    (binaryfunc) GMPy_Lazy_Mul_Slot,           /* nb_multiply             */
+        0,                                     /* nb_remainder            */
+        0,                                     /* nb_divmod               */
+        0,                                     /* nb_power                */
+    (unaryfunc) GMPy_Lazy_Neg_Slot,            /* nb_negative             */
+    (unaryfunc) GMPy_Lazy_Pos_Slot,            /* nb_positive             */
+    (unaryfunc) GMPy_Lazy_Abs_Slot,            /* nb_absolute             */
+        0,                                     /* nb_bool                 */
+        0,                                     /* nb_invert               */
+        0,                                     /* nb_lshift               */
+        0,                                     /* nb_rshift               */
+        0,                                     /* nb_and                  */
+        0,                                     /* nb_xor                  */
+        0,                                     /* nb_or                   */
+        0,                                     /* nb_int                  */
+        0,                                     /* nb_reserved             */
+        0,                                     /* nb_float                */
+        0,                                     /* nb_inplace_add          */
+        0,                                     /* nb_inplace_subtract     */
+        0,                                     /* nb_inplace_multiply     */
+        0,                                     /* nb_inplace_remainder    */
+        0,                                     /* nb_inplace_power        */
+        0,                                     /* nb_inplace_lshift       */
+        0,                                     /* nb_inplace_rshift       */
+        0,                                     /* nb_inplace_and          */
+        0,                                     /* nb_inplace_xor          */
+        0,                                     /* nb_inplace_or           */
+        0,                                     /* nb_floor_divide         */
+    (binaryfunc) GMPy_Lazy_TrueDiv_Slot,       /* nb_true_divide          */
+        0,                                     /* nb_inplace_floor_divide */
+        0,                                     /* nb_inplace_true_divide  */
+        0,                                     /* nb_index                */
+};
+#else
+static PyNumberMethods GMPy_Lazy_number_methods =
+{
+    (binaryfunc) GMPy_Lazy_Add_Slot,           /* nb_add                  */
+    (binaryfunc) GMPy_Lazy_Sub_Slot,           /* nb_subtract             */
+    (binaryfunc) GMPy_Lazy_Mul_Slot,           /* nb_multiply             */
+    (binaryfunc) GMPy_Lazy_TrueDiv_Slot,       /* nb_divide               */
+        0,                                     /* nb_remainder            */
+        0,                                     /* nb_divmod               */
+        0,                                     /* nb_power                */
+    (unaryfunc) GMPy_Lazy_Neg_Slot,            /* nb_negative             */
+    (unaryfunc) GMPy_Lazy_Pos_Slot,            /* nb_positive             */
+    (unaryfunc) GMPy_Lazy_Abs_Slot,            /* nb_absolute             */
+        0,                                     /* nb_bool                 */
+        0,                                     /* nb_invert               */
+        0,                                     /* nb_lshift               */
+        0,                                     /* nb_rshift               */
+        0,                                     /* nb_and                  */
+        0,                                     /* nb_xor                  */
+        0,                                     /* nb_or                   */
+        0,                                     /* nb_coerce               */
+        0,                                     /* nb_int                  */
+        0,                                     /* nb_long                 */
+        0,                                     /* nb_float                */
+        0,                                     /* nb_oct                  */
+        0,                                     /* nb_hex                  */
+        0,                                     /* nb_inplace_add          */
+        0,                                     /* nb_inplace_subtract     */
+        0,                                     /* nb_inplace_multiply     */
+        0,                                     /* nb_inplace_divide       */
+        0,                                     /* nb_inplace_remainder    */
+        0,                                     /* nb_inplace_power        */
+        0,                                     /* nb_inplace_lshift       */
+        0,                                     /* nb_inplace_rshift       */
+        0,                                     /* nb_inplace_and          */
+        0,                                     /* nb_inplace_xor          */
+        0,                                     /* nb_inplace_or           */
+        0,                                     /* nb_floor_divide         */
+    (binaryfunc) GMPy_Lazy_TrueDiv_Slot,       /* nb_true_divide          */
+        0,                                     /* nb_inplace_floor_divide */
+        0,                                     /* nb_inplace_true_divide  */
+        0,                                     /* nb_index                */
+};
+#endif
+
+#define LAZY_METHOD_ENTRY(NAME) \
+    { #NAME, GMPy_Lazy_Method_##NAME, METH_NOARGS, GMPy_doc_lazy_##NAME }
+
+static PyMethodDef GMPy_Lazy_methods[] =
+{
+    LAZY_METHOD_ENTRY(atan),
+    LAZY_METHOD_ENTRY(cos),
+    { "eval", (PyCFunction)GMPy_Lazy_Method_Eval, METH_VARARGS | METH_KEYWORDS, GMPy_doc_lazy_eval },
+    LAZY_METHOD_ENTRY(exp),
+    LAZY_METHOD_ENTRY(log),
+    LAZY_METHOD_ENTRY(sin),
+    LAZY_METHOD_ENTRY(sqrt),
+    { NULL, NULL, 1 }
+};
+
+static PyTypeObject Lazy_Type =
+{
+#ifdef PY3
+    PyVarObject_HEAD_INIT(0, 0)
+#else
+    PyObject_HEAD_INIT(0)
+        0,                                   /* ob_size          */
+#endif
+    "lazy",                                  /* tp_name          */
+    sizeof(Lazy_Object),                     /* tp_basicsize     */
+        0,                                   /* tp_itemsize      */
+    (destructor) GMPy_Lazy_Dealloc,          /* tp_dealloc       */
+        0,                                   /* tp_print         */
+        0,                                   /* tp_getattr       */
+        0,                                   /* tp_setattr       */
+        0,                                   /* tp_reserved      */
+    (reprfunc) GMPy_Lazy_Repr_Slot,          /* tp_repr          */
+    &GMPy_Lazy_number_methods,               /* tp_as_number     */
+        0,                                   /* tp_as_sequence   */
+        0,                                   /* tp_as_mapping    */
+        0,                                   /* tp_hash          */
+        0,                                   /* tp_call          */
+        0,                                   /* tp_str           */
+        0,                                   /* tp_getattro      */
+        0,                                   /* tp_setattro      */
+        0,                                   /* tp_as_buffer     */
+#ifdef PY3
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC, /* tp_flags         */
+#else
+    Py_TPFLAGS_HAVE_RICHCOMPARE | Py_TPFLAGS_CHECKTYPES |
+        Py_TPFLAGS_HAVE_GC,                  /* tp_flags         */
+#endif
+    "GMPY2 lazy real expression",            /* tp_doc           */
+    (traverseproc) GMPy_Lazy_Traverse,       /* tp_traverse      */
+        0,                                   /* tp_clear         */
+        0,                                   /* tp_richcompare   */
+        0,                                   /* tp_weaklistoffset*/
+        0,                                   /* tp_iter          */
+        0,                                   /* tp_iternext      */
+    GMPy_Lazy_methods,                       /* tp_methods       */
+        0,                                   /* tp_members       */
+        0,                                   /* tp_getset        */
+};
@@ -0,0 +1,91 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_lazy.h                                                            *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+#ifndef GMPY_LAZY_H
+#define GMPY_LAZY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* A lazy object is a node of an expression DAG over real numbers. Nothing
+ * is computed when the expression is built. eval() evaluates the DAG in
+ * midpoint-radius (ball) arithmetic at increasing working precision until
+ * both ends of the ball round to the same number at the target precision.
+ *
+ * The nodes are immutable, so a node may be shared by several expressions.
+ * The midpoint m and radius r of the last evaluation are kept in the node;
+ * epoch identifies the evaluation they belong to.
+ */
+
+enum {
+    LAZY_LEAF_MPZ, LAZY_LEAF_MPQ, LAZY_LEAF_MPFR, LAZY_LEAF_STR,
+    LAZY_PI, LAZY_LOG2, LAZY_EULER, LAZY_CATALAN,
+    LAZY_NEG, LAZY_ABS, LAZY_SQRT, LAZY_EXP, LAZY_LOG,
+    LAZY_SIN, LAZY_COS, LAZY_ATAN,
+    LAZY_ADD, LAZY_SUB, LAZY_MUL, LAZY_DIV
+};
+
+#define LAZY_IS_LEAF(op) ((op) <= LAZY_LEAF_STR)
+#define LAZY_IS_UNARY(op) ((op) >= LAZY_NEG && (op) < LAZY_ADD)
+#define LAZY_IS_BINARY(op) ((op) >= LAZY_ADD)
+
+/* Precision of the radius, which is always rounded up. */
+#define LAZY_RPREC 32
+
+typedef struct gmpy_lazy_object {
+    PyObject_HEAD
+    int op;
+    PyObject *a;                    /* the value of a leaf, or operand */
+    PyObject *b;                    /* second operand, or NULL */
+    unsigned long epoch;            /* evaluation m and r belong to */
+    mpfr_t m;                       /* midpoint at the working precision */
+    mpfr_t r;                       /* radius */
+} Lazy_Object;
+
+static PyTypeObject Lazy_Type;
+
+#define Lazy_Check(v) (((PyObject*)v)->ob_type == &Lazy_Type)
+
+static PyObject * GMPy_Lazy_Factory(PyObject *self, PyObject *other);
+static void       GMPy_Lazy_Dealloc(Lazy_Object *self);
+static int        GMPy_Lazy_Traverse(Lazy_Object *self, visitproc visit, void *arg);
+static PyObject * GMPy_Lazy_Repr_Slot(Lazy_Object *self);
+static PyObject * GMPy_Lazy_Add_Slot(PyObject *x, PyObject *y);
+static PyObject * GMPy_Lazy_Sub_Slot(PyObject *x, PyObject *y);
+static PyObject * GMPy_Lazy_Mul_Slot(PyObject *x, PyObject *y);
+static PyObject * GMPy_Lazy_TrueDiv_Slot(PyObject *x, PyObject *y);
+static PyObject * GMPy_Lazy_Neg_Slot(PyObject *x);
+static PyObject * GMPy_Lazy_Pos_Slot(PyObject *x);
+static PyObject * GMPy_Lazy_Abs_Slot(PyObject *x);
+static PyObject * GMPy_Lazy_Method_Eval(PyObject *self, PyObject *args, PyObject *keywds);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
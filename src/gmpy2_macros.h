@@ -304,10 +304,10 @@ GMPy_Number_##NAME(PyObject *x, PyObject *y, PyObject *z, CTXT_Object *context)
     return NULL; \
 } \
 static PyObject * \
-GMPy_Context_##NAME(PyObject *self, PyObject *args) \
+GMPy_Context_##NAME(PyObject *self, PyObject *const *args, Py_ssize_t nargs) \
 { \
     CTXT_Object *context = NULL; \
-    if (PyTuple_GET_SIZE(args) != 3) { \
+    if (nargs != 3) { \
         TYPE_ERROR(#FUNC"() requires 3 arguments"); \
         return NULL; \
     } \
@@ -317,9 +317,9 @@ GMPy_Context_##NAME(PyObject *self, PyObject *args) \
     else { \
         CHECK_CONTEXT(context); \
     } \
-    return GMPy_Number_##NAME(PyTuple_GET_ITEM(args, 0), PyTuple_GET_ITEM(args, 1), \
-                              PyTuple_GET_ITEM(args, 2), context); \
-}
+    return GMPy_Number_##NAME(args[0], args[1], args[2], context); \
+} \
+GMPY_FASTCALL_WRAPPER(GMPy_Context_##NAME)
 
 #define GMPY_MPFR_UNIOP(NAME, FUNC) \
 static PyObject * \
@@ -458,7 +458,9 @@ _GMPy_MPFR_##NAME(PyObject *x, CTXT_Object *context) \
         return NULL; \
     } \
     mpfr_clear_flags(); \
+    GMPY_BEGIN_NOGIL_MPFR(mpfr_get_prec(result->f)); \
     result->rc = mpfr_##FUNC(result->f, MPFR(x), GET_MPFR_ROUND(context)); \
+    GMPY_END_NOGIL; \
     GMPY_MPFR_CLEANUP(result, context, #FUNC "()"); \
     return (PyObject*)result; \
 } \
@@ -574,10 +576,10 @@ GMPy_Number_##NAME(PyObject *x, PyObject *y, CTXT_Object *context) \
     return NULL; \
 } \
 static PyObject * \
-GMPy_Context_##NAME(PyObject *self, PyObject *args) \
+GMPy_Context_##NAME(PyObject *self, PyObject *const *args, Py_ssize_t nargs) \
 { \
     CTXT_Object *context = NULL; \
-    if (PyTuple_GET_SIZE(args) != 2) { \
+    if (nargs != 2) { \
         TYPE_ERROR(#FUNC"() requires 2 arguments"); \
         return NULL; \
     } \
@@ -587,8 +589,9 @@ GMPy_Context_##NAME(PyObject *self, PyObject *args) \
     else { \
         CHECK_CONTEXT(context); \
     } \
-    return GMPy_Number_##NAME(PyTuple_GET_ITEM(args, 0), PyTuple_GET_ITEM(args, 1), context); \
+    return GMPy_Number_##NAME(args[0], args[1], context); \
 } \
+GMPY_FASTCALL_WRAPPER(GMPy_Context_##NAME) \
 
 /* Macro to support functions that require ('mpfr', 'int').
  * More precisely, the first argument must pass IS_REAL() and the second
@@ -624,10 +627,10 @@ GMPy_Number_##NAME(PyObject *x, PyObject *y, CTXT_Object *context) \
     return NULL; \
 } \
 static PyObject * \
-GMPy_Context_##NAME(PyObject *self, PyObject *args) \
+GMPy_Context_##NAME(PyObject *self, PyObject *const *args, Py_ssize_t nargs) \
 { \
     CTXT_Object *context = NULL; \
-    if (PyTuple_GET_SIZE(args) != 2) { \
+    if (nargs != 2) { \
         TYPE_ERROR(#FUNC"() requires 2 arguments"); \
         return NULL; \
     } \
@@ -637,8 +640,9 @@ GMPy_Context_##NAME(PyObject *self, PyObject *args) \
     else { \
         CHECK_CONTEXT(context); \
     } \
-    return GMPy_Number_##NAME(PyTuple_GET_ITEM(args, 0), PyTuple_GET_ITEM(args, 1), context); \
+    return GMPy_Number_##NAME(args[0], args[1], context); \
 } \
+GMPY_FASTCALL_WRAPPER(GMPy_Context_##NAME) \
 
 /* Macro to support functions that require ('mpfr', 'int').
  * More precisely, the first argument must pass IS_REAL() and the second
@@ -675,10 +679,10 @@ GMPy_Number_##NAME(PyObject *x, PyObject *y, CTXT_Object *context) \
     return NULL; \
 } \
 static PyObject * \
-GMPy_Context_##NAME(PyObject *self, PyObject *args) \
+GMPy_Context_##NAME(PyObject *self, PyObject *const *args, Py_ssize_t nargs) \
 { \
     CTXT_Object *context = NULL; \
-    if (PyTuple_GET_SIZE(args) != 2) { \
+    if (nargs != 2) { \
         TYPE_ERROR(#FUNC"() requires 2 arguments"); \
         return NULL; \
     } \
@@ -688,8 +692,9 @@ GMPy_Context_##NAME(PyObject *self, PyObject *args) \
     else { \
         CHECK_CONTEXT(context); \
     } \
-    return GMPy_Number_##NAME(PyTuple_GET_ITEM(args, 0), PyTuple_GET_ITEM(args, 1), context); \
+    return GMPy_Number_##NAME(args[0], args[1], context); \
 } \
+GMPY_FASTCALL_WRAPPER(GMPy_Context_##NAME) \
 
 #define GMPY_MPFR_BINOP_TEMPLATE(NAME, FUNC) \
 static PyObject * \
@@ -701,10 +706,10 @@ GMPy_Number_##NAME(PyObject *x, PyObject *y, CTXT_Object *context) \
     return NULL; \
 } \
 static PyObject * \
-GMPy_Context_##NAME(PyObject *self, PyObject *args) \
+GMPy_Context_##NAME(PyObject *self, PyObject *const *args, Py_ssize_t nargs) \
 { \
     CTXT_Object *context = NULL; \
-    if (PyTuple_GET_SIZE(args) != 2) { \
+    if (nargs != 2) { \
         TYPE_ERROR(#FUNC"() requires 2 arguments"); \
         return NULL; \
     } \
@@ -714,8 +719,9 @@ GMPy_Context_##NAME(PyObject *self, PyObject *args) \
     else { \
         CHECK_CONTEXT(context); \
     } \
-    return GMPy_Number_##NAME(PyTuple_GET_ITEM(args, 0), PyTuple_GET_ITEM(args, 1), context); \
+    return GMPy_Number_##NAME(args[0], args[1], context); \
 } \
+GMPY_FASTCALL_WRAPPER(GMPy_Context_##NAME) \
 
 #define GMPY_MPFR_BINOP_EX(NAME, FUNC) \
 static PyObject * \
@@ -759,10 +765,10 @@ GMPy_Number_##NAME(PyObject *x, PyObject *y, CTXT_Object *context) \
     return NULL; \
 } \
 static PyObject * \
-GMPy_Context_##NAME(PyObject *self, PyObject *args) \
+GMPy_Context_##NAME(PyObject *self, PyObject *const *args, Py_ssize_t nargs) \
 { \
     CTXT_Object *context = NULL; \
-    if (PyTuple_GET_SIZE(args) != 2) { \
+    if (nargs != 2) { \
         TYPE_ERROR(#FUNC"() requires 2 arguments"); \
         return NULL; \
     } \
@@ -772,8 +778,9 @@ GMPy_Context_##NAME(PyObject *self, PyObject *args) \
     else { \
         CHECK_CONTEXT(context); \
     } \
-    return GMPy_Number_##NAME(PyTuple_GET_ITEM(args, 0), PyTuple_GET_ITEM(args, 1), context); \
+    return GMPy_Number_##NAME(args[0], args[1], context); \
 } \
+GMPY_FASTCALL_WRAPPER(GMPy_Context_##NAME) \
 
 /* GMPY_MPFR_CONST(NAME, FUNCT) is the template for creating constants. For
  * compatibility with gmpy 2.0.x, the functions that create constants accept an
@@ -795,7 +802,7 @@ GMPy_Function_##NAME(PyObject *self, PyObject *args, PyObject *keywds) \
     if (!PyArg_ParseTupleAndKeywords(args, keywds, "|l", kwlist, &bits)) return NULL; \
     if ((result = GMPy_MPFR_New(bits, context))) { \
         mpfr_clear_flags(); \
-        result->rc = mpfr_##FUNC(result->f, GET_MPFR_ROUND(context)); \
+        result->rc = pcache_const(result, #FUNC, mpfr_##FUNC, context); \
         GMPY_MPFR_CLEANUP(result, context, #FUNC"()") \
     } \
     return (PyObject*)result; \
@@ -814,7 +821,7 @@ GMPy_Real_##NAME(CTXT_Object *context) \
         return NULL; \
     } \
     mpfr_clear_flags(); \
-    result->rc = mpfr_##FUNC(result->f, GET_MPFR_ROUND(context)); \
+    result->rc = pcache_const(result, #FUNC, mpfr_##FUNC, context); \
     GMPY_MPFR_CLEANUP(result, context, #FUNC"()"); \
     return (PyObject*)result; \
 } \
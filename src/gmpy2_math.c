@@ -931,6 +931,172 @@ PyDoc_STRVAR(GMPy_doc_function_sinh_cosh,
 
 GMPY_MPFR_UNIOP_TEMPLATE_EX(Sinh_Cosh, sinh_cosh)
 
+/* Batch versions of sin_cos() and sinh_cosh(). Each value is converted and
+ * evaluated with a single call to mpfr_sin_cos(), mpfr_sinh_cosh() or
+ * mpc_sin_cos(), and the results are stored directly into two lists, so no
+ * temporary tuple or method lookup is needed per value.
+ */
+
+static PyObject *
+trig_pair_many(PyObject *other, int hyper, CTXT_Object *context)
+{
+    PyObject *seq, *first = NULL, *second = NULL, *result = NULL;
+    PyObject **items;
+    Py_ssize_t i, n;
+
+    if (!(seq = PySequence_Fast(other, "argument must be an iterable")))
+        return NULL;
+    n = PySequence_Fast_GET_SIZE(seq);
+    items = PySequence_Fast_ITEMS(seq);
+
+    if (!(first = PyList_New(n)) || !(second = PyList_New(n)))
+        goto error;
+
+    for (i = 0; i < n; i++) {
+        PyObject *x = items[i];
+
+        if (IS_REAL(x)) {
+            MPFR_Object *tempx, *s, *c;
+            int code;
+
+            if (!(tempx = GMPy_MPFR_From_Real(x, 1, context)))
+                goto error;
+            s = GMPy_MPFR_New(0, context);
+            c = GMPy_MPFR_New(0, context);
+            if (!s || !c) {
+                Py_XDECREF((PyObject*)s);
+                Py_XDECREF((PyObject*)c);
+                Py_DECREF((PyObject*)tempx);
+                goto error;
+            }
+
+            mpfr_clear_flags();
+            if (hyper)
+                code = mpfr_sinh_cosh(s->f, c->f, tempx->f, GET_MPFR_ROUND(context));
+            else
+                code = mpfr_sin_cos(s->f, c->f, tempx->f, GET_MPFR_ROUND(context));
+            Py_DECREF((PyObject*)tempx);
+
+            s->rc = code & 0x03;
+            c->rc = code >> 2;
+            if (s->rc == 2) s->rc = -1;
+            if (c->rc == 2) c->rc = -1;
+
+            if (hyper) {
+                GMPY_MPFR_CLEANUP(s, context, "sinh_cosh_many()");
+                GMPY_MPFR_CLEANUP(c, context, "sinh_cosh_many()");
+            }
+            else {
+                GMPY_MPFR_CLEANUP(s, context, "sin_cos_many()");
+                GMPY_MPFR_CLEANUP(c, context, "sin_cos_many()");
+            }
+            if (!s || !c) {
+                Py_XDECREF((PyObject*)s);
+                Py_XDECREF((PyObject*)c);
+                goto error;
+            }
+            PyList_SET_ITEM(first, i, (PyObject*)s);
+            PyList_SET_ITEM(second, i, (PyObject*)c);
+        }
+        else if (!hyper && IS_COMPLEX(x)) {
+            MPC_Object *tempx, *s, *c;
+            int code;
+
+            if (!(tempx = GMPy_MPC_From_Complex(x, 1, 1, context)))
+                goto error;
+            s = GMPy_MPC_New(0, 0, context);
+            c = GMPy_MPC_New(0, 0, context);
+            if (!s || !c) {
+                Py_XDECREF((PyObject*)s);
+                Py_XDECREF((PyObject*)c);
+                Py_DECREF((PyObject*)tempx);
+                goto error;
+            }
+
+            code = mpc_sin_cos(s->c, c->c, tempx->c, GET_MPC_ROUND(context), GET_MPC_ROUND(context));
+            Py_DECREF((PyObject*)tempx);
+
+            s->rc = MPC_INEX1(code);
+            c->rc = MPC_INEX2(code);
+
+            GMPY_MPC_CLEANUP(s, context, "sin_cos_many()");
+            GMPY_MPC_CLEANUP(c, context, "sin_cos_many()");
+            if (!s || !c) {
+                Py_XDECREF((PyObject*)s);
+                Py_XDECREF((PyObject*)c);
+                goto error;
+            }
+            PyList_SET_ITEM(first, i, (PyObject*)s);
+            PyList_SET_ITEM(second, i, (PyObject*)c);
+        }
+        else {
+            if (hyper)
+                TYPE_ERROR("sinh_cosh_many() argument type not supported");
+            else
+                TYPE_ERROR("sin_cos_many() argument type not supported");
+            goto error;
+        }
+    }
+
+    result = PyTuple_Pack(2, first, second);
+
+  error:
+    Py_XDECREF(first);
+    Py_XDECREF(second);
+    Py_DECREF(seq);
+    return result;
+}
+
+PyDoc_STRVAR(GMPy_doc_context_sin_cos_many,
+"context.sin_cos_many(iterable) -> (list, list)\n\n"
+"Return a tuple of two lists containing the sines and the cosines of the\n"
+"values in iterable; values in radians.");
+
+PyDoc_STRVAR(GMPy_doc_function_sin_cos_many,
+"sin_cos_many(iterable) -> (list, list)\n\n"
+"Return a tuple of two lists containing the sines and the cosines of the\n"
+"values in iterable; values in radians.");
+
+static PyObject *
+GMPy_Context_Sin_Cos_Many(PyObject *self, PyObject *other)
+{
+    CTXT_Object *context = NULL;
+
+    if (self && CTXT_Check(self)) {
+        context = (CTXT_Object*)self;
+    }
+    else {
+        CHECK_CONTEXT(context);
+    }
+
+    return trig_pair_many(other, 0, context);
+}
+
+PyDoc_STRVAR(GMPy_doc_context_sinh_cosh_many,
+"context.sinh_cosh_many(iterable) -> (list, list)\n\n"
+"Return a tuple of two lists containing the hyperbolic sines and cosines\n"
+"of the values in iterable.");
+
+PyDoc_STRVAR(GMPy_doc_function_sinh_cosh_many,
+"sinh_cosh_many(iterable) -> (list, list)\n\n"
+"Return a tuple of two lists containing the hyperbolic sines and cosines\n"
+"of the values in iterable.");
+
+static PyObject *
+GMPy_Context_Sinh_Cosh_Many(PyObject *self, PyObject *other)
+{
+    CTXT_Object *context = NULL;
+
+    if (self && CTXT_Check(self)) {
+        context = (CTXT_Object*)self;
+    }
+    else {
+        CHECK_CONTEXT(context);
+    }
+
+    return trig_pair_many(other, 1, context);
+}
+
 PyDoc_STRVAR(GMPy_doc_function_degrees,
 "degrees(x) -> mpfr\n\n"
 "Convert angle x from radians to degrees.\n"
@@ -1072,8 +1238,10 @@ _GMPy_MPFR_Sqrt(PyObject *x, CTXT_Object *context)
         return NULL;
     }
 
-    mpfr_clear_flags();
-    result->rc = mpfr_sqrt(result->f, MPFR(x), GET_MPFR_ROUND(context));
+    if (!GMPy_MPFR_D53_Sqrt(result, (MPFR_Object*)x, context)) {
+        mpfr_clear_flags();
+        result->rc = mpfr_sqrt(result->f, MPFR(x), GET_MPFR_ROUND(context));
+    }
     GMPY_MPFR_CLEANUP(result, context, "sqrt()");
     return (PyObject*)result;
 }
@@ -1271,11 +1439,11 @@ GMPy_Number_Round2(PyObject *x, PyObject *y, CTXT_Object *context)
 }
 
 static PyObject *
-GMPy_Context_Round2(PyObject *self, PyObject *args)
+GMPy_Context_Round2(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     CTXT_Object *context = NULL;
     
-    if (PyTuple_GET_SIZE(args) < 1 || PyTuple_GET_SIZE(args) > 2) {
+    if (nargs < 1 || nargs > 2) {
         TYPE_ERROR("round2() requires 1 or 2 arguments");
         return NULL;
     }
@@ -1287,13 +1455,14 @@ GMPy_Context_Round2(PyObject *self, PyObject *args)
         CHECK_CONTEXT(context);
     }
 
-    if (PyTuple_GET_SIZE(args) == 1) {
-        return GMPy_Number_Round2(PyTuple_GET_ITEM(args, 0), NULL, context);
+    if (nargs == 1) {
+        return GMPy_Number_Round2(args[0], NULL, context);
     }
     else {
-        return GMPy_Number_Round2(PyTuple_GET_ITEM(args, 0), PyTuple_GET_ITEM(args, 1), context);
+        return GMPy_Number_Round2(args[0], args[1], context);
     }
 }
+GMPY_FASTCALL_WRAPPER(GMPy_Context_Round2)
 
 PyDoc_STRVAR(GMPy_doc_function_reldiff,
 "reldiff(x, y) -> mpfr\n\n"
@@ -1588,7 +1757,7 @@ PyDoc_STRVAR(GMPy_doc_context_next_toward,
 "the same precision as x.");
 
 static PyObject *
-GMPy_Context_NextToward(PyObject *self, PyObject *args)
+GMPy_Context_NextToward(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     MPFR_Object *result, *tempx, *tempy;
     CTXT_Object *context = NULL;
@@ -1600,13 +1769,13 @@ GMPy_Context_NextToward(PyObject *self, PyObject *args)
         CHECK_CONTEXT(context);
     }
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (nargs != 2) {
         TYPE_ERROR("next_toward() requires 2 arguments");
         return NULL;
     }
 
-    tempx = GMPy_MPFR_From_Real(PyTuple_GET_ITEM(args, 0), 1, context);
-    tempy = GMPy_MPFR_From_Real(PyTuple_GET_ITEM(args, 1), 1, context);
+    tempx = GMPy_MPFR_From_Real(args[0], 1, context);
+    tempy = GMPy_MPFR_From_Real(args[1], 1, context);
     if (!tempx || !tempy) {
         TYPE_ERROR("next_toward() argument type not supported");
         Py_XDECREF((PyObject*)tempx);
@@ -1629,6 +1798,7 @@ GMPy_Context_NextToward(PyObject *self, PyObject *args)
     GMPY_MPFR_CLEANUP(result, context, "next_toward()");
     return (PyObject*)result;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_Context_NextToward)
 
 PyDoc_STRVAR(GMPy_doc_function_next_above,
 "next_above(x) -> mpfr\n\n"
@@ -1757,20 +1927,240 @@ GMPy_Context_Factorial(PyObject *self, PyObject *other)
 }
 
 PyDoc_STRVAR(GMPy_doc_function_fsum,
-"fsum(iterable) -> mpfr\n\n"
-"Return an accurate sum of the values in the iterable.");
+"fsum(iterable, threads=None) -> mpfr\n\n"
+"Return an accurate sum of the values in the iterable. If threads is\n"
+"given, chunks of the values are summed exactly by up to that many\n"
+"threads; the result is the same for any number of threads.");
 
 PyDoc_STRVAR(GMPy_doc_context_fsum,
-"fsum(iterable) -> mpfr\n\n"
-"Return an accurate sum of the values in the iterable.");
+"context.fsum(iterable, threads=None) -> mpfr\n\n"
+"Return an accurate sum of the values in the iterable. If threads is\n"
+"given, chunks of the values are summed exactly by up to that many\n"
+"threads; the result is the same for any number of threads.");
+
+/* fsum(), dot() and norm2() consume their arguments in chunks of FSUM_CHUNK
+ * items. Each chunk is added to a running sum that is kept exact: products
+ * are computed with the sum of the precisions of their operands, the
+ * precision of each partial sum is chosen so that mpfr_sum() cannot round,
+ * and the partial sum is then reduced to the number of bits that are really
+ * needed. Only the final result is rounded, so the result is the same as
+ * summing all of the items at once, but the memory used only depends on the
+ * chunk size and the size of the exact sum.
+ *
+ * The exact arithmetic is done with the widest exponent range so that a
+ * partial sum can't overflow or underflow. No Python code may run while the
+ * range is extended.
+ */
+
+#define FSUM_CHUNK 1024
+
+/* Add the n values in tab exactly and store the sum in acc. Returns 0 if
+ * the precision required is too large.
+ */
+
+static int
+fsum_exact(mpfr_t acc, mpfr_ptr *tab, Py_ssize_t n, mpfr_rnd_t round)
+{
+    mpfr_exp_t top = 0, bottom = 0, exp;
+    mpfr_prec_t prec, bits = 0;
+    Py_ssize_t i;
+    int regular = 0;
+    mpfr_t sum;
+
+    for (i = 0; i < n; i++) {
+        if (!mpfr_regular_p(tab[i]))
+            continue;
+        exp = mpfr_get_exp(tab[i]);
+        if (!regular || exp > top)
+            top = exp;
+        if (!regular || exp - mpfr_get_prec(tab[i]) < bottom)
+            bottom = exp - mpfr_get_prec(tab[i]);
+        regular = 1;
+    }
+    for (i = n; i > 0; i >>= 1)
+        bits++;
+
+    if ((double)top - (double)bottom + bits + 1 > (double)(MPFR_PREC_MAX - 1))
+        return 0;
+    prec = regular ? (mpfr_prec_t)(top - bottom) + bits + 1 : MPFR_PREC_MIN;
+
+    mpfr_init2(sum, prec);
+    mpfr_sum(sum, tab, (unsigned long)n, round);
+    mpfr_swap(acc, sum);
+    mpfr_clear(sum);
+    if (mpfr_regular_p(acc)) {
+        prec = mpfr_min_prec(acc);
+        mpfr_prec_round(acc, prec < MPFR_PREC_MIN ? MPFR_PREC_MIN : prec, round);
+    }
+    return 1;
+}
+
+/* Read up to FSUM_CHUNK items from iter into held, converting them to mpfr.
+ * Items that are already mpfr are used without conversion. Returns the
+ * number of items read, or -1 if an error occurred.
+ */
+
+static Py_ssize_t
+fsum_next_chunk(PyObject *iter, PyObject **held, CTXT_Object *context)
+{
+    PyObject *item, *temp;
+    Py_ssize_t n = 0;
+
+    while (n < FSUM_CHUNK && (item = PyIter_Next(iter))) {
+        if (!MPFR_Check(item)) {
+            temp = (PyObject*)GMPy_MPFR_From_Real(item, 1, context);
+            Py_DECREF(item);
+            if (!(item = temp)) {
+                TYPE_ERROR("all items in iterable must be real numbers");
+                break;
+            }
+        }
+        held[n++] = item;
+    }
+
+    if (PyErr_Occurred()) {
+        while (n > 0) {
+            n--;
+            Py_DECREF(held[n]);
+        }
+        return -1;
+    }
+    return n;
+}
+
+/* Store the exact value of sum(x), sum(a*b for a, b in zip(x, y)), or (if
+ * square is set) sum(a*a for a in x) in acc. *invalid is set if an invalid
+ * operation occurred. Returns 0 if an exception was raised.
+ */
+
+static int
+fsum_accumulate(mpfr_t acc, PyObject *x, PyObject *y, int square, int *invalid,
+                CTXT_Object *context)
+{
+    PyObject *xiter = NULL, *yiter = NULL, **held = NULL;
+    mpfr_ptr *tab = NULL, a, b;
+    mpfr_t *prod = NULL;
+    mpfr_exp_t emin, emax;
+    mpfr_rnd_t round = GET_MPFR_ROUND(context);
+    Py_ssize_t i, n, m, start = 1, nprod = 0;
+    int products = square || y, success = 0, exact;
+
+    mpfr_set_zero(acc, 1);
+    *invalid = 0;
+
+    if (!(xiter = PyObject_GetIter(x)) || (y && !(yiter = PyObject_GetIter(y)))) {
+        TYPE_ERROR("argument must be an iterable");
+        goto done;
+    }
+
+    /* The first entry of tab is the running sum, once there is one. */
+    if (!(held = GMPY_MALLOC(sizeof(PyObject*) * 2 * FSUM_CHUNK)) ||
+        !(tab = GMPY_MALLOC(sizeof(mpfr_ptr) * (FSUM_CHUNK + 1))) ||
+        (products && !(prod = GMPY_MALLOC(sizeof(mpfr_t) * FSUM_CHUNK)))) {
+        PyErr_NoMemory();
+        goto done;
+    }
+    tab[0] = acc;
+
+    for (;;) {
+        if ((n = fsum_next_chunk(xiter, held, context)) < 0)
+            goto done;
+        if (yiter) {
+            if ((m = fsum_next_chunk(yiter, held + FSUM_CHUNK, context)) >= 0 && m != n) {
+                VALUE_ERROR("dot() requires iterables of the same length");
+                while (m > 0) {
+                    m--;
+                    Py_DECREF(held[FSUM_CHUNK + m]);
+                }
+                m = -1;
+            }
+            if (m < 0) {
+                while (n > 0) {
+                    n--;
+                    Py_DECREF(held[n]);
+                }
+                goto done;
+            }
+        }
+
+        GMPY_MPFR_WIDEN_RANGE(emin, emax);
+        for (i = 0; i < n; i++) {
+            a = MPFR(held[i]);
+            if (products) {
+                b = yiter ? MPFR(held[FSUM_CHUNK + i]) : a;
+                if (i == nprod)
+                    mpfr_init2(prod[nprod++], mpfr_get_prec(a) + mpfr_get_prec(b));
+                else
+                    mpfr_set_prec(prod[i], mpfr_get_prec(a) + mpfr_get_prec(b));
+                mpfr_mul(prod[i], a, b, round);
+                a = prod[i];
+            }
+            tab[1 + i] = a;
+        }
+        mpfr_clear_flags();
+        exact = fsum_exact(acc, tab + start, n + 1 - start, round);
+        *invalid |= mpfr_nanflag_p();
+        GMPY_MPFR_RESTORE_RANGE(emin, emax);
+
+        for (i = 0; i < n; i++) {
+            Py_DECREF(held[i]);
+            if (yiter)
+                Py_DECREF(held[FSUM_CHUNK + i]);
+        }
+        if (!exact) {
+            OVERFLOW_ERROR("range of exponents is too large");
+            goto done;
+        }
+        start = 0;
+        if (n < FSUM_CHUNK)
+            break;
+    }
+    success = 1;
+
+  done:
+    for (i = 0; i < nprod; i++)
+        mpfr_clear(prod[i]);
+    GMPY_FREE(prod);
+    GMPY_FREE(tab);
+    GMPY_FREE(held);
+    Py_XDECREF(xiter);
+    Py_XDECREF(yiter);
+    return success;
+}
+
+/* Round the exact value in acc, or its square root if root is set, to the
+ * precision of the context.
+ */
+
+static MPFR_Object *
+fsum_result(mpfr_t acc, int root, int invalid, CTXT_Object *context)
+{
+    MPFR_Object *result;
+    mpfr_exp_t emin, emax;
+
+    if (!(result = GMPy_MPFR_New(0, context)))
+        return NULL;
+
+    GMPY_MPFR_WIDEN_RANGE(emin, emax);
+    mpfr_clear_flags();
+    if (root)
+        result->rc = mpfr_sqrt(result->f, acc, GET_MPFR_ROUND(context));
+    else
+        result->rc = mpfr_set(result->f, acc, GET_MPFR_ROUND(context));
+    GMPY_MPFR_RESTORE_RANGE(emin, emax);
+    if (invalid)
+        mpfr_set_nanflag();
+    return result;
+}
 
 static PyObject *
-GMPy_Context_Fsum(PyObject *self, PyObject *other)
+GMPy_Context_Fsum(PyObject *self, PyObject *args, PyObject *kwargs)
 {
-    MPFR_Object *temp, *result;
-    mpfr_ptr *tab;
-    int errcode;
-    Py_ssize_t i, seq_length = 0;
+    static char *kwlist[] = {"iterable", "threads", NULL};
+    PyObject *other, *threads_obj = NULL;
+    MPFR_Object *result = NULL;
+    int invalid, threads, ok;
+    mpfr_t acc;
     CTXT_Object *context = NULL;
 
     if (self && CTXT_Check(self)) {
@@ -1780,81 +2170,85 @@ GMPy_Context_Fsum(PyObject *self, PyObject *other)
         CHECK_CONTEXT(context);
     }
 
-    if (!(result = GMPy_MPFR_New(0, context))) {
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|O", kwlist,
+                                     &other, &threads_obj))
+        return NULL;
+    if ((threads = GMPy_Pool_Threads_Arg(threads_obj)) < 0)
         return NULL;
-    }
 
-    if (!(other = PySequence_List(other))) {
-        Py_DECREF((PyObject*)result);
-        TYPE_ERROR("argument must be an iterable");
+    mpfr_init2(acc, MPFR_PREC_MIN);
+    if (threads)
+        ok = GMPy_Reduce_Fsum(acc, other, threads, &invalid, context) == 0;
+    else
+        ok = fsum_accumulate(acc, other, NULL, 0, &invalid, context);
+    if (ok)
+        result = fsum_result(acc, 0, invalid, context);
+    mpfr_clear(acc);
+    if (!result)
         return NULL;
-    }
 
-    /* other contains a new list containing all the values from the
-     * iterable. Now make sure each item in the list is an mpfr.
-     */
+    GMPY_MPFR_CLEANUP(result, context, "fsum()");
+    return (PyObject*)result;
+}
 
-    seq_length = PyList_GET_SIZE(other);
-    for (i=0; i < seq_length; i++) {
-        if (!(temp = GMPy_MPFR_From_Real(PyList_GET_ITEM(other, i), 1, context))) {
-            Py_DECREF(other);
-            Py_DECREF((PyObject*)result);
-            TYPE_ERROR("all items in iterable must be real numbers");
-            return NULL;
-        }
+PyDoc_STRVAR(GMPy_doc_function_dot,
+"dot(x, y) -> mpfr\n\n"
+"Return the sum of the products of the values in the iterables x and y,\n"
+"which must have the same length. Only the final result is rounded.");
 
-        errcode = PyList_SetItem(other, i,(PyObject*)temp);
-        if (errcode < 0) {
-            Py_DECREF(other);
-            Py_DECREF((PyObject*)result);
-            TYPE_ERROR("all items in iterable must be real numbers");
-            return NULL;
-        }
-    }
+PyDoc_STRVAR(GMPy_doc_context_dot,
+"context.dot(x, y) -> mpfr\n\n"
+"Return the sum of the products of the values in the iterables x and y,\n"
+"which must have the same length. Only the final result is rounded.");
+
+static PyObject *
+GMPy_Context_Dot(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    MPFR_Object *result = NULL;
+    int invalid;
+    mpfr_t acc;
+    CTXT_Object *context = NULL;
 
-    /* create an array of pointers to the mpfr_t field of a Pympfr object */
+    if (nargs != 2) {
+        TYPE_ERROR("dot() requires 2 arguments");
+        return NULL;
+    }
 
-    if (!(tab = (mpfr_ptr *)GMPY_MALLOC((sizeof(mpfr_srcptr) * seq_length)))) {
-        Py_DECREF(other);
-        Py_DECREF((PyObject*)result);
-        return PyErr_NoMemory();
+    if (self && CTXT_Check(self)) {
+        context = (CTXT_Object*)self;
     }
-    for (i=0; i < seq_length; i++) {
-        temp = (MPFR_Object*)PyList_GET_ITEM(other, i);
-        tab[i] = temp->f;
+    else {
+        CHECK_CONTEXT(context);
     }
-    
-    mpfr_clear_flags();
-    result->rc = mpfr_sum(result->f, tab, seq_length, GET_MPFR_ROUND(context));
-    Py_DECREF(other);
-    GMPY_FREE(tab);
 
-    GMPY_MPFR_CLEANUP(result, context, "fsum()");
+    mpfr_init2(acc, MPFR_PREC_MIN);
+    if (fsum_accumulate(acc, args[0], args[1], 0, &invalid, context))
+        result = fsum_result(acc, 0, invalid, context);
+    mpfr_clear(acc);
+    if (!result)
+        return NULL;
+
+    GMPY_MPFR_CLEANUP(result, context, "dot()");
     return (PyObject*)result;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_Context_Dot)
 
-#if 0
-
-/* The following code was a test case for creating a gmpy2 function that would
- * apply an MPFR function to all the elements of a list. It was slightly faster
- * than map(gmpy2.list, <<list>>) but not enough to justify the effort. The
- * code is left for possible future use.
- */ 
+PyDoc_STRVAR(GMPy_doc_function_norm2,
+"norm2(x) -> mpfr\n\n"
+"Return the Euclidean norm, sqrt(sum(a*a for a in x)), of the values in\n"
+"the iterable x. Only the final result is rounded.");
 
-PyDoc_STRVAR(GMPy_doc_function_vector,
-"vector(iterable) -> list\n\n"
-"Template for applying a function to an iterable..");
-
-PyDoc_STRVAR(GMPy_doc_context_vector,
-"vector(iterable) -> list\n\n"
-"Template for applying a function to an iterable.");
+PyDoc_STRVAR(GMPy_doc_context_norm2,
+"context.norm2(x) -> mpfr\n\n"
+"Return the Euclidean norm, sqrt(sum(a*a for a in x)), of the values in\n"
+"the iterable x. Only the final result is rounded.");
 
 static PyObject *
-GMPy_Context_Vector(PyObject *self, PyObject *other)
+GMPy_Context_Norm2(PyObject *self, PyObject *other)
 {
-    PyObject *result, *tempres;
-    Py_ssize_t i, seq_length;
-    
+    MPFR_Object *result = NULL;
+    int invalid;
+    mpfr_t acc;
     CTXT_Object *context = NULL;
 
     if (self && CTXT_Check(self)) {
@@ -1864,40 +2258,94 @@ GMPy_Context_Vector(PyObject *self, PyObject *other)
         CHECK_CONTEXT(context);
     }
 
-    if (!(other = PySequence_List(other))) {
-        TYPE_ERROR("argument must be an iterable");
+    mpfr_init2(acc, MPFR_PREC_MIN);
+    if (fsum_accumulate(acc, other, NULL, 1, &invalid, context))
+        result = fsum_result(acc, 1, invalid, context);
+    mpfr_clear(acc);
+    if (!result)
         return NULL;
-    }
 
-    /* other contains a new list containing all the values from the
-     * iterable. Create a list to store the results.
-     */
+    GMPY_MPFR_CLEANUP(result, context, "norm2()");
+    return (PyObject*)result;
+}
 
-    seq_length = PyList_GET_SIZE(other);
-    if (!(result = PyList_New(seq_length))) {
-        Py_DECREF(other);
+/* Apply a context method that takes one argument to every item of an
+ * iterable. The method is found once and its C function is called directly
+ * for each item, so there is no per-item attribute lookup, argument
+ * parsing, or context lookup.
+ */
+
+PyDoc_STRVAR(GMPy_doc_context_map,
+"context.map(func, iterable) -> list\n\n"
+"Return a list of func(x) for each x in iterable, computed using the\n"
+"context. func is the name of a function that accepts one argument,\n"
+"such as 'sin' or 'exp', or the gmpy2 function itself.");
+
+static PyObject *
+GMPy_Context_Map(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *func, *name, *method, *seq, *result, *temp, **items;
+    PyCFunction cfunc;
+    Py_ssize_t i, seq_length;
+
+    if (nargs != 2) {
+        TYPE_ERROR("map() requires 2 arguments");
         return NULL;
     }
 
-    /* Iterate through the list. */
-    
-    for (i=0; i < seq_length; i++) {
-        if (!(tempres = GMPy_Number_Sin(PyList_GET_ITEM(other, i), context))) {
-            Py_DECREF(other);
-            Py_DECREF(result);
-            TYPE_ERROR("all items in iterable must be numbers");
+    func = args[0];
+    if (Py2or3String_Check(func)) {
+        Py_INCREF(func);
+        name = func;
+    }
+    else if (PyCFunction_Check(func)) {
+        if (!(name = PyObject_GetAttrString(func, "__name__")))
             return NULL;
-        }
+    }
+    else {
+        TYPE_ERROR("map() requires a function name or a gmpy2 function");
+        return NULL;
+    }
+
+    method = PyObject_GetAttr(self, name);
+    Py_DECREF(name);
+    if (!method)
+        return NULL;
 
-        if (PyList_SetItem(result, i, tempres) < 0) {
-            Py_DECREF(other);
+    if (!PyCFunction_Check(method) || PyCFunction_GET_SELF(method) != self ||
+        (PyCFunction_GET_FLAGS(method) &
+         (METH_VARARGS | METH_KEYWORDS | METH_NOARGS | METH_O)) != METH_O) {
+        Py_DECREF(method);
+        TYPE_ERROR("map() requires a function of one argument");
+        return NULL;
+    }
+    cfunc = PyCFunction_GET_FUNCTION(method);
+
+    if (!(seq = PySequence_Fast(args[1],
+                                "map() requires an iterable"))) {
+        Py_DECREF(method);
+        return NULL;
+    }
+
+    seq_length = PySequence_Fast_GET_SIZE(seq);
+    if (!(result = PyList_New(seq_length))) {
+        Py_DECREF(seq);
+        Py_DECREF(method);
+        return NULL;
+    }
+
+    items = PySequence_Fast_ITEMS(seq);
+    for (i = 0; i < seq_length; i++) {
+        if (!(temp = cfunc(self, items[i]))) {
             Py_DECREF(result);
-            return NULL;
+            result = NULL;
+            break;
         }
+        PyList_SET_ITEM(result, i, temp);
     }
 
-    Py_DECREF(other);
-
-    return (PyObject*)result;
+    Py_DECREF(seq);
+    Py_DECREF(method);
+    return result;
 }
-#endif
+GMPY_FASTCALL_WRAPPER(GMPy_Context_Map)
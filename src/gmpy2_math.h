@@ -125,13 +125,16 @@ static PyObject * GMPy_Real_Sinh_Cosh(PyObject *x, CTXT_Object *context);
 static PyObject * GMPy_Number_Sinh_Cosh(PyObject *x, CTXT_Object *context);
 static PyObject * GMPy_Context_Sinh_Cosh(PyObject *self, PyObject *other);
 
+static PyObject * GMPy_Context_Sin_Cos_Many(PyObject *self, PyObject *other);
+static PyObject * GMPy_Context_Sinh_Cosh_Many(PyObject *self, PyObject *other);
+
 static PyObject * GMPy_Real_Atan2(PyObject *x, PyObject *y, CTXT_Object *context);
 static PyObject * GMPy_Number_Atan2(PyObject *x, PyObject *y, CTXT_Object *context);
-static PyObject * GMPy_Context_Atan2(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_Atan2(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 
 static PyObject * GMPy_Real_Hypot(PyObject *x, PyObject *y, CTXT_Object *context);
 static PyObject * GMPy_Number_Hypot(PyObject *x, PyObject *y, CTXT_Object *context);
-static PyObject * GMPy_Context_Hypot(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_Hypot(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 
 static PyObject * GMPy_Context_Degrees(PyObject *self, PyObject *other);
 static PyObject * GMPy_Context_Radians(PyObject *self, PyObject *other);
@@ -258,47 +261,47 @@ static PyObject * GMPy_Context_Ai(PyObject *self, PyObject *other);
 
 static PyObject * GMPy_Real_FMA(PyObject *x, PyObject *y, PyObject *z, CTXT_Object *context);
 static PyObject * GMPy_Number_FMA(PyObject *x, PyObject *y, PyObject *z, CTXT_Object *context);
-static PyObject * GMPy_Context_FMA(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_FMA(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 
 static PyObject * GMPy_Real_FMS(PyObject *x, PyObject *y, PyObject *z, CTXT_Object *context);
 static PyObject * GMPy_Number_FMS(PyObject *x, PyObject *y, PyObject *z, CTXT_Object *context);
-static PyObject * GMPy_Context_FMS(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_FMS(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 
 static PyObject * GMPy_Real_Root(PyObject *x, PyObject *y, CTXT_Object *context);
 static PyObject * GMPy_Number_Root(PyObject *x, PyObject *y, CTXT_Object *context);
-static PyObject * GMPy_Context_Root(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_Root(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 
 static PyObject * GMPy_Real_Jn(PyObject *x, PyObject *y, CTXT_Object *context);
 static PyObject * GMPy_Number_Jn(PyObject *x, PyObject *y, CTXT_Object *context);
-static PyObject * GMPy_Context_Jn(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_Jn(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 
 static PyObject * GMPy_Real_Yn(PyObject *x, PyObject *y, CTXT_Object *context);
 static PyObject * GMPy_Number_Yn(PyObject *x, PyObject *y, CTXT_Object *context);
-static PyObject * GMPy_Context_Yn(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_Yn(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 
 static PyObject * GMPy_Real_AGM(PyObject *x, PyObject *y, CTXT_Object *context);
 static PyObject * GMPy_Number_AGM(PyObject *x, PyObject *y, CTXT_Object *context);
-static PyObject * GMPy_Context_AGM(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_AGM(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 
 static PyObject * GMPy_Real_Maxnum(PyObject *x, PyObject *y, CTXT_Object *context);
 static PyObject * GMPy_Number_Maxnum(PyObject *x, PyObject *y, CTXT_Object *context);
-static PyObject * GMPy_Context_Maxnum(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_Maxnum(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 
 static PyObject * GMPy_Real_Minnum(PyObject *x, PyObject *y, CTXT_Object *context);
 static PyObject * GMPy_Number_Minnum(PyObject *x, PyObject *y, CTXT_Object *context);
-static PyObject * GMPy_Context_Minnum(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_Minnum(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 
 static PyObject * GMPy_Real_Remainder(PyObject *x, PyObject *y, CTXT_Object *context);
 static PyObject * GMPy_Number_Remainder(PyObject *x, PyObject *y, CTXT_Object *context);
-static PyObject * GMPy_Context_Remainder(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_Remainder(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 
 static PyObject * GMPy_Real_Fmod(PyObject *x, PyObject *y, CTXT_Object *context);
 static PyObject * GMPy_Number_Fmod(PyObject *x, PyObject *y, CTXT_Object *context);
-static PyObject * GMPy_Context_Fmod(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_Fmod(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 
 static PyObject * GMPy_Real_RelDiff(PyObject *x, PyObject *y, CTXT_Object *context);
 static PyObject * GMPy_Number_RelDiff(PyObject *x, PyObject *y, CTXT_Object *context);
-static PyObject * GMPy_Context_RelDiff(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_RelDiff(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 
 static PyObject * GMPy_Real_Ceil(PyObject *x, CTXT_Object *context);
 static PyObject * GMPy_Number_Ceil(PyObject *x, CTXT_Object *context);
@@ -317,7 +320,7 @@ static PyObject * GMPy_Context_Trunc(PyObject *self, PyObject *args);
 
 static PyObject * GMPy_Real_Round2(PyObject *x, PyObject *y, CTXT_Object *context);
 static PyObject * GMPy_Number_Round2(PyObject *x, PyObject *y, CTXT_Object *context);
-static PyObject * GMPy_Context_Round2(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_Round2(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 
 static PyObject * GMPy_Real_RoundAway(PyObject *x, CTXT_Object *context);
 static PyObject * GMPy_Number_RoundAway(PyObject *x, CTXT_Object *context);
@@ -333,13 +336,13 @@ static PyObject * GMPy_Context_Lgamma(PyObject *self, PyObject *other);
 
 static PyObject * GMPy_Real_RemQuo(PyObject *x, PyObject *y, CTXT_Object *context);
 static PyObject * GMPy_Number_RemQuo(PyObject *x, PyObject *y, CTXT_Object *context);
-static PyObject * GMPy_Context_RemQuo(PyObject *self, PyObject *other);
+static PyObject * GMPy_Context_RemQuo(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 
 static PyObject * GMPy_Real_Frexp(PyObject *x, CTXT_Object *context);
 static PyObject * GMPy_Number_Frexp(PyObject *x, CTXT_Object *context);
 static PyObject * GMPy_Context_Frexp(PyObject *self, PyObject *other);
 
-static PyObject * GMPy_Context_NextToward(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_NextToward(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 
 static PyObject * GMPy_Context_NextAbove(PyObject *self, PyObject *other);
 
@@ -347,11 +350,11 @@ static PyObject * GMPy_Context_NextBelow(PyObject *self, PyObject *other);
 
 static PyObject * GMPy_Context_Factorial(PyObject *self, PyObject *other);
 
-static PyObject * GMPy_Context_Fsum(PyObject *self, PyObject *other);
+static PyObject * GMPy_Context_Fsum(PyObject *self, PyObject *args, PyObject *kwargs);
+static PyObject * GMPy_Context_Dot(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPy_Context_Norm2(PyObject *self, PyObject *other);
 
-#if 0
-static PyObject * GMPy_Context_Vector(PyObject *self, PyObject *other);
-#endif
+static PyObject * GMPy_Context_Map(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 
 #ifdef __cplusplus
 }
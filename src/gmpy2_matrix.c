@@ -0,0 +1,875 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_matrix.c                                                          *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* Dense linear algebra over mpz, mpq and mpfr.
+ *
+ * matmul() is exact over mpz and mpq. Over mpfr each entry is the exact sum
+ * of the exact products, rounded once, so it is the same value dot() would
+ * return for the row and column.
+ *
+ * det() and solve() over mpz and mpq first multiply each row by the least
+ * common multiple of its denominators and then use fraction-free (Bareiss)
+ * elimination, so every intermediate value is an integer and the results
+ * are exact. Over mpfr they use Gaussian elimination with partial pivoting
+ * at the context precision plus 2*log2(n)+16 guard bits and round only the
+ * final values; the error then depends on the condition of the matrix.
+ */
+
+#define MZ(m, i, j) ((m)->z[MATRIX_INDEX(m, i, j)])
+#define MF(m, i, j) ((m)->f[MATRIX_INDEX(m, i, j)])
+
+static void
+matrix_init(gmpy_matrix *m)
+{
+    m->rows = 0;
+    m->cols = 0;
+    m->kind = MATRIX_MPZ;
+    m->z = NULL;
+    m->q = NULL;
+    m->f = NULL;
+}
+
+static void
+matrix_clear(gmpy_matrix *m)
+{
+    Py_ssize_t i, n = m->rows * m->cols;
+
+    if (m->z) {
+        for (i = 0; i < n; i++)
+            mpz_clear(m->z[i]);
+        PyMem_Free(m->z);
+    }
+    if (m->q) {
+        for (i = 0; i < n; i++)
+            mpq_clear(m->q[i]);
+        PyMem_Free(m->q);
+    }
+    if (m->f) {
+        for (i = 0; i < n; i++)
+            mpfr_clear(m->f[i]);
+        PyMem_Free(m->f);
+    }
+    matrix_init(m);
+}
+
+/* Allocate a rows x cols matrix of zeros (of NaNs for mpfr, with
+ * precision prec). The matrix must be empty.
+ */
+static int
+matrix_alloc(gmpy_matrix *m, Py_ssize_t rows, Py_ssize_t cols, int kind,
+             mpfr_prec_t prec)
+{
+    Py_ssize_t i, n;
+
+    if (cols && rows > PY_SSIZE_T_MAX / cols / (Py_ssize_t)sizeof(mpfr_t)) {
+        PyErr_NoMemory();
+        return 0;
+    }
+    n = rows * cols;
+
+    switch (kind) {
+    case MATRIX_MPZ:
+        m->z = PyMem_New(mpz_t, n ? n : 1);
+        break;
+    case MATRIX_MPQ:
+        m->q = PyMem_New(mpq_t, n ? n : 1);
+        break;
+    default:
+        m->f = PyMem_New(mpfr_t, n ? n : 1);
+        break;
+    }
+    if (!m->z && !m->q && !m->f) {
+        PyErr_NoMemory();
+        return 0;
+    }
+
+    for (i = 0; i < n; i++) {
+        switch (kind) {
+        case MATRIX_MPZ:
+            mpz_init(m->z[i]);
+            break;
+        case MATRIX_MPQ:
+            mpq_init(m->q[i]);
+            break;
+        default:
+            mpfr_init2(m->f[i], prec);
+            break;
+        }
+    }
+    m->rows = rows;
+    m->cols = cols;
+    m->kind = kind;
+    return 1;
+}
+
+/* Copy a sequence of rows (or, if vector is set, a sequence of numbers that
+ * becomes a single column) into m. The kind of m is the widest kind of the
+ * entries; mpfr entries keep their precision.
+ */
+static int
+matrix_load(gmpy_matrix *m, PyObject *obj, int vector, CTXT_Object *context)
+{
+    PyObject *seq, **rows = NULL, **items;
+    Py_ssize_t i, j, k, n, nrows, ncols = vector ? 1 : 0;
+    int kind = MATRIX_MPZ, ok = 0;
+
+    if (!(seq = PySequence_Fast(obj, vector ? "expected a sequence of numbers"
+                                            : "expected a sequence of rows")))
+        return 0;
+    nrows = PySequence_Fast_GET_SIZE(seq);
+    if (!(rows = PyMem_New(PyObject*, nrows ? nrows : 1))) {
+        PyErr_NoMemory();
+        goto done;
+    }
+    for (i = 0; i < nrows; i++)
+        rows[i] = NULL;
+
+    for (i = 0; i < nrows; i++) {
+        if (vector) {
+            rows[i] = PySequence_Fast_GET_ITEM(seq, i);
+            Py_INCREF(rows[i]);
+            items = &rows[i];
+            n = 1;
+        }
+        else {
+            if (!(rows[i] = PySequence_Fast(PySequence_Fast_GET_ITEM(seq, i),
+                                            "each row of a matrix must be a sequence")))
+                goto done;
+            items = PySequence_Fast_ITEMS(rows[i]);
+            n = PySequence_Fast_GET_SIZE(rows[i]);
+            if (i == 0) {
+                ncols = n;
+            }
+            else if (n != ncols) {
+                VALUE_ERROR("all rows of a matrix must have the same length");
+                goto done;
+            }
+        }
+        for (j = 0; j < n; j++) {
+            if (IS_INTEGER(items[j]))
+                continue;
+            if (IS_RATIONAL(items[j])) {
+                if (kind < MATRIX_MPQ)
+                    kind = MATRIX_MPQ;
+                continue;
+            }
+            if (IS_REAL(items[j])) {
+                kind = MATRIX_MPFR;
+                continue;
+            }
+            TYPE_ERROR("matrix entries must be real numbers");
+            goto done;
+        }
+    }
+
+    if (!matrix_alloc(m, nrows, ncols, kind, MPFR_PREC_MIN))
+        goto done;
+
+    for (i = 0, k = 0; i < nrows; i++) {
+        items = vector ? &rows[i] : PySequence_Fast_ITEMS(rows[i]);
+        for (j = 0; j < ncols; j++, k++) {
+            if (kind == MATRIX_MPZ) {
+                MPZ_Object *temp;
+
+                if (!(temp = GMPy_MPZ_From_Integer(items[j], context)))
+                    goto done;
+                mpz_set(m->z[k], temp->z);
+                Py_DECREF((PyObject*)temp);
+            }
+            else if (kind == MATRIX_MPQ) {
+                MPQ_Object *temp;
+
+                if (!(temp = GMPy_MPQ_From_Rational(items[j], context)))
+                    goto done;
+                mpq_set(m->q[k], temp->q);
+                Py_DECREF((PyObject*)temp);
+            }
+            else {
+                MPFR_Object *temp;
+
+                if (!(temp = GMPy_MPFR_From_Real(items[j], 1, context)))
+                    goto done;
+                mpfr_set_prec(m->f[k], mpfr_get_prec(temp->f));
+                mpfr_set(m->f[k], temp->f, MPFR_RNDN);
+                Py_DECREF((PyObject*)temp);
+            }
+        }
+    }
+    ok = 1;
+
+  done:
+    if (rows) {
+        for (i = 0; i < nrows; i++)
+            Py_XDECREF(rows[i]);
+        PyMem_Free(rows);
+    }
+    Py_DECREF(seq);
+    if (!ok)
+        matrix_clear(m);
+    return ok;
+}
+
+/* Convert m to a wider kind. Integers become exact mpfr values; rationals
+ * are rounded like mpfr(x) would round them.
+ */
+static int
+matrix_promote(gmpy_matrix *m, int kind, CTXT_Object *context)
+{
+    gmpy_matrix t;
+    Py_ssize_t i, n = m->rows * m->cols;
+
+    if (m->kind >= kind)
+        return 1;
+
+    matrix_init(&t);
+    if (!matrix_alloc(&t, m->rows, m->cols, kind, MPFR_PREC_MIN))
+        return 0;
+
+    for (i = 0; i < n; i++) {
+        if (kind == MATRIX_MPQ) {
+            mpq_set_z(t.q[i], m->z[i]);
+        }
+        else if (m->kind == MATRIX_MPZ) {
+            size_t bits = mpz_sizeinbase(m->z[i], 2);
+
+            mpfr_set_prec(t.f[i], bits < MPFR_PREC_MIN ? MPFR_PREC_MIN : (mpfr_prec_t)bits);
+            mpfr_set_z(t.f[i], m->z[i], MPFR_RNDN);
+        }
+        else {
+            mpfr_set_prec(t.f[i], GET_MPFR_PREC(context) + GET_GUARD_BITS(context));
+            mpfr_set_q(t.f[i], m->q[i], GET_MPFR_ROUND(context));
+        }
+    }
+    matrix_clear(m);
+    *m = t;
+    return 1;
+}
+
+/* Return the entries of an mpz or mpq matrix as a list of rows, or as a
+ * flat list if vector is set. The values are moved out of m.
+ */
+static PyObject *
+matrix_to_list(gmpy_matrix *m, int vector, CTXT_Object *context)
+{
+    PyObject *result, *row = NULL;
+    Py_ssize_t i, j;
+
+    if (!(result = PyList_New(vector ? m->rows * m->cols : m->rows)))
+        return NULL;
+
+    for (i = 0; i < m->rows; i++) {
+        if (!vector) {
+            if (!(row = PyList_New(m->cols)))
+                goto error;
+            PyList_SET_ITEM(result, i, row);
+        }
+        for (j = 0; j < m->cols; j++) {
+            PyObject *temp;
+
+            if (m->kind == MATRIX_MPZ) {
+                if (!(temp = (PyObject*)GMPy_MPZ_New(context)))
+                    goto error;
+                mpz_swap(MPZ(temp), MZ(m, i, j));
+            }
+            else {
+                if (!(temp = (PyObject*)GMPy_MPQ_New(context)))
+                    goto error;
+                mpq_swap(MPQ(temp), m->q[MATRIX_INDEX(m, i, j)]);
+            }
+            if (vector)
+                PyList_SET_ITEM(result, MATRIX_INDEX(m, i, j), temp);
+            else
+                PyList_SET_ITEM(row, j, temp);
+        }
+    }
+    return result;
+
+  error:
+    Py_DECREF(result);
+    return NULL;
+}
+
+/* Replace the mpq matrix m with the integer matrix obtained by multiplying
+ * each row by the least common multiple of its denominators. The product
+ * of the multipliers is stored in scale.
+ */
+static int
+matrix_clear_denominators(gmpy_matrix *m, mpz_t scale)
+{
+    gmpy_matrix t;
+    Py_ssize_t i, j;
+    mpz_t lcm;
+
+    matrix_init(&t);
+    if (!matrix_alloc(&t, m->rows, m->cols, MATRIX_MPZ, 0))
+        return 0;
+
+    mpz_init(lcm);
+    mpz_set_ui(scale, 1);
+    for (i = 0; i < m->rows; i++) {
+        mpz_set_ui(lcm, 1);
+        for (j = 0; j < m->cols; j++)
+            mpz_lcm(lcm, lcm, mpq_denref(m->q[MATRIX_INDEX(m, i, j)]));
+        for (j = 0; j < m->cols; j++) {
+            mpq_ptr q = m->q[MATRIX_INDEX(m, i, j)];
+
+            mpz_divexact(MZ(&t, i, j), lcm, mpq_denref(q));
+            mpz_mul(MZ(&t, i, j), MZ(&t, i, j), mpq_numref(q));
+        }
+        mpz_mul(scale, scale, lcm);
+    }
+    mpz_clear(lcm);
+    matrix_clear(m);
+    *m = t;
+    return 1;
+}
+
+/* Fraction-free elimination of the first rows columns of the integer
+ * matrix m; the remaining columns are updated along with them. On return m
+ * is upper triangular and its last diagonal entry, times sign, is the
+ * determinant of the leading square block. Returns 0 if that block is
+ * singular.
+ */
+static int
+matrix_bareiss(gmpy_matrix *m, int *sign)
+{
+    Py_ssize_t i, j, k, p, n = m->rows;
+    mpz_t prev, t;
+    int result = 1;
+
+    mpz_init_set_ui(prev, 1);
+    mpz_init(t);
+    *sign = 1;
+    for (k = 0; k < n; k++) {
+        for (p = k; p < n && !mpz_sgn(MZ(m, p, k)); p++)
+            ;
+        if (p == n) {
+            result = 0;
+            break;
+        }
+        if (p != k) {
+            for (j = k; j < m->cols; j++)
+                mpz_swap(MZ(m, p, j), MZ(m, k, j));
+            *sign = -*sign;
+        }
+        for (i = k + 1; i < n; i++) {
+            for (j = k + 1; j < m->cols; j++) {
+                mpz_mul(t, MZ(m, i, j), MZ(m, k, k));
+                mpz_submul(t, MZ(m, i, k), MZ(m, k, j));
+                mpz_divexact(MZ(m, i, j), t, prev);
+            }
+            mpz_set_ui(MZ(m, i, k), 0);
+        }
+        mpz_set(prev, MZ(m, k, k));
+    }
+    mpz_clear(prev);
+    mpz_clear(t);
+    return result;
+}
+
+static mpfr_prec_t
+matrix_working_prec(Py_ssize_t n, CTXT_Object *context)
+{
+    mpfr_prec_t bits = 0;
+
+    for (; n > 0; n >>= 1)
+        bits++;
+    return GET_MPFR_PREC(context) + 2 * bits + 16;
+}
+
+/* Round the entries of the mpfr matrix m to precision prec. */
+static void
+matrix_set_prec(gmpy_matrix *m, mpfr_prec_t prec)
+{
+    Py_ssize_t i, n = m->rows * m->cols;
+
+    for (i = 0; i < n; i++)
+        mpfr_prec_round(m->f[i], prec, MPFR_RNDN);
+}
+
+/* Gaussian elimination with partial pivoting of the first rows columns of
+ * the mpfr matrix m, at the precision of its entries. Returns 0 if a pivot
+ * is zero.
+ */
+static int
+matrix_gauss(gmpy_matrix *m, int *sign)
+{
+    Py_ssize_t i, j, k, p, n = m->rows;
+    mpfr_t factor, t;
+    int result = 1;
+
+    mpfr_init2(factor, mpfr_get_prec(m->f[0]));
+    mpfr_init2(t, mpfr_get_prec(m->f[0]));
+    *sign = 1;
+    for (k = 0; k < n; k++) {
+        for (p = k, i = k + 1; i < n; i++) {
+            if (mpfr_cmpabs(MF(m, i, k), MF(m, p, k)) > 0)
+                p = i;
+        }
+        if (mpfr_zero_p(MF(m, p, k))) {
+            result = 0;
+            break;
+        }
+        if (p != k) {
+            for (j = k; j < m->cols; j++)
+                mpfr_swap(MF(m, p, j), MF(m, k, j));
+            *sign = -*sign;
+        }
+        for (i = k + 1; i < n; i++) {
+            mpfr_div(factor, MF(m, i, k), MF(m, k, k), MPFR_RNDN);
+            for (j = k + 1; j < m->cols; j++) {
+                mpfr_mul(t, factor, MF(m, k, j), MPFR_RNDN);
+                mpfr_sub(MF(m, i, j), MF(m, i, j), t, MPFR_RNDN);
+            }
+            mpfr_set_zero(MF(m, i, k), 1);
+        }
+    }
+    mpfr_clear(factor);
+    mpfr_clear(t);
+    return result;
+}
+
+PyDoc_STRVAR(GMPy_doc_function_matmul,
+"matmul(A, B) -> list\n\n"
+"Return the matrix product of A and B, given as sequences of rows. The\n"
+"product is exact if all entries are integers or rationals. Otherwise\n"
+"each entry is an mpfr with a single rounding of the exact sum.");
+
+PyDoc_STRVAR(GMPy_doc_context_matmul,
+"context.matmul(A, B) -> list\n\n"
+"Return the matrix product of A and B, given as sequences of rows. The\n"
+"product is exact if all entries are integers or rationals. Otherwise\n"
+"each entry is an mpfr with a single rounding of the exact sum.");
+
+static PyObject *
+matrix_matmul_mpfr(gmpy_matrix *a, gmpy_matrix *b, CTXT_Object *context)
+{
+    PyObject *result, *row;
+    Py_ssize_t i, j, k, n = a->cols;
+    mpfr_ptr *tab;
+    mpfr_t *prod;
+    mpfr_exp_t emin, emax;
+
+    if (!(result = PyList_New(a->rows)))
+        return NULL;
+    tab = PyMem_New(mpfr_ptr, n ? n : 1);
+    prod = PyMem_New(mpfr_t, n ? n : 1);
+    if (!tab || !prod) {
+        PyMem_Free(tab);
+        PyMem_Free(prod);
+        Py_DECREF(result);
+        return PyErr_NoMemory();
+    }
+    for (k = 0; k < n; k++) {
+        mpfr_init2(prod[k], MPFR_PREC_MIN);
+        tab[k] = prod[k];
+    }
+
+    for (i = 0; i < a->rows; i++) {
+        if (!(row = PyList_New(b->cols)))
+            goto error;
+        PyList_SET_ITEM(result, i, row);
+        for (j = 0; j < b->cols; j++) {
+            MPFR_Object *temp;
+
+            if (!(temp = GMPy_MPFR_New(0, context)))
+                goto error;
+
+            GMPY_MPFR_WIDEN_RANGE(emin, emax);
+            for (k = 0; k < n; k++) {
+                mpfr_set_prec(prod[k], mpfr_get_prec(MF(a, i, k)) +
+                                       mpfr_get_prec(MF(b, k, j)));
+                mpfr_mul(prod[k], MF(a, i, k), MF(b, k, j), MPFR_RNDN);
+            }
+            mpfr_clear_flags();
+            temp->rc = mpfr_sum(temp->f, tab, (unsigned long)n, GET_MPFR_ROUND(context));
+            GMPY_MPFR_RESTORE_RANGE(emin, emax);
+
+            GMPY_MPFR_CLEANUP(temp, context, "matmul()");
+            if (!temp)
+                goto error;
+            PyList_SET_ITEM(row, j, (PyObject*)temp);
+        }
+    }
+
+    for (k = 0; k < n; k++)
+        mpfr_clear(prod[k]);
+    PyMem_Free(prod);
+    PyMem_Free(tab);
+    return result;
+
+  error:
+    for (k = 0; k < n; k++)
+        mpfr_clear(prod[k]);
+    PyMem_Free(prod);
+    PyMem_Free(tab);
+    Py_DECREF(result);
+    return NULL;
+}
+
+static PyObject *
+GMPy_Context_MatMul(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *result = NULL;
+    gmpy_matrix a, b, c;
+    Py_ssize_t i, j, k;
+    int kind;
+    CTXT_Object *context = NULL;
+
+    if (nargs != 2) {
+        TYPE_ERROR("matmul() requires 2 arguments");
+        return NULL;
+    }
+
+    if (self && CTXT_Check(self)) {
+        context = (CTXT_Object*)self;
+    }
+    else {
+        CHECK_CONTEXT(context);
+    }
+
+    matrix_init(&a);
+    matrix_init(&b);
+    matrix_init(&c);
+    if (!matrix_load(&a, args[0], 0, context) || !matrix_load(&b, args[1], 0, context))
+        goto done;
+
+    if (a.cols != b.rows) {
+        VALUE_ERROR("matmul() requires the number of columns of A to equal the number of rows of B");
+        goto done;
+    }
+
+    kind = a.kind > b.kind ? a.kind : b.kind;
+    if (!matrix_promote(&a, kind, context) || !matrix_promote(&b, kind, context))
+        goto done;
+
+    if (kind == MATRIX_MPFR) {
+        result = matrix_matmul_mpfr(&a, &b, context);
+        goto done;
+    }
+
+    if (!matrix_alloc(&c, a.rows, b.cols, kind, 0))
+        goto done;
+
+    /* The i-k-j order walks along the rows of B and C. */
+    if (kind == MATRIX_MPZ) {
+        for (i = 0; i < a.rows; i++)
+            for (k = 0; k < a.cols; k++) {
+                if (!mpz_sgn(MZ(&a, i, k)))
+                    continue;
+                for (j = 0; j < b.cols; j++)
+                    mpz_addmul(MZ(&c, i, j), MZ(&a, i, k), MZ(&b, k, j));
+            }
+    }
+    else {
+        mpq_t t;
+
+        mpq_init(t);
+        for (i = 0; i < a.rows; i++)
+            for (k = 0; k < a.cols; k++) {
+                if (!mpq_sgn(a.q[MATRIX_INDEX(&a, i, k)]))
+                    continue;
+                for (j = 0; j < b.cols; j++) {
+                    mpq_mul(t, a.q[MATRIX_INDEX(&a, i, k)], b.q[MATRIX_INDEX(&b, k, j)]);
+                    mpq_add(c.q[MATRIX_INDEX(&c, i, j)], c.q[MATRIX_INDEX(&c, i, j)], t);
+                }
+            }
+        mpq_clear(t);
+    }
+    result = matrix_to_list(&c, 0, context);
+
+  done:
+    matrix_clear(&a);
+    matrix_clear(&b);
+    matrix_clear(&c);
+    return result;
+}
+GMPY_FASTCALL_WRAPPER(GMPy_Context_MatMul)
+
+PyDoc_STRVAR(GMPy_doc_function_det,
+"det(A) -> mpz | mpq | mpfr\n\n"
+"Return the determinant of the square matrix A, given as a sequence of\n"
+"rows. The result is exact if all entries are integers or rationals.");
+
+PyDoc_STRVAR(GMPy_doc_context_det,
+"context.det(A) -> mpz | mpq | mpfr\n\n"
+"Return the determinant of the square matrix A, given as a sequence of\n"
+"rows. The result is exact if all entries are integers or rationals.");
+
+static PyObject *
+GMPy_Context_Det(PyObject *self, PyObject *other)
+{
+    PyObject *result = NULL;
+    gmpy_matrix a;
+    Py_ssize_t n;
+    int sign;
+    CTXT_Object *context = NULL;
+
+    if (self && CTXT_Check(self)) {
+        context = (CTXT_Object*)self;
+    }
+    else {
+        CHECK_CONTEXT(context);
+    }
+
+    matrix_init(&a);
+    if (!matrix_load(&a, other, 0, context))
+        return NULL;
+    n = a.rows;
+    if (a.cols != n) {
+        VALUE_ERROR("det() requires a square matrix");
+        goto done;
+    }
+
+    if (a.kind == MATRIX_MPZ) {
+        MPZ_Object *temp;
+
+        if (!(temp = GMPy_MPZ_New(context)))
+            goto done;
+        if (n == 0)
+            mpz_set_ui(temp->z, 1);
+        else if (matrix_bareiss(&a, &sign)) {
+            mpz_swap(temp->z, MZ(&a, n - 1, n - 1));
+            if (sign < 0)
+                mpz_neg(temp->z, temp->z);
+        }
+        else {
+            mpz_set_ui(temp->z, 0);
+        }
+        result = (PyObject*)temp;
+    }
+    else if (a.kind == MATRIX_MPQ) {
+        MPQ_Object *temp;
+
+        if (!(temp = GMPy_MPQ_New(context)))
+            goto done;
+        if (!matrix_clear_denominators(&a, mpq_denref(temp->q))) {
+            Py_DECREF((PyObject*)temp);
+            goto done;
+        }
+        if (n == 0) {
+            mpq_set_ui(temp->q, 1, 1);
+        }
+        else if (matrix_bareiss(&a, &sign)) {
+            mpz_swap(mpq_numref(temp->q), MZ(&a, n - 1, n - 1));
+            if (sign < 0)
+                mpz_neg(mpq_numref(temp->q), mpq_numref(temp->q));
+            mpq_canonicalize(temp->q);
+        }
+        else {
+            mpq_set_ui(temp->q, 0, 1);
+        }
+        result = (PyObject*)temp;
+    }
+    else {
+        MPFR_Object *temp;
+        mpfr_t prod;
+        Py_ssize_t k;
+
+        if (!(temp = GMPy_MPFR_New(0, context)))
+            goto done;
+        mpfr_init2(prod, matrix_working_prec(n, context));
+        mpfr_set_ui(prod, 1, MPFR_RNDN);
+        if (n > 0) {
+            matrix_set_prec(&a, mpfr_get_prec(prod));
+            if (matrix_gauss(&a, &sign)) {
+                for (k = 0; k < n; k++)
+                    mpfr_mul(prod, prod, MF(&a, k, k), MPFR_RNDN);
+                if (sign < 0)
+                    mpfr_neg(prod, prod, MPFR_RNDN);
+            }
+            else {
+                mpfr_set_zero(prod, 1);
+            }
+        }
+        mpfr_clear_flags();
+        temp->rc = mpfr_set(temp->f, prod, GET_MPFR_ROUND(context));
+        mpfr_clear(prod);
+        GMPY_MPFR_CLEANUP(temp, context, "det()");
+        result = (PyObject*)temp;
+    }
+
+  done:
+    matrix_clear(&a);
+    return result;
+}
+
+PyDoc_STRVAR(GMPy_doc_function_solve,
+"solve(A, b) -> list\n\n"
+"Return the solution x of A*x = b for the square matrix A, given as a\n"
+"sequence of rows, and the sequence b. The values are exact mpq if all\n"
+"entries are integers or rationals and mpfr otherwise. Raises\n"
+"ZeroDivisionError if A is singular.");
+
+PyDoc_STRVAR(GMPy_doc_context_solve,
+"context.solve(A, b) -> list\n\n"
+"Return the solution x of A*x = b for the square matrix A, given as a\n"
+"sequence of rows, and the sequence b. The values are exact mpq if all\n"
+"entries are integers or rationals and mpfr otherwise. Raises\n"
+"ZeroDivisionError if A is singular.");
+
+static PyObject *
+GMPy_Context_Solve(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *result = NULL;
+    gmpy_matrix a, b, aug, x;
+    Py_ssize_t i, j, n;
+    int kind, sign;
+    CTXT_Object *context = NULL;
+
+    if (nargs != 2) {
+        TYPE_ERROR("solve() requires 2 arguments");
+        return NULL;
+    }
+
+    if (self && CTXT_Check(self)) {
+        context = (CTXT_Object*)self;
+    }
+    else {
+        CHECK_CONTEXT(context);
+    }
+
+    matrix_init(&a);
+    matrix_init(&b);
+    matrix_init(&aug);
+    matrix_init(&x);
+    if (!matrix_load(&a, args[0], 0, context) || !matrix_load(&b, args[1], 1, context))
+        goto done;
+
+    n = a.rows;
+    if (a.cols != n) {
+        VALUE_ERROR("solve() requires a square matrix");
+        goto done;
+    }
+    if (b.rows != n) {
+        VALUE_ERROR("solve() requires len(b) to equal the size of A");
+        goto done;
+    }
+
+    kind = a.kind > b.kind ? a.kind : b.kind;
+    if (kind < MATRIX_MPQ)
+        kind = MATRIX_MPQ;
+    if (!matrix_promote(&a, kind, context) || !matrix_promote(&b, kind, context))
+        goto done;
+
+    /* The augmented matrix [A | b]. */
+    if (!matrix_alloc(&aug, n, n + 1, kind, matrix_working_prec(n, context)))
+        goto done;
+    for (i = 0; i < n; i++) {
+        for (j = 0; j <= n; j++) {
+            if (kind == MATRIX_MPQ)
+                mpq_set(aug.q[MATRIX_INDEX(&aug, i, j)],
+                        j < n ? a.q[MATRIX_INDEX(&a, i, j)] : b.q[i]);
+            else
+                mpfr_set(MF(&aug, i, j), j < n ? MF(&a, i, j) : b.f[i], MPFR_RNDN);
+        }
+    }
+
+    if (kind == MATRIX_MPQ) {
+        mpz_t scale;
+        mpq_t s, t;
+        int ok;
+
+        mpz_init(scale);
+        ok = matrix_clear_denominators(&aug, scale);
+        mpz_clear(scale);
+        if (!ok)
+            goto done;
+        if (!matrix_bareiss(&aug, &sign)) {
+            ZERO_ERROR("solve() matrix is singular");
+            goto done;
+        }
+        if (!matrix_alloc(&x, n, 1, MATRIX_MPQ, 0))
+            goto done;
+
+        mpq_init(s);
+        mpq_init(t);
+        for (i = n - 1; i >= 0; i--) {
+            mpq_set_z(s, MZ(&aug, i, n));
+            for (j = i + 1; j < n; j++) {
+                mpq_set_z(t, MZ(&aug, i, j));
+                mpq_mul(t, t, x.q[j]);
+                mpq_sub(s, s, t);
+            }
+            mpq_set_z(t, MZ(&aug, i, i));
+            mpq_div(x.q[i], s, t);
+        }
+        mpq_clear(s);
+        mpq_clear(t);
+        result = matrix_to_list(&x, 1, context);
+    }
+    else {
+        mpfr_t s, t;
+
+        if (n > 0 && !matrix_gauss(&aug, &sign)) {
+            ZERO_ERROR("solve() matrix is singular");
+            goto done;
+        }
+        if (!matrix_alloc(&x, n, 1, MATRIX_MPFR, matrix_working_prec(n, context)))
+            goto done;
+
+        mpfr_init2(s, matrix_working_prec(n, context));
+        mpfr_init2(t, matrix_working_prec(n, context));
+        for (i = n - 1; i >= 0; i--) {
+            mpfr_set(s, MF(&aug, i, n), MPFR_RNDN);
+            for (j = i + 1; j < n; j++) {
+                mpfr_mul(t, MF(&aug, i, j), x.f[j], MPFR_RNDN);
+                mpfr_sub(s, s, t, MPFR_RNDN);
+            }
+            mpfr_div(x.f[i], s, MF(&aug, i, i), MPFR_RNDN);
+        }
+        mpfr_clear(s);
+        mpfr_clear(t);
+
+        if (!(result = PyList_New(n)))
+            goto done;
+        for (i = 0; i < n; i++) {
+            MPFR_Object *temp;
+
+            if (!(temp = GMPy_MPFR_New(0, context))) {
+                Py_CLEAR(result);
+                goto done;
+            }
+            mpfr_clear_flags();
+            temp->rc = mpfr_set(temp->f, x.f[i], GET_MPFR_ROUND(context));
+            GMPY_MPFR_CLEANUP(temp, context, "solve()");
+            if (!temp) {
+                Py_CLEAR(result);
+                goto done;
+            }
+            PyList_SET_ITEM(result, i, (PyObject*)temp);
+        }
+    }
+
+  done:
+    matrix_clear(&a);
+    matrix_clear(&b);
+    matrix_clear(&aug);
+    matrix_clear(&x);
+    return result;
+}
+GMPY_FASTCALL_WRAPPER(GMPy_Context_Solve)
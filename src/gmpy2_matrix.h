@@ -0,0 +1,60 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_matrix.h                                                          *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GMPY_MATRIX_H
+#define GMPY_MATRIX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* A matrix is passed in and returned as a sequence of rows. Internally the
+ * entries are copied once into a single row-major array of mpz_t, mpq_t or
+ * mpfr_t, chosen from the widest type of the entries.
+ */
+
+enum { MATRIX_MPZ, MATRIX_MPQ, MATRIX_MPFR };
+
+typedef struct {
+    Py_ssize_t rows;
+    Py_ssize_t cols;
+    int kind;
+    mpz_t *z;
+    mpq_t *q;
+    mpfr_t *f;
+} gmpy_matrix;
+
+#define MATRIX_INDEX(m, i, j) ((i) * (m)->cols + (j))
+
+static PyObject * GMPy_Context_MatMul(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPy_Context_Det(PyObject *self, PyObject *other);
+static PyObject * GMPy_Context_Solve(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
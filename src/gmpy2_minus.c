@@ -79,7 +79,12 @@ GMPy_Integer_Minus(PyObject *x, CTXT_Object *context)
 static PyObject *
 GMPy_MPZ_Minus_Slot(MPZ_Object *x)
 {
-    return _GMPy_MPZ_Minus((PyObject*)x, NULL);
+    MPZ_Object *result;
+
+    if ((result = GMPy_MPZ_Reuse((PyObject*)x, NULL))) {
+        mpz_neg(result->z, x->z);
+    }
+    return (PyObject*)result;
 }
 
 static PyObject *
@@ -232,11 +237,11 @@ PyDoc_STRVAR(GMPy_doc_context_minus,
 "Return -x. The context is applied to the result.");
 
 static PyObject *
-GMPy_Context_Minus(PyObject *self, PyObject *args)
+GMPy_Context_Minus(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     CTXT_Object *context = NULL;
 
-    if (PyTuple_GET_SIZE(args) != 1) {
+    if (nargs != 1) {
         TYPE_ERROR("minus() requires 1 argument.");
         return NULL;
     }
@@ -248,6 +253,7 @@ GMPy_Context_Minus(PyObject *self, PyObject *args)
         CHECK_CONTEXT(context);
     }
 
-    return GMPy_Number_Minus(PyTuple_GET_ITEM(args, 0), context);
+    return GMPy_Number_Minus(args[0], context);
 }
+GMPY_FASTCALL_WRAPPER(GMPy_Context_Minus)
 
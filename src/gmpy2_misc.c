@@ -117,18 +117,36 @@ GMPy_get_cache(PyObject *self, PyObject *args)
     return Py_BuildValue("(ii)", global.cache_size, global.cache_obsize);
 }
 
+/* Names of the caches, indexed by GMPY_CACHE_ZCACHE, etc. */
+
+static const char *cache_names[GMPY_CACHE_TYPES] =
+    { "zcache", "mpz", "xmpz", "mpq", "mpfr", "mpc" };
+
 PyDoc_STRVAR(GMPy_doc_set_cache,
-"set_cache(cache_size, object_size)\n\n\
+"set_cache(cache_size, object_size, **kwargs)\n\n\
 Set the current cache size (number of objects) and the maximum size\n\
 per object (number of limbs). Raises ValueError if cache size exceeds\n\
-1000 or object size exceeds 16384.");
+1000 or object size exceeds 16384. The size of an individual cache can\n\
+be set with the keywords 'zcache', 'mpz', 'xmpz', 'mpq', 'mpfr', and\n\
+'mpc'; the other caches use 'cache_size'.");
 
 static PyObject *
-GMPy_set_cache(PyObject *self, PyObject *args)
+GMPy_set_cache(PyObject *self, PyObject *args, PyObject *kwargs)
 {
-    int newcache = -1, newsize = -1;
+    int newcache = -1, newsize = -1, i;
+    int sizes[GMPY_CACHE_TYPES] = { -1, -1, -1, -1, -1, -1 };
+    gmpy_cache *cache;
+    static char *kwlist[] = {"cache_size", "object_size", "zcache", "mpz",
+                             "xmpz", "mpq", "mpfr", "mpc", NULL};
 
-    if (!PyArg_ParseTuple(args, "ii", &newcache, &newsize))
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "ii|iiiiii", kwlist,
+                                     &newcache, &newsize,
+                                     &sizes[GMPY_CACHE_ZCACHE],
+                                     &sizes[GMPY_CACHE_MPZ],
+                                     &sizes[GMPY_CACHE_XMPZ],
+                                     &sizes[GMPY_CACHE_MPQ],
+                                     &sizes[GMPY_CACHE_MPFR],
+                                     &sizes[GMPY_CACHE_MPC]))
         return NULL;
     if (newcache<0 || newcache>MAX_CACHE) {
         VALUE_ERROR("cache size must between 0 and 1000");
@@ -138,18 +156,162 @@ GMPy_set_cache(PyObject *self, PyObject *args)
         VALUE_ERROR("object size must between 0 and 16384");
         return NULL;
     }
+    for (i = 0; i < GMPY_CACHE_TYPES; ++i) {
+        if (sizes[i] == -1)
+            sizes[i] = newcache;
+        if (sizes[i]<0 || sizes[i]>MAX_CACHE) {
+            VALUE_ERROR("cache size must between 0 and 1000");
+            return NULL;
+        }
+    }
 
     global.cache_size = newcache;
     global.cache_obsize = newsize;
-    set_zcache();
-    set_gmpympzcache();
-    set_gmpympqcache();
-    set_gmpyxmpzcache();
-    set_gmpympfrcache();
-    set_gmpympccache();
+    for (i = 0; i < GMPY_CACHE_TYPES; ++i)
+        global.cache_sizes[i] = sizes[i];
+    global.cache_generation++;
+
+    /* The caches of other threads are resized the next time they are used. */
+    if ((cache = GMPy_current_cache()))
+        GMPy_Cache_Resize(cache);
+    Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(GMPy_doc_get_str_cache,
+"get_str_cache() -> (limit, bytes)\n\n\
+Return the maximum number of bytes of mpz strings that are kept by\n\
+set_str_cache() and the number of bytes currently kept.");
+
+static PyObject *
+GMPy_get_str_cache(PyObject *self, PyObject *args)
+{
+    return Py_BuildValue("(nn)", (Py_ssize_t)global.str_cache_limit,
+                         (Py_ssize_t)global.str_cache_bytes);
+}
+
+PyDoc_STRVAR(GMPy_doc_set_str_cache,
+"set_str_cache(bytes)\n\n\
+Keep the result of str() on an mpz of at least 256 bits with the mpz,\n\
+so converting it again (with str() or repr()) does not repeat the\n\
+conversion. At most 'bytes' bytes of strings are kept in total; they\n\
+are released when the mpz is deleted. xmpz values are never cached.\n\
+0 (the default) stops adding strings to the cache.");
+
+static PyObject *
+GMPy_set_str_cache(PyObject *self, PyObject *other)
+{
+    Py_ssize_t bytes;
+
+    bytes = PyIntOrLong_AsSsize_t(other);
+    if (bytes == -1 && PyErr_Occurred()) {
+        TYPE_ERROR("set_str_cache() requires an integer argument");
+        return NULL;
+    }
+    if (bytes < 0) {
+        VALUE_ERROR("size must be 0 or greater");
+        return NULL;
+    }
+    global.str_cache_limit = (size_t)bytes;
     Py_RETURN_NONE;
 }
 
+PyDoc_STRVAR(GMPy_doc_prewarm,
+"prewarm(cache, count, limbs) -> integer\n\n\
+Add up to 'count' freed objects with room for 'limbs' limbs to the cache\n\
+named 'cache' ('zcache', 'mpz', 'xmpz', 'mpq', 'mpfr', or 'mpc') of the\n\
+current thread. Return the number of objects added. The cache size and\n\
+object size set by set_cache() still apply.");
+
+static PyObject *
+GMPy_prewarm(PyObject *self, PyObject *args)
+{
+    char *name;
+    int count, limbs, type;
+    Py_ssize_t added;
+
+    if (!PyArg_ParseTuple(args, "sii", &name, &count, &limbs))
+        return NULL;
+
+    for (type = 0; type < GMPY_CACHE_TYPES; ++type) {
+        if (!strcmp(name, cache_names[type]))
+            break;
+    }
+    if (type == GMPY_CACHE_TYPES) {
+        VALUE_ERROR("unknown cache name");
+        return NULL;
+    }
+    if (count<0 || count>MAX_CACHE) {
+        VALUE_ERROR("count must between 0 and 1000");
+        return NULL;
+    }
+    if (limbs<1 || limbs>MAX_CACHE_LIMBS) {
+        VALUE_ERROR("limbs must between 1 and 16384");
+        return NULL;
+    }
+
+    if ((added = GMPy_Cache_Prewarm(type, count, limbs)) < 0)
+        return NULL;
+    return PyIntOrLong_FromSsize_t(added);
+}
+
+PyDoc_STRVAR(GMPy_doc_cache_stats,
+"cache_stats() -> dict\n\n\
+Return a dictionary of statistics for the object caches of the current\n\
+thread and for the memory allocated by GMP, MPFR, and MPC. For each of\n\
+'zcache', 'mpz', 'xmpz', 'mpq', 'mpfr', and 'mpc' the dictionary contains\n\
+the number of 'hits', 'misses', 'evictions', the number of objects\n\
+currently 'cached', and the maximum 'size' of the cache. The 'allocator' entry contains the number of calls to\n\
+'malloc', 'realloc', and 'free', the 'total_bytes' requested, and the\n\
+'bytes' currently allocated and their high-water mark 'peak_bytes', and\n\
+the number of allocations of one or two limbs served from the freed limbs\n\
+kept by the current thread ('limb_hits').");
+
+static PyObject *
+GMPy_cache_stats(PyObject *self, PyObject *args)
+{
+    gmpy_cache_stats *stats, empty = { 0, 0, 0 };
+    gmpy_cache *cache;
+    PyObject *result, *temp;
+    int i;
+
+    cache = GMPy_current_cache();
+
+    if (!(result = PyDict_New()))
+        return NULL;
+
+    for (i = 0; i < GMPY_CACHE_TYPES; ++i) {
+        stats = cache ? &(cache->stats[i]) : &empty;
+        temp = Py_BuildValue("{s:n,s:n,s:n,s:n,s:i}",
+                             "hits", (Py_ssize_t)stats->hits,
+                             "misses", (Py_ssize_t)stats->misses,
+                             "evictions", (Py_ssize_t)stats->evictions,
+                             "cached", cache ? GMPy_Cache_Count(cache, i) : 0,
+                             "size", global.cache_sizes[i]);
+        if (!temp || PyDict_SetItemString(result, cache_names[i], temp) < 0) {
+            Py_XDECREF(temp);
+            Py_DECREF(result);
+            return NULL;
+        }
+        Py_DECREF(temp);
+    }
+
+    temp = Py_BuildValue("{s:n,s:n,s:n,s:n,s:n,s:n,s:n}",
+                         "malloc", (Py_ssize_t)alloc_stats.allocs,
+                         "realloc", (Py_ssize_t)alloc_stats.reallocs,
+                         "free", (Py_ssize_t)alloc_stats.frees,
+                         "total_bytes", (Py_ssize_t)alloc_stats.total_bytes,
+                         "bytes", (Py_ssize_t)alloc_stats.bytes,
+                         "peak_bytes", (Py_ssize_t)alloc_stats.peak_bytes,
+                         "limb_hits", (Py_ssize_t)alloc_stats.limb_hits);
+    if (!temp || PyDict_SetItemString(result, "allocator", temp) < 0) {
+        Py_XDECREF(temp);
+        Py_DECREF(result);
+        return NULL;
+    }
+    Py_DECREF(temp);
+    return result;
+}
+
 PyDoc_STRVAR(GMPy_doc_function_printf,
 "_printf(fmt, x) -> string\n\n"
 "Return a Python string by formatting 'x' using the format string\n"
@@ -206,3 +368,45 @@ GMPy_printf(PyObject *self, PyObject *args)
     }
 }
 
+#if PY_VERSION_HEX >= 0x03070000
+/* Call a METH_VARARGS | METH_KEYWORDS function with the arguments of a
+ * METH_FASTCALL | METH_KEYWORDS call. Used by the fast call front ends for
+ * the calls they do not handle themselves.
+ */
+
+static PyObject *
+GMPy_FastCall_Keywords(PyCFunctionWithKeywords func, PyObject *self,
+                       PyObject *const *args, Py_ssize_t nargs,
+                       PyObject *kwnames)
+{
+    PyObject *tuple, *dict = NULL, *result;
+    Py_ssize_t i, nkw = kwnames ? PyTuple_GET_SIZE(kwnames) : 0;
+
+    if (!(tuple = PyTuple_New(nargs))) {
+        return NULL;
+    }
+    for (i = 0; i < nargs; i++) {
+        Py_INCREF(args[i]);
+        PyTuple_SET_ITEM(tuple, i, args[i]);
+    }
+
+    if (nkw) {
+        if (!(dict = PyDict_New())) {
+            Py_DECREF(tuple);
+            return NULL;
+        }
+        for (i = 0; i < nkw; i++) {
+            if (PyDict_SetItem(dict, PyTuple_GET_ITEM(kwnames, i), args[nargs + i]) < 0) {
+                Py_DECREF(tuple);
+                Py_DECREF(dict);
+                return NULL;
+            }
+        }
+    }
+
+    result = func(self, tuple, dict);
+    Py_DECREF(tuple);
+    Py_XDECREF(dict);
+    return result;
+}
+#endif
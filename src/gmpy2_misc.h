@@ -40,8 +40,17 @@ static PyObject * GMPy_get_mpfr_version(PyObject *self, PyObject *args);
 static PyObject * GMPy_get_mpc_version(PyObject *self, PyObject *args);
 static PyObject * GMPy_get_mp_limbsize(PyObject *self, PyObject *args);
 static PyObject * GMPy_get_cache(PyObject *self, PyObject *args);
-static PyObject * GMPy_set_cache(PyObject *self, PyObject *args);
+static PyObject * GMPy_set_cache(PyObject *self, PyObject *args, PyObject *kwargs);
+static PyObject * GMPy_get_str_cache(PyObject *self, PyObject *args);
+static PyObject * GMPy_set_str_cache(PyObject *self, PyObject *other);
+static PyObject * GMPy_prewarm(PyObject *self, PyObject *args);
+static PyObject * GMPy_cache_stats(PyObject *self, PyObject *args);
 static PyObject * GMPy_printf(PyObject *self, PyObject *args);
+#if PY_VERSION_HEX >= 0x03070000
+static PyObject * GMPy_FastCall_Keywords(PyCFunctionWithKeywords func, PyObject *self,
+                                         PyObject *const *args, Py_ssize_t nargs,
+                                         PyObject *kwnames);
+#endif
 
 #ifdef __cplusplus
 }
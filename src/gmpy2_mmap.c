@@ -0,0 +1,404 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_mmap.c                                                            *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* xmpz_mmap() returns an xmpz whose limbs are stored in a memory-mapped
+ * file instead of on the heap, so the value may be larger than the memory
+ * that the process can allocate and the operating system decides which
+ * pages stay resident.
+ *
+ * GMP resizes the limbs through the memory functions installed by gmpy2.
+ * gmpy_reallocate() recognizes the limbs of a mapped file and grows the
+ * file instead of calling realloc(). Some GMP functions replace the limbs
+ * of their result with freshly allocated memory and free the old limbs;
+ * gmpy_free() then marks the file as detached and the limbs are copied
+ * back into the file by the next save().
+ *
+ * save() records the size of the value in the header and flushes the
+ * pages to disk. Mapping the file again restores the value without
+ * parsing or copying it. The memory functions may run without the GIL, so
+ * the list of regions is protected by arena_lock.
+ */
+
+#ifdef GMPY_MMAP
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+static size_t
+mmap_round(size_t size)
+{
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+
+    return (size + page - 1) / page * page;
+}
+
+static size_t
+mmap_capacity(gmpy_mmap_region *region)
+{
+    return (region->map_size - MMAP_HEADER) / sizeof(mp_limb_t);
+}
+
+/* Map the first 'map_size' bytes of the file, growing the file if
+ * necessary. The previous mapping, if any, is removed. Returns -1 and sets
+ * errno on failure; the previous mapping is then left in place.
+ */
+
+static int
+mmap_region_map(gmpy_mmap_region *region, size_t map_size)
+{
+    char *base;
+
+    if (map_size > region->map_size && ftruncate(region->fd, (off_t)map_size) < 0)
+        return -1;
+    base = mmap(NULL, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, region->fd, 0);
+    if (base == MAP_FAILED)
+        return -1;
+    if (region->base)
+        munmap(region->base, region->map_size);
+    region->base = base;
+    region->map_size = map_size;
+    region->data = (mp_limb_t*)(base + MMAP_HEADER);
+    return 0;
+}
+
+static void
+mmap_region_del(gmpy_mmap_region *region)
+{
+    int locked;
+
+    ARENA_LOCK(locked);
+    if (region->prev)
+        region->prev->next = region->next;
+    else
+        mmap_regions = region->next;
+    if (region->next)
+        region->next->prev = region->prev;
+    ARENA_UNLOCK(locked);
+
+    if (region->base)
+        munmap(region->base, region->map_size);
+    close(region->fd);
+    GMPY_FREE(region);
+}
+
+static gmpy_mmap_region *
+GMPy_Mmap_Find(void *ptr)
+{
+    gmpy_mmap_region *region;
+
+    for (region = mmap_regions; region; region = region->next) {
+        if (region->attached && (void*)region->data == ptr)
+            return region;
+    }
+    return NULL;
+}
+
+static void *
+GMPy_Mmap_Reallocate(gmpy_mmap_region *region, void *ptr,
+                     size_t old_size, size_t new_size)
+{
+    void *res;
+
+    if (MMAP_HEADER + new_size <= region->map_size ||
+        mmap_region_map(region, mmap_round(MMAP_HEADER + new_size)) == 0)
+        return region->data;
+
+    /* The file cannot grow; keep the value on the heap until save(). */
+    if (!(res = GMPY_MALLOC(new_size)))
+        Py_FatalError("Insufficient memory");
+    memcpy(res, ptr, old_size < new_size ? old_size : new_size);
+    region->attached = 0;
+    return res;
+}
+
+static void
+GMPy_Mmap_Free(gmpy_mmap_region *region, void *ptr)
+{
+    region->attached = 0;
+}
+
+/* Move the limbs of a detached xmpz back into its file. Returns -1 and
+ * sets an exception on failure.
+ */
+
+static int
+mmap_attach(XMPZ_Object *obj)
+{
+    gmpy_mmap_region *region = obj->mapping;
+    size_t size = mpz_size(obj->z), capacity;
+    void (*free_func)(void *, size_t);
+    void *limbs = obj->z->_mp_d;
+    size_t limbs_size = (size_t)obj->z->_mp_alloc * sizeof(mp_limb_t);
+    int locked, res = 0;
+
+    if (region->attached)
+        return 0;
+
+    if (obj->exports) {
+        BUFFER_ERROR("cannot save an xmpz with exported buffers");
+        return -1;
+    }
+
+    ARENA_LOCK(locked);
+    if (MMAP_HEADER + (size ? size : 1) * sizeof(mp_limb_t) > region->map_size)
+        res = mmap_region_map(region,
+                              mmap_round(MMAP_HEADER + size * sizeof(mp_limb_t)));
+    if (res == 0) {
+        memcpy(region->data, limbs, size * sizeof(mp_limb_t));
+        capacity = mmap_capacity(region);
+        obj->z->_mp_d = region->data;
+        obj->z->_mp_alloc = capacity > INT_MAX ? INT_MAX : (int)capacity;
+        region->attached = 1;
+    }
+    ARENA_UNLOCK(locked);
+
+    if (res < 0) {
+        PyErr_SetFromErrno(PyExc_OSError);
+        return -1;
+    }
+    mp_get_memory_functions(NULL, NULL, &free_func);
+    free_func(limbs, limbs_size);
+    return 0;
+}
+
+/* Called by GMPy_XMPZ_Dealloc. The value is saved and the file is closed;
+ * obj->z is left holding a heap-allocated 0.
+ */
+
+static void
+GMPy_Mmap_Close(XMPZ_Object *obj)
+{
+    gmpy_mmap_region *region = obj->mapping;
+
+    if (mmap_attach(obj) < 0)
+        PyErr_Clear();
+    if (region->attached)
+        ((gmpy_mmap_header*)region->base)->size = obj->z->_mp_size;
+    else
+        mpz_clear(obj->z);
+    mmap_region_del(region);
+    obj->mapping = NULL;
+    mpz_init(obj->z);
+}
+
+PyDoc_STRVAR(GMPy_doc_xmpz_mmap,
+"xmpz_mmap(filename[, x]) -> xmpz\n\n"
+"Return an xmpz whose limbs are stored in the memory-mapped file\n"
+"'filename'. If 'x' is given, the file is created or replaced and\n"
+"initialized to 'x'. Otherwise the value saved in an existing file is\n"
+"mapped without being parsed or copied. The file grows as the value\n"
+"does. Use xmpz.save() to write the value to disk.");
+
+static PyObject *
+GMPy_XMPZ_Mmap(PyObject *self, PyObject *args)
+{
+    PyObject *filename = NULL, *value = NULL;
+    MPZ_Object *tempx = NULL;
+    XMPZ_Object *result = NULL;
+    gmpy_mmap_region *region;
+    gmpy_mmap_header *header;
+    struct stat st;
+    size_t size, capacity;
+    int locked;
+
+#ifdef PY3
+    if (!PyArg_ParseTuple(args, "O&|O", PyUnicode_FSConverter, &filename, &value))
+        return NULL;
+#else
+    if (!PyArg_ParseTuple(args, "S|O", &filename, &value))
+        return NULL;
+    Py_INCREF(filename);
+#endif
+
+    if (value && !(tempx = GMPy_MPZ_From_Integer(value, NULL)))
+        goto error;
+
+    if (!(region = GMPY_MALLOC(sizeof(gmpy_mmap_region)))) {
+        PyErr_NoMemory();
+        goto error;
+    }
+    region->base = NULL;
+    region->map_size = 0;
+    region->attached = 1;
+
+    region->fd = open(PyBytes_AS_STRING(filename),
+                      tempx ? O_RDWR | O_CREAT | O_TRUNC : O_RDWR, 0666);
+    if (region->fd < 0) {
+        GMPY_FREE(region);
+        PyErr_SetFromErrnoWithFilename(PyExc_OSError, PyBytes_AS_STRING(filename));
+        goto error;
+    }
+
+    if (tempx) {
+        size = mpz_size(tempx->z);
+        if (mmap_region_map(region,
+                            mmap_round(MMAP_HEADER + (size ? size : 1) * sizeof(mp_limb_t))) < 0)
+            goto error_errno;
+        header = (gmpy_mmap_header*)region->base;
+        memcpy(header->magic, MMAP_MAGIC, 8);
+        header->version = MMAP_VERSION;
+        header->limb_bytes = (uint32_t)sizeof(mp_limb_t);
+        header->size = tempx->z->_mp_size;
+        memcpy(region->data, tempx->z->_mp_d, size * sizeof(mp_limb_t));
+    }
+    else {
+        if (fstat(region->fd, &st) < 0)
+            goto error_errno;
+        if (st.st_size < MMAP_HEADER + (off_t)sizeof(mp_limb_t)) {
+            VALUE_ERROR("file is not an xmpz_mmap() file");
+            goto error_region;
+        }
+        if (mmap_region_map(region, (size_t)st.st_size) < 0)
+            goto error_errno;
+        header = (gmpy_mmap_header*)region->base;
+        if (memcmp(header->magic, MMAP_MAGIC, 8) || header->version != MMAP_VERSION) {
+            VALUE_ERROR("file is not an xmpz_mmap() file");
+            goto error_region;
+        }
+        if (header->limb_bytes != sizeof(mp_limb_t)) {
+            VALUE_ERROR("xmpz_mmap() file was written with a different limb size");
+            goto error_region;
+        }
+        if ((uint64_t)(header->size < 0 ? -header->size : header->size) > mmap_capacity(region) ||
+            header->size > INT_MAX || header->size < -INT_MAX) {
+            VALUE_ERROR("xmpz_mmap() file is truncated");
+            goto error_region;
+        }
+    }
+
+    if (!(result = GMPy_XMPZ_New(NULL)))
+        goto error_region;
+
+    mpz_clear(result->z);
+    capacity = mmap_capacity(region);
+    result->z->_mp_d = region->data;
+    result->z->_mp_alloc = capacity > INT_MAX ? INT_MAX : (int)capacity;
+    result->z->_mp_size = (int)header->size;
+    result->mapping = region;
+
+    ARENA_LOCK(locked);
+    region->prev = NULL;
+    region->next = mmap_regions;
+    if (mmap_regions)
+        mmap_regions->prev = region;
+    mmap_regions = region;
+    ARENA_UNLOCK(locked);
+
+    Py_DECREF(filename);
+    Py_XDECREF((PyObject*)tempx);
+    return (PyObject*)result;
+
+  error_errno:
+    PyErr_SetFromErrnoWithFilename(PyExc_OSError, PyBytes_AS_STRING(filename));
+  error_region:
+    if (region->base)
+        munmap(region->base, region->map_size);
+    close(region->fd);
+    GMPY_FREE(region);
+  error:
+    Py_DECREF(filename);
+    Py_XDECREF((PyObject*)tempx);
+    return NULL;
+}
+
+PyDoc_STRVAR(GMPy_doc_xmpz_method_save,
+"x.save()\n\n"
+"Write the value of an xmpz created by xmpz_mmap() to its file and\n"
+"flush the file to disk.");
+
+static PyObject *
+GMPy_XMPZ_Method_Save(PyObject *self, PyObject *other)
+{
+    XMPZ_Object *obj = (XMPZ_Object*)self;
+    gmpy_mmap_region *region = obj->mapping;
+
+    if (!region) {
+        VALUE_ERROR("save() requires an xmpz created by xmpz_mmap()");
+        return NULL;
+    }
+
+    if (mmap_attach(obj) < 0)
+        return NULL;
+
+    ((gmpy_mmap_header*)region->base)->size = obj->z->_mp_size;
+    if (msync(region->base, region->map_size, MS_SYNC) < 0) {
+        PyErr_SetFromErrno(PyExc_OSError);
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+#else
+
+static gmpy_mmap_region *
+GMPy_Mmap_Find(void *ptr)
+{
+    return NULL;
+}
+
+static void *
+GMPy_Mmap_Reallocate(gmpy_mmap_region *region, void *ptr,
+                     size_t old_size, size_t new_size)
+{
+    return NULL;
+}
+
+static void
+GMPy_Mmap_Free(gmpy_mmap_region *region, void *ptr)
+{
+}
+
+static void
+GMPy_Mmap_Close(XMPZ_Object *obj)
+{
+}
+
+PyDoc_STRVAR(GMPy_doc_xmpz_mmap,
+"xmpz_mmap(filename[, x]) -> xmpz\n\n"
+"Not supported on this platform.");
+
+static PyObject *
+GMPy_XMPZ_Mmap(PyObject *self, PyObject *args)
+{
+    SYSTEM_ERROR("xmpz_mmap() is not supported on this platform");
+    return NULL;
+}
+
+PyDoc_STRVAR(GMPy_doc_xmpz_method_save,
+"x.save()\n\n"
+"Not supported on this platform.");
+
+static PyObject *
+GMPy_XMPZ_Method_Save(PyObject *self, PyObject *other)
+{
+    VALUE_ERROR("save() requires an xmpz created by xmpz_mmap()");
+    return NULL;
+}
+
+#endif
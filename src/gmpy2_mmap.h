@@ -0,0 +1,77 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_mmap.h                                                            *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GMPY_MMAP_H
+#define GMPY_MMAP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* The limbs of an xmpz created by xmpz_mmap() live in a file mapped with
+ * mmap(). The file starts with a header of MMAP_HEADER bytes that records
+ * the size of the value; the limbs follow.
+ */
+
+#if defined(HAVE_MMAP) && defined(HAVE_SYS_MMAN_H) && defined(HAVE_FTRUNCATE)
+#  define GMPY_MMAP
+#endif
+
+#define MMAP_MAGIC "GMPYXMPZ"
+#define MMAP_VERSION 1
+#define MMAP_HEADER 64
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t limb_bytes;            /* sizeof(mp_limb_t) of the writer */
+    int64_t size;                   /* _mp_size when last saved */
+} gmpy_mmap_header;
+
+typedef struct gmpy_mmap_region {
+    struct gmpy_mmap_region *next;  /* list of all mapped files */
+    struct gmpy_mmap_region *prev;
+    int fd;
+    char *base;                     /* start of the mapping */
+    size_t map_size;                /* bytes mapped, equal to the file size */
+    mp_limb_t *data;                /* base + MMAP_HEADER */
+    int attached;                   /* the xmpz uses data for its limbs */
+} gmpy_mmap_region;
+
+static gmpy_mmap_region * GMPy_Mmap_Find(void *ptr);
+static void *             GMPy_Mmap_Reallocate(gmpy_mmap_region *region, void *ptr,
+                                               size_t old_size, size_t new_size);
+static void               GMPy_Mmap_Free(gmpy_mmap_region *region, void *ptr);
+static void               GMPy_Mmap_Close(XMPZ_Object *obj);
+
+static PyObject *         GMPy_XMPZ_Mmap(PyObject *self, PyObject *args);
+static PyObject *         GMPy_XMPZ_Method_Save(PyObject *self, PyObject *other);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
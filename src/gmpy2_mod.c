@@ -80,10 +80,9 @@ GMPy_Integer_Mod(PyObject *x, PyObject *y, CTXT_Object *context)
             }
             else {
                 mpz_t tempz;
-                mpz_inoc(tempz);
-                mpz_set_PyIntOrLong(tempz, y);
+                mpz_inoc_pylong(tempz, y);
                 mpz_fdiv_r(result->z, MPZ(x), tempz);
-                mpz_cloc(tempz);
+                mpz_cloc_pylong(tempz);
             }
             return (PyObject*)result;
         }
@@ -108,10 +107,9 @@ GMPy_Integer_Mod(PyObject *x, PyObject *y, CTXT_Object *context)
         
         if (PyIntOrLong_Check(x)) {
             mpz_t tempz;
-            mpz_inoc(tempz);
-            mpz_set_PyIntOrLong(tempz, x);
+            mpz_inoc_pylong(tempz, x);
             mpz_fdiv_r(result->z, tempz, MPZ(y));
-            mpz_cloc(tempz);
+            mpz_cloc_pylong(tempz);
             return (PyObject*)result;
         }
     }
@@ -145,19 +143,27 @@ GMPy_Integer_Mod(PyObject *x, PyObject *y, CTXT_Object *context)
     Py_RETURN_NOTIMPLEMENTED;
 }
 
+GMPY_PROFILE_WRAP(PyObject *, GMPy_MPZ_Mod_Slot, (PyObject *x, PyObject *y),
+                  (x, y), gmpy_profile_bits2(x, y))
+
 static PyObject *
-GMPy_MPZ_Mod_Slot(PyObject *x, PyObject *y)
+GMPy_MPZ_Mod_Slot_Impl(PyObject *x, PyObject *y)
 {
-    if (IS_INTEGER(x) && IS_INTEGER(y))
+    int xtype, ytype;
+
+    xtype = GMPy_ObjectType(x);
+    ytype = GMPy_ObjectType(y);
+
+    if (IS_TYPE_INTEGER(xtype) && IS_TYPE_INTEGER(ytype))
         return GMPy_Integer_Mod(x, y, NULL);
 
-    if (IS_RATIONAL(x) && IS_RATIONAL(y))
+    if (IS_TYPE_RATIONAL(xtype) && IS_TYPE_RATIONAL(ytype))
         return GMPy_Rational_Mod(x, y, NULL);
 
-    if (IS_REAL(x) && IS_REAL(y))
+    if (IS_TYPE_REAL(xtype) && IS_TYPE_REAL(ytype))
         return GMPy_Real_Mod(x, y, NULL);
 
-    if (IS_COMPLEX(x) && IS_COMPLEX(y))
+    if (IS_TYPE_COMPLEX(xtype) && IS_TYPE_COMPLEX(ytype))
         return GMPy_Complex_Mod(x, y, NULL);
 
     Py_RETURN_NOTIMPLEMENTED;
@@ -209,16 +215,24 @@ GMPy_Rational_Mod(PyObject *x, PyObject *y, CTXT_Object *context)
     return NULL;
 }
 
+GMPY_PROFILE_WRAP(PyObject *, GMPy_MPQ_Mod_Slot, (PyObject *x, PyObject *y),
+                  (x, y), gmpy_profile_bits2(x, y))
+
 static PyObject *
-GMPy_MPQ_Mod_Slot(PyObject *x, PyObject *y)
+GMPy_MPQ_Mod_Slot_Impl(PyObject *x, PyObject *y)
 {
-    if (IS_RATIONAL(x) && IS_RATIONAL(y))
+    int xtype, ytype;
+
+    xtype = GMPy_ObjectType(x);
+    ytype = GMPy_ObjectType(y);
+
+    if (IS_TYPE_RATIONAL(xtype) && IS_TYPE_RATIONAL(ytype))
         return GMPy_Rational_Mod(x, y, NULL);
 
-    if (IS_REAL(x) && IS_REAL(y))
+    if (IS_TYPE_REAL(xtype) && IS_TYPE_REAL(ytype))
         return GMPy_Real_Mod(x, y, NULL);
 
-    if (IS_COMPLEX(x) && IS_COMPLEX(y))
+    if (IS_TYPE_COMPLEX(xtype) && IS_TYPE_COMPLEX(ytype))
         return GMPy_Complex_Mod(x, y, NULL);
 
     Py_RETURN_NOTIMPLEMENTED;
@@ -247,7 +261,7 @@ GMPy_Real_Mod(PyObject *x, PyObject *y, CTXT_Object *context)
             goto error;
         }
         if (mpfr_zero_p(tempy->f)) {
-            context->ctx.divzero = 1;
+            GMPY_FLAGS(context)->divzero = 1;
             if (context->ctx.traps & TRAP_DIVZERO) {
                 GMPY_DIVZERO("mod() modulo by zero");
                 goto error;
@@ -255,7 +269,7 @@ GMPy_Real_Mod(PyObject *x, PyObject *y, CTXT_Object *context)
         }
 
         if (mpfr_nan_p(tempx->f) || mpfr_nan_p(tempy->f) || mpfr_inf_p(tempx->f)) {
-            context->ctx.invalid = 1;
+            GMPY_FLAGS(context)->invalid = 1;
             if (context->ctx.traps & TRAP_INVALID) {
                 GMPY_INVALID("mod() invalid operation");
                 goto error;
@@ -265,7 +279,7 @@ GMPy_Real_Mod(PyObject *x, PyObject *y, CTXT_Object *context)
             }
         }
         else if (mpfr_inf_p(tempy->f)) {
-            context->ctx.invalid = 1;
+            GMPY_FLAGS(context)->invalid = 1;
             if (context->ctx.traps & TRAP_INVALID) {
                 GMPY_INVALID("mod() invalid operation");
                 goto error;
@@ -312,13 +326,21 @@ GMPy_Real_Mod(PyObject *x, PyObject *y, CTXT_Object *context)
     return NULL;
 }
 
+GMPY_PROFILE_WRAP(PyObject *, GMPy_MPFR_Mod_Slot, (PyObject *x, PyObject *y),
+                  (x, y), gmpy_profile_bits2(x, y))
+
 static PyObject *
-GMPy_MPFR_Mod_Slot(PyObject *x, PyObject *y)
+GMPy_MPFR_Mod_Slot_Impl(PyObject *x, PyObject *y)
 {
-    if (IS_REAL(x) && IS_REAL(y))
+    int xtype, ytype;
+
+    xtype = GMPy_ObjectType(x);
+    ytype = GMPy_ObjectType(y);
+
+    if (IS_TYPE_REAL(xtype) && IS_TYPE_REAL(ytype))
         return GMPy_Real_Mod(x, y, NULL);
 
-    if (IS_COMPLEX(x) && IS_COMPLEX(y))
+    if (IS_TYPE_COMPLEX(xtype) && IS_TYPE_COMPLEX(ytype))
         return GMPy_Complex_Mod(x, y, NULL);
 
     Py_RETURN_NOTIMPLEMENTED;
@@ -331,8 +353,11 @@ GMPy_Complex_Mod(PyObject *x, PyObject *y, CTXT_Object *context)
     return NULL;
 }
 
+GMPY_PROFILE_WRAP(PyObject *, GMPy_MPC_Mod_Slot, (PyObject *x, PyObject *y),
+                  (x, y), gmpy_profile_bits2(x, y))
+
 static PyObject *
-GMPy_MPC_Mod_Slot(PyObject *x, PyObject *y)
+GMPy_MPC_Mod_Slot_Impl(PyObject *x, PyObject *y)
 {
     return GMPy_Complex_Mod(x, y, NULL);
 }
@@ -343,19 +368,27 @@ PyDoc_STRVAR(GMPy_doc_mod,
 "Note: overflow, underflow, and inexact exceptions are not supported for\n"
 "mpfr arguments to mod().");
 
+GMPY_PROFILE_WRAP(PyObject *, GMPy_Number_Mod, (PyObject *x, PyObject *y, CTXT_Object *context),
+                  (x, y, context), gmpy_profile_bits2(x, y))
+
 static PyObject *
-GMPy_Number_Mod(PyObject *x, PyObject *y, CTXT_Object *context)
+GMPy_Number_Mod_Impl(PyObject *x, PyObject *y, CTXT_Object *context)
 {
-    if (IS_INTEGER(x) && IS_INTEGER(y))
+    int xtype, ytype;
+
+    xtype = GMPy_ObjectType(x);
+    ytype = GMPy_ObjectType(y);
+
+    if (IS_TYPE_INTEGER(xtype) && IS_TYPE_INTEGER(ytype))
         return GMPy_Integer_Mod(x, y, context);
 
-    if (IS_RATIONAL(x) && IS_RATIONAL(y))
+    if (IS_TYPE_RATIONAL(xtype) && IS_TYPE_RATIONAL(ytype))
         return GMPy_Rational_Mod(x, y, context);
 
-    if (IS_REAL(x) && IS_REAL(y))
+    if (IS_TYPE_REAL(xtype) && IS_TYPE_REAL(ytype))
         return GMPy_Real_Mod(x, y, context);
 
-    if (IS_COMPLEX(x) && IS_COMPLEX(y))
+    if (IS_TYPE_COMPLEX(xtype) && IS_TYPE_COMPLEX(ytype))
         return GMPy_Complex_Mod(x, y, context);
 
     TYPE_ERROR("mod() argument type not supported");
@@ -369,11 +402,11 @@ PyDoc_STRVAR(GMPy_doc_context_mod,
 "mpfr arguments to context.mod().");
 
 static PyObject *
-GMPy_Context_Mod(PyObject *self, PyObject *args)
+GMPy_Context_Mod(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     CTXT_Object *context = NULL;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (nargs != 2) {
         TYPE_ERROR("mod() requires 2 arguments");
         return NULL;
     }
@@ -385,6 +418,7 @@ GMPy_Context_Mod(PyObject *self, PyObject *args)
         CHECK_CONTEXT(context);
     }
 
-    return GMPy_Number_Mod(PyTuple_GET_ITEM(args, 0), PyTuple_GET_ITEM(args, 1), context);
+    return GMPy_Number_Mod(args[0], args[1], context);
 }
+GMPY_FASTCALL_WRAPPER(GMPy_Context_Mod)
 
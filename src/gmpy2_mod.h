@@ -48,7 +48,7 @@ static PyObject * GMPy_MPQ_Mod_Slot(PyObject *x, PyObject *y);
 static PyObject * GMPy_MPFR_Mod_Slot(PyObject *x, PyObject *y);
 static PyObject * GMPy_MPC_Mod_Slot(PyObject *x, PyObject *y);
 
-static PyObject * GMPy_Context_Mod(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_Mod(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 
 #ifdef __cplusplus
 }
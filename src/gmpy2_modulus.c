@@ -0,0 +1,488 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_modulus.c                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+/* This file implements the Modulus type, which performs modular arithmetic
+ * for a fixed modulus m > 0.
+ *
+ * The modulus is converted once and the result of each operation is
+ * reduced into a new mpz with 0 <= r < m, so mul(a, b) costs one
+ * multiplication and one reduction instead of two operations and an
+ * intermediate object. For moduli of at least get_tuning()['barrett_bits']
+ * bits (MODULUS_BARRETT_BITS unless it is tuned) the
+ * reduction of a product uses Barrett's method with the precomputed value
+ * mu = floor(4**k / m), where k is the number of bits of m:
+ *
+ *     q = ((x >> (k - 1)) * mu) >> (k + 1)
+ *     r = x - q * m,  then subtract m at most twice
+ *
+ * which replaces a division by two multiplications. Smaller moduli, and
+ * values outside 0 <= x < 4**k, use mpz_mod(). mpz_powm() already uses
+ * Montgomery reduction internally for odd moduli.
+ */
+
+/* Set r to x mod m. r and x may be the same; q is used as a temporary.
+ * The helpers below don't touch the object caches, so they can be used
+ * without the GIL. */
+
+static void
+modulus_reduce(Modulus_Object *self, mpz_ptr r, mpz_srcptr x, mpz_ptr q)
+{
+    if (!self->barrett || mpz_sgn(x) < 0 ||
+        mpz_sizeinbase(x, 2) > 2 * self->bits) {
+        mpz_mod(r, x, self->m);
+        return;
+    }
+
+    mpz_tdiv_q_2exp(q, x, self->bits - 1);
+    mpz_mul(q, q, self->mu);
+    mpz_tdiv_q_2exp(q, q, self->bits + 1);
+    if (r != x)
+        mpz_set(r, x);
+    mpz_submul(r, q, self->m);
+    while (mpz_cmp(r, self->m) >= 0)
+        mpz_sub(r, r, self->m);
+}
+
+/* Reduce r, which is usually already close to 0 <= r < m. */
+
+static void
+modulus_adjust(Modulus_Object *self, mpz_ptr r, mpz_ptr q)
+{
+    if (mpz_sgn(r) < 0) {
+        mpz_add(r, r, self->m);
+        if (mpz_sgn(r) >= 0)
+            return;
+    }
+    else if (mpz_cmp(r, self->m) >= 0) {
+        mpz_sub(r, r, self->m);
+        if (mpz_cmp(r, self->m) < 0)
+            return;
+    }
+    else {
+        return;
+    }
+    modulus_reduce(self, r, r, q);
+}
+
+/* Set r to a**e mod m. Returns 0 if e < 0 and a is not invertible. */
+
+static int
+modulus_pow(Modulus_Object *self, mpz_ptr r, mpz_srcptr a, mpz_srcptr e, mpz_ptr inv)
+{
+    if (mpz_sgn(e) >= 0) {
+        mpz_powm(r, a, e, self->m);
+        return 1;
+    }
+
+    if (!mpz_invert(inv, a, self->m))
+        return 0;
+    mpz_neg(r, e);
+    mpz_powm(r, inv, r, self->m);
+    return 1;
+}
+
+PyDoc_STRVAR(GMPy_doc_modulus_factory,
+"Modulus(m) -> Modulus\n\n"
+"Return an object that performs arithmetic modulo the positive integer\n"
+"m. The modulus is converted, and its reduction constants computed, only\n"
+"once; all results are mpz in the range 0 <= r < m.");
+
+static PyObject *
+GMPy_Modulus_Factory(PyObject *self, PyObject *other)
+{
+    Modulus_Object *result;
+    MPZ_Object *tempm;
+
+    if (!IS_INTEGER(other)) {
+        TYPE_ERROR("Modulus() requires an integer argument");
+        return NULL;
+    }
+    if (!(tempm = GMPy_MPZ_From_Integer(other, NULL)))
+        return NULL;
+    if (mpz_sgn(tempm->z) <= 0) {
+        VALUE_ERROR("Modulus() requires a positive modulus");
+        Py_DECREF((PyObject*)tempm);
+        return NULL;
+    }
+
+    if (!(result = PyObject_New(Modulus_Object, &Modulus_Type))) {
+        Py_DECREF((PyObject*)tempm);
+        return NULL;
+    }
+    mpz_init_set(result->m, tempm->z);
+    mpz_init(result->mu);
+    Py_DECREF((PyObject*)tempm);
+
+    result->bits = mpz_sizeinbase(result->m, 2);
+    result->barrett = result->bits >= global.barrett_bits;
+    if (result->barrett) {
+        mpz_setbit(result->mu, 2 * result->bits);
+        mpz_fdiv_q(result->mu, result->mu, result->m);
+    }
+    return (PyObject*)result;
+}
+
+static void
+GMPy_Modulus_Dealloc(Modulus_Object *self)
+{
+    mpz_clear(self->m);
+    mpz_clear(self->mu);
+    PyObject_Del(self);
+}
+
+static PyObject *
+GMPy_Modulus_Repr_Slot(Modulus_Object *self)
+{
+    return Py2or3String_FromFormat("<Modulus of %zu bits>", (size_t)self->bits);
+}
+
+static PyObject *
+GMPy_Modulus_GetModulus(Modulus_Object *self, void *closure)
+{
+    MPZ_Object *result;
+
+    if ((result = GMPy_MPZ_New(NULL)))
+        mpz_set(result->z, self->m);
+    return (PyObject*)result;
+}
+
+/* Operations on one or two integer arguments. */
+
+#define MODULUS_REDUCE 0
+#define MODULUS_SQR    1
+#define MODULUS_INV    2
+#define MODULUS_MUL    3
+#define MODULUS_ADD    4
+#define MODULUS_SUB    5
+#define MODULUS_POW    6
+
+static PyObject *
+modulus_apply(Modulus_Object *self, PyObject *x, PyObject *y, int op, const char *msg)
+{
+    MPZ_Object *result = NULL, *tempx = NULL, *tempy = NULL;
+    mpz_ptr zx, zy = NULL;
+    mpz_t temp;
+
+    if (!IS_INTEGER(x) || (y && !IS_INTEGER(y))) {
+        TYPE_ERROR(msg);
+        return NULL;
+    }
+    if (fused_integer_arg(x, &zx, &tempx, NULL) < 0 ||
+        (y && fused_integer_arg(y, &zy, &tempy, NULL) < 0) ||
+        !(result = GMPy_MPZ_New(NULL)))
+        goto done;
+
+    mpz_inoc(temp);
+    switch (op) {
+    case MODULUS_REDUCE:
+        modulus_reduce(self, result->z, zx, temp);
+        break;
+    case MODULUS_SQR:
+        mpz_mul(result->z, zx, zx);
+        modulus_reduce(self, result->z, result->z, temp);
+        break;
+    case MODULUS_INV:
+        if (!mpz_invert(result->z, zx, self->m)) {
+            ZERO_ERROR("Modulus.inv() no inverse exists");
+            Py_CLEAR(result);
+        }
+        break;
+    case MODULUS_MUL:
+        mpz_mul(result->z, zx, zy);
+        modulus_reduce(self, result->z, result->z, temp);
+        break;
+    case MODULUS_ADD:
+        mpz_add(result->z, zx, zy);
+        modulus_adjust(self, result->z, temp);
+        break;
+    case MODULUS_SUB:
+        mpz_sub(result->z, zx, zy);
+        modulus_adjust(self, result->z, temp);
+        break;
+    case MODULUS_POW:
+        if (!modulus_pow(self, result->z, zx, zy, temp)) {
+            VALUE_ERROR("Modulus.pow() base not invertible");
+            Py_CLEAR(result);
+        }
+        break;
+    }
+    mpz_cloc(temp);
+
+  done:
+    Py_XDECREF((PyObject*)tempx);
+    Py_XDECREF((PyObject*)tempy);
+    return (PyObject*)result;
+}
+
+static PyObject *
+modulus_apply2(PyObject *self, PyObject *args, int op, const char *msg)
+{
+    if (PyTuple_GET_SIZE(args) != 2) {
+        TYPE_ERROR(msg);
+        return NULL;
+    }
+    return modulus_apply((Modulus_Object*)self, PyTuple_GET_ITEM(args, 0),
+                         PyTuple_GET_ITEM(args, 1), op, msg);
+}
+
+PyDoc_STRVAR(GMPy_doc_modulus_reduce,
+"M.reduce(x) -> mpz\n\n"
+"Return x mod M.modulus.");
+
+static PyObject *
+GMPy_Modulus_Reduce(PyObject *self, PyObject *other)
+{
+    return modulus_apply((Modulus_Object*)self, other, NULL, MODULUS_REDUCE,
+                         "reduce() requires an integer argument");
+}
+
+PyDoc_STRVAR(GMPy_doc_modulus_sqr,
+"M.sqr(x) -> mpz\n\n"
+"Return x*x mod M.modulus.");
+
+static PyObject *
+GMPy_Modulus_Sqr(PyObject *self, PyObject *other)
+{
+    return modulus_apply((Modulus_Object*)self, other, NULL, MODULUS_SQR,
+                         "sqr() requires an integer argument");
+}
+
+PyDoc_STRVAR(GMPy_doc_modulus_inv,
+"M.inv(x) -> mpz\n\n"
+"Return the inverse of x modulo M.modulus. Raises ZeroDivisionError if\n"
+"x has no inverse.");
+
+static PyObject *
+GMPy_Modulus_Inv(PyObject *self, PyObject *other)
+{
+    return modulus_apply((Modulus_Object*)self, other, NULL, MODULUS_INV,
+                         "inv() requires an integer argument");
+}
+
+PyDoc_STRVAR(GMPy_doc_modulus_mul,
+"M.mul(x, y) -> mpz\n\n"
+"Return x*y mod M.modulus.");
+
+static PyObject *
+GMPy_Modulus_Mul(PyObject *self, PyObject *args)
+{
+    return modulus_apply2(self, args, MODULUS_MUL, "mul() requires 'int','int' arguments");
+}
+
+PyDoc_STRVAR(GMPy_doc_modulus_add,
+"M.add(x, y) -> mpz\n\n"
+"Return (x + y) mod M.modulus.");
+
+static PyObject *
+GMPy_Modulus_Add(PyObject *self, PyObject *args)
+{
+    return modulus_apply2(self, args, MODULUS_ADD, "add() requires 'int','int' arguments");
+}
+
+PyDoc_STRVAR(GMPy_doc_modulus_sub,
+"M.sub(x, y) -> mpz\n\n"
+"Return (x - y) mod M.modulus.");
+
+static PyObject *
+GMPy_Modulus_Sub(PyObject *self, PyObject *args)
+{
+    return modulus_apply2(self, args, MODULUS_SUB, "sub() requires 'int','int' arguments");
+}
+
+PyDoc_STRVAR(GMPy_doc_modulus_pow,
+"M.pow(x, e) -> mpz\n\n"
+"Return x**e mod M.modulus. A negative e requires x to be invertible.");
+
+static PyObject *
+GMPy_Modulus_Pow(PyObject *self, PyObject *args)
+{
+    return modulus_apply2(self, args, MODULUS_POW, "pow() requires 'int','int' arguments");
+}
+
+/* The batch variants convert all the arguments first and then do the
+ * arithmetic without the GIL. y is either a sequence with the same length
+ * as x or a single integer that is used with every item of x.
+ */
+
+static PyObject *
+modulus_apply_many(Modulus_Object *self, PyObject *args, int op, const char *msg)
+{
+    PyObject *result = NULL;
+    MPZ_Object **xs = NULL, **ys = NULL, *y = NULL;
+    Py_ssize_t i, nx = 0, ny = 0;
+    size_t bits = 0;
+    int invalid = 0;
+    PyObject *temp;
+    mpz_t q;
+    mpz_ptr r;
+
+    if (PyTuple_GET_SIZE(args) != 2) {
+        TYPE_ERROR(msg);
+        return NULL;
+    }
+
+    if (!(xs = GMPy_MPZ_Array_From_Iterable(PyTuple_GET_ITEM(args, 0), &nx, msg, NULL)))
+        return NULL;
+    if (IS_INTEGER(PyTuple_GET_ITEM(args, 1))) {
+        if (!(y = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL)))
+            goto done;
+    }
+    else {
+        if (!(ys = GMPy_MPZ_Array_From_Iterable(PyTuple_GET_ITEM(args, 1), &ny, msg, NULL)))
+            goto done;
+        if (nx != ny) {
+            VALUE_ERROR("requires sequences of the same length");
+            goto done;
+        }
+    }
+
+    if (!(result = PyList_New(nx)))
+        goto done;
+    for (i = 0; i < nx; i++) {
+        if (!(temp = (PyObject*)GMPy_MPZ_New(NULL))) {
+            Py_CLEAR(result);
+            goto done;
+        }
+        PyList_SET_ITEM(result, i, temp);
+    }
+
+    bits = (size_t)nx * self->bits;
+    if (op == MODULUS_POW)
+        bits *= y ? mpz_sizeinbase(y->z, 2) : self->bits;
+
+    GMPY_BEGIN_NOGIL(bits);
+    mpz_init(q);
+    for (i = 0; i < nx; i++) {
+        r = MPZ(PyList_GET_ITEM(result, i));
+        if (op == MODULUS_MUL) {
+            mpz_mul(r, xs[i]->z, y ? y->z : ys[i]->z);
+            modulus_reduce(self, r, r, q);
+        }
+        else if (!modulus_pow(self, r, xs[i]->z, y ? y->z : ys[i]->z, q)) {
+            invalid = 1;
+            break;
+        }
+    }
+    mpz_clear(q);
+    GMPY_END_NOGIL;
+
+    if (invalid) {
+        VALUE_ERROR("Modulus.pow_many() base not invertible");
+        Py_CLEAR(result);
+    }
+
+  done:
+    GMPy_MPZ_Array_Free(xs, nx);
+    if (ys)
+        GMPy_MPZ_Array_Free(ys, ny);
+    Py_XDECREF((PyObject*)y);
+    return result;
+}
+
+PyDoc_STRVAR(GMPy_doc_modulus_mul_many,
+"M.mul_many(xs, ys) -> list\n\n"
+"Return [x*y mod M.modulus for x, y in zip(xs, ys)]. ys may also be a\n"
+"single integer that multiplies every item of xs.");
+
+static PyObject *
+GMPy_Modulus_MulMany(PyObject *self, PyObject *args)
+{
+    return modulus_apply_many((Modulus_Object*)self, args, MODULUS_MUL,
+                              "mul_many() requires sequences of integers");
+}
+
+PyDoc_STRVAR(GMPy_doc_modulus_pow_many,
+"M.pow_many(xs, es) -> list\n\n"
+"Return [x**e mod M.modulus for x, e in zip(xs, es)]. es may also be a\n"
+"single exponent that is used for every item of xs.");
+
+static PyObject *
+GMPy_Modulus_PowMany(PyObject *self, PyObject *args)
+{
+    return modulus_apply_many((Modulus_Object*)self, args, MODULUS_POW,
+                              "pow_many() requires sequences of integers");
+}
+
+static PyGetSetDef GMPy_Modulus_getseters[] =
+{
+    { "modulus", (getter)GMPy_Modulus_GetModulus, NULL, "the modulus", NULL },
+    {NULL}
+};
+
+static PyMethodDef GMPy_Modulus_methods[] =
+{
+    { "add", GMPy_Modulus_Add, METH_VARARGS, GMPy_doc_modulus_add },
+    { "inv", GMPy_Modulus_Inv, METH_O, GMPy_doc_modulus_inv },
+    { "mul", GMPy_Modulus_Mul, METH_VARARGS, GMPy_doc_modulus_mul },
+    { "mul_many", GMPy_Modulus_MulMany, METH_VARARGS, GMPy_doc_modulus_mul_many },
+    { "pow", GMPy_Modulus_Pow, METH_VARARGS, GMPy_doc_modulus_pow },
+    { "pow_many", GMPy_Modulus_PowMany, METH_VARARGS, GMPy_doc_modulus_pow_many },
+    { "reduce", GMPy_Modulus_Reduce, METH_O, GMPy_doc_modulus_reduce },
+    { "sqr", GMPy_Modulus_Sqr, METH_O, GMPy_doc_modulus_sqr },
+    { "sub", GMPy_Modulus_Sub, METH_VARARGS, GMPy_doc_modulus_sub },
+    { NULL, NULL, 1 }
+};
+
+static PyTypeObject Modulus_Type =
+{
+#ifdef PY3
+    PyVarObject_HEAD_INIT(0, 0)
+#else
+    PyObject_HEAD_INIT(0)
+        0,                                   /* ob_size          */
+#endif
+    "gmpy2 Modulus",                         /* tp_name          */
+    sizeof(Modulus_Object),                  /* tp_basicsize     */
+        0,                                   /* tp_itemsize      */
+    (destructor) GMPy_Modulus_Dealloc,       /* tp_dealloc       */
+        0,                                   /* tp_print         */
+        0,                                   /* tp_getattr       */
+        0,                                   /* tp_setattr       */
+        0,                                   /* tp_reserved      */
+    (reprfunc) GMPy_Modulus_Repr_Slot,       /* tp_repr          */
+        0,                                   /* tp_as_number     */
+        0,                                   /* tp_as_sequence   */
+        0,                                   /* tp_as_mapping    */
+        0,                                   /* tp_hash          */
+        0,                                   /* tp_call          */
+        0,                                   /* tp_str           */
+        0,                                   /* tp_getattro      */
+        0,                                   /* tp_setattro      */
+        0,                                   /* tp_as_buffer     */
+    Py_TPFLAGS_DEFAULT,                      /* tp_flags         */
+    "GMPY2 modulus",                         /* tp_doc           */
+        0,                                   /* tp_traverse      */
+        0,                                   /* tp_clear         */
+        0,                                   /* tp_richcompare   */
+        0,                                   /* tp_weaklistoffset*/
+        0,                                   /* tp_iter          */
+        0,                                   /* tp_iternext      */
+    GMPy_Modulus_methods,                    /* tp_methods       */
+        0,                                   /* tp_members       */
+    GMPy_Modulus_getseters,                  /* tp_getset        */
+};
@@ -0,0 +1,71 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_modulus.h                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+#ifndef GMPY_MODULUS_H
+#define GMPY_MODULUS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* A Modulus performs modular arithmetic for a fixed modulus m > 0. */
+
+typedef struct {
+    PyObject_HEAD
+    mpz_t m;                        /* the modulus */
+    mpz_t mu;                       /* floor(4**bits / m), if barrett */
+    mp_bitcnt_t bits;               /* number of bits of m */
+    int barrett;                    /* use Barrett reduction */
+} Modulus_Object;
+
+static PyTypeObject Modulus_Type;
+
+/* Default size of the moduli that use Barrett reduction; see
+ * gmpy2_modulus.c and get_tuning(). */
+#define MODULUS_BARRETT_BITS 2048
+
+#define Modulus_Check(v) (((PyObject*)v)->ob_type == &Modulus_Type)
+
+static PyObject * GMPy_Modulus_Factory(PyObject *self, PyObject *other);
+static void       GMPy_Modulus_Dealloc(Modulus_Object *self);
+static PyObject * GMPy_Modulus_Repr_Slot(Modulus_Object *self);
+static PyObject * GMPy_Modulus_GetModulus(Modulus_Object *self, void *closure);
+static PyObject * GMPy_Modulus_Reduce(PyObject *self, PyObject *other);
+static PyObject * GMPy_Modulus_Sqr(PyObject *self, PyObject *other);
+static PyObject * GMPy_Modulus_Inv(PyObject *self, PyObject *other);
+static PyObject * GMPy_Modulus_Mul(PyObject *self, PyObject *args);
+static PyObject * GMPy_Modulus_Add(PyObject *self, PyObject *args);
+static PyObject * GMPy_Modulus_Sub(PyObject *self, PyObject *args);
+static PyObject * GMPy_Modulus_Pow(PyObject *self, PyObject *args);
+static PyObject * GMPy_Modulus_MulMany(PyObject *self, PyObject *args);
+static PyObject * GMPy_Modulus_PowMany(PyObject *self, PyObject *args);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
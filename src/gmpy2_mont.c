@@ -0,0 +1,133 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_mont.c                                                            *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+/* This file implements Montgomery multiplication with the public mpn
+ * functions. It is shared by powmod_prod() and the Lucas sequence
+ * functions, which keep their operands in Montgomery form for a whole
+ * ladder instead of reducing each product with mpz_mod().
+ *
+ * mont_redc(), mont_mul(), mont_add(), mont_sub() and mont_copy() work in
+ * the space given to mont_init() and never allocate memory. mont_from_mpz()
+ * and mont_to_mpz() may grow their mpz arguments through GMP. All of them
+ * can be used without holding the GIL.
+ */
+
+static void
+mont_init(gmpy_mont *M, mpz_srcptr m, mp_ptr tp)
+{
+    mp_limb_t m0 = mpz_getlimbn(m, 0), inv = m0;
+    int i;
+
+    /* m0 * m0 == 1 mod 8, and each Newton step doubles the correct bits. */
+    for (i = 0; i < 6; i++)
+        inv *= 2 - m0 * inv;
+
+    M->mz = m;
+    M->m = m->_mp_d;
+    M->n = mpz_size(m);
+    M->minv = -inv;
+    M->tp = tp;
+}
+
+/* Set rp to tp / B**n mod m, where M->tp holds a 2n limb value less than
+ * m * B**n. M->tp is overwritten. */
+
+static void
+mont_redc(const gmpy_mont *M, mp_ptr rp)
+{
+    mp_ptr tp = M->tp;
+    mp_size_t j, n = M->n;
+
+    for (j = 0; j < n; j++)
+        tp[j] = mpn_addmul_1(tp + j, M->m, n, tp[j] * M->minv);
+    if (mpn_add_n(rp, tp + n, tp, n) || mpn_cmp(rp, M->m, n) >= 0)
+        mpn_sub_n(rp, rp, M->m, n);
+}
+
+static void
+mont_mul(const gmpy_mont *M, mp_ptr rp, mp_srcptr ap, mp_srcptr bp)
+{
+    if (ap == bp)
+        mpn_sqr(M->tp, ap, M->n);
+    else
+        mpn_mul_n(M->tp, ap, bp, M->n);
+    mont_redc(M, rp);
+}
+
+static void
+mont_add(const gmpy_mont *M, mp_ptr rp, mp_srcptr ap, mp_srcptr bp)
+{
+    if (mpn_add_n(rp, ap, bp, M->n) || mpn_cmp(rp, M->m, M->n) >= 0)
+        mpn_sub_n(rp, rp, M->m, M->n);
+}
+
+static void
+mont_sub(const gmpy_mont *M, mp_ptr rp, mp_srcptr ap, mp_srcptr bp)
+{
+    if (mpn_sub_n(rp, ap, bp, M->n))
+        mpn_add_n(rp, rp, M->m, M->n);
+}
+
+static void
+mont_copy(const gmpy_mont *M, mp_ptr rp, mp_srcptr ap)
+{
+    mp_size_t j;
+
+    for (j = 0; j < M->n; j++)
+        rp[j] = ap[j];
+}
+
+/* Convert x to Montgomery form. temp is scratch space. */
+
+static void
+mont_from_mpz(const gmpy_mont *M, mp_ptr rp, mpz_srcptr x, mpz_ptr temp)
+{
+    mp_size_t j;
+
+    mpz_mod(temp, x, M->mz);
+    mpz_mul_2exp(temp, temp, M->n * GMP_NUMB_BITS);
+    mpz_tdiv_r(temp, temp, M->mz);
+    for (j = 0; j < M->n; j++)
+        rp[j] = mpz_getlimbn(temp, j);
+}
+
+static void
+mont_to_mpz(const gmpy_mont *M, mpz_ptr r, mp_srcptr ap)
+{
+    mp_size_t j, n = M->n;
+
+    for (j = 0; j < n; j++) {
+        M->tp[j] = ap[j];
+        M->tp[n + j] = 0;
+    }
+    mpz_realloc2(r, n * GMP_NUMB_BITS);
+    mont_redc(M, r->_mp_d);
+    while (n > 0 && r->_mp_d[n - 1] == 0)
+        n--;
+    r->_mp_size = (int)n;
+}
@@ -0,0 +1,64 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_mont.h                                                            *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+#ifndef GMPY_MONT_H
+#define GMPY_MONT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Montgomery arithmetic modulo an odd m of n limbs. Residues are n-limb
+ * arrays in [0, m) that represent x * B**n mod m, where B = 2**GMP_NUMB_BITS.
+ * The caller supplies 2n limbs of scratch in tp.
+ */
+
+typedef struct {
+    mpz_srcptr mz;          /* the modulus */
+    mp_srcptr m;            /* limbs of the modulus */
+    mp_size_t n;            /* number of limbs in the modulus */
+    mp_limb_t minv;         /* -1/m mod B */
+    mp_ptr tp;              /* 2n limbs of scratch */
+} gmpy_mont;
+
+/* Moduli with more limbs are faster with mpz_mul and mpz_tdiv_r. */
+#define MONT_MAX_LIMBS 64
+
+static void mont_init(gmpy_mont *M, mpz_srcptr m, mp_ptr tp);
+static void mont_redc(const gmpy_mont *M, mp_ptr rp);
+static void mont_mul(const gmpy_mont *M, mp_ptr rp, mp_srcptr ap, mp_srcptr bp);
+static void mont_add(const gmpy_mont *M, mp_ptr rp, mp_srcptr ap, mp_srcptr bp);
+static void mont_sub(const gmpy_mont *M, mp_ptr rp, mp_srcptr ap, mp_srcptr bp);
+static void mont_copy(const gmpy_mont *M, mp_ptr rp, mp_srcptr ap);
+static void mont_from_mpz(const gmpy_mont *M, mp_ptr rp, mpz_srcptr x, mpz_ptr temp);
+static void mont_to_mpz(const gmpy_mont *M, mpz_ptr r, mp_srcptr ap);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -46,16 +46,8 @@ extern "C" {
 #  pragma comment(lib,"mpc.lib")
 #endif
 
-typedef struct {
-    PyObject_HEAD
-    mpc_t c;
-    Py_hash_t hash_cache;
-    int rc;
-} MPC_Object;
-
+/* MPC_Object, MPC() and MPC_Check() are defined in gmpy2_capi.h. */
 static PyTypeObject MPC_Type;
-#define MPC(obj) (((MPC_Object *)(obj))->c)
-#define MPC_Check(v) (((PyObject*)v)->ob_type == &MPC_Type)
 
 /*
  * Define macros for comparing with zero, checking if either component is
@@ -154,19 +146,19 @@ static PyTypeObject MPC_Type;
         rcr = MPC_INEX_RE(V->rc); \
         rci = MPC_INEX_IM(V->rc); \
         if (MPC_IS_NAN_P(V)) { \
-            CTX->ctx.invalid = 1; \
+            GMPY_FLAGS(CTX)->invalid = 1; \
             _invalid = 1; \
         } \
         if (V->rc) { \
-            CTX->ctx.inexact = 1; \
+            GMPY_FLAGS(CTX)->inexact = 1; \
             _inexact = 1; \
         } \
         if ((rcr && mpfr_zero_p(mpc_realref(V->c))) || (rci && mpfr_zero_p(mpc_imagref(V->c)))) { \
-            CTX->ctx.underflow = 1; \
+            GMPY_FLAGS(CTX)->underflow = 1; \
             _underflow = 1; \
         } \
         if ((rcr && mpfr_inf_p(mpc_realref(V->c))) || (rci && mpfr_inf_p(mpc_imagref(V->c)))) { \
-            CTX->ctx.overflow = 1; \
+            GMPY_FLAGS(CTX)->overflow = 1; \
             _overflow = 1; \
         } \
         if (CTX->ctx.traps) { \
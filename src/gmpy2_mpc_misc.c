@@ -262,11 +262,11 @@ GMPy_Number_Rect(PyObject *x, PyObject *y, CTXT_Object *context)
 }
 
 static PyObject *
-GMPy_Context_Rect(PyObject *self, PyObject *args)
+GMPy_Context_Rect(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     CTXT_Object *context = NULL;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (nargs != 2) {
         TYPE_ERROR("rect() requires 2 arguments");
         return NULL;
     }
@@ -278,8 +278,9 @@ GMPy_Context_Rect(PyObject *self, PyObject *args)
         CHECK_CONTEXT(context);
     }
 
-    return GMPy_Number_Rect(PyTuple_GET_ITEM(args, 0), PyTuple_GET_ITEM(args, 1), context);
+    return GMPy_Number_Rect(args[0], args[1], context);
 }
+GMPY_FASTCALL_WRAPPER(GMPy_Context_Rect)
 
 PyDoc_STRVAR(GMPy_doc_context_proj,
 "context.proj(x) -> mpc\n\n"
@@ -138,6 +138,33 @@ GMPy_MPFR_Factory(PyObject *self, PyObject *args, PyObject *keywds)
     return NULL;
 }
 
+#if PY_VERSION_HEX >= 0x03070000
+static PyObject *
+GMPy_MPFR_Factory_FastCall(PyObject *self, PyObject *const *args,
+                           Py_ssize_t nargs, PyObject *kwnames)
+{
+    CTXT_Object *context = NULL;
+
+    if (nargs == 1 && !kwnames) {
+        if (self && CTXT_Check(self)) {
+            context = (CTXT_Object*)self;
+        }
+        else {
+            CHECK_CONTEXT(context);
+        }
+
+        if (PyStrOrUnicode_Check(args[0])) {
+            return (PyObject*)GMPy_MPFR_From_PyStr(args[0], 10, 0, context);
+        }
+        if (IS_REAL(args[0])) {
+            return (PyObject*)GMPy_MPFR_From_Real(args[0], 0, context);
+        }
+    }
+
+    return GMPy_FastCall_Keywords(GMPy_MPFR_Factory, self, args, nargs, kwnames);
+}
+#endif
+
 #ifdef PY3
 static PyNumberMethods mpfr_number_methods =
 {
@@ -235,6 +262,9 @@ static PyMethodDef Pympfr_methods [] =
     { "__floor__", GMPy_MPFR_Method_Floor, METH_NOARGS, GMPy_doc_mpfr_floor_method },
     { "__format__", GMPy_MPFR_Format, METH_VARARGS, GMPy_doc_mpfr_format },
     { "__round__", GMPy_MPFR_Method_Round10, METH_VARARGS, GMPy_doc_method_round10 },
+#ifdef GMPY_PICKLE_BUFFER
+    { "__reduce_ex__", GMPy_MPANY_Reduce_Ex, METH_VARARGS, GMPy_doc_reduce_ex },
+#endif
     { "__sizeof__", GMPy_MPFR_SizeOf_Method, METH_NOARGS, GMPy_doc_mpfr_sizeof_method },
     { "__trunc__", GMPy_MPFR_Method_Trunc, METH_NOARGS, GMPy_doc_mpfr_trunc_method },
     { "as_integer_ratio", GMPy_MPFR_Integer_Ratio_Method, METH_NOARGS, GMPy_doc_method_integer_ratio },
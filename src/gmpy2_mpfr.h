@@ -50,16 +50,8 @@ extern "C" {
 #  pragma comment(lib,"mpfr.lib")
 #endif
 
-typedef struct {
-    PyObject_HEAD
-    mpfr_t f;
-    Py_hash_t hash_cache;
-    int rc;
-} MPFR_Object;
-
+/* MPFR_Object, MPFR() and MPFR_Check() are defined in gmpy2_capi.h. */
 static PyTypeObject MPFR_Type;
-#define MPFR(obj) (((MPFR_Object *)(obj))->f)
-#define MPFR_Check(v) (((PyObject*)v)->ob_type == &MPFR_Type)
 
 #define GMPY_DIVZERO(msg) PyErr_SetString(GMPyExc_DivZero, msg)
 #define GMPY_INEXACT(msg) PyErr_SetString(GMPyExc_Inexact, msg)
@@ -97,15 +89,85 @@ static PyTypeObject MPFR_Type;
         mpfr_set_emax(_oldemax); \
     }
 
+/* Use the widest possible exponent range for intermediate results that must
+ * not overflow or underflow. The range must be restored before any Python
+ * code can run.
+ */
+
+#define GMPY_MPFR_WIDEN_RANGE(EMIN, EMAX) \
+    EMIN = mpfr_get_emin(); \
+    EMAX = mpfr_get_emax(); \
+    mpfr_set_emin(mpfr_get_emin_min()); \
+    mpfr_set_emax(mpfr_get_emax_max());
+
+#define GMPY_MPFR_RESTORE_RANGE(EMIN, EMAX) \
+    mpfr_set_emin(EMIN); \
+    mpfr_set_emax(EMAX);
+
 /* Exceptions should be checked in order of least important to most important.
+ *
+ * With MPFR 4, the flags are read with a single call and nothing else is
+ * done when none of them is set, which is the usual case for an exact result
+ * or a context that nobody inspects.
  */
 
+#if MPFR_VERSION_MAJOR >= 4
+
+#define GMPY_MPFR_FLAGS \
+    (MPFR_FLAGS_UNDERFLOW | MPFR_FLAGS_OVERFLOW | MPFR_FLAGS_NAN | \
+     MPFR_FLAGS_INEXACT | MPFR_FLAGS_DIVBY0)
+
 #define GMPY_MPFR_EXCEPTIONS(V, CTX, NAME) \
-    CTX->ctx.underflow |= mpfr_underflow_p(); \
-    CTX->ctx.overflow |= mpfr_overflow_p(); \
-    CTX->ctx.invalid |= mpfr_nanflag_p(); \
-    CTX->ctx.inexact |= mpfr_inexflag_p(); \
-    CTX->ctx.divzero |= mpfr_divby0_p(); \
+    do { \
+        mpfr_flags_t _flags = mpfr_flags_save() & GMPY_MPFR_FLAGS; \
+        if (_flags) { \
+            gmpy_context *_ctxflags = GMPY_FLAGS(CTX); \
+            _ctxflags->underflow |= (_flags & MPFR_FLAGS_UNDERFLOW) != 0; \
+            _ctxflags->overflow |= (_flags & MPFR_FLAGS_OVERFLOW) != 0; \
+            _ctxflags->invalid |= (_flags & MPFR_FLAGS_NAN) != 0; \
+            _ctxflags->inexact |= (_flags & MPFR_FLAGS_INEXACT) != 0; \
+            _ctxflags->divzero |= (_flags & MPFR_FLAGS_DIVBY0) != 0; \
+            if (CTX->ctx.traps) { \
+                if ((CTX->ctx.traps & TRAP_UNDERFLOW) && (_flags & MPFR_FLAGS_UNDERFLOW)) { \
+                    GMPY_UNDERFLOW(NAME" underflow"); \
+                    Py_XDECREF((PyObject*)V); \
+                    V = NULL; \
+                } \
+                if ((CTX->ctx.traps & TRAP_OVERFLOW) && (_flags & MPFR_FLAGS_OVERFLOW)) { \
+                    GMPY_OVERFLOW(NAME" overflow"); \
+                    Py_XDECREF((PyObject*)V); \
+                    V = NULL; \
+                } \
+                if ((CTX->ctx.traps & TRAP_INEXACT) && (_flags & MPFR_FLAGS_INEXACT)) { \
+                    GMPY_INEXACT(NAME" inexact result"); \
+                    Py_XDECREF((PyObject*)V); \
+                    V = NULL; \
+                } \
+                if ((CTX->ctx.traps & TRAP_INVALID) && (_flags & MPFR_FLAGS_NAN)) { \
+                    GMPY_INVALID(NAME" invalid operation"); \
+                    Py_XDECREF((PyObject*)V); \
+                    V = NULL; \
+                } \
+                if ((CTX->ctx.traps & TRAP_DIVZERO) && (_flags & MPFR_FLAGS_DIVBY0)) { \
+                    GMPY_DIVZERO(NAME" division by zero"); \
+                    Py_XDECREF((PyObject*)V); \
+                    V = NULL; \
+                } \
+            } \
+        } \
+    } while (0)
+
+#else
+
+#define GMPY_MPFR_EXCEPTIONS(V, CTX, NAME) \
+    { \
+        gmpy_context *_ctxflags = GMPY_FLAGS(CTX); \
+        _ctxflags->underflow |= mpfr_underflow_p(); \
+        _ctxflags->overflow |= mpfr_overflow_p(); \
+        _ctxflags->invalid |= mpfr_nanflag_p(); \
+        _ctxflags->inexact |= mpfr_inexflag_p(); \
+        _ctxflags->divzero |= mpfr_divby0_p(); \
+    } \
     if (CTX->ctx.traps) { \
         if ((CTX->ctx.traps & TRAP_UNDERFLOW) && mpfr_underflow_p()) { \
             GMPY_UNDERFLOW(NAME" underflow"); \
@@ -134,13 +196,15 @@ static PyTypeObject MPFR_Type;
         } \
     }
 
+#endif
+
 #define GMPY_MPFR_CLEANUP(V, CTX, NAME) \
     GMPY_MPFR_CHECK_RANGE(V, CTX); \
     GMPY_MPFR_SUBNORMALIZE(V, CTX); \
     GMPY_MPFR_EXCEPTIONS(V, CTX, NAME); \
 
 #define GMPY_CHECK_ERANGE(V, CTX, MSG) \
-    CTX->ctx.erange |= mpfr_erangeflag_p(); \
+    GMPY_FLAGS(CTX)->erange |= mpfr_erangeflag_p(); \
     if (CTX->ctx.traps) { \
         if ((CTX->ctx.traps & TRAP_ERANGE) && mpfr_erangeflag_p()) { \
             GMPY_ERANGE(MSG); \
@@ -150,6 +214,10 @@ static PyTypeObject MPFR_Type;
     } \
 
 static PyObject * GMPy_MPFR_Factory(PyObject *self, PyObject *args, PyObject *keywds);
+#if PY_VERSION_HEX >= 0x03070000
+static PyObject * GMPy_MPFR_Factory_FastCall(PyObject *self, PyObject *const *args,
+                                             Py_ssize_t nargs, PyObject *kwnames);
+#endif
 
 #ifdef __cplusplus
 }
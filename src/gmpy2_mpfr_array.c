@@ -0,0 +1,1024 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_mpfr_array.c                                                      *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* The operations of an mpfr_array work directly on the elements and create
+ * no Python objects for them. Each element is rounded with the rounding
+ * mode of the current context and then has the exponent range and the
+ * subnormalization of the context applied, exactly like a single mpfr
+ * result. The flags of the context are updated, and its traps checked,
+ * once for the whole operation. Operations that release the GIL work on a
+ * copy of the elements of their operands.
+ */
+
+typedef int (*mpfrarr_unary_func)(mpfr_ptr, mpfr_srcptr, mpfr_rnd_t);
+typedef int (*mpfrarr_binary_func)(mpfr_ptr, mpfr_srcptr, mpfr_srcptr, mpfr_rnd_t);
+
+/* An element result in the form used by GMPY_MPFR_CHECK_RANGE and
+ * GMPY_MPFR_SUBNORMALIZE. */
+
+typedef struct {
+    mpfr_ptr f;
+    int rc;
+} mpfrarr_result;
+
+static void
+mpfrarr_cleanup(mpfr_ptr x, int rc, CTXT_Object *context)
+{
+    mpfrarr_result r, *v = &r;
+
+    r.f = x;
+    r.rc = rc;
+    GMPY_MPFR_CHECK_RANGE(v, context);
+    GMPY_MPFR_SUBNORMALIZE(v, context);
+}
+
+/* Return a new array of n zeros with precision prec. */
+
+static MPFRArray_Object *
+mpfrarr_alloc(Py_ssize_t n, mpfr_prec_t prec)
+{
+    MPFRArray_Object *result;
+    size_t sigsize = mpfr_custom_get_size(prec);
+    char *sig;
+    Py_ssize_t i;
+
+    if ((size_t)n > PY_SSIZE_T_MAX / (sizeof(__mpfr_struct) + sigsize)) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+    if (!(result = PyObject_New(MPFRArray_Object, &MPFRArray_Type)))
+        return NULL;
+    result->size = n;
+    result->step = 1;
+    result->prec = prec;
+    result->base = NULL;
+    if (!(result->data = GMPY_MALLOC(n ? n * (sizeof(__mpfr_struct) + sigsize) : 1))) {
+        Py_DECREF((PyObject*)result);
+        PyErr_NoMemory();
+        return NULL;
+    }
+
+    sig = (char*)(result->data + n);
+    for (i = 0; i < n; i++, sig += sigsize) {
+        mpfr_custom_init(sig, prec);
+        mpfr_custom_init_set(&result->data[i], MPFR_ZERO_KIND, 0, prec, sig);
+    }
+    return result;
+}
+
+/* Convert a precision argument, 0 meaning the precision of the context. A
+ * precision of 1 is not used since GMPy_MPFR_New() gives it a meaning of
+ * its own. */
+
+static int
+mpfrarr_prec(long prec, CTXT_Object *context, mpfr_prec_t *result)
+{
+    if (prec == 0)
+        prec = GET_MPFR_PREC(context);
+    if (prec < 2 || prec > MPFR_PREC_MAX) {
+        VALUE_ERROR("invalid value for precision");
+        return -1;
+    }
+    *result = (mpfr_prec_t)prec;
+    return 0;
+}
+
+/* Round the real number obj to the precision of x and store it in x. */
+
+static int
+mpfrarr_set(mpfr_ptr x, PyObject *obj, CTXT_Object *context)
+{
+    MPFR_Object *temp;
+
+    CHECK_CONTEXT(context);
+    if (!IS_REAL(obj)) {
+        TYPE_ERROR("mpfr_array elements must be real numbers");
+        return -1;
+    }
+    if (!(temp = GMPy_MPFR_From_Real(obj, mpfr_get_prec(x), context)))
+        return -1;
+    mpfr_set(x, temp->f, GET_MPFR_ROUND(context));
+    Py_DECREF((PyObject*)temp);
+    return 0;
+}
+
+/* An operand of an elementwise operation: an array, or a real number that
+ * is used for every element (step 0). */
+
+typedef struct {
+    __mpfr_struct *data;
+    Py_ssize_t step;
+    Py_ssize_t size;                /* -1 for a real number */
+    mpfr_prec_t prec;               /* 0 for a real number */
+    MPFR_Object *scalar;
+    MPFRArray_Object *copy;         /* private copy of the elements */
+} mpfrarr_operand;
+
+#define MPFRARR_OPERAND(o, i) (&(o)->data[(i) * (o)->step])
+
+/* Returns 1 on success, 0 if obj is neither an array nor a real number, and
+ * -1 after an error. */
+
+static int
+mpfrarr_operand_init(mpfrarr_operand *op, PyObject *obj, CTXT_Object *context)
+{
+    op->scalar = NULL;
+    op->copy = NULL;
+    if (MPFRArray_Check(obj)) {
+        op->data = ((MPFRArray_Object*)obj)->data;
+        op->step = ((MPFRArray_Object*)obj)->step;
+        op->size = ((MPFRArray_Object*)obj)->size;
+        op->prec = ((MPFRArray_Object*)obj)->prec;
+        return 1;
+    }
+    if (!IS_REAL(obj))
+        return 0;
+    if (!(op->scalar = GMPy_MPFR_From_Real(obj, 1, context)))
+        return -1;
+    op->data = op->scalar->f;
+    op->step = 0;
+    op->size = -1;
+    op->prec = 0;
+    return 1;
+}
+
+/* Other threads can assign to the elements of an array, or of a slice that
+ * shares them, and can sort it while an operation runs without the GIL.
+ * When the GIL will be released for 'bits', replace the elements of an
+ * array operand with a private copy of the first n. Call it before
+ * mpfr_clear_flags() since copying a NaN sets a flag. Returns -1 after an
+ * error. */
+
+static int
+mpfrarr_operand_copy(mpfrarr_operand *op, Py_ssize_t n, size_t bits)
+{
+    Py_ssize_t i;
+
+    if (op->size < 0 || !GMPY_NOGIL_WANTED_MPFR(bits))
+        return 0;
+    if (!(op->copy = mpfrarr_alloc(n, op->prec)))
+        return -1;
+    for (i = 0; i < n; i++)
+        mpfr_set(&op->copy->data[i], MPFRARR_OPERAND(op, i), MPFR_RNDN);
+    op->data = op->copy->data;
+    op->step = 1;
+    return 0;
+}
+
+static void
+mpfrarr_operand_clear(mpfrarr_operand *op)
+{
+    Py_XDECREF((PyObject*)op->scalar);
+    Py_XDECREF((PyObject*)op->copy);
+}
+
+static MPFRArray_Object *
+mpfrarr_unary(MPFRArray_Object *v, mpfrarr_unary_func func, CTXT_Object *context)
+{
+    MPFRArray_Object *result;
+    mpfrarr_operand op;
+    mpfr_rnd_t rnd = GET_MPFR_ROUND(context);
+    size_t bits = (size_t)v->prec * v->size;
+    Py_ssize_t i;
+
+    mpfrarr_operand_init(&op, (PyObject*)v, context);
+    if (mpfrarr_operand_copy(&op, v->size, bits) < 0)
+        return NULL;
+    if (!(result = mpfrarr_alloc(v->size, v->prec))) {
+        mpfrarr_operand_clear(&op);
+        return NULL;
+    }
+
+    mpfr_clear_flags();
+    GMPY_BEGIN_NOGIL_MPFR(bits);
+    for (i = 0; i < v->size; i++) {
+        mpfr_ptr r = &result->data[i];
+
+        mpfrarr_cleanup(r, func(r, MPFRARR_OPERAND(&op, i), rnd), context);
+    }
+    GMPY_END_NOGIL;
+    mpfrarr_operand_clear(&op);
+    return result;
+}
+
+/* MPFRARR_UNIOP(FUNC) creates the method a.FUNC() that returns the array of
+ * mpfr_FUNC() of the elements of a.
+ */
+
+#define MPFRARR_UNIOP(FUNC) \
+PyDoc_STRVAR(GMPy_doc_mpfr_array_##FUNC, \
+"a." #FUNC "() -> mpfr_array\n\n" \
+"Return the array of " #FUNC "(x) for the elements x of a."); \
+static PyObject * \
+GMPy_MPFRArray_Method_##FUNC(PyObject *self, PyObject *other) \
+{ \
+    MPFRArray_Object *result; \
+    CTXT_Object *context = NULL; \
+    CHECK_CONTEXT(context); \
+    if ((result = mpfrarr_unary((MPFRArray_Object*)self, mpfr_##FUNC, context))) { \
+        GMPY_MPFR_EXCEPTIONS(result, context, #FUNC "()"); \
+    } \
+    return (PyObject*)result; \
+}
+
+MPFRARR_UNIOP(acos)
+MPFRARR_UNIOP(acosh)
+MPFRARR_UNIOP(ai)
+MPFRARR_UNIOP(asin)
+MPFRARR_UNIOP(asinh)
+MPFRARR_UNIOP(atan)
+MPFRARR_UNIOP(atanh)
+MPFRARR_UNIOP(cbrt)
+MPFRARR_UNIOP(cos)
+MPFRARR_UNIOP(cosh)
+MPFRARR_UNIOP(cot)
+MPFRARR_UNIOP(coth)
+MPFRARR_UNIOP(csc)
+MPFRARR_UNIOP(csch)
+MPFRARR_UNIOP(digamma)
+MPFRARR_UNIOP(eint)
+MPFRARR_UNIOP(erf)
+MPFRARR_UNIOP(erfc)
+MPFRARR_UNIOP(exp)
+MPFRARR_UNIOP(exp10)
+MPFRARR_UNIOP(exp2)
+MPFRARR_UNIOP(expm1)
+MPFRARR_UNIOP(frac)
+MPFRARR_UNIOP(gamma)
+MPFRARR_UNIOP(j0)
+MPFRARR_UNIOP(j1)
+MPFRARR_UNIOP(li2)
+MPFRARR_UNIOP(lngamma)
+MPFRARR_UNIOP(log)
+MPFRARR_UNIOP(log10)
+MPFRARR_UNIOP(log1p)
+MPFRARR_UNIOP(log2)
+MPFRARR_UNIOP(rec_sqrt)
+MPFRARR_UNIOP(rint)
+MPFRARR_UNIOP(rint_ceil)
+MPFRARR_UNIOP(rint_floor)
+MPFRARR_UNIOP(rint_round)
+MPFRARR_UNIOP(rint_trunc)
+MPFRARR_UNIOP(sec)
+MPFRARR_UNIOP(sech)
+MPFRARR_UNIOP(sin)
+MPFRARR_UNIOP(sinh)
+MPFRARR_UNIOP(sqrt)
+MPFRARR_UNIOP(tan)
+MPFRARR_UNIOP(tanh)
+MPFRARR_UNIOP(y0)
+MPFRARR_UNIOP(y1)
+MPFRARR_UNIOP(zeta)
+
+static PyObject *
+GMPy_MPFRArray_Neg_Slot(PyObject *self)
+{
+    MPFRArray_Object *result;
+    CTXT_Object *context = NULL;
+
+    CHECK_CONTEXT(context);
+    if ((result = mpfrarr_unary((MPFRArray_Object*)self, mpfr_neg, context))) {
+        GMPY_MPFR_EXCEPTIONS(result, context, "neg()");
+    }
+    return (PyObject*)result;
+}
+
+static PyObject *
+GMPy_MPFRArray_Abs_Slot(PyObject *self)
+{
+    MPFRArray_Object *result;
+    CTXT_Object *context = NULL;
+
+    CHECK_CONTEXT(context);
+    if ((result = mpfrarr_unary((MPFRArray_Object*)self, mpfr_abs, context))) {
+        GMPY_MPFR_EXCEPTIONS(result, context, "abs()");
+    }
+    return (PyObject*)result;
+}
+
+static MPFRArray_Object *
+mpfrarr_binary(PyObject *a, PyObject *b, mpfrarr_binary_func func, CTXT_Object *context)
+{
+    mpfrarr_operand ops[2];
+    MPFRArray_Object *result = NULL;
+    mpfr_rnd_t rnd = GET_MPFR_ROUND(context);
+    Py_ssize_t i, n;
+    int rc;
+
+    if ((rc = mpfrarr_operand_init(&ops[0], a, context)) <= 0) {
+        if (rc == 0) {
+            Py_INCREF(Py_NotImplemented);
+            return (MPFRArray_Object*)Py_NotImplemented;
+        }
+        return NULL;
+    }
+    if ((rc = mpfrarr_operand_init(&ops[1], b, context)) <= 0) {
+        mpfrarr_operand_clear(&ops[0]);
+        if (rc == 0) {
+            Py_INCREF(Py_NotImplemented);
+            return (MPFRArray_Object*)Py_NotImplemented;
+        }
+        return NULL;
+    }
+
+    n = ops[0].size >= 0 ? ops[0].size : ops[1].size;
+    if (ops[0].size >= 0 && ops[1].size >= 0 && ops[0].size != ops[1].size) {
+        VALUE_ERROR("mpfr_array operation requires arrays of the same length");
+        goto done;
+    }
+
+    if (!(result = mpfrarr_alloc(n, ops[0].prec > ops[1].prec ? ops[0].prec : ops[1].prec)))
+        goto done;
+    if (mpfrarr_operand_copy(&ops[0], n, (size_t)result->prec * n) < 0 ||
+        mpfrarr_operand_copy(&ops[1], n, (size_t)result->prec * n) < 0) {
+        Py_CLEAR(result);
+        goto done;
+    }
+
+    mpfr_clear_flags();
+    GMPY_BEGIN_NOGIL_MPFR((size_t)result->prec * n);
+    for (i = 0; i < n; i++) {
+        mpfr_ptr r = &result->data[i];
+
+        mpfrarr_cleanup(r, func(r, MPFRARR_OPERAND(&ops[0], i),
+                                MPFRARR_OPERAND(&ops[1], i), rnd), context);
+    }
+    GMPY_END_NOGIL;
+
+  done:
+    mpfrarr_operand_clear(&ops[0]);
+    mpfrarr_operand_clear(&ops[1]);
+    return result;
+}
+
+/* MPFRARR_BINOP(NAME, FUNC, MSG) creates the number slot for an elementwise
+ * operator.
+ */
+
+#define MPFRARR_BINOP(NAME, FUNC, MSG) \
+static PyObject * \
+GMPy_MPFRArray_##NAME##_Slot(PyObject *x, PyObject *y) \
+{ \
+    MPFRArray_Object *result; \
+    CTXT_Object *context = NULL; \
+    CHECK_CONTEXT(context); \
+    result = mpfrarr_binary(x, y, mpfr_##FUNC, context); \
+    if (result && (PyObject*)result != Py_NotImplemented) { \
+        GMPY_MPFR_EXCEPTIONS(result, context, MSG); \
+    } \
+    return (PyObject*)result; \
+}
+
+MPFRARR_BINOP(Add, add, "addition")
+MPFRARR_BINOP(Sub, sub, "subtraction")
+MPFRARR_BINOP(Mul, mul, "multiplication")
+MPFRARR_BINOP(TrueDiv, div, "division")
+
+PyDoc_STRVAR(GMPy_doc_mpfr_array_sum,
+"a.sum() -> mpfr\n\n"
+"Return the correctly rounded sum of the elements of a, with the\n"
+"precision of a.");
+
+static PyObject *
+GMPy_MPFRArray_Method_Sum(PyObject *self, PyObject *other)
+{
+    MPFRArray_Object *v = (MPFRArray_Object*)self;
+    MPFR_Object *result;
+    CTXT_Object *context = NULL;
+    mpfrarr_operand op;
+    size_t bits = (size_t)v->prec * v->size;
+    mpfr_ptr *tab;
+    Py_ssize_t i;
+
+    CHECK_CONTEXT(context);
+    mpfrarr_operand_init(&op, self, context);
+    if (mpfrarr_operand_copy(&op, v->size, bits) < 0)
+        return NULL;
+    if (!(tab = GMPY_MALLOC(sizeof(mpfr_ptr) * (v->size ? v->size : 1)))) {
+        mpfrarr_operand_clear(&op);
+        return PyErr_NoMemory();
+    }
+    if (!(result = GMPy_MPFR_New(v->prec, context))) {
+        mpfrarr_operand_clear(&op);
+        GMPY_FREE(tab);
+        return NULL;
+    }
+    for (i = 0; i < v->size; i++)
+        tab[i] = MPFRARR_OPERAND(&op, i);
+
+    mpfr_clear_flags();
+    GMPY_BEGIN_NOGIL_MPFR(bits);
+    result->rc = mpfr_sum(result->f, tab, (unsigned long)v->size, GET_MPFR_ROUND(context));
+    GMPY_END_NOGIL;
+    mpfrarr_operand_clear(&op);
+    GMPY_FREE(tab);
+    GMPY_MPFR_CLEANUP(result, context, "sum()");
+    return (PyObject*)result;
+}
+
+PyDoc_STRVAR(GMPy_doc_mpfr_array_dot,
+"a.dot(b) -> mpfr\n\n"
+"Return the correctly rounded dot product of the arrays a and b, with\n"
+"the larger of their precisions. The products are computed exactly\n"
+"and rounded only once, as part of the sum.");
+
+static PyObject *
+GMPy_MPFRArray_Method_Dot(PyObject *self, PyObject *other)
+{
+    MPFRArray_Object *x = (MPFRArray_Object*)self, *y = (MPFRArray_Object*)other, *prod;
+    MPFR_Object *result;
+    CTXT_Object *context = NULL;
+    mpfrarr_operand ops[2];
+    mpfr_exp_t _oldemin, _oldemax;
+    mpfr_ptr *tab;
+    Py_ssize_t i;
+
+    CHECK_CONTEXT(context);
+    if (!MPFRArray_Check(other)) {
+        TYPE_ERROR("dot() requires an mpfr_array argument");
+        return NULL;
+    }
+    if (x->size != y->size) {
+        VALUE_ERROR("dot() requires arrays of the same length");
+        return NULL;
+    }
+    if (x->prec > MPFR_PREC_MAX - y->prec) {
+        VALUE_ERROR("dot() precision too large");
+        return NULL;
+    }
+
+    if (!(tab = GMPY_MALLOC(sizeof(mpfr_ptr) * (x->size ? x->size : 1))))
+        return PyErr_NoMemory();
+    if (!(prod = mpfrarr_alloc(x->size, x->prec + y->prec))) {
+        GMPY_FREE(tab);
+        return NULL;
+    }
+    if (!(result = GMPy_MPFR_New(x->prec > y->prec ? x->prec : y->prec, context))) {
+        Py_DECREF((PyObject*)prod);
+        GMPY_FREE(tab);
+        return NULL;
+    }
+    mpfrarr_operand_init(&ops[0], self, context);
+    mpfrarr_operand_init(&ops[1], other, context);
+    if (mpfrarr_operand_copy(&ops[0], x->size, (size_t)prod->prec * x->size) < 0 ||
+        mpfrarr_operand_copy(&ops[1], x->size, (size_t)prod->prec * x->size) < 0) {
+        mpfrarr_operand_clear(&ops[0]);
+        mpfrarr_operand_clear(&ops[1]);
+        Py_DECREF((PyObject*)result);
+        Py_DECREF((PyObject*)prod);
+        GMPY_FREE(tab);
+        return NULL;
+    }
+
+    mpfr_clear_flags();
+    GMPY_BEGIN_NOGIL_MPFR((size_t)prod->prec * x->size);
+    GMPY_MPFR_WIDEN_RANGE(_oldemin, _oldemax);
+    for (i = 0; i < x->size; i++) {
+        tab[i] = &prod->data[i];
+        mpfr_mul(tab[i], MPFRARR_OPERAND(&ops[0], i), MPFRARR_OPERAND(&ops[1], i), MPFR_RNDN);
+    }
+    result->rc = mpfr_sum(result->f, tab, (unsigned long)x->size, GET_MPFR_ROUND(context));
+    GMPY_MPFR_RESTORE_RANGE(_oldemin, _oldemax);
+    GMPY_END_NOGIL;
+    mpfrarr_operand_clear(&ops[0]);
+    mpfrarr_operand_clear(&ops[1]);
+    Py_DECREF((PyObject*)prod);
+    GMPY_FREE(tab);
+    GMPY_MPFR_CLEANUP(result, context, "dot()");
+    return (PyObject*)result;
+}
+
+/* Sort in ascending order with NaNs last. */
+
+static int
+mpfrarr_compare(const void *a, const void *b)
+{
+    mpfr_srcptr x = (mpfr_srcptr)a, y = (mpfr_srcptr)b;
+
+    if (mpfr_nan_p(x))
+        return mpfr_nan_p(y) ? 0 : 1;
+    if (mpfr_nan_p(y))
+        return -1;
+    return mpfr_cmp(x, y);
+}
+
+PyDoc_STRVAR(GMPy_doc_mpfr_array_sort,
+"a.sort() -> None\n\n"
+"Sort the elements of a in place in ascending order, with NaNs last.");
+
+static PyObject *
+GMPy_MPFRArray_Method_Sort(PyObject *self, PyObject *other)
+{
+    MPFRArray_Object *v = (MPFRArray_Object*)self;
+    __mpfr_struct *temp;
+    Py_ssize_t i;
+
+    if (v->size < 2)
+        Py_RETURN_NONE;
+
+    /* Sorting moves the structs, and with them the pointers to their
+     * significands, which all stay in the block of the owner. */
+    if (v->step == 1) {
+        qsort(v->data, v->size, sizeof(__mpfr_struct), mpfrarr_compare);
+        Py_RETURN_NONE;
+    }
+
+    if (!(temp = GMPY_MALLOC(sizeof(__mpfr_struct) * v->size)))
+        return PyErr_NoMemory();
+    for (i = 0; i < v->size; i++)
+        temp[i] = *MPFRARRAY_ITEM(v, i);
+    qsort(temp, v->size, sizeof(__mpfr_struct), mpfrarr_compare);
+    for (i = 0; i < v->size; i++)
+        *MPFRARRAY_ITEM(v, i) = temp[i];
+    GMPY_FREE(temp);
+    Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(GMPy_doc_mpfr_array_tolist,
+"a.tolist() -> list\n\n"
+"Return the elements of a as a list of mpfr.");
+
+static PyObject *
+GMPy_MPFRArray_Method_ToList(PyObject *self, PyObject *other)
+{
+    MPFRArray_Object *v = (MPFRArray_Object*)self;
+    PyObject *result, *item;
+    Py_ssize_t i;
+
+    if (!(result = PyList_New(v->size)))
+        return NULL;
+    for (i = 0; i < v->size; i++) {
+        if (!(item = GMPy_MPFRArray_Item_Slot(v, i))) {
+            Py_DECREF(result);
+            return NULL;
+        }
+        PyList_SET_ITEM(result, i, item);
+    }
+    return result;
+}
+
+PyDoc_STRVAR(GMPy_doc_mpfr_array_factory,
+"mpfr_array(n, precision=0) -> mpfr_array\n\n"
+"Return an array of n zeros that all have the given precision; 0 uses\n"
+"the precision of the current context. If n is an iterable of real\n"
+"numbers instead, the array holds those numbers rounded to the given\n"
+"precision. The elements and their significands are stored in a single\n"
+"block. An array supports len(), indexing, assignment of elements,\n"
+"slicing (which returns a view of the same elements), the elementwise\n"
+"operators +, -, * and / with another array of the same length or with\n"
+"a real number, and methods for the elementwise mathematical functions\n"
+"such as a.sin() and a.exp().");
+
+static PyObject *
+GMPy_MPFRArray_Factory(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    MPFRArray_Object *result, *src = NULL;
+    PyObject *arg, *seq = NULL;
+    CTXT_Object *context = NULL;
+    mpfr_prec_t prec;
+    long bits = 0;
+    Py_ssize_t i, n;
+    static char *kwlist[] = {"n", "precision", NULL};
+
+    CHECK_CONTEXT(context);
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "O|l:mpfr_array", kwlist, &arg, &bits))
+        return NULL;
+    if (mpfrarr_prec(bits, context, &prec) < 0)
+        return NULL;
+
+    if (MPFRArray_Check(arg)) {
+        src = (MPFRArray_Object*)arg;
+        n = src->size;
+    }
+    else if (PyIndex_Check(arg)) {
+        n = PyNumber_AsSsize_t(arg, PyExc_OverflowError);
+        if (n == -1 && PyErr_Occurred())
+            return NULL;
+        if (n < 0) {
+            VALUE_ERROR("mpfr_array() requires n >= 0");
+            return NULL;
+        }
+    }
+    else {
+        if (!(seq = PySequence_Fast(arg, "mpfr_array() requires an integer or an iterable of real numbers")))
+            return NULL;
+        n = PySequence_Fast_GET_SIZE(seq);
+    }
+
+    if (!(result = mpfrarr_alloc(n, prec))) {
+        Py_XDECREF(seq);
+        return NULL;
+    }
+    if (src) {
+        for (i = 0; i < n; i++)
+            mpfr_set(&result->data[i], MPFRARRAY_ITEM(src, i), GET_MPFR_ROUND(context));
+    }
+    else if (seq) {
+        for (i = 0; i < n; i++) {
+            if (mpfrarr_set(&result->data[i], PySequence_Fast_GET_ITEM(seq, i), context) < 0) {
+                Py_CLEAR(result);
+                break;
+            }
+        }
+        Py_DECREF(seq);
+    }
+    return (PyObject*)result;
+}
+
+static void
+GMPy_MPFRArray_Dealloc(MPFRArray_Object *self)
+{
+    /* The elements use the mpfr_custom interface and are not cleared. */
+    if (self->base) {
+        Py_DECREF(self->base);
+    }
+    else if (self->data) {
+        GMPY_FREE(self->data);
+    }
+    PyObject_Del(self);
+}
+
+static PyObject *
+GMPy_MPFRArray_Repr_Slot(MPFRArray_Object *self)
+{
+    PyObject *list, *sep, *joined, *args, *format, *result = NULL;
+    Py_ssize_t i;
+
+    if (!(list = PyList_New(self->size)))
+        return NULL;
+    for (i = 0; i < self->size; i++) {
+        PyObject *item, *str;
+
+        if (!(item = GMPy_MPFRArray_Item_Slot(self, i))) {
+            Py_DECREF(list);
+            return NULL;
+        }
+        str = PyObject_Str(item);
+        Py_DECREF(item);
+        if (!str) {
+            Py_DECREF(list);
+            return NULL;
+        }
+        PyList_SET_ITEM(list, i, str);
+    }
+
+    if (!(sep = Py2or3String_FromString(", "))) {
+        Py_DECREF(list);
+        return NULL;
+    }
+    joined = PyObject_CallMethod(sep, "join", "O", list);
+    Py_DECREF(sep);
+    Py_DECREF(list);
+    if (!joined)
+        return NULL;
+
+    args = Py_BuildValue("(Nl)", joined, (long)self->prec);
+    format = Py2or3String_FromString("mpfr_array([%s], precision=%d)");
+    if (args && format)
+        result = Py2or3String_Format(format, args);
+    Py_XDECREF(args);
+    Py_XDECREF(format);
+    return result;
+}
+
+static Py_ssize_t
+GMPy_MPFRArray_Length_Slot(MPFRArray_Object *self)
+{
+    return self->size;
+}
+
+static PyObject *
+GMPy_MPFRArray_Item_Slot(MPFRArray_Object *self, Py_ssize_t i)
+{
+    MPFR_Object *result;
+
+    if (i < 0 || i >= self->size) {
+        INDEX_ERROR("mpfr_array index out of range");
+        return NULL;
+    }
+    if ((result = GMPy_MPFR_New(self->prec, NULL))) {
+        mpfr_set(result->f, MPFRARRAY_ITEM(self, i), MPFR_RNDN);
+        result->rc = 0;
+    }
+    return (PyObject*)result;
+}
+
+static PyObject *
+GMPy_MPFRArray_Subscript_Slot(MPFRArray_Object *self, PyObject *item)
+{
+    MPFRArray_Object *result;
+    Py_ssize_t i, start, stop, step, slicelength;
+
+    if (PyIndex_Check(item)) {
+        i = PyNumber_AsSsize_t(item, PyExc_IndexError);
+        if (i == -1 && PyErr_Occurred())
+            return NULL;
+        if (i < 0)
+            i += self->size;
+        return GMPy_MPFRArray_Item_Slot(self, i);
+    }
+    if (!PySlice_Check(item)) {
+        TYPE_ERROR("mpfr_array indices must be integers or slices");
+        return NULL;
+    }
+
+#if PY_VERSION_HEX > 0x030200A4
+    if (PySlice_GetIndicesEx(item,
+#else
+    if (PySlice_GetIndicesEx((PySliceObject*)item,
+#endif
+                             self->size, &start, &stop, &step, &slicelength) < 0)
+        return NULL;
+
+    /* A slice is a view of the same elements. */
+    if (!(result = PyObject_New(MPFRArray_Object, &MPFRArray_Type)))
+        return NULL;
+    result->data = slicelength ? MPFRARRAY_ITEM(self, start) : self->data;
+    result->size = slicelength;
+    result->step = self->step * step;
+    result->prec = self->prec;
+    result->base = self->base ? self->base : (PyObject*)self;
+    Py_INCREF(result->base);
+    return (PyObject*)result;
+}
+
+static int
+GMPy_MPFRArray_AssSubscript_Slot(MPFRArray_Object *self, PyObject *item, PyObject *value)
+{
+    Py_ssize_t i;
+
+    if (!value) {
+        TYPE_ERROR("mpfr_array does not support deleting elements");
+        return -1;
+    }
+    if (!PyIndex_Check(item)) {
+        TYPE_ERROR("mpfr_array assignment requires an integer index");
+        return -1;
+    }
+    i = PyNumber_AsSsize_t(item, PyExc_IndexError);
+    if (i == -1 && PyErr_Occurred())
+        return -1;
+    if (i < 0)
+        i += self->size;
+    if (i < 0 || i >= self->size) {
+        INDEX_ERROR("mpfr_array assignment index out of range");
+        return -1;
+    }
+    return mpfrarr_set(MPFRARRAY_ITEM(self, i), value, NULL);
+}
+
+static PyObject *
+GMPy_MPFRArray_RichCompare_Slot(PyObject *a, PyObject *b, int op)
+{
+    MPFRArray_Object *x = (MPFRArray_Object*)a, *y = (MPFRArray_Object*)b;
+    Py_ssize_t i;
+    int equal;
+
+    if (!MPFRArray_Check(a) || !MPFRArray_Check(b) || (op != Py_EQ && op != Py_NE))
+        Py_RETURN_NOTIMPLEMENTED;
+
+    equal = x->size == y->size;
+    for (i = 0; equal && i < x->size; i++)
+        equal = mpfr_equal_p(MPFRARRAY_ITEM(x, i), MPFRARRAY_ITEM(y, i));
+    if (equal == (op == Py_EQ))
+        Py_RETURN_TRUE;
+    Py_RETURN_FALSE;
+}
+
+static PyObject *
+GMPy_MPFRArray_GetPrec_Attrib(MPFRArray_Object *self, void *closure)
+{
+    return PyIntOrLong_FromSsize_t((Py_ssize_t)self->prec);
+}
+
+#ifdef PY3
+static PyNumberMethods GMPy_MPFRArray_number_methods =
+{
+    (binaryfunc) GMPy_MPFRArray_Add_Slot,      /* nb_add                  */
+    (binaryfunc) GMPy_MPFRArray_Sub_Slot,      /* nb_subtract             */
+    (binaryfunc) GMPy_MPFRArray_Mul_Slot,      /* nb_multiply             */
+        0,                                     /* nb_remainder            */
+        0,                                     /* nb_divmod               */
+        0,                                     /* nb_power                */
+    (unaryfunc) GMPy_MPFRArray_Neg_Slot,       /* nb_negative             */
+        0,                                     /* nb_positive             */
+    (unaryfunc) GMPy_MPFRArray_Abs_Slot,       /* nb_absolute             */
+        0,                                     /* nb_bool                 */
+        0,                                     /* nb_invert               */
+        0,                                     /* nb_lshift               */
+        0,                                     /* nb_rshift               */
+        0,                                     /* nb_and                  */
+        0,                                     /* nb_xor                  */
+        0,                                     /* nb_or                   */
+        0,                                     /* nb_int                  */
+        0,                                     /* nb_reserved             */
+        0,                                     /* nb_float                */
+        0,                                     /* nb_inplace_add          */
+        0,                                     /* nb_inplace_subtract     */
+        0,                                     /* nb_inplace_multiply     */
+        0,                                     /* nb_inplace_remainder    */
+        0,                                     /* nb_inplace_power        */
+        0,                                     /* nb_inplace_lshift       */
+        0,                                     /* nb_inplace_rshift       */
+        0,                                     /* nb_inplace_and          */
+        0,                                     /* nb_inplace_xor          */
+        0,                                     /* nb_inplace_or           */
+        0,                                     /* nb_floor_divide         */
+    (binaryfunc) GMPy_MPFRArray_TrueDiv_Slot,  /* nb_true_divide          */
+        0,                                     /* nb_inplace_floor_divide */
+        0,                                     /* nb_inplace_true_divide  */
+        0,                                     /* nb_index                */
+};
+#else
+static PyNumberMethods GMPy_MPFRArray_number_methods =
+{
+    (binaryfunc) GMPy_MPFRArray_Add_Slot,      /* nb_add                  */
+    (binaryfunc) GMPy_MPFRArray_Sub_Slot,      /* nb_subtract             */
+    (binaryfunc) GMPy_MPFRArray_Mul_Slot,      /* nb_multiply             */
+    (binaryfunc) GMPy_MPFRArray_TrueDiv_Slot,  /* nb_divide               */
+        0,                                     /* nb_remainder            */
+        0,                                     /* nb_divmod               */
+        0,                                     /* nb_power                */
+    (unaryfunc) GMPy_MPFRArray_Neg_Slot,       /* nb_negative             */
+        0,                                     /* nb_positive             */
+    (unaryfunc) GMPy_MPFRArray_Abs_Slot,       /* nb_absolute             */
+        0,                                     /* nb_bool                 */
+        0,                                     /* nb_invert               */
+        0,                                     /* nb_lshift               */
+        0,                                     /* nb_rshift               */
+        0,                                     /* nb_and                  */
+        0,                                     /* nb_xor                  */
+        0,                                     /* nb_or                   */
+        0,                                     /* nb_coerce               */
+        0,                                     /* nb_int                  */
+        0,                                     /* nb_long                 */
+        0,                                     /* nb_float                */
+        0,                                     /* nb_oct                  */
+        0,                                     /* nb_hex                  */
+        0,                                     /* nb_inplace_add          */
+        0,                                     /* nb_inplace_subtract     */
+        0,                                     /* nb_inplace_multiply     */
+        0,                                     /* nb_inplace_divide       */
+        0,                                     /* nb_inplace_remainder    */
+        0,                                     /* nb_inplace_power        */
+        0,                                     /* nb_inplace_lshift       */
+        0,                                     /* nb_inplace_rshift       */
+        0,                                     /* nb_inplace_and          */
+        0,                                     /* nb_inplace_xor          */
+        0,                                     /* nb_inplace_or           */
+        0,                                     /* nb_floor_divide         */
+    (binaryfunc) GMPy_MPFRArray_TrueDiv_Slot,  /* nb_true_divide          */
+        0,                                     /* nb_inplace_floor_divide */
+        0,                                     /* nb_inplace_true_divide  */
+        0,                                     /* nb_index                */
+};
+#endif
+
+static PySequenceMethods GMPy_MPFRArray_sequence_methods =
+{
+    (lenfunc) GMPy_MPFRArray_Length_Slot,    /* sq_length         */
+        0,                                   /* sq_concat         */
+        0,                                   /* sq_repeat         */
+    (ssizeargfunc) GMPy_MPFRArray_Item_Slot, /* sq_item           */
+};
+
+static PyMappingMethods GMPy_MPFRArray_mapping_methods =
+{
+    (lenfunc) GMPy_MPFRArray_Length_Slot,
+    (binaryfunc) GMPy_MPFRArray_Subscript_Slot,
+    (objobjargproc) GMPy_MPFRArray_AssSubscript_Slot
+};
+
+static PyGetSetDef GMPy_MPFRArray_getseters[] =
+{
+    { "precision", (getter)GMPy_MPFRArray_GetPrec_Attrib, NULL,
+      "precision in bits of the elements", NULL },
+    { NULL }
+};
+
+#define MPFRARR_METHOD(FUNC) \
+    { #FUNC, GMPy_MPFRArray_Method_##FUNC, METH_NOARGS, GMPy_doc_mpfr_array_##FUNC }
+
+static PyMethodDef GMPy_MPFRArray_methods[] =
+{
+    MPFRARR_METHOD(acos),
+    MPFRARR_METHOD(acosh),
+    MPFRARR_METHOD(ai),
+    MPFRARR_METHOD(asin),
+    MPFRARR_METHOD(asinh),
+    MPFRARR_METHOD(atan),
+    MPFRARR_METHOD(atanh),
+    MPFRARR_METHOD(cbrt),
+    MPFRARR_METHOD(cos),
+    MPFRARR_METHOD(cosh),
+    MPFRARR_METHOD(cot),
+    MPFRARR_METHOD(coth),
+    MPFRARR_METHOD(csc),
+    MPFRARR_METHOD(csch),
+    MPFRARR_METHOD(digamma),
+    { "dot", GMPy_MPFRArray_Method_Dot, METH_O, GMPy_doc_mpfr_array_dot },
+    MPFRARR_METHOD(eint),
+    MPFRARR_METHOD(erf),
+    MPFRARR_METHOD(erfc),
+    MPFRARR_METHOD(exp),
+    MPFRARR_METHOD(exp10),
+    MPFRARR_METHOD(exp2),
+    MPFRARR_METHOD(expm1),
+    MPFRARR_METHOD(frac),
+    MPFRARR_METHOD(gamma),
+    MPFRARR_METHOD(j0),
+    MPFRARR_METHOD(j1),
+    MPFRARR_METHOD(li2),
+    MPFRARR_METHOD(lngamma),
+    MPFRARR_METHOD(log),
+    MPFRARR_METHOD(log10),
+    MPFRARR_METHOD(log1p),
+    MPFRARR_METHOD(log2),
+    MPFRARR_METHOD(rec_sqrt),
+    MPFRARR_METHOD(rint),
+    MPFRARR_METHOD(rint_ceil),
+    MPFRARR_METHOD(rint_floor),
+    MPFRARR_METHOD(rint_round),
+    MPFRARR_METHOD(rint_trunc),
+    MPFRARR_METHOD(sec),
+    MPFRARR_METHOD(sech),
+    MPFRARR_METHOD(sin),
+    MPFRARR_METHOD(sinh),
+    { "sort", GMPy_MPFRArray_Method_Sort, METH_NOARGS, GMPy_doc_mpfr_array_sort },
+    MPFRARR_METHOD(sqrt),
+    { "sum", GMPy_MPFRArray_Method_Sum, METH_NOARGS, GMPy_doc_mpfr_array_sum },
+    MPFRARR_METHOD(tan),
+    MPFRARR_METHOD(tanh),
+    { "tolist", GMPy_MPFRArray_Method_ToList, METH_NOARGS, GMPy_doc_mpfr_array_tolist },
+    MPFRARR_METHOD(y0),
+    MPFRARR_METHOD(y1),
+    MPFRARR_METHOD(zeta),
+    { NULL, NULL, 1 }
+};
+
+static PyTypeObject MPFRArray_Type =
+{
+#ifdef PY3
+    PyVarObject_HEAD_INIT(0, 0)
+#else
+    PyObject_HEAD_INIT(0)
+        0,                                   /* ob_size          */
+#endif
+    "mpfr_array",                            /* tp_name          */
+    sizeof(MPFRArray_Object),                /* tp_basicsize     */
+        0,                                   /* tp_itemsize      */
+    (destructor) GMPy_MPFRArray_Dealloc,     /* tp_dealloc       */
+        0,                                   /* tp_print         */
+        0,                                   /* tp_getattr       */
+        0,                                   /* tp_setattr       */
+        0,                                   /* tp_reserved      */
+    (reprfunc) GMPy_MPFRArray_Repr_Slot,     /* tp_repr          */
+    &GMPy_MPFRArray_number_methods,          /* tp_as_number     */
+    &GMPy_MPFRArray_sequence_methods,        /* tp_as_sequence   */
+    &GMPy_MPFRArray_mapping_methods,         /* tp_as_mapping    */
+        0,                                   /* tp_hash          */
+        0,                                   /* tp_call          */
+        0,                                   /* tp_str           */
+        0,                                   /* tp_getattro      */
+        0,                                   /* tp_setattro      */
+        0,                                   /* tp_as_buffer     */
+#ifdef PY3
+    Py_TPFLAGS_DEFAULT,                      /* tp_flags         */
+#else
+    Py_TPFLAGS_HAVE_RICHCOMPARE | Py_TPFLAGS_CHECKTYPES, /* tp_flags */
+#endif
+    "GMPY2 fixed precision array of mpfr",   /* tp_doc           */
+        0,                                   /* tp_traverse      */
+        0,                                   /* tp_clear         */
+    (richcmpfunc)&GMPy_MPFRArray_RichCompare_Slot, /* tp_richcompare */
+        0,                                   /* tp_weaklistoffset*/
+        0,                                   /* tp_iter          */
+        0,                                   /* tp_iternext      */
+    GMPy_MPFRArray_methods,                  /* tp_methods       */
+        0,                                   /* tp_members       */
+    GMPy_MPFRArray_getseters,                /* tp_getset        */
+};
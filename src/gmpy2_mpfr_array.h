@@ -0,0 +1,78 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_mpfr_array.h                                                      *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+#ifndef GMPY_MPFR_ARRAY_H
+#define GMPY_MPFR_ARRAY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* An mpfr_array stores its elements as an array of __mpfr_struct that all
+ * have the same precision. The array and the significands of its elements
+ * are allocated as a single block, the significands following the array,
+ * and are set up with the mpfr_custom interface. The elements must never
+ * be passed to mpfr_clear() or mpfr_set_prec(). A slice is a view that
+ * shares the elements of the array it was taken from: element i is
+ * data[i * step], and base refers to the array that owns the block.
+ */
+
+typedef struct {
+    PyObject_HEAD
+    __mpfr_struct *data;            /* first element */
+    Py_ssize_t size;                /* number of elements */
+    Py_ssize_t step;                /* distance between elements */
+    mpfr_prec_t prec;               /* precision of every element */
+    PyObject *base;                 /* owner of the elements of a view */
+} MPFRArray_Object;
+
+static PyTypeObject MPFRArray_Type;
+
+#define MPFRArray_Check(v) (((PyObject*)v)->ob_type == &MPFRArray_Type)
+#define MPFRARRAY_ITEM(v, i) (&(v)->data[(i) * (v)->step])
+
+static PyObject * GMPy_MPFRArray_Factory(PyObject *self, PyObject *args, PyObject *keywds);
+static void       GMPy_MPFRArray_Dealloc(MPFRArray_Object *self);
+static PyObject * GMPy_MPFRArray_Repr_Slot(MPFRArray_Object *self);
+static Py_ssize_t GMPy_MPFRArray_Length_Slot(MPFRArray_Object *self);
+static PyObject * GMPy_MPFRArray_Item_Slot(MPFRArray_Object *self, Py_ssize_t i);
+static PyObject * GMPy_MPFRArray_Subscript_Slot(MPFRArray_Object *self, PyObject *item);
+static int        GMPy_MPFRArray_AssSubscript_Slot(MPFRArray_Object *self, PyObject *item, PyObject *value);
+static PyObject * GMPy_MPFRArray_RichCompare_Slot(PyObject *a, PyObject *b, int op);
+static PyObject * GMPy_MPFRArray_Add_Slot(PyObject *x, PyObject *y);
+static PyObject * GMPy_MPFRArray_Sub_Slot(PyObject *x, PyObject *y);
+static PyObject * GMPy_MPFRArray_Mul_Slot(PyObject *x, PyObject *y);
+static PyObject * GMPy_MPFRArray_TrueDiv_Slot(PyObject *x, PyObject *y);
+static PyObject * GMPy_MPFRArray_Method_Sum(PyObject *self, PyObject *other);
+static PyObject * GMPy_MPFRArray_Method_Dot(PyObject *self, PyObject *other);
+static PyObject * GMPy_MPFRArray_Method_Sort(PyObject *self, PyObject *other);
+static PyObject * GMPy_MPFRArray_Method_ToList(PyObject *self, PyObject *other);
+static PyObject * GMPy_MPFRArray_GetPrec_Attrib(MPFRArray_Object *self, void *closure);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
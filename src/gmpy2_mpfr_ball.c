@@ -0,0 +1,782 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_mpfr_ball.c                                                       *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* This file implements mpfr_ball, see gmpy2_mpfr_ball.h.
+ *
+ * The midpoint of a result is computed by the MPFR function for the
+ * operation, with the precision and the rounding mode of the context. The
+ * radius collects, rounded up, the propagated radii of the operands and
+ * the rounding error of the midpoint: half an ulp for MPFR_RNDN and one
+ * ulp for the directed modes. Bounds on absolute values are computed by
+ * rounding away from zero.
+ */
+
+#define BALL_ADD 0
+#define BALL_SUB 1
+#define BALL_MUL 2
+#define BALL_DIV 3
+
+static Ball_Object *
+GMPy_Ball_New(mpfr_prec_t prec)
+{
+    Ball_Object *result;
+
+    if ((result = PyObject_New(Ball_Object, &Ball_Type))) {
+        mpfr_init2(result->mid, prec);
+        mpfr_init2(result->rad, BALL_RAD_PREC);
+        mpfr_set_zero(result->mid, 1);
+        mpfr_set_zero(result->rad, 1);
+    }
+    return result;
+}
+
+static void
+GMPy_Ball_Dealloc(Ball_Object *self)
+{
+    mpfr_clear(self->mid);
+    mpfr_clear(self->rad);
+    PyObject_Del(self);
+}
+
+/* Add the rounding error of x->mid to x->rad if inexact is not 0. A ball
+ * whose midpoint is not a number, or whose radius is NaN, gets an infinite
+ * radius. */
+
+static void
+ball_finish(Ball_Object *x, int inexact, mpfr_rnd_t rnd)
+{
+    mpfr_t err;
+    mpfr_exp_t e;
+
+    if (!mpfr_number_p(x->mid) || mpfr_nan_p(x->rad)) {
+        mpfr_set_inf(x->rad, 1);
+        return;
+    }
+    if (!inexact)
+        return;
+
+    if (mpfr_zero_p(x->mid))
+        e = mpfr_get_emin() - 1;
+    else
+        e = mpfr_get_exp(x->mid) - (mpfr_exp_t)mpfr_get_prec(x->mid) - (rnd == MPFR_RNDN);
+    mpfr_init2(err, BALL_RAD_PREC);
+    mpfr_set_ui_2exp(err, 1, e, MPFR_RNDU);
+    mpfr_add(x->rad, x->rad, err, MPFR_RNDU);
+    mpfr_clear(err);
+}
+
+/* Set r to an upper bound of |x| * y for y >= 0. */
+
+static void
+ball_mag_mul(mpfr_ptr r, mpfr_srcptr x, mpfr_srcptr y)
+{
+    mpfr_mul(r, x, y, mpfr_sgn(x) < 0 ? MPFR_RNDD : MPFR_RNDU);
+    mpfr_abs(r, r, MPFR_RNDU);
+}
+
+/* Set r to a lower bound of |x| - y. */
+
+static void
+ball_mag_sub_lower(mpfr_ptr r, mpfr_srcptr x, mpfr_srcptr y)
+{
+    if (mpfr_sgn(x) > 0) {
+        mpfr_sub(r, x, y, MPFR_RNDD);
+    }
+    else {
+        mpfr_add(r, x, y, MPFR_RNDU);
+        mpfr_neg(r, r, MPFR_RNDD);
+    }
+}
+
+/* Return a new reference to obj as a ball, or NULL with an exception set.
+ * A real number keeps its own precision where it can be converted exactly;
+ * otherwise the conversion error becomes the radius. */
+
+static Ball_Object *
+ball_operand(PyObject *obj, CTXT_Object *context)
+{
+    Ball_Object *result;
+    MPFR_Object *temp;
+
+    if (Ball_Check(obj)) {
+        Py_INCREF(obj);
+        return (Ball_Object*)obj;
+    }
+    if (!(temp = GMPy_MPFR_From_Real(obj, 1, context)))
+        return NULL;
+    if ((result = GMPy_Ball_New(mpfr_get_prec(temp->f)))) {
+        mpfr_set(result->mid, temp->f, MPFR_RNDN);
+        ball_finish(result, !MPFR_Check(obj) && temp->rc, GET_MPFR_ROUND(context));
+    }
+    Py_DECREF((PyObject*)temp);
+    return result;
+}
+
+static Ball_Object *
+ball_binary(Ball_Object *a, Ball_Object *b, int op, CTXT_Object *context)
+{
+    Ball_Object *result;
+    mpfr_rnd_t rnd = GET_MPFR_ROUND(context);
+    mpfr_t t, d;
+    int inexact;
+
+    if (op == BALL_DIV) {
+        mpfr_init2(d, BALL_RAD_PREC);
+        ball_mag_sub_lower(d, b->mid, b->rad);
+        if (!mpfr_nan_p(d) && mpfr_sgn(d) <= 0) {
+            mpfr_clear(d);
+            ZERO_ERROR("division by an mpfr_ball that contains zero");
+            return NULL;
+        }
+    }
+
+    if (!(result = GMPy_Ball_New(GET_MPFR_PREC(context)))) {
+        if (op == BALL_DIV)
+            mpfr_clear(d);
+        return NULL;
+    }
+    mpfr_init2(t, BALL_RAD_PREC);
+
+    switch (op) {
+    case BALL_ADD:
+        inexact = mpfr_add(result->mid, a->mid, b->mid, rnd);
+        mpfr_add(result->rad, a->rad, b->rad, MPFR_RNDU);
+        break;
+    case BALL_SUB:
+        inexact = mpfr_sub(result->mid, a->mid, b->mid, rnd);
+        mpfr_add(result->rad, a->rad, b->rad, MPFR_RNDU);
+        break;
+    case BALL_MUL:
+        /* |xy - ab| <= |a| rb + |b| ra + ra rb */
+        inexact = mpfr_mul(result->mid, a->mid, b->mid, rnd);
+        ball_mag_mul(result->rad, a->mid, b->rad);
+        ball_mag_mul(t, b->mid, a->rad);
+        mpfr_add(result->rad, result->rad, t, MPFR_RNDU);
+        mpfr_mul(t, a->rad, b->rad, MPFR_RNDU);
+        mpfr_add(result->rad, result->rad, t, MPFR_RNDU);
+        break;
+    default:
+        /* |x/y - a/b| <= (|a| rb + |b| ra) / (|b| (|b| - rb)) */
+        inexact = mpfr_div(result->mid, a->mid, b->mid, rnd);
+        ball_mag_mul(result->rad, a->mid, b->rad);
+        ball_mag_mul(t, b->mid, a->rad);
+        mpfr_add(result->rad, result->rad, t, MPFR_RNDU);
+        mpfr_mul(t, b->mid, d, mpfr_sgn(b->mid) < 0 ? MPFR_RNDU : MPFR_RNDD);
+        mpfr_abs(t, t, MPFR_RNDD);
+        mpfr_div(result->rad, result->rad, t, MPFR_RNDU);
+        mpfr_clear(d);
+    }
+    mpfr_clear(t);
+    ball_finish(result, inexact, rnd);
+    return result;
+}
+
+static PyObject *
+ball_binary_slot(PyObject *x, PyObject *y, int op)
+{
+    Ball_Object *a, *b, *result = NULL;
+    CTXT_Object *context = NULL;
+
+    if (!(Ball_Check(x) || IS_REAL(x)) || !(Ball_Check(y) || IS_REAL(y)))
+        Py_RETURN_NOTIMPLEMENTED;
+
+    CHECK_CONTEXT(context);
+    if (!(a = ball_operand(x, context)))
+        return NULL;
+    if ((b = ball_operand(y, context))) {
+        result = ball_binary(a, b, op, context);
+        Py_DECREF((PyObject*)b);
+    }
+    Py_DECREF((PyObject*)a);
+    return (PyObject*)result;
+}
+
+static PyObject *
+GMPy_Ball_Add_Slot(PyObject *x, PyObject *y)
+{
+    return ball_binary_slot(x, y, BALL_ADD);
+}
+
+static PyObject *
+GMPy_Ball_Sub_Slot(PyObject *x, PyObject *y)
+{
+    return ball_binary_slot(x, y, BALL_SUB);
+}
+
+static PyObject *
+GMPy_Ball_Mul_Slot(PyObject *x, PyObject *y)
+{
+    return ball_binary_slot(x, y, BALL_MUL);
+}
+
+static PyObject *
+GMPy_Ball_TrueDiv_Slot(PyObject *x, PyObject *y)
+{
+    return ball_binary_slot(x, y, BALL_DIV);
+}
+
+static PyObject *
+GMPy_Ball_Neg_Slot(Ball_Object *x)
+{
+    Ball_Object *result;
+    CTXT_Object *context = NULL;
+
+    CHECK_CONTEXT(context);
+    if ((result = GMPy_Ball_New(GET_MPFR_PREC(context)))) {
+        mpfr_set(result->rad, x->rad, MPFR_RNDU);
+        ball_finish(result, mpfr_neg(result->mid, x->mid, GET_MPFR_ROUND(context)),
+                    GET_MPFR_ROUND(context));
+    }
+    return (PyObject*)result;
+}
+
+/* x ** n for an integer n, by repeated squaring. */
+
+static PyObject *
+GMPy_Ball_Pow_Slot(PyObject *x, PyObject *y, PyObject *m)
+{
+    Ball_Object *base, *result, *temp;
+    CTXT_Object *context = NULL;
+    unsigned long n;
+    long e;
+    int error;
+
+    if (!Ball_Check(x) || !IS_INTEGER(y))
+        Py_RETURN_NOTIMPLEMENTED;
+
+    if (m != Py_None) {
+        TYPE_ERROR("pow() of an mpfr_ball does not accept a modulus");
+        return NULL;
+    }
+    e = GMPy_Integer_AsLongAndError(y, &error);
+    if (error) {
+        OVERFLOW_ERROR("pow() exponent too large");
+        return NULL;
+    }
+
+    CHECK_CONTEXT(context);
+    if (!(result = GMPy_Ball_New(GET_MPFR_PREC(context))))
+        return NULL;
+    mpfr_set_ui(result->mid, 1, MPFR_RNDN);
+
+    base = (Ball_Object*)x;
+    Py_INCREF((PyObject*)base);
+    for (n = e < 0 ? -(unsigned long)e : (unsigned long)e; n; n >>= 1) {
+        if (n & 1) {
+            temp = ball_binary(result, base, BALL_MUL, context);
+            Py_DECREF((PyObject*)result);
+            if (!(result = temp))
+                break;
+        }
+        if (n > 1) {
+            temp = ball_binary(base, base, BALL_MUL, context);
+            Py_DECREF((PyObject*)base);
+            if (!(base = temp))
+                break;
+        }
+    }
+    if (!result || !base) {
+        Py_XDECREF((PyObject*)result);
+        Py_XDECREF((PyObject*)base);
+        return NULL;
+    }
+    Py_DECREF((PyObject*)base);
+
+    if (e < 0) {
+        if (!(base = GMPy_Ball_New(2))) {
+            Py_DECREF((PyObject*)result);
+            return NULL;
+        }
+        mpfr_set_ui(base->mid, 1, MPFR_RNDN);
+        temp = ball_binary(base, result, BALL_DIV, context);
+        Py_DECREF((PyObject*)base);
+        Py_DECREF((PyObject*)result);
+        result = temp;
+    }
+    return (PyObject*)result;
+}
+
+PyDoc_STRVAR(GMPy_doc_ball_sqrt,
+"x.sqrt() -> mpfr_ball\n\n"
+"Return a ball that contains the square roots of all points of x. x must\n"
+"not contain negative numbers.");
+
+static PyObject *
+GMPy_Ball_Method_Sqrt(PyObject *self, PyObject *other)
+{
+    Ball_Object *x = (Ball_Object*)self, *result;
+    CTXT_Object *context = NULL;
+    mpfr_t lo;
+    int inexact;
+
+    mpfr_init2(lo, BALL_RAD_PREC);
+    mpfr_sub(lo, x->mid, x->rad, MPFR_RNDD);
+    if (mpfr_sgn(lo) < 0) {
+        mpfr_clear(lo);
+        VALUE_ERROR("sqrt() of an mpfr_ball that contains negative numbers");
+        return NULL;
+    }
+
+    CHECK_CONTEXT(context);
+    if ((result = GMPy_Ball_New(GET_MPFR_PREC(context)))) {
+        inexact = mpfr_sqrt(result->mid, x->mid, GET_MPFR_ROUND(context));
+        if (mpfr_zero_p(x->rad)) {
+            ;
+        }
+        else if (mpfr_zero_p(lo)) {
+            /* The ball reaches 0: |sqrt(y) - sqrt(mid)| <= sqrt(mid + rad). */
+            mpfr_add(result->rad, x->mid, x->rad, MPFR_RNDU);
+            mpfr_sqrt(result->rad, result->rad, MPFR_RNDU);
+        }
+        else {
+            /* |sqrt(y) - sqrt(mid)| <= rad / (2 sqrt(mid - rad)) */
+            mpfr_sqrt(lo, lo, MPFR_RNDD);
+            mpfr_div(result->rad, x->rad, lo, MPFR_RNDU);
+            mpfr_div_2ui(result->rad, result->rad, 1, MPFR_RNDU);
+        }
+        ball_finish(result, inexact, GET_MPFR_ROUND(context));
+    }
+    mpfr_clear(lo);
+    return (PyObject*)result;
+}
+
+PyDoc_STRVAR(GMPy_doc_ball_exp,
+"x.exp() -> mpfr_ball\n\n"
+"Return a ball that contains exp(y) for all points y of x.");
+
+static PyObject *
+GMPy_Ball_Method_Exp(PyObject *self, PyObject *other)
+{
+    Ball_Object *x = (Ball_Object*)self, *result;
+    CTXT_Object *context = NULL;
+    mpfr_t t;
+    int inexact;
+
+    CHECK_CONTEXT(context);
+    if ((result = GMPy_Ball_New(GET_MPFR_PREC(context)))) {
+        inexact = mpfr_exp(result->mid, x->mid, GET_MPFR_ROUND(context));
+        if (!mpfr_zero_p(x->rad)) {
+            /* |exp(y) - exp(mid)| <= exp(mid) (exp(rad) - 1) */
+            mpfr_init2(t, BALL_RAD_PREC);
+            mpfr_exp(t, x->mid, MPFR_RNDU);
+            mpfr_expm1(result->rad, x->rad, MPFR_RNDU);
+            mpfr_mul(result->rad, result->rad, t, MPFR_RNDU);
+            mpfr_clear(t);
+        }
+        ball_finish(result, inexact, GET_MPFR_ROUND(context));
+    }
+    return (PyObject*)result;
+}
+
+PyDoc_STRVAR(GMPy_doc_ball_log,
+"x.log() -> mpfr_ball\n\n"
+"Return a ball that contains log(y) for all points y of x. x must only\n"
+"contain positive numbers.");
+
+static PyObject *
+GMPy_Ball_Method_Log(PyObject *self, PyObject *other)
+{
+    Ball_Object *x = (Ball_Object*)self, *result;
+    CTXT_Object *context = NULL;
+    mpfr_t lo;
+    int inexact;
+
+    mpfr_init2(lo, BALL_RAD_PREC);
+    mpfr_sub(lo, x->mid, x->rad, MPFR_RNDD);
+    if (!mpfr_nan_p(lo) && mpfr_sgn(lo) <= 0) {
+        mpfr_clear(lo);
+        VALUE_ERROR("log() of an mpfr_ball that contains non-positive numbers");
+        return NULL;
+    }
+
+    CHECK_CONTEXT(context);
+    if ((result = GMPy_Ball_New(GET_MPFR_PREC(context)))) {
+        inexact = mpfr_log(result->mid, x->mid, GET_MPFR_ROUND(context));
+        if (!mpfr_zero_p(x->rad)) {
+            /* |log(y) - log(mid)| <= log(mid / (mid - rad)) <= log1p(rad / (mid - rad)) */
+            mpfr_div(result->rad, x->rad, lo, MPFR_RNDU);
+            mpfr_log1p(result->rad, result->rad, MPFR_RNDU);
+        }
+        ball_finish(result, inexact, GET_MPFR_ROUND(context));
+    }
+    mpfr_clear(lo);
+    return (PyObject*)result;
+}
+
+/* Return mid - rad or mid + rad, rounded outward, as an mpfr with the
+ * precision of the midpoint. */
+
+static PyObject *
+ball_endpoint(Ball_Object *x, int upper)
+{
+    MPFR_Object *result;
+
+    if ((result = GMPy_MPFR_New(mpfr_get_prec(x->mid), NULL))) {
+        if (upper)
+            result->rc = mpfr_add(result->f, x->mid, x->rad, MPFR_RNDU);
+        else
+            result->rc = mpfr_sub(result->f, x->mid, x->rad, MPFR_RNDD);
+    }
+    return (PyObject*)result;
+}
+
+PyDoc_STRVAR(GMPy_doc_ball_lower,
+"x.lower() -> mpfr\n\n"
+"Return a lower bound of x, mid - rad rounded down.");
+
+static PyObject *
+GMPy_Ball_Method_Lower(PyObject *self, PyObject *other)
+{
+    return ball_endpoint((Ball_Object*)self, 0);
+}
+
+PyDoc_STRVAR(GMPy_doc_ball_upper,
+"x.upper() -> mpfr\n\n"
+"Return an upper bound of x, mid + rad rounded up.");
+
+static PyObject *
+GMPy_Ball_Method_Upper(PyObject *self, PyObject *other)
+{
+    return ball_endpoint((Ball_Object*)self, 1);
+}
+
+PyDoc_STRVAR(GMPy_doc_ball_contains,
+"x.contains(y) -> bool\n\n"
+"Return True if x certainly contains y, a real number or an mpfr_ball.\n"
+"The test uses an upper bound of the distance of the midpoints, so it\n"
+"may return False when y only just fits.");
+
+static PyObject *
+GMPy_Ball_Method_Contains(PyObject *self, PyObject *other)
+{
+    Ball_Object *x = (Ball_Object*)self, *y;
+    CTXT_Object *context = NULL;
+    mpfr_t d;
+    int result;
+
+    if (!Ball_Check(other) && !IS_REAL(other)) {
+        TYPE_ERROR("contains() requires a real number or an mpfr_ball argument");
+        return NULL;
+    }
+    CHECK_CONTEXT(context);
+    if (!(y = ball_operand(other, context)))
+        return NULL;
+
+    mpfr_init2(d, BALL_RAD_PREC);
+    if (mpfr_cmp(y->mid, x->mid) >= 0)
+        mpfr_sub(d, y->mid, x->mid, MPFR_RNDU);
+    else
+        mpfr_sub(d, x->mid, y->mid, MPFR_RNDU);
+    mpfr_add(d, d, y->rad, MPFR_RNDU);
+    result = mpfr_lessequal_p(d, x->rad);
+    mpfr_clear(d);
+    Py_DECREF((PyObject*)y);
+    return PyBool_FromLong(result);
+}
+
+static PyObject *
+GMPy_Ball_GetMid(Ball_Object *self, void *closure)
+{
+    MPFR_Object *result;
+
+    if ((result = GMPy_MPFR_New(mpfr_get_prec(self->mid), NULL)))
+        mpfr_set(result->f, self->mid, MPFR_RNDN);
+    return (PyObject*)result;
+}
+
+static PyObject *
+GMPy_Ball_GetRad(Ball_Object *self, void *closure)
+{
+    MPFR_Object *result;
+
+    if ((result = GMPy_MPFR_New(BALL_RAD_PREC, NULL)))
+        mpfr_set(result->f, self->rad, MPFR_RNDN);
+    return (PyObject*)result;
+}
+
+static PyObject *
+GMPy_Ball_Repr_Slot(Ball_Object *self)
+{
+    PyObject *mid, *rad, *format, *args, *result = NULL;
+
+    if (!(mid = GMPy_Ball_GetMid(self, NULL)))
+        return NULL;
+    if (!(rad = GMPy_Ball_GetRad(self, NULL))) {
+        Py_DECREF(mid);
+        return NULL;
+    }
+    args = Py_BuildValue("(NN)", mid, rad);
+    format = Py2or3String_FromString("mpfr_ball(%r, %r)");
+    if (args && format)
+        result = Py2or3String_Format(format, args);
+    Py_XDECREF(args);
+    Py_XDECREF(format);
+    return result;
+}
+
+static PyObject *
+GMPy_Ball_Str_Slot(Ball_Object *self)
+{
+    PyObject *mid, *rad, *format, *args, *result = NULL;
+
+    if (!(mid = GMPy_Ball_GetMid(self, NULL)))
+        return NULL;
+    if (!(rad = GMPy_Ball_GetRad(self, NULL))) {
+        Py_DECREF(mid);
+        return NULL;
+    }
+    args = Py_BuildValue("(NN)", mid, rad);
+    format = Py2or3String_FromString("[%s +/- %s]");
+    if (args && format)
+        result = Py2or3String_Format(format, args);
+    Py_XDECREF(args);
+    Py_XDECREF(format);
+    return result;
+}
+
+PyDoc_STRVAR(GMPy_doc_mpfr_ball_factory,
+"mpfr_ball(x, rad=0, precision=0) -> mpfr_ball\n\n"
+"Return the ball of real numbers y with |y - x| <= rad. x is a real number,\n"
+"a string or an mpfr_ball; it is rounded to the given precision, 0 uses\n"
+"the precision of the current context, and the rounding error is added\n"
+"to the radius. The operators +, -, *, /, unary - and ** with an integer\n"
+"exponent, and the methods sqrt(), exp() and log(), return balls that\n"
+"contain the exact results for all points of the operands. The midpoint\n"
+"is rounded with the rounding mode of the context.");
+
+static PyObject *
+GMPy_Ball_Factory(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    Ball_Object *result;
+    MPFR_Object *temp;
+    PyObject *x, *rad = NULL;
+    CTXT_Object *context = NULL;
+    mpfr_prec_t prec;
+    mpfr_rnd_t rnd;
+    long bits = 0;
+    int inexact = 0;
+    static char *kwlist[] = {"x", "rad", "precision", NULL};
+
+    CHECK_CONTEXT(context);
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|Ol:mpfr_ball", kwlist, &x, &rad, &bits))
+        return NULL;
+    if (mpfrarr_prec(bits, context, &prec) < 0)
+        return NULL;
+    rnd = GET_MPFR_ROUND(context);
+
+    if (!Ball_Check(x) && !IS_REAL(x) && !PyStrOrUnicode_Check(x)) {
+        TYPE_ERROR("mpfr_ball() requires a real number, a string or an mpfr_ball");
+        return NULL;
+    }
+    if (rad && !IS_REAL(rad)) {
+        TYPE_ERROR("mpfr_ball() requires a real radius");
+        return NULL;
+    }
+
+    if (!(result = GMPy_Ball_New(prec)))
+        return NULL;
+
+    if (rad) {
+        if (!(temp = GMPy_MPFR_From_Real(rad, 1, context))) {
+            Py_DECREF((PyObject*)result);
+            return NULL;
+        }
+        if (mpfr_nan_p(temp->f) || mpfr_sgn(temp->f) < 0) {
+            Py_DECREF((PyObject*)temp);
+            Py_DECREF((PyObject*)result);
+            VALUE_ERROR("mpfr_ball() requires a non-negative radius");
+            return NULL;
+        }
+        /* A radius that was rounded down is moved up by one ulp. */
+        mpfr_set(result->rad, temp->f, MPFR_RNDU);
+        if (temp->rc < 0 && !MPFR_Check(rad))
+            mpfr_nextabove(result->rad);
+        Py_DECREF((PyObject*)temp);
+    }
+
+    if (Ball_Check(x)) {
+        mpfr_add(result->rad, result->rad, ((Ball_Object*)x)->rad, MPFR_RNDU);
+        inexact = mpfr_set(result->mid, ((Ball_Object*)x)->mid, rnd);
+    }
+    else if (MPFR_Check(x)) {
+        inexact = mpfr_set(result->mid, MPFR(x), rnd);
+    }
+    else {
+        /* The conversion rounds to prec, so the copy is exact. */
+        if (PyStrOrUnicode_Check(x))
+            temp = GMPy_MPFR_From_PyStr(x, 10, prec, context);
+        else
+            temp = GMPy_MPFR_From_Real(x, prec, context);
+        if (!temp) {
+            Py_DECREF((PyObject*)result);
+            return NULL;
+        }
+        mpfr_set(result->mid, temp->f, rnd);
+        inexact = temp->rc;
+        Py_DECREF((PyObject*)temp);
+    }
+    ball_finish(result, inexact, rnd);
+    return (PyObject*)result;
+}
+
+#ifdef PY3
+static PyNumberMethods GMPy_Ball_number_methods =
+{
+    (binaryfunc) GMPy_Ball_Add_Slot,         /* nb_add                  */
+    (binaryfunc) GMPy_Ball_Sub_Slot,         /* nb_subtract             */
+    (binaryfunc) GMPy_Ball_Mul_Slot,         /* nb_multiply             */
+        0,                                   /* nb_remainder            */
+        0,                                   /* nb_divmod               */
+    (ternaryfunc) GMPy_Ball_Pow_Slot,        /* nb_power                */
+    (unaryfunc) GMPy_Ball_Neg_Slot,          /* nb_negative             */
+        0,                                   /* nb_positive             */
+        0,                                   /* nb_absolute             */
+        0,                                   /* nb_bool                 */
+        0,                                   /* nb_invert               */
+        0,                                   /* nb_lshift               */
+        0,                                   /* nb_rshift               */
+        0,                                   /* nb_and                  */
+        0,                                   /* nb_xor                  */
+        0,                                   /* nb_or                   */
+        0,                                   /* nb_int                  */
+        0,                                   /* nb_reserved             */
+        0,                                   /* nb_float                */
+        0,                                   /* nb_inplace_add          */
+        0,                                   /* nb_inplace_subtract     */
+        0,                                   /* nb_inplace_multiply     */
+        0,                                   /* nb_inplace_remainder    */
+        0,                                   /* nb_inplace_power        */
+        0,                                   /* nb_inplace_lshift       */
+        0,                                   /* nb_inplace_rshift       */
+        0,                                   /* nb_inplace_and          */
+        0,                                   /* nb_inplace_xor          */
+        0,                                   /* nb_inplace_or           */
+        0,                                   /* nb_floor_divide         */
+    (binaryfunc) GMPy_Ball_TrueDiv_Slot,     /* nb_true_divide          */
+};
+#else
+static PyNumberMethods GMPy_Ball_number_methods =
+{
+    (binaryfunc) GMPy_Ball_Add_Slot,         /* nb_add                  */
+    (binaryfunc) GMPy_Ball_Sub_Slot,         /* nb_subtract             */
+    (binaryfunc) GMPy_Ball_Mul_Slot,         /* nb_multiply             */
+    (binaryfunc) GMPy_Ball_TrueDiv_Slot,     /* nb_divide               */
+        0,                                   /* nb_remainder            */
+        0,                                   /* nb_divmod               */
+    (ternaryfunc) GMPy_Ball_Pow_Slot,        /* nb_power                */
+    (unaryfunc) GMPy_Ball_Neg_Slot,          /* nb_negative             */
+        0,                                   /* nb_positive             */
+        0,                                   /* nb_absolute             */
+        0,                                   /* nb_bool                 */
+        0,                                   /* nb_invert               */
+        0,                                   /* nb_lshift               */
+        0,                                   /* nb_rshift               */
+        0,                                   /* nb_and                  */
+        0,                                   /* nb_xor                  */
+        0,                                   /* nb_or                   */
+        0,                                   /* nb_coerce               */
+        0,                                   /* nb_int                  */
+        0,                                   /* nb_long                 */
+        0,                                   /* nb_float                */
+        0,                                   /* nb_oct                  */
+        0,                                   /* nb_hex                  */
+        0,                                   /* nb_inplace_add          */
+        0,                                   /* nb_inplace_subtract     */
+        0,                                   /* nb_inplace_multiply     */
+        0,                                   /* nb_inplace_divide       */
+        0,                                   /* nb_inplace_remainder    */
+        0,                                   /* nb_inplace_power        */
+        0,                                   /* nb_inplace_lshift       */
+        0,                                   /* nb_inplace_rshift       */
+        0,                                   /* nb_inplace_and          */
+        0,                                   /* nb_inplace_xor          */
+        0,                                   /* nb_inplace_or           */
+        0,                                   /* nb_floor_divide         */
+    (binaryfunc) GMPy_Ball_TrueDiv_Slot,     /* nb_true_divide          */
+};
+#endif
+
+static PyGetSetDef GMPy_Ball_getseters[] =
+{
+    { "mid", (getter)GMPy_Ball_GetMid, NULL, "midpoint", NULL },
+    { "rad", (getter)GMPy_Ball_GetRad, NULL, "radius", NULL },
+    {NULL}
+};
+
+static PyMethodDef GMPy_Ball_methods[] =
+{
+    { "contains", GMPy_Ball_Method_Contains, METH_O, GMPy_doc_ball_contains },
+    { "exp", GMPy_Ball_Method_Exp, METH_NOARGS, GMPy_doc_ball_exp },
+    { "log", GMPy_Ball_Method_Log, METH_NOARGS, GMPy_doc_ball_log },
+    { "lower", GMPy_Ball_Method_Lower, METH_NOARGS, GMPy_doc_ball_lower },
+    { "sqrt", GMPy_Ball_Method_Sqrt, METH_NOARGS, GMPy_doc_ball_sqrt },
+    { "upper", GMPy_Ball_Method_Upper, METH_NOARGS, GMPy_doc_ball_upper },
+    { NULL, NULL, 1 }
+};
+
+static PyTypeObject Ball_Type =
+{
+#ifdef PY3
+    PyVarObject_HEAD_INIT(0, 0)
+#else
+    PyObject_HEAD_INIT(0)
+        0,                                   /* ob_size          */
+#endif
+    "gmpy2 mpfr_ball",                       /* tp_name          */
+    sizeof(Ball_Object),                     /* tp_basicsize     */
+        0,                                   /* tp_itemsize      */
+    (destructor) GMPy_Ball_Dealloc,          /* tp_dealloc       */
+        0,                                   /* tp_print         */
+        0,                                   /* tp_getattr       */
+        0,                                   /* tp_setattr       */
+        0,                                   /* tp_reserved      */
+    (reprfunc) GMPy_Ball_Repr_Slot,          /* tp_repr          */
+    &GMPy_Ball_number_methods,               /* tp_as_number     */
+        0,                                   /* tp_as_sequence   */
+        0,                                   /* tp_as_mapping    */
+        0,                                   /* tp_hash          */
+        0,                                   /* tp_call          */
+    (reprfunc) GMPy_Ball_Str_Slot,           /* tp_str           */
+        0,                                   /* tp_getattro      */
+        0,                                   /* tp_setattro      */
+        0,                                   /* tp_as_buffer     */
+#ifdef PY3
+    Py_TPFLAGS_DEFAULT,                      /* tp_flags         */
+#else
+    Py_TPFLAGS_HAVE_RICHCOMPARE | Py_TPFLAGS_CHECKTYPES, /* tp_flags */
+#endif
+    "GMPY2 real ball",                       /* tp_doc           */
+        0,                                   /* tp_traverse      */
+        0,                                   /* tp_clear         */
+        0,                                   /* tp_richcompare   */
+        0,                                   /* tp_weaklistoffset*/
+        0,                                   /* tp_iter          */
+        0,                                   /* tp_iternext      */
+    GMPy_Ball_methods,                       /* tp_methods       */
+        0,                                   /* tp_members       */
+    GMPy_Ball_getseters,                     /* tp_getset        */
+};
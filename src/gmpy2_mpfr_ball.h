@@ -0,0 +1,77 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_mpfr_ball.h                                                       *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GMPY_MPFR_BALL_H
+#define GMPY_MPFR_BALL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* An mpfr_ball is the set of real numbers x with |x - mid| <= rad. The
+ * midpoint has the precision of the context; the radius is an upper bound
+ * kept with BALL_RAD_PREC bits and always rounded up. Every operation
+ * returns a ball that contains the exact result for all points of the
+ * operands, so a single evaluation gives a verified enclosure.
+ */
+
+#define BALL_RAD_PREC 30
+
+typedef struct {
+    PyObject_HEAD
+    mpfr_t mid;
+    mpfr_t rad;
+} Ball_Object;
+
+static PyTypeObject Ball_Type;
+
+#define Ball_Check(v) (((PyObject*)v)->ob_type == &Ball_Type)
+
+static Ball_Object * GMPy_Ball_New(mpfr_prec_t prec);
+static PyObject *    GMPy_Ball_Factory(PyObject *self, PyObject *args, PyObject *kwargs);
+static void          GMPy_Ball_Dealloc(Ball_Object *self);
+static PyObject *    GMPy_Ball_Repr_Slot(Ball_Object *self);
+static PyObject *    GMPy_Ball_Str_Slot(Ball_Object *self);
+static PyObject *    GMPy_Ball_Add_Slot(PyObject *x, PyObject *y);
+static PyObject *    GMPy_Ball_Sub_Slot(PyObject *x, PyObject *y);
+static PyObject *    GMPy_Ball_Mul_Slot(PyObject *x, PyObject *y);
+static PyObject *    GMPy_Ball_TrueDiv_Slot(PyObject *x, PyObject *y);
+static PyObject *    GMPy_Ball_Pow_Slot(PyObject *x, PyObject *y, PyObject *m);
+static PyObject *    GMPy_Ball_Neg_Slot(Ball_Object *x);
+static PyObject *    GMPy_Ball_Method_Sqrt(PyObject *self, PyObject *other);
+static PyObject *    GMPy_Ball_Method_Exp(PyObject *self, PyObject *other);
+static PyObject *    GMPy_Ball_Method_Log(PyObject *self, PyObject *other);
+static PyObject *    GMPy_Ball_Method_Lower(PyObject *self, PyObject *other);
+static PyObject *    GMPy_Ball_Method_Upper(PyObject *self, PyObject *other);
+static PyObject *    GMPy_Ball_Method_Contains(PyObject *self, PyObject *other);
+static PyObject *    GMPy_Ball_GetMid(Ball_Object *self, void *closure);
+static PyObject *    GMPy_Ball_GetRad(Ball_Object *self, void *closure);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
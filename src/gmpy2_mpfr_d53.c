@@ -0,0 +1,216 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_mpfr_d53.c                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+/* Most mpfr arithmetic is done at the default precision of 53 bits, where
+ * an mpfr has the same significand as an IEEE double. For add, sub, mul,
+ * fma and sqrt with round-to-nearest, the hardware result is the correctly
+ * rounded result, and the error-free transformations below give its exact
+ * error, so the ternary value is known as well. The fast path is only taken
+ * when every operand and the result are normal doubles far enough from the
+ * ends of the exponent range for those transformations to be exact, and the
+ * result lies inside the exponent range of the context. Anything else
+ * returns 0 and is left to MPFR.
+ *
+ * The conversions use the limb layout of an mpfr directly. They require
+ * 64-bit limbs and doubles that are evaluated in their own precision (not
+ * x87 extended precision).
+ */
+
+#if GMP_NUMB_BITS == 64 && GMP_NAIL_BITS == 0 && DBL_MANT_DIG == 53 && \
+    DBL_MAX_EXP == 1024 && defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+
+#define D53_MANT_MASK ((((uint64_t)1) << 52) - 1)
+#define D53_HIDDEN_BIT (((uint64_t)1) << 52)
+#define D53_SIGN_BIT (((uint64_t)1) << 63)
+
+/* Magnitudes that keep the error terms free of underflow and the
+ * intermediate sums free of overflow, with a wide margin. */
+#define D53_TINY 1e-270
+#define D53_HUGE 1e+300
+
+#define D53_CONTEXT_OK(r, context) \
+    (GET_MPFR_ROUND(context) == MPFR_RNDN && mpfr_get_prec(r->f) == 53)
+
+/* Return the sum of a and b in *s and its rounding error, exactly. */
+#define D53_TWO_SUM(s, err, a, b) \
+    do { \
+        double _bb; \
+        s = (a) + (b); \
+        _bb = s - (a); \
+        err = ((a) - (s - _bb)) + ((b) - _bb); \
+    } while (0)
+
+/* Sign of the ternary value when exact = rounded + err. */
+#define D53_TERNARY(err) ((err) > 0 ? -1 : ((err) < 0 ? 1 : 0))
+
+static int
+d53_get(double *d, mpfr_srcptr f)
+{
+    uint64_t bits;
+    mpfr_exp_t exp;
+
+    if (mpfr_get_prec(f) != 53 || !mpfr_regular_p(f))
+        return 0;
+
+    exp = f->_mpfr_exp;
+    if (exp < -1020 || exp > 1024)
+        return 0;
+
+    bits = ((uint64_t)(exp + 1022) << 52) | ((f->_mpfr_d[0] >> 11) & D53_MANT_MASK);
+    if (f->_mpfr_sign < 0)
+        bits |= D53_SIGN_BIT;
+    memcpy(d, &bits, sizeof(double));
+    return 1;
+}
+
+static int
+d53_set(MPFR_Object *r, double d, int rc, CTXT_Object *context)
+{
+    uint64_t bits;
+    mpfr_exp_t exp;
+    int biased;
+
+    memcpy(&bits, &d, sizeof(double));
+    biased = (int)((bits >> 52) & 0x7ff);
+    if (biased == 0 || biased == 0x7ff)
+        return 0;
+
+    exp = (mpfr_exp_t)biased - 1022;
+    if (exp < context->ctx.emin || exp > context->ctx.emax)
+        return 0;
+    if (context->ctx.subnormalize && exp <= context->ctx.emin + 51)
+        return 0;
+
+    r->f->_mpfr_d[0] = (mp_limb_t)(((bits & D53_MANT_MASK) | D53_HIDDEN_BIT) << 11);
+    r->f->_mpfr_exp = exp;
+    r->f->_mpfr_sign = (bits & D53_SIGN_BIT) ? -1 : 1;
+    r->rc = rc;
+    mpfr_clear_flags();
+    if (rc)
+        mpfr_set_inexflag();
+    return 1;
+}
+
+static int
+GMPy_MPFR_D53_Add(MPFR_Object *r, MPFR_Object *x, MPFR_Object *y, int negate,
+                  CTXT_Object *context)
+{
+    double a, b, s, err;
+
+    if (!D53_CONTEXT_OK(r, context) || !d53_get(&a, x->f) || !d53_get(&b, y->f))
+        return 0;
+
+    if (negate)
+        b = -b;
+    D53_TWO_SUM(s, err, a, b);
+    return d53_set(r, s, D53_TERNARY(err), context);
+}
+
+static int
+GMPy_MPFR_D53_Mul(MPFR_Object *r, MPFR_Object *x, MPFR_Object *y, CTXT_Object *context)
+{
+    double a, b, p;
+
+    if (!D53_CONTEXT_OK(r, context) || !d53_get(&a, x->f) || !d53_get(&b, y->f))
+        return 0;
+
+    p = a * b;
+    if (fabs(p) < D53_TINY)
+        return 0;
+    return d53_set(r, p, D53_TERNARY(fma(a, b, -p)), context);
+}
+
+/* The exact error of fma(a, b, c) is ga + a2, following Boldo and Muller,
+ * "Some functions computable with a fused-mac". */
+
+static int
+GMPy_MPFR_D53_FMA(MPFR_Object *r, MPFR_Object *x, MPFR_Object *y, MPFR_Object *z,
+                  CTXT_Object *context)
+{
+    double a, b, c, r1, u1, u2, a1, a2, b1, b2, ga;
+
+    if (!D53_CONTEXT_OK(r, context) || !d53_get(&a, x->f) ||
+        !d53_get(&b, y->f) || !d53_get(&c, z->f))
+        return 0;
+
+    u1 = a * b;
+    if (fabs(u1) < D53_TINY || fabs(u1) > D53_HUGE || fabs(c) > D53_HUGE)
+        return 0;
+
+    r1 = fma(a, b, c);
+    if (fabs(r1) < D53_TINY)
+        return 0;
+
+    u2 = fma(a, b, -u1);
+    D53_TWO_SUM(a1, a2, c, u2);
+    D53_TWO_SUM(b1, b2, u1, a1);
+    ga = (b1 - r1) + b2;
+    return d53_set(r, r1, D53_TERNARY(ga + a2), context);
+}
+
+static int
+GMPy_MPFR_D53_Sqrt(MPFR_Object *r, MPFR_Object *x, CTXT_Object *context)
+{
+    double a, s;
+
+    if (!D53_CONTEXT_OK(r, context) || !d53_get(&a, x->f) || a < D53_TINY)
+        return 0;
+
+    s = sqrt(a);
+    return d53_set(r, s, D53_TERNARY(fma(-s, s, a)), context);
+}
+
+#else
+
+static int
+GMPy_MPFR_D53_Add(MPFR_Object *r, MPFR_Object *x, MPFR_Object *y, int negate,
+                  CTXT_Object *context)
+{
+    return 0;
+}
+
+static int
+GMPy_MPFR_D53_Mul(MPFR_Object *r, MPFR_Object *x, MPFR_Object *y, CTXT_Object *context)
+{
+    return 0;
+}
+
+static int
+GMPy_MPFR_D53_FMA(MPFR_Object *r, MPFR_Object *x, MPFR_Object *y, MPFR_Object *z,
+                  CTXT_Object *context)
+{
+    return 0;
+}
+
+static int
+GMPy_MPFR_D53_Sqrt(MPFR_Object *r, MPFR_Object *x, CTXT_Object *context)
+{
+    return 0;
+}
+
+#endif
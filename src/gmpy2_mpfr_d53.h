@@ -0,0 +1,50 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_mpfr_d53.h                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+#ifndef GMPY_MPFR_D53_H
+#define GMPY_MPFR_D53_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Arithmetic on 53-bit mpfr with hardware doubles. Each function returns 1
+ * after storing a correctly rounded result, its ternary value and the MPFR
+ * flags, or 0 if the operands, the result or the context need the general
+ * MPFR code. Only round-to-nearest at 53 bits is handled.
+ */
+
+static int GMPy_MPFR_D53_Add(MPFR_Object *r, MPFR_Object *x, MPFR_Object *y, int negate, CTXT_Object *context);
+static int GMPy_MPFR_D53_Mul(MPFR_Object *r, MPFR_Object *x, MPFR_Object *y, CTXT_Object *context);
+static int GMPy_MPFR_D53_FMA(MPFR_Object *r, MPFR_Object *x, MPFR_Object *y, MPFR_Object *z, CTXT_Object *context);
+static int GMPy_MPFR_D53_Sqrt(MPFR_Object *r, MPFR_Object *x, CTXT_Object *context);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
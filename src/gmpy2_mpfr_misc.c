@@ -68,11 +68,11 @@ GMPy_Number_F2Q(PyObject *x, PyObject *y, CTXT_Object *context)
 }
 
 static PyObject *
-GMPy_Context_F2Q(PyObject *self, PyObject *args)
+GMPy_Context_F2Q(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     CTXT_Object *context = NULL;
 
-    if (PyTuple_GET_SIZE(args) < 1 || PyTuple_GET_SIZE(args) > 2) {
+    if (nargs < 1 || nargs > 2) {
         TYPE_ERROR("f2q() requires 1 or 2 arguments");
         return NULL;
     }
@@ -84,22 +84,25 @@ GMPy_Context_F2Q(PyObject *self, PyObject *args)
         CHECK_CONTEXT(context);
     }
 
-    if (PyTuple_GET_SIZE(args) == 1) {
-        return GMPy_Number_F2Q(PyTuple_GET_ITEM(args, 0), NULL, context);
+    if (nargs == 1) {
+        return GMPy_Number_F2Q(args[0], NULL, context);
     }
     else {
-        return GMPy_Number_F2Q(PyTuple_GET_ITEM(args, 0), PyTuple_GET_ITEM(args, 1), context);
+        return GMPy_Number_F2Q(args[0], args[1], context);
     }
 }
+GMPY_FASTCALL_WRAPPER(GMPy_Context_F2Q)
 
 PyDoc_STRVAR(GMPy_doc_mpfr_free_cache,
 "free_cache()\n\n"
-"Free the internal cache of constants maintained by MPFR.");
+"Free the internal cache of constants maintained by MPFR and the twiddle\n"
+"factors kept by fft().");
 
 static PyObject *
 GMPy_MPFR_Free_Cache(PyObject *self, PyObject *args)
 {
     mpfr_free_cache();
+    GMPy_FFT_Free_Cache();
     Py_RETURN_NONE;
 }
 
@@ -206,7 +209,7 @@ GMPy_MPFR_get_exp(PyObject *self, PyObject *other)
         result = PyIntOrLong_FromSsize_t(0);
     }
     else {
-        context->ctx.erange = 1;
+        GMPY_FLAGS(context)->erange = 1;
         if (context->ctx.traps & TRAP_ERANGE) {
             GMPY_ERANGE("Can not get exponent from NaN or Infinity.");
         }
@@ -225,7 +228,7 @@ PyDoc_STRVAR(GMPy_doc_mpfr_set_exp,
 "is set.");
 
 static PyObject *
-GMPy_MPFR_set_exp(PyObject *self, PyObject *args)
+GMPy_MPFR_set_exp(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     MPFR_Object *result;
     PyObject *temp;
@@ -234,15 +237,15 @@ GMPy_MPFR_set_exp(PyObject *self, PyObject *args)
 
     CHECK_CONTEXT(context);
 
-    if (PyTuple_GET_SIZE(args) != 2 ||
-        !MPFR_Check(PyTuple_GET_ITEM(args, 0)) ||
-        !PyIntOrLong_Check(PyTuple_GET_ITEM(args, 1))) {
+    if (nargs != 2 ||
+        !MPFR_Check(args[0]) ||
+        !PyIntOrLong_Check(args[1])) {
         TYPE_ERROR("set_exp() requires 'mpfr', 'integer' arguments");
         return NULL;
     }
 
-    temp = PyTuple_GET_ITEM(args, 0);
-    exp = (mpfr_exp_t)PyIntOrLong_AsLong(PyTuple_GET_ITEM(args, 1));
+    temp = args[0];
+    exp = (mpfr_exp_t)PyIntOrLong_AsLong(args[1]);
     if (exp == -1 && PyErr_Occurred()) {
         VALUE_ERROR("exponent too large");
         return NULL;
@@ -264,7 +267,7 @@ GMPy_MPFR_set_exp(PyObject *self, PyObject *args)
     mpfr_set_emax(_oldemax);
 
     if (result->rc) {
-        context->ctx.erange = 1;
+        GMPY_FLAGS(context)->erange = 1;
         if (context->ctx.traps & TRAP_ERANGE) {
             GMPY_ERANGE("new exponent is out-of-bounds");
             Py_DECREF((PyObject*)result);
@@ -274,22 +277,23 @@ GMPy_MPFR_set_exp(PyObject *self, PyObject *args)
 
     return (PyObject*)result;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPFR_set_exp)
 
 PyDoc_STRVAR(GMPy_doc_mpfr_set_sign,
 "set_sign(mpfr, bool) -> mpfr\n\n"
 "If 'bool' is True, then return an 'mpfr' with the sign bit set.");
 
 static PyObject *
-GMPy_MPFR_set_sign(PyObject *self, PyObject *args)
+GMPy_MPFR_set_sign(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     MPFR_Object *result;
     CTXT_Object *context = NULL;
 
     CHECK_CONTEXT(context);
 
-    if (PyTuple_GET_SIZE(args) != 2 ||
-        !MPFR_Check(PyTuple_GET_ITEM(args, 0)) ||
-        !PyIntOrLong_Check(PyTuple_GET_ITEM(args, 1))) {
+    if (nargs != 2 ||
+        !MPFR_Check(args[0]) ||
+        !PyIntOrLong_Check(args[1])) {
         TYPE_ERROR("set_sign() requires 'mpfr', 'boolean' arguments");
         return NULL;
     }
@@ -298,12 +302,13 @@ GMPy_MPFR_set_sign(PyObject *self, PyObject *args)
         return NULL;
     }
 
-    result->rc = mpfr_setsign(MPFR(result), MPFR(PyTuple_GET_ITEM(args, 0)),
-                              PyObject_IsTrue(PyTuple_GET_ITEM(args, 1)),
+    result->rc = mpfr_setsign(MPFR(result), MPFR(args[0]),
+                              PyObject_IsTrue(args[1]),
                               GET_MPFR_ROUND(context));
 
     return (PyObject*)result;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPFR_set_sign)
 
 PyDoc_STRVAR(GMPy_doc_mpfr_copy_sign,
 "copy_sign(mpfr, mpfr) -> mpfr\n\n"
@@ -311,16 +316,16 @@ PyDoc_STRVAR(GMPy_doc_mpfr_copy_sign,
 "second argument.");
 
 static PyObject *
-GMPy_MPFR_copy_sign(PyObject *self, PyObject *args)
+GMPy_MPFR_copy_sign(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     MPFR_Object *result;
     CTXT_Object *context = NULL;
 
     CHECK_CONTEXT(context);
 
-    if (PyTuple_GET_SIZE(args) != 2 ||
-        !MPFR_Check(PyTuple_GET_ITEM(args, 0)) ||
-        !MPFR_Check(PyTuple_GET_ITEM(args, 1))) {
+    if (nargs != 2 ||
+        !MPFR_Check(args[0]) ||
+        !MPFR_Check(args[1])) {
         TYPE_ERROR("copy_sign() requires 'mpfr', 'boolean' arguments");
         return NULL;
     }
@@ -329,12 +334,13 @@ GMPy_MPFR_copy_sign(PyObject *self, PyObject *args)
         return NULL;
     }
 
-    result->rc = mpfr_copysign(MPFR(result), MPFR(PyTuple_GET_ITEM(args, 0)),
-                               MPFR(PyTuple_GET_ITEM(args, 1)),
+    result->rc = mpfr_copysign(MPFR(result), MPFR(args[0]),
+                               MPFR(args[1]),
                                GET_MPFR_ROUND(context));
 
     return (PyObject*)result;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPFR_copy_sign)
 
 PyDoc_STRVAR(GMPy_doc_mpfr_set_nan,
 "nan() -> mpfr\n\n"
@@ -360,7 +366,7 @@ PyDoc_STRVAR(GMPy_doc_mpfr_set_inf,
 "If n is not given, +Infinity is returned.");
 
 static PyObject *
-GMPy_MPFR_set_inf(PyObject *self, PyObject *args)
+GMPy_MPFR_set_inf(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     MPFR_Object *result;
     long s = 1;
@@ -368,8 +374,8 @@ GMPy_MPFR_set_inf(PyObject *self, PyObject *args)
 
     CHECK_CONTEXT(context);
 
-    if (PyTuple_Size(args) == 1) {
-        s = c_long_From_Integer(PyTuple_GET_ITEM(args, 0));
+    if (nargs == 1) {
+        s = c_long_From_Integer(args[0]);
         if (s == -1 && PyErr_Occurred()) {
             return NULL;
         }
@@ -380,6 +386,7 @@ GMPy_MPFR_set_inf(PyObject *self, PyObject *args)
     }
     return (PyObject*)result;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPFR_set_inf)
 
 PyDoc_STRVAR(GMPy_doc_mpfr_set_zero,
 "zero(n) -> mpfr\n\n"
@@ -387,7 +394,7 @@ PyDoc_STRVAR(GMPy_doc_mpfr_set_zero,
 "If n is not given, +0.0 is returned.");
 
 static PyObject *
-GMPy_MPFR_set_zero(PyObject *self, PyObject *args)
+GMPy_MPFR_set_zero(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     MPFR_Object *result;
     long s = 1;
@@ -395,8 +402,8 @@ GMPy_MPFR_set_zero(PyObject *self, PyObject *args)
 
     CHECK_CONTEXT(context);
 
-    if (PyTuple_Size(args) == 1) {
-        s = c_long_From_Integer(PyTuple_GET_ITEM(args, 0));
+    if (nargs == 1) {
+        s = c_long_From_Integer(args[0]);
         if (s == -1 && PyErr_Occurred()) {
             return NULL;
         }
@@ -407,21 +414,17 @@ GMPy_MPFR_set_zero(PyObject *self, PyObject *args)
     }
     return (PyObject*)result;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPFR_set_zero)
 
 PyDoc_STRVAR(GMPy_doc_method_integer_ratio,
 "x.as_integer_ratio() -> (num, den)\n\n"
 "Return the exact rational equivalent of an mpfr. Value is a tuple\n"
 "for compatibility with Python's float.as_integer_ratio().");
 
-/* Note: almost identical code exists in gmpy2_convert_mpfr.c as the
- * function GMPy_MPQ_From_MPFR. They should be refactored.
- */
-
 static PyObject *
 GMPy_MPFR_Integer_Ratio_Method(PyObject *self, PyObject *args)
 {
     MPZ_Object *num, *den;
-    mpfr_exp_t temp, twocount;
     PyObject *result;
     CTXT_Object *context = NULL;
 
@@ -450,17 +453,7 @@ GMPy_MPFR_Integer_Ratio_Method(PyObject *self, PyObject *args)
         mpz_set_ui(den->z, 1);
     }
     else {
-        temp = mpfr_get_z_2exp(num->z, MPFR(self));
-        twocount = (mpfr_exp_t)mpz_scan1(num->z, 0);
-        if (twocount) {
-            temp += twocount;
-            mpz_div_2exp(num->z, num->z, twocount);
-        }
-        mpz_set_ui(den->z, 1);
-        if (temp > 0)
-            mpz_mul_2exp(num->z, num->z, temp);
-        else if (temp < 0)
-            mpz_mul_2exp(den->z, den->z, -temp);
+        mpfr_get_num_den(num->z, den->z, MPFR(self));
     }
     result = Py_BuildValue("(NN)", (PyObject*)num, (PyObject*)den);
     if (!result) {
@@ -34,22 +34,22 @@ extern "C" {
 
 static PyObject * GMPy_Real_F2Q(PyObject *x, PyObject *y, CTXT_Object *context);
 static PyObject * GMPy_Number_F2Q(PyObject *x, PyObject *y, CTXT_Object *context);
-static PyObject * GMPy_Context_F2Q(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_F2Q(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 
 static PyObject * GMPy_MPFR_Free_Cache(PyObject *self, PyObject *args);
 static PyObject * GMPy_MPFR_Can_Round(PyObject *self, PyObject *args);
 static PyObject * GMPy_MPFR_get_emax_max(PyObject *self, PyObject *args);
 static PyObject * GMPy_MPFR_get_max_precision(PyObject *self, PyObject *args);
 static PyObject * GMPy_MPFR_get_exp(PyObject *self, PyObject *other);
-static PyObject * GMPy_MPFR_set_exp(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPFR_set_sign(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPFR_copy_sign(PyObject *self, PyObject *args);
+static PyObject * GMPy_MPFR_set_exp(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPy_MPFR_set_sign(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPy_MPFR_copy_sign(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 static PyObject * GMPy_MPFR_Integer_Ratio_Method(PyObject *self, PyObject *args);
 static PyObject * GMPy_MPFR_Mantissa_Exp_Method(PyObject *self, PyObject *args);
 static PyObject * GMPy_MPFR_Simple_Fraction_Method(PyObject *self, PyObject *args, PyObject *keywds);
 static PyObject * GMPy_MPFR_set_nan(PyObject *self, PyObject *other);
-static PyObject * GMPy_MPFR_set_inf(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPFR_set_zero(PyObject *self, PyObject *args);
+static PyObject * GMPy_MPFR_set_inf(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPy_MPFR_set_zero(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 
 static PyObject * GMPy_MPFR_GetPrec_Attrib(MPFR_Object *self, void *closure);
 static PyObject * GMPy_MPFR_GetRc_Attrib(MPFR_Object *self, void *closure);
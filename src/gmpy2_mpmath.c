@@ -65,7 +65,7 @@ PyDoc_STRVAR(doc_mpmath_normalizeg,
 "_mpmath_normalize(...): helper function for mpmath.");
 
 static PyObject *
-Pympz_mpmath_normalize(PyObject *self, PyObject *args)
+Pympz_mpmath_normalize(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     long sign = 0;
     long bc = 0, prec = 0, shift, zbits, carry = 0;
@@ -74,15 +74,15 @@ Pympz_mpmath_normalize(PyObject *self, PyObject *args)
     char rnd = 0;
     int err1, err2, err3;
 
-    if (PyTuple_GET_SIZE(args) == 6) {
+    if (nargs == 6) {
         /* Need better error-checking here. Under Python 3.0, overflow into
            C-long is possible. */
-        sign = GMPy_Integer_AsLongAndError(PyTuple_GET_ITEM(args, 0), &err1);
-        man = (MPZ_Object *)PyTuple_GET_ITEM(args, 1);
-        exp = PyTuple_GET_ITEM(args, 2);
-        bc = GMPy_Integer_AsLongAndError(PyTuple_GET_ITEM(args, 3), &err2);
-        prec = GMPy_Integer_AsLongAndError(PyTuple_GET_ITEM(args, 4), &err3);
-        rndstr = PyTuple_GET_ITEM(args, 5);
+        sign = GMPy_Integer_AsLongAndError(args[0], &err1);
+        man = (MPZ_Object *)args[1];
+        exp = args[2];
+        bc = GMPy_Integer_AsLongAndError(args[3], &err2);
+        prec = GMPy_Integer_AsLongAndError(args[4], &err3);
+        rndstr = args[5];
         if (err1 || err2 || err3) {
             TYPE_ERROR("arguments long, MPZ_Object*, PyObject*, long, long, char needed");
             return NULL;
@@ -221,12 +221,13 @@ Pympz_mpmath_normalize(PyObject *self, PyObject *args)
     Py_DECREF((PyObject*)lower);
     return mpmath_build_mpf(sign, upper, newexp2, bc);
 }
+GMPY_FASTCALL_WRAPPER(Pympz_mpmath_normalize)
 
 PyDoc_STRVAR(doc_mpmath_createg,
 "_mpmath_create(...): helper function for mpmath.");
 
 static PyObject *
-Pympz_mpmath_create(PyObject *self, PyObject *args)
+Pympz_mpmath_create(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     long sign;
     long bc, shift, zbits, carry = 0, prec = 0;
@@ -236,23 +237,23 @@ Pympz_mpmath_create(PyObject *self, PyObject *args)
 
     const char *rnd = "f";
 
-    if (PyTuple_GET_SIZE(args) < 2) {
+    if (nargs < 2) {
         TYPE_ERROR("mpmath_create() expects 'mpz','int'[,'int','str'] arguments");
         return NULL;
     }
 
-    switch (PyTuple_GET_SIZE(args)) {
+    switch (nargs) {
         case 4:
-            rnd = Py2or3String_AsString(PyTuple_GET_ITEM(args, 3));
+            rnd = Py2or3String_AsString(args[3]);
         case 3:
-            prec = GMPy_Integer_AsLongAndError(PyTuple_GET_ITEM(args, 2), &error);
+            prec = GMPy_Integer_AsLongAndError(args[2], &error);
             if (error)
                 return NULL;
             prec = ABS(prec);
         case 2:
-            exp = PyTuple_GET_ITEM(args, 1);
+            exp = args[1];
         case 1:
-            man = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
+            man = GMPy_MPZ_From_Integer(args[0], NULL);
             if (!man) {
                 TYPE_ERROR("mpmath_create() expects 'mpz','int'[,'int','str'] arguments");
                 return NULL;
@@ -377,3 +378,549 @@ Pympz_mpmath_create(PyObject *self, PyObject *args)
     Py_DECREF((PyObject*)man);
     return mpmath_build_mpf(sign, upper, newexp2, bc);
 }
+GMPY_FASTCALL_WRAPPER(Pympz_mpmath_create)
+
+/* Arithmetic on mpmath's raw (sign, man, exp, bc) tuples. The operation and
+ * the normalization are done in one step, so mpmath's libmpf can call these
+ * instead of computing an unnormalized result in Python and then calling
+ * _mpmath_normalize().
+ *
+ * Exponents are handled as mpz_t so they may be arbitrarily large, as they
+ * may be in mpmath. The special values are recognized by the exponent that
+ * mpmath stores with a zero mantissa.
+ */
+
+#define MPMATH_NAN_EXP   -123
+#define MPMATH_PINF_EXP  -456
+#define MPMATH_NINF_EXP  -789
+
+enum { MPMATH_FINITE, MPMATH_NAN, MPMATH_PINF, MPMATH_NINF };
+
+typedef struct {
+    int sign;
+    int special;
+    mpz_t man;
+    mpz_t exp;
+} mpmath_mpf;
+
+static void
+mpmath_mpf_init(mpmath_mpf *x)
+{
+    x->sign = 0;
+    x->special = MPMATH_FINITE;
+    mpz_init(x->man);
+    mpz_init(x->exp);
+}
+
+static void
+mpmath_mpf_clear(mpmath_mpf *x)
+{
+    mpz_clear(x->man);
+    mpz_clear(x->exp);
+}
+
+static int
+mpmath_set_integer(mpz_t z, PyObject *obj)
+{
+    if (MPZ_Check(obj)) {
+        mpz_set(z, MPZ(obj));
+        return 1;
+    }
+    if (PyIntOrLong_Check(obj)) {
+        mpz_set_PyIntOrLong(z, obj);
+        return 1;
+    }
+    TYPE_ERROR("mpf tuple must contain integers");
+    return 0;
+}
+
+static int
+mpmath_parse(mpmath_mpf *x, PyObject *obj)
+{
+    long sign;
+    int error;
+
+    if (!PyTuple_Check(obj) || PyTuple_GET_SIZE(obj) != 4) {
+        TYPE_ERROR("expected an mpf tuple (sign, man, exp, bc)");
+        return 0;
+    }
+    sign = GMPy_Integer_AsLongAndError(PyTuple_GET_ITEM(obj, 0), &error);
+    if (error) {
+        TYPE_ERROR("mpf tuple must contain integers");
+        return 0;
+    }
+    if (!mpmath_set_integer(x->man, PyTuple_GET_ITEM(obj, 1)) ||
+        !mpmath_set_integer(x->exp, PyTuple_GET_ITEM(obj, 2)))
+        return 0;
+
+    x->sign = (sign != 0);
+    x->special = MPMATH_FINITE;
+    if (!mpz_sgn(x->man)) {
+        x->sign = 0;
+        if (!mpz_cmp_si(x->exp, MPMATH_NAN_EXP))
+            x->special = MPMATH_NAN;
+        else if (!mpz_cmp_si(x->exp, MPMATH_PINF_EXP))
+            x->special = MPMATH_PINF;
+        else if (!mpz_cmp_si(x->exp, MPMATH_NINF_EXP)) {
+            x->special = MPMATH_NINF;
+            x->sign = 1;
+        }
+        mpz_set_ui(x->exp, 0);
+    }
+    else if (mpz_sgn(x->man) < 0) {
+        /* mpmath never makes a negative mantissa, but accept one. */
+        mpz_neg(x->man, x->man);
+        x->sign = !x->sign;
+    }
+    return 1;
+}
+
+static PyObject *
+mpmath_build_special(int special)
+{
+    MPZ_Object *man;
+    PyObject *exp;
+
+    if (!(man = GMPy_MPZ_New(NULL)))
+        return NULL;
+    mpz_set_ui(man->z, 0);
+
+    switch (special) {
+    case MPMATH_NAN:
+        exp = PyIntOrLong_FromLong(MPMATH_NAN_EXP);
+        return exp ? mpmath_build_mpf(0, man, exp, -1) : NULL;
+    case MPMATH_PINF:
+        exp = PyIntOrLong_FromLong(MPMATH_PINF_EXP);
+        return exp ? mpmath_build_mpf(0, man, exp, -2) : NULL;
+    case MPMATH_NINF:
+        exp = PyIntOrLong_FromLong(MPMATH_NINF_EXP);
+        return exp ? mpmath_build_mpf(1, man, exp, -3) : NULL;
+    default:
+        return mpmath_build_mpf(0, man, 0, 0);
+    }
+}
+
+/* Round x to prec bits (prec <= 0 means exactly) in the direction given by
+ * rnd, remove the trailing zero bits, and return the tuple. For division
+ * and square root, the mantissa has at least prec+2 bits and its last bit
+ * is set when the exact result was truncated, so rounding it once gives the
+ * correctly rounded result.
+ */
+static PyObject *
+mpmath_round_build(mpmath_mpf *x, long prec, char rnd)
+{
+    MPZ_Object *man;
+    PyObject *exp;
+    mp_bitcnt_t bc, shift, zbits;
+
+    if (x->special != MPMATH_FINITE)
+        return mpmath_build_special(x->special);
+    if (!mpz_sgn(x->man))
+        return mpmath_build_special(MPMATH_FINITE);
+
+    bc = mpz_sizeinbase(x->man, 2);
+    if (prec > 0 && bc > (mp_bitcnt_t)prec) {
+        shift = bc - prec;
+        switch (rnd) {
+        case 'f':
+            if (x->sign)
+                mpz_cdiv_q_2exp(x->man, x->man, shift);
+            else
+                mpz_fdiv_q_2exp(x->man, x->man, shift);
+            break;
+        case 'c':
+            if (x->sign)
+                mpz_fdiv_q_2exp(x->man, x->man, shift);
+            else
+                mpz_cdiv_q_2exp(x->man, x->man, shift);
+            break;
+        case 'd':
+            mpz_fdiv_q_2exp(x->man, x->man, shift);
+            break;
+        case 'u':
+            mpz_cdiv_q_2exp(x->man, x->man, shift);
+            break;
+        case 'n':
+        default:
+            {
+                int half = mpz_tstbit(x->man, shift - 1);
+                int sticky = mpz_scan1(x->man, 0) < shift - 1;
+
+                mpz_tdiv_q_2exp(x->man, x->man, shift);
+                if (half && (sticky || mpz_odd_p(x->man)))
+                    mpz_add_ui(x->man, x->man, 1);
+            }
+        }
+        mpz_add_ui(x->exp, x->exp, shift);
+    }
+
+    if ((zbits = mpz_scan1(x->man, 0))) {
+        mpz_tdiv_q_2exp(x->man, x->man, zbits);
+        mpz_add_ui(x->exp, x->exp, zbits);
+    }
+
+    if (!(man = GMPy_MPZ_New(NULL)))
+        return NULL;
+    mpz_swap(man->z, x->man);
+    if (!(exp = mpz_get_PyLong(x->exp))) {
+        Py_DECREF((PyObject*)man);
+        return NULL;
+    }
+    return mpmath_build_mpf(x->sign, man, exp, (long)mpz_sizeinbase(man->z, 2));
+}
+
+/* Parse the common arguments: nmpf tuples, the precision and the rounding
+ * mode.
+ */
+static int
+mpmath_parse_args(PyObject *const *args, Py_ssize_t nargs, int nmpf,
+                  mpmath_mpf *x, mpmath_mpf *y, long *prec, char *rnd)
+{
+    const char *mode;
+    int error;
+
+    if (nargs != nmpf + 2) {
+        TYPE_ERROR(nmpf == 2 ? "4 arguments required" : "3 arguments required");
+        return 0;
+    }
+    if (!mpmath_parse(x, args[0]))
+        return 0;
+    if (nmpf == 2 && !mpmath_parse(y, args[1]))
+        return 0;
+
+    *prec = GMPy_Integer_AsLongAndError(args[nmpf], &error);
+    if (error) {
+        TYPE_ERROR("precision must be an integer");
+        return 0;
+    }
+    if (!Py2or3String_Check(args[nmpf + 1])) {
+        VALUE_ERROR("invalid rounding mode specified");
+        return 0;
+    }
+#ifdef PY3
+    if (!(mode = PyUnicode_AsUTF8(args[nmpf + 1])))
+        return 0;
+#else
+    mode = PyString_AsString(args[nmpf + 1]);
+#endif
+    *rnd = mode[0];
+    return 1;
+}
+
+/* Store the shift count in r as an mp_bitcnt_t. */
+static int
+mpmath_get_shift(mp_bitcnt_t *r, mpz_t shift)
+{
+    if (!mpz_fits_ulong_p(shift)) {
+        OVERFLOW_ERROR("exponent difference too large");
+        return 0;
+    }
+    *r = mpz_get_ui(shift);
+    return 1;
+}
+
+static int
+mpmath_add(mpmath_mpf *r, mpmath_mpf *x, mpmath_mpf *y, long prec)
+{
+    mpmath_mpf *t;
+    mpz_t topx, topy, d;
+    mp_bitcnt_t shift, bcx;
+    int ok = 1;
+
+    if (x->special == MPMATH_NAN || y->special == MPMATH_NAN) {
+        r->special = MPMATH_NAN;
+        return 1;
+    }
+    if (x->special != MPMATH_FINITE || y->special != MPMATH_FINITE) {
+        if (x->special != MPMATH_FINITE && y->special != MPMATH_FINITE &&
+            x->special != y->special)
+            r->special = MPMATH_NAN;
+        else
+            r->special = (x->special != MPMATH_FINITE) ? x->special : y->special;
+        return 1;
+    }
+    if (!mpz_sgn(y->man)) {
+        r->sign = x->sign;
+        mpz_set(r->man, x->man);
+        mpz_set(r->exp, x->exp);
+        return 1;
+    }
+    if (!mpz_sgn(x->man)) {
+        r->sign = y->sign;
+        mpz_set(r->man, y->man);
+        mpz_set(r->exp, y->exp);
+        return 1;
+    }
+
+    mpz_init(topx);
+    mpz_init(topy);
+    mpz_init(d);
+    mpz_add_ui(topx, x->exp, mpz_sizeinbase(x->man, 2));
+    mpz_add_ui(topy, y->exp, mpz_sizeinbase(y->man, 2));
+    if (mpz_cmp(topx, topy) < 0) {
+        t = x; x = y; y = t;
+        mpz_swap(topx, topy);
+    }
+    bcx = mpz_sizeinbase(x->man, 2);
+
+    /* If y is below both the last bit of x and the rounding position, it
+     * only decides the direction of rounding, so a sticky bit can take its
+     * place. This avoids shifting x by a huge exponent difference.
+     */
+    if (prec > 0) {
+        mpz_sub_ui(d, topx, prec + 2);
+        if (mpz_cmp(x->exp, d) < 0)
+            mpz_set(d, x->exp);
+    }
+    if (prec > 0 && mpz_cmp(topy, d) < 0) {
+        shift = bcx + 2 < (mp_bitcnt_t)prec + 3 ? prec + 3 - bcx : 2;
+        mpz_mul_2exp(r->man, x->man, shift);
+        if (x->sign == y->sign)
+            mpz_add_ui(r->man, r->man, 1);
+        else
+            mpz_sub_ui(r->man, r->man, 1);
+        mpz_sub_ui(r->exp, x->exp, shift);
+        r->sign = x->sign;
+        goto done;
+    }
+
+    /* Exact sum, aligned to the smaller exponent. */
+    mpz_sub(d, x->exp, y->exp);
+    if (mpz_sgn(d) < 0) {
+        t = x; x = y; y = t;
+        mpz_neg(d, d);
+    }
+    if (!(ok = mpmath_get_shift(&shift, d)))
+        goto done;
+    mpz_mul_2exp(r->man, x->man, shift);
+    if (x->sign)
+        mpz_neg(r->man, r->man);
+    if (y->sign)
+        mpz_sub(r->man, r->man, y->man);
+    else
+        mpz_add(r->man, r->man, y->man);
+    mpz_set(r->exp, y->exp);
+    r->sign = mpz_sgn(r->man) < 0;
+    mpz_abs(r->man, r->man);
+
+  done:
+    mpz_clear(topx);
+    mpz_clear(topy);
+    mpz_clear(d);
+    return ok;
+}
+
+static void
+mpmath_mul(mpmath_mpf *r, mpmath_mpf *x, mpmath_mpf *y)
+{
+    if (x->special == MPMATH_NAN || y->special == MPMATH_NAN) {
+        r->special = MPMATH_NAN;
+        return;
+    }
+    r->sign = x->sign != y->sign;
+    if (x->special != MPMATH_FINITE || y->special != MPMATH_FINITE) {
+        if (!mpz_sgn(x->man) && x->special == MPMATH_FINITE)
+            r->special = MPMATH_NAN;
+        else if (!mpz_sgn(y->man) && y->special == MPMATH_FINITE)
+            r->special = MPMATH_NAN;
+        else
+            r->special = r->sign ? MPMATH_NINF : MPMATH_PINF;
+        return;
+    }
+    mpz_mul(r->man, x->man, y->man);
+    mpz_add(r->exp, x->exp, y->exp);
+}
+
+/* Divide x by y with at least prec+3 bits and a sticky bit. */
+static int
+mpmath_div(mpmath_mpf *r, mpmath_mpf *x, mpmath_mpf *y, long prec)
+{
+    mp_bitcnt_t bcx, bcy, shift = 0;
+    mpz_t rem;
+
+    if (y->special == MPMATH_FINITE && !mpz_sgn(y->man)) {
+        ZERO_ERROR("division by zero");
+        return 0;
+    }
+    if (x->special == MPMATH_NAN || y->special == MPMATH_NAN) {
+        r->special = MPMATH_NAN;
+        return 1;
+    }
+    r->sign = x->sign != y->sign;
+    if (x->special != MPMATH_FINITE) {
+        if (y->special != MPMATH_FINITE)
+            r->special = MPMATH_NAN;
+        else
+            r->special = r->sign ? MPMATH_NINF : MPMATH_PINF;
+        return 1;
+    }
+    if (y->special != MPMATH_FINITE || !mpz_sgn(x->man)) {
+        r->sign = 0;
+        mpz_set_ui(r->man, 0);
+        return 1;
+    }
+
+    bcx = mpz_sizeinbase(x->man, 2);
+    bcy = mpz_sizeinbase(y->man, 2);
+    if (bcx < (mp_bitcnt_t)prec + 3 + bcy)
+        shift = prec + 3 + bcy - bcx;
+
+    mpz_init(rem);
+    mpz_mul_2exp(r->man, x->man, shift);
+    mpz_tdiv_qr(r->man, rem, r->man, y->man);
+    mpz_sub(r->exp, x->exp, y->exp);
+    mpz_sub_ui(r->exp, r->exp, shift);
+    if (mpz_sgn(rem)) {
+        mpz_mul_2exp(r->man, r->man, 1);
+        mpz_add_ui(r->man, r->man, 1);
+        mpz_sub_ui(r->exp, r->exp, 1);
+    }
+    mpz_clear(rem);
+    return 1;
+}
+
+/* Square root of x with at least prec+3 bits and a sticky bit. */
+static int
+mpmath_sqrt(mpmath_mpf *r, mpmath_mpf *x, long prec)
+{
+    mp_bitcnt_t bcx, shift = 0;
+    mpz_t rem;
+
+    if (x->special == MPMATH_NAN || x->special == MPMATH_PINF) {
+        r->special = x->special;
+        return 1;
+    }
+    if (x->special == MPMATH_NINF || x->sign) {
+        VALUE_ERROR("square root of a negative number");
+        return 0;
+    }
+    if (!mpz_sgn(x->man)) {
+        mpz_set_ui(r->man, 0);
+        return 1;
+    }
+
+    bcx = mpz_sizeinbase(x->man, 2);
+    if (bcx < 2 * (mp_bitcnt_t)prec + 6)
+        shift = 2 * prec + 6 - bcx;
+    /* The exponent of the radicand must be even. */
+    if (mpz_odd_p(x->exp) != (int)(shift & 1))
+        shift++;
+
+    mpz_init(rem);
+    mpz_mul_2exp(r->man, x->man, shift);
+    mpz_sqrtrem(r->man, rem, r->man);
+    mpz_sub_ui(r->exp, x->exp, shift);
+    mpz_divexact_ui(r->exp, r->exp, 2);
+    if (mpz_sgn(rem)) {
+        mpz_mul_2exp(r->man, r->man, 1);
+        mpz_add_ui(r->man, r->man, 1);
+        mpz_sub_ui(r->exp, r->exp, 1);
+    }
+    mpz_clear(rem);
+    return 1;
+}
+
+PyDoc_STRVAR(doc_mpmath_addg,
+"_mpmath_add(s, t, prec, rnd): helper function for mpmath.\n\n"
+"Return the mpf tuple s+t rounded to prec bits (exactly if prec is 0).");
+
+static PyObject *
+Pympz_mpmath_add(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    mpmath_mpf x, y, r;
+    PyObject *result = NULL;
+    long prec;
+    char rnd;
+
+    mpmath_mpf_init(&x);
+    mpmath_mpf_init(&y);
+    mpmath_mpf_init(&r);
+    if (mpmath_parse_args(args, nargs, 2, &x, &y, &prec, &rnd) &&
+        mpmath_add(&r, &x, &y, prec))
+        result = mpmath_round_build(&r, prec, rnd);
+    mpmath_mpf_clear(&x);
+    mpmath_mpf_clear(&y);
+    mpmath_mpf_clear(&r);
+    return result;
+}
+GMPY_FASTCALL_WRAPPER(Pympz_mpmath_add)
+
+PyDoc_STRVAR(doc_mpmath_mulg,
+"_mpmath_mul(s, t, prec, rnd): helper function for mpmath.\n\n"
+"Return the mpf tuple s*t rounded to prec bits (exactly if prec is 0).");
+
+static PyObject *
+Pympz_mpmath_mul(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    mpmath_mpf x, y, r;
+    PyObject *result = NULL;
+    long prec;
+    char rnd;
+
+    mpmath_mpf_init(&x);
+    mpmath_mpf_init(&y);
+    mpmath_mpf_init(&r);
+    if (mpmath_parse_args(args, nargs, 2, &x, &y, &prec, &rnd)) {
+        mpmath_mul(&r, &x, &y);
+        result = mpmath_round_build(&r, prec, rnd);
+    }
+    mpmath_mpf_clear(&x);
+    mpmath_mpf_clear(&y);
+    mpmath_mpf_clear(&r);
+    return result;
+}
+GMPY_FASTCALL_WRAPPER(Pympz_mpmath_mul)
+
+PyDoc_STRVAR(doc_mpmath_divg,
+"_mpmath_div(s, t, prec, rnd): helper function for mpmath.\n\n"
+"Return the mpf tuple s/t correctly rounded to prec bits.");
+
+static PyObject *
+Pympz_mpmath_div(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    mpmath_mpf x, y, r;
+    PyObject *result = NULL;
+    long prec;
+    char rnd;
+
+    mpmath_mpf_init(&x);
+    mpmath_mpf_init(&y);
+    mpmath_mpf_init(&r);
+    if (mpmath_parse_args(args, nargs, 2, &x, &y, &prec, &rnd)) {
+        if (prec <= 0)
+            VALUE_ERROR("division requires a positive precision");
+        else if (mpmath_div(&r, &x, &y, prec))
+            result = mpmath_round_build(&r, prec, rnd);
+    }
+    mpmath_mpf_clear(&x);
+    mpmath_mpf_clear(&y);
+    mpmath_mpf_clear(&r);
+    return result;
+}
+GMPY_FASTCALL_WRAPPER(Pympz_mpmath_div)
+
+PyDoc_STRVAR(doc_mpmath_sqrtg,
+"_mpmath_sqrt(s, prec, rnd): helper function for mpmath.\n\n"
+"Return the square root of the mpf tuple s correctly rounded to prec bits.");
+
+static PyObject *
+Pympz_mpmath_sqrt(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    mpmath_mpf x, r;
+    PyObject *result = NULL;
+    long prec;
+    char rnd;
+
+    mpmath_mpf_init(&x);
+    mpmath_mpf_init(&r);
+    if (mpmath_parse_args(args, nargs, 1, &x, NULL, &prec, &rnd)) {
+        if (prec <= 0)
+            VALUE_ERROR("square root requires a positive precision");
+        else if (mpmath_sqrt(&r, &x, prec))
+            result = mpmath_round_build(&r, prec, rnd);
+    }
+    mpmath_mpf_clear(&x);
+    mpmath_mpf_clear(&r);
+    return result;
+}
+GMPY_FASTCALL_WRAPPER(Pympz_mpmath_sqrt)
@@ -32,15 +32,8 @@
 extern "C" {
 #endif
 
-typedef struct {
-    PyObject_HEAD
-    mpq_t q;
-    Py_hash_t  hash_cache;
-} MPQ_Object;
-
+/* MPQ_Object, MPQ() and MPQ_Check() are defined in gmpy2_capi.h. */
 static PyTypeObject MPQ_Type;
-#define MPQ(obj) (((MPQ_Object *)(obj))->q)
-#define MPQ_Check(v) (((PyObject*)v)->ob_type == &MPQ_Type)
 
 static PyObject * GMPy_MPQ_Factory(PyObject *self, PyObject *args, PyObject *keywds);
 
@@ -101,7 +101,7 @@ PyDoc_STRVAR(GMPy_doc_function_qdiv,
 "divisible by y.");
 
 static PyObject *
-GMPy_MPQ_Function_Qdiv(PyObject *self, PyObject *args)
+GMPy_MPQ_Function_Qdiv(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     Py_ssize_t argc;
     int isOne = 0;
@@ -113,17 +113,17 @@ GMPy_MPQ_Function_Qdiv(PyObject *self, PyObject *args)
 
     /* Validate the argument(s). */
 
-    argc = PyTuple_GET_SIZE(args);
+    argc = nargs;
     if (argc == 1) {
-        x = PyTuple_GET_ITEM(args, 0);
+        x = args[0];
         isOne = 1;
         if (!IS_RATIONAL(x)) {
             goto arg_error;
         }
     }
     else if (argc == 2) {
-        x = PyTuple_GET_ITEM(args, 0);
-        y = PyTuple_GET_ITEM(args, 1);
+        x = args[0];
+        y = args[1];
         if (!IS_RATIONAL(x) || !IS_RATIONAL(y)) {
             goto arg_error;
         }
@@ -196,6 +196,7 @@ GMPy_MPQ_Function_Qdiv(PyObject *self, PyObject *args)
     TYPE_ERROR("qdiv() requires 1 or 2 integer or rational arguments");
     return NULL;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPQ_Function_Qdiv)
 
 PyDoc_STRVAR(GMPy_doc_mpq_method_floor,
 "Return greatest integer less than or equal to an mpq.");
@@ -355,3 +356,336 @@ GMPy_MPQ_Method_Sizeof(PyObject *self, PyObject *other)
         (mpq_denref(MPQ(self))->_mp_alloc * sizeof(mp_limb_t)));
 }
 
+
+PyDoc_STRVAR(GMPy_doc_function_mpq_many,
+"mpq_many(iterable[, base=10]) -> list\n\n"
+"Return a list with mpq(x, base) for each string x in iterable, or\n"
+"mpq(x) for each number. Equivalent to [mpq(x, base) for x in iterable]\n"
+"but avoids the cost of calling mpq() for each item.");
+
+static PyObject *
+GMPy_MPQ_Function_Many(PyObject *self, PyObject *args)
+{
+    PyObject *seq, *result, *item;
+    MPQ_Object *temp;
+    Py_ssize_t i, n;
+    int base = 10;
+    CTXT_Object *context = NULL;
+
+    if (!PyArg_ParseTuple(args, "O|i", &seq, &base))
+        return NULL;
+
+    if ((base != 0) && ((base < 2) || (base > 62))) {
+        VALUE_ERROR("base for mpq() must be 0 or in the interval [2, 62]");
+        return NULL;
+    }
+
+    CHECK_CONTEXT(context);
+
+    if (!(seq = PySequence_Fast(seq, "mpq_many() requires an iterable")))
+        return NULL;
+
+    n = PySequence_Fast_GET_SIZE(seq);
+    if (!(result = PyList_New(n))) {
+        Py_DECREF(seq);
+        return NULL;
+    }
+
+    for (i = 0; i < n; i++) {
+        item = PySequence_Fast_GET_ITEM(seq, i);
+        if (PyStrOrUnicode_Check(item)) {
+            temp = GMPy_MPQ_From_PyStr(item, base, context);
+        }
+        else if (IS_REAL(item)) {
+            temp = GMPy_MPQ_From_Number(item, context);
+        }
+        else {
+            TYPE_ERROR("mpq_many() requires strings or real numbers");
+            temp = NULL;
+        }
+        if (!temp) {
+            Py_DECREF(result);
+            Py_DECREF(seq);
+            return NULL;
+        }
+        PyList_SET_ITEM(result, i, (PyObject*)temp);
+    }
+    Py_DECREF(seq);
+    return result;
+}
+
+/* Sums of rationals are formed in a balanced tree over unreduced terms.
+ * Each merge puts both terms over the lcm of their denominators, which
+ * costs one gcd of the denominators and skips the second gcd that mpq_add
+ * needs to keep the result canonical. Every denominator in the tree
+ * divides the lcm of the input denominators, so the terms stay bounded
+ * and the result is reduced once at the end.
+ *
+ * The tree is built like a binary counter: level k holds the sum of 2**k
+ * consecutive terms, and a new term is carried up through the occupied
+ * levels. Only one term per level is kept and the level storage is reused,
+ * so the input is consumed from an iterator without copying it.
+ */
+
+#define QSUM_LEVELS (8 * (int)sizeof(Py_ssize_t))
+
+typedef struct {
+    mpq_t level[QSUM_LEVELS];
+    mpq_t term;
+    mpz_t g, t;
+    Py_ssize_t count;
+} qsum_state;
+
+static void
+qsum_init(qsum_state *s)
+{
+    int k;
+
+    for (k = 0; k < QSUM_LEVELS; k++) {
+        mpq_init(s->level[k]);
+    }
+    mpq_init(s->term);
+    mpz_init(s->g);
+    mpz_init(s->t);
+    s->count = 0;
+}
+
+static void
+qsum_clear(qsum_state *s)
+{
+    int k;
+
+    for (k = 0; k < QSUM_LEVELS; k++) {
+        mpq_clear(s->level[k]);
+    }
+    mpq_clear(s->term);
+    mpz_clear(s->g);
+    mpz_clear(s->t);
+}
+
+/* x += y, leaving x unreduced. */
+
+static void
+qsum_merge(mpq_ptr x, mpq_srcptr y, mpz_ptr g, mpz_ptr t)
+{
+    mpz_ptr xn = mpq_numref(x), xd = mpq_denref(x);
+    mpz_srcptr yn = mpq_numref(y), yd = mpq_denref(y);
+
+    if (!mpz_cmp(xd, yd)) {
+        mpz_add(xn, xn, yn);
+    }
+    else if (!mpz_cmp_ui(yd, 1)) {
+        mpz_addmul(xn, yn, xd);
+    }
+    else if (!mpz_cmp_ui(xd, 1)) {
+        mpz_mul(xn, xn, yd);
+        mpz_add(xn, xn, yn);
+        mpz_set(xd, yd);
+    }
+    else {
+        mpz_gcd(g, xd, yd);
+        if (!mpz_cmp_ui(g, 1)) {
+            mpz_mul(xn, xn, yd);
+            mpz_addmul(xn, yn, xd);
+            mpz_mul(xd, xd, yd);
+        }
+        else {
+            mpz_divexact(t, yd, g);
+            mpz_divexact(g, xd, g);
+            mpz_mul(xn, xn, t);
+            mpz_addmul(xn, yn, g);
+            mpz_mul(xd, xd, t);
+        }
+    }
+}
+
+static size_t
+qsum_bits(mpq_srcptr x)
+{
+    return (mpz_size(mpq_numref(x)) + mpz_size(mpq_denref(x))) * GMP_NUMB_BITS;
+}
+
+/* Carry s->term into the levels. Level k is occupied if bit k of the
+ * number of terms already added is set. */
+
+static void
+qsum_push(qsum_state *s)
+{
+    Py_ssize_t count = s->count;
+    int k = 0;
+
+    while (count & 1) {
+        GMPY_BEGIN_NOGIL(qsum_bits(s->level[k]));
+        qsum_merge(s->level[k], s->term, s->g, s->t);
+        GMPY_END_NOGIL;
+        mpq_swap(s->level[k], s->term);
+        count >>= 1;
+        k++;
+    }
+    mpq_swap(s->level[k], s->term);
+    s->count++;
+}
+
+/* Add up the occupied levels and return the reduced sum. */
+
+static PyObject *
+qsum_result(qsum_state *s, CTXT_Object *context)
+{
+    MPQ_Object *result;
+    Py_ssize_t count = s->count;
+    int k;
+
+    mpq_set_ui(s->term, 0, 1);
+    for (k = 0; count; k++, count >>= 1) {
+        if (count & 1) {
+            GMPY_BEGIN_NOGIL(qsum_bits(s->level[k]));
+            qsum_merge(s->term, s->level[k], s->g, s->t);
+            GMPY_END_NOGIL;
+        }
+    }
+    GMPY_BEGIN_NOGIL(qsum_bits(s->term));
+    mpq_canonicalize(s->term);
+    GMPY_END_NOGIL;
+
+    if ((result = GMPy_MPQ_New(context))) {
+        mpq_swap(result->q, s->term);
+    }
+    return (PyObject*)result;
+}
+
+/* Store the rational item in out. Returns 0 on success or -1 with an
+ * exception set. Steals the reference to item. */
+
+static int
+qsum_item(PyObject *item, mpq_ptr out, const char *name, CTXT_Object *context)
+{
+    MPQ_Object *temp;
+
+    if (MPQ_Check(item)) {
+        mpq_set(out, MPQ(item));
+        Py_DECREF(item);
+        return 0;
+    }
+    if (!IS_RATIONAL(item)) {
+        PyErr_Format(PyExc_TypeError, "%s() requires rational arguments", name);
+        Py_DECREF(item);
+        return -1;
+    }
+    temp = GMPy_MPQ_From_Rational(item, context);
+    Py_DECREF(item);
+    if (!temp)
+        return -1;
+    mpq_swap(out, temp->q);
+    Py_DECREF((PyObject*)temp);
+    return 0;
+}
+
+PyDoc_STRVAR(GMPy_doc_function_qsum,
+"qsum(iterable) -> mpq\n\n"
+"Return the exact sum of the rational numbers in iterable. The terms\n"
+"are added in a balanced tree without reducing the partial sums, so\n"
+"the result is reduced only once.");
+
+static PyObject *
+GMPy_MPQ_Function_Qsum(PyObject *self, PyObject *other)
+{
+    PyObject *iter, *item, *result = NULL;
+    qsum_state s;
+    CTXT_Object *context = NULL;
+
+    CHECK_CONTEXT(context);
+
+    if (!(iter = PyObject_GetIter(other))) {
+        PyErr_Clear();
+        TYPE_ERROR("qsum() requires an iterable");
+        return NULL;
+    }
+
+    qsum_init(&s);
+    while ((item = PyIter_Next(iter))) {
+        if (qsum_item(item, s.term, "qsum", context))
+            goto done;
+        qsum_push(&s);
+    }
+    if (!PyErr_Occurred()) {
+        result = qsum_result(&s, context);
+    }
+
+  done:
+    qsum_clear(&s);
+    Py_DECREF(iter);
+    return result;
+}
+
+PyDoc_STRVAR(GMPy_doc_function_qdot,
+"qdot(xs, ys) -> mpq\n\n"
+"Return the exact sum of x*y for the pairs of rational numbers in xs\n"
+"and ys, which must have the same length. The products are summed as\n"
+"in qsum().");
+
+static PyObject *
+GMPy_MPQ_Function_Qdot(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *xs, *ys, *x, *y, *result = NULL;
+    qsum_state s;
+    mpq_t temp;
+    CTXT_Object *context = NULL;
+
+    if (nargs != 2) {
+        TYPE_ERROR("qdot() requires 2 arguments");
+        return NULL;
+    }
+
+    CHECK_CONTEXT(context);
+
+    if (!(xs = PyObject_GetIter(args[0]))) {
+        PyErr_Clear();
+        TYPE_ERROR("qdot() requires iterables");
+        return NULL;
+    }
+    if (!(ys = PyObject_GetIter(args[1]))) {
+        PyErr_Clear();
+        TYPE_ERROR("qdot() requires iterables");
+        Py_DECREF(xs);
+        return NULL;
+    }
+
+    qsum_init(&s);
+    mpq_init(temp);
+    while (1) {
+        x = PyIter_Next(xs);
+        if (!x && PyErr_Occurred())
+            goto done;
+        y = PyIter_Next(ys);
+        if (!y && PyErr_Occurred()) {
+            Py_XDECREF(x);
+            goto done;
+        }
+        if (!x || !y) {
+            if (x || y) {
+                Py_XDECREF(x);
+                Py_XDECREF(y);
+                VALUE_ERROR("qdot() requires sequences of the same length");
+                goto done;
+            }
+            break;
+        }
+        if (qsum_item(x, s.term, "qdot", context)) {
+            Py_DECREF(y);
+            goto done;
+        }
+        if (qsum_item(y, temp, "qdot", context))
+            goto done;
+        mpq_mul(s.term, s.term, temp);
+        qsum_push(&s);
+    }
+    result = qsum_result(&s, context);
+
+  done:
+    mpq_clear(temp);
+    qsum_clear(&s);
+    Py_DECREF(xs);
+    Py_DECREF(ys);
+    return result;
+}
+GMPY_FASTCALL_WRAPPER(GMPy_MPQ_Function_Qdot)
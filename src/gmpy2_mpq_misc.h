@@ -36,12 +36,15 @@ static PyObject * GMPy_MPQ_Attrib_GetNumer(MPQ_Object *self, void *closure);
 static PyObject * GMPy_MPQ_Attrib_GetDenom(MPQ_Object *self, void *closure);
 static PyObject * GMPy_MPQ_Function_Numer(PyObject *self, PyObject *other);
 static PyObject * GMPy_MPQ_Function_Denom(PyObject *self, PyObject *other);
-static PyObject * GMPy_MPQ_Function_Qdiv(PyObject *self, PyObject *args);
+static PyObject * GMPy_MPQ_Function_Qdiv(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 static PyObject * GMPy_MPQ_Method_Ceil(PyObject *self, PyObject *other);
 static PyObject * GMPy_MPQ_Method_Floor(PyObject *self, PyObject *other);
 static PyObject * GMPy_MPQ_Method_Trunc(PyObject *self, PyObject *other);
 static PyObject * GMPy_MPQ_Method_Round(PyObject *self, PyObject *other);
 static int        GMPy_MPQ_NonZero_Slot(MPQ_Object *x);
+static PyObject * GMPy_MPQ_Function_Many(PyObject *self, PyObject *args);
+static PyObject * GMPy_MPQ_Function_Qsum(PyObject *self, PyObject *other);
+static PyObject * GMPy_MPQ_Function_Qdot(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 
 #ifdef __cplusplus
 }
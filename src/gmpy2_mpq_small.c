@@ -0,0 +1,169 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_mpq_small.c                                                       *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* Rationals of one limb, see gmpy2_mpq_small.h. The gcds are computed
+ * with mpn_gcd_1(), which uses a binary algorithm on a single limb.
+ */
+
+typedef struct {
+    mp_limb_t num;              /* absolute value of the numerator */
+    mp_limb_t den;
+    int neg;
+} small_q;
+
+static int
+small_q_get(small_q *s, mpq_srcptr q)
+{
+    if (mpz_size(mpq_numref(q)) > 1 || mpz_size(mpq_denref(q)) != 1)
+        return 0;
+    s->num = mpz_getlimbn(mpq_numref(q), 0);
+    s->den = mpz_getlimbn(mpq_denref(q), 0);
+    s->neg = mpz_sgn(mpq_numref(q)) < 0;
+    return 1;
+}
+
+static void
+small_q_set(mpq_ptr r, mp_limb_t num, mp_limb_t den, int neg)
+{
+    if (num == 0) {
+        mpz_set_ui(mpq_numref(r), 0);
+        mpz_set_ui(mpq_denref(r), 1);
+        return;
+    }
+    mpz_limbs_write(mpq_numref(r), 1)[0] = num;
+    mpz_limbs_finish(mpq_numref(r), neg ? -1 : 1);
+    mpz_limbs_write(mpq_denref(r), 1)[0] = den;
+    mpz_limbs_finish(mpq_denref(r), 1);
+}
+
+/* Set *r to a * b or a + b and return 1, or return 0 on overflow. */
+
+static int
+limb_mul(mp_limb_t a, mp_limb_t b, mp_limb_t *r)
+{
+#if (defined(__GNUC__) && __GNUC__ >= 5) || defined(__clang__)
+    return !__builtin_mul_overflow(a, b, r);
+#else
+    if (b && a > GMP_NUMB_MAX / b)
+        return 0;
+    *r = a * b;
+    return 1;
+#endif
+}
+
+static int
+limb_add(mp_limb_t a, mp_limb_t b, mp_limb_t *r)
+{
+    *r = a + b;
+    return *r >= a;
+}
+
+static mp_limb_t
+limb_gcd(mp_limb_t a, mp_limb_t b)
+{
+    if (a == 0)
+        return b;
+    if (b == 0)
+        return a;
+    return mpn_gcd_1(&a, 1, b);
+}
+
+/* r = x + y, or x - y if 'sub' is set. With g = gcd(b, d), the sum of a/b
+ * and c/d is t / (b/g * d) where t = a*(d/g) + c*(b/g), and only a factor
+ * of g can be shared by t and the denominator (Knuth, TAOCP 4.5.1). */
+
+static int
+GMPy_MPQ_Small_Add(mpq_ptr r, mpq_srcptr x, mpq_srcptr y, int sub)
+{
+    small_q a, c;
+    mp_limb_t g, b1, p, q, t, den;
+    int neg;
+
+    if (!small_q_get(&a, x) || !small_q_get(&c, y))
+        return 0;
+    c.neg ^= sub;
+
+    g = limb_gcd(a.den, c.den);
+    b1 = a.den / g;
+    if (!limb_mul(a.num, c.den / g, &p) || !limb_mul(c.num, b1, &q))
+        return 0;
+
+    if (a.neg == c.neg) {
+        if (!limb_add(p, q, &t))
+            return 0;
+        neg = a.neg;
+    }
+    else if (p >= q) {
+        t = p - q;
+        neg = a.neg;
+    }
+    else {
+        t = q - p;
+        neg = c.neg;
+    }
+
+    if (t == 0) {
+        small_q_set(r, 0, 1, 0);
+        return 1;
+    }
+    g = limb_gcd(t, g);
+    if (!limb_mul(b1, c.den / g, &den))
+        return 0;
+    small_q_set(r, t / g, den, neg);
+    return 1;
+}
+
+/* r = x * y, or x / y if 'div' is set; y must not be 0 for a division.
+ * Cancelling gcd(a, d) and gcd(c, b) first leaves a reduced product. */
+
+static int
+GMPy_MPQ_Small_Mul(mpq_ptr r, mpq_srcptr x, mpq_srcptr y, int div)
+{
+    small_q a, c;
+    mp_limb_t g1, g2, num, den, temp;
+
+    if (!small_q_get(&a, x) || !small_q_get(&c, y))
+        return 0;
+    if (div) {
+        temp = c.num;
+        c.num = c.den;
+        c.den = temp;
+    }
+
+    if (a.num == 0 || c.num == 0) {
+        small_q_set(r, 0, 1, 0);
+        return 1;
+    }
+
+    g1 = limb_gcd(a.num, c.den);
+    g2 = limb_gcd(c.num, a.den);
+    if (!limb_mul(a.num / g1, c.num / g2, &num) ||
+        !limb_mul(a.den / g2, c.den / g1, &den))
+        return 0;
+    small_q_set(r, num, den, a.neg != c.neg);
+    return 1;
+}
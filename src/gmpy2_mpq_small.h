@@ -0,0 +1,50 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_mpq_small.h                                                       *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GMPY_MPQ_SMALL_H
+#define GMPY_MPQ_SMALL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Arithmetic on rationals whose numerator and denominator each fit in one
+ * limb is done with single limb operations that check for overflow. The
+ * reduced result is stored directly, so mpq_canonicalize() and the
+ * temporaries used by mpq_add() and friends are avoided. Each function
+ * returns 1 if it stored the result and 0 if the operands are too large or
+ * the result would overflow; the caller then uses the mpq_* function.
+ * 'r' must not be the same as 'x' or 'y'.
+ */
+
+static int GMPy_MPQ_Small_Add(mpq_ptr r, mpq_srcptr x, mpq_srcptr y, int sub);
+static int GMPy_MPQ_Small_Mul(mpq_ptr r, mpq_srcptr x, mpq_srcptr y, int div);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -39,6 +39,29 @@ PyDoc_STRVAR(GMPy_doc_mpz_factory,
 "     the string is assumed to be decimal. Values for base can range\n"
 "     between 2 and 62.");
 
+/* Convert the single positional argument of mpz(). */
+
+static PyObject *
+GMPy_MPZ_Factory_One(PyObject *n, CTXT_Object *context)
+{
+    if (PyIntOrLong_Check(n)) {
+        int error;
+        long temp = GMPy_Integer_AsLongAndError(n, &error);
+
+        if (!error && MPZ_IS_SMALL(temp))
+            return (PyObject*)GMPy_MPZ_Small(temp);
+        return (PyObject*)GMPy_MPZ_From_PyIntOrLong(n, context);
+    }
+    if (IS_REAL(n)) {
+        return (PyObject*)GMPy_MPZ_From_Number(n, context);
+    }
+    if (PyStrOrUnicode_Check(n)) {
+        return (PyObject*)GMPy_MPZ_From_PyStr(n, 0, context);
+    }
+    TYPE_ERROR("mpz() requires numeric or string argument");
+    return NULL;
+}
+
 static PyObject *
 GMPy_MPZ_Factory(PyObject *self, PyObject *args, PyObject *keywds)
 {
@@ -56,24 +79,11 @@ GMPy_MPZ_Factory(PyObject *self, PyObject *args, PyObject *keywds)
     argc = PyTuple_GET_SIZE(args);
     
     if (argc == 0) {
-        if ((result = GMPy_MPZ_New(context))) {
-            mpz_set_ui(result->z, 0);
-        }
-        return (PyObject*)result;
+        return (PyObject*)GMPy_MPZ_Small(0);
     }
 
     if (argc == 1 && !keywds) {
-        n = PyTuple_GET_ITEM(args, 0);
-        if (IS_REAL(n)) {
-            result = GMPy_MPZ_From_Number(n, context);
-        }
-        else if (PyStrOrUnicode_Check(n)) {
-            result = GMPy_MPZ_From_PyStr(n, base, context);
-        }
-        else {
-            TYPE_ERROR("mpz() requires numeric or string argument");
-        }
-        return (PyObject*)result;
+        return GMPy_MPZ_Factory_One(PyTuple_GET_ITEM(args, 0), context);
     }
 
     if (!PyArg_ParseTupleAndKeywords(args, keywds, "O|i", kwlist, &n, &base)) {
@@ -97,6 +107,26 @@ GMPy_MPZ_Factory(PyObject *self, PyObject *args, PyObject *keywds)
     return (PyObject*)result;
 }
 
+#if PY_VERSION_HEX >= 0x03070000
+static PyObject *
+GMPy_MPZ_Factory_FastCall(PyObject *self, PyObject *const *args,
+                          Py_ssize_t nargs, PyObject *kwnames)
+{
+    CTXT_Object *context = NULL;
+
+    if (nargs == 0 && !kwnames) {
+        return (PyObject*)GMPy_MPZ_Small(0);
+    }
+
+    if (nargs == 1 && !kwnames) {
+        CHECK_CONTEXT(context);
+        return GMPy_MPZ_Factory_One(args[0], context);
+    }
+
+    return GMPy_FastCall_Keywords(GMPy_MPZ_Factory, self, args, nargs, kwnames);
+}
+#endif
+
 #ifdef PY3
 static PyNumberMethods GMPy_MPZ_number_methods =
 {
@@ -181,6 +211,14 @@ static PyNumberMethods GMPy_MPZ_number_methods =
 };
 #endif
 
+#ifdef PY3
+static PyBufferProcs GMPy_MPZ_buffer_methods =
+{
+    (getbufferproc) GMPy_MPZ_GetBuffer,           /* bf_getbuffer     */
+    0,                                            /* bf_releasebuffer */
+};
+#endif
+
 static PyMappingMethods GMPy_MPZ_mapping_methods = {
     (lenfunc)GMPy_MPZ_Method_Length,
     (binaryfunc)GMPy_MPZ_Method_SubScript,
@@ -200,6 +238,9 @@ static PyMethodDef GMPy_MPZ_methods [] =
     { "__ceil__", GMPy_MPZ_Method_Ceil, METH_NOARGS, GMPy_doc_mpz_method_ceil },
     { "__floor__", GMPy_MPZ_Method_Floor, METH_NOARGS, GMPy_doc_mpz_method_floor },
     { "__round__", GMPy_MPZ_Method_Round, METH_VARARGS, GMPy_doc_mpz_method_round },
+#ifdef GMPY_PICKLE_BUFFER
+    { "__reduce_ex__", GMPy_MPANY_Reduce_Ex, METH_VARARGS, GMPy_doc_reduce_ex },
+#endif
     { "__sizeof__", GMPy_MPZ_Method_SizeOf, METH_NOARGS, GMPy_doc_mpz_method_sizeof },
     { "__trunc__", GMPy_MPZ_Method_Trunc, METH_NOARGS, GMPy_doc_mpz_method_trunc },
     { "bit_clear", GMPy_MPZ_bit_clear_method, METH_O, doc_bit_clear_method },
@@ -210,9 +251,16 @@ static PyMethodDef GMPy_MPZ_methods [] =
     { "bit_set", GMPy_MPZ_bit_set_method, METH_O, doc_bit_set_method },
     { "bit_test", GMPy_MPZ_bit_test_method, METH_O, doc_bit_test_method },
     { "digits", GMPy_MPZ_Digits_Method, METH_VARARGS, GMPy_doc_mpz_digits_method },
+#ifdef PY3
+    { "from_bytes", (PyCFunction)GMPy_MPZ_Method_FromBytes, METH_VARARGS | METH_KEYWORDS | METH_CLASS, GMPy_doc_mpz_method_from_bytes },
+#endif
+    { "get_bits", GMPy_MPZ_get_bits_method, METH_VARARGS, doc_get_bits_method },
     { "is_congruent", GMPy_MPZ_Method_IsCongruent, METH_VARARGS, GMPy_doc_mpz_method_is_congruent },
     { "is_divisible", GMPy_MPZ_Method_IsDivisible, METH_O, GMPy_doc_mpz_method_is_divisible },
     { "num_digits", GMPy_MPZ_Method_NumDigits, METH_VARARGS, GMPy_doc_mpz_method_num_digits },
+#ifdef PY3
+    { "to_bytes", (PyCFunction)GMPy_MPZ_Method_ToBytes, METH_VARARGS | METH_KEYWORDS, GMPy_doc_mpz_method_to_bytes },
+#endif
     { NULL, NULL, 1 }
 };
 
@@ -243,7 +291,11 @@ static PyTypeObject MPZ_Type =
     (reprfunc) GMPy_MPZ_Str_Slot,           /* tp_str           */
         0,                                  /* tp_getattro      */
         0,                                  /* tp_setattro      */
+#ifdef PY3
+    &GMPy_MPZ_buffer_methods,               /* tp_as_buffer     */
+#else
         0,                                  /* tp_as_buffer     */
+#endif
 #ifdef PY3
     Py_TPFLAGS_DEFAULT,                     /* tp_flags         */
 #else
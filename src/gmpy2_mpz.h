@@ -32,17 +32,18 @@
 extern "C" {
 #endif
 
-typedef struct {
-    PyObject_HEAD
-    mpz_t z;
-    Py_hash_t hash_cache;
-} MPZ_Object;
+/* Smaller values are not worth keeping in str_cache. */
+#define STR_CACHE_MIN_BITS 256
 
+/* MPZ_Object, MPZ() and MPZ_Check() are defined in gmpy2_capi.h. */
 static PyTypeObject MPZ_Type;
-#define MPZ(obj) (((MPZ_Object*)(obj))->z)
-#define MPZ_Check(v) (((PyObject*)v)->ob_type == &MPZ_Type)
 
 static PyObject * GMPy_MPZ_Factory(PyObject *self, PyObject *args, PyObject *keywds);
+static PyObject * GMPy_MPZ_Factory_One(PyObject *n, CTXT_Object *context);
+#if PY_VERSION_HEX >= 0x03070000
+static PyObject * GMPy_MPZ_Factory_FastCall(PyObject *self, PyObject *const *args,
+                                            Py_ssize_t nargs, PyObject *kwnames);
+#endif
 
 #ifdef __cplusplus
 }
@@ -78,6 +78,9 @@ GMPy_MPZ_bit_mask(PyObject *self, PyObject *other)
         return NULL;
     }
 
+    if (GMPY_LIMB_CHECK((double)n, NULL))
+        return NULL;
+
     if (!(result = GMPy_MPZ_New(NULL)))
         return NULL;
 
@@ -126,21 +129,21 @@ PyDoc_STRVAR(doc_bit_scan0_function,
 "format), then None is returned.");
 
 static PyObject *
-GMPy_MPZ_bit_scan0_function(PyObject *self, PyObject *args)
+GMPy_MPZ_bit_scan0_function(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     mp_bitcnt_t index, starting_bit = 0;
     MPZ_Object *tempx = NULL;
 
-    if (PyTuple_GET_SIZE(args) == 0 || PyTuple_GET_SIZE(args) > 2) {
+    if (nargs == 0 || nargs > 2) {
         goto err;
     }
 
-    if (!(tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL))) {
+    if (!(tempx = GMPy_MPZ_From_Integer(args[0], NULL))) {
         goto err;
     }
 
-    if (PyTuple_GET_SIZE(args) == 2) {
-        starting_bit = mp_bitcnt_t_From_Integer(PyTuple_GET_ITEM(args, 1));
+    if (nargs == 2) {
+        starting_bit = mp_bitcnt_t_From_Integer(args[1]);
         if (starting_bit == (mp_bitcnt_t)(-1) && PyErr_Occurred()) {
             goto err_index;
         }
@@ -162,29 +165,47 @@ GMPy_MPZ_bit_scan0_function(PyObject *self, PyObject *args)
     Py_DECREF((PyObject*)tempx);
     return NULL;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_bit_scan0_function)
 
 PyDoc_STRVAR(doc_bit_scan1_method,
-"x.bit_scan1(n=0) -> int\n\n"
+"x.bit_scan1(n=0, stop=None) -> int\n\n"
 "Return the index of the first 1-bit of x with index >= n. n >= 0.\n"
 "If there are no more 1-bits in x at or above index n (which can\n"
 "only happen for x>=0, assuming an infinitely long 2's complement\n"
-"format), then None is returned.");
+"format), or none below index 'stop' if it is given, then None is\n"
+"returned.");
 
 static PyObject *
 GMPy_MPZ_bit_scan1_method(PyObject *self, PyObject *args)
 {
-    mp_bitcnt_t index, starting_bit = 0;
+    mp_bitcnt_t index, starting_bit = 0, stop = (mp_bitcnt_t)(-1);
 
-    if (PyTuple_GET_SIZE(args) == 1) {
+    if (PyTuple_GET_SIZE(args) > 2) {
+        TYPE_ERROR("bit_scan1() takes at most 2 arguments");
+        return NULL;
+    }
+
+    if (PyTuple_GET_SIZE(args) >= 1) {
         starting_bit = mp_bitcnt_t_From_Integer(PyTuple_GET_ITEM(args, 0));
         if (starting_bit == (mp_bitcnt_t)(-1) && PyErr_Occurred()) {
             return NULL;
         }
     }
 
+    if (PyTuple_GET_SIZE(args) == 2 && PyTuple_GET_ITEM(args, 1) != Py_None) {
+        stop = mp_bitcnt_t_From_Integer(PyTuple_GET_ITEM(args, 1));
+        if (stop == (mp_bitcnt_t)(-1) && PyErr_Occurred()) {
+            return NULL;
+        }
+    }
+
+    if (starting_bit >= stop) {
+        Py_RETURN_NONE;
+    }
+
     index = mpz_scan1(MPZ(self), starting_bit);
 
-    if (index == (mp_bitcnt_t)(-1)) {
+    if (index == (mp_bitcnt_t)(-1) || index >= stop) {
         Py_RETURN_NONE;
     }
     else {
@@ -200,21 +221,21 @@ PyDoc_STRVAR(doc_bit_scan1_function,
 "format), then None is returned.");
 
 static PyObject *
-GMPy_MPZ_bit_scan1_function(PyObject *self, PyObject *args)
+GMPy_MPZ_bit_scan1_function(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     mp_bitcnt_t index, starting_bit = 0;
     MPZ_Object *tempx = NULL;
 
-    if (PyTuple_GET_SIZE(args) == 0 || PyTuple_GET_SIZE(args) > 2) {
+    if (nargs == 0 || nargs > 2) {
         goto err;
     }
 
-    if (!(tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL))) {
+    if (!(tempx = GMPy_MPZ_From_Integer(args[0], NULL))) {
         goto err;
     }
 
-    if (PyTuple_GET_SIZE(args) == 2) {
-        starting_bit = mp_bitcnt_t_From_Integer(PyTuple_GET_ITEM(args, 1));
+    if (nargs == 2) {
+        starting_bit = mp_bitcnt_t_From_Integer(args[1]);
         if (starting_bit == (mp_bitcnt_t)(-1) && PyErr_Occurred()) {
             goto err_index;
         }
@@ -236,6 +257,7 @@ GMPy_MPZ_bit_scan1_function(PyObject *self, PyObject *args)
     Py_DECREF((PyObject*)tempx);
     return NULL;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_bit_scan1_function)
 
 /* get & return one bit from an mpz */
 PyDoc_STRVAR(doc_bit_test_function,
@@ -243,21 +265,21 @@ PyDoc_STRVAR(doc_bit_test_function,
 "Return the value of the n-th bit of x.");
 
 static PyObject *
-GMPy_MPZ_bit_test_function(PyObject *self, PyObject *args)
+GMPy_MPZ_bit_test_function(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     mp_bitcnt_t bit_index;
     int temp;
     MPZ_Object *tempx = NULL;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (nargs != 2) {
         goto err;
     }
 
-    if (!(tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL))) {
+    if (!(tempx = GMPy_MPZ_From_Integer(args[0], NULL))) {
         goto err;
     }
 
-    bit_index = mp_bitcnt_t_From_Integer(PyTuple_GET_ITEM(args, 1));
+    bit_index = mp_bitcnt_t_From_Integer(args[1]);
     if (bit_index == (mp_bitcnt_t)(-1) && PyErr_Occurred()) {
         goto err_index;
     }
@@ -276,6 +298,7 @@ GMPy_MPZ_bit_test_function(PyObject *self, PyObject *args)
     Py_DECREF((PyObject*)tempx);
     return NULL;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_bit_test_function)
 
 PyDoc_STRVAR(doc_bit_test_method,
 "x.bit_test(n) -> bool\n\n"
@@ -302,21 +325,21 @@ PyDoc_STRVAR(doc_bit_clear_function,
 "Return a copy of x with the n-th bit cleared.");
 
 static PyObject *
-GMPy_MPZ_bit_clear_function(PyObject *self, PyObject *args)
+GMPy_MPZ_bit_clear_function(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     mp_bitcnt_t bit_index;
     MPZ_Object *result = NULL, *tempx = NULL;
 
-    if (PyTuple_GET_SIZE(args) != 2)
+    if (nargs != 2)
         goto err;
 
     if (!(result = GMPy_MPZ_New(NULL)))
         return NULL;
 
-    if (!(tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL)))
+    if (!(tempx = GMPy_MPZ_From_Integer(args[0], NULL)))
         goto err;
 
-    bit_index = mp_bitcnt_t_From_Integer(PyTuple_GET_ITEM(args, 1));
+    bit_index = mp_bitcnt_t_From_Integer(args[1]);
     if (bit_index == (mp_bitcnt_t)(-1) && PyErr_Occurred())
         goto err_index;
 
@@ -333,6 +356,7 @@ GMPy_MPZ_bit_clear_function(PyObject *self, PyObject *args)
     Py_XDECREF((PyObject*)tempx);
     return NULL;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_bit_clear_function)
 
 PyDoc_STRVAR(doc_bit_clear_method,
 "x.bit_clear(n) -> mpz\n\n"
@@ -361,21 +385,21 @@ PyDoc_STRVAR(doc_bit_set_function,
 "Return a copy of x with the n-th bit set.");
 
 static PyObject *
-GMPy_MPZ_bit_set_function(PyObject *self, PyObject *args)
+GMPy_MPZ_bit_set_function(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     mp_bitcnt_t bit_index;
     MPZ_Object *result = NULL, *tempx = NULL;
 
-    if (PyTuple_GET_SIZE(args) != 2)
+    if (nargs != 2)
         goto err;
 
     if (!(result = GMPy_MPZ_New(NULL)))
         return NULL;
 
-    if (!(tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL)))
+    if (!(tempx = GMPy_MPZ_From_Integer(args[0], NULL)))
         goto err;
 
-    bit_index = mp_bitcnt_t_From_Integer(PyTuple_GET_ITEM(args, 1));
+    bit_index = mp_bitcnt_t_From_Integer(args[1]);
     if (bit_index == (mp_bitcnt_t)(-1) && PyErr_Occurred())
         goto err_index;
 
@@ -392,6 +416,7 @@ GMPy_MPZ_bit_set_function(PyObject *self, PyObject *args)
     Py_XDECREF((PyObject*)tempx);
     return NULL;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_bit_set_function)
 
 PyDoc_STRVAR(doc_bit_set_method,
 "x.bit_set(n) -> mpz\n\n"
@@ -420,21 +445,21 @@ PyDoc_STRVAR(doc_bit_flip_function,
 "Return a copy of x with the n-th bit inverted.");
 
 static PyObject *
-GMPy_MPZ_bit_flip_function(PyObject *self, PyObject *args)
+GMPy_MPZ_bit_flip_function(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     mp_bitcnt_t bit_index;
     MPZ_Object *result = NULL, *tempx = NULL;
 
-    if (PyTuple_GET_SIZE(args) != 2)
+    if (nargs != 2)
         goto err;
 
     if (!(result = GMPy_MPZ_New(NULL)))
         return NULL;
 
-    if (!(tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL)))
+    if (!(tempx = GMPy_MPZ_From_Integer(args[0], NULL)))
         goto err;
 
-    bit_index = mp_bitcnt_t_From_Integer(PyTuple_GET_ITEM(args, 1));
+    bit_index = mp_bitcnt_t_From_Integer(args[1]);
     if (bit_index == (mp_bitcnt_t)(-1) && PyErr_Occurred())
         goto err_index;
 
@@ -448,6 +473,7 @@ GMPy_MPZ_bit_flip_function(PyObject *self, PyObject *args)
     Py_XDECREF((PyObject*)tempx);
     return NULL;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_bit_flip_function)
 
 PyDoc_STRVAR(doc_bit_flip_method,
 "x.bit_flip(n) -> mpz\n\n"
@@ -606,6 +632,9 @@ GMPy_MPZ_Lshift_Slot(PyObject *self, PyObject *other)
     if ((count == (mp_bitcnt_t)(-1)) && PyErr_Occurred())
         return NULL;
 
+    if (GMPY_LIMB_CHECK((double)count, NULL))
+        return NULL;
+
     if (!(result = GMPy_MPZ_New(NULL)))
         return NULL;
 
@@ -657,16 +686,16 @@ PyDoc_STRVAR(doc_hamdist,
 "bits differ) between integers x and y.");
 
 static PyObject *
-GMPy_MPZ_hamdist(PyObject *self, PyObject *args)
+GMPy_MPZ_hamdist(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     PyObject *result = NULL;
     MPZ_Object *tempx = NULL, *tempy = NULL;
 
-    if (PyTuple_GET_SIZE(args) != 2)
+    if (nargs != 2)
         goto err;
 
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
-    tempy = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL);
+    tempx = GMPy_MPZ_From_Integer(args[0], NULL);
+    tempy = GMPy_MPZ_From_Integer(args[1], NULL);
     if (!tempx || !tempy)
         goto err;
 
@@ -681,4 +710,462 @@ GMPy_MPZ_hamdist(PyObject *self, PyObject *args)
     Py_XDECREF((PyObject*)tempy);
     return NULL;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_hamdist)
+
+/* The batch bit counting functions run mpz_popcount() and mpz_hamdist(),
+ * which use the popcount instructions of the CPU that GMP was built or
+ * dispatched for, on the thread pool. */
+
+typedef struct {
+    MPZ_Object **xs;
+    mpz_srcptr query;
+    mp_bitcnt_t *out;
+} bitcount_many_job;
+
+static void
+popcount_many_run(void *arg, Py_ssize_t start, Py_ssize_t stop)
+{
+    bitcount_many_job *job = (bitcount_many_job*)arg;
+    Py_ssize_t i;
+
+    for (i = start; i < stop; i++)
+        job->out[i] = mpz_popcount(job->xs[i]->z);
+}
+
+static void
+hamdist_many_run(void *arg, Py_ssize_t start, Py_ssize_t stop)
+{
+    bitcount_many_job *job = (bitcount_many_job*)arg;
+    Py_ssize_t i;
+
+    for (i = start; i < stop; i++)
+        job->out[i] = mpz_hamdist(job->query, job->xs[i]->z);
+}
+
+/* Run the job for n items and return the list of counts. A count of
+ * (mp_bitcnt_t)(-1) becomes -1, as in popcount(). */
+
+static PyObject *
+bitcount_many(gmpy_pool_func func, bitcount_many_job *job, Py_ssize_t n)
+{
+    PyObject *result = NULL, *temp;
+    size_t *cost = NULL, bits = 0;
+    Py_ssize_t i;
+
+    if (!(job->out = GMPY_MALLOC(sizeof(mp_bitcnt_t) * (n ? n : 1))) ||
+        !(cost = GMPY_MALLOC(sizeof(size_t) * (n ? n : 1)))) {
+        PyErr_NoMemory();
+        goto done;
+    }
+    for (i = 0; i < n; i++) {
+        cost[i] = mpz_size(job->xs[i]->z) + 1;
+        bits += cost[i] * GMP_NUMB_BITS;
+        cost[i] *= GMP_NUMB_BITS;
+    }
+
+    if (GMPy_Pool_Run_Checked(func, job, n, cost, bits) < 0)
+        goto done;
+
+    if (!(result = PyList_New(n)))
+        goto done;
+    for (i = 0; i < n; i++) {
+        if (job->out[i] == (mp_bitcnt_t)(-1))
+            temp = PyLong_FromLong(-1);
+        else
+            temp = PyIntOrLong_From_mp_bitcnt_t(job->out[i]);
+        if (!temp) {
+            Py_CLEAR(result);
+            goto done;
+        }
+        PyList_SET_ITEM(result, i, temp);
+    }
+
+  done:
+    if (job->out)
+        GMPY_FREE(job->out);
+    if (cost)
+        GMPY_FREE(cost);
+    return result;
+}
+
+PyDoc_STRVAR(doc_popcount_many,
+"popcount_many(xs) -> list\n\n"
+"Return the list [popcount(x) for x in xs]. The counts are computed\n"
+"without the GIL on the thread pool (see set_threads()).");
+
+static PyObject *
+GMPy_MPZ_popcount_many(PyObject *self, PyObject *other)
+{
+    PyObject *result;
+    bitcount_many_job job;
+    Py_ssize_t n = 0;
+
+    memset(&job, 0, sizeof(job));
+    if (!(job.xs = GMPy_MPZ_Array_From_Iterable(other, &n,
+                "popcount_many() requires a sequence of integers", NULL)))
+        return NULL;
+
+    result = bitcount_many(popcount_many_run, &job, n);
+    GMPy_MPZ_Array_Free(job.xs, n);
+    return result;
+}
+
+PyDoc_STRVAR(doc_hamdist_many,
+"hamdist_many(query, candidates) -> list\n\n"
+"Return the list [hamdist(query, c) for c in candidates], with -1\n"
+"where the signs of query and c differ. The distances are computed\n"
+"without the GIL on the thread pool (see set_threads()).");
+
+static PyObject *
+GMPy_MPZ_hamdist_many(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *result;
+    MPZ_Object *query;
+    bitcount_many_job job;
+    Py_ssize_t n = 0;
+
+    if (nargs != 2 || !IS_INTEGER(args[0])) {
+        TYPE_ERROR("hamdist_many() requires an integer and a sequence of integers");
+        return NULL;
+    }
+
+    if (!(query = GMPy_MPZ_From_Integer(args[0], NULL)))
+        return NULL;
+
+    memset(&job, 0, sizeof(job));
+    if (!(job.xs = GMPy_MPZ_Array_From_Iterable(args[1], &n,
+                "hamdist_many() requires an integer and a sequence of integers", NULL))) {
+        Py_DECREF((PyObject*)query);
+        return NULL;
+    }
+    job.query = query->z;
+
+    result = bitcount_many(hamdist_many_run, &job, n);
+    GMPy_MPZ_Array_Free(job.xs, n);
+    Py_DECREF((PyObject*)query);
+    return result;
+}
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_hamdist_many)
+
+/* Combine all the integers of an iterable with one bitwise operation. When
+ * all of them are nonnegative, the result is accumulated in place with the
+ * mpn functions. */
+
+#define BITWISE_AND 0
+#define BITWISE_IOR 1
+#define BITWISE_XOR 2
+
+static PyObject *
+bitwise_many(PyObject *other, int op, const char *msg)
+{
+    MPZ_Object *result, **xs;
+    Py_ssize_t i, n = 0;
+    size_t size, s, bits = 0;
+    int negative = 0;
+    mp_limb_t *rp;
+
+    if (!(xs = GMPy_MPZ_Array_From_Iterable(other, &n, msg, NULL)))
+        return NULL;
+
+    if (!(result = GMPy_MPZ_New(NULL))) {
+        GMPy_MPZ_Array_Free(xs, n);
+        return NULL;
+    }
+
+    if (n == 0) {
+        /* The identity of the operation. */
+        mpz_set_si(result->z, op == BITWISE_AND ? -1 : 0);
+        GMPy_MPZ_Array_Free(xs, n);
+        return (PyObject*)result;
+    }
+
+    size = mpz_size(xs[0]->z);
+    for (i = 0; i < n; i++) {
+        s = mpz_size(xs[i]->z);
+        bits += s * GMP_NUMB_BITS;
+        if (mpz_sgn(xs[i]->z) < 0)
+            negative = 1;
+        if (op == BITWISE_AND ? s < size : s > size)
+            size = s;
+    }
+
+    if (negative) {
+        GMPY_BEGIN_NOGIL(bits);
+        mpz_set(result->z, xs[0]->z);
+        for (i = 1; i < n; i++) {
+            if (op == BITWISE_AND)
+                mpz_and(result->z, result->z, xs[i]->z);
+            else if (op == BITWISE_IOR)
+                mpz_ior(result->z, result->z, xs[i]->z);
+            else
+                mpz_xor(result->z, result->z, xs[i]->z);
+        }
+        GMPY_END_NOGIL;
+    }
+    else if (size > 0) {
+        if ((size_t)result->z->_mp_alloc < size)
+            mpz_realloc2(result->z, (mp_bitcnt_t)size * GMP_NUMB_BITS);
+        rp = result->z->_mp_d;
+
+        GMPY_BEGIN_NOGIL(bits);
+        s = mpz_size(xs[0]->z);
+        if (s > size)
+            s = size;
+        mpn_copyi(rp, xs[0]->z->_mp_d, s);
+        if (s < size)
+            memset(rp + s, 0, (size - s) * sizeof(mp_limb_t));
+
+        /* For AND, size is the shortest length, so every item covers it. */
+        for (i = 1; i < n; i++) {
+            s = mpz_size(xs[i]->z);
+            if (s > size)
+                s = size;
+            if (s == 0)
+                continue;
+            if (op == BITWISE_AND)
+                mpn_and_n(rp, rp, xs[i]->z->_mp_d, s);
+            else if (op == BITWISE_IOR)
+                mpn_ior_n(rp, rp, xs[i]->z->_mp_d, s);
+            else
+                mpn_xor_n(rp, rp, xs[i]->z->_mp_d, s);
+        }
+        GMPY_END_NOGIL;
+
+        while (size > 0 && rp[size - 1] == 0)
+            size--;
+        result->z->_mp_size = (int)size;
+    }
+
+    GMPy_MPZ_Array_Free(xs, n);
+    return (PyObject*)result;
+}
+
+PyDoc_STRVAR(doc_bit_and_many,
+"bit_and_many(xs) -> mpz\n\n"
+"Return the bitwise and of all the integers in xs, or -1 if xs is\n"
+"empty. No intermediate results are created.");
+
+static PyObject *
+GMPy_MPZ_bit_and_many(PyObject *self, PyObject *other)
+{
+    return bitwise_many(other, BITWISE_AND,
+                        "bit_and_many() requires a sequence of integers");
+}
+
+PyDoc_STRVAR(doc_bit_or_many,
+"bit_or_many(xs) -> mpz\n\n"
+"Return the bitwise or of all the integers in xs, or 0 if xs is\n"
+"empty. No intermediate results are created.");
+
+static PyObject *
+GMPy_MPZ_bit_or_many(PyObject *self, PyObject *other)
+{
+    return bitwise_many(other, BITWISE_IOR,
+                        "bit_or_many() requires a sequence of integers");
+}
+
+PyDoc_STRVAR(doc_bit_xor_many,
+"bit_xor_many(xs) -> mpz\n\n"
+"Return the bitwise exclusive or of all the integers in xs, or 0 if\n"
+"xs is empty. No intermediate results are created.");
+
+static PyObject *
+GMPy_MPZ_bit_xor_many(PyObject *self, PyObject *other)
+{
+    return bitwise_many(other, BITWISE_XOR,
+                        "bit_xor_many() requires a sequence of integers");
+}
+
+
+/* Limb-level access to a field of bits, used by slicing with step 1 and by
+ * get_bits(). A negative value is read and written as two's complement with
+ * mpz arithmetic; a nonnegative value is accessed through its limbs. */
+
+/* Set r to the n bits of x beginning at bit position 'start'. r must not be
+ * x. */
+
+static void
+GMPy_MPZ_Get_Bits(mpz_ptr r, mpz_srcptr x, mp_bitcnt_t start, mp_bitcnt_t n)
+{
+    size_t xsize = mpz_size(x), i0 = start / GMP_NUMB_BITS, rsize, m;
+    unsigned int shift = start % GMP_NUMB_BITS;
+    mp_limb_t *rp;
+
+    if (mpz_sgn(x) < 0) {
+        mpz_fdiv_q_2exp(r, x, start);
+        mpz_fdiv_r_2exp(r, r, n);
+        return;
+    }
+
+    if (n == 0 || i0 >= xsize) {
+        mpz_set_ui(r, 0);
+        return;
+    }
+
+    /* With a shift, the last limb of the field may take bits from one more
+     * limb of x. */
+    rsize = (n - 1) / GMP_NUMB_BITS + 1;
+    m = xsize - i0;
+    if (m > rsize + 1)
+        m = rsize + 1;
+    if ((size_t)r->_mp_alloc < m)
+        mpz_realloc2(r, (mp_bitcnt_t)m * GMP_NUMB_BITS);
+    rp = r->_mp_d;
+
+    if (shift)
+        mpn_rshift(rp, x->_mp_d + i0, m, shift);
+    else
+        mpn_copyi(rp, x->_mp_d + i0, m);
 
+    if (m >= rsize) {
+        m = rsize;
+        if (n % GMP_NUMB_BITS)
+            rp[m - 1] &= ((mp_limb_t)1 << (n % GMP_NUMB_BITS)) - 1;
+    }
+    while (m > 0 && rp[m - 1] == 0)
+        m--;
+    r->_mp_size = (int)m;
+}
+
+/* Replace the n bits of x beginning at bit position 'start' with the low n
+ * bits of v. */
+
+static void
+GMPy_MPZ_Set_Bits(mpz_ptr x, mp_bitcnt_t start, mp_bitcnt_t n, mpz_srcptr v)
+{
+    mpz_t temp;
+    mpz_srcptr src = v;
+    int own = 0;
+
+    if (n == 0)
+        return;
+
+    if (mpz_sgn(v) < 0 || mpz_sizeinbase(v, 2) > n) {
+        mpz_init(temp);
+        mpz_fdiv_r_2exp(temp, v, n);
+        src = temp;
+        own = 1;
+    }
+
+    if (mpz_sgn(x) < 0) {
+        mpz_t mask;
+
+        /* x = (x & ~((2**n - 1) << start)) | (src << start) */
+        mpz_init(mask);
+        mpz_setbit(mask, n);
+        mpz_sub_ui(mask, mask, 1);
+        mpz_mul_2exp(mask, mask, start);
+        mpz_com(mask, mask);
+        mpz_and(x, x, mask);
+        mpz_mul_2exp(mask, src, start);
+        mpz_ior(x, x, mask);
+        mpz_clear(mask);
+    }
+    else {
+        size_t xsize = mpz_size(x), need = (start + n - 1) / GMP_NUMB_BITS + 1;
+        size_t ssize = mpz_size(src), si;
+        const mp_limb_t *sp = src->_mp_d;
+        mp_bitcnt_t k, pos, chunk;
+        unsigned int off, so;
+        mp_limb_t w, mask, *xp;
+
+        if (need > xsize) {
+            if ((size_t)x->_mp_alloc < need)
+                mpz_realloc2(x, (mp_bitcnt_t)need * GMP_NUMB_BITS);
+            memset(x->_mp_d + xsize, 0, (need - xsize) * sizeof(mp_limb_t));
+        }
+        else {
+            need = xsize;
+        }
+        xp = x->_mp_d;
+
+        /* After the first limb of the field, every chunk is a whole limb of
+         * x, assembled from at most two limbs of src. */
+        for (k = 0; k < n; k += chunk) {
+            pos = start + k;
+            off = pos % GMP_NUMB_BITS;
+            chunk = GMP_NUMB_BITS - off;
+            if (chunk > n - k)
+                chunk = n - k;
+
+            si = k / GMP_NUMB_BITS;
+            so = k % GMP_NUMB_BITS;
+            w = si < ssize ? sp[si] >> so : 0;
+            if (so && si + 1 < ssize)
+                w |= sp[si + 1] << (GMP_NUMB_BITS - so);
+
+            mask = chunk == GMP_NUMB_BITS ? GMP_NUMB_MASK :
+                   (((mp_limb_t)1 << chunk) - 1);
+            xp[pos / GMP_NUMB_BITS] = (xp[pos / GMP_NUMB_BITS] & ~(mask << off)) |
+                                      ((w & mask) << off);
+        }
+        while (need > 0 && xp[need - 1] == 0)
+            need--;
+        x->_mp_size = (int)need;
+    }
+
+    if (own)
+        mpz_clear(temp);
+}
+
+PyDoc_STRVAR(doc_get_bits_method,
+"x.get_bits(start, n) -> int\n\n"
+"Return the n bits of x beginning at bit position 'start' as a\n"
+"nonnegative integer, the same value as x[start:start+n] for bits\n"
+"within x. A negative x is read as two's complement. The result is\n"
+"an int if n <= 64 and an mpz otherwise.");
+
+static PyObject *
+GMPy_MPZ_get_bits_method(PyObject *self, PyObject *args)
+{
+    mp_bitcnt_t start, n, done, pos, chunk;
+    unsigned PY_LONG_LONG value = 0;
+    MPZ_Object *result;
+    mpz_t temp;
+    mpz_srcptr src = MPZ(self);
+    size_t i, size;
+    mp_limb_t w;
+
+    if (PyTuple_GET_SIZE(args) != 2) {
+        TYPE_ERROR("get_bits() requires 2 integer arguments");
+        return NULL;
+    }
+
+    start = mp_bitcnt_t_From_Integer(PyTuple_GET_ITEM(args, 0));
+    if (start == (mp_bitcnt_t)(-1) && PyErr_Occurred())
+        return NULL;
+    n = mp_bitcnt_t_From_Integer(PyTuple_GET_ITEM(args, 1));
+    if (n == (mp_bitcnt_t)(-1) && PyErr_Occurred())
+        return NULL;
+
+    if (n > 64) {
+        if (!(result = GMPy_MPZ_New(NULL)))
+            return NULL;
+        GMPy_MPZ_Get_Bits(result->z, MPZ(self), start, n);
+        return (PyObject*)result;
+    }
+
+    if (mpz_sgn(MPZ(self)) < 0) {
+        mpz_init(temp);
+        GMPy_MPZ_Get_Bits(temp, MPZ(self), start, n);
+        src = temp;
+        start = 0;
+    }
+
+    size = mpz_size(src);
+    for (done = 0; done < n; done += chunk) {
+        pos = start + done;
+        i = pos / GMP_NUMB_BITS;
+        chunk = GMP_NUMB_BITS - pos % GMP_NUMB_BITS;
+        if (chunk > n - done)
+            chunk = n - done;
+        w = i < size ? src->_mp_d[i] >> (pos % GMP_NUMB_BITS) : 0;
+        if (chunk < GMP_NUMB_BITS)
+            w &= ((mp_limb_t)1 << chunk) - 1;
+        value |= (unsigned PY_LONG_LONG)w << done;
+    }
+
+    if (src != MPZ(self))
+        mpz_clear(temp);
+    return PyLong_FromUnsignedLongLong(value);
+}
@@ -35,22 +35,31 @@ extern "C" {
 static PyObject * GMPy_MPZ_bit_length_function(PyObject *self, PyObject *other);
 static PyObject * GMPy_MPZ_bit_length_method(PyObject *self, PyObject *other);
 static PyObject * GMPy_MPZ_bit_mask(PyObject *self, PyObject *other);
-static PyObject * GMPy_MPZ_bit_scan0_function(PyObject *self, PyObject *args);
+static PyObject * GMPy_MPZ_bit_scan0_function(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 static PyObject * GMPy_MPZ_bit_scan0_method(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPZ_bit_scan1_function(PyObject *self, PyObject *args);
+static PyObject * GMPy_MPZ_bit_scan1_function(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 static PyObject * GMPy_MPZ_bit_scan1_method(PyObject *self, PyObject *args);
 
-static PyObject * GMPy_MPZ_bit_test_function(PyObject *self, PyObject *args);
+static PyObject * GMPy_MPZ_bit_test_function(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 static PyObject * GMPy_MPZ_bit_test_method(PyObject *self, PyObject *other);
-static PyObject * GMPy_MPZ_bit_clear_function(PyObject *self, PyObject *args);
+static PyObject * GMPy_MPZ_bit_clear_function(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 static PyObject * GMPy_MPZ_bit_clear_method(PyObject *self, PyObject *other);
-static PyObject * GMPy_MPZ_bit_set_function(PyObject *self, PyObject *args);
+static PyObject * GMPy_MPZ_bit_set_function(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 static PyObject * GMPy_MPZ_bit_set_method(PyObject *self, PyObject *other);
-static PyObject * GMPy_MPZ_bit_flip_function(PyObject *self, PyObject *args);
+static PyObject * GMPy_MPZ_bit_flip_function(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 static PyObject * GMPy_MPZ_bit_flip_method(PyObject *self, PyObject *other);
 
 static PyObject * GMPy_MPZ_popcount(PyObject *self, PyObject *other);
-static PyObject * GMPy_MPZ_hamdist(PyObject *self, PyObject *args);
+static PyObject * GMPy_MPZ_get_bits_method(PyObject *self, PyObject *args);
+
+static void       GMPy_MPZ_Get_Bits(mpz_ptr r, mpz_srcptr x, mp_bitcnt_t start, mp_bitcnt_t n);
+static void       GMPy_MPZ_Set_Bits(mpz_ptr x, mp_bitcnt_t start, mp_bitcnt_t n, mpz_srcptr v);
+static PyObject * GMPy_MPZ_hamdist(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPy_MPZ_popcount_many(PyObject *self, PyObject *other);
+static PyObject * GMPy_MPZ_hamdist_many(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPy_MPZ_bit_and_many(PyObject *self, PyObject *other);
+static PyObject * GMPy_MPZ_bit_or_many(PyObject *self, PyObject *other);
+static PyObject * GMPy_MPZ_bit_xor_many(PyObject *self, PyObject *other);
 
 static PyObject * GMPy_MPZ_Invert_Slot(MPZ_Object *self);
 static PyObject * GMPy_MPZ_And_Slot(PyObject *self, PyObject *other);
@@ -41,18 +41,18 @@ PyDoc_STRVAR(doc_c_divmod,
 "have the opposite sign of y. x and y must be integers.");
 
 static PyObject *
-GMPy_MPZ_c_divmod(PyObject *self, PyObject *args)
+GMPy_MPZ_c_divmod(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     PyObject *result;
     MPZ_Object *q, *r, *tempx, *tempy;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (nargs != 2) {
         TYPE_ERROR("c_divmod() requires 'mpz','mpz' arguments");
         return NULL;
     }
 
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
-    tempy = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL);
+    tempx = GMPy_MPZ_From_Integer(args[0], NULL);
+    tempy = GMPy_MPZ_From_Integer(args[1], NULL);
     q = GMPy_MPZ_New(NULL);
     r = GMPy_MPZ_New(NULL);
     result = PyTuple_New(2);
@@ -80,6 +80,7 @@ GMPy_MPZ_c_divmod(PyObject *self, PyObject *args)
     Py_XDECREF((PyObject*)r);
     return NULL;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_c_divmod)
 
 PyDoc_STRVAR(doc_c_div,
 "c_div(x, y) -> quotient\n\n"
@@ -87,17 +88,17 @@ PyDoc_STRVAR(doc_c_div,
 "towards +Inf (ceiling rounding). x and y must be integers.");
 
 static PyObject *
-GMPy_MPZ_c_div(PyObject *self, PyObject *args)
+GMPy_MPZ_c_div(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     MPZ_Object *q, *tempx, *tempy;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (nargs != 2) {
         TYPE_ERROR("c_div() requires 'mpz','mpz' arguments");
         return NULL;
     }
 
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
-    tempy = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL);
+    tempx = GMPy_MPZ_From_Integer(args[0], NULL);
+    tempy = GMPy_MPZ_From_Integer(args[1], NULL);
     q = GMPy_MPZ_New(NULL);
     if (!tempx || !tempy || !q)
         goto err;
@@ -119,6 +120,7 @@ GMPy_MPZ_c_div(PyObject *self, PyObject *args)
     Py_XDECREF((PyObject*)q);
     return NULL;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_c_div)
 
 PyDoc_STRVAR(doc_c_mod,
 "c_mod(x, y) -> remainder\n\n"
@@ -126,17 +128,17 @@ PyDoc_STRVAR(doc_c_mod,
 "the opposite sign of y. x and y must be integers.");
 
 static PyObject *
-GMPy_MPZ_c_mod(PyObject *self, PyObject *args)
+GMPy_MPZ_c_mod(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     MPZ_Object *r, *tempx, *tempy;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (nargs != 2) {
         TYPE_ERROR("c_mod() requires 'mpz','mpz' arguments");
         return NULL;
     }
 
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
-    tempy = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL);
+    tempx = GMPy_MPZ_From_Integer(args[0], NULL);
+    tempy = GMPy_MPZ_From_Integer(args[1], NULL);
     r = GMPy_MPZ_New(NULL);
     if (!tempx || !tempy || !r)
         goto err;
@@ -158,6 +160,7 @@ GMPy_MPZ_c_mod(PyObject *self, PyObject *args)
     Py_XDECREF((PyObject*)r);
     return NULL;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_c_mod)
 
 /*
  **************************************************************************
@@ -172,18 +175,18 @@ PyDoc_STRVAR(doc_f_divmod,
 "have the same sign as y. x and y must be integers.");
 
 static PyObject *
-GMPy_MPZ_f_divmod(PyObject *self, PyObject *args)
+GMPy_MPZ_f_divmod(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     PyObject *result;
     MPZ_Object *q, *r, *tempx, *tempy;
 
-    if(PyTuple_GET_SIZE(args) != 2) {
+    if(nargs != 2) {
         TYPE_ERROR("f_divmod() requires 'mpz','mpz' arguments");
         return NULL;
     }
 
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
-    tempy = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL);
+    tempx = GMPy_MPZ_From_Integer(args[0], NULL);
+    tempy = GMPy_MPZ_From_Integer(args[1], NULL);
     q = GMPy_MPZ_New(NULL);
     r = GMPy_MPZ_New(NULL);
     result = PyTuple_New(2);
@@ -211,6 +214,7 @@ GMPy_MPZ_f_divmod(PyObject *self, PyObject *args)
     Py_XDECREF((PyObject*)r);
     return NULL;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_f_divmod)
 
 PyDoc_STRVAR(doc_f_div,
 "f_div(x, y) -> quotient\n\n"
@@ -218,17 +222,17 @@ PyDoc_STRVAR(doc_f_div,
 "towards -Inf (floor rounding). x and y must be integers.");
 
 static PyObject *
-GMPy_MPZ_f_div(PyObject *self, PyObject *args)
+GMPy_MPZ_f_div(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     MPZ_Object *q, *tempx, *tempy;
 
-    if(PyTuple_GET_SIZE(args) != 2) {
+    if(nargs != 2) {
         TYPE_ERROR("f_div() requires 'mpz','mpz' arguments");
         return NULL;
     }
 
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
-    tempy = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL);
+    tempx = GMPy_MPZ_From_Integer(args[0], NULL);
+    tempy = GMPy_MPZ_From_Integer(args[1], NULL);
     q = GMPy_MPZ_New(NULL);
     if (!tempx || !tempy || !q)
         goto err;
@@ -250,6 +254,7 @@ GMPy_MPZ_f_div(PyObject *self, PyObject *args)
     Py_XDECREF((PyObject*)q);
     return NULL;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_f_div)
 
 PyDoc_STRVAR(doc_f_mod,
 "f_mod(x, y) -> remainder\n\n"
@@ -257,17 +262,17 @@ PyDoc_STRVAR(doc_f_mod,
 "the same sign as y. x and y must be integers.");
 
 static PyObject *
-GMPy_MPZ_f_mod(PyObject *self, PyObject *args)
+GMPy_MPZ_f_mod(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     MPZ_Object *r, *tempx, *tempy;
 
-    if(PyTuple_GET_SIZE(args) != 2) {
+    if(nargs != 2) {
         TYPE_ERROR("f_mod() requires 'mpz','mpz' arguments");
         return NULL;
     }
 
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
-    tempy = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL);
+    tempx = GMPy_MPZ_From_Integer(args[0], NULL);
+    tempy = GMPy_MPZ_From_Integer(args[1], NULL);
     r = GMPy_MPZ_New(NULL);
     if (!tempx || !tempy || !r)
         goto err;
@@ -289,6 +294,7 @@ GMPy_MPZ_f_mod(PyObject *self, PyObject *args)
     Py_XDECREF((PyObject*)r);
     return NULL;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_f_mod)
 
 /*
  **************************************************************************
@@ -303,18 +309,18 @@ PyDoc_STRVAR(doc_t_divmod,
 "the same sign as x. x and y must be integers.");
 
 static PyObject *
-GMPy_MPZ_t_divmod(PyObject *self, PyObject *args)
+GMPy_MPZ_t_divmod(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     PyObject *result;
     MPZ_Object *q, *r, *tempx, *tempy;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (nargs != 2) {
         TYPE_ERROR("t_divmod() requires 'mpz','mpz' arguments");
         return NULL;
     }
 
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
-    tempy = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL);
+    tempx = GMPy_MPZ_From_Integer(args[0], NULL);
+    tempy = GMPy_MPZ_From_Integer(args[1], NULL);
     q = GMPy_MPZ_New(NULL);
     r = GMPy_MPZ_New(NULL);
     result = PyTuple_New(2);
@@ -342,6 +348,7 @@ GMPy_MPZ_t_divmod(PyObject *self, PyObject *args)
     Py_XDECREF((PyObject*)r);
     return NULL;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_t_divmod)
 
 PyDoc_STRVAR(doc_t_div,
 "t_div(x, y) -> quotient\n\n"
@@ -349,17 +356,17 @@ PyDoc_STRVAR(doc_t_div,
 "towards 0. x and y must be integers.");
 
 static PyObject *
-GMPy_MPZ_t_div(PyObject *self, PyObject *args)
+GMPy_MPZ_t_div(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     MPZ_Object *q, *tempx, *tempy;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (nargs != 2) {
         TYPE_ERROR("t_div() requires 'mpz','mpz' arguments");
         return NULL;
     }
 
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
-    tempy = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL);
+    tempx = GMPy_MPZ_From_Integer(args[0], NULL);
+    tempy = GMPy_MPZ_From_Integer(args[1], NULL);
     q = GMPy_MPZ_New(NULL);
     if (!tempx || !tempy || !q)
         goto err;
@@ -381,6 +388,7 @@ GMPy_MPZ_t_div(PyObject *self, PyObject *args)
     Py_XDECREF((PyObject*)q);
     return NULL;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_t_div)
 
 PyDoc_STRVAR(doc_t_mod,
 "t_mod(x, y) -> remainder\n\n"
@@ -388,17 +396,17 @@ PyDoc_STRVAR(doc_t_mod,
 "the same sign as x. x and y must be integers.");
 
 static PyObject *
-GMPy_MPZ_t_mod(PyObject *self, PyObject *args)
+GMPy_MPZ_t_mod(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     MPZ_Object *r, *tempx, *tempy;
 
-    if(PyTuple_GET_SIZE(args) != 2) {
+    if(nargs != 2) {
         TYPE_ERROR("t_mod() requires 'mpz','mpz' arguments");
         return NULL;
     }
 
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
-    tempy = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL);
+    tempx = GMPy_MPZ_From_Integer(args[0], NULL);
+    tempy = GMPy_MPZ_From_Integer(args[1], NULL);
     r = GMPy_MPZ_New(NULL);
     if (!tempx || !tempy || !r)
         goto err;
@@ -420,3 +428,4 @@ GMPy_MPZ_t_mod(PyObject *self, PyObject *args)
     Py_XDECREF((PyObject*)r);
     return NULL;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_t_mod)
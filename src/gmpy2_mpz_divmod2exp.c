@@ -43,23 +43,23 @@ PyDoc_STRVAR(doc_c_divmod_2exp,
 "be negative. x must be an integer. n must be >0.");
 
 static PyObject *
-GMPy_MPZ_c_divmod_2exp(PyObject *self, PyObject *args)
+GMPy_MPZ_c_divmod_2exp(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     mp_bitcnt_t nbits;
     PyObject *result;
     MPZ_Object *q, *r, *tempx;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (nargs != 2) {
         TYPE_ERROR("c_divmod_2exp() requires 'mpz','int' arguments");
         return NULL;
     }
 
-    nbits = mp_bitcnt_t_From_Integer(PyTuple_GET_ITEM(args, 1));
+    nbits = mp_bitcnt_t_From_Integer(args[1]);
     if (nbits == (mp_bitcnt_t)(-1) && PyErr_Occurred()) {
         return NULL;
     }
 
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
+    tempx = GMPy_MPZ_From_Integer(args[0], NULL);
     q = GMPy_MPZ_New(NULL);
     r = GMPy_MPZ_New(NULL);
     result = PyTuple_New(2);
@@ -79,6 +79,7 @@ GMPy_MPZ_c_divmod_2exp(PyObject *self, PyObject *args)
     PyTuple_SET_ITEM(result, 1, (PyObject*)r);
     return result;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_c_divmod_2exp)
 
 PyDoc_STRVAR(doc_c_div_2exp,
 "c_div_2exp(x, n) -> quotient\n\n"
@@ -86,22 +87,22 @@ PyDoc_STRVAR(doc_c_div_2exp,
 "towards +Inf (ceiling rounding). x must be an integer. n must be >0.");
 
 static PyObject *
-GMPy_MPZ_c_div_2exp(PyObject *self, PyObject *args)
+GMPy_MPZ_c_div_2exp(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     mp_bitcnt_t nbits;
     MPZ_Object *result, *tempx;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (nargs != 2) {
         TYPE_ERROR("c_div_2exp() requires 'mpz','int' arguments");
         return NULL;
     }
 
-    nbits = mp_bitcnt_t_From_Integer(PyTuple_GET_ITEM(args, 1));
+    nbits = mp_bitcnt_t_From_Integer(args[1]);
     if (nbits == (mp_bitcnt_t)(-1) && PyErr_Occurred()) {
         return NULL;
     }
 
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
+    tempx = GMPy_MPZ_From_Integer(args[0], NULL);
     result = GMPy_MPZ_New(NULL);
     if (!tempx || !result) {
         Py_XDECREF((PyObject*)result);
@@ -113,6 +114,7 @@ GMPy_MPZ_c_div_2exp(PyObject *self, PyObject *args)
     Py_DECREF((PyObject*)tempx);
     return (PyObject*)result;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_c_div_2exp)
 
 PyDoc_STRVAR(doc_c_mod_2exp,
 "c_mod_2exp(x, n) -> remainder\n\n"
@@ -120,22 +122,22 @@ PyDoc_STRVAR(doc_c_mod_2exp,
 "negative. x must be an integer. n must be >0.");
 
 static PyObject *
-GMPy_MPZ_c_mod_2exp(PyObject *self, PyObject *args)
+GMPy_MPZ_c_mod_2exp(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     mp_bitcnt_t nbits;
     MPZ_Object *result, *tempx;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (nargs != 2) {
         TYPE_ERROR("c_mod_2exp() requires 'mpz','int' arguments");
         return NULL;
     }
 
-    nbits = mp_bitcnt_t_From_Integer(PyTuple_GET_ITEM(args, 1));
+    nbits = mp_bitcnt_t_From_Integer(args[1]);
     if (nbits == (mp_bitcnt_t)(-1) && PyErr_Occurred()) {
         return NULL;
     }
 
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
+    tempx = GMPy_MPZ_From_Integer(args[0], NULL);
     result = GMPy_MPZ_New(NULL);
     if (!tempx || !result) {
         Py_XDECREF((PyObject*)result);
@@ -147,6 +149,7 @@ GMPy_MPZ_c_mod_2exp(PyObject *self, PyObject *args)
     Py_DECREF((PyObject*)tempx);
     return (PyObject*)result;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_c_mod_2exp)
 
 /*
  **************************************************************************
@@ -161,23 +164,23 @@ PyDoc_STRVAR(doc_f_divmod_2exp,
 "positive. x must be an integer. n must be >0.");
 
 static PyObject *
-GMPy_MPZ_f_divmod_2exp(PyObject *self, PyObject *args)
+GMPy_MPZ_f_divmod_2exp(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     mp_bitcnt_t nbits;
     PyObject *result;
     MPZ_Object *q, *r, *tempx;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (nargs != 2) {
         TYPE_ERROR("f_divmod_2exp() requires 'mpz','int' arguments");
         return NULL;
     }
 
-    nbits = mp_bitcnt_t_From_Integer(PyTuple_GET_ITEM(args, 1));
+    nbits = mp_bitcnt_t_From_Integer(args[1]);
     if (nbits == (mp_bitcnt_t)(-1) && PyErr_Occurred()) {
         return NULL;
     }
 
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
+    tempx = GMPy_MPZ_From_Integer(args[0], NULL);
     q = GMPy_MPZ_New(NULL);
     r = GMPy_MPZ_New(NULL);
     result = PyTuple_New(2);
@@ -197,6 +200,7 @@ GMPy_MPZ_f_divmod_2exp(PyObject *self, PyObject *args)
     PyTuple_SET_ITEM(result, 1, (PyObject*)r);
     return result;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_f_divmod_2exp)
 
 PyDoc_STRVAR(doc_f_div_2exp,
 "f_div_2exp(x, n) -? quotient\n\n"
@@ -204,22 +208,22 @@ PyDoc_STRVAR(doc_f_div_2exp,
 "towards -Inf (floor rounding). x must be an integer. n must be >0.");
 
 static PyObject *
-GMPy_MPZ_f_div_2exp(PyObject *self, PyObject *args)
+GMPy_MPZ_f_div_2exp(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     mp_bitcnt_t nbits;
     MPZ_Object *result, *tempx;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (nargs != 2) {
         TYPE_ERROR("f_div_2exp() requires 'mpz','int' arguments");
         return NULL;
     }
 
-    nbits = mp_bitcnt_t_From_Integer(PyTuple_GET_ITEM(args, 1));
+    nbits = mp_bitcnt_t_From_Integer(args[1]);
     if (nbits == (mp_bitcnt_t)(-1) && PyErr_Occurred()) {
         return NULL;
     }
 
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
+    tempx = GMPy_MPZ_From_Integer(args[0], NULL);
     result = GMPy_MPZ_New(NULL);
     if (!tempx || !result) {
         Py_XDECREF((PyObject*)result);
@@ -231,6 +235,7 @@ GMPy_MPZ_f_div_2exp(PyObject *self, PyObject *args)
     Py_DECREF((PyObject*)tempx);
     return (PyObject*)result;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_f_div_2exp)
 
 PyDoc_STRVAR(doc_f_mod_2exp,
 "f_mod_2exp(x, n) -> remainder\n\n"
@@ -238,22 +243,22 @@ PyDoc_STRVAR(doc_f_mod_2exp,
 "positive. x must be an integer. n must be >0.");
 
 static PyObject *
-GMPy_MPZ_f_mod_2exp(PyObject *self, PyObject *args)
+GMPy_MPZ_f_mod_2exp(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     mp_bitcnt_t nbits;
     MPZ_Object *result, *tempx;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (nargs != 2) {
         TYPE_ERROR("f_mod_2exp() requires 'mpz','int' arguments");
         return NULL;
     }
 
-    nbits = mp_bitcnt_t_From_Integer(PyTuple_GET_ITEM(args, 1));
+    nbits = mp_bitcnt_t_From_Integer(args[1]);
     if (nbits == (mp_bitcnt_t)(-1) && PyErr_Occurred()) {
         return NULL;
     }
 
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
+    tempx = GMPy_MPZ_From_Integer(args[0], NULL);
     result = GMPy_MPZ_New(NULL);
     if (!tempx || !result) {
         Py_XDECREF((PyObject*)result);
@@ -265,6 +270,7 @@ GMPy_MPZ_f_mod_2exp(PyObject *self, PyObject *args)
     Py_DECREF((PyObject*)tempx);
     return (PyObject*)result;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_f_mod_2exp)
 
 /*
  **************************************************************************
@@ -279,23 +285,23 @@ PyDoc_STRVAR(doc_t_divmod_2exp,
 "same sign as x. x must be an integer. n must be >0.");
 
 static PyObject *
-GMPy_MPZ_t_divmod_2exp(PyObject *self, PyObject *args)
+GMPy_MPZ_t_divmod_2exp(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     mp_bitcnt_t nbits;
     MPZ_Object *q, *r, *tempx;
     PyObject *result;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (nargs != 2) {
         TYPE_ERROR("t_divmod_2exp() requires 'mpz','int' arguments");
         return NULL;
     }
 
-    nbits = mp_bitcnt_t_From_Integer(PyTuple_GET_ITEM(args, 1));
+    nbits = mp_bitcnt_t_From_Integer(args[1]);
     if (nbits == (mp_bitcnt_t)(-1) && PyErr_Occurred()) {
         return NULL;
     }
 
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
+    tempx = GMPy_MPZ_From_Integer(args[0], NULL);
     q = GMPy_MPZ_New(NULL);
     r = GMPy_MPZ_New(NULL);
     result = PyTuple_New(2);
@@ -315,6 +321,7 @@ GMPy_MPZ_t_divmod_2exp(PyObject *self, PyObject *args)
     PyTuple_SET_ITEM(result, 1, (PyObject*)r);
     return result;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_t_divmod_2exp)
 
 PyDoc_STRVAR(doc_t_div_2exp,
 "t_div_2exp(x, n) -> quotient\n\n"
@@ -322,22 +329,22 @@ PyDoc_STRVAR(doc_t_div_2exp,
 "towards zero (truncation). n must be >0.");
 
 static PyObject *
-GMPy_MPZ_t_div_2exp(PyObject *self, PyObject *args)
+GMPy_MPZ_t_div_2exp(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     mp_bitcnt_t nbits;
     MPZ_Object *result, *tempx;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (nargs != 2) {
         TYPE_ERROR("t_div_2exp() requires 'mpz','int' arguments");
         return NULL;
     }
 
-    nbits = mp_bitcnt_t_From_Integer(PyTuple_GET_ITEM(args, 1));
+    nbits = mp_bitcnt_t_From_Integer(args[1]);
     if (nbits == (mp_bitcnt_t)(-1) && PyErr_Occurred()) {
         return NULL;
     }
 
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
+    tempx = GMPy_MPZ_From_Integer(args[0], NULL);
     result = GMPy_MPZ_New(NULL);
     if (!tempx || !result) {
         Py_XDECREF((PyObject*)result);
@@ -349,6 +356,7 @@ GMPy_MPZ_t_div_2exp(PyObject *self, PyObject *args)
     Py_DECREF((PyObject*)tempx);
     return (PyObject*)result;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_t_div_2exp)
 
 PyDoc_STRVAR(doc_t_mod_2exp,
 "t_mod_2exp(x, n) -> remainder\n\n"
@@ -356,22 +364,22 @@ PyDoc_STRVAR(doc_t_mod_2exp,
 "the same sign as x. x must be an integer. n must be >0.");
 
 static PyObject *
-GMPy_MPZ_t_mod_2exp(PyObject *self, PyObject *args)
+GMPy_MPZ_t_mod_2exp(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     mp_bitcnt_t nbits;
     MPZ_Object *result, *tempx;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (nargs != 2) {
         TYPE_ERROR("t_mod_2exp() requires 'mpz','int' arguments");
         return NULL;
     }
 
-    nbits = mp_bitcnt_t_From_Integer(PyTuple_GET_ITEM(args, 1));
+    nbits = mp_bitcnt_t_From_Integer(args[1]);
     if (nbits == (mp_bitcnt_t)(-1) && PyErr_Occurred()) {
         return NULL;
     }
 
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
+    tempx = GMPy_MPZ_From_Integer(args[0], NULL);
     result = GMPy_MPZ_New(NULL);
     if (!tempx || !result) {
         Py_XDECREF((PyObject*)result);
@@ -383,3 +391,4 @@ GMPy_MPZ_t_mod_2exp(PyObject *self, PyObject *args)
     Py_DECREF((PyObject*)tempx);
     return (PyObject*)result;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_t_mod_2exp)
@@ -57,10 +57,9 @@ GMPy_MPZ_IAdd_Slot(PyObject *self, PyObject *other)
         }
         else {
             mpz_t tempz;
-            mpz_inoc(tempz);
-            mpz_set_PyIntOrLong(tempz, other);
+            mpz_inoc_pylong(tempz, other);
             mpz_add(rz->z, MPZ(self), tempz);
-            mpz_cloc(tempz);
+            mpz_cloc_pylong(tempz);
         }
         return (PyObject*)rz;
     }
@@ -95,10 +94,9 @@ GMPy_MPZ_ISub_Slot(PyObject *self, PyObject *other)
         }
         else {
             mpz_t tempz;
-            mpz_inoc(tempz);
-            mpz_set_PyIntOrLong(tempz, other);
+            mpz_inoc_pylong(tempz, other);
             mpz_sub(rz->z, MPZ(self), tempz);
-            mpz_cloc(tempz);
+            mpz_cloc_pylong(tempz);
         }
         return (PyObject*)rz;
     }
@@ -115,7 +113,7 @@ GMPy_MPZ_IMul_Slot(PyObject *self, PyObject *other)
         return NULL;
 
     if (CHECK_MPZANY(other)) {
-        mpz_mul(rz->z, MPZ(self), MPZ(other));
+        GMPY_MPZ_MUL(rz->z, MPZ(self), MPZ(other));
         return (PyObject*)rz;
     }
 
@@ -128,10 +126,9 @@ GMPy_MPZ_IMul_Slot(PyObject *self, PyObject *other)
         }
         else {
             mpz_t tempz;
-            mpz_inoc(tempz);
-            mpz_set_PyIntOrLong(tempz, other);
-            mpz_mul(rz->z, MPZ(self), tempz);
-            mpz_cloc(tempz);
+            mpz_inoc_pylong(tempz, other);
+            GMPY_MPZ_MUL(rz->z, MPZ(self), tempz);
+            mpz_cloc_pylong(tempz);
         }
         return (PyObject*)rz;
     }
@@ -180,10 +177,9 @@ GMPy_MPZ_IFloorDiv_Slot(PyObject *self, PyObject *other)
         }
         else {
             mpz_t tempz;
-            mpz_inoc(tempz);
-            mpz_set_PyIntOrLong(tempz, other);
+            mpz_inoc_pylong(tempz, other);
             mpz_fdiv_q(rz->z, MPZ(self), tempz);
-            mpz_cloc(tempz);
+            mpz_cloc_pylong(tempz);
         }
         return (PyObject*)rz;
     }
@@ -226,10 +222,9 @@ GMPy_MPZ_IRem_Slot(PyObject *self, PyObject *other)
         }
         else {
             mpz_t tempz;
-            mpz_inoc(tempz);
-            mpz_set_PyIntOrLong(tempz, other);
+            mpz_inoc_pylong(tempz, other);
             mpz_fdiv_r(rz->z, MPZ(self), tempz);
-            mpz_cloc(tempz);
+            mpz_cloc_pylong(tempz);
         }
         return (PyObject*)rz;
     }
@@ -268,6 +263,9 @@ GMPy_MPZ_ILshift_Slot(PyObject *self, PyObject *other)
         if (shift == (mp_bitcnt_t)(-1) && PyErr_Occurred())
             return NULL;
 
+        if (GMPY_LIMB_CHECK((double)mpz_sizeinbase(MPZ(self), 2) + shift, NULL))
+            return NULL;
+
         if (!(rz =  GMPy_MPZ_New(NULL)))
             return NULL;
 
@@ -289,6 +287,9 @@ GMPy_MPZ_IPow_Slot(PyObject *self, PyObject *other, PyObject *mod)
         Py_RETURN_NOTIMPLEMENTED;
     }
 
+    if (GMPY_LIMB_CHECK(exp * GMPy_Limb_Log2_MPZ(MPZ(self)), NULL))
+        return NULL;
+
     if (!(r =  GMPy_MPZ_New(NULL)))
         return NULL;
 
@@ -61,21 +61,21 @@ GMPy_MPZ_Method_NumDigits(PyObject *self, PyObject *args)
 }
 
 static PyObject *
-GMPy_MPZ_Function_NumDigits(PyObject *self, PyObject *args)
+GMPy_MPZ_Function_NumDigits(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     long base = 10;
     Py_ssize_t argc;
     MPZ_Object *temp;
     PyObject *result;
 
-    argc = PyTuple_GET_SIZE(args);
+    argc = nargs;
     if (argc == 0 || argc > 2) {
         TYPE_ERROR("num_digits() requires 'mpz',['int'] arguments");
         return NULL;
     }
 
     if (argc == 2) {
-        base = PyIntOrLong_AsLong(PyTuple_GET_ITEM(args, 1));
+        base = PyIntOrLong_AsLong(args[1]);
         if (base == -1 && PyErr_Occurred()) {
             return NULL;
         }
@@ -86,7 +86,7 @@ GMPy_MPZ_Function_NumDigits(PyObject *self, PyObject *args)
         return NULL;
     }
 
-    if (!(temp = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL))) {
+    if (!(temp = GMPy_MPZ_From_Integer(args[0], NULL))) {
         return NULL;
     }
     
@@ -94,6 +94,7 @@ GMPy_MPZ_Function_NumDigits(PyObject *self, PyObject *args)
     Py_DECREF((PyObject*)temp);
     return result;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_Function_NumDigits)
 
 PyDoc_STRVAR(GMPy_doc_mpz_function_iroot,
 "iroot(x,n) -> (number, boolean)\n\n"
@@ -101,25 +102,25 @@ PyDoc_STRVAR(GMPy_doc_mpz_function_iroot,
 "iff the root is exact. x >= 0. n > 0.");
 
 static PyObject *
-GMPy_MPZ_Function_Iroot(PyObject *self, PyObject *args)
+GMPy_MPZ_Function_Iroot(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     unsigned long n;
     int exact;
     MPZ_Object *root, *tempx;
     PyObject *result;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (nargs != 2) {
         TYPE_ERROR("iroot() requires 'mpz','int' arguments");
         return NULL;
     }
     
-    n = c_ulong_From_Integer(PyTuple_GET_ITEM(args, 1));
+    n = c_ulong_From_Integer(args[1]);
     if ((n == 0) || ((n == (unsigned long)(-1)) && PyErr_Occurred())) {
         VALUE_ERROR("n must be > 0");
         return NULL;
     }
 
-    if (!(tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL))) {
+    if (!(tempx = GMPy_MPZ_From_Integer(args[0], NULL))) {
         return NULL;
     }
     
@@ -145,6 +146,7 @@ GMPy_MPZ_Function_Iroot(PyObject *self, PyObject *args)
     PyTuple_SET_ITEM(result, 1, (PyObject*)PyBool_FromLong(exact));
     return result;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_Function_Iroot)
 
 PyDoc_STRVAR(GMPy_doc_mpz_function_iroot_rem,
 "iroot_rem(x,n) -> (number, number)\n\n"
@@ -152,24 +154,24 @@ PyDoc_STRVAR(GMPy_doc_mpz_function_iroot_rem,
 "root of x and x=y**n + r. x >= 0. n > 0.");
 
 static PyObject *
-GMPy_MPZ_Function_IrootRem(PyObject *self, PyObject *args)
+GMPy_MPZ_Function_IrootRem(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     unsigned long n;
     MPZ_Object *root, *rem, *tempx;
     PyObject *result;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (nargs != 2) {
         TYPE_ERROR("iroot_rem() requires 'mpz','int' arguments");
         return NULL;
     }
     
-    n = c_ulong_From_Integer(PyTuple_GET_ITEM(args, 1));
+    n = c_ulong_From_Integer(args[1]);
     if ((n == 0) || ((n == (unsigned long)(-1)) && PyErr_Occurred())) {
         VALUE_ERROR("n must be > 0");
         return NULL;
     }
 
-    if (!(tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL))) {
+    if (!(tempx = GMPy_MPZ_From_Integer(args[0], NULL))) {
         return NULL;
     }
     
@@ -197,6 +199,7 @@ GMPy_MPZ_Function_IrootRem(PyObject *self, PyObject *args)
     PyTuple_SET_ITEM(result, 1, (PyObject*)rem);
     return result;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_Function_IrootRem)
 
 PyDoc_STRVAR(GMPy_doc_mpz_method_ceil, "Ceiling of an mpz returns itself.");
 
@@ -314,12 +317,12 @@ PyDoc_STRVAR(GMPy_doc_mpz_function_gcd,
 "Return the greatest common denominator of integers a and b.");
 
 static PyObject *
-GMPy_MPZ_Function_GCD(PyObject *self, PyObject *args)
+GMPy_MPZ_Function_GCD(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     PyObject *arg0, *arg1;
     MPZ_Object *result, *tempa, *tempb;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (nargs != 2) {
         TYPE_ERROR("gcd() requires 'mpz','mpz' arguments");
         return NULL;
     }
@@ -328,8 +331,8 @@ GMPy_MPZ_Function_GCD(PyObject *self, PyObject *args)
         return NULL;
     }
 
-    arg0 = PyTuple_GET_ITEM(args, 0);
-    arg1 = PyTuple_GET_ITEM(args, 1);
+    arg0 = args[0];
+    arg1 = args[1];
     if (MPZ_Check(arg0) && MPZ_Check(arg1)) {
         mpz_gcd(result->z, MPZ(arg0), MPZ(arg1));
     }
@@ -350,18 +353,19 @@ GMPy_MPZ_Function_GCD(PyObject *self, PyObject *args)
     }
     return (PyObject*)result;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_Function_GCD)
 
 PyDoc_STRVAR(GMPy_doc_mpz_function_lcm,
 "lcm(a, b) -> mpz\n\n"
 "Return the lowest common multiple of integers a and b.");
 
 static PyObject *
-GMPy_MPZ_Function_LCM(PyObject *self, PyObject *args)
+GMPy_MPZ_Function_LCM(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     PyObject *arg0, *arg1;
     MPZ_Object *result, *tempa, *tempb;
 
-    if(PyTuple_GET_SIZE(args) != 2) {
+    if(nargs != 2) {
         TYPE_ERROR("lcm() requires 'mpz','mpz' arguments");
         return NULL;
     }
@@ -370,8 +374,8 @@ GMPy_MPZ_Function_LCM(PyObject *self, PyObject *args)
         return NULL;
     }
 
-    arg0 = PyTuple_GET_ITEM(args, 0);
-    arg1 = PyTuple_GET_ITEM(args, 1);
+    arg0 = args[0];
+    arg1 = args[1];
 
     if (MPZ_Check(arg0) && MPZ_Check(arg1)) {
         mpz_lcm(result->z, MPZ(arg0), MPZ(arg1));
@@ -392,6 +396,136 @@ GMPy_MPZ_Function_LCM(PyObject *self, PyObject *args)
     }
     return (PyObject*)result;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_Function_LCM)
+
+PyDoc_STRVAR(GMPy_doc_mpz_function_batch_gcd,
+"batch_gcd(moduli) -> list\n\n"
+"Return a list containing gcd(n, p // n) for each n in the sequence of\n"
+"positive integers moduli, where p is the product of all the moduli.\n"
+"A result greater than 1 means that n shares a factor with another\n"
+"modulus. Uses Bernstein's product tree and remainder tree algorithm.");
+
+/* The product tree is stored level by level: tree[0] contains the moduli
+ * and each entry of tree[k+1] is the product of two adjacent entries of
+ * tree[k], or a copy of the last entry if tree[k] has an odd length. The
+ * remainder tree is computed top-down, keeping only two levels at a time:
+ * the remainder of a node is the remainder of its parent modulo the square
+ * of the node. Each level of the product tree is freed once it is no
+ * longer needed.
+ */
+
+static PyObject *
+GMPy_MPZ_Function_BatchGCD(PyObject *self, PyObject *other)
+{
+    PyObject *result = NULL;
+    MPZ_Object **moduli;
+    mpz_t **tree = NULL, *rem = NULL, *next = NULL, *swap, square;
+    Py_ssize_t *size = NULL, i, n, levels = 1, k;
+    size_t bits = 0;
+
+    if (!(moduli = GMPy_MPZ_Array_From_Iterable(other, &n,
+                            "batch_gcd() requires a sequence of integers", NULL)))
+        return NULL;
+
+    for (i = 0; i < n; i++) {
+        if (mpz_sgn(moduli[i]->z) <= 0) {
+            VALUE_ERROR("batch_gcd() requires positive integers");
+            goto done;
+        }
+        bits += mpz_sizeinbase(moduli[i]->z, 2);
+    }
+
+    if (!(result = PyList_New(n)))
+        goto done;
+    for (i = 0; i < n; i++) {
+        PyObject *temp = (PyObject*)GMPy_MPZ_New(NULL);
+
+        if (!temp) {
+            Py_CLEAR(result);
+            goto done;
+        }
+        PyList_SET_ITEM(result, i, temp);
+    }
+    if (n == 0)
+        goto done;
+
+    for (k = n; k > 1; k = (k + 1) / 2)
+        levels++;
+
+    /* Allocate everything while the GIL is held. */
+    if (!(size = GMPY_MALLOC(levels * sizeof(Py_ssize_t))) ||
+        !(tree = GMPY_MALLOC(levels * sizeof(mpz_t*))) ||
+        !(rem = GMPY_MALLOC(n * sizeof(mpz_t))) ||
+        !(next = GMPY_MALLOC(n * sizeof(mpz_t)))) {
+        PyErr_NoMemory();
+        Py_CLEAR(result);
+        goto done;
+    }
+    for (k = 0, size[0] = n; k < levels; k++) {
+        if (k)
+            size[k] = (size[k - 1] + 1) / 2;
+        if (!(tree[k] = GMPY_MALLOC(size[k] * sizeof(mpz_t)))) {
+            while (k)
+                GMPY_FREE(tree[--k]);
+            GMPY_FREE(tree);
+            tree = NULL;
+            PyErr_NoMemory();
+            Py_CLEAR(result);
+            goto done;
+        }
+    }
+
+    GMPY_BEGIN_NOGIL(bits);
+    for (i = 0; i < n; i++)
+        mpz_init_set(tree[0][i], moduli[i]->z);
+    for (k = 1; k < levels; k++) {
+        for (i = 0; i < size[k]; i++) {
+            if (2 * i + 1 < size[k - 1]) {
+                mpz_init(tree[k][i]);
+                mpz_mul(tree[k][i], tree[k - 1][2 * i], tree[k - 1][2 * i + 1]);
+            }
+            else {
+                mpz_init_set(tree[k][i], tree[k - 1][2 * i]);
+            }
+        }
+    }
+
+    mpz_init(square);
+    mpz_init_set(rem[0], tree[levels - 1][0]);
+    for (k = levels - 2; k >= 0; k--) {
+        for (i = 0; i < size[k]; i++) {
+            mpz_init(next[i]);
+            mpz_mul(square, tree[k][i], tree[k][i]);
+            mpz_mod(next[i], rem[i / 2], square);
+        }
+        for (i = 0; i < size[k + 1]; i++)
+            mpz_clear(rem[i]);
+        for (i = 0; i < size[k + 1]; i++)
+            mpz_clear(tree[k + 1][i]);
+        swap = rem;
+        rem = next;
+        next = swap;
+    }
+    for (i = 0; i < n; i++) {
+        mpz_divexact(rem[i], rem[i], tree[0][i]);
+        mpz_gcd(MPZ(PyList_GET_ITEM(result, i)), rem[i], tree[0][i]);
+        mpz_clear(rem[i]);
+        mpz_clear(tree[0][i]);
+    }
+    mpz_clear(square);
+    GMPY_END_NOGIL;
+
+    for (k = 0; k < levels; k++)
+        GMPY_FREE(tree[k]);
+
+  done:
+    GMPY_FREE(tree);
+    GMPY_FREE(size);
+    GMPY_FREE(rem);
+    GMPY_FREE(next);
+    GMPy_MPZ_Array_Free(moduli, n);
+    return result;
+}
 
 PyDoc_STRVAR(GMPy_doc_mpz_function_gcdext,
 "gcdext(a, b) - > tuple\n\n"
@@ -399,12 +533,12 @@ PyDoc_STRVAR(GMPy_doc_mpz_function_gcdext,
 "    g == gcd(a,b) and g == a*s + b*t");
 
 static PyObject *
-GMPy_MPZ_Function_GCDext(PyObject *self, PyObject *args)
+GMPy_MPZ_Function_GCDext(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     PyObject *arg0, *arg1, *result;
     MPZ_Object *g, *s, *t, *tempa, *tempb;
 
-    if(PyTuple_GET_SIZE(args) != 2) {
+    if(nargs != 2) {
         TYPE_ERROR("gcdext() requires 'mpz','mpz' arguments");
         return NULL;
     }
@@ -421,8 +555,8 @@ GMPy_MPZ_Function_GCDext(PyObject *self, PyObject *args)
         return NULL;
     }
 
-    arg0 = PyTuple_GET_ITEM(args, 0);
-    arg1 = PyTuple_GET_ITEM(args, 1);
+    arg0 = args[0];
+    arg1 = args[1];
 
     if (MPZ_Check(arg0) && MPZ_Check(arg1)) {
         mpz_gcdext(g->z, s->z, t->z, MPZ(arg0), MPZ(arg1));
@@ -449,6 +583,7 @@ GMPy_MPZ_Function_GCDext(PyObject *self, PyObject *args)
     PyTuple_SET_ITEM(result, 2, (PyObject*)t);
     return result;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_Function_GCDext)
 
 PyDoc_STRVAR(GMPy_doc_mpz_function_divm,
 "divm(a, b, m) -> mpz\n\n"
@@ -456,13 +591,13 @@ PyDoc_STRVAR(GMPy_doc_mpz_function_divm,
 "exception if no such value x exists.");
 
 static PyObject *
-GMPy_MPZ_Function_Divm(PyObject *self, PyObject *args)
+GMPy_MPZ_Function_Divm(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     MPZ_Object *result, *num, *den, *mod;
     mpz_t numz, denz, modz, gcdz;
     int ok = 0;
 
-    if (PyTuple_GET_SIZE(args) != 3) {
+    if (nargs != 3) {
         TYPE_ERROR("divm() requires 'mpz','mpz','mpz' arguments");
         return NULL;
     }
@@ -471,9 +606,9 @@ GMPy_MPZ_Function_Divm(PyObject *self, PyObject *args)
         return NULL;
     }
 
-    num = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
-    den = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL);
-    mod = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 2), NULL);
+    num = GMPy_MPZ_From_Integer(args[0], NULL);
+    den = GMPy_MPZ_From_Integer(args[1], NULL);
+    mod = GMPy_MPZ_From_Integer(args[2], NULL);
 
     if (!num || !den || !mod) {
         TYPE_ERROR("divm() requires 'mpz','mpz','mpz' arguments");
@@ -528,6 +663,7 @@ GMPy_MPZ_Function_Divm(PyObject *self, PyObject *args)
         return NULL;
     }
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_Function_Divm)
 
 PyDoc_STRVAR(GMPy_doc_mpz_function_fac,
 "fac(n) -> mpz\n\n"
@@ -545,9 +681,14 @@ GMPy_MPZ_Function_Fac(PyObject *self, PyObject *other)
         return NULL;
     }
     
+    if (GMPY_LIMB_CHECK(n * GMPy_Limb_Log2((double)n), NULL))
+        return NULL;
+
+    GMPY_PROBE_ENTRY("fac", n);
     if ((result = GMPy_MPZ_New(NULL))) {
-        mpz_fac_ui(result->z, n);
+        comb_fac(result->z, n);
     }
+    GMPY_PROBE_RETURN("fac", n);
     return (PyObject*)result;
 }
 
@@ -567,9 +708,16 @@ GMPy_MPZ_Function_DoubleFac(PyObject *self, PyObject *other)
         return NULL;
     }
 
+    if (GMPY_LIMB_CHECK(n * GMPy_Limb_Log2((double)n) / 2, NULL))
+        return NULL;
+
+    GMPY_PROBE_ENTRY("double_fac", n);
     if ((result = GMPy_MPZ_New(NULL))) {
+        GMPY_BEGIN_NOGIL(n);
         mpz_2fac_ui(result->z, n);
+        GMPY_END_NOGIL;
     }
+    GMPY_PROBE_RETURN("double_fac", n);
     return (PyObject*)result;
 }
 
@@ -589,9 +737,14 @@ GMPy_MPZ_Function_Primorial(PyObject *self, PyObject *other)
         return NULL;
     }
     
+    if (GMPY_LIMB_CHECK(1.4427 * n, NULL))
+        return NULL;
+
+    GMPY_PROBE_ENTRY("primorial", n);
     if ((result = GMPy_MPZ_New(NULL))) {
-        mpz_primorial_ui(result->z, n);
+        comb_primorial(result->z, n);
     }
+    GMPY_PROBE_RETURN("primorial", n);
     return (PyObject*)result;
 }
 
@@ -601,31 +754,39 @@ PyDoc_STRVAR(GMPy_doc_mpz_function_multi_fac,
 "factorial is defined as n*(n-m)*(n-2m)...");
 
 static PyObject *
-GMPy_MPZ_Function_MultiFac(PyObject *self, PyObject *args)
+GMPy_MPZ_Function_MultiFac(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     MPZ_Object *result = NULL;
     unsigned long n, m;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (nargs != 2) {
         TYPE_ERROR("multi_fac() requires 2 integer arguments");
         return NULL;
     }
 
-    n = c_ulong_From_Integer(PyTuple_GET_ITEM(args, 0));
+    n = c_ulong_From_Integer(args[0]);
     if (n == (unsigned long)(-1) && PyErr_Occurred()) {
         return NULL;
     }
     
-    m = c_ulong_From_Integer(PyTuple_GET_ITEM(args, 1));
+    m = c_ulong_From_Integer(args[1]);
     if (m == (unsigned long)(-1) && PyErr_Occurred()) {
         return NULL;
     }
 
+    if (GMPY_LIMB_CHECK(n * GMPy_Limb_Log2((double)n) / (m ? m : 1), NULL))
+        return NULL;
+
+    GMPY_PROBE_ENTRY("multi_fac", n);
     if ((result = GMPy_MPZ_New(NULL))) {
+        GMPY_BEGIN_NOGIL(n / (m ? m : 1));
         mpz_mfac_uiui(result->z, n, m);
+        GMPY_END_NOGIL;
     }
+    GMPY_PROBE_RETURN("multi_fac", n);
     return (PyObject*)result;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_Function_MultiFac)
 
 PyDoc_STRVAR(GMPy_doc_mpz_function_fib,
 "fib(n) -> mpz\n\n"
@@ -641,6 +802,9 @@ GMPy_MPZ_Function_Fib(PyObject *self, PyObject *other)
     if (n == (unsigned long)(-1) && PyErr_Occurred()) {
         return NULL;
     }
+    if (GMPY_LIMB_CHECK(0.6943 * n, NULL))
+        return NULL;
+
     if ((result = GMPy_MPZ_New(NULL))) {
         mpz_fib_ui(result->z, n);
     }
@@ -663,6 +827,9 @@ GMPy_MPZ_Function_Fib2(PyObject *self, PyObject *other)
         return NULL;
     }
 
+    if (GMPY_LIMB_CHECK(0.6943 * n, NULL))
+        return NULL;
+
     result = PyTuple_New(2);
     fib1 = GMPy_MPZ_New(NULL);
     fib2 = GMPy_MPZ_New(NULL);
@@ -694,6 +861,9 @@ GMPy_MPZ_Function_Lucas(PyObject *self, PyObject *other)
         return NULL;
     }
 
+    if (GMPY_LIMB_CHECK(0.6943 * n, NULL))
+        return NULL;
+
     if ((result = GMPy_MPZ_New(NULL))) {
         mpz_lucnum_ui(result->z, n);
     }
@@ -716,6 +886,9 @@ GMPy_MPZ_Function_Lucas2(PyObject *self, PyObject *other)
         return NULL;
     }
 
+    if (GMPY_LIMB_CHECK(0.6943 * n, NULL))
+        return NULL;
+
     result = PyTuple_New(2);
     luc1 = GMPy_MPZ_New(NULL);
     luc2 = GMPy_MPZ_New(NULL);
@@ -732,6 +905,212 @@ GMPy_MPZ_Function_Lucas2(PyObject *self, PyObject *other)
     return result;
 }
 
+/* Set a = F(n) mod m and b = F(n+1) mod m by fast doubling,
+ *
+ *   F(2k)   = F(k) * (2*F(k+1) - F(k))
+ *   F(2k+1) = F(k)**2 + F(k+1)**2
+ *
+ * reducing after every step. m must be > 0. Moduli below 2**32 use
+ * 64-bit arithmetic.
+ */
+
+static void
+fib_mod_pair(mpz_t a, mpz_t b, mpz_srcptr n, mpz_srcptr m)
+{
+    mp_bitcnt_t i = mpz_sizeinbase(n, 2);
+    mpz_t c, d;
+
+    if (mpz_cmp_ui(m, 0xffffffffUL) <= 0) {
+        uint64_t w = mpz_get_ui(m), x = 0, y = 1 % w, u, v;
+
+        while (i-- > 0) {
+            u = x * ((2 * y + w - x) % w) % w;
+            v = (x * x % w + y * y % w) % w;
+            if (mpz_tstbit(n, i)) {
+                x = v;
+                y = (u + v) % w;
+            }
+            else {
+                x = u;
+                y = v;
+            }
+        }
+        mpz_set_ui(a, (unsigned long)x);
+        mpz_set_ui(b, (unsigned long)y);
+        return;
+    }
+
+    mpz_init(c);
+    mpz_init(d);
+    mpz_set_ui(a, 0);
+    mpz_set_ui(b, 1);
+    while (i-- > 0) {
+        mpz_mul_2exp(c, b, 1);
+        mpz_sub(c, c, a);
+        mpz_mul(c, c, a);
+        mpz_mod(c, c, m);
+        mpz_mul(d, a, a);
+        mpz_addmul(d, b, b);
+        mpz_mod(d, d, m);
+        if (mpz_tstbit(n, i)) {
+            mpz_swap(a, d);
+            mpz_add(b, a, c);
+            if (mpz_cmp(b, m) >= 0)
+                mpz_sub(b, b, m);
+        }
+        else {
+            mpz_swap(a, c);
+            mpz_swap(b, d);
+        }
+    }
+    mpz_clear(c);
+    mpz_clear(d);
+}
+
+/* Compute F(n) and F(n+1) modulo m for the arguments (n, m) of the
+ * Python function name. Returns -1 on error. */
+
+static int
+fib_mod_args(PyObject *args, const char *name, mpz_t a, mpz_t b, mpz_t m)
+{
+    MPZ_Object *tempn, *tempm;
+
+    if (PyTuple_GET_SIZE(args) != 2) {
+        PyErr_Format(PyExc_TypeError, "%s() requires 2 integer arguments", name);
+        return -1;
+    }
+
+    tempn = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
+    tempm = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL);
+    if (!tempn || !tempm) {
+        PyErr_Format(PyExc_TypeError, "%s() requires 2 integer arguments", name);
+        goto error;
+    }
+    if (mpz_sgn(tempn->z) < 0) {
+        PyErr_Format(PyExc_ValueError, "%s() requires n >= 0", name);
+        goto error;
+    }
+    if (mpz_sgn(tempm->z) <= 0) {
+        PyErr_Format(PyExc_ValueError, "%s() requires m > 0", name);
+        goto error;
+    }
+
+    mpz_set(m, tempm->z);
+    GMPY_BEGIN_NOGIL(mpz_sizeinbase(m, 2));
+    fib_mod_pair(a, b, tempn->z, m);
+    GMPY_END_NOGIL;
+    Py_DECREF((PyObject*)tempn);
+    Py_DECREF((PyObject*)tempm);
+    return 0;
+
+  error:
+    Py_XDECREF((PyObject*)tempn);
+    Py_XDECREF((PyObject*)tempm);
+    return -1;
+}
+
+/* Build the result of fib_mod() and friends from F(n) mod m in a and
+ * F(n+1) mod m in b. If lucas is set, use the Lucas numbers
+ * L(n) = 2*F(n+1) - F(n) instead. If pair is set, return a tuple with the
+ * values for n and n-1, in the same order as fib2() and lucas2(). */
+
+static PyObject *
+fib_mod_result(mpz_t a, mpz_t b, mpz_t m, int lucas, int pair)
+{
+    MPZ_Object *r0 = NULL, *r1;
+
+    if (!(r1 = GMPy_MPZ_New(NULL)))
+        return NULL;
+    if (pair && !(r0 = GMPy_MPZ_New(NULL))) {
+        Py_DECREF((PyObject*)r1);
+        return NULL;
+    }
+
+    if (lucas) {
+        /* L(n) = 2*F(n+1) - F(n), L(n-1) = 2*F(n) - F(n-1) */
+        mpz_mul_2exp(r1->z, b, 1);
+        mpz_sub(r1->z, r1->z, a);
+        mpz_mod(r1->z, r1->z, m);
+        if (pair) {
+            mpz_sub(r0->z, b, a);
+            mpz_mul_2exp(b, a, 1);
+            mpz_sub(r0->z, b, r0->z);
+            mpz_mod(r0->z, r0->z, m);
+        }
+    }
+    else {
+        mpz_set(r1->z, a);
+        if (pair) {
+            /* F(n-1) = F(n+1) - F(n) */
+            mpz_sub(r0->z, b, a);
+            mpz_mod(r0->z, r0->z, m);
+        }
+    }
+
+    if (!pair)
+        return (PyObject*)r1;
+    return Py_BuildValue("(NN)", r1, r0);
+}
+
+static PyObject *
+fib_mod_function(PyObject *args, const char *name, int lucas, int pair)
+{
+    PyObject *result = NULL;
+    mpz_t a, b, m;
+
+    mpz_init(a);
+    mpz_init(b);
+    mpz_init(m);
+    if (fib_mod_args(args, name, a, b, m) == 0)
+        result = fib_mod_result(a, b, m, lucas, pair);
+    mpz_clear(a);
+    mpz_clear(b);
+    mpz_clear(m);
+    return result;
+}
+
+PyDoc_STRVAR(GMPy_doc_mpz_function_fib_mod,
+"fib_mod(n, m) -> mpz\n\n"
+"Return the n-th Fibonacci number modulo m. n >= 0 and m > 0.");
+
+static PyObject *
+GMPy_MPZ_Function_FibMod(PyObject *self, PyObject *args)
+{
+    return fib_mod_function(args, "fib_mod", 0, 0);
+}
+
+PyDoc_STRVAR(GMPy_doc_mpz_function_fib2_mod,
+"fib2_mod(n, m) -> tuple\n\n"
+"Return the 2-tuple fib2(n) modulo m, computed without the full\n"
+"Fibonacci numbers. n >= 0 and m > 0.");
+
+static PyObject *
+GMPy_MPZ_Function_Fib2Mod(PyObject *self, PyObject *args)
+{
+    return fib_mod_function(args, "fib2_mod", 0, 1);
+}
+
+PyDoc_STRVAR(GMPy_doc_mpz_function_lucas_mod,
+"lucas_mod(n, m) -> mpz\n\n"
+"Return the n-th Lucas number modulo m. n >= 0 and m > 0.");
+
+static PyObject *
+GMPy_MPZ_Function_LucasMod(PyObject *self, PyObject *args)
+{
+    return fib_mod_function(args, "lucas_mod", 1, 0);
+}
+
+PyDoc_STRVAR(GMPy_doc_mpz_function_lucas2_mod,
+"lucas2_mod(n, m) -> tuple\n\n"
+"Return the 2-tuple lucas2(n) modulo m, computed without the full\n"
+"Lucas numbers. n >= 0 and m > 0.");
+
+static PyObject *
+GMPy_MPZ_Function_Lucas2Mod(PyObject *self, PyObject *args)
+{
+    return fib_mod_function(args, "lucas2_mod", 1, 1);
+}
+
 PyDoc_STRVAR(GMPy_doc_mpz_function_bincoef,
 "bincoef(x, n) -> mpz\n\n"
 "Return the binomial coefficient ('x over n'). n >= 0.");
@@ -742,34 +1121,45 @@ PyDoc_STRVAR(GMPy_doc_mpz_function_comb,
 "time'. n >= 0. Same as bincoef(x, n)");
 
 static PyObject *
-GMPy_MPZ_Function_Bincoef(PyObject *self, PyObject *args)
+GMPy_MPZ_Function_Bincoef(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     MPZ_Object *result = NULL, *tempx;
-    unsigned long k;
+    unsigned long k, n;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (nargs != 2) {
         TYPE_ERROR("bincoef() requires two integer arguments");
         return NULL;
     }
     
-    if (!(tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL))) {
+    if (!(tempx = GMPy_MPZ_From_Integer(args[0], NULL))) {
         return NULL;
     }
 
-    k = c_ulong_From_Integer(PyTuple_GET_ITEM(args, 1));
+    k = c_ulong_From_Integer(args[1]);
     if (k == (unsigned long)(-1) && PyErr_Occurred()) {
         return NULL;
     }
+
+    /* The result has about min(k, x-k)*log2(x) bits. */
+    n = k;
+    if (mpz_fits_ulong_p(tempx->z) && mpz_get_ui(tempx->z) >= k &&
+        mpz_get_ui(tempx->z) - k < k)
+        n = mpz_get_ui(tempx->z) - k;
+    if (GMPY_LIMB_CHECK(n * GMPy_Limb_Log2_MPZ(tempx->z), NULL)) {
+        Py_DECREF((PyObject*)tempx);
+        return NULL;
+    }
     
     if(!(result = GMPy_MPZ_New(NULL))) {
         Py_DECREF((PyObject*)tempx);
         return NULL;
     }
     
-    mpz_bin_ui(result->z, tempx->z, k);
+    comb_bin(result->z, tempx->z, k);
     Py_DECREF((PyObject*)tempx);
     return (PyObject*)result;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_Function_Bincoef)
 
 PyDoc_STRVAR(GMPy_doc_mpz_function_isqrt,
 "isqrt(x) -> mpz\n\n"
@@ -851,13 +1241,13 @@ PyDoc_STRVAR(GMPy_doc_mpz_function_remove,
 "possible. m is the multiplicity f in x. f > 1.");
 
 static PyObject *
-GMPy_MPZ_Function_Remove(PyObject *self, PyObject *args)
+GMPy_MPZ_Function_Remove(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     MPZ_Object *result, *tempx, *tempf;
     PyObject *x, *f;
     size_t multiplicity;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (nargs != 2) {
         TYPE_ERROR("remove() requires 'mpz','mpz' arguments");
         return NULL;
     }
@@ -866,8 +1256,8 @@ GMPy_MPZ_Function_Remove(PyObject *self, PyObject *args)
         return NULL;
     }
     
-    x = PyTuple_GET_ITEM(args, 0);
-    f = PyTuple_GET_ITEM(args, 1);
+    x = args[0];
+    f = args[1];
 
     if (MPZ_Check(x) && MPZ_Check(f)) {
         if (mpz_cmp_si(MPZ(f), 2) < 0) {
@@ -899,6 +1289,7 @@ GMPy_MPZ_Function_Remove(PyObject *self, PyObject *args)
         return Py_BuildValue("(Nk)", result, multiplicity);
     }
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_Function_Remove)
 
 PyDoc_STRVAR(GMPy_doc_mpz_function_invert,
 "invert(x, m) -> mpz\n\n"
@@ -906,13 +1297,13 @@ PyDoc_STRVAR(GMPy_doc_mpz_function_invert,
 "inverse exists.");
 
 static PyObject *
-GMPy_MPZ_Function_Invert(PyObject *self, PyObject *args)
+GMPy_MPZ_Function_Invert(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     PyObject *x, *y;
     MPZ_Object *result, *tempx, *tempy;
     int success;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (nargs != 2) {
         TYPE_ERROR("invert() requires 'mpz','mpz' arguments");
         return NULL;
     }
@@ -921,8 +1312,8 @@ GMPy_MPZ_Function_Invert(PyObject *self, PyObject *args)
         return NULL;
     }
     
-    x = PyTuple_GET_ITEM(args, 0);
-    y = PyTuple_GET_ITEM(args, 1);
+    x = args[0];
+    y = args[1];
 
     if (MPZ_Check(x) && MPZ_Check(y)) {
         if (mpz_sgn(MPZ(y)) == 0) {
@@ -965,6 +1356,153 @@ GMPy_MPZ_Function_Invert(PyObject *self, PyObject *args)
     }
     return (PyObject*)result;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_Function_Invert)
+
+PyDoc_STRVAR(GMPy_doc_mpz_function_invert_many,
+"invert_many(xs, m) -> list\n\n"
+"Return a list of the inverses modulo m of each x in the sequence xs,\n"
+"with None for an x that has no inverse. The inverses are computed\n"
+"with a single invert() and 3*(len(xs)-1) multiplications modulo m.");
+
+/* Montgomery's simultaneous inversion. With r(1), ..., r(k) the residues
+ * that are not 0, the products c(j) = r(1) * ... * r(j) are formed and only
+ * c(k) is inverted. Going back from j = k, the inverse of r(j) is
+ * inv * c(j-1), where inv is the inverse of c(j), and inv * r(j) is the
+ * inverse of c(j-1). The result for r(j) holds c(j-1) until it is
+ * replaced by the inverse.
+ *
+ * If c(k) has no inverse, some residue shares a factor with m, which can
+ * only happen for a composite m. Each residue is then inverted on its
+ * own.
+ */
+
+static PyObject *
+GMPy_MPZ_Function_InvertMany(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *result = NULL;
+    MPZ_Object **xs = NULL, **ys = NULL, *tempm;
+    mpz_t *rs = NULL, mod, inv, t;
+    Py_ssize_t i, n = 0, first = -1, last = -1;
+    size_t bits;
+    int unit;
+
+    if (nargs != 2) {
+        TYPE_ERROR("invert_many() requires 'sequence','mpz' arguments");
+        return NULL;
+    }
+
+    if (!(tempm = GMPy_MPZ_From_Integer(args[1], NULL)))
+        return NULL;
+
+    if (mpz_sgn(tempm->z) == 0) {
+        ZERO_ERROR("invert_many() division by 0");
+        Py_DECREF((PyObject*)tempm);
+        return NULL;
+    }
+
+    mpz_init(mod);
+    mpz_init(inv);
+    mpz_init(t);
+    mpz_abs(mod, tempm->z);
+    unit = mpz_cmp_ui(mod, 1) == 0;
+
+    if (!(xs = GMPy_MPZ_Array_From_Iterable(args[0], &n,
+                                            "invert_many() requires a sequence of integers",
+                                            NULL)))
+        goto done;
+
+    if (!(ys = GMPY_MALLOC((n ? n : 1) * sizeof(MPZ_Object*)))) {
+        PyErr_NoMemory();
+        goto done;
+    }
+    for (i = 0; i < n; i++)
+        ys[i] = NULL;
+    if (!(rs = GMPY_MALLOC((n ? n : 1) * sizeof(mpz_t)))) {
+        PyErr_NoMemory();
+        goto done;
+    }
+    for (i = 0; i < n; i++)
+        mpz_init(rs[i]);
+
+    /* Every integer is its own inverse, 0, modulo 1. */
+    for (i = 0; i < n; i++) {
+        mpz_mod(rs[i], xs[i]->z, mod);
+        if (mpz_sgn(rs[i]) == 0 && !unit)
+            continue;
+        if (!(ys[i] = GMPy_MPZ_New(NULL)))
+            goto done;
+        mpz_set_ui(ys[i]->z, 0);
+        if (first < 0)
+            first = i;
+        last = i;
+    }
+
+    bits = (size_t)n * mpz_sizeinbase(mod, 2);
+    GMPY_BEGIN_NOGIL(bits);
+    if (!unit && first >= 0) {
+        mpz_set(inv, rs[first]);
+        for (i = first + 1; i <= last; i++) {
+            if (!ys[i])
+                continue;
+            mpz_set(ys[i]->z, inv);
+            mpz_mul(inv, inv, rs[i]);
+            mpz_mod(inv, inv, mod);
+        }
+
+        if (mpz_invert(inv, inv, mod)) {
+            for (i = last; i > first; i--) {
+                if (!ys[i])
+                    continue;
+                mpz_mul(t, inv, ys[i]->z);
+                mpz_mod(ys[i]->z, t, mod);
+                mpz_mul(inv, inv, rs[i]);
+                mpz_mod(inv, inv, mod);
+            }
+            mpz_set(ys[first]->z, inv);
+        }
+        else {
+            /* A result left at 0 has no inverse. */
+            for (i = first; i <= last; i++) {
+                if (ys[i] && !mpz_invert(ys[i]->z, rs[i], mod))
+                    mpz_set_ui(ys[i]->z, 0);
+            }
+        }
+    }
+    GMPY_END_NOGIL;
+
+    if (!(result = PyList_New(n)))
+        goto done;
+    for (i = 0; i < n; i++) {
+        if (ys[i] && (unit || mpz_sgn(ys[i]->z))) {
+            PyList_SET_ITEM(result, i, (PyObject*)ys[i]);
+            ys[i] = NULL;
+        }
+        else {
+            Py_INCREF(Py_None);
+            PyList_SET_ITEM(result, i, Py_None);
+        }
+    }
+
+  done:
+    if (rs) {
+        for (i = 0; i < n; i++)
+            mpz_clear(rs[i]);
+        GMPY_FREE(rs);
+    }
+    if (ys) {
+        for (i = 0; i < n; i++)
+            Py_XDECREF((PyObject*)ys[i]);
+        GMPY_FREE(ys);
+    }
+    if (xs)
+        GMPy_MPZ_Array_Free(xs, n);
+    mpz_clear(mod);
+    mpz_clear(inv);
+    mpz_clear(t);
+    Py_DECREF((PyObject*)tempm);
+    return result;
+}
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_Function_InvertMany)
 
 PyDoc_STRVAR(GMPy_doc_mpz_function_divexact,
 "divexact(x, y) -> mpz\n\n"
@@ -972,12 +1510,12 @@ PyDoc_STRVAR(GMPy_doc_mpz_function_divexact,
 "division but requires the remainder is zero!");
 
 static PyObject *
-GMPy_MPZ_Function_Divexact(PyObject *self, PyObject *args)
+GMPy_MPZ_Function_Divexact(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     PyObject *x, *y;
     MPZ_Object *result, *tempx, *tempy;
 
-    if(PyTuple_GET_SIZE(args) != 2) {
+    if(nargs != 2) {
         TYPE_ERROR("divexact() requires 'mpz','mpz' arguments");
         return NULL;
     }
@@ -986,8 +1524,8 @@ GMPy_MPZ_Function_Divexact(PyObject *self, PyObject *args)
         return NULL;
     }
     
-    x = PyTuple_GET_ITEM(args, 0);
-    y = PyTuple_GET_ITEM(args, 1);
+    x = args[0];
+    y = args[1];
 
     if (MPZ_Check(x) && MPZ_Check(y)) {
         if (mpz_sgn(MPZ(y)) == 0) {
@@ -1020,6 +1558,7 @@ GMPy_MPZ_Function_Divexact(PyObject *self, PyObject *args)
     }
     return (PyObject*)result;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_Function_Divexact)
 
 PyDoc_STRVAR(GMPy_doc_mpz_function_is_square,
 "is_square(x) -> bool\n\n"
@@ -1056,22 +1595,22 @@ PyDoc_STRVAR(GMPy_doc_mpz_function_is_divisible,
 "Returns True if x is divisible by d, else return False.");
 
 static PyObject *
-GMPy_MPZ_Function_IsDivisible(PyObject *self, PyObject *args)
+GMPy_MPZ_Function_IsDivisible(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     unsigned long temp;
     int error, res;
     MPZ_Object *tempx, *tempd;
     
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (nargs != 2) {
         TYPE_ERROR("is_divisible() requires 2 integer arguments");
         return NULL;
     }
 
-    if (!(tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL))) {
+    if (!(tempx = GMPy_MPZ_From_Integer(args[0], NULL))) {
         return NULL;
     }
 
-    temp = GMPy_Integer_AsUnsignedLongAndError(PyTuple_GET_ITEM(args, 1), &error);
+    temp = GMPy_Integer_AsUnsignedLongAndError(args[1], &error);
     if (!error) {
         res = mpz_divisible_ui_p(tempx->z, temp);
         Py_DECREF((PyObject*)tempx);
@@ -1081,7 +1620,7 @@ GMPy_MPZ_Function_IsDivisible(PyObject *self, PyObject *args)
             Py_RETURN_FALSE;
     }
         
-    if (!(tempd = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL))) {
+    if (!(tempd = GMPy_MPZ_From_Integer(args[1], NULL))) {
         TYPE_ERROR("is_divisible() requires 2 integer arguments");
         Py_DECREF((PyObject*)tempx);
         return NULL;
@@ -1095,6 +1634,7 @@ GMPy_MPZ_Function_IsDivisible(PyObject *self, PyObject *args)
     else
         Py_RETURN_FALSE;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_Function_IsDivisible)
 
 PyDoc_STRVAR(GMPy_doc_mpz_method_is_divisible,
 "x.is_divisible(d) -> bool\n\n"
@@ -1136,19 +1676,19 @@ PyDoc_STRVAR(GMPy_doc_mpz_function_is_congruent,
 "Returns True if x is congruent to y modulo m, else return False.");
 
 static PyObject *
-GMPy_MPZ_Function_IsCongruent(PyObject *self, PyObject *args)
+GMPy_MPZ_Function_IsCongruent(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     int res;
     MPZ_Object *tempx, *tempy, *tempm;
     
-    if (PyTuple_GET_SIZE(args) != 3) {
+    if (nargs != 3) {
         TYPE_ERROR("is_congruent() requires 3 integer arguments");
         return NULL;
     }
 
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
-    tempy = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL);
-    tempm = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 2), NULL);
+    tempx = GMPy_MPZ_From_Integer(args[0], NULL);
+    tempy = GMPy_MPZ_From_Integer(args[1], NULL);
+    tempm = GMPy_MPZ_From_Integer(args[2], NULL);
     if (!tempx || !tempy || !tempm) {
         Py_XDECREF((PyObject*)tempx);
         Py_XDECREF((PyObject*)tempy);
@@ -1166,6 +1706,7 @@ GMPy_MPZ_Function_IsCongruent(PyObject *self, PyObject *args)
     else
         Py_RETURN_FALSE;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_Function_IsCongruent)
 
 PyDoc_STRVAR(GMPy_doc_mpz_method_is_congruent,
 "x.is_congruent(y, m) -> bool\n\n"
@@ -1231,34 +1772,339 @@ GMPy_MPZ_Function_IsPower(PyObject *self, PyObject *other)
         Py_RETURN_FALSE;
 }
 
+/* The batch root functions keep the last root r together with r**n and,
+ * once needed, (r+1)**n. When the inputs are sorted, most of them have
+ * the same root as the previous input or the next one, and checking the
+ * bounds replaces a full root computation.
+ */
+
+/* Maximum number of times the root is stepped up before falling back to
+ * mpz_sqrt(). */
+#define ROOTS_MAX_STEPS 4
+
+PyDoc_STRVAR(GMPy_doc_mpz_function_isqrt_many,
+"isqrt_many(xs) -> list\n\n"
+"Return the list [isqrt(x) for x in xs]. Sorted inputs are fastest,\n"
+"since each root then starts from the previous one. All x >= 0.");
+
+static PyObject *
+GMPy_MPZ_Function_IsqrtMany(PyObject *self, PyObject *other)
+{
+    PyObject *result = NULL;
+    MPZ_Object **xs = NULL, **roots = NULL;
+    Py_ssize_t i, n = 0;
+    size_t bits = 0;
+    mpz_t r, s, t;
+    int have = 0, k;
+
+    if (!(xs = GMPy_MPZ_Array_From_Iterable(other, &n,
+                "isqrt_many() requires a sequence of integers", NULL)))
+        return NULL;
+
+    for (i = 0; i < n; i++) {
+        if (mpz_sgn(xs[i]->z) < 0) {
+            VALUE_ERROR("isqrt_many() of negative number");
+            goto done;
+        }
+        bits += mpz_sizeinbase(xs[i]->z, 2);
+    }
+
+    if (!(roots = GMPY_MALLOC(sizeof(MPZ_Object*) * (n ? n : 1)))) {
+        PyErr_NoMemory();
+        goto done;
+    }
+    for (i = 0; i < n; i++) {
+        if (!(roots[i] = GMPy_MPZ_New(NULL))) {
+            GMPy_MPZ_Array_Free(roots, i);
+            roots = NULL;
+            goto done;
+        }
+    }
+
+    mpz_init(r);
+    mpz_init(s);
+    mpz_init(t);
+    GMPY_BEGIN_NOGIL(bits);
+    for (i = 0; i < n; i++) {
+        /* Invariant: s == r**2. */
+        if (have && mpz_cmp(xs[i]->z, s) >= 0) {
+            for (k = 0; k < ROOTS_MAX_STEPS; k++) {
+                /* t = (r+1)**2 */
+                mpz_mul_2exp(t, r, 1);
+                mpz_add_ui(t, t, 1);
+                mpz_add(t, t, s);
+                if (mpz_cmp(xs[i]->z, t) < 0)
+                    break;
+                mpz_swap(s, t);
+                mpz_add_ui(r, r, 1);
+            }
+            if (k < ROOTS_MAX_STEPS) {
+                mpz_set(roots[i]->z, r);
+                continue;
+            }
+        }
+        mpz_sqrt(r, xs[i]->z);
+        mpz_mul(s, r, r);
+        have = 1;
+        mpz_set(roots[i]->z, r);
+    }
+    GMPY_END_NOGIL;
+    mpz_clear(r);
+    mpz_clear(s);
+    mpz_clear(t);
+
+    if (!(result = PyList_New(n)))
+        goto done;
+    for (i = 0; i < n; i++) {
+        PyList_SET_ITEM(result, i, (PyObject*)roots[i]);
+        roots[i] = NULL;
+    }
+
+  done:
+    if (roots) {
+        for (i = 0; i < n; i++)
+            Py_XDECREF((PyObject*)roots[i]);
+        GMPY_FREE(roots);
+    }
+    GMPy_MPZ_Array_Free(xs, n);
+    return result;
+}
+
+PyDoc_STRVAR(GMPy_doc_mpz_function_iroot_many,
+"iroot_many(xs, n) -> list\n\n"
+"Return the list [iroot(x, n) for x in xs]. Sorted inputs are fastest,\n"
+"since each root then starts from the previous one. All x >= 0. n > 0.");
+
+static PyObject *
+GMPy_MPZ_Function_IrootMany(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *result = NULL, *item;
+    MPZ_Object **xs = NULL, **roots = NULL;
+    Py_ssize_t i, len = 0;
+    size_t bits = 0;
+    unsigned long n;
+    char *exact = NULL;
+    mpz_t r, lo, hi;
+    int have = 0, have_hi = 0, found;
+
+    if (nargs != 2) {
+        TYPE_ERROR("iroot_many() requires 'sequence','int' arguments");
+        return NULL;
+    }
+
+    n = c_ulong_From_Integer(args[1]);
+    if ((n == 0) || ((n == (unsigned long)(-1)) && PyErr_Occurred())) {
+        VALUE_ERROR("n must be > 0");
+        return NULL;
+    }
+
+    if (!(xs = GMPy_MPZ_Array_From_Iterable(args[0], &len,
+                "iroot_many() requires a sequence of integers", NULL)))
+        return NULL;
+
+    for (i = 0; i < len; i++) {
+        if (mpz_sgn(xs[i]->z) < 0) {
+            VALUE_ERROR("iroot_many() of negative number");
+            goto done;
+        }
+        bits += mpz_sizeinbase(xs[i]->z, 2);
+    }
+
+    if (!(roots = GMPY_MALLOC(sizeof(MPZ_Object*) * (len ? len : 1))) ||
+        !(exact = GMPY_MALLOC(len ? len : 1))) {
+        PyErr_NoMemory();
+        goto done;
+    }
+    for (i = 0; i < len; i++) {
+        if (!(roots[i] = GMPy_MPZ_New(NULL))) {
+            GMPy_MPZ_Array_Free(roots, i);
+            roots = NULL;
+            goto done;
+        }
+    }
+
+    mpz_init(r);
+    mpz_init(lo);
+    mpz_init(hi);
+    GMPY_BEGIN_NOGIL(bits);
+    for (i = 0; i < len; i++) {
+        /* Invariant: lo == r**n and, if have_hi, hi == (r+1)**n. */
+        found = 0;
+        if (have && mpz_cmp(xs[i]->z, lo) >= 0) {
+            if (!have_hi) {
+                mpz_add_ui(hi, r, 1);
+                mpz_pow_ui(hi, hi, n);
+                have_hi = 1;
+            }
+            if (mpz_cmp(xs[i]->z, hi) < 0) {
+                found = 1;
+            }
+            else {
+                /* Try the next root. */
+                mpz_swap(lo, hi);
+                mpz_add_ui(r, r, 1);
+                mpz_add_ui(hi, r, 1);
+                mpz_pow_ui(hi, hi, n);
+                found = mpz_cmp(xs[i]->z, hi) < 0;
+            }
+        }
+        if (!found) {
+            mpz_rootrem(r, lo, xs[i]->z, n);
+            mpz_sub(lo, xs[i]->z, lo);
+            have = 1;
+            have_hi = 0;
+        }
+        exact[i] = mpz_cmp(xs[i]->z, lo) == 0;
+        mpz_set(roots[i]->z, r);
+    }
+    GMPY_END_NOGIL;
+    mpz_clear(r);
+    mpz_clear(lo);
+    mpz_clear(hi);
+
+    if (!(result = PyList_New(len)))
+        goto done;
+    for (i = 0; i < len; i++) {
+        if (!(item = Py_BuildValue("(NO)", roots[i],
+                                   exact[i] ? Py_True : Py_False))) {
+            Py_CLEAR(result);
+            goto done;
+        }
+        roots[i] = NULL;
+        PyList_SET_ITEM(result, i, item);
+    }
+
+  done:
+    if (roots) {
+        for (i = 0; i < len; i++)
+            Py_XDECREF((PyObject*)roots[i]);
+        GMPY_FREE(roots);
+    }
+    if (exact)
+        GMPY_FREE(exact);
+    GMPy_MPZ_Array_Free(xs, len);
+    return result;
+}
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_Function_IrootMany)
+
+/* Return 0 if x > 0 is certainly not a p-th power, for prime p. The
+ * residue of x modulo a few primes q == 1 (mod p) is checked; only one
+ * in p of the nonzero residues modulo q is a p-th power. */
+
+static int
+perfect_power_filter(mpz_srcptr x, unsigned long p)
+{
+    uint64_t q, e, b, a;
+    unsigned long k;
+    int count = 0;
+
+    for (k = 1; count < 6 && (uint64_t)k * p + 1 < 0xffffffffUL; k++) {
+        q = (uint64_t)k * p + 1;
+        if (!(q & 1) || !prp_word_is_prime((mp_limb_t)q))
+            continue;
+        count++;
+        if (!(b = mpz_fdiv_ui(x, (unsigned long)q)))
+            continue;
+        /* a = b**((q-1)/p) mod q must be 1 */
+        for (a = 1, e = (q - 1) / p; e; e >>= 1) {
+            if (e & 1)
+                a = a * b % q;
+            b = b * b % q;
+        }
+        if (a != 1)
+            return 0;
+    }
+    return 1;
+}
+
+PyDoc_STRVAR(GMPy_doc_mpz_function_perfect_power,
+"perfect_power(x) -> tuple\n\n"
+"Return a 2-tuple (y, n) with y**n == x and n as large as possible. If\n"
+"x is not a perfect power, return (x, 1). Negative values of x only\n"
+"have odd powers.");
+
+static PyObject *
+GMPy_MPZ_Function_PerfectPower(PyObject *self, PyObject *other)
+{
+    MPZ_Object *tempx, *base;
+    mp_bitcnt_t v;
+    unsigned long p, e = 1;
+    int neg;
+    mpz_t r;
+
+    if (!(tempx = GMPy_MPZ_From_Integer(other, NULL))) {
+        TYPE_ERROR("perfect_power() requires 'mpz' argument");
+        return NULL;
+    }
+    if (!(base = GMPy_MPZ_New(NULL))) {
+        Py_DECREF((PyObject*)tempx);
+        return NULL;
+    }
+
+    mpz_abs(base->z, tempx->z);
+    neg = mpz_sgn(tempx->z) < 0;
+
+    /* mpz_perfect_power_p() quickly rejects most numbers that are not
+     * powers; the exponents are then found one prime at a time. */
+    if (mpz_cmp_ui(base->z, 1) > 0 && mpz_perfect_power_p(tempx->z)) {
+        mpz_init(r);
+        GMPY_BEGIN_NOGIL(mpz_sizeinbase(base->z, 2));
+        /* The exponent of 2 in x is a multiple of the exponent of x. */
+        v = mpz_scan1(base->z, 0);
+        p = neg ? 3 : 2;
+        while (mpz_sizeinbase(base->z, 2) - 1 >= p && (!v || p <= v)) {
+            if ((!v || v % p == 0) && perfect_power_filter(base->z, p) &&
+                mpz_root(r, base->z, p)) {
+                mpz_swap(base->z, r);
+                e *= p;
+                v /= p;
+                continue;
+            }
+            do {
+                p++;
+            } while (!prp_word_is_prime(p));
+        }
+        GMPY_END_NOGIL;
+        mpz_clear(r);
+    }
+
+    if (neg)
+        mpz_neg(base->z, base->z);
+    Py_DECREF((PyObject*)tempx);
+    return Py_BuildValue("(Nk)", base, e);
+}
+
 PyDoc_STRVAR(GMPy_doc_mpz_function_is_prime,
 "is_prime(x[, n=25]) -> bool\n\n"
 "Return True if x is _probably_ prime, else False if x is\n"
 "definately composite. x is checked for small divisors and up\n"
 "to n Miller-Rabin tests are performed.");
 
+GMPY_PROFILE_WRAP(PyObject *, GMPy_MPZ_Function_IsPrime, (PyObject *self, PyObject *const *args, Py_ssize_t nargs),
+                  (self, args, nargs), gmpy_profile_bits_args(args, nargs))
+
 static PyObject *
-GMPy_MPZ_Function_IsPrime(PyObject *self, PyObject *args)
+GMPy_MPZ_Function_IsPrime_Impl(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     int i, reps = 25;
     MPZ_Object* tempx;
     Py_ssize_t argc;
 
-    argc = PyTuple_GET_SIZE(args);
+    argc = nargs;
 
     if (argc == 0 || argc > 2) {
         TYPE_ERROR("is_prime() requires 'mpz'[,'int'] arguments");
         return NULL; 
     }
         
-    if (PyTuple_GET_SIZE(args) == 2) {
-        reps = c_long_From_Integer(PyTuple_GET_ITEM(args, 1));
+    if (nargs == 2) {
+        reps = c_long_From_Integer(args[1]);
         if (reps == -1 && PyErr_Occurred()) {
             return NULL; 
         }
     }
     
-    if (!(tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL))) {
+    if (!(tempx = GMPy_MPZ_From_Integer(args[0], NULL))) {
         return NULL;
     }
 
@@ -1268,7 +2114,16 @@ GMPy_MPZ_Function_IsPrime(PyObject *self, PyObject *args)
         return NULL;
     }
     
-    i = mpz_probab_prime_p(tempx->z, reps);
+    if (mpz_size(tempx->z) == 1) {
+        i = prp_word_is_prime(mpz_getlimbn(tempx->z, 0));
+    }
+    else {
+        GMPY_PROBE_ENTRY("is_prime", mpz_sizeinbase(tempx->z, 2));
+        GMPY_BEGIN_NOGIL(mpz_sizeinbase(tempx->z, 2));
+        i = mpz_probab_prime_p(tempx->z, reps);
+        GMPY_END_NOGIL;
+        GMPY_PROBE_RETURN("is_prime", mpz_sizeinbase(tempx->z, 2));
+    }
     Py_DECREF((PyObject*)tempx);
     
     if (i)
@@ -1276,29 +2131,255 @@ GMPy_MPZ_Function_IsPrime(PyObject *self, PyObject *args)
     else
         Py_RETURN_FALSE;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_Function_IsPrime)
+
+PyDoc_STRVAR(GMPy_doc_mpz_function_is_prime_many,
+"is_prime_many(candidates[, n=25]) -> list\n\n"
+"Return a list of booleans, one for each integer in candidates, with\n"
+"the same meaning as is_prime(x, n). All candidates share one trial\n"
+"division pass by the primes below 1000 and the tests are run without\n"
+"holding the GIL.");
+
+PyDoc_STRVAR(GMPy_doc_mpz_function_is_bpsw_prp_many,
+"is_bpsw_prp_many(candidates) -> list\n\n"
+"Return a list of booleans, one for each positive integer in\n"
+"candidates, with the same meaning as is_bpsw_prp(n). Candidates with\n"
+"a prime factor below 1000 are rejected by one shared trial division\n"
+"pass before the probable prime tests are run.");
+
+/* Each candidate is trial divided by the primes below PRIME_SIEVE_LIMIT,
+ * using the table shared with the BPSW tests. The state of each candidate
+ * is set to 0 if it is composite and to 1 if it still needs a probable
+ * prime test. Safe to call without the GIL.
+ */
 
-PyDoc_STRVAR(GMPy_doc_mpz_function_next_prime,
-"next_prime(x) -> mpz\n\n"
-"Return the next _probable_ prime number > x.");
+#define PRIME_SIEVE_LIMIT 1000
 
-static PyObject *
-GMPy_MPZ_Function_NextPrime(PyObject *self, PyObject *other)
+static void
+prime_sieve_many(MPZ_Object **candidates, Py_ssize_t n, char *state)
 {
-    MPZ_Object *result;
+    Py_ssize_t i;
+
+    for (i = 0; i < n; i++)
+        state[i] = !prp_trial_divide(candidates[i]->z, PRIME_SIEVE_LIMIT);
+}
+
+static PyObject *
+prime_many_result(char *state, Py_ssize_t n)
+{
+    PyObject *result;
+    Py_ssize_t i;
+
+    if (!(result = PyList_New(n)))
+        return NULL;
+    for (i = 0; i < n; i++) {
+        PyObject *temp = state[i] ? Py_True : Py_False;
+
+        Py_INCREF(temp);
+        PyList_SET_ITEM(result, i, temp);
+    }
+    return result;
+}
+
+/* Called by the thread pool for the candidates start to stop - 1. */
+
+typedef struct {
+    MPZ_Object **candidates;
+    char *state;
+    int reps;
+} prime_many_job;
+
+static void
+prime_many_run(void *arg, Py_ssize_t start, Py_ssize_t stop)
+{
+    prime_many_job *job = (prime_many_job*)arg;
+    MPZ_Object **candidates = job->candidates;
+    char *state = job->state;
+    Py_ssize_t i;
+
+    prime_sieve_many(candidates + start, stop - start, state + start);
+    for (i = start; i < stop; i++) {
+        if (!state[i])
+            continue;
+        if (mpz_size(candidates[i]->z) == 1)
+            state[i] = (char)prp_word_is_prime(mpz_getlimbn(candidates[i]->z, 0));
+        else
+            state[i] = (mpz_probab_prime_p(candidates[i]->z, job->reps) != 0);
+    }
+}
+
+static PyObject *
+GMPy_MPZ_Function_IsPrimeMany(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *result = NULL;
+    MPZ_Object **candidates;
+    Py_ssize_t argc, i, n;
+    size_t bits = 0, *cost;
+    char *state;
+    int reps = 25;
+    prime_many_job job;
+
+    argc = nargs;
+
+    if (argc == 0 || argc > 2) {
+        TYPE_ERROR("is_prime_many() requires 'sequence'[,'int'] arguments");
+        return NULL;
+    }
+
+    if (argc == 2) {
+        reps = c_long_From_Integer(args[1]);
+        if (reps == -1 && PyErr_Occurred()) {
+            return NULL;
+        }
+    }
+
+    if (reps <= 0) {
+        VALUE_ERROR("repetition count for is_prime_many() must be positive");
+        return NULL;
+    }
+
+    if (!(candidates = GMPy_MPZ_Array_From_Iterable(args[0], &n,
+                            "is_prime_many() requires a sequence of integers", NULL)))
+        return NULL;
+
+    state = GMPY_MALLOC(n ? n : 1);
+    cost = GMPY_MALLOC((n ? n : 1) * sizeof(size_t));
+    if (!state || !cost) {
+        PyErr_NoMemory();
+        goto done;
+    }
+
+    for (i = 0; i < n; i++) {
+        cost[i] = mpz_sizeinbase(candidates[i]->z, 2);
+        bits += cost[i];
+    }
+
+    PRP_TRIAL_INIT();
+    job.candidates = candidates;
+    job.state = state;
+    job.reps = reps;
+    if (GMPy_Pool_Run_Checked(prime_many_run, &job, n, cost, bits) == 0)
+        result = prime_many_result(state, n);
+
+  done:
+    if (state)
+        GMPY_FREE(state);
+    if (cost)
+        GMPY_FREE(cost);
+    GMPy_MPZ_Array_Free(candidates, n);
+    return result;
+}
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_Function_IsPrimeMany)
+
+static PyObject *
+GMPy_MPZ_Function_IsBPSWPrpMany(PyObject *self, PyObject *other)
+{
+    PyObject *result = NULL, *test;
+    MPZ_Object **candidates;
+    Py_ssize_t i, n;
+    size_t bits = 0;
+    char *state;
+
+    if (!(candidates = GMPy_MPZ_Array_From_Iterable(other, &n,
+                            "is_bpsw_prp_many() requires a sequence of integers", NULL)))
+        return NULL;
+
+    for (i = 0; i < n; i++) {
+        if (mpz_sgn(candidates[i]->z) <= 0) {
+            VALUE_ERROR("is_bpsw_prp_many() requires 'n' be greater than 0");
+            GMPy_MPZ_Array_Free(candidates, n);
+            return NULL;
+        }
+        bits += mpz_sizeinbase(candidates[i]->z, 2);
+    }
+
+    if (!(state = GMPY_MALLOC(n > 0 ? n : 1))) {
+        PyErr_NoMemory();
+        GMPy_MPZ_Array_Free(candidates, n);
+        return NULL;
+    }
+
+    PRP_TRIAL_INIT();
+    GMPY_BEGIN_NOGIL(bits);
+    prime_sieve_many(candidates, n, state);
+    GMPY_END_NOGIL;
+
+    /* Only the survivors of the shared sieve need the full BPSW test. */
+    for (i = 0; i < n; i++) {
+        if (!state[i])
+            continue;
+        if (!(test = GMPY_mpz_is_bpsw_prp(NULL, (PyObject**)&candidates[i], 1)))
+            goto done;
+        state[i] = (test == Py_True);
+        Py_DECREF(test);
+    }
+
+    result = prime_many_result(state, n);
+
+  done:
+    GMPY_FREE(state);
+    GMPy_MPZ_Array_Free(candidates, n);
+    return result;
+}
+
+PyDoc_STRVAR(GMPy_doc_mpz_function_next_prime,
+"next_prime(x) -> mpz\n\n"
+"Return the next _probable_ prime number > x.");
+
+/* Set r to the next prime after x if it is below the largest prime in a
+ * limb and return 1, otherwise return 0. */
+
+static int
+next_prime_word(mpz_t r, mpz_t x)
+{
+    mp_limb_t n;
+
+    if (mpz_sgn(x) <= 0 || mpz_size(x) != 1 ||
+        (n = mpz_getlimbn(x, 0)) >= GMP_NUMB_MAX - 64)
+        return 0;
+
+    if (n < 2) {
+        n = 2;
+    }
+    else {
+        n = (n + 1) | 1;
+        while (!prp_word_is_prime(n))
+            n += 2;
+    }
+    mpz_import(r, 1, -1, sizeof(mp_limb_t), 0, GMP_NAIL_BITS, &n);
+    return 1;
+}
+
+static PyObject *
+GMPy_MPZ_Function_NextPrime(PyObject *self, PyObject *other)
+{
+    MPZ_Object *result;
+
+    if (MPZ_Check(other) && mpz_size(MPZ(other)) == 1) {
+        if (!(result = GMPy_MPZ_New(NULL)))
+            return NULL;
+        if (next_prime_word(result->z, MPZ(other)))
+            return (PyObject*)result;
+        Py_DECREF((PyObject*)result);
+    }
 
     if(MPZ_Check(other)) {
         if(!(result = GMPy_MPZ_New(NULL))) {
             return NULL;
         }
+        GMPY_BEGIN_NOGIL(mpz_sizeinbase(MPZ(other), 2));
         mpz_nextprime(result->z, MPZ(other));
+        GMPY_END_NOGIL;
     }
     else {
         if (!(result = GMPy_MPZ_From_Integer(other, NULL))) {
             TYPE_ERROR("next_prime() requires 'mpz' argument");
             return NULL;
         }
-        else {
+        else if (!next_prime_word(result->z, result->z)) {
+            GMPY_BEGIN_NOGIL(mpz_sizeinbase(result->z, 2));
             mpz_nextprime(result->z, result->z);
+            GMPY_END_NOGIL;
         }
     }
     return (PyObject*)result;
@@ -1309,18 +2390,18 @@ PyDoc_STRVAR(GMPy_doc_mpz_function_jacobi,
 "Return the Jacobi symbol (x|y). y must be odd and >0.");
 
 static PyObject *
-GMPy_MPZ_Function_Jacobi(PyObject *self, PyObject *args)
+GMPy_MPZ_Function_Jacobi(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     MPZ_Object *tempx, *tempy;
     long res;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (nargs != 2) {
         TYPE_ERROR("jacobi() requires 'mpz','mpz' arguments");
         return NULL;
     }
 
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
-    tempy = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL);
+    tempx = GMPy_MPZ_From_Integer(args[0], NULL);
+    tempy = GMPy_MPZ_From_Integer(args[1], NULL);
     if (!tempx || !tempy) {
         Py_XDECREF((PyObject*)tempx);
         Py_XDECREF((PyObject*)tempy);
@@ -1339,24 +2420,25 @@ GMPy_MPZ_Function_Jacobi(PyObject *self, PyObject *args)
     Py_DECREF((PyObject*)tempy);
     return PyIntOrLong_FromLong(res);
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_Function_Jacobi)
 
 PyDoc_STRVAR(GMPy_doc_mpz_function_legendre,
 "legendre(x, y) -> mpz\n\n"
 "Return the Legendre symbol (x|y). y is assumed to be an odd prime.");
 
 static PyObject *
-GMPy_MPZ_Function_Legendre(PyObject *self, PyObject *args)
+GMPy_MPZ_Function_Legendre(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     MPZ_Object *tempx, *tempy;
     long res;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (nargs != 2) {
         TYPE_ERROR("legendre() requires 'mpz','mpz' arguments");
         return NULL;
     }
 
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
-    tempy = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL);
+    tempx = GMPy_MPZ_From_Integer(args[0], NULL);
+    tempy = GMPy_MPZ_From_Integer(args[1], NULL);
     if (!tempx || !tempy) {
         Py_XDECREF((PyObject*)tempx);
         Py_XDECREF((PyObject*)tempy);
@@ -1375,24 +2457,25 @@ GMPy_MPZ_Function_Legendre(PyObject *self, PyObject *args)
     Py_DECREF((PyObject*)tempy);
     return PyIntOrLong_FromLong(res);
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_Function_Legendre)
 
 PyDoc_STRVAR(GMPy_doc_mpz_function_kronecker,
 "kronecker(x, y) -> mpz\n\n"
 "Return the Kronecker-Jacobi symbol (x|y).");
 
 static PyObject *
-GMPy_MPZ_Function_Kronecker(PyObject *self, PyObject *args)
+GMPy_MPZ_Function_Kronecker(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     MPZ_Object *tempx, *tempy;
     long res;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (nargs != 2) {
         TYPE_ERROR("kronecker() requires 'mpz','mpz' arguments");
         return NULL;
     }
     
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
-    tempy = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL);
+    tempx = GMPy_MPZ_From_Integer(args[0], NULL);
+    tempy = GMPy_MPZ_From_Integer(args[1], NULL);
     if (!tempx || !tempy) {
         Py_XDECREF((PyObject*)tempx);
         Py_XDECREF((PyObject*)tempy);
@@ -1404,6 +2487,477 @@ GMPy_MPZ_Function_Kronecker(PyObject *self, PyObject *args)
     Py_DECREF((PyObject*)tempy);
     return PyIntOrLong_FromLong(res);
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_Function_Kronecker)
+
+PyDoc_STRVAR(GMPy_doc_mpz_function_jacobi_many,
+"jacobi_many(xs, y) -> list\n\n"
+"Return a list of the Jacobi symbols (x|y) for each x in the sequence xs.\n"
+"y must be odd and >0.");
+
+PyDoc_STRVAR(GMPy_doc_mpz_function_legendre_many,
+"legendre_many(xs, y) -> list\n\n"
+"Return a list of the Legendre symbols (x|y) for each x in the sequence\n"
+"xs. y is assumed to be an odd prime.");
+
+/* Shared by jacobi_many() and legendre_many(). For a y that fits in an
+ * unsigned long, mpz_kronecker_ui() reduces each x with a single division
+ * by a limb. */
+
+static PyObject *
+GMPy_MPZ_Jacobi_Many(PyObject *args, const char *name, const char *msg)
+{
+    PyObject *result = NULL, *temp;
+    MPZ_Object **xs = NULL, *tempy;
+    Py_ssize_t i, n = 0;
+    size_t bits = 0;
+    signed char *res = NULL;
+    unsigned long uy = 0;
+    int small;
+
+    if (PyTuple_GET_SIZE(args) != 2) {
+        PyErr_Format(PyExc_TypeError, "%s() requires 'sequence','mpz' arguments", name);
+        return NULL;
+    }
+
+    if (!(tempy = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL)))
+        return NULL;
+
+    if (mpz_sgn(tempy->z) <= 0 || mpz_even_p(tempy->z)) {
+        VALUE_ERROR("y must be odd and >0");
+        goto done;
+    }
+
+    if (!(xs = GMPy_MPZ_Array_From_Iterable(PyTuple_GET_ITEM(args, 0), &n,
+                                            msg, NULL)))
+        goto done;
+
+    if (!(res = GMPY_MALLOC(n ? n : 1))) {
+        PyErr_NoMemory();
+        goto done;
+    }
+
+    if ((small = mpz_fits_ulong_p(tempy->z)))
+        uy = mpz_get_ui(tempy->z);
+    for (i = 0; i < n; i++)
+        bits += mpz_sizeinbase(xs[i]->z, 2);
+
+    GMPY_BEGIN_NOGIL(bits);
+    for (i = 0; i < n; i++) {
+        if (small)
+            res[i] = (signed char)mpz_kronecker_ui(xs[i]->z, uy);
+        else
+            res[i] = (signed char)mpz_jacobi(xs[i]->z, tempy->z);
+    }
+    GMPY_END_NOGIL;
+
+    if (!(result = PyList_New(n)))
+        goto done;
+    for (i = 0; i < n; i++) {
+        if (!(temp = PyIntOrLong_FromLong((long)res[i]))) {
+            Py_CLEAR(result);
+            goto done;
+        }
+        PyList_SET_ITEM(result, i, temp);
+    }
+
+  done:
+    if (res)
+        GMPY_FREE(res);
+    if (xs)
+        GMPy_MPZ_Array_Free(xs, n);
+    Py_DECREF((PyObject*)tempy);
+    return result;
+}
+
+static PyObject *
+GMPy_MPZ_Function_JacobiMany(PyObject *self, PyObject *args)
+{
+    return GMPy_MPZ_Jacobi_Many(args, "jacobi_many",
+                                "jacobi_many() requires a sequence of integers");
+}
+
+static PyObject *
+GMPy_MPZ_Function_LegendreMany(PyObject *self, PyObject *args)
+{
+    return GMPy_MPZ_Jacobi_Many(args, "legendre_many",
+                                "legendre_many() requires a sequence of integers");
+}
+
+/* Square roots modulo a prime. Tonelli-Shanks needs about s**2/4 extra
+ * squarings, where 2**s is the largest power of 2 that divides p - 1, so
+ * Cipolla's method is used instead when s is large compared to the size
+ * of p. The root r is checked before it is returned, so a p that is not
+ * prime is detected instead of giving a wrong result.
+ */
+
+/* Set r to a square root of a modulo the odd prime p using Tonelli-Shanks.
+ * 0 < a < p and a must be a quadratic residue. Returns 0 if p is found to
+ * be composite. */
+
+static int
+sqrtmod_tonelli(mpz_t r, mpz_t a, mpz_t p, mpz_t q, mp_bitcnt_t s)
+{
+    mpz_t z, c, t, b;
+    mp_bitcnt_t m, i;
+    int ok = 1;
+
+    mpz_init(c);
+    mpz_init(t);
+    mpz_init(b);
+    mpz_init_set_ui(z, 2);
+    while (mpz_jacobi(z, p) == 1)
+        mpz_add_ui(z, z, 1);
+    if (mpz_jacobi(z, p) == 0) {
+        ok = 0;
+        goto done;
+    }
+
+    mpz_powm(c, z, q, p);
+    mpz_powm(t, a, q, p);
+    mpz_add_ui(b, q, 1);
+    mpz_tdiv_q_2exp(b, b, 1);
+    mpz_powm(r, a, b, p);
+    m = s;
+    while (mpz_cmp_ui(t, 1) != 0) {
+        mpz_set(b, t);
+        for (i = 0; mpz_cmp_ui(b, 1) != 0; i++) {
+            if (i == m) {
+                ok = 0;
+                goto done;
+            }
+            mpz_mul(b, b, b);
+            mpz_mod(b, b, p);
+        }
+        mpz_set(b, c);
+        while (m-- > i + 1) {
+            mpz_mul(b, b, b);
+            mpz_mod(b, b, p);
+        }
+        mpz_mul(r, r, b);
+        mpz_mod(r, r, p);
+        mpz_mul(c, b, b);
+        mpz_mod(c, c, p);
+        mpz_mul(t, t, c);
+        mpz_mod(t, t, p);
+        m = i;
+    }
+
+  done:
+    mpz_clear(z);
+    mpz_clear(c);
+    mpz_clear(t);
+    mpz_clear(b);
+    return ok;
+}
+
+/* Set r to a square root of a modulo the odd prime p using Cipolla's
+ * method: with w = u**2 - a a nonresidue, (u + sqrt(w))**((p + 1)/2) is a
+ * square root of a in GF(p**2). */
+
+static int
+sqrtmod_cipolla(mpz_t r, mpz_t a, mpz_t p)
+{
+    mpz_t u, w, x0, x1, t, e;
+    mp_bitcnt_t bit;
+    int j, ok = 1;
+
+    mpz_init(w);
+    mpz_init(x0);
+    mpz_init(x1);
+    mpz_init(t);
+    mpz_init(e);
+    mpz_init_set_ui(u, 1);
+    for (;;) {
+        mpz_mul(w, u, u);
+        mpz_sub(w, w, a);
+        mpz_mod(w, w, p);
+        if ((j = mpz_jacobi(w, p)) == -1)
+            break;
+        if (j == 0 && mpz_sgn(w) == 0) {
+            mpz_set(r, u);
+            goto done;
+        }
+        if (j == 0) {
+            ok = 0;
+            goto done;
+        }
+        mpz_add_ui(u, u, 1);
+    }
+
+    /* x0 + x1*sqrt(w) = (u + sqrt(w))**e, e = (p + 1) / 2 */
+    mpz_add_ui(e, p, 1);
+    mpz_tdiv_q_2exp(e, e, 1);
+    mpz_set(x0, u);
+    mpz_set_ui(x1, 1);
+    for (bit = mpz_sizeinbase(e, 2) - 1; bit-- > 0; ) {
+        mpz_mul(t, x0, x1);
+        mpz_mul(x0, x0, x0);
+        mpz_mul(x1, x1, x1);
+        mpz_mul(x1, x1, w);
+        mpz_add(x0, x0, x1);
+        mpz_mod(x0, x0, p);
+        mpz_mul_2exp(x1, t, 1);
+        mpz_mod(x1, x1, p);
+        if (mpz_tstbit(e, bit)) {
+            mpz_mul(t, x1, w);
+            mpz_mul(x1, x1, u);
+            mpz_add(x1, x1, x0);
+            mpz_mod(x1, x1, p);
+            mpz_mul(x0, x0, u);
+            mpz_add(x0, x0, t);
+            mpz_mod(x0, x0, p);
+        }
+    }
+    mpz_set(r, x0);
+
+  done:
+    mpz_clear(u);
+    mpz_clear(w);
+    mpz_clear(x0);
+    mpz_clear(x1);
+    mpz_clear(t);
+    mpz_clear(e);
+    return ok;
+}
+
+/* Set r to the smaller square root of a modulo the prime p. Returns 1 on
+ * success, 0 if a is not a square and -1 if p was found to be composite.
+ * r must not be a or p. */
+
+static int
+mpz_sqrtmod_prime(mpz_t r, mpz_t a, mpz_t p)
+{
+    mpz_t b, q;
+    mp_bitcnt_t s;
+    int ok = 1;
+
+    if (mpz_cmp_ui(p, 2) == 0) {
+        mpz_fdiv_r_2exp(r, a, 1);
+        return 1;
+    }
+    if (mpz_even_p(p))
+        return -1;
+
+    mpz_init(b);
+    mpz_mod(b, a, p);
+    if (mpz_sgn(b) == 0) {
+        mpz_set_ui(r, 0);
+        mpz_clear(b);
+        return 1;
+    }
+    if (mpz_jacobi(b, p) != 1) {
+        mpz_clear(b);
+        return 0;
+    }
+
+    mpz_init(q);
+    mpz_sub_ui(q, p, 1);
+    s = mpz_scan1(q, 0);
+    mpz_tdiv_q_2exp(q, q, s);
+    if (s == 1) {
+        /* p == 3 mod 4: r = a**((p + 1)/4) */
+        mpz_add_ui(q, q, 1);
+        mpz_tdiv_q_2exp(q, q, 1);
+        mpz_powm(r, b, q, p);
+    }
+    else if (s * s > 8 * mpz_sizeinbase(p, 2)) {
+        ok = sqrtmod_cipolla(r, b, p);
+    }
+    else {
+        ok = sqrtmod_tonelli(r, b, p, q, s);
+    }
+
+    if (ok) {
+        mpz_mul(q, r, r);
+        ok = mpz_congruent_p(q, b, p);
+        mpz_sub(q, p, r);
+        if (mpz_cmp(q, r) < 0)
+            mpz_swap(q, r);
+    }
+    mpz_clear(b);
+    mpz_clear(q);
+    return ok ? 1 : -1;
+}
+
+PyDoc_STRVAR(GMPy_doc_mpz_function_sqrtmod,
+"sqrtmod(a, p) -> mpz\n\n"
+"Return the smaller of the two square roots of a modulo the prime p.\n"
+"Raises ValueError if no square root exists or p is found not to be\n"
+"a prime.");
+
+static PyObject *
+GMPy_MPZ_Function_Sqrtmod(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    MPZ_Object *tempa = NULL, *tempp = NULL, *result = NULL;
+    int res;
+
+    if (nargs != 2) {
+        TYPE_ERROR("sqrtmod() requires 'mpz','mpz' arguments");
+        return NULL;
+    }
+
+    if (!(tempa = GMPy_MPZ_From_Integer(args[0], NULL)) ||
+        !(tempp = GMPy_MPZ_From_Integer(args[1], NULL)) ||
+        !(result = GMPy_MPZ_New(NULL)))
+        goto done;
+
+    if (mpz_cmp_ui(tempp->z, 2) < 0)
+        res = -1;
+    else
+        res = mpz_sqrtmod_prime(result->z, tempa->z, tempp->z);
+    if (res <= 0) {
+        if (res == 0)
+            VALUE_ERROR("sqrtmod() no square root exists");
+        else
+            VALUE_ERROR("sqrtmod() requires p to be a prime");
+        Py_CLEAR(result);
+    }
+
+  done:
+    Py_XDECREF((PyObject*)tempa);
+    Py_XDECREF((PyObject*)tempp);
+    return (PyObject*)result;
+}
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_Function_Sqrtmod)
+
+/* Set r to a square root of the odd a modulo 2**k, or return 0 if none
+ * exists. A root r of a mod 2**i is lifted to 2**(i+1) by adding 2**(i-1)
+ * to r when r**2 - a is not divisible by 2**(i+1). */
+
+static int
+sqrtmod_power_of_2(mpz_t r, mpz_t a, unsigned long k)
+{
+    mpz_t t;
+    unsigned long i;
+
+    if (k >= 3 ? mpz_fdiv_ui(a, 8) != 1 : (k == 2 && mpz_fdiv_ui(a, 4) != 1))
+        return 0;
+
+    mpz_init(t);
+    mpz_set_ui(r, 1);
+    for (i = 3; i < k; i++) {
+        mpz_mul(t, r, r);
+        mpz_sub(t, t, a);
+        if (mpz_tstbit(t, i))
+            mpz_setbit(r, i - 1);
+    }
+    mpz_clear(t);
+    return 1;
+}
+
+PyDoc_STRVAR(GMPy_doc_mpz_function_sqrtmod_prime_power,
+"sqrtmod_prime_power(a, p, k) -> mpz\n\n"
+"Return a square root of a modulo p**k, where p is a prime and k > 0.\n"
+"The root is the smaller of r and p**k - r. Raises ValueError if no\n"
+"square root exists.");
+
+static PyObject *
+GMPy_MPZ_Function_SqrtmodPrimePower(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    MPZ_Object *tempa = NULL, *tempp = NULL, *result = NULL;
+    mpz_t a, m, t, u;
+    unsigned long k, v = 0, j;
+    int res = 1;
+
+    if (nargs != 3) {
+        TYPE_ERROR("sqrtmod_prime_power() requires 'mpz','mpz','int' arguments");
+        return NULL;
+    }
+
+    k = c_ulong_From_Integer(args[2]);
+    if (k == (unsigned long)(-1) && PyErr_Occurred())
+        return NULL;
+    if (k == 0) {
+        VALUE_ERROR("sqrtmod_prime_power() requires k > 0");
+        return NULL;
+    }
+
+    if (!(tempa = GMPy_MPZ_From_Integer(args[0], NULL)) ||
+        !(tempp = GMPy_MPZ_From_Integer(args[1], NULL)) ||
+        !(result = GMPy_MPZ_New(NULL))) {
+        Py_XDECREF((PyObject*)tempa);
+        Py_XDECREF((PyObject*)tempp);
+        return NULL;
+    }
+
+    if (mpz_cmp_ui(tempp->z, 2) < 0) {
+        Py_DECREF((PyObject*)tempa);
+        Py_DECREF((PyObject*)tempp);
+        Py_DECREF((PyObject*)result);
+        VALUE_ERROR("sqrtmod_prime_power() requires p to be a prime");
+        return NULL;
+    }
+
+    mpz_init(a);
+    mpz_init(m);
+    mpz_init(t);
+    mpz_init(u);
+    mpz_pow_ui(m, tempp->z, k);
+    mpz_mod(a, tempa->z, m);
+
+    /* a = p**v * b with b coprime to p has a root only if v is even, and
+     * then p**(v/2) * sqrt(b mod p**(k - v)) is one. */
+    if (mpz_sgn(a) == 0) {
+        mpz_set_ui(result->z, 0);
+        goto done;
+    }
+    v = (unsigned long)mpz_remove(a, a, tempp->z);
+    if (v & 1) {
+        res = 0;
+        goto done;
+    }
+    k -= v;
+
+    if (mpz_cmp_ui(tempp->z, 2) == 0) {
+        res = sqrtmod_power_of_2(result->z, a, k);
+    }
+    else if ((res = mpz_sqrtmod_prime(result->z, a, tempp->z)) > 0) {
+        /* Newton's iteration r = r - (r**2 - a) / (2*r) doubles the number
+         * of correct p-adic digits. */
+        for (j = 1; j < k; ) {
+            j = (2 * j < k) ? 2 * j : k;
+            mpz_pow_ui(m, tempp->z, j);
+            mpz_mul(t, result->z, result->z);
+            mpz_sub(t, t, a);
+            mpz_mul_2exp(u, result->z, 1);
+            if (!mpz_invert(u, u, m)) {
+                res = -1;
+                break;
+            }
+            mpz_mul(t, t, u);
+            mpz_sub(result->z, result->z, t);
+            mpz_mod(result->z, result->z, m);
+        }
+    }
+    if (res > 0 && v) {
+        mpz_pow_ui(t, tempp->z, v / 2);
+        mpz_mul(result->z, result->z, t);
+    }
+
+  done:
+    if (res > 0) {
+        mpz_pow_ui(m, tempp->z, k + v);
+        mpz_mod(result->z, result->z, m);
+        mpz_sub(t, m, result->z);
+        if (mpz_cmp(t, result->z) < 0)
+            mpz_swap(t, result->z);
+    }
+    mpz_clear(a);
+    mpz_clear(m);
+    mpz_clear(t);
+    mpz_clear(u);
+    Py_DECREF((PyObject*)tempa);
+    Py_DECREF((PyObject*)tempp);
+    if (res <= 0) {
+        if (res == 0)
+            VALUE_ERROR("sqrtmod_prime_power() no square root exists");
+        else
+            VALUE_ERROR("sqrtmod_prime_power() requires p to be a prime");
+        Py_CLEAR(result);
+    }
+    return (PyObject*)result;
+}
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_Function_SqrtmodPrimePower)
 
 PyDoc_STRVAR(GMPy_doc_mpz_function_is_even,
 "is_even(x) -> bool\n\n"
@@ -1514,7 +3068,10 @@ GMPy_MPZ_Method_SubScript(MPZ_Object *self, PyObject *item)
         }
 
         mpz_set_ui(result->z, 0);
-        if (slicelength > 0) {
+        if (slicelength > 0 && step == 1) {
+            GMPy_MPZ_Get_Bits(result->z, self->z, start, slicelength);
+        }
+        else if (slicelength > 0) {
             for (cur = start, i = 0; i < slicelength; cur += step, i++) {
                 if(mpz_tstbit(self->z, cur)) {
                     mpz_setbit(result->z, i);
@@ -1559,3 +3116,192 @@ GMPy_MPZ_Method_SizeOf(PyObject *self, PyObject *other)
         (MPZ(self)->_mp_alloc * sizeof(mp_limb_t)));
 }
 
+#ifdef PY3
+/* An mpz exports its limbs, least significant limb first, as a read-only
+ * buffer of bytes. The sign is not included.
+ */
+
+static int
+GMPy_MPZ_GetBuffer(MPZ_Object *self, Py_buffer *view, int flags)
+{
+    return PyBuffer_FillInfo(view, (PyObject*)self, self->z->_mp_d,
+                             (Py_ssize_t)(mpz_size(self->z) * sizeof(mp_limb_t)),
+                             1, flags);
+}
+
+/* Parse the byteorder argument of to_bytes() and from_bytes(). Returns 1
+ * for big-endian, -1 for little-endian, and 0 on error.
+ */
+
+static int
+bytes_order(const char *byteorder)
+{
+    if (!strcmp(byteorder, "big"))
+        return 1;
+    if (!strcmp(byteorder, "little"))
+        return -1;
+    VALUE_ERROR("byteorder must be either 'little' or 'big'");
+    return 0;
+}
+
+/* Write z to buf[0:length] in the format of int.to_bytes(). The bytes are
+ * written by mpz_export() directly; a negative value -m is stored as the
+ * complement of m - 1.
+ */
+
+static int
+bytes_export(mpz_t z, unsigned char *buf, Py_ssize_t length, int order, int is_signed)
+{
+    mpz_t temp;
+    size_t bits, count = 0;
+    Py_ssize_t i;
+    int negative = mpz_sgn(z) < 0;
+
+    if (negative && !is_signed) {
+        OVERFLOW_ERROR("can't convert negative int to unsigned");
+        return -1;
+    }
+
+    if (negative) {
+        mpz_init(temp);
+        mpz_neg(temp, z);
+        mpz_sub_ui(temp, temp, 1);
+    }
+    else {
+        temp[0] = z[0];
+    }
+
+    bits = mpz_sgn(temp) ? mpz_sizeinbase(temp, 2) : 0;
+    /* As with int.to_bytes(), 0 and -1 fit in zero bytes. */
+    if (bits && bits + (is_signed ? 1 : 0) > (size_t)length * 8) {
+        if (negative)
+            mpz_clear(temp);
+        OVERFLOW_ERROR("int too big to convert");
+        return -1;
+    }
+
+    count = (bits + 7) / 8;
+    memset(buf, 0, length);
+    if (count)
+        mpz_export(order > 0 ? buf + length - count : buf, NULL, order, 1, 0, 0, temp);
+
+    if (negative) {
+        mpz_clear(temp);
+        for (i = 0; i < length; i++)
+            buf[i] = (unsigned char)~buf[i];
+    }
+    return 0;
+}
+
+PyDoc_STRVAR(GMPy_doc_mpz_method_to_bytes,
+"x.to_bytes(length=1, byteorder='big', *, signed=False, out=None)\n\n"
+"Return an array of bytes representing x, like int.to_bytes(). If 'out'\n"
+"is a writable buffer, the bytes are written to it instead and 'out'\n"
+"is returned; 'length' then defaults to the size of the buffer.");
+
+static PyObject *
+GMPy_MPZ_Method_ToBytes(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    Py_ssize_t length = -1;
+    const char *byteorder = "big";
+    int order, is_signed = 0;
+    PyObject *out = NULL, *result;
+    Py_buffer view;
+    static char *kwlist[] = {"length", "byteorder", "signed", "out", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|ns$pO", kwlist,
+                                     &length, &byteorder, &is_signed, &out))
+        return NULL;
+
+    if (!(order = bytes_order(byteorder)))
+        return NULL;
+
+    if (out && out != Py_None) {
+        if (PyObject_GetBuffer(out, &view, PyBUF_WRITABLE) < 0)
+            return NULL;
+        if (length < 0)
+            length = view.len;
+        if (length > view.len) {
+            PyBuffer_Release(&view);
+            VALUE_ERROR("to_bytes() buffer is smaller than length");
+            return NULL;
+        }
+        if (bytes_export(MPZ(self), (unsigned char*)view.buf, length, order, is_signed) < 0) {
+            PyBuffer_Release(&view);
+            return NULL;
+        }
+        PyBuffer_Release(&view);
+        Py_INCREF(out);
+        return out;
+    }
+
+    if (length < 0)
+        length = 1;
+    if (!(result = PyBytes_FromStringAndSize(NULL, length)))
+        return NULL;
+    if (bytes_export(MPZ(self), (unsigned char*)PyBytes_AS_STRING(result),
+                     length, order, is_signed) < 0) {
+        Py_DECREF(result);
+        return NULL;
+    }
+    return result;
+}
+
+PyDoc_STRVAR(GMPy_doc_mpz_method_from_bytes,
+"mpz_from_bytes(bytes, byteorder='big', *, signed=False) -> mpz\n\n"
+"Return the mpz represented by the given array of bytes, like\n"
+"int.from_bytes(). Any object supporting the buffer protocol is read\n"
+"in place. Also available as the class method from_bytes() of mpz.");
+
+static PyObject *
+GMPy_MPZ_Method_FromBytes(PyObject *type, PyObject *args, PyObject *kwargs)
+{
+    PyObject *obj, *bytes = NULL;
+    const char *byteorder = "big";
+    int order, is_signed = 0;
+    unsigned char *buf;
+    Py_buffer view;
+    MPZ_Object *result;
+    static char *kwlist[] = {"bytes", "byteorder", "signed", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|s$p", kwlist,
+                                     &obj, &byteorder, &is_signed))
+        return NULL;
+
+    if (!(order = bytes_order(byteorder)))
+        return NULL;
+
+    /* Like int.from_bytes(), accept an iterable of small integers. */
+    if (!PyObject_CheckBuffer(obj)) {
+        if (!(bytes = PyBytes_FromObject(obj)))
+            return NULL;
+        obj = bytes;
+    }
+
+    if (PyObject_GetBuffer(obj, &view, PyBUF_SIMPLE) < 0) {
+        Py_XDECREF(bytes);
+        return NULL;
+    }
+
+    if (!(result = GMPy_MPZ_New(NULL))) {
+        PyBuffer_Release(&view);
+        Py_XDECREF(bytes);
+        return NULL;
+    }
+
+    buf = (unsigned char*)view.buf;
+    mpz_import(result->z, view.len, order, 1, 0, 0, buf);
+    if (is_signed && view.len && (buf[order > 0 ? 0 : view.len - 1] & 0x80)) {
+        mpz_t temp;
+
+        mpz_init(temp);
+        mpz_setbit(temp, (mp_bitcnt_t)view.len * 8);
+        mpz_sub(result->z, result->z, temp);
+        mpz_clear(temp);
+    }
+
+    PyBuffer_Release(&view);
+    Py_XDECREF(bytes);
+    return (PyObject*)result;
+}
+#endif
@@ -41,46 +41,68 @@ static PyObject * GMPy_MPZ_Method_Floor(PyObject *self, PyObject *other);
 static PyObject * GMPy_MPZ_Method_Trunc(PyObject *self, PyObject *other);
 static PyObject * GMPy_MPZ_Method_Round(PyObject *self, PyObject *other);
 static PyObject * GMPy_MPZ_Method_NumDigits(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPZ_Function_NumDigits(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPZ_Function_Iroot(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPZ_Function_IrootRem(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPZ_Function_Bincoef(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPZ_Function_GCD(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPZ_Function_LCM(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPZ_Function_GCDext(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPZ_Function_Divm(PyObject *self, PyObject *args);
+static PyObject * GMPy_MPZ_Function_NumDigits(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPy_MPZ_Function_Iroot(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPy_MPZ_Function_IrootRem(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPy_MPZ_Function_Bincoef(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPy_MPZ_Function_GCD(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPy_MPZ_Function_BatchGCD(PyObject *self, PyObject *other);
+static PyObject * GMPy_MPZ_Function_LCM(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPy_MPZ_Function_GCDext(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPy_MPZ_Function_Divm(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 static PyObject * GMPy_MPZ_Function_Fac(PyObject *self, PyObject *other);
 static PyObject * GMPy_MPZ_Function_Primorial(PyObject *self, PyObject *other);
 static PyObject * GMPy_MPZ_Function_DoubleFac(PyObject *self, PyObject *other);
-static PyObject * GMPy_MPZ_Function_MultiFac(PyObject *self, PyObject *args);
+static PyObject * GMPy_MPZ_Function_MultiFac(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 static PyObject * GMPy_MPZ_Function_Fib(PyObject *self, PyObject *other);
 static PyObject * GMPy_MPZ_Function_Fib2(PyObject *self, PyObject *other);
 static PyObject * GMPy_MPZ_Function_Lucas(PyObject *self, PyObject *other);
 static PyObject * GMPy_MPZ_Function_Lucas2(PyObject *self, PyObject *other);
+static PyObject * GMPy_MPZ_Function_FibMod(PyObject *self, PyObject *args);
+static PyObject * GMPy_MPZ_Function_Fib2Mod(PyObject *self, PyObject *args);
+static PyObject * GMPy_MPZ_Function_LucasMod(PyObject *self, PyObject *args);
+static PyObject * GMPy_MPZ_Function_Lucas2Mod(PyObject *self, PyObject *args);
 static PyObject * GMPy_MPZ_Function_Isqrt(PyObject *self, PyObject *other);
 static PyObject * GMPy_MPZ_Function_IsqrtRem(PyObject *self, PyObject *other);
-static PyObject * GMPy_MPZ_Function_Remove(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPZ_Function_Invert(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPZ_Function_Divexact(PyObject *self, PyObject *args);
+static PyObject * GMPy_MPZ_Function_Remove(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPy_MPZ_Function_Invert(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPy_MPZ_Function_InvertMany(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPy_MPZ_Function_Divexact(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 static PyObject * GMPy_MPZ_Function_IsSquare(PyObject *self, PyObject *other);
 
-static PyObject * GMPy_MPZ_Function_IsDivisible(PyObject *self, PyObject *args);
+static PyObject * GMPy_MPZ_Function_IsDivisible(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 static PyObject * GMPy_MPZ_Method_IsDivisible(PyObject *self, PyObject *other);
 
-static PyObject * GMPy_MPZ_Function_IsCongruent(PyObject *self, PyObject *args);
+static PyObject * GMPy_MPZ_Function_IsCongruent(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 static PyObject * GMPy_MPZ_Method_IsCongruent(PyObject *self, PyObject *args);
 
 static PyObject * GMPy_MPZ_Function_IsPower(PyObject *self, PyObject *other);
-static PyObject * GMPy_MPZ_Function_IsPrime(PyObject *self, PyObject *args);
+static PyObject * GMPy_MPZ_Function_IsqrtMany(PyObject *self, PyObject *other);
+static PyObject * GMPy_MPZ_Function_IrootMany(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPy_MPZ_Function_PerfectPower(PyObject *self, PyObject *other);
+static PyObject * GMPy_MPZ_Function_IsPrime(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPy_MPZ_Function_IsPrimeMany(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPy_MPZ_Function_IsBPSWPrpMany(PyObject *self, PyObject *other);
+static int        next_prime_word(mpz_t r, mpz_t x);
 static PyObject * GMPy_MPZ_Function_NextPrime(PyObject *self, PyObject *other);
-static PyObject * GMPy_MPZ_Function_Jacobi(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPZ_Function_Legendre(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPZ_Function_Kronecker(PyObject *self, PyObject *args);
+static PyObject * GMPy_MPZ_Function_Jacobi(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPy_MPZ_Function_Legendre(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPy_MPZ_Function_Kronecker(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPy_MPZ_Function_JacobiMany(PyObject *self, PyObject *args);
+static PyObject * GMPy_MPZ_Function_LegendreMany(PyObject *self, PyObject *args);
+static PyObject * GMPy_MPZ_Function_Sqrtmod(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPy_MPZ_Function_SqrtmodPrimePower(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 static PyObject * GMPy_MPZ_Function_IsEven(PyObject *self, PyObject *other);
 static PyObject * GMPy_MPZ_Function_IsOdd(PyObject *self, PyObject *other);
 static Py_ssize_t GMPy_MPZ_Method_Length(MPZ_Object *self);
 static PyObject * GMPy_MPZ_Method_SubScript(MPZ_Object *self, PyObject *item);
 
+#ifdef PY3
+static int        GMPy_MPZ_GetBuffer(MPZ_Object *self, Py_buffer *view, int flags);
+static PyObject * GMPy_MPZ_Method_ToBytes(PyObject *self, PyObject *args, PyObject *kwargs);
+static PyObject * GMPy_MPZ_Method_FromBytes(PyObject *type, PyObject *args, PyObject *kwargs);
+#endif
+
 #if PY_MAJOR_VERSION < 3
 static PyObject * GMPy_MPZ_Oct_Slot(MPZ_Object *self);
 static PyObject * GMPy_MPZ_Hex_Slot(MPZ_Object *self);
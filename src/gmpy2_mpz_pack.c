@@ -29,102 +29,317 @@
  **************************************************************************
  * pack and unpack methods
  *
- * Both pack and unpack use a devious trick when stuffing values into the
- * internal structure of an mpz_t. By setting a bit beyond the range of
- * interest, we are guaranteed that memory will remain available. When
- * the bit is cleared, it also triggers normalization of the value by
- * accounting for leading bits that are zero.
+ * Element i of pack() and unpack() occupies bits i*n ... i*n+n-1 of the
+ * mpz. The limbs of the result are written directly: an element starting
+ * at bit offset 'off' within a limb is ORed into the limbs shifted left by
+ * 'off' bits, so when n is a multiple of GMP_NUMB_BITS every element is a
+ * plain copy of limbs. Elements of at most 64 bits that are Python ints or
+ * words of a buffer are never converted to an mpz.
  **************************************************************************
  */
 
+#define PACK_LIMBS(nbits) ((mp_size_t)(((nbits) + GMP_NUMB_BITS - 1) / GMP_NUMB_BITS))
+
+/* OR the 'size' limbs at src, shifted left by 'pos' bits, into dst. */
+
+static void
+pack_limbs(mp_limb_t *dst, mp_bitcnt_t pos, const mp_limb_t *src, mp_size_t size)
+{
+    mp_size_t i, idx = (mp_size_t)(pos / GMP_NUMB_BITS);
+    unsigned int off = (unsigned int)(pos % GMP_NUMB_BITS);
+
+    if (off == 0) {
+        for (i = 0; i < size; i++)
+            dst[idx + i] |= src[i];
+    }
+    else {
+        for (i = 0; i < size; i++) {
+            dst[idx + i] |= src[i] << off;
+            dst[idx + i + 1] |= src[i] >> (GMP_NUMB_BITS - off);
+        }
+    }
+}
+
+/* Store the 'nbits' bits starting at bit 'pos' of the 'size' limbs at src
+ * in dst, which has room for PACK_LIMBS(nbits) limbs. Returns the number
+ * of limbs of the normalized result.
+ */
+
+static mp_size_t
+unpack_limbs(mp_limb_t *dst, const mp_limb_t *src, mp_size_t size,
+             mp_bitcnt_t pos, mp_bitcnt_t nbits)
+{
+    mp_size_t i, count = PACK_LIMBS(nbits), idx = (mp_size_t)(pos / GMP_NUMB_BITS);
+    unsigned int off = (unsigned int)(pos % GMP_NUMB_BITS);
+    mp_limb_t lo, hi;
+
+    for (i = 0; i < count; i++) {
+        lo = idx + i < size ? src[idx + i] : 0;
+        if (off) {
+            hi = idx + i + 1 < size ? src[idx + i + 1] : 0;
+            lo = (lo >> off) | (hi << (GMP_NUMB_BITS - off));
+        }
+        dst[i] = lo;
+    }
+    if (nbits % GMP_NUMB_BITS)
+        dst[count - 1] &= ((mp_limb_t)1 << (nbits % GMP_NUMB_BITS)) - 1;
+    while (count > 0 && dst[count - 1] == 0)
+        count--;
+    return count;
+}
+
+/* Split a value of at most 64 bits into limbs. Returns the number of
+ * limbs used.
+ */
+
+static mp_size_t
+pack_word(mp_limb_t *limbs, uint64_t v)
+{
+#if GMP_NUMB_BITS >= 64
+    limbs[0] = (mp_limb_t)v;
+    return 1;
+#else
+    limbs[0] = (mp_limb_t)v;
+    limbs[1] = (mp_limb_t)(v >> 32);
+    return 2;
+#endif
+}
+
+/* Read a word of an integer buffer as an unsigned value. Returns -1 if the
+ * word is negative.
+ */
+
+static int
+pack_read_word(const char *p, Py_ssize_t itemsize, int is_signed, uint64_t *v)
+{
+    switch (itemsize) {
+        case 1: {
+            if (is_signed) {
+                if (*(signed char*)p < 0)
+                    return -1;
+            }
+            *v = *(unsigned char*)p;
+            return 0;
+        }
+        case 2: {
+            uint16_t w;
+
+            memcpy(&w, p, 2);
+            if (is_signed && (int16_t)w < 0)
+                return -1;
+            *v = w;
+            return 0;
+        }
+        case 4: {
+            uint32_t w;
+
+            memcpy(&w, p, 4);
+            if (is_signed && (int32_t)w < 0)
+                return -1;
+            *v = w;
+            return 0;
+        }
+        default: {
+            uint64_t w;
+
+            memcpy(&w, p, 8);
+            if (is_signed && (int64_t)w < 0)
+                return -1;
+            *v = w;
+            return 0;
+        }
+    }
+}
+
+/* Return the item size of a buffer format for native integers, or 0 if the
+ * format is not supported. *is_signed is set for signed formats.
+ */
+
+static Py_ssize_t
+pack_format(const char *format, Py_ssize_t itemsize, int *is_signed)
+{
+    if (!format)
+        format = "B";
+    if (format[0] == '@' || format[0] == '=')
+        format++;
+    if (!format[0] || format[1] || !strchr("bBhHiIlLqQnN", format[0]))
+        return 0;
+    *is_signed = islower((unsigned char)format[0]);
+    if (itemsize != 1 && itemsize != 2 && itemsize != 4 && itemsize != 8)
+        return 0;
+    return itemsize;
+}
+
 PyDoc_STRVAR(doc_pack,
 "pack(lst, n) -> mpz\n\n"
 "Pack a list of integers 'lst' into a single 'mpz' by concatenating\n"
 "each integer element of 'lst' after padding to length n bits. Raises\n"
 "an error if any integer is negative or greater than n bits in\n"
-"length.");
+"length. Instead of a list, 'lst' may be an object that supports the\n"
+"buffer protocol (bytes, array.array, numpy array) with words of 1, 2,\n"
+"4, or 8 bytes.");
 
 static PyObject *
-GMPy_MPZ_pack(PyObject *self, PyObject *args)
+GMPy_MPZ_pack(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
-    mp_bitcnt_t nbits, total_bits, tempx_bits;
-    Py_ssize_t index, lst_count, i, temp_bits, limb_count;
-    PyObject *lst;
-    mpz_t temp;
+    mp_bitcnt_t nbits, total_bits, pos;
+    Py_ssize_t index, lst_count, itemsize = 0;
+    mp_size_t limb_count, size;
+    PyObject *lst, *item;
+    mp_limb_t *d, word[2];
+    Py_buffer view;
+    uint64_t v;
+    int is_signed = 0, is_buffer = 0;
     MPZ_Object *result, *tempx = 0;
     CTXT_Object *context = NULL;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (nargs != 2) {
         TYPE_ERROR("pack() requires 'list','int' arguments");
         return NULL;
     }
 
-    nbits = mp_bitcnt_t_From_Integer(PyTuple_GET_ITEM(args, 1));
+    nbits = mp_bitcnt_t_From_Integer(args[1]);
     if (nbits == -1 && PyErr_Occurred()) {
         return NULL;
     }
 
-    if (!PyList_Check(PyTuple_GET_ITEM(args, 0))) {
+    lst = args[0];
+    if (PyList_Check(lst)) {
+        lst_count = PyList_GET_SIZE(lst);
+    }
+    else if (PyObject_CheckBuffer(lst)) {
+        if (PyObject_GetBuffer(lst, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) < 0)
+            return NULL;
+        if (!(itemsize = pack_format(view.format, view.itemsize, &is_signed))) {
+            PyBuffer_Release(&view);
+            TYPE_ERROR("pack() requires a buffer of integers");
+            return NULL;
+        }
+        is_buffer = 1;
+        lst_count = view.len / itemsize;
+    }
+    else {
         TYPE_ERROR("pack() requires 'list','int' arguments");
         return NULL;
     }
 
-    if (!(result = GMPy_MPZ_New(context)))
-        return NULL;
-
-    lst = PyTuple_GET_ITEM(args, 0);
-    lst_count = PyList_GET_SIZE(lst);
     total_bits = nbits * lst_count;
-
-    if ((total_bits / lst_count) != nbits) {
+    if (lst_count && (total_bits / lst_count) != nbits) {
         VALUE_ERROR("result too large to store in an 'mpz'");
-        return NULL;
+        goto error_buffer;
     }
 
+    if (!(result = GMPy_MPZ_New(context)))
+        goto error_buffer;
+
+    /* One more limb than needed: pack_limbs() may write a zero limb past
+     * the last element.
+     */
+    limb_count = PACK_LIMBS(total_bits) + 1;
     mpz_set_ui(result->z, 0);
-    mpz_setbit(result->z, total_bits + (mp_bits_per_limb * 2));
+    if (total_bits) {
+        mpz_realloc2(result->z, (mp_bitcnt_t)limb_count * GMP_NUMB_BITS);
+        d = result->z->_mp_d;
+        memset(d, 0, limb_count * sizeof(mp_limb_t));
+    }
+    else {
+        d = NULL;
+    }
 
-    mpz_inoc(temp);
-    mpz_set_ui(temp, 0);
-    limb_count = 0;
-    tempx_bits = 0;
+    for (index = 0, pos = 0; index < lst_count; index++, pos += nbits) {
+        if (is_buffer) {
+            if (pack_read_word((char*)view.buf + index * itemsize, itemsize,
+                               is_signed, &v) < 0 ||
+                (nbits < 64 && (v >> nbits)))
+                goto error_range;
+            if (v)
+                pack_limbs(d, pos, word, pack_word(word, v));
+            continue;
+        }
 
-    for (index = 0; index < lst_count; index++) {
-        if (!(tempx = GMPy_MPZ_From_Integer(PyList_GetItem(lst, index), context))
+        item = PyList_GET_ITEM(lst, index);
+#ifdef PY3
+        if (PyLong_CheckExact(item) && nbits <= 64 && Py_SIZE(item) >= 0) {
+            v = PyLong_AsUnsignedLongLong(item);
+            if (v == (uint64_t)-1 && PyErr_Occurred()) {
+                PyErr_Clear();
+                goto error_range;
+            }
+            if (nbits < 64 && (v >> nbits))
+                goto error_range;
+            if (v)
+                pack_limbs(d, pos, word, pack_word(word, v));
+            continue;
+        }
+#endif
+        if (!(tempx = GMPy_MPZ_From_Integer(item, context))
             || (mpz_sgn(tempx->z) < 0)
             || (mpz_sizeinbase(tempx->z,2) > (size_t)nbits)) {
-            TYPE_ERROR("pack() requires list elements be positive integers < 2^n bits");
-            mpz_cloc(temp);
             Py_XDECREF((PyObject*)tempx);
-            Py_DECREF((PyObject*)result);
-            return NULL;
-        }
-        mpz_mul_2exp(tempx->z, tempx->z, tempx_bits);
-        mpz_add(temp, temp, tempx->z);
-        tempx_bits += nbits;
-        i = 0;
-        temp_bits = mpz_sizeinbase(temp, 2) * mpz_sgn(temp);
-        while (tempx_bits >= mp_bits_per_limb) {
-            if (temp_bits > 0) {
-                result->z->_mp_d[limb_count] = mpz_getlimbn(temp, i);
-            }
-            i += 1;
-            tempx_bits -= mp_bits_per_limb;
-            limb_count += 1;
-            temp_bits -= mp_bits_per_limb;
-        }
-        if (temp_bits > 0) {
-            mpz_tdiv_q_2exp(temp, temp, mp_bits_per_limb * i);
-        }
-        else {
-            mpz_set_ui(temp, 0);
+            goto error_range;
         }
+        /* Don't modify tempx; it may be the caller's mpz. */
+        if (mpz_sgn(tempx->z))
+            pack_limbs(d, pos, tempx->z->_mp_d, mpz_size(tempx->z));
         Py_DECREF((PyObject*)tempx);
     }
-    result->z->_mp_d[limb_count] = mpz_getlimbn(temp, 0);
-    mpz_clrbit(result->z, total_bits + (mp_bits_per_limb * 2));
-    mpz_cloc(temp);
+
+    if (is_buffer)
+        PyBuffer_Release(&view);
+
+    size = total_bits ? limb_count : 0;
+    while (size > 0 && d[size - 1] == 0)
+        size--;
+    result->z->_mp_size = (int)size;
     return (PyObject*)result;
+
+  error_range:
+    PyErr_Clear();
+    TYPE_ERROR("pack() requires list elements be positive integers < 2^n bits");
+    Py_DECREF((PyObject*)result);
+  error_buffer:
+    if (is_buffer)
+        PyBuffer_Release(&view);
+    return NULL;
+}
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_pack)
+
+/* Parse the arguments of unpack() and unpack_buffer(). Returns a new
+ * reference to x and sets *count to the number of elements.
+ */
+
+static MPZ_Object *
+unpack_args(PyObject *x, PyObject *n, mp_bitcnt_t *nbits, Py_ssize_t *count)
+{
+    MPZ_Object *tempx;
+    mp_bitcnt_t total_bits;
+
+    *nbits = mp_bitcnt_t_From_Integer(n);
+    if (*nbits == (mp_bitcnt_t)-1 && PyErr_Occurred()) {
+        return NULL;
+    }
+    if (*nbits == 0) {
+        VALUE_ERROR("unpack() requires n > 0");
+        return NULL;
+    }
+
+    if (!(tempx = GMPy_MPZ_From_Integer(x, NULL))) {
+        TYPE_ERROR("unpack() requires 'int','int' arguments");
+        return NULL;
+    }
+
+    if (mpz_sgn(tempx->z) < 0) {
+        VALUE_ERROR("unpack() requires x >= 0");
+        Py_DECREF((PyObject*)tempx);
+        return NULL;
+    }
+
+    total_bits = mpz_sgn(tempx->z) ? mpz_sizeinbase(tempx->z, 2) : 0;
+    *count = (Py_ssize_t)(total_bits / *nbits);
+    if ((total_bits % *nbits) || !*count) {
+        *count += 1;
+    }
+    return tempx;
 }
 
 PyDoc_STRVAR(doc_unpack,
@@ -133,108 +348,458 @@ PyDoc_STRVAR(doc_unpack,
 "repeated division by 2**n. Raises error if 'x' is negative.");
 
 static PyObject *
-GMPy_MPZ_unpack(PyObject *self, PyObject *args)
+GMPy_MPZ_unpack(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
-    mp_bitcnt_t nbits, total_bits, guard_bit, extra_bits, temp_bits;
-    Py_ssize_t index = 0, lst_count, i, lst_ptr = 0;
+    mp_bitcnt_t nbits, pos;
+    Py_ssize_t index, lst_count;
+    mp_size_t size;
     PyObject *result;
-    mpz_t temp;
-    mp_limb_t extra = 0;
-    MPZ_Object *item, *tempx = NULL;
+    MPZ_Object *item, *tempx;
+    mp_limb_t word[2];
     CTXT_Object *context = NULL;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (nargs != 2) {
         TYPE_ERROR("unpack() requires 'int','int' arguments");
         return NULL;
     }
 
-    nbits = mp_bitcnt_t_From_Integer(PyTuple_GET_ITEM(args, 1));
-    if (nbits == -1 && PyErr_Occurred()) {
+    if (!(tempx = unpack_args(args[0], args[1],
+                              &nbits, &lst_count)))
+        return NULL;
+
+    if (!(result = PyList_New(lst_count))) {
+        Py_DECREF((PyObject*)tempx);
         return NULL;
     }
 
-    if (!(tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), context))) {
-        TYPE_ERROR("unpack() requires 'int','int' arguments");
+    for (index = 0, pos = 0; index < lst_count; index++, pos += nbits) {
+        if (nbits <= 2 * GMP_NUMB_BITS && nbits <= 64) {
+            /* Small values may be shared objects. */
+            size = unpack_limbs(word, tempx->z->_mp_d, mpz_size(tempx->z), pos, nbits);
+            if (size == 0 || (size == 1 && word[0] <= MPZ_SMALL_MAX)) {
+                item = GMPy_MPZ_Small(size ? (long)word[0] : 0);
+                PyList_SET_ITEM(result, index, (PyObject*)item);
+                continue;
+            }
+            if (!(item = GMPy_MPZ_New(context)))
+                goto error;
+            mpz_realloc2(item->z, 64);
+            memcpy(item->z->_mp_d, word, size * sizeof(mp_limb_t));
+            item->z->_mp_size = (int)size;
+        }
+        else {
+            if (!(item = GMPy_MPZ_New(context)))
+                goto error;
+            mpz_realloc2(item->z, (mp_bitcnt_t)PACK_LIMBS(nbits) * GMP_NUMB_BITS);
+            size = unpack_limbs(item->z->_mp_d, tempx->z->_mp_d, mpz_size(tempx->z),
+                                pos, nbits);
+            item->z->_mp_size = (int)size;
+        }
+        PyList_SET_ITEM(result, index, (PyObject*)item);
+    }
+    Py_DECREF((PyObject*)tempx);
+    return result;
+
+  error:
+    Py_DECREF((PyObject*)tempx);
+    Py_DECREF(result);
+    return NULL;
+}
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_unpack)
+
+PyDoc_STRVAR(doc_unpack_buffer,
+"unpack_buffer(x, n[, itemsize]) -> memoryview\n\n"
+"Unpack an integer 'x' into n-bit values, like unpack(), but return\n"
+"them as a memoryview of unsigned words of 'itemsize' bytes (1, 2, 4,\n"
+"or 8) instead of a list. By default the smallest word that can hold\n"
+"n bits is used. n must not exceed 64.");
+
+static PyObject *
+GMPy_MPZ_unpack_buffer(PyObject *self, PyObject *args)
+{
+    mp_bitcnt_t nbits, pos;
+    Py_ssize_t index, count, itemsize = 0;
+    PyObject *bytes, *view, *result;
+    MPZ_Object *tempx;
+    mp_limb_t word[2];
+    mp_size_t size;
+    uint64_t v;
+    char *p;
+    static const char *formats[] = {NULL, "B", "H", NULL, "I", NULL, NULL, NULL, "Q"};
+
+    if (!PyArg_ParseTuple(args, "OO|n", &bytes, &view, &itemsize))
+        return NULL;
+
+    if (!(tempx = unpack_args(bytes, view, &nbits, &count)))
+        return NULL;
+
+    if (itemsize == 0) {
+        for (itemsize = 1; itemsize < 8 && (mp_bitcnt_t)itemsize * 8 < nbits; itemsize *= 2);
+    }
+    if ((itemsize != 1 && itemsize != 2 && itemsize != 4 && itemsize != 8) ||
+        (mp_bitcnt_t)itemsize * 8 < nbits || (itemsize == 4 && sizeof(int) != 4)) {
+        VALUE_ERROR("unpack_buffer() requires n <= 8*itemsize <= 64");
+        Py_DECREF((PyObject*)tempx);
         return NULL;
     }
 
-    if (mpz_sgn(tempx->z) < 0) {
-        VALUE_ERROR("unpack() requires x >= 0");
+    if (!(bytes = PyByteArray_FromStringAndSize(NULL, count * itemsize))) {
+        Py_DECREF((PyObject*)tempx);
         return NULL;
     }
+    p = PyByteArray_AS_STRING(bytes);
 
-    if (mpz_sgn(tempx->z) == 0) {
-        total_bits = 0;
+    for (index = 0, pos = 0; index < count; index++, pos += nbits, p += itemsize) {
+        size = unpack_limbs(word, tempx->z->_mp_d, mpz_size(tempx->z), pos, nbits);
+        v = size > 0 ? word[0] : 0;
+#if GMP_NUMB_BITS < 64
+        if (size > 1)
+            v |= (uint64_t)word[1] << GMP_NUMB_BITS;
+#endif
+        switch (itemsize) {
+            case 1: *(unsigned char*)p = (unsigned char)v; break;
+            case 2: { uint16_t w = (uint16_t)v; memcpy(p, &w, 2); break; }
+            case 4: { uint32_t w = (uint32_t)v; memcpy(p, &w, 4); break; }
+            default: memcpy(p, &v, 8); break;
+        }
     }
-    else {
-        total_bits = mpz_sizeinbase(tempx->z, 2);
+    Py_DECREF((PyObject*)tempx);
+
+    if (!(view = PyMemoryView_FromObject(bytes))) {
+        Py_DECREF(bytes);
+        return NULL;
+    }
+    Py_DECREF(bytes);
+    result = PyObject_CallMethod(view, "cast", "s", formats[itemsize]);
+    Py_DECREF(view);
+    return result;
+}
+
+PyDoc_STRVAR(doc_mpz_from_buffer,
+"mpz_from_buffer(obj[, order=-1[, endian=0]]) -> mpz\n\n"
+"Return a non-negative 'mpz' from the words of an object that supports\n"
+"the buffer protocol. The word size is the item size of the buffer.\n"
+"If order is -1, the least significant word comes first; if order is 1,\n"
+"the most significant word comes first. endian gives the byte order\n"
+"within each word: -1 for little endian, 1 for big endian and 0 for the\n"
+"native byte order. mpz_from_buffer(memoryview(x)) == x for any mpz x\n"
+"greater than or equal to 0.");
+
+static PyObject *
+GMPy_MPZ_From_Buffer(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    MPZ_Object *result;
+    PyObject *obj;
+    Py_buffer view;
+    int order = -1, endian = 0;
+    static char *kwlist[] = {"obj", "order", "endian", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "O|ii", kwlist,
+                                     &obj, &order, &endian))
+        return NULL;
+
+    if (order != 1 && order != -1) {
+        VALUE_ERROR("mpz_from_buffer() requires order be 1 or -1");
+        return NULL;
     }
-    
-    lst_count = total_bits / nbits;
-    if ((total_bits % nbits) || !lst_count) {
-        lst_count += 1;
+    if (endian != 1 && endian != 0 && endian != -1) {
+        VALUE_ERROR("mpz_from_buffer() requires endian be 1, 0, or -1");
+        return NULL;
     }
 
-    if (!(result = PyList_New(lst_count))) {
-        Py_DECREF((PyObject*)tempx);
+    if (PyObject_GetBuffer(obj, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) < 0)
+        return NULL;
+
+    if (!(result = GMPy_MPZ_New(NULL))) {
+        PyBuffer_Release(&view);
         return NULL;
     }
 
-    if (mpz_sgn(tempx->z) == 0) {
-        if (!(item = GMPy_MPZ_New(context))) {
-            Py_DECREF((PyObject*)tempx);
+    if (view.itemsize > 0) {
+        GMPY_BEGIN_NOGIL((size_t)view.len * 8);
+        mpz_import(result->z, (size_t)(view.len / view.itemsize), order,
+                   (size_t)view.itemsize, endian, 0, view.buf);
+        GMPY_END_NOGIL;
+    }
+    else {
+        mpz_set_ui(result->z, 0);
+    }
+    PyBuffer_Release(&view);
+    return (PyObject*)result;
+}
+
+/*
+ **************************************************************************
+ * Polynomial multiplication by Kronecker substitution
+ *
+ * A polynomial with integer coefficients is evaluated at 2**w by packing
+ * its coefficients into one mpz, w bits each, so one mpz multiplication
+ * gives the product polynomial evaluated at 2**w. w is chosen so that
+ * every coefficient of the product is less than 2**(w-1) in absolute
+ * value. Negative coefficients are packed separately and subtracted; the
+ * product is then split into balanced digits in [-2**(w-1), 2**(w-1)).
+ **************************************************************************
+ */
+
+static mp_bitcnt_t
+poly_bitlen(size_t n)
+{
+    mp_bitcnt_t bits = 0;
+
+    while (n) {
+        bits++;
+        n >>= 1;
+    }
+    return bits;
+}
+
+/* Largest bit length of the absolute values of the coefficients. */
+
+static mp_bitcnt_t
+poly_maxbits(MPZ_Object **coef, Py_ssize_t n)
+{
+    mp_bitcnt_t bits = 0, b;
+    Py_ssize_t i;
+
+    for (i = 0; i < n; i++) {
+        if (mpz_sgn(coef[i]->z) && (b = mpz_sizeinbase(coef[i]->z, 2)) > bits)
+            bits = b;
+    }
+    return bits;
+}
+
+/* Set r to the polynomial at 2**w. neg is a temporary. */
+
+static void
+poly_pack(mpz_ptr r, mpz_ptr neg, MPZ_Object **coef, Py_ssize_t n, mp_bitcnt_t w)
+{
+    mp_size_t limb_count = PACK_LIMBS(w * n) + 1, rsize, nsize;
+    Py_ssize_t i;
+    mpz_srcptr c;
+
+    mpz_set_ui(r, 0);
+    mpz_set_ui(neg, 0);
+    mpz_realloc2(r, (mp_bitcnt_t)limb_count * GMP_NUMB_BITS);
+    mpz_realloc2(neg, (mp_bitcnt_t)limb_count * GMP_NUMB_BITS);
+    memset(r->_mp_d, 0, limb_count * sizeof(mp_limb_t));
+    memset(neg->_mp_d, 0, limb_count * sizeof(mp_limb_t));
+
+    for (i = 0; i < n; i++) {
+        c = coef[i]->z;
+        if (mpz_sgn(c) > 0)
+            pack_limbs(r->_mp_d, (mp_bitcnt_t)i * w, c->_mp_d, mpz_size(c));
+        else if (mpz_sgn(c) < 0)
+            pack_limbs(neg->_mp_d, (mp_bitcnt_t)i * w, c->_mp_d, mpz_size(c));
+    }
+
+    for (rsize = limb_count; rsize > 0 && r->_mp_d[rsize - 1] == 0; rsize--);
+    for (nsize = limb_count; nsize > 0 && neg->_mp_d[nsize - 1] == 0; nsize--);
+    r->_mp_size = (int)rsize;
+    neg->_mp_size = (int)nsize;
+    mpz_sub(r, r, neg);
+}
+
+/* Split x into count coefficients of w bits. If m is NULL, the digits are
+ * balanced and x may be negative; otherwise x >= 0 and the coefficients
+ * are reduced modulo m. */
+
+static PyObject *
+poly_unpack(mpz_srcptr x, Py_ssize_t count, mp_bitcnt_t w, mpz_srcptr m)
+{
+    PyObject *result;
+    MPZ_Object *item;
+    Py_ssize_t i;
+    mp_size_t size;
+    mpz_t half;
+    int carry = 0;
+
+    if (!(result = PyList_New(count)))
+        return NULL;
+
+    mpz_init(half);
+    mpz_setbit(half, w - 1);
+    for (i = 0; i < count; i++) {
+        if (!(item = GMPy_MPZ_New(NULL))) {
+            mpz_clear(half);
             Py_DECREF(result);
             return NULL;
         }
-        mpz_set_ui(item->z, 0);
-        PyList_SET_ITEM(result, 0, (PyObject*)item);
-        Py_DECREF((PyObject*)tempx);
-        return result;
-    }
-
-    mpz_inoc(temp);
-    guard_bit = nbits + (2 * mp_bits_per_limb);
-    extra_bits = 0;
-    index = 0;
-    
-    while (lst_ptr < lst_count) {
-        i = 0;
-        temp_bits = 0;
-        mpz_set_ui(temp, 0);
-        mpz_setbit(temp, guard_bit);
-        while (temp_bits + extra_bits < nbits) {
-            temp->_mp_d[i++] = mpz_getlimbn(tempx->z, index++);
-            temp_bits += mp_bits_per_limb;
-        }
-        mpz_clrbit(temp, guard_bit);
-        mpz_mul_2exp(temp, temp, extra_bits);
-        if (mpz_sgn(temp) == 0 && extra != 0) {
-            mpz_set_ui(temp, 1);
-            temp->_mp_d[0] = extra;
+        mpz_realloc2(item->z, (mp_bitcnt_t)(PACK_LIMBS(w) + 1) * GMP_NUMB_BITS);
+        size = unpack_limbs(item->z->_mp_d, x->_mp_d, mpz_size(x),
+                            (mp_bitcnt_t)i * w, w);
+        item->z->_mp_size = (int)size;
+        if (m) {
+            mpz_tdiv_r(item->z, item->z, m);
         }
         else {
-           mpn_add_1(temp->_mp_d, temp->_mp_d, mpz_size(temp), extra);
-        }
-        temp_bits += extra_bits;
-
-        while ((lst_ptr < lst_count) && (temp_bits >= nbits)) {
-            if(!(item = GMPy_MPZ_New(context))) {
-                mpz_cloc(temp);
-                Py_DECREF((PyObject*)tempx);
-                Py_DECREF(result);
-                return NULL;
+            if (carry)
+                mpz_add_ui(item->z, item->z, 1);
+            if ((carry = (mpz_cmp(item->z, half) >= 0))) {
+                mpz_sub(item->z, item->z, half);
+                mpz_sub(item->z, item->z, half);
             }
-            mpz_tdiv_r_2exp(item->z, temp, nbits);
-            PyList_SET_ITEM(result, lst_ptr++, (PyObject*)item);
-            mpz_tdiv_q_2exp(temp, temp, nbits);
-            temp_bits -= nbits;
+            if (mpz_sgn(x) < 0)
+                mpz_neg(item->z, item->z);
         }
-        extra = mpz_getlimbn(temp, 0);
-        extra_bits = temp_bits;
+        PyList_SET_ITEM(result, i, (PyObject*)item);
     }
-    Py_DECREF((PyObject*)tempx);
-    mpz_cloc(temp);
+    mpz_clear(half);
+    return result;
+}
+
+/* Multiply the polynomials a and b, which may be the same array. If m is
+ * not NULL the coefficients must be in [0, m). */
+
+static PyObject *
+poly_mul(MPZ_Object **a, Py_ssize_t na, MPZ_Object **b, Py_ssize_t nb, mpz_srcptr m)
+{
+    PyObject *result;
+    mp_bitcnt_t w;
+    mpz_t x, y, t;
+
+    if (!na || !nb)
+        return PyList_New(0);
+
+    if (m)
+        w = 2 * mpz_sizeinbase(m, 2) + poly_bitlen(na < nb ? na : nb);
+    else
+        w = poly_maxbits(a, na) + poly_maxbits(b, nb) +
+            poly_bitlen(na < nb ? na : nb) + 1;
+
+    mpz_init(x);
+    mpz_init(y);
+    mpz_init(t);
+    GMPY_BEGIN_NOGIL(w * (na + nb));
+    poly_pack(x, t, a, na, w);
+    if (a == b) {
+        mpz_mul(x, x, x);
+    }
+    else {
+        poly_pack(y, t, b, nb, w);
+        mpz_mul(x, x, y);
+    }
+    GMPY_END_NOGIL;
+    result = poly_unpack(x, na + nb - 1, w, m);
+    mpz_clear(x);
+    mpz_clear(y);
+    mpz_clear(t);
     return result;
 }
 
+PyDoc_STRVAR(GMPy_doc_mpz_function_poly_mul,
+"poly_mul(a, b) -> list\n\n"
+"Return the coefficients of the product of the polynomials with integer\n"
+"coefficients a and b, given lowest degree first. The polynomials are\n"
+"packed into integers so the product takes a single mpz multiplication.");
+
+static PyObject *
+GMPy_MPZ_Function_PolyMul(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    MPZ_Object **a, **b;
+    Py_ssize_t na, nb;
+    PyObject *result;
+
+    if (nargs != 2) {
+        TYPE_ERROR("poly_mul() requires 2 arguments");
+        return NULL;
+    }
+    if (!(a = GMPy_MPZ_Array_From_Iterable(args[0], &na,
+                "poly_mul() requires iterables of integers", NULL)))
+        return NULL;
+    if (!(b = GMPy_MPZ_Array_From_Iterable(args[1], &nb,
+                "poly_mul() requires iterables of integers", NULL))) {
+        GMPy_MPZ_Array_Free(a, na);
+        return NULL;
+    }
+    result = poly_mul(a, na, b, nb, NULL);
+    GMPy_MPZ_Array_Free(a, na);
+    GMPy_MPZ_Array_Free(b, nb);
+    return result;
+}
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_Function_PolyMul)
 
+PyDoc_STRVAR(GMPy_doc_mpz_function_poly_sqr,
+"poly_sqr(a) -> list\n\n"
+"Return the coefficients of the square of the polynomial with integer\n"
+"coefficients a, given lowest degree first. Same as poly_mul(a, a),\n"
+"but faster.");
+
+static PyObject *
+GMPy_MPZ_Function_PolySqr(PyObject *self, PyObject *other)
+{
+    MPZ_Object **a;
+    Py_ssize_t na;
+    PyObject *result;
+
+    if (!(a = GMPy_MPZ_Array_From_Iterable(other, &na,
+                "poly_sqr() requires an iterable of integers", NULL)))
+        return NULL;
+    result = poly_mul(a, na, a, na, NULL);
+    GMPy_MPZ_Array_Free(a, na);
+    return result;
+}
+
+/* Replace the coefficients by their residues in [0, m). */
+
+static int
+poly_reduce(MPZ_Object **coef, Py_ssize_t n, mpz_srcptr m)
+{
+    MPZ_Object *temp;
+    Py_ssize_t i;
+
+    for (i = 0; i < n; i++) {
+        if (mpz_sgn(coef[i]->z) >= 0 && mpz_cmp(coef[i]->z, m) < 0)
+            continue;
+        if (!(temp = GMPy_MPZ_New(NULL)))
+            return -1;
+        mpz_fdiv_r(temp->z, coef[i]->z, m);
+        Py_DECREF((PyObject*)coef[i]);
+        coef[i] = temp;
+    }
+    return 0;
+}
+
+PyDoc_STRVAR(GMPy_doc_mpz_function_poly_mulmod,
+"poly_mulmod(a, b, m) -> list\n\n"
+"Return the coefficients of the product of the polynomials with integer\n"
+"coefficients a and b, given lowest degree first, reduced modulo the\n"
+"integer m > 0. The coefficients of the result are in [0, m).");
+
+static PyObject *
+GMPy_MPZ_Function_PolyMulmod(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    MPZ_Object **a, **b = NULL, *m;
+    Py_ssize_t na, nb = 0;
+    PyObject *result = NULL;
+
+    if (nargs != 3 || !IS_INTEGER(args[2])) {
+        TYPE_ERROR("poly_mulmod() requires 'iterable','iterable','int' arguments");
+        return NULL;
+    }
+    if (!(m = GMPy_MPZ_From_Integer(args[2], NULL)))
+        return NULL;
+    if (mpz_sgn(m->z) <= 0) {
+        VALUE_ERROR("poly_mulmod() requires m > 0");
+        Py_DECREF((PyObject*)m);
+        return NULL;
+    }
+    if (!(a = GMPy_MPZ_Array_From_Iterable(args[0], &na,
+                "poly_mulmod() requires iterables of integers", NULL))) {
+        Py_DECREF((PyObject*)m);
+        return NULL;
+    }
+    if (!(b = GMPy_MPZ_Array_From_Iterable(args[1], &nb,
+                "poly_mulmod() requires iterables of integers", NULL)))
+        goto done;
+    if (poly_reduce(a, na, m->z) < 0 || poly_reduce(b, nb, m->z) < 0)
+        goto done;
+    result = poly_mul(a, na, b, nb, m->z);
+
+  done:
+    GMPy_MPZ_Array_Free(a, na);
+    if (b)
+        GMPy_MPZ_Array_Free(b, nb);
+    Py_DECREF((PyObject*)m);
+    return result;
+}
+GMPY_FASTCALL_WRAPPER(GMPy_MPZ_Function_PolyMulmod)
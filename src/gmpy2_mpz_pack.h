@@ -32,8 +32,13 @@
 extern "C" {
 #endif
 
-static PyObject * GMPy_MPZ_pack(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPZ_unpack(PyObject *self, PyObject *args);
+static PyObject * GMPy_MPZ_pack(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPy_MPZ_unpack(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPy_MPZ_unpack_buffer(PyObject *self, PyObject *args);
+static PyObject * GMPy_MPZ_From_Buffer(PyObject *self, PyObject *args, PyObject *keywds);
+static PyObject * GMPy_MPZ_Function_PolyMul(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPy_MPZ_Function_PolySqr(PyObject *self, PyObject *other);
+static PyObject * GMPy_MPZ_Function_PolyMulmod(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 
 #ifdef __cplusplus
 }
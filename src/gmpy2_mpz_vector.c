@@ -0,0 +1,938 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_mpz_vector.c                                                      *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* The elementwise operations of an mpz_vector work directly on the mpz_t
+ * array and create no Python objects for the elements. Every result
+ * element is initialized with room for the largest possible result before
+ * the loop runs, and while that happens the limbs are carved out of a
+ * single arena chunk (see gmpy2_arena.c), so the limbs of a new vector are
+ * contiguous. The chunk is retired right away and released once every
+ * element that uses it has been freed or has grown out of it. Long loops
+ * release the GIL after the elements are initialized. Other threads can
+ * assign to the elements of a vector, or of a slice that shares them, in
+ * the meantime, so the elements of the operands are copied first.
+ */
+
+#define MPZVEC_POOL_MIN 16
+#define MPZVEC_POOL_MAX (16 * 1024 * 1024)
+
+enum { MPZVEC_ADD, MPZVEC_SUB, MPZVEC_MUL, MPZVEC_FLOORDIV, MPZVEC_MOD };
+
+typedef struct {
+    gmpy_arena_chunk *prev;
+    int active;
+} mpzvec_pool;
+
+static void
+mpzvec_pool_begin(mpzvec_pool *pool, Py_ssize_t n, size_t bytes)
+{
+    gmpy_arena_chunk *chunk;
+    int locked;
+
+    pool->active = 0;
+    if (n < MPZVEC_POOL_MIN || !bytes || bytes > MPZVEC_POOL_MAX)
+        return;
+
+    ARENA_LOCK(locked);
+    chunk = arena_chunk_new(NULL, bytes);
+    ARENA_UNLOCK(locked);
+    if (!chunk)
+        return;
+
+    pool->prev = tls_arena;
+    pool->active = 1;
+    tls_arena = chunk;
+}
+
+static void
+mpzvec_pool_end(mpzvec_pool *pool)
+{
+    int locked;
+
+    if (!pool->active)
+        return;
+
+    ARENA_LOCK(locked);
+    arena_chunk_retire(tls_arena);
+    ARENA_UNLOCK(locked);
+    tls_arena = pool->prev;
+}
+
+/* Bytes taken from a chunk by an element with 'limbs' limbs. */
+
+#define MPZVEC_BYTES(limbs) ARENA_ROUND((size_t)(limbs) * sizeof(mp_limb_t))
+
+/* Return a new vector that owns room for n elements. The caller must
+ * initialize all of them. */
+
+static MPZVector_Object *
+mpzvec_alloc(Py_ssize_t n)
+{
+    MPZVector_Object *result;
+
+    if (!(result = PyObject_New(MPZVector_Object, &MPZVector_Type)))
+        return NULL;
+    result->size = n;
+    result->step = 1;
+    result->alloc = 0;
+    result->base = NULL;
+    if (!(result->data = GMPY_MALLOC(sizeof(mpz_t) * (n ? n : 1)))) {
+        Py_DECREF((PyObject*)result);
+        PyErr_NoMemory();
+        return NULL;
+    }
+    result->alloc = n;
+    return result;
+}
+
+/* An operand of an elementwise operation: a vector, or an integer that is
+ * used for every element (step 0). */
+
+typedef struct {
+    mpz_t *data;
+    Py_ssize_t step;
+    Py_ssize_t size;                /* -1 for an integer */
+    MPZ_Object *scalar;
+    mpz_t *copy;                    /* private copy of the elements */
+    Py_ssize_t ncopy;
+} mpzvec_operand;
+
+#define MPZVEC_OPERAND(o, i) ((o)->data[(i) * (o)->step])
+
+/* Returns 1 on success, 0 if obj is neither a vector nor an integer, and
+ * -1 after an error. */
+
+static int
+mpzvec_operand_init(mpzvec_operand *op, PyObject *obj)
+{
+    op->scalar = NULL;
+    op->copy = NULL;
+    op->ncopy = 0;
+    if (MPZVector_Check(obj)) {
+        op->data = ((MPZVector_Object*)obj)->data;
+        op->step = ((MPZVector_Object*)obj)->step;
+        op->size = ((MPZVector_Object*)obj)->size;
+        return 1;
+    }
+    if (!IS_INTEGER(obj))
+        return 0;
+    if (!(op->scalar = GMPy_MPZ_From_Integer(obj, NULL)))
+        return -1;
+    op->data = &op->scalar->z;
+    op->step = 0;
+    op->size = -1;
+    return 1;
+}
+
+/* Replace the elements of a vector operand with a private copy of the
+ * first n elements before the GIL is released. Returns -1 after an error. */
+
+static int
+mpzvec_operand_copy(mpzvec_operand *op, Py_ssize_t n)
+{
+    Py_ssize_t i;
+
+    if (op->size < 0)
+        return 0;
+    if (!(op->copy = GMPY_MALLOC(sizeof(mpz_t) * (n ? n : 1)))) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    for (i = 0; i < n; i++)
+        mpz_init_set(op->copy[i], MPZVEC_OPERAND(op, i));
+    op->ncopy = n;
+    op->data = op->copy;
+    op->step = 1;
+    return 0;
+}
+
+static void
+mpzvec_operand_clear(mpzvec_operand *op)
+{
+    Py_ssize_t i;
+
+    Py_XDECREF((PyObject*)op->scalar);
+    if (op->copy) {
+        for (i = 0; i < op->ncopy; i++)
+            mpz_clear(op->copy[i]);
+        GMPY_FREE(op->copy);
+    }
+}
+
+/* Return the common length of the operands, or -1 after setting an
+ * exception. */
+
+static Py_ssize_t
+mpzvec_length(const mpzvec_operand *ops, int count)
+{
+    Py_ssize_t n = -1;
+    int i;
+
+    for (i = 0; i < count; i++) {
+        if (ops[i].size < 0)
+            continue;
+        if (n >= 0 && ops[i].size != n) {
+            VALUE_ERROR("mpz_vector operation requires vectors of the same length");
+            return -1;
+        }
+        n = ops[i].size;
+    }
+    return n;
+}
+
+/* Limbs needed for the result of x op y, including the limb GMP may
+ * reserve for a carry. */
+
+static mp_size_t
+mpzvec_estimate(int op, mpz_srcptr x, mpz_srcptr y)
+{
+    mp_size_t sx = mpz_size(x), sy = mpz_size(y);
+
+    switch (op) {
+    case MPZVEC_ADD:
+    case MPZVEC_SUB:
+        return (sx > sy ? sx : sy) + 1;
+    case MPZVEC_MUL:
+        return sx + sy + 1;
+    case MPZVEC_FLOORDIV:
+        return sx >= sy ? sx - sy + 2 : 2;
+    default:
+        return sy + 1;
+    }
+}
+
+static PyObject *
+mpzvec_binary(PyObject *a, PyObject *b, int op)
+{
+    mpzvec_operand ops[2];
+    MPZVector_Object *result = NULL;
+    mpzvec_pool pool;
+    mp_size_t limbs;
+    size_t bytes = 0;
+    Py_ssize_t i, n;
+    int rc;
+
+    if ((rc = mpzvec_operand_init(&ops[0], a)) <= 0) {
+        if (rc == 0)
+            Py_RETURN_NOTIMPLEMENTED;
+        return NULL;
+    }
+    if ((rc = mpzvec_operand_init(&ops[1], b)) <= 0) {
+        mpzvec_operand_clear(&ops[0]);
+        if (rc == 0)
+            Py_RETURN_NOTIMPLEMENTED;
+        return NULL;
+    }
+    if ((n = mpzvec_length(ops, 2)) < 0)
+        goto done;
+
+    for (i = 0; i < n; i++) {
+        if ((op == MPZVEC_FLOORDIV || op == MPZVEC_MOD) &&
+            !mpz_sgn(MPZVEC_OPERAND(&ops[1], i))) {
+            ZERO_ERROR("division or modulo by zero");
+            goto done;
+        }
+        bytes += MPZVEC_BYTES(mpzvec_estimate(op, MPZVEC_OPERAND(&ops[0], i),
+                                              MPZVEC_OPERAND(&ops[1], i)));
+    }
+
+    if (GMPY_NOGIL_WANTED(bytes * 8) &&
+        (mpzvec_operand_copy(&ops[0], n) < 0 || mpzvec_operand_copy(&ops[1], n) < 0))
+        goto done;
+
+    if (!(result = mpzvec_alloc(n)))
+        goto done;
+
+    mpzvec_pool_begin(&pool, n, bytes);
+    for (i = 0; i < n; i++) {
+        limbs = mpzvec_estimate(op, MPZVEC_OPERAND(&ops[0], i), MPZVEC_OPERAND(&ops[1], i));
+        mpz_init2(result->data[i], (mp_bitcnt_t)limbs * GMP_NUMB_BITS);
+    }
+    mpzvec_pool_end(&pool);
+
+    GMPY_BEGIN_NOGIL(bytes * 8);
+    for (i = 0; i < n; i++) {
+        mpz_ptr r = result->data[i];
+        mpz_srcptr x = MPZVEC_OPERAND(&ops[0], i), y = MPZVEC_OPERAND(&ops[1], i);
+
+        switch (op) {
+        case MPZVEC_ADD:
+            mpz_add(r, x, y);
+            break;
+        case MPZVEC_SUB:
+            mpz_sub(r, x, y);
+            break;
+        case MPZVEC_MUL:
+            mpz_mul(r, x, y);
+            break;
+        case MPZVEC_FLOORDIV:
+            mpz_fdiv_q(r, x, y);
+            break;
+        default:
+            mpz_fdiv_r(r, x, y);
+        }
+    }
+    GMPY_END_NOGIL;
+
+  done:
+    mpzvec_operand_clear(&ops[0]);
+    mpzvec_operand_clear(&ops[1]);
+    return (PyObject*)result;
+}
+
+static PyObject *
+GMPy_MPZVector_Add_Slot(PyObject *x, PyObject *y)
+{
+    return mpzvec_binary(x, y, MPZVEC_ADD);
+}
+
+static PyObject *
+GMPy_MPZVector_Sub_Slot(PyObject *x, PyObject *y)
+{
+    return mpzvec_binary(x, y, MPZVEC_SUB);
+}
+
+static PyObject *
+GMPy_MPZVector_Mul_Slot(PyObject *x, PyObject *y)
+{
+    return mpzvec_binary(x, y, MPZVEC_MUL);
+}
+
+static PyObject *
+GMPy_MPZVector_FloorDiv_Slot(PyObject *x, PyObject *y)
+{
+    return mpzvec_binary(x, y, MPZVEC_FLOORDIV);
+}
+
+static PyObject *
+GMPy_MPZVector_Mod_Slot(PyObject *x, PyObject *y)
+{
+    return mpzvec_binary(x, y, MPZVEC_MOD);
+}
+
+PyDoc_STRVAR(GMPy_doc_mpz_vector_powmod,
+"v.powmod(e, m) -> mpz_vector\n\n"
+"Return the vector of powmod(x, e, m) for the elements x of v. e and m\n"
+"may be integers or vectors of the same length as v.");
+
+static PyObject *
+GMPy_MPZVector_Method_PowMod(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    mpzvec_operand ops[3];
+    MPZVector_Object *result = NULL;
+    mpzvec_pool pool;
+    size_t bytes = 0;
+    Py_ssize_t i, n;
+    mpz_t mm, inv, absexp;
+    int count = 1, invalid = 0;
+
+    if (nargs != 2) {
+        TYPE_ERROR("powmod() requires 2 arguments");
+        return NULL;
+    }
+    mpzvec_operand_init(&ops[0], self);
+    for (; count < 3; count++) {
+        if (mpzvec_operand_init(&ops[count], args[count - 1]) <= 0) {
+            if (!PyErr_Occurred())
+                TYPE_ERROR("powmod() requires integer or mpz_vector arguments");
+            goto done;
+        }
+    }
+    if ((n = mpzvec_length(ops, 3)) < 0)
+        goto done;
+
+    for (i = 0; i < n; i++) {
+        if (!mpz_sgn(MPZVEC_OPERAND(&ops[2], i))) {
+            VALUE_ERROR("powmod() modulus cannot be 0");
+            goto done;
+        }
+        bytes += MPZVEC_BYTES(mpz_size(MPZVEC_OPERAND(&ops[2], i)) + 1);
+    }
+
+    if (GMPY_NOGIL_WANTED(bytes * 8)) {
+        for (i = 0; i < 3; i++) {
+            if (mpzvec_operand_copy(&ops[i], n) < 0)
+                goto done;
+        }
+    }
+
+    if (!(result = mpzvec_alloc(n)))
+        goto done;
+
+    mpzvec_pool_begin(&pool, n, bytes);
+    for (i = 0; i < n; i++) {
+        mpz_init2(result->data[i],
+                  (mp_bitcnt_t)(mpz_size(MPZVEC_OPERAND(&ops[2], i)) + 1) * GMP_NUMB_BITS);
+    }
+    mpzvec_pool_end(&pool);
+
+    GMPY_BEGIN_NOGIL(bytes * 8);
+    mpz_init(mm);
+    mpz_init(inv);
+    mpz_init(absexp);
+    for (i = 0; i < n; i++) {
+        mpz_ptr r = result->data[i];
+        mpz_srcptr x = MPZVEC_OPERAND(&ops[0], i), e = MPZVEC_OPERAND(&ops[1], i);
+        mpz_srcptr m = MPZVEC_OPERAND(&ops[2], i);
+
+        mpz_abs(mm, m);
+        if (mpz_sgn(e) < 0) {
+            if (!mpz_invert(inv, x, mm)) {
+                invalid = 1;
+                break;
+            }
+            mpz_abs(absexp, e);
+            mpz_powm(r, inv, absexp, mm);
+        }
+        else {
+            mpz_powm(r, x, e, mm);
+        }
+        if (mpz_sgn(m) < 0 && mpz_sgn(r))
+            mpz_sub(r, r, mm);
+    }
+    mpz_clear(mm);
+    mpz_clear(inv);
+    mpz_clear(absexp);
+    GMPY_END_NOGIL;
+
+    if (invalid) {
+        VALUE_ERROR("powmod() base not invertible");
+        Py_CLEAR(result);
+    }
+
+  done:
+    while (--count >= 0)
+        mpzvec_operand_clear(&ops[count]);
+    return (PyObject*)result;
+}
+GMPY_FASTCALL_WRAPPER(GMPy_MPZVector_Method_PowMod)
+
+/* Total size of the elements in bits, for the nogil threshold. */
+
+static size_t
+mpzvec_bits(MPZVector_Object *self)
+{
+    size_t bits = 0;
+    Py_ssize_t i;
+
+    for (i = 0; i < self->size; i++)
+        bits += mpz_size(MPZVECTOR_ITEM(self, i)) * GMP_NUMB_BITS;
+    return bits;
+}
+
+PyDoc_STRVAR(GMPy_doc_mpz_vector_sum,
+"v.sum() -> mpz\n\n"
+"Return the sum of the elements of v.");
+
+static PyObject *
+GMPy_MPZVector_Method_Sum(PyObject *self, PyObject *other)
+{
+    MPZVector_Object *v = (MPZVector_Object*)self;
+    MPZ_Object *result = NULL;
+    mpzvec_operand op;
+    size_t bits = mpzvec_bits(v);
+    Py_ssize_t i;
+
+    mpzvec_operand_init(&op, self);
+    if (GMPY_NOGIL_WANTED(bits) && mpzvec_operand_copy(&op, v->size) < 0)
+        goto done;
+    if (!(result = GMPy_MPZ_New(NULL)))
+        goto done;
+    mpz_set_ui(result->z, 0);
+    GMPY_BEGIN_NOGIL(bits);
+    for (i = 0; i < v->size; i++)
+        mpz_add(result->z, result->z, MPZVEC_OPERAND(&op, i));
+    GMPY_END_NOGIL;
+
+  done:
+    mpzvec_operand_clear(&op);
+    return (PyObject*)result;
+}
+
+PyDoc_STRVAR(GMPy_doc_mpz_vector_prod,
+"v.prod() -> mpz\n\n"
+"Return the product of the elements of v. The elements are multiplied\n"
+"in a balanced tree so the operands of each multiplication have similar\n"
+"sizes.");
+
+static PyObject *
+GMPy_MPZVector_Method_Prod(PyObject *self, PyObject *other)
+{
+    MPZVector_Object *v = (MPZVector_Object*)self;
+    MPZ_Object *result;
+    mpzvec_operand op;
+    size_t bits;
+    Py_ssize_t i, m;
+    mpz_t *temp;
+
+    if (!(result = GMPy_MPZ_New(NULL)))
+        return NULL;
+    if (v->size <= 2) {
+        mpz_set_ui(result->z, 1);
+        for (i = 0; i < v->size; i++)
+            mpz_mul(result->z, result->z, MPZVECTOR_ITEM(v, i));
+        return (PyObject*)result;
+    }
+
+    m = (v->size + 1) / 2;
+    if (!(temp = GMPY_MALLOC(sizeof(mpz_t) * m))) {
+        Py_DECREF((PyObject*)result);
+        return PyErr_NoMemory();
+    }
+    bits = mpzvec_bits(v);
+    mpzvec_operand_init(&op, self);
+    if (GMPY_NOGIL_WANTED(bits) && mpzvec_operand_copy(&op, v->size) < 0) {
+        GMPY_FREE(temp);
+        Py_DECREF((PyObject*)result);
+        return NULL;
+    }
+    GMPY_BEGIN_NOGIL(bits);
+    for (i = 0; i < m; i++) {
+        mpz_init(temp[i]);
+        if (2 * i + 1 < v->size)
+            mpz_mul(temp[i], MPZVEC_OPERAND(&op, 2 * i), MPZVEC_OPERAND(&op, 2 * i + 1));
+        else
+            mpz_set(temp[i], MPZVEC_OPERAND(&op, 2 * i));
+    }
+    for (; m > 1; m = (m + 1) / 2) {
+        for (i = 0; 2 * i + 1 < m; i++)
+            mpz_mul(temp[i], temp[2 * i], temp[2 * i + 1]);
+        if (m & 1)
+            mpz_swap(temp[i], temp[m - 1]);
+    }
+    mpz_swap(result->z, temp[0]);
+    for (i = 0; i < (v->size + 1) / 2; i++)
+        mpz_clear(temp[i]);
+    GMPY_END_NOGIL;
+    GMPY_FREE(temp);
+    mpzvec_operand_clear(&op);
+    return (PyObject*)result;
+}
+
+PyDoc_STRVAR(GMPy_doc_mpz_vector_gcd,
+"v.gcd() -> mpz\n\n"
+"Return the greatest common divisor of the elements of v.");
+
+static PyObject *
+GMPy_MPZVector_Method_GCD(PyObject *self, PyObject *other)
+{
+    MPZVector_Object *v = (MPZVector_Object*)self;
+    MPZ_Object *result = NULL;
+    mpzvec_operand op;
+    size_t bits = mpzvec_bits(v);
+    Py_ssize_t i;
+
+    mpzvec_operand_init(&op, self);
+    if (GMPY_NOGIL_WANTED(bits) && mpzvec_operand_copy(&op, v->size) < 0)
+        goto done;
+    if (!(result = GMPy_MPZ_New(NULL)))
+        goto done;
+    mpz_set_ui(result->z, 0);
+    GMPY_BEGIN_NOGIL(bits);
+    for (i = 0; i < v->size && mpz_cmp_ui(result->z, 1); i++)
+        mpz_gcd(result->z, result->z, MPZVEC_OPERAND(&op, i));
+    GMPY_END_NOGIL;
+
+  done:
+    mpzvec_operand_clear(&op);
+    return (PyObject*)result;
+}
+
+PyDoc_STRVAR(GMPy_doc_mpz_vector_tolist,
+"v.tolist() -> list\n\n"
+"Return the elements of v as a list of mpz.");
+
+static PyObject *
+GMPy_MPZVector_Method_ToList(PyObject *self, PyObject *other)
+{
+    MPZVector_Object *v = (MPZVector_Object*)self;
+    PyObject *result, *item;
+    Py_ssize_t i;
+
+    if (!(result = PyList_New(v->size)))
+        return NULL;
+    for (i = 0; i < v->size; i++) {
+        if (!(item = GMPy_MPZVector_Item_Slot(v, i))) {
+            Py_DECREF(result);
+            return NULL;
+        }
+        PyList_SET_ITEM(result, i, item);
+    }
+    return result;
+}
+
+PyDoc_STRVAR(GMPy_doc_mpz_vector_factory,
+"mpz_vector(iterable=()) -> mpz_vector\n\n"
+"Return a vector of the integers in iterable. The elements are stored\n"
+"contiguously as mpz values without a Python object for each element.\n"
+"A vector supports len(), indexing, assignment of elements, slicing\n"
+"(which returns a view of the same elements), and the elementwise\n"
+"operators +, -, *, // and % with another vector of the same length or\n"
+"with an integer.");
+
+static PyObject *
+GMPy_MPZVector_Factory(PyObject *self, PyObject *args)
+{
+    MPZVector_Object *result, *src = NULL;
+    MPZ_Object **items = NULL;
+    PyObject *arg = NULL;
+    mpzvec_pool pool;
+    size_t bytes = 0;
+    Py_ssize_t i, n = 0;
+
+    if (!PyArg_ParseTuple(args, "|O:mpz_vector", &arg))
+        return NULL;
+
+    if (arg && MPZVector_Check(arg)) {
+        src = (MPZVector_Object*)arg;
+        n = src->size;
+        for (i = 0; i < n; i++)
+            bytes += MPZVEC_BYTES(mpz_size(MPZVECTOR_ITEM(src, i)));
+    }
+    else if (arg) {
+        if (!(items = GMPy_MPZ_Array_From_Iterable(arg, &n,
+                        "mpz_vector() requires an iterable of integers", NULL)))
+            return NULL;
+        for (i = 0; i < n; i++)
+            bytes += MPZVEC_BYTES(mpz_size(items[i]->z));
+    }
+
+    if ((result = mpzvec_alloc(n))) {
+        mpzvec_pool_begin(&pool, n, bytes);
+        for (i = 0; i < n; i++) {
+            mpz_init_set(result->data[i], src ? MPZVECTOR_ITEM(src, i) : items[i]->z);
+        }
+        mpzvec_pool_end(&pool);
+    }
+    if (items)
+        GMPy_MPZ_Array_Free(items, n);
+    return (PyObject*)result;
+}
+
+static void
+GMPy_MPZVector_Dealloc(MPZVector_Object *self)
+{
+    Py_ssize_t i;
+
+    if (self->base) {
+        Py_DECREF(self->base);
+    }
+    else if (self->data) {
+        for (i = 0; i < self->alloc; i++)
+            mpz_clear(self->data[i]);
+        GMPY_FREE(self->data);
+    }
+    PyObject_Del(self);
+}
+
+static PyObject *
+GMPy_MPZVector_Repr_Slot(MPZVector_Object *self)
+{
+    PyObject *result;
+    size_t len = sizeof("mpz_vector([])");
+    Py_ssize_t i;
+    char *buf, *p;
+
+    for (i = 0; i < self->size; i++)
+        len += mpz_sizeinbase(MPZVECTOR_ITEM(self, i), 10) + 4;
+    if (!(buf = GMPY_MALLOC(len)))
+        return PyErr_NoMemory();
+
+    p = buf + sprintf(buf, "mpz_vector([");
+    for (i = 0; i < self->size; i++) {
+        if (i)
+            p += sprintf(p, ", ");
+        mpz_get_str(p, 10, MPZVECTOR_ITEM(self, i));
+        p += strlen(p);
+    }
+    sprintf(p, "])");
+    result = Py2or3String_FromString(buf);
+    GMPY_FREE(buf);
+    return result;
+}
+
+static Py_ssize_t
+GMPy_MPZVector_Length_Slot(MPZVector_Object *self)
+{
+    return self->size;
+}
+
+static PyObject *
+GMPy_MPZVector_Item_Slot(MPZVector_Object *self, Py_ssize_t i)
+{
+    MPZ_Object *result;
+
+    if (i < 0 || i >= self->size) {
+        INDEX_ERROR("mpz_vector index out of range");
+        return NULL;
+    }
+    if ((result = GMPy_MPZ_New(NULL)))
+        mpz_set(result->z, MPZVECTOR_ITEM(self, i));
+    return (PyObject*)result;
+}
+
+static PyObject *
+GMPy_MPZVector_Subscript_Slot(MPZVector_Object *self, PyObject *item)
+{
+    MPZVector_Object *result;
+    Py_ssize_t i, start, stop, step, slicelength;
+
+    if (PyIndex_Check(item)) {
+        i = PyNumber_AsSsize_t(item, PyExc_IndexError);
+        if (i == -1 && PyErr_Occurred())
+            return NULL;
+        if (i < 0)
+            i += self->size;
+        return GMPy_MPZVector_Item_Slot(self, i);
+    }
+    if (!PySlice_Check(item)) {
+        TYPE_ERROR("mpz_vector indices must be integers or slices");
+        return NULL;
+    }
+
+#if PY_VERSION_HEX > 0x030200A4
+    if (PySlice_GetIndicesEx(item,
+#else
+    if (PySlice_GetIndicesEx((PySliceObject*)item,
+#endif
+                             self->size, &start, &stop, &step, &slicelength) < 0)
+        return NULL;
+
+    /* A slice is a view of the same elements. */
+    if (!(result = PyObject_New(MPZVector_Object, &MPZVector_Type)))
+        return NULL;
+    result->data = slicelength ? &MPZVECTOR_ITEM(self, start) : self->data;
+    result->size = slicelength;
+    result->step = self->step * step;
+    result->alloc = 0;
+    result->base = self->base ? self->base : (PyObject*)self;
+    Py_INCREF(result->base);
+    return (PyObject*)result;
+}
+
+static int
+GMPy_MPZVector_AssSubscript_Slot(MPZVector_Object *self, PyObject *item, PyObject *value)
+{
+    MPZ_Object *temp;
+    Py_ssize_t i;
+
+    if (!value) {
+        TYPE_ERROR("mpz_vector does not support deleting elements");
+        return -1;
+    }
+    if (!PyIndex_Check(item)) {
+        TYPE_ERROR("mpz_vector assignment requires an integer index");
+        return -1;
+    }
+    i = PyNumber_AsSsize_t(item, PyExc_IndexError);
+    if (i == -1 && PyErr_Occurred())
+        return -1;
+    if (i < 0)
+        i += self->size;
+    if (i < 0 || i >= self->size) {
+        INDEX_ERROR("mpz_vector assignment index out of range");
+        return -1;
+    }
+    if (!IS_INTEGER(value)) {
+        TYPE_ERROR("mpz_vector elements must be integers");
+        return -1;
+    }
+    if (!(temp = GMPy_MPZ_From_Integer(value, NULL)))
+        return -1;
+    mpz_set(MPZVECTOR_ITEM(self, i), temp->z);
+    Py_DECREF((PyObject*)temp);
+    return 0;
+}
+
+static PyObject *
+GMPy_MPZVector_RichCompare_Slot(PyObject *a, PyObject *b, int op)
+{
+    MPZVector_Object *x = (MPZVector_Object*)a, *y = (MPZVector_Object*)b;
+    Py_ssize_t i;
+    int equal;
+
+    if (!MPZVector_Check(a) || !MPZVector_Check(b) || (op != Py_EQ && op != Py_NE))
+        Py_RETURN_NOTIMPLEMENTED;
+
+    equal = x->size == y->size;
+    for (i = 0; equal && i < x->size; i++)
+        equal = !mpz_cmp(MPZVECTOR_ITEM(x, i), MPZVECTOR_ITEM(y, i));
+    if (equal == (op == Py_EQ))
+        Py_RETURN_TRUE;
+    Py_RETURN_FALSE;
+}
+
+#ifdef PY3
+static PyNumberMethods GMPy_MPZVector_number_methods =
+{
+    (binaryfunc) GMPy_MPZVector_Add_Slot,      /* nb_add                  */
+    (binaryfunc) GMPy_MPZVector_Sub_Slot,      /* nb_subtract             */
+    (binaryfunc) GMPy_MPZVector_Mul_Slot,      /* nb_multiply             */
+    (binaryfunc) GMPy_MPZVector_Mod_Slot,      /* nb_remainder            */
+        0,                                     /* nb_divmod               */
+        0,                                     /* nb_power                */
+        0,                                     /* nb_negative             */
+        0,                                     /* nb_positive             */
+        0,                                     /* nb_absolute             */
+        0,                                     /* nb_bool                 */
+        0,                                     /* nb_invert               */
+        0,                                     /* nb_lshift               */
+        0,                                     /* nb_rshift               */
+        0,                                     /* nb_and                  */
+        0,                                     /* nb_xor                  */
+        0,                                     /* nb_or                   */
+        0,                                     /* nb_int                  */
+        0,                                     /* nb_reserved             */
+        0,                                     /* nb_float                */
+        0,                                     /* nb_inplace_add          */
+        0,                                     /* nb_inplace_subtract     */
+        0,                                     /* nb_inplace_multiply     */
+        0,                                     /* nb_inplace_remainder    */
+        0,                                     /* nb_inplace_power        */
+        0,                                     /* nb_inplace_lshift       */
+        0,                                     /* nb_inplace_rshift       */
+        0,                                     /* nb_inplace_and          */
+        0,                                     /* nb_inplace_xor          */
+        0,                                     /* nb_inplace_or           */
+    (binaryfunc) GMPy_MPZVector_FloorDiv_Slot, /* nb_floor_divide         */
+        0,                                     /* nb_true_divide          */
+        0,                                     /* nb_inplace_floor_divide */
+        0,                                     /* nb_inplace_true_divide  */
+        0,                                     /* nb_index                */
+};
+#else
+static PyNumberMethods GMPy_MPZVector_number_methods =
+{
+    (binaryfunc) GMPy_MPZVector_Add_Slot,      /* nb_add                  */
+    (binaryfunc) GMPy_MPZVector_Sub_Slot,      /* nb_subtract             */
+    (binaryfunc) GMPy_MPZVector_Mul_Slot,      /* nb_multiply             */
+    (binaryfunc) GMPy_MPZVector_FloorDiv_Slot, /* nb_divide               */
+    (binaryfunc) GMPy_MPZVector_Mod_Slot,      /* nb_remainder            */
+        0,                                     /* nb_divmod               */
+        0,                                     /* nb_power                */
+        0,                                     /* nb_negative             */
+        0,                                     /* nb_positive             */
+        0,                                     /* nb_absolute             */
+        0,                                     /* nb_bool                 */
+        0,                                     /* nb_invert               */
+        0,                                     /* nb_lshift               */
+        0,                                     /* nb_rshift               */
+        0,                                     /* nb_and                  */
+        0,                                     /* nb_xor                  */
+        0,                                     /* nb_or                   */
+        0,                                     /* nb_coerce               */
+        0,                                     /* nb_int                  */
+        0,                                     /* nb_long                 */
+        0,                                     /* nb_float                */
+        0,                                     /* nb_oct                  */
+        0,                                     /* nb_hex                  */
+        0,                                     /* nb_inplace_add          */
+        0,                                     /* nb_inplace_subtract     */
+        0,                                     /* nb_inplace_multiply     */
+        0,                                     /* nb_inplace_divide       */
+        0,                                     /* nb_inplace_remainder    */
+        0,                                     /* nb_inplace_power        */
+        0,                                     /* nb_inplace_lshift       */
+        0,                                     /* nb_inplace_rshift       */
+        0,                                     /* nb_inplace_and          */
+        0,                                     /* nb_inplace_xor          */
+        0,                                     /* nb_inplace_or           */
+    (binaryfunc) GMPy_MPZVector_FloorDiv_Slot, /* nb_floor_divide         */
+        0,                                     /* nb_true_divide          */
+        0,                                     /* nb_inplace_floor_divide */
+        0,                                     /* nb_inplace_true_divide  */
+        0,                                     /* nb_index                */
+};
+#endif
+
+static PySequenceMethods GMPy_MPZVector_sequence_methods =
+{
+    (lenfunc) GMPy_MPZVector_Length_Slot,    /* sq_length         */
+        0,                                   /* sq_concat         */
+        0,                                   /* sq_repeat         */
+    (ssizeargfunc) GMPy_MPZVector_Item_Slot, /* sq_item           */
+};
+
+static PyMappingMethods GMPy_MPZVector_mapping_methods =
+{
+    (lenfunc) GMPy_MPZVector_Length_Slot,
+    (binaryfunc) GMPy_MPZVector_Subscript_Slot,
+    (objobjargproc) GMPy_MPZVector_AssSubscript_Slot
+};
+
+static PyMethodDef GMPy_MPZVector_methods[] =
+{
+    { "gcd", GMPy_MPZVector_Method_GCD, METH_NOARGS, GMPy_doc_mpz_vector_gcd },
+    { "powmod", GMPY_FASTCALL(GMPy_MPZVector_Method_PowMod), GMPY_METH_FASTCALL, GMPy_doc_mpz_vector_powmod },
+    { "prod", GMPy_MPZVector_Method_Prod, METH_NOARGS, GMPy_doc_mpz_vector_prod },
+    { "sum", GMPy_MPZVector_Method_Sum, METH_NOARGS, GMPy_doc_mpz_vector_sum },
+    { "tolist", GMPy_MPZVector_Method_ToList, METH_NOARGS, GMPy_doc_mpz_vector_tolist },
+    { NULL, NULL, 1 }
+};
+
+static PyTypeObject MPZVector_Type =
+{
+#ifdef PY3
+    PyVarObject_HEAD_INIT(0, 0)
+#else
+    PyObject_HEAD_INIT(0)
+        0,                                   /* ob_size          */
+#endif
+    "mpz_vector",                            /* tp_name          */
+    sizeof(MPZVector_Object),                /* tp_basicsize     */
+        0,                                   /* tp_itemsize      */
+    (destructor) GMPy_MPZVector_Dealloc,     /* tp_dealloc       */
+        0,                                   /* tp_print         */
+        0,                                   /* tp_getattr       */
+        0,                                   /* tp_setattr       */
+        0,                                   /* tp_reserved      */
+    (reprfunc) GMPy_MPZVector_Repr_Slot,     /* tp_repr          */
+    &GMPy_MPZVector_number_methods,          /* tp_as_number     */
+    &GMPy_MPZVector_sequence_methods,        /* tp_as_sequence   */
+    &GMPy_MPZVector_mapping_methods,         /* tp_as_mapping    */
+        0,                                   /* tp_hash          */
+        0,                                   /* tp_call          */
+        0,                                   /* tp_str           */
+        0,                                   /* tp_getattro      */
+        0,                                   /* tp_setattro      */
+        0,                                   /* tp_as_buffer     */
+#ifdef PY3
+    Py_TPFLAGS_DEFAULT,                      /* tp_flags         */
+#else
+    Py_TPFLAGS_HAVE_RICHCOMPARE | Py_TPFLAGS_CHECKTYPES, /* tp_flags */
+#endif
+    "GMPY2 vector of mpz",                   /* tp_doc           */
+        0,                                   /* tp_traverse      */
+        0,                                   /* tp_clear         */
+    (richcmpfunc)&GMPy_MPZVector_RichCompare_Slot, /* tp_richcompare */
+        0,                                   /* tp_weaklistoffset*/
+        0,                                   /* tp_iter          */
+        0,                                   /* tp_iternext      */
+    GMPy_MPZVector_methods,                  /* tp_methods       */
+        0,                                   /* tp_members       */
+        0,                                   /* tp_getset        */
+};
@@ -0,0 +1,77 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_mpz_vector.h                                                      *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+#ifndef GMPY_MPZ_VECTOR_H
+#define GMPY_MPZ_VECTOR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* An mpz_vector stores its elements as an array of mpz_t. A slice is a
+ * view that shares the array of the vector it was taken from: element i
+ * of a vector is data[i * step], and base refers to the vector that owns
+ * the array. A vector that owns its array has base == NULL and initialized
+ * alloc elements.
+ */
+
+typedef struct {
+    PyObject_HEAD
+    mpz_t *data;                    /* first element */
+    Py_ssize_t size;                /* number of elements */
+    Py_ssize_t step;                /* distance between elements */
+    Py_ssize_t alloc;               /* elements owned, 0 for a view */
+    PyObject *base;                 /* owner of the elements of a view */
+} MPZVector_Object;
+
+static PyTypeObject MPZVector_Type;
+
+#define MPZVector_Check(v) (((PyObject*)v)->ob_type == &MPZVector_Type)
+#define MPZVECTOR_ITEM(v, i) ((v)->data[(i) * (v)->step])
+
+static PyObject * GMPy_MPZVector_Factory(PyObject *self, PyObject *args);
+static void       GMPy_MPZVector_Dealloc(MPZVector_Object *self);
+static PyObject * GMPy_MPZVector_Repr_Slot(MPZVector_Object *self);
+static Py_ssize_t GMPy_MPZVector_Length_Slot(MPZVector_Object *self);
+static PyObject * GMPy_MPZVector_Item_Slot(MPZVector_Object *self, Py_ssize_t i);
+static PyObject * GMPy_MPZVector_Subscript_Slot(MPZVector_Object *self, PyObject *item);
+static int        GMPy_MPZVector_AssSubscript_Slot(MPZVector_Object *self, PyObject *item, PyObject *value);
+static PyObject * GMPy_MPZVector_RichCompare_Slot(PyObject *a, PyObject *b, int op);
+static PyObject * GMPy_MPZVector_Add_Slot(PyObject *x, PyObject *y);
+static PyObject * GMPy_MPZVector_Sub_Slot(PyObject *x, PyObject *y);
+static PyObject * GMPy_MPZVector_Mul_Slot(PyObject *x, PyObject *y);
+static PyObject * GMPy_MPZVector_FloorDiv_Slot(PyObject *x, PyObject *y);
+static PyObject * GMPy_MPZVector_Mod_Slot(PyObject *x, PyObject *y);
+static PyObject * GMPy_MPZVector_Method_PowMod(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPy_MPZVector_Method_Sum(PyObject *self, PyObject *other);
+static PyObject * GMPy_MPZVector_Method_Prod(PyObject *self, PyObject *other);
+static PyObject * GMPy_MPZVector_Method_GCD(PyObject *self, PyObject *other);
+static PyObject * GMPy_MPZVector_Method_ToList(PyObject *self, PyObject *other);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -25,7 +25,8 @@
  * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
  * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
-/* This file implements the * operator, gmpy2.mul() and context.mul().
+/* This file implements the * operator, gmpy2.mul(), context.mul(), and
+ * gmpy2.prod().
  *
  * Public API
  * ==========
@@ -47,6 +48,7 @@
  *   GMPy_Complex_Mul(Complex, Complex, context|NULL)
  *
  *   GMPy_Context_Mul(context, args)
+ *   GMPy_Context_Prod(context, iterable)
  *
  */
 
@@ -72,16 +74,15 @@ GMPy_Integer_Mul(PyObject *x, PyObject *y, CTXT_Object *context)
             }
             else {
                 mpz_t tempz;
-                mpz_inoc(tempz);
-                mpz_set_PyIntOrLong(tempz, y);
-                mpz_mul(result->z, MPZ(x), tempz);
-                mpz_cloc(tempz);
+                mpz_inoc_pylong(tempz, y);
+                GMPY_MPZ_MUL(result->z, MPZ(x), tempz);
+                mpz_cloc_pylong(tempz);
             }
             return (PyObject*)result;
         }
 
         if (CHECK_MPZANY(y)) {
-            mpz_mul(result->z, MPZ(x), MPZ(y));
+            GMPY_MPZ_MUL(result->z, MPZ(x), MPZ(y));
             return (PyObject*)result;
         }
     }
@@ -96,10 +97,9 @@ GMPy_Integer_Mul(PyObject *x, PyObject *y, CTXT_Object *context)
             }
             else {
                 mpz_t tempz;
-                mpz_inoc(tempz);
-                mpz_set_PyIntOrLong(tempz, x);
-                mpz_mul(result->z, MPZ(y), tempz);
-                mpz_cloc(tempz);
+                mpz_inoc_pylong(tempz, x);
+                GMPY_MPZ_MUL(result->z, MPZ(y), tempz);
+                mpz_cloc_pylong(tempz);
             }
             return (PyObject*)result;
         }
@@ -117,7 +117,7 @@ GMPy_Integer_Mul(PyObject *x, PyObject *y, CTXT_Object *context)
             return NULL;
         }
 
-        mpz_mul(result->z, tempx->z, tempy->z);
+        GMPY_MPZ_MUL(result->z, tempx->z, tempy->z);
         Py_DECREF((PyObject*)tempx);
         Py_DECREF((PyObject*)tempy);
         return (PyObject*)result;
@@ -132,28 +132,40 @@ GMPy_Integer_Mul(PyObject *x, PyObject *y, CTXT_Object *context)
  * MPZ_Object. If the other object isn't an MPZ_Object, call the appropriate
  * function. If no appropriate function can be found, return NotImplemented. */
 
+GMPY_PROFILE_WRAP(PyObject *, GMPy_MPZ_Mul_Slot, (PyObject *x, PyObject *y),
+                  (x, y), gmpy_profile_bits2(x, y))
+
 static PyObject *
-GMPy_MPZ_Mul_Slot(PyObject *x, PyObject *y)
+GMPy_MPZ_Mul_Slot_Impl(PyObject *x, PyObject *y)
 {
+    int xtype, ytype;
+
     if (CHECK_MPZANY(x) && CHECK_MPZANY(y)) {
         MPZ_Object *result;
 
-        if ((result = GMPy_MPZ_New(NULL))) {
-            mpz_mul(result->z, MPZ(x), MPZ(y));
+        if (GMPY_LIMB_CHECK((double)(mpz_size(MPZ(x)) + mpz_size(MPZ(y))) *
+                            GMP_NUMB_BITS, NULL))
+            return NULL;
+
+        if ((result = GMPy_MPZ_Reuse(x, y))) {
+            GMPY_MPZ_MUL(result->z, MPZ(x), MPZ(y));
         }
         return (PyObject*)result;
     }
     
-    if (IS_INTEGER(x) && IS_INTEGER(y))
+    xtype = GMPy_ObjectType(x);
+    ytype = GMPy_ObjectType(y);
+
+    if (IS_TYPE_INTEGER(xtype) && IS_TYPE_INTEGER(ytype))
         return GMPy_Integer_Mul(x, y, NULL);
 
-    if (IS_RATIONAL(x) && IS_RATIONAL(y))
+    if (IS_TYPE_RATIONAL(xtype) && IS_TYPE_RATIONAL(ytype))
         return GMPy_Rational_Mul(x, y, NULL);
 
-    if (IS_REAL(x) && IS_REAL(y))
+    if (IS_TYPE_REAL(xtype) && IS_TYPE_REAL(ytype))
         return GMPy_Real_Mul(x, y, NULL);
 
-    if (IS_COMPLEX(x) && IS_COMPLEX(y))
+    if (IS_TYPE_COMPLEX(xtype) && IS_TYPE_COMPLEX(ytype))
         return GMPy_Complex_Mul(x, y, NULL);
 
     Py_RETURN_NOTIMPLEMENTED;
@@ -172,7 +184,8 @@ GMPy_Rational_Mul(PyObject *x, PyObject *y, CTXT_Object *context)
         return NULL;
 
     if (MPQ_Check(x) && MPQ_Check(y)) {
-        mpq_mul(result->q, MPQ(x), MPQ(y));
+        if (!GMPy_MPQ_Small_Mul(result->q, MPQ(x), MPQ(y), 0))
+            mpq_mul(result->q, MPQ(x), MPQ(y));
         return (PyObject*)result;
     }
 
@@ -188,7 +201,8 @@ GMPy_Rational_Mul(PyObject *x, PyObject *y, CTXT_Object *context)
             return NULL;
         }
 
-        mpq_mul(result->q, tempx->q, tempy->q);
+        if (!GMPy_MPQ_Small_Mul(result->q, tempx->q, tempy->q, 0))
+            mpq_mul(result->q, tempx->q, tempy->q);
         Py_DECREF((PyObject*)tempx);
         Py_DECREF((PyObject*)tempy);
         return (PyObject*)result;
@@ -203,16 +217,24 @@ GMPy_Rational_Mul(PyObject *x, PyObject *y, CTXT_Object *context)
  * If the other object isn't a Pympq, call the appropriate function. If
  * no appropriate function can be found, return NotImplemented. */
 
+GMPY_PROFILE_WRAP(PyObject *, GMPy_MPQ_Mul_Slot, (PyObject *x, PyObject *y),
+                  (x, y), gmpy_profile_bits2(x, y))
+
 static PyObject *
-GMPy_MPQ_Mul_Slot(PyObject *x, PyObject *y)
+GMPy_MPQ_Mul_Slot_Impl(PyObject *x, PyObject *y)
 {
-    if (IS_RATIONAL(x) && IS_RATIONAL(y))
+    int xtype, ytype;
+
+    xtype = GMPy_ObjectType(x);
+    ytype = GMPy_ObjectType(y);
+
+    if (IS_TYPE_RATIONAL(xtype) && IS_TYPE_RATIONAL(ytype))
         return GMPy_Rational_Mul(x, y, NULL);
 
-    if (IS_REAL(x) && IS_REAL(y))
+    if (IS_TYPE_REAL(xtype) && IS_TYPE_REAL(ytype))
         return GMPy_Real_Mul(x, y, NULL);
 
-    if (IS_COMPLEX(x) && IS_COMPLEX(y))
+    if (IS_TYPE_COMPLEX(xtype) && IS_TYPE_COMPLEX(ytype))
         return GMPy_Complex_Mul(x, y, NULL);
 
     Py_RETURN_NOTIMPLEMENTED;
@@ -236,6 +258,8 @@ GMPy_Real_Mul(PyObject *x, PyObject *y, CTXT_Object *context)
      * to handle the rare case at the end. */
 
     if (MPFR_Check(x) && MPFR_Check(y)) {
+        if (GMPy_MPFR_D53_Mul(result, (MPFR_Object*)x, (MPFR_Object*)y, context))
+            goto done;
         mpfr_clear_flags();
         result->rc = mpfr_mul(result->f, MPFR(x), MPFR(y),
                               GET_MPFR_ROUND(context));
@@ -254,11 +278,10 @@ GMPy_Real_Mul(PyObject *x, PyObject *y, CTXT_Object *context)
             }
             else {
                 mpz_t tempz;
-                mpz_inoc(tempz);
-                mpz_set_PyIntOrLong(tempz, y);
+                mpz_inoc_pylong(tempz, y);
                 mpfr_clear_flags();
                 result->rc = mpfr_mul_z(result->f, MPFR(x), tempz, GET_MPFR_ROUND(context));
-                mpz_cloc(tempz);
+                mpz_cloc_pylong(tempz);
                 goto done;
             }
         }
@@ -300,11 +323,10 @@ GMPy_Real_Mul(PyObject *x, PyObject *y, CTXT_Object *context)
             }
             else {
                 mpz_t tempz;
-                mpz_inoc(tempz);
-                mpz_set_PyIntOrLong(tempz, x);
+                mpz_inoc_pylong(tempz, x);
                 mpfr_clear_flags();
                 result->rc = mpfr_mul_z(result->f, MPFR(y), tempz, GET_MPFR_ROUND(context));
-                mpz_cloc(tempz);
+                mpz_cloc_pylong(tempz);
                 goto done;
             }
         }
@@ -370,13 +392,21 @@ GMPy_Real_Mul(PyObject *x, PyObject *y, CTXT_Object *context)
  * If the other object isn't a Pympfr, call the appropriate function. If
  * no appropriate function can be found, return NotImplemented. */
 
+GMPY_PROFILE_WRAP(PyObject *, GMPy_MPFR_Mul_Slot, (PyObject *x, PyObject *y),
+                  (x, y), gmpy_profile_bits2(x, y))
+
 static PyObject *
-GMPy_MPFR_Mul_Slot(PyObject *x, PyObject *y)
+GMPy_MPFR_Mul_Slot_Impl(PyObject *x, PyObject *y)
 {
-    if (IS_REAL(x) && IS_REAL(y))
+    int xtype, ytype;
+
+    xtype = GMPy_ObjectType(x);
+    ytype = GMPy_ObjectType(y);
+
+    if (IS_TYPE_REAL(xtype) && IS_TYPE_REAL(ytype))
         return GMPy_Real_Mul(x, y, NULL);
 
-    if (IS_COMPLEX(x) && IS_COMPLEX(y))
+    if (IS_TYPE_COMPLEX(xtype) && IS_TYPE_COMPLEX(ytype))
         return GMPy_Complex_Mul(x, y, NULL);
 
     Py_RETURN_NOTIMPLEMENTED;
@@ -401,6 +431,44 @@ GMPy_Complex_Mul(PyObject *x, PyObject *y, CTXT_Object *context)
         goto done;
     }
 
+    /* A real operand is used as an mpfr, so no zero imaginary part is
+     * created or operated on. */
+    if (IS_COMPLEX(x) && IS_REAL(y)) {
+        MPC_Object *tempx;
+        MPFR_Object *tempy;
+
+        tempx = GMPy_MPC_From_Complex(x, 1, 1, context);
+        tempy = GMPy_MPFR_From_Real(y, 1, context);
+        if (!tempx || !tempy) {
+            Py_XDECREF((PyObject*)tempx);
+            Py_XDECREF((PyObject*)tempy);
+            Py_DECREF((PyObject*)result);
+            return NULL;
+        }
+        result->rc = mpc_mul_fr(result->c, tempx->c, tempy->f, GET_MPC_ROUND(context));
+        Py_DECREF((PyObject*)tempx);
+        Py_DECREF((PyObject*)tempy);
+        goto done;
+    }
+
+    if (IS_REAL(x) && IS_COMPLEX(y)) {
+        MPFR_Object *tempx;
+        MPC_Object *tempy;
+
+        tempx = GMPy_MPFR_From_Real(x, 1, context);
+        tempy = GMPy_MPC_From_Complex(y, 1, 1, context);
+        if (!tempx || !tempy) {
+            Py_XDECREF((PyObject*)tempx);
+            Py_XDECREF((PyObject*)tempy);
+            Py_DECREF((PyObject*)result);
+            return NULL;
+        }
+        result->rc = mpc_mul_fr(result->c, tempy->c, tempx->f, GET_MPC_ROUND(context));
+        Py_DECREF((PyObject*)tempx);
+        Py_DECREF((PyObject*)tempy);
+        goto done;
+    }
+
     if (IS_COMPLEX(x) && IS_COMPLEX(y)) {
         MPC_Object *tempx, *tempy;
 
@@ -431,25 +499,36 @@ GMPy_Complex_Mul(PyObject *x, PyObject *y, CTXT_Object *context)
  * step of the numeric ladder, the NotImplemented return value from
  * Pympc_Add_Complex() is correct and is just passed on. */
 
+GMPY_PROFILE_WRAP(PyObject *, GMPy_MPC_Mul_Slot, (PyObject *x, PyObject *y),
+                  (x, y), gmpy_profile_bits2(x, y))
+
 static PyObject *
-GMPy_MPC_Mul_Slot(PyObject *x, PyObject *y)
+GMPy_MPC_Mul_Slot_Impl(PyObject *x, PyObject *y)
 {
     return GMPy_Complex_Mul(x, y, NULL);
 }
 
+GMPY_PROFILE_WRAP(PyObject *, GMPy_Number_Mul, (PyObject *x, PyObject *y, CTXT_Object *context),
+                  (x, y, context), gmpy_profile_bits2(x, y))
+
 static PyObject *
-GMPy_Number_Mul(PyObject *x, PyObject *y, CTXT_Object *context)
+GMPy_Number_Mul_Impl(PyObject *x, PyObject *y, CTXT_Object *context)
 {
-    if (IS_INTEGER(x) && IS_INTEGER(y))
+    int xtype, ytype;
+
+    xtype = GMPy_ObjectType(x);
+    ytype = GMPy_ObjectType(y);
+
+    if (IS_TYPE_INTEGER(xtype) && IS_TYPE_INTEGER(ytype))
         return GMPy_Integer_Mul(x, y, context);
 
-    if (IS_RATIONAL(x) && IS_RATIONAL(y))
+    if (IS_TYPE_RATIONAL(xtype) && IS_TYPE_RATIONAL(ytype))
         return GMPy_Rational_Mul(x, y, context);
 
-    if (IS_REAL(x) && IS_REAL(y))
+    if (IS_TYPE_REAL(xtype) && IS_TYPE_REAL(ytype))
         return GMPy_Real_Mul(x, y, context);
 
-    if (IS_COMPLEX(x) && IS_COMPLEX(y))
+    if (IS_TYPE_COMPLEX(xtype) && IS_TYPE_COMPLEX(ytype))
         return GMPy_Complex_Mul(x, y, context);
 
     TYPE_ERROR("mul() argument type not supported");
@@ -467,11 +546,11 @@ PyDoc_STRVAR(GMPy_doc_context_mul,
 "Return x * y.");
 
 static PyObject *
-GMPy_Context_Mul(PyObject *self, PyObject *args)
+GMPy_Context_Mul(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     CTXT_Object *context = NULL;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (nargs != 2) {
         TYPE_ERROR("mul() requires 2 arguments");
         return NULL;
     }
@@ -483,6 +562,266 @@ GMPy_Context_Mul(PyObject *self, PyObject *args)
         CHECK_CONTEXT(context);
     }
 
-    return GMPy_Number_Mul(PyTuple_GET_ITEM(args, 0), PyTuple_GET_ITEM(args, 1), context);
+    return GMPy_Number_Mul(args[0], args[1], context);
+}
+GMPY_FASTCALL_WRAPPER(GMPy_Context_Mul)
+
+
+/* Support for prod(). Each factor is split into an integer numerator, an
+ * integer denominator, and a power of 2 so the product can be computed
+ * exactly using balanced product trees. A real result is only rounded once.
+ */
+
+typedef struct {
+    mpz_t *z;
+    Py_ssize_t n, alloc;
+} prod_factors;
+
+/* Return the next (initialized) entry in f, or NULL if out of memory. */
+
+static mpz_ptr
+prod_next(prod_factors *f)
+{
+    mpz_t *temp;
+
+    if (f->n == f->alloc) {
+        f->alloc = f->alloc ? 2 * f->alloc : 64;
+        if (!(temp = GMPY_REALLOC(f->z, f->alloc * sizeof(mpz_t)))) {
+            PyErr_NoMemory();
+            return NULL;
+        }
+        f->z = temp;
+    }
+    mpz_inoc(f->z[f->n]);
+    return f->z[f->n++];
+}
+
+static void
+prod_clear(prod_factors *f)
+{
+    Py_ssize_t i;
+
+    for (i = 0; i < f->n; i++)
+        mpz_cloc(f->z[i]);
+    GMPY_FREE(f->z);
+}
+
+/* Multiply the entries of f and store the product in the first entry. Each
+ * level of the tree multiplies adjacent pairs in place, so no temporaries
+ * are needed and the GIL can be released.
+ */
+
+static void
+prod_tree(prod_factors *f)
+{
+    Py_ssize_t i, m;
+    size_t bits = 0;
+
+    for (i = 0; i < f->n; i++)
+        bits += mpz_size(f->z[i]) * GMP_NUMB_BITS;
+
+    GMPY_BEGIN_NOGIL(bits);
+    for (m = f->n; m > 1; m = (m + 1) / 2) {
+        for (i = 0; i < m / 2; i++)
+            mpz_mul(f->z[i], f->z[2 * i], f->z[2 * i + 1]);
+        if (m & 1)
+            mpz_swap(f->z[m / 2], f->z[m - 1]);
+    }
+    GMPY_END_NOGIL;
 }
 
+PyDoc_STRVAR(GMPy_doc_function_prod,
+"prod(iterable, threads=None) -> number\n\n"
+"Return the product of the values in the iterable, or 1 if the iterable\n"
+"is empty. The product is an mpz if all the values are integers, an mpq\n"
+"if they are rational, and an mpfr (rounded once) if any value is real.\n"
+"If threads is given, each level of the product tree is computed by up\n"
+"to that many threads.");
+
+PyDoc_STRVAR(GMPy_doc_context_prod,
+"context.prod(iterable, threads=None) -> number\n\n"
+"Return the product of the values in the iterable, or 1 if the iterable\n"
+"is empty. The product is an mpz if all the values are integers, an mpq\n"
+"if they are rational, and an mpfr (rounded once) if any value is real.\n"
+"If threads is given, each level of the product tree is computed by up\n"
+"to that many threads.");
+
+static PyObject *
+GMPy_Context_Prod(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    static char *kwlist[] = {"iterable", "threads", NULL};
+    PyObject *other, *threads_obj = NULL;
+    PyObject *iter, *item, *result = NULL;
+    MPZ_Object *resultz;
+    MPQ_Object *tempq, *resultq;
+    MPFR_Object *tempf, *resultf;
+    prod_factors num = { NULL, 0, 0 }, den = { NULL, 0, 0 };
+    mpfr_exp_t emin, emax, e;
+    mpz_ptr z;
+    mpz_t exp;
+    mpq_t q;
+    int kind = 1, zero = 0, inf = 0, nan = 0, negative = 0, ok, t, threads;
+    CTXT_Object *context = NULL;
+
+    if (self && CTXT_Check(self)) {
+        context = (CTXT_Object*)self;
+    }
+    else {
+        CHECK_CONTEXT(context);
+    }
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|O", kwlist,
+                                     &other, &threads_obj))
+        return NULL;
+    if ((threads = GMPy_Pool_Threads_Arg(threads_obj)) < 0)
+        return NULL;
+
+    if (!(iter = PyObject_GetIter(other))) {
+        TYPE_ERROR("prod() argument must be an iterable");
+        return NULL;
+    }
+
+    mpz_inoc(exp);
+    mpz_set_ui(exp, 0);
+    while ((item = PyIter_Next(iter))) {
+        ok = 0;
+        if (IS_INTEGER(item)) {
+            if ((z = prod_next(&num))) {
+                ok = 1;
+                if (CHECK_MPZANY(item))
+                    mpz_set(z, MPZ(item));
+                else
+                    mpz_set_PyIntOrLong(z, item);
+                zero |= !mpz_sgn(z);
+                negative ^= mpz_sgn(z) < 0;
+            }
+        }
+        else if (IS_RATIONAL(item)) {
+            if ((tempq = GMPy_MPQ_From_Rational(item, context))) {
+                if (prod_next(&num) && (z = prod_next(&den))) {
+                    ok = 1;
+                    mpz_set(num.z[num.n - 1], mpq_numref(tempq->q));
+                    mpz_set(z, mpq_denref(tempq->q));
+                    zero |= !mpq_sgn(tempq->q);
+                    negative ^= mpq_sgn(tempq->q) < 0;
+                }
+                Py_DECREF((PyObject*)tempq);
+                if (kind < 2)
+                    kind = 2;
+            }
+        }
+        else if (IS_REAL(item)) {
+            if ((tempf = GMPy_MPFR_From_Real(item, 1, context))) {
+                if (mpfr_regular_p(tempf->f)) {
+                    if ((z = prod_next(&num))) {
+                        ok = 1;
+                        e = mpfr_get_z_2exp(z, tempf->f);
+                        if (e >= 0)
+                            mpz_add_ui(exp, exp, (unsigned long)e);
+                        else
+                            mpz_sub_ui(exp, exp, (unsigned long)-e);
+                        negative ^= mpz_sgn(z) < 0;
+                    }
+                }
+                else {
+                    ok = 1;
+                    nan |= mpfr_nan_p(tempf->f);
+                    inf |= mpfr_inf_p(tempf->f);
+                    zero |= mpfr_zero_p(tempf->f);
+                    negative ^= mpfr_signbit(tempf->f) != 0;
+                }
+                Py_DECREF((PyObject*)tempf);
+                kind = 3;
+            }
+        }
+        else {
+            TYPE_ERROR("prod() argument type not supported");
+        }
+        Py_DECREF(item);
+        if (!ok)
+            break;
+    }
+    Py_DECREF(iter);
+    if (PyErr_Occurred())
+        goto done;
+
+    /* The product of no factors is 1. */
+    if (num.n == 0) {
+        if (!(z = prod_next(&num)))
+            goto done;
+        mpz_set_ui(z, 1);
+    }
+
+    if (threads) {
+        if (GMPy_Reduce_Prod(num.z, num.n, threads) < 0 ||
+            GMPy_Reduce_Prod(den.z, den.n, threads) < 0)
+            goto done;
+    }
+    else {
+        prod_tree(&num);
+        prod_tree(&den);
+    }
+
+    if (kind == 1) {
+        if ((resultz = GMPy_MPZ_New(context))) {
+            mpz_swap(resultz->z, num.z[0]);
+            result = (PyObject*)resultz;
+        }
+    }
+    else if (kind == 2) {
+        if ((resultq = GMPy_MPQ_New(context))) {
+            mpz_swap(mpq_numref(resultq->q), num.z[0]);
+            mpz_swap(mpq_denref(resultq->q), den.z[0]);
+            mpq_canonicalize(resultq->q);
+            result = (PyObject*)resultq;
+        }
+    }
+    else if ((resultf = GMPy_MPFR_New(0, context))) {
+        mpfr_clear_flags();
+        if (nan || (inf && zero)) {
+            mpfr_set_nan(resultf->f);
+            mpfr_set_nanflag();
+            resultf->rc = 0;
+        }
+        else if (inf) {
+            mpfr_set_inf(resultf->f, negative ? -1 : 1);
+            resultf->rc = 0;
+        }
+        else if (zero) {
+            mpfr_set_zero(resultf->f, negative ? -1 : 1);
+            resultf->rc = 0;
+        }
+        else {
+            if (den.n) {
+                mpq_init(q);
+                mpz_swap(mpq_numref(q), num.z[0]);
+                mpz_swap(mpq_denref(q), den.z[0]);
+                mpq_canonicalize(q);
+            }
+            if (mpz_fits_slong_p(exp))
+                e = mpz_get_si(exp);
+            else
+                e = mpz_sgn(exp) > 0 ? LONG_MAX : LONG_MIN;
+
+            GMPY_MPFR_WIDEN_RANGE(emin, emax);
+            if (den.n)
+                resultf->rc = mpfr_set_q(resultf->f, q, GET_MPFR_ROUND(context));
+            else
+                resultf->rc = mpfr_set_z(resultf->f, num.z[0], GET_MPFR_ROUND(context));
+            /* Scaling is exact unless the result overflows or underflows. */
+            if ((t = mpfr_mul_2si(resultf->f, resultf->f, e, GET_MPFR_ROUND(context))))
+                resultf->rc = t;
+            GMPY_MPFR_RESTORE_RANGE(emin, emax);
+            if (den.n)
+                mpq_clear(q);
+        }
+        GMPY_MPFR_CLEANUP(resultf, context, "prod()");
+        result = (PyObject*)resultf;
+    }
+
+  done:
+    mpz_cloc(exp);
+    prod_clear(&num);
+    prod_clear(&den);
+    return result;
+}
@@ -48,7 +48,8 @@ static PyObject * GMPy_MPQ_Mul_Slot(PyObject *x, PyObject *y);
 static PyObject * GMPy_MPFR_Mul_Slot(PyObject *x, PyObject *y);
 static PyObject * GMPy_MPC_Mul_Slot(PyObject *x, PyObject *y);
 
-static PyObject * GMPy_Context_Mul(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_Mul(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPy_Context_Prod(PyObject *self, PyObject *args, PyObject *kwargs);
 
 #ifdef __cplusplus
 }
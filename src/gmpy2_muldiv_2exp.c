@@ -102,11 +102,11 @@ GMPy_Number_Mul_2exp(PyObject *x, PyObject *y, CTXT_Object *context)
 }
 
 static PyObject *
-GMPy_Context_Mul_2exp(PyObject *self, PyObject *args)
+GMPy_Context_Mul_2exp(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     CTXT_Object *context = NULL;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (nargs != 2) {
         TYPE_ERROR("mul_2exp() requires 2 arguments");
         return NULL;
     }
@@ -118,10 +118,11 @@ GMPy_Context_Mul_2exp(PyObject *self, PyObject *args)
         CHECK_CONTEXT(context);
     }
 
-    return GMPy_Number_Mul_2exp(PyTuple_GET_ITEM(args, 0),
-                                PyTuple_GET_ITEM(args, 1),
+    return GMPy_Number_Mul_2exp(args[0],
+                                args[1],
                                 context);
 }
+GMPY_FASTCALL_WRAPPER(GMPy_Context_Mul_2exp)
 
 /* ======================================================================= */
 
@@ -202,11 +203,11 @@ GMPy_Number_Div_2exp(PyObject *x, PyObject *y, CTXT_Object *context)
 }
 
 static PyObject *
-GMPy_Context_Div_2exp(PyObject *self, PyObject *args)
+GMPy_Context_Div_2exp(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     CTXT_Object *context = NULL;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (nargs != 2) {
         TYPE_ERROR("div_2exp() requires 2 arguments");
         return NULL;
     }
@@ -218,8 +219,9 @@ GMPy_Context_Div_2exp(PyObject *self, PyObject *args)
         CHECK_CONTEXT(context);
     }
 
-    return GMPy_Number_Div_2exp(PyTuple_GET_ITEM(args, 0),
-                                PyTuple_GET_ITEM(args, 1),
+    return GMPy_Number_Div_2exp(args[0],
+                                args[1],
                                 context);
 }
+GMPY_FASTCALL_WRAPPER(GMPy_Context_Div_2exp)
 
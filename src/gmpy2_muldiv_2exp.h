@@ -35,12 +35,12 @@ extern "C" {
 static PyObject * GMPy_Real_Mul_2exp(PyObject *x, PyObject *y, CTXT_Object *context);
 static PyObject * GMPy_Complex_Mul_2exp(PyObject *x, PyObject *y, CTXT_Object *context);
 static PyObject * GMPy_Number_Mul_2exp(PyObject *x, PyObject *y, CTXT_Object *context);
-static PyObject * GMPy_Context_Mul_2exp(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_Mul_2exp(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 
 static PyObject * GMPy_Real_Div_2exp(PyObject *x, PyObject *y, CTXT_Object *context);
 static PyObject * GMPy_Complex_Div_2exp(PyObject *x, PyObject *y, CTXT_Object *context);
 static PyObject * GMPy_Number_Div_2exp(PyObject *x, PyObject *y, CTXT_Object *context);
-static PyObject * GMPy_Context_Div_2exp(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_Div_2exp(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 
 #ifdef __cplusplus
 }
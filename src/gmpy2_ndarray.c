@@ -0,0 +1,446 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_ndarray.c                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* This file implements bulk conversion between arrays of machine numbers
+ * and lists of gmpy2 objects:
+ *
+ *   from_ndarray(arr)
+ *   to_ndarray(seq, dtype)
+ *
+ * The array is accessed through the buffer protocol so any exporter (a
+ * numpy array, an array.array, a memoryview) can be used and numpy is not
+ * required at compile time. Only C-contiguous buffers of int64, uint64,
+ * float64 and long double items are supported.
+ */
+
+#define NDARRAY_INT64      1
+#define NDARRAY_UINT64     2
+#define NDARRAY_FLOAT64    3
+#define NDARRAY_LONGDOUBLE 4
+
+/* Return the array type for a single buffer format character and item
+ * size, or 0 if the combination is not supported.
+ */
+
+static int
+ndarray_code(char c, Py_ssize_t itemsize)
+{
+    switch (c) {
+        case 'q':
+        case 'l':
+            return itemsize == 8 ? NDARRAY_INT64 : 0;
+        case 'Q':
+        case 'L':
+            return itemsize == 8 ? NDARRAY_UINT64 : 0;
+        case 'd':
+            return itemsize == 8 ? NDARRAY_FLOAT64 : 0;
+        case 'g':
+            return itemsize == sizeof(long double) ? NDARRAY_LONGDOUBLE : 0;
+        default:
+            return 0;
+    }
+}
+
+/* Return the array type described by a buffer format string. A byte order
+ * prefix is accepted if it matches the native byte order.
+ */
+
+static int
+ndarray_format_code(const char *format, Py_ssize_t itemsize)
+{
+    if (!format)
+        return 0;
+    if (format[0] == '@' || format[0] == '=')
+        format++;
+#ifdef WORDS_BIGENDIAN
+    else if (format[0] == '>' || format[0] == '!')
+        format++;
+#else
+    else if (format[0] == '<')
+        format++;
+#endif
+    if (!format[0] || format[1])
+        return 0;
+    return ndarray_code(format[0], itemsize);
+}
+
+/* Return the array type named by a dtype argument. A string is accepted, as
+ * is any object (such as a numpy dtype or scalar type) with a name.
+ */
+
+static int
+ndarray_dtype_code(PyObject *dtype)
+{
+    PyObject *name = NULL, *ascii;
+    const char *s;
+    int code = 0;
+
+    if (PyStrOrUnicode_Check(dtype)) {
+        Py_INCREF(dtype);
+        name = dtype;
+    }
+    else if (!(name = PyObject_GetAttrString(dtype, "name"))) {
+        PyErr_Clear();
+        if (!(name = PyObject_GetAttrString(dtype, "__name__")))
+            PyErr_Clear();
+    }
+    if (!name || !PyStrOrUnicode_Check(name)) {
+        Py_XDECREF(name);
+        return 0;
+    }
+
+    if (PyUnicode_Check(name)) {
+        ascii = PyUnicode_AsASCIIString(name);
+        Py_DECREF(name);
+        if (!ascii) {
+            PyErr_Clear();
+            return 0;
+        }
+        name = ascii;
+    }
+    s = PyBytes_AS_STRING(name);
+
+    if (!strcmp(s, "int64") || !strcmp(s, "i8"))
+        code = NDARRAY_INT64;
+    else if (!strcmp(s, "uint64") || !strcmp(s, "u8"))
+        code = NDARRAY_UINT64;
+    else if (!strcmp(s, "float64") || !strcmp(s, "f8") || !strcmp(s, "double"))
+        code = NDARRAY_FLOAT64;
+    else if (!strcmp(s, "longdouble") ||
+             (sizeof(long double) == 16 && !strcmp(s, "float128")) ||
+             (sizeof(long double) == 12 && !strcmp(s, "float96")))
+        code = NDARRAY_LONGDOUBLE;
+    else if (s[0] == 'g' && !s[1])
+        code = ndarray_code('g', sizeof(long double));
+    else if ((s[0] == 'l' || s[0] == 'L') && !s[1])
+        code = ndarray_code(s[0], sizeof(long));
+    else if (s[0] && !s[1])
+        code = ndarray_code(s[0], 8);
+
+    Py_DECREF(name);
+    return code;
+}
+
+static void
+ndarray_set_uint64(mpz_t z, uint64_t v)
+{
+#if SIZEOF_LONG >= 8
+    mpz_set_ui(z, (unsigned long)v);
+#else
+    mpz_import(z, 1, -1, sizeof(uint64_t), 0, 0, &v);
+#endif
+}
+
+static void
+ndarray_set_int64(mpz_t z, int64_t v)
+{
+#if SIZEOF_LONG >= 8
+    mpz_set_si(z, (long)v);
+#else
+    if (v < 0) {
+        ndarray_set_uint64(z, 0 - (uint64_t)v);
+        mpz_neg(z, z);
+    }
+    else {
+        ndarray_set_uint64(z, (uint64_t)v);
+    }
+#endif
+}
+
+/* Return the absolute value of z; z must have at most 64 bits. */
+
+static uint64_t
+ndarray_get_mag(mpz_t z)
+{
+    uint64_t mag = mpz_getlimbn(z, 0);
+
+#if GMP_NUMB_BITS < 64
+    mag |= (uint64_t)mpz_getlimbn(z, 1) << GMP_NUMB_BITS;
+#endif
+    return mag;
+}
+
+/* Store z in *out as an integer of the given array type. Returns -1 and
+ * raises OverflowError if z is out of range.
+ */
+
+static int
+ndarray_store_mpz(mpz_t z, int code, char *out)
+{
+    size_t bits = mpz_sizeinbase(z, 2);
+    uint64_t mag;
+    int64_t s;
+
+    if (mpz_sgn(z) < 0 && code == NDARRAY_UINT64) {
+        OVERFLOW_ERROR("negative value cannot be stored in a uint64 array");
+        return -1;
+    }
+    if (bits > 64 || (code == NDARRAY_INT64 && bits == 64 &&
+                      !(mpz_sgn(z) < 0 && mpz_scan1(z, 0) == 63))) {
+        OVERFLOW_ERROR("value too large for to_ndarray() array type");
+        return -1;
+    }
+
+    mag = mpz_sgn(z) ? ndarray_get_mag(z) : 0;
+    if (code == NDARRAY_UINT64) {
+        memcpy(out, &mag, sizeof(uint64_t));
+    }
+    else {
+        s = mpz_sgn(z) < 0 ? (int64_t)(0 - mag) : (int64_t)mag;
+        memcpy(out, &s, sizeof(int64_t));
+    }
+    return 0;
+}
+
+/* Round f to a double or long double, updating the context flags. Returns
+ * -1 if a trapped exception was raised.
+ */
+
+static int
+ndarray_store_mpfr(mpfr_t f, int code, char *out, CTXT_Object *context)
+{
+    mpfr_rnd_t rnd = GET_MPFR_ROUND(context);
+    int inexact, overflow, underflow;
+
+    if (code == NDARRAY_FLOAT64) {
+        double d = mpfr_get_d(f, rnd);
+
+        inexact = !mpfr_nan_p(f) && mpfr_cmp_d(f, d) != 0;
+        overflow = mpfr_number_p(f) && Py_IS_INFINITY(d);
+        underflow = !mpfr_zero_p(f) && d == 0.0;
+        memcpy(out, &d, sizeof(double));
+    }
+    else {
+        long double d = mpfr_get_ld(f, rnd);
+
+        inexact = !mpfr_nan_p(f) && mpfr_cmp_ld(f, d) != 0;
+        overflow = mpfr_number_p(f) && (d - d != d - d);
+        underflow = !mpfr_zero_p(f) && d == 0.0L;
+        memcpy(out, &d, sizeof(long double));
+    }
+
+    if (inexact) {
+        GMPY_FLAGS(context)->inexact = 1;
+        if (context->ctx.traps & TRAP_INEXACT) {
+            GMPY_INEXACT("inexact result in to_ndarray()");
+            return -1;
+        }
+    }
+    if (overflow) {
+        GMPY_FLAGS(context)->overflow = 1;
+        if (context->ctx.traps & TRAP_OVERFLOW) {
+            GMPY_OVERFLOW("overflow in to_ndarray()");
+            return -1;
+        }
+    }
+    if (underflow) {
+        GMPY_FLAGS(context)->underflow = 1;
+        if (context->ctx.traps & TRAP_UNDERFLOW) {
+            GMPY_UNDERFLOW("underflow in to_ndarray()");
+            return -1;
+        }
+    }
+    return 0;
+}
+
+PyDoc_STRVAR(GMPy_doc_from_ndarray,
+"from_ndarray(arr) -> list\n\n"
+"Return a list with the items of the array arr, which must support\n"
+"the buffer protocol and be C-contiguous. int64 and uint64 arrays\n"
+"return mpz values. float64 and long double arrays return mpfr\n"
+"values with 53 and 64 (or the size of the long double mantissa)\n"
+"bits of precision, so the conversion is exact. A multidimensional\n"
+"array is flattened.");
+
+static PyObject *
+GMPy_MPANY_From_NDArray(PyObject *self, PyObject *other)
+{
+    PyObject *result = NULL, *item;
+    Py_buffer view;
+    Py_ssize_t i, n;
+    char *cp;
+    int code;
+    CTXT_Object *context = NULL;
+
+    CHECK_CONTEXT(context);
+
+    if (PyObject_GetBuffer(other, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) < 0)
+        return NULL;
+
+    if (!(code = ndarray_format_code(view.format, view.itemsize))) {
+        VALUE_ERROR("from_ndarray() requires an int64, uint64, float64 or long double array");
+        goto done;
+    }
+
+    n = view.len / view.itemsize;
+    if (!(result = PyList_New(n)))
+        goto done;
+
+    cp = (char*)view.buf;
+    for (i = 0; i < n; i++, cp += view.itemsize) {
+        if (code == NDARRAY_INT64 || code == NDARRAY_UINT64) {
+            if (!(item = (PyObject*)GMPy_MPZ_New(context)))
+                goto error;
+            if (code == NDARRAY_INT64) {
+                int64_t v;
+
+                memcpy(&v, cp, sizeof(int64_t));
+                ndarray_set_int64(MPZ(item), v);
+            }
+            else {
+                uint64_t v;
+
+                memcpy(&v, cp, sizeof(uint64_t));
+                ndarray_set_uint64(MPZ(item), v);
+            }
+        }
+        else if (code == NDARRAY_FLOAT64) {
+            double d;
+
+            if (!(item = (PyObject*)GMPy_MPFR_New(DBL_MANT_DIG, context)))
+                goto error;
+            memcpy(&d, cp, sizeof(double));
+            ((MPFR_Object*)item)->rc = mpfr_set_d(MPFR(item), d, MPFR_RNDN);
+        }
+        else {
+            long double d;
+
+            if (!(item = (PyObject*)GMPy_MPFR_New(LDBL_MANT_DIG, context)))
+                goto error;
+            memcpy(&d, cp, sizeof(long double));
+            ((MPFR_Object*)item)->rc = mpfr_set_ld(MPFR(item), d, MPFR_RNDN);
+        }
+        PyList_SET_ITEM(result, i, item);
+    }
+    goto done;
+
+  error:
+    Py_CLEAR(result);
+  done:
+    PyBuffer_Release(&view);
+    return result;
+}
+
+PyDoc_STRVAR(GMPy_doc_to_ndarray,
+"to_ndarray(seq, dtype) -> array\n\n"
+"Store the numbers in seq in a new array of the given dtype, which\n"
+"may be 'int64', 'uint64', 'float64' or 'longdouble' (or 'float128'\n"
+"where that is the long double type), or a numpy dtype. Integers\n"
+"out of range of an integer dtype raise OverflowError. Floating point\n"
+"values are rounded using the rounding mode of the current context and\n"
+"set its inexact, overflow and underflow flags, raising an exception if\n"
+"the flag is trapped. If numpy has been imported a numpy array is\n"
+"returned; otherwise a bytearray holding the items in native layout\n"
+"is returned.");
+
+static PyObject *
+GMPy_MPANY_To_NDArray(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *seq, *result = NULL, *numpy, **items, *temp;
+    Py_ssize_t i, n, itemsize;
+    char *cp;
+    int code;
+    CTXT_Object *context = NULL;
+    static const char *names[] = {NULL, "int64", "uint64", "float64", "longdouble"};
+
+    CHECK_CONTEXT(context);
+
+    if (nargs != 2) {
+        TYPE_ERROR("to_ndarray() requires 2 arguments");
+        return NULL;
+    }
+
+    if (!(code = ndarray_dtype_code(args[1]))) {
+        VALUE_ERROR("to_ndarray() requires dtype int64, uint64, float64 or longdouble");
+        return NULL;
+    }
+    itemsize = code == NDARRAY_LONGDOUBLE ? sizeof(long double) : 8;
+
+    if (!(seq = PySequence_Fast(args[0], "to_ndarray() requires a sequence")))
+        return NULL;
+    n = PySequence_Fast_GET_SIZE(seq);
+    items = PySequence_Fast_ITEMS(seq);
+
+    if (n > PY_SSIZE_T_MAX / itemsize) {
+        PyErr_NoMemory();
+        goto error;
+    }
+    if (!(result = PyByteArray_FromStringAndSize(NULL, n * itemsize)))
+        goto error;
+    cp = PyByteArray_AS_STRING(result);
+
+    for (i = 0; i < n; i++, cp += itemsize) {
+        if (code == NDARRAY_INT64 || code == NDARRAY_UINT64) {
+            if (CHECK_MPZANY(items[i])) {
+                if (ndarray_store_mpz(MPZ(items[i]), code, cp) < 0)
+                    goto error;
+            }
+            else {
+                if (!(temp = (PyObject*)GMPy_MPZ_From_Integer(items[i], context)))
+                    goto error;
+                if (ndarray_store_mpz(MPZ(temp), code, cp) < 0) {
+                    Py_DECREF(temp);
+                    goto error;
+                }
+                Py_DECREF(temp);
+            }
+        }
+        else if (code == NDARRAY_FLOAT64 && PyFloat_Check(items[i])) {
+            double d = PyFloat_AS_DOUBLE(items[i]);
+
+            memcpy(cp, &d, sizeof(double));
+        }
+        else if (MPFR_Check(items[i])) {
+            if (ndarray_store_mpfr(MPFR(items[i]), code, cp, context) < 0)
+                goto error;
+        }
+        else {
+            if (!(temp = (PyObject*)GMPy_MPFR_From_Real(items[i], 1, context)))
+                goto error;
+            if (ndarray_store_mpfr(MPFR(temp), code, cp, context) < 0) {
+                Py_DECREF(temp);
+                goto error;
+            }
+            Py_DECREF(temp);
+        }
+    }
+    Py_DECREF(seq);
+
+    /* Wrap the data without copying if numpy is already loaded. */
+    if ((numpy = PyDict_GetItemString(PyImport_GetModuleDict(), "numpy"))) {
+        temp = PyObject_CallMethod(numpy, "frombuffer", "Os", result, names[code]);
+        Py_DECREF(result);
+        return temp;
+    }
+    return result;
+
+  error:
+    Py_DECREF(seq);
+    Py_XDECREF(result);
+    return NULL;
+}
+GMPY_FASTCALL_WRAPPER(GMPy_MPANY_To_NDArray)
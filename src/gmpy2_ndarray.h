@@ -0,0 +1,49 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_ndarray.h                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GMPY_NDARRAY_H
+#define GMPY_NDARRAY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+static int        ndarray_code(char c, Py_ssize_t itemsize);
+static int        ndarray_format_code(const char *format, Py_ssize_t itemsize);
+static int        ndarray_dtype_code(PyObject *dtype);
+static void       ndarray_set_uint64(mpz_t z, uint64_t v);
+static void       ndarray_set_int64(mpz_t z, int64_t v);
+static uint64_t   ndarray_get_mag(mpz_t z);
+static int        ndarray_store_mpz(mpz_t z, int code, char *out);
+static int        ndarray_store_mpfr(mpfr_t f, int code, char *out, CTXT_Object *context);
+static PyObject * GMPy_MPANY_From_NDArray(PyObject *self, PyObject *other);
+static PyObject * GMPy_MPANY_To_NDArray(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,329 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_pcache.c                                                          *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* set_persistent_cache() names a directory where expensive results are
+ * kept for other processes: const_pi(), const_euler(), const_log2() and
+ * const_catalan(), fac(), primorial(), and the powers kept by
+ * set_radix_cache(). Each value is a file in the format of to_binary(),
+ * named after the function, its argument and the precision:
+ *
+ *   const_pi-<round>-<precision>.gmpy2
+ *   fac-<n>-0.gmpy2
+ *   radix-<base>-<i>.gmpy2
+ *
+ * A file is mapped with mmap() and decoded where it lies. New files are
+ * written under a temporary name and then renamed, so a process never
+ * reads a file that another process is still writing. A file that can't
+ * be read or written is ignored and the value is computed as usual.
+ *
+ * The cache is only used while the GIL is held.
+ */
+
+#ifdef GMPY_MMAP
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+static PyObject *pcache_dir = NULL;      /* bytes; NULL disables the cache */
+
+/* Return the path of the file for (name, arg, prec), to be freed with
+ * GMPY_FREE(), or NULL if out of memory.
+ */
+
+static char *
+pcache_path(const char *name, unsigned long arg, long prec)
+{
+    size_t size = (size_t)PyBytes_GET_SIZE(pcache_dir) + strlen(name) + 64;
+    char *path;
+
+    if ((path = GMPY_MALLOC(size)))
+        PyOS_snprintf(path, size, "%s/%s-%lu-%ld.gmpy2",
+                      PyBytes_AS_STRING(pcache_dir), name, arg, prec);
+    return path;
+}
+
+/* Map the file for (name, arg, prec) read-only and set *size. Returns NULL
+ * if there is no such file.
+ */
+
+static unsigned char *
+pcache_open(const char *name, unsigned long arg, long prec, size_t *size)
+{
+    struct stat st;
+    void *base = MAP_FAILED;
+    char *path;
+    int fd;
+
+    if (!(path = pcache_path(name, arg, prec)))
+        return NULL;
+    if ((fd = open(path, O_RDONLY)) >= 0) {
+        if (fstat(fd, &st) == 0 && st.st_size >= 2) {
+            *size = (size_t)st.st_size;
+            base = mmap(NULL, *size, PROT_READ, MAP_SHARED, fd, 0);
+        }
+        close(fd);
+    }
+    GMPY_FREE(path);
+    return base == MAP_FAILED ? NULL : (unsigned char*)base;
+}
+
+/* Write the file for (name, arg, prec). */
+
+static void
+pcache_write(const char *name, unsigned long arg, long prec,
+             const char *data, size_t size)
+{
+    char *path, *temp;
+    size_t len;
+    ssize_t n;
+    int fd;
+
+    if (!(path = pcache_path(name, arg, prec)))
+        return;
+    len = strlen(path) + 32;
+    if (!(temp = GMPY_MALLOC(len))) {
+        GMPY_FREE(path);
+        return;
+    }
+    PyOS_snprintf(temp, len, "%s.%ld.tmp", path, (long)getpid());
+
+    if ((fd = open(temp, O_WRONLY | O_CREAT | O_TRUNC, 0666)) >= 0) {
+        while (size > 0 && (n = write(fd, data, size)) > 0) {
+            data += n;
+            size -= (size_t)n;
+        }
+        if (close(fd) < 0 || size > 0 || rename(temp, path) < 0)
+            unlink(temp);
+    }
+    GMPY_FREE(temp);
+    GMPY_FREE(path);
+}
+
+/* Set r to the value kept for (name, arg, prec) and return 1, or return 0
+ * if there is none. bits is an estimate of the size of the value.
+ */
+
+static int
+pcache_load_mpz(mpz_t r, const char *name, unsigned long arg, long prec,
+                double bits)
+{
+    unsigned char *base;
+    size_t size;
+    int res = 0;
+
+    if (!pcache_dir || bits < PCACHE_MIN_BITS ||
+        !(base = pcache_open(name, arg, prec, &size)))
+        return 0;
+
+    /* Values this large never use the compact format. */
+    if (base[0] == 0x01 && (base[1] == 0x01 || base[1] == 0x02)) {
+        mpz_import(r, size - 2, -1, sizeof(char), 0, 0, base + 2);
+        if (base[1] == 0x02)
+            mpz_neg(r, r);
+        res = 1;
+    }
+    munmap(base, size);
+    return res;
+}
+
+static void
+pcache_store_mpz(mpz_t value, const char *name, unsigned long arg, long prec,
+                 double bits)
+{
+    char *buffer;
+    size_t size;
+
+    if (!pcache_dir || bits < PCACHE_MIN_BITS)
+        return;
+
+    size = GMPy_MPZ_Binary_Size(value, 0);
+    if (!(buffer = GMPY_MALLOC(size)))
+        return;
+    GMPy_MPZ_Binary_Write(buffer, value, 0x01, 0);
+    pcache_write(name, arg, prec, buffer, size);
+    GMPY_FREE(buffer);
+}
+
+/* Set result to the constant computed by func, using the rounding mode of
+ * the context, and return the ternary value. The constant is read from the
+ * cache when it was kept with the same precision and rounding mode.
+ */
+
+static int
+pcache_const(MPFR_Object *result, const char *name,
+             int (*func)(mpfr_ptr, mpfr_rnd_t), CTXT_Object *context)
+{
+    mpfr_prec_t prec = mpfr_get_prec(result->f);
+    mpfr_rnd_t rnd = GET_MPFR_ROUND(context);
+    PyObject *temp, *bytes;
+    unsigned char *base;
+    size_t size;
+    int rc;
+
+    if (!pcache_dir || prec < PCACHE_MIN_BITS)
+        return func(result->f, rnd);
+
+    if ((base = pcache_open(name, (unsigned long)rnd, (long)prec, &size))) {
+        temp = GMPy_MPANY_From_Binary_Data(base, (Py_ssize_t)size, context);
+        munmap(base, size);
+        if (temp && MPFR_Check(temp) && mpfr_get_prec(MPFR(temp)) == prec) {
+            mpfr_swap(result->f, MPFR(temp));
+            rc = ((MPFR_Object*)temp)->rc;
+            Py_DECREF(temp);
+            mpfr_clear_flags();
+            if (rc)
+                mpfr_set_inexflag();
+            return rc;
+        }
+        Py_XDECREF(temp);
+        PyErr_Clear();
+    }
+
+    result->rc = func(result->f, rnd);
+    if ((bytes = GMPy_MPFR_To_Binary(result))) {
+        pcache_write(name, (unsigned long)rnd, (long)prec,
+                     PyBytes_AS_STRING(bytes), (size_t)PyBytes_GET_SIZE(bytes));
+        Py_DECREF(bytes);
+    }
+    else {
+        PyErr_Clear();
+    }
+    return result->rc;
+}
+
+PyDoc_STRVAR(GMPy_doc_get_persistent_cache,
+"get_persistent_cache() -> str or None\n\n"
+"Return the directory of the persistent cache, or None if the cache\n"
+"is disabled.");
+
+static PyObject *
+GMPy_get_persistent_cache(PyObject *self, PyObject *args)
+{
+    if (!pcache_dir)
+        Py_RETURN_NONE;
+#ifdef PY3
+    return PyUnicode_DecodeFSDefaultAndSize(PyBytes_AS_STRING(pcache_dir),
+                                            PyBytes_GET_SIZE(pcache_dir));
+#else
+    Py_INCREF(pcache_dir);
+    return pcache_dir;
+#endif
+}
+
+PyDoc_STRVAR(GMPy_doc_set_persistent_cache,
+"set_persistent_cache(path)\n\n"
+"Keep the results of const_pi(), const_euler(), const_log2(),\n"
+"const_catalan(), fac(), primorial() and the radix powers of\n"
+"set_radix_cache() in files in the directory 'path', in the format\n"
+"of to_binary(). Later calls, in this or any other process using the\n"
+"same directory, map the file instead of computing the value. Only\n"
+"values of at least 131072 bits are kept. None (the default)\n"
+"disables the cache; the files are not removed.");
+
+static PyObject *
+GMPy_set_persistent_cache(PyObject *self, PyObject *other)
+{
+    PyObject *path = NULL;
+    struct stat st;
+
+    if (other != Py_None) {
+#ifdef PY3
+        if (!PyUnicode_FSConverter(other, &path))
+            return NULL;
+#else
+        if (!PyString_Check(other)) {
+            TYPE_ERROR("set_persistent_cache() requires a path or None");
+            return NULL;
+        }
+        path = other;
+        Py_INCREF(path);
+#endif
+        if (stat(PyBytes_AS_STRING(path), &st) < 0) {
+            PyErr_SetFromErrnoWithFilename(PyExc_OSError, PyBytes_AS_STRING(path));
+            Py_DECREF(path);
+            return NULL;
+        }
+        if (!S_ISDIR(st.st_mode)) {
+            VALUE_ERROR("set_persistent_cache() requires a directory");
+            Py_DECREF(path);
+            return NULL;
+        }
+    }
+
+    Py_XDECREF(pcache_dir);
+    pcache_dir = path;
+    Py_RETURN_NONE;
+}
+
+#else
+
+static int
+pcache_load_mpz(mpz_t r, const char *name, unsigned long arg, long prec,
+                double bits)
+{
+    return 0;
+}
+
+static void
+pcache_store_mpz(mpz_t value, const char *name, unsigned long arg, long prec,
+                 double bits)
+{
+}
+
+static int
+pcache_const(MPFR_Object *result, const char *name,
+             int (*func)(mpfr_ptr, mpfr_rnd_t), CTXT_Object *context)
+{
+    return func(result->f, GET_MPFR_ROUND(context));
+}
+
+PyDoc_STRVAR(GMPy_doc_get_persistent_cache,
+"get_persistent_cache() -> None\n\n"
+"Not supported on this platform.");
+
+static PyObject *
+GMPy_get_persistent_cache(PyObject *self, PyObject *args)
+{
+    Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(GMPy_doc_set_persistent_cache,
+"set_persistent_cache(path)\n\n"
+"Not supported on this platform.");
+
+static PyObject *
+GMPy_set_persistent_cache(PyObject *self, PyObject *other)
+{
+    if (other == Py_None)
+        Py_RETURN_NONE;
+    SYSTEM_ERROR("set_persistent_cache() is not supported on this platform");
+    return NULL;
+}
+
+#endif
@@ -0,0 +1,55 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_pcache.h                                                          *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GMPY_PCACHE_H
+#define GMPY_PCACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Values of at least PCACHE_MIN_BITS bits are kept in the directory given
+ * to set_persistent_cache(). Smaller values are cheaper to compute than to
+ * read from a file.
+ */
+
+#define PCACHE_MIN_BITS 131072
+
+static int        pcache_load_mpz(mpz_t r, const char *name, unsigned long arg,
+                                  long prec, double bits);
+static void       pcache_store_mpz(mpz_t value, const char *name,
+                                   unsigned long arg, long prec, double bits);
+static int        pcache_const(MPFR_Object *result, const char *name,
+                               int (*func)(mpfr_ptr, mpfr_rnd_t),
+                               CTXT_Object *context);
+static PyObject * GMPy_get_persistent_cache(PyObject *self, PyObject *args);
+static PyObject * GMPy_set_persistent_cache(PyObject *self, PyObject *other);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -127,11 +127,11 @@ PyDoc_STRVAR(GMPy_doc_context_plus,
 "Return +x, the context is applied to the result.");
 
 static PyObject *
-GMPy_Context_Plus(PyObject *self, PyObject *args)
+GMPy_Context_Plus(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     CTXT_Object *context = NULL;
 
-    if (PyTuple_GET_SIZE(args) != 1) {
+    if (nargs != 1) {
         TYPE_ERROR("plus() requires 1 argument.");
         return NULL;
     }
@@ -143,6 +143,7 @@ GMPy_Context_Plus(PyObject *self, PyObject *args)
         CHECK_CONTEXT(context);
     }
 
-    return GMPy_Number_Plus(PyTuple_GET_ITEM(args, 0), context);
+    return GMPy_Number_Plus(args[0], context);
 }
+GMPY_FASTCALL_WRAPPER(GMPy_Context_Plus)
 
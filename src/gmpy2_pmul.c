@@ -0,0 +1,370 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_pmul.c                                                            *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* The products are described by a tree that is built in preorder. Each
+ * leaf is one mpz_mul() of two operands that are usually read-only views
+ * of the limbs of the inputs, or of the sums made by Karatsuba steps. After
+ * the thread pool has computed the leaves, the tree is walked again in the
+ * same order to combine them.
+ */
+
+#define PMUL_LEAF 0
+#define PMUL_SPLIT 1                /* x1*y*B + x0*y */
+#define PMUL_KARA 2                 /* Karatsuba step on x and y */
+
+typedef struct {
+    int kind;
+    size_t h;                       /* split point, in limbs */
+} pmul_node;
+
+typedef struct {
+    __mpz_struct x, y;              /* operands, not owned by the leaf */
+    mpz_t r;                        /* product */
+} pmul_leaf;
+
+typedef struct {
+    pmul_node nodes[PMUL_MAX_NODES];
+    pmul_leaf leaves[PMUL_MAX_LEAVES];
+    mpz_t sums[2 * (PMUL_MAX_NODES - PMUL_MAX_LEAVES)];
+    int nnodes, nleaves, nsums;
+} pmul_state;
+
+/* Make v a read-only view of len limbs of x, starting at limb off. */
+
+static void
+pmul_view(mpz_ptr v, mpz_srcptr x, size_t off, size_t len)
+{
+    mp_limb_t *d = x->_mp_d + off;
+
+    while (len > 0 && d[len - 1] == 0)
+        len--;
+    v->_mp_d = d;
+    v->_mp_size = (int)len;
+    v->_mp_alloc = 0;
+}
+
+/* x and y are nonnegative. A square is recognized by x == y. */
+
+static void
+pmul_build(pmul_state *s, mpz_srcptr x, mpz_srcptr y, int depth)
+{
+    pmul_node *node = &s->nodes[s->nnodes++];
+    pmul_leaf *leaf;
+    __mpz_struct x0, x1, y0, y1;
+    mpz_srcptr temp;
+    mpz_ptr sx, sy;
+    size_t nx = mpz_size(x), ny = mpz_size(y), h;
+    int square = (x == y);
+
+    if (nx < ny) {
+        temp = x, x = y, y = temp;
+        h = nx, nx = ny, ny = h;
+    }
+
+    if (depth == 0 || ny < 2 * PMUL_LEAF_LIMBS) {
+        node->kind = PMUL_LEAF;
+        leaf = &s->leaves[s->nleaves++];
+        leaf->x = *x;
+        leaf->y = *y;
+        mpz_init(leaf->r);
+        return;
+    }
+
+    node->h = h = (nx + 1) / 2;
+    pmul_view(&x0, x, 0, h);
+    pmul_view(&x1, x, h, nx - h);
+
+    if (ny <= h) {
+        node->kind = PMUL_SPLIT;
+        pmul_build(s, &x0, y, depth - 1);
+        pmul_build(s, &x1, y, depth - 1);
+        return;
+    }
+
+    node->kind = PMUL_KARA;
+    sx = s->sums[s->nsums++];
+    mpz_init(sx);
+    mpz_add(sx, &x0, &x1);
+    if (square) {
+        pmul_build(s, &x0, &x0, depth - 1);
+        pmul_build(s, &x1, &x1, depth - 1);
+        pmul_build(s, sx, sx, depth - 1);
+        return;
+    }
+
+    pmul_view(&y0, y, 0, h);
+    pmul_view(&y1, y, h, ny - h);
+    sy = s->sums[s->nsums++];
+    mpz_init(sy);
+    mpz_add(sy, &y0, &y1);
+    pmul_build(s, &x0, &y0, depth - 1);
+    pmul_build(s, &x1, &y1, depth - 1);
+    pmul_build(s, sx, sy, depth - 1);
+}
+
+static void
+pmul_combine(pmul_state *s, mpz_ptr r, int *node, int *leaf)
+{
+    pmul_node *n = &s->nodes[(*node)++];
+    mp_bitcnt_t shift;
+    mpz_t t0, t1, t2;
+
+    if (n->kind == PMUL_LEAF) {
+        mpz_swap(r, s->leaves[(*leaf)++].r);
+        return;
+    }
+
+    shift = (mp_bitcnt_t)n->h * GMP_NUMB_BITS;
+    mpz_init(t0);
+    mpz_init(t1);
+    pmul_combine(s, t0, node, leaf);
+    pmul_combine(s, t1, node, leaf);
+    if (n->kind == PMUL_SPLIT) {
+        mpz_mul_2exp(r, t1, shift);
+        mpz_add(r, r, t0);
+    }
+    else {
+        /* (x0 + x1)*(y0 + y1) - x0*y0 - x1*y1 is the middle term. */
+        mpz_init(t2);
+        pmul_combine(s, t2, node, leaf);
+        mpz_sub(t2, t2, t0);
+        mpz_sub(t2, t2, t1);
+        mpz_mul_2exp(r, t1, shift);
+        mpz_add(r, r, t2);
+        mpz_mul_2exp(r, r, shift);
+        mpz_add(r, r, t0);
+        mpz_clear(t2);
+    }
+    mpz_clear(t0);
+    mpz_clear(t1);
+}
+
+static void
+pmul_run(void *arg, Py_ssize_t start, Py_ssize_t stop)
+{
+    pmul_leaf *leaves = (pmul_leaf*)arg;
+    Py_ssize_t i;
+
+    for (i = start; i < stop; i++)
+        mpz_mul(leaves[i].r, &leaves[i].x, &leaves[i].y);
+}
+
+/* Set r to x * y. Must be called with the GIL held. */
+
+static void
+pmul_mul(mpz_ptr r, mpz_srcptr x, mpz_srcptr y)
+{
+    pmul_state *s;
+    __mpz_struct ax, ay;
+    size_t cost[PMUL_MAX_LEAVES], total = 0;
+    int i, depth, sign, node = 0, leaf = 0;
+    mpz_t res;
+
+    if (tls_nogil ||
+        mpz_sizeinbase(x, 2) < tls_pmul_bits ||
+        mpz_sizeinbase(y, 2) < tls_pmul_bits ||
+        !(s = GMPY_MALLOC(sizeof(pmul_state)))) {
+        mpz_mul(r, x, y);
+        return;
+    }
+
+    /* A Karatsuba step makes three products of half the size, so 3**depth
+     * products should not exceed the number of threads. */
+    for (depth = 1, i = 9; i <= tls_pmul_threads && depth < PMUL_MAX_DEPTH; depth++)
+        i *= 3;
+
+    s->nnodes = s->nleaves = s->nsums = 0;
+    sign = mpz_sgn(x) * mpz_sgn(y);
+    pmul_view(&ax, x, 0, mpz_size(x));
+    if (x == y) {
+        pmul_build(s, &ax, &ax, depth);
+    }
+    else {
+        pmul_view(&ay, y, 0, mpz_size(y));
+        pmul_build(s, &ax, &ay, depth);
+    }
+
+    for (i = 0; i < s->nleaves; i++) {
+        cost[i] = mpz_sizeinbase(&s->leaves[i].x, 2) + mpz_sizeinbase(&s->leaves[i].y, 2);
+        total += cost[i];
+    }
+    GMPy_Pool_Run(pmul_run, s->leaves, s->nleaves, cost, total);
+
+    mpz_init(res);
+    GMPY_BEGIN_NOGIL(total);
+    pmul_combine(s, res, &node, &leaf);
+    GMPY_END_NOGIL;
+    if (sign < 0)
+        mpz_neg(res, res);
+    mpz_swap(r, res);
+    mpz_clear(res);
+
+    for (i = 0; i < s->nleaves; i++)
+        mpz_clear(s->leaves[i].r);
+    for (i = 0; i < s->nsums; i++)
+        mpz_clear(s->sums[i]);
+    GMPY_FREE(s);
+}
+
+PyDoc_STRVAR(GMPy_doc_parallel_mul,
+"parallel_mul(threads, crossover=None) -> parallel_mul manager\n\n"
+"Return a manager for use with the 'with' statement. While it is in\n"
+"effect, mpz multiplications and squarings in the current thread whose\n"
+"operands both have at least 'crossover' bits are split into smaller\n"
+"products that are computed on 'threads' threads. The thread pool is\n"
+"grown to 'threads' threads if it is smaller; see set_threads(). The\n"
+"default crossover is get_tuning()['pmul_crossover'].");
+
+static PyObject *
+GMPy_PMUL_Factory(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    PMUL_Object *result;
+    int threads;
+    Py_ssize_t crossover = (Py_ssize_t)global.pmul_crossover;
+    PyObject *crossover_obj = Py_None;
+    static char *kwlist[] = {"threads", "crossover", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "i|O", kwlist, &threads, &crossover_obj))
+        return NULL;
+
+    if (crossover_obj != Py_None) {
+        crossover = PyIntOrLong_AsSsize_t(crossover_obj);
+        if (crossover == -1 && PyErr_Occurred())
+            return NULL;
+    }
+
+    if (threads < 1 || threads > GMPY_POOL_MAX_THREADS) {
+        VALUE_ERROR("number of threads must be between 1 and 1024");
+        return NULL;
+    }
+    if (crossover <= 0) {
+        VALUE_ERROR("crossover must be greater than 0");
+        return NULL;
+    }
+
+    if (!(result = PyObject_New(PMUL_Object, &PMUL_Type)))
+        return NULL;
+    result->threads = threads;
+    result->crossover = (size_t)crossover;
+    result->active = 0;
+    return (PyObject*)result;
+}
+
+static void
+GMPy_PMUL_Dealloc(PMUL_Object *self)
+{
+    PyObject_Del(self);
+}
+
+static PyObject *
+GMPy_PMUL_Repr_Slot(PMUL_Object *self)
+{
+    return Py2or3String_FromFormat("parallel_mul(threads=%d, crossover=%zu)",
+                                   self->threads, self->crossover);
+}
+
+static PyObject *
+GMPy_PMUL_Enter(PyObject *self, PyObject *args)
+{
+    PMUL_Object *pmul = (PMUL_Object*)self;
+
+    if (pmul->active) {
+        RUNTIME_ERROR("parallel_mul is already in effect");
+        return NULL;
+    }
+
+    if (GMPy_Pool_Reserve(pmul->threads) < 0)
+        return NULL;
+
+    pmul->prev_threads = tls_pmul_threads;
+    pmul->prev_crossover = tls_pmul_bits;
+    pmul->active = 1;
+    tls_pmul_threads = pmul->threads;
+    tls_pmul_bits = pmul->crossover;
+
+    Py_INCREF(self);
+    return self;
+}
+
+static PyObject *
+GMPy_PMUL_Exit(PyObject *self, PyObject *args)
+{
+    PMUL_Object *pmul = (PMUL_Object*)self;
+
+    if (pmul->active) {
+        tls_pmul_threads = pmul->prev_threads;
+        tls_pmul_bits = pmul->prev_crossover;
+        pmul->active = 0;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyMethodDef GMPyPMUL_methods[] =
+{
+    { "__enter__", GMPy_PMUL_Enter, METH_NOARGS, NULL },
+    { "__exit__", GMPy_PMUL_Exit, METH_VARARGS, NULL },
+    { NULL, NULL, 1 }
+};
+
+static PyTypeObject PMUL_Type =
+{
+#ifdef PY3
+    PyVarObject_HEAD_INIT(0, 0)
+#else
+    PyObject_HEAD_INIT(0)
+        0,                                   /* ob_size          */
+#endif
+    "gmpy2 parallel_mul",                    /* tp_name          */
+    sizeof(PMUL_Object),                     /* tp_basicsize     */
+        0,                                   /* tp_itemsize      */
+    (destructor) GMPy_PMUL_Dealloc,          /* tp_dealloc       */
+        0,                                   /* tp_print         */
+        0,                                   /* tp_getattr       */
+        0,                                   /* tp_setattr       */
+        0,                                   /* tp_reserved      */
+    (reprfunc) GMPy_PMUL_Repr_Slot,          /* tp_repr          */
+        0,                                   /* tp_as_number     */
+        0,                                   /* tp_as_sequence   */
+        0,                                   /* tp_as_mapping    */
+        0,                                   /* tp_hash          */
+        0,                                   /* tp_call          */
+        0,                                   /* tp_str           */
+        0,                                   /* tp_getattro      */
+        0,                                   /* tp_setattro      */
+        0,                                   /* tp_as_buffer     */
+    Py_TPFLAGS_DEFAULT,                      /* tp_flags         */
+    "GMPY2 parallel multiplication manager", /* tp_doc           */
+        0,                                   /* tp_traverse      */
+        0,                                   /* tp_clear         */
+        0,                                   /* tp_richcompare   */
+        0,                                   /* tp_weaklistoffset*/
+        0,                                   /* tp_iter          */
+        0,                                   /* tp_iternext      */
+    GMPyPMUL_methods,                        /* tp_methods       */
+        0,                                   /* tp_members       */
+        0,                                   /* tp_getset        */
+};
@@ -0,0 +1,74 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_pmul.h                                                            *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GMPY_PMUL_H
+#define GMPY_PMUL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Multiplication of huge integers on the thread pool.
+ *
+ * While a parallel_mul() manager is in effect, GMPY_MPZ_MUL() splits the
+ * product of two integers whose smaller operand has at least crossover
+ * bits into independent sub-products: Karatsuba steps for balanced
+ * operands, and halves of the larger operand for unbalanced ones. The
+ * sub-products are computed by mpz_mul() on the thread pool and combined
+ * with shifts and additions. Splitting stops before there are more
+ * balanced sub-products than threads, or before an operand would have
+ * fewer than PMUL_LEAF_LIMBS limbs.
+ */
+
+typedef struct {
+    PyObject_HEAD
+    int threads;
+    size_t crossover;               /* in bits */
+    int prev_threads;               /* setting when __enter__ was called */
+    size_t prev_crossover;
+    int active;
+} PMUL_Object;
+
+static PyTypeObject PMUL_Type;
+
+#define PMUL_DEFAULT_CROSSOVER 10000000
+#define PMUL_LEAF_LIMBS 1024
+#define PMUL_MAX_DEPTH 4
+#define PMUL_MAX_NODES 121          /* 1 + 3 + ... + 3**PMUL_MAX_DEPTH */
+#define PMUL_MAX_LEAVES 81          /* 3**PMUL_MAX_DEPTH */
+
+#define GMPY_MPZ_MUL(r, x, y) \
+    (tls_pmul_threads ? pmul_mul(r, x, y) : mpz_mul(r, x, y))
+
+static void       pmul_mul(mpz_ptr r, mpz_srcptr x, mpz_srcptr y);
+
+static PyObject * GMPy_PMUL_Factory(PyObject *self, PyObject *args, PyObject *kwargs);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
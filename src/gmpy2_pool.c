@@ -0,0 +1,546 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_pool.c                                                            *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* Each thread taking part in a job has a queue of chunks, which are ranges
+ * of indices. A thread takes chunks from the front of its own queue and,
+ * once that is empty, steals from the back of the queue with the most
+ * chunks left. Chunks are large, so a single lock protects all queues.
+ *
+ * Workers wait on their own start lock, which GMPy_Pool_Run() releases to
+ * hand them a job. The last worker to finish releases pool.done. All
+ * worker threads run GMP code only and never hold the GIL; their
+ * allocation counters are added to alloc_stats by the calling thread.
+ *
+ * In GMPy_Pool_Run_Checked() the calling thread polls for cancellation
+ * after each of its chunks. If that stops the job, no more chunks are
+ * claimed and the job ends once the workers finish their current chunks.
+ */
+
+/* Run the indices in the calling thread. If 'check' is set, they are
+ * split into ranges of about global.pool_min_cost bits and the thread polls
+ * for cancellation after each. */
+
+static int
+pool_serial(gmpy_pool_func func, void *arg, Py_ssize_t n,
+            const size_t *cost, size_t total, int check)
+{
+    Py_ssize_t start, stop;
+    size_t bits;
+    int status = 0;
+
+    GMPY_BEGIN_NOGIL(total);
+    if (!check) {
+        func(arg, 0, n);
+    }
+    else {
+        for (start = 0; start < n && !status; start = stop) {
+            bits = 0;
+            for (stop = start; stop < n && bits < global.pool_min_cost; stop++)
+                bits += cost ? cost[stop] : total / (size_t)n + 1;
+            func(arg, start, stop);
+            status = GMPy_Cancel_Poll(stop, n);
+        }
+    }
+    GMPY_END_NOGIL;
+    return status ? -1 : 0;
+}
+
+#ifndef WITHOUT_THREADS
+
+#ifdef HAVE_FORK
+#  include <unistd.h>
+#endif
+
+typedef struct {
+    PyThread_type_lock start;     /* released to start a job */
+    int index;                    /* queue used by the worker */
+    int quit;                     /* set to stop the worker */
+    struct gmpy_nogil_stats stats;
+} gmpy_pool_worker;
+
+typedef struct {
+    Py_ssize_t lo, hi;            /* chunks lo to hi - 1 are unclaimed */
+} gmpy_pool_queue;
+
+static struct {
+    int threads;                  /* value set by set_threads() */
+    gmpy_pool_worker **workers;   /* threads - 1 workers */
+    PyThread_type_lock run;       /* held while a job runs or during resize */
+    PyThread_type_lock lock;      /* protects queues and pending */
+    PyThread_type_lock done;      /* released when pending reaches 0 */
+    gmpy_pool_func func;
+    void *arg;
+    Py_ssize_t *bounds;           /* chunk c is bounds[c] to bounds[c + 1] */
+    gmpy_pool_queue *queues;
+    int nqueues;
+    int pending;                  /* workers that have not finished */
+    int check;                    /* the caller polls for cancellation */
+    int cancelled;                /* set to stop claiming chunks */
+    Py_ssize_t n;                 /* number of indices */
+    Py_ssize_t finished;          /* indices done so far */
+    size_t total;                 /* total cost */
+    unsigned long owner;          /* thread running the job, or 0 */
+#ifdef HAVE_FORK
+    pid_t pid;                    /* process that started the workers */
+#endif
+} pool = { 1 };
+
+static int
+GMPy_Pool_Init(void)
+{
+    if (!(pool.run = PyThread_allocate_lock()) ||
+        !(pool.lock = PyThread_allocate_lock()) ||
+        !(pool.done = PyThread_allocate_lock()))
+        return -1;
+    PyThread_acquire_lock(pool.done, WAIT_LOCK);
+    return 0;
+}
+
+/* Claim the next chunk for queue 'self'. Returns 0 if no work is left. */
+
+static int
+pool_claim(int self, Py_ssize_t *chunk)
+{
+    gmpy_pool_queue *q = &pool.queues[self];
+    Py_ssize_t most = 0;
+    int i, victim = -1, found = 1;
+
+    PyThread_acquire_lock(pool.lock, WAIT_LOCK);
+    if (pool.cancelled) {
+        found = 0;
+    }
+    else if (q->lo < q->hi) {
+        *chunk = q->lo++;
+    }
+    else {
+        for (i = 0; i < pool.nqueues; i++) {
+            if (pool.queues[i].hi - pool.queues[i].lo > most) {
+                most = pool.queues[i].hi - pool.queues[i].lo;
+                victim = i;
+            }
+        }
+        if (victim >= 0)
+            *chunk = --(pool.queues[victim].hi);
+        else
+            found = 0;
+    }
+    PyThread_release_lock(pool.lock);
+    return found;
+}
+
+static void
+pool_work(int self)
+{
+    Py_ssize_t chunk, start, stop, finished;
+
+    while (pool_claim(self, &chunk)) {
+        start = pool.bounds[chunk];
+        stop = pool.bounds[chunk + 1];
+        pool.func(pool.arg, start, stop);
+
+        PyThread_acquire_lock(pool.lock, WAIT_LOCK);
+        finished = (pool.finished += stop - start);
+        PyThread_release_lock(pool.lock);
+
+        if (self == 0 && pool.check && GMPy_Cancel_Poll(finished, pool.n)) {
+            PyThread_acquire_lock(pool.lock, WAIT_LOCK);
+            pool.cancelled = 1;
+            PyThread_release_lock(pool.lock);
+        }
+    }
+}
+
+static void
+pool_worker_main(void *arg)
+{
+    gmpy_pool_worker *w = (gmpy_pool_worker*)arg;
+    int last;
+
+    tls_nogil = 1;
+    for (;;) {
+        PyThread_acquire_lock(w->start, WAIT_LOCK);
+        if (w->quit)
+            break;
+
+        pool_work(w->index);
+        w->stats = tls_alloc_stats;
+        memset(&tls_alloc_stats, 0, sizeof(struct gmpy_nogil_stats));
+
+        PyThread_acquire_lock(pool.lock, WAIT_LOCK);
+        last = (--pool.pending == 0);
+        PyThread_release_lock(pool.lock);
+        if (last)
+            PyThread_release_lock(pool.done);
+    }
+    PyThread_free_lock(w->start);
+    GMPY_FREE(w);
+}
+
+/* Split the indices into at most nchunks chunks of about equal cost and
+ * return the number of chunks. */
+
+static Py_ssize_t
+pool_split(Py_ssize_t *bounds, Py_ssize_t nchunks, Py_ssize_t n,
+           const size_t *cost, size_t total)
+{
+    Py_ssize_t i, c = 0;
+    size_t sum = 0, share = total / (size_t)nchunks;
+
+    bounds[0] = 0;
+    if (!cost) {
+        for (c = 1; c <= nchunks; c++)
+            bounds[c] = n * c / nchunks;
+        return nchunks;
+    }
+    for (i = 0; i < n - 1 && c < nchunks - 1; i++) {
+        sum += cost[i];
+        if (sum >= share * (size_t)(c + 1))
+            bounds[++c] = i + 1;
+    }
+    bounds[++c] = n;
+    return c;
+}
+
+/* Start or stop workers until there are 'threads' threads. Must be called
+ * with pool.run held. */
+
+static int
+pool_resize(int threads)
+{
+    gmpy_pool_worker **workers, *w;
+    int i;
+
+    for (i = threads - 1; i < pool.threads - 1; i++) {
+        pool.workers[i]->quit = 1;
+        PyThread_release_lock(pool.workers[i]->start);
+    }
+    if (threads <= pool.threads) {
+        pool.threads = threads;
+        return 0;
+    }
+
+    if (!(workers = GMPY_REALLOC(pool.workers, (threads - 1) * sizeof(gmpy_pool_worker*)))) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    pool.workers = workers;
+
+    for (i = pool.threads - 1; i < threads - 1; i++) {
+        if (!(w = GMPY_MALLOC(sizeof(gmpy_pool_worker)))) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        memset(w, 0, sizeof(gmpy_pool_worker));
+        w->index = i + 1;
+        if (!(w->start = PyThread_allocate_lock())) {
+            GMPY_FREE(w);
+            PyErr_NoMemory();
+            return -1;
+        }
+        PyThread_acquire_lock(w->start, WAIT_LOCK);
+        if ((unsigned long)PyThread_start_new_thread(pool_worker_main, w) == (unsigned long)-1) {
+            PyThread_free_lock(w->start);
+            GMPY_FREE(w);
+            RUNTIME_ERROR("cannot start a worker thread");
+            return -1;
+        }
+        pool.workers[i] = w;
+        pool.threads = i + 2;
+    }
+#ifdef HAVE_FORK
+    pool.pid = getpid();
+#endif
+    return 0;
+}
+
+/* The workers do not exist in a child process created by fork(), and the
+ * locks may have been held by other threads. Forget both. */
+
+static void
+pool_check_fork(void)
+{
+#ifdef HAVE_FORK
+    if (pool.threads > 1 && pool.pid != getpid()) {
+        pool.threads = 1;
+        pool.workers = NULL;
+        pool.run = pool.lock = pool.done = NULL;
+        if (GMPy_Pool_Init() < 0)
+            Py_FatalError("cannot allocate the locks of the thread pool");
+    }
+#endif
+}
+
+static int
+pool_run(gmpy_pool_func func, void *arg, Py_ssize_t n,
+         const size_t *cost, size_t total, int check, int limit)
+{
+    PyThreadState *save;
+    Py_ssize_t nchunks, *bounds = NULL;
+    gmpy_pool_queue *queues = NULL;
+    int i, threads, cancelled;
+
+    pool_check_fork();
+    if (n < 2 || pool.threads < 2 || limit == 1 || total < global.pool_min_cost ||
+        !global.nogil_bits || !PyThread_acquire_lock(pool.run, NOWAIT_LOCK))
+        goto serial;
+
+    threads = pool.threads;
+    if (limit && threads > limit)
+        threads = limit;
+    if (threads > n)
+        threads = (int)n;
+    nchunks = (Py_ssize_t)threads * GMPY_POOL_CHUNKS;
+    if (nchunks > n)
+        nchunks = n;
+
+    if (!(bounds = GMPY_MALLOC((nchunks + 1) * sizeof(Py_ssize_t))) ||
+        !(queues = GMPY_MALLOC(threads * sizeof(gmpy_pool_queue)))) {
+        if (bounds)
+            GMPY_FREE(bounds);
+        PyThread_release_lock(pool.run);
+        goto serial;
+    }
+
+    nchunks = pool_split(bounds, nchunks, n, cost, total);
+    for (i = 0; i < threads; i++) {
+        queues[i].lo = nchunks * i / threads;
+        queues[i].hi = nchunks * (i + 1) / threads;
+    }
+
+    pool.func = func;
+    pool.arg = arg;
+    pool.bounds = bounds;
+    pool.queues = queues;
+    pool.nqueues = threads;
+    pool.pending = threads - 1;
+    pool.check = check;
+    pool.cancelled = 0;
+    pool.n = n;
+    pool.finished = 0;
+    pool.total = total;
+    pool.owner = (unsigned long)PyThread_get_thread_ident();
+
+    nogil_count++;
+    tls_nogil = 1;
+    save = tls_nogil_save = PyEval_SaveThread();
+    for (i = 0; i < threads - 1; i++)
+        PyThread_release_lock(pool.workers[i]->start);
+    pool_work(0);
+    PyThread_acquire_lock(pool.done, WAIT_LOCK);
+    GMPy_NoGIL_End(save);
+
+    for (i = 0; i < threads - 1; i++)
+        GMPy_NoGIL_Merge(&pool.workers[i]->stats);
+
+    cancelled = pool.cancelled;
+    pool.bounds = NULL;
+    pool.queues = NULL;
+    pool.owner = 0;
+    GMPY_FREE(bounds);
+    GMPY_FREE(queues);
+    PyThread_release_lock(pool.run);
+    return cancelled ? -1 : 0;
+
+  serial:
+    return pool_serial(func, arg, n, cost, total, check);
+}
+
+static void
+GMPy_Pool_Run(gmpy_pool_func func, void *arg, Py_ssize_t n,
+              const size_t *cost, size_t total)
+{
+    (void)pool_run(func, arg, n, cost, total, 0, 0);
+}
+
+static int
+GMPy_Pool_Run_Checked(gmpy_pool_func func, void *arg, Py_ssize_t n,
+                      const size_t *cost, size_t total)
+{
+    return pool_run(func, arg, n, cost, total, 1, 0);
+}
+
+static int
+GMPy_Pool_Run_Threads(gmpy_pool_func func, void *arg, Py_ssize_t n,
+                      const size_t *cost, size_t total, int threads)
+{
+    return pool_run(func, arg, n, cost, total, 1, threads);
+}
+
+/* Acquire pool.run to change the number of threads. A progress callback
+ * called by the job that holds it must not wait for it. */
+
+static int
+pool_lock_run(void)
+{
+    if (pool.owner == (unsigned long)PyThread_get_thread_ident()) {
+        RUNTIME_ERROR("cannot change the number of threads while the pool is running");
+        return -1;
+    }
+    Py_BEGIN_ALLOW_THREADS
+    PyThread_acquire_lock(pool.run, WAIT_LOCK);
+    Py_END_ALLOW_THREADS
+    return 0;
+}
+
+/* Make sure that the pool has at least 'threads' threads. */
+
+static int
+GMPy_Pool_Reserve(int threads)
+{
+    int status = 0;
+
+    pool_check_fork();
+    if (pool.threads >= threads)
+        return 0;
+
+    if (pool_lock_run() < 0)
+        return -1;
+    if (pool.threads < threads)
+        status = pool_resize(threads);
+    PyThread_release_lock(pool.run);
+    return status;
+}
+
+#else
+
+static int
+GMPy_Pool_Init(void)
+{
+    return 0;
+}
+
+static int
+GMPy_Pool_Reserve(int threads)
+{
+    return 0;
+}
+
+static void
+GMPy_Pool_Run(gmpy_pool_func func, void *arg, Py_ssize_t n,
+              const size_t *cost, size_t total)
+{
+    func(arg, 0, n);
+}
+
+static int
+GMPy_Pool_Run_Checked(gmpy_pool_func func, void *arg, Py_ssize_t n,
+                      const size_t *cost, size_t total)
+{
+    return pool_serial(func, arg, n, cost, total, 1);
+}
+
+static int
+GMPy_Pool_Run_Threads(gmpy_pool_func func, void *arg, Py_ssize_t n,
+                      const size_t *cost, size_t total, int threads)
+{
+    return pool_serial(func, arg, n, cost, total, 1);
+}
+
+#endif
+
+static int
+GMPy_Pool_Threads_Arg(PyObject *obj)
+{
+    Py_ssize_t n;
+
+    if (!obj || obj == Py_None)
+        return 0;
+
+    n = PyIntOrLong_AsSsize_t(obj);
+    if (n == -1 && PyErr_Occurred()) {
+        TYPE_ERROR("threads must be an integer or None");
+        return -1;
+    }
+    if (n < 1 || n > GMPY_POOL_MAX_THREADS) {
+        VALUE_ERROR("number of threads must be between 1 and 1024");
+        return -1;
+    }
+#ifdef WITHOUT_THREADS
+    return 1;
+#else
+    if (GMPy_Pool_Reserve((int)n) < 0)
+        return -1;
+    return (int)n;
+#endif
+}
+
+PyDoc_STRVAR(GMPy_doc_get_threads,
+"get_threads() -> int\n\n"
+"Return the number of threads used by the batch functions. See\n"
+"set_threads().");
+
+static PyObject *
+GMPy_get_threads(PyObject *self, PyObject *args)
+{
+#ifdef WITHOUT_THREADS
+    return PyIntOrLong_FromLong(1);
+#else
+    pool_check_fork();
+    return PyIntOrLong_FromLong(pool.threads);
+#endif
+}
+
+PyDoc_STRVAR(GMPy_doc_set_threads,
+"set_threads(n)\n\n"
+"Use n threads, including the calling thread, in is_prime_many(),\n"
+"powmod_many(), and powmod_base_many(). The work is split into chunks\n"
+"of about the same operand size and each result is stored at its own\n"
+"index, so the results do not depend on n. The default is 1.");
+
+static PyObject *
+GMPy_set_threads(PyObject *self, PyObject *other)
+{
+    Py_ssize_t n;
+    int status = 0;
+
+    n = PyIntOrLong_AsSsize_t(other);
+    if (n == -1 && PyErr_Occurred()) {
+        TYPE_ERROR("set_threads() requires an integer argument");
+        return NULL;
+    }
+    if (n < 1 || n > GMPY_POOL_MAX_THREADS) {
+        VALUE_ERROR("number of threads must be between 1 and 1024");
+        return NULL;
+    }
+
+#ifdef WITHOUT_THREADS
+    if (n > 1) {
+        VALUE_ERROR("gmpy2 was built without thread support");
+        return NULL;
+    }
+#else
+    pool_check_fork();
+    if (pool_lock_run() < 0)
+        return NULL;
+    status = pool_resize((int)n);
+    PyThread_release_lock(pool.run);
+#endif
+
+    if (status < 0)
+        return NULL;
+    Py_RETURN_NONE;
+}
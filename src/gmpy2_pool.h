@@ -0,0 +1,83 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_pool.h                                                            *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GMPY_POOL_H
+#define GMPY_POOL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* A pool of native threads used by the batch functions. set_threads(n)
+ * starts n - 1 workers; the thread that calls GMPy_Pool_Run() is the n-th.
+ *
+ * GMPy_Pool_Run(func, arg, n, cost, total) calls func(arg, start, stop)
+ * for consecutive ranges of the indices 0 to n - 1, covering each index
+ * exactly once. The ranges are chunks of about the same cost: cost[i] is
+ * the work for index i, in bits, and total is the sum of the costs. cost
+ * may be NULL if all indices are equal. func is called without the GIL
+ * and from several threads at once, so the rules for code between
+ * GMPY_BEGIN_NOGIL and GMPY_END_NOGIL apply, and it must only write the
+ * results for its own indices. The work is done in the calling thread
+ * if the pool has one thread, if another call is using the pool, or if
+ * total is below global.pool_min_cost, which is GMPY_POOL_MIN_COST unless
+ * it is changed with set_tuning().
+ *
+ * GMPy_Pool_Run_Checked() is the same, but calls GMPy_Cancel_Poll() (see
+ * gmpy2_cancel.h) between chunks. It returns -1, with an exception set,
+ * if one of them stopped the job; some results are then missing.
+ * GMPy_Pool_Run_Threads() is GMPy_Pool_Run_Checked() using at most
+ * 'threads' threads, or all of them if threads is 0.
+ *
+ * GMPy_Pool_Threads_Arg() converts the threads= argument of a reduction:
+ * None gives 0, and n starts workers so the pool has at least n threads.
+ * It returns -1 with an exception set if the argument is invalid.
+ */
+
+typedef void (*gmpy_pool_func)(void *arg, Py_ssize_t start, Py_ssize_t stop);
+
+#define GMPY_POOL_MAX_THREADS 1024
+#define GMPY_POOL_MIN_COST 65536
+#define GMPY_POOL_CHUNKS 4          /* chunks per thread */
+
+static int        GMPy_Pool_Init(void);
+static int        GMPy_Pool_Reserve(int threads);
+static void       GMPy_Pool_Run(gmpy_pool_func func, void *arg, Py_ssize_t n,
+                                const size_t *cost, size_t total);
+static int        GMPy_Pool_Run_Checked(gmpy_pool_func func, void *arg, Py_ssize_t n,
+                                        const size_t *cost, size_t total);
+static int        GMPy_Pool_Run_Threads(gmpy_pool_func func, void *arg, Py_ssize_t n,
+                                        const size_t *cost, size_t total, int threads);
+static int        GMPy_Pool_Threads_Arg(PyObject *obj);
+
+static PyObject * GMPy_get_threads(PyObject *self, PyObject *args);
+static PyObject * GMPy_set_threads(PyObject *self, PyObject *other);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
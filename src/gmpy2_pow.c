@@ -26,7 +26,8 @@
  * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
 /* This file implements the ** operator, Python's pow() function,
- * gmpy2.powmod(), and context.pow().
+ * gmpy2.powmod(), gmpy2.powmod_many(), gmpy2.powmod_base_many(), and
+ * context.pow().
  *
  *
  * Public API
@@ -42,6 +43,8 @@
  *
  *   GMPy_Integer_Pow(Integer, Integer, Integer|Py_None, context|NULL)
  *   GMPy_Integer_PowMod(Integer, Integer, Integer|Py_None, context|NULL)
+ *   GMPy_Integer_PowModMany(bases, exps, Integer)
+ *   GMPy_Integer_PowModBaseMany(Integer, exps, Integer)
  *   GMPy_Rational_Pow(Rational, Rational, context|NULL)
  *   GMPy_Real_Pow(Real, Real, context|NULL)
  *   GMPy_Complex_Pow(Complex, Complex, context|NULL)
@@ -103,11 +106,15 @@ GMPy_Integer_Pow(PyObject *b, PyObject *e, PyObject *m, CTXT_Object *context)
         }
 
         el = mpz_get_ui(tempe->z);
+        if (GMPY_LIMB_CHECK(el * GMPy_Limb_Log2_MPZ(tempb->z), context)) {
+            goto err;
+        }
         mpz_pow_ui(result->z, tempb->z, el);
     }
     else {
         /* Modulo is present. */
         int sign;
+        size_t bits;
         mpz_t mm, base, exp;
 
         sign = mpz_sgn(tempm->z);
@@ -119,6 +126,12 @@ GMPy_Integer_Pow(PyObject *b, PyObject *e, PyObject *m, CTXT_Object *context)
         mpz_inoc(mm);
         mpz_abs(mm, tempm->z);
 
+        /* The running time depends on the sizes of both the modulus and
+         * the exponent. */
+        bits = mpz_sizeinbase(mm, 2);
+        if (mpz_sizeinbase(tempe->z, 2) < bits)
+            bits = mpz_sizeinbase(tempe->z, 2);
+
         /* A negative exponent is allowed if inverse exists. */
         if (mpz_sgn(tempe->z) < 0) {
             mpz_inoc(base);
@@ -135,12 +148,20 @@ GMPy_Integer_Pow(PyObject *b, PyObject *e, PyObject *m, CTXT_Object *context)
                 mpz_abs(exp, tempe->z);
             }
 
+            GMPY_PROBE_ENTRY("powmod", bits);
+            GMPY_BEGIN_NOGIL(bits);
             mpz_powm(result->z, base, exp, mm);
+            GMPY_END_NOGIL;
+            GMPY_PROBE_RETURN("powmod", bits);
             mpz_cloc(base);
             mpz_cloc(exp);
         }
         else {
+            GMPY_PROBE_ENTRY("powmod", bits);
+            GMPY_BEGIN_NOGIL(bits);
             mpz_powm(result->z, tempb->z, tempe->z, mm);
+            GMPY_END_NOGIL;
+            GMPY_PROBE_RETURN("powmod", bits);
         }
         mpz_cloc(mm);
 
@@ -297,7 +318,7 @@ GMPy_Real_Pow(PyObject *base, PyObject *exp, PyObject *mod, CTXT_Object *context
         mpc_result = (MPC_Object*)GMPy_Complex_Pow(base, exp, Py_None, context);
         if (!mpc_result || MPC_IS_NAN_P(mpc_result)) {
             Py_XDECREF((PyObject*)mpc_result);
-            context->ctx.invalid = 1;
+            GMPY_FLAGS(context)->invalid = 1;
             GMPY_INVALID("pow() invalid operation");
             goto err;
         }
@@ -400,19 +421,22 @@ PyDoc_STRVAR(GMPy_doc_integer_powmod,
 "Return (x**y) mod m. Same as the three argument version of Python's\n"
 "built-in pow(), but converts all three arguments to mpz.");
 
+GMPY_PROFILE_WRAP(PyObject *, GMPy_Integer_PowMod, (PyObject *self, PyObject *const *args, Py_ssize_t nargs),
+                  (self, args, nargs), gmpy_profile_bits_args(args, nargs))
+
 static PyObject *
-GMPy_Integer_PowMod(PyObject *self, PyObject *args)
+GMPy_Integer_PowMod_Impl(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     PyObject *x, *y, *m;
 
-    if (PyTuple_GET_SIZE(args) != 3) {
+    if (nargs != 3) {
         TYPE_ERROR("powmod() requires 3 arguments.");
         return NULL;
     }
 
-    x = PyTuple_GET_ITEM(args, 0);
-    y = PyTuple_GET_ITEM(args, 1);
-    m = PyTuple_GET_ITEM(args, 2);
+    x = args[0];
+    y = args[1];
+    m = args[2];
 
     if (IS_INTEGER(x) && IS_INTEGER(y) && IS_INTEGER(m))
         return GMPy_Integer_Pow(x, y, m, NULL);
@@ -420,20 +444,954 @@ GMPy_Integer_PowMod(PyObject *self, PyObject *args)
     TYPE_ERROR("powmod() argument types not supported");
     return NULL;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_Integer_PowMod)
+
+/* Support for powmod_many() and powmod_base_many(). The modulus is converted
+ * once and the whole batch is computed in one pass, with the GIL released
+ * if the total work reaches the nogil threshold.
+ *
+ * For a fixed base, b**(d * 16**i) mod m is tabulated for every 4-bit digit
+ * d of the exponents. Each exponent then costs one modular multiplication
+ * per nonzero digit instead of a full exponentiation.
+ */
+
+#define POWMOD_WINDOW 4
+#define POWMOD_DIGITS ((1 << POWMOD_WINDOW) - 1)
+#define POWMOD_TABLE_MIN 8
+#define POWMOD_TABLE_MAX_BYTES (16 * 1024 * 1024)
+
+/* Store abs(m) in mm and return the sign of m, or 0 after setting an
+ * exception. */
+
+static int
+powmod_modulus(PyObject *m, mpz_t mm, const char *name)
+{
+    MPZ_Object *tempm;
+    int sign;
+
+    if (!IS_INTEGER(m)) {
+        TYPE_ERROR(name);
+        return 0;
+    }
+    if (!(tempm = GMPy_MPZ_From_Integer(m, NULL)))
+        return 0;
+
+    sign = mpz_sgn(tempm->z);
+    if (sign == 0)
+        VALUE_ERROR("powmod() modulus cannot be 0");
+    else
+        mpz_abs(mm, tempm->z);
+    Py_DECREF((PyObject*)tempm);
+    return sign;
+}
+
+/* Python returns a result in the interval m < r <= 0 for a negative m. */
+
+#define POWMOD_ADJUST(r, mm, sign) \
+    if ((sign) < 0 && mpz_sgn(r)) mpz_sub(r, r, mm)
+
+/* Estimate of the work needed to compute b**e mod m, in bits. */
+
+static size_t
+powmod_bits(mpz_t e, mpz_t mm)
+{
+    size_t ebits = mpz_sizeinbase(e, 2), mbits = mpz_sizeinbase(mm, 2);
+
+    return ebits < mbits ? ebits : mbits;
+}
+
+static PyObject *
+powmod_result_list(Py_ssize_t n)
+{
+    PyObject *result;
+    MPZ_Object *temp;
+    Py_ssize_t i;
+
+    if (!(result = PyList_New(n)))
+        return NULL;
+    for (i = 0; i < n; i++) {
+        if (!(temp = GMPy_MPZ_New(NULL))) {
+            Py_DECREF(result);
+            return NULL;
+        }
+        PyList_SET_ITEM(result, i, (PyObject*)temp);
+    }
+    return result;
+}
+
+/* Fill table[i * digits + d - 1] with b**(d * 2**(window * i)) mod m for
+ * 0 <= i < nwin and 1 <= d <= digits, where digits = 2**window - 1. */
+
+static void
+powmod_table_init(mpz_t *table, size_t nwin, int window, mpz_t b, mpz_t mm)
+{
+    mpz_t *row;
+    size_t i;
+    int d, digits = (1 << window) - 1;
+
+    for (i = 0; i < nwin; i++) {
+        row = table + i * digits;
+        for (d = 0; d < digits; d++)
+            mpz_init(row[d]);
+
+        if (i == 0) {
+            mpz_mod(row[0], b, mm);
+        }
+        else {
+            mpz_mul(row[0], row[-1], row[-digits]);
+            mpz_tdiv_r(row[0], row[0], mm);
+        }
+        for (d = 1; d < digits; d++) {
+            mpz_mul(row[d], row[d - 1], row[0]);
+            mpz_tdiv_r(row[d], row[d], mm);
+        }
+    }
+}
+
+static void
+powmod_table_clear(mpz_t *table, size_t nwin, int window)
+{
+    size_t i;
+
+    for (i = 0; i < nwin * ((1 << window) - 1); i++)
+        mpz_clear(table[i]);
+}
+
+/* Return the window bits of abs(e) starting at bit. */
+
+static mp_limb_t
+powmod_digit(mpz_t e, size_t bit, int window)
+{
+    size_t off = bit % GMP_NUMB_BITS;
+    mp_limb_t digit;
+
+    digit = mpz_getlimbn(e, bit / GMP_NUMB_BITS) >> off;
+    if (off + window > GMP_NUMB_BITS)
+        digit |= mpz_getlimbn(e, bit / GMP_NUMB_BITS + 1) << (GMP_NUMB_BITS - off);
+    return digit & (((mp_limb_t)1 << window) - 1);
+}
+
+/* Compute r = b**e mod m for a nonnegative e using a table. e must not have
+ * more than nwin * window bits. */
+
+static void
+powmod_table_eval(mpz_t r, mpz_t *table, int window, mpz_t e, mpz_t mm)
+{
+    size_t i, nwin;
+    mp_limb_t digit;
+    int started = 0, digits = (1 << window) - 1;
+
+    nwin = (mpz_sizeinbase(e, 2) + window - 1) / window;
+    for (i = 0; i < nwin; i++) {
+        digit = powmod_digit(e, i * window, window);
+        if (!digit)
+            continue;
+        if (!started) {
+            mpz_set(r, table[i * digits + digit - 1]);
+            started = 1;
+        }
+        else {
+            mpz_mul(r, r, table[i * digits + digit - 1]);
+            mpz_tdiv_r(r, r, mm);
+        }
+    }
+    if (!started) {
+        mpz_set_ui(r, 1);
+        mpz_tdiv_r(r, r, mm);
+    }
+}
+
+/* Shared by powmod_many() and powmod_base_many(); the thread pool calls
+ * powmod_many_run() for the results start to stop - 1. If bases is NULL,
+ * the base is b, or inv for a negative exponent, and table is used if it
+ * is not NULL. */
+
+typedef struct {
+    PyObject *result;
+    MPZ_Object **bases;
+    MPZ_Object **exps;
+    mpz_ptr b, inv, mm;
+    mpz_t *table;
+    int sign;
+    int invalid;
+} powmod_many_job;
+
+static void
+powmod_many_run(void *arg, Py_ssize_t start, Py_ssize_t stop)
+{
+    powmod_many_job *job = (powmod_many_job*)arg;
+    Py_ssize_t i;
+    mpz_t inv, absexp;
+    mpz_ptr r;
+
+    mpz_init(inv);
+    mpz_init(absexp);
+    for (i = start; i < stop; i++) {
+        r = MPZ(PyList_GET_ITEM(job->result, i));
+        if (mpz_sgn(job->exps[i]->z) < 0) {
+            if (!job->bases) {
+                mpz_set(inv, job->inv);
+            }
+            else if (!mpz_invert(inv, job->bases[i]->z, job->mm)) {
+                job->invalid = 1;
+                break;
+            }
+            mpz_abs(absexp, job->exps[i]->z);
+            mpz_powm(r, inv, absexp, job->mm);
+        }
+        else if (job->bases) {
+            mpz_powm(r, job->bases[i]->z, job->exps[i]->z, job->mm);
+        }
+        else if (job->table) {
+            powmod_table_eval(r, job->table, POWMOD_WINDOW, job->exps[i]->z, job->mm);
+        }
+        else {
+            mpz_powm(r, job->b, job->exps[i]->z, job->mm);
+        }
+        POWMOD_ADJUST(r, job->mm, job->sign);
+    }
+    mpz_clear(inv);
+    mpz_clear(absexp);
+}
+
+/* Return the estimated work for each exponent, or NULL after setting an
+ * exception. The sum is stored in *bits. */
+
+static size_t *
+powmod_many_cost(MPZ_Object **exps, Py_ssize_t n, mpz_t mm, size_t *bits)
+{
+    size_t *cost;
+    Py_ssize_t i;
+
+    if (!(cost = GMPY_MALLOC((n ? n : 1) * sizeof(size_t)))) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+    *bits = 0;
+    for (i = 0; i < n; i++) {
+        cost[i] = powmod_bits(exps[i]->z, mm);
+        *bits += cost[i];
+    }
+    return cost;
+}
+
+PyDoc_STRVAR(GMPy_doc_integer_powmod_many,
+"powmod_many(bases, exps, m) -> list\n\n"
+"Return a list of (b**e) mod m for each pair b, e taken from the\n"
+"sequences bases and exps, which must have the same length. Faster\n"
+"than calling powmod() for each pair.");
+
+static PyObject *
+GMPy_Integer_PowModMany(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *result = NULL;
+    MPZ_Object **bases = NULL, **exps = NULL;
+    Py_ssize_t nbases = 0, nexps = 0;
+    size_t bits = 0, *cost = NULL;
+    int sign;
+    mpz_t mm;
+    powmod_many_job job;
+
+    if (nargs != 3) {
+        TYPE_ERROR("powmod_many() requires 3 arguments");
+        return NULL;
+    }
+
+    mpz_init(mm);
+    if (!(sign = powmod_modulus(args[2], mm,
+                                "powmod_many() modulus must be an integer")))
+        goto done;
+
+    if (!(bases = GMPy_MPZ_Array_From_Iterable(args[0], &nbases,
+                                               "powmod_many() requires sequences of integers", NULL)) ||
+        !(exps = GMPy_MPZ_Array_From_Iterable(args[1], &nexps,
+                                              "powmod_many() requires sequences of integers", NULL)))
+        goto done;
+
+    if (nbases != nexps) {
+        VALUE_ERROR("powmod_many() requires sequences of the same length");
+        goto done;
+    }
+
+    if (!(result = powmod_result_list(nbases)) ||
+        !(cost = powmod_many_cost(exps, nexps, mm, &bits))) {
+        Py_CLEAR(result);
+        goto done;
+    }
+
+    memset(&job, 0, sizeof(job));
+    job.result = result;
+    job.bases = bases;
+    job.exps = exps;
+    job.mm = mm;
+    job.sign = sign;
+    if (GMPy_Pool_Run_Checked(powmod_many_run, &job, nbases, cost, bits) < 0) {
+        Py_CLEAR(result);
+    }
+    else if (job.invalid) {
+        VALUE_ERROR("powmod_many() base not invertible");
+        Py_CLEAR(result);
+    }
+
+  done:
+    if (cost)
+        GMPY_FREE(cost);
+    if (bases)
+        GMPy_MPZ_Array_Free(bases, nbases);
+    if (exps)
+        GMPy_MPZ_Array_Free(exps, nexps);
+    mpz_clear(mm);
+    return result;
+}
+GMPY_FASTCALL_WRAPPER(GMPy_Integer_PowModMany)
+
+PyDoc_STRVAR(GMPy_doc_integer_powmod_base_many,
+"powmod_base_many(b, exps, m) -> list\n\n"
+"Return a list of (b**e) mod m for each e in the sequence exps. For a\n"
+"large number of exponents, the powers of b are precomputed once and\n"
+"shared by all the exponents.");
+
+static PyObject *
+GMPy_Integer_PowModBaseMany(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *result = NULL;
+    MPZ_Object *tempb = NULL, **exps = NULL;
+    Py_ssize_t i, nexps = 0, count = 0;
+    size_t bits = 0, ebits, maxbits = 0, nwin = 0, *cost = NULL;
+    int sign, negative = 0;
+    mpz_t mm, inv, *table = NULL;
+    powmod_many_job job;
+
+    if (nargs != 3) {
+        TYPE_ERROR("powmod_base_many() requires 3 arguments");
+        return NULL;
+    }
+
+    mpz_init(mm);
+    mpz_init(inv);
+    if (!(sign = powmod_modulus(args[2], mm,
+                                "powmod_base_many() modulus must be an integer")))
+        goto done;
+
+    if (!IS_INTEGER(args[0])) {
+        TYPE_ERROR("powmod_base_many() base must be an integer");
+        goto done;
+    }
+    if (!(tempb = GMPy_MPZ_From_Integer(args[0], NULL)) ||
+        !(exps = GMPy_MPZ_Array_From_Iterable(args[1], &nexps,
+                                              "powmod_base_many() requires a sequence of integers", NULL)))
+        goto done;
+
+    if (!(cost = powmod_many_cost(exps, nexps, mm, &bits)))
+        goto done;
+
+    for (i = 0; i < nexps; i++) {
+        if (mpz_sgn(exps[i]->z) < 0) {
+            negative = 1;
+        }
+        else {
+            count++;
+            ebits = mpz_sizeinbase(exps[i]->z, 2);
+            if (ebits > maxbits)
+                maxbits = ebits;
+        }
+    }
+
+    if (negative && !mpz_invert(inv, tempb->z, mm)) {
+        VALUE_ERROR("powmod_base_many() base not invertible");
+        goto done;
+    }
+
+    /* Only build a table if it is shared by enough exponents. */
+    if (count >= POWMOD_TABLE_MIN) {
+        nwin = (maxbits + POWMOD_WINDOW - 1) / POWMOD_WINDOW;
+        if (nwin * POWMOD_DIGITS * (mpz_size(mm) + 1) * sizeof(mp_limb_t) > POWMOD_TABLE_MAX_BYTES ||
+            !(table = GMPY_MALLOC(nwin * POWMOD_DIGITS * sizeof(mpz_t))))
+            nwin = 0;
+    }
+
+    if (!(result = powmod_result_list(nexps)))
+        goto done;
+
+    if (table) {
+        GMPY_BEGIN_NOGIL(bits);
+        powmod_table_init(table, nwin, POWMOD_WINDOW, tempb->z, mm);
+        GMPY_END_NOGIL;
+    }
+
+    memset(&job, 0, sizeof(job));
+    job.result = result;
+    job.exps = exps;
+    job.b = tempb->z;
+    job.inv = inv;
+    job.mm = mm;
+    job.table = table;
+    job.sign = sign;
+    if (GMPy_Pool_Run_Checked(powmod_many_run, &job, nexps, cost, bits) < 0)
+        Py_CLEAR(result);
+
+    if (table)
+        powmod_table_clear(table, nwin, POWMOD_WINDOW);
+
+  done:
+    if (cost)
+        GMPY_FREE(cost);
+    if (table)
+        GMPY_FREE(table);
+    Py_XDECREF((PyObject*)tempb);
+    if (exps)
+        GMPy_MPZ_Array_Free(exps, nexps);
+    mpz_clear(inv);
+    mpz_clear(mm);
+    return result;
+}
+GMPY_FASTCALL_WRAPPER(GMPy_Integer_PowModBaseMany)
+
+/* Straus' simultaneous exponentiation: every base gets a table of its
+ * first 2**window - 1 powers and the exponents are scanned together, one
+ * window at a time from the top, so the squarings are shared by all the
+ * pairs.
+ */
+
+static int
+powmod_prod_window(size_t ebits)
+{
+    if (ebits <= 24)
+        return 1;
+    if (ebits <= 80)
+        return 2;
+    if (ebits <= 240)
+        return 3;
+    if (ebits <= 768)
+        return 4;
+    return 5;
+}
+
+/* Compute r = prod(bases[j]**exps[j]) mod m for nonnegative exponents of
+ * at most ebits bits. table must have room for n * (2**window - 1) values. */
+
+static void
+powmod_prod_eval(mpz_t r, mpz_t *table, int window, size_t ebits,
+                 MPZ_Object **bases, MPZ_Object **exps, Py_ssize_t n, mpz_t mm)
+{
+    size_t i, nwin;
+    Py_ssize_t j;
+    mp_limb_t digit;
+    int k, digits = (1 << window) - 1, started = 0;
+
+    nwin = (ebits + window - 1) / window;
+
+    for (j = 0; j < n; j++) {
+        mpz_mod(table[j * digits], bases[j]->z, mm);
+        for (k = 1; k < digits; k++) {
+            mpz_mul(table[j * digits + k], table[j * digits + k - 1], table[j * digits]);
+            mpz_tdiv_r(table[j * digits + k], table[j * digits + k], mm);
+        }
+    }
+
+    for (i = nwin; i-- > 0; ) {
+        if (started) {
+            for (k = 0; k < window; k++) {
+                mpz_mul(r, r, r);
+                mpz_tdiv_r(r, r, mm);
+            }
+        }
+        for (j = 0; j < n; j++) {
+            if (!(digit = powmod_digit(exps[j]->z, i * window, window)))
+                continue;
+            if (!started) {
+                mpz_set(r, table[j * digits + digit - 1]);
+                started = 1;
+            }
+            else {
+                mpz_mul(r, r, table[j * digits + digit - 1]);
+                mpz_tdiv_r(r, r, mm);
+            }
+        }
+    }
+    if (!started) {
+        mpz_set_ui(r, 1);
+        mpz_tdiv_r(r, r, mm);
+    }
+}
+
+/* For an odd modulus of at most MONT_MAX_LIMBS limbs, the pass is done in
+ * Montgomery form like mpz_powm; see gmpy2_mont.c. Larger moduli use
+ * mpz_tdiv_r.
+ */
+
+/* Same as powmod_prod_eval() for an odd m. limbs must have room for
+ * (n * (2**window - 1) + 3) * mpz_size(mm) limbs. */
+
+static void
+powmod_prod_redc(mpz_t r, mp_ptr limbs, int window, size_t ebits,
+                 MPZ_Object **bases, MPZ_Object **exps, Py_ssize_t n, mpz_t mm)
+{
+    mp_size_t nl = mpz_size(mm);
+    mp_limb_t digit;
+    mp_ptr entry, acc;
+    gmpy_mont M;
+    size_t i, nwin;
+    Py_ssize_t j;
+    int k, digits = (1 << window) - 1, started = 0;
+
+    acc = limbs + n * digits * nl;
+    mont_init(&M, mm, acc + nl);
+    nwin = (ebits + window - 1) / window;
+
+    for (j = 0; j < n; j++) {
+        entry = limbs + j * digits * nl;
+        mont_from_mpz(&M, entry, bases[j]->z, r);
+        for (k = 1; k < digits; k++)
+            mont_mul(&M, entry + k * nl, entry + (k - 1) * nl, entry);
+    }
+
+    for (i = nwin; i-- > 0; ) {
+        if (started) {
+            for (k = 0; k < window; k++)
+                mont_mul(&M, acc, acc, acc);
+        }
+        for (j = 0; j < n; j++) {
+            if (!(digit = powmod_digit(exps[j]->z, i * window, window)))
+                continue;
+            entry = limbs + (j * digits + digit - 1) * nl;
+            if (!started) {
+                mont_copy(&M, acc, entry);
+                started = 1;
+            }
+            else {
+                mont_mul(&M, acc, acc, entry);
+            }
+        }
+    }
+    if (!started) {
+        mpz_set_ui(r, 1);
+        mpz_tdiv_r(r, r, mm);
+        return;
+    }
+    mont_to_mpz(&M, r, acc);
+}
+
+PyDoc_STRVAR(GMPy_doc_integer_powmod_prod,
+"powmod_prod(pairs, m) -> mpz\n\n"
+"Return the product of (b**e) mod m for each pair (b, e) in pairs. The\n"
+"squarings are shared by all the pairs, so this is faster than\n"
+"multiplying the results of powmod().");
+
+static PyObject *
+GMPy_Integer_PowModProd(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    MPZ_Object *result = NULL, **bases = NULL, **exps = NULL;
+    PyObject *seq = NULL, *pair;
+    Py_ssize_t i, n = 0, done_bases = 0, done_exps = 0;
+    size_t bits = 0, ebits = 0;
+    mpz_t mm, *table = NULL;
+    mp_ptr limbs;
+    int sign, window, digits;
+
+    if (nargs != 2) {
+        TYPE_ERROR("powmod_prod() requires 2 arguments");
+        return NULL;
+    }
+
+    mpz_init(mm);
+    if (!(sign = powmod_modulus(args[1], mm,
+                                "powmod_prod() modulus must be an integer")))
+        goto done;
+
+    if (!(seq = PySequence_Fast(args[0],
+                                "powmod_prod() requires a sequence of (base, exponent) pairs")))
+        goto done;
+    n = PySequence_Fast_GET_SIZE(seq);
+
+    if (!(bases = GMPY_MALLOC((n + 1) * sizeof(MPZ_Object*))) ||
+        !(exps = GMPY_MALLOC((n + 1) * sizeof(MPZ_Object*)))) {
+        PyErr_NoMemory();
+        goto done;
+    }
+
+    for (i = 0; i < n; i++) {
+        pair = PySequence_Fast_GET_ITEM(seq, i);
+        if (!PyTuple_Check(pair) || PyTuple_GET_SIZE(pair) != 2 ||
+            !IS_INTEGER(PyTuple_GET_ITEM(pair, 0)) ||
+            !IS_INTEGER(PyTuple_GET_ITEM(pair, 1))) {
+            TYPE_ERROR("powmod_prod() requires a sequence of (base, exponent) pairs");
+            goto done;
+        }
+        if (!(bases[i] = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(pair, 0), NULL)))
+            goto done;
+        done_bases++;
+        if (!(exps[i] = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(pair, 1), NULL)))
+            goto done;
+        done_exps++;
+    }
+
+    /* A negative exponent is applied to the inverse of the base. The
+     * converted values may be shared, so they are replaced by new ones. */
+
+    for (i = 0; i < n; i++) {
+        if (mpz_sgn(exps[i]->z) < 0) {
+            MPZ_Object *inv, *absexp;
+
+            if (!(inv = GMPy_MPZ_New(NULL)))
+                goto done;
+            if (!mpz_invert(inv->z, bases[i]->z, mm)) {
+                VALUE_ERROR("powmod_prod() base not invertible");
+                Py_DECREF((PyObject*)inv);
+                goto done;
+            }
+            if (!(absexp = GMPy_MPZ_New(NULL))) {
+                Py_DECREF((PyObject*)inv);
+                goto done;
+            }
+            mpz_neg(absexp->z, exps[i]->z);
+            Py_DECREF((PyObject*)bases[i]);
+            bases[i] = inv;
+            Py_DECREF((PyObject*)exps[i]);
+            exps[i] = absexp;
+        }
+        bits += powmod_bits(exps[i]->z, mm);
+        if (mpz_sizeinbase(exps[i]->z, 2) > ebits)
+            ebits = mpz_sizeinbase(exps[i]->z, 2);
+    }
+
+    if (!(result = GMPy_MPZ_New(NULL)))
+        goto done;
+
+    if (n == 1) {
+        GMPY_BEGIN_NOGIL(bits);
+        mpz_powm(result->z, bases[0]->z, exps[0]->z, mm);
+        GMPY_END_NOGIL;
+    }
+    else {
+        window = powmod_prod_window(ebits);
+        digits = (1 << window) - 1;
+        if (mpz_odd_p(mm) && mpz_size(mm) <= MONT_MAX_LIMBS) {
+            if (!(limbs = GMPY_MALLOC((n * digits + 3) * mpz_size(mm) * sizeof(mp_limb_t)))) {
+                PyErr_NoMemory();
+                Py_CLEAR(result);
+                goto done;
+            }
+            GMPY_BEGIN_NOGIL(bits);
+            powmod_prod_redc(result->z, limbs, window, ebits, bases, exps, n, mm);
+            GMPY_END_NOGIL;
+            GMPY_FREE(limbs);
+        }
+        else {
+            if (!(table = GMPY_MALLOC((n * digits + 1) * sizeof(mpz_t)))) {
+                PyErr_NoMemory();
+                Py_CLEAR(result);
+                goto done;
+            }
+            GMPY_BEGIN_NOGIL(bits);
+            for (i = 0; i < n * digits; i++)
+                mpz_init(table[i]);
+            powmod_prod_eval(result->z, table, window, ebits, bases, exps, n, mm);
+            for (i = 0; i < n * digits; i++)
+                mpz_clear(table[i]);
+            GMPY_END_NOGIL;
+            GMPY_FREE(table);
+        }
+    }
+    POWMOD_ADJUST(result->z, mm, sign);
+
+  done:
+    for (i = 0; i < done_bases; i++)
+        Py_DECREF((PyObject*)bases[i]);
+    for (i = 0; i < done_exps; i++)
+        Py_DECREF((PyObject*)exps[i]);
+    if (bases)
+        GMPY_FREE(bases);
+    if (exps)
+        GMPY_FREE(exps);
+    Py_XDECREF(seq);
+    mpz_clear(mm);
+    return (PyObject*)result;
+}
+GMPY_FASTCALL_WRAPPER(GMPy_Integer_PowModProd)
+
+/* A PowmodTable stores the powers b**(d * 2**(window * i)) mod m used by
+ * powmod_table_eval(). Each exponent of up to max_exp_bits bits then costs
+ * at most max_exp_bits / window modular multiplications and no squarings.
+ * The widest window from 4 to POWMOD_TABLE_MAX_WINDOW bits whose table
+ * fits in POWMOD_TABLE_BYTES is used.
+ */
+
+#define POWMOD_TABLE_MAX_WINDOW 8
+#define POWMOD_TABLE_BYTES (4 * 1024 * 1024)
+
+PyDoc_STRVAR(GMPy_doc_powmod_table_factory,
+"PowmodTable(b, m, max_exp_bits) -> PowmodTable\n\n"
+"Return an object that computes powmod(b, e, m) for many exponents e\n"
+"using a table of powers of b. Exponents with up to max_exp_bits bits\n"
+"only need about max_exp_bits / 4 (or fewer) modular multiplications;\n"
+"larger and negative exponents use powmod().");
+
+static PyObject *
+GMPy_PowmodTable_Factory(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    PowmodTable_Object *result;
+    MPZ_Object *tempb;
+    mpz_t mm;
+    Py_ssize_t maxbits;
+    size_t nwin, bytes;
+    int sign, window;
+
+    if (nargs != 3) {
+        TYPE_ERROR("PowmodTable() requires 3 arguments");
+        return NULL;
+    }
+
+    mpz_init(mm);
+    if (!(sign = powmod_modulus(args[1], mm,
+                                "PowmodTable() modulus must be an integer"))) {
+        mpz_clear(mm);
+        return NULL;
+    }
+    maxbits = ssize_t_From_Integer(args[2]);
+    if (maxbits == -1 && PyErr_Occurred()) {
+        mpz_clear(mm);
+        return NULL;
+    }
+    if (maxbits <= 0) {
+        VALUE_ERROR("PowmodTable() max_exp_bits must be > 0");
+        mpz_clear(mm);
+        return NULL;
+    }
+    if (!IS_INTEGER(args[0])) {
+        TYPE_ERROR("PowmodTable() base must be an integer");
+        mpz_clear(mm);
+        return NULL;
+    }
+    if (!(tempb = GMPy_MPZ_From_Integer(args[0], NULL))) {
+        mpz_clear(mm);
+        return NULL;
+    }
+
+    for (window = POWMOD_TABLE_MAX_WINDOW; ; window--) {
+        nwin = ((size_t)maxbits + window - 1) / window;
+        bytes = nwin * ((1 << window) - 1) * (mpz_size(mm) + 1) * sizeof(mp_limb_t);
+        if (bytes <= POWMOD_TABLE_BYTES || window == POWMOD_WINDOW)
+            break;
+    }
+    if (bytes > POWMOD_TABLE_MAX_BYTES) {
+        VALUE_ERROR("PowmodTable() table would be too large");
+        Py_DECREF((PyObject*)tempb);
+        mpz_clear(mm);
+        return NULL;
+    }
+
+    if (!(result = PyObject_New(PowmodTable_Object, &PowmodTable_Type))) {
+        Py_DECREF((PyObject*)tempb);
+        mpz_clear(mm);
+        return NULL;
+    }
+    if (!(result->table = GMPY_MALLOC(nwin * ((1 << window) - 1) * sizeof(mpz_t)))) {
+        result->nwin = 0;
+        mpz_init(result->base);
+        mpz_init(result->mm);
+        Py_DECREF((PyObject*)result);
+        Py_DECREF((PyObject*)tempb);
+        mpz_clear(mm);
+        return PyErr_NoMemory();
+    }
+    result->nwin = nwin;
+    result->window = window;
+    result->max_bits = (size_t)maxbits;
+    result->sign = sign;
+    mpz_init_set(result->base, tempb->z);
+    mpz_init_set(result->mm, mm);
+    Py_DECREF((PyObject*)tempb);
+    mpz_clear(mm);
+
+    GMPY_BEGIN_NOGIL(nwin * window);
+    powmod_table_init(result->table, nwin, window, result->base, result->mm);
+    GMPY_END_NOGIL;
+    return (PyObject*)result;
+}
+GMPY_FASTCALL_WRAPPER(GMPy_PowmodTable_Factory)
+
+static void
+GMPy_PowmodTable_Dealloc(PowmodTable_Object *self)
+{
+    if (self->table) {
+        powmod_table_clear(self->table, self->nwin, self->window);
+        GMPY_FREE(self->table);
+    }
+    mpz_clear(self->base);
+    mpz_clear(self->mm);
+    PyObject_Del(self);
+}
+
+static PyObject *
+GMPy_PowmodTable_Repr_Slot(PowmodTable_Object *self)
+{
+    return Py2or3String_FromFormat("<PowmodTable for %zu bit exponents>", self->max_bits);
+}
+
+/* Set r to b**e mod m. Returns 0 if e < 0 and b is not invertible. */
+
+static int
+powmod_table_pow(PowmodTable_Object *self, mpz_t r, mpz_t e, mpz_t temp)
+{
+    if (mpz_sgn(e) < 0) {
+        if (!mpz_invert(temp, self->base, self->mm))
+            return 0;
+        mpz_neg(r, e);
+        mpz_powm(r, temp, r, self->mm);
+    }
+    else if (mpz_sizeinbase(e, 2) > self->nwin * self->window) {
+        mpz_powm(r, self->base, e, self->mm);
+    }
+    else {
+        powmod_table_eval(r, self->table, self->window, e, self->mm);
+    }
+    POWMOD_ADJUST(r, self->mm, self->sign);
+    return 1;
+}
+
+PyDoc_STRVAR(GMPy_doc_powmod_table_pow,
+"T.pow(e) -> mpz\n\n"
+"Return powmod(b, e, m) for the base and modulus of the table.");
+
+static PyObject *
+GMPy_PowmodTable_Pow(PyObject *self, PyObject *other)
+{
+    MPZ_Object *result, *tempe;
+    mpz_t temp;
+    int ok;
+
+    if (!IS_INTEGER(other)) {
+        TYPE_ERROR("pow() requires an integer exponent");
+        return NULL;
+    }
+    if (!(tempe = GMPy_MPZ_From_Integer(other, NULL)))
+        return NULL;
+    if (!(result = GMPy_MPZ_New(NULL))) {
+        Py_DECREF((PyObject*)tempe);
+        return NULL;
+    }
+
+    mpz_inoc(temp);
+    ok = powmod_table_pow((PowmodTable_Object*)self, result->z, tempe->z, temp);
+    mpz_cloc(temp);
+    Py_DECREF((PyObject*)tempe);
+    if (!ok) {
+        VALUE_ERROR("pow() base not invertible");
+        Py_DECREF((PyObject*)result);
+        return NULL;
+    }
+    return (PyObject*)result;
+}
+
+PyDoc_STRVAR(GMPy_doc_powmod_table_pow_many,
+"T.pow_many(exps) -> list\n\n"
+"Return [T.pow(e) for e in exps], computed without the GIL.");
+
+static PyObject *
+GMPy_PowmodTable_PowMany(PyObject *self, PyObject *other)
+{
+    PowmodTable_Object *table = (PowmodTable_Object*)self;
+    PyObject *result = NULL;
+    MPZ_Object **exps;
+    Py_ssize_t i, nexps = 0;
+    size_t bits = 0;
+    int invalid = 0;
+    mpz_t temp;
+
+    if (!(exps = GMPy_MPZ_Array_From_Iterable(other, &nexps,
+                            "pow_many() requires a sequence of integers", NULL)))
+        return NULL;
+
+    if (!(result = powmod_result_list(nexps)))
+        goto done;
+
+    for (i = 0; i < nexps; i++)
+        bits += powmod_bits(exps[i]->z, table->mm);
+
+    GMPY_BEGIN_NOGIL(bits);
+    mpz_init(temp);
+    for (i = 0; i < nexps; i++) {
+        if (!powmod_table_pow(table, MPZ(PyList_GET_ITEM(result, i)), exps[i]->z, temp)) {
+            invalid = 1;
+            break;
+        }
+    }
+    mpz_clear(temp);
+    GMPY_END_NOGIL;
+
+    if (invalid) {
+        VALUE_ERROR("pow_many() base not invertible");
+        Py_CLEAR(result);
+    }
+
+  done:
+    GMPy_MPZ_Array_Free(exps, nexps);
+    return result;
+}
+
+static PyMethodDef GMPy_PowmodTable_methods[] =
+{
+    { "pow", GMPy_PowmodTable_Pow, METH_O, GMPy_doc_powmod_table_pow },
+    { "pow_many", GMPy_PowmodTable_PowMany, METH_O, GMPy_doc_powmod_table_pow_many },
+    { NULL, NULL, 1 }
+};
+
+static PyTypeObject PowmodTable_Type =
+{
+#ifdef PY3
+    PyVarObject_HEAD_INIT(0, 0)
+#else
+    PyObject_HEAD_INIT(0)
+        0,                                   /* ob_size          */
+#endif
+    "gmpy2 PowmodTable",                     /* tp_name          */
+    sizeof(PowmodTable_Object),              /* tp_basicsize     */
+        0,                                   /* tp_itemsize      */
+    (destructor) GMPy_PowmodTable_Dealloc,   /* tp_dealloc       */
+        0,                                   /* tp_print         */
+        0,                                   /* tp_getattr       */
+        0,                                   /* tp_setattr       */
+        0,                                   /* tp_reserved      */
+    (reprfunc) GMPy_PowmodTable_Repr_Slot,   /* tp_repr          */
+        0,                                   /* tp_as_number     */
+        0,                                   /* tp_as_sequence   */
+        0,                                   /* tp_as_mapping    */
+        0,                                   /* tp_hash          */
+        0,                                   /* tp_call          */
+        0,                                   /* tp_str           */
+        0,                                   /* tp_getattro      */
+        0,                                   /* tp_setattro      */
+        0,                                   /* tp_as_buffer     */
+    Py_TPFLAGS_DEFAULT,                      /* tp_flags         */
+    "GMPY2 fixed-base powmod table",         /* tp_doc           */
+        0,                                   /* tp_traverse      */
+        0,                                   /* tp_clear         */
+        0,                                   /* tp_richcompare   */
+        0,                                   /* tp_weaklistoffset*/
+        0,                                   /* tp_iter          */
+        0,                                   /* tp_iternext      */
+    GMPy_PowmodTable_methods,                /* tp_methods       */
+};
 
 static PyObject *
 GMPy_Number_Pow(PyObject *x, PyObject *y, PyObject *z, CTXT_Object *context)
 {
-    if (IS_INTEGER(x) && IS_INTEGER(y))
+    int xtype, ytype;
+
+    xtype = GMPy_ObjectType(x);
+    ytype = GMPy_ObjectType(y);
+
+    if (IS_TYPE_INTEGER(xtype) && IS_TYPE_INTEGER(ytype))
         return GMPy_Integer_Pow(x, y, z, context);
 
-    if (IS_RATIONAL(x) && IS_RATIONAL(y))
+    if (IS_TYPE_RATIONAL(xtype) && IS_TYPE_RATIONAL(ytype))
         return GMPy_Rational_Pow(x, y, z, context);
 
-    if (IS_REAL(x) && IS_REAL(y))
+    if (IS_TYPE_REAL(xtype) && IS_TYPE_REAL(ytype))
         return GMPy_Real_Pow(x, y, z, context);
 
-    if (IS_COMPLEX(x) && IS_COMPLEX(y))
+    if (IS_TYPE_COMPLEX(xtype) && IS_TYPE_COMPLEX(ytype))
         return GMPy_Complex_Pow(x, y, z, context);
 
     TYPE_ERROR("pow() argument type not supported");
@@ -445,11 +1403,11 @@ PyDoc_STRVAR(GMPy_doc_context_pow,
 "Return x ** y.");
 
 static PyObject *
-GMPy_Context_Pow(PyObject *self, PyObject *args)
+GMPy_Context_Pow(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     CTXT_Object *context = NULL;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (nargs != 2) {
         TYPE_ERROR("pow() requires 2 arguments.");
         return NULL;
     }
@@ -460,12 +1418,16 @@ GMPy_Context_Pow(PyObject *self, PyObject *args)
         CHECK_CONTEXT(context);
     }
 
-    return GMPy_Number_Pow(PyTuple_GET_ITEM(args, 0), PyTuple_GET_ITEM(args, 1),
+    return GMPy_Number_Pow(args[0], args[1],
                            Py_None, context);
 }
+GMPY_FASTCALL_WRAPPER(GMPy_Context_Pow)
+
+GMPY_PROFILE_WRAP(PyObject *, GMPy_MPANY_Pow_Slot, (PyObject *base, PyObject *exp, PyObject *mod),
+                  (base, exp, mod), gmpy_profile_bits2(base, mod))
 
 static PyObject *
-GMPy_MPANY_Pow_Slot(PyObject *base, PyObject *exp, PyObject *mod)
+GMPy_MPANY_Pow_Slot_Impl(PyObject *base, PyObject *exp, PyObject *mod)
 {
     if (IS_INTEGER(base) && IS_INTEGER(exp))
         return GMPy_Integer_Pow(base, exp, mod, NULL);
@@ -32,6 +32,21 @@
 extern "C" {
 #endif
 
+/* Precomputed powers of a fixed base, see GMPy_PowmodTable_Factory. */
+
+typedef struct {
+    PyObject_HEAD
+    mpz_t base;
+    mpz_t mm;                       /* absolute value of the modulus */
+    int sign;                       /* sign of the modulus */
+    int window;                     /* bits per table row */
+    size_t nwin;                    /* number of rows */
+    size_t max_bits;                /* max_exp_bits given by the caller */
+    mpz_t *table;
+} PowmodTable_Object;
+
+static PyTypeObject PowmodTable_Type;
+
 /* Private API */
 
 static PyObject * GMPy_MPANY_Pow_Slot(PyObject *base, PyObject *exp, PyObject *mod);
@@ -40,9 +55,17 @@ static PyObject * GMPy_Integer_Pow(PyObject *base, PyObject *exp, PyObject *mod,
 static PyObject * GMPy_Rational_Pow(PyObject *base, PyObject *exp, PyObject *mod, CTXT_Object *context);
 static PyObject * GMPy_Real_Pow(PyObject *base, PyObject *exp, PyObject *mod, CTXT_Object *context);
 static PyObject * GMPy_Complex_Pow(PyObject *base, PyObject *exp, PyObject *mod, CTXT_Object *context);
-static PyObject * GMPy_Integer_PowMod(PyObject *self, PyObject *args);
+static PyObject * GMPy_Integer_PowMod(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPy_Integer_PowModMany(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPy_Integer_PowModBaseMany(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPy_Integer_PowModProd(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPy_PowmodTable_Factory(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static void       GMPy_PowmodTable_Dealloc(PowmodTable_Object *self);
+static PyObject * GMPy_PowmodTable_Repr_Slot(PowmodTable_Object *self);
+static PyObject * GMPy_PowmodTable_Pow(PyObject *self, PyObject *other);
+static PyObject * GMPy_PowmodTable_PowMany(PyObject *self, PyObject *other);
 
-static PyObject * GMPy_Context_Pow(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_Pow(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 static PyObject * GMPy_Number_Pow(PyObject *x, PyObject *y, PyObject *z, CTXT_Object *context);
 
 #ifdef __cplusplus
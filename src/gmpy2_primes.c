@@ -0,0 +1,371 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_primes.c                                                          *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* This file implements gmpy2.primes(), an iterator over the primes in a
+ * range that is backed by a segmented sieve of Eratosthenes.
+ *
+ * The sieving primes are all the primes below
+ * min(isqrt(stop - 1) + 1, PRIMES_LIMIT). When they include every prime up
+ * to the square root of a number, the sieve alone proves it prime. Above
+ * that bound a survivor of the sieve is only returned if it also passes the
+ * same probable prime test as is_prime().
+ */
+
+/* Number of odd numbers in each segment. */
+#define PRIMES_SEGMENT 32768
+
+/* Upper limit for the sieving primes. */
+#define PRIMES_LIMIT (1UL << 21)
+
+/* The wheel contains one entry for each odd residue modulo 2*3*5*7*11*13.
+ * wheel[j] is 1 if 2*j+1 is coprime to 15015.
+ */
+#define PRIMES_WHEEL 15015
+
+static unsigned char primes_wheel[PRIMES_WHEEL];
+static int primes_wheel_ready = 0;
+
+static void
+primes_wheel_init(void)
+{
+    static const unsigned long small[] = {3, 5, 7, 11, 13};
+    unsigned long j;
+    int k;
+
+    if (primes_wheel_ready)
+        return;
+    memset(primes_wheel, 1, PRIMES_WHEEL);
+    for (k = 0; k < 5; k++) {
+        for (j = (small[k] - 1) / 2; j < PRIMES_WHEEL; j += small[k])
+            primes_wheel[j] = 0;
+    }
+    primes_wheel_ready = 1;
+}
+
+/* Return the value of a non-negative mpz that is known to be below 2**64. */
+
+static uint64_t
+primes_get_u64(mpz_t z)
+{
+    uint64_t result = mpz_getlimbn(z, 0);
+
+#if GMP_NUMB_BITS < 64
+    result |= (uint64_t)mpz_getlimbn(z, 1) << GMP_NUMB_BITS;
+#endif
+    return result;
+}
+
+/* Store the odd primes from 17 up to (but not including) limit in
+ * self->base and the index of the first multiple of each one that needs to
+ * be crossed off in self->next.
+ */
+
+static int
+primes_base_init(Primes_Object *self, unsigned long limit)
+{
+    unsigned char *flags;
+    unsigned long i, j, p, count = 0;
+    mpz_t temp;
+
+    if (!(flags = GMPY_MALLOC(limit / 2 + 1))) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    memset(flags, 1, limit / 2 + 1);
+    for (i = 1; (2 * i + 1) * (2 * i + 1) < limit; i++) {
+        if (flags[i]) {
+            p = 2 * i + 1;
+            for (j = p * p / 2; j < limit / 2 + 1; j += p)
+                flags[j] = 0;
+        }
+    }
+    for (i = 8; 2 * i + 1 < limit; i++)
+        count += flags[i];
+
+    if (!(self->base = GMPY_MALLOC((count ? count : 1) * sizeof(unsigned long))) ||
+        !(self->next = GMPY_MALLOC((count ? count : 1) * sizeof(uint64_t)))) {
+        GMPY_FREE(flags);
+        PyErr_NoMemory();
+        return -1;
+    }
+
+    mpz_init(temp);
+    for (i = 8; 2 * i + 1 < limit; i++) {
+        if (!flags[i])
+            continue;
+        p = 2 * i + 1;
+        mpz_set_ui(temp, p);
+        mpz_mul_ui(temp, temp, p);
+        if (mpz_cmp(temp, self->low) > 0) {
+            /* Multiples below p*p were crossed off by smaller primes. */
+            mpz_sub(temp, temp, self->low);
+            self->next[self->nbase] = primes_get_u64(temp) / 2;
+        }
+        else {
+            j = mpz_fdiv_ui(self->low, p);
+            j = j ? p - j : 0;
+            /* low is odd, so an odd distance leads to an even multiple. */
+            if (j & 1)
+                j += p;
+            self->next[self->nbase] = j / 2;
+        }
+        self->base[self->nbase++] = p;
+    }
+    mpz_clear(temp);
+    GMPY_FREE(flags);
+    return 0;
+}
+
+/* Sieve the segment that starts at self->low. */
+
+static void
+primes_fill(Primes_Object *self)
+{
+    static const unsigned long small[] = {3, 5, 7, 11, 13};
+    unsigned char *seg = self->seg;
+    Py_ssize_t i, chunk, k;
+    unsigned long j, p;
+    uint64_t n;
+    mpz_t last;
+
+    j = (mpz_fdiv_ui(self->low, 2 * PRIMES_WHEEL) - 1) / 2;
+    for (i = 0; i < PRIMES_SEGMENT; i += chunk) {
+        chunk = PRIMES_WHEEL - j;
+        if (chunk > PRIMES_SEGMENT - i)
+            chunk = PRIMES_SEGMENT - i;
+        memcpy(seg + i, primes_wheel + j, chunk);
+        j = 0;
+    }
+
+    for (k = 0; k < self->nbase; k++) {
+        p = self->base[k];
+        for (n = self->next[k]; n < PRIMES_SEGMENT; n += p)
+            seg[n] = 0;
+        self->next[k] = n - PRIMES_SEGMENT;
+    }
+
+    /* The wheel removes the wheel primes themselves. */
+    if (mpz_cmp_ui(self->low, 13) <= 0) {
+        j = mpz_get_ui(self->low);
+        for (k = 0; k < 5; k++) {
+            if (small[k] >= j)
+                seg[(small[k] - j) / 2] = 1;
+        }
+    }
+
+    mpz_init(last);
+    mpz_add_ui(last, self->low, 2 * (PRIMES_SEGMENT - 1));
+    self->proven = (mpz_cmp(last, self->bound) < 0);
+    mpz_clear(last);
+    self->pos = 0;
+}
+
+PyDoc_STRVAR(GMPy_doc_primes_factory,
+"primes(stop) -> iterator\n"
+"primes(start, stop) -> iterator\n\n"
+"Return an iterator over the primes p with start <= p < stop as mpz\n"
+"values. The primes are found with a segmented sieve. Numbers above\n"
+"2**42 that survive the sieve are also checked with is_prime(), so\n"
+"they are only _probably_ prime.");
+
+static PyObject *
+GMPy_Primes_Factory(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    Primes_Object *result;
+    MPZ_Object *start = NULL, *stop = NULL;
+    Py_ssize_t argc;
+    unsigned long limit;
+    mpz_t temp;
+
+    argc = nargs;
+    if (argc == 0 || argc > 2) {
+        TYPE_ERROR("primes() requires 'int'[,'int'] arguments");
+        return NULL;
+    }
+
+    if (argc == 2 &&
+        !(start = GMPy_MPZ_From_Integer(args[0], NULL))) {
+        TYPE_ERROR("primes() requires 'int'[,'int'] arguments");
+        return NULL;
+    }
+    if (!(stop = GMPy_MPZ_From_Integer(args[argc - 1], NULL))) {
+        TYPE_ERROR("primes() requires 'int'[,'int'] arguments");
+        Py_XDECREF((PyObject*)start);
+        return NULL;
+    }
+
+    if (!(result = PyObject_New(Primes_Object, &Primes_Type))) {
+        Py_XDECREF((PyObject*)start);
+        Py_DECREF((PyObject*)stop);
+        return NULL;
+    }
+    mpz_init(result->low);
+    mpz_init_set(result->stop, stop->z);
+    mpz_init(result->bound);
+    result->base = NULL;
+    result->next = NULL;
+    result->nbase = 0;
+    result->seg = NULL;
+    result->pos = PRIMES_SEGMENT;
+    result->two = 0;
+    result->proven = 0;
+    result->done = 0;
+
+    if (start)
+        mpz_set(result->low, start->z);
+    else
+        mpz_set_ui(result->low, 2);
+    Py_XDECREF((PyObject*)start);
+    Py_DECREF((PyObject*)stop);
+
+    if (mpz_cmp(result->low, result->stop) >= 0 ||
+        mpz_cmp_ui(result->stop, 2) <= 0) {
+        result->done = 1;
+        return (PyObject*)result;
+    }
+
+    result->two = (mpz_cmp_ui(result->low, 2) <= 0);
+    if (mpz_cmp_ui(result->low, 3) < 0)
+        mpz_set_ui(result->low, 3);
+    if (mpz_even_p(result->low))
+        mpz_add_ui(result->low, result->low, 1);
+
+    mpz_init(temp);
+    mpz_sub_ui(temp, result->stop, 1);
+    mpz_sqrt(temp, temp);
+    if (mpz_cmp_ui(temp, PRIMES_LIMIT - 1) >= 0)
+        limit = PRIMES_LIMIT;
+    else
+        limit = mpz_get_ui(temp) + 1;
+    mpz_clear(temp);
+    /* The wheel accounts for all the primes below 17. */
+    if (limit < 17)
+        limit = 17;
+    mpz_set_ui(result->bound, limit);
+    mpz_mul_ui(result->bound, result->bound, limit);
+
+    primes_wheel_init();
+    if (primes_base_init(result, limit) < 0 ||
+        !(result->seg = GMPY_MALLOC(PRIMES_SEGMENT))) {
+        if (!PyErr_Occurred())
+            PyErr_NoMemory();
+        Py_DECREF((PyObject*)result);
+        return NULL;
+    }
+    primes_fill(result);
+    return (PyObject*)result;
+}
+GMPY_FASTCALL_WRAPPER(GMPy_Primes_Factory)
+
+static void
+GMPy_Primes_Dealloc(Primes_Object *self)
+{
+    mpz_clear(self->low);
+    mpz_clear(self->stop);
+    mpz_clear(self->bound);
+    GMPY_FREE(self->base);
+    GMPY_FREE(self->next);
+    GMPY_FREE(self->seg);
+    PyObject_Del(self);
+}
+
+static PyObject *
+GMPy_Primes_IterNext(Primes_Object *self)
+{
+    MPZ_Object *result;
+
+    if (self->done)
+        return NULL;
+
+    if (!(result = GMPy_MPZ_New(NULL)))
+        return NULL;
+
+    if (self->two) {
+        self->two = 0;
+        mpz_set_ui(result->z, 2);
+        return (PyObject*)result;
+    }
+
+    while (1) {
+        for (; self->pos < PRIMES_SEGMENT; self->pos++) {
+            if (!self->seg[self->pos])
+                continue;
+            mpz_add_ui(result->z, self->low, 2 * self->pos);
+            if (mpz_cmp(result->z, self->stop) >= 0)
+                goto done;
+            if (self->proven || mpz_probab_prime_p(result->z, 25)) {
+                self->pos++;
+                return (PyObject*)result;
+            }
+        }
+        mpz_add_ui(self->low, self->low, 2 * PRIMES_SEGMENT);
+        if (mpz_cmp(self->low, self->stop) >= 0)
+            goto done;
+        primes_fill(self);
+    }
+
+  done:
+    self->done = 1;
+    Py_DECREF((PyObject*)result);
+    return NULL;
+}
+
+static PyTypeObject Primes_Type =
+{
+#ifdef PY3
+    PyVarObject_HEAD_INIT(0, 0)
+#else
+    PyObject_HEAD_INIT(0)
+        0,                                   /* ob_size          */
+#endif
+    "gmpy2 primes",                          /* tp_name          */
+    sizeof(Primes_Object),                   /* tp_basicsize     */
+        0,                                   /* tp_itemsize      */
+    (destructor) GMPy_Primes_Dealloc,        /* tp_dealloc       */
+        0,                                   /* tp_print         */
+        0,                                   /* tp_getattr       */
+        0,                                   /* tp_setattr       */
+        0,                                   /* tp_reserved      */
+        0,                                   /* tp_repr          */
+        0,                                   /* tp_as_number     */
+        0,                                   /* tp_as_sequence   */
+        0,                                   /* tp_as_mapping    */
+        0,                                   /* tp_hash          */
+        0,                                   /* tp_call          */
+        0,                                   /* tp_str           */
+        0,                                   /* tp_getattro      */
+        0,                                   /* tp_setattro      */
+        0,                                   /* tp_as_buffer     */
+    Py_TPFLAGS_DEFAULT,                      /* tp_flags         */
+    "GMPY2 prime iterator",                  /* tp_doc           */
+        0,                                   /* tp_traverse      */
+        0,                                   /* tp_clear         */
+        0,                                   /* tp_richcompare   */
+        0,                                   /* tp_weaklistoffset*/
+    PyObject_SelfIter,                       /* tp_iter          */
+    (iternextfunc) GMPy_Primes_IterNext,     /* tp_iternext      */
+};
@@ -0,0 +1,67 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_primes.h                                                          *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GMPY_PRIMES_H
+#define GMPY_PRIMES_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* A primes iterator walks a range of integers one segment at a time. Each
+ * entry of the segment represents an odd number; multiples of 3, 5, 7, 11
+ * and 13 are removed by copying a precomputed wheel pattern and the
+ * remaining sieving primes are crossed off individually.
+ */
+
+typedef struct {
+    PyObject_HEAD
+    mpz_t low;                      /* odd number represented by seg[0] */
+    mpz_t stop;                     /* end of the range (exclusive) */
+    mpz_t bound;                    /* survivors below bound are prime */
+    unsigned long *base;            /* sieving primes larger than 13 */
+    uint64_t *next;                 /* next multiple of each sieving prime */
+    Py_ssize_t nbase;               /* number of sieving primes */
+    unsigned char *seg;             /* nonzero if not crossed off */
+    Py_ssize_t pos;                 /* next entry of seg to examine */
+    int two;                        /* 2 has not been returned yet */
+    int proven;                     /* all survivors in seg are prime */
+    int done;
+} Primes_Object;
+
+static PyTypeObject Primes_Type;
+
+#define Primes_Check(v) (((PyObject*)v)->ob_type == &Primes_Type)
+
+static PyObject *         GMPy_Primes_Factory(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static void               GMPy_Primes_Dealloc(Primes_Object *self);
+static PyObject *         GMPy_Primes_IterNext(Primes_Object *self);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
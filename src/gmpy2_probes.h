@@ -0,0 +1,88 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_probes.h                                                          *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+#ifndef GMPY_PROBES_H
+#define GMPY_PROBES_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Static probes for bpftrace, SystemTap, and DTrace. They are compiled in
+ * when gmpy2 is built with -DGMPY_USDT (setup.py build_ext --usdt), which
+ * requires <sys/sdt.h>, and expand to nothing otherwise. A probe that is
+ * not being traced costs one nop instruction, but its arguments are always
+ * evaluated, so they must be cheap.
+ *
+ * The probes of the provider gmpy2 are:
+ *
+ *   mpz__cache__hit()              GMPy_MPZ_New reused a cached object
+ *   mpz__cache__miss()             GMPy_MPZ_New allocated a new object
+ *   mpfr__cache__hit(prec)         the same for GMPy_MPFR_New
+ *   mpfr__cache__miss(prec)
+ *   alloc__large(size)             gmpy_allocate() or gmpy_reallocate()
+ *                                  was asked for at least
+ *                                  GMPY_PROBE_LARGE_ALLOC bytes
+ *   context__set(context)          set_context() was called
+ *   kernel__entry(name, bits)      a long-running function was entered
+ *   kernel__return(name, bits)     or is about to return; name is a C
+ *                                  string, bits is the size of the largest
+ *                                  operand (n for the factorials)
+ *
+ * The kernels are powmod (also used by pow()), is_prime, the is_*_prp
+ * tests, fac, double_fac, multi_fac, and primorial. For example,
+ *
+ *   bpftrace -e 'usdt:/path/to/gmpy2.so:gmpy2:kernel__entry
+ *                { @start[tid] = nsecs; }
+ *                usdt:/path/to/gmpy2.so:gmpy2:kernel__return /@start[tid]/
+ *                { @us[str(arg0)] = hist((nsecs - @start[tid]) / 1000);
+ *                  delete(@start[tid]); }'
+ */
+
+#define GMPY_PROBE_LARGE_ALLOC ((size_t)1 << 20)
+
+#ifdef GMPY_USDT
+#  include <sys/sdt.h>
+#  define GMPY_PROBE(NAME) DTRACE_PROBE(gmpy2, NAME)
+#  define GMPY_PROBE1(NAME, A) DTRACE_PROBE1(gmpy2, NAME, A)
+#  define GMPY_PROBE2(NAME, A, B) DTRACE_PROBE2(gmpy2, NAME, A, B)
+#else
+#  define GMPY_PROBE(NAME) ((void)0)
+#  define GMPY_PROBE1(NAME, A) ((void)0)
+#  define GMPY_PROBE2(NAME, A, B) ((void)0)
+#endif
+
+#define GMPY_PROBE_ENTRY(NAME, BITS) \
+    GMPY_PROBE2(kernel__entry, NAME, (size_t)(BITS))
+#define GMPY_PROBE_RETURN(NAME, BITS) \
+    GMPY_PROBE2(kernel__return, NAME, (size_t)(BITS))
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,293 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_profile.c                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+/* Opt-in call counters for the arithmetic slots, the gmpy2 functions that
+ * dispatch on their argument types, and the integer and string
+ * conversions. Profiling is off by default and the wrappers then cost one
+ * test of gmpy_profile_active. Counters are only updated while the GIL is
+ * held.
+ */
+
+static int gmpy_profile_active = 0;
+static gmpy_profile_entry *gmpy_profile_entries = NULL;
+
+static double
+gmpy_profile_now(void)
+{
+#if defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+#elif PY_VERSION_HEX >= 0x030D0000
+    PyTime_t t;
+
+    PyTime_PerfCounterRaw(&t);
+    return PyTime_AsSecondsDouble(t);
+#else
+    return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+static void
+gmpy_profile_record(gmpy_profile_entry *entry, double start, size_t bits)
+{
+    double elapsed = gmpy_profile_now() - start;
+
+    if (!entry->listed) {
+        entry->next = gmpy_profile_entries;
+        gmpy_profile_entries = entry;
+        entry->listed = 1;
+    }
+    entry->calls++;
+    entry->total_time += elapsed;
+    if (elapsed > entry->max_time)
+        entry->max_time = elapsed;
+    entry->total_bits += bits;
+    if (bits > entry->max_bits)
+        entry->max_bits = bits;
+}
+
+/* The size of a number in bits: the bit length of an integer, the sum for
+ * the numerator and denominator of a rational, and the precision of a
+ * floating point or complex value. Other objects count as 0.
+ */
+
+static size_t
+gmpy_profile_bits(PyObject *obj)
+{
+    if (!obj)
+        return 0;
+    if (CHECK_MPZANY(obj))
+        return mpz_sizeinbase(MPZ(obj), 2);
+    if (MPQ_Check(obj))
+        return mpz_sizeinbase(mpq_numref(MPQ(obj)), 2) +
+               mpz_sizeinbase(mpq_denref(MPQ(obj)), 2);
+    if (MPFR_Check(obj))
+        return (size_t)mpfr_get_prec(MPFR(obj));
+    if (MPC_Check(obj)) {
+        mpfr_prec_t rprec, iprec;
+
+        mpc_get_prec2(&rprec, &iprec, MPC(obj));
+        return (size_t)(rprec > iprec ? rprec : iprec);
+    }
+    if (PyLong_Check(obj)) {
+#if PY_VERSION_HEX >= 0x030D0000
+        Py_ssize_t n = PyLong_AsNativeBytes(obj, NULL, 0, -1);
+
+        return n > 0 ? 8 * (size_t)n : 0;
+#else
+        size_t n = _PyLong_NumBits(obj);
+
+        if (n == (size_t)-1) {
+            PyErr_Clear();
+            return 0;
+        }
+        return n;
+#endif
+    }
+    if (PyFloat_Check(obj))
+        return DBL_MANT_DIG;
+    return 0;
+}
+
+static size_t
+gmpy_profile_bits2(PyObject *x, PyObject *y)
+{
+    size_t a = gmpy_profile_bits(x), b = gmpy_profile_bits(y);
+
+    return a > b ? a : b;
+}
+
+static size_t
+gmpy_profile_bits_args(PyObject *const *args, Py_ssize_t nargs)
+{
+    size_t bits = 0, b;
+    Py_ssize_t i;
+
+    for (i = 0; i < nargs; i++) {
+        if ((b = gmpy_profile_bits(args[i])) > bits)
+            bits = b;
+    }
+    return bits;
+}
+
+PyDoc_STRVAR(GMPy_doc_profile,
+"profile([enable]) -> bool\n\n"
+"Turn the call counters for gmpy2 arithmetic, dispatch and conversion\n"
+"functions on or off and return the previous setting. Without an\n"
+"argument, the current setting is returned. The counters are read with\n"
+"profile_stats() or profile_text().");
+
+static PyObject *
+GMPy_Profile(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    int previous = gmpy_profile_active, enable;
+
+    if (nargs > 1) {
+        TYPE_ERROR("profile() takes at most 1 argument");
+        return NULL;
+    }
+    if (nargs == 1) {
+        if ((enable = PyObject_IsTrue(args[0])) < 0)
+            return NULL;
+        gmpy_profile_active = enable;
+    }
+    return PyBool_FromLong(previous);
+}
+GMPY_FASTCALL_WRAPPER(GMPy_Profile)
+
+PyDoc_STRVAR(GMPy_doc_profile_stats,
+"profile_stats([reset=False]) -> dict\n\n"
+"Return a dictionary that maps the name of each profiled C function that\n"
+"was called to a dictionary with the number of 'calls', the 'total_time'\n"
+"and 'max_time' in seconds, and the 'total_bits' and 'max_bits' of the\n"
+"largest operand. If reset is true, the counters are cleared afterwards.");
+
+static PyObject *
+GMPy_Profile_Stats(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *result, *item;
+    gmpy_profile_entry *entry;
+    int reset = 0;
+
+    if (nargs > 1) {
+        TYPE_ERROR("profile_stats() takes at most 1 argument");
+        return NULL;
+    }
+    if (nargs == 1 && (reset = PyObject_IsTrue(args[0])) < 0)
+        return NULL;
+
+    if (!(result = PyDict_New()))
+        return NULL;
+
+    for (entry = gmpy_profile_entries; entry; entry = entry->next) {
+        if (!entry->calls)
+            continue;
+        item = Py_BuildValue("{s:K,s:d,s:d,s:K,s:n}",
+                             "calls", entry->calls,
+                             "total_time", entry->total_time,
+                             "max_time", entry->max_time,
+                             "total_bits", entry->total_bits,
+                             "max_bits", (Py_ssize_t)entry->max_bits);
+        if (!item || PyDict_SetItemString(result, entry->name, item) < 0) {
+            Py_XDECREF(item);
+            Py_DECREF(result);
+            return NULL;
+        }
+        Py_DECREF(item);
+    }
+
+    if (reset) {
+        for (entry = gmpy_profile_entries; entry; entry = entry->next) {
+            entry->calls = entry->total_bits = 0;
+            entry->max_bits = 0;
+            entry->total_time = entry->max_time = 0.0;
+        }
+    }
+    return result;
+}
+GMPY_FASTCALL_WRAPPER(GMPy_Profile_Stats)
+
+PyDoc_STRVAR(GMPy_doc_profile_text,
+"profile_text() -> str\n\n"
+"Return the counters of profile_stats() in the Prometheus text format.\n"
+"Each metric has a 'function' label with the name of the C function.");
+
+static PyObject *
+GMPy_Profile_Text(PyObject *self, PyObject *args)
+{
+    static const char *metrics[5][3] = {
+        {"gmpy2_calls_total", "counter", "Number of calls."},
+        {"gmpy2_seconds_total", "counter", "Total wall time in seconds."},
+        {"gmpy2_seconds_max", "gauge", "Longest call in seconds."},
+        {"gmpy2_bits_total", "counter", "Sum of the largest operand size in bits."},
+        {"gmpy2_bits_max", "gauge", "Largest operand size in bits."},
+    };
+    PyObject *lines, *line, *sep, *result;
+    gmpy_profile_entry *entry;
+    char value[64];
+    int m;
+
+    if (!(lines = PyList_New(0)))
+        return NULL;
+
+    for (m = 0; m < 5; m++) {
+        line = PyUnicode_FromFormat("# HELP %s %s\n# TYPE %s %s",
+                                    metrics[m][0], metrics[m][2],
+                                    metrics[m][0], metrics[m][1]);
+        if (!line || PyList_Append(lines, line) < 0)
+            goto error;
+        Py_DECREF(line);
+        for (entry = gmpy_profile_entries; entry; entry = entry->next) {
+            if (!entry->calls)
+                continue;
+            switch (m) {
+                case 0:
+                    PyOS_snprintf(value, sizeof(value), "%llu", entry->calls);
+                    break;
+                case 1:
+                    PyOS_snprintf(value, sizeof(value), "%.9g", entry->total_time);
+                    break;
+                case 2:
+                    PyOS_snprintf(value, sizeof(value), "%.9g", entry->max_time);
+                    break;
+                case 3:
+                    PyOS_snprintf(value, sizeof(value), "%llu", entry->total_bits);
+                    break;
+                default:
+                    PyOS_snprintf(value, sizeof(value), "%llu",
+                                  (unsigned long long)entry->max_bits);
+                    break;
+            }
+            line = PyUnicode_FromFormat("%s{function=\"%s\"} %s",
+                                        metrics[m][0], entry->name, value);
+            if (!line || PyList_Append(lines, line) < 0)
+                goto error;
+            Py_DECREF(line);
+        }
+    }
+
+    /* An empty last line gives the text a final newline. */
+    if (!(line = PyUnicode_FromString("")) || PyList_Append(lines, line) < 0)
+        goto error;
+    Py_DECREF(line);
+
+    if (!(sep = PyUnicode_FromString("\n")))
+        goto error_list;
+    result = PyUnicode_Join(sep, lines);
+    Py_DECREF(sep);
+    Py_DECREF(lines);
+    return result;
+
+  error:
+    Py_XDECREF(line);
+  error_list:
+    Py_DECREF(lines);
+    return NULL;
+}
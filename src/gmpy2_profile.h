@@ -0,0 +1,87 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_profile.h                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+#ifndef GMPY_PROFILE_H
+#define GMPY_PROFILE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Counters for one profiled function. An entry is a static variable of the
+ * wrapper and is added to the list of entries on its first call.
+ */
+
+typedef struct gmpy_profile_entry {
+    const char *name;
+    struct gmpy_profile_entry *next;
+    int listed;
+    unsigned long long calls;
+    unsigned long long total_bits;
+    size_t max_bits;
+    double total_time;
+    double max_time;
+} gmpy_profile_entry;
+
+/* GMPY_PROFILE_WRAP(RTYPE, NAME, PARAMS, ARGS, BITS) defines NAME as a
+ * wrapper around NAME##_Impl, which must be defined next with the same
+ * parameters. While profiling is off, the wrapper only tests a flag.
+ * Otherwise the call is timed and BITS, an expression that may use the
+ * parameters and 'result', gives the operand size that is recorded.
+ */
+
+#define GMPY_PROFILE_WRAP(RTYPE, NAME, PARAMS, ARGS, BITS) \
+static RTYPE NAME##_Impl PARAMS; \
+static RTYPE \
+NAME PARAMS \
+{ \
+    static gmpy_profile_entry entry = { #NAME }; \
+    RTYPE result; \
+    double start; \
+    if (!gmpy_profile_active) \
+        return NAME##_Impl ARGS; \
+    start = gmpy_profile_now(); \
+    result = NAME##_Impl ARGS; \
+    gmpy_profile_record(&entry, start, BITS); \
+    return result; \
+}
+
+static double     gmpy_profile_now(void);
+static void       gmpy_profile_record(gmpy_profile_entry *entry, double start, size_t bits);
+static size_t     gmpy_profile_bits(PyObject *obj);
+static size_t     gmpy_profile_bits2(PyObject *x, PyObject *y);
+static size_t     gmpy_profile_bits_args(PyObject *const *args, Py_ssize_t nargs);
+
+static PyObject * GMPy_Profile(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPy_Profile_Stats(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPy_Profile_Text(PyObject *self, PyObject *args);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
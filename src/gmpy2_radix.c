@@ -0,0 +1,335 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_radix.c                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* GMP converts between an mpz and a string by repeatedly splitting the
+ * number (or the string) in half, using powers base**(2**k) that it computes
+ * again on every call. When set_radix_cache() gives a memory budget, the
+ * conversions of large numbers are instead split here using powers that are
+ * kept between calls. With base = odd * 2**twos and n(i) = RADIX_LEAF << i,
+ *
+ *   base ** n(i) = radix.pow[i] * 2 ** (twos * n(i))
+ *
+ * and only the odd part is stored. A number x < (base ** n(i)) ** 2 is split
+ * into a quotient and a remainder by dividing x >> (twos * n(i)) by pow[i],
+ * which is smaller than a division by the full power. The pieces are
+ * converted recursively and the pieces of RADIX_LEAF digits at the bottom
+ * are converted by mpz_get_str() and mpz_set_str(). Powers of two are not
+ * cached since GMP converts those bases in linear time.
+ *
+ * The cache is only used while the GIL is held.
+ */
+
+#define RADIX_LEAF 4096
+#define RADIX_MAX_POW 48
+
+typedef struct {
+    mpz_t pow[RADIX_MAX_POW];
+    int npow;                /* number of valid entries in pow */
+    int twos;                /* power of 2 that divides the base */
+    size_t bytes;            /* memory used by pow */
+} gmpy_radix;
+
+static gmpy_radix radix_cache[63];
+static size_t radix_cache_limit = 0;     /* 0 disables the cache */
+static size_t radix_cache_bytes = 0;
+
+/* Free the powers of one base. */
+
+static void
+radix_clear(int base)
+{
+    gmpy_radix *radix = &radix_cache[base];
+    int i;
+
+    for (i = 0; i < radix->npow; i++)
+        mpz_clear(radix->pow[i]);
+    radix_cache_bytes -= radix->bytes;
+    radix->npow = 0;
+    radix->bytes = 0;
+}
+
+/* Make sure pow[0] ... pow[k] exist for the base. Returns the cache entry,
+ * or NULL if the powers do not fit the memory budget.
+ */
+
+static gmpy_radix *
+radix_powers(int base, int k)
+{
+    gmpy_radix *radix = &radix_cache[base];
+    size_t bytes;
+    int i;
+
+    if (k >= RADIX_MAX_POW)
+        return NULL;
+
+    while (radix->npow <= k) {
+        i = radix->npow;
+
+        /* pow[i] is about twice the size of pow[i-1]. */
+        if (i == 0)
+            bytes = RADIX_LEAF * 6 / 8 + sizeof(mp_limb_t);
+        else
+            bytes = 2 * mpz_size(radix->pow[i-1]) * sizeof(mp_limb_t);
+
+        if (radix_cache_bytes + bytes > radix_cache_limit) {
+            int b;
+
+            /* Make room by dropping the powers of the other bases. */
+            for (b = 2; b < 63; b++) {
+                if (b != base)
+                    radix_clear(b);
+            }
+            if (radix_cache_bytes + bytes > radix_cache_limit)
+                return NULL;
+        }
+
+        mpz_init(radix->pow[i]);
+        if (i == 0) {
+            for (radix->twos = 0; !((base >> radix->twos) & 1); radix->twos++);
+            mpz_ui_pow_ui(radix->pow[0], base >> radix->twos, RADIX_LEAF);
+        }
+        else if (!pcache_load_mpz(radix->pow[i], "radix", (unsigned long)base,
+                                  i, 8.0 * bytes)) {
+            mpz_mul(radix->pow[i], radix->pow[i-1], radix->pow[i-1]);
+            pcache_store_mpz(radix->pow[i], "radix", (unsigned long)base,
+                             i, 8.0 * bytes);
+        }
+        bytes = mpz_size(radix->pow[i]) * sizeof(mp_limb_t);
+        radix->bytes += bytes;
+        radix_cache_bytes += bytes;
+        radix->npow++;
+    }
+    return radix;
+}
+
+/* Return the cache entry and set *k for converting a number of n digits,
+ * or return NULL if the cache should not be used.
+ */
+
+static gmpy_radix *
+radix_lookup(int base, size_t n, int *k)
+{
+    int i = 0;
+
+    if (!radix_cache_limit || n <= 2 * RADIX_LEAF || base < 2 || base > 62 ||
+        (base & (base - 1)) == 0)
+        return NULL;
+
+    /* Find the smallest k with n <= RADIX_LEAF << (k + 1). */
+    while (((size_t)RADIX_LEAF << (i + 1)) < n)
+        i++;
+    *k = i;
+    return radix_powers(base, i);
+}
+
+/* Write x < pow[k]**2 at p. If pad is set, exactly RADIX_LEAF << (k + 1)
+ * digits are written, with leading zeros. Returns the end of the digits.
+ */
+
+static char *
+radix_get_str(char *p, int base, mpz_t x, gmpy_radix *radix, int k, int pad)
+{
+    mpz_t q, r, low;
+    size_t len, width, shift;
+
+    if (k < 0) {
+        mpz_get_str(p, base, x);
+        len = strlen(p);
+        if (pad && len < RADIX_LEAF) {
+            memmove(p + RADIX_LEAF - len, p, len);
+            memset(p, '0', RADIX_LEAF - len);
+            len = RADIX_LEAF;
+        }
+        return p + len;
+    }
+
+    width = (size_t)RADIX_LEAF << (k + 1);
+    shift = radix->twos * (width / 2);
+    mpz_init(q);
+    mpz_init(r);
+    mpz_init(low);
+    mpz_tdiv_r_2exp(low, x, shift);
+    mpz_tdiv_q_2exp(q, x, shift);
+    mpz_tdiv_qr(q, r, q, radix->pow[k]);
+    mpz_mul_2exp(r, r, shift);
+    mpz_add(r, r, low);
+    mpz_clear(low);
+
+    /* An unpadded high part has no leading zeros to write. */
+    if (!pad && mpz_sgn(q) == 0) {
+        mpz_clear(q);
+        p = radix_get_str(p, base, r, radix, k - 1, 0);
+        mpz_clear(r);
+        return p;
+    }
+    if (pad && mpz_sgn(q) == 0) {
+        memset(p, '0', width / 2);
+        p += width / 2;
+    }
+    else {
+        p = radix_get_str(p, base, q, radix, k - 1, pad);
+    }
+    mpz_clear(q);
+    p = radix_get_str(p, base, r, radix, k - 1, 1);
+    mpz_clear(r);
+    return p;
+}
+
+/* Same as mpz_get_str(p, base, x) for x >= 0, where p has room for
+ * mpz_sizeinbase(x, base) + 1 characters.
+ */
+
+static void
+mpz_get_str_radix(char *p, int base, mpz_t x)
+{
+    gmpy_radix *radix;
+    int k, b = base < 0 ? -base : (base ? base : 10);
+
+    if (!(radix = radix_lookup(b, mpz_sizeinbase(x, b), &k))) {
+        mpz_get_str(p, base, x);
+        return;
+    }
+    *radix_get_str(p, base, x, radix, k, 0) = '\0';
+}
+
+/* Return the value of digit c, or 62 if c is not a digit. */
+
+static int
+radix_digit(int c, int base)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'A' && c <= 'Z')
+        return c - 'A' + 10;
+    if (c >= 'a' && c <= 'z')
+        return c - 'a' + (base <= 36 ? 10 : 36);
+    return 62;
+}
+
+/* Set z to the n digits at cp, where n <= RADIX_LEAF << (k + 1). */
+
+static void
+radix_set_str(mpz_t z, const char *cp, size_t n, int base, gmpy_radix *radix, int k)
+{
+    mpz_t hi;
+    size_t low;
+
+    while (k >= 0 && n <= ((size_t)RADIX_LEAF << k))
+        k--;
+
+    if (k < 0) {
+        char leaf[RADIX_LEAF + 1];
+
+        memcpy(leaf, cp, n);
+        leaf[n] = '\0';
+        mpz_set_str(z, leaf, base);
+        return;
+    }
+
+    low = (size_t)RADIX_LEAF << k;
+    mpz_init(hi);
+    radix_set_str(hi, cp, n - low, base, radix, k - 1);
+    radix_set_str(z, cp + n - low, low, base, radix, k - 1);
+    mpz_mul(hi, hi, radix->pow[k]);
+    mpz_mul_2exp(hi, hi, radix->twos * low);
+    mpz_add(z, z, hi);
+    mpz_clear(hi);
+}
+
+/* Same as mpz_set_str(z, cp, base) for 2 <= base <= 62. */
+
+static int
+mpz_set_str_radix(mpz_t z, const char *cp, int base)
+{
+    gmpy_radix *radix;
+    const char *digits = cp;
+    size_t i, n;
+    int k;
+
+    if (*digits == '-')
+        digits++;
+    n = strlen(digits);
+
+    if (!(radix = radix_lookup(base, n, &k)))
+        return mpz_set_str(z, cp, base);
+
+    /* Let GMP handle white space and report invalid digits. */
+    for (i = 0; i < n; i++) {
+        if (radix_digit((unsigned char)digits[i], base) >= base)
+            return mpz_set_str(z, cp, base);
+    }
+
+    radix_set_str(z, digits, n, base, radix, k);
+    if (digits != cp)
+        mpz_neg(z, z);
+    return 0;
+}
+
+PyDoc_STRVAR(GMPy_doc_get_radix_cache,
+"get_radix_cache() -> tuple\n\n"
+"Return the memory budget, in bytes, of the cache of radix powers used\n"
+"to convert large integers to and from strings, and the number of bytes\n"
+"currently used.");
+
+static PyObject *
+GMPy_get_radix_cache(PyObject *self, PyObject *args)
+{
+    return Py_BuildValue("(nn)", (Py_ssize_t)radix_cache_limit,
+                         (Py_ssize_t)radix_cache_bytes);
+}
+
+PyDoc_STRVAR(GMPy_doc_set_radix_cache,
+"set_radix_cache(bytes)\n\n"
+"Keep the powers of the base that are used to convert integers with\n"
+"more than 8192 digits to and from strings, up to 'bytes' bytes of\n"
+"memory, instead of computing them for every conversion. The powers of\n"
+"the most recently used base are kept. 0 (the default) disables the\n"
+"cache and frees its memory.");
+
+static PyObject *
+GMPy_set_radix_cache(PyObject *self, PyObject *other)
+{
+    Py_ssize_t bytes;
+    int base;
+
+    bytes = PyIntOrLong_AsSsize_t(other);
+    if (bytes == -1 && PyErr_Occurred()) {
+        TYPE_ERROR("set_radix_cache() requires an integer argument");
+        return NULL;
+    }
+    if (bytes < 0) {
+        VALUE_ERROR("size must be 0 or greater");
+        return NULL;
+    }
+
+    radix_cache_limit = (size_t)bytes;
+    if (radix_cache_bytes > radix_cache_limit) {
+        for (base = 2; base < 63; base++)
+            radix_clear(base);
+    }
+    Py_RETURN_NONE;
+}
@@ -32,6 +32,8 @@ GMPy_RandomState_New(void)
 
     if ((result = PyObject_New(RandomState_Object, &RandomState_Type))) {
         gmp_randinit_default(result->state);
+        mpz_init(result->key);
+        result->spawned = 0;
     }
     return result;
 };
@@ -40,6 +42,7 @@ static void
 GMPy_RandomState_Dealloc(RandomState_Object *self)
 {
     gmp_randclear(self->state);
+    mpz_clear(self->key);
     PyObject_Del(self);
 };
 
@@ -55,7 +58,7 @@ PyDoc_STRVAR(GMPy_doc_random_state_factory,
 "generator. An optional integer can be specified as the seed value.");
 
 static PyObject *
-GMPy_RandomState_Factory(PyObject *self, PyObject *args)
+GMPy_RandomState_Factory(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     RandomState_Object *result;
     MPZ_Object *temp;
@@ -64,16 +67,17 @@ GMPy_RandomState_Factory(PyObject *self, PyObject *args)
         return NULL;
     }
 
-    if (PyTuple_GET_SIZE(args) == 0) {
+    if (nargs == 0) {
         gmp_randseed_ui(result->state, 0);
     }
-    else if (PyTuple_GET_SIZE(args) == 1) {
-        if (!(temp = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args,0), NULL))) {
+    else if (nargs == 1) {
+        if (!(temp = GMPy_MPZ_From_Integer(args[0], NULL))) {
             Py_DECREF((PyObject*)result);
             TYPE_ERROR("seed must be an integer");
             return NULL;
         }
         gmp_randseed(result->state, temp->z);
+        mpz_set(result->key, temp->z);
         Py_DECREF((PyObject*)temp);
     }
     else {
@@ -83,17 +87,201 @@ GMPy_RandomState_Factory(PyObject *self, PyObject *args)
     }
     return (PyObject*)result;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_RandomState_Factory)
+
+/* GMP does not provide a way to advance the Mersenne Twister by a fixed
+ * number of steps, so streams are split the way seed sequences do it:
+ * each derived stream is seeded with a 256-bit key obtained by hashing the
+ * parent's key with the index of the stream. The keys depend only on the
+ * values involved, not on the limb size, so the streams are reproducible
+ * on every platform, and with a period of 2**19937 - 1 the chance that two
+ * streams overlap is negligible.
+ */
+
+static uint64_t
+random_mix64(uint64_t z)
+{
+    /* The SplitMix64 finalizer. */
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/* Set child to the key of stream index derived from key. */
+
+static void
+random_derive_key(mpz_t child, mpz_t key, uint64_t index)
+{
+    uint64_t h1 = 0x9E3779B97F4A7C15ULL, h2 = 0xD1B54A32D192ED03ULL;
+    uint64_t word = 0, words[4];
+    size_t i, shift = 0;
+    int j;
+
+    h1 ^= (uint64_t)(mpz_sgn(key) + 1);
+    for (i = 0; i < mpz_size(key); i++) {
+        word |= (uint64_t)mpz_getlimbn(key, i) << shift;
+        shift += GMP_NUMB_BITS;
+        if (shift >= 64 || i + 1 == mpz_size(key)) {
+            h1 = random_mix64(h1 ^ word);
+            h2 = random_mix64(h2 + word);
+            word = 0;
+            shift = 0;
+        }
+    }
+    h1 = random_mix64(h1 ^ index);
+    h2 = random_mix64(h2 + index);
+    for (j = 0; j < 4; j++) {
+        h1 = random_mix64(h1 + 0x9E3779B97F4A7C15ULL);
+        h2 = random_mix64(h2 ^ h1);
+        words[j] = h1 ^ (h2 << 1);
+    }
+    mpz_import(child, 4, -1, sizeof(uint64_t), 0, 0, words);
+}
+
+PyDoc_STRVAR(GMPy_doc_random_state_split,
+"x.split(n) -> list\n\n"
+"Return a list of n new random states whose streams are independent of\n"
+"each other and of x. The streams only depend on the seed of x and the\n"
+"number of streams already split from it, so they are reproducible.");
+
+static PyObject *
+GMPy_RandomState_Split(PyObject *self, PyObject *other)
+{
+    RandomState_Object *state = (RandomState_Object*)self, *temp;
+    PyObject *result;
+    Py_ssize_t i, n;
+
+    n = ssize_t_From_Integer(other);
+    if (n == -1 && PyErr_Occurred())
+        return NULL;
+    if (n < 0) {
+        VALUE_ERROR("split() requires n >= 0");
+        return NULL;
+    }
+
+    if (!(result = PyList_New(n)))
+        return NULL;
+    for (i = 0; i < n; i++) {
+        if (!(temp = GMPy_RandomState_New())) {
+            Py_DECREF(result);
+            return NULL;
+        }
+        random_derive_key(temp->key, state->key, state->spawned++);
+        gmp_randseed(temp->state, temp->key);
+        PyList_SET_ITEM(result, i, (PyObject*)temp);
+    }
+    return result;
+}
+
+PyDoc_STRVAR(GMPy_doc_random_state_jump,
+"x.jump()\n\n"
+"Move x to a new stream that does not overlap the values it produced\n"
+"before or any stream split from it. Jumps are reproducible in the\n"
+"same way as split().");
+
+static PyObject *
+GMPy_RandomState_Jump(PyObject *self, PyObject *args)
+{
+    RandomState_Object *state = (RandomState_Object*)self;
+
+    random_derive_key(state->key, state->key, state->spawned);
+    state->spawned = 0;
+    gmp_randseed(state->state, state->key);
+    Py_RETURN_NONE;
+}
+
+/* Parse the keyword arguments shared by the random functions. count is set
+ * to -1 when no count was given, in which case a single value is returned.
+ * raw is only accepted when it is not NULL.
+ */
+
+static int
+GMPy_Random_Keywords(PyObject *kwargs, const char *name,
+                     Py_ssize_t *count, int *raw)
+{
+    static char *kwlist_raw[] = {"count", "raw", NULL};
+    static char *kwlist[] = {"count", NULL};
+    PyObject *empty, *c = Py_None, *r = Py_False;
+    int ok;
+
+    *count = -1;
+    if (raw)
+        *raw = 0;
+    if (!kwargs)
+        return 0;
+
+    if (!(empty = PyTuple_New(0)))
+        return -1;
+    if (raw)
+        ok = PyArg_ParseTupleAndKeywords(empty, kwargs, "|OO", kwlist_raw, &c, &r);
+    else
+        ok = PyArg_ParseTupleAndKeywords(empty, kwargs, "|O", kwlist, &c);
+    Py_DECREF(empty);
+    if (!ok)
+        return -1;
+
+    if (c != Py_None) {
+        *count = ssize_t_From_Integer(c);
+        if (*count == -1 && PyErr_Occurred()) {
+            PyErr_Format(PyExc_TypeError,
+                         "%s() count must be an integer", name);
+            return -1;
+        }
+        if (*count < 0) {
+            PyErr_Format(PyExc_ValueError,
+                         "%s() requires count >= 0", name);
+            return -1;
+        }
+    }
+    if (raw && (*raw = PyObject_IsTrue(r)) < 0)
+        return -1;
+    return 0;
+}
+
+/* Return each of the count values of an mpz_urandomb() call as a fixed
+ * width little-endian field of (len+7)/8 bytes.
+ */
+
+static PyObject *
+GMPy_MPZ_urandomb_Raw(gmp_randstate_t state, mp_bitcnt_t len, Py_ssize_t count)
+{
+    PyObject *result;
+    unsigned char *buf;
+    size_t width = (size_t)((len + 7) / 8);
+    mpz_t temp;
+    Py_ssize_t i;
+
+    if (width && (size_t)count > (size_t)PY_SSIZE_T_MAX / width)
+        return PyErr_NoMemory();
+    if (!(result = PyBytes_FromStringAndSize(NULL, (Py_ssize_t)(count * width))))
+        return NULL;
+
+    buf = (unsigned char *)PyBytes_AS_STRING(result);
+    memset(buf, 0, count * width);
+    mpz_init(temp);
+    for (i = 0; i < count; i++) {
+        mpz_urandomb(temp, state, len);
+        mpz_export(buf + i * width, NULL, -1, 1, 0, 0, temp);
+    }
+    mpz_clear(temp);
+    return result;
+}
 
 PyDoc_STRVAR(GMPy_doc_mpz_urandomb_function,
-"mpz_urandomb(random_state, bit_count) -> mpz\n\n"
+"mpz_urandomb(random_state, bit_count, *, count=None, raw=False) -> mpz\n\n"
 "Return uniformly distributed random integer between 0 and\n"
-"2**bit_count-1.");
+"2**bit_count-1. If count is given, return a list of count integers.\n"
+"If raw is also true, return a bytes object instead that holds each\n"
+"integer as a little-endian field of (bit_count+7)//8 bytes.");
 
 static PyObject *
-GMPy_MPZ_urandomb_Function(PyObject *self, PyObject *args)
+GMPy_MPZ_urandomb_Function(PyObject *self, PyObject *args, PyObject *kwargs)
 {
     MPZ_Object *result;
+    PyObject *list;
     mp_bitcnt_t len;
+    Py_ssize_t count, i;
+    int raw;
 
     if (PyTuple_GET_SIZE(args) != 2) {
         TYPE_ERROR("mpz_urandomb() requires 2 arguments");
@@ -111,23 +299,51 @@ GMPy_MPZ_urandomb_Function(PyObject *self, PyObject *args)
         return NULL;
     }
 
-    if ((result = GMPy_MPZ_New(NULL))) {
-        mpz_urandomb(result->z, RANDOM_STATE(PyTuple_GET_ITEM(args, 0)), len);
+    if (GMPy_Random_Keywords(kwargs, "mpz_urandomb", &count, &raw) < 0)
+        return NULL;
+
+    if (raw) {
+        if (count < 0) {
+            VALUE_ERROR("mpz_urandomb() raw output requires count");
+            return NULL;
+        }
+        return GMPy_MPZ_urandomb_Raw(RANDOM_STATE(PyTuple_GET_ITEM(args, 0)),
+                                     len, count);
     }
 
-    return (PyObject*)result;
+    if (count < 0) {
+        if ((result = GMPy_MPZ_New(NULL))) {
+            mpz_urandomb(result->z, RANDOM_STATE(PyTuple_GET_ITEM(args, 0)), len);
+        }
+        return (PyObject*)result;
+    }
+
+    if (!(list = PyList_New(count)))
+        return NULL;
+    for (i = 0; i < count; i++) {
+        if (!(result = GMPy_MPZ_New(NULL))) {
+            Py_DECREF(list);
+            return NULL;
+        }
+        mpz_urandomb(result->z, RANDOM_STATE(PyTuple_GET_ITEM(args, 0)), len);
+        PyList_SET_ITEM(list, i, (PyObject*)result);
+    }
+    return list;
 }
 
 PyDoc_STRVAR(GMPy_doc_mpz_rrandomb_function,
-"mpz_rrandomb(random_state, bit_count) -> mpz\n\n"
+"mpz_rrandomb(random_state, bit_count, *, count=None) -> mpz\n\n"
 "Return a random integer between 0 and 2**bit_count-1 with long\n"
-"sequences of zeros and one in its binary representation.");
+"sequences of zeros and one in its binary representation. If count\n"
+"is given, return a list of count integers.");
 
 static PyObject *
-GMPy_MPZ_rrandomb_Function(PyObject *self, PyObject *args)
+GMPy_MPZ_rrandomb_Function(PyObject *self, PyObject *args, PyObject *kwargs)
 {
     MPZ_Object *result;
+    PyObject *list;
     mp_bitcnt_t len;
+    Py_ssize_t count, i;
 
     if (PyTuple_GET_SIZE(args) != 2) {
         TYPE_ERROR("mpz_rrandomb() requires 2 arguments");
@@ -145,21 +361,40 @@ GMPy_MPZ_rrandomb_Function(PyObject *self, PyObject *args)
         return NULL;
     }
 
-    if ((result = GMPy_MPZ_New(NULL))) {
-        mpz_rrandomb(result->z, RANDOM_STATE(PyTuple_GET_ITEM(args, 0)), len);
+    if (GMPy_Random_Keywords(kwargs, "mpz_rrandomb", &count, NULL) < 0)
+        return NULL;
+
+    if (count < 0) {
+        if ((result = GMPy_MPZ_New(NULL))) {
+            mpz_rrandomb(result->z, RANDOM_STATE(PyTuple_GET_ITEM(args, 0)), len);
+        }
+        return (PyObject*)result;
     }
 
-    return (PyObject*)result;
+    if (!(list = PyList_New(count)))
+        return NULL;
+    for (i = 0; i < count; i++) {
+        if (!(result = GMPy_MPZ_New(NULL))) {
+            Py_DECREF(list);
+            return NULL;
+        }
+        mpz_rrandomb(result->z, RANDOM_STATE(PyTuple_GET_ITEM(args, 0)), len);
+        PyList_SET_ITEM(list, i, (PyObject*)result);
+    }
+    return list;
 }
 
 PyDoc_STRVAR(GMPy_doc_mpz_random_function,
-"mpz_random(random_state, int) -> mpz\n\n"
-"Return uniformly distributed random integer between 0 and n-1.");
+"mpz_random(random_state, int, *, count=None) -> mpz\n\n"
+"Return uniformly distributed random integer between 0 and n-1. If\n"
+"count is given, return a list of count integers.");
 
 static PyObject *
-GMPy_MPZ_random_Function(PyObject *self, PyObject *args)
+GMPy_MPZ_random_Function(PyObject *self, PyObject *args, PyObject *kwargs)
 {
     MPZ_Object *result, *temp;
+    PyObject *list = NULL;
+    Py_ssize_t count, i;
 
     if (PyTuple_GET_SIZE(args) != 2) {
         TYPE_ERROR("mpz_random() requires 2 arguments");
@@ -176,22 +411,46 @@ GMPy_MPZ_random_Function(PyObject *self, PyObject *args)
         return NULL;
     }
 
-    if ((result = GMPy_MPZ_New(NULL))) {
-        mpz_urandomm(result->z, RANDOM_STATE(PyTuple_GET_ITEM(args, 0)), temp->z);
+    if (GMPy_Random_Keywords(kwargs, "mpz_random", &count, NULL) < 0) {
+        Py_DECREF((PyObject*)temp);
+        return NULL;
     }
 
+    if (count < 0) {
+        if ((result = GMPy_MPZ_New(NULL))) {
+            mpz_urandomm(result->z, RANDOM_STATE(PyTuple_GET_ITEM(args, 0)), temp->z);
+        }
+        Py_DECREF((PyObject*)temp);
+        return (PyObject*)result;
+    }
+
+    if (!(list = PyList_New(count))) {
+        Py_DECREF((PyObject*)temp);
+        return NULL;
+    }
+    for (i = 0; i < count; i++) {
+        if (!(result = GMPy_MPZ_New(NULL))) {
+            Py_CLEAR(list);
+            break;
+        }
+        mpz_urandomm(result->z, RANDOM_STATE(PyTuple_GET_ITEM(args, 0)), temp->z);
+        PyList_SET_ITEM(list, i, (PyObject*)result);
+    }
     Py_DECREF((PyObject*)temp);
-    return (PyObject*)result;
+    return list;
 }
 
 PyDoc_STRVAR(GMPy_doc_mpfr_random_function,
-"mpfr_random(random_state) -> mpfr\n\n"
-"Return uniformly distributed number between [0,1].");
+"mpfr_random(random_state, *, count=None) -> mpfr\n\n"
+"Return uniformly distributed number between [0,1]. If count is\n"
+"given, return a list of count numbers.");
 
 static PyObject *
-GMPy_MPFR_random_Function(PyObject *self, PyObject *args)
+GMPy_MPFR_random_Function(PyObject *self, PyObject *args, PyObject *kwargs)
 {
     MPFR_Object *result;
+    PyObject *list;
+    Py_ssize_t count, i;
     CTXT_Object *context = NULL;
 
     CHECK_CONTEXT(context);
@@ -206,22 +465,41 @@ GMPy_MPFR_random_Function(PyObject *self, PyObject *args)
         return NULL;
     }
 
-    if ((result = GMPy_MPFR_New(0, context))) {
-        mpfr_urandom(result->f, RANDOM_STATE(PyTuple_GET_ITEM(args, 0)), GET_MPFR_ROUND(context));
+    if (GMPy_Random_Keywords(kwargs, "mpfr_random", &count, NULL) < 0)
+        return NULL;
+
+    if (count < 0) {
+        if ((result = GMPy_MPFR_New(0, context))) {
+            mpfr_urandom(result->f, RANDOM_STATE(PyTuple_GET_ITEM(args, 0)), GET_MPFR_ROUND(context));
+        }
+        return (PyObject*)result;
     }
 
-    return (PyObject*)result;
+    if (!(list = PyList_New(count)))
+        return NULL;
+    for (i = 0; i < count; i++) {
+        if (!(result = GMPy_MPFR_New(0, context))) {
+            Py_DECREF(list);
+            return NULL;
+        }
+        mpfr_urandom(result->f, RANDOM_STATE(PyTuple_GET_ITEM(args, 0)), GET_MPFR_ROUND(context));
+        PyList_SET_ITEM(list, i, (PyObject*)result);
+    }
+    return list;
 }
 
 PyDoc_STRVAR(GMPy_doc_mpfr_grandom_function,
-"mpfr_grandom(random_state) -> (mpfr, mpfr)\n\n"
-"Return two random numbers with gaussian distribution.");
+"mpfr_grandom(random_state, *, count=None) -> (mpfr, mpfr)\n\n"
+"Return two random numbers with gaussian distribution. If count is\n"
+"given, return a list of count numbers instead.");
 
 static PyObject *
-GMPy_MPFR_grandom_Function(PyObject *self, PyObject *args)
+GMPy_MPFR_grandom_Function(PyObject *self, PyObject *args, PyObject *kwargs)
 {
     MPFR_Object *result1, *result2;
     PyObject *result;
+    Py_ssize_t count, i;
+    mpfr_t spare;
     CTXT_Object *context = NULL;
 
     CHECK_CONTEXT(context);
@@ -236,6 +514,44 @@ GMPy_MPFR_grandom_Function(PyObject *self, PyObject *args)
         return NULL;
     }
 
+    if (GMPy_Random_Keywords(kwargs, "mpfr_grandom", &count, NULL) < 0)
+        return NULL;
+
+    if (count >= 0) {
+        /* The numbers are generated in pairs; the second number of the
+         * last pair is discarded when count is odd. */
+        if (!(result = PyList_New(count)))
+            return NULL;
+        for (i = 0; i + 1 < count; i += 2) {
+            result1 = GMPy_MPFR_New(0, context);
+            result2 = GMPy_MPFR_New(0, context);
+            if (!result1 || !result2) {
+                Py_XDECREF((PyObject*)result1);
+                Py_XDECREF((PyObject*)result2);
+                Py_DECREF(result);
+                return NULL;
+            }
+            mpfr_grandom(result1->f, result2->f,
+                         RANDOM_STATE(PyTuple_GET_ITEM(args, 0)),
+                         GET_MPFR_ROUND(context));
+            PyList_SET_ITEM(result, i, (PyObject*)result1);
+            PyList_SET_ITEM(result, i + 1, (PyObject*)result2);
+        }
+        if (i < count) {
+            if (!(result1 = GMPy_MPFR_New(0, context))) {
+                Py_DECREF(result);
+                return NULL;
+            }
+            mpfr_init2(spare, mpfr_get_prec(result1->f));
+            mpfr_grandom(result1->f, spare,
+                         RANDOM_STATE(PyTuple_GET_ITEM(args, 0)),
+                         GET_MPFR_ROUND(context));
+            mpfr_clear(spare);
+            PyList_SET_ITEM(result, i, (PyObject*)result1);
+        }
+        return result;
+    }
+
     result1 = GMPy_MPFR_New(0, context);
     result2 = GMPy_MPFR_New(0, context);
     if (!result1 || !result2) {
@@ -261,29 +577,37 @@ PyDoc_STRVAR(GMPy_doc_mpc_random_function,
 "Return uniformly distributed number in the unit square [0,1]x[0,1].");
 
 static PyObject *
-GMPy_MPC_random_Function(PyObject *self, PyObject *args)
+GMPy_MPC_random_Function(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     MPC_Object *result;
     CTXT_Object *context = NULL;
 
     CHECK_CONTEXT(context);
 
-    if (PyTuple_GET_SIZE(args) != 1) {
+    if (nargs != 1) {
         TYPE_ERROR("mpfc_random() requires 1 argument");
         return NULL;
     }
 
-    if (!RandomState_Check(PyTuple_GET_ITEM(args, 0))) {
+    if (!RandomState_Check(args[0])) {
         TYPE_ERROR("mpc_random() requires 'random_state' argument");
         return NULL;
     }
 
     if ((result = GMPy_MPC_New(0, 0, context))) {
-        mpc_urandom(result->c, RANDOM_STATE(PyTuple_GET_ITEM(args, 0)));
+        mpc_urandom(result->c, RANDOM_STATE(args[0]));
     }
 
     return (PyObject*)result;
 }
+GMPY_FASTCALL_WRAPPER(GMPy_MPC_random_Function)
+
+static PyMethodDef GMPy_RandomState_methods [] =
+{
+    { "jump", GMPy_RandomState_Jump, METH_NOARGS, GMPy_doc_random_state_jump },
+    { "split", GMPy_RandomState_Split, METH_O, GMPy_doc_random_state_split },
+    { NULL, NULL, 1 }
+};
 
 static PyTypeObject RandomState_Type =
 {
@@ -319,7 +643,7 @@ static PyTypeObject RandomState_Type =
         0,                                  /* tp_weaklistoffset*/
         0,                                  /* tp_iter          */
         0,                                  /* tp_iternext      */
-        0,                                  /* tp_methods       */
+    GMPy_RandomState_methods,               /* tp_methods       */
         0,                                  /* tp_members       */
         0,                                  /* tp_getset        */
 };
@@ -41,9 +41,16 @@ extern "C" {
  * This file is expected to be included from gmpy.h
  */
 
+/* Independent streams are derived from a random state by mixing its key
+ * with the number of streams derived from it so far. key is the seed the
+ * state was created with.
+ */
+
 typedef struct {
     PyObject_HEAD
     gmp_randstate_t state;
+    mpz_t key;
+    uint64_t spawned;       /* number of streams derived from key */
 } RandomState_Object;
 
 static PyTypeObject RandomState_Type;
@@ -54,13 +61,15 @@ static RandomState_Object * GMPy_RandomState_New(void);
 static void                 GMPy_RandomState_Dealloc(RandomState_Object *self);
 
 static PyObject * GMPy_RandomState_Repr(RandomState_Object *self);
-static PyObject * GMPy_RandomState_Factory(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPZ_urandomb_Function(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPZ_rrandomb_Function(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPZ_random_Function(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPFR_random_Function(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPFR_grandom_Function(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPC_random_Function(PyObject *self, PyObject *args);
+static PyObject * GMPy_RandomState_Factory(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPy_RandomState_Split(PyObject *self, PyObject *other);
+static PyObject * GMPy_RandomState_Jump(PyObject *self, PyObject *args);
+static PyObject * GMPy_MPZ_urandomb_Function(PyObject *self, PyObject *args, PyObject *kwargs);
+static PyObject * GMPy_MPZ_rrandomb_Function(PyObject *self, PyObject *args, PyObject *kwargs);
+static PyObject * GMPy_MPZ_random_Function(PyObject *self, PyObject *args, PyObject *kwargs);
+static PyObject * GMPy_MPFR_random_Function(PyObject *self, PyObject *args, PyObject *kwargs);
+static PyObject * GMPy_MPFR_grandom_Function(PyObject *self, PyObject *args, PyObject *kwargs);
+static PyObject * GMPy_MPC_random_Function(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 
 #ifdef __cplusplus
 }
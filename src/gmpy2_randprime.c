@@ -0,0 +1,303 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_randprime.c                                                       *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* This file implements random_prime() and random_safe_prime().
+ *
+ * A random odd starting point with the requested number of bits is chosen
+ * and a window of odd candidates above it is sieved with the odd primes
+ * below PRP_TRIAL_MAX. The survivors are tested in order; a Fermat test to
+ * the base 2 rejects almost all composites and runs without the GIL, and
+ * only the numbers that pass it get the full BPSW test. When the window is
+ * exhausted a new starting point is chosen.
+ *
+ * For a safe prime p = 2*q + 1 the sieve removes the candidates q where
+ * either q or p has a small factor. If q is prime, 2**(p-1) == 1 (mod p)
+ * and p is not divisible by 3, then p is prime by Pocklington's theorem,
+ * so only q needs the full BPSW test.
+ */
+
+/* Number of odd candidates in each window. */
+#define RANDPRIME_WINDOW 4096
+
+/* Clear sieve[i] if start + 2*i has a prime factor below the limit, or
+ * if safe is set, if start + 2*i or 2*(start + 2*i) + 1 has one. start
+ * must be odd and larger than limit. */
+
+static void
+randprime_sieve(unsigned char *sieve, mpz_srcptr start, unsigned long limit,
+                int safe)
+{
+    mp_size_t size = mpz_size(start);
+    unsigned long g, k = 0, p, r, half, i;
+
+    memset(sieve, 1, RANDPRIME_WINDOW);
+    for (g = 0; g < prp_trial.ngroups; g++) {
+        r = mpn_mod_1(start->_mp_d, size, prp_trial.products[g]);
+        for (; k < prp_trial.ends[g]; k++) {
+            p = prp_trial.primes[k];
+            if (p >= limit)
+                return;
+            /* start + 2*i == 0 (mod p) for i == -start / 2 (mod p) */
+            half = (p + 1) / 2;
+            for (i = (p - r % p) % p * half % p; i < RANDPRIME_WINDOW; i += p)
+                sieve[i] = 0;
+            /* 2*(start + 2*i) + 1 == 0 (mod p) for
+             * i == (-1/2 - start) / 2 (mod p) */
+            if (safe) {
+                for (i = (half - 1 + p - r % p) % p * half % p;
+                     i < RANDPRIME_WINDOW; i += p)
+                    sieve[i] = 0;
+            }
+        }
+    }
+}
+
+/* Return 1 if n is a Fermat probable prime to the base 2. */
+
+static int
+randprime_fermat(mpz_srcptr n, mpz_t t, mpz_t e)
+{
+    mpz_sub_ui(e, n, 1);
+    mpz_set_ui(t, 2);
+    mpz_powm(t, t, e, n);
+    return mpz_cmp_ui(t, 1) == 0;
+}
+
+/* Return the index of the next survivor of the sieve at or after pos that
+ * is prime (single limb candidates) or passes the Fermat test. Returns -1
+ * when the window is exhausted or the candidates grow beyond bits. The
+ * candidate is returned in c. Does not use the Python API. */
+
+static Py_ssize_t
+randprime_scan(const unsigned char *sieve, Py_ssize_t pos, mpz_srcptr start,
+               mp_bitcnt_t bits, int safe, mpz_t c, mpz_t p, mpz_t t, mpz_t e)
+{
+    for (; pos < RANDPRIME_WINDOW; pos++) {
+        if (!sieve[pos])
+            continue;
+        mpz_add_ui(c, start, 2 * (unsigned long)pos);
+        if (safe) {
+            mpz_mul_2exp(p, c, 1);
+            mpz_add_ui(p, p, 1);
+        }
+        else {
+            mpz_set(p, c);
+        }
+        if (mpz_sizeinbase(p, 2) > bits)
+            return -1;
+        if (mpz_size(p) == 1) {
+            if (prp_word_is_prime(mpz_getlimbn(c, 0)) &&
+                (!safe || prp_word_is_prime(mpz_getlimbn(p, 0))))
+                return pos;
+            continue;
+        }
+        if (randprime_fermat(c, t, e) && (!safe || randprime_fermat(p, t, e)))
+            return pos;
+    }
+    return -1;
+}
+
+/* Return 1 if the odd n > 4 is a strong probable prime to the base a. */
+
+static int
+randprime_sprp(mpz_srcptr n, mpz_srcptr a, mpz_t t, mpz_t d)
+{
+    mp_bitcnt_t r, s;
+
+    mpz_sub_ui(d, n, 1);
+    s = mpz_scan1(d, 0);
+    mpz_tdiv_q_2exp(d, d, s);
+    mpz_powm(t, a, d, n);
+    mpz_sub_ui(d, n, 1);
+    if (mpz_cmp_ui(t, 1) == 0 || mpz_cmp(t, d) == 0)
+        return 1;
+    for (r = 1; r < s; r++) {
+        mpz_powm_ui(t, t, 2, n);
+        if (mpz_cmp(t, d) == 0)
+            return 1;
+        if (mpz_cmp_ui(t, 1) == 0)
+            return 0;
+    }
+    return 0;
+}
+
+/* Set result to a random prime with exactly bits bits, or a safe prime if
+ * safe is set. Candidates that are not proven prime must also pass
+ * mr_rounds Miller-Rabin tests with random bases. Returns -1 on error. */
+
+static int
+randprime_search(mpz_t result, RandomState_Object *state, mp_bitcnt_t bits,
+                 Py_ssize_t mr_rounds, int safe)
+{
+    unsigned char *sieve;
+    unsigned long limit;
+    mp_bitcnt_t sbits = safe ? bits - 1 : bits;
+    Py_ssize_t pos, i;
+    mpz_t start, c, p, t, e;
+    int r = -1, prime;
+
+    if (!(sieve = GMPY_MALLOC(RANDPRIME_WINDOW))) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    mpz_init(start);
+    mpz_init(c);
+    mpz_init(p);
+    mpz_init(t);
+    mpz_init(e);
+
+    PRP_TRIAL_INIT();
+
+    /* Only sieve with primes below the smallest candidate, so that no
+     * candidate is removed for being one of the sieving primes. */
+    limit = (sbits - 1 < 17) ? 1UL << (sbits - 1) : PRP_TRIAL_MAX;
+
+    while (1) {
+        mpz_urandomb(start, state->state, sbits - 1);
+        mpz_setbit(start, sbits - 1);
+        mpz_setbit(start, 0);
+
+        pos = 0;
+        while (1) {
+            GMPY_BEGIN_NOGIL(bits);
+            if (pos == 0)
+                randprime_sieve(sieve, start, limit, safe);
+            pos = randprime_scan(sieve, pos, start, bits, safe, c, p, t, e);
+            GMPY_END_NOGIL;
+            if (pos < 0)
+                break;
+            pos++;
+            if (mpz_size(p) == 1) {
+                mpz_set(result, p);
+                r = 0;
+                goto done;
+            }
+            if ((prime = prp_is_prime(c)) < 0)
+                goto done;
+            for (i = 0; prime && i < mr_rounds; i++) {
+                /* A random base between 2 and c - 2. */
+                mpz_sub_ui(e, c, 3);
+                mpz_urandomm(e, state->state, e);
+                mpz_add_ui(e, e, 2);
+                prime = randprime_sprp(c, e, t, p);
+            }
+            if (prime) {
+                if (safe) {
+                    mpz_mul_2exp(result, c, 1);
+                    mpz_add_ui(result, result, 1);
+                }
+                else {
+                    mpz_set(result, c);
+                }
+                r = 0;
+                goto done;
+            }
+        }
+        if (PyErr_CheckSignals())
+            goto done;
+    }
+
+  done:
+    GMPY_FREE(sieve);
+    mpz_clear(start);
+    mpz_clear(c);
+    mpz_clear(p);
+    mpz_clear(t);
+    mpz_clear(e);
+    return r;
+}
+
+static PyObject *
+randprime_parse(PyObject *args, PyObject *kwargs, const char *name,
+                mp_bitcnt_t min_bits, int safe)
+{
+    static char *kwlist[] = {"random_state", "bits", "mr_rounds", NULL};
+    PyObject *state;
+    Py_ssize_t bits, mr_rounds = 0;
+    MPZ_Object *result;
+    char format[32];
+
+    sprintf(format, "On|n:%s", name);
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, format, kwlist,
+                                     &state, &bits, &mr_rounds))
+        return NULL;
+    if (!RandomState_Check(state)) {
+        PyErr_Format(PyExc_TypeError,
+                     "%s() requires 'random_state' and 'bits' arguments", name);
+        return NULL;
+    }
+    if (bits < (Py_ssize_t)min_bits) {
+        PyErr_Format(PyExc_ValueError,
+                     "%s() requires bits >= %d", name, (int)min_bits);
+        return NULL;
+    }
+    if (mr_rounds < 0) {
+        VALUE_ERROR("mr_rounds must be >= 0");
+        return NULL;
+    }
+
+    if (!(result = GMPy_MPZ_New(NULL)))
+        return NULL;
+    if (bits == 2) {
+        /* Both 2 and 3 have two bits. */
+        mpz_urandomb(result->z, RANDOM_STATE(state), 1);
+        mpz_add_ui(result->z, result->z, 2);
+    }
+    else if (randprime_search(result->z, (RandomState_Object*)state,
+                              (mp_bitcnt_t)bits, mr_rounds, safe) < 0) {
+        Py_DECREF((PyObject*)result);
+        return NULL;
+    }
+    return (PyObject*)result;
+}
+
+PyDoc_STRVAR(GMPy_doc_mpz_function_random_prime,
+"random_prime(random_state, bits, mr_rounds=0) -> mpz\n\n"
+"Return a random prime with exactly bits bits, i.e. a prime p with\n"
+"2**(bits-1) <= p < 2**bits. The result is a BPSW probable prime; if\n"
+"mr_rounds is given, it also passes that many Miller-Rabin tests with\n"
+"random bases. The search releases the GIL while testing candidates.");
+
+static PyObject *
+GMPy_MPZ_Function_RandomPrime(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    return randprime_parse(args, kwargs, "random_prime", 2, 0);
+}
+
+PyDoc_STRVAR(GMPy_doc_mpz_function_random_safe_prime,
+"random_safe_prime(random_state, bits, mr_rounds=0) -> mpz\n\n"
+"Return a random safe prime p with exactly bits bits, i.e. p and\n"
+"(p-1)//2 are both prime. (p-1)//2 is a BPSW probable prime and, if\n"
+"mr_rounds is given, also passes that many Miller-Rabin tests with\n"
+"random bases; the primality of p then follows from Pocklington's\n"
+"theorem. The search releases the GIL while testing candidates.");
+
+static PyObject *
+GMPy_MPZ_Function_RandomSafePrime(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    return randprime_parse(args, kwargs, "random_safe_prime", 3, 1);
+}
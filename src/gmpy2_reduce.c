@@ -0,0 +1,392 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_reduce.c                                                          *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* Chunked reductions on the thread pool, see gmpy2_reduce.h. */
+
+static Py_ssize_t
+reduce_chunks(Py_ssize_t n)
+{
+    return (n + REDUCE_CHUNK - 1) / REDUCE_CHUNK;
+}
+
+static Py_ssize_t
+reduce_chunk_end(Py_ssize_t c, Py_ssize_t n)
+{
+    return (c + 1) * REDUCE_CHUNK < n ? (c + 1) * REDUCE_CHUNK : n;
+}
+
+/* fsum() with threads=. */
+
+typedef struct {
+    mpfr_ptr *tab;              /* the items */
+    Py_ssize_t n;
+    mpfr_t *part;               /* exact sum of each chunk */
+    char *status;               /* 1: invalid operation, 2: too large */
+    mpfr_rnd_t round;
+} fsum_job;
+
+static void
+fsum_chunk_run(void *arg, Py_ssize_t start, Py_ssize_t stop)
+{
+    fsum_job *job = (fsum_job*)arg;
+    mpfr_exp_t emin, emax;
+    Py_ssize_t c, lo;
+
+    GMPY_MPFR_WIDEN_RANGE(emin, emax);
+    for (c = start; c < stop; c++) {
+        lo = c * REDUCE_CHUNK;
+        mpfr_clear_flags();
+        if (!fsum_exact(job->part[c], job->tab + lo,
+                        reduce_chunk_end(c, job->n) - lo, job->round))
+            job->status[c] = 2;
+        else if (mpfr_nanflag_p())
+            job->status[c] = 1;
+    }
+    GMPY_MPFR_RESTORE_RANGE(emin, emax);
+}
+
+static int
+GMPy_Reduce_Fsum(mpfr_ptr acc, PyObject *iterable, int threads,
+                 int *invalid, CTXT_Object *context)
+{
+    PyObject *seq, **items, **held = NULL;
+    fsum_job job = { NULL, 0, NULL, NULL, GET_MPFR_ROUND(context) };
+    mpfr_ptr *parts = NULL;
+    mpfr_exp_t emin, emax;
+    size_t *cost = NULL, total = 0;
+    Py_ssize_t i, c, nchunks, nheld = 0;
+    int success = -1, exact;
+
+    mpfr_set_zero(acc, 1);
+    *invalid = 0;
+
+    if (!(seq = PySequence_Fast(iterable, "argument must be an iterable")))
+        return -1;
+    job.n = PySequence_Fast_GET_SIZE(seq);
+    items = PySequence_Fast_ITEMS(seq);
+    nchunks = reduce_chunks(job.n);
+    if (nchunks == 0) {
+        Py_DECREF(seq);
+        return 0;
+    }
+
+    if (!(held = GMPY_MALLOC(sizeof(PyObject*) * job.n)) ||
+        !(job.tab = GMPY_MALLOC(sizeof(mpfr_ptr) * job.n)) ||
+        !(job.part = GMPY_MALLOC(sizeof(mpfr_t) * nchunks)) ||
+        !(parts = GMPY_MALLOC(sizeof(mpfr_ptr) * nchunks)) ||
+        !(job.status = GMPY_MALLOC(nchunks)) ||
+        !(cost = GMPY_MALLOC(sizeof(size_t) * nchunks))) {
+        PyErr_NoMemory();
+        goto done;
+    }
+
+    for (nheld = 0; nheld < job.n; nheld++) {
+        if (MPFR_Check(items[nheld])) {
+            Py_INCREF(items[nheld]);
+            held[nheld] = items[nheld];
+        }
+        else if (!(held[nheld] = (PyObject*)GMPy_MPFR_From_Real(items[nheld], 1, context))) {
+            TYPE_ERROR("all items in iterable must be real numbers");
+            goto done;
+        }
+        job.tab[nheld] = MPFR(held[nheld]);
+    }
+
+    for (c = 0; c < nchunks; c++) {
+        mpfr_init2(job.part[c], MPFR_PREC_MIN);
+        parts[c] = job.part[c];
+        job.status[c] = 0;
+        cost[c] = 0;
+        for (i = c * REDUCE_CHUNK; i < reduce_chunk_end(c, job.n); i++)
+            cost[c] += (size_t)mpfr_get_prec(job.tab[i]);
+        total += cost[c];
+    }
+
+    /* Without thread-local storage in MPFR the chunks are summed in the
+     * calling thread. */
+    if (GMPy_Pool_Run_Threads(fsum_chunk_run, &job, nchunks, cost,
+                              global.nogil_mpfr ? total : 0,
+                              global.nogil_mpfr ? threads : 1) < 0)
+        goto clear;
+
+    for (c = 0; c < nchunks; c++) {
+        if (job.status[c] == 2) {
+            OVERFLOW_ERROR("range of exponents is too large");
+            goto clear;
+        }
+        *invalid |= job.status[c];
+    }
+
+    GMPY_MPFR_WIDEN_RANGE(emin, emax);
+    mpfr_clear_flags();
+    exact = fsum_exact(acc, parts, nchunks, job.round);
+    *invalid |= mpfr_nanflag_p();
+    GMPY_MPFR_RESTORE_RANGE(emin, emax);
+    if (!exact)
+        OVERFLOW_ERROR("range of exponents is too large");
+    else
+        success = 0;
+
+  clear:
+    for (c = 0; c < nchunks; c++)
+        mpfr_clear(job.part[c]);
+  done:
+    for (i = 0; i < nheld; i++)
+        Py_DECREF(held[i]);
+    GMPY_FREE(cost);
+    GMPY_FREE(job.status);
+    GMPY_FREE(parts);
+    GMPY_FREE(job.part);
+    GMPY_FREE(job.tab);
+    GMPY_FREE(held);
+    Py_DECREF(seq);
+    return success;
+}
+
+/* prod() with threads=. The pairs of each level of the product tree are
+ * multiplied in parallel into 'out' and then moved back into z. */
+
+typedef struct {
+    mpz_t *z;
+    mpz_t *out;
+} prod_job;
+
+static void
+prod_level_run(void *arg, Py_ssize_t start, Py_ssize_t stop)
+{
+    prod_job *job = (prod_job*)arg;
+    Py_ssize_t i;
+
+    for (i = start; i < stop; i++)
+        mpz_mul(job->out[i], job->z[2 * i], job->z[2 * i + 1]);
+}
+
+static int
+GMPy_Reduce_Prod(mpz_t *z, Py_ssize_t n, int threads)
+{
+    prod_job job;
+    size_t *cost, total;
+    Py_ssize_t i, m;
+    int status = 0;
+
+    if (n < 2)
+        return 0;
+
+    job.z = z;
+    job.out = GMPY_MALLOC(sizeof(mpz_t) * (n / 2));
+    cost = GMPY_MALLOC(sizeof(size_t) * (n / 2));
+    if (!job.out || !cost) {
+        GMPY_FREE(job.out);
+        GMPY_FREE(cost);
+        PyErr_NoMemory();
+        return -1;
+    }
+    for (i = 0; i < n / 2; i++)
+        mpz_init(job.out[i]);
+
+    for (m = n; m > 1 && status == 0; m = (m + 1) / 2) {
+        total = 0;
+        for (i = 0; i < m / 2; i++) {
+            cost[i] = (mpz_size(z[2 * i]) + mpz_size(z[2 * i + 1])) * GMP_NUMB_BITS;
+            total += cost[i];
+        }
+        status = GMPy_Pool_Run_Threads(prod_level_run, &job, m / 2, cost, total, threads);
+        if (status == 0) {
+            for (i = 0; i < m / 2; i++)
+                mpz_swap(z[i], job.out[i]);
+            if (m & 1)
+                mpz_swap(z[m / 2], z[m - 1]);
+        }
+    }
+
+    for (i = 0; i < n / 2; i++)
+        mpz_clear(job.out[i]);
+    GMPY_FREE(job.out);
+    GMPY_FREE(cost);
+    return status;
+}
+
+/* sum() of integers or rationals. Rational chunks are added with
+ * qsum_merge(), so only the final sum is reduced. */
+
+typedef struct {
+    PyObject **items;           /* mpz, or mpq if rational is set */
+    Py_ssize_t n;
+    int rational;
+    mpz_t *zpart;
+    mpq_t *qpart;
+} sum_job;
+
+static void
+sum_chunk_run(void *arg, Py_ssize_t start, Py_ssize_t stop)
+{
+    sum_job *job = (sum_job*)arg;
+    Py_ssize_t c, i;
+    mpz_t g, t;
+
+    mpz_init(g);
+    mpz_init(t);
+    for (c = start; c < stop; c++) {
+        for (i = c * REDUCE_CHUNK; i < reduce_chunk_end(c, job->n); i++) {
+            if (job->rational)
+                qsum_merge(job->qpart[c], MPQ(job->items[i]), g, t);
+            else
+                mpz_add(job->zpart[c], job->zpart[c], MPZ(job->items[i]));
+        }
+    }
+    mpz_clear(g);
+    mpz_clear(t);
+}
+
+PyDoc_STRVAR(GMPy_doc_function_sum,
+"sum(iterable, threads=None) -> mpz or mpq\n\n"
+"Return the exact sum of the integers or rationals in the iterable, or\n"
+"mpz(0) if it is empty. The sum is an mpz if all the values are integers\n"
+"and an mpq otherwise. The values are added in chunks by up to 'threads'\n"
+"threads (default: the number set by set_threads()); the result does not\n"
+"depend on the number of threads.");
+
+static PyObject *
+GMPy_Function_Sum(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    static char *kwlist[] = {"iterable", "threads", NULL};
+    PyObject *iterable, *threads_obj = NULL, *seq, **items, *result = NULL;
+    sum_job job = { NULL, 0, 0, NULL, NULL };
+    MPZ_Object *resultz;
+    MPQ_Object *resultq;
+    size_t *cost = NULL, total = 0;
+    Py_ssize_t i, c, nchunks = 0, nitems = 0;
+    int threads, status;
+    mpz_t g, t;
+    CTXT_Object *context = NULL;
+
+    CHECK_CONTEXT(context);
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|O", kwlist,
+                                     &iterable, &threads_obj))
+        return NULL;
+    if ((threads = GMPy_Pool_Threads_Arg(threads_obj)) < 0)
+        return NULL;
+
+    if (!(seq = PySequence_Fast(iterable, "sum() argument must be an iterable")))
+        return NULL;
+    job.n = PySequence_Fast_GET_SIZE(seq);
+    items = PySequence_Fast_ITEMS(seq);
+
+    for (i = 0; i < job.n; i++) {
+        if (IS_INTEGER(items[i]))
+            continue;
+        if (!IS_RATIONAL(items[i])) {
+            TYPE_ERROR("sum() requires integer or rational arguments");
+            Py_DECREF(seq);
+            return NULL;
+        }
+        job.rational = 1;
+    }
+
+    nchunks = reduce_chunks(job.n);
+    if (!(job.items = GMPY_MALLOC(sizeof(PyObject*) * (job.n ? job.n : 1))) ||
+        !(cost = GMPY_MALLOC(sizeof(size_t) * (nchunks ? nchunks : 1))) ||
+        (job.rational ? !(job.qpart = GMPY_MALLOC(sizeof(mpq_t) * (nchunks ? nchunks : 1)))
+                      : !(job.zpart = GMPY_MALLOC(sizeof(mpz_t) * (nchunks ? nchunks : 1))))) {
+        PyErr_NoMemory();
+        nchunks = 0;
+        goto done;
+    }
+
+    for (nitems = 0; nitems < job.n; nitems++) {
+        if (job.rational)
+            job.items[nitems] = (PyObject*)GMPy_MPQ_From_Rational(items[nitems], context);
+        else
+            job.items[nitems] = (PyObject*)GMPy_MPZ_From_Integer(items[nitems], context);
+        if (!job.items[nitems]) {
+            nchunks = 0;
+            goto done;
+        }
+    }
+
+    for (c = 0; c < nchunks; c++) {
+        if (job.rational)
+            mpq_init(job.qpart[c]);
+        else
+            mpz_init(job.zpart[c]);
+        cost[c] = 0;
+        for (i = c * REDUCE_CHUNK; i < reduce_chunk_end(c, job.n); i++) {
+            if (job.rational)
+                cost[c] += qsum_bits(MPQ(job.items[i]));
+            else
+                cost[c] += mpz_size(MPZ(job.items[i])) * GMP_NUMB_BITS;
+        }
+        total += cost[c];
+    }
+
+    if ((status = GMPy_Pool_Run_Threads(sum_chunk_run, &job, nchunks, cost,
+                                        total, threads)) < 0)
+        goto done;
+
+    if (job.rational) {
+        if (!(resultq = GMPy_MPQ_New(context)))
+            goto done;
+        mpq_set_ui(resultq->q, 0, 1);
+        mpz_init(g);
+        mpz_init(t);
+        GMPY_BEGIN_NOGIL(total);
+        for (c = 0; c < nchunks; c++)
+            qsum_merge(resultq->q, job.qpart[c], g, t);
+        mpq_canonicalize(resultq->q);
+        GMPY_END_NOGIL;
+        mpz_clear(g);
+        mpz_clear(t);
+        result = (PyObject*)resultq;
+    }
+    else {
+        if (!(resultz = GMPy_MPZ_New(context)))
+            goto done;
+        mpz_set_ui(resultz->z, 0);
+        GMPY_BEGIN_NOGIL(total);
+        for (c = 0; c < nchunks; c++)
+            mpz_add(resultz->z, resultz->z, job.zpart[c]);
+        GMPY_END_NOGIL;
+        result = (PyObject*)resultz;
+    }
+
+  done:
+    for (c = 0; c < nchunks; c++) {
+        if (job.rational)
+            mpq_clear(job.qpart[c]);
+        else
+            mpz_clear(job.zpart[c]);
+    }
+    for (i = 0; i < nitems; i++)
+        Py_DECREF(job.items[i]);
+    GMPY_FREE(job.items);
+    GMPY_FREE(job.zpart);
+    GMPY_FREE(job.qpart);
+    GMPY_FREE(cost);
+    Py_DECREF(seq);
+    return result;
+}
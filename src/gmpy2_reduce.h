@@ -0,0 +1,58 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_reduce.h                                                          *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GMPY_REDUCE_H
+#define GMPY_REDUCE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Reductions that use the thread pool: sum(), and fsum() and prod() when
+ * they are called with threads=. The items are split into chunks of
+ * REDUCE_CHUNK items that do not depend on the number of threads. Each
+ * chunk is reduced exactly by one thread and the partial results are then
+ * combined in order, so the result is the same for any number of threads.
+ *
+ * GMPy_Reduce_Fsum() stores the exact sum of the real items of 'iterable'
+ * in acc, like fsum_accumulate(). GMPy_Reduce_Prod() multiplies z[0..n-1]
+ * and stores the product in z[0], like prod_tree(). Both return 0 on
+ * success and -1 with an exception set. 'threads' is the limit returned by
+ * GMPy_Pool_Threads_Arg().
+ */
+
+#define REDUCE_CHUNK 1024
+
+static int        GMPy_Reduce_Fsum(mpfr_ptr acc, PyObject *iterable, int threads,
+                                   int *invalid, CTXT_Object *context);
+static int        GMPy_Reduce_Prod(mpz_t *z, Py_ssize_t n, int threads);
+static PyObject * GMPy_Function_Sum(PyObject *self, PyObject *args, PyObject *kwargs);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
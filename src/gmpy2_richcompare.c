@@ -49,30 +49,20 @@ GMPy_RichCompare_Slot(PyObject *a, PyObject *b, int op)
     PyObject *tempa = NULL, *tempb = NULL, *result = NULL;
     CTXT_Object *context = NULL;
 
-    CHECK_CONTEXT(context);
-
+    /* Comparisons with an int or another mpz don't need the context. */
     if (CHECK_MPZANY(a)) {
         if (PyIntOrLong_Check(b)) {
-            int error;
-            long temp = GMPy_Integer_AsLongAndError(b, &error);
-            
-            if (!error) {
-                c = mpz_cmp_si(MPZ(a), temp);
-            }
-            else {
-                mpz_t tempz;
-                mpz_inoc(tempz);
-                mpz_set_PyIntOrLong(tempz, b);
-                c = mpz_cmp(MPZ(a), tempz);
-                mpz_cloc(tempz);
-            }
-            return _cmp_to_object(c, op);
+            return _cmp_to_object(mpz_cmp_PyIntOrLong(MPZ(a), b), op);
         }
-        
+
         if (CHECK_MPZANY(b)) {
             return _cmp_to_object(mpz_cmp(MPZ(a), MPZ(b)), op);
         }
-        
+    }
+
+    CHECK_CONTEXT(context);
+
+    if (CHECK_MPZANY(a)) {
         if (IS_INTEGER(b)) {
             if (!(tempb = (PyObject*)GMPy_MPZ_From_Integer(b, context))) {
                 return NULL;
@@ -222,7 +212,7 @@ GMPy_RichCompare_Slot(PyObject *a, PyObject *b, int op)
             c = mpfr_cmp(MPFR(a), MPFR(b));
             if (mpfr_erangeflag_p()) {
                 /* Set erange and check if an exception should be raised. */
-                context->ctx.erange = 1;
+                GMPY_FLAGS(context)->erange = 1;
                 if (context->ctx.traps & TRAP_ERANGE) {
                     GMPY_ERANGE("comparison with NaN");
                     return NULL;
@@ -242,7 +232,7 @@ GMPy_RichCompare_Slot(PyObject *a, PyObject *b, int op)
             c = mpfr_cmp_d(MPFR(a), d);
             if (mpfr_erangeflag_p()) {
                 /* Set erange and check if an exception should be raised. */
-                context->ctx.erange = 1;
+                GMPY_FLAGS(context)->erange = 1;
                 if (context->ctx.traps & TRAP_ERANGE) {
                     GMPY_ERANGE("comparison with NaN");
                     return NULL;
@@ -265,7 +255,7 @@ GMPy_RichCompare_Slot(PyObject *a, PyObject *b, int op)
             Py_DECREF(tempb);
             if (mpfr_erangeflag_p()) {
                 /* Set erange and check if an exception should be raised. */
-                context->ctx.erange = 1;
+                GMPY_FLAGS(context)->erange = 1;
                 if (context->ctx.traps & TRAP_ERANGE) {
                     GMPY_ERANGE("comparison with NaN");
                     return NULL;
@@ -288,7 +278,7 @@ GMPy_RichCompare_Slot(PyObject *a, PyObject *b, int op)
             Py_DECREF(tempb);
             if (mpfr_erangeflag_p()) {
                 /* Set erange and check if an exception should be raised. */
-                context->ctx.erange = 1;
+                GMPY_FLAGS(context)->erange = 1;
                 if (context->ctx.traps & TRAP_ERANGE) {
                     GMPY_ERANGE("comparison with NaN");
                     return NULL;
@@ -308,7 +298,7 @@ GMPy_RichCompare_Slot(PyObject *a, PyObject *b, int op)
             }
             if (!mpz_cmp_si(mpq_denref(MPQ(tempb)), 0)) {
                 if (!mpz_cmp_si(mpq_numref(MPQ(tempb)), 0)) {
-                    context->ctx.erange = 1;
+                    GMPY_FLAGS(context)->erange = 1;
                     if (context->ctx.traps & TRAP_ERANGE) {
                         GMPY_ERANGE("comparison with NaN");
                         return NULL;
@@ -333,7 +323,7 @@ GMPy_RichCompare_Slot(PyObject *a, PyObject *b, int op)
                 Py_DECREF(tempb);
                 if (mpfr_erangeflag_p()) {
                     /* Set erange and check if an exception should be raised. */
-                    context->ctx.erange = 1;
+                    GMPY_FLAGS(context)->erange = 1;
                     if (context->ctx.traps & TRAP_ERANGE) {
                         GMPY_ERANGE("comparison with NaN");
                         return NULL;
@@ -357,7 +347,7 @@ GMPy_RichCompare_Slot(PyObject *a, PyObject *b, int op)
             Py_DECREF(tempb);
             if (mpfr_erangeflag_p()) {
                 /* Set erange and check if an exception should be raised. */
-                context->ctx.erange = 1;
+                GMPY_FLAGS(context)->erange = 1;
                 if (context->ctx.traps & TRAP_ERANGE) {
                     GMPY_ERANGE("comparison with NaN");
                     return NULL;
@@ -382,7 +372,7 @@ GMPy_RichCompare_Slot(PyObject *a, PyObject *b, int op)
             c = mpc_cmp(MPC(a), MPC(b));
             if (mpfr_erangeflag_p()) {
                 /* Set erange and check if an exception should be raised. */
-                context->ctx.erange = 1;
+                GMPY_FLAGS(context)->erange = 1;
                 if (context->ctx.traps & TRAP_ERANGE) {
                     GMPY_ERANGE("comparison with NaN");
                     return NULL;
@@ -405,7 +395,7 @@ GMPy_RichCompare_Slot(PyObject *a, PyObject *b, int op)
             Py_DECREF(tempb);
             if (mpfr_erangeflag_p()) {
                 /* Set erange and check if an exception should be raised. */
-                context->ctx.erange = 1;
+                GMPY_FLAGS(context)->erange = 1;
                 if (context->ctx.traps & TRAP_ERANGE) {
                     GMPY_ERANGE("comparison with NaN");
                     return NULL;
@@ -422,7 +412,7 @@ GMPy_RichCompare_Slot(PyObject *a, PyObject *b, int op)
         if (!mpfr_zero_p(mpc_imagref(MPC(a)))) {
             /* if a.real is NaN, possibly raise exception */
             if (mpfr_nan_p(mpc_realref(MPC(a)))) {
-                context->ctx.erange = 1;
+                GMPY_FLAGS(context)->erange = 1;
                 if (context->ctx.traps & TRAP_ERANGE) {
                     GMPY_ERANGE("comparison with NaN");
                     return NULL;
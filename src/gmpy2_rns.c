@@ -0,0 +1,694 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_rns.c                                                             *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* This file implements the rns_int type and rns_many(), see gmpy2_rns.h.
+ *
+ * A value x is converted to residues with one mpz_fdiv_ui() per modulus;
+ * the divisions are independent and run on the thread pool. The value is
+ * converted back with GMPy_CRT_Basis_Combine_Values(). Operands that are
+ * integers are converted with the basis of the rns_int operand.
+ */
+
+#define RNS_ADD 0
+#define RNS_SUB 1
+#define RNS_MUL 2
+#define RNS_NEG 3
+#define RNS_POW 4
+
+/* Return a * b mod m for a, b < m. */
+
+static unsigned long
+rns_mulmod(unsigned long a, unsigned long b, unsigned long m)
+{
+#if ULONG_MAX <= 0xffffffffUL
+    return (unsigned long)(((unsigned long long)a * b) % m);
+#elif defined(__SIZEOF_INT128__)
+    return (unsigned long)(((unsigned __int128)a * b) % m);
+#else
+    mp_limb_t p[2], x = a;
+
+    p[1] = mpn_mul_1(p, &x, 1, b);
+    return (unsigned long)mpn_mod_1(p, 2, m);
+#endif
+}
+
+static unsigned long
+rns_powmod(unsigned long a, unsigned long e, unsigned long m)
+{
+    unsigned long r = 1 % m;
+
+    while (e) {
+        if (e & 1)
+            r = rns_mulmod(r, a, m);
+        a = rns_mulmod(a, a, m);
+        e >>= 1;
+    }
+    return r;
+}
+
+typedef struct {
+    int op;
+    const unsigned long *x;
+    const unsigned long *y;         /* NULL for RNS_NEG and RNS_POW */
+    unsigned long *r;
+    const unsigned long *m;
+    unsigned long e;                /* exponent for RNS_POW */
+} rns_job;
+
+static void
+rns_run(void *arg, Py_ssize_t start, Py_ssize_t stop)
+{
+    rns_job *job = (rns_job*)arg;
+    const unsigned long *x = job->x, *y = job->y, *m = job->m;
+    unsigned long *r = job->r, t;
+    Py_ssize_t i;
+
+    switch (job->op) {
+    case RNS_ADD:
+        for (i = start; i < stop; i++) {
+            t = x[i] + y[i];
+            r[i] = (t < x[i] || t >= m[i]) ? t - m[i] : t;
+        }
+        break;
+    case RNS_SUB:
+        for (i = start; i < stop; i++)
+            r[i] = x[i] >= y[i] ? x[i] - y[i] : x[i] - y[i] + m[i];
+        break;
+    case RNS_MUL:
+        for (i = start; i < stop; i++)
+            r[i] = rns_mulmod(x[i], y[i], m[i]);
+        break;
+    case RNS_NEG:
+        for (i = start; i < stop; i++)
+            r[i] = x[i] ? m[i] - x[i] : 0;
+        break;
+    default:
+        for (i = start; i < stop; i++)
+            r[i] = rns_powmod(x[i], job->e, m[i]);
+    }
+}
+
+/* Conversion of one value: the thread pool splits the moduli. */
+
+typedef struct {
+    mpz_srcptr x;
+    const unsigned long *m;
+    unsigned long *r;
+} rns_from_job;
+
+static void
+rns_from_run(void *arg, Py_ssize_t start, Py_ssize_t stop)
+{
+    rns_from_job *job = (rns_from_job*)arg;
+    Py_ssize_t i;
+
+    for (i = start; i < stop; i++)
+        job->r[i] = mpz_fdiv_ui(job->x, job->m[i]);
+}
+
+static void
+rns_from_mpz(CRT_Basis_Object *basis, mpz_srcptr x, unsigned long *r)
+{
+    rns_from_job job = { x, basis->words, r };
+
+    GMPy_Pool_Run(rns_from_run, &job, basis->n, NULL,
+                  (size_t)basis->n * (mpz_size(x) + 1) * GMP_NUMB_BITS);
+}
+
+static RNS_Object *
+rns_new(CRT_Basis_Object *basis)
+{
+    RNS_Object *result;
+
+    if ((result = PyObject_NewVar(RNS_Object, &RNS_Type, basis->n))) {
+        Py_INCREF((PyObject*)basis);
+        result->basis = basis;
+    }
+    return result;
+}
+
+/* Two bases are the same if they have the same moduli in the same order. */
+
+static int
+rns_same_basis(CRT_Basis_Object *a, CRT_Basis_Object *b)
+{
+    return a == b || (a->n == b->n &&
+                      !memcmp(a->words, b->words, a->n * sizeof(unsigned long)));
+}
+
+/* Return 1 and set *res to the residues of obj for basis, 0 if obj is not
+ * an rns_int or an integer, or -1 with an exception set. The residues of
+ * an integer are stored in *temp, which must be freed by the caller.
+ */
+
+static int
+rns_operand(PyObject *obj, CRT_Basis_Object *basis, const unsigned long **res,
+            unsigned long **temp)
+{
+    MPZ_Object *tempz;
+
+    if (RNS_Check(obj)) {
+        if (!rns_same_basis(((RNS_Object*)obj)->basis, basis)) {
+            VALUE_ERROR("rns_int operands must have the same moduli");
+            return -1;
+        }
+        *res = ((RNS_Object*)obj)->res;
+        return 1;
+    }
+    if (!IS_INTEGER(obj))
+        return 0;
+
+    if (!(tempz = GMPy_MPZ_From_Integer(obj, NULL)))
+        return -1;
+    if (!(*temp = GMPY_MALLOC(basis->n * sizeof(unsigned long)))) {
+        Py_DECREF((PyObject*)tempz);
+        PyErr_NoMemory();
+        return -1;
+    }
+    rns_from_mpz(basis, tempz->z, *temp);
+    Py_DECREF((PyObject*)tempz);
+    *res = *temp;
+    return 1;
+}
+
+/* Store the value of x, 0 <= value < M, in result. Returns 0 on success or
+ * -1 with an exception set. */
+
+static int
+rns_to_mpz(RNS_Object *x, mpz_ptr result)
+{
+    CRT_Basis_Object *basis = x->basis;
+    mpz_t *value;
+    Py_ssize_t i;
+
+    if (!(value = GMPY_MALLOC(basis->n * sizeof(mpz_t)))) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    GMPY_BEGIN_NOGIL(mpz_sizeinbase(basis->tree[basis->levels - 1][0], 2));
+    for (i = 0; i < basis->n; i++)
+        mpz_init_set_ui(value[i], x->res[i]);
+    GMPy_CRT_Basis_Combine_Values(basis, value, result);
+    GMPY_END_NOGIL;
+    GMPY_FREE(value);
+    return 0;
+}
+
+/* Return op applied to a and b, one of which is an rns_int, or
+ * NotImplemented if the other one is not an rns_int or an integer. */
+
+static PyObject *
+rns_apply(PyObject *a, PyObject *b, int op, unsigned long e)
+{
+    CRT_Basis_Object *basis;
+    RNS_Object *result = NULL;
+    unsigned long *tempa = NULL, *tempb = NULL, k;
+    size_t cost = GMP_NUMB_BITS;
+    rns_job job;
+    int rc;
+
+    basis = RNS_Check(a) ? ((RNS_Object*)a)->basis : ((RNS_Object*)b)->basis;
+    job.op = op;
+    job.y = NULL;
+    job.m = basis->words;
+    job.e = e;
+
+    if ((rc = rns_operand(a, basis, &job.x, &tempa)) <= 0 ||
+        (b && (rc = rns_operand(b, basis, &job.y, &tempb)) <= 0)) {
+        GMPY_FREE(tempa);
+        if (rc == 0)
+            Py_RETURN_NOTIMPLEMENTED;
+        return NULL;
+    }
+
+    /* A power costs about one multiplication per bit of the exponent. */
+    for (k = e; k; k >>= 1)
+        cost += GMP_NUMB_BITS;
+
+    if ((result = rns_new(basis))) {
+        job.r = result->res;
+        GMPy_Pool_Run(rns_run, &job, basis->n, NULL, (size_t)basis->n * cost);
+    }
+    GMPY_FREE(tempa);
+    GMPY_FREE(tempb);
+    return (PyObject*)result;
+}
+
+static PyObject *
+GMPy_RNS_Add_Slot(PyObject *x, PyObject *y)
+{
+    return rns_apply(x, y, RNS_ADD, 0);
+}
+
+static PyObject *
+GMPy_RNS_Sub_Slot(PyObject *x, PyObject *y)
+{
+    return rns_apply(x, y, RNS_SUB, 0);
+}
+
+static PyObject *
+GMPy_RNS_Mul_Slot(PyObject *x, PyObject *y)
+{
+    return rns_apply(x, y, RNS_MUL, 0);
+}
+
+static PyObject *
+GMPy_RNS_Neg_Slot(RNS_Object *x)
+{
+    return rns_apply((PyObject*)x, NULL, RNS_NEG, 0);
+}
+
+static PyObject *
+GMPy_RNS_Pow_Slot(PyObject *x, PyObject *y, PyObject *m)
+{
+    MPZ_Object *tempe;
+    unsigned long e;
+
+    if (!RNS_Check(x) || !IS_INTEGER(y))
+        Py_RETURN_NOTIMPLEMENTED;
+
+    if (m != Py_None) {
+        TYPE_ERROR("pow() of an rns_int does not accept a modulus");
+        return NULL;
+    }
+    if (!(tempe = GMPy_MPZ_From_Integer(y, NULL)))
+        return NULL;
+    if (mpz_sgn(tempe->z) < 0) {
+        Py_DECREF((PyObject*)tempe);
+        VALUE_ERROR("pow() of an rns_int requires a non-negative exponent");
+        return NULL;
+    }
+    if (!mpz_fits_ulong_p(tempe->z)) {
+        Py_DECREF((PyObject*)tempe);
+        OVERFLOW_ERROR("pow() exponent too large");
+        return NULL;
+    }
+    e = mpz_get_ui(tempe->z);
+    Py_DECREF((PyObject*)tempe);
+    return rns_apply(x, NULL, RNS_POW, e);
+}
+
+static PyObject *
+GMPy_RNS_Int_Slot(RNS_Object *x)
+{
+    MPZ_Object *tempz;
+    PyObject *result = NULL;
+
+    if (!(tempz = GMPy_MPZ_New(NULL)))
+        return NULL;
+    if (rns_to_mpz(x, tempz->z) == 0)
+        result = GMPy_PyIntOrLong_From_MPZ(tempz, NULL);
+    Py_DECREF((PyObject*)tempz);
+    return result;
+}
+
+PyDoc_STRVAR(GMPy_doc_rns_to_mpz,
+"x.to_mpz(signed=False) -> mpz\n\n"
+"Return the value of x as an mpz. The value v is in the range\n"
+"0 <= v < M, where M is the modulus of the basis. If signed is True,\n"
+"return the value in the range -M/2 <= v < M/2 instead.");
+
+static PyObject *
+GMPy_RNS_Method_ToMPZ(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    RNS_Object *x = (RNS_Object*)self;
+    MPZ_Object *result;
+    mpz_srcptr modulus = x->basis->tree[x->basis->levels - 1][0];
+    int is_signed = 0;
+    static char *kwlist[] = {"signed", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|i", kwlist, &is_signed))
+        return NULL;
+
+    if (!(result = GMPy_MPZ_New(NULL)))
+        return NULL;
+    if (rns_to_mpz(x, result->z) < 0) {
+        Py_DECREF((PyObject*)result);
+        return NULL;
+    }
+    if (is_signed && mpz_sizeinbase(result->z, 2) + 1 >= mpz_sizeinbase(modulus, 2)) {
+        mpz_t twice;
+
+        mpz_init(twice);
+        mpz_mul_2exp(twice, result->z, 1);
+        if (mpz_cmp(twice, modulus) >= 0)
+            mpz_sub(result->z, result->z, modulus);
+        mpz_clear(twice);
+    }
+    return (PyObject*)result;
+}
+
+static PyObject *
+GMPy_RNS_RichCompare_Slot(PyObject *a, PyObject *b, int op)
+{
+    CRT_Basis_Object *basis;
+    const unsigned long *x, *y;
+    unsigned long *tempa = NULL, *tempb = NULL;
+    int rc, equal;
+
+    if (op != Py_EQ && op != Py_NE)
+        Py_RETURN_NOTIMPLEMENTED;
+
+    basis = RNS_Check(a) ? ((RNS_Object*)a)->basis : ((RNS_Object*)b)->basis;
+    if (RNS_Check(a) && RNS_Check(b) && !rns_same_basis(((RNS_Object*)b)->basis, basis)) {
+        equal = 0;
+    }
+    else {
+        if ((rc = rns_operand(a, basis, &x, &tempa)) <= 0 ||
+            (rc = rns_operand(b, basis, &y, &tempb)) <= 0) {
+            GMPY_FREE(tempa);
+            if (rc == 0)
+                Py_RETURN_NOTIMPLEMENTED;
+            return NULL;
+        }
+        equal = !memcmp(x, y, basis->n * sizeof(unsigned long));
+        GMPY_FREE(tempa);
+        GMPY_FREE(tempb);
+    }
+    if (equal == (op == Py_EQ))
+        Py_RETURN_TRUE;
+    Py_RETURN_FALSE;
+}
+
+static PyObject *
+GMPy_RNS_Repr_Slot(RNS_Object *self)
+{
+    MPZ_Object *tempz;
+    PyObject *format, *args, *result = NULL;
+
+    if (!(tempz = GMPy_MPZ_New(NULL)))
+        return NULL;
+    if (rns_to_mpz(self, tempz->z) < 0) {
+        Py_DECREF((PyObject*)tempz);
+        return NULL;
+    }
+    args = Py_BuildValue("(NO)", (PyObject*)tempz, (PyObject*)self->basis);
+    format = Py2or3String_FromString("rns_int(%s, %r)");
+    if (args && format)
+        result = Py2or3String_Format(format, args);
+    Py_XDECREF(args);
+    Py_XDECREF(format);
+    return result;
+}
+
+static PyObject *
+GMPy_RNS_GetBasis(RNS_Object *self, void *closure)
+{
+    Py_INCREF((PyObject*)self->basis);
+    return (PyObject*)self->basis;
+}
+
+static PyObject *
+GMPy_RNS_GetResidues(RNS_Object *self, void *closure)
+{
+    PyObject *result, *temp;
+    Py_ssize_t i;
+
+    if (!(result = PyTuple_New(self->basis->n)))
+        return NULL;
+    for (i = 0; i < self->basis->n; i++) {
+        if (!(temp = PyLong_FromUnsignedLong(self->res[i]))) {
+            Py_DECREF(result);
+            return NULL;
+        }
+        PyTuple_SET_ITEM(result, i, temp);
+    }
+    return result;
+}
+
+static void
+GMPy_RNS_Dealloc(RNS_Object *self)
+{
+    Py_DECREF((PyObject*)self->basis);
+    PyObject_Del(self);
+}
+
+/* Return a new reference to a crt_basis with word-size moduli for obj,
+ * which is a crt_basis or an iterable of moduli. */
+
+static CRT_Basis_Object *
+rns_basis(PyObject *obj, const char *name)
+{
+    CRT_Basis_Object *basis;
+
+    if (CRT_Basis_Check(obj)) {
+        Py_INCREF(obj);
+        basis = (CRT_Basis_Object*)obj;
+    }
+    else if (!(basis = (CRT_Basis_Object*)GMPy_CRT_Basis_Factory(NULL, obj))) {
+        return NULL;
+    }
+    if (!basis->words) {
+        PyErr_Format(PyExc_ValueError,
+                     "%s() requires moduli that fit in an unsigned long", name);
+        Py_DECREF((PyObject*)basis);
+        return NULL;
+    }
+    return basis;
+}
+
+PyDoc_STRVAR(GMPy_doc_rns_int,
+"rns_int(x, basis) -> rns_int\n\n"
+"Return x modulo M as residues modulo the moduli of basis, where basis\n"
+"is a crt_basis, or a sequence of pairwise coprime moduli, whose moduli\n"
+"fit in an unsigned long and M is their product. rns_int supports +, -,\n"
+"*, unary - and ** with a non-negative exponent, with another rns_int of\n"
+"the same basis or an integer; the result is an rns_int. Each residue is\n"
+"computed independently. int(x) and x.to_mpz() return the value.");
+
+static PyObject *
+GMPy_RNS_Factory(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    CRT_Basis_Object *basis;
+    MPZ_Object *tempx;
+    RNS_Object *result = NULL;
+
+    if (nargs != 2) {
+        TYPE_ERROR("rns_int() requires 2 arguments");
+        return NULL;
+    }
+    if (!IS_INTEGER(args[0])) {
+        TYPE_ERROR("rns_int() requires an integer argument");
+        return NULL;
+    }
+    if (!(basis = rns_basis(args[1], "rns_int")))
+        return NULL;
+
+    if ((tempx = GMPy_MPZ_From_Integer(args[0], NULL))) {
+        if ((result = rns_new(basis)))
+            rns_from_mpz(basis, tempx->z, result->res);
+        Py_DECREF((PyObject*)tempx);
+    }
+    Py_DECREF((PyObject*)basis);
+    return (PyObject*)result;
+}
+GMPY_FASTCALL_WRAPPER(GMPy_RNS_Factory)
+
+/* Conversion of many values: the thread pool splits the values. */
+
+typedef struct {
+    MPZ_Object **x;
+    RNS_Object **r;
+    const unsigned long *m;
+    Py_ssize_t n;                   /* number of moduli */
+} rns_many_job;
+
+static void
+rns_many_run(void *arg, Py_ssize_t start, Py_ssize_t stop)
+{
+    rns_many_job *job = (rns_many_job*)arg;
+    Py_ssize_t i, j;
+
+    for (i = start; i < stop; i++) {
+        for (j = 0; j < job->n; j++)
+            job->r[i]->res[j] = mpz_fdiv_ui(job->x[i]->z, job->m[j]);
+    }
+}
+
+PyDoc_STRVAR(GMPy_doc_rns_many,
+"rns_many(values, basis) -> list\n\n"
+"Return [rns_int(x, basis) for x in values]. The conversions are split\n"
+"across the thread pool, see set_threads().");
+
+static PyObject *
+GMPy_RNS_Function_Many(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    CRT_Basis_Object *basis;
+    MPZ_Object **items;
+    PyObject *result = NULL;
+    rns_many_job job;
+    size_t *cost = NULL, total = 0;
+    Py_ssize_t i, n;
+
+    if (nargs != 2) {
+        TYPE_ERROR("rns_many() requires 2 arguments");
+        return NULL;
+    }
+    if (!(basis = rns_basis(args[1], "rns_many")))
+        return NULL;
+    if (!(items = GMPy_MPZ_Array_From_Iterable(args[0], &n,
+                            "rns_many() requires a sequence of integers", NULL))) {
+        Py_DECREF((PyObject*)basis);
+        return NULL;
+    }
+
+    if (!(cost = GMPY_MALLOC((n ? n : 1) * sizeof(size_t)))) {
+        PyErr_NoMemory();
+        goto done;
+    }
+    if (!(result = PyList_New(n)))
+        goto done;
+    for (i = 0; i < n; i++) {
+        RNS_Object *temp;
+
+        if (!(temp = rns_new(basis))) {
+            Py_CLEAR(result);
+            goto done;
+        }
+        PyList_SET_ITEM(result, i, (PyObject*)temp);
+        cost[i] = (size_t)basis->n * (mpz_size(items[i]->z) + 1) * GMP_NUMB_BITS;
+        total += cost[i];
+    }
+
+    job.x = items;
+    job.r = (RNS_Object**)((PyListObject*)result)->ob_item;
+    job.m = basis->words;
+    job.n = basis->n;
+    GMPy_Pool_Run(rns_many_run, &job, n, cost, total);
+
+  done:
+    GMPY_FREE(cost);
+    GMPy_MPZ_Array_Free(items, n);
+    Py_DECREF((PyObject*)basis);
+    return result;
+}
+GMPY_FASTCALL_WRAPPER(GMPy_RNS_Function_Many)
+
+#ifdef PY3
+static PyNumberMethods GMPy_RNS_number_methods =
+{
+    (binaryfunc) GMPy_RNS_Add_Slot,          /* nb_add                  */
+    (binaryfunc) GMPy_RNS_Sub_Slot,          /* nb_subtract             */
+    (binaryfunc) GMPy_RNS_Mul_Slot,          /* nb_multiply             */
+        0,                                   /* nb_remainder            */
+        0,                                   /* nb_divmod               */
+    (ternaryfunc) GMPy_RNS_Pow_Slot,         /* nb_power                */
+    (unaryfunc) GMPy_RNS_Neg_Slot,           /* nb_negative             */
+        0,                                   /* nb_positive             */
+        0,                                   /* nb_absolute             */
+        0,                                   /* nb_bool                 */
+        0,                                   /* nb_invert               */
+        0,                                   /* nb_lshift               */
+        0,                                   /* nb_rshift               */
+        0,                                   /* nb_and                  */
+        0,                                   /* nb_xor                  */
+        0,                                   /* nb_or                   */
+    (unaryfunc) GMPy_RNS_Int_Slot,           /* nb_int                  */
+        0,                                   /* nb_reserved             */
+        0,                                   /* nb_float                */
+};
+#else
+static PyNumberMethods GMPy_RNS_number_methods =
+{
+    (binaryfunc) GMPy_RNS_Add_Slot,          /* nb_add                  */
+    (binaryfunc) GMPy_RNS_Sub_Slot,          /* nb_subtract             */
+    (binaryfunc) GMPy_RNS_Mul_Slot,          /* nb_multiply             */
+        0,                                   /* nb_divide               */
+        0,                                   /* nb_remainder            */
+        0,                                   /* nb_divmod               */
+    (ternaryfunc) GMPy_RNS_Pow_Slot,         /* nb_power                */
+    (unaryfunc) GMPy_RNS_Neg_Slot,           /* nb_negative             */
+        0,                                   /* nb_positive             */
+        0,                                   /* nb_absolute             */
+        0,                                   /* nb_bool                 */
+        0,                                   /* nb_invert               */
+        0,                                   /* nb_lshift               */
+        0,                                   /* nb_rshift               */
+        0,                                   /* nb_and                  */
+        0,                                   /* nb_xor                  */
+        0,                                   /* nb_or                   */
+        0,                                   /* nb_coerce               */
+    (unaryfunc) GMPy_RNS_Int_Slot,           /* nb_int                  */
+    (unaryfunc) GMPy_RNS_Int_Slot,           /* nb_long                 */
+};
+#endif
+
+static PyGetSetDef GMPy_RNS_getseters[] =
+{
+    { "basis", (getter)GMPy_RNS_GetBasis, NULL, "crt_basis of the residues", NULL },
+    { "residues", (getter)GMPy_RNS_GetResidues, NULL, "tuple of the residues", NULL },
+    {NULL}
+};
+
+static PyMethodDef GMPy_RNS_methods[] =
+{
+    { "to_mpz", (PyCFunction)GMPy_RNS_Method_ToMPZ, METH_VARARGS | METH_KEYWORDS, GMPy_doc_rns_to_mpz },
+    { NULL, NULL, 1 }
+};
+
+static PyTypeObject RNS_Type =
+{
+#ifdef PY3
+    PyVarObject_HEAD_INIT(0, 0)
+#else
+    PyObject_HEAD_INIT(0)
+        0,                                   /* ob_size          */
+#endif
+    "gmpy2 rns_int",                         /* tp_name          */
+    offsetof(RNS_Object, res),               /* tp_basicsize     */
+    sizeof(unsigned long),                   /* tp_itemsize      */
+    (destructor) GMPy_RNS_Dealloc,           /* tp_dealloc       */
+        0,                                   /* tp_print         */
+        0,                                   /* tp_getattr       */
+        0,                                   /* tp_setattr       */
+        0,                                   /* tp_reserved      */
+    (reprfunc) GMPy_RNS_Repr_Slot,           /* tp_repr          */
+    &GMPy_RNS_number_methods,                /* tp_as_number     */
+        0,                                   /* tp_as_sequence   */
+        0,                                   /* tp_as_mapping    */
+        0,                                   /* tp_hash          */
+        0,                                   /* tp_call          */
+        0,                                   /* tp_str           */
+        0,                                   /* tp_getattro      */
+        0,                                   /* tp_setattro      */
+        0,                                   /* tp_as_buffer     */
+#ifdef PY3
+    Py_TPFLAGS_DEFAULT,                      /* tp_flags         */
+#else
+    Py_TPFLAGS_HAVE_RICHCOMPARE | Py_TPFLAGS_CHECKTYPES, /* tp_flags */
+#endif
+    "GMPY2 residue number system integer",   /* tp_doc           */
+        0,                                   /* tp_traverse      */
+        0,                                   /* tp_clear         */
+    (richcmpfunc)&GMPy_RNS_RichCompare_Slot, /* tp_richcompare   */
+        0,                                   /* tp_weaklistoffset*/
+        0,                                   /* tp_iter          */
+        0,                                   /* tp_iternext      */
+    GMPy_RNS_methods,                        /* tp_methods       */
+        0,                                   /* tp_members       */
+    GMPy_RNS_getseters,                      /* tp_getset        */
+};
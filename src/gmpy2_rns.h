@@ -0,0 +1,70 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_rns.h                                                             *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GMPY_RNS_H
+#define GMPY_RNS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* An rns_int is an integer modulo M = prod(m[i]) stored as its residues
+ * modulo the word-size moduli m[i] of a crt_basis. Addition, subtraction
+ * and multiplication act on each residue independently, so there are no
+ * carries between them and long vectors of residues are split across the
+ * thread pool. The value is reconstructed with the crt_basis.
+ */
+
+typedef struct {
+    PyObject_VAR_HEAD               /* ob_size is the number of moduli */
+    CRT_Basis_Object *basis;
+    unsigned long res[1];           /* res[i] = value mod basis->words[i] */
+} RNS_Object;
+
+static PyTypeObject RNS_Type;
+
+#define RNS_Check(v) (((PyObject*)v)->ob_type == &RNS_Type)
+
+static PyObject * GMPy_RNS_Factory(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPy_RNS_Function_Many(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static void       GMPy_RNS_Dealloc(RNS_Object *self);
+static PyObject * GMPy_RNS_Repr_Slot(RNS_Object *self);
+static PyObject * GMPy_RNS_RichCompare_Slot(PyObject *a, PyObject *b, int op);
+static PyObject * GMPy_RNS_Add_Slot(PyObject *x, PyObject *y);
+static PyObject * GMPy_RNS_Sub_Slot(PyObject *x, PyObject *y);
+static PyObject * GMPy_RNS_Mul_Slot(PyObject *x, PyObject *y);
+static PyObject * GMPy_RNS_Pow_Slot(PyObject *x, PyObject *y, PyObject *m);
+static PyObject * GMPy_RNS_Neg_Slot(RNS_Object *x);
+static PyObject * GMPy_RNS_Int_Slot(RNS_Object *x);
+static PyObject * GMPy_RNS_Method_ToMPZ(PyObject *self, PyObject *args, PyObject *kwargs);
+static PyObject * GMPy_RNS_GetBasis(RNS_Object *self, void *closure);
+static PyObject * GMPy_RNS_GetResidues(RNS_Object *self, void *closure);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
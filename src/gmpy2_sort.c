@@ -0,0 +1,362 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_sort.c                                                            *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+/* This file implements gmpy2.sort() and gmpy2.searchsorted().
+ *
+ * If every item is an mpz, an xmpz, or a Python integer, the items are
+ * compared directly instead of calling tp_richcompare. A sequence of mpz
+ * (or xmpz) values is first distributed by signed limb count with a
+ * counting sort, so only values of the same size are compared, and that
+ * comparison is a single mpn_cmp(). Any other sequence is sorted by
+ * list.sort().
+ *
+ * The sort is stable, so the result is always the same list that sorted()
+ * returns.
+ */
+
+/* Runs shorter than this are sorted by insertion. */
+#define SORT_INSERTION 16
+
+typedef int (*sort_cmpfunc)(PyObject *, PyObject *);
+
+/* Compare two Python integers. */
+
+static int
+sort_cmp_pylong(PyObject *a, PyObject *b)
+{
+    Py_ssize_t sa = Py_SIZE(a), sb = Py_SIZE(b), i;
+    digit da, db;
+
+    if (sa != sb)
+        return sa < sb ? -1 : 1;
+    for (i = ABS(sa); i-- > 0; ) {
+        da = ((PyLongObject*)a)->ob_digit[i];
+        db = ((PyLongObject*)b)->ob_digit[i];
+        if (da != db)
+            return (da < db) == (sa > 0) ? -1 : 1;
+    }
+    return 0;
+}
+
+/* Compare two integers that are mpz, xmpz, or Python integers. */
+
+static int
+sort_cmp_integer(PyObject *a, PyObject *b)
+{
+    if (CHECK_MPZANY(a)) {
+        if (CHECK_MPZANY(b))
+            return mpz_cmp(MPZ(a), MPZ(b));
+        return mpz_cmp_PyIntOrLong(MPZ(a), b);
+    }
+    if (CHECK_MPZANY(b))
+        return -mpz_cmp_PyIntOrLong(MPZ(b), a);
+#ifdef PY2
+    if (PyInt_Check(a) || PyInt_Check(b)) {
+        return PyObject_RichCompareBool(a, b, Py_LT) ? -1 :
+               PyObject_RichCompareBool(a, b, Py_GT);
+    }
+#endif
+    return sort_cmp_pylong(a, b);
+}
+
+/* Compare two mpz values with the same number of limbs. */
+
+static int
+sort_cmp_limbs(PyObject *a, PyObject *b)
+{
+    int size = MPZ(a)->_mp_size;
+    int c = mpn_cmp(MPZ(a)->_mp_d, MPZ(b)->_mp_d, ABS(size));
+
+    return size < 0 ? -c : c;
+}
+
+/* Stable merge sort of v[0..n-1]. tmp must have room for n/2 items. The
+ * result of cmp is multiplied by sign, which is -1 for a reversed sort.
+ */
+
+static void
+sort_merge(PyObject **v, PyObject **tmp, Py_ssize_t n, sort_cmpfunc cmp, int sign)
+{
+    Py_ssize_t h, i, j, k;
+    PyObject *t;
+
+    if (n <= SORT_INSERTION) {
+        for (i = 1; i < n; i++) {
+            t = v[i];
+            for (j = i; j > 0 && cmp(t, v[j - 1]) * sign < 0; j--)
+                v[j] = v[j - 1];
+            v[j] = t;
+        }
+        return;
+    }
+
+    h = n / 2;
+    sort_merge(v, tmp, h, cmp, sign);
+    sort_merge(v + h, tmp, n - h, cmp, sign);
+    if (cmp(v[h - 1], v[h]) * sign <= 0)
+        return;
+
+    memcpy(tmp, v, h * sizeof(PyObject*));
+    i = 0; j = h; k = 0;
+    while (i < h && j < n) {
+        if (cmp(v[j], tmp[i]) * sign < 0)
+            v[k++] = v[j++];
+        else
+            v[k++] = tmp[i++];
+    }
+    while (i < h)
+        v[k++] = tmp[i++];
+}
+
+/* Sort a sequence of mpz values. The values are distributed by signed limb
+ * count if the number of different counts is small. Returns -1 if memory
+ * can't be allocated.
+ */
+
+static int
+sort_mpz(PyObject **v, Py_ssize_t n, int sign)
+{
+    Py_ssize_t i, range, *count = NULL, start, key;
+    PyObject **tmp;
+    int min, max, size;
+
+    if (!(tmp = GMPY_MALLOC(n * sizeof(PyObject*))))
+        return -1;
+
+    min = max = MPZ(v[0])->_mp_size;
+    for (i = 1; i < n; i++) {
+        size = MPZ(v[i])->_mp_size;
+        if (size < min)
+            min = size;
+        if (size > max)
+            max = size;
+    }
+    range = (Py_ssize_t)max - min + 1;
+
+    if (range == 1 || range > n ||
+        !(count = GMPY_MALLOC((range + 1) * sizeof(Py_ssize_t)))) {
+        sort_merge(v, tmp, n, range == 1 ? sort_cmp_limbs : sort_cmp_integer, sign);
+        GMPY_FREE(tmp);
+        return 0;
+    }
+
+    /* Counting sort by limb count, in the requested direction. */
+    memset(count, 0, (range + 1) * sizeof(Py_ssize_t));
+    for (i = 0; i < n; i++) {
+        key = sign > 0 ? MPZ(v[i])->_mp_size - min : max - MPZ(v[i])->_mp_size;
+        count[key + 1]++;
+    }
+    for (i = 0; i < range; i++)
+        count[i + 1] += count[i];
+    for (i = 0; i < n; i++) {
+        key = sign > 0 ? MPZ(v[i])->_mp_size - min : max - MPZ(v[i])->_mp_size;
+        tmp[count[key]++] = v[i];
+    }
+    memcpy(v, tmp, n * sizeof(PyObject*));
+
+    /* count[key] is now the end of bucket key. */
+    start = 0;
+    for (key = 0; key < range; key++) {
+        if (count[key] - start > 1)
+            sort_merge(v + start, tmp, count[key] - start, sort_cmp_limbs, sign);
+        start = count[key];
+    }
+
+    GMPY_FREE(count);
+    GMPY_FREE(tmp);
+    return 0;
+}
+
+PyDoc_STRVAR(GMPy_doc_function_sort,
+"sort(iterable, reverse=False) -> list\n\n"
+"Return a new sorted list of the items of iterable, like sorted(). If\n"
+"every item is an mpz, xmpz or int, the values are compared directly\n"
+"without calling their comparison methods.");
+
+static PyObject *
+GMPy_Function_Sort(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *seq, *result, **items, **tmp;
+    PyObject *method, *empty, *kw, *temp;
+    Py_ssize_t i, n;
+    int reverse = 0, all_mpz = 1;
+    static char *kwlist[] = {"iterable", "reverse", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|i", kwlist, &seq, &reverse))
+        return NULL;
+
+    if (!(result = PySequence_List(seq)))
+        return NULL;
+
+    n = PyList_GET_SIZE(result);
+    items = PySequence_Fast_ITEMS(result);
+    for (i = 0; i < n; i++) {
+        if (!CHECK_MPZANY(items[i])) {
+            all_mpz = 0;
+            if (!PyIntOrLong_Check(items[i]))
+                break;
+        }
+    }
+
+    if (i < n) {
+        /* Not all integers; use list.sort(). */
+        method = PyObject_GetAttrString(result, "sort");
+        empty = PyTuple_New(0);
+        kw = Py_BuildValue("{s:O}", "reverse", reverse ? Py_True : Py_False);
+        temp = (method && empty && kw) ? PyObject_Call(method, empty, kw) : NULL;
+        Py_XDECREF(method);
+        Py_XDECREF(empty);
+        Py_XDECREF(kw);
+        if (!temp) {
+            Py_DECREF(result);
+            return NULL;
+        }
+        Py_DECREF(temp);
+        return result;
+    }
+
+    if (n < 2)
+        return result;
+
+    if (all_mpz) {
+        if (sort_mpz(items, n, reverse ? -1 : 1) < 0) {
+            Py_DECREF(result);
+            return PyErr_NoMemory();
+        }
+        return result;
+    }
+
+    if (!(tmp = GMPY_MALLOC((n / 2) * sizeof(PyObject*)))) {
+        Py_DECREF(result);
+        return PyErr_NoMemory();
+    }
+    sort_merge(items, tmp, n, sort_cmp_integer, reverse ? -1 : 1);
+    GMPY_FREE(tmp);
+    return result;
+}
+
+PyDoc_STRVAR(GMPy_doc_function_searchsorted,
+"searchsorted(seq, keys, side='left') -> list\n\n"
+"Return the indices where the integers in keys would be inserted into the\n"
+"sorted sequence of integers seq to keep it sorted. With side='left' the\n"
+"index of the first item >= key is returned, with side='right' the index\n"
+"of the first item > key. If keys is a single integer, a single index is\n"
+"returned. seq is not checked to be sorted.");
+
+static PyObject *
+GMPy_Function_SearchSorted(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *seq, *keys, *fseq = NULL, *fkeys = NULL, *result = NULL, *index;
+    PyObject **items, **keyitems, *key;
+    MPZ_Object *tempz;
+    Py_ssize_t i, n, nkeys, lo, hi, mid;
+    const char *side = "left";
+    int right, single, c;
+    static char *kwlist[] = {"seq", "keys", "side", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|s", kwlist, &seq, &keys, &side))
+        return NULL;
+
+    if (!strcmp(side, "left"))
+        right = 0;
+    else if (!strcmp(side, "right"))
+        right = 1;
+    else {
+        VALUE_ERROR("searchsorted() side must be 'left' or 'right'");
+        return NULL;
+    }
+
+    if (!(fseq = PySequence_Fast(seq, "searchsorted() requires a sequence")))
+        return NULL;
+    n = PySequence_Fast_GET_SIZE(fseq);
+    items = PySequence_Fast_ITEMS(fseq);
+    for (i = 0; i < n; i++) {
+        if (!CHECK_MPZANY(items[i]) && !PyIntOrLong_Check(items[i])) {
+            TYPE_ERROR("searchsorted() requires a sequence of integers");
+            goto error;
+        }
+    }
+
+    single = IS_INTEGER(keys);
+    if (single) {
+        keyitems = &keys;
+        nkeys = 1;
+    }
+    else {
+        if (!(fkeys = PySequence_Fast(keys, "searchsorted() requires integer keys")))
+            goto error;
+        keyitems = PySequence_Fast_ITEMS(fkeys);
+        nkeys = PySequence_Fast_GET_SIZE(fkeys);
+        if (!(result = PyList_New(nkeys)))
+            goto error;
+    }
+
+    for (i = 0; i < nkeys; i++) {
+        key = keyitems[i];
+        tempz = NULL;
+        if (!CHECK_MPZANY(key) && !PyIntOrLong_Check(key)) {
+            if (!IS_INTEGER(key)) {
+                TYPE_ERROR("searchsorted() requires integer keys");
+                goto error;
+            }
+            if (!(tempz = GMPy_MPZ_From_Integer(key, NULL)))
+                goto error;
+            key = (PyObject*)tempz;
+        }
+
+        lo = 0;
+        hi = n;
+        while (lo < hi) {
+            mid = lo + (hi - lo) / 2;
+            c = sort_cmp_integer(items[mid], key);
+            if (c < 0 || (right && c == 0))
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        Py_XDECREF((PyObject*)tempz);
+
+        if (!(index = PyIntOrLong_FromSsize_t(lo)))
+            goto error;
+        if (single) {
+            Py_DECREF(fseq);
+            return index;
+        }
+        PyList_SET_ITEM(result, i, index);
+    }
+
+    Py_DECREF(fseq);
+    Py_DECREF(fkeys);
+    return result;
+
+  error:
+    Py_XDECREF(fseq);
+    Py_XDECREF(fkeys);
+    Py_XDECREF(result);
+    return NULL;
+}
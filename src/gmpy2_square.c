@@ -48,11 +48,15 @@ _GMPy_MPZ_Square(PyObject *x, CTXT_Object *context)
 {
     MPZ_Object *result = NULL;
 
+    if (GMPY_LIMB_CHECK((double)mpz_size(MPZ(x)) * 2 * GMP_NUMB_BITS, context)) {
+        return NULL;
+    }
+
     if (!(result = GMPy_MPZ_New(context))) {
         return NULL;
     }
 
-    mpz_mul(result->z, MPZ(x), MPZ(x));
+    GMPY_MPZ_MUL(result->z, MPZ(x), MPZ(x));
     return (PyObject*)result;
 }
 
@@ -0,0 +1,134 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_threads.c                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* While a thread runs without the GIL, the memory functions in gmpy2.c
+ * record their statistics in tls_alloc_stats and GMPy_NoGIL_End() adds them
+ * to alloc_stats once the GIL is held again. The list of arena chunks is
+ * protected by arena_lock as long as nogil_count is not 0. nogil_count is
+ * only changed while the GIL is held, so a thread holding the GIL that sees
+ * a count of 0 does not need the lock.
+ */
+
+#ifndef WITHOUT_THREADS
+
+/* Release the GIL if 'bits' reaches the threshold. Returns the saved thread
+ * state, or NULL if the GIL is still held.
+ */
+
+static PyThreadState *
+GMPy_NoGIL_Begin(size_t bits)
+{
+    if (!GMPY_NOGIL_WANTED(bits))
+        return NULL;
+
+    nogil_count++;
+    tls_nogil = 1;
+    return tls_nogil_save = PyEval_SaveThread();
+}
+
+static void
+GMPy_NoGIL_End(PyThreadState *save)
+{
+    if (!save)
+        return;
+
+    PyEval_RestoreThread(save);
+    tls_nogil = 0;
+    tls_nogil_save = NULL;
+    nogil_count--;
+    GMPy_NoGIL_Merge(&tls_alloc_stats);
+}
+
+/* Add the counters recorded without the GIL to alloc_stats and clear
+ * them. The GIL must be held. */
+
+static void
+GMPy_NoGIL_Merge(struct gmpy_nogil_stats *stats)
+{
+    alloc_stats.allocs += stats->allocs;
+    alloc_stats.reallocs += stats->reallocs;
+    alloc_stats.frees += stats->frees;
+    alloc_stats.total_bytes += stats->total_bytes;
+    if (stats->peak_bytes > 0 &&
+        alloc_stats.bytes + (size_t)stats->peak_bytes > alloc_stats.peak_bytes)
+        alloc_stats.peak_bytes = alloc_stats.bytes + (size_t)stats->peak_bytes;
+    if (stats->bytes >= 0)
+        alloc_stats.bytes += (size_t)stats->bytes;
+    else if (alloc_stats.bytes > (size_t)(-stats->bytes))
+        alloc_stats.bytes -= (size_t)(-stats->bytes);
+    else
+        alloc_stats.bytes = 0;
+
+    memset(stats, 0, sizeof(struct gmpy_nogil_stats));
+}
+
+#endif
+
+PyDoc_STRVAR(GMPy_doc_get_nogil_threshold,
+"get_nogil_threshold() -> int\n\n"
+"Return the operand size, in bits, at which long-running functions\n"
+"release the GIL. 0 means the GIL is never released.");
+
+static PyObject *
+GMPy_get_nogil_threshold(PyObject *self, PyObject *args)
+{
+    return PyIntOrLong_FromSize_t(global.nogil_bits);
+}
+
+PyDoc_STRVAR(GMPy_doc_set_nogil_threshold,
+"set_nogil_threshold(bits)\n\n"
+"Release the GIL in powmod(), fac(), next_prime(), is_prime(), and the\n"
+"mpfr special functions (zeta(), gamma(), ...) when the operands, or the\n"
+"precision of the result, have at least 'bits' bits. Other threads can\n"
+"then run while the result is computed. 0 disables releasing the GIL.\n"
+"The mpfr functions only release the GIL if MPFR is thread-safe.");
+
+static PyObject *
+GMPy_set_nogil_threshold(PyObject *self, PyObject *other)
+{
+    Py_ssize_t bits;
+
+    bits = PyIntOrLong_AsSsize_t(other);
+    if (bits == -1 && PyErr_Occurred()) {
+        TYPE_ERROR("set_nogil_threshold() requires an integer argument");
+        return NULL;
+    }
+    if (bits < 0) {
+        VALUE_ERROR("threshold must be 0 or greater");
+        return NULL;
+    }
+
+#ifdef WITHOUT_THREADS
+    if (bits) {
+        VALUE_ERROR("gmpy2 was built without thread support");
+        return NULL;
+    }
+#endif
+
+    global.nogil_bits = (size_t)bits;
+    Py_RETURN_NONE;
+}
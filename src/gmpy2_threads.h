@@ -0,0 +1,92 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_threads.h                                                         *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GMPY_THREADS_H
+#define GMPY_THREADS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* GMP and MPFR functions that can run for a long time release the GIL when
+ * the size of their operands, in bits, reaches the threshold set by
+ * set_nogil_threshold(). Only GMP, MPFR, and MPC functions may be called
+ * between GMPY_BEGIN_NOGIL and GMPY_END_NOGIL; the operands must be owned
+ * by the caller and must not be visible to other threads.
+ */
+
+struct gmpy_nogil_stats {
+    size_t allocs;
+    size_t reallocs;
+    size_t frees;
+    size_t total_bytes;
+    Py_ssize_t bytes;        /* change in allocated bytes */
+    Py_ssize_t peak_bytes;   /* largest value of bytes */
+};
+
+#define NOGIL_DEFAULT_BITS 8192
+
+#ifdef WITHOUT_THREADS
+#  define GMPY_BEGIN_NOGIL(bits) {
+#  define GMPY_END_NOGIL }
+#else
+#  define GMPY_BEGIN_NOGIL(bits) \
+    { PyThreadState *_nogil_save = GMPy_NoGIL_Begin(bits);
+#  define GMPY_END_NOGIL \
+      GMPy_NoGIL_End(_nogil_save); }
+#endif
+
+/* True if GMPY_BEGIN_NOGIL(bits) will release the GIL. Operands that other
+ * threads can change, such as the elements of an mpz_vector, must then be
+ * copied before the GIL is released. */
+#ifdef WITHOUT_THREADS
+#  define GMPY_NOGIL_WANTED(bits) 0
+#else
+#  define GMPY_NOGIL_WANTED(bits) \
+    (global.nogil_bits && (size_t)(bits) >= global.nogil_bits && !tls_nogil)
+#endif
+
+/* MPFR keeps its flags and exponent range in global variables unless it was
+ * built with thread-local storage. */
+#define GMPY_BEGIN_NOGIL_MPFR(prec) \
+    GMPY_BEGIN_NOGIL(global.nogil_mpfr ? (size_t)(prec) : 0)
+#define GMPY_NOGIL_WANTED_MPFR(prec) \
+    GMPY_NOGIL_WANTED(global.nogil_mpfr ? (size_t)(prec) : 0)
+
+#ifndef WITHOUT_THREADS
+static PyThreadState * GMPy_NoGIL_Begin(size_t bits);
+static void            GMPy_NoGIL_End(PyThreadState *save);
+static void            GMPy_NoGIL_Merge(struct gmpy_nogil_stats *stats);
+#endif
+
+static PyObject *      GMPy_get_nogil_threshold(PyObject *self, PyObject *args);
+static PyObject *      GMPy_set_nogil_threshold(PyObject *self, PyObject *other);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -117,19 +117,27 @@ GMPy_Integer_TrueDiv(PyObject *x, PyObject *y, CTXT_Object *context)
  * function. If no appropriate function can be found, return NotImplemented.
  */
 
+GMPY_PROFILE_WRAP(PyObject *, GMPy_MPZ_TrueDiv_Slot, (PyObject *x, PyObject *y),
+                  (x, y), gmpy_profile_bits2(x, y))
+
 static PyObject *
-GMPy_MPZ_TrueDiv_Slot(PyObject *x, PyObject *y)
+GMPy_MPZ_TrueDiv_Slot_Impl(PyObject *x, PyObject *y)
 {
-    if (IS_INTEGER(x) && IS_INTEGER(y))
+    int xtype, ytype;
+
+    xtype = GMPy_ObjectType(x);
+    ytype = GMPy_ObjectType(y);
+
+    if (IS_TYPE_INTEGER(xtype) && IS_TYPE_INTEGER(ytype))
         return GMPy_Integer_TrueDiv(x, y, NULL);
 
-    if (IS_RATIONAL(x) && IS_RATIONAL(y))
+    if (IS_TYPE_RATIONAL(xtype) && IS_TYPE_RATIONAL(ytype))
         return GMPy_Rational_TrueDiv(x, y, NULL);
 
-    if (IS_REAL(x) && IS_REAL(y))
+    if (IS_TYPE_REAL(xtype) && IS_TYPE_REAL(ytype))
         return GMPy_Real_TrueDiv(x, y, NULL);
 
-    if (IS_COMPLEX(x) && IS_COMPLEX(y))
+    if (IS_TYPE_COMPLEX(xtype) && IS_TYPE_COMPLEX(ytype))
         return GMPy_Complex_TrueDiv(x, y, NULL);
 
     Py_RETURN_NOTIMPLEMENTED;
@@ -139,16 +147,21 @@ GMPy_MPZ_TrueDiv_Slot(PyObject *x, PyObject *y)
 static PyObject *
 GMPy_MPZ_Div2_Slot(PyObject *x, PyObject *y)
 {
-    if (IS_INTEGER(x) && IS_INTEGER(y))
+    int xtype, ytype;
+
+    xtype = GMPy_ObjectType(x);
+    ytype = GMPy_ObjectType(y);
+
+    if (IS_TYPE_INTEGER(xtype) && IS_TYPE_INTEGER(ytype))
         return GMPy_Integer_FloorDiv(x, y, NULL);
 
-    if (IS_RATIONAL(x) && IS_RATIONAL(y))
+    if (IS_TYPE_RATIONAL(xtype) && IS_TYPE_RATIONAL(ytype))
         return GMPy_Rational_TrueDiv(x, y, NULL);
 
-    if (IS_REAL(x) && IS_REAL(y))
+    if (IS_TYPE_REAL(xtype) && IS_TYPE_REAL(ytype))
         return GMPy_Real_TrueDiv(x, y, NULL);
 
-    if (IS_COMPLEX(x) && IS_COMPLEX(y))
+    if (IS_TYPE_COMPLEX(xtype) && IS_TYPE_COMPLEX(ytype))
         return GMPy_Complex_TrueDiv(x, y, NULL);
 
     Py_RETURN_NOTIMPLEMENTED;
@@ -170,7 +183,8 @@ GMPy_Rational_TrueDiv(PyObject *x, PyObject *y, CTXT_Object *context)
             ZERO_ERROR("division or modulo by zero");
             goto error;
         }
-        mpq_div(result->q, MPQ(x), MPQ(y));
+        if (!GMPy_MPQ_Small_Mul(result->q, MPQ(x), MPQ(y), 1))
+            mpq_div(result->q, MPQ(x), MPQ(y));
         return (PyObject*)result;
     }
 
@@ -186,7 +200,8 @@ GMPy_Rational_TrueDiv(PyObject *x, PyObject *y, CTXT_Object *context)
             goto error;
         }
 
-        mpq_div(result->q, tempx->q, tempy->q);
+        if (!GMPy_MPQ_Small_Mul(result->q, tempx->q, tempy->q, 1))
+            mpq_div(result->q, tempx->q, tempy->q);
         Py_DECREF((PyObject*)tempx);
         Py_DECREF((PyObject*)tempy);
         return (PyObject*)result;
@@ -202,16 +217,24 @@ GMPy_Rational_TrueDiv(PyObject *x, PyObject *y, CTXT_Object *context)
     return NULL;
 }
 
+GMPY_PROFILE_WRAP(PyObject *, GMPy_MPQ_TrueDiv_Slot, (PyObject *x, PyObject *y),
+                  (x, y), gmpy_profile_bits2(x, y))
+
 static PyObject *
-GMPy_MPQ_TrueDiv_Slot(PyObject *x, PyObject *y)
+GMPy_MPQ_TrueDiv_Slot_Impl(PyObject *x, PyObject *y)
 {
-    if (IS_RATIONAL(x) && IS_RATIONAL(y))
+    int xtype, ytype;
+
+    xtype = GMPy_ObjectType(x);
+    ytype = GMPy_ObjectType(y);
+
+    if (IS_TYPE_RATIONAL(xtype) && IS_TYPE_RATIONAL(ytype))
         return GMPy_Rational_TrueDiv(x, y, NULL);
 
-    if (IS_REAL(x) && IS_REAL(y))
+    if (IS_TYPE_REAL(xtype) && IS_TYPE_REAL(ytype))
         return GMPy_Real_TrueDiv(x, y, NULL);
 
-    if (IS_COMPLEX(x) && IS_COMPLEX(y))
+    if (IS_TYPE_COMPLEX(xtype) && IS_TYPE_COMPLEX(ytype))
         return GMPy_Complex_TrueDiv(x, y, NULL);
 
     Py_RETURN_NOTIMPLEMENTED;
@@ -249,11 +272,10 @@ GMPy_Real_TrueDiv(PyObject *x, PyObject *y, CTXT_Object *context)
             }
             else {
                 mpz_t tempz;
-                mpz_inoc(tempz);
-                mpz_set_PyIntOrLong(tempz, y);
+                mpz_inoc_pylong(tempz, y);
                 mpfr_clear_flags();
                 result->rc = mpfr_div_z(result->f, MPFR(x), tempz, GET_MPFR_ROUND(context));
-                mpz_cloc(tempz);
+                mpz_cloc_pylong(tempz);
                 goto done;
             }
         }
@@ -333,13 +355,21 @@ GMPy_Real_TrueDiv(PyObject *x, PyObject *y, CTXT_Object *context)
     return (PyObject*)result;
 }
 
+GMPY_PROFILE_WRAP(PyObject *, GMPy_MPFR_TrueDiv_Slot, (PyObject *x, PyObject *y),
+                  (x, y), gmpy_profile_bits2(x, y))
+
 static PyObject *
-GMPy_MPFR_TrueDiv_Slot(PyObject *x, PyObject *y)
+GMPy_MPFR_TrueDiv_Slot_Impl(PyObject *x, PyObject *y)
 {
-    if (IS_REAL(x) && IS_REAL(y))
+    int xtype, ytype;
+
+    xtype = GMPy_ObjectType(x);
+    ytype = GMPy_ObjectType(y);
+
+    if (IS_TYPE_REAL(xtype) && IS_TYPE_REAL(ytype))
         return GMPy_Real_TrueDiv(x, y, NULL);
 
-    if (IS_COMPLEX(x) && IS_COMPLEX(y))
+    if (IS_TYPE_COMPLEX(xtype) && IS_TYPE_COMPLEX(ytype))
         return GMPy_Complex_TrueDiv(x, y, NULL);
 
     Py_RETURN_NOTIMPLEMENTED;
@@ -357,7 +387,7 @@ GMPy_Complex_TrueDiv(PyObject *x, PyObject *y, CTXT_Object *context)
 
     if (MPC_Check(x) && MPC_Check(y)) {
         if (MPC_IS_ZERO_P(y)) {
-            context->ctx.divzero = 1;
+            GMPY_FLAGS(context)->divzero = 1;
             if (context->ctx.traps & TRAP_DIVZERO) {
                 GMPY_DIVZERO("'mpc' division by zero");
                 Py_DECREF((PyObject*)result);
@@ -369,6 +399,45 @@ GMPy_Complex_TrueDiv(PyObject *x, PyObject *y, CTXT_Object *context)
         goto done;
     }
 
+    /* A real operand is used as an mpfr, so no zero imaginary part is
+     * created or operated on. */
+    if (IS_COMPLEX(x) && IS_REAL(y)) {
+        MPC_Object *tempx;
+        MPFR_Object *tempy;
+
+        tempx = GMPy_MPC_From_Complex(x, 1, 1, context);
+        tempy = GMPy_MPFR_From_Real(y, 1, context);
+        if (!tempx || !tempy) {
+            Py_XDECREF((PyObject*)tempx);
+            Py_XDECREF((PyObject*)tempy);
+            Py_DECREF((PyObject*)result);
+            return NULL;
+        }
+        result->rc = mpc_div_fr(result->c, tempx->c, tempy->f, GET_MPC_ROUND(context));
+        Py_DECREF((PyObject*)tempx);
+        Py_DECREF((PyObject*)tempy);
+        goto done;
+    }
+
+    if (IS_REAL(x) && IS_COMPLEX(y)) {
+        MPFR_Object *tempx;
+        MPC_Object *tempy;
+
+        tempx = GMPy_MPFR_From_Real(x, 1, context);
+        tempy = GMPy_MPC_From_Complex(y, 1, 1, context);
+        if (!tempx || !tempy) {
+            Py_XDECREF((PyObject*)tempx);
+            Py_XDECREF((PyObject*)tempy);
+            Py_DECREF((PyObject*)result);
+            return NULL;
+        }
+        result->rc = mpc_fr_div(result->c, tempx->f, tempy->c,
+                               GET_MPC_ROUND(context));
+        Py_DECREF((PyObject*)tempx);
+        Py_DECREF((PyObject*)tempy);
+        goto done;
+    }
+
     if (IS_COMPLEX(x) && IS_COMPLEX(y)) {
         MPC_Object *tempx, *tempy;
 
@@ -395,8 +464,11 @@ GMPy_Complex_TrueDiv(PyObject *x, PyObject *y, CTXT_Object *context)
     return (PyObject*)result;
 }
 
+GMPY_PROFILE_WRAP(PyObject *, GMPy_MPC_TrueDiv_Slot, (PyObject *x, PyObject *y),
+                  (x, y), gmpy_profile_bits2(x, y))
+
 static PyObject *
-GMPy_MPC_TrueDiv_Slot(PyObject *x, PyObject *y)
+GMPy_MPC_TrueDiv_Slot_Impl(PyObject *x, PyObject *y)
 {
     return GMPy_Complex_TrueDiv(x, y, NULL);
 }
@@ -405,19 +477,27 @@ PyDoc_STRVAR(GMPy_doc_truediv,
 "div(x, y) -> number\n\n"
 "Return x / y; uses true division.");
 
+GMPY_PROFILE_WRAP(PyObject *, GMPy_Number_TrueDiv, (PyObject *x, PyObject *y, CTXT_Object *context),
+                  (x, y, context), gmpy_profile_bits2(x, y))
+
 static PyObject *
-GMPy_Number_TrueDiv(PyObject *x, PyObject *y, CTXT_Object *context)
+GMPy_Number_TrueDiv_Impl(PyObject *x, PyObject *y, CTXT_Object *context)
 {
-    if (IS_INTEGER(x) && IS_INTEGER(y))
+    int xtype, ytype;
+
+    xtype = GMPy_ObjectType(x);
+    ytype = GMPy_ObjectType(y);
+
+    if (IS_TYPE_INTEGER(xtype) && IS_TYPE_INTEGER(ytype))
         return GMPy_Integer_TrueDiv(x, y, context);
 
-    if (IS_RATIONAL(x) && IS_RATIONAL(y))
+    if (IS_TYPE_RATIONAL(xtype) && IS_TYPE_RATIONAL(ytype))
         return GMPy_Rational_TrueDiv(x, y, context);
 
-    if (IS_REAL(x) && IS_REAL(y))
+    if (IS_TYPE_REAL(xtype) && IS_TYPE_REAL(ytype))
         return GMPy_Real_TrueDiv(x, y, context);
 
-    if (IS_COMPLEX(x) && IS_COMPLEX(y))
+    if (IS_TYPE_COMPLEX(xtype) && IS_TYPE_COMPLEX(ytype))
         return GMPy_Complex_TrueDiv(x, y, context);
 
     TYPE_ERROR("div() argument type not supported");
@@ -429,11 +509,11 @@ PyDoc_STRVAR(GMPy_doc_context_truediv,
 "Return x / y; uses true division.");
 
 static PyObject *
-GMPy_Context_TrueDiv(PyObject *self, PyObject *args)
+GMPy_Context_TrueDiv(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     CTXT_Object *context = NULL;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (nargs != 2) {
         TYPE_ERROR("div() requires 2 arguments.");
         return NULL;
     }
@@ -445,7 +525,8 @@ GMPy_Context_TrueDiv(PyObject *self, PyObject *args)
         CHECK_CONTEXT(context);
     }
 
-    return GMPy_Number_TrueDiv(PyTuple_GET_ITEM(args, 0), PyTuple_GET_ITEM(args, 1),
+    return GMPy_Number_TrueDiv(args[0], args[1],
                                context);
 }
+GMPY_FASTCALL_WRAPPER(GMPy_Context_TrueDiv)
 
@@ -0,0 +1,263 @@
+"""Measure the machine dependent thresholds of gmpy2.
+
+Run
+
+    python -m gmpy2_tune
+
+to time the crossovers on this machine and write them to the tuning
+profile that gmpy2 loads at import: the file named by the environment
+variable GMPY2_TUNING or, if it is not set, ~/.gmpy2_tuning. Use -o to
+write another file and -n to only print the profile. --quick uses
+smaller operands and fewer repeats.
+
+The thresholds are described by gmpy2.get_tuning(). A threshold that
+does not pay off anywhere in the measured range, for example a parallel
+crossover on a machine with one CPU, keeps its current value.
+"""
+
+from __future__ import print_function, division
+
+import os
+import random
+import sys
+import time
+
+import gmpy2
+from gmpy2 import mpz
+
+try:
+    _timer = time.perf_counter
+except AttributeError:
+    _timer = time.time
+
+
+def operand(bits, seed):
+    rng = random.Random(seed * 1000003 + bits)
+    return mpz(rng.getrandbits(bits) | (1 << (bits - 1)))
+
+
+def best_time(func, repeat, target=0.02):
+    """Return the best time per call of func(), calibrating the loops."""
+    loops = 1
+    while True:
+        t0 = _timer()
+        for _ in range(loops):
+            func()
+        t = _timer() - t0
+        if t >= target or loops >= 10**6:
+            break
+        loops *= 10 if t < target / 10 else 2
+    best = t
+    for _ in range(repeat - 1):
+        t0 = _timer()
+        for _ in range(loops):
+            func()
+        best = min(best, _timer() - t0)
+    return best / loops
+
+
+def cpus():
+    try:
+        return len(os.sched_getaffinity(0))
+    except AttributeError:
+        import multiprocessing
+        return multiprocessing.cpu_count()
+
+
+def crossover(sizes, slow, fast, repeat, margin=0.9):
+    """Return the first size where fast(size) takes at most margin times
+    as long as slow(size) for this and the next size, or None."""
+    wins = []
+    for bits in sizes:
+        wins.append(best_time(fast(bits), repeat) <= margin * best_time(slow(bits), repeat))
+        if len(wins) >= 2 and wins[-2] and wins[-1]:
+            return sizes[len(wins) - 2]
+    if wins and wins[-1]:
+        return sizes[-1]
+    return None
+
+
+def tune_nogil_bits(quick, repeat):
+    """Smallest powmod() operand for which releasing the GIL costs less
+    than 1% of the time."""
+    sizes = [1 << k for k in range(8, 15 if quick else 17)]
+
+    def timed(threshold):
+        def make(bits):
+            x, e, m = operand(bits, 1), operand(bits, 2), operand(bits, 3) | 1
+            def func():
+                gmpy2.set_nogil_threshold(threshold)
+                gmpy2.powmod(x, e, m)
+            return func
+        return make
+
+    saved = gmpy2.get_nogil_threshold()
+    try:
+        return crossover(sizes, timed(0), timed(1), repeat, margin=1.01)
+    finally:
+        gmpy2.set_nogil_threshold(saved)
+
+
+def tune_pmul_crossover(quick, repeat):
+    """Smallest operands for which parallel_mul() beats mpz_mul()."""
+    threads = min(cpus(), 8)
+    if threads < 2:
+        return None
+    sizes = [1 << k for k in range(17, 23 if quick else 26)]
+    saved = gmpy2.get_threads()
+
+    def serial(bits):
+        x, y = operand(bits, 1), operand(bits, 2)
+        return lambda: x * y
+
+    def parallel(bits):
+        x, y = operand(bits, 1), operand(bits, 2)
+        manager = gmpy2.parallel_mul(threads, crossover=bits)
+        def func():
+            with manager:
+                x * y
+        return func
+
+    try:
+        return crossover(sizes, serial, parallel, repeat)
+    finally:
+        gmpy2.set_threads(saved)
+
+
+def tune_pool_min_cost(quick, repeat):
+    """Smallest total work, in bits, for which powmod_many() is faster on
+    the thread pool than in the calling thread."""
+    threads = min(cpus(), 8)
+    if threads < 2:
+        return None
+    saved = gmpy2.get_threads(), gmpy2.get_tuning()
+    bits = 256
+    sizes = [bits << k for k in range(2, 12 if quick else 16)]
+
+    def timed(n):
+        def make(total):
+            count = total // bits
+            bases = [operand(bits, i) for i in range(count)]
+            exps = [operand(bits, i + count) for i in range(count)]
+            m = operand(bits, 0) | 1
+            def func():
+                gmpy2.set_threads(n)
+                gmpy2.powmod_many(bases, exps, m)
+            return func
+        return make
+
+    try:
+        gmpy2.set_tuning(pool_min_cost=1)
+        return crossover(sizes, timed(1), timed(threads), repeat)
+    finally:
+        gmpy2.set_threads(saved[0])
+        gmpy2.set_tuning(saved[1])
+
+
+def tune_barrett_bits(quick, repeat):
+    """Smallest modulus for which Barrett reduction beats mpz_mod()."""
+    sizes = [1 << k for k in range(7, 14 if quick else 16)]
+    saved = gmpy2.get_tuning()
+
+    def timed(barrett_bits):
+        def make(bits):
+            gmpy2.set_tuning(barrett_bits=barrett_bits)
+            M = gmpy2.Modulus(operand(bits, 1))
+            x, y = operand(bits - 1, 2), operand(bits - 1, 3)
+            return lambda: M.mul(x, y)
+        return make
+
+    try:
+        return crossover(sizes, timed(sys.maxsize), timed(1), repeat, margin=0.97)
+    finally:
+        gmpy2.set_tuning(saved)
+
+
+def tune_cache_size(quick, repeat):
+    """Cache size that is fastest for creating and dropping small mpz."""
+    saved = gmpy2.get_tuning()
+    x = mpz(12345)
+
+    def func():
+        for _ in range(100):
+            x + 1; x * 3; x - 7; x + 2; x * 5
+
+    results = []
+    try:
+        for size in (25, 50, 100, 200, 400, 1000):
+            gmpy2.set_tuning(cache_size=size)
+            results.append((best_time(func, repeat), size))
+    finally:
+        gmpy2.set_tuning(saved)
+    # Prefer the smaller cache unless a larger one is clearly faster.
+    fastest = min(results)[0]
+    return min(size for t, size in results if t <= 1.02 * fastest)
+
+
+TUNERS = [
+    ("nogil_bits", tune_nogil_bits),
+    ("pmul_crossover", tune_pmul_crossover),
+    ("pool_min_cost", tune_pool_min_cost),
+    ("barrett_bits", tune_barrett_bits),
+    ("cache_size", tune_cache_size),
+]
+
+
+def default_path():
+    path = os.environ.get("GMPY2_TUNING")
+    if path is None:
+        path = os.path.join(os.path.expanduser("~"), ".gmpy2_tuning")
+    return path
+
+
+def tune(quick=False, repeat=5, log=None):
+    """Return a profile, like get_tuning(), with the measured values."""
+    profile = gmpy2.get_tuning()
+    for name, tuner in TUNERS:
+        value = tuner(quick, repeat)
+        if value is not None:
+            profile[name] = value
+        if log:
+            log("%-16s %s" % (name, value if value is not None else
+                              "%s (kept)" % profile[name]))
+    return profile
+
+
+def format_profile(profile):
+    lines = ["# gmpy2 tuning profile, written by gmpy2_tune",
+             "# gmpy2 %s, %s, %s" % (gmpy2.version(), gmpy2.mp_version(),
+                                     gmpy2.mpfr_version())]
+    lines.extend("%s = %d" % (name, profile[name]) for name in sorted(profile))
+    return "\n".join(lines) + "\n"
+
+
+def main(argv=None):
+    import argparse
+
+    parser = argparse.ArgumentParser(prog="python -m gmpy2_tune",
+                                     description="measure the thresholds of gmpy2")
+    parser.add_argument("-o", "--output", default=None,
+                        help="profile to write (default: %s)" % default_path())
+    parser.add_argument("-n", "--dry-run", action="store_true",
+                        help="print the profile instead of writing it")
+    parser.add_argument("--quick", action="store_true",
+                        help="use smaller operands and fewer repeats")
+    args = parser.parse_args(argv)
+
+    log = lambda msg: print(msg, file=sys.stderr)
+    profile = tune(quick=args.quick, repeat=3 if args.quick else 5, log=log)
+    text = format_profile(profile)
+    if args.dry_run:
+        sys.stdout.write(text)
+        return 0
+
+    path = args.output or default_path()
+    with open(path, "w") as f:
+        f.write(text)
+    gmpy2.set_tuning(profile)
+    log("wrote %s" % path)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
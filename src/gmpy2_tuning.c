@@ -0,0 +1,381 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_tuning.c                                                          *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* Machine dependent thresholds, see gmpy2_tuning.h. */
+
+typedef struct {
+    const char *name;
+    size_t min;
+    size_t max;
+    size_t (*get)(void);
+    void (*set)(size_t value);
+} gmpy_tunable;
+
+#define TUNE_GLOBAL(NAME) \
+static size_t \
+tune_get_##NAME(void) \
+{ \
+    return (size_t)global.NAME; \
+} \
+static void \
+tune_set_##NAME(size_t value) \
+{ \
+    global.NAME = value; \
+}
+
+TUNE_GLOBAL(nogil_bits)
+TUNE_GLOBAL(pmul_crossover)
+TUNE_GLOBAL(pool_min_cost)
+TUNE_GLOBAL(barrett_bits)
+
+/* The cache sizes are changed like set_cache() does. */
+
+static size_t
+tune_get_cache_size(void)
+{
+    return (size_t)global.cache_size;
+}
+
+static size_t
+tune_get_cache_obsize(void)
+{
+    return (size_t)global.cache_obsize;
+}
+
+static void
+tune_resize_caches(void)
+{
+    gmpy_cache *cache;
+
+    global.cache_generation++;
+    if ((cache = GMPy_current_cache()))
+        GMPy_Cache_Resize(cache);
+}
+
+static void
+tune_set_cache_size(size_t value)
+{
+    int i;
+
+    global.cache_size = (int)value;
+    for (i = 0; i < GMPY_CACHE_TYPES; ++i)
+        global.cache_sizes[i] = (int)value;
+    tune_resize_caches();
+}
+
+static void
+tune_set_cache_obsize(size_t value)
+{
+    global.cache_obsize = (int)value;
+    tune_resize_caches();
+}
+
+#ifdef WITHOUT_THREADS
+#  define TUNE_NOGIL_MAX 0
+#else
+#  define TUNE_NOGIL_MAX PY_SSIZE_T_MAX
+#endif
+
+#define ADD_TUNABLE(NAME, MIN, MAX) \
+    { #NAME, MIN, MAX, tune_get_##NAME, tune_set_##NAME }
+
+static gmpy_tunable tunables[] = {
+    ADD_TUNABLE(nogil_bits, 0, TUNE_NOGIL_MAX),
+    ADD_TUNABLE(pmul_crossover, 1, PY_SSIZE_T_MAX),
+    ADD_TUNABLE(pool_min_cost, 1, PY_SSIZE_T_MAX),
+    ADD_TUNABLE(barrett_bits, 1, PY_SSIZE_T_MAX),
+    ADD_TUNABLE(cache_size, 0, MAX_CACHE),
+    ADD_TUNABLE(cache_obsize, 0, MAX_CACHE_LIMBS),
+    { NULL }
+};
+
+static gmpy_tunable *
+find_tunable(const char *name)
+{
+    gmpy_tunable *t;
+
+    for (t = tunables; t->name; t++) {
+        if (!strcmp(t->name, name))
+            return t;
+    }
+    return NULL;
+}
+
+PyDoc_STRVAR(GMPy_doc_get_tuning,
+"get_tuning() -> dict\n\n"
+"Return the machine dependent thresholds as a dict:\n"
+"    nogil_bits      operand size that releases the GIL, see\n"
+"                    set_nogil_threshold()\n"
+"    pmul_crossover  default crossover of parallel_mul(), in bits\n"
+"    pool_min_cost   work, in bits, below which the thread pool is not\n"
+"                    used, and the size of the ranges that are given to\n"
+"                    its threads\n"
+"    barrett_bits    size of the moduli for which Modulus() uses Barrett\n"
+"                    reduction\n"
+"    cache_size      number of objects in each cache, see set_cache()\n"
+"    cache_obsize    maximum size of a cached object, in limbs\n"
+"The values are loaded from a profile at import; see set_tuning().");
+
+static PyObject *
+GMPy_get_tuning(PyObject *self, PyObject *args)
+{
+    PyObject *result, *value;
+    gmpy_tunable *t;
+
+    if (!(result = PyDict_New()))
+        return NULL;
+
+    for (t = tunables; t->name; t++) {
+        if (!(value = PyIntOrLong_FromSize_t(t->get())) ||
+            PyDict_SetItemString(result, t->name, value) < 0) {
+            Py_XDECREF(value);
+            Py_DECREF(result);
+            return NULL;
+        }
+        Py_DECREF(value);
+    }
+    return result;
+}
+
+/* Check one item of a profile passed to set_tuning(). Stores the index of
+ * the threshold and its value, and returns 0 on success or -1 with an
+ * exception set.
+ */
+
+static int
+tuning_item(PyObject *key, PyObject *value, Py_ssize_t *index, size_t *result)
+{
+    const char *name;
+    gmpy_tunable *t;
+    Py_ssize_t temp;
+
+    if (!Py2or3String_Check(key)) {
+        TYPE_ERROR("set_tuning() requires string keys");
+        return -1;
+    }
+#ifdef PY3
+    if (!(name = PyUnicode_AsUTF8(key)))
+        return -1;
+#else
+    name = PyString_AsString(key);
+#endif
+    if (!(t = find_tunable(name))) {
+        PyErr_Format(PyExc_ValueError, "unknown threshold '%s'", name);
+        return -1;
+    }
+    if (!PyIntOrLong_Check(value)) {
+        PyErr_Format(PyExc_TypeError, "%s must be an integer", name);
+        return -1;
+    }
+    temp = PyIntOrLong_AsSsize_t(value);
+    if (temp == -1 && PyErr_Occurred())
+        return -1;
+    if (temp < 0 || (size_t)temp < t->min || (size_t)temp > t->max) {
+        PyErr_Format(PyExc_ValueError, "%s must be between %zd and %zd",
+                     name, (Py_ssize_t)t->min, (Py_ssize_t)t->max);
+        return -1;
+    }
+    *index = t - tunables;
+    *result = (size_t)temp;
+    return 0;
+}
+
+/* Check the items of a dict into values and given. */
+
+static int
+tuning_dict(PyObject *dict, size_t *values, int *given)
+{
+    PyObject *key, *value;
+    Py_ssize_t pos = 0, index;
+    size_t temp;
+
+    while (PyDict_Next(dict, &pos, &key, &value)) {
+        if (tuning_item(key, value, &index, &temp) < 0)
+            return -1;
+        values[index] = temp;
+        given[index] = 1;
+    }
+    return 0;
+}
+
+PyDoc_STRVAR(GMPy_doc_set_tuning,
+"set_tuning([profile,] **kwargs)\n\n"
+"Change the thresholds returned by get_tuning(). 'profile' is a dict\n"
+"like the one returned by get_tuning(); keywords override its items.\n"
+"Thresholds that are not given keep their value, and nothing is changed\n"
+"if any value is invalid.\n\n"
+"At import, gmpy2 reads the profile named by the environment variable\n"
+"GMPY2_TUNING or, if it is not set, ~/.gmpy2_tuning if it exists. The\n"
+"command 'python -m gmpy2_tune' measures the thresholds for the machine\n"
+"and writes that file.");
+
+static PyObject *
+GMPy_set_tuning(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    size_t values[sizeof(tunables) / sizeof(tunables[0])];
+    int given[sizeof(tunables) / sizeof(tunables[0])] = { 0 };
+    Py_ssize_t i;
+
+    if (PyTuple_GET_SIZE(args) > 1 ||
+        (PyTuple_GET_SIZE(args) == 1 && !PyDict_Check(PyTuple_GET_ITEM(args, 0)))) {
+        TYPE_ERROR("set_tuning() requires a dict and keyword arguments");
+        return NULL;
+    }
+
+    if ((PyTuple_GET_SIZE(args) && tuning_dict(PyTuple_GET_ITEM(args, 0), values, given) < 0) ||
+        (kwargs && tuning_dict(kwargs, values, given) < 0)) {
+        return NULL;
+    }
+
+    for (i = 0; tunables[i].name; i++) {
+        if (given[i])
+            tunables[i].set(values[i]);
+    }
+    Py_RETURN_NONE;
+}
+
+/* Report a problem with the profile; returns -1 if the warning was turned
+ * into an exception. */
+
+static int
+tuning_warn(const char *path, int line, const char *msg)
+{
+    char buffer[512];
+
+    if (line)
+        PyOS_snprintf(buffer, sizeof(buffer), "%s, line %d: %s", path, line, msg);
+    else
+        PyOS_snprintf(buffer, sizeof(buffer), "%s: %s", path, msg);
+    return PyErr_WarnEx(PyExc_RuntimeWarning, buffer, 1);
+}
+
+/* Parse one line of a profile. Returns 0 if it was used or ignored, 1 if
+ * it is not valid, and stores the message in *msg. */
+
+static int
+tuning_line(char *line, const char **msg)
+{
+    char *name, *end;
+    unsigned long long value;
+    gmpy_tunable *t;
+
+    while (isspace((unsigned char)*line))
+        line++;
+    if (!*line || *line == '#')
+        return 0;
+
+    name = line;
+    while (*line && (isalnum((unsigned char)*line) || *line == '_'))
+        line++;
+    end = line;
+    while (isspace((unsigned char)*line))
+        line++;
+    if (end == name || *line != '=') {
+        *msg = "expected 'name = value'";
+        return 1;
+    }
+    *end = '\0';
+    line++;
+
+    if (!(t = find_tunable(name))) {
+        *msg = "unknown threshold";
+        return 1;
+    }
+
+    while (isspace((unsigned char)*line))
+        line++;
+    if (!isdigit((unsigned char)*line)) {
+        *msg = "value must be a non-negative integer";
+        return 1;
+    }
+    errno = 0;
+    value = strtoull(line, &end, 10);
+    while (isspace((unsigned char)*end))
+        end++;
+    if (*end) {
+        *msg = "value must be a non-negative integer";
+        return 1;
+    }
+    if (errno || value < t->min || value > t->max) {
+        *msg = "value is out of range";
+        return 1;
+    }
+
+    t->set((size_t)value);
+    return 0;
+}
+
+static int
+GMPy_Tuning_Load(void)
+{
+    char path[1024], line[TUNING_LINE];
+    const char *env, *home, *msg = NULL;
+    int lineno = 0, named;
+    FILE *file;
+
+    if ((env = getenv(TUNING_ENV))) {
+        if (!*env)
+            return 0;
+        if (strlen(env) >= sizeof(path))
+            return tuning_warn(TUNING_ENV, 0, "file name is too long");
+        strcpy(path, env);
+        named = 1;
+    }
+    else {
+        if (!(home = getenv("HOME")) && !(home = getenv("USERPROFILE")))
+            return 0;
+        if (PyOS_snprintf(path, sizeof(path), "%s/%s", home, TUNING_FILE) >= (int)sizeof(path))
+            return 0;
+        named = 0;
+    }
+
+    if (!(file = fopen(path, "r"))) {
+        /* The default profile is optional. */
+        return named ? tuning_warn(path, 0, "cannot open tuning profile") : 0;
+    }
+
+    while (fgets(line, sizeof(line), file)) {
+        lineno++;
+        if (!strchr(line, '\n') && !feof(file)) {
+            int c;
+
+            /* Skip the rest of a line that is too long. */
+            while ((c = fgetc(file)) != EOF && c != '\n')
+                ;
+            msg = "line is too long";
+        }
+        else if (!tuning_line(line, &msg)) {
+            continue;
+        }
+        if (tuning_warn(path, lineno, msg) < 0) {
+            fclose(file);
+            return -1;
+        }
+    }
+    fclose(file);
+    return 0;
+}
@@ -0,0 +1,57 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_tuning.h                                                          *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GMPY_TUNING_H
+#define GMPY_TUNING_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Thresholds whose best value depends on the machine. get_tuning() returns
+ * them as a dict and set_tuning() changes them; the gmpy2_tune module
+ * measures them and writes a profile. A profile is a text file with one
+ * "name = value" line per threshold; blank lines and lines starting with
+ * '#' are ignored. At import, GMPy_Tuning_Load() reads the file named by
+ * the environment variable GMPY2_TUNING or, if it is not set, the file
+ * TUNING_FILE in the home directory if there is one. An empty GMPY2_TUNING
+ * disables loading. Problems with the profile are reported as a
+ * RuntimeWarning and the rest of the file is still used.
+ */
+
+#define TUNING_ENV "GMPY2_TUNING"
+#define TUNING_FILE ".gmpy2_tuning"
+#define TUNING_LINE 256
+
+static int        GMPy_Tuning_Load(void);
+static PyObject * GMPy_get_tuning(PyObject *self, PyObject *args);
+static PyObject * GMPy_set_tuning(PyObject *self, PyObject *args, PyObject *kwargs);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,230 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_vector.c                                                          *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* This file implements elementwise arithmetic between sequences:
+ *
+ *   context.vadd(x, y)
+ *   context.vsub(x, y)
+ *   context.vmul(x, y)
+ *   context.vdiv(x, y)
+ *
+ * Either argument may be a single number instead of a sequence; it is then
+ * combined with every item of the other sequence. The context is checked
+ * once and, if all operands have the same numeric class, the kernel for
+ * that class is called directly for every item. Otherwise the same
+ * GMPy_Number_* function used by add(), sub(), mul() and div() is called
+ * for each pair, so the results are always identical to those functions.
+ */
+
+/* Returns 1, 2, 3, or 4 if x is an integer, a rational (but not an integer),
+ * a real (but not a rational), or a complex (but not a real) number, and 0
+ * if x is not a number. The checks below are ordered by cost.
+ */
+
+static int
+GMPy_Vector_Class(PyObject *x)
+{
+    if (IS_INTEGER(x))
+        return 1;
+    if (MPFR_Check(x) || PyFloat_Check(x))
+        return 3;
+    if (MPQ_Check(x))
+        return 2;
+    if (IS_COMPLEX_ONLY(x))
+        return 4;
+    if (IS_FRACTION(x))
+        return 2;
+    if (IS_DECIMAL(x))
+        return 3;
+    return 0;
+}
+
+/* Classify every item of a sequence. Returns the common class, or 0 if the
+ * items are of mixed (or unsupported) classes.
+ */
+
+static int
+vector_class(PyObject **items, Py_ssize_t n, int cls)
+{
+    Py_ssize_t i;
+
+    for (i = 0; i < n && cls; i++) {
+        if (GMPy_Vector_Class(items[i]) != cls)
+            cls = 0;
+    }
+    return cls;
+}
+
+static PyObject *
+GMPy_Vector_Apply(PyObject *x, PyObject *y, const gmpy_vector_op *op, CTXT_Object *context)
+{
+    PyObject *xseq = NULL, *yseq = NULL, *result = NULL, *temp;
+    PyObject **xitems, **yitems;
+    Py_ssize_t i, n, xstep = 1, ystep = 1;
+    gmpy_binaryfunc kernel;
+    int cls, xcls, ycls;
+
+    xcls = GMPy_Vector_Class(x);
+    ycls = GMPy_Vector_Class(y);
+    if (xcls && ycls) {
+        TYPE_ERROR("vector operation requires at least one sequence");
+        return NULL;
+    }
+
+    /* A number is broadcast by using a step of 0 for its "sequence". */
+    if (xcls) {
+        xitems = &x;
+        xstep = 0;
+    }
+    else {
+        if (!(xseq = PySequence_Fast(x, "vector operation requires a sequence or a number")))
+            return NULL;
+        xitems = PySequence_Fast_ITEMS(xseq);
+    }
+    if (ycls) {
+        yitems = &y;
+        ystep = 0;
+    }
+    else {
+        if (!(yseq = PySequence_Fast(y, "vector operation requires a sequence or a number")))
+            goto done;
+        yitems = PySequence_Fast_ITEMS(yseq);
+    }
+
+    if (xseq && yseq) {
+        n = PySequence_Fast_GET_SIZE(xseq);
+        if (n != PySequence_Fast_GET_SIZE(yseq)) {
+            VALUE_ERROR("vector operation requires sequences of the same length");
+            goto done;
+        }
+    }
+    else {
+        n = PySequence_Fast_GET_SIZE(xseq ? xseq : yseq);
+    }
+
+    /* Decide once which kernel is used for the whole batch. */
+    cls = xseq ? vector_class(xitems, n, n ? GMPy_Vector_Class(xitems[0]) : 0) : xcls;
+    if (cls)
+        cls = yseq ? vector_class(yitems, n, cls) : (ycls == cls ? cls : 0);
+    kernel = op->kernel[cls];
+
+    if (!(result = PyList_New(n)))
+        goto done;
+
+    for (i = 0; i < n; i++) {
+        if (!(temp = kernel(xitems[i * xstep], yitems[i * ystep], context))) {
+            Py_CLEAR(result);
+            goto done;
+        }
+        PyList_SET_ITEM(result, i, temp);
+    }
+
+  done:
+    Py_XDECREF(xseq);
+    Py_XDECREF(yseq);
+    return result;
+}
+
+static PyObject *
+vector_context_apply(PyObject *self, PyObject *args, const gmpy_vector_op *op)
+{
+    CTXT_Object *context = NULL;
+
+    if (PyTuple_GET_SIZE(args) != 2) {
+        TYPE_ERROR("vector operation requires 2 arguments");
+        return NULL;
+    }
+
+    if (self && CTXT_Check(self)) {
+        context = (CTXT_Object*)self;
+    }
+    else {
+        CHECK_CONTEXT(context);
+    }
+
+    return GMPy_Vector_Apply(PyTuple_GET_ITEM(args, 0), PyTuple_GET_ITEM(args, 1), op, context);
+}
+
+static const gmpy_vector_op vector_add = {
+    { GMPy_Number_Add, GMPy_Integer_Add, GMPy_Rational_Add, GMPy_Real_Add, GMPy_Complex_Add }
+};
+
+static const gmpy_vector_op vector_sub = {
+    { GMPy_Number_Sub, GMPy_Integer_Sub, GMPy_Rational_Sub, GMPy_Real_Sub, GMPy_Complex_Sub }
+};
+
+static const gmpy_vector_op vector_mul = {
+    { GMPy_Number_Mul, GMPy_Integer_Mul, GMPy_Rational_Mul, GMPy_Real_Mul, GMPy_Complex_Mul }
+};
+
+static const gmpy_vector_op vector_div = {
+    { GMPy_Number_TrueDiv, GMPy_Integer_TrueDiv, GMPy_Rational_TrueDiv, GMPy_Real_TrueDiv, GMPy_Complex_TrueDiv }
+};
+
+PyDoc_STRVAR(GMPy_doc_context_vadd,
+"context.vadd(x, y) -> list\n\n"
+"Return the list [add(a, b) for a, b in zip(x, y)]. Either x or y may\n"
+"be a single number, which is then added to every item of the other.");
+
+static PyObject *
+GMPy_Context_VAdd(PyObject *self, PyObject *args)
+{
+    return vector_context_apply(self, args, &vector_add);
+}
+
+PyDoc_STRVAR(GMPy_doc_context_vsub,
+"context.vsub(x, y) -> list\n\n"
+"Return the list [sub(a, b) for a, b in zip(x, y)]. Either x or y may\n"
+"be a single number, which is then used with every item of the other.");
+
+static PyObject *
+GMPy_Context_VSub(PyObject *self, PyObject *args)
+{
+    return vector_context_apply(self, args, &vector_sub);
+}
+
+PyDoc_STRVAR(GMPy_doc_context_vmul,
+"context.vmul(x, y) -> list\n\n"
+"Return the list [mul(a, b) for a, b in zip(x, y)]. Either x or y may\n"
+"be a single number, which then multiplies every item of the other.");
+
+static PyObject *
+GMPy_Context_VMul(PyObject *self, PyObject *args)
+{
+    return vector_context_apply(self, args, &vector_mul);
+}
+
+PyDoc_STRVAR(GMPy_doc_context_vdiv,
+"context.vdiv(x, y) -> list\n\n"
+"Return the list [div(a, b) for a, b in zip(x, y)]. Either x or y may\n"
+"be a single number, which is then used with every item of the other.");
+
+static PyObject *
+GMPy_Context_VDiv(PyObject *self, PyObject *args)
+{
+    return vector_context_apply(self, args, &vector_div);
+}
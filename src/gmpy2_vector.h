@@ -0,0 +1,56 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_vector.h                                                          *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GMPY_VECTOR_H
+#define GMPY_VECTOR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef PyObject * (*gmpy_binaryfunc)(PyObject *, PyObject *, CTXT_Object *);
+
+/* The kernels used for one elementwise operation. The first kernel is
+ * used for a batch of mixed types; the others are used if every operand
+ * is an integer, rational, real, or complex, respectively.
+ */
+
+typedef struct {
+    gmpy_binaryfunc kernel[5];
+} gmpy_vector_op;
+
+static int GMPy_Vector_Class(PyObject *x);
+static PyObject * GMPy_Vector_Apply(PyObject *x, PyObject *y, const gmpy_vector_op *op, CTXT_Object *context);
+static PyObject * GMPy_Context_VAdd(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_VSub(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_VMul(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_VDiv(PyObject *self, PyObject *args);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -38,6 +38,9 @@ PyDoc_STRVAR(GMPy_doc_xmpz_factory,
 "     are recognized by leading 0b, 0o, or 0x characters, otherwise\n"
 "     the string is assumed to be decimal. Values for base can range\n"
 "     between 2 and 62.\n\n"
+"     The keyword argument 'capacity_bits' reserves room for a value of\n"
+"     that many bits so that in-place operations do not reallocate\n"
+"     until the value grows beyond it.\n\n"
 "     Note: 'xmpz' is a mutable integer. It can be faster for when\n"
 "     used for augmented assignment (+=, *=, etc.). 'xmpz' objects\n"
 "     cannot be used as dictionary keys. The use of 'mpz' objects is\n"
@@ -47,17 +50,17 @@ static PyObject *
 GMPy_XMPZ_Factory(PyObject *self, PyObject *args, PyObject *keywds)
 {
     XMPZ_Object *result = 0;
-    PyObject *n = 0;
+    PyObject *n = 0, *b = 0;
     int base = 0;
-    Py_ssize_t argc;
-    static char *kwlist[] = {"n", "base", NULL };
+    Py_ssize_t argc, capacity = 0;
+    static char *kwlist[] = {"n", "base", "capacity_bits", NULL };
     CTXT_Object *context = NULL;
 
     CHECK_CONTEXT(context);
 
     argc = PyTuple_GET_SIZE(args);
     
-    if (argc == 0) {
+    if (argc == 0 && !keywds) {
         if ((result = GMPy_XMPZ_New(context))) {
             mpz_set_ui(result->z, 0);
         }
@@ -78,24 +81,50 @@ GMPy_XMPZ_Factory(PyObject *self, PyObject *args, PyObject *keywds)
         return (PyObject*)result;
     }
 
-    if (!PyArg_ParseTupleAndKeywords(args, keywds, "O|i", kwlist, &n, &base)) {
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "|OOn", kwlist, &n, &b, &capacity)) {
         return NULL;
     }
 
+    if (b) {
+        base = c_long_From_Integer(b);
+        if (base == -1 && PyErr_Occurred()) {
+            return NULL;
+        }
+    }
+
     if ((base != 0) && ((base < 2)|| (base > 62))) {
         VALUE_ERROR("base for xmpz() must be 0 or in the interval [2, 62]");
         return NULL;
     }
 
-    if (PyStrOrUnicode_Check(n)) {
+    if (capacity < 0) {
+        VALUE_ERROR("capacity_bits for xmpz() must be >= 0");
+        return NULL;
+    }
+
+    if (!n) {
+        if ((result = GMPy_XMPZ_New(context))) {
+            mpz_set_ui(result->z, 0);
+        }
+    }
+    else if (PyStrOrUnicode_Check(n)) {
         result = GMPy_XMPZ_From_PyStr(n, base, context);
     }
     else if (IS_REAL(n)) {
-        TYPE_ERROR("xmpz() with number argument only takes 1 argument");
+        if (b) {
+            TYPE_ERROR("xmpz() with number argument only takes 1 argument");
+        }
+        else {
+            result = GMPy_XMPZ_From_Number(n, context);
+        }
     }
     else {
         TYPE_ERROR("xmpz() requires numeric or string (and optional base) arguments");
     }
+
+    if (result && (size_t)capacity > (size_t)result->z->_mp_alloc * GMP_NUMB_BITS) {
+        mpz_realloc2(result->z, (mp_bitcnt_t)capacity);
+    }
     return (PyObject*)result;
 }
 
@@ -183,6 +212,14 @@ static PyNumberMethods GMPy_XMPZ_number_methods =
 };
 #endif
 
+#ifdef PY3
+static PyBufferProcs GMPy_XMPZ_buffer_methods =
+{
+    (getbufferproc) GMPy_XMPZ_GetBuffer,          /* bf_getbuffer     */
+    (releasebufferproc) GMPy_XMPZ_ReleaseBuffer,  /* bf_releasebuffer */
+};
+#endif
+
 static PyMappingMethods GMPy_XMPZ_mapping_methods = {
     (lenfunc)GMPy_XMPZ_Method_Length,
     (binaryfunc)GMPy_XMPZ_Method_SubScript,
@@ -192,7 +229,11 @@ static PyMappingMethods GMPy_XMPZ_mapping_methods = {
 static PyMethodDef GMPy_XMPZ_methods [] =
 {
     { "__format__", GMPy_MPZ_Format, METH_VARARGS, GMPy_doc_mpz_format },
+#ifdef GMPY_PICKLE_BUFFER
+    { "__reduce_ex__", GMPy_MPANY_Reduce_Ex, METH_VARARGS, GMPy_doc_reduce_ex },
+#endif
     { "__sizeof__", GMPy_XMPZ_Method_SizeOf, METH_NOARGS, GMPy_doc_xmpz_method_sizeof },
+    { "addmul", GMPy_XMPZ_Method_AddMul, METH_VARARGS, GMPy_doc_xmpz_method_addmul },
     { "bit_clear", GMPy_MPZ_bit_clear_method, METH_O, doc_bit_clear_method },
     { "bit_flip", GMPy_MPZ_bit_flip_method, METH_O, doc_bit_flip_method },
     { "bit_length", GMPy_MPZ_bit_length_method, METH_NOARGS, doc_bit_length_method },
@@ -202,11 +243,25 @@ static PyMethodDef GMPy_XMPZ_methods [] =
     { "bit_test", GMPy_MPZ_bit_test_method, METH_O, doc_bit_test_method },
     { "copy", GMPy_XMPZ_Method_Copy, METH_NOARGS, GMPy_doc_xmpz_method_copy },
     { "digits", GMPy_XMPZ_Digits_Method, METH_VARARGS, GMPy_doc_mpz_digits_method },
+    { "fma_inplace", GMPy_XMPZ_Method_FMA_InPlace, METH_VARARGS, GMPy_doc_xmpz_method_fma_inplace },
+    { "get_bits", GMPy_MPZ_get_bits_method, METH_VARARGS, doc_get_bits_method },
+    { "hamdist", (PyCFunction)GMPy_XMPZ_Method_Hamdist, METH_VARARGS | METH_KEYWORDS, GMPy_doc_xmpz_method_hamdist },
+    { "indices_set", (PyCFunction)GMPy_XMPZ_Method_IndicesSet, METH_VARARGS | METH_KEYWORDS, GMPy_doc_xmpz_method_indices_set },
     { "iter_bits", (PyCFunction)GMPy_XMPZ_Method_IterBits, METH_VARARGS | METH_KEYWORDS, GMPy_doc_xmpz_method_iter_bits },
     { "iter_clear", (PyCFunction)GMPy_XMPZ_Method_IterClear, METH_VARARGS | METH_KEYWORDS, GMPy_doc_xmpz_method_iter_clear },
     { "iter_set", (PyCFunction)GMPy_XMPZ_Method_IterSet, METH_VARARGS | METH_KEYWORDS, GMPy_doc_xmpz_method_iter_set },
     { "make_mpz", GMPy_XMPZ_Method_MakeMPZ, METH_NOARGS, GMPy_doc_xmpz_method_make_mpz },
     { "num_digits", GMPy_MPZ_Method_NumDigits, METH_VARARGS, GMPy_doc_mpz_method_num_digits },
+    { "popcount", (PyCFunction)GMPy_XMPZ_Method_Popcount, METH_VARARGS | METH_KEYWORDS, GMPy_doc_xmpz_method_popcount },
+    { "rank", GMPy_XMPZ_Method_Rank, METH_O, GMPy_doc_xmpz_method_rank },
+    { "reserve", GMPy_XMPZ_Method_Reserve, METH_O, GMPy_doc_xmpz_method_reserve },
+    { "save", GMPy_XMPZ_Method_Save, METH_NOARGS, GMPy_doc_xmpz_method_save },
+    { "select", GMPy_XMPZ_Method_Select, METH_O, GMPy_doc_xmpz_method_select },
+    { "shrink_to_fit", GMPy_XMPZ_Method_ShrinkToFit, METH_NOARGS, GMPy_doc_xmpz_method_shrink_to_fit },
+    { "submul", GMPy_XMPZ_Method_SubMul, METH_VARARGS, GMPy_doc_xmpz_method_submul },
+#ifdef PY3
+    { "to_bytes", (PyCFunction)GMPy_MPZ_Method_ToBytes, METH_VARARGS | METH_KEYWORDS, GMPy_doc_mpz_method_to_bytes },
+#endif
     { NULL, NULL, 1 }
 };
 
@@ -237,7 +292,11 @@ static PyTypeObject XMPZ_Type =
     (reprfunc) GMPy_XMPZ_Str_Slot,          /* tp_str           */
         0,                                  /* tp_getattro      */
         0,                                  /* tp_setattro      */
+#ifdef PY3
+    &GMPy_XMPZ_buffer_methods,              /* tp_as_buffer     */
+#else
         0,                                  /* tp_as_buffer     */
+#endif
 #ifdef PY3
     Py_TPFLAGS_DEFAULT,                     /* tp_flags         */
 #else
@@ -32,20 +32,27 @@
 extern "C" {
 #endif
 
-typedef struct {
-    PyObject_HEAD
-    mpz_t z;
-} XMPZ_Object;
-
+/* XMPZ_Object, XMPZ() and XMPZ_Check() are defined in gmpy2_capi.h. */
 static PyTypeObject XMPZ_Type;
-#define XMPZ(obj) (((XMPZ_Object*)(obj))->z)
-#define XMPZ_Check(v) (((PyObject*)v)->ob_type == &XMPZ_Type)
 #define CHECK_MPZANY(v) (MPZ_Check(v) || XMPZ_Check(v))
 
+/* The limbs of an xmpz must not be reallocated while a buffer that refers
+ * to them is exported. Every operation that modifies an xmpz starts with
+ * XMPZ_CHECK_EXPORTS, so it also drops the index kept for rank(). */
+#define XMPZ_CHECK_EXPORTS(obj, ret) \
+    do { \
+        if (((XMPZ_Object*)(obj))->exports) { \
+            BUFFER_ERROR("xmpz cannot be modified while a buffer is exported"); \
+            return ret; \
+        } \
+        GMPy_XMPZ_Drop_Rank((XMPZ_Object*)(obj)); \
+    } while (0)
+
 typedef struct {
     PyObject_HEAD
     XMPZ_Object *bitmap;
     Py_ssize_t start, stop;
+    Py_ssize_t batch;       /* > 0 to return lists of up to batch positions */
     int iter_type;
 } GMPy_Iter_Object;
 
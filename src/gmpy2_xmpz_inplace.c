@@ -35,6 +35,8 @@
 static PyObject *
 GMPy_XMPZ_IAdd_Slot(PyObject *self, PyObject *other)
 {
+    XMPZ_CHECK_EXPORTS(self, NULL);
+
     /* Try to make mpz + small_int faster */
     if (PyIntOrLong_Check(other)) {
         int error;
@@ -50,10 +52,9 @@ GMPy_XMPZ_IAdd_Slot(PyObject *self, PyObject *other)
         }
         else {
             mpz_t tempz;
-            mpz_inoc(tempz);
-            mpz_set_PyIntOrLong(tempz, other);
+            mpz_inoc_pylong(tempz, other);
             mpz_add(MPZ(self), MPZ(self), tempz);
-            mpz_cloc(tempz);
+            mpz_cloc_pylong(tempz);
         }
         Py_INCREF(self);
         return self;
@@ -74,6 +75,8 @@ GMPy_XMPZ_IAdd_Slot(PyObject *self, PyObject *other)
 static PyObject *
 GMPy_XMPZ_ISub_Slot(PyObject *self, PyObject *other)
 {
+    XMPZ_CHECK_EXPORTS(self, NULL);
+
     if (PyIntOrLong_Check(other)) {
         int error;
         long temp = GMPy_Integer_AsLongAndError(other, &error);
@@ -88,10 +91,9 @@ GMPy_XMPZ_ISub_Slot(PyObject *self, PyObject *other)
         }
         else {
             mpz_t tempz;
-            mpz_inoc(tempz);
-            mpz_set_PyIntOrLong(tempz, other);
+            mpz_inoc_pylong(tempz, other);
             mpz_sub(MPZ(self), MPZ(self), tempz);
-            mpz_cloc(tempz);
+            mpz_cloc_pylong(tempz);
         }
         Py_INCREF(self);
         return self;
@@ -112,6 +114,8 @@ GMPy_XMPZ_ISub_Slot(PyObject *self, PyObject *other)
 static PyObject *
 GMPy_XMPZ_IMul_Slot(PyObject *self, PyObject *other)
 {
+    XMPZ_CHECK_EXPORTS(self, NULL);
+
     if (PyIntOrLong_Check(other)) {
         int error;
         long temp = GMPy_Integer_AsLongAndError(other, &error);
@@ -121,17 +125,16 @@ GMPy_XMPZ_IMul_Slot(PyObject *self, PyObject *other)
         }
         else {
             mpz_t tempz;
-            mpz_inoc(tempz);
-            mpz_set_PyIntOrLong(tempz, other);
-            mpz_mul(MPZ(self), MPZ(self), tempz);
-            mpz_cloc(tempz);
+            mpz_inoc_pylong(tempz, other);
+            GMPY_MPZ_MUL(MPZ(self), MPZ(self), tempz);
+            mpz_cloc_pylong(tempz);
         }
         Py_INCREF(self);
         return self;
     }
 
     if (CHECK_MPZANY(other)) {
-        mpz_mul(MPZ(self), MPZ(self), MPZ(other));
+        GMPY_MPZ_MUL(MPZ(self), MPZ(self), MPZ(other));
         Py_INCREF(self);
         return self;
     }
@@ -147,6 +150,8 @@ GMPy_XMPZ_IMul_Slot(PyObject *self, PyObject *other)
 static PyObject *
 GMPy_XMPZ_IFloorDiv_Slot(PyObject *self, PyObject *other)
 {
+    XMPZ_CHECK_EXPORTS(self, NULL);
+
     if (PyIntOrLong_Check(other)) {
         int error;
         long temp = GMPy_Integer_AsLongAndError(other, &error);
@@ -166,10 +171,9 @@ GMPy_XMPZ_IFloorDiv_Slot(PyObject *self, PyObject *other)
         }
         else {
             mpz_t tempz;
-            mpz_inoc(tempz);
-            mpz_set_PyIntOrLong(tempz, other);
+            mpz_inoc_pylong(tempz, other);
             mpz_fdiv_q(MPZ(self), MPZ(self), tempz);
-            mpz_cloc(tempz);
+            mpz_cloc_pylong(tempz);
         }
         Py_INCREF(self);
         return self;
@@ -194,6 +198,8 @@ GMPy_XMPZ_IFloorDiv_Slot(PyObject *self, PyObject *other)
 static PyObject *
 GMPy_XMPZ_IRem_Slot(PyObject *self, PyObject *other)
 {
+    XMPZ_CHECK_EXPORTS(self, NULL);
+
     if (PyIntOrLong_Check(other)) {
         int error;
         long temp = GMPy_Integer_AsLongAndError(other, &error);
@@ -212,10 +218,9 @@ GMPy_XMPZ_IRem_Slot(PyObject *self, PyObject *other)
         }
         else {
             mpz_t tempz;
-            mpz_inoc(tempz);
-            mpz_set_PyIntOrLong(tempz, other);
+            mpz_inoc_pylong(tempz, other);
             mpz_fdiv_r(MPZ(self), MPZ(self), tempz);
-            mpz_cloc(tempz);
+            mpz_cloc_pylong(tempz);
         }
         Py_INCREF(self);
         return self;
@@ -242,6 +247,8 @@ GMPy_XMPZ_IRshift_Slot(PyObject *self, PyObject *other)
 {
     mp_bitcnt_t shift;
 
+    XMPZ_CHECK_EXPORTS(self, NULL);
+
     if (IS_INTEGER(other)) {
         shift = mp_bitcnt_t_From_Integer(other);
         if (shift == (mp_bitcnt_t)(-1) && PyErr_Occurred())
@@ -263,11 +270,16 @@ GMPy_XMPZ_ILshift_Slot(PyObject *self, PyObject *other)
 {
     mp_bitcnt_t shift;
 
+    XMPZ_CHECK_EXPORTS(self, NULL);
+
     if (IS_INTEGER(other)) {
         shift = mp_bitcnt_t_From_Integer(other);
         if (shift == (mp_bitcnt_t)(-1) && PyErr_Occurred())
             return NULL;
 
+        if (GMPY_LIMB_CHECK((double)mpz_sizeinbase(MPZ(self), 2) + shift, NULL))
+            return NULL;
+
         mpz_mul_2exp(MPZ(self), MPZ(self), shift);
         Py_INCREF(self);
         return self;
@@ -284,12 +296,17 @@ GMPy_XMPZ_IPow_Slot(PyObject *self, PyObject *other, PyObject *mod)
 {
     mp_bitcnt_t exp;
 
+    XMPZ_CHECK_EXPORTS(self, NULL);
+
     exp = mp_bitcnt_t_From_Integer(other);
     if (exp == (mp_bitcnt_t)(-1) && PyErr_Occurred()) {
         PyErr_Clear();
         Py_RETURN_NOTIMPLEMENTED;
     }
 
+    if (GMPY_LIMB_CHECK(exp * GMPy_Limb_Log2_MPZ(MPZ(self)), NULL))
+        return NULL;
+
     mpz_pow_ui(MPZ(self), MPZ(self), exp);
     Py_INCREF((PyObject*)self);
     return (PyObject*)self;
@@ -303,6 +320,8 @@ GMPy_XMPZ_IAnd_Slot(PyObject *self, PyObject *other)
 {
     mpz_t tempz;
 
+    XMPZ_CHECK_EXPORTS(self, NULL);
+
     if (CHECK_MPZANY(other)) {
         mpz_and(MPZ(self), MPZ(self), MPZ(other));
         Py_INCREF(self);
@@ -310,10 +329,9 @@ GMPy_XMPZ_IAnd_Slot(PyObject *self, PyObject *other)
     }
 
     if (PyIntOrLong_Check(other)) {
-        mpz_inoc(tempz);
-        mpz_set_PyIntOrLong(tempz, other);
+        mpz_inoc_pylong(tempz, other);
         mpz_and(MPZ(self), MPZ(self), tempz);
-        mpz_cloc(tempz);
+        mpz_cloc_pylong(tempz);
         Py_INCREF(self);
         return self;
     }
@@ -329,6 +347,8 @@ GMPy_XMPZ_IXor_Slot(PyObject *self, PyObject *other)
 {
     mpz_t tempz;
 
+    XMPZ_CHECK_EXPORTS(self, NULL);
+
     if(CHECK_MPZANY(other)) {
         mpz_xor(MPZ(self), MPZ(self), MPZ(other));
         Py_INCREF(self);
@@ -336,10 +356,9 @@ GMPy_XMPZ_IXor_Slot(PyObject *self, PyObject *other)
     }
 
     if(PyIntOrLong_Check(other)) {
-        mpz_inoc(tempz);
-        mpz_set_PyIntOrLong(tempz, other);
+        mpz_inoc_pylong(tempz, other);
         mpz_xor(MPZ(self), MPZ(self), tempz);
-        mpz_cloc(tempz);
+        mpz_cloc_pylong(tempz);
         Py_INCREF(self);
         return self;
     }
@@ -355,6 +374,8 @@ GMPy_XMPZ_IIor_Slot(PyObject *self, PyObject *other)
 {
     mpz_t tempz;
 
+    XMPZ_CHECK_EXPORTS(self, NULL);
+
     if(CHECK_MPZANY(other)) {
         mpz_ior(MPZ(self), MPZ(self), MPZ(other));
         Py_INCREF(self);
@@ -362,10 +383,9 @@ GMPy_XMPZ_IIor_Slot(PyObject *self, PyObject *other)
     }
 
     if(PyIntOrLong_Check(other)) {
-        mpz_inoc(tempz);
-        mpz_set_PyIntOrLong(tempz, other);
+        mpz_inoc_pylong(tempz, other);
         mpz_ior(MPZ(self), MPZ(self), tempz);
-        mpz_cloc(tempz);
+        mpz_cloc_pylong(tempz);
         Py_INCREF(self);
         return self;
     }
@@ -91,6 +91,7 @@ GMPy_XMPZ_NonZero_Slot(XMPZ_Object *x)
 static PyObject *
 GMPy_XMPZ_Com_Slot(XMPZ_Object *x)
 {
+    XMPZ_CHECK_EXPORTS(x, NULL);
     mpz_com(x->z, x->z);
     Py_RETURN_NONE;
 }
@@ -130,6 +131,7 @@ GMPy_XMPZ_Method_MakeMPZ(PyObject *self, PyObject *other)
     MPZ_Object* result;
     CTXT_Object *context = NULL;
 
+    XMPZ_CHECK_EXPORTS(self, NULL);
     CHECK_CONTEXT(context);
 
     if (!(result = GMPy_MPZ_New(context))) {
@@ -207,7 +209,10 @@ GMPy_XMPZ_Method_SubScript(XMPZ_Object* self, PyObject* item)
         }
 
         mpz_set_ui(result->z, 0);
-        if (slicelength > 0) {
+        if (slicelength > 0 && step == 1) {
+            GMPy_MPZ_Get_Bits(result->z, self->z, start, slicelength);
+        }
+        else if (slicelength > 0) {
             for (cur = start, i = 0; i < slicelength; cur += step, i++) {
                 if (mpz_tstbit(self->z, cur)) {
                     mpz_setbit(result->z, i);
@@ -227,6 +232,7 @@ GMPy_XMPZ_Method_AssignSubScript(XMPZ_Object* self, PyObject* item, PyObject* va
 {
     CTXT_Object *context = NULL;
 
+    XMPZ_CHECK_EXPORTS(self, -1);
     CHECK_CONTEXT(context);
 
     if (PyIndex_Check(item)) {
@@ -304,7 +310,10 @@ GMPy_XMPZ_Method_AssignSubScript(XMPZ_Object* self, PyObject* item, PyObject* va
                 VALUE_ERROR("must specify bit sequence as an integer");
                 return -1;
             }
-            if (mpz_sgn(tempx->z) == 0) {
+            if (step == 1) {
+                GMPy_MPZ_Set_Bits(self->z, start, slicelength, tempx->z);
+            }
+            else if (mpz_sgn(tempx->z) == 0) {
                 for (cur = start, i = 0; i < slicelength; cur += step, i++) {
                     mpz_clrbit(self->z, cur);
                 }
@@ -348,8 +357,101 @@ GMPy_XMPZ_Method_AssignSubScript(XMPZ_Object* self, PyObject* item, PyObject* va
  *      (scale*bit_position + offset) when bit_position is clear, beginning at
  *      'start', ending at 'stop'.
  *
+ * With batch=N, iter_set() and iter_clear() return lists of up to N bit
+ * positions instead. The lists are filled by GMPy_XMPZ_Collect(), which
+ * decodes a limb at a time.
+ */
+
+/* Return the number of trailing 0-bits of a nonzero limb. */
+
+static int
+limb_ctz(mp_limb_t w)
+{
+#if defined(__GNUC__)
+    if (sizeof(mp_limb_t) == sizeof(unsigned long))
+        return __builtin_ctzl((unsigned long)w);
+    return __builtin_ctzll((unsigned long long)w);
+#else
+    int n = 0;
+
+    while (!(w & 1)) {
+        w >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+/* Append to 'list' up to 'max' positions of the 1-bits of z (or the 0-bits
+ * if 'clear' is set) in [*start, stop), and advance *start past the last
+ * position that was examined. Returns -1, with an exception set, on error.
+ * A negative z is treated as two's complement, one bit at a time.
  */
 
+static int
+GMPy_XMPZ_Collect(mpz_srcptr z, int clear, Py_ssize_t *start, Py_ssize_t stop,
+                  Py_ssize_t max, PyObject *list)
+{
+    Py_ssize_t pos = *start < 0 ? 0 : *start, count = 0, bit;
+    size_t i, size = mpz_size(z);
+    mp_limb_t word;
+    PyObject *temp;
+
+    while (pos < stop && count < max) {
+        if (mpz_sgn(z) < 0) {
+            mp_bitcnt_t next = clear ? mpz_scan0(z, pos) : mpz_scan1(z, pos);
+
+            if (next == (mp_bitcnt_t)(-1) || next >= (mp_bitcnt_t)stop) {
+                pos = stop;
+                break;
+            }
+            bit = (Py_ssize_t)next;
+            if (!(temp = PyIntOrLong_FromSsize_t(bit)) ||
+                PyList_Append(list, temp) < 0) {
+                Py_XDECREF(temp);
+                return -1;
+            }
+            Py_DECREF(temp);
+            count++;
+            pos = bit + 1;
+            continue;
+        }
+
+        i = (size_t)pos / GMP_NUMB_BITS;
+        if (i >= size && !clear) {
+            pos = stop;
+            break;
+        }
+        word = i < size ? z->_mp_d[i] : 0;
+        if (clear)
+            word = ~word & GMP_NUMB_MASK;
+        word &= GMP_NUMB_MASK << (pos % GMP_NUMB_BITS);
+        pos = (Py_ssize_t)((i + 1) * GMP_NUMB_BITS);
+
+        while (word) {
+            bit = (Py_ssize_t)(i * GMP_NUMB_BITS) + limb_ctz(word);
+            if (bit >= stop) {
+                pos = stop;
+                break;
+            }
+            if (count == max) {
+                pos = bit;
+                break;
+            }
+            if (!(temp = PyIntOrLong_FromSsize_t(bit)) ||
+                PyList_Append(list, temp) < 0) {
+                Py_XDECREF(temp);
+                return -1;
+            }
+            Py_DECREF(temp);
+            count++;
+            word &= word - 1;
+        }
+    }
+    *start = pos < stop ? pos : stop;
+    return 0;
+}
+
 static GMPy_Iter_Object *
 GMPy_Iter_New(void)
 {
@@ -360,6 +462,7 @@ GMPy_Iter_New(void)
         result->bitmap = NULL;
         result->start = 0;
         result->stop = -1;
+        result->batch = 0;
         result->iter_type = 1;
     }
     return result;
@@ -383,6 +486,27 @@ GMPy_Iter_Next(GMPy_Iter_Object *self) {
     else
         current_stop = self->stop;
 
+    if (self->batch > 0 && self->iter_type != 1) {
+        if (self->start >= current_stop) {
+            PyErr_SetNone(PyExc_StopIteration);
+            return NULL;
+        }
+        if (!(result = PyList_New(0)))
+            return NULL;
+        if (GMPy_XMPZ_Collect(self->bitmap->z, self->iter_type == 3,
+                              &(self->start), current_stop, self->batch,
+                              result) < 0) {
+            Py_DECREF(result);
+            return NULL;
+        }
+        if (PyList_GET_SIZE(result) == 0) {
+            Py_DECREF(result);
+            PyErr_SetNone(PyExc_StopIteration);
+            return NULL;
+        }
+        return result;
+    }
+
     switch (self->iter_type) {
         case 1:
             if (self->start >= current_stop)
@@ -399,7 +523,7 @@ GMPy_Iter_Next(GMPy_Iter_Object *self) {
                 PyErr_SetNone(PyExc_StopIteration);
             else {
                 temp = mpz_scan1(self->bitmap->z, self->start);
-                if (temp == (mp_bitcnt_t)(-1))
+                if (temp == (mp_bitcnt_t)(-1) || temp >= current_stop)
                     PyErr_SetNone(PyExc_StopIteration);
                 else {
                     self->start = temp + 1;
@@ -466,83 +590,172 @@ GMPy_XMPZ_Method_IterBits(PyObject *self, PyObject *args, PyObject *kwargs)
 }
 
 PyDoc_STRVAR(GMPy_doc_xmpz_method_iter_set,
-"xmpz.iter_set(start=0, stop=-1) -> iterator\n\n"
+"xmpz.iter_set(start=0, stop=-1, batch=0) -> iterator\n\n"
 "Return an iterator yielding the bit position for every bit that\n"
 "is set in 'xmpz', beginning at 'start'. If a positive value is\n"
 "specified for 'stop', iteration is continued until 'stop' is\n"
 "reached. To match the behavior of slicing, 'stop' is not included.\n"
 "If a negative value is specified, iteration is continued until\n"
-"the last 1-bit. Note: the value of the underlying xmpz object can\n"
-"change during iteration.");
+"the last 1-bit. If 'batch' is positive, the iterator returns lists\n"
+"of up to 'batch' bit positions. Note: the value of the underlying\n"
+"xmpz object can change during iteration.");
 
 static PyObject *
 GMPy_XMPZ_Method_IterSet(PyObject *self, PyObject *args, PyObject *kwargs)
 {
     GMPy_Iter_Object *result;
-    Py_ssize_t start = 0, stop = -1;
+    Py_ssize_t start = 0, stop = -1, batch = 0;
 
-    static char *kwlist[] = {"start", "stop", NULL };
+    static char *kwlist[] = {"start", "stop", "batch", NULL };
 
     if (!(result = GMPy_Iter_New())) {
         return NULL;
     }
 
-    if (!(PyArg_ParseTupleAndKeywords(args, kwargs, "|nn", kwlist, &start, &stop))) {
+    if (!(PyArg_ParseTupleAndKeywords(args, kwargs, "|nnn", kwlist, &start, &stop, &batch))) {
         Py_XDECREF((PyObject*)result);
         return NULL;
     }
 
+    if (batch < 0) {
+        Py_DECREF((PyObject*)result);
+        VALUE_ERROR("batch must be 0 or positive");
+        return NULL;
+    }
+
     result->iter_type = 2;
     result->bitmap = (XMPZ_Object*)self;
     Py_INCREF(self);
     result->start = start;
     result->stop = stop;
+    result->batch = batch;
     return (PyObject*)result;
 }
 
 PyDoc_STRVAR(GMPy_doc_xmpz_method_iter_clear,
-"xmpz.iter_clear(start=0, stop=-1) -> iterator\n\n"
+"xmpz.iter_clear(start=0, stop=-1, batch=0) -> iterator\n\n"
 "Return every bit position that is clear in 'xmpz', beginning at\n"
 "'start'. If a positive value is specified for 'stop', iteration\n"
 "is continued until 'stop' is reached. If a negative value is specified,\n"
-"iteration is continued until the last 1-bit. Note: the value of the\n"
-"underlying xmpz object can change during iteration.");
+"iteration is continued until the last 1-bit. If 'batch' is positive,\n"
+"the iterator returns lists of up to 'batch' bit positions. Note: the\n"
+"value of the underlying xmpz object can change during iteration.");
+
+PyDoc_STRVAR(GMPy_doc_xmpz_method_indices_set,
+"xmpz.indices_set(start=0, stop=-1) -> list\n\n"
+"Return a list of the positions of the bits that are set in 'xmpz',\n"
+"beginning at 'start' and ending before 'stop'. If 'stop' is negative,\n"
+"the list ends at the last 1-bit. This gives the same positions as\n"
+"iter_set() but decodes a limb at a time.");
 
 static PyObject *
-GMPy_XMPZ_Method_IterClear(PyObject *self, PyObject *args, PyObject *kwargs)
+GMPy_XMPZ_Method_IndicesSet(PyObject *self, PyObject *args, PyObject *kwargs)
 {
-    GMPy_Iter_Object *result;
+    PyObject *result;
     Py_ssize_t start = 0, stop = -1;
 
     static char *kwlist[] = {"start", "stop", NULL };
 
+    if (!(PyArg_ParseTupleAndKeywords(args, kwargs, "|nn", kwlist, &start, &stop))) {
+        return NULL;
+    }
+
+    if (stop < 0)
+        stop = mpz_sizeinbase(MPZ(self), 2);
+
+    if (!(result = PyList_New(0)))
+        return NULL;
+
+    if (GMPy_XMPZ_Collect(MPZ(self), 0, &start, stop, PY_SSIZE_T_MAX, result) < 0) {
+        Py_DECREF(result);
+        return NULL;
+    }
+    return result;
+}
+
+static PyObject *
+GMPy_XMPZ_Method_IterClear(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    GMPy_Iter_Object *result;
+    Py_ssize_t start = 0, stop = -1, batch = 0;
+
+    static char *kwlist[] = {"start", "stop", "batch", NULL };
+
     if (!(result = GMPy_Iter_New())) {
         return NULL;
     }
 
-    if (!(PyArg_ParseTupleAndKeywords(args, kwargs, "|nn", kwlist, &start, &stop))) {
+    if (!(PyArg_ParseTupleAndKeywords(args, kwargs, "|nnn", kwlist, &start, &stop, &batch))) {
         Py_XDECREF((PyObject*)result);
         return NULL;
     }
 
+    if (batch < 0) {
+        Py_DECREF((PyObject*)result);
+        VALUE_ERROR("batch must be 0 or positive");
+        return NULL;
+    }
+
     result->iter_type = 3;
     result->bitmap = (XMPZ_Object*)self;
     Py_INCREF(self);
     result->start = start;
     result->stop = stop;
+    result->batch = batch;
     return (PyObject*)result;
 }
 
+PyDoc_STRVAR(GMPy_doc_xmpz_method_reserve,
+"x.reserve(bits)\n\n"
+"Reserve room in x for a value of 'bits' bits so that in-place\n"
+"operations do not reallocate until the value grows beyond it. The\n"
+"reserved memory is never reduced; see shrink_to_fit().");
+
+static PyObject *
+GMPy_XMPZ_Method_Reserve(PyObject *self, PyObject *other)
+{
+    mp_bitcnt_t bits;
+
+    bits = mp_bitcnt_t_From_Integer(other);
+    if (bits == (mp_bitcnt_t)(-1) && PyErr_Occurred()) {
+        return NULL;
+    }
+
+    if (bits > (mp_bitcnt_t)MPZ(self)->_mp_alloc * GMP_NUMB_BITS) {
+        XMPZ_CHECK_EXPORTS(self, NULL);
+        mpz_realloc2(MPZ(self), bits);
+    }
+    Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(GMPy_doc_xmpz_method_shrink_to_fit,
+"x.shrink_to_fit()\n\n"
+"Release the memory reserved by x beyond what its value requires.");
+
+static PyObject *
+GMPy_XMPZ_Method_ShrinkToFit(PyObject *self, PyObject *other)
+{
+    size_t size = mpz_size(MPZ(self));
+
+    if (size < (size_t)MPZ(self)->_mp_alloc) {
+        XMPZ_CHECK_EXPORTS(self, NULL);
+        mpz_realloc2(MPZ(self), (mp_bitcnt_t)(size ? size : 1) * GMP_NUMB_BITS);
+    }
+    Py_RETURN_NONE;
+}
+
 PyDoc_STRVAR(GMPy_doc_xmpz_method_sizeof,
 "x.__sizeof__()\n\n"
-"Returns the amount of memory consumed by x. Note: deleted xmpz objects\n"
-"are reused and may or may not be resized when a new value is assigned.");
+"Returns the amount of memory consumed by x, including the memory\n"
+"reserved for growth. Note: deleted xmpz objects are reused and may or\n"
+"may not be resized when a new value is assigned.");
 
 static PyObject *
 GMPy_XMPZ_Method_SizeOf(PyObject *self, PyObject *other)
 {
     return PyIntOrLong_FromSize_t(sizeof(XMPZ_Object) + \
-        (MPZ(self)->_mp_alloc * sizeof(mp_limb_t)));
+        (MPZ(self)->_mp_alloc * sizeof(mp_limb_t)) +
+        GMPy_XMPZ_Rank_Bytes((XMPZ_Object*)self));
 }
 
 static PyTypeObject GMPy_Iter_Type =
@@ -580,3 +793,35 @@ static PyTypeObject GMPy_Iter_Type =
     PyObject_SelfIter,                      /* tp_iter          */
     (iternextfunc)GMPy_Iter_Next,           /* tp_iternext      */
 };
+
+#ifdef PY3
+/* An xmpz exports its limbs as a writable buffer. The limbs cannot be
+ * reallocated while the buffer exists, so operations that modify the xmpz
+ * raise BufferError. Writes through the buffer may clear the high limbs,
+ * so the size is normalized when the buffer is released.
+ */
+
+static int
+GMPy_XMPZ_GetBuffer(XMPZ_Object *self, Py_buffer *view, int flags)
+{
+    if (PyBuffer_FillInfo(view, (PyObject*)self, self->z->_mp_d,
+                          (Py_ssize_t)(mpz_size(self->z) * sizeof(mp_limb_t)),
+                          0, flags) < 0)
+        return -1;
+    self->exports++;
+    /* The buffer can be written, so the index of rank() is not valid. */
+    GMPy_XMPZ_Drop_Rank(self);
+    return 0;
+}
+
+static void
+GMPy_XMPZ_ReleaseBuffer(XMPZ_Object *self, Py_buffer *view)
+{
+    int size = (int)mpz_size(self->z);
+
+    self->exports--;
+    while (size > 0 && self->z->_mp_d[size - 1] == 0)
+        size--;
+    self->z->_mp_size = (self->z->_mp_size < 0) ? -size : size;
+}
+#endif
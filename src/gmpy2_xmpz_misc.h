@@ -40,14 +40,24 @@ static PyObject * GMPy_XMPZ_Pos_Slot(XMPZ_Object *x);
 static PyObject * GMPy_XMPZ_Com_Slot(XMPZ_Object *x);
 static PyObject * GMPy_XMPZ_Method_MakeMPZ(PyObject *self, PyObject *other);
 static PyObject * GMPy_XMPZ_Method_Copy(PyObject *self, PyObject *other);
+static PyObject * GMPy_XMPZ_Method_Reserve(PyObject *self, PyObject *other);
+static PyObject * GMPy_XMPZ_Method_ShrinkToFit(PyObject *self, PyObject *other);
 static Py_ssize_t GMPy_XMPZ_Method_Length(XMPZ_Object *obj);
 static PyObject * GMPy_XMPZ_Method_SubScript(XMPZ_Object* self, PyObject* item);
 static int        GMPy_XMPZ_Method_AssignSubScript(XMPZ_Object* self, PyObject* item, PyObject* value);
 
+#ifdef PY3
+static int        GMPy_XMPZ_GetBuffer(XMPZ_Object *self, Py_buffer *view, int flags);
+static void       GMPy_XMPZ_ReleaseBuffer(XMPZ_Object *self, Py_buffer *view);
+#endif
+
 static GMPy_Iter_Object * GMPy_Iter_New(void);
 static void               GMPy_Iter_Dealloc(GMPy_Iter_Object *self);
 static PyObject *         GMPy_Iter_Next(GMPy_Iter_Object *self);
 static PyObject *         GMPy_Iter_Repr(GMPy_Iter_Object *self);
+static int                GMPy_XMPZ_Collect(mpz_srcptr z, int clear, Py_ssize_t *start,
+                                            Py_ssize_t stop, Py_ssize_t max, PyObject *list);
+static PyObject *         GMPy_XMPZ_Method_IndicesSet(PyObject *self, PyObject *args, PyObject *kwargs);
 static PyObject *         GMPy_XMPZ_Method_IterBits(PyObject *self, PyObject *args, PyObject *kwargs);
 static PyObject *         GMPy_XMPZ_Method_IterSet(PyObject *self, PyObject *args, PyObject *kwargs);
 static PyObject *         GMPy_XMPZ_Method_IterClear(PyObject *self, PyObject *args, PyObject *kwargs);
@@ -0,0 +1,366 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_xmpz_rank.c                                                       *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* Bit counting for xmpz bitmaps: popcount() over a range of bits, rank(),
+ * select(), and hamdist() over a range. See gmpy2_xmpz_rank.h for the
+ * block index used by rank() and select().
+ */
+
+static mp_bitcnt_t
+limb_popcount(mp_limb_t w)
+{
+    return mpn_popcount(&w, 1);
+}
+
+/* Return the number of 1-bits in [start, stop) of the limbs d[0..size-1]. */
+
+static mp_bitcnt_t
+rank_count_limbs(const mp_limb_t *d, size_t size, mp_bitcnt_t start, mp_bitcnt_t stop)
+{
+    size_t i0, i1;
+    mp_bitcnt_t count;
+
+    if (stop > (mp_bitcnt_t)size * GMP_NUMB_BITS)
+        stop = (mp_bitcnt_t)size * GMP_NUMB_BITS;
+    if (start >= stop)
+        return 0;
+
+    i0 = start / GMP_NUMB_BITS;
+    i1 = stop / GMP_NUMB_BITS;
+    if (i0 == i1)
+        return limb_popcount(d[i0] & (GMP_NUMB_MASK << (start % GMP_NUMB_BITS)) &
+                             (((mp_limb_t)1 << (stop % GMP_NUMB_BITS)) - 1));
+
+    count = limb_popcount(d[i0] & (GMP_NUMB_MASK << (start % GMP_NUMB_BITS)));
+    if (i1 > i0 + 1)
+        count += mpn_popcount(d + i0 + 1, i1 - i0 - 1);
+    if (stop % GMP_NUMB_BITS)
+        count += limb_popcount(d[i1] & (((mp_limb_t)1 << (stop % GMP_NUMB_BITS)) - 1));
+    return count;
+}
+
+/* Return the number of positions in [start, stop) where the limbs
+ * dx[0..size-1] and dy[0..size-1] differ. */
+
+static mp_bitcnt_t
+rank_hamdist_limbs(const mp_limb_t *dx, const mp_limb_t *dy, size_t size,
+                   mp_bitcnt_t start, mp_bitcnt_t stop)
+{
+    size_t i0, i1;
+    mp_bitcnt_t count;
+
+    if (stop > (mp_bitcnt_t)size * GMP_NUMB_BITS)
+        stop = (mp_bitcnt_t)size * GMP_NUMB_BITS;
+    if (start >= stop)
+        return 0;
+
+    i0 = start / GMP_NUMB_BITS;
+    i1 = stop / GMP_NUMB_BITS;
+    if (i0 == i1)
+        return limb_popcount((dx[i0] ^ dy[i0]) &
+                             (GMP_NUMB_MASK << (start % GMP_NUMB_BITS)) &
+                             (((mp_limb_t)1 << (stop % GMP_NUMB_BITS)) - 1));
+
+    count = limb_popcount((dx[i0] ^ dy[i0]) & (GMP_NUMB_MASK << (start % GMP_NUMB_BITS)));
+    if (i1 > i0 + 1)
+        count += mpn_hamdist(dx + i0 + 1, dy + i0 + 1, i1 - i0 - 1);
+    if (stop % GMP_NUMB_BITS)
+        count += limb_popcount((dx[i1] ^ dy[i1]) &
+                               (((mp_limb_t)1 << (stop % GMP_NUMB_BITS)) - 1));
+    return count;
+}
+
+/* Return the number of 1-bits in [start, stop) of z, using two's complement
+ * for a negative z. */
+
+static mp_bitcnt_t
+rank_count(mpz_srcptr z, mp_bitcnt_t start, mp_bitcnt_t stop)
+{
+    mp_bitcnt_t count;
+    mpz_t temp;
+
+    if (start >= stop)
+        return 0;
+    if (mpz_sgn(z) >= 0)
+        return rank_count_limbs(z->_mp_d, mpz_size(z), start, stop);
+
+    /* The bits of z are those of -z-1 inverted. */
+    mpz_init(temp);
+    mpz_neg(temp, z);
+    mpz_sub_ui(temp, temp, 1);
+    count = (stop - start) - rank_count_limbs(temp->_mp_d, mpz_size(temp), start, stop);
+    mpz_clear(temp);
+    return count;
+}
+
+static void
+GMPy_XMPZ_Drop_Rank(XMPZ_Object *obj)
+{
+    if (obj->rank) {
+        GMPY_FREE(obj->rank);
+        obj->rank = NULL;
+    }
+}
+
+static size_t
+GMPy_XMPZ_Rank_Bytes(XMPZ_Object *obj)
+{
+    if (!obj->rank)
+        return 0;
+    return sizeof(gmpy_rank_index) +
+           (obj->rank->size / RANK_BLOCK) * sizeof(mp_bitcnt_t);
+}
+
+/* Return the index of a nonnegative xmpz, building it if necessary, or NULL
+ * if the value is too small to need one, a buffer is exported, or there is
+ * no memory for it. */
+
+static gmpy_rank_index *
+rank_index(XMPZ_Object *obj)
+{
+    size_t size = mpz_size(obj->z), blocks, j;
+    gmpy_rank_index *index;
+
+    if (obj->rank && obj->rank->size == size)
+        return obj->rank;
+    GMPy_XMPZ_Drop_Rank(obj);
+
+    if (size < RANK_MIN_LIMBS || obj->exports || mpz_sgn(obj->z) < 0)
+        return NULL;
+
+    blocks = size / RANK_BLOCK;
+    if (!(index = GMPY_MALLOC(sizeof(gmpy_rank_index) + blocks * sizeof(mp_bitcnt_t))))
+        return NULL;
+
+    index->size = size;
+    index->counts[0] = 0;
+    for (j = 0; j < blocks; j++)
+        index->counts[j + 1] = index->counts[j] +
+                               mpn_popcount(obj->z->_mp_d + j * RANK_BLOCK, RANK_BLOCK);
+    index->total = index->counts[blocks];
+    if (size > blocks * RANK_BLOCK)
+        index->total += mpn_popcount(obj->z->_mp_d + blocks * RANK_BLOCK,
+                                     size - blocks * RANK_BLOCK);
+    obj->rank = index;
+    return index;
+}
+
+/* Parse the optional start and stop of a bit range. A negative stop means
+ * the end of the value; *stop is then set to (mp_bitcnt_t)(-1). */
+
+static int
+rank_parse_range(PyObject *args, PyObject *kwargs, char *fmt, char **kwlist,
+                 PyObject **other, mp_bitcnt_t *start, mp_bitcnt_t *stop)
+{
+    Py_ssize_t pstart = 0, pstop = -1;
+    int ok;
+
+    if (other)
+        ok = PyArg_ParseTupleAndKeywords(args, kwargs, fmt, kwlist, other,
+                                         &pstart, &pstop);
+    else
+        ok = PyArg_ParseTupleAndKeywords(args, kwargs, fmt, kwlist,
+                                         &pstart, &pstop);
+    if (!ok)
+        return -1;
+
+    if (pstart < 0) {
+        VALUE_ERROR("start must be >= 0");
+        return -1;
+    }
+    *start = (mp_bitcnt_t)pstart;
+    *stop = pstop < 0 ? (mp_bitcnt_t)(-1) : (mp_bitcnt_t)pstop;
+    return 0;
+}
+
+PyDoc_STRVAR(GMPy_doc_xmpz_method_popcount,
+"x.popcount(start=0, stop=-1) -> int\n\n"
+"Return the number of 1-bits of x in the bit positions from 'start'\n"
+"up to, but not including, 'stop'. If 'stop' is negative, count to\n"
+"the end of x; a negative x then has infinitely many 1-bits and -1\n"
+"is returned.");
+
+static PyObject *
+GMPy_XMPZ_Method_Popcount(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    mp_bitcnt_t start, stop;
+
+    static char *kwlist[] = {"start", "stop", NULL };
+
+    if (rank_parse_range(args, kwargs, "|nn", kwlist, NULL, &start, &stop) < 0)
+        return NULL;
+
+    if (stop == (mp_bitcnt_t)(-1)) {
+        if (mpz_sgn(MPZ(self)) < 0)
+            return PyLong_FromLong(-1);
+        stop = mpz_sizeinbase(MPZ(self), 2);
+    }
+    return PyIntOrLong_From_mp_bitcnt_t(rank_count(MPZ(self), start, stop));
+}
+
+PyDoc_STRVAR(GMPy_doc_xmpz_method_rank,
+"x.rank(i) -> int\n\n"
+"Return the number of 1-bits of x below bit position i. The counts of\n"
+"large values are taken from an index that is kept until x is modified.");
+
+static PyObject *
+GMPy_XMPZ_Method_Rank(PyObject *self, PyObject *other)
+{
+    mp_bitcnt_t i, block;
+    gmpy_rank_index *index;
+
+    i = mp_bitcnt_t_From_Integer(other);
+    if (i == (mp_bitcnt_t)(-1) && PyErr_Occurred())
+        return NULL;
+
+    if (!(index = rank_index((XMPZ_Object*)self)))
+        return PyIntOrLong_From_mp_bitcnt_t(rank_count(MPZ(self), 0, i));
+
+    if (i >= (mp_bitcnt_t)index->size * GMP_NUMB_BITS)
+        return PyIntOrLong_From_mp_bitcnt_t(index->total);
+
+    block = i / (GMP_NUMB_BITS * RANK_BLOCK);
+    return PyIntOrLong_From_mp_bitcnt_t(index->counts[block] +
+        rank_count_limbs(MPZ(self)->_mp_d, index->size,
+                         block * GMP_NUMB_BITS * RANK_BLOCK, i));
+}
+
+PyDoc_STRVAR(GMPy_doc_xmpz_method_select,
+"x.select(k) -> int\n\n"
+"Return the bit position of the k-th 1-bit of x, counting from 0, so\n"
+"that x.rank(x.select(k)) == k. x must not be negative. IndexError is\n"
+"raised if x has k or fewer 1-bits.");
+
+static PyObject *
+GMPy_XMPZ_Method_Select(PyObject *self, PyObject *other)
+{
+    mp_bitcnt_t k, total;
+    size_t j = 0, lo, hi, mid, size = mpz_size(MPZ(self));
+    const mp_limb_t *d = MPZ(self)->_mp_d;
+    gmpy_rank_index *index;
+    mp_limb_t w;
+
+    k = mp_bitcnt_t_From_Integer(other);
+    if (k == (mp_bitcnt_t)(-1) && PyErr_Occurred())
+        return NULL;
+
+    if (mpz_sgn(MPZ(self)) < 0) {
+        VALUE_ERROR("select() requires a nonnegative xmpz");
+        return NULL;
+    }
+
+    if ((index = rank_index((XMPZ_Object*)self))) {
+        total = index->total;
+        if (k >= total) {
+            INDEX_ERROR("select() index out of range");
+            return NULL;
+        }
+
+        /* Find the last block that starts with at most k 1-bits below it. */
+        lo = 0;
+        hi = size / RANK_BLOCK;
+        while (lo < hi) {
+            mid = (lo + hi + 1) / 2;
+            if (index->counts[mid] <= k)
+                lo = mid;
+            else
+                hi = mid - 1;
+        }
+        k -= index->counts[lo];
+        j = lo * RANK_BLOCK;
+    }
+    else if (size == 0 || k >= mpn_popcount(d, size)) {
+        INDEX_ERROR("select() index out of range");
+        return NULL;
+    }
+
+    while ((total = limb_popcount(d[j])) <= k) {
+        k -= total;
+        j++;
+    }
+    for (w = d[j]; k > 0; k--)
+        w &= w - 1;
+    return PyIntOrLong_From_mp_bitcnt_t((mp_bitcnt_t)j * GMP_NUMB_BITS + limb_ctz(w));
+}
+
+PyDoc_STRVAR(GMPy_doc_xmpz_method_hamdist,
+"x.hamdist(y, start=0, stop=-1) -> int\n\n"
+"Return the number of bit positions from 'start' up to, but not\n"
+"including, 'stop' where x and y differ. If 'stop' is negative, count\n"
+"to the end of the longer value; -1 is returned if only one of x and\n"
+"y is negative.");
+
+static PyObject *
+GMPy_XMPZ_Method_Hamdist(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    PyObject *other = NULL;
+    MPZ_Object *tempy;
+    mp_bitcnt_t start, stop, count;
+    static char *kwlist[] = {"y", "start", "stop", NULL };
+
+    if (rank_parse_range(args, kwargs, "O|nn", kwlist, &other, &start, &stop) < 0)
+        return NULL;
+
+    if (!(tempy = GMPy_MPZ_From_Integer(other, NULL)))
+        return NULL;
+
+    if (stop == (mp_bitcnt_t)(-1)) {
+        if ((mpz_sgn(MPZ(self)) < 0) != (mpz_sgn(tempy->z) < 0)) {
+            Py_DECREF((PyObject*)tempy);
+            return PyLong_FromLong(-1);
+        }
+        stop = mpz_sizeinbase(MPZ(self), 2);
+        if (mpz_sizeinbase(tempy->z, 2) > stop)
+            stop = mpz_sizeinbase(tempy->z, 2);
+    }
+
+    if (mpz_sgn(MPZ(self)) >= 0 && mpz_sgn(tempy->z) >= 0) {
+        const mp_limb_t *dx = MPZ(self)->_mp_d, *dy = tempy->z->_mp_d, *dt;
+        size_t sx = mpz_size(MPZ(self)), sy = mpz_size(tempy->z), st;
+        mp_bitcnt_t high;
+
+        if (sx < sy) {
+            dt = dx; dx = dy; dy = dt;
+            st = sx; sx = sy; sy = st;
+        }
+        /* Above the shorter value, the bits that differ are the 1-bits of
+         * the longer one. */
+        high = (mp_bitcnt_t)sy * GMP_NUMB_BITS;
+        count = rank_hamdist_limbs(dx, dy, sy, start, stop) +
+                rank_count_limbs(dx, sx, start > high ? start : high, stop);
+    }
+    else {
+        mpz_t temp;
+
+        mpz_init(temp);
+        mpz_xor(temp, MPZ(self), tempy->z);
+        count = rank_count(temp, start, stop);
+        mpz_clear(temp);
+    }
+    Py_DECREF((PyObject*)tempy);
+    return PyIntOrLong_From_mp_bitcnt_t(count);
+}
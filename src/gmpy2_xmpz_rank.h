@@ -0,0 +1,63 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_xmpz_rank.h                                                       *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GMPY_XMPZ_RANK_H
+#define GMPY_XMPZ_RANK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* An xmpz used as a bitmap can keep an index of the number of 1-bits that
+ * precede every block of RANK_BLOCK limbs, so rank() and select() only
+ * count the bits of one block. The index is built on the first query of a
+ * value of at least RANK_MIN_LIMBS limbs, and it is dropped by every
+ * operation that modifies the xmpz (see XMPZ_CHECK_EXPORTS) and when a
+ * buffer is exported.
+ */
+
+#define RANK_BLOCK 32
+#define RANK_MIN_LIMBS (4 * RANK_BLOCK)
+
+typedef struct gmpy_rank_index {
+    size_t size;                /* mpz_size() of the indexed value */
+    mp_bitcnt_t total;          /* number of 1-bits in the value */
+    mp_bitcnt_t counts[1];      /* counts[j]: 1-bits below block j */
+} gmpy_rank_index;
+
+static void       GMPy_XMPZ_Drop_Rank(XMPZ_Object *obj);
+static size_t     GMPy_XMPZ_Rank_Bytes(XMPZ_Object *obj);
+
+static PyObject * GMPy_XMPZ_Method_Popcount(PyObject *self, PyObject *args, PyObject *kwargs);
+static PyObject * GMPy_XMPZ_Method_Rank(PyObject *self, PyObject *other);
+static PyObject * GMPy_XMPZ_Method_Select(PyObject *self, PyObject *other);
+static PyObject * GMPy_XMPZ_Method_Hamdist(PyObject *self, PyObject *args, PyObject *kwargs);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -1,655 +1,778 @@
-/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
- * gmpy_mpz_lucas.c                                                        *
- * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
- * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
- * libraries.                                                              *
- *                                                                         *
- * Copyright 2011 David Cleaver                                            *
- *                                                                         *
- * Copyright 2012, 2013, 2014 Case Van Horsen                              *
- *                                                                         *
- * The original file is available at:                                      *
- *   <http://sourceforge.net/projects/mpzlucas/files/>                     *
- *                                                                         *
- * Modified by Case Van Horsen for inclusion into GMPY2.                   *
- *                                                                         *
- * This file is part of GMPY2.                                             *
- *                                                                         *
- * GMPY2 is free software: you can redistribute it and/or modify it under  *
- * the terms of the GNU Lesser General Public License as published by the  *
- * Free Software Foundation, either version 3 of the License, or (at your  *
- * option) any later version.                                              *
- *                                                                         *
- * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
- * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
- * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
- * License for more details.                                               *
- *                                                                         *
- * You should have received a copy of the GNU Lesser General Public        *
- * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
- * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
-
-PyDoc_STRVAR(doc_mpz_lucasu,
-"lucasu(p,q,k) -> mpz\n\n"
-"Return the k-th element of the Lucas U sequence defined by p,q.\n"
-"p*p - 4*q must not equal 0; k must be greater than or equal to 0.");
-
-static PyObject *
-GMPY_mpz_lucasu(PyObject *self, PyObject *args)
-{
-    /* Adaptation of algorithm found in http://joye.site88.net/papers/JQ96lucas.pdf
-     * calculate u[k] of Lucas U sequence for p,q.
-     * Note: p^2-4q=0 is not tested, not a proper Lucas sequence!!
-     */
-
-    MPZ_Object *result = 0, *p, *q, *k;
-    size_t s = 0, j = 0;
-    mpz_t uh, vl, vh, ql, qh, tmp;
-
-    if (PyTuple_Size(args) != 3) {
-        TYPE_ERROR("lucasu() requires 3 integer arguments");
-        return NULL;
-    }
-
-    /* Take advantage of the cache of mpz_t objects maintained by GMPY2 to
-     * avoid memory allocations. */
-
-    mpz_inoc(uh);
-    mpz_inoc(vl);
-    mpz_inoc(vh);
-    mpz_inoc(ql);
-    mpz_inoc(qh);
-    mpz_inoc(tmp);
-
-    p = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
-    q = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL);
-    k = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 2), NULL);
-    if (!p || !q || !k) {
-        TYPE_ERROR("lucasu() requires 3 integer arguments");
-        goto cleanup;
-    }
-
-    /* Check if p*p - 4*q == 0. */
-
-    mpz_mul(tmp, p->z, p->z);
-    mpz_mul_ui(qh, q->z, 4);
-    mpz_sub(tmp, tmp, qh);
-    if (mpz_sgn(tmp) == 0) {
-        VALUE_ERROR("invalid values for p,q in lucasu()");
-        goto cleanup;
-    }
-
-    /* Check if k < 0. */
-
-    if (mpz_sgn(k->z) < 0) {
-        VALUE_ERROR("invalid value for k in lucasu()");
-        goto cleanup;
-    }
-
-    mpz_set_si(uh, 1);
-    mpz_set_si(vl, 2);
-    mpz_set(vh, p->z);
-    mpz_set_si(ql, 1);
-    mpz_set_si(qh, 1);
-    mpz_set_si(tmp, 0);
-
-    s = mpz_scan1(k->z, 0);
-    for (j = mpz_sizeinbase(k->z,2)-1; j >= s+1; j--) {
-        /* ql = ql*qh */
-        mpz_mul(ql, ql, qh);
-        if (mpz_tstbit(k->z,j) == 1) {
-            /* qh = ql*q */
-            mpz_mul(qh, ql, q->z);
-
-            /* uh = uh*vh */
-            mpz_mul(uh, uh, vh);
-
-            /* vl = vh*vl - p*ql */
-            mpz_mul(vl, vh, vl);
-            mpz_mul(tmp, ql, p->z);
-            mpz_sub(vl, vl, tmp);
-
-            /* vh = vh*vh - 2*qh */
-            mpz_mul(vh, vh, vh);
-            mpz_mul_si(tmp, qh, 2);
-            mpz_sub(vh, vh, tmp);
-        }
-        else {
-            /* qh = ql */
-            mpz_set(qh, ql);
-
-            /* uh = uh*vl - ql */
-            mpz_mul(uh, uh, vl);
-            mpz_sub(uh, uh, ql);
-
-            /* vh = vh*vl - p*ql */
-            mpz_mul(vh, vh, vl);
-            mpz_mul(tmp, ql, p->z);
-            mpz_sub(vh, vh, tmp);
-
-            /* vl = vl*vl - 2*ql */
-            mpz_mul(vl, vl, vl);
-            mpz_mul_si(tmp, ql, 2);
-            mpz_sub(vl, vl, tmp);
-        }
-    }
-    /* ql = ql*qh */
-    mpz_mul(ql, ql, qh);
-
-    /* qh = ql*q */
-    mpz_mul(qh, ql, q->z);
-
-    /* uh = uh*vl - ql */
-    mpz_mul(uh, uh, vl);
-    mpz_sub(uh, uh, ql);
-
-    /* vl = vh*vl - p*ql */
-    mpz_mul(vl, vh, vl);
-    mpz_mul(tmp, ql, p->z);
-    mpz_sub(vl, vl, tmp);
-
-    /* ql = ql*qh */
-    mpz_mul(ql, ql, qh);
-
-    for (j = 1; j <= s; j++) {
-        /* uh = uh*vl */
-        mpz_mul(uh, uh, vl);
-
-        /* vl = vl*vl - 2*ql */
-        mpz_mul(vl, vl, vl);
-        mpz_mul_si(tmp, ql, 2);
-        mpz_sub(vl, vl, tmp);
-
-        /* ql = ql*ql */
-        mpz_mul(ql, ql, ql);
-    }
-
-    if (!(result = GMPy_MPZ_New(NULL)))
-        goto cleanup;
-
-    /* uh contains our return value */
-    mpz_set(result->z, uh);
-
-  cleanup:
-    mpz_cloc(uh);
-    mpz_cloc(vl);
-    mpz_cloc(vh);
-    mpz_cloc(ql);
-    mpz_cloc(qh);
-    mpz_cloc(tmp);
-    Py_XDECREF((PyObject*)p);
-    Py_XDECREF((PyObject*)q);
-    Py_XDECREF((PyObject*)k);
-
-    return (PyObject*)result;
-}
-
-PyDoc_STRVAR(doc_mpz_lucasu_mod,
-"lucasu_mod(p,q,k,n) -> mpz\n\n"
-"Return the k-th element of the Lucas U sequence defined by p,q (mod n).\n"
-"p*p - 4*q must not equal 0; k must be greater than or equal to 0;\n"
-"n must be greater than 0.");
-
-static PyObject *
-GMPY_mpz_lucasu_mod(PyObject *self, PyObject *args)
-{
-    /* Adaptation of algorithm found in http://joye.site88.net/papers/JQ96lucas.pdf
-     * calculate u[k] (modulo n) of Lucas U sequence for p,q.
-     * Note: p^2-4q=0 is not tested, not a proper Lucas sequence!!
-     */
-
-    MPZ_Object *result = 0, *p, *q, *k, *n;
-
-    size_t s = 0, j = 0;
-    mpz_t uh, vl, vh, ql, qh, tmp;
-
-    if (PyTuple_Size(args) != 4) {
-        TYPE_ERROR("lucasu_mod() requires 4 integer arguments");
-        return NULL;
-    }
-
-    /* Take advantage of the cache of mpz_t objects maintained by GMPY2 to
-     * avoid memory allocations. */
-
-    mpz_inoc(uh);
-    mpz_inoc(vl);
-    mpz_inoc(vh);
-    mpz_inoc(ql);
-    mpz_inoc(qh);
-    mpz_inoc(tmp);
-
-    p = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
-    q = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL);
-    k = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 2), NULL);
-    n = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 3), NULL);
-    if (!p || !q || !k || !n) {
-        TYPE_ERROR("lucasu_mod() requires 4 integer arguments");
-        goto cleanup;
-    }
-
-    /* Check if p*p - 4*q == 0. */
-
-    mpz_mul(tmp, p->z, p->z);
-    mpz_mul_ui(qh, q->z, 4);
-    mpz_sub(tmp, tmp, qh);
-    if (mpz_sgn(tmp) == 0) {
-        VALUE_ERROR("invalid values for p,q in lucasu_mod()");
-        goto cleanup;
-    }
-
-    /* Check if k < 0. */
-
-    if (mpz_sgn(k->z) < 0) {
-        VALUE_ERROR("invalid value for k in lucasu_mod()");
-        goto cleanup;
-    }
-
-    /* Check if n > 0. */
-
-    if (mpz_sgn(n->z) <= 0) {
-        VALUE_ERROR("invalid value for n in lucasu_mod()");
-        goto cleanup;
-    }
-
-    mpz_set_si(uh, 1);
-    mpz_set_si(vl, 2);
-    mpz_set(vh, p->z);
-    mpz_set_si(ql, 1);
-    mpz_set_si(qh, 1);
-    mpz_set_si(tmp, 0);
-
-    s = mpz_scan1(k->z, 0);
-    for (j = mpz_sizeinbase(k->z,2)-1; j >= s+1; j--) {
-        /* ql = ql*qh (mod n) */
-        mpz_mul(ql, ql, qh);
-        mpz_mod(ql, ql, n->z);
-        if (mpz_tstbit(k->z,j) == 1) {
-            /* qh = ql*q */
-            mpz_mul(qh, ql, q->z);
-
-            /* uh = uh*vh (mod n) */
-            mpz_mul(uh, uh, vh);
-            mpz_mod(uh, uh, n->z);
-
-            /* vl = vh*vl - p*ql (mod n) */
-            mpz_mul(vl, vh, vl);
-            mpz_mul(tmp, ql, p->z);
-            mpz_sub(vl, vl, tmp);
-            mpz_mod(vl, vl, n->z);
-
-            /* vh = vh*vh - 2*qh (mod n) */
-            mpz_mul(vh, vh, vh);
-            mpz_mul_si(tmp, qh, 2);
-            mpz_sub(vh, vh, tmp);
-            mpz_mod(vh, vh, n->z);
-        }
-        else {
-            /* qh = ql */
-            mpz_set(qh, ql);
-
-            /* uh = uh*vl - ql (mod n) */
-            mpz_mul(uh, uh, vl);
-            mpz_sub(uh, uh, ql);
-            mpz_mod(uh, uh, n->z);
-
-            /* vh = vh*vl - p*ql (mod n) */
-            mpz_mul(vh, vh, vl);
-            mpz_mul(tmp, ql, p->z);
-            mpz_sub(vh, vh, tmp);
-            mpz_mod(vh, vh, n->z);
-
-            /* vl = vl*vl - 2*ql (mod n) */
-            mpz_mul(vl, vl, vl);
-            mpz_mul_si(tmp, ql, 2);
-            mpz_sub(vl, vl, tmp);
-            mpz_mod(vl, vl, n->z);
-        }
-    }
-    /* ql = ql*qh */
-    mpz_mul(ql, ql, qh);
-
-    /* qh = ql*q */
-    mpz_mul(qh, ql, q->z);
-
-    /* uh = uh*vl - ql */
-    mpz_mul(uh, uh, vl);
-    mpz_sub(uh, uh, ql);
-
-    /* vl = vh*vl - p*ql */
-    mpz_mul(vl, vh, vl);
-    mpz_mul(tmp, ql, p->z);
-    mpz_sub(vl, vl, tmp);
-
-    /* ql = ql*qh */
-    mpz_mul(ql, ql, qh);
-
-    for (j = 1; j <= s; j++) {
-        /* uh = uh*vl (mod n) */
-        mpz_mul(uh, uh, vl);
-        mpz_mod(uh, uh, n->z);
-
-        /* vl = vl*vl - 2*ql (mod n) */
-        mpz_mul(vl, vl, vl);
-        mpz_mul_si(tmp, ql, 2);
-        mpz_sub(vl, vl, tmp);
-        mpz_mod(vl, vl, n->z);
-
-        /* ql = ql*ql (mod n) */
-        mpz_mul(ql, ql, ql);
-        mpz_mod(ql, ql, n->z);
-    }
-
-    if (!(result = GMPy_MPZ_New(NULL)))
-        goto cleanup;
-
-    /* uh contains our return value */
-    mpz_mod(result->z, uh, n->z);
-
-  cleanup:
-    mpz_cloc(uh);
-    mpz_cloc(vl);
-    mpz_cloc(vh);
-    mpz_cloc(ql);
-    mpz_cloc(qh);
-    mpz_cloc(tmp);
-    Py_XDECREF((PyObject*)p);
-    Py_XDECREF((PyObject*)q);
-    Py_XDECREF((PyObject*)k);
-    Py_XDECREF((PyObject*)n);
-
-    return (PyObject*)result;
-}
-
-PyDoc_STRVAR(doc_mpz_lucasv,
-"lucasv(p,q,k) -> mpz\n\n"
-"Return the k-th element of the Lucas V sequence defined by p,q.\n"
-"p*p - 4*q must not equal 0; k must be greater than or equal to 0.");
-
-static PyObject *
-GMPY_mpz_lucasv(PyObject *self, PyObject *args)
-{
-    /* Adaptation of algorithm found in http://joye.site88.net/papers/JQ96lucas.pdf
-     * calculate v[k] of Lucas V sequence for p,q.
-     * Note: p^2-4q=0 is not tested, not a proper Lucas sequence!!
-     */
-
-    MPZ_Object *result = 0, *p, *q, *k;
-    size_t s = 0, j = 0;
-    mpz_t vl, vh, ql, qh, tmp;
-
-    if (PyTuple_Size(args) != 3) {
-        TYPE_ERROR("lucasv() requires 3 integer arguments");
-        return NULL;
-    }
-
-    /* Take advantage of the cache of mpz_t objects maintained by GMPY2 to
-     * avoid memory allocations. */
-
-    mpz_inoc(vl);
-    mpz_inoc(vh);
-    mpz_inoc(ql);
-    mpz_inoc(qh);
-    mpz_inoc(tmp);
-
-    p = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
-    q = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL);
-    k = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 2), NULL);
-    if (!p || !q || !k) {
-        TYPE_ERROR("lucasv() requires 3 integer arguments");
-        goto cleanup;
-    }
-
-    /* Check if p*p - 4*q == 0. */
-
-    mpz_mul(tmp, p->z, p->z);
-    mpz_mul_ui(qh, q->z, 4);
-    mpz_sub(tmp, tmp, qh);
-    if (mpz_sgn(tmp) == 0) {
-        VALUE_ERROR("invalid values for p,q in lucasv()");
-        goto cleanup;
-    }
-
-    /* Check if k < 0. */
-
-    if (mpz_sgn(k->z) < 0) {
-        VALUE_ERROR("invalid value for k in lucasv()");
-        goto cleanup;
-    }
-
-    mpz_set_si(vl, 2);
-    mpz_set(vh, p->z);
-    mpz_set_si(ql, 1);
-    mpz_set_si(qh, 1);
-    mpz_set_si(tmp,0);
-
-    s = mpz_scan1(k->z, 0);
-    for (j = mpz_sizeinbase(k->z,2)-1; j >= s+1; j--) {
-        /* ql = ql*qh */
-        mpz_mul(ql, ql, qh);
-        if (mpz_tstbit(k->z,j) == 1) {
-            /* qh = ql*q */
-            mpz_mul(qh, ql, q->z);
-
-            /* vl = vh*vl - p*ql */
-            mpz_mul(vl, vh, vl);
-            mpz_mul(tmp, ql, p->z);
-            mpz_sub(vl, vl, tmp);
-
-            /* vh = vh*vh - 2*qh */
-            mpz_mul(vh, vh, vh);
-            mpz_mul_si(tmp, qh, 2);
-            mpz_sub(vh, vh, tmp);
-        }
-        else {
-            /* qh = ql */
-            mpz_set(qh, ql);
-
-            /* vh = vh*vl - p*ql */
-            mpz_mul(vh, vh, vl);
-            mpz_mul(tmp, ql, p->z);
-            mpz_sub(vh, vh, tmp);
-
-            /* vl = vl*vl - 2*ql */
-            mpz_mul(vl, vl, vl);
-            mpz_mul_si(tmp, ql, 2);
-            mpz_sub(vl, vl, tmp);
-        }
-    }
-    /* ql = ql*qh */
-    mpz_mul(ql, ql, qh);
-
-    /* qh = ql*q */
-    mpz_mul(qh, ql, q->z);
-
-    /* vl = vh*vl - p*ql */
-    mpz_mul(vl, vh, vl);
-    mpz_mul(tmp, ql, p->z);
-    mpz_sub(vl, vl, tmp);
-
-    /* ql = ql*qh */
-    mpz_mul(ql, ql, qh);
-
-    for (j = 1; j <= s; j++) {
-        /* vl = vl*vl - 2*ql */
-        mpz_mul(vl, vl, vl);
-        mpz_mul_si(tmp, ql, 2);
-        mpz_sub(vl, vl, tmp);
-
-        /* ql = ql*ql */
-        mpz_mul(ql, ql, ql);
-    }
-
-    if (!(result = GMPy_MPZ_New(NULL)))
-        goto cleanup;
-
-    /* vl contains our return value */
-    mpz_set(result->z, vl);
-
-  cleanup:
-    mpz_cloc(vl);
-    mpz_cloc(vh);
-    mpz_cloc(ql);
-    mpz_cloc(qh);
-    mpz_cloc(tmp);
-    Py_XDECREF((PyObject*)p);
-    Py_XDECREF((PyObject*)q);
-    Py_XDECREF((PyObject*)k);
-
-    return (PyObject*)result;
-}
-
-PyDoc_STRVAR(doc_mpz_lucasv_mod,
-"lucasv_mod(p,q,k,n) -> mpz\n\n"
-"Return the k-th element of the Lucas V sequence defined by p,q (mod n).\n"
-"p*p - 4*q must not equal 0; k must be greater than or equal to 0;\n"
-"n must be greater than 0.");
-
-static PyObject *
-GMPY_mpz_lucasv_mod(PyObject *self, PyObject *args)
-{
-    /* Adaptation of algorithm found in http://joye.site88.net/papers/JQ96lucas.pdf
-     * calculate v[k] (modulo n) of Lucas V sequence for p,q.
-     * Note: p^2-4q=0 is not tested, not a proper Lucas sequence!!
-     */
-
-    MPZ_Object *result = 0, *p, *q, *k, *n;
-
-    size_t s = 0, j = 0;
-    mpz_t vl, vh, ql, qh, tmp;
-
-    if (PyTuple_Size(args) != 4) {
-        TYPE_ERROR("lucasv_mod() requires 4 integer arguments");
-        return NULL;
-    }
-
-    /* Take advantage of the cache of mpz_t objects maintained by GMPY2 to
-     * avoid memory allocations. */
-
-    mpz_inoc(vl);
-    mpz_inoc(vh);
-    mpz_inoc(ql);
-    mpz_inoc(qh);
-    mpz_inoc(tmp);
-
-    p = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
-    q = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL);
-    k = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 2), NULL);
-    n = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 3), NULL);
-    if (!p || !q || !k || !n) {
-        TYPE_ERROR("lucasv_mod() requires 4 integer arguments");
-        goto cleanup;
-    }
-
-    /* Check if p*p - 4*q == 0. */
-
-    mpz_mul(tmp, p->z, p->z);
-    mpz_mul_ui(qh, q->z, 4);
-    mpz_sub(tmp, tmp, qh);
-    if (mpz_sgn(tmp) == 0) {
-        VALUE_ERROR("invalid values for p,q in lucasv_mod()");
-        goto cleanup;
-    }
-
-    /* Check if k < 0. */
-
-    if (mpz_sgn(k->z) < 0) {
-        VALUE_ERROR("invalid value for k in lucasv_mod()");
-        goto cleanup;
-    }
-
-    /* Check if n > 0. */
-
-    if (mpz_sgn(n->z) <= 0) {
-        VALUE_ERROR("invalid value for n in lucasv_mod()");
-        goto cleanup;
-    }
-
-    mpz_set_si(vl, 2);
-    mpz_set(vh, p->z);
-    mpz_set_si(ql, 1);
-    mpz_set_si(qh, 1);
-    mpz_set_si(tmp,0);
-
-    s = mpz_scan1(k->z, 0);
-    for (j = mpz_sizeinbase(k->z,2)-1; j >= s+1; j--) {
-        /* ql = ql*qh (mod n) */
-        mpz_mul(ql, ql, qh);
-        mpz_mod(ql, ql, n->z);
-        if (mpz_tstbit(k->z,j) == 1) {
-            /* qh = ql*q */
-            mpz_mul(qh, ql, q->z);
-
-            /* vl = vh*vl - p*ql (mod n) */
-            mpz_mul(vl, vh, vl);
-            mpz_mul(tmp, ql, p->z);
-            mpz_sub(vl, vl, tmp);
-            mpz_mod(vl, vl, n->z);
-
-            /* vh = vh*vh - 2*qh (mod n) */
-            mpz_mul(vh, vh, vh);
-            mpz_mul_si(tmp, qh, 2);
-            mpz_sub(vh, vh, tmp);
-            mpz_mod(vh, vh, n->z);
-        }
-        else {
-            /* qh = ql */
-            mpz_set(qh, ql);
-
-            /* vh = vh*vl - p*ql (mod n) */
-            mpz_mul(vh, vh, vl);
-            mpz_mul(tmp, ql, p->z);
-            mpz_sub(vh, vh, tmp);
-            mpz_mod(vh, vh, n->z);
-
-            /* vl = vl*vl - 2*ql (mod n) */
-            mpz_mul(vl, vl, vl);
-            mpz_mul_si(tmp, ql, 2);
-            mpz_sub(vl, vl, tmp);
-            mpz_mod(vl, vl, n->z);
-        }
-    }
-    /* ql = ql*qh */
-    mpz_mul(ql, ql, qh);
-
-    /* qh = ql*q */
-    mpz_mul(qh, ql, q->z);
-
-    /* vl = vh*vl - p*ql */
-    mpz_mul(vl, vh, vl);
-    mpz_mul(tmp, ql, p->z);
-    mpz_sub(vl, vl, tmp);
-
-    /* ql = ql*qh */
-    mpz_mul(ql, ql, qh);
-
-    for (j = 1; j <= s; j++) {
-        /* vl = vl*vl - 2*ql (mod n) */
-        mpz_mul(vl, vl, vl);
-        mpz_mul_si(tmp, ql, 2);
-        mpz_sub(vl, vl, tmp);
-        mpz_mod(vl, vl, n->z);
-
-        /* ql = ql*ql (mod n) */
-        mpz_mul(ql, ql, ql);
-        mpz_mod(ql, ql, n->z);
-    }
-
-    if (!(result = GMPy_MPZ_New(NULL)))
-        goto cleanup;
-
-    /* vl contains our return value */
-    mpz_mod(result->z, vl, n->z);
-
-  cleanup:
-    mpz_cloc(vl);
-    mpz_cloc(vh);
-    mpz_cloc(ql);
-    mpz_cloc(qh);
-    mpz_cloc(tmp);
-    Py_XDECREF((PyObject*)p);
-    Py_XDECREF((PyObject*)q);
-    Py_XDECREF((PyObject*)k);
-    Py_XDECREF((PyObject*)n);
-
-    return (PyObject*)result;
-}
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy_mpz_lucas.c                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2011 David Cleaver                                            *
+ *                                                                         *
+ * Copyright 2012, 2013, 2014 Case Van Horsen                              *
+ *                                                                         *
+ * The original file is available at:                                      *
+ *   <http://sourceforge.net/projects/mpzlucas/files/>                     *
+ *                                                                         *
+ * Modified by Case Van Horsen for inclusion into GMPY2.                   *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+PyDoc_STRVAR(doc_mpz_lucasu,
+"lucasu(p,q,k) -> mpz\n\n"
+"Return the k-th element of the Lucas U sequence defined by p,q.\n"
+"p*p - 4*q must not equal 0; k must be greater than or equal to 0.");
+
+static PyObject *
+GMPY_mpz_lucasu(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    /* Adaptation of algorithm found in http://joye.site88.net/papers/JQ96lucas.pdf
+     * calculate u[k] of Lucas U sequence for p,q.
+     * Note: p^2-4q=0 is not tested, not a proper Lucas sequence!!
+     */
+
+    MPZ_Object *result = 0, *p, *q, *k;
+    size_t s = 0, j = 0;
+    mpz_t uh, vl, vh, ql, qh, tmp;
+
+    if (nargs != 3) {
+        TYPE_ERROR("lucasu() requires 3 integer arguments");
+        return NULL;
+    }
+
+    /* Take advantage of the cache of mpz_t objects maintained by GMPY2 to
+     * avoid memory allocations. */
+
+    mpz_inoc(uh);
+    mpz_inoc(vl);
+    mpz_inoc(vh);
+    mpz_inoc(ql);
+    mpz_inoc(qh);
+    mpz_inoc(tmp);
+
+    p = GMPy_MPZ_From_Integer(args[0], NULL);
+    q = GMPy_MPZ_From_Integer(args[1], NULL);
+    k = GMPy_MPZ_From_Integer(args[2], NULL);
+    if (!p || !q || !k) {
+        TYPE_ERROR("lucasu() requires 3 integer arguments");
+        goto cleanup;
+    }
+
+    /* Check if p*p - 4*q == 0. */
+
+    mpz_mul(tmp, p->z, p->z);
+    mpz_mul_ui(qh, q->z, 4);
+    mpz_sub(tmp, tmp, qh);
+    if (mpz_sgn(tmp) == 0) {
+        VALUE_ERROR("invalid values for p,q in lucasu()");
+        goto cleanup;
+    }
+
+    /* Check if k < 0. */
+
+    if (mpz_sgn(k->z) < 0) {
+        VALUE_ERROR("invalid value for k in lucasu()");
+        goto cleanup;
+    }
+
+    mpz_set_si(uh, 1);
+    mpz_set_si(vl, 2);
+    mpz_set(vh, p->z);
+    mpz_set_si(ql, 1);
+    mpz_set_si(qh, 1);
+    mpz_set_si(tmp, 0);
+
+    s = mpz_scan1(k->z, 0);
+    for (j = mpz_sizeinbase(k->z,2)-1; j >= s+1; j--) {
+        /* ql = ql*qh */
+        mpz_mul(ql, ql, qh);
+        if (mpz_tstbit(k->z,j) == 1) {
+            /* qh = ql*q */
+            mpz_mul(qh, ql, q->z);
+
+            /* uh = uh*vh */
+            mpz_mul(uh, uh, vh);
+
+            /* vl = vh*vl - p*ql */
+            mpz_mul(vl, vh, vl);
+            mpz_mul(tmp, ql, p->z);
+            mpz_sub(vl, vl, tmp);
+
+            /* vh = vh*vh - 2*qh */
+            mpz_mul(vh, vh, vh);
+            mpz_mul_si(tmp, qh, 2);
+            mpz_sub(vh, vh, tmp);
+        }
+        else {
+            /* qh = ql */
+            mpz_set(qh, ql);
+
+            /* uh = uh*vl - ql */
+            mpz_mul(uh, uh, vl);
+            mpz_sub(uh, uh, ql);
+
+            /* vh = vh*vl - p*ql */
+            mpz_mul(vh, vh, vl);
+            mpz_mul(tmp, ql, p->z);
+            mpz_sub(vh, vh, tmp);
+
+            /* vl = vl*vl - 2*ql */
+            mpz_mul(vl, vl, vl);
+            mpz_mul_si(tmp, ql, 2);
+            mpz_sub(vl, vl, tmp);
+        }
+    }
+    /* ql = ql*qh */
+    mpz_mul(ql, ql, qh);
+
+    /* qh = ql*q */
+    mpz_mul(qh, ql, q->z);
+
+    /* uh = uh*vl - ql */
+    mpz_mul(uh, uh, vl);
+    mpz_sub(uh, uh, ql);
+
+    /* vl = vh*vl - p*ql */
+    mpz_mul(vl, vh, vl);
+    mpz_mul(tmp, ql, p->z);
+    mpz_sub(vl, vl, tmp);
+
+    /* ql = ql*qh */
+    mpz_mul(ql, ql, qh);
+
+    for (j = 1; j <= s; j++) {
+        /* uh = uh*vl */
+        mpz_mul(uh, uh, vl);
+
+        /* vl = vl*vl - 2*ql */
+        mpz_mul(vl, vl, vl);
+        mpz_mul_si(tmp, ql, 2);
+        mpz_sub(vl, vl, tmp);
+
+        /* ql = ql*ql */
+        mpz_mul(ql, ql, ql);
+    }
+
+    if (!(result = GMPy_MPZ_New(NULL)))
+        goto cleanup;
+
+    /* uh contains our return value */
+    mpz_set(result->z, uh);
+
+  cleanup:
+    mpz_cloc(uh);
+    mpz_cloc(vl);
+    mpz_cloc(vh);
+    mpz_cloc(ql);
+    mpz_cloc(qh);
+    mpz_cloc(tmp);
+    Py_XDECREF((PyObject*)p);
+    Py_XDECREF((PyObject*)q);
+    Py_XDECREF((PyObject*)k);
+
+    return (PyObject*)result;
+}
+GMPY_FASTCALL_WRAPPER(GMPY_mpz_lucasu)
+
+PyDoc_STRVAR(doc_mpz_lucasu_mod,
+"lucasu_mod(p,q,k,n) -> mpz\n\n"
+"Return the k-th element of the Lucas U sequence defined by p,q (mod n).\n"
+"p*p - 4*q must not equal 0; k must be greater than or equal to 0;\n"
+"n must be greater than 0.");
+
+static PyObject *
+GMPY_mpz_lucasu_mod(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    /* Calculate u[k] (modulo n) of Lucas U sequence for p,q. */
+
+    MPZ_Object *result = 0, *p, *q, *k, *n;
+    mpz_t tmp;
+
+    if (nargs != 4) {
+        TYPE_ERROR("lucasu_mod() requires 4 integer arguments");
+        return NULL;
+    }
+
+    /* Take advantage of the cache of mpz_t objects maintained by GMPY2 to
+     * avoid memory allocations. */
+
+    mpz_inoc(tmp);
+
+    p = GMPy_MPZ_From_Integer(args[0], NULL);
+    q = GMPy_MPZ_From_Integer(args[1], NULL);
+    k = GMPy_MPZ_From_Integer(args[2], NULL);
+    n = GMPy_MPZ_From_Integer(args[3], NULL);
+    if (!p || !q || !k || !n) {
+        TYPE_ERROR("lucasu_mod() requires 4 integer arguments");
+        goto cleanup;
+    }
+
+    /* Check if p*p - 4*q == 0. */
+
+    mpz_mul(tmp, p->z, p->z);
+    mpz_submul_ui(tmp, q->z, 4);
+    if (mpz_sgn(tmp) == 0) {
+        VALUE_ERROR("invalid values for p,q in lucasu_mod()");
+        goto cleanup;
+    }
+
+    /* Check if k < 0. */
+
+    if (mpz_sgn(k->z) < 0) {
+        VALUE_ERROR("invalid value for k in lucasu_mod()");
+        goto cleanup;
+    }
+
+    /* Check if n > 0. */
+
+    if (mpz_sgn(n->z) <= 0) {
+        VALUE_ERROR("invalid value for n in lucasu_mod()");
+        goto cleanup;
+    }
+
+    if (!(result = GMPy_MPZ_New(NULL)))
+        goto cleanup;
+
+    if (lucas_uv_mod(result->z, NULL, NULL, p->z, q->z, k->z, n->z) < 0)
+        Py_CLEAR(result);
+
+  cleanup:
+    mpz_cloc(tmp);
+    Py_XDECREF((PyObject*)p);
+    Py_XDECREF((PyObject*)q);
+    Py_XDECREF((PyObject*)k);
+    Py_XDECREF((PyObject*)n);
+
+    return (PyObject*)result;
+}
+GMPY_FASTCALL_WRAPPER(GMPY_mpz_lucasu_mod)
+
+PyDoc_STRVAR(doc_mpz_lucasv,
+"lucasv(p,q,k) -> mpz\n\n"
+"Return the k-th element of the Lucas V sequence defined by p,q.\n"
+"p*p - 4*q must not equal 0; k must be greater than or equal to 0.");
+
+static PyObject *
+GMPY_mpz_lucasv(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    /* Adaptation of algorithm found in http://joye.site88.net/papers/JQ96lucas.pdf
+     * calculate v[k] of Lucas V sequence for p,q.
+     * Note: p^2-4q=0 is not tested, not a proper Lucas sequence!!
+     */
+
+    MPZ_Object *result = 0, *p, *q, *k;
+    size_t s = 0, j = 0;
+    mpz_t vl, vh, ql, qh, tmp;
+
+    if (nargs != 3) {
+        TYPE_ERROR("lucasv() requires 3 integer arguments");
+        return NULL;
+    }
+
+    /* Take advantage of the cache of mpz_t objects maintained by GMPY2 to
+     * avoid memory allocations. */
+
+    mpz_inoc(vl);
+    mpz_inoc(vh);
+    mpz_inoc(ql);
+    mpz_inoc(qh);
+    mpz_inoc(tmp);
+
+    p = GMPy_MPZ_From_Integer(args[0], NULL);
+    q = GMPy_MPZ_From_Integer(args[1], NULL);
+    k = GMPy_MPZ_From_Integer(args[2], NULL);
+    if (!p || !q || !k) {
+        TYPE_ERROR("lucasv() requires 3 integer arguments");
+        goto cleanup;
+    }
+
+    /* Check if p*p - 4*q == 0. */
+
+    mpz_mul(tmp, p->z, p->z);
+    mpz_mul_ui(qh, q->z, 4);
+    mpz_sub(tmp, tmp, qh);
+    if (mpz_sgn(tmp) == 0) {
+        VALUE_ERROR("invalid values for p,q in lucasv()");
+        goto cleanup;
+    }
+
+    /* Check if k < 0. */
+
+    if (mpz_sgn(k->z) < 0) {
+        VALUE_ERROR("invalid value for k in lucasv()");
+        goto cleanup;
+    }
+
+    mpz_set_si(vl, 2);
+    mpz_set(vh, p->z);
+    mpz_set_si(ql, 1);
+    mpz_set_si(qh, 1);
+    mpz_set_si(tmp,0);
+
+    s = mpz_scan1(k->z, 0);
+    for (j = mpz_sizeinbase(k->z,2)-1; j >= s+1; j--) {
+        /* ql = ql*qh */
+        mpz_mul(ql, ql, qh);
+        if (mpz_tstbit(k->z,j) == 1) {
+            /* qh = ql*q */
+            mpz_mul(qh, ql, q->z);
+
+            /* vl = vh*vl - p*ql */
+            mpz_mul(vl, vh, vl);
+            mpz_mul(tmp, ql, p->z);
+            mpz_sub(vl, vl, tmp);
+
+            /* vh = vh*vh - 2*qh */
+            mpz_mul(vh, vh, vh);
+            mpz_mul_si(tmp, qh, 2);
+            mpz_sub(vh, vh, tmp);
+        }
+        else {
+            /* qh = ql */
+            mpz_set(qh, ql);
+
+            /* vh = vh*vl - p*ql */
+            mpz_mul(vh, vh, vl);
+            mpz_mul(tmp, ql, p->z);
+            mpz_sub(vh, vh, tmp);
+
+            /* vl = vl*vl - 2*ql */
+            mpz_mul(vl, vl, vl);
+            mpz_mul_si(tmp, ql, 2);
+            mpz_sub(vl, vl, tmp);
+        }
+    }
+    /* ql = ql*qh */
+    mpz_mul(ql, ql, qh);
+
+    /* qh = ql*q */
+    mpz_mul(qh, ql, q->z);
+
+    /* vl = vh*vl - p*ql */
+    mpz_mul(vl, vh, vl);
+    mpz_mul(tmp, ql, p->z);
+    mpz_sub(vl, vl, tmp);
+
+    /* ql = ql*qh */
+    mpz_mul(ql, ql, qh);
+
+    for (j = 1; j <= s; j++) {
+        /* vl = vl*vl - 2*ql */
+        mpz_mul(vl, vl, vl);
+        mpz_mul_si(tmp, ql, 2);
+        mpz_sub(vl, vl, tmp);
+
+        /* ql = ql*ql */
+        mpz_mul(ql, ql, ql);
+    }
+
+    if (!(result = GMPy_MPZ_New(NULL)))
+        goto cleanup;
+
+    /* vl contains our return value */
+    mpz_set(result->z, vl);
+
+  cleanup:
+    mpz_cloc(vl);
+    mpz_cloc(vh);
+    mpz_cloc(ql);
+    mpz_cloc(qh);
+    mpz_cloc(tmp);
+    Py_XDECREF((PyObject*)p);
+    Py_XDECREF((PyObject*)q);
+    Py_XDECREF((PyObject*)k);
+
+    return (PyObject*)result;
+}
+GMPY_FASTCALL_WRAPPER(GMPY_mpz_lucasv)
+
+PyDoc_STRVAR(doc_mpz_lucasv_mod,
+"lucasv_mod(p,q,k,n) -> mpz\n\n"
+"Return the k-th element of the Lucas V sequence defined by p,q (mod n).\n"
+"p*p - 4*q must not equal 0; k must be greater than or equal to 0;\n"
+"n must be greater than 0.");
+
+static PyObject *
+GMPY_mpz_lucasv_mod(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    /* Calculate v[k] (modulo n) of Lucas V sequence for p,q. */
+
+    MPZ_Object *result = 0, *p, *q, *k, *n;
+    mpz_t tmp;
+
+    if (nargs != 4) {
+        TYPE_ERROR("lucasv_mod() requires 4 integer arguments");
+        return NULL;
+    }
+
+    /* Take advantage of the cache of mpz_t objects maintained by GMPY2 to
+     * avoid memory allocations. */
+
+    mpz_inoc(tmp);
+
+    p = GMPy_MPZ_From_Integer(args[0], NULL);
+    q = GMPy_MPZ_From_Integer(args[1], NULL);
+    k = GMPy_MPZ_From_Integer(args[2], NULL);
+    n = GMPy_MPZ_From_Integer(args[3], NULL);
+    if (!p || !q || !k || !n) {
+        TYPE_ERROR("lucasv_mod() requires 4 integer arguments");
+        goto cleanup;
+    }
+
+    /* Check if p*p - 4*q == 0. */
+
+    mpz_mul(tmp, p->z, p->z);
+    mpz_submul_ui(tmp, q->z, 4);
+    if (mpz_sgn(tmp) == 0) {
+        VALUE_ERROR("invalid values for p,q in lucasv_mod()");
+        goto cleanup;
+    }
+
+    /* Check if k < 0. */
+
+    if (mpz_sgn(k->z) < 0) {
+        VALUE_ERROR("invalid value for k in lucasv_mod()");
+        goto cleanup;
+    }
+
+    /* Check if n > 0. */
+
+    if (mpz_sgn(n->z) <= 0) {
+        VALUE_ERROR("invalid value for n in lucasv_mod()");
+        goto cleanup;
+    }
+
+    if (!(result = GMPy_MPZ_New(NULL)))
+        goto cleanup;
+
+    if (lucas_uv_mod(NULL, result->z, NULL, p->z, q->z, k->z, n->z) < 0)
+        Py_CLEAR(result);
+
+  cleanup:
+    mpz_cloc(tmp);
+    Py_XDECREF((PyObject*)p);
+    Py_XDECREF((PyObject*)q);
+    Py_XDECREF((PyObject*)k);
+    Py_XDECREF((PyObject*)n);
+
+    return (PyObject*)result;
+}
+GMPY_FASTCALL_WRAPPER(GMPY_mpz_lucasv_mod)
+
+/* Lucas sequence kernel shared by lucasu_mod(), lucasv_mod(), lucas_uv_mod()
+ * and the Lucas probable prime tests. It uses the ladder of Joye and
+ * Quisquater (see lucasu() above) and returns U_k, V_k and Q**k together.
+ * For an odd n the whole ladder runs in Montgomery form (gmpy2_mont.c);
+ * the limbs come from a single cached mpz_t, so repeated calls do not
+ * allocate. Other n use mpz_mul and mpz_mod. The ladder has a cancellation
+ * point per bit of k; the kernels return -1, with an exception set, if it
+ * stopped them, and 0 otherwise.
+ */
+
+static int
+lucas_uv_mont(mpz_ptr u, mpz_ptr v, mpz_ptr qk, mpz_srcptr p, mpz_srcptr q,
+              mpz_srcptr k, mpz_srcptr n, mp_bitcnt_t s)
+{
+    mp_size_t nl = mpz_size(n);
+    mp_ptr uh, vl, vh, ql, qh, pm, qm, t;
+    mp_bitcnt_t j, top = mpz_sizeinbase(k, 2) - 1;
+    int status = 0;
+    mpz_t scratch, temp;
+    gmpy_mont M;
+
+    mpz_inoc(scratch);
+    mpz_inoc(temp);
+    mpz_realloc2(scratch, 10 * nl * GMP_NUMB_BITS);
+    uh = scratch->_mp_d;
+    vl = uh + nl;
+    vh = vl + nl;
+    ql = vh + nl;
+    qh = ql + nl;
+    pm = qh + nl;
+    qm = pm + nl;
+    t = qm + nl;
+    mont_init(&M, n, t + nl);
+
+    mont_from_mpz(&M, pm, p, temp);
+    mont_from_mpz(&M, qm, q, temp);
+    mpz_set_ui(temp, 1);
+    mont_from_mpz(&M, ql, temp, temp);
+    mont_copy(&M, qh, ql);
+    mont_copy(&M, uh, ql);
+    mont_add(&M, vl, ql, ql);
+    mont_copy(&M, vh, pm);
+
+    for (j = top; j > s; j--) {
+        if (GMPY_CANCEL_POINT(nl * GMP_NUMB_BITS, top - j, top)) {
+            status = -1;
+            goto cleanup;
+        }
+        mont_mul(&M, ql, ql, qh);
+        if (mpz_tstbit(k, j)) {
+            /* qh = ql*q, uh = uh*vh, vl = vh*vl - p*ql, vh = vh*vh - 2*qh */
+            mont_mul(&M, qh, ql, qm);
+            if (u)
+                mont_mul(&M, uh, uh, vh);
+            mont_mul(&M, vl, vh, vl);
+            mont_mul(&M, t, pm, ql);
+            mont_sub(&M, vl, vl, t);
+            mont_mul(&M, vh, vh, vh);
+            mont_add(&M, t, qh, qh);
+            mont_sub(&M, vh, vh, t);
+        }
+        else {
+            /* qh = ql, uh = uh*vl - ql, vh = vh*vl - p*ql, vl = vl*vl - 2*ql */
+            mont_copy(&M, qh, ql);
+            if (u) {
+                mont_mul(&M, uh, uh, vl);
+                mont_sub(&M, uh, uh, ql);
+            }
+            mont_mul(&M, vh, vh, vl);
+            mont_mul(&M, t, pm, ql);
+            mont_sub(&M, vh, vh, t);
+            mont_mul(&M, vl, vl, vl);
+            mont_add(&M, t, ql, ql);
+            mont_sub(&M, vl, vl, t);
+        }
+    }
+
+    mont_mul(&M, ql, ql, qh);
+    mont_mul(&M, qh, ql, qm);
+    if (u) {
+        mont_mul(&M, uh, uh, vl);
+        mont_sub(&M, uh, uh, ql);
+    }
+    mont_mul(&M, vl, vh, vl);
+    mont_mul(&M, t, pm, ql);
+    mont_sub(&M, vl, vl, t);
+    mont_mul(&M, ql, ql, qh);
+
+    for (j = 0; j < s; j++) {
+        if (GMPY_CANCEL_POINT(nl * GMP_NUMB_BITS, top - s + j, top)) {
+            status = -1;
+            goto cleanup;
+        }
+        if (u)
+            mont_mul(&M, uh, uh, vl);
+        mont_mul(&M, vl, vl, vl);
+        mont_add(&M, t, ql, ql);
+        mont_sub(&M, vl, vl, t);
+        mont_mul(&M, ql, ql, ql);
+    }
+
+    if (u)
+        mont_to_mpz(&M, u, uh);
+    if (v)
+        mont_to_mpz(&M, v, vl);
+    if (qk)
+        mont_to_mpz(&M, qk, ql);
+  cleanup:
+    mpz_cloc(scratch);
+    mpz_cloc(temp);
+    return status;
+}
+
+static int
+lucas_uv_generic(mpz_ptr u, mpz_ptr v, mpz_ptr qk, mpz_srcptr p, mpz_srcptr q,
+                 mpz_srcptr k, mpz_srcptr n, mp_bitcnt_t s)
+{
+    mpz_t uh, vl, vh, ql, qh;
+    mp_bitcnt_t j, top = mpz_sizeinbase(k, 2) - 1;
+    size_t bits = mpz_sizeinbase(n, 2);
+    int status = 0;
+
+    mpz_inoc(uh);
+    mpz_inoc(vl);
+    mpz_inoc(vh);
+    mpz_inoc(ql);
+    mpz_inoc(qh);
+
+    mpz_set_si(uh, 1);
+    mpz_set_si(vl, 2);
+    mpz_set(vh, p);
+    mpz_set_si(ql, 1);
+    mpz_set_si(qh, 1);
+
+    for (j = top; j > s; j--) {
+        if (GMPY_CANCEL_POINT(bits, top - j, top)) {
+            status = -1;
+            goto cleanup;
+        }
+        mpz_mul(ql, ql, qh);
+        mpz_mod(ql, ql, n);
+        if (mpz_tstbit(k, j)) {
+            mpz_mul(qh, ql, q);
+            if (u) {
+                mpz_mul(uh, uh, vh);
+                mpz_mod(uh, uh, n);
+            }
+            mpz_mul(vl, vh, vl);
+            mpz_submul(vl, ql, p);
+            mpz_mod(vl, vl, n);
+            mpz_mul(vh, vh, vh);
+            mpz_submul_ui(vh, qh, 2);
+            mpz_mod(vh, vh, n);
+        }
+        else {
+            mpz_set(qh, ql);
+            if (u) {
+                mpz_mul(uh, uh, vl);
+                mpz_sub(uh, uh, ql);
+                mpz_mod(uh, uh, n);
+            }
+            mpz_mul(vh, vh, vl);
+            mpz_submul(vh, ql, p);
+            mpz_mod(vh, vh, n);
+            mpz_mul(vl, vl, vl);
+            mpz_submul_ui(vl, ql, 2);
+            mpz_mod(vl, vl, n);
+        }
+    }
+
+    mpz_mul(ql, ql, qh);
+    mpz_mul(qh, ql, q);
+    if (u) {
+        mpz_mul(uh, uh, vl);
+        mpz_sub(uh, uh, ql);
+    }
+    mpz_mul(vl, vh, vl);
+    mpz_submul(vl, ql, p);
+    mpz_mul(ql, ql, qh);
+
+    for (j = 0; j < s; j++) {
+        if (GMPY_CANCEL_POINT(bits, top - s + j, top)) {
+            status = -1;
+            goto cleanup;
+        }
+        if (u) {
+            mpz_mul(uh, uh, vl);
+            mpz_mod(uh, uh, n);
+        }
+        mpz_mul(vl, vl, vl);
+        mpz_submul_ui(vl, ql, 2);
+        mpz_mod(vl, vl, n);
+        mpz_mul(ql, ql, ql);
+        mpz_mod(ql, ql, n);
+    }
+
+    if (u)
+        mpz_mod(u, uh, n);
+    if (v)
+        mpz_mod(v, vl, n);
+    if (qk)
+        mpz_mod(qk, ql, n);
+  cleanup:
+    mpz_cloc(uh);
+    mpz_cloc(vl);
+    mpz_cloc(vh);
+    mpz_cloc(ql);
+    mpz_cloc(qh);
+    return status;
+}
+
+/* Set u = U_k, v = V_k and qk = Q**k for the Lucas sequences defined by
+ * p, q, all reduced into [0, n). Any of u, v and qk may be NULL. Requires
+ * k >= 0 and n > 0. Returns -1 if a cancellation point stopped it. */
+
+static int
+lucas_uv_mod(mpz_ptr u, mpz_ptr v, mpz_ptr qk, mpz_srcptr p, mpz_srcptr q,
+             mpz_srcptr k, mpz_srcptr n)
+{
+    if (mpz_sgn(k) == 0) {
+        if (u)
+            mpz_set_ui(u, 0);
+        if (v) {
+            mpz_set_ui(v, 2);
+            mpz_mod(v, v, n);
+        }
+        if (qk) {
+            mpz_set_ui(qk, 1);
+            mpz_mod(qk, qk, n);
+        }
+    }
+    else if (mpz_odd_p(n) && mpz_size(n) <= MONT_MAX_LIMBS) {
+        return lucas_uv_mont(u, v, qk, p, q, k, n, mpz_scan1(k, 0));
+    }
+    else {
+        return lucas_uv_generic(u, v, qk, p, q, k, n, mpz_scan1(k, 0));
+    }
+    return 0;
+}
+
+PyDoc_STRVAR(doc_mpz_lucas_uv_mod,
+"lucas_uv_mod(p,q,k,n) -> (mpz, mpz)\n\n"
+"Return the k-th elements of the Lucas U and V sequences defined by p,q\n"
+"(mod n) as a tuple. This is faster than calling lucasu_mod() and\n"
+"lucasv_mod(). p*p - 4*q must not equal 0; k must be greater than or\n"
+"equal to 0; n must be greater than 0.");
+
+static PyObject *
+GMPY_mpz_lucas_uv_mod(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    MPZ_Object *u = 0, *v = 0, *p, *q, *k, *n;
+    PyObject *result = 0;
+    mpz_t tmp;
+
+    if (nargs != 4) {
+        TYPE_ERROR("lucas_uv_mod() requires 4 integer arguments");
+        return NULL;
+    }
+
+    p = GMPy_MPZ_From_Integer(args[0], NULL);
+    q = GMPy_MPZ_From_Integer(args[1], NULL);
+    k = GMPy_MPZ_From_Integer(args[2], NULL);
+    n = GMPy_MPZ_From_Integer(args[3], NULL);
+    if (!p || !q || !k || !n) {
+        TYPE_ERROR("lucas_uv_mod() requires 4 integer arguments");
+        goto cleanup;
+    }
+
+    /* Check if p*p - 4*q == 0. */
+
+    mpz_inoc(tmp);
+    mpz_mul(tmp, p->z, p->z);
+    mpz_submul_ui(tmp, q->z, 4);
+    if (mpz_sgn(tmp) == 0) {
+        mpz_cloc(tmp);
+        VALUE_ERROR("invalid values for p,q in lucas_uv_mod()");
+        goto cleanup;
+    }
+    mpz_cloc(tmp);
+
+    if (mpz_sgn(k->z) < 0) {
+        VALUE_ERROR("invalid value for k in lucas_uv_mod()");
+        goto cleanup;
+    }
+
+    if (mpz_sgn(n->z) <= 0) {
+        VALUE_ERROR("invalid value for n in lucas_uv_mod()");
+        goto cleanup;
+    }
+
+    if (!(u = GMPy_MPZ_New(NULL)) || !(v = GMPy_MPZ_New(NULL)))
+        goto cleanup;
+
+    if (lucas_uv_mod(u->z, v->z, NULL, p->z, q->z, k->z, n->z) == 0)
+        result = PyTuple_Pack(2, (PyObject*)u, (PyObject*)v);
+
+  cleanup:
+    Py_XDECREF((PyObject*)u);
+    Py_XDECREF((PyObject*)v);
+    Py_XDECREF((PyObject*)p);
+    Py_XDECREF((PyObject*)q);
+    Py_XDECREF((PyObject*)k);
+    Py_XDECREF((PyObject*)n);
+    return result;
+}
+GMPY_FASTCALL_WRAPPER(GMPY_mpz_lucas_uv_mod)
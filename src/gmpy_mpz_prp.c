@@ -29,6 +29,284 @@
  * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
  * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
+/* ******************************************************************
+ * Single-limb primality:
+ * Odd n that fit in one limb are tested with Montgomery arithmetic on
+ * limbs instead of mpz_t. A product of two limbs comes from __int128 when
+ * the compiler has it, or else from mpn_mul_1(). Miller-Rabin with the
+ * bases {2, 7, 61} is deterministic for n < 2**32, and with Jim
+ * Sinclair's seven bases it is deterministic for n < 2**64. No BPSW
+ * pseudoprimes below 2**64 exist, so the same answer is exact for the
+ * BPSW tests too.
+ * ******************************************************************/
+
+#if GMP_NUMB_BITS == 64 && defined(__SIZEOF_INT128__)
+#define PRP_UMUL(hi, lo, a, b) \
+    do { \
+        unsigned __int128 _p = (unsigned __int128)(a) * (b); \
+        (hi) = (mp_limb_t)(_p >> 64); \
+        (lo) = (mp_limb_t)_p; \
+    } while (0)
+#else
+#define PRP_UMUL(hi, lo, a, b) \
+    do { \
+        mp_limb_t _a = (a); \
+        (hi) = mpn_mul_1(&(lo), &_a, 1, (b)); \
+    } while (0)
+#endif
+
+typedef struct {
+    mp_limb_t n;
+    mp_limb_t ninv;         /* 1/n mod B */
+    mp_limb_t one;          /* B mod n, the Montgomery form of 1 */
+    mp_limb_t r2;           /* B**2 mod n */
+} prp_word;
+
+static void
+prp_word_init(prp_word *w, mp_limb_t n)
+{
+    mp_limb_t t[3] = {0, 0, 1};
+    int i;
+
+    /* n * n == 1 mod 8, and each Newton step doubles the correct bits. */
+    w->n = n;
+    w->ninv = n;
+    for (i = 0; i < 6; i++)
+        w->ninv *= 2 - n * w->ninv;
+    w->one = mpn_mod_1(t + 1, 2, n);
+    w->r2 = mpn_mod_1(t, 3, n);
+}
+
+/* Return a * b / B mod n for a, b < n. */
+
+static mp_limb_t
+prp_word_mul(const prp_word *w, mp_limb_t a, mp_limb_t b)
+{
+    mp_limb_t hi, lo, mh, ml, r;
+
+    PRP_UMUL(hi, lo, a, b);
+    PRP_UMUL(mh, ml, lo * w->ninv, w->n);
+    (void)ml;
+    r = hi - mh;
+    if (hi < mh)
+        r += w->n;
+    return r;
+}
+
+/* Return 1 if the odd n > 2 is a strong probable prime to the base a,
+ * where 0 < a < n. */
+
+static int
+prp_word_sprp(const prp_word *w, mp_limb_t a)
+{
+    mp_limb_t d = w->n - 1, x, base, mone = w->n - w->one;
+    int r = 0, bit;
+
+    while (!(d & 1)) {
+        d >>= 1;
+        r++;
+    }
+
+    base = prp_word_mul(w, a, w->r2);
+    x = base;
+    for (bit = GMP_NUMB_BITS - 1; !((d >> bit) & 1); bit--)
+        ;
+    while (bit-- > 0) {
+        x = prp_word_mul(w, x, x);
+        if ((d >> bit) & 1)
+            x = prp_word_mul(w, x, base);
+    }
+
+    if (x == w->one || x == mone)
+        return 1;
+    while (--r > 0) {
+        x = prp_word_mul(w, x, x);
+        if (x == mone)
+            return 1;
+        if (x == w->one)
+            return 0;
+    }
+    return 0;
+}
+
+/* Return 1 if n is prime, without any probability of error. */
+
+static int
+prp_word_is_prime(mp_limb_t n)
+{
+    static const unsigned int small[] = { 3, 5, 7, 11, 13, 17, 19, 23, 29,
+                                          31, 37, 41, 43, 47, 53, 59, 61 };
+    static const mp_limb_t bases32[] = { 2, 7, 61 };
+#if GMP_NUMB_BITS >= 64
+    static const mp_limb_t bases64[] = { 2, 325, 9375, 28178, 450775,
+                                         9780504, 1795265022 };
+#endif
+    const mp_limb_t *bases = bases32;
+    size_t i, nbases = 3;
+    prp_word w;
+    mp_limb_t a;
+
+    if (n < 2)
+        return 0;
+    if (!(n & 1))
+        return n == 2;
+    for (i = 0; i < sizeof(small) / sizeof(small[0]); i++) {
+        if (n % small[i] == 0)
+            return n == small[i];
+    }
+    if (n < 61 * 61)
+        return 1;
+
+#if GMP_NUMB_BITS >= 64
+    if (n >> 32) {
+        bases = bases64;
+        nbases = 7;
+    }
+#endif
+    prp_word_init(&w, n);
+    for (i = 0; i < nbases; i++) {
+        if (!(a = bases[i] % n))
+            continue;
+        if (!prp_word_sprp(&w, a))
+            return 0;
+    }
+    return 1;
+}
+
+/* ******************************************************************
+ * Trial division:
+ * The odd primes below PRP_TRIAL_MAX are grouped so that the product of
+ * each group fits in a limb. One mpn_mod_1() per group then finds the
+ * remainders for all primes in the group. The table is built on first
+ * use: functions that use it call PRP_TRIAL_INIT() while they hold the
+ * GIL. It is only read afterwards, so it can be used without the GIL.
+ * ******************************************************************/
+
+#define PRP_TRIAL_MAX 65536
+#define PRP_TRIAL_PRIMES 6541       /* odd primes below PRP_TRIAL_MAX */
+
+static struct {
+    unsigned int primes[PRP_TRIAL_PRIMES];
+    mp_limb_t products[PRP_TRIAL_PRIMES];
+    unsigned int ends[PRP_TRIAL_PRIMES];   /* end of each group in primes */
+    unsigned int ngroups;
+} prp_trial;
+
+#define PRP_TRIAL_INIT() do { if (!prp_trial.ngroups) prp_trial_init(); } while (0)
+
+static void
+prp_trial_init(void)
+{
+    static char composite[PRP_TRIAL_MAX];
+    unsigned int i, j, nprimes = 0;
+    mp_limb_t product = 1;
+
+    for (i = 3; i < PRP_TRIAL_MAX; i += 2) {
+        if (composite[i])
+            continue;
+        for (j = i * i; j < PRP_TRIAL_MAX; j += 2 * i)
+            composite[j] = 1;
+        if (product > GMP_NUMB_MAX / i) {
+            prp_trial.products[prp_trial.ngroups] = product;
+            prp_trial.ends[prp_trial.ngroups++] = nprimes;
+            product = 1;
+        }
+        product *= i;
+        prp_trial.primes[nprimes++] = i;
+    }
+    prp_trial.products[prp_trial.ngroups] = product;
+    prp_trial.ends[prp_trial.ngroups++] = nprimes;
+}
+
+/* Return 1 if abs(n) is even or has an odd prime factor p < limit, and is
+ * not itself that prime. Returns 0 if no such factor was found. */
+
+static int
+prp_trial_divide(mpz_t n, unsigned long limit)
+{
+    mp_size_t size = mpz_size(n);
+    mp_limb_t rem;
+    unsigned int g, i = 0, p;
+
+    if (size == 0)
+        return 0;
+    if (!(mpz_getlimbn(n, 0) & 1))
+        return mpz_cmpabs_ui(n, 2) != 0;
+
+    for (g = 0; g < prp_trial.ngroups && prp_trial.primes[i] < limit; g++) {
+        rem = mpn_mod_1(n->_mp_d, size, prp_trial.products[g]);
+        for (; i < prp_trial.ends[g]; i++) {
+            p = prp_trial.primes[i];
+            if (p >= limit)
+                return 0;
+            if (rem % p == 0)
+                return mpz_cmpabs_ui(n, p) != 0;
+        }
+    }
+    return 0;
+}
+
+/* Return 1 if the positive n is a BPSW probable prime, 0 if not and -1 on
+ * error. Single limb numbers are tested exactly. */
+
+static int
+prp_is_prime(mpz_srcptr n)
+{
+    MPZ_Object *temp;
+    PyObject *result;
+    int r;
+
+    if (mpz_size(n) == 1)
+        return prp_word_is_prime(mpz_getlimbn(n, 0));
+
+    if (!(temp = GMPy_MPZ_New(NULL)))
+        return -1;
+    mpz_set(temp->z, n);
+    result = GMPY_mpz_is_bpsw_prp(NULL, (PyObject**)&temp, 1);
+    Py_DECREF((PyObject*)temp);
+    if (!result)
+        return -1;
+    r = (result == Py_True);
+    Py_DECREF(result);
+    return r;
+}
+
+PyDoc_STRVAR(GMPy_doc_get_bpsw_trial_limit,
+"get_bpsw_trial_limit() -> int\n\n"
+"Return the bound for the trial division done by is_bpsw_prp() and\n"
+"is_strong_bpsw_prp(). See set_bpsw_trial_limit().");
+
+static PyObject *
+GMPy_get_bpsw_trial_limit(PyObject *self, PyObject *args)
+{
+    return PyIntOrLong_FromSize_t((size_t)global.bpsw_trial_limit);
+}
+
+PyDoc_STRVAR(GMPy_doc_set_bpsw_trial_limit,
+"set_bpsw_trial_limit(limit)\n\n"
+"Before the probable prime tests, is_bpsw_prp() and is_strong_bpsw_prp()\n"
+"reject numbers with a prime factor below limit. limit must be between\n"
+"0 and 65536; 0 disables the trial division.");
+
+static PyObject *
+GMPy_set_bpsw_trial_limit(PyObject *self, PyObject *other)
+{
+    Py_ssize_t limit;
+
+    limit = PyIntOrLong_AsSsize_t(other);
+    if (limit == -1 && PyErr_Occurred()) {
+        TYPE_ERROR("set_bpsw_trial_limit() requires an integer argument");
+        return NULL;
+    }
+    if (limit < 0 || limit > PRP_TRIAL_MAX) {
+        VALUE_ERROR("limit must be between 0 and 65536");
+        return NULL;
+    }
+
+    global.bpsw_trial_limit = (unsigned long)limit;
+    Py_RETURN_NONE;
+}
+
 /* ******************************************************************
  * mpz_prp: (also called a Fermat probable prime)
  * A "probable prime" to the base a is a number n such that,
@@ -44,19 +322,20 @@ PyDoc_STRVAR(doc_mpz_is_fermat_prp,
 "    a**(n-1) == 1 (mod n)");
 
 static PyObject *
-GMPY_mpz_is_fermat_prp(PyObject *self, PyObject *args)
+GMPY_mpz_is_fermat_prp(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     MPZ_Object *a, *n;
     PyObject *result = 0;
     mpz_t res, nm1;
 
-    if (PyTuple_Size(args) != 2) {
+    if (nargs != 2) {
         TYPE_ERROR("is_fermat_prp() requires 2 integer arguments");
         return NULL;
     }
+    GMPY_PROBE_ENTRY("is_fermat_prp", gmpy_profile_bits_args(args, nargs));
 
-    n = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
-    a = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL);
+    n = GMPy_MPZ_From_Integer(args[0], NULL);
+    a = GMPy_MPZ_From_Integer(args[1], NULL);
     if (!a || !n) {
         TYPE_ERROR("is_fermat_prp() requires 2 integer arguments");
         goto cleanup;
@@ -118,8 +397,10 @@ GMPY_mpz_is_fermat_prp(PyObject *self, PyObject *args)
     mpz_cloc(nm1);
     Py_XDECREF((PyObject*)a);
     Py_XDECREF((PyObject*)n);
+    GMPY_PROBE_RETURN("is_fermat_prp", gmpy_profile_bits_args(args, nargs));
     return result;
 }
+GMPY_FASTCALL_WRAPPER(GMPY_mpz_is_fermat_prp)
 
 /* *************************************************************************
  * mpz_euler_prp: (also called a Solovay-Strassen probable prime)
@@ -138,20 +419,21 @@ PyDoc_STRVAR(doc_mpz_is_euler_prp,
 "    a**((n-1)/2) == 1 (mod n)");
 
 static PyObject *
-GMPY_mpz_is_euler_prp(PyObject *self, PyObject *args)
+GMPY_mpz_is_euler_prp(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     MPZ_Object *a, *n;
     PyObject *result = 0;
     mpz_t res, exp;
     int ret;
 
-    if (PyTuple_Size(args) != 2) {
+    if (nargs != 2) {
         TYPE_ERROR("is_euler_prp() requires 2 integer arguments");
         return NULL;
     }
+    GMPY_PROBE_ENTRY("is_euler_prp", gmpy_profile_bits_args(args, nargs));
 
-    n = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
-    a = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL);
+    n = GMPy_MPZ_From_Integer(args[0], NULL);
+    a = GMPy_MPZ_From_Integer(args[1], NULL);
     if (!a || !n) {
         TYPE_ERROR("is_euler_prp() requires 2 integer arguments");
         goto cleanup;
@@ -222,8 +504,10 @@ GMPY_mpz_is_euler_prp(PyObject *self, PyObject *args)
     mpz_cloc(exp);
     Py_XDECREF((PyObject*)a);
     Py_XDECREF((PyObject*)n);
+    GMPY_PROBE_RETURN("is_euler_prp", gmpy_profile_bits_args(args, nargs));
     return result;
 }
+GMPY_FASTCALL_WRAPPER(GMPY_mpz_is_euler_prp)
 
 /* *********************************************************************************************
  * mpz_sprp: (also called a Miller-Rabin probable prime)
@@ -245,20 +529,22 @@ PyDoc_STRVAR(doc_mpz_is_strong_prp,
 "    a**(s*(2**t)) == -1 (mod n) for some t, 0 <= t < r.");
 
 static PyObject *
-GMPY_mpz_is_strong_prp(PyObject *self, PyObject *args)
+GMPY_mpz_is_strong_prp(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     MPZ_Object *a, *n;
     PyObject *result = 0;
     mpz_t s, nm1, mpz_test;
     mp_bitcnt_t r = 0;
+    int found, cancelled = 0;
 
-    if (PyTuple_Size(args) != 2) {
+    if (nargs != 2) {
         TYPE_ERROR("is_strong_prp() requires 2 integer arguments");
         return NULL;
     }
+    GMPY_PROBE_ENTRY("is_strong_prp", gmpy_profile_bits_args(args, nargs));
 
-    n = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
-    a = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL);
+    n = GMPy_MPZ_From_Integer(args[0], NULL);
+    a = GMPy_MPZ_From_Integer(args[1], NULL);
     if (!a || !n) {
         TYPE_ERROR("is_strong_prp() requires 2 integer arguments");
         goto cleanup;
@@ -298,6 +584,20 @@ GMPY_mpz_is_strong_prp(PyObject *self, PyObject *args)
         goto cleanup;
     }
 
+    /* A single-limb n uses native arithmetic; a >= 2 so a->z has limbs. */
+    if (mpz_size(n->z) == 1) {
+        prp_word w;
+        mp_limb_t aw = mpn_mod_1(a->z->_mp_d, mpz_size(a->z), mpz_getlimbn(n->z, 0));
+
+        if (aw == 0 || mpn_gcd_1(&aw, 1, mpz_getlimbn(n->z, 0)) != 1) {
+            VALUE_ERROR("is_strong_prp() requires gcd(n,a) == 1");
+            goto cleanup;
+        }
+        prp_word_init(&w, mpz_getlimbn(n->z, 0));
+        result = prp_word_sprp(&w, aw) ? Py_True : Py_False;
+        goto cleanup;
+    }
+
     /* Check gcd(a,b) */
     mpz_gcd(s, n->z, a->z);
     if (mpz_cmp_ui(s, 1) > 0) {
@@ -314,24 +614,26 @@ GMPY_mpz_is_strong_prp(PyObject *self, PyObject *args)
 
 
     /* Check a^((2^t)*s) mod n for 0 <= t < r */
+    GMPY_BEGIN_NOGIL(mpz_sizeinbase(n->z, 2));
     mpz_powm(mpz_test, a->z, s, n->z);
-    if ((mpz_cmp_ui(mpz_test, 1) == 0) || (mpz_cmp(mpz_test, nm1) == 0)) {
-        result = Py_True;
-        goto cleanup;
-    }
+    found = (mpz_cmp_ui(mpz_test, 1) == 0) || (mpz_cmp(mpz_test, nm1) == 0);
 
-    while (--r) {
+    while (!found && --r) {
+        if (GMPY_CANCEL_POINT(mpz_sizeinbase(n->z, 2),
+                              mpz_scan1(nm1, 0) - r, mpz_scan1(nm1, 0))) {
+            cancelled = 1;
+            break;
+        }
         /* mpz_test = mpz_test^2%n */
         mpz_mul(mpz_test, mpz_test, mpz_test);
         mpz_mod(mpz_test, mpz_test, n->z);
-
-        if (mpz_cmp(mpz_test, nm1) == 0) {
-            result = Py_True;
-            goto cleanup;
-        }
+        found = (mpz_cmp(mpz_test, nm1) == 0);
     }
+    GMPY_END_NOGIL;
 
-    result = Py_False;
+    if (cancelled)
+        goto cleanup;
+    result = found ? Py_True : Py_False;
   cleanup:
     Py_XINCREF(result);
     mpz_cloc(s);
@@ -339,8 +641,10 @@ GMPY_mpz_is_strong_prp(PyObject *self, PyObject *args)
     mpz_cloc(mpz_test);
     Py_XDECREF((PyObject*)a);
     Py_XDECREF((PyObject*)n);
+    GMPY_PROBE_RETURN("is_strong_prp", gmpy_profile_bits_args(args, nargs));
     return result;
 }
+GMPY_FASTCALL_WRAPPER(GMPY_mpz_is_strong_prp)
 
 /* *************************************************************************
  * mpz_fibonacci_prp:
@@ -360,19 +664,19 @@ PyDoc_STRVAR(doc_mpz_is_fibonacci_prp,
 "    lucasv(p,q,n) == p (mod n).");
 
 static PyObject *
-GMPY_mpz_is_fibonacci_prp(PyObject *self, PyObject *args)
+GMPY_mpz_is_fibonacci_prp(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     MPZ_Object *n, *p, *q;
     PyObject *result = 0;
     mpz_t pmodn, zP;
     /* used for calculating the Lucas V sequence */
-    mpz_t vl, vh, ql, qh, tmp;
-    mp_bitcnt_t s = 0, j = 0;
+    mpz_t vl, qh, tmp;
 
-    if (PyTuple_Size(args) != 3) {
+    if (nargs != 3) {
         TYPE_ERROR("is_fibonacci_prp() requires 3 integer arguments");
         return NULL;
     }
+    GMPY_PROBE_ENTRY("is_fibonacci_prp", gmpy_profile_bits_args(args, nargs));
 
     /* Take advantage of the cache of mpz_t objects maintained by GMPY2 to
      * avoid memory allocations. */
@@ -380,14 +684,12 @@ GMPY_mpz_is_fibonacci_prp(PyObject *self, PyObject *args)
     mpz_inoc(pmodn);
     mpz_inoc(zP);
     mpz_inoc(vl);
-    mpz_inoc(vh);
-    mpz_inoc(ql);
     mpz_inoc(qh);
     mpz_inoc(tmp);
 
-    n = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
-    p = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL);
-    q = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 2), NULL);
+    n = GMPy_MPZ_From_Integer(args[0], NULL);
+    p = GMPy_MPZ_From_Integer(args[1], NULL);
+    q = GMPy_MPZ_From_Integer(args[2], NULL);
     if (!n || !p || !q) {
         TYPE_ERROR("is_fibonacci_prp() requires 3 integer arguments");
         goto cleanup;
@@ -434,79 +736,8 @@ GMPY_mpz_is_fibonacci_prp(PyObject *self, PyObject *args)
     mpz_set(zP, p->z);
     mpz_mod(pmodn, zP, n->z);
 
-    /* mpz_lucasvmod(res, p, q, n, n); */
-    mpz_set_si(vl, 2);
-    mpz_set(vh, p->z);
-    mpz_set_si(ql, 1);
-    mpz_set_si(qh, 1);
-    mpz_set_si(tmp,0);
-
-    s = mpz_scan1(n->z, 0);
-    for (j = mpz_sizeinbase(n->z,2)-1; j >= s+1; j--) {
-        /* ql = ql*qh (mod n) */
-        mpz_mul(ql, ql, qh);
-        mpz_mod(ql, ql, n->z);
-        if (mpz_tstbit(n->z,j) == 1) {
-            /* qh = ql*q */
-            mpz_mul(qh, ql, q->z);
-
-            /* vl = vh*vl - p*ql (mod n) */
-            mpz_mul(vl, vh, vl);
-            mpz_mul(tmp, ql, p->z);
-            mpz_sub(vl, vl, tmp);
-            mpz_mod(vl, vl, n->z);
-
-            /* vh = vh*vh - 2*qh (mod n) */
-            mpz_mul(vh, vh, vh);
-            mpz_mul_si(tmp, qh, 2);
-            mpz_sub(vh, vh, tmp);
-            mpz_mod(vh, vh, n->z);
-        }
-        else {
-            /* qh = ql */
-            mpz_set(qh, ql);
-
-            /* vh = vh*vl - p*ql (mod n) */
-            mpz_mul(vh, vh, vl);
-            mpz_mul(tmp, ql, p->z);
-            mpz_sub(vh, vh, tmp);
-            mpz_mod(vh, vh, n->z);
-
-            /* vl = vl*vl - 2*ql (mod n) */
-            mpz_mul(vl, vl, vl);
-            mpz_mul_si(tmp, ql, 2);
-            mpz_sub(vl, vl, tmp);
-            mpz_mod(vl, vl, n->z);
-        }
-    }
-    /* ql = ql*qh */
-    mpz_mul(ql, ql, qh);
-
-    /* qh = ql*q */
-    mpz_mul(qh, ql, q->z);
-
-    /* vl = vh*vl - p*ql */
-    mpz_mul(vl, vh, vl);
-    mpz_mul(tmp, ql, p->z);
-    mpz_sub(vl, vl, tmp);
-
-    /* ql = ql*qh */
-    mpz_mul(ql, ql, qh);
-
-    for (j = 1; j <= s; j++) {
-        /* vl = vl*vl - 2*ql (mod n) */
-        mpz_mul(vl, vl, vl);
-        mpz_mul_si(tmp, ql, 2);
-        mpz_sub(vl, vl, tmp);
-        mpz_mod(vl, vl, n->z);
-
-        /* ql = ql*ql (mod n) */
-        mpz_mul(ql, ql, ql);
-        mpz_mod(ql, ql, n->z);
-    }
-
-    /* vl contains our return value */
-    mpz_mod(vl, vl, n->z);
+    if (lucas_uv_mod(NULL, vl, NULL, p->z, q->z, n->z, n->z) < 0)
+        goto cleanup;
 
     if (mpz_cmp(vl, pmodn) == 0)
         result = Py_True;
@@ -518,15 +749,15 @@ GMPY_mpz_is_fibonacci_prp(PyObject *self, PyObject *args)
     mpz_cloc(pmodn);
     mpz_cloc(zP);
     mpz_cloc(vl);
-    mpz_cloc(vh);
-    mpz_cloc(ql);
     mpz_cloc(qh);
     mpz_cloc(tmp);
     Py_XDECREF((PyObject*)p);
     Py_XDECREF((PyObject*)q);
     Py_XDECREF((PyObject*)n);
+    GMPY_PROBE_RETURN("is_fibonacci_prp", gmpy_profile_bits_args(args, nargs));
     return result;
 }
+GMPY_FASTCALL_WRAPPER(GMPY_mpz_is_fibonacci_prp)
 
 
 /* *******************************************************************************
@@ -546,20 +777,19 @@ PyDoc_STRVAR(doc_mpz_is_lucas_prp,
 "    lucasu(p,q,n - Jacobi(D,n)) == 0 (mod n)");
 
 static PyObject *
-GMPY_mpz_is_lucas_prp(PyObject *self, PyObject *args)
+GMPY_mpz_is_lucas_prp(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     MPZ_Object *n, *p, *q;
     PyObject *result = 0;
     mpz_t zD, res, index;
-    /* used for calculating the Lucas U sequence */
-    mpz_t uh, vl, vh, ql, qh, tmp;
-    mp_bitcnt_t s = 0, j = 0;
+    mpz_t tmp;
     int ret;
 
-    if (PyTuple_Size(args) != 3) {
+    if (nargs != 3) {
         TYPE_ERROR("is_lucas_prp() requires 3 integer arguments");
         return NULL;
     }
+    GMPY_PROBE_ENTRY("is_lucas_prp", gmpy_profile_bits_args(args, nargs));
 
     /* Take advantage of the cache of mpz_t objects maintained by GMPY2 to
      * avoid memory allocations. */
@@ -567,16 +797,11 @@ GMPY_mpz_is_lucas_prp(PyObject *self, PyObject *args)
     mpz_inoc(zD);
     mpz_inoc(res);
     mpz_inoc(index);
-    mpz_inoc(uh);
-    mpz_inoc(vl);
-    mpz_inoc(vh);
-    mpz_inoc(ql);
-    mpz_inoc(qh);
     mpz_inoc(tmp);
 
-    n = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
-    p = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL);
-    q = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 2), NULL);
+    n = GMPy_MPZ_From_Integer(args[0], NULL);
+    p = GMPy_MPZ_From_Integer(args[1], NULL);
+    q = GMPy_MPZ_From_Integer(args[2], NULL);
     if (!n || !p || !q) {
         TYPE_ERROR("is_lucas_prp() requires 3 integer arguments");
         goto cleanup;
@@ -629,97 +854,11 @@ GMPY_mpz_is_lucas_prp(PyObject *self, PyObject *args)
     else if (ret == 1)
         mpz_sub_ui(index, index, 1);
 
-    /* mpz_lucasumod(res, p, q, index, n); */
-    mpz_set_si(uh, 1);
-    mpz_set_si(vl, 2);
-    mpz_set(vh, p->z);
-    mpz_set_si(ql, 1);
-    mpz_set_si(qh, 1);
-    mpz_set_si(tmp,0);
-
-    s = mpz_scan1(index, 0);
-    for (j = mpz_sizeinbase(index,2)-1; j >= s+1; j--) {
-        /* ql = ql*qh (mod n) */
-        mpz_mul(ql, ql, qh);
-        mpz_mod(ql, ql, n->z);
-        if (mpz_tstbit(index,j) == 1) {
-            /* qh = ql*q */
-            mpz_mul(qh, ql, q->z);
-
-            /* uh = uh*vh (mod n) */
-            mpz_mul(uh, uh, vh);
-            mpz_mod(uh, uh, n->z);
-
-            /* vl = vh*vl - p*ql (mod n) */
-            mpz_mul(vl, vh, vl);
-            mpz_mul(tmp, ql, p->z);
-            mpz_sub(vl, vl, tmp);
-            mpz_mod(vl, vl, n->z);
-
-            /* vh = vh*vh - 2*qh (mod n) */
-            mpz_mul(vh, vh, vh);
-            mpz_mul_si(tmp, qh, 2);
-            mpz_sub(vh, vh, tmp);
-            mpz_mod(vh, vh, n->z);
-        }
-        else {
-            /* qh = ql */
-            mpz_set(qh, ql);
-
-            /* uh = uh*vl - ql (mod n) */
-            mpz_mul(uh, uh, vl);
-            mpz_sub(uh, uh, ql);
-            mpz_mod(uh, uh, n->z);
-
-            /* vh = vh*vl - p*ql (mod n) */
-            mpz_mul(vh, vh, vl);
-            mpz_mul(tmp, ql, p->z);
-            mpz_sub(vh, vh, tmp);
-            mpz_mod(vh, vh, n->z);
-
-            /* vl = vl*vl - 2*ql (mod n) */
-            mpz_mul(vl, vl, vl);
-            mpz_mul_si(tmp, ql, 2);
-            mpz_sub(vl, vl, tmp);
-            mpz_mod(vl, vl, n->z);
-        }
-    }
-    /* ql = ql*qh */
-    mpz_mul(ql, ql, qh);
-
-    /* qh = ql*q */
-    mpz_mul(qh, ql, q->z);
-
-    /* uh = uh*vl - ql */
-    mpz_mul(uh, uh, vl);
-    mpz_sub(uh, uh, ql);
-
-    /* vl = vh*vl - p*ql */
-    mpz_mul(vl, vh, vl);
-    mpz_mul(tmp, ql, p->z);
-    mpz_sub(vl, vl, tmp);
-
-    /* ql = ql*qh */
-    mpz_mul(ql, ql, qh);
-
-    for (j = 1; j <= s; j++) {
-        /* uh = uh*vl (mod n) */
-        mpz_mul(uh, uh, vl);
-        mpz_mod(uh, uh, n->z);
-
-        /* vl = vl*vl - 2*ql (mod n) */
-        mpz_mul(vl, vl, vl);
-        mpz_mul_si(tmp, ql, 2);
-        mpz_sub(vl, vl, tmp);
-        mpz_mod(vl, vl, n->z);
-
-        /* ql = ql*ql (mod n) */
-        mpz_mul(ql, ql, ql);
-        mpz_mod(ql, ql, n->z);
-    }
-
-    /* uh contains our return value */
-    mpz_mod(res, uh, n->z);
+    GMPY_BEGIN_NOGIL(mpz_sizeinbase(n->z, 2));
+    ret = lucas_uv_mod(res, NULL, NULL, p->z, q->z, index, n->z);
+    GMPY_END_NOGIL;
+    if (ret < 0)
+        goto cleanup;
     if (mpz_cmp_ui(res, 0) == 0)
         result = Py_True;
     else
@@ -730,17 +869,14 @@ GMPY_mpz_is_lucas_prp(PyObject *self, PyObject *args)
     mpz_clear(zD);
     mpz_clear(res);
     mpz_clear(index);
-    mpz_clear(uh);
-    mpz_clear(vl);
-    mpz_clear(vh);
-    mpz_clear(ql);
-    mpz_clear(qh);
     mpz_clear(tmp);
     Py_XDECREF((PyObject*)p);
     Py_XDECREF((PyObject*)q);
     Py_XDECREF((PyObject*)n);
+    GMPY_PROBE_RETURN("is_lucas_prp", gmpy_profile_bits_args(args, nargs));
     return result;
 }
+GMPY_FASTCALL_WRAPPER(GMPY_mpz_is_lucas_prp)
 
 /* *********************************************************************************************
  * mpz_stronglucas_prp:
@@ -763,20 +899,21 @@ PyDoc_STRVAR(doc_mpz_is_stronglucas_prp,
 "    lucasv(p,q,s*(2**t)) == 0 (mod n) for some t, 0 <= t < r");
 
 static PyObject *
-GMPY_mpz_is_stronglucas_prp(PyObject *self, PyObject *args)
+GMPY_mpz_is_stronglucas_prp(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     MPZ_Object *n, *p, *q;
     PyObject *result = 0;
     mpz_t zD, s, nmj, res;
     /* these are needed for the LucasU and LucasV part of this function */
-    mpz_t uh, vl, vh, ql, qh, tmp;
+    mpz_t uh, vl, ql, tmp;
     mp_bitcnt_t r = 0, j = 0;
-    int ret = 0;
+    int ret = 0, found;
 
-    if (PyTuple_Size(args) != 3) {
+    if (nargs != 3) {
         TYPE_ERROR("is_strong_lucas_prp() requires 3 integer arguments");
         return NULL;
     }
+    GMPY_PROBE_ENTRY("is_stronglucas_prp", gmpy_profile_bits_args(args, nargs));
 
     /* Take advantage of the cache of mpz_t objects maintained by GMPY2 to
      * avoid memory allocations. */
@@ -787,14 +924,12 @@ GMPY_mpz_is_stronglucas_prp(PyObject *self, PyObject *args)
     mpz_inoc(res);
     mpz_inoc(uh);
     mpz_inoc(vl);
-    mpz_inoc(vh);
     mpz_inoc(ql);
-    mpz_inoc(qh);
     mpz_inoc(tmp);
 
-    n = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
-    p = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL);
-    q = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 2), NULL);
+    n = GMPy_MPZ_From_Integer(args[0], NULL);
+    p = GMPy_MPZ_From_Integer(args[1], NULL);
+    q = GMPy_MPZ_From_Integer(args[2], NULL);
     if (!n || !p || !q) {
         TYPE_ERROR("is_strong_lucas_prp() requires 3 integer arguments");
         goto cleanup;
@@ -851,87 +986,17 @@ GMPY_mpz_is_stronglucas_prp(PyObject *self, PyObject *args)
     mpz_fdiv_q_2exp(s, nmj, r);
 
     /* make sure U_s == 0 mod n or V_((2^t)*s) == 0 mod n, for some t, 0 <= t < r */
-    mpz_set_si(uh, 1);
-    mpz_set_si(vl, 2);
-    mpz_set(vh, p->z);
-    mpz_set_si(ql, 1);
-    mpz_set_si(qh, 1);
-    mpz_set_si(tmp,0);
-
-    for (j = mpz_sizeinbase(s,2)-1; j >= 1; j--) {
-        /* ql = ql*qh (mod n) */
-        mpz_mul(ql, ql, qh);
-        mpz_mod(ql, ql, n->z);
-        if (mpz_tstbit(s,j) == 1) {
-            /* qh = ql*q */
-            mpz_mul(qh, ql, q->z);
-
-            /* uh = uh*vh (mod n) */
-            mpz_mul(uh, uh, vh);
-            mpz_mod(uh, uh, n->z);
-
-            /* vl = vh*vl - p*ql (mod n) */
-            mpz_mul(vl, vh, vl);
-            mpz_mul(tmp, ql, p->z);
-            mpz_sub(vl, vl, tmp);
-            mpz_mod(vl, vl, n->z);
-
-            /* vh = vh*vh - 2*qh (mod n) */
-            mpz_mul(vh, vh, vh);
-            mpz_mul_si(tmp, qh, 2);
-            mpz_sub(vh, vh, tmp);
-            mpz_mod(vh, vh, n->z);
-        }
-        else {
-            /* qh = ql */
-            mpz_set(qh, ql);
-
-            /* uh = uh*vl - ql (mod n) */
-            mpz_mul(uh, uh, vl);
-            mpz_sub(uh, uh, ql);
-            mpz_mod(uh, uh, n->z);
-
-            /* vh = vh*vl - p*ql (mod n) */
-            mpz_mul(vh, vh, vl);
-            mpz_mul(tmp, ql, p->z);
-            mpz_sub(vh, vh, tmp);
-            mpz_mod(vh, vh, n->z);
-
-            /* vl = vl*vl - 2*ql (mod n) */
-            mpz_mul(vl, vl, vl);
-            mpz_mul_si(tmp, ql, 2);
-            mpz_sub(vl, vl, tmp);
-            mpz_mod(vl, vl, n->z);
-        }
-    }
-    /* ql = ql*qh */
-    mpz_mul(ql, ql, qh);
-
-    /* qh = ql*q */
-    mpz_mul(qh, ql, q->z);
-
-    /* uh = uh*vl - ql */
-    mpz_mul(uh, uh, vl);
-    mpz_sub(uh, uh, ql);
-
-    /* vl = vh*vl - p*ql */
-    mpz_mul(vl, vh, vl);
-    mpz_mul(tmp, ql, p->z);
-    mpz_sub(vl, vl, tmp);
-
-    /* ql = ql*qh */
-    mpz_mul(ql, ql, qh);
-
-    mpz_mod(uh, uh, n->z);
-    mpz_mod(vl, vl, n->z);
+    GMPY_BEGIN_NOGIL(mpz_sizeinbase(n->z, 2));
+    ret = lucas_uv_mod(uh, vl, ql, p->z, q->z, s, n->z);
 
     /* uh contains LucasU_s and vl contains LucasV_s */
-    if ((mpz_cmp_ui(uh, 0) == 0) || (mpz_cmp_ui(vl, 0) == 0)) {
-        result = Py_True;
-        goto cleanup;
-    }
+    found = (ret == 0) && ((mpz_cmp_ui(uh, 0) == 0) || (mpz_cmp_ui(vl, 0) == 0));
 
-    for (j = 1; j < r; j++) {
+    for (j = 1; ret == 0 && !found && j < r; j++) {
+        if (GMPY_CANCEL_POINT(mpz_sizeinbase(n->z, 2), j, r)) {
+            ret = -1;
+            break;
+        }
         /* vl = vl*vl - 2*ql (mod n) */
         mpz_mul(vl, vl, vl);
         mpz_mul_si(tmp, ql, 2);
@@ -942,13 +1007,13 @@ GMPY_mpz_is_stronglucas_prp(PyObject *self, PyObject *args)
         mpz_mul(ql, ql, ql);
         mpz_mod(ql, ql, n->z);
 
-        if (mpz_cmp_ui(vl, 0) == 0) {
-            result = Py_True;
-            goto cleanup;
-        }
+        found = (mpz_cmp_ui(vl, 0) == 0);
     }
+    GMPY_END_NOGIL;
 
-    result = Py_False;
+    if (ret < 0)
+        goto cleanup;
+    result = found ? Py_True : Py_False;
   cleanup:
     Py_XINCREF(result);
     mpz_clear(zD);
@@ -957,15 +1022,15 @@ GMPY_mpz_is_stronglucas_prp(PyObject *self, PyObject *args)
     mpz_clear(res);
     mpz_clear(uh);
     mpz_clear(vl);
-    mpz_clear(vh);
     mpz_clear(ql);
-    mpz_clear(qh);
     mpz_clear(tmp);
     Py_XDECREF((PyObject*)p);
     Py_XDECREF((PyObject*)q);
     Py_XDECREF((PyObject*)n);
+    GMPY_PROBE_RETURN("is_stronglucas_prp", gmpy_profile_bits_args(args, nargs));
     return result;
 }
+GMPY_FASTCALL_WRAPPER(GMPY_mpz_is_stronglucas_prp)
 
 /* *******************************************************************************************
  * mpz_extrastronglucas_prp:
@@ -991,20 +1056,21 @@ PyDoc_STRVAR(doc_mpz_is_extrastronglucas_prp,
 "    lucasv(p,1,s*(2**t)) == 0 (mod n) for some t, 0 <= t < r");
 
 static PyObject *
-GMPY_mpz_is_extrastronglucas_prp(PyObject *self, PyObject *args)
+GMPY_mpz_is_extrastronglucas_prp(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     MPZ_Object *n, *p;
     PyObject *result = 0;
     mpz_t zD, s, nmj, nm2, res;
     /* these are needed for the LucasU and LucasV part of this function */
-    mpz_t uh, vl, vh, ql, qh, tmp;
+    mpz_t uh, vl, ql, qh, tmp;
     mp_bitcnt_t r = 0, j = 0;
     int ret = 0;
 
-    if (PyTuple_Size(args) != 2) {
+    if (nargs != 2) {
         TYPE_ERROR("is_extra_strong_lucas_prp() requires 2 integer arguments");
         return NULL;
     }
+    GMPY_PROBE_ENTRY("is_extrastronglucas_prp", gmpy_profile_bits_args(args, nargs));
 
     /* Take advantage of the cache of mpz_t objects maintained by GMPY2 to
      * avoid memory allocations. */
@@ -1016,13 +1082,12 @@ GMPY_mpz_is_extrastronglucas_prp(PyObject *self, PyObject *args)
     mpz_inoc(res);
     mpz_inoc(uh);
     mpz_inoc(vl);
-    mpz_inoc(vh);
     mpz_inoc(ql);
     mpz_inoc(qh);
     mpz_inoc(tmp);
 
-    n = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
-    p = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL);
+    n = GMPy_MPZ_From_Integer(args[0], NULL);
+    p = GMPy_MPZ_From_Integer(args[1], NULL);
     if (!n || !p) {
         TYPE_ERROR("is_extra_strong_lucas_prp() requires 2 integer arguments");
         goto cleanup;
@@ -1081,79 +1146,9 @@ GMPY_mpz_is_extrastronglucas_prp(PyObject *self, PyObject *args)
 
     /* make sure that either U_s == 0 mod n or V_s == +/-2 mod n, or */
     /* V_((2^t)*s) == 0 mod n for some t with 0 <= t < r-1           */
-    mpz_set_si(uh, 1);
-    mpz_set_si(vl, 2);
-    mpz_set(vh, p->z);
-    mpz_set_si(ql, 1);
-    mpz_set_si(qh, 1);
-    mpz_set_si(tmp,0);
-
-    for (j = mpz_sizeinbase(s,2)-1; j >= 1; j--) {
-        /* ql = ql*qh (mod n) */
-        mpz_mul(ql, ql, qh);
-        mpz_mod(ql, ql, n->z);
-        if (mpz_tstbit(s,j) == 1) {
-            /* qh = ql*q */
-            mpz_set(qh, ql);
-
-            /* uh = uh*vh (mod n) */
-            mpz_mul(uh, uh, vh);
-            mpz_mod(uh, uh, n->z);
-
-            /* vl = vh*vl - p*ql (mod n) */
-            mpz_mul(vl, vh, vl);
-            mpz_mul(tmp, ql, p->z);
-            mpz_sub(vl, vl, tmp);
-            mpz_mod(vl, vl, n->z);
-
-            /* vh = vh*vh - 2*qh (mod n) */
-            mpz_mul(vh, vh, vh);
-            mpz_mul_si(tmp, qh, 2);
-            mpz_sub(vh, vh, tmp);
-            mpz_mod(vh, vh, n->z);
-        }
-        else {
-            /* qh = ql */
-            mpz_set(qh, ql);
-
-            /* uh = uh*vl - ql (mod n) */
-            mpz_mul(uh, uh, vl);
-            mpz_sub(uh, uh, ql);
-            mpz_mod(uh, uh, n->z);
-
-            /* vh = vh*vl - p*ql (mod n) */
-            mpz_mul(vh, vh, vl);
-            mpz_mul(tmp, ql, p->z);
-            mpz_sub(vh, vh, tmp);
-            mpz_mod(vh, vh, n->z);
-
-            /* vl = vl*vl - 2*ql (mod n) */
-            mpz_mul(vl, vl, vl);
-            mpz_mul_si(tmp, ql, 2);
-            mpz_sub(vl, vl, tmp);
-            mpz_mod(vl, vl, n->z);
-        }
-    }
-    /* ql = ql*qh */
-    mpz_mul(ql, ql, qh);
-
-    /* qh = ql*q */
-    mpz_set(qh, ql);
-
-    /* uh = uh*vl - ql */
-    mpz_mul(uh, uh, vl);
-    mpz_sub(uh, uh, ql);
-
-    /* vl = vh*vl - p*ql */
-    mpz_mul(vl, vh, vl);
-    mpz_mul(tmp, ql, p->z);
-    mpz_sub(vl, vl, tmp);
-
-    /* ql = ql*qh */
-    mpz_mul(ql, ql, qh);
-
-    mpz_mod(uh, uh, n->z);
-    mpz_mod(vl, vl, n->z);
+    mpz_set_ui(qh, 1);
+    if (lucas_uv_mod(uh, vl, ql, p->z, qh, s, n->z) < 0)
+        goto cleanup;
 
     /* uh contains LucasU_s and vl contains LucasV_s */
     if ((mpz_cmp_ui(uh, 0) == 0) || (mpz_cmp_ui(vl, 0) == 0) ||
@@ -1163,6 +1158,9 @@ GMPY_mpz_is_extrastronglucas_prp(PyObject *self, PyObject *args)
     }
 
     for (j = 1; j < r-1; j++) {
+        if (GMPY_CANCEL_POINT(mpz_sizeinbase(n->z, 2), j, r - 1))
+            goto cleanup;
+
         /* vl = vl*vl - 2*ql (mod n) */
         mpz_mul(vl, vl, vl);
         mpz_mul_si(tmp, ql, 2);
@@ -1189,14 +1187,15 @@ GMPY_mpz_is_extrastronglucas_prp(PyObject *self, PyObject *args)
     mpz_clear(res);
     mpz_clear(uh);
     mpz_clear(vl);
-    mpz_clear(vh);
     mpz_clear(ql);
     mpz_clear(qh);
     mpz_clear(tmp);
     Py_XDECREF((PyObject*)p);
     Py_XDECREF((PyObject*)n);
+    GMPY_PROBE_RETURN("is_extrastronglucas_prp", gmpy_profile_bits_args(args, nargs));
     return result;
 }
+GMPY_FASTCALL_WRAPPER(GMPY_mpz_is_extrastronglucas_prp)
 
 /* ***********************************************************************************************
  * mpz_selfridge_prp:
@@ -1215,25 +1214,26 @@ PyDoc_STRVAR(doc_mpz_is_selfridge_prp,
 "a Lucas probable prime test.");
 
 static PyObject *
-GMPY_mpz_is_selfridge_prp(PyObject *self, PyObject *args)
+GMPY_mpz_is_selfridge_prp(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     MPZ_Object *n;
-    PyObject *result = 0, *temp = 0;
+    PyObject *result = 0, *argv[3];
     long d = 5, p = 1, q = 0, max_d = 1000000;
     int jacobi = 0;
     mpz_t zD;
 
-    if (PyTuple_Size(args) != 1) {
+    if (nargs != 1) {
         TYPE_ERROR("is_selfridge_prp() requires 1 integer argument");
         return NULL;
     }
+    GMPY_PROBE_ENTRY("is_selfridge_prp", gmpy_profile_bits_args(args, nargs));
 
     /* Take advantage of the cache of mpz_t objects maintained by GMPY2 to
      * avoid memory allocations. */
 
     mpz_inoc(zD);
 
-    n = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
+    n = GMPy_MPZ_From_Integer(args[0], NULL);
     if (!n) {
         TYPE_ERROR("is_selfridge_prp() requires 1 integer argument");
         goto cleanup;
@@ -1308,14 +1308,13 @@ GMPY_mpz_is_selfridge_prp(PyObject *self, PyObject *args)
 
     q = (1-d)/4;
 
-    /* Since "O" is used, the refcount for n is incremented so deleting
-     * temp will not delete n.
-     */
-    temp = Py_BuildValue("Oll", n, p, q);
-    if (!temp)
-        goto cleanup;
-    result = GMPY_mpz_is_lucas_prp(NULL, temp);
-    Py_DECREF(temp);
+    argv[0] = (PyObject*)n;
+    argv[1] = PyIntOrLong_FromLong(p);
+    argv[2] = PyIntOrLong_FromLong(q);
+    if (argv[1] && argv[2])
+        result = GMPY_mpz_is_lucas_prp(NULL, argv, 3);
+    Py_XDECREF(argv[1]);
+    Py_XDECREF(argv[2]);
     goto return_result;
 
   cleanup:
@@ -1323,8 +1322,10 @@ GMPY_mpz_is_selfridge_prp(PyObject *self, PyObject *args)
   return_result:
     mpz_cloc(zD);
     Py_DECREF((PyObject*)n);
+    GMPY_PROBE_RETURN("is_selfridge_prp", gmpy_profile_bits_args(args, nargs));
     return result;
 }
+GMPY_FASTCALL_WRAPPER(GMPY_mpz_is_selfridge_prp)
 
 /* *********************************************************************************************************
  * mpz_strongselfridge_prp:
@@ -1343,25 +1344,26 @@ PyDoc_STRVAR(doc_mpz_is_strongselfridge_prp,
 "a strong Lucas probable prime test.");
 
 static PyObject *
-GMPY_mpz_is_strongselfridge_prp(PyObject *self, PyObject *args)
+GMPY_mpz_is_strongselfridge_prp(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     MPZ_Object *n;
-    PyObject *result = 0, *temp = 0;
+    PyObject *result = 0, *argv[3];
     long d = 5, p = 1, q = 0, max_d = 1000000;
     int jacobi = 0;
     mpz_t zD;
 
-    if (PyTuple_Size(args) != 1) {
+    if (nargs != 1) {
         TYPE_ERROR("is_strong_selfridge_prp() requires 1 integer argument");
         return NULL;
     }
+    GMPY_PROBE_ENTRY("is_strongselfridge_prp", gmpy_profile_bits_args(args, nargs));
 
     /* Take advantage of the cache of mpz_t objects maintained by GMPY2 to
      * avoid memory allocations. */
 
     mpz_inoc(zD);
 
-    n = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
+    n = GMPy_MPZ_From_Integer(args[0], NULL);
     if (!n) {
         TYPE_ERROR("is_strong_selfridge_prp() requires 1 integer argument");
         goto cleanup;
@@ -1437,14 +1439,13 @@ GMPY_mpz_is_strongselfridge_prp(PyObject *self, PyObject *args)
 
     q = (1-d)/4;
 
-    /* Since "O" is used, the refcount for n is incremented so deleting
-     * temp will not delete n.
-     */
-    temp = Py_BuildValue("Oll", n, p, q);
-    if (!temp)
-        goto cleanup;
-    result = GMPY_mpz_is_stronglucas_prp(NULL, temp);
-    Py_DECREF(temp);
+    argv[0] = (PyObject*)n;
+    argv[1] = PyIntOrLong_FromLong(p);
+    argv[2] = PyIntOrLong_FromLong(q);
+    if (argv[1] && argv[2])
+        result = GMPY_mpz_is_stronglucas_prp(NULL, argv, 3);
+    Py_XDECREF(argv[1]);
+    Py_XDECREF(argv[2]);
     goto return_result;
 
   cleanup:
@@ -1452,8 +1453,10 @@ GMPY_mpz_is_strongselfridge_prp(PyObject *self, PyObject *args)
   return_result:
     mpz_cloc(zD);
     Py_DECREF((PyObject*)n);
+    GMPY_PROBE_RETURN("is_strongselfridge_prp", gmpy_profile_bits_args(args, nargs));
     return result;
 }
+GMPY_FASTCALL_WRAPPER(GMPY_mpz_is_strongselfridge_prp)
 
 /* **********************************************************************************
  * mpz_bpsw_prp:
@@ -1468,18 +1471,22 @@ PyDoc_STRVAR(doc_mpz_is_bpsw_prp,
 "prime. A BPSW probable prime passes the is_strong_prp() test with base\n"
 "2 and the is_selfridge_prp() test.\n");
 
+GMPY_PROFILE_WRAP(PyObject *, GMPY_mpz_is_bpsw_prp, (PyObject *self, PyObject *const *args, Py_ssize_t nargs),
+                  (self, args, nargs), gmpy_profile_bits_args(args, nargs))
+
 static PyObject *
-GMPY_mpz_is_bpsw_prp(PyObject *self, PyObject *args)
+GMPY_mpz_is_bpsw_prp_Impl(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     MPZ_Object *n;
-    PyObject *result = 0, *temp = 0;
+    PyObject *result = 0, *argv[3];
 
-    if (PyTuple_Size(args) != 1) {
+    if (nargs != 1) {
         TYPE_ERROR("is_bpsw_prp() requires 1 integer argument");
         return NULL;
     }
+    GMPY_PROBE_ENTRY("is_bpsw_prp", gmpy_profile_bits_args(args, nargs));
 
-    n = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
+    n = GMPy_MPZ_From_Integer(args[0], NULL);
     if (!n) {
         TYPE_ERROR("is_bpsw_prp() requires 1 integer argument");
         goto cleanup;
@@ -1506,32 +1513,38 @@ GMPY_mpz_is_bpsw_prp(PyObject *self, PyObject *args)
         goto cleanup;
     }
 
-    /* "O" is used to increment the reference to n so deleting temp won't
-     * delete n.
-     */
-    temp = Py_BuildValue("Oi", n, 2);
-    if (!temp)
+    if (mpz_size(n->z) == 1) {
+        result = prp_word_is_prime(mpz_getlimbn(n->z, 0)) ? Py_True : Py_False;
+        goto cleanup;
+    }
+
+    PRP_TRIAL_INIT();
+    if (prp_trial_divide(n->z, global.bpsw_trial_limit)) {
+        result = Py_False;
+        goto cleanup;
+    }
+
+    argv[0] = (PyObject*)n;
+    if (!(argv[1] = PyIntOrLong_FromLong(2)))
         goto cleanup;
-    result = GMPY_mpz_is_strong_prp(NULL, temp);
-    Py_DECREF(temp);
-    if (result == Py_False)
+    result = GMPY_mpz_is_strong_prp(NULL, argv, 2);
+    Py_DECREF(argv[1]);
+    if (result != Py_True)
         goto return_result;
     /* Remember to ignore the preceding result */
     Py_DECREF(result);
 
-    temp = Py_BuildValue("O", n);
-    if (!temp)
-        goto cleanup;
-    result = GMPY_mpz_is_selfridge_prp(NULL, temp);
-    Py_DECREF(temp);
+    result = GMPY_mpz_is_selfridge_prp(NULL, argv, 1);
     goto return_result;
 
   cleanup:
     Py_XINCREF(result);
   return_result:
     Py_DECREF((PyObject*)n);
+    GMPY_PROBE_RETURN("is_bpsw_prp", gmpy_profile_bits_args(args, nargs));
     return result;
 }
+GMPY_FASTCALL_WRAPPER(GMPY_mpz_is_bpsw_prp)
 
 
 /* ****************************************************************************************
@@ -1548,17 +1561,18 @@ PyDoc_STRVAR(doc_mpz_is_strongbpsw_prp,
 "test with base and the is_strong_selfridge_prp() test.\n");
 
 static PyObject *
-GMPY_mpz_is_strongbpsw_prp(PyObject *self, PyObject *args)
+GMPY_mpz_is_strongbpsw_prp(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
     MPZ_Object *n;
-    PyObject *result = 0, *temp = 0;
+    PyObject *result = 0, *argv[3];
 
-    if (PyTuple_Size(args) != 1) {
+    if (nargs != 1) {
         TYPE_ERROR("is_strong_bpsw_prp() requires 1 integer argument");
         return NULL;
     }
+    GMPY_PROBE_ENTRY("is_strongbpsw_prp", gmpy_profile_bits_args(args, nargs));
 
-    n = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
+    n = GMPy_MPZ_From_Integer(args[0], NULL);
     if (!n) {
         TYPE_ERROR("is_strong_bpsw_prp() requires 1 integer argument");
         goto cleanup;
@@ -1585,30 +1599,36 @@ GMPY_mpz_is_strongbpsw_prp(PyObject *self, PyObject *args)
         goto cleanup;
     }
 
-    /* "O" is used to increment the reference to n so deleting temp won't
-     * delete n.
-     */
-    temp = Py_BuildValue("Oi", n, 2);
-    if (!temp)
+    if (mpz_size(n->z) == 1) {
+        result = prp_word_is_prime(mpz_getlimbn(n->z, 0)) ? Py_True : Py_False;
         goto cleanup;
-    result = GMPY_mpz_is_strong_prp(NULL, temp);
-    Py_DECREF(temp);
-    if (result == Py_False)
+    }
+
+    PRP_TRIAL_INIT();
+    if (prp_trial_divide(n->z, global.bpsw_trial_limit)) {
+        result = Py_False;
+        goto cleanup;
+    }
+
+    argv[0] = (PyObject*)n;
+    if (!(argv[1] = PyIntOrLong_FromLong(2)))
+        goto cleanup;
+    result = GMPY_mpz_is_strong_prp(NULL, argv, 2);
+    Py_DECREF(argv[1]);
+    if (result != Py_True)
         goto return_result;
     /* Remember to ignore the preceding result */
     Py_DECREF(result);
 
-    temp = Py_BuildValue("O", n);
-    if (!temp)
-        goto cleanup;
-    result = GMPY_mpz_is_selfridge_prp(NULL, temp);
-    Py_DECREF(temp);
+    result = GMPY_mpz_is_selfridge_prp(NULL, argv, 1);
     goto return_result;
 
   cleanup:
     Py_XINCREF(result);
   return_result:
     Py_DECREF((PyObject*)n);
+    GMPY_PROBE_RETURN("is_strongbpsw_prp", gmpy_profile_bits_args(args, nargs));
     return result;
 }
+GMPY_FASTCALL_WRAPPER(GMPY_mpz_is_strongbpsw_prp)
 
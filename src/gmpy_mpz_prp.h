@@ -29,17 +29,23 @@
 extern "C" {
 #endif
 
-static PyObject * GMPY_mpz_is_fermat_prp(PyObject *self, PyObject *args);
-static PyObject * GMPY_mpz_is_euler_prp(PyObject *self, PyObject *args);
-static PyObject * GMPY_mpz_is_strong_prp(PyObject *self, PyObject *args);
-static PyObject * GMPY_mpz_is_fibonacci_prp(PyObject *self, PyObject *args);
-static PyObject * GMPY_mpz_is_lucas_prp(PyObject *self, PyObject *args);
-static PyObject * GMPY_mpz_is_stronglucas_prp(PyObject *self, PyObject *args);
-static PyObject * GMPY_mpz_is_extrastronglucas_prp(PyObject *self, PyObject *args);
-static PyObject * GMPY_mpz_is_selfridge_prp(PyObject *self, PyObject *args);
-static PyObject * GMPY_mpz_is_strongselfridge_prp(PyObject *self, PyObject *args);
-static PyObject * GMPY_mpz_is_bpsw_prp(PyObject *self, PyObject *args);
-static PyObject * GMPY_mpz_is_strongbpsw_prp(PyObject *self, PyObject *args);
+static int        prp_word_is_prime(mp_limb_t n);
+static void       prp_trial_init(void);
+static int        prp_trial_divide(mpz_t n, unsigned long limit);
+static int        prp_is_prime(mpz_srcptr n);
+static PyObject * GMPy_get_bpsw_trial_limit(PyObject *self, PyObject *args);
+static PyObject * GMPy_set_bpsw_trial_limit(PyObject *self, PyObject *other);
+static PyObject * GMPY_mpz_is_fermat_prp(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPY_mpz_is_euler_prp(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPY_mpz_is_strong_prp(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPY_mpz_is_fibonacci_prp(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPY_mpz_is_lucas_prp(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPY_mpz_is_stronglucas_prp(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPY_mpz_is_extrastronglucas_prp(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPY_mpz_is_selfridge_prp(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPY_mpz_is_strongselfridge_prp(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPY_mpz_is_bpsw_prp(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
+static PyObject * GMPY_mpz_is_strongbpsw_prp(PyObject *self, PyObject *const *args, Py_ssize_t nargs);
 
 #ifdef __cplusplus
 }
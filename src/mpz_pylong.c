@@ -97,7 +97,76 @@ mpn_pylong_size (mp_ptr up, size_t un)
     return (mpn_sizebits(up, un) + PyLong_SHIFT - 1) / PyLong_SHIFT;
 }
 
-/* this is based from GMP code in mpn/get_str.c */
+/* The conversions work from the least significant end, so that each
+ * digit or limb is read once and shifted into place with a single word
+ * operation.
+ */
+
+#if PyLong_SHIFT == 30 && GMP_NUMB_BITS == 64
+/* With 30-bit digits and 64-bit limbs, 32 digits fill exactly 15 limbs.
+ * Whole blocks are converted with fixed shifts.
+ */
+
+#define PYLONG_BLOCK_DIGITS 32
+#define PYLONG_BLOCK_LIMBS  15
+
+static inline void
+mpn_set_pylong_block(mp_ptr up, const digit *d)
+{
+    up[0] = (mp_limb_t)d[0] | (mp_limb_t)d[1] << 30 | (mp_limb_t)d[2] << 60;
+    up[1] = (mp_limb_t)d[2] >> 4 | (mp_limb_t)d[3] << 26 | (mp_limb_t)d[4] << 56;
+    up[2] = (mp_limb_t)d[4] >> 8 | (mp_limb_t)d[5] << 22 | (mp_limb_t)d[6] << 52;
+    up[3] = (mp_limb_t)d[6] >> 12 | (mp_limb_t)d[7] << 18 | (mp_limb_t)d[8] << 48;
+    up[4] = (mp_limb_t)d[8] >> 16 | (mp_limb_t)d[9] << 14 | (mp_limb_t)d[10] << 44;
+    up[5] = (mp_limb_t)d[10] >> 20 | (mp_limb_t)d[11] << 10 | (mp_limb_t)d[12] << 40;
+    up[6] = (mp_limb_t)d[12] >> 24 | (mp_limb_t)d[13] << 6 | (mp_limb_t)d[14] << 36;
+    up[7] = (mp_limb_t)d[14] >> 28 | (mp_limb_t)d[15] << 2 | (mp_limb_t)d[16] << 32 | (mp_limb_t)d[17] << 62;
+    up[8] = (mp_limb_t)d[17] >> 2 | (mp_limb_t)d[18] << 28 | (mp_limb_t)d[19] << 58;
+    up[9] = (mp_limb_t)d[19] >> 6 | (mp_limb_t)d[20] << 24 | (mp_limb_t)d[21] << 54;
+    up[10] = (mp_limb_t)d[21] >> 10 | (mp_limb_t)d[22] << 20 | (mp_limb_t)d[23] << 50;
+    up[11] = (mp_limb_t)d[23] >> 14 | (mp_limb_t)d[24] << 16 | (mp_limb_t)d[25] << 46;
+    up[12] = (mp_limb_t)d[25] >> 18 | (mp_limb_t)d[26] << 12 | (mp_limb_t)d[27] << 42;
+    up[13] = (mp_limb_t)d[27] >> 22 | (mp_limb_t)d[28] << 8 | (mp_limb_t)d[29] << 38;
+    up[14] = (mp_limb_t)d[29] >> 26 | (mp_limb_t)d[30] << 4 | (mp_limb_t)d[31] << 34;
+}
+
+static inline void
+mpn_get_pylong_block(digit *d, mp_srcptr up)
+{
+    d[0] = (digit)(up[0] & PyLong_MASK);
+    d[1] = (digit)(up[0] >> 30 & PyLong_MASK);
+    d[2] = (digit)((up[0] >> 60 | up[1] << 4) & PyLong_MASK);
+    d[3] = (digit)(up[1] >> 26 & PyLong_MASK);
+    d[4] = (digit)((up[1] >> 56 | up[2] << 8) & PyLong_MASK);
+    d[5] = (digit)(up[2] >> 22 & PyLong_MASK);
+    d[6] = (digit)((up[2] >> 52 | up[3] << 12) & PyLong_MASK);
+    d[7] = (digit)(up[3] >> 18 & PyLong_MASK);
+    d[8] = (digit)((up[3] >> 48 | up[4] << 16) & PyLong_MASK);
+    d[9] = (digit)(up[4] >> 14 & PyLong_MASK);
+    d[10] = (digit)((up[4] >> 44 | up[5] << 20) & PyLong_MASK);
+    d[11] = (digit)(up[5] >> 10 & PyLong_MASK);
+    d[12] = (digit)((up[5] >> 40 | up[6] << 24) & PyLong_MASK);
+    d[13] = (digit)(up[6] >> 6 & PyLong_MASK);
+    d[14] = (digit)((up[6] >> 36 | up[7] << 28) & PyLong_MASK);
+    d[15] = (digit)(up[7] >> 2 & PyLong_MASK);
+    d[16] = (digit)(up[7] >> 32 & PyLong_MASK);
+    d[17] = (digit)((up[7] >> 62 | up[8] << 2) & PyLong_MASK);
+    d[18] = (digit)(up[8] >> 28 & PyLong_MASK);
+    d[19] = (digit)((up[8] >> 58 | up[9] << 6) & PyLong_MASK);
+    d[20] = (digit)(up[9] >> 24 & PyLong_MASK);
+    d[21] = (digit)((up[9] >> 54 | up[10] << 10) & PyLong_MASK);
+    d[22] = (digit)(up[10] >> 20 & PyLong_MASK);
+    d[23] = (digit)((up[10] >> 50 | up[11] << 14) & PyLong_MASK);
+    d[24] = (digit)(up[11] >> 16 & PyLong_MASK);
+    d[25] = (digit)((up[11] >> 46 | up[12] << 18) & PyLong_MASK);
+    d[26] = (digit)(up[12] >> 12 & PyLong_MASK);
+    d[27] = (digit)((up[12] >> 42 | up[13] << 22) & PyLong_MASK);
+    d[28] = (digit)(up[13] >> 8 & PyLong_MASK);
+    d[29] = (digit)((up[13] >> 38 | up[14] << 26) & PyLong_MASK);
+    d[30] = (digit)(up[14] >> 4 & PyLong_MASK);
+    d[31] = (digit)(up[14] >> 34 & PyLong_MASK);
+}
+#endif
 
 /* Assume digits points to a chunk of size size
  * where size >= mpn_pylong_size(up, un)
@@ -105,34 +174,41 @@ mpn_pylong_size (mp_ptr up, size_t un)
 void
 mpn_get_pylong (digit *digits, size_t size, mp_ptr up, size_t un)
 {
-    mp_limb_t n1, n0;
-    size_t i;
-    ssize_t bit_pos;
-    /* point past the allocated chunk */
-    digit *s = digits + size;
-
-    /* input length 0 is special ! */
-    if (un == 0) {
-        while (size) digits[--size] = 0;
-        return;
+    mp_limb_t n, acc = 0;
+    size_t i, j = 0;
+    int bits = 0, avail;
+
+#ifdef PYLONG_BLOCK_DIGITS
+    while (un >= PYLONG_BLOCK_LIMBS && size >= PYLONG_BLOCK_DIGITS) {
+        mpn_get_pylong_block(digits, up);
+        digits += PYLONG_BLOCK_DIGITS;
+        size -= PYLONG_BLOCK_DIGITS;
+        up += PYLONG_BLOCK_LIMBS;
+        un -= PYLONG_BLOCK_LIMBS;
     }
+#endif
 
-    i = un - 1;
-    n1 = up[i];
-    bit_pos = size * PyLong_SHIFT - i * GMP_NUMB_BITS;
-
-    for (;;) {
-        bit_pos -= PyLong_SHIFT;
-        while (bit_pos >= 0) {
-            *--s = (n1 >> bit_pos) & PyLong_MASK;
-            bit_pos -= PyLong_SHIFT;
-            }
-        if (i == 0)
-            break;
-        n0 = (n1 << -bit_pos) & PyLong_MASK;
-        n1 = up[--i];
-        bit_pos += GMP_NUMB_BITS;
-        *--s = (digit)(n0 | (n1 >> bit_pos));
+    for (i = 0; i < un && j < size; i++) {
+        n = up[i];
+        avail = GMP_NUMB_BITS;
+        if (bits) {
+            /* complete the digit started by the previous limb */
+            digits[j++] = (digit)((acc | (n << bits)) & PyLong_MASK);
+            n >>= PyLong_SHIFT - bits;
+            avail -= PyLong_SHIFT - bits;
+        }
+        while (avail >= PyLong_SHIFT && j < size) {
+            digits[j++] = (digit)(n & PyLong_MASK);
+            n >>= PyLong_SHIFT;
+            avail -= PyLong_SHIFT;
+        }
+        acc = n;
+        bits = avail;
+    }
+    /* the remaining high bits; zero once the limbs are exhausted */
+    while (j < size) {
+        digits[j++] = (digit)(acc & PyLong_MASK);
+        acc = 0;
     }
 }
 
@@ -147,38 +223,35 @@ mpn_size_from_pylong (digit *digits, size_t size)
 void
 mpn_set_pylong(mp_ptr up, size_t un, digit *digits, size_t size)
 {
-    mp_limb_t n1, d;
-    size_t i;
-    ssize_t bit_pos;
-    /* point past the allocated chunk */
-    digit * s = digits + size;
-
-    /* input length 0 is special ! */
-    if (size == 0) {
-        while (un) up[--un] = 0;
-        return;
+    mp_limb_t d, acc = 0;
+    size_t i, j = 0;
+    int bits = 0;
+
+#ifdef PYLONG_BLOCK_DIGITS
+    while (size >= PYLONG_BLOCK_DIGITS && un >= PYLONG_BLOCK_LIMBS) {
+        mpn_set_pylong_block(up, digits);
+        digits += PYLONG_BLOCK_DIGITS;
+        size -= PYLONG_BLOCK_DIGITS;
+        up += PYLONG_BLOCK_LIMBS;
+        un -= PYLONG_BLOCK_LIMBS;
     }
+#endif
 
-    i = un - 1;
-    n1 = 0;
-    bit_pos = size * PyLong_SHIFT - i * GMP_NUMB_BITS;
-
-    for (;;) {
-        bit_pos -= PyLong_SHIFT;
-        while (bit_pos >= 0) {
-            d = (mp_limb_t) *--s;
-            n1 |= (d << bit_pos) & GMP_NUMB_MASK;
-            bit_pos -= PyLong_SHIFT;
-            }
-        if (i == 0)
-            break;
-        d = (mp_limb_t) *--s;
-        /* add some high bits of d; maybe none if bit_pos=-SHIFT */
-        up[i--] = n1 | (d & PyLong_MASK) >> -bit_pos;
-        bit_pos += GMP_NUMB_BITS;
-        n1 = (d << bit_pos) & GMP_NUMB_MASK;
+    for (i = 0; i < size; i++) {
+        d = (mp_limb_t)digits[i];
+        acc |= (d << bits) & GMP_NUMB_MASK;
+        bits += PyLong_SHIFT;
+        if (bits >= GMP_NUMB_BITS) {
+            up[j++] = acc;
+            bits -= GMP_NUMB_BITS;
+            /* the bits of d that did not fit; d < 2**PyLong_SHIFT */
+            acc = d >> (PyLong_SHIFT - bits);
+        }
     }
-    up[0] = n1;
+    if (j < un)
+        up[j++] = acc;
+    while (j < un)
+        up[j++] = 0;
 }
 
 
@@ -261,9 +334,15 @@ mpz_pythonhash(mpz_srcptr z)
 PyObject *
 mpz_get_PyLong(mpz_srcptr z)
 {
-    size_t size = mpn_pylong_size(z->_mp_d, ABS(z->_mp_size));
-    PyLongObject *lptr = PyObject_NEW_VAR(PyLongObject, &PyLong_Type, size);
+    size_t size;
+    PyLongObject *lptr;
 
+    /* Small values use CPython's own fast path and small int cache. */
+    if (mpz_fits_slong_p(z))
+        return PyLong_FromLong(mpz_get_si(z));
+
+    size = mpn_pylong_size(z->_mp_d, ABS(z->_mp_size));
+    lptr = PyObject_NEW_VAR(PyLongObject, &PyLong_Type, size);
     if (lptr != NULL) {
         mpn_get_pylong(lptr->ob_digit, size, z->_mp_d, ABS(z->_mp_size));
         if (z->_mp_size < 0)
@@ -287,6 +366,20 @@ mpz_set_PyIntOrLong(mpz_ptr z, PyObject *lsrc)
     }
 #endif
 
+    /* Most ints seen in mixed arithmetic have at most one digit. */
+    switch (Py_SIZE(lptr)) {
+    case 0:
+        z->_mp_size = 0;
+        return;
+    case 1:
+        mpz_set_ui(z, (unsigned long)lptr->ob_digit[0]);
+        return;
+    case -1:
+        mpz_set_ui(z, (unsigned long)lptr->ob_digit[0]);
+        mpz_neg(z, z);
+        return;
+    }
+
     size = (ssize_t)mpn_size_from_pylong(lptr->ob_digit, ABS(Py_SIZE(lptr)));
 
     if (z->_mp_alloc < size)
@@ -299,3 +392,53 @@ mpz_set_PyIntOrLong(mpz_ptr z, PyObject *lsrc)
 }
 
 
+/* mpz <-> pylong comparison
+ *
+ * Compare the signs, then the number of bits, then the digits of the
+ * pylong from the most significant one down. The digits are compared with
+ * the matching bits of the mpz so nothing is converted or allocated; sorting
+ * a list that mixes mpz and int values compares the values many times.
+ */
+int
+mpz_cmp_PyIntOrLong(mpz_srcptr z, PyObject *lsrc)
+{
+    register PyLongObject *lptr = (PyLongObject*)lsrc;
+    ssize_t lsize;
+    size_t un, size, bits, pos, i, k, off;
+    mp_limb_t w;
+    int sign;
+
+#ifdef PY2
+    if (PyInt_Check(lsrc))
+        return mpz_cmp_si(z, PyInt_AS_LONG(lsrc));
+#endif
+
+    lsize = (ssize_t)Py_SIZE(lptr);
+    if (z->_mp_size == 0 || lsize == 0 || (z->_mp_size < 0) != (lsize < 0)) {
+        return ((z->_mp_size > 0) - (z->_mp_size < 0)) -
+               ((lsize > 0) - (lsize < 0));
+    }
+
+    sign = z->_mp_size < 0 ? -1 : 1;
+    un = ABS(z->_mp_size);
+    size = ABS(lsize);
+
+    bits = mpn_sizebits(z->_mp_d, un);
+    if (bits != pylong_sizebits(lptr->ob_digit, size))
+        return bits < pylong_sizebits(lptr->ob_digit, size) ? -sign : sign;
+
+    /* Both values have the same number of bits and therefore the same
+     * number of pylong digits. */
+    for (i = size; i-- > 0; ) {
+        pos = i * PyLong_SHIFT;
+        k = pos / GMP_NUMB_BITS;
+        off = pos % GMP_NUMB_BITS;
+        w = z->_mp_d[k] >> off;
+        if (off + PyLong_SHIFT > GMP_NUMB_BITS && k + 1 < un)
+            w |= z->_mp_d[k + 1] << (GMP_NUMB_BITS - off);
+        w &= PyLong_MASK;
+        if (w != (mp_limb_t)lptr->ob_digit[i])
+            return w < (mp_limb_t)lptr->ob_digit[i] ? -sign : sign;
+    }
+    return 0;
+}
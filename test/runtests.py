@@ -59,23 +59,32 @@ if sys.version.startswith('3.1'):
     print()
 
 mpz_doctests = ["test_mpz_create.txt", "test_mpz.txt", "test_mpz_io.txt",
-                "test_mpz_pack_unpack.txt", "test_mpz_to_from_binary.txt"]
+                "test_mpz_pack_unpack.txt", "test_mpz_to_from_binary.txt",
+                "test_mpz_ntheory.txt", "test_crt_basis.txt", "test_xmpz.txt",
+                "test_modulus.txt", "test_powmod_table.txt",
+                "test_divisor_set.txt", "test_mpz_vector.txt",
+                "test_rns_int.txt", "test_decimal_mpz.txt"]
 
 mpq_doctests = ["test_mpq.txt", "test_mpq_to_from_binary.txt"]
 
 mpfr_doctests = ["test_mpfr_create.txt", "test_mpfr.txt",
                  "test_mpfr_trig.txt", "test_mpfr_min_max.txt",
                  "test_mpfr_to_from_binary.txt", "test_context.txt",
-                 "test_mpfr_subnormalize.txt"]
+                 "test_mpfr_subnormalize.txt", "test_mpfr_array.txt",
+                 "test_lazy.txt", "test_mpfr_ball.txt"]
 
 mpc_doctests = ["test_mpc_create.txt", "test_mpc.txt",
                 "test_mpc_to_from_binary.txt"]
 
-gmpy2_tests = ["test_misc.txt", "test_abs.txt"]
+gmpy2_tests = ["test_misc.txt", "test_abs.txt", "test_arena.txt",
+               "test_random.txt"]
 
 # The following tests will only pass on Python 3.2+.
 py32_doctests = ["test_py32_hash.txt"]
 
+# The following tests will only pass on Python 3.7+.
+py37_doctests = ["test_futures.txt"]
+
 failed = 0
 attempted = 0
 
@@ -90,6 +99,9 @@ all_doctests += mpc_doctests
 if sys.version >= "3.2":
     all_doctests += py32_doctests
 
+if sys.version_info >= (3, 7):
+    all_doctests += py37_doctests
+
 for test in sorted(all_doctests):
     for r in range(repeat):
         result = doctest.testfile(test, globs=globals(),